@@ -0,0 +1,58 @@
+# SPDX-FileCopyrightText: 2024 yuzu Emulator Project
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Converts the XML report of yuzu-benchmarks into JSON and compares it with a baseline.
+# Usage: yuzu-benchmarks "[.benchmark]" --reporter xml --out results.xml
+#        python compare.py results.xml results.json [baseline.json] [threshold percent]
+# Exits with 1 when a benchmark got slower than the threshold (default 10%) and the confidence
+# intervals of both runs do not overlap.
+
+import json, sys
+import xml.etree.ElementTree as ET
+
+def parse_results(path):
+    results = {}
+    for test_case in ET.parse(path).getroot().iter('TestCase'):
+        for benchmark in test_case.iter('BenchmarkResults'):
+            mean = benchmark.find('mean')
+            name = '%s / %s' % (test_case.get('name'), benchmark.get('name'))
+            results[name] = {
+                'mean_ns': float(mean.get('value')),
+                'lower_bound_ns': float(mean.get('lowerBound')),
+                'upper_bound_ns': float(mean.get('upperBound')),
+                'samples': int(benchmark.get('samples')),
+            }
+    return results
+
+def main():
+    if len(sys.argv) < 3:
+        print('Usage: python compare.py <results.xml> <results.json> [baseline.json] [threshold]')
+        sys.exit(2)
+    results = parse_results(sys.argv[1])
+    with open(sys.argv[2], 'w') as output:
+        json.dump(results, output, indent=4, sort_keys=True)
+    if len(sys.argv) < 4:
+        return
+
+    with open(sys.argv[3]) as baseline_file:
+        baseline = json.load(baseline_file)
+    threshold = float(sys.argv[4]) / 100.0 if len(sys.argv) > 4 else 0.1
+    regressions = 0
+    for name, result in sorted(results.items()):
+        base = baseline.get(name)
+        if base is None:
+            print('new        %s: %.0f ns' % (name, result['mean_ns']))
+            continue
+        change = result['mean_ns'] / base['mean_ns'] - 1.0
+        is_regression = (change > threshold and
+                         result['lower_bound_ns'] > base['upper_bound_ns'])
+        regressions += is_regression
+        print('%-10s %s: %.0f ns -> %.0f ns (%+.1f%%)' %
+              ('REGRESSED' if is_regression else 'ok', name, base['mean_ns'],
+               result['mean_ns'], change * 100.0))
+    for name in sorted(baseline.keys() - results.keys()):
+        print('missing    %s' % name)
+    sys.exit(1 if regressions else 0)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,20 @@
+# SPDX-FileCopyrightText: 2024 yuzu Emulator Project
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+include(FindPackageHandleStandardArgs)
+
+find_package(xxHash QUIET CONFIG)
+if (xxHash_CONSIDERED_CONFIGS)
+    find_package_handle_standard_args(xxHash CONFIG_MODE)
+else()
+    find_package(PkgConfig QUIET)
+    pkg_search_module(XXHASH QUIET IMPORTED_TARGET libxxhash)
+    find_package_handle_standard_args(xxHash
+        REQUIRED_VARS XXHASH_LINK_LIBRARIES
+        VERSION_VAR XXHASH_VERSION
+    )
+endif()
+
+if (xxHash_FOUND AND NOT TARGET xxHash::xxhash)
+    add_library(xxHash::xxhash ALIAS PkgConfig::XXHASH)
+endif()
@@ -330,6 +330,11 @@ object NativeLibrary {
      */
     external fun logDeviceInfo()
 
+    /**
+     * Logs the host memory used by each subsystem, called when the system asks to trim memory.
+     */
+    external fun logMemoryUsage(level: Int)
+
     /**
      * Submits inline keyboard text. Called on input for buttons that result text.
      * @param text Text to submit to the inline software keyboard implementation.
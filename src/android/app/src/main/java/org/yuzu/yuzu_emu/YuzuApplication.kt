@@ -45,6 +45,11 @@ class YuzuApplication : Application() {
         createNotificationChannels()
     }
 
+    override fun onTrimMemory(level: Int) {
+        super.onTrimMemory(level)
+        NativeLibrary.logMemoryUsage(level)
+    }
+
     companion object {
         var documentsTree: DocumentsTree? = null
         lateinit var application: YuzuApplication
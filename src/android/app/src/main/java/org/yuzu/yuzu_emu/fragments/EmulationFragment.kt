@@ -491,6 +491,7 @@ class EmulationFragment : Fragment(), SurfaceHolder.Callback {
             val FPS = 1
             val FRAMETIME = 2
             val SPEED = 3
+            val FRAMETIME_1_PERCENT_LOW = 4
             perfStatsUpdater = {
                 if (emulationViewModel.emulationStarted.value &&
                     !emulationViewModel.isEmulationStopping.value
@@ -499,8 +500,18 @@ class EmulationFragment : Fragment(), SurfaceHolder.Callback {
                     val cpuBackend = NativeLibrary.getCpuBackend()
                     val gpuDriver = NativeLibrary.getGpuDriver()
                     if (_binding != null) {
-                        binding.showFpsText.text =
-                            String.format("FPS: %.1f\n%s/%s", perfStats[FPS], cpuBackend, gpuDriver)
+                        val lowFps = if (perfStats[FRAMETIME_1_PERCENT_LOW] > 0) {
+                            1.0 / perfStats[FRAMETIME_1_PERCENT_LOW]
+                        } else {
+                            0.0
+                        }
+                        binding.showFpsText.text = String.format(
+                            "FPS: %.1f (1%% low: %.1f)\n%s/%s",
+                            perfStats[FPS],
+                            lowFps,
+                            cpuBackend,
+                            gpuDriver
+                        )
                     }
                     perfStatsUpdateHandler.postDelayed(perfStatsUpdater!!, 800)
                 }
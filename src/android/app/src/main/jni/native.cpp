@@ -27,6 +27,7 @@
 #include "common/fs/path_util.h"
 #include "common/logging/backend.h"
 #include "common/logging/log.h"
+#include "common/memory_usage.h"
 #include "common/microprofile.h"
 #include "common/scm_rev.h"
 #include "common/scope_exit.h"
@@ -590,16 +591,20 @@ void Java_org_yuzu_yuzu_1emu_NativeLibrary_initializeSystem(JNIEnv* env, jclass
 }
 
 jdoubleArray Java_org_yuzu_yuzu_1emu_NativeLibrary_getPerfStats(JNIEnv* env, jclass clazz) {
-    jdoubleArray j_stats = env->NewDoubleArray(4);
+    jdoubleArray j_stats = env->NewDoubleArray(6);
 
     if (EmulationSession::GetInstance().IsRunning()) {
         jconst results = EmulationSession::GetInstance().PerfStats();
 
         // Converting the structure into an array makes it easier to pass it to the frontend
-        double stats[4] = {results.system_fps, results.average_game_fps, results.frametime,
-                           results.emulation_speed};
+        double stats[6] = {results.system_fps,
+                           results.average_game_fps,
+                           results.frametime,
+                           results.emulation_speed,
+                           results.frametime_1_percent_low,
+                           results.frametime_0_1_percent_low};
 
-        env->SetDoubleArrayRegion(j_stats, 0, 4, stats);
+        env->SetDoubleArrayRegion(j_stats, 0, 6, stats);
     }
 
     return j_stats;
@@ -646,6 +651,12 @@ void Java_org_yuzu_yuzu_1emu_NativeLibrary_logDeviceInfo(JNIEnv* env, jclass cla
     LOG_INFO(Frontend, "Host OS: Android API level {}", android_get_device_api_level());
 }
 
+void Java_org_yuzu_yuzu_1emu_NativeLibrary_logMemoryUsage(JNIEnv* env, jclass clazz,
+                                                          jint j_level) {
+    LOG_WARNING(Frontend, "Memory trim requested by the system, level {}", j_level);
+    Common::LogMemoryUsage();
+}
+
 void Java_org_yuzu_yuzu_1emu_NativeLibrary_submitInlineKeyboardText(JNIEnv* env, jclass clazz,
                                                                     jstring j_text) {
     const std::u16string input = Common::UTF8ToUTF16(Common::Android::GetJString(env, j_text));
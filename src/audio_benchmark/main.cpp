@@ -0,0 +1,612 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Renders a deterministic audio scene through the AudioRenderer's command implementations and
+// reports the cost of each command type and of each frame, along with a hash of the output, so
+// audio_core changes can be measured and checked for regressions without booting a game.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <getopt.h>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/command/command_processing_time_estimator.h"
+#include "audio_core/renderer/command/commands.h"
+#include "common/cityhash.h"
+#include "common/common_types.h"
+
+namespace {
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+// Mix buffer layout of the scene: a 6 channel final mix, a 6 channel sub mix running the
+// effects, then one buffer per voice.
+constexpr s16 FinalMixOffset = 0;
+constexpr s16 SubMixOffset = FinalMixOffset + MaxChannels;
+constexpr s16 VoiceOffset = SubMixOffset + MaxChannels;
+
+/// Number of frames of source audio generated for each voice, played in a loop
+constexpr u32 SourceFrameCount = 200;
+
+constexpr std::array<f32, 4> DownMixCoefficients{1.0f, 0.707f, 0.251f, 0.707f};
+
+struct Options {
+    u32 num_voices{64};
+    u32 num_frames{2000};
+    u32 sample_count{TargetSampleCount};
+    bool effects{true};
+    u64 seed{0};
+};
+
+/**
+ * Stands in for the data source commands, which decode from game memory, by copying
+ * pre-generated samples into the voice's mix buffer.
+ */
+struct VoiceSourceCommand : ICommand {
+    void Dump(const AudioRenderer::CommandListProcessor& processor, std::string& string) override {
+        string += "VoiceSourceCommand\n";
+    }
+
+    void Process(const AudioRenderer::CommandListProcessor& processor) override {
+        std::ranges::copy(samples, processor.mix_buffers
+                                       .subspan(output_index * processor.sample_count,
+                                                processor.sample_count)
+                                       .begin());
+    }
+
+    bool Verify(const AudioRenderer::CommandListProcessor& processor) override {
+        return true;
+    }
+
+    std::span<const s32> samples;
+    s16 output_index;
+};
+
+struct Voice {
+    std::vector<s32> source;
+    VoiceState::BiquadFilterState biquad_state{};
+    std::array<s32, MaxMixBuffers> previous_samples{};
+    std::array<f32, MaxChannels> prev_mix_volumes{};
+    std::array<f32, MaxChannels> mix_volumes{};
+    f32 prev_volume{};
+    f32 volume{};
+};
+
+struct CommandTotals {
+    std::chrono::nanoseconds time{};
+    u64 num_runs{};
+    u64 estimated_time{};
+};
+
+struct Benchmark {
+    explicit Benchmark(const Options& options_)
+        : options{options_}, estimator{options.sample_count,
+                                       static_cast<u32>(VoiceOffset + options.num_voices)},
+          rng{options.seed} {}
+
+    Options options;
+    CommandProcessingTimeEstimatorVersion5 estimator;
+    std::mt19937_64 rng;
+
+    AudioCore::ADSP::AudioRenderer::CommandListProcessor processor{};
+    std::vector<s32> mix_buffers;
+    std::vector<s32> depop_buffer;
+    std::vector<Voice> voices;
+
+    std::unique_ptr<DelayInfo::State> delay_state{std::make_unique<DelayInfo::State>()};
+    std::unique_ptr<ReverbInfo::State> reverb_state{std::make_unique<ReverbInfo::State>()};
+    std::unique_ptr<I3dl2ReverbInfo::State> i3dl2_state{
+        std::make_unique<I3dl2ReverbInfo::State>()};
+    std::unique_ptr<CompressorInfo::State> compressor_state{
+        std::make_unique<CompressorInfo::State>()};
+    std::unique_ptr<LightLimiterInfo::State> limiter_state{
+        std::make_unique<LightLimiterInfo::State>()};
+
+    std::vector<std::unique_ptr<ICommand>> commands;
+
+    std::map<CommandId, CommandTotals> totals;
+    std::vector<std::chrono::nanoseconds> frame_times;
+    u64 output_hash{};
+};
+
+std::string_view CommandName(CommandId type) {
+    switch (type) {
+    case CommandId::Invalid:
+        return "VoiceSource (harness)";
+    case CommandId::DataSourcePcmInt16Version1:
+        return "DataSourcePcmInt16Version1";
+    case CommandId::DataSourcePcmInt16Version2:
+        return "DataSourcePcmInt16Version2";
+    case CommandId::DataSourcePcmFloatVersion1:
+        return "DataSourcePcmFloatVersion1";
+    case CommandId::DataSourcePcmFloatVersion2:
+        return "DataSourcePcmFloatVersion2";
+    case CommandId::DataSourceAdpcmVersion1:
+        return "DataSourceAdpcmVersion1";
+    case CommandId::DataSourceAdpcmVersion2:
+        return "DataSourceAdpcmVersion2";
+    case CommandId::Volume:
+        return "Volume";
+    case CommandId::VolumeRamp:
+        return "VolumeRamp";
+    case CommandId::BiquadFilter:
+        return "BiquadFilter";
+    case CommandId::Mix:
+        return "Mix";
+    case CommandId::MixRamp:
+        return "MixRamp";
+    case CommandId::MixRampGrouped:
+        return "MixRampGrouped";
+    case CommandId::DepopPrepare:
+        return "DepopPrepare";
+    case CommandId::DepopForMixBuffers:
+        return "DepopForMixBuffers";
+    case CommandId::Delay:
+        return "Delay";
+    case CommandId::Upsample:
+        return "Upsample";
+    case CommandId::DownMix6chTo2ch:
+        return "DownMix6chTo2ch";
+    case CommandId::Aux:
+        return "Aux";
+    case CommandId::DeviceSink:
+        return "DeviceSink";
+    case CommandId::CircularBufferSink:
+        return "CircularBufferSink";
+    case CommandId::Reverb:
+        return "Reverb";
+    case CommandId::I3dl2Reverb:
+        return "I3dl2Reverb";
+    case CommandId::Performance:
+        return "Performance";
+    case CommandId::ClearMixBuffer:
+        return "ClearMixBuffer";
+    case CommandId::CopyMixBuffer:
+        return "CopyMixBuffer";
+    case CommandId::LightLimiterVersion1:
+        return "LightLimiterVersion1";
+    case CommandId::LightLimiterVersion2:
+        return "LightLimiterVersion2";
+    case CommandId::MultiTapBiquadFilter:
+        return "MultiTapBiquadFilter";
+    case CommandId::Capture:
+        return "Capture";
+    case CommandId::Compressor:
+        return "Compressor";
+    }
+    return "Unknown";
+}
+
+void PrintHelp(const char* argv0) {
+    fmt::print("Usage: {} [options]\n"
+               "Renders a generated audio scene through the AudioRenderer commands.\n"
+               "-v, --voices=N         Number of voices to mix (default 64)\n"
+               "-f, --frames=N         Number of frames to render (default 2000)\n"
+               "-s, --sample-count=N   Samples per frame, 160 or 240 (default 240)\n"
+               "-n, --no-effects       Don't run the sub mix effects\n"
+               "-r, --seed=N           Seed of the generated scene (default 0)\n"
+               "-e, --expect=HASH      Exit with a failure if the output hash differs\n"
+               "-h, --help             Display this help and exit\n",
+               argv0);
+}
+
+template <typename T, CommandId Id>
+T& GenerateStart(Benchmark& benchmark, u32 node_id) {
+    auto& cmd{static_cast<T&>(*benchmark.commands.emplace_back(std::make_unique<T>()))};
+    cmd.magic = CommandMagic;
+    cmd.enabled = true;
+    cmd.type = Id;
+    cmd.size = sizeof(T);
+    cmd.node_id = node_id;
+    return cmd;
+}
+
+template <typename T>
+void GenerateEnd(Benchmark& benchmark, T& cmd) {
+    cmd.estimated_process_time = benchmark.estimator.Estimate(cmd);
+}
+
+void InitializeScene(Benchmark& benchmark) {
+    const auto& options{benchmark.options};
+    const u32 buffer_count{VoiceOffset + options.num_voices};
+    benchmark.mix_buffers.resize(buffer_count * options.sample_count);
+    benchmark.depop_buffer.resize(buffer_count);
+
+    auto& processor{benchmark.processor};
+    processor.mix_buffers = benchmark.mix_buffers;
+    processor.buffer_count = buffer_count;
+    processor.sample_count = options.sample_count;
+    processor.target_sample_rate = TargetSampleRate;
+
+    // Band limited noise at varying levels, loud enough for the limiter to engage on the mix
+    std::uniform_int_distribution<s32> sample_distribution{-0x8000, 0x7FFF};
+    std::uniform_real_distribution<f32> volume_distribution{0.05f, 0.5f};
+    benchmark.voices.resize(options.num_voices);
+    for (auto& voice : benchmark.voices) {
+        voice.source.resize(SourceFrameCount * options.sample_count);
+        s32 previous{};
+        for (auto& sample : voice.source) {
+            sample = (previous + sample_distribution(benchmark.rng)) / 2;
+            previous = sample;
+        }
+        for (auto& volume : voice.mix_volumes) {
+            volume = volume_distribution(benchmark.rng);
+        }
+        voice.volume = volume_distribution(benchmark.rng) * 2.0f;
+    }
+}
+
+void GenerateVoiceCommands(Benchmark& benchmark, u32 frame) {
+    const auto& options{benchmark.options};
+    std::uniform_real_distribution<f32> ramp_distribution{0.9f, 1.1f};
+    for (u32 index = 0; index < options.num_voices; index++) {
+        auto& voice{benchmark.voices[index]};
+        const u32 node_id{(1u << 28) | (index << 16)};
+        const auto buffer{static_cast<s16>(VoiceOffset + index)};
+
+        // Volumes drift every frame so the ramps are exercised
+        voice.prev_volume = voice.volume;
+        voice.volume = std::clamp(voice.volume * ramp_distribution(benchmark.rng), 0.0f, 1.0f);
+        voice.prev_mix_volumes = voice.mix_volumes;
+        for (auto& volume : voice.mix_volumes) {
+            volume = std::clamp(volume * ramp_distribution(benchmark.rng), 0.0f, 1.0f);
+        }
+
+        auto& source{GenerateStart<VoiceSourceCommand, CommandId::Invalid>(benchmark, node_id)};
+        const u32 source_frame{frame % SourceFrameCount};
+        source.samples = std::span<const s32>{voice.source}.subspan(
+            source_frame * options.sample_count, options.sample_count);
+        source.output_index = buffer;
+
+        auto& biquad{GenerateStart<BiquadFilterCommand, CommandId::BiquadFilter>(benchmark,
+                                                                               node_id)};
+        biquad.input = buffer;
+        biquad.output = buffer;
+        biquad.biquad = {.enabled = true, .b{0x0800, 0x1000, 0x0800}, .a{-0x1000, 0x0400}};
+        biquad.state = CpuAddr(&voice.biquad_state);
+        biquad.needs_init = frame == 0;
+        biquad.use_float_processing = true;
+        GenerateEnd(benchmark, biquad);
+
+        auto& volume_ramp{
+            GenerateStart<VolumeRampCommand, CommandId::VolumeRamp>(benchmark, node_id)};
+        volume_ramp.precision = 15;
+        volume_ramp.input_index = buffer;
+        volume_ramp.output_index = buffer;
+        volume_ramp.prev_volume = voice.prev_volume;
+        volume_ramp.volume = voice.volume;
+        GenerateEnd(benchmark, volume_ramp);
+
+        auto& mix{
+            GenerateStart<MixRampGroupedCommand, CommandId::MixRampGrouped>(benchmark, node_id)};
+        mix.precision = 15;
+        mix.buffer_count = MaxChannels;
+        for (u32 channel = 0; channel < MaxChannels; channel++) {
+            mix.inputs[channel] = buffer;
+            mix.outputs[channel] = static_cast<s16>(SubMixOffset + channel);
+            mix.prev_volumes[channel] = voice.prev_mix_volumes[channel];
+            mix.volumes[channel] = voice.mix_volumes[channel];
+        }
+        mix.previous_samples = CpuAddr(voice.previous_samples.data());
+        GenerateEnd(benchmark, mix);
+    }
+}
+
+template <typename Parameter>
+void SetChannels(Parameter& parameter) {
+    parameter.channel_count_max = MaxChannels;
+    parameter.channel_count = MaxChannels;
+    for (u32 channel = 0; channel < MaxChannels; channel++) {
+        parameter.inputs[channel] = static_cast<s8>(channel);
+        parameter.outputs[channel] = static_cast<s8>(channel);
+    }
+}
+
+template <typename T>
+void SetBuffers(T& cmd, s16 buffer_offset) {
+    for (u32 channel = 0; channel < MaxChannels; channel++) {
+        cmd.inputs[channel] = static_cast<s16>(buffer_offset + channel);
+        cmd.outputs[channel] = static_cast<s16>(buffer_offset + channel);
+    }
+}
+
+void GenerateEffectCommands(Benchmark& benchmark, u32 frame) {
+    constexpr u32 node_id{(2u << 28)};
+    // Effects are (re)initialized by the first command list they are part of
+    const auto state{frame == 0 ? EffectInfoBase::ParameterState::Initialized
+                                : EffectInfoBase::ParameterState::Updated};
+
+    auto& delay{GenerateStart<DelayCommand, CommandId::Delay>(benchmark, node_id)};
+    SetBuffers(delay, SubMixOffset);
+    delay.parameter = {};
+    SetChannels(delay.parameter);
+    delay.parameter.delay_time_max = 100;
+    delay.parameter.delay_time = 50;
+    delay.parameter.sample_rate = static_cast<f32>(TargetSampleRate);
+    delay.parameter.in_gain = 0.5f;
+    delay.parameter.feedback_gain = 0.4f;
+    delay.parameter.wet_gain = 0.5f;
+    delay.parameter.dry_gain = 0.5f;
+    delay.parameter.channel_spread = 0.25f;
+    delay.parameter.lowpass_amount = 0.5f;
+    delay.parameter.state = state;
+    delay.state = CpuAddr(benchmark.delay_state.get());
+    delay.effect_enabled = true;
+    GenerateEnd(benchmark, delay);
+
+    auto& reverb{GenerateStart<ReverbCommand, CommandId::Reverb>(benchmark, node_id)};
+    SetBuffers(reverb, SubMixOffset);
+    reverb.parameter = {};
+    SetChannels(reverb.parameter);
+    reverb.parameter.sample_rate = 48 << 14;
+    reverb.parameter.early_mode = 1;
+    reverb.parameter.early_gain = 1 << 13;
+    reverb.parameter.pre_delay = 20 << 14;
+    reverb.parameter.late_mode = 1;
+    reverb.parameter.late_gain = 1 << 13;
+    reverb.parameter.decay_time = 3 << 14;
+    reverb.parameter.high_freq_decay_ratio = 1 << 13;
+    reverb.parameter.colouration = 1 << 12;
+    reverb.parameter.base_gain = 1 << 14;
+    reverb.parameter.wet_gain = 1 << 13;
+    reverb.parameter.dry_gain = 1 << 13;
+    reverb.parameter.state = state;
+    reverb.state = CpuAddr(benchmark.reverb_state.get());
+    reverb.effect_enabled = true;
+    reverb.long_size_pre_delay_supported = true;
+    GenerateEnd(benchmark, reverb);
+
+    auto& i3dl2{GenerateStart<I3dl2ReverbCommand, CommandId::I3dl2Reverb>(benchmark, node_id)};
+    SetBuffers(i3dl2, SubMixOffset);
+    i3dl2.parameter = {};
+    SetChannels(i3dl2.parameter);
+    i3dl2.parameter.sample_rate = TargetSampleRate;
+    i3dl2.parameter.room_gain = -1000.0f;
+    i3dl2.parameter.room_HF_gain = -100.0f;
+    i3dl2.parameter.late_reverb_decay_time = 1.5f;
+    i3dl2.parameter.late_reverb_HF_decay_ratio = 0.8f;
+    i3dl2.parameter.reflection_gain = -500.0f;
+    i3dl2.parameter.reverb_gain = -200.0f;
+    i3dl2.parameter.late_reverb_delay_time = 0.02f;
+    i3dl2.parameter.reflection_delay = 0.01f;
+    i3dl2.parameter.late_reverb_diffusion = 100.0f;
+    i3dl2.parameter.late_reverb_density = 100.0f;
+    i3dl2.parameter.dry_gain = 0.5f;
+    i3dl2.parameter.reference_HF = 5000.0f;
+    i3dl2.parameter.state = state;
+    i3dl2.state = CpuAddr(benchmark.i3dl2_state.get());
+    i3dl2.effect_enabled = true;
+    GenerateEnd(benchmark, i3dl2);
+
+    auto& compressor{GenerateStart<CompressorCommand, CommandId::Compressor>(benchmark, node_id)};
+    SetBuffers(compressor, SubMixOffset);
+    compressor.parameter = {};
+    SetChannels(compressor.parameter);
+    compressor.parameter.sample_rate = TargetSampleRate;
+    compressor.parameter.threshold = -20.0f;
+    compressor.parameter.compressor_ratio = 4.0f;
+    compressor.parameter.attack_time = 10;
+    compressor.parameter.release_time = 100;
+    compressor.parameter.unk_24 = 0.1f;
+    compressor.parameter.unk_28 = 0.01f;
+    compressor.parameter.unk_2C = 0.01f;
+    compressor.parameter.out_gain = 0.0f;
+    compressor.parameter.state = state;
+    compressor.state = CpuAddr(benchmark.compressor_state.get());
+    compressor.effect_enabled = true;
+    GenerateEnd(benchmark, compressor);
+}
+
+void GenerateFinalMixCommands(Benchmark& benchmark, u32 frame) {
+    constexpr u32 node_id{(3u << 28)};
+    for (u32 channel = 0; channel < MaxChannels; channel++) {
+        auto& mix{GenerateStart<MixCommand, CommandId::Mix>(benchmark, node_id)};
+        mix.precision = 15;
+        mix.input_index = static_cast<s16>(SubMixOffset + channel);
+        mix.output_index = static_cast<s16>(FinalMixOffset + channel);
+        mix.volume = 0.8f;
+        GenerateEnd(benchmark, mix);
+    }
+
+    auto& depop{
+        GenerateStart<DepopForMixBuffersCommand, CommandId::DepopForMixBuffers>(benchmark,
+                                                                                node_id)};
+    depop.input = FinalMixOffset;
+    depop.count = MaxChannels;
+    depop.decay = 0.96218872f;
+    depop.depop_buffer = CpuAddr(benchmark.depop_buffer.data());
+    GenerateEnd(benchmark, depop);
+
+    auto& limiter{
+        GenerateStart<LightLimiterVersion1Command, CommandId::LightLimiterVersion1>(benchmark,
+                                                                                    node_id)};
+    SetBuffers(limiter, FinalMixOffset);
+    limiter.parameter = {};
+    SetChannels(limiter.parameter);
+    limiter.parameter.sample_rate = TargetSampleRate;
+    limiter.parameter.look_ahead_samples_min = static_cast<s32>(benchmark.options.sample_count);
+    limiter.parameter.look_ahead_samples_max = static_cast<s32>(benchmark.options.sample_count);
+    limiter.parameter.attack_coeff = 0.1f;
+    limiter.parameter.release_coeff = 0.001f;
+    limiter.parameter.threshold = 0.5f;
+    limiter.parameter.input_gain = 1.0f;
+    limiter.parameter.output_gain = 1.0f;
+    limiter.parameter.state = frame == 0 ? EffectInfoBase::ParameterState::Initialized
+                                         : EffectInfoBase::ParameterState::Updated;
+    limiter.state = CpuAddr(benchmark.limiter_state.get());
+    limiter.effect_enabled = true;
+    GenerateEnd(benchmark, limiter);
+
+    auto& down_mix{
+        GenerateStart<DownMix6chTo2chCommand, CommandId::DownMix6chTo2ch>(benchmark, node_id)};
+    SetBuffers(down_mix, FinalMixOffset);
+    for (u32 i = 0; i < DownMixCoefficients.size(); i++) {
+        down_mix.down_mix_coeff[i] = DownMixCoefficients[i];
+    }
+    GenerateEnd(benchmark, down_mix);
+}
+
+void GenerateCommands(Benchmark& benchmark, u32 frame) {
+    benchmark.commands.clear();
+
+    auto& clear{GenerateStart<ClearMixBufferCommand, CommandId::ClearMixBuffer>(benchmark,
+                                                                              InvalidNodeId)};
+    GenerateEnd(benchmark, clear);
+
+    GenerateVoiceCommands(benchmark, frame);
+    if (benchmark.options.effects) {
+        GenerateEffectCommands(benchmark, frame);
+    }
+    GenerateFinalMixCommands(benchmark, frame);
+}
+
+void RenderFrame(Benchmark& benchmark) {
+    const auto frame_start{std::chrono::steady_clock::now()};
+    for (auto& command : benchmark.commands) {
+        const auto start{std::chrono::steady_clock::now()};
+        command->Process(benchmark.processor);
+        const auto end{std::chrono::steady_clock::now()};
+
+        CommandTotals& totals{benchmark.totals[command->type]};
+        totals.time += end - start;
+        totals.estimated_time += command->estimated_process_time;
+        ++totals.num_runs;
+    }
+    const auto frame_end{std::chrono::steady_clock::now()};
+    benchmark.frame_times.push_back(frame_end - frame_start);
+
+    // Only the final mix is heard, but a difference anywhere else shows up here eventually
+    const std::span<const s32> final_mix{benchmark.mix_buffers.data(),
+                                         MaxChannels * benchmark.options.sample_count};
+    benchmark.output_hash =
+        Common::CityHash64WithSeed(reinterpret_cast<const char*>(final_mix.data()),
+                                   final_mix.size_bytes(), benchmark.output_hash);
+}
+
+void PrintReport(Benchmark& benchmark) {
+    const auto& options{benchmark.options};
+    const auto to_us = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::micro>(time).count();
+    };
+
+    auto frame_times{benchmark.frame_times};
+    std::ranges::sort(frame_times);
+    std::chrono::nanoseconds total_time{};
+    for (const auto time : frame_times) {
+        total_time += time;
+    }
+    const auto percentile = [&](double fraction) {
+        const auto index{fraction * static_cast<double>(frame_times.size() - 1)};
+        return frame_times[static_cast<size_t>(index)];
+    };
+    const double frame_budget_us{1'000'000.0 * options.sample_count / TargetSampleRate};
+
+    fmt::print("{} voices, {} frames of {} samples, effects {}\n", options.num_voices,
+               options.num_frames, options.sample_count, options.effects ? "on" : "off");
+    fmt::print("Frame (us): mean {:.2f}, median {:.2f}, p99 {:.2f}, max {:.2f}, budget {:.0f}\n\n",
+               to_us(total_time) / static_cast<double>(frame_times.size()), to_us(percentile(0.5)),
+               to_us(percentile(0.99)), to_us(frame_times.back()), frame_budget_us);
+
+    fmt::print("{:<24} {:>10} {:>12} {:>12} {:>14} {:>14}\n", "Command", "Runs", "Total (ms)",
+               "Mean (us)", "Mean estimate", "ns per cycle");
+    std::vector<std::pair<CommandId, CommandTotals>> commands(benchmark.totals.begin(),
+                                                              benchmark.totals.end());
+    std::ranges::sort(commands, [](const auto& lhs, const auto& rhs) {
+        return lhs.second.time > rhs.second.time;
+    });
+    for (const auto& [type, totals] : commands) {
+        const double runs{static_cast<double>(std::max<u64>(totals.num_runs, 1))};
+        const double ns_per_cycle{
+            totals.estimated_time == 0
+                ? 0.0
+                : static_cast<double>(totals.time.count()) /
+                      static_cast<double>(totals.estimated_time)};
+        fmt::print("{:<24} {:>10} {:>12.3f} {:>12.3f} {:>14.1f} {:>14.3f}\n", CommandName(type),
+                   totals.num_runs, to_us(totals.time) / 1000.0, to_us(totals.time) / runs,
+                   static_cast<double>(totals.estimated_time) / runs, ns_per_cycle);
+    }
+    fmt::print("\nOutput hash: {:016X}\n", benchmark.output_hash);
+}
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::optional<u64> expected_hash;
+
+    static constexpr option long_options[] = {
+        {"voices", required_argument, 0, 'v'},
+        {"frames", required_argument, 0, 'f'},
+        {"sample-count", required_argument, 0, 's'},
+        {"no-effects", no_argument, 0, 'n'},
+        {"seed", required_argument, 0, 'r'},
+        {"expect", required_argument, 0, 'e'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+    while (optind < argc) {
+        const int arg{getopt_long(argc, argv, "v:f:s:nr:e:h", long_options, nullptr)};
+        if (arg == -1) {
+            break;
+        }
+        switch (static_cast<char>(arg)) {
+        case 'v':
+            options.num_voices = static_cast<u32>(std::max(std::atoi(optarg), 0));
+            break;
+        case 'f':
+            options.num_frames = static_cast<u32>(std::max(std::atoi(optarg), 1));
+            break;
+        case 's':
+            options.sample_count = static_cast<u32>(std::atoi(optarg));
+            if (options.sample_count != 160 && options.sample_count != 240) {
+                fmt::print(stderr, "Unsupported sample count {}\n", optarg);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'n':
+            options.effects = false;
+            break;
+        case 'r':
+            options.seed = std::strtoull(optarg, nullptr, 0);
+            break;
+        case 'e':
+            expected_hash = std::strtoull(optarg, nullptr, 16);
+            break;
+        case 'h':
+            PrintHelp(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            PrintHelp(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc) {
+        PrintHelp(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Benchmark benchmark{options};
+    InitializeScene(benchmark);
+    benchmark.frame_times.reserve(options.num_frames);
+    for (u32 frame = 0; frame < options.num_frames; frame++) {
+        GenerateCommands(benchmark, frame);
+        RenderFrame(benchmark);
+    }
+    PrintReport(benchmark);
+
+    if (expected_hash && *expected_hash != benchmark.output_hash) {
+        fmt::print(stderr, "Output hash mismatch, expected {:016X}\n", *expected_hash);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,7 @@
 #include "audio_core/sink/sink.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -18,6 +19,11 @@ MICROPROFILE_DEFINE(Audio_Renderer, "Audio", "DSP_AudioRenderer", MP_RGB(60, 19,
 
 namespace AudioCore::ADSP::AudioRenderer {
 
+/// Time a frame takes to play, rendering it should take less.
+constexpr u64 FrameTimeUs{TargetSampleCount * 1'000'000ULL / TargetSampleRate};
+/// Number of frames between glitch reports, about 5 seconds.
+constexpr u64 GlitchReportInterval{1000};
+
 AudioRenderer::AudioRenderer(Core::System& system_, Sink::Sink& sink_)
     : system{system_}, sink{sink_} {}
 
@@ -119,6 +125,34 @@ u64 AudioRenderer::GetRenderingStartTick(s32 session_id) const noexcept {
     return (1000 * command_buffers[session_id].render_time_taken_us) + signalled_tick;
 }
 
+u64 AudioRenderer::GetUnderrunCount() const noexcept {
+    u64 count{0};
+    for (const auto* stream : streams) {
+        if (stream) {
+            count += stream->GetUnderrunCount();
+        }
+    }
+    return count;
+}
+
+u64 AudioRenderer::GetLateRenderCount() const noexcept {
+    return late_render_count.load(std::memory_order_relaxed);
+}
+
+void AudioRenderer::ReportGlitches() {
+    const auto underruns{GetUnderrunCount()};
+    const auto late_renders{GetLateRenderCount()};
+    if (underruns != reported_underrun_count || late_renders != reported_late_render_count) {
+        LOG_WARNING(Service_Audio,
+                    "ADSP AudioRenderer -- {} underruns and {} late frames in the last {} frames "
+                    "({} and {} in total)",
+                    underruns - reported_underrun_count, late_renders - reported_late_render_count,
+                    GlitchReportInterval, underruns, late_renders);
+    }
+    reported_underrun_count = underruns;
+    reported_late_render_count = late_renders;
+}
+
 void AudioRenderer::CreateSinkStreams() {
     u32 channels{sink.GetDeviceChannels()};
     for (u32 i = 0; i < MaxRendererSessions; i++) {
@@ -133,7 +167,12 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     static constexpr char name[]{"DSP_AudioRenderer_Main"};
     MicroProfileOnThreadCreate(name);
     Common::SetCurrentThreadName(name);
-    Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    if (!Settings::values.audio_renderer_realtime.GetValue()) {
+        Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    } else if (!Common::SetCurrentThreadRealtimeAudioPriority()) {
+        LOG_WARNING(Service_Audio, "ADSP AudioRenderer -- Host denied real-time priority");
+        Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    }
 
     // TODO: Create buffer map/unmap thread + mailbox
     // TODO: Create gMix devices, initialize them here
@@ -165,6 +204,7 @@ void AudioRenderer::Main(std::stop_token stop_token) {
             std::array<bool, MaxRendererSessions> buffers_reset{};
             std::array<u64, MaxRendererSessions> render_times_taken{};
             const auto start_time{system.CoreTiming().GetGlobalTimeUs().count()};
+            u64 process_time{0};
 
             for (u32 index = 0; index < MaxRendererSessions; index++) {
                 auto& command_buffer{command_buffers[index]};
@@ -202,6 +242,8 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                     }
 
                     // Process the command list
+                    const auto process_start_time{
+                        system.CoreTiming().GetGlobalTimeUs().count()};
                     {
                         MICROPROFILE_SCOPE(Audio_Renderer);
                         render_times_taken[index] =
@@ -209,6 +251,7 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                     }
 
                     const auto end_time{system.CoreTiming().GetGlobalTimeUs().count()};
+                    process_time += end_time - process_start_time;
 
                     command_buffer.remaining_command_count =
                         command_list_processor.GetRemainingCommandCount();
@@ -216,6 +259,13 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                 }
             }
 
+            if (process_time > FrameTimeUs) {
+                late_render_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (++render_count % GlitchReportInterval == 0) {
+                ReportGlitches();
+            }
+
             mailbox.Send(Direction::Host, Message::RenderResponse);
         } break;
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -79,6 +80,20 @@ public:
     void ClearRemainCommandCount(s32 session_id) noexcept;
     u64 GetRenderingStartTick(s32 session_id) const noexcept;
 
+    /**
+     * Get the number of times the sink ran out of rendered samples.
+     *
+     * @return The number of underruns across all sessions.
+     */
+    u64 GetUnderrunCount() const noexcept;
+
+    /**
+     * Get the number of frames which took longer to render than they take to play.
+     *
+     * @return The number of late frames.
+     */
+    u64 GetLateRenderCount() const noexcept;
+
 private:
     /**
      * Main AudioRenderer thread, responsible for processing the command lists.
@@ -92,6 +107,11 @@ private:
 
     void PostDSPClearCommandBuffer() noexcept;
 
+    /**
+     * Logs the underruns and late frames since the last report, if there were any.
+     */
+    void ReportGlitches();
+
     /// Core system
     Core::System& system;
     /// The output sink the AudioRenderer will send samples to
@@ -110,6 +130,13 @@ private:
     std::array<Sink::SinkStream*, MaxRendererSessions> streams{};
     /// CPU Tick when the DSP was signalled to process, uses time rather than tick
     u64 signalled_tick{0};
+    /// Number of frames rendered
+    u64 render_count{0};
+    /// Number of frames which took longer to render than they take to play
+    std::atomic<u64> late_render_count{0};
+    /// Underrun and late frame counts at the last report
+    u64 reported_underrun_count{0};
+    u64 reported_late_render_count{0};
 };
 
 } // namespace ADSP::AudioRenderer
@@ -6,6 +6,7 @@
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/command/host_processing_time_model.h"
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -17,6 +18,10 @@ namespace AudioCore::ADSP::AudioRenderer {
 void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& process,
                                       CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
     system = &system_;
+    // Cached wave buffers are keyed by guest address, which means nothing in another process
+    if (adpcm_cache && memory != &process.GetMemory()) {
+        adpcm_cache->Clear();
+    }
     memory = &process.GetMemory();
     stream = stream_;
     header = reinterpret_cast<Renderer::CommandListHeader*>(buffer);
@@ -27,6 +32,12 @@ void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& p
     target_sample_rate = header->sample_rate;
     mix_buffers = header->samples_buffer;
     buffer_count = header->buffer_count;
+    host_time_model = header->host_time_model;
+    if (!Settings::values.cache_adpcm_decode.GetValue()) {
+        adpcm_cache.reset();
+    } else if (!adpcm_cache) {
+        adpcm_cache = std::make_unique<Renderer::AdpcmDecodeCache>();
+    }
     processed_command_count = 0;
 }
 
@@ -82,7 +93,13 @@ u64 CommandListProcessor::Process(u32 session_id) {
             break;
         }
 
-        if (command.enabled) {
+        if (command.enabled && host_time_model != nullptr) {
+            const auto command_start{system->CoreTiming().GetGlobalTimeNs().count()};
+            command.Process(*this);
+            const auto command_end{system->CoreTiming().GetGlobalTimeNs().count()};
+            host_time_model->Record(command.type, command.estimated_process_time,
+                                    static_cast<u64>(command_end - command_start));
+        } else if (command.enabled) {
             command.Process(*this);
         } else {
             dump += fmt::format("\tDisabled!\n");
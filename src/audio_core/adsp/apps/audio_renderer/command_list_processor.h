@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <memory>
 #include <span>
 
 #include "audio_core/common/common.h"
 #include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/data_source/adpcm_decode_cache.h"
 #include "common/common_types.h"
 
 namespace Core {
@@ -27,7 +29,8 @@ class SinkStream;
 
 namespace Renderer {
 struct CommandListHeader;
-}
+class HostProcessingTimeModel;
+} // namespace Renderer
 
 namespace ADSP::AudioRenderer {
 
@@ -101,6 +104,10 @@ public:
     std::span<s32> mix_buffers{};
     /// The number of mix buffers
     u32 buffer_count{};
+    /// Model to record host processing times into, or nullptr if they are not measured
+    Renderer::HostProcessingTimeModel* host_time_model{};
+    /// Cache of decoded ADPCM wave buffers, or nullptr if caching is disabled
+    std::unique_ptr<Renderer::AdpcmDecodeCache> adpcm_cache{};
     /// The number of processed commands so far
     u32 processed_command_count{};
     /// The processing start time of this list
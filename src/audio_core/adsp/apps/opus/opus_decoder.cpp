@@ -1,8 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <future>
 
 #include "audio_core/adsp/apps/opus/opus_decode_object.h"
 #include "audio_core/adsp/apps/opus/opus_multistream_decode_object.h"
@@ -21,6 +23,8 @@ namespace AudioCore::ADSP::OpusDecoder {
 
 namespace {
 constexpr size_t OpusStreamCountMax = 255;
+constexpr size_t DecodeWorkerCount = 2;
+constexpr u64 DecodeStatsLogInterval = 1000;
 
 bool IsValidChannelCount(u32 channel_count) {
     return channel_count == 1 || channel_count == 2;
@@ -36,7 +40,8 @@ bool IsValidMultiStreamStreamCounts(s32 total_stream_count, s32 stereo_stream_co
 }
 } // namespace
 
-OpusDecoder::OpusDecoder(Core::System& system_) : system{system_} {
+OpusDecoder::OpusDecoder(Core::System& system_)
+    : system{system_}, decode_workers{DecodeWorkerCount, "DSP_OpusDecode"} {
     init_thread = std::jthread([this](std::stop_token stop_token) { Init(stop_token); });
 }
 
@@ -64,6 +69,82 @@ u32 OpusDecoder::Receive(Direction dir, std::stop_token stop_token) {
     return mailbox.Receive(dir, stop_token);
 }
 
+DecodeResult OpusDecoder::Decode(const DecodeRequest& request) {
+    std::promise<DecodeResult> result;
+    auto future = result.get_future();
+    decode_workers.QueueWork([this, &request, &result] { result.set_value(DecodeImpl(request)); });
+    return future.get();
+}
+
+DecodeStats OpusDecoder::GetDecodeStats() const noexcept {
+    return {
+        .decode_count = decode_count.load(std::memory_order_relaxed),
+        .total_time_us = total_decode_time_us.load(std::memory_order_relaxed),
+        .max_time_us = max_decode_time_us.load(std::memory_order_relaxed),
+    };
+}
+
+DecodeResult OpusDecoder::DecodeImpl(const DecodeRequest& request) {
+    MICROPROFILE_SCOPE(OpusDecoder);
+    const auto start_time = system.CoreTiming().GetGlobalTimeUs();
+
+    u32 decoded_samples{0};
+    u32 final_range{0};
+    s32 error_code{OPUS_OK};
+    if (request.is_multi_stream) {
+        auto& decoder_object =
+            OpusMultiStreamDecodeObject::Initialize(request.buffer, request.buffer);
+        if (request.reset_requested) {
+            error_code = decoder_object.ResetDecoder();
+        }
+        if (error_code == OPUS_OK) {
+            error_code = decoder_object.Decode(decoded_samples, request.output_data,
+                                               request.output_data_size, request.input_data,
+                                               request.input_data_size);
+            final_range = decoder_object.GetFinalRange();
+        }
+    } else {
+        auto& decoder_object = OpusDecodeObject::Initialize(request.buffer, request.buffer);
+        if (request.reset_requested) {
+            error_code = decoder_object.ResetDecoder();
+        }
+        if (error_code == OPUS_OK) {
+            error_code = decoder_object.Decode(decoded_samples, request.output_data,
+                                               request.output_data_size, request.input_data,
+                                               request.input_data_size);
+            final_range = decoder_object.GetFinalRange();
+        }
+    }
+
+    if (error_code == OPUS_OK) {
+        if (request.final_range && final_range != request.final_range) {
+            error_code = OPUS_INVALID_PACKET;
+        }
+    }
+
+    const auto end_time = system.CoreTiming().GetGlobalTimeUs();
+    const auto time_taken = static_cast<u64>((end_time - start_time).count());
+
+    const auto count = decode_count.fetch_add(1, std::memory_order_relaxed) + 1;
+    const auto total_time = total_decode_time_us.fetch_add(time_taken, std::memory_order_relaxed) +
+                            time_taken;
+    auto max_time = max_decode_time_us.load(std::memory_order_relaxed);
+    while (time_taken > max_time &&
+           !max_decode_time_us.compare_exchange_weak(max_time, time_taken,
+                                                     std::memory_order_relaxed)) {
+    }
+    if (count % DecodeStatsLogInterval == 0) {
+        LOG_DEBUG(Service_Audio, "Decoded {} Opus packets, {}us on average, {}us at most", count,
+                  total_time / count, std::max(max_time, time_taken));
+    }
+
+    return {
+        .error_code = error_code,
+        .decoded_samples = decoded_samples,
+        .time_taken_us = time_taken,
+    };
+}
+
 void OpusDecoder::Init(std::stop_token stop_token) {
     Common::SetCurrentThreadName("DSP_OpusDecoder_Init");
 
@@ -123,42 +204,26 @@ void OpusDecoder::Main(std::stop_token stop_token) {
             Send(Direction::Host, Message::ShutdownDecodeObjectOK);
         } break;
 
-        case DecodeInterleaved: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
-
-            Send(Direction::Host, Message::DecodeInterleavedOK);
+        case DecodeInterleaved:
+        case DecodeInterleavedForMultiStream: {
+            const auto result = DecodeImpl({
+                .buffer = shared_memory->host_send_data[0],
+                .input_data = shared_memory->host_send_data[1],
+                .input_data_size = shared_memory->host_send_data[2],
+                .output_data = shared_memory->host_send_data[3],
+                .output_data_size = shared_memory->host_send_data[4],
+                .final_range = static_cast<u32>(shared_memory->host_send_data[5]),
+                .reset_requested = shared_memory->host_send_data[6] != 0,
+                .is_multi_stream = msg == DecodeInterleavedForMultiStream,
+            });
+
+            shared_memory->dsp_return_data[0] = result.error_code;
+            shared_memory->dsp_return_data[1] = result.decoded_samples;
+            shared_memory->dsp_return_data[2] = result.time_taken_us;
+
+            Send(Direction::Host, msg == DecodeInterleaved
+                                      ? Message::DecodeInterleavedOK
+                                      : Message::DecodeInterleavedForMultiStreamOK);
         } break;
 
         case MapMemory: {
@@ -221,44 +286,6 @@ void OpusDecoder::Main(std::stop_token stop_token) {
             Send(Direction::Host, Message::ShutdownMultiStreamDecodeObjectOK);
         } break;
 
-        case DecodeInterleavedForMultiStream: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusMultiStreamDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
-
-            Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
-        } break;
-
         default:
             LOG_ERROR(Service_Audio, "Invalid OpusDecoder command {}", msg);
             continue;
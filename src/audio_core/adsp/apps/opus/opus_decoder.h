@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
 #include "audio_core/adsp/apps/opus/shared_memory.h"
 #include "audio_core/adsp/mailbox.h"
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 
 namespace Core {
 class System;
@@ -45,6 +47,32 @@ enum Message : u32 {
     DecodeInterleavedForMultiStreamOK = 50,
 };
 
+/**
+ * A request to decode one packet, with the same arguments the host passes through shared memory.
+ */
+struct DecodeRequest {
+    u64 buffer;
+    u64 input_data;
+    u64 input_data_size;
+    u64 output_data;
+    u64 output_data_size;
+    u32 final_range;
+    bool reset_requested;
+    bool is_multi_stream;
+};
+
+struct DecodeResult {
+    s32 error_code;
+    u32 decoded_samples;
+    u64 time_taken_us;
+};
+
+struct DecodeStats {
+    u64 decode_count;
+    u64 total_time_us;
+    u64 max_time_us;
+};
+
 /**
  * The AudioRenderer application running on the ADSP.
  */
@@ -64,6 +92,22 @@ public:
         shared_memory = &shared_memory_;
     }
 
+    /**
+     * Decode a packet on the decode worker pool and wait for the result.
+     * Unlike the mailbox, this may be called from several threads at once, so that independent
+     * decode objects decode in parallel. Each decode object must only be used by one thread at a
+     * time, which keeps the order of its packets.
+     *
+     * @param request - The packet to decode and the decode object to use.
+     * @return The libopus error code, decoded sample count and time taken.
+     */
+    DecodeResult Decode(const DecodeRequest& request);
+
+    /**
+     * Get the number of packets decoded and the time spent decoding them.
+     */
+    DecodeStats GetDecodeStats() const noexcept;
+
 private:
     /**
      * Initializing thread, launched at audio_core boot to avoid blocking the main emu boot thread.
@@ -74,6 +118,11 @@ private:
      */
     void Main(std::stop_token stop_token);
 
+    /**
+     * Decode a packet on the calling thread, and account for it in the decode stats.
+     */
+    DecodeResult DecodeImpl(const DecodeRequest& request);
+
     /// Core system
     Core::System& system;
     /// Mailbox to communicate messages with the host, drives the main thread
@@ -87,6 +136,12 @@ private:
     /// Structure shared with the host, input data set by the host before sending a mailbox message,
     /// and the responses are written back by the OpusDecoder.
     SharedMemory* shared_memory{};
+    /// Decode stats
+    std::atomic<u64> decode_count{};
+    std::atomic<u64> total_decode_time_us{};
+    std::atomic<u64> max_decode_time_us{};
+    /// Threads decoding the packets of Decode calls
+    Common::ThreadWorker decode_workers;
 };
 
 } // namespace AudioCore::ADSP::OpusDecoder
@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <span>
 
-#include "common/bounded_threadsafe_queue.h"
 #include "common/common_types.h"
+#include "common/polyfill_thread.h"
 
 namespace AudioCore::ADSP {
 
@@ -21,6 +23,69 @@ enum class Direction : u32 {
     DSP,
 };
 
+/**
+ * Single producer, single consumer queue of mailbox messages. Neither side ever takes a lock, so
+ * a preempted sender cannot hold up a real-time receiver. Waiting sides sleep on an atomic wake
+ * counter, which is bumped after each push or pop and when a stop is requested.
+ */
+class MessageQueue {
+public:
+    void Push(u32 message) {
+        const u32 write_index = m_write_index.load(std::memory_order::relaxed);
+        WaitUntil([&] {
+            return write_index - m_read_index.load(std::memory_order::acquire) < Capacity;
+        });
+        m_messages[write_index % Capacity] = message;
+        m_write_index.store(write_index + 1, std::memory_order::release);
+        Wake();
+    }
+
+    bool TryPop(u32& message) {
+        const u32 read_index = m_read_index.load(std::memory_order::relaxed);
+        if (read_index == m_write_index.load(std::memory_order::acquire)) {
+            return false;
+        }
+        message = m_messages[read_index % Capacity];
+        m_read_index.store(read_index + 1, std::memory_order::release);
+        Wake();
+        return true;
+    }
+
+    u32 PopWait(std::stop_token stop_token) {
+        const std::stop_callback wake_on_stop{stop_token, [this] { Wake(); }};
+        u32 message{};
+        WaitUntil([&] { return TryPop(message) || stop_token.stop_requested(); });
+        return message;
+    }
+
+private:
+    static constexpr u32 Capacity = 16;
+
+    template <typename Predicate>
+    void WaitUntil(Predicate&& pred) {
+        while (true) {
+            // The wake counter is read before checking, so a wake between the check and the wait
+            // changes it and the wait returns immediately.
+            const u32 wake_count = m_wake_count.load(std::memory_order::acquire);
+            if (pred()) {
+                return;
+            }
+            m_wake_count.wait(wake_count, std::memory_order::acquire);
+        }
+    }
+
+    void Wake() {
+        m_wake_count.fetch_add(1, std::memory_order::release);
+        m_wake_count.notify_all();
+    }
+
+    // The indices are written by different threads, keep them on separate cache lines.
+    std::array<u32, Capacity> m_messages{};
+    alignas(128) std::atomic<u32> m_write_index{};
+    alignas(128) std::atomic<u32> m_read_index{};
+    alignas(128) std::atomic<u32> m_wake_count{};
+};
+
 class Mailbox {
 public:
     void Initialize(AppMailboxId id_) {
@@ -34,7 +99,7 @@ public:
 
     void Send(Direction dir, u32 message) {
         auto& queue = dir == Direction::Host ? host_queue : adsp_queue;
-        queue.EmplaceWait(message);
+        queue.Push(message);
     }
 
     u32 Receive(Direction dir, std::stop_token stop_token = {}) {
@@ -53,8 +118,8 @@ public:
 
 private:
     AppMailboxId id{0};
-    Common::SPSCQueue<u32> host_queue;
-    Common::SPSCQueue<u32> adsp_queue;
+    MessageQueue host_queue;
+    MessageQueue adsp_queue;
 };
 
 } // namespace AudioCore::ADSP
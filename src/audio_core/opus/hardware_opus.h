@@ -37,6 +37,10 @@ public:
     Result UnmapMemory(void* buffer, u64 buffer_size);
 
 private:
+    Result Decode(u32& out_sample_count, void* output_data, u64 output_data_size, void* input_data,
+                  u64 input_data_size, void* buffer, u64& out_time_taken, bool reset,
+                  bool is_multi_stream);
+
     Core::System& system;
     std::mutex mutex;
     ADSP::OpusDecoder::OpusDecoder& opus_decoder;
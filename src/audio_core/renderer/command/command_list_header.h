@@ -9,6 +9,7 @@
 #include "common/common_types.h"
 
 namespace AudioCore::Renderer {
+class HostProcessingTimeModel;
 
 struct CommandListHeader {
     u64 buffer_size;
@@ -17,6 +18,7 @@ struct CommandListHeader {
     s16 buffer_count;
     u32 sample_count;
     u32 sample_rate;
+    HostProcessingTimeModel* host_time_model;
 };
 
 } // namespace AudioCore::Renderer
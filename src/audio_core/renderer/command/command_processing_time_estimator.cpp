@@ -3617,4 +3617,143 @@ u32 CommandProcessingTimeEstimatorVersion5::Estimate(const CompressorCommand& co
     }
 }
 
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const PcmInt16DataSourceVersion1Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const PcmInt16DataSourceVersion2Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const PcmFloatDataSourceVersion1Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const PcmFloatDataSourceVersion2Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const AdpcmDataSourceVersion1Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const AdpcmDataSourceVersion2Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const VolumeCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const VolumeRampCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const BiquadFilterCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const MixCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const MixRampCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const MixRampGroupedCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const DepopPrepareCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const DepopForMixBuffersCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const DelayCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const UpsampleCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const DownMix6chTo2chCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const AuxCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const DeviceSinkCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const CircularBufferSinkCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const ReverbCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const I3dl2ReverbCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const PerformanceCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const ClearMixBufferCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const CopyMixBufferCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const LightLimiterVersion1Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const LightLimiterVersion2Command& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(
+    const MultiTapBiquadFilterCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const CaptureCommand& command) const {
+    return Calibrate(command);
+}
+
+u32 CommandProcessingTimeEstimatorHostCalibrated::Estimate(const CompressorCommand& command) const {
+    return Calibrate(command);
+}
+
 } // namespace AudioCore::Renderer
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/command/host_processing_time_model.h"
 #include "common/common_types.h"
 
 namespace AudioCore::Renderer {
@@ -251,4 +254,58 @@ private:
     u32 buffer_count{};
 };
 
+/**
+ * Scales the estimates of a firmware estimator by how long each command type actually takes to
+ * process on the host, so that voice dropping follows the host's real rendering cost.
+ */
+class CommandProcessingTimeEstimatorHostCalibrated final : public ICommandProcessingTimeEstimator {
+public:
+    CommandProcessingTimeEstimatorHostCalibrated(
+        std::unique_ptr<ICommandProcessingTimeEstimator> estimator_,
+        const HostProcessingTimeModel& model_)
+        : estimator{std::move(estimator_)}, model{model_} {}
+
+    u32 Estimate(const PcmInt16DataSourceVersion1Command& command) const override;
+    u32 Estimate(const PcmInt16DataSourceVersion2Command& command) const override;
+    u32 Estimate(const PcmFloatDataSourceVersion1Command& command) const override;
+    u32 Estimate(const PcmFloatDataSourceVersion2Command& command) const override;
+    u32 Estimate(const AdpcmDataSourceVersion1Command& command) const override;
+    u32 Estimate(const AdpcmDataSourceVersion2Command& command) const override;
+    u32 Estimate(const VolumeCommand& command) const override;
+    u32 Estimate(const VolumeRampCommand& command) const override;
+    u32 Estimate(const BiquadFilterCommand& command) const override;
+    u32 Estimate(const MixCommand& command) const override;
+    u32 Estimate(const MixRampCommand& command) const override;
+    u32 Estimate(const MixRampGroupedCommand& command) const override;
+    u32 Estimate(const DepopPrepareCommand& command) const override;
+    u32 Estimate(const DepopForMixBuffersCommand& command) const override;
+    u32 Estimate(const DelayCommand& command) const override;
+    u32 Estimate(const UpsampleCommand& command) const override;
+    u32 Estimate(const DownMix6chTo2chCommand& command) const override;
+    u32 Estimate(const AuxCommand& command) const override;
+    u32 Estimate(const DeviceSinkCommand& command) const override;
+    u32 Estimate(const CircularBufferSinkCommand& command) const override;
+    u32 Estimate(const ReverbCommand& command) const override;
+    u32 Estimate(const I3dl2ReverbCommand& command) const override;
+    u32 Estimate(const PerformanceCommand& command) const override;
+    u32 Estimate(const ClearMixBufferCommand& command) const override;
+    u32 Estimate(const CopyMixBufferCommand& command) const override;
+    u32 Estimate(const LightLimiterVersion1Command& command) const override;
+    u32 Estimate(const LightLimiterVersion2Command& command) const override;
+    u32 Estimate(const MultiTapBiquadFilterCommand& command) const override;
+    u32 Estimate(const CaptureCommand& command) const override;
+    u32 Estimate(const CompressorCommand& command) const override;
+
+private:
+    template <typename T>
+    u32 Calibrate(const T& command) const {
+        return model.Calibrate(command.type, estimator->Estimate(command));
+    }
+
+    /// Firmware estimator being calibrated
+    std::unique_ptr<ICommandProcessingTimeEstimator> estimator;
+    /// Host processing times measured by the AudioRenderer
+    const HostProcessingTimeModel& model;
+};
+
 } // namespace AudioCore::Renderer
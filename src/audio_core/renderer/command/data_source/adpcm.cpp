@@ -40,6 +40,7 @@ void AdpcmDataSourceVersion1Command::Process(const AudioRenderer::CommandListPro
         .sample_count{processor.sample_count},
         .data_address{data_address},
         .data_size{data_size},
+        .adpcm_cache{processor.adpcm_cache.get()},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
@@ -76,6 +77,7 @@ void AdpcmDataSourceVersion2Command::Process(const AudioRenderer::CommandListPro
         .sample_count{processor.sample_count},
         .data_address{data_address},
         .data_size{data_size},
+        .adpcm_cache{processor.adpcm_cache.get()},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "audio_core/renderer/command/data_source/adpcm_decode_cache.h"
+
+namespace AudioCore::Renderer {
+namespace {
+constexpr u32 SamplesPerFrame = 14;
+} // namespace
+
+VoiceState::AdpcmContext AdpcmDecodeCache::Entry::ContextAt(const u32 offset) const {
+    if (offset == 0) {
+        return initial_context;
+    }
+
+    // The header in use is the one of the frame holding the last decoded sample. If the range
+    // starts partway through that frame, its header was never read and it is the initial one.
+    const auto last_position{start_offset + offset - 1};
+    const auto frame{last_position / SamplesPerFrame - start_offset / SamplesPerFrame};
+    const bool header_read{frame != 0 || start_offset % SamplesPerFrame == 0};
+
+    return {
+        .header = header_read ? u16{headers[frame]} : initial_context.header,
+        .yn0 = samples[offset - 1],
+        .yn1 = offset >= 2 ? samples[offset - 2] : initial_context.yn0,
+    };
+}
+
+bool AdpcmDecodeCache::Entry::Matches(const u32 offset, const VoiceState::AdpcmContext& context,
+                                      const std::array<s16, 16>& coefficients_) const {
+    if (offset >= samples.size() || coefficients != coefficients_) {
+        return false;
+    }
+
+    // At a frame boundary the next header is read from the data, so the one in the context
+    // doesn't affect the output.
+    const auto expected{ContextAt(offset)};
+    const bool header_used{(start_offset + offset) % SamplesPerFrame != 0};
+    return expected.yn0 == context.yn0 && expected.yn1 == context.yn1 &&
+           (!header_used || expected.header == context.header);
+}
+
+AdpcmDecodeCache::Entry* AdpcmDecodeCache::Find(const Key& key) {
+    const auto it{entries.find(key)};
+    if (it == entries.end()) {
+        return nullptr;
+    }
+    it->second.last_use = ++use_counter;
+    return &it->second;
+}
+
+AdpcmDecodeCache::Entry& AdpcmDecodeCache::Insert(const Key& key, Entry&& entry) {
+    if (const auto it{entries.find(key)}; it != entries.end()) {
+        cached_samples -= it->second.samples.size();
+        entries.erase(it);
+    }
+
+    while (!entries.empty() && cached_samples + entry.samples.size() > MaxCachedSamples) {
+        const auto oldest{std::ranges::min_element(
+            entries, {}, [](const auto& pair) { return pair.second.last_use; })};
+        cached_samples -= oldest->second.samples.size();
+        entries.erase(oldest);
+    }
+
+    cached_samples += entry.samples.size();
+    entry.last_use = ++use_counter;
+    return entries.insert_or_assign(key, std::move(entry)).first->second;
+}
+
+void AdpcmDecodeCache::Clear() {
+    entries.clear();
+    cached_samples = 0;
+}
+
+size_t AdpcmDecodeCache::KeyHash::operator()(const Key& key) const noexcept {
+    size_t hash{std::hash<u64>{}(key.buffer)};
+    hash ^= std::hash<u64>{}(key.buffer_size) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<u64>{}((u64{key.start_offset} << 32) | key.end_offset) + 0x9E3779B9 +
+            (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace AudioCore::Renderer
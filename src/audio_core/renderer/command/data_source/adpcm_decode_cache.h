@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Bounded cache of decoded ADPCM wave buffers.
+ *
+ * Games replay the same short ADPCM sound effects and loops over and over, each time decoding them
+ * again. Decoding is a function of the wave buffer data, the coefficients and the context it
+ * starts from, so a wave buffer range decoded once can be reused whenever those match.
+ *
+ * Entries are keyed by the guest range they were decoded from, and keep a hash of the data so a
+ * range rewritten by the game is decoded again the next time it is started. The least recently
+ * used entries are evicted once the cache holds more than MaxCachedSamples samples.
+ */
+class AdpcmDecodeCache {
+public:
+    /// Largest wave buffer range which is cached, longer ones are always decoded as they play
+    static constexpr u32 MaxEntrySamples = 1 << 17;
+    /// Total number of decoded samples kept across all entries
+    static constexpr u64 MaxCachedSamples = 1 << 23;
+
+    struct Key {
+        CpuAddr buffer;
+        u64 buffer_size;
+        u32 start_offset;
+        u32 end_offset;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct Entry {
+        /**
+         * Get the decoder context after decoding the first samples of this entry.
+         *
+         * @param offset - Number of samples decoded from the start of the range.
+         * @return The decoder context at offset.
+         */
+        VoiceState::AdpcmContext ContextAt(u32 offset) const;
+
+        /**
+         * Check if decoding from offset with the given context and coefficients produces the
+         * same samples as this entry.
+         *
+         * @param offset        - Number of samples decoded from the start of the range.
+         * @param context       - Decoder context at offset.
+         * @param coefficients_ - Coefficients to decode with.
+         * @return True if the entry's samples from offset onwards can be used.
+         */
+        bool Matches(u32 offset, const VoiceState::AdpcmContext& context,
+                     const std::array<s16, 16>& coefficients_) const;
+
+        /// Hash of the wave buffer data the samples were decoded from
+        u64 data_hash;
+        /// Coefficients the samples were decoded with
+        std::array<s16, 16> coefficients;
+        /// Decoder context at the start of the range
+        VoiceState::AdpcmContext initial_context;
+        /// Start offset of the range, in samples
+        u32 start_offset;
+        /// Decoded samples of the range
+        std::vector<s16> samples;
+        /// Header of each frame the range touches, starting at the frame of start_offset
+        std::vector<u8> headers;
+        /// Use counter value of the last lookup, for eviction
+        u64 last_use;
+    };
+
+    /**
+     * Find the entry for a wave buffer range.
+     *
+     * @param key - Wave buffer range to look up.
+     * @return The entry, or nullptr if the range is not cached.
+     */
+    Entry* Find(const Key& key);
+
+    /**
+     * Add or replace the entry for a wave buffer range, evicting old entries to stay in budget.
+     *
+     * @param key   - Wave buffer range the entry was decoded from.
+     * @param entry - The decoded entry.
+     * @return The entry in the cache.
+     */
+    Entry& Insert(const Key& key, Entry&& entry);
+
+    /**
+     * Remove all entries.
+     */
+    void Clear();
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    /// Total number of samples held by the entries
+    u64 cached_samples{};
+    /// Incremented on each lookup, entries with the lowest last_use are evicted first
+    u64 use_counter{};
+};
+
+} // namespace AudioCore::Renderer
@@ -4,9 +4,11 @@
 #include <array>
 #include <vector>
 
+#include "audio_core/renderer/command/data_source/adpcm_decode_cache.h"
 #include "audio_core/renderer/command/data_source/decode.h"
 #include "audio_core/renderer/command/resample/resample.h"
 #include "common/fixed_point.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/scratch_buffer.h"
 #include "core/guest_memory.h"
@@ -21,13 +23,14 @@ constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
  * Decode PCM data. Only s16 or f32 is supported.
  *
  * @tparam T         - Type to decode. Only s16 and f32 are supported.
+ * @tparam Out       - Type of the output, s16 for the temporary buffer or s32 for a mix buffer.
  * @param memory     - Core memory for reading samples.
- * @param out_buffer - Output mix buffer to receive the samples.
+ * @param out_buffer - Output buffer to receive the samples.
  * @param req        - Information for how to decode.
  * @return Number of samples decoded.
  */
-template <typename T>
-static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
+template <typename T, typename Out>
+static u32 DecodePcm(Core::Memory::Memory& memory, std::span<Out> out_buffer,
                      const DecodeArg& req) {
     constexpr s32 min{std::numeric_limits<s16>::min()};
     constexpr s32 max{std::numeric_limits<s16>::max()};
@@ -82,8 +85,10 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                                              std::numeric_limits<s16>::max())};
                 out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
             }
-        } else {
+        } else if constexpr (std::is_same_v<Out, s16>) {
             std::memcpy(out_buffer.data(), samples.data(), samples_to_decode * sizeof(s16));
+        } else {
+            std::copy_n(samples.data(), samples_to_decode, out_buffer.data());
         }
         break;
     }
@@ -220,6 +225,100 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
     return samples_to_process;
 }
 
+/**
+ * Decode ADPCM data through the decode cache.
+ * When a wave buffer range is started, its data is hashed and the whole range is decoded into
+ * the cache unless a matching entry exists. Later reads from the range are copied from the entry.
+ * Ranges which can't be cached are decoded with DecodeAdpcm.
+ *
+ * @param memory     - Core memory for reading samples.
+ * @param cache      - Cache of decoded wave buffers.
+ * @param out_buffer - Output mix buffer to receive the samples.
+ * @param req        - Information for how to decode.
+ * @return Number of samples decoded.
+ */
+static u32 DecodeAdpcmCached(Core::Memory::Memory& memory, AdpcmDecodeCache& cache,
+                             std::span<s16> out_buffer, const DecodeArg& req) {
+    constexpr u32 SamplesPerFrame{14};
+    constexpr u32 BytesPerFrame{8};
+
+    const auto range_samples{req.end_offset - req.start_offset};
+    if (req.buffer == 0 || req.end_offset <= req.start_offset ||
+        req.offset >= range_samples || range_samples > AdpcmDecodeCache::MaxEntrySamples) {
+        return DecodeAdpcm(memory, out_buffer, req);
+    }
+
+    // Bytes of the frames holding the range. The header of the first frame is included even if
+    // the range starts after it, the decoder simply doesn't read it.
+    const auto first_byte{(req.start_offset / SamplesPerFrame) * BytesPerFrame};
+    const auto last_sample{req.end_offset - 1};
+    const auto last_byte{(last_sample / SamplesPerFrame) * BytesPerFrame + 1 +
+                         (last_sample % SamplesPerFrame) / 2};
+    if (req.buffer_size <= last_byte) {
+        return DecodeAdpcm(memory, out_buffer, req);
+    }
+
+    const AdpcmDecodeCache::Key key{
+        .buffer = req.buffer,
+        .buffer_size = req.buffer_size,
+        .start_offset = req.start_offset,
+        .end_offset = req.end_offset,
+    };
+    auto* entry{cache.Find(key)};
+
+    // The data is only checked when the range is started, it is too costly to hash on every read.
+    if (req.offset == 0) {
+        Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> data(
+            memory, req.buffer + first_byte, last_byte - first_byte + 1);
+        const auto data_hash{Common::RuntimeHash64(data.data(), data.size())};
+
+        if (!entry || entry->data_hash != data_hash ||
+            !entry->Matches(0, *req.adpcm_context, req.coefficients)) {
+            AdpcmDecodeCache::Entry new_entry{
+                .data_hash = data_hash,
+                .coefficients = req.coefficients,
+                .initial_context = *req.adpcm_context,
+                .start_offset = req.start_offset,
+                .samples = std::vector<s16>(range_samples),
+                .headers = {},
+                .last_use = 0,
+            };
+            for (u32 byte = 0; byte < data.size(); byte += BytesPerFrame) {
+                new_entry.headers.push_back(data[byte]);
+            }
+
+            // Decode in pieces no larger than a normal read, DecodeAdpcm reads past what it needs
+            // in proportion to the samples requested.
+            auto context{*req.adpcm_context};
+            auto chunk_arg{req};
+            chunk_arg.adpcm_context = &context;
+            for (u32 decoded = 0; decoded < range_samples;) {
+                chunk_arg.offset = decoded;
+                chunk_arg.samples_to_read = std::min(range_samples - decoded, TempBufferSize);
+                const auto count{DecodeAdpcm(
+                    memory, std::span<s16>{new_entry.samples}.subspan(decoded), chunk_arg)};
+                if (count == 0) {
+                    return DecodeAdpcm(memory, out_buffer, req);
+                }
+                decoded += count;
+            }
+            entry = &cache.Insert(key, std::move(new_entry));
+        }
+    } else if (!entry || !entry->Matches(req.offset, *req.adpcm_context, req.coefficients)) {
+        return DecodeAdpcm(memory, out_buffer, req);
+    }
+
+    const auto samples_to_process{std::min(range_samples - req.offset, req.samples_to_read)};
+    if (samples_to_process == 0) {
+        return 0;
+    }
+    std::memcpy(out_buffer.data(), &entry->samples[req.offset],
+                samples_to_process * sizeof(s16));
+    *req.adpcm_context = entry->ContextAt(req.offset + samples_to_process);
+
+    return samples_to_process;
+}
+
 /**
  * Decode implementation.
  * Decode wavebuffers according to the given args.
@@ -270,7 +369,13 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     u32 offset{voice_state.offset};
 
     auto output_buffer{args.output};
-    std::array<s16, TempBufferSize> temp_buffer{};
+    // Only the parts written by the decoders are read back, so this doesn't need clearing.
+    std::array<s16, TempBufferSize> temp_buffer;
+
+    // When pitch and SRC are skipped, PCM samples are read from guest memory straight into the
+    // output rather than being staged in temp_buffer first.
+    const bool pcm_to_output{args.IsVoicePitchAndSrcSkippedSupported &&
+                             args.sample_format != SampleFormat::Adpcm};
 
     while (remaining_sample_count > 0) {
         const auto samples_to_write{std::min(remaining_sample_count, max_remaining_sample_count)};
@@ -278,6 +383,7 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
             (fraction + samples_to_write * sample_rate_ratio).to_uint_floor()};
 
         u32 temp_buffer_pos{0};
+        const bool decode_to_output{pcm_to_output && samples_to_read <= output_buffer.size()};
 
         if (!args.IsVoicePitchAndSrcSkippedSupported) {
             for (u32 i = 0; i < pitch; i++) {
@@ -334,23 +440,42 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
 
             switch (args.sample_format) {
             case SampleFormat::PcmInt16:
-                samples_decoded = DecodePcm<s16>(
-                    memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
-                    decode_arg);
+                if (decode_to_output) {
+                    samples_decoded =
+                        DecodePcm<s16>(memory, output_buffer.subspan(samples_read), decode_arg);
+                } else {
+                    samples_decoded = DecodePcm<s16>(
+                        memory,
+                        std::span<s16>{&temp_buffer[temp_buffer_pos],
+                                       TempBufferSize - temp_buffer_pos},
+                        decode_arg);
+                }
                 break;
 
             case SampleFormat::PcmFloat:
-                samples_decoded = DecodePcm<f32>(
-                    memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
-                    decode_arg);
+                if (decode_to_output) {
+                    samples_decoded =
+                        DecodePcm<f32>(memory, output_buffer.subspan(samples_read), decode_arg);
+                } else {
+                    samples_decoded = DecodePcm<f32>(
+                        memory,
+                        std::span<s16>{&temp_buffer[temp_buffer_pos],
+                                       TempBufferSize - temp_buffer_pos},
+                        decode_arg);
+                }
                 break;
 
             case SampleFormat::Adpcm: {
                 decode_arg.adpcm_context = &voice_state.adpcm_context;
                 memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
-                samples_decoded = DecodeAdpcm(
-                    memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
-                    decode_arg);
+                const std::span<s16> out{&temp_buffer[temp_buffer_pos],
+                                         TempBufferSize - temp_buffer_pos};
+                if (args.adpcm_cache) {
+                    samples_decoded =
+                        DecodeAdpcmCached(memory, *args.adpcm_cache, out, decode_arg);
+                } else {
+                    samples_decoded = DecodeAdpcm(memory, out, decode_arg);
+                }
             } break;
 
             default:
@@ -393,11 +518,13 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
         }
 
         if (args.IsVoicePitchAndSrcSkippedSupported) {
-            if (samples_read > output_buffer.size()) {
-                LOG_ERROR(Service_Audio, "Attempting to write past the end of output buffer!");
-            }
-            for (u32 i = 0; i < samples_read; i++) {
-                output_buffer[i] = temp_buffer[i];
+            if (!decode_to_output) {
+                if (samples_read > output_buffer.size()) {
+                    LOG_ERROR(Service_Audio, "Attempting to write past the end of output buffer!");
+                }
+                for (u32 i = 0; i < samples_read; i++) {
+                    output_buffer[i] = temp_buffer[i];
+                }
             }
         } else {
             std::memset(&temp_buffer[temp_buffer_pos], 0,
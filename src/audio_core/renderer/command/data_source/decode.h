@@ -16,6 +16,7 @@ class Memory;
 }
 
 namespace AudioCore::Renderer {
+class AdpcmDecodeCache;
 
 struct DecodeFromWaveBuffersArgs {
     SampleFormat sample_format;
@@ -31,6 +32,7 @@ struct DecodeFromWaveBuffersArgs {
     u32 sample_count;
     CpuAddr data_address;
     u64 data_size;
+    AdpcmDecodeCache* adpcm_cache;
     bool IsVoicePlayedSampleCountResetAtLoopPointSupported;
     bool IsVoicePitchAndSrcSkippedSupported;
 };
@@ -41,6 +41,7 @@ void PcmFloatDataSourceVersion1Command::Process(
         .sample_count{processor.sample_count},
         .data_address{0},
         .data_size{0},
+        .adpcm_cache{nullptr},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
@@ -81,6 +82,7 @@ void PcmFloatDataSourceVersion2Command::Process(
         .sample_count{processor.sample_count},
         .data_address{0},
         .data_size{0},
+        .adpcm_cache{nullptr},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
@@ -43,6 +43,7 @@ void PcmInt16DataSourceVersion1Command::Process(
         .sample_count{processor.sample_count},
         .data_address{0},
         .data_size{0},
+        .adpcm_cache{nullptr},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
@@ -82,6 +83,7 @@ void PcmInt16DataSourceVersion2Command::Process(
         .sample_count{processor.sample_count},
         .data_address{0},
         .data_size{0},
+        .adpcm_cache{nullptr},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
     };
@@ -236,6 +236,18 @@ static Common::FixedPoint<50, 14> Axfx2AllPassTick(ReverbInfo::ReverbDelayLine&
     return out;
 }
 
+/**
+ * Divide a sample by 64, rounding towards zero like FixedPoint division. FixedPoint<50, 14> has no
+ * larger type to divide in, so its division runs bit by bit, which is too slow to do for every
+ * output sample.
+ *
+ * @param sample - The sample to divide.
+ * @return The divided sample.
+ */
+static Common::FixedPoint<50, 14> DivideBy64(const Common::FixedPoint<50, 14> sample) {
+    return Common::FixedPoint<50, 14>::from_base(sample.to_raw() / 64);
+}
+
 /**
  * Impl. Apply a Reverb according to the current state, on the input mix buffers,
  * saving the results to the output mix buffers.
@@ -343,14 +355,14 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
                     allpass = allpass_outputs[channel];
                 }
 
-                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
+                auto out_sample{DivideBy64((output_samples[channel] + allpass) * wet_gain)};
                 outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         } else {
             for (u32 channel = 0; channel < NumChannels; channel++) {
                 auto in_sample{inputs[channel][sample_index] * dry_gain};
-                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
-                                64};
+                auto out_sample{
+                    DivideBy64((output_samples[channel] + allpass_samples[channel]) * wet_gain)};
                 outputs[channel][sample_index] = (in_sample + out_sample).to_int();
             }
         }
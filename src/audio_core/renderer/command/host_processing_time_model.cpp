@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "audio_core/renderer/command/host_processing_time_model.h"
+
+namespace AudioCore::Renderer {
+namespace {
+/// The renderer time limits assume 2,880,000 DSP cycles per 5ms frame
+constexpr f32 DspCyclesPerNs = 0.576f;
+/// Weight of each new measurement in the running scales
+constexpr f32 SmoothingFactor = 1.0f / 64.0f;
+/// Bounds of the scales, so a single preempted command cannot skew the model
+constexpr f32 MinScale = 1.0f / 64.0f;
+constexpr f32 MaxScale = 64.0f;
+} // namespace
+
+HostProcessingTimeModel::HostProcessingTimeModel() {
+    for (auto& scale : scales) {
+        scale.store(1.0f, std::memory_order_relaxed);
+    }
+}
+
+void HostProcessingTimeModel::Record(const CommandId type, const u32 estimated_time,
+                                     const u64 host_time_ns) {
+    const auto index{static_cast<size_t>(type)};
+    if (estimated_time == 0 || index >= scales.size()) {
+        return;
+    }
+
+    // Estimates have already been scaled when the command was generated, so how far off the
+    // estimate was gives a correction for the current scale.
+    auto& scale{scales[index]};
+    const auto current{scale.load(std::memory_order_relaxed)};
+    const auto host_time{static_cast<f32>(host_time_ns) * DspCyclesPerNs};
+    const auto observed{
+        std::clamp(current * host_time / static_cast<f32>(estimated_time), MinScale, MaxScale)};
+    scale.store(current + (observed - current) * SmoothingFactor, std::memory_order_relaxed);
+}
+
+u32 HostProcessingTimeModel::Calibrate(const CommandId type, const u32 estimated_time) const {
+    const auto index{static_cast<size_t>(type)};
+    if (index >= scales.size()) {
+        return estimated_time;
+    }
+    const auto scale{scales[index].load(std::memory_order_relaxed)};
+    return static_cast<u32>(static_cast<f32>(estimated_time) * scale);
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "audio_core/renderer/command/icommand.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Running model of how long each command type takes to process on the host, relative to its
+ * estimated processing time.
+ *
+ * The estimators model the cycle costs of the console's DSP, which can be far off for the host
+ * rendering the commands. The AudioRenderer records how long each command actually took, and the
+ * model keeps a smoothed scale per command type that maps estimates to host time, expressed in
+ * DSP cycles so the renderer time limits still apply.
+ *
+ * Recording happens on the AudioRenderer thread while the renderer system reads the scales when
+ * generating commands, so the scales are kept in relaxed atomics.
+ */
+class HostProcessingTimeModel {
+public:
+    HostProcessingTimeModel();
+
+    /**
+     * Record the host time taken by a command.
+     *
+     * @param type           - Type of the processed command.
+     * @param estimated_time - Estimated processing time of the command, in DSP cycles.
+     * @param host_time_ns   - Time the host took to process the command, in nanoseconds.
+     */
+    void Record(CommandId type, u32 estimated_time, u64 host_time_ns);
+
+    /**
+     * Scale an estimated processing time to the expected host processing time.
+     *
+     * @param type           - Type of the command.
+     * @param estimated_time - Estimated processing time of the command, in DSP cycles.
+     *
+     * @return Expected host processing time, in DSP cycles.
+     */
+    u32 Calibrate(CommandId type, u32 estimated_time) const;
+
+private:
+    /// Number of command types, CommandId::Compressor is the last one
+    static constexpr size_t CommandTypeCount = static_cast<size_t>(CommandId::Compressor) + 1;
+
+    /// Current host time per estimated DSP cycle for each command type, starting out at 1
+    std::array<std::atomic<f32>, CommandTypeCount> scales{};
+};
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,266 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+namespace AudioCore::Renderer::MixKernels {
+namespace {
+
+// Mirrors FixedPoint<64 - Q, Q>: the product of a sample and a raw volume is rounded half up by
+// to_int, and only the low 32 bits of the result are kept. Unsigned arithmetic gives the same
+// wrapping without the undefined behaviour.
+template <size_t Q>
+s32 ApplyVolume(s32 sample, u64 volume) {
+    constexpr u64 FractionalMask = (u64{1} << Q) - 1;
+    const u64 product = static_cast<u64>(static_cast<s64>(sample)) * volume;
+    return static_cast<s32>((product + ((product & FractionalMask) >> 1)) >> Q);
+}
+
+s32 AddWrapping(s32 lhs, s32 rhs) {
+    return static_cast<s32>(static_cast<u32>(lhs) + static_cast<u32>(rhs));
+}
+
+template <size_t Q, bool Accumulate>
+void ProcessScalar(s32* output, const s32* input, u64 volume, u64 ramp, u32 sample_count) {
+    for (u32 i = 0; i < sample_count; i++) {
+        const s32 sample = ApplyVolume<Q>(input[i], volume);
+        output[i] = Accumulate ? AddWrapping(output[i], sample) : sample;
+        volume += ramp;
+    }
+}
+
+// The vector kernels multiply 32-bit lanes into 64-bit products, so they can only be used when
+// every volume of the ramp fits in 32 bits. Volumes are then kept in 32-bit lanes, where adding
+// the ramp wraps around to the same values as the 64-bit sum.
+bool FitsInLanes(s64 volume, s64 ramp, u32 sample_count) {
+    constexpr s64 Min = std::numeric_limits<s32>::min();
+    constexpr s64 Max = std::numeric_limits<s32>::max();
+    if (volume < Min || volume > Max || ramp < Min || ramp > Max) {
+        return false;
+    }
+    const s64 last_volume = volume + ramp * static_cast<s64>(sample_count);
+    return last_volume >= Min && last_volume <= Max;
+}
+
+#ifdef ARCHITECTURE_x86_64
+#ifdef _MSC_VER
+#define SSE41_FUNCTION
+#define AVX2_FUNCTION
+#else
+#define SSE41_FUNCTION __attribute__((target("sse4.1")))
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+template <size_t Q>
+SSE41_FUNCTION __m128i RoundSse41(__m128i product) {
+    const __m128i fractional_mask = _mm_set1_epi64x((s64{1} << Q) - 1);
+    const __m128i half = _mm_srli_epi64(_mm_and_si128(product, fractional_mask), 1);
+    return _mm_srli_epi64(_mm_add_epi64(product, half), Q);
+}
+
+template <size_t Q>
+SSE41_FUNCTION __m128i ApplyVolumeSse41(__m128i samples, __m128i volumes) {
+    const __m128i even = _mm_mul_epi32(samples, volumes);
+    const __m128i odd = _mm_mul_epi32(_mm_srli_epi64(samples, 32), _mm_srli_epi64(volumes, 32));
+    return _mm_blend_epi16(RoundSse41<Q>(even), _mm_slli_epi64(RoundSse41<Q>(odd), 32), 0xCC);
+}
+
+template <size_t Q, bool Accumulate>
+SSE41_FUNCTION u32 ProcessSse41(s32* output, const s32* input, u32 volume, u32 ramp,
+                                u32 sample_count) {
+    constexpr u32 Lanes = 4;
+    __m128i volumes = _mm_setr_epi32(static_cast<s32>(volume), static_cast<s32>(volume + ramp),
+                                     static_cast<s32>(volume + ramp * 2),
+                                     static_cast<s32>(volume + ramp * 3));
+    const __m128i step = _mm_set1_epi32(static_cast<s32>(ramp * Lanes));
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i result = ApplyVolumeSse41<Q>(samples, volumes);
+        if constexpr (Accumulate) {
+            result = _mm_add_epi32(result,
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+        volumes = _mm_add_epi32(volumes, step);
+    }
+    return i;
+}
+
+template <size_t Q>
+AVX2_FUNCTION __m256i RoundAvx2(__m256i product) {
+    const __m256i fractional_mask = _mm256_set1_epi64x((s64{1} << Q) - 1);
+    const __m256i half = _mm256_srli_epi64(_mm256_and_si256(product, fractional_mask), 1);
+    return _mm256_srli_epi64(_mm256_add_epi64(product, half), Q);
+}
+
+template <size_t Q>
+AVX2_FUNCTION __m256i ApplyVolumeAvx2(__m256i samples, __m256i volumes) {
+    const __m256i even = _mm256_mul_epi32(samples, volumes);
+    const __m256i odd =
+        _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), _mm256_srli_epi64(volumes, 32));
+    return _mm256_blend_epi32(RoundAvx2<Q>(even), _mm256_slli_epi64(RoundAvx2<Q>(odd), 32), 0xAA);
+}
+
+template <size_t Q, bool Accumulate>
+AVX2_FUNCTION u32 ProcessAvx2(s32* output, const s32* input, u32 volume, u32 ramp,
+                              u32 sample_count) {
+    constexpr u32 Lanes = 8;
+    const __m256i lane_steps = _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<s32>(ramp)),
+                                                  _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i volumes = _mm256_add_epi32(_mm256_set1_epi32(static_cast<s32>(volume)), lane_steps);
+    const __m256i step = _mm256_set1_epi32(static_cast<s32>(ramp * Lanes));
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i result = ApplyVolumeAvx2<Q>(samples, volumes);
+        if constexpr (Accumulate) {
+            result = _mm256_add_epi32(
+                result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), result);
+        volumes = _mm256_add_epi32(volumes, step);
+    }
+    return i;
+}
+#elif defined(ARCHITECTURE_arm64)
+template <size_t Q>
+uint32x2_t RoundNeon(int64x2_t product) {
+    const uint64x2_t bits = vreinterpretq_u64_s64(product);
+    const uint64x2_t half = vshrq_n_u64(vandq_u64(bits, vdupq_n_u64((u64{1} << Q) - 1)), 1);
+    return vmovn_u64(vshrq_n_u64(vaddq_u64(bits, half), Q));
+}
+
+template <size_t Q>
+int32x4_t ApplyVolumeNeon(int32x4_t samples, int32x4_t volumes) {
+    const int64x2_t low = vmull_s32(vget_low_s32(samples), vget_low_s32(volumes));
+    const int64x2_t high = vmull_high_s32(samples, volumes);
+    return vreinterpretq_s32_u32(vcombine_u32(RoundNeon<Q>(low), RoundNeon<Q>(high)));
+}
+
+template <size_t Q, bool Accumulate>
+u32 ProcessNeon(s32* output, const s32* input, u32 volume, u32 ramp, u32 sample_count) {
+    constexpr u32 Lanes = 4;
+    const u32 initial_volumes[Lanes]{volume, volume + ramp, volume + ramp * 2, volume + ramp * 3};
+    int32x4_t volumes = vreinterpretq_s32_u32(vld1q_u32(initial_volumes));
+    const int32x4_t step = vdupq_n_s32(static_cast<s32>(ramp * Lanes));
+
+    u32 i = 0;
+    for (; i + Lanes <= sample_count; i += Lanes) {
+        int32x4_t result = ApplyVolumeNeon<Q>(vld1q_s32(input + i), volumes);
+        if constexpr (Accumulate) {
+            result = vaddq_s32(result, vld1q_s32(output + i));
+        }
+        vst1q_s32(output + i, result);
+        volumes = vaddq_s32(volumes, step);
+    }
+    return i;
+}
+#endif
+
+template <size_t Q, bool Accumulate>
+void Process(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+             u32 sample_count, Backend backend) {
+    u32 processed = 0;
+    if (backend != Backend::Scalar && IsSupported(backend) &&
+        FitsInLanes(volume, ramp, sample_count)) {
+        [[maybe_unused]] const auto lane_volume = static_cast<u32>(volume);
+        [[maybe_unused]] const auto lane_ramp = static_cast<u32>(ramp);
+        switch (backend) {
+#ifdef ARCHITECTURE_x86_64
+        case Backend::Sse41:
+            processed = ProcessSse41<Q, Accumulate>(output.data(), input.data(), lane_volume,
+                                                    lane_ramp, sample_count);
+            break;
+        case Backend::Avx2:
+            processed = ProcessAvx2<Q, Accumulate>(output.data(), input.data(), lane_volume,
+                                                   lane_ramp, sample_count);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case Backend::Neon:
+            processed = ProcessNeon<Q, Accumulate>(output.data(), input.data(), lane_volume,
+                                                   lane_ramp, sample_count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+
+    // The samples left over by the vector kernels continue the ramp where they stopped.
+    const u64 volume_bits = static_cast<u64>(volume) + static_cast<u64>(ramp) * processed;
+    ProcessScalar<Q, Accumulate>(output.data() + processed, input.data() + processed,
+                                 volume_bits, static_cast<u64>(ramp), sample_count - processed);
+}
+
+} // Anonymous namespace
+
+Backend GetBackend() {
+    static const Backend backend = [] {
+        for (const auto candidate : {Backend::Avx2, Backend::Sse41, Backend::Neon}) {
+            if (IsSupported(candidate)) {
+                return candidate;
+            }
+        }
+        return Backend::Scalar;
+    }();
+    return backend;
+}
+
+bool IsSupported(Backend backend) {
+    switch (backend) {
+    case Backend::Scalar:
+        return true;
+#ifdef ARCHITECTURE_x86_64
+    case Backend::Sse41:
+        return Common::GetCPUCaps().sse4_1;
+    case Backend::Avx2:
+        return Common::GetCPUCaps().avx2;
+#elif defined(ARCHITECTURE_arm64)
+    case Backend::Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+template <size_t Q>
+s32 MixRamp(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+            u32 sample_count, Backend backend) {
+    if (sample_count == 0) {
+        return 0;
+    }
+
+    // The input may be the output buffer, so the last sample is taken before it is mixed into.
+    const u64 last_volume =
+        static_cast<u64>(volume) + static_cast<u64>(ramp) * (sample_count - 1);
+    const s32 last_sample = ApplyVolume<Q>(input[sample_count - 1], last_volume);
+
+    Process<Q, true>(output, input, volume, ramp, sample_count, backend);
+    return last_sample;
+}
+
+template <size_t Q>
+void VolumeRamp(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+                u32 sample_count, Backend backend) {
+    Process<Q, false>(output, input, volume, ramp, sample_count, backend);
+}
+
+template s32 MixRamp<15>(std::span<s32>, std::span<const s32>, s64, s64, u32, Backend);
+template s32 MixRamp<23>(std::span<s32>, std::span<const s32>, s64, s64, u32, Backend);
+template void VolumeRamp<15>(std::span<s32>, std::span<const s32>, s64, s64, u32, Backend);
+template void VolumeRamp<23>(std::span<s32>, std::span<const s32>, s64, s64, u32, Backend);
+
+} // namespace AudioCore::Renderer::MixKernels
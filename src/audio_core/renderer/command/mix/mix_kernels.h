@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer::MixKernels {
+
+/// Instruction sets the mix kernels are implemented with.
+enum class Backend {
+    Scalar,
+    Sse41,
+    Avx2,
+    Neon,
+};
+
+/**
+ * Get the fastest backend supported by the host CPU.
+ *
+ * @return The backend used when none is given to a kernel.
+ */
+Backend GetBackend();
+
+/**
+ * Check if a backend can be used on the host CPU.
+ *
+ * @param backend - Backend to check.
+ * @return True if the backend is supported.
+ */
+bool IsSupported(Backend backend);
+
+/**
+ * Mix an input mix buffer into an output mix buffer, with a linearly ramping volume applied to
+ * the input. Results are bit-exact with Common::FixedPoint<64 - Q, Q> arithmetic on every backend.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer.
+ * @param volume       - Volume applied to the first sample, as a raw fixed point value.
+ * @param ramp         - Added to the volume after every sample, as a raw fixed point value.
+ * @param sample_count - Number of samples to process.
+ * @param backend      - Backend to process with.
+ * @return The last input sample with the volume applied, or 0 if no samples were processed.
+ */
+template <size_t Q>
+s32 MixRamp(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+            u32 sample_count, Backend backend = GetBackend());
+
+/**
+ * Apply a linearly ramping volume to an input mix buffer, saving to an output mix buffer.
+ * Results are bit-exact with Common::FixedPoint<64 - Q, Q> arithmetic on every backend.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer.
+ * @param volume       - Volume applied to the first sample, as a raw fixed point value.
+ * @param ramp         - Added to the volume after every sample, as a raw fixed point value.
+ * @param sample_count - Number of samples to process.
+ * @param backend      - Backend to process with.
+ */
+template <size_t Q>
+void VolumeRamp(std::span<s32> output, std::span<const s32> input, s64 volume, s64 ramp,
+                u32 sample_count, Backend backend = GetBackend());
+
+} // namespace AudioCore::Renderer::MixKernels
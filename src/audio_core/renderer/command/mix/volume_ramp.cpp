@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/mix/mix_kernels.h"
 #include "audio_core/renderer/command/mix/volume_ramp.h"
 #include "common/fixed_point.h"
 
@@ -23,18 +24,10 @@ static void ApplyLinearEnvelopeGain(std::span<s32> output, std::span<const s32>
         std::memset(output.data(), 0, output.size_bytes());
     } else if (volume == 1.0f && ramp_ == 0.0f) {
         std::memcpy(output.data(), input.data(), output.size_bytes());
-    } else if (ramp_ == 0.0f) {
-        const Common::FixedPoint<64 - Q, Q> gain{volume};
-        for (u32 i = 0; i < sample_count; i++) {
-            output[i] = (input[i] * gain).to_int();
-        }
     } else {
-        Common::FixedPoint<64 - Q, Q> gain{volume};
+        const Common::FixedPoint<64 - Q, Q> gain{volume};
         const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
-        for (u32 i = 0; i < sample_count; i++) {
-            output[i] = (input[i] * gain).to_int();
-            gain += ramp;
-        }
+        MixKernels::VolumeRamp<Q>(output, input, gain.to_raw(), ramp.to_raw(), sample_count);
     }
 }
 
@@ -3,8 +3,186 @@
 
 #include "audio_core/renderer/command/resample/resample.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 namespace AudioCore::Renderer {
 
+/**
+ * Number of output samples the vectorized polyphase filters compute per iteration.
+ */
+constexpr u32 PolyphaseBatchSize = 4;
+
+/**
+ * Position of the filter for one output sample.
+ */
+struct PolyphasePosition {
+    u32 read_index;
+    u32 lut_index;
+};
+
+/**
+ * Get the filter position for the next output sample, and step the read position forward.
+ *
+ * @tparam Taps             - Number of filter taps per phase.
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction.
+ * @param read_index        - Current read index into the input.
+ * @return The filter position for the output sample.
+ */
+template <size_t Taps>
+static PolyphasePosition StepPolyphase(const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                                       Common::FixedPoint<49, 15>& fraction, u32& read_index) {
+    const PolyphasePosition position{read_index,
+                                     static_cast<u32>((fraction.get_frac() >> 8) * Taps)};
+    fraction += sample_rate_ratio;
+    read_index += static_cast<u32>(fraction.to_int_floor());
+    fraction.clear_int();
+    return position;
+}
+
+#ifdef ARCHITECTURE_x86_64
+#ifdef _MSC_VER
+#define SSE41_FUNCTION
+#else
+#define SSE41_FUNCTION __attribute__((target("sse4.1")))
+#endif
+
+/**
+ * Multiply 4 input samples by 4 filter coefficients, truncating each product to FixedPoint<56, 8>
+ * like the scalar filter does.
+ */
+SSE41_FUNCTION static __m128i ApplyTapsSse41(__m128i samples, const f32* coeffs) {
+    const __m128 products = _mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_loadu_ps(coeffs));
+    return _mm_cvttps_epi32(_mm_mul_ps(products, _mm_set1_ps(256.0f)));
+}
+
+template <size_t Taps>
+SSE41_FUNCTION static __m128i ApplyFilterSse41(const s16* input, const f32* coeffs) {
+    if constexpr (Taps == 4) {
+        const __m128i samples =
+            _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)));
+        return ApplyTapsSse41(samples, coeffs);
+    } else {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        const __m128i low = ApplyTapsSse41(_mm_cvtepi16_epi32(samples), coeffs);
+        const __m128i high = ApplyTapsSse41(_mm_cvtepi16_epi32(_mm_srli_si128(samples, 8)),
+                                            coeffs + 4);
+        return _mm_add_epi32(low, high);
+    }
+}
+
+template <size_t Taps>
+SSE41_FUNCTION static u32 ResamplePolyphaseSse41(
+    std::span<s32> output, std::span<const s16> input, std::span<const f32> lut,
+    const Common::FixedPoint<49, 15>& sample_rate_ratio, Common::FixedPoint<49, 15>& fraction,
+    u32& read_index, const u32 samples_to_write) {
+    u32 i{0};
+    for (; i + PolyphaseBatchSize <= samples_to_write; i += PolyphaseBatchSize) {
+        __m128i sums[PolyphaseBatchSize];
+        for (auto& sum : sums) {
+            const auto position{StepPolyphase<Taps>(sample_rate_ratio, fraction, read_index)};
+            sum = ApplyFilterSse41<Taps>(&input[position.read_index], &lut[position.lut_index]);
+        }
+        // Reduce the taps of each output sample, leaving one output sample per lane.
+        const __m128i sum01 = _mm_hadd_epi32(sums[0], sums[1]);
+        const __m128i sum23 = _mm_hadd_epi32(sums[2], sums[3]);
+        const __m128i result = _mm_srai_epi32(_mm_hadd_epi32(sum01, sum23), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), result);
+    }
+    return i;
+}
+#elif defined(ARCHITECTURE_arm64)
+/**
+ * Multiply 4 input samples by 4 filter coefficients, truncating each product to FixedPoint<56, 8>
+ * like the scalar filter does.
+ */
+static int32x4_t ApplyTapsNeon(int16x4_t samples, const f32* coeffs) {
+    const float32x4_t products = vmulq_f32(vcvtq_f32_s32(vmovl_s16(samples)), vld1q_f32(coeffs));
+    return vcvtq_s32_f32(vmulq_n_f32(products, 256.0f));
+}
+
+template <size_t Taps>
+static int32x4_t ApplyFilterNeon(const s16* input, const f32* coeffs) {
+    if constexpr (Taps == 4) {
+        return ApplyTapsNeon(vld1_s16(input), coeffs);
+    } else {
+        const int16x8_t samples = vld1q_s16(input);
+        return vaddq_s32(ApplyTapsNeon(vget_low_s16(samples), coeffs),
+                         ApplyTapsNeon(vget_high_s16(samples), coeffs + 4));
+    }
+}
+
+template <size_t Taps>
+static u32 ResamplePolyphaseNeon(std::span<s32> output, std::span<const s16> input,
+                                 std::span<const f32> lut,
+                                 const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                                 Common::FixedPoint<49, 15>& fraction, u32& read_index,
+                                 const u32 samples_to_write) {
+    u32 i{0};
+    for (; i + PolyphaseBatchSize <= samples_to_write; i += PolyphaseBatchSize) {
+        int32x4_t sums[PolyphaseBatchSize];
+        for (auto& sum : sums) {
+            const auto position{StepPolyphase<Taps>(sample_rate_ratio, fraction, read_index)};
+            sum = ApplyFilterNeon<Taps>(&input[position.read_index], &lut[position.lut_index]);
+        }
+        // Reduce the taps of each output sample, leaving one output sample per lane.
+        const int32x4_t sum01 = vpaddq_s32(sums[0], sums[1]);
+        const int32x4_t sum23 = vpaddq_s32(sums[2], sums[3]);
+        vst1q_s32(&output[i], vshrq_n_s32(vpaddq_s32(sum01, sum23), 8));
+    }
+    return i;
+}
+#endif
+
+/**
+ * Resample with a polyphase filter, where each output sample is the sum of Taps input samples
+ * multiplied by the coefficients of the phase selected by the read fraction.
+ *
+ * Several output samples are filtered per iteration where vector instructions are available.
+ * Each product is truncated to FixedPoint<56, 8> before summing on every path, so the output is
+ * identical to filtering one sample at a time.
+ *
+ * @tparam Taps             - Number of filter taps per phase.
+ * @param output            - Output buffer.
+ * @param input             - Input buffer.
+ * @param lut               - Filter coefficients, Taps per phase.
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction, updated for the next call.
+ * @param samples_to_write  - Number of samples to write.
+ */
+template <size_t Taps>
+static void ResamplePolyphase(std::span<s32> output, std::span<const s16> input,
+                              std::span<const f32> lut,
+                              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                              Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
+    u32 read_index{0};
+    u32 i{0};
+#ifdef ARCHITECTURE_x86_64
+    if (Common::GetCPUCaps().sse4_1) {
+        i = ResamplePolyphaseSse41<Taps>(output, input, lut, sample_rate_ratio, fraction,
+                                         read_index, samples_to_write);
+    }
+#elif defined(ARCHITECTURE_arm64)
+    i = ResamplePolyphaseNeon<Taps>(output, input, lut, sample_rate_ratio, fraction, read_index,
+                                    samples_to_write);
+#endif
+
+    for (; i < samples_to_write; i++) {
+        const auto position{StepPolyphase<Taps>(sample_rate_ratio, fraction, read_index)};
+        Common::FixedPoint<56, 8> sum{0};
+        for (u32 tap = 0; tap < Taps; tap++) {
+            sum += Common::FixedPoint<56, 8>{input[position.read_index + tap] *
+                                             lut[position.lut_index + tap]};
+        }
+        output[i] = sum.to_int_floor();
+    }
+}
+
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
@@ -292,19 +470,7 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 4};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        output[i] = (sample0 + sample1 + sample2 + sample3).to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResamplePolyphase<4>(output, input, get_lut(), sample_rate_ratio, fraction, samples_to_write);
 }
 
 static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
@@ -842,24 +1008,7 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 8};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        const Common::FixedPoint<56, 8> sample4{input[read_index + 4] * lut[lut_index + 4]};
-        const Common::FixedPoint<56, 8> sample5{input[read_index + 5] * lut[lut_index + 5]};
-        const Common::FixedPoint<56, 8> sample6{input[read_index + 6] * lut[lut_index + 6]};
-        const Common::FixedPoint<56, 8> sample7{input[read_index + 7] * lut[lut_index + 7]};
-        output[i] = (sample0 + sample1 + sample2 + sample3 + sample4 + sample5 + sample6 + sample7)
-                        .to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResamplePolyphase<8>(output, input, get_lut(), sample_rate_ratio, fraction, samples_to_write);
 }
 
 void Resample(std::span<s32> output, std::span<const s16> input,
@@ -29,6 +29,7 @@
 #include "audio_core/renderer/voice/voice_info.h"
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/alignment.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_event.h"
@@ -356,7 +357,11 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
     }
 
     render_time_limit_percent = 100;
-    drop_voice = params.voice_drop_enabled && params.execution_mode == ExecutionMode::Auto;
+    // When host timing is enabled, voices are dropped whenever the host can't keep up, even if the
+    // game did not ask for it.
+    host_timed = Settings::values.host_timed_voice_drop.GetValue();
+    drop_voice = (params.voice_drop_enabled || host_timed) &&
+                 params.execution_mode == ExecutionMode::Auto;
     drop_voice_param = 1.0f;
     num_voices_dropped = 0;
 
@@ -394,6 +399,12 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
                                                                      mix_buffer_count);
     }
 
+    if (host_timed) {
+        command_processing_time_estimator =
+            std::make_unique<CommandProcessingTimeEstimatorHostCalibrated>(
+                std::move(command_processing_time_estimator), host_time_model);
+    }
+
     initialized = true;
     return ResultSuccess;
 }
@@ -641,6 +652,7 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
     command_list_header->sample_count = sample_count;
     command_list_header->sample_rate = sample_rate;
     command_list_header->samples_buffer = samples_workbuffer;
+    command_list_header->host_time_model = host_timed ? &host_time_model : nullptr;
 
     const auto performance_initialized{performance_manager.IsInitialized()};
     if (performance_initialized) {
@@ -267,6 +267,10 @@ private:
     SplitterContext splitter_context{};
     /// Estimates the time taken for each command
     std::unique_ptr<ICommandProcessingTimeEstimator> command_processing_time_estimator{};
+    /// Host processing times of each command type, measured by the AudioRenderer
+    HostProcessingTimeModel host_time_model{};
+    /// Are command estimates calibrated to the host processing times?
+    bool host_timed{};
     /// Session id of this system
     s32 session_id{};
     /// Number of channels in use by voices
@@ -1,17 +1,22 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cmath>
 #include <memory>
 #include <span>
+#include <utility>
 #include <vector>
 
 #include "audio_core/audio_core.h"
 #include "audio_core/common/common.h"
 #include "audio_core/sink/sink_stream.h"
 #include "common/common_types.h"
+#include "common/div_ceil.h"
 #include "common/fixed_point.h"
+#include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -19,6 +24,15 @@
 
 namespace AudioCore::Sink {
 
+namespace {
+/// Duration of one queued buffer.
+constexpr f64 BufferDurationUs{TargetSampleCount * 1'000'000.0 / TargetSampleRate};
+/// Fewest buffers the adaptive target queue size shrinks to.
+constexpr u32 MinTargetQueueSize{2};
+/// Time without underruns before the target queue size may shrink.
+constexpr auto StablePeriod{std::chrono::seconds{2}};
+} // Anonymous namespace
+
 void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     SCOPE_EXIT {
         queue.enqueue(buffer);
@@ -225,12 +239,15 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         return;
     }
 
+    bool underran{false};
     while (frames_written < num_frames) {
         // If the playing buffer has been consumed or has no frames, we need a new one
         if (playing_buffer.consumed || playing_buffer.frames == 0) {
             if (!queue.try_dequeue(playing_buffer)) {
                 // If no buffer was available we've underrun, fill the remaining buffer with
                 // the last written frame and continue.
+                underrun_count.fetch_add(1, std::memory_order_relaxed);
+                underran = true;
                 for (size_t i = frames_written; i < num_frames; i++) {
                     std::memcpy(&output_buffer[i * frame_size], &last_frame[0], frame_size_bytes);
                 }
@@ -273,6 +290,59 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         min_played_sample_count = max_played_sample_count;
         max_played_sample_count += actual_frames_written;
     }
+
+    UpdateTargetQueueSize(num_frames, underran);
+}
+
+void SinkStream::UpdateTargetQueueSize(std::size_t num_frames, bool underran) {
+    const auto now{std::chrono::steady_clock::now()};
+    const auto last_time{std::exchange(last_callback_time, now)};
+    if (!Settings::values.adaptive_audio_latency.GetValue() || max_queue_size == 0) {
+        target_queue_size = max_queue_size;
+        return;
+    }
+    if (last_time == std::chrono::steady_clock::time_point{}) {
+        last_adjust_time = now;
+        return;
+    }
+
+    // The callbacks should arrive as often as the frames they request take to play.
+    const f64 interval_us{std::chrono::duration<f64, std::micro>(now - last_time).count()};
+    const f64 expected_us{static_cast<f64>(num_frames) * 1'000'000.0 / TargetSampleRate};
+    callback_jitter_us += (std::abs(interval_us - expected_us) - callback_jitter_us) / 16.0;
+
+    // Each callback drains up to its frame count at once, so the queue must always hold at least
+    // that much, plus the buffer being rendered.
+    const u32 min_size{std::max(
+        MinTargetQueueSize,
+        static_cast<u32>(Common::DivCeil(num_frames, static_cast<size_t>(TargetSampleCount))) +
+            1)};
+    const u32 max_size{std::max(max_queue_size * 2, min_size)};
+    u32 target{std::clamp(target_queue_size.load(std::memory_order_relaxed), min_size, max_size)};
+
+    if (underran) {
+        target = std::min(target + 1, max_size);
+        last_adjust_time = now;
+    } else if (now - last_adjust_time >= StablePeriod) {
+        // Shrink while the jitter fits comfortably within the buffers that would remain.
+        if (target > min_size && callback_jitter_us * 2 < (target - 1) * BufferDurationUs) {
+            target--;
+        }
+        last_adjust_time = now;
+    }
+
+    if (target != target_queue_size.exchange(target, std::memory_order_relaxed)) {
+        LOG_DEBUG(Service_Audio, "{} target queue size is now {} buffers, jitter {:.0f}us", name,
+                  target, callback_jitter_us);
+        { std::scoped_lock lk{release_mutex}; }
+        release_cv.notify_one();
+    }
+}
+
+std::chrono::microseconds SinkStream::GetLatency() const {
+    const u64 channels{std::max<u32>(device_channels, 1)};
+    const u64 frames{samples_buffer.Size() / channels};
+    return std::chrono::microseconds{frames * 1'000'000 / TargetSampleRate};
 }
 
 u64 SinkStream::GetExpectedPlayedSampleCount() {
@@ -288,11 +358,12 @@ u64 SinkStream::GetExpectedPlayedSampleCount() {
 
 void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
     std::unique_lock lk{release_mutex};
-    release_cv.wait_for(lk, std::chrono::milliseconds(5),
-                        [this]() { return paused || queued_buffers < max_queue_size; });
-    if (queued_buffers > max_queue_size + 3) {
-        Common::CondvarWait(release_cv, lk, stop_token,
-                            [this] { return paused || queued_buffers < max_queue_size; });
+    const auto has_free_space = [this] {
+        return paused || queued_buffers < target_queue_size.load(std::memory_order_relaxed);
+    };
+    release_cv.wait_for(lk, std::chrono::milliseconds(5), has_free_space);
+    if (queued_buffers > target_queue_size + 3) {
+        Common::CondvarWait(release_cv, lk, stop_token, has_free_space);
     }
 }
 
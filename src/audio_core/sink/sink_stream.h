@@ -162,8 +162,28 @@ public:
      */
     void SetRingSize(u32 ring_size) {
         max_queue_size = ring_size;
+        target_queue_size = ring_size;
     }
 
+    /**
+     * Get the number of buffers WaitFreeSpace currently lets the queue grow to.
+     * With adaptive latency this follows how steadily the backend consumes samples, otherwise it
+     * is the ring size.
+     *
+     * @return The target queue size.
+     */
+    u32 GetTargetQueueSize() const {
+        return target_queue_size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the time the samples waiting in this stream take to play, not counting the backend's
+     * own buffering.
+     *
+     * @return The current latency.
+     */
+    std::chrono::microseconds GetLatency() const;
+
     /**
      * Append a new buffer and its samples to a waiting queue to play.
      *
@@ -213,12 +233,31 @@ public:
      */
     void WaitFreeSpace(std::stop_token stop_token);
 
+    /**
+     * Get the number of output callbacks which ran out of queued samples.
+     *
+     * @return The number of underruns.
+     */
+    u64 GetUnderrunCount() const noexcept {
+        return underrun_count.load(std::memory_order_relaxed);
+    }
+
 protected:
     /**
      * Unblocks the ADSP if the stream is paused.
      */
     void SignalPause();
 
+private:
+    /**
+     * Adapt the target queue size after an output callback, growing it after underruns and
+     * shrinking it while the callbacks arrive steadily.
+     *
+     * @param num_frames - Number of frames the callback requested.
+     * @param underran   - Whether the callback ran out of queued samples.
+     */
+    void UpdateTargetQueueSize(std::size_t num_frames, bool underran);
+
 protected:
     /// Core system
     Core::System& system;
@@ -244,8 +283,18 @@ private:
     std::array<s16, MaxChannels> last_frame{};
     /// Number of buffers waiting to be played
     std::atomic<u32> queued_buffers{};
+    /// Number of output callbacks which ran out of queued samples
+    std::atomic<u64> underrun_count{};
     /// The ring size for audio out buffers (usually 4, rarely 2 or 8)
     u32 max_queue_size{};
+    /// Number of buffers WaitFreeSpace lets the queue grow to, adapted to the backend's jitter
+    std::atomic<u32> target_queue_size{};
+    /// Time of the previous output callback
+    std::chrono::steady_clock::time_point last_callback_time{};
+    /// Time of the last underrun or target queue size change
+    std::chrono::steady_clock::time_point last_adjust_time{};
+    /// Average deviation of the output callback interval from the duration it played
+    f64 callback_jitter_us{};
     /// Locks access to sample count tracking info
     std::mutex sample_count_lock;
     /// Minimum number of total samples that have been played since the last callback
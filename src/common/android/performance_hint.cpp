@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <android/performance_hint.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/android/performance_hint.h"
+#include "common/dynamic_library.h"
+#include "common/logging/log.h"
+
+namespace Common::Android {
+namespace {
+constexpr size_t NUM_SESSIONS = 3;
+
+/// Hint sessions were added in API level 33, above the minimum we support, so the entry points
+/// are loaded at runtime
+struct HintApi {
+    HintApi() : library{"libandroid.so"} {
+        if (!library.IsOpen() || !library.GetSymbol("APerformanceHint_getManager", &get_manager) ||
+            !library.GetSymbol("APerformanceHint_createSession", &create_session) ||
+            !library.GetSymbol("APerformanceHint_updateTargetWorkDuration",
+                               &update_target_work_duration) ||
+            !library.GetSymbol("APerformanceHint_reportActualWorkDuration",
+                               &report_actual_work_duration) ||
+            !library.GetSymbol("APerformanceHint_closeSession", &close_session)) {
+            LOG_INFO(Common, "Performance hint sessions are not available");
+            return;
+        }
+        manager = get_manager();
+        if (manager) {
+            LOG_INFO(Common, "Using performance hint sessions");
+        }
+    }
+
+    DynamicLibrary library;
+    APerformanceHintManager* (*get_manager)(){};
+    APerformanceHintSession* (*create_session)(APerformanceHintManager*, const int32_t*, size_t,
+                                               int64_t){};
+    int (*update_target_work_duration)(APerformanceHintSession*, int64_t){};
+    int (*report_actual_work_duration)(APerformanceHintSession*, int64_t){};
+    void (*close_session)(APerformanceHintSession*){};
+    APerformanceHintManager* manager{};
+};
+
+struct HintThread {
+    pid_t tid;
+    clockid_t clock;
+    s64 last_cpu_time;
+};
+
+struct SessionState {
+    std::vector<HintThread> threads;
+    APerformanceHintSession* handle{};
+    s64 target{};
+    bool is_dirty{};
+};
+
+HintApi& Api() {
+    static HintApi api;
+    return api;
+}
+
+std::mutex state_mutex;
+std::array<SessionState, NUM_SESSIONS> sessions;
+std::atomic_bool missing_frame_budget{};
+
+s64 ReadCpuTime(clockid_t clock) {
+    timespec time{};
+    if (clock_gettime(clock, &time) != 0) {
+        return -1;
+    }
+    return static_cast<s64>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+}
+
+void RecreateSession(const HintApi& api, SessionState& session, s64 target) {
+    if (session.handle) {
+        api.close_session(session.handle);
+        session.handle = nullptr;
+    }
+    session.is_dirty = false;
+    if (session.threads.empty()) {
+        return;
+    }
+    std::vector<int32_t> tids(session.threads.size());
+    std::ranges::transform(session.threads, tids.begin(), &HintThread::tid);
+    session.handle = api.create_session(api.manager, tids.data(), tids.size(), target);
+    session.target = target;
+}
+} // Anonymous namespace
+
+bool IsPerformanceHintSupported() {
+    return Api().manager != nullptr;
+}
+
+void RegisterHintThread(HintSession session) {
+    if (!IsPerformanceHintSupported()) {
+        return;
+    }
+    clockid_t clock{};
+    if (pthread_getcpuclockid(pthread_self(), &clock) != 0) {
+        return;
+    }
+    std::scoped_lock lock{state_mutex};
+    SessionState& state{sessions[static_cast<size_t>(session)]};
+    state.threads.push_back({
+        .tid = gettid(),
+        .clock = clock,
+        .last_cpu_time = ReadCpuTime(clock),
+    });
+    state.is_dirty = true;
+}
+
+void UnregisterHintThread() {
+    if (!IsPerformanceHintSupported()) {
+        return;
+    }
+    const pid_t tid{gettid()};
+    std::scoped_lock lock{state_mutex};
+    for (SessionState& state : sessions) {
+        if (std::erase_if(state.threads, [tid](const HintThread& thread) {
+                return thread.tid == tid;
+            }) != 0) {
+            state.is_dirty = true;
+        }
+    }
+}
+
+void ReportHintFrame(std::chrono::nanoseconds target) {
+    const HintApi& api{Api()};
+    if (!api.manager) {
+        return;
+    }
+    const s64 target_ns{target.count()};
+    bool missed_budget{};
+    std::scoped_lock lock{state_mutex};
+    for (SessionState& state : sessions) {
+        if (state.is_dirty) {
+            RecreateSession(api, state, target_ns);
+        }
+        if (!state.handle) {
+            continue;
+        }
+        if (state.target != target_ns) {
+            api.update_target_work_duration(state.handle, target_ns);
+            state.target = target_ns;
+        }
+        // Threads of a session run in parallel, the busiest one bounds the frame
+        s64 actual{};
+        for (HintThread& thread : state.threads) {
+            const s64 cpu_time{ReadCpuTime(thread.clock)};
+            if (cpu_time < 0 || thread.last_cpu_time < 0) {
+                thread.last_cpu_time = cpu_time;
+                continue;
+            }
+            actual = std::max(actual, cpu_time - thread.last_cpu_time);
+            thread.last_cpu_time = cpu_time;
+        }
+        if (actual > 0) {
+            api.report_actual_work_duration(state.handle, actual);
+        }
+        missed_budget |= actual > target_ns;
+    }
+    missing_frame_budget.store(missed_budget, std::memory_order_relaxed);
+}
+
+bool IsMissingFrameBudget() {
+    return missing_frame_budget.load(std::memory_order_relaxed);
+}
+
+} // namespace Common::Android
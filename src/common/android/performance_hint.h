@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+
+#include "common/common_types.h"
+
+namespace Common::Android {
+
+/// Groups of threads sharing a performance hint session
+enum class HintSession : u32 {
+    EmulatedCores, ///< Host threads running emulated CPU cores
+    Gpu,           ///< Host thread processing GPU commands
+    VulkanSubmit,  ///< Host thread recording and submitting Vulkan command buffers
+};
+
+/// Returns true when the system supports performance hint sessions (Android 13 and newer)
+[[nodiscard]] bool IsPerformanceHintSupported();
+
+/// Adds the calling thread to a hint session
+void RegisterHintThread(HintSession session);
+
+/// Removes the calling thread from its hint session
+void UnregisterHintThread();
+
+/**
+ * Reports to each session the CPU time its busiest thread spent since the previous report,
+ * letting the governor raise clocks before frames miss their budget.
+ * @param target Time budget of a frame
+ */
+void ReportHintFrame(std::chrono::nanoseconds target);
+
+/// Returns true when a session exceeded the budget on the last reported frame
+[[nodiscard]] bool IsMissingFrameBudget();
+
+/// Registers the calling thread in a hint session for the lifetime of the object
+class ScopedHintThread {
+public:
+    explicit ScopedHintThread(HintSession session) {
+        RegisterHintThread(session);
+    }
+
+    ~ScopedHintThread() {
+        UnregisterHintThread();
+    }
+
+    ScopedHintThread(const ScopedHintThread&) = delete;
+    ScopedHintThread& operator=(const ScopedHintThread&) = delete;
+};
+
+} // namespace Common::Android
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/boot_profiler.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/steady_clock.h"
+
+namespace Common::BootProfiler {
+
+namespace {
+
+struct Phase {
+    const char* name;
+    s64 start_ns;
+    s64 duration_ns;
+    u32 thread_id;
+    u32 depth;
+};
+
+std::atomic_bool g_is_recording{};
+std::mutex g_mutex;
+std::vector<Phase> g_phases;
+s64 g_boot_start_ns{};
+std::atomic<u32> g_next_thread_id{};
+
+thread_local u32 t_depth{};
+
+s64 GetTimeNs() {
+    return SteadyClock::Now().time_since_epoch().count();
+}
+
+u32 GetThreadId() {
+    thread_local const u32 thread_id = g_next_thread_id++;
+    return thread_id;
+}
+
+std::string EscapeJson(std::string_view str) {
+    std::string out;
+    out.reserve(str.size());
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+std::string MakeChromeTrace(std::string_view title, const std::vector<Phase>& phases,
+                            s64 boot_start_ns) {
+    std::string events;
+    for (const auto& phase : phases) {
+        if (!events.empty()) {
+            events += ",\n";
+        }
+        events += fmt::format(R"(  {{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{},"dur":{}}})",
+                              EscapeJson(phase.name), phase.thread_id,
+                              (phase.start_ns - boot_start_ns) / 1000, phase.duration_ns / 1000);
+    }
+    return fmt::format("{{\"otherData\":{{\"title\":\"{}\",\"build\":\"{}\"}},\n"
+                       "\"displayTimeUnit\":\"ms\",\n\"traceEvents\":[\n{}\n]}}\n",
+                       EscapeJson(title), EscapeJson(g_build_fullname), events);
+}
+
+} // Anonymous namespace
+
+void Start() {
+    std::scoped_lock lk{g_mutex};
+    g_phases.clear();
+    g_boot_start_ns = GetTimeNs();
+    g_is_recording = true;
+}
+
+void Finish(std::string_view title) {
+    std::vector<Phase> phases;
+    s64 boot_start_ns{};
+    {
+        std::scoped_lock lk{g_mutex};
+        if (!g_is_recording.exchange(false)) {
+            return;
+        }
+        phases = std::move(g_phases);
+        g_phases.clear();
+        boot_start_ns = g_boot_start_ns;
+    }
+
+    // Phases are recorded when they end, so sort them to put the outer ones first.
+    std::sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) {
+        return std::tie(a.thread_id, a.start_ns, a.depth) <
+               std::tie(b.thread_id, b.start_ns, b.depth);
+    });
+
+    LOG_INFO(Core, "Boot phases for {} ({:.2f} ms total):", title,
+             static_cast<double>(GetTimeNs() - boot_start_ns) / 1e6);
+    for (const auto& phase : phases) {
+        LOG_INFO(Core, "  {:>{}}{}: {:.2f} ms", "", phase.depth * 2, phase.name,
+                 static_cast<double>(phase.duration_ns) / 1e6);
+    }
+
+    const auto path =
+        FS::GetYuzuPath(FS::YuzuPath::LogDir) / "boot" / fmt::format("{}.json", title);
+    if (!FS::CreateParentDirs(path)) {
+        LOG_ERROR(Core, "Failed to create the boot report directory");
+        return;
+    }
+    const auto trace = MakeChromeTrace(title, phases, boot_start_ns);
+    if (FS::WriteStringToFile(path, FS::FileType::TextFile, trace) != trace.size()) {
+        LOG_ERROR(Core, "Failed to write the boot report");
+    }
+}
+
+ScopedPhase::ScopedPhase(const char* name) : m_name{name} {
+    if (!g_is_recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+    m_start_ns = GetTimeNs();
+    m_is_recording = true;
+    ++t_depth;
+}
+
+ScopedPhase::~ScopedPhase() {
+    if (!m_is_recording) {
+        return;
+    }
+    const s64 end_ns = GetTimeNs();
+    const u32 depth = --t_depth;
+
+    std::scoped_lock lk{g_mutex};
+    if (g_is_recording) {
+        g_phases.push_back({
+            .name = m_name,
+            .start_ns = m_start_ns,
+            .duration_ns = end_ns - m_start_ns,
+            .thread_id = GetThreadId(),
+            .depth = depth,
+        });
+    }
+}
+
+} // namespace Common::BootProfiler
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Common::BootProfiler {
+
+/// Discards previously recorded phases and starts recording the phases of a new boot.
+void Start();
+
+/**
+ * Stops recording, logs the recorded phases and writes them to the log directory as a Chrome
+ * trace named after the title.
+ */
+void Finish(std::string_view title);
+
+/// Records the time between its construction and destruction as a boot phase. Phases opened on
+/// the same thread while another one is open are nested under it.
+class ScopedPhase {
+    YUZU_NON_COPYABLE(ScopedPhase);
+    YUZU_NON_MOVEABLE(ScopedPhase);
+
+public:
+    explicit ScopedPhase(const char* name);
+    ~ScopedPhase();
+
+private:
+    const char* m_name;
+    s64 m_start_ns{};
+    bool m_is_recording{};
+};
+
+} // namespace Common::BootProfiler
+
+#define BOOT_PHASE(name) Common::BootProfiler::ScopedPhase CONCAT2(boot_phase_, __LINE__)(name)
@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <new>
+#include <span>
+#include <thread>
 
 #include "common/polyfill_thread.h"
 
@@ -200,50 +204,190 @@ private:
     std::mutex write_mutex;
 };
 
+/**
+ * Lock-free queue for any number of producers and consumers. Each slot carries a sequence number
+ * telling whether it is ready to be written or read, so producers and consumers only contend on
+ * their own index. Blocking calls spin for a short while before sleeping, and the sleeping side
+ * is only notified when it is actually waiting.
+ */
 template <typename T, size_t Capacity = detail::DefaultCapacity>
 class MPMCQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
 public:
+    MPMCQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order::relaxed);
+        }
+    }
+
     template <typename... Args>
     bool TryEmplace(Args&&... args) {
-        std::scoped_lock lock{write_mutex};
-        return spsc_queue.TryEmplace(std::forward<Args>(args)...);
+        size_t pos;
+        if (!ClaimWrite(pos)) {
+            return false;
+        }
+        Slot& slot = m_slots[pos % Capacity];
+        slot.value = T(std::forward<Args>(args)...);
+        slot.sequence.store(pos + 1, std::memory_order::release);
+        Notify(consumer_cv, consumer_cv_mutex, m_waiting_consumers);
+        return true;
     }
 
     template <typename... Args>
     void EmplaceWait(Args&&... args) {
-        std::scoped_lock lock{write_mutex};
-        spsc_queue.EmplaceWait(std::forward<Args>(args)...);
+        // Arguments are only consumed by the call that finds a free slot
+        for (size_t spin = 0; !TryEmplace(std::forward<Args>(args)...); ++spin) {
+            if (spin < SpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock lock{producer_cv_mutex};
+            ++m_waiting_producers;
+            producer_cv.wait(lock, [this] { return !IsFull(); });
+            --m_waiting_producers;
+        }
     }
 
     bool TryPop(T& t) {
-        std::scoped_lock lock{read_mutex};
-        return spsc_queue.TryPop(t);
+        return TryPopBatch(std::span<T>(&t, 1)) != 0;
     }
 
     void PopWait(T& t) {
-        std::scoped_lock lock{read_mutex};
-        spsc_queue.PopWait(t);
+        PopBatchWait(std::span<T>(&t, 1));
     }
 
     void PopWait(T& t, std::stop_token stop_token) {
-        std::scoped_lock lock{read_mutex};
-        spsc_queue.PopWait(t, stop_token);
+        PopBatchWait(std::span<T>(&t, 1), stop_token);
     }
 
     T PopWait() {
-        std::scoped_lock lock{read_mutex};
-        return spsc_queue.PopWait();
+        T t{};
+        PopWait(t);
+        return t;
     }
 
     T PopWait(std::stop_token stop_token) {
-        std::scoped_lock lock{read_mutex};
-        return spsc_queue.PopWait(stop_token);
+        T t{};
+        PopWait(t, stop_token);
+        return t;
+    }
+
+    /// Pops as many consecutive elements as are ready, up to the size of out.
+    /// Returns the number of popped elements.
+    size_t TryPopBatch(std::span<T> out) {
+        size_t pos = m_read_index.load(std::memory_order::relaxed);
+        size_t count;
+        do {
+            count = 0;
+            while (count < out.size() && IsReadable(pos + count)) {
+                ++count;
+            }
+            if (count == 0) {
+                return 0;
+            }
+            // Ready slots only change once their reader releases them, so claiming the range
+            // is enough to own all of them
+        } while (
+            !m_read_index.compare_exchange_weak(pos, pos + count, std::memory_order::relaxed));
+
+        for (size_t i = 0; i < count; ++i) {
+            Slot& slot = m_slots[(pos + i) % Capacity];
+            out[i] = std::move(slot.value);
+            slot.sequence.store(pos + i + Capacity, std::memory_order::release);
+        }
+        Notify(producer_cv, producer_cv_mutex, m_waiting_producers);
+        return count;
+    }
+
+    /// Waits until at least one element is ready and pops up to the size of out.
+    /// Returns the number of popped elements, which is zero when a stop was requested.
+    size_t PopBatchWait(std::span<T> out, std::stop_token stop_token = {}) {
+        for (size_t spin = 0;; ++spin) {
+            if (const size_t count = TryPopBatch(out); count != 0) {
+                return count;
+            }
+            if (stop_token.stop_requested()) {
+                return 0;
+            }
+            if (spin < SpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock lock{consumer_cv_mutex};
+            ++m_waiting_consumers;
+            if (stop_token.stop_possible()) {
+                Common::CondvarWait(consumer_cv, lock, stop_token, [this] { return !IsEmpty(); });
+            } else {
+                consumer_cv.wait(lock, [this] { return !IsEmpty(); });
+            }
+            --m_waiting_consumers;
+        }
     }
 
 private:
-    SPSCQueue<T, Capacity> spsc_queue;
-    std::mutex write_mutex;
-    std::mutex read_mutex;
+    /// Number of failed attempts before a blocking call goes to sleep.
+    static constexpr size_t SpinCount = 64;
+
+    struct Slot {
+        std::atomic_size_t sequence;
+        T value{};
+    };
+
+    bool ClaimWrite(size_t& pos) {
+        pos = m_write_index.load(std::memory_order::relaxed);
+        while (true) {
+            const Slot& slot = m_slots[pos % Capacity];
+            const size_t sequence = slot.sequence.load(std::memory_order::acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff < 0) {
+                // The slot still holds the element written one lap ago
+                return false;
+            }
+            if (diff > 0) {
+                pos = m_write_index.load(std::memory_order::relaxed);
+            } else if (m_write_index.compare_exchange_weak(pos, pos + 1,
+                                                           std::memory_order::relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    bool IsReadable(size_t pos) const {
+        return m_slots[pos % Capacity].sequence.load(std::memory_order::acquire) == pos + 1;
+    }
+
+    bool IsEmpty() const {
+        return !IsReadable(m_read_index.load(std::memory_order::relaxed));
+    }
+
+    bool IsFull() const {
+        const size_t pos = m_write_index.load(std::memory_order::relaxed);
+        return m_slots[pos % Capacity].sequence.load(std::memory_order::acquire) != pos;
+    }
+
+    void Notify(std::condition_variable_any& cv, std::mutex& mutex,
+                const std::atomic_size_t& num_waiting) {
+        // Pairs with the increment of the waiter count before it checks the queue, so either
+        // the waiter sees the change or the counter is seen here
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (num_waiting.load(std::memory_order::relaxed) != 0) {
+            std::scoped_lock lock{mutex};
+            cv.notify_all();
+        }
+    }
+
+    alignas(128) std::atomic_size_t m_read_index{0};
+    alignas(128) std::atomic_size_t m_write_index{0};
+    alignas(128) std::atomic_size_t m_waiting_consumers{0};
+    std::atomic_size_t m_waiting_producers{0};
+
+    std::array<Slot, Capacity> m_slots;
+
+    std::condition_variable_any producer_cv;
+    std::mutex producer_cv_mutex;
+    std::condition_variable_any consumer_cv;
+    std::mutex consumer_cv_mutex;
 };
 
 } // namespace Common
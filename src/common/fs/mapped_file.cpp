@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/alignment.h"
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+namespace Common::FS {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+    Close();
+    data = std::exchange(rhs.data, nullptr);
+    size = std::exchange(rhs.size, 0);
+#ifdef _WIN32
+    mapping = std::exchange(rhs.mapping, nullptr);
+#endif
+    return *this;
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept {
+    *this = std::move(rhs);
+}
+
+void MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+#ifdef _WIN32
+    const HANDLE file{CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+    // The mapping keeps its own reference to the file
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        LOG_ERROR(Common_Filesystem, "Failed to create file mapping of {}",
+                  PathToUTF8String(path));
+        return;
+    }
+    void* const view{MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+    if (!view) {
+        LOG_ERROR(Common_Filesystem, "Failed to map {}", PathToUTF8String(path));
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+    const int fd{open(path.c_str(), O_RDONLY)};
+    if (fd == -1) {
+        return;
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        close(fd);
+        return;
+    }
+    const size_t file_size{static_cast<size_t>(file_stat.st_size)};
+    // The mapping stays valid after the descriptor is closed
+    void* const view{mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    close(fd);
+    if (view == MAP_FAILED) {
+        LOG_ERROR(Common_Filesystem, "Failed to map {}", PathToUTF8String(path));
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = file_size;
+#endif
+}
+
+void MappedFile::Close() {
+    if (!data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    munmap(const_cast<u8*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t length) const {
+    if (!data || offset >= size) {
+        return;
+    }
+    length = std::min(length, size - offset);
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range{
+        .VirtualAddress = const_cast<u8*>(data + offset),
+        .NumberOfBytes = length,
+    };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    // madvise requires a page aligned address
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t aligned_offset = Common::AlignDown(offset, page_size);
+    madvise(const_cast<u8*>(data + aligned_offset), length + (offset - aligned_offset),
+            MADV_WILLNEED);
+#endif
+}
+
+} // namespace Common::FS
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only memory mapping of a whole file.
+ * Pages are read from storage on first access, so only the parts of the file that are touched
+ * are loaded.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile& operator=(MappedFile&& rhs) noexcept;
+    MappedFile(MappedFile&& rhs) noexcept;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(const MappedFile&) = delete;
+
+    /// Maps the file at path, closing the previous mapping. Empty files can't be mapped.
+    void Open(const std::filesystem::path& path);
+
+    /// Unmaps the file
+    void Close();
+
+    /// Hints that the given range will be read soon, so it can be read ahead of the accesses.
+    void Prefetch(size_t offset, size_t length) const;
+
+    [[nodiscard]] bool IsOpen() const noexcept {
+        return data != nullptr;
+    }
+
+    [[nodiscard]] std::span<const u8> Data() const noexcept {
+        return {data, size};
+    }
+
+private:
+    const u8* data{};
+    size_t size{};
+#ifdef _WIN32
+    void* mapping{};
+#endif
+};
+
+} // namespace Common::FS
@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <xxhash.h>
+
+#include "common/hash.h"
+
+namespace Common {
+
+u64 RuntimeHash64(const void* data, std::size_t size) {
+    return XXH3_64bits(data, size);
+}
+
+u64 RuntimeHash64WithSeed(const void* data, std::size_t size, u64 seed) {
+    return XXH3_64bits_withSeed(data, size, seed);
+}
+
+} // namespace Common
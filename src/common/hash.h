@@ -7,8 +7,20 @@
 #include <utility>
 #include <boost/functional/hash.hpp>
 
+#include "common/common_types.h"
+
 namespace Common {
 
+/**
+ * Hashes data for keys that never leave the process, such as runtime cache lookups, using XXH3.
+ * It is several times faster than CityHash on large inputs, but the result is not guaranteed to
+ * be stable across xxHash versions, so anything written to disk keeps using CityHash64.
+ */
+[[nodiscard]] u64 RuntimeHash64(const void* data, std::size_t size);
+
+/// Hashes data for runtime-only keys as RuntimeHash64 does, chaining from seed.
+[[nodiscard]] u64 RuntimeHash64WithSeed(const void* data, std::size_t size, u64 seed);
+
 struct PairHash {
     template <class T1, class T2>
     std::size_t operator()(const std::pair<T1, T2>& pair) const noexcept {
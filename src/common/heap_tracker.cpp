@@ -1,16 +1,30 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <fstream>
 #include <vector>
 
 #include "common/heap_tracker.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
 
 namespace Common {
 
 namespace {
 
+using namespace Common::Literals;
+
+// Bounds of the size of non-resident neighbours mapped in along with a faulting mapping.
+constexpr size_t MinCoalesceLimit = 64_KiB;
+constexpr size_t MaxCoalesceLimit = 2_MiB;
+
+u64 NanosecondsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count());
+}
+
 s64 GetMaxPermissibleResidentMapCount() {
     // Default value.
     s64 value = 65530;
@@ -29,8 +43,20 @@ s64 GetMaxPermissibleResidentMapCount() {
 } // namespace
 
 HeapTracker::HeapTracker(Common::HostMemory& buffer)
-    : m_buffer(buffer), m_max_resident_map_count(GetMaxPermissibleResidentMapCount()) {}
-HeapTracker::~HeapTracker() = default;
+    : m_buffer(buffer), m_max_resident_map_count(GetMaxPermissibleResidentMapCount()),
+      m_coalesce_limit(MinCoalesceLimit) {}
+
+HeapTracker::~HeapTracker() {
+    const HeapTrackerStatistics& stats = m_statistics;
+    if (stats.faults == 0) {
+        return;
+    }
+    LOG_INFO(HW_Memory,
+             "Separate heap: {} faults ({} remaps) in {} ms, {} evictions over {} rebuilds in "
+             "{} ms, {} mappings coalesced",
+             stats.faults, stats.remaps, stats.fault_time_ns / 1000000, stats.evictions,
+             stats.rebuilds, stats.rebuild_time_ns / 1000000, stats.coalesced);
+}
 
 void HeapTracker::Map(size_t virtual_offset, size_t host_offset, size_t length,
                       MemoryPermission perm, bool is_separate_heap) {
@@ -166,9 +192,13 @@ bool HeapTracker::DeferredMapSeparateHeap(u8* fault_address) {
 }
 
 bool HeapTracker::DeferredMapSeparateHeap(size_t virtual_offset) {
+    const auto start_time = std::chrono::steady_clock::now();
     bool rebuild_required = false;
 
     {
+        // Merging mappings must not race with a reprotect walking them, so only coalesce when
+        // no reprotect or rebuild is in progress.
+        std::unique_lock rebuild_lk{m_rebuild_lock, std::try_to_lock};
         std::scoped_lock lk{m_lock};
 
         // Check to ensure this was a non-resident separate heap mapping.
@@ -190,8 +220,20 @@ bool HeapTracker::DeferredMapSeparateHeap(size_t virtual_offset) {
 
         // This map is now resident.
         it->is_resident = true;
+        m_statistics.faults++;
+        if (it->was_evicted) {
+            it->was_evicted = false;
+            m_statistics.remaps++;
+        }
+
+        SeparateHeapMap* map = std::addressof(*it);
+        if (rebuild_lk.owns_lock()) {
+            map = this->CoalesceLocked(map);
+        }
         m_resident_map_count++;
-        m_resident_mappings.insert(*it);
+        m_resident_mappings.insert(*map);
+
+        m_statistics.fault_time_ns += NanosecondsSince(start_time);
     }
 
     if (rebuild_required) {
@@ -202,7 +244,13 @@ bool HeapTracker::DeferredMapSeparateHeap(size_t virtual_offset) {
     return true;
 }
 
+HeapTrackerStatistics HeapTracker::GetStatistics() {
+    std::scoped_lock lk{m_lock};
+    return m_statistics;
+}
+
 void HeapTracker::RebuildSeparateHeapAddressSpace() {
+    const auto start_time = std::chrono::steady_clock::now();
     std::scoped_lock lk{m_rebuild_lock, m_lock};
 
     ASSERT(!m_resident_mappings.empty());
@@ -219,12 +267,33 @@ void HeapTracker::RebuildSeparateHeapAddressSpace() {
     for (size_t i = 0; i < evict_count && it != m_resident_mappings.end(); i++) {
         // Unmark and unmap.
         it->is_resident = false;
+        it->was_evicted = true;
         m_buffer.Unmap(it->vaddr, it->size, false);
 
         // Advance.
         ASSERT(--m_resident_map_count >= 0);
         it = m_resident_mappings.erase(it);
+        m_statistics.evictions++;
+    }
+
+    // When most faults since the last rebuild brought back evicted mappings, the working set
+    // does not fit in the map budget. Coalesce more eagerly so each mapping covers more of it,
+    // and back off again once the working set fits.
+    const u64 remaps = m_statistics.remaps - m_remaps_at_last_rebuild;
+    const u64 faults = m_statistics.faults - m_faults_at_last_rebuild;
+    if (remaps * 2 > faults) {
+        m_coalesce_limit = std::min(m_coalesce_limit * 2, MaxCoalesceLimit);
+    } else {
+        m_coalesce_limit = std::max(m_coalesce_limit / 2, MinCoalesceLimit);
     }
+    m_remaps_at_last_rebuild = m_statistics.remaps;
+    m_faults_at_last_rebuild = m_statistics.faults;
+
+    m_statistics.rebuilds++;
+    m_statistics.rebuild_time_ns += NanosecondsSince(start_time);
+    LOG_DEBUG(HW_Memory,
+              "Rebuilt separate heap: {} of {} faults were remaps, coalescing up to {} KiB",
+              remaps, faults, m_coalesce_limit / 1_KiB);
 }
 
 void HeapTracker::SplitHeapMap(VAddr offset, size_t size) {
@@ -257,6 +326,7 @@ void HeapTracker::SplitHeapMapLocked(VAddr offset) {
         .tick = left->tick,
         .perm = left->perm,
         .is_resident = left->is_resident,
+        .was_evicted = left->was_evicted,
     };
 
     // Insert the new right map.
@@ -278,4 +348,61 @@ HeapTracker::AddrTree::iterator HeapTracker::GetNearestHeapMapLocked(VAddr offse
     return m_mappings.find(key);
 }
 
+SeparateHeapMap* HeapTracker::CoalesceLocked(SeparateHeapMap* map) {
+    // The map is resident, but not yet in the resident tree.
+    const auto it = m_mappings.iterator_to(*map);
+
+    // Merge the following mapping into this one.
+    if (auto next = std::next(it); next != m_mappings.end() &&
+                                   this->CanCoalesceLocked(*map, *next, *next)) {
+        auto* const right = std::addressof(*next);
+        this->AbsorbNeighbourLocked(right);
+        m_mappings.erase(next);
+        map->size += right->size;
+        delete right;
+    }
+
+    // Merge this mapping into the preceding one.
+    if (it != m_mappings.begin()) {
+        auto prev = it;
+        --prev;
+        if (this->CanCoalesceLocked(*prev, *map, *prev)) {
+            auto* const left = std::addressof(*prev);
+            this->AbsorbNeighbourLocked(left);
+            m_mappings.erase(it);
+            left->size += map->size;
+            left->tick = map->tick;
+            left->is_resident = true;
+            delete map;
+            map = left;
+        }
+    }
+
+    return map;
+}
+
+bool HeapTracker::CanCoalesceLocked(const SeparateHeapMap& left, const SeparateHeapMap& right,
+                                    const SeparateHeapMap& neighbour) const {
+    // Mappings must be contiguous on both sides to be mapped as one.
+    if (left.vaddr + left.size != right.vaddr || left.paddr + left.size != right.paddr ||
+        left.perm != right.perm) {
+        return false;
+    }
+
+    // Resident neighbours cost nothing to merge, others only if small.
+    return neighbour.is_resident || neighbour.size <= m_coalesce_limit;
+}
+
+void HeapTracker::AbsorbNeighbourLocked(SeparateHeapMap* neighbour) {
+    if (neighbour->is_resident) {
+        ASSERT(--m_resident_map_count >= 0);
+        m_resident_mappings.erase(m_resident_mappings.iterator_to(*neighbour));
+    } else {
+        m_buffer.Map(neighbour->vaddr, neighbour->paddr, neighbour->size, neighbour->perm, false);
+    }
+
+    ASSERT(--m_map_count >= 0);
+    m_statistics.coalesced++;
+}
+
 } // namespace Common
@@ -22,6 +22,7 @@ struct SeparateHeapMap {
     size_t tick{};
     MemoryPermission perm{};
     bool is_resident{};
+    bool was_evicted{};
 };
 
 struct SeparateHeapMapAddrComparator {
@@ -48,6 +49,19 @@ struct SeparateHeapMapTickComparator {
     }
 };
 
+struct HeapTrackerStatistics {
+    /// Faults that made a separate heap mapping resident
+    u64 faults{};
+    /// Faults on mappings that had been evicted before
+    u64 remaps{};
+    u64 evictions{};
+    u64 rebuilds{};
+    /// Neighbouring mappings merged into the mapping that faulted
+    u64 coalesced{};
+    u64 fault_time_ns{};
+    u64 rebuild_time_ns{};
+};
+
 class HeapTracker {
 public:
     explicit HeapTracker(Common::HostMemory& buffer);
@@ -64,6 +78,8 @@ public:
     bool DeferredMapSeparateHeap(u8* fault_address);
     bool DeferredMapSeparateHeap(size_t virtual_offset);
 
+    HeapTrackerStatistics GetStatistics();
+
 private:
     using AddrTreeTraits =
         Common::IntrusiveRedBlackTreeMemberTraitsDeferredAssert<&SeparateHeapMap::addr_node>;
@@ -82,6 +98,11 @@ private:
 
     AddrTree::iterator GetNearestHeapMapLocked(VAddr offset);
 
+    SeparateHeapMap* CoalesceLocked(SeparateHeapMap* map);
+    bool CanCoalesceLocked(const SeparateHeapMap& left, const SeparateHeapMap& right,
+                           const SeparateHeapMap& neighbour) const;
+    void AbsorbNeighbourLocked(SeparateHeapMap* neighbour);
+
     void RebuildSeparateHeapAddressSpace();
 
 private:
@@ -93,6 +114,12 @@ private:
     s64 m_map_count{};
     s64 m_resident_map_count{};
     size_t m_tick{};
+
+    /// Largest non-resident neighbour mapped in along with a faulting mapping
+    size_t m_coalesce_limit;
+    u64 m_faults_at_last_rebuild{};
+    u64 m_remaps_at_last_rebuild{};
+    HeapTrackerStatistics m_statistics{};
 };
 
 } // namespace Common
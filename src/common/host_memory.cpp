@@ -29,6 +29,7 @@
 
 #include <mutex>
 #include <random>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -89,7 +90,7 @@ static void GetFuncAddress(Common::DynamicLibrary& dll, const char* name, T& pfn
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t backing_size_, size_t virtual_size_)
+    explicit Impl(size_t backing_size_, size_t virtual_size_, bool /* huge_pages */)
         : backing_size{backing_size_}, virtual_size{virtual_size_}, process{GetCurrentProcess()},
           kernelbase_dll("Kernelbase") {
         if (!kernelbase_dll.IsOpen()) {
@@ -427,7 +428,7 @@ static void* ChooseVirtualBase(size_t virtual_size) {
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t backing_size_, size_t virtual_size_)
+    explicit Impl(size_t backing_size_, size_t virtual_size_, bool huge_pages)
         : backing_size{backing_size_}, virtual_size{virtual_size_} {
         bool good = false;
         SCOPE_EXIT {
@@ -443,30 +444,11 @@ public:
         }
 
         // Backing memory initialization
-#if defined(__FreeBSD__) && __FreeBSD__ < 13
-        // XXX Drop after FreeBSD 12.* reaches EOL on 2024-06-30
-        fd = shm_open(SHM_ANON, O_RDWR, 0600);
-#else
-        fd = memfd_create("HostMemory", 0);
-#endif
-        if (fd < 0) {
-            LOG_CRITICAL(HW_Memory, "memfd_create failed: {}", strerror(errno));
-            throw std::bad_alloc{};
-        }
-
-        // Defined to extend the file with zeros
-        int ret = ftruncate(fd, backing_size);
-        if (ret != 0) {
-            LOG_CRITICAL(HW_Memory, "ftruncate failed with {}, are you out-of-memory?",
-                         strerror(errno));
-            throw std::bad_alloc{};
+        if (huge_pages) {
+            use_huge_pages = CreateHugePageBacking();
         }
-
-        backing_base = static_cast<u8*>(
-            mmap(nullptr, backing_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
-        if (backing_base == MAP_FAILED) {
-            LOG_CRITICAL(HW_Memory, "mmap failed: {}", strerror(errno));
-            throw std::bad_alloc{};
+        if (!use_huge_pages) {
+            CreateBacking();
         }
 
         // Virtual memory initialization
@@ -476,7 +458,11 @@ public:
             throw std::bad_alloc{};
         }
 #if defined(__linux__)
-        madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
+        if (use_huge_pages) {
+            huge_page_mapped.resize(virtual_size / HugePageSize + 1);
+        } else {
+            madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
+        }
 #endif
 
         free_manager.SetAddressSpace(virtual_base, virtual_size);
@@ -508,6 +494,11 @@ public:
         }
 #endif
 
+        if (use_huge_pages) {
+            MapHugePages(virtual_offset, host_offset, length, flags);
+            return;
+        }
+
         void* ret = mmap(virtual_base + virtual_offset, length, flags, MAP_SHARED | MAP_FIXED, fd,
                          host_offset);
         ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
@@ -520,6 +511,13 @@ public:
         // Intersect the range with our address space.
         AdjustMap(&virtual_offset, &length);
 
+        // Huge pages can not be split, drop every one the range touches.
+        if (use_huge_pages) {
+            ForEachHugePage(virtual_offset, length, [this](u8* huge_page, bool) {
+                UnmapHugePage(huge_page);
+            });
+        }
+
         // Merge with any adjacent placeholder mappings.
         auto [merged_pointer, merged_size] =
             free_manager.FreeBlock(virtual_base + virtual_offset, length);
@@ -545,12 +543,29 @@ public:
             flags |= PROT_EXEC;
         }
 #endif
+        if (use_huge_pages) {
+            // Only touch mapped huge pages, protecting a placeholder would make it accessible.
+            ForEachHugePage(virtual_offset, length, [this, flags](u8* huge_page, bool contained) {
+                if (!contained) {
+                    UnmapHugePage(huge_page);
+                    return;
+                }
+                int ret = mprotect(huge_page, HugePageSize, flags);
+                ASSERT_MSG(ret == 0, "mprotect failed: {}", strerror(errno));
+            });
+            return;
+        }
         int ret = mprotect(virtual_base + virtual_offset, length, flags);
         ASSERT_MSG(ret == 0, "mprotect failed: {}", strerror(errno));
     }
 
     bool ClearBackingRegion(size_t physical_offset, size_t length) {
 #ifdef __linux__
+        if (use_huge_pages) {
+            // Holes can not be punched into parts of a huge page.
+            return false;
+        }
+
         // Set MADV_REMOVE on backing map to destroy it instantly.
         // This also deletes the area from the backing file.
         int ret = madvise(backing_base + physical_offset, length, MADV_REMOVE);
@@ -574,8 +589,134 @@ public:
     u8* virtual_map_base{reinterpret_cast<u8*>(MAP_FAILED)};
 
 private:
+    void CreateBacking() {
+#if defined(__FreeBSD__) && __FreeBSD__ < 13
+        // XXX Drop after FreeBSD 12.* reaches EOL on 2024-06-30
+        fd = shm_open(SHM_ANON, O_RDWR, 0600);
+#else
+        fd = memfd_create("HostMemory", 0);
+#endif
+        if (fd < 0) {
+            LOG_CRITICAL(HW_Memory, "memfd_create failed: {}", strerror(errno));
+            throw std::bad_alloc{};
+        }
+
+        // Defined to extend the file with zeros
+        int ret = ftruncate(fd, backing_size);
+        if (ret != 0) {
+            LOG_CRITICAL(HW_Memory, "ftruncate failed with {}, are you out-of-memory?",
+                         strerror(errno));
+            throw std::bad_alloc{};
+        }
+
+        backing_base = static_cast<u8*>(
+            mmap(nullptr, backing_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        if (backing_base == MAP_FAILED) {
+            LOG_CRITICAL(HW_Memory, "mmap failed: {}", strerror(errno));
+            throw std::bad_alloc{};
+        }
+    }
+
+    /// Backs the memory with explicit 2MiB pages from the hugetlb pool, returns false when the
+    /// pool can not hold it
+    bool CreateHugePageBacking() {
+#if defined(__linux__) && defined(MFD_HUGETLB) && defined(MFD_HUGE_2MB)
+        if (backing_size % HugePageSize != 0) {
+            LOG_WARNING(HW_Memory, "Backing size {:#x} is not a multiple of the huge page size",
+                        backing_size);
+            return false;
+        }
+        fd = memfd_create("HostMemory", MFD_HUGETLB | MFD_HUGE_2MB);
+        if (fd < 0) {
+            LOG_WARNING(HW_Memory, "Huge page backing unavailable: {}", strerror(errno));
+            return false;
+        }
+        // Shared hugetlb mappings reserve their pages up front, so this fails instead of
+        // faulting later when the pool is too small.
+        if (ftruncate(fd, backing_size) == 0) {
+            backing_base = static_cast<u8*>(
+                mmap(nullptr, backing_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        }
+        if (backing_base == MAP_FAILED) {
+            LOG_WARNING(HW_Memory, "Failed to reserve {} huge pages: {}",
+                        backing_size / HugePageSize, strerror(errno));
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        LOG_INFO(HW_Memory, "Backing {} MiB of guest memory with {} huge pages",
+                 backing_size >> 20, backing_size / HugePageSize);
+        return true;
+#else
+        LOG_WARNING(HW_Memory, "Huge page backing is not supported on this platform");
+        return false;
+#endif
+    }
+
+    /// Maps the huge pages fully contained in the range, the rest is left to the slow path of the
+    /// CPU backends
+    void MapHugePages(size_t virtual_offset, size_t host_offset, size_t length, int flags) {
+        u8* const start = virtual_base + virtual_offset;
+        if ((reinterpret_cast<uintptr_t>(start) - host_offset) % HugePageSize != 0) {
+            // The view and the backing are not aligned the same way, no huge page fits.
+            return;
+        }
+        const uintptr_t begin = AlignUp(reinterpret_cast<uintptr_t>(start), HugePageSize);
+        const uintptr_t end = AlignDown(reinterpret_cast<uintptr_t>(start) + length, HugePageSize);
+        if (begin >= end) {
+            return;
+        }
+        void* ret = mmap(reinterpret_cast<u8*>(begin), end - begin, flags, MAP_SHARED | MAP_FIXED,
+                         fd, host_offset + (begin - reinterpret_cast<uintptr_t>(start)));
+        ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
+
+        for (uintptr_t huge_page = begin; huge_page < end; huge_page += HugePageSize) {
+            huge_page_mapped[HugePageIndex(reinterpret_cast<u8*>(huge_page))] = true;
+        }
+        num_huge_pages_mapped += (end - begin) / HugePageSize;
+        if (HugePageMappedSize() > peak_huge_page_mapped_size) {
+            peak_huge_page_mapped_size = HugePageMappedSize();
+        }
+    }
+
+    /// Replaces a mapped huge page with a placeholder
+    void UnmapHugePage(u8* huge_page) {
+        void* ret = mmap(huge_page, HugePageSize, PROT_NONE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
+        huge_page_mapped[HugePageIndex(huge_page)] = false;
+        --num_huge_pages_mapped;
+    }
+
+    /// Calls func for each mapped huge page the range touches, and whether it is fully inside it
+    void ForEachHugePage(size_t virtual_offset, size_t length, auto&& func) {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(virtual_base + virtual_offset);
+        const uintptr_t end = start + length;
+        for (uintptr_t huge_page = AlignDown(start, HugePageSize); huge_page < end;
+             huge_page += HugePageSize) {
+            u8* const pointer = reinterpret_cast<u8*>(huge_page);
+            if (pointer < virtual_map_base || !huge_page_mapped[HugePageIndex(pointer)]) {
+                continue;
+            }
+            func(pointer, huge_page >= start && huge_page + HugePageSize <= end);
+        }
+    }
+
+    [[nodiscard]] size_t HugePageMappedSize() const noexcept {
+        return num_huge_pages_mapped * HugePageSize;
+    }
+
+    [[nodiscard]] size_t HugePageIndex(const u8* huge_page) const {
+        return static_cast<size_t>(huge_page - virtual_map_base) / HugePageSize;
+    }
+
     /// Release all resources in the object
     void Release() {
+        if (use_huge_pages) {
+            LOG_INFO(HW_Memory, "Huge pages covered up to {} MiB of the fastmem arena",
+                     peak_huge_page_mapped_size >> 20);
+        }
+
         if (virtual_map_base != MAP_FAILED) {
             int ret = munmap(virtual_map_base, virtual_size);
             ASSERT_MSG(ret == 0, "munmap failed: {}", strerror(errno));
@@ -615,13 +756,18 @@ private:
 
     int fd{-1}; // memfd file descriptor, -1 is the error value of memfd_create
     FreeRegionManager free_manager{};
+
+    bool use_huge_pages{};               ///< True when backed by the hugetlb pool
+    std::vector<bool> huge_page_mapped;  ///< Huge pages of the arena mapped to the backing
+    size_t num_huge_pages_mapped{};      ///< Number of huge pages currently mapped
+    size_t peak_huge_page_mapped_size{}; ///< Largest size mapped with huge pages at once
 };
 
 #else // ^^^ Linux ^^^ vvv Generic vvv
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t /*backing_size */, size_t /* virtual_size */) {
+    explicit Impl(size_t /*backing_size */, size_t /* virtual_size */, bool /* huge_pages */) {
         // This is just a place holder.
         // Please implement fastmem in a proper way on your platform.
         throw std::bad_alloc{};
@@ -645,14 +791,15 @@ public:
 
 #endif // ^^^ Generic ^^^
 
-HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
+HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_, bool huge_pages)
     : backing_size(backing_size_), virtual_size(virtual_size_) {
     try {
         // Try to allocate a fastmem arena.
         // The implementation will fail with std::bad_alloc on errors.
-        impl =
-            std::make_unique<HostMemory::Impl>(AlignUp(backing_size, PageAlignment),
-                                               AlignUp(virtual_size, PageAlignment) + HugePageSize);
+        impl = std::make_unique<HostMemory::Impl>(AlignUp(backing_size, PageAlignment),
+                                                  AlignUp(virtual_size, PageAlignment) +
+                                                      HugePageSize,
+                                                  huge_pages);
         backing_base = impl->backing_base;
         virtual_base = impl->virtual_base;
 
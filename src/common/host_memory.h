@@ -24,7 +24,11 @@ DECLARE_ENUM_FLAG_OPERATORS(MemoryPermission)
  */
 class HostMemory {
 public:
-    explicit HostMemory(size_t backing_size_, size_t virtual_size_);
+    /**
+     * @param huge_pages Back the memory with explicit huge pages when the host has enough of
+     *                   them. Only huge page aligned mappings are then placed in the virtual view.
+     */
+    explicit HostMemory(size_t backing_size_, size_t virtual_size_, bool huge_pages = false);
     ~HostMemory();
 
     /**
@@ -65,6 +69,10 @@ public:
         return virtual_base;
     }
 
+    [[nodiscard]] size_t BackingSize() const noexcept {
+        return backing_size;
+    }
+
     bool IsInVirtualRange(void* address) const noexcept {
         return address >= virtual_base && address < virtual_base + virtual_size;
     }
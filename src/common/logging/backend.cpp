@@ -226,13 +226,28 @@ public:
         color_console_backend.SetEnabled(enabled);
     }
 
+    bool IsLogged(Class log_class, Level log_level) const {
+        return filter.CheckMessage(log_class, log_level);
+    }
+
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, std::string&& message) {
+                   const char* function, const char* format, const fmt::format_args& args) {
         if (!filter.CheckMessage(log_class, log_level)) {
             return;
         }
-        message_queue.EmplaceWait(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+        message_queue.EmplaceWait(CreateEntry(log_class, log_level, filename, line_num, function,
+                                              fmt::vformat(format, args)));
+    }
+
+    void PushDeferredEntry(Class log_class, Level log_level, const char* filename,
+                           unsigned int line_num, const char* function,
+                           const DeferredMessage& message) {
+        if (!filter.CheckMessage(log_class, log_level)) {
+            return;
+        }
+        Entry entry = CreateEntry(log_class, log_level, filename, line_num, function, {});
+        entry.deferred = message;
+        message_queue.EmplaceWait(std::move(entry));
     }
 
 private:
@@ -246,6 +261,7 @@ private:
             Common::SetCurrentThreadName("Logger");
             Entry entry;
             const auto write_logs = [this, &entry]() {
+                FormatDeferredEntry(entry);
                 ForEachBackend([&entry](Backend& backend) { backend.Write(entry); });
             };
             while (!stop_token.stop_requested()) {
@@ -289,6 +305,19 @@ private:
         };
     }
 
+    static void FormatDeferredEntry(Entry& entry) {
+        const DeferredMessage& deferred = entry.deferred;
+        if (!deferred.formatter) {
+            return;
+        }
+        try {
+            entry.message = deferred.formatter(deferred.format, deferred.arguments.data());
+        } catch (const fmt::format_error& error) {
+            entry.message = fmt::format("Failed to format \"{}\": {}", deferred.format,
+                                        error.what());
+        }
+    }
+
     void ForEachBackend(auto lambda) {
         lambda(static_cast<Backend&>(debugger_backend));
         lambda(static_cast<Backend&>(color_console_backend));
@@ -342,12 +371,26 @@ void SetColorConsoleBackendEnabled(bool enabled) {
     Impl::Instance().SetColorConsoleBackendEnabled(enabled);
 }
 
+bool IsLogged(Class log_class, Level log_level) {
+    return !initialization_in_progress_suppress_logging &&
+           Impl::Instance().IsLogged(log_class, log_level);
+}
+
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args) {
     if (!initialization_in_progress_suppress_logging) {
-        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function,
-                                   fmt::vformat(format, args));
+        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function, format,
+                                   args);
+    }
+}
+
+void DeferredLogMessageImpl(Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function,
+                            const DeferredMessage& message) {
+    if (!initialization_in_progress_suppress_logging) {
+        Impl::Instance().PushDeferredEntry(log_class, log_level, filename, line_num, function,
+                                           message);
     }
 }
 } // namespace Common::Log
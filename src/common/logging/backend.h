@@ -25,4 +25,7 @@ void DisableLoggingInTests();
 void SetGlobalFilter(const Filter& filter);
 
 void SetColorConsoleBackendEnabled(bool enabled);
+
+/// Returns whether messages of this class and level pass the global filter
+bool IsLogged(Class log_class, Level log_level);
 } // namespace Common::Log
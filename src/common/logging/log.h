@@ -4,11 +4,15 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 
 #include <fmt/format.h>
 
 #include "common/logging/formatter.h"
+#include "common/logging/log_entry.h"
 #include "common/logging/types.h"
 
 namespace Common::Log {
@@ -27,11 +31,49 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
 
-template <typename... Args>
+/// Logs a message to the global logger, formatting it on the logging thread
+void DeferredLogMessageImpl(Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function,
+                            const DeferredMessage& message);
+
+/// Arguments that can be copied as plain bytes and formatted later on another thread
+template <typename T>
+concept DeferrableLogArgument = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <DeferrableLogArgument... Args>
+std::string FormatDeferredMessage(const char* format, const std::byte* arguments) {
+    std::tuple<Args...> values;
+    std::apply(
+        [arguments](Args&... value) {
+            std::size_t offset = 0;
+            ((std::memcpy(&value, arguments + offset, sizeof(Args)), offset += sizeof(Args)), ...);
+        },
+        values);
+    return std::apply(
+        [format](const Args&... value) {
+            return fmt::vformat(format, fmt::make_format_args(value...));
+        },
+        values);
+}
+
+template <typename Format, typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, const char* format, const Args&... args) {
-    FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
-                      fmt::make_format_args(args...));
+                   const char* function, const Format& format, const Args&... args) {
+    // Only string literals outlive the call, and only plain values can be copied as bytes
+    if constexpr (std::is_array_v<Format> && (DeferrableLogArgument<Args> && ...) &&
+                  (sizeof(Args) + ... + 0) <= DeferredMessage::ArgumentsSize) {
+        DeferredMessage message;
+        message.format = format;
+        message.formatter = &FormatDeferredMessage<Args...>;
+        std::size_t offset = 0;
+        ((std::memcpy(message.arguments.data() + offset, &args, sizeof(Args)),
+          offset += sizeof(Args)),
+         ...);
+        DeferredLogMessageImpl(log_class, log_level, filename, line_num, function, message);
+    } else {
+        FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                          fmt::make_format_args(args...));
+    }
 }
 
 } // namespace Common::Log
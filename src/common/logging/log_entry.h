@@ -3,12 +3,29 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <string>
 
 #include "common/logging/types.h"
 
 namespace Common::Log {
 
+/**
+ * Format string and copied arguments of a message that is formatted by the logging thread instead
+ * of the thread that logged it.
+ */
+struct DeferredMessage {
+    static constexpr std::size_t ArgumentsSize = 64;
+
+    using FormatFunction = std::string (*)(const char* format, const std::byte* arguments);
+
+    const char* format = nullptr;
+    FormatFunction formatter = nullptr;
+    std::array<std::byte, ArgumentsSize> arguments;
+};
+
 /**
  * A log entry. Log entries are store in a structured format to permit more varied output
  * formatting on different frontends, as well as facilitating filtering and aggregation.
@@ -21,6 +38,7 @@ struct Entry {
     unsigned int line_num = 0;
     std::string function;
     std::string message;
+    DeferredMessage deferred{}; ///< Set instead of message when formatting was deferred
 };
 
 } // namespace Common::Log
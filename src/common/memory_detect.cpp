@@ -4,9 +4,11 @@
 #ifdef _WIN32
 // clang-format off
 #include <windows.h>
+#include <psapi.h>
 #include <sysinfoapi.h>
 // clang-format on
 #else
+#include <sys/resource.h>
 #include <sys/types.h>
 #if defined(__APPLE__) || defined(__FreeBSD__)
 #include <sys/sysctl.h>
@@ -69,4 +71,25 @@ const MemoryInfo& GetMemInfo() {
     return mem_info;
 }
 
+u64 GetPeakResidentMemory() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    // macOS reports the size in bytes, other systems in kilobytes
+    return static_cast<u64>(usage.ru_maxrss);
+#else
+    return static_cast<u64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
 } // namespace Common
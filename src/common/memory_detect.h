@@ -18,4 +18,10 @@ struct MemoryInfo {
  */
 [[nodiscard]] const MemoryInfo& GetMemInfo();
 
+/**
+ * Gets the largest amount of physical memory used by the process so far
+ * @return Peak resident set size of the process in bytes, zero when the host does not report it
+ */
+[[nodiscard]] u64 GetPeakResidentMemory();
+
 } // namespace Common
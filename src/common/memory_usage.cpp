@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+
+#include "common/logging/log.h"
+#include "common/memory_detect.h"
+#include "common/memory_usage.h"
+
+namespace Common {
+
+namespace {
+struct Counters {
+    std::atomic<u64> current_bytes{};
+    std::atomic<u64> peak_bytes{};
+    std::atomic<u64> budget_bytes{};
+};
+
+std::array<Counters, NumMemoryUsageCategories> g_counters;
+
+constexpr std::array<std::string_view, NumMemoryUsageCategories> CATEGORY_NAMES{
+    "Guest memory", "Page tables", "JIT code cache", "Texture cache", "Buffer cache", "Shader IR",
+};
+} // Anonymous namespace
+
+void UpdateMemoryUsage(MemoryUsageCategory category, s64 num_bytes) {
+    Counters& counters = g_counters[static_cast<size_t>(category)];
+    const u64 current_bytes =
+        counters.current_bytes.fetch_add(static_cast<u64>(num_bytes), std::memory_order_relaxed) +
+        static_cast<u64>(num_bytes);
+    u64 peak = counters.peak_bytes.load(std::memory_order_relaxed);
+    while (current_bytes > peak && !counters.peak_bytes.compare_exchange_weak(
+                                       peak, current_bytes, std::memory_order_relaxed)) {
+    }
+}
+
+void SetMemoryBudget(MemoryUsageCategory category, u64 num_bytes) {
+    g_counters[static_cast<size_t>(category)].budget_bytes.store(num_bytes,
+                                                                 std::memory_order_relaxed);
+}
+
+MemoryUsage GetMemoryUsage(MemoryUsageCategory category) {
+    const Counters& counters = g_counters[static_cast<size_t>(category)];
+    return {
+        .current_bytes = counters.current_bytes.load(std::memory_order_relaxed),
+        .peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed),
+        .budget_bytes = counters.budget_bytes.load(std::memory_order_relaxed),
+    };
+}
+
+std::string_view GetMemoryUsageCategoryName(MemoryUsageCategory category) {
+    return CATEGORY_NAMES[static_cast<size_t>(category)];
+}
+
+void LogMemoryUsage() {
+    for (size_t i = 0; i < NumMemoryUsageCategories; ++i) {
+        const auto category = static_cast<MemoryUsageCategory>(i);
+        const MemoryUsage usage = GetMemoryUsage(category);
+        LOG_INFO(Common_Memory, "{}: {} KiB (peak {} KiB)", GetMemoryUsageCategoryName(category),
+                 usage.current_bytes / 1024, usage.peak_bytes / 1024);
+    }
+    LOG_INFO(Common_Memory, "Peak resident memory: {} KiB", GetPeakResidentMemory() / 1024);
+}
+
+} // namespace Common
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Subsystems whose host memory is accounted for
+enum class MemoryUsageCategory : u32 {
+    GuestMemory,  ///< Backing memory of the emulated DRAM
+    PageTables,   ///< Sub-tables committed by the GPU page tables
+    JitCodeCache, ///< Code caches of the CPU recompilers
+    TextureCache, ///< Images of the texture cache, as estimated by the cache
+    BufferCache,  ///< Buffers of the buffer cache, as estimated by the cache
+    ShaderIR,     ///< Object pools of the shader recompiler
+};
+constexpr size_t NumMemoryUsageCategories = 6;
+
+struct MemoryUsage {
+    u64 current_bytes;
+    u64 peak_bytes;
+    u64 budget_bytes; ///< Usage the owner tries to stay under, zero when it has no budget
+};
+
+/// Adds a signed number of bytes to the usage of a category
+void UpdateMemoryUsage(MemoryUsageCategory category, s64 num_bytes);
+
+/// Sets the usage the owner of a category tries to stay under
+void SetMemoryBudget(MemoryUsageCategory category, u64 num_bytes);
+
+[[nodiscard]] MemoryUsage GetMemoryUsage(MemoryUsageCategory category);
+
+[[nodiscard]] std::string_view GetMemoryUsageCategoryName(MemoryUsageCategory category);
+
+/// Logs the current and peak usage of every category, along with the peak resident memory
+void LogMemoryUsage();
+
+/// Bytes of a category owned by an object, given back when the object is destroyed
+class MemoryUsageCounter {
+public:
+    explicit MemoryUsageCounter(MemoryUsageCategory category_, u64 num_bytes = 0)
+        : category{category_} {
+        Add(num_bytes);
+    }
+
+    ~MemoryUsageCounter() {
+        if (bytes != 0) {
+            Subtract(bytes);
+        }
+    }
+
+    MemoryUsageCounter(const MemoryUsageCounter&) = delete;
+    MemoryUsageCounter& operator=(const MemoryUsageCounter&) = delete;
+
+    void Add(u64 num_bytes) {
+        bytes += num_bytes;
+        UpdateMemoryUsage(category, static_cast<s64>(num_bytes));
+    }
+
+    void Subtract(u64 num_bytes) {
+        bytes -= num_bytes;
+        UpdateMemoryUsage(category, -static_cast<s64>(num_bytes));
+    }
+
+    void Set(u64 num_bytes) {
+        UpdateMemoryUsage(category, static_cast<s64>(num_bytes - bytes));
+        bytes = num_bytes;
+    }
+
+private:
+    MemoryUsageCategory category;
+    u64 bytes{};
+};
+
+} // namespace Common
@@ -21,4 +21,14 @@ typedef void* HANDLE;
 
 #include <microprofile.h>
 
+#if MICROPROFILE_ENABLED
+#include "common/scope_trace.h"
+
+// Scopes are also recorded by Common::ScopeTrace, which exports them without the profiler UI.
+#undef MICROPROFILE_SCOPE
+#define MICROPROFILE_SCOPE(var)                                                                    \
+    MicroProfileScopeHandler MICROPROFILE_TOKEN_PASTE(foo, __LINE__)(g_mp_##var);                  \
+    Common::ScopeTrace::Scope MICROPROFILE_TOKEN_PASTE(scope_trace_, __LINE__)(g_mp_##var)
+#endif
+
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
@@ -1,9 +1,41 @@
 // SPDX-FileCopyrightText: 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <atomic>
+
+#include "common/memory_usage.h"
 #include "common/multi_level_page_table.inc"
 
 namespace Common {
+
+namespace {
+std::atomic<u64> g_committed_levels{};
+std::atomic<u64> g_committed_bytes{};
+std::atomic<u64> g_peak_committed_bytes{};
+} // Anonymous namespace
+
+namespace Detail {
+void UpdateCommittedLevels(s64 num_levels, s64 num_bytes) {
+    g_committed_levels.fetch_add(static_cast<u64>(num_levels), std::memory_order_relaxed);
+    const u64 committed_bytes =
+        g_committed_bytes.fetch_add(static_cast<u64>(num_bytes), std::memory_order_relaxed) +
+        static_cast<u64>(num_bytes);
+    u64 peak = g_peak_committed_bytes.load(std::memory_order_relaxed);
+    while (committed_bytes > peak && !g_peak_committed_bytes.compare_exchange_weak(
+                                         peak, committed_bytes, std::memory_order_relaxed)) {
+    }
+    UpdateMemoryUsage(MemoryUsageCategory::PageTables, num_bytes);
+}
+} // namespace Detail
+
+MultiLevelPageTableStatistics GetMultiLevelPageTableStatistics() {
+    return {
+        .committed_levels = g_committed_levels.load(std::memory_order_relaxed),
+        .committed_bytes = g_committed_bytes.load(std::memory_order_relaxed),
+        .peak_committed_bytes = g_peak_committed_bytes.load(std::memory_order_relaxed),
+    };
+}
+
 template class Common::MultiLevelPageTable<u64>;
 template class Common::MultiLevelPageTable<u32>;
 } // namespace Common
@@ -11,12 +11,30 @@
 
 namespace Common {
 
+/// Memory committed by the sub-tables of every MultiLevelPageTable in the process
+struct MultiLevelPageTableStatistics {
+    u64 committed_levels;
+    u64 committed_bytes;
+    u64 peak_committed_bytes;
+};
+
+[[nodiscard]] MultiLevelPageTableStatistics GetMultiLevelPageTableStatistics();
+
+namespace Detail {
+void UpdateCommittedLevels(s64 num_levels, s64 num_bytes);
+} // namespace Detail
+
 template <typename BaseAddr>
 class MultiLevelPageTable final {
 public:
     constexpr MultiLevelPageTable() = default;
+
+    /**
+     * @param compact When true, the table counts the entries in use of each sub-table through
+     *                MarkUsed and MarkUnused, and frees the sub-tables left without any.
+     */
     explicit MultiLevelPageTable(std::size_t address_space_bits, std::size_t first_level_bits,
-                                 std::size_t page_bits);
+                                 std::size_t page_bits, bool compact = false);
 
     ~MultiLevelPageTable() noexcept;
 
@@ -25,12 +43,16 @@ public:
 
     MultiLevelPageTable(MultiLevelPageTable&& other) noexcept
         : address_space_bits{std::exchange(other.address_space_bits, 0)},
-          first_level_bits{std::exchange(other.first_level_bits, 0)}, page_bits{std::exchange(
-                                                                          other.page_bits, 0)},
+          first_level_bits{std::exchange(other.first_level_bits, 0)},
+          page_bits{std::exchange(other.page_bits, 0)},
           first_level_shift{std::exchange(other.first_level_shift, 0)},
           first_level_chunk_size{std::exchange(other.first_level_chunk_size, 0)},
-          first_level_map{std::move(other.first_level_map)}, base_ptr{std::exchange(other.base_ptr,
-                                                                                    nullptr)} {}
+          level_index_shift{std::exchange(other.level_index_shift, 0)},
+          alloc_size{std::exchange(other.alloc_size, 0)},
+          num_committed_levels{std::exchange(other.num_committed_levels, 0)},
+          first_level_map{std::move(other.first_level_map)},
+          level_use_counts{std::move(other.level_use_counts)},
+          base_ptr{std::exchange(other.base_ptr, nullptr)} {}
 
     MultiLevelPageTable& operator=(MultiLevelPageTable&& other) noexcept {
         address_space_bits = std::exchange(other.address_space_bits, 0);
@@ -38,14 +60,40 @@ public:
         page_bits = std::exchange(other.page_bits, 0);
         first_level_shift = std::exchange(other.first_level_shift, 0);
         first_level_chunk_size = std::exchange(other.first_level_chunk_size, 0);
+        level_index_shift = std::exchange(other.level_index_shift, 0);
         alloc_size = std::exchange(other.alloc_size, 0);
+        num_committed_levels = std::exchange(other.num_committed_levels, 0);
         first_level_map = std::move(other.first_level_map);
+        level_use_counts = std::move(other.level_use_counts);
         base_ptr = std::exchange(other.base_ptr, nullptr);
         return *this;
     }
 
+    /// Commits the sub-tables holding the entries of the given address range.
     void ReserveRange(u64 start, std::size_t size);
 
+    /// Counts the entry at index as in use, its sub-table must have been reserved.
+    void MarkUsed(std::size_t index) {
+        if (!level_use_counts.empty()) {
+            ++level_use_counts[index >> level_index_shift];
+        }
+    }
+
+    /// Counts the entry at index as no longer in use, freeing its sub-table once it has none left.
+    void MarkUnused(std::size_t index) {
+        if (!level_use_counts.empty() && --level_use_counts[index >> level_index_shift] == 0) {
+            FreeLevel(index >> level_index_shift);
+        }
+    }
+
+    [[nodiscard]] std::size_t NumCommittedLevels() const noexcept {
+        return num_committed_levels;
+    }
+
+    [[nodiscard]] std::size_t CommittedBytes() const noexcept {
+        return num_committed_levels * first_level_chunk_size;
+    }
+
     [[nodiscard]] const BaseAddr& operator[](std::size_t index) const {
         return base_ptr[index];
     }
@@ -65,13 +113,18 @@ public:
 private:
     void AllocateLevel(u64 level);
 
+    void FreeLevel(u64 level);
+
     std::size_t address_space_bits{};
     std::size_t first_level_bits{};
     std::size_t page_bits{};
     std::size_t first_level_shift{};
     std::size_t first_level_chunk_size{};
+    std::size_t level_index_shift{};
     std::size_t alloc_size{};
+    std::size_t num_committed_levels{};
     std::vector<void*> first_level_map{};
+    std::vector<u32> level_use_counts{};
     BaseAddr* base_ptr{};
 };
 
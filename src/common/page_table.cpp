@@ -57,4 +57,10 @@ void PageTable::Resize(std::size_t address_space_width_in_bits, std::size_t page
     page_size = 1ULL << page_size_in_bits;
 }
 
+std::size_t PageTable::GetCommittedBytes() const noexcept {
+    return GetCommittedMemoryPagesSize(pointers.data(), pointers.size() * sizeof(PageInfo)) +
+           GetCommittedMemoryPagesSize(blocks.data(), blocks.size() * sizeof(u64)) +
+           GetCommittedMemoryPagesSize(backing_addr.data(), backing_addr.size() * sizeof(u64));
+}
+
 } // namespace Common
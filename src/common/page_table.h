@@ -114,6 +114,10 @@ struct PageTable {
      */
     void Resize(std::size_t address_space_width_in_bits, std::size_t page_size_in_bits);
 
+    /// Returns the host memory backing the tables, which only grows as pages are mapped on
+    /// systems committing memory lazily.
+    [[nodiscard]] std::size_t GetCommittedBytes() const noexcept;
+
     std::size_t GetAddressSpaceBits() const {
         return current_address_space_width_in_bits;
     }
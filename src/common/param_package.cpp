@@ -1,10 +1,9 @@
 // SPDX-FileCopyrightText: 2017 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <array>
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
-#include <vector>
 
 #include "common/logging/log.h"
 #include "common/param_package.h"
@@ -24,112 +23,169 @@ constexpr char ESCAPE_CHARACTER_ESCAPE[] = "$2";
 /// (they may be recognized as "not set" by some frontend libraries like qt)
 constexpr char EMPTY_PLACEHOLDER[] = "[empty]";
 
+namespace {
+
+std::string Unescape(std::string_view part) {
+    std::string result(part);
+    if (part.find(ESCAPE_CHARACTER) == std::string_view::npos) {
+        return result;
+    }
+    result = Common::ReplaceAll(result, KEY_VALUE_SEPARATOR_ESCAPE, {KEY_VALUE_SEPARATOR});
+    result = Common::ReplaceAll(result, PARAM_SEPARATOR_ESCAPE, {PARAM_SEPARATOR});
+    result = Common::ReplaceAll(result, ESCAPE_CHARACTER_ESCAPE, {ESCAPE_CHARACTER});
+    return result;
+}
+
+void AppendEscaped(std::string& result, std::string_view part) {
+    for (const char c : part) {
+        switch (c) {
+        case ESCAPE_CHARACTER:
+            result += ESCAPE_CHARACTER_ESCAPE;
+            break;
+        case PARAM_SEPARATOR:
+            result += PARAM_SEPARATOR_ESCAPE;
+            break;
+        case KEY_VALUE_SEPARATOR:
+            result += KEY_VALUE_SEPARATOR_ESCAPE;
+            break;
+        default:
+            result += c;
+            break;
+        }
+    }
+}
+
+} // Anonymous namespace
+
 ParamPackage::ParamPackage(const std::string& serialized) {
     if (serialized == EMPTY_PLACEHOLDER) {
         return;
     }
 
-    std::vector<std::string> pairs;
-    Common::SplitString(serialized, PARAM_SEPARATOR, pairs);
+    std::string_view remaining{serialized};
+    while (!remaining.empty()) {
+        const size_t pair_end = std::min(remaining.find(PARAM_SEPARATOR), remaining.size());
+        const std::string_view pair = remaining.substr(0, pair_end);
+        remaining.remove_prefix(std::min(pair_end + 1, remaining.size()));
 
-    for (const std::string& pair : pairs) {
-        std::vector<std::string> key_value;
-        Common::SplitString(pair, KEY_VALUE_SEPARATOR, key_value);
-        if (key_value.size() != 2) {
+        // Pairs need a single separator and a value, an empty key is allowed
+        const size_t separator = pair.find(KEY_VALUE_SEPARATOR);
+        if (separator == std::string_view::npos || separator + 1 == pair.size() ||
+            pair.find(KEY_VALUE_SEPARATOR, separator + 1) != std::string_view::npos) {
             LOG_ERROR(Common, "invalid key pair {}", pair);
             continue;
         }
+        Set(Unescape(pair.substr(0, separator)), Unescape(pair.substr(separator + 1)));
+    }
+}
 
-        for (std::string& part : key_value) {
-            part = Common::ReplaceAll(part, KEY_VALUE_SEPARATOR_ESCAPE, {KEY_VALUE_SEPARATOR});
-            part = Common::ReplaceAll(part, PARAM_SEPARATOR_ESCAPE, {PARAM_SEPARATOR});
-            part = Common::ReplaceAll(part, ESCAPE_CHARACTER_ESCAPE, {ESCAPE_CHARACTER});
+ParamPackage::ParamPackage(std::initializer_list<DataType::value_type> list) {
+    data.reserve(list.size());
+    for (const auto& [key, value] : list) {
+        // Like the map it replaces, the first value given for a key is kept
+        if (!Has(key)) {
+            Set(key, value);
         }
-
-        Set(key_value[0], std::move(key_value[1]));
     }
 }
 
-ParamPackage::ParamPackage(std::initializer_list<DataType::value_type> list) : data(list) {}
-
 std::string ParamPackage::Serialize() const {
     if (data.empty())
         return EMPTY_PLACEHOLDER;
 
     std::string result;
 
-    for (const auto& pair : data) {
-        std::array<std::string, 2> key_value{{pair.first, pair.second}};
-        for (std::string& part : key_value) {
-            part = Common::ReplaceAll(part, {ESCAPE_CHARACTER}, ESCAPE_CHARACTER_ESCAPE);
-            part = Common::ReplaceAll(part, {PARAM_SEPARATOR}, PARAM_SEPARATOR_ESCAPE);
-            part = Common::ReplaceAll(part, {KEY_VALUE_SEPARATOR}, KEY_VALUE_SEPARATOR_ESCAPE);
-        }
-        result += key_value[0] + KEY_VALUE_SEPARATOR + key_value[1] + PARAM_SEPARATOR;
+    for (const auto& [key, value] : data) {
+        AppendEscaped(result, key);
+        result += KEY_VALUE_SEPARATOR;
+        AppendEscaped(result, value);
+        result += PARAM_SEPARATOR;
     }
 
     result.pop_back(); // discard the trailing PARAM_SEPARATOR
     return result;
 }
 
-std::string ParamPackage::Get(const std::string& key, const std::string& default_value) const {
-    auto pair = data.find(key);
-    if (pair == data.end()) {
+const std::string* ParamPackage::Find(std::string_view key) const {
+    const auto it = std::ranges::lower_bound(data, key, {}, [](const auto& pair) {
+        return std::string_view{pair.first};
+    });
+    if (it == data.end() || it->first != key) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+std::string ParamPackage::Get(std::string_view key, const std::string& default_value) const {
+    const std::string* const value = Find(key);
+    if (!value) {
         LOG_TRACE(Common, "key '{}' not found", key);
         return default_value;
     }
 
-    return pair->second;
+    return *value;
 }
 
-int ParamPackage::Get(const std::string& key, int default_value) const {
-    auto pair = data.find(key);
-    if (pair == data.end()) {
+int ParamPackage::Get(std::string_view key, int default_value) const {
+    const std::string* const value = Find(key);
+    if (!value) {
         LOG_TRACE(Common, "key '{}' not found", key);
         return default_value;
     }
 
     try {
-        return std::stoi(pair->second);
+        return std::stoi(*value);
     } catch (const std::logic_error&) {
-        LOG_ERROR(Common, "failed to convert {} to int", pair->second);
+        LOG_ERROR(Common, "failed to convert {} to int", *value);
         return default_value;
     }
 }
 
-float ParamPackage::Get(const std::string& key, float default_value) const {
-    auto pair = data.find(key);
-    if (pair == data.end()) {
+float ParamPackage::Get(std::string_view key, float default_value) const {
+    const std::string* const value = Find(key);
+    if (!value) {
         LOG_TRACE(Common, "key {} not found", key);
         return default_value;
     }
 
     try {
-        return std::stof(pair->second);
+        return std::stof(*value);
     } catch (const std::logic_error&) {
-        LOG_ERROR(Common, "failed to convert {} to float", pair->second);
+        LOG_ERROR(Common, "failed to convert {} to float", *value);
         return default_value;
     }
 }
 
-void ParamPackage::Set(const std::string& key, std::string value) {
-    data.insert_or_assign(key, std::move(value));
+void ParamPackage::Set(std::string_view key, std::string value) {
+    const auto it = std::ranges::lower_bound(data, key, {}, [](const auto& pair) {
+        return std::string_view{pair.first};
+    });
+    if (it != data.end() && it->first == key) {
+        it->second = std::move(value);
+        return;
+    }
+    data.emplace(it, std::string(key), std::move(value));
 }
 
-void ParamPackage::Set(const std::string& key, int value) {
-    data.insert_or_assign(key, std::to_string(value));
+void ParamPackage::Set(std::string_view key, int value) {
+    Set(key, std::to_string(value));
 }
 
-void ParamPackage::Set(const std::string& key, float value) {
-    data.insert_or_assign(key, std::to_string(value));
+void ParamPackage::Set(std::string_view key, float value) {
+    Set(key, std::to_string(value));
 }
 
-bool ParamPackage::Has(const std::string& key) const {
-    return data.find(key) != data.end();
+bool ParamPackage::Has(std::string_view key) const {
+    return Find(key) != nullptr;
 }
 
-void ParamPackage::Erase(const std::string& key) {
-    data.erase(key);
+void ParamPackage::Erase(std::string_view key) {
+    const auto it = std::ranges::lower_bound(data, key, {}, [](const auto& pair) {
+        return std::string_view{pair.first};
+    });
+    if (it != data.end() && it->first == key) {
+        data.erase(it);
+    }
 }
 
 void ParamPackage::Clear() {
@@ -5,14 +5,17 @@
 
 #include <initializer_list>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace Common {
 
-/// A string-based key-value container supporting serializing to and deserializing from a string
+/// A string-based key-value container supporting serializing to and deserializing from a string.
+/// Packages hold a handful of entries, so they are kept in a vector sorted by key.
 class ParamPackage {
 public:
-    using DataType = std::unordered_map<std::string, std::string>;
+    using DataType = std::vector<std::pair<std::string, std::string>>;
 
     ParamPackage() = default;
     explicit ParamPackage(const std::string& serialized);
@@ -24,17 +27,20 @@ public:
     ParamPackage& operator=(ParamPackage&& other) = default;
 
     [[nodiscard]] std::string Serialize() const;
-    [[nodiscard]] std::string Get(const std::string& key, const std::string& default_value) const;
-    [[nodiscard]] int Get(const std::string& key, int default_value) const;
-    [[nodiscard]] float Get(const std::string& key, float default_value) const;
-    void Set(const std::string& key, std::string value);
-    void Set(const std::string& key, int value);
-    void Set(const std::string& key, float value);
-    [[nodiscard]] bool Has(const std::string& key) const;
-    void Erase(const std::string& key);
+    [[nodiscard]] std::string Get(std::string_view key, const std::string& default_value) const;
+    [[nodiscard]] int Get(std::string_view key, int default_value) const;
+    [[nodiscard]] float Get(std::string_view key, float default_value) const;
+    void Set(std::string_view key, std::string value);
+    void Set(std::string_view key, int value);
+    void Set(std::string_view key, float value);
+    [[nodiscard]] bool Has(std::string_view key) const;
+    void Erase(std::string_view key);
     void Clear();
 
 private:
+    /// Returns the entry with the given key, or nullptr if there is none
+    [[nodiscard]] const std::string* Find(std::string_view key) const;
+
     DataType data;
 };
 
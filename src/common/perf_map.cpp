@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <mutex>
+
+#include <fmt/format.h>
+
+#include "common/perf_map.h"
+#include "common/settings.h"
+
+#ifdef __linux__
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "common/common_types.h"
+#include "common/logging/log.h"
+#endif
+
+namespace Common::PerfMap {
+
+#ifdef __linux__
+
+namespace {
+
+// Layout of the jitdump format understood by `perf inject --jit`
+constexpr u32 JITDUMP_MAGIC = 0x4A695444;
+constexpr u32 JITDUMP_VERSION = 1;
+constexpr u32 JIT_CODE_LOAD = 0;
+
+#if defined(__x86_64__)
+constexpr u32 JITDUMP_ELF_MACHINE = 62; // EM_X86_64
+#elif defined(__aarch64__)
+constexpr u32 JITDUMP_ELF_MACHINE = 183; // EM_AARCH64
+#else
+constexpr u32 JITDUMP_ELF_MACHINE = 0;
+#endif
+
+struct JitDumpHeader {
+    u32 magic;
+    u32 version;
+    u32 total_size;
+    u32 elf_mach;
+    u32 pad1;
+    u32 pid;
+    u64 timestamp;
+    u64 flags;
+};
+static_assert(sizeof(JitDumpHeader) == 40);
+
+struct JitCodeLoad {
+    u32 id;
+    u32 total_size;
+    u64 timestamp;
+    u32 pid;
+    u32 tid;
+    u64 vma;
+    u64 code_addr;
+    u64 code_size;
+    u64 code_index;
+};
+static_assert(sizeof(JitCodeLoad) == 56);
+
+u64 Timestamp() {
+    // perf has to be run with `-k mono` to correlate samples with these timestamps
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<u64>(ts.tv_sec) * 1'000'000'000ULL + static_cast<u64>(ts.tv_nsec);
+}
+
+class Writer {
+public:
+    Writer() {
+        const pid_t pid = getpid();
+        const std::string map_path = fmt::format("/tmp/perf-{}.map", pid);
+        map_file = std::fopen(map_path.c_str(), "w");
+        if (!map_file) {
+            LOG_ERROR(Common, "Failed to create perf map {}", map_path);
+        }
+        OpenJitDump(pid);
+    }
+
+    ~Writer() {
+        if (map_file) {
+            std::fclose(map_file);
+        }
+        if (jitdump_marker != MAP_FAILED) {
+            munmap(jitdump_marker, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        }
+        if (jitdump_file) {
+            std::fclose(jitdump_file);
+        }
+    }
+
+    void Register(const void* start, std::size_t size, std::string_view name) {
+        std::scoped_lock lk{mutex};
+        if (map_file) {
+            fmt::print(map_file, "{:x} {:x} {}\n", reinterpret_cast<uintptr_t>(start), size, name);
+            std::fflush(map_file);
+        }
+        if (jitdump_file) {
+            const auto address = static_cast<u64>(reinterpret_cast<uintptr_t>(start));
+            const JitCodeLoad record{
+                .id = JIT_CODE_LOAD,
+                .total_size = static_cast<u32>(sizeof(JitCodeLoad) + name.size() + 1 + size),
+                .timestamp = Timestamp(),
+                .pid = static_cast<u32>(getpid()),
+                .tid = static_cast<u32>(syscall(SYS_gettid)),
+                .vma = address,
+                .code_addr = address,
+                .code_size = size,
+                .code_index = code_index++,
+            };
+            std::fwrite(&record, sizeof(record), 1, jitdump_file);
+            std::fwrite(name.data(), 1, name.size(), jitdump_file);
+            std::fputc('\0', jitdump_file);
+            std::fwrite(start, 1, size, jitdump_file);
+            std::fflush(jitdump_file);
+        }
+    }
+
+private:
+    void OpenJitDump(pid_t pid) {
+        const std::string path = fmt::format("jit-{}.dump", pid);
+        const int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0666);
+        if (fd < 0) {
+            LOG_ERROR(Common, "Failed to create jitdump {}", path);
+            return;
+        }
+        // perf finds the dump through an executable mapping of it recorded in the trace
+        jitdump_marker = mmap(nullptr, static_cast<size_t>(sysconf(_SC_PAGESIZE)),
+                              PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0);
+        jitdump_file = fdopen(fd, "wb");
+        if (!jitdump_file) {
+            close(fd);
+            return;
+        }
+        const JitDumpHeader header{
+            .magic = JITDUMP_MAGIC,
+            .version = JITDUMP_VERSION,
+            .total_size = sizeof(JitDumpHeader),
+            .elf_mach = JITDUMP_ELF_MACHINE,
+            .pad1 = 0,
+            .pid = static_cast<u32>(pid),
+            .timestamp = Timestamp(),
+            .flags = 0,
+        };
+        std::fwrite(&header, sizeof(header), 1, jitdump_file);
+        std::fflush(jitdump_file);
+    }
+
+    std::mutex mutex;
+    std::FILE* map_file{};
+    std::FILE* jitdump_file{};
+    void* jitdump_marker{MAP_FAILED};
+    u64 code_index{};
+};
+
+} // Anonymous namespace
+
+bool IsEnabled() {
+    return Settings::values.enable_perf_map.GetValue();
+}
+
+void Register(const void* start, std::size_t size, std::string_view name) {
+    if (!IsEnabled() || size == 0) {
+        return;
+    }
+    static Writer writer;
+    writer.Register(start, size, name);
+}
+
+#else
+
+bool IsEnabled() {
+    return false;
+}
+
+void Register(const void*, std::size_t, std::string_view) {}
+
+#endif
+
+} // namespace Common::PerfMap
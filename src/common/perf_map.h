@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace Common::PerfMap {
+
+/// Returns true when generated code should be reported to host profilers.
+[[nodiscard]] bool IsEnabled();
+
+/**
+ * Reports a region of generated host code to profilers such as perf, by writing it to
+ * /tmp/perf-<pid>.map and to a jitdump file in the working directory.
+ * Does nothing unless the enable_perf_map setting is set.
+ *
+ * @param start Start of the generated code.
+ * @param size  Size of the generated code in bytes.
+ * @param name  Name the samples in this region are attributed to.
+ */
+void Register(const void* start, std::size_t size, std::string_view name);
+
+} // namespace Common::PerfMap
@@ -23,6 +23,10 @@ public:
 
     void Add(AddressType base_address, size_t size);
     void Subtract(AddressType base_address, size_t size);
+
+    /// Removes every range of other from this set
+    void Subtract(const RangeSet& other);
+
     void Clear();
     bool Empty() const;
 
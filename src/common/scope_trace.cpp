@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/scm_rev.h"
+#include "common/scope_trace.h"
+#include "common/steady_clock.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace Common::ScopeTrace {
+
+namespace Detail {
+std::atomic_bool g_is_recording{};
+} // namespace Detail
+
+namespace {
+
+/// Number of scopes kept for each thread, the oldest ones are overwritten once it is full.
+constexpr u64 EventsPerThread = 1ULL << 17;
+
+struct Event {
+    u64 token;
+    s64 start_ns;
+    s64 duration_ns;
+};
+
+struct ThreadBuffer {
+    std::string name;
+    u32 thread_id{};
+    /// Recording session of the events, the owning thread drops stale events when it changes.
+    std::atomic<u64> generation{};
+    /// Number of events written by the owning thread, including overwritten ones.
+    std::atomic<u64> count{};
+    std::atomic_bool has_exited{};
+    std::array<Event, EventsPerThread> events;
+};
+
+/// Flags the buffer of the current thread for removal once the thread exits.
+struct ThreadBufferOwner {
+    ThreadBuffer* buffer{};
+
+    ~ThreadBufferOwner() {
+        if (buffer) {
+            buffer->has_exited = true;
+        }
+    }
+};
+
+std::mutex g_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+std::atomic<u64> g_generation{};
+s64 g_start_ns{};
+u32 g_next_thread_id{};
+
+thread_local ThreadBufferOwner t_owner;
+
+std::string GetCurrentThreadName(u32 thread_id) {
+#if defined(__linux__) || defined(__APPLE__)
+    std::array<char, 64> name{};
+    if (pthread_getname_np(pthread_self(), name.data(), name.size()) == 0 && name[0] != '\0') {
+        return name.data();
+    }
+#endif
+    return fmt::format("Thread {}", thread_id);
+}
+
+ThreadBuffer& GetThreadBuffer() {
+    if (!t_owner.buffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+
+        std::scoped_lock lk{g_mutex};
+        buffer->thread_id = g_next_thread_id++;
+        buffer->name = GetCurrentThreadName(buffer->thread_id);
+        t_owner.buffer = g_buffers.emplace_back(std::move(buffer)).get();
+    }
+    return *t_owner.buffer;
+}
+
+std::string EscapeJson(std::string_view str) {
+    std::string out;
+    out.reserve(str.size());
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+std::string GetTimerName(u64 token) {
+    MicroProfile* const profile = MicroProfileGet();
+    const u16 timer_index = MicroProfileGetTimerIndex(token);
+    return fmt::format("{}/{}", profile->GroupInfo[profile->TimerToGroup[timer_index]].pName,
+                       profile->TimerInfo[timer_index].pName);
+}
+
+} // Anonymous namespace
+
+namespace Detail {
+
+s64 GetTimeNs() {
+    return SteadyClock::Now().time_since_epoch().count();
+}
+
+void RecordScope(u64 token, s64 start_ns) {
+    const s64 end_ns = GetTimeNs();
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    u64 count = buffer.count.load(std::memory_order_relaxed);
+    const u64 generation = g_generation.load(std::memory_order_relaxed);
+    if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+        buffer.generation.store(generation, std::memory_order_relaxed);
+        count = 0;
+    }
+    buffer.events[count % EventsPerThread] = {
+        .token = token,
+        .start_ns = start_ns,
+        .duration_ns = end_ns - start_ns,
+    };
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+} // namespace Detail
+
+void Start() {
+    std::scoped_lock lk{g_mutex};
+    std::erase_if(g_buffers, [](const auto& buffer) { return buffer->has_exited.load(); });
+    ++g_generation;
+    g_start_ns = Detail::GetTimeNs();
+    Detail::g_is_recording = true;
+}
+
+void Finish(std::string_view title) {
+    if (!Detail::g_is_recording.exchange(false)) {
+        return;
+    }
+
+    std::string events;
+    u64 num_events = 0;
+    u64 num_overwritten = 0;
+    {
+        std::scoped_lock lk{g_mutex};
+        std::scoped_lock profile_lk{MicroProfileGetMutex()};
+        const u64 generation = g_generation.load();
+        for (const auto& buffer : g_buffers) {
+            const u64 count = buffer->count.load(std::memory_order_acquire);
+            if (buffer->generation.load(std::memory_order_relaxed) != generation || count == 0) {
+                continue;
+            }
+            fmt::format_to(std::back_inserter(events),
+                           R"(  {{"name":"thread_name","ph":"M","pid":0,"tid":{},)"
+                           R"("args":{{"name":"{}"}}}},)"
+                           "\n",
+                           buffer->thread_id, EscapeJson(buffer->name));
+
+            const u64 first = count > EventsPerThread ? count - EventsPerThread : 0;
+            for (u64 i = first; i < count; ++i) {
+                const Event& event = buffer->events[i % EventsPerThread];
+                fmt::format_to(std::back_inserter(events),
+                               R"(  {{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},)"
+                               R"("dur":{:.3f}}},)"
+                               "\n",
+                               EscapeJson(GetTimerName(event.token)), buffer->thread_id,
+                               static_cast<double>(event.start_ns - g_start_ns) / 1e3,
+                               static_cast<double>(event.duration_ns) / 1e3);
+            }
+            num_events += count - first;
+            num_overwritten += first;
+        }
+    }
+    if (!events.empty()) {
+        // Drop the separator of the last event
+        events.resize(events.size() - 2);
+    }
+
+    const auto path =
+        FS::GetYuzuPath(FS::YuzuPath::LogDir) / "trace" / fmt::format("{}.json", title);
+    if (!FS::CreateParentDirs(path)) {
+        LOG_ERROR(Common, "Failed to create the scope trace directory");
+        return;
+    }
+    const auto trace =
+        fmt::format("{{\"otherData\":{{\"title\":\"{}\",\"build\":\"{}\"}},\n"
+                    "\"displayTimeUnit\":\"ms\",\n\"traceEvents\":[\n{}\n]}}\n",
+                    EscapeJson(title), EscapeJson(g_build_fullname), events);
+    if (FS::WriteStringToFile(path, FS::FileType::TextFile, trace) != trace.size()) {
+        LOG_ERROR(Common, "Failed to write the scope trace");
+        return;
+    }
+    LOG_INFO(Common, "Wrote {} profiler scopes to {} ({} older scopes were overwritten)",
+             num_events, FS::PathToUTF8String(path), num_overwritten);
+}
+
+} // namespace Common::ScopeTrace
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <string_view>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Common::ScopeTrace {
+
+namespace Detail {
+extern std::atomic_bool g_is_recording;
+
+s64 GetTimeNs();
+void RecordScope(u64 token, s64 start_ns);
+} // namespace Detail
+
+/// Discards previously recorded scopes and starts recording the profiler scopes of every thread.
+void Start();
+
+/**
+ * Stops recording and writes the recorded scopes to the log directory as a Chrome trace named
+ * after the title. The traced threads should be idle, scopes ending during the export may be lost.
+ */
+void Finish(std::string_view title);
+
+/// Records the time between its construction and destruction under a microprofile token.
+class Scope {
+    YUZU_NON_COPYABLE(Scope);
+    YUZU_NON_MOVEABLE(Scope);
+
+public:
+    explicit Scope(u64 token) : m_token{token} {
+        if (Detail::g_is_recording.load(std::memory_order_relaxed)) {
+            m_start_ns = Detail::GetTimeNs();
+        }
+    }
+
+    ~Scope() {
+        if (m_start_ns >= 0) {
+            Detail::RecordScope(m_token, m_start_ns);
+        }
+    }
+
+private:
+    u64 m_token;
+    s64 m_start_ns{-1};
+};
+
+} // namespace Common::ScopeTrace
@@ -4,8 +4,11 @@
 #pragma once
 
 #include <iterator>
+#include <memory>
+#include <type_traits>
 
 #include "common/make_unique_for_overwrite.h"
+#include "common/scratch_pool.h"
 
 namespace Common {
 
@@ -35,7 +38,7 @@ public:
 
     explicit ScratchBuffer(size_type initial_capacity)
         : last_requested_size{initial_capacity}, buffer_capacity{initial_capacity},
-          buffer{Common::make_unique_for_overwrite<T[]>(initial_capacity)} {}
+          buffer{Common::make_unique_for_overwrite<T[]>(initial_capacity).release()} {}
 
     ~ScratchBuffer() = default;
     ScratchBuffer(const ScratchBuffer&) = delete;
@@ -60,10 +63,11 @@ public:
     /// The previously held data will remain intact.
     void resize(size_type size) {
         if (size > buffer_capacity) {
-            auto new_buffer = Common::make_unique_for_overwrite<T[]>(size);
+            size_type new_capacity = size;
+            auto new_buffer = Allocate(new_capacity);
             std::move(buffer.get(), buffer.get() + buffer_capacity, new_buffer.get());
             buffer = std::move(new_buffer);
-            buffer_capacity = size;
+            buffer_capacity = new_capacity;
         }
         last_requested_size = size;
     }
@@ -72,8 +76,10 @@ public:
     /// The previously held data will be destroyed if a reallocation occurs.
     void resize_destructive(size_type size) {
         if (size > buffer_capacity) {
+            // Release the old buffer first so a pooled one can be reused by the allocation
+            buffer.reset();
             buffer_capacity = size;
-            buffer = Common::make_unique_for_overwrite<T[]>(buffer_capacity);
+            buffer = Allocate(buffer_capacity);
         }
         last_requested_size = size;
     }
@@ -122,12 +128,62 @@ public:
         std::swap(last_requested_size, other.last_requested_size);
         std::swap(buffer_capacity, other.buffer_capacity);
         std::swap(buffer, other.buffer);
+        std::swap(use_pool, other.use_pool);
     }
 
+protected:
+    struct UsePool {};
+
+    explicit ScratchBuffer(UsePool) : use_pool{true} {}
+
 private:
+    static constexpr bool IsPoolable =
+        std::is_trivially_copyable_v<T> && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    /// Frees buffers the way they were allocated, the size of pooled blocks is kept here.
+    struct Deleter {
+        size_t pooled_size{};
+
+        void operator()(T* elements) const noexcept {
+            if (pooled_size != 0) {
+                ScratchPool::Return(elements, pooled_size);
+            } else {
+                delete[] elements;
+            }
+        }
+    };
+
+    /// Allocates a buffer of at least capacity elements, rounding capacity up to its real size.
+    std::unique_ptr<T[], Deleter> Allocate(size_type& capacity) {
+        if constexpr (IsPoolable) {
+            if (use_pool) {
+                size_t size = capacity * sizeof(T);
+                T* const elements = static_cast<T*>(ScratchPool::Borrow(size));
+                capacity = size / sizeof(T);
+                return std::unique_ptr<T[], Deleter>(elements, Deleter{size});
+            }
+        }
+        return std::unique_ptr<T[], Deleter>(
+            Common::make_unique_for_overwrite<T[]>(capacity).release());
+    }
+
     size_type last_requested_size{};
     size_type buffer_capacity{};
-    std::unique_ptr<T[]> buffer{};
+    std::unique_ptr<T[], Deleter> buffer{};
+    bool use_pool{};
+};
+
+/**
+ * ScratchBuffer borrowing its memory from the scratch pool of the current thread and giving it
+ * back when destroyed or grown. Meant for buffers created for each request, which would otherwise
+ * allocate from the heap every time.
+ */
+template <typename T>
+class PooledScratchBuffer : public ScratchBuffer<T> {
+    static_assert(std::is_trivially_copyable_v<T>, "Pooled buffers are not constructed");
+
+public:
+    PooledScratchBuffer() : ScratchBuffer<T>(typename ScratchBuffer<T>::UsePool{}) {}
 };
 
 } // namespace Common
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <new>
+#include <vector>
+
+#include "common/scratch_pool.h"
+
+namespace Common::ScratchPool {
+
+namespace {
+
+constexpr size_t MinClassBits = 12;
+constexpr size_t MaxClassBits = 26;
+constexpr size_t NumClasses = MaxClassBits - MinClassBits + 1;
+
+/// Blocks of each size class kept by a thread, extra blocks go back to the heap.
+constexpr size_t MaxCachedBlocks = 4;
+
+std::atomic<u64> g_live_bytes{};
+std::atomic<u64> g_peak_live_bytes{};
+std::atomic<u64> g_cached_bytes{};
+std::atomic<u64> g_heap_allocations{};
+
+struct ThreadCache {
+    std::array<std::vector<void*>, NumClasses> free_blocks;
+
+    ~ThreadCache();
+};
+
+// Scratch buffers owned by other thread locals can be destroyed after the cache of their thread,
+// their memory is freed directly then.
+thread_local bool t_is_pool_destroyed{};
+thread_local ThreadCache t_cache;
+
+ThreadCache::~ThreadCache() {
+    for (size_t index = 0; index < NumClasses; ++index) {
+        for (void* const block : free_blocks[index]) {
+            ::operator delete(block);
+        }
+        g_cached_bytes -= free_blocks[index].size() << (index + MinClassBits);
+    }
+    t_is_pool_destroyed = true;
+}
+
+/// Returns the index of the size class holding blocks of at least size bytes, or NumClasses when
+/// the size is too large to be pooled.
+size_t ClassIndex(size_t size) {
+    const size_t bits = std::bit_width(std::max<size_t>(size, 1) - 1);
+    return bits <= MinClassBits ? 0 : bits - MinClassBits;
+}
+
+void UpdatePeak(u64 live_bytes) {
+    u64 peak = g_peak_live_bytes.load(std::memory_order_relaxed);
+    while (live_bytes > peak &&
+           !g_peak_live_bytes.compare_exchange_weak(peak, live_bytes, std::memory_order_relaxed)) {
+    }
+}
+
+} // Anonymous namespace
+
+void* Borrow(size_t& size) {
+    const size_t index = ClassIndex(size);
+    if (index < NumClasses) {
+        size = size_t{1} << (index + MinClassBits);
+    }
+    UpdatePeak(g_live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+
+    if (index < NumClasses && !t_is_pool_destroyed) {
+        auto& blocks = t_cache.free_blocks[index];
+        if (!blocks.empty()) {
+            void* const block = blocks.back();
+            blocks.pop_back();
+            g_cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+            return block;
+        }
+    }
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size);
+}
+
+void Return(void* block, size_t size) noexcept {
+    g_live_bytes.fetch_sub(size, std::memory_order_relaxed);
+
+    const size_t index = ClassIndex(size);
+    if (index < NumClasses && !t_is_pool_destroyed) {
+        auto& blocks = t_cache.free_blocks[index];
+        if (blocks.size() < MaxCachedBlocks) {
+            // The vectors never hold more than MaxCachedBlocks, so this only allocates once
+            blocks.reserve(MaxCachedBlocks);
+            blocks.push_back(block);
+            g_cached_bytes.fetch_add(size, std::memory_order_relaxed);
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
+Statistics GetStatistics() {
+    return {
+        .live_bytes = g_live_bytes.load(std::memory_order_relaxed),
+        .peak_live_bytes = g_peak_live_bytes.load(std::memory_order_relaxed),
+        .cached_bytes = g_cached_bytes.load(std::memory_order_relaxed),
+        .heap_allocations = g_heap_allocations.load(std::memory_order_relaxed),
+    };
+}
+
+} // namespace Common::ScratchPool
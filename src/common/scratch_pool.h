@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "common/common_types.h"
+
+/**
+ * Per-thread cache of scratch memory blocks, sorted in power of two size classes. Borrowing a
+ * block reuses one returned earlier on the same thread when possible, so temporary buffers
+ * created for each request stop going through the heap once the pool has warmed up.
+ */
+namespace Common::ScratchPool {
+
+struct Statistics {
+    u64 live_bytes;       ///< Bytes currently borrowed by every thread
+    u64 peak_live_bytes;  ///< Highest number of bytes borrowed at once
+    u64 cached_bytes;     ///< Bytes kept by the pools of every thread for reuse
+    u64 heap_allocations; ///< Blocks that had to be allocated from the heap
+};
+
+/// Borrows a block of at least size bytes from the pool of the calling thread.
+/// The size is rounded up to the size of the returned block.
+[[nodiscard]] void* Borrow(size_t& size);
+
+/// Gives a block back to the pool of the calling thread, which may not be the one it was
+/// borrowed from. The size must be the one returned by Borrow.
+void Return(void* block, size_t size) noexcept;
+
+[[nodiscard]] Statistics GetStatistics();
+
+} // namespace Common::ScratchPool
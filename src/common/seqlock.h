@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Sequence lock holding a copy of a trivially copyable value.
+ * Readers never block: they retry when a store happened while they were copying. Stores never
+ * wait for readers, but must be serialized by the caller.
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class SeqLock {
+public:
+    SeqLock() {
+        Store(T{});
+    }
+
+    explicit SeqLock(const T& value) {
+        Store(value);
+    }
+
+    /// Publishes a new value. Only one thread may store at a time.
+    void Store(const T& value) noexcept {
+        std::array<u64, NumWords> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const u64 current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < NumWords; ++i) {
+            storage[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    /// Returns a copy of the last published value
+    [[nodiscard]] T Load() const noexcept {
+        std::array<u64, NumWords> words;
+        u64 begin;
+        u64 end;
+        do {
+            begin = sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < NumWords; ++i) {
+                words[i] = storage[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            end = sequence.load(std::memory_order_relaxed);
+        } while (begin != end || (begin & 1) != 0);
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t NumWords = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+
+    std::atomic<u64> sequence{};
+    std::array<std::atomic<u64>, NumWords> storage{};
+};
+
+} // namespace Common
@@ -65,6 +65,7 @@ SWITCHABLE(AstcRecompression, true);
 SWITCHABLE(AudioMode, true);
 SWITCHABLE(CpuBackend, true);
 SWITCHABLE(CpuAccuracy, true);
+SWITCHABLE(FramePacing, false);
 SWITCHABLE(FullscreenMode, true);
 SWITCHABLE(GpuAccuracy, true);
 SWITCHABLE(Language, true);
@@ -189,15 +190,25 @@ struct Values {
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
+    Setting<bool> audio_renderer_realtime{linkage, false, "audio_renderer_realtime",
+                                          Category::Audio};
+    Setting<bool> adaptive_audio_latency{linkage, true, "adaptive_audio_latency", Category::Audio};
+    Setting<bool> host_timed_voice_drop{linkage, false, "host_timed_voice_drop", Category::Audio};
+    Setting<bool> cache_adpcm_decode{linkage, true, "cache_adpcm_decode", Category::Audio};
 
     // Core
     SwitchableSetting<bool> use_multi_core{linkage, true, "use_multi_core", Category::Core};
+    SwitchableSetting<bool> use_adaptive_idle{linkage, true, "use_adaptive_idle", Category::Core};
+    Setting<bool> use_performance_cores{linkage, true, "use_performance_cores", Category::Core};
+    Setting<std::string> host_core_affinity{linkage, std::string(), "host_core_affinity",
+                                            Category::Core};
     SwitchableSetting<MemoryLayout, true> memory_layout_mode{linkage,
                                                              MemoryLayout::Memory_4Gb,
                                                              MemoryLayout::Memory_4Gb,
                                                              MemoryLayout::Memory_8Gb,
                                                              "memory_layout_mode",
                                                              Category::Core};
+    Setting<bool> use_huge_pages{linkage, false, "use_huge_pages", Category::Core};
     SwitchableSetting<bool> use_speed_limit{
         linkage, true, "use_speed_limit", Category::Core, Specialization::Paired, false, true};
     SwitchableSetting<u16, true> speed_limit{linkage,
@@ -322,6 +333,19 @@ struct Values {
     ResolutionScalingInfo resolution_info{};
     SwitchableSetting<ResolutionSetup> resolution_setup{linkage, ResolutionSetup::Res1X,
                                                         "resolution_setup", Category::Renderer};
+    // Lowers the resolution scale down to dynamic_resolution_min when the GPU time of frames
+    // exceeds the budget of the target frame rate, resolution_setup is the upper bound
+    SwitchableSetting<bool> dynamic_resolution{linkage, false, "dynamic_resolution",
+                                               Category::Renderer};
+    SwitchableSetting<ResolutionSetup> dynamic_resolution_min{
+        linkage, ResolutionSetup::Res1_2X, "dynamic_resolution_min", Category::Renderer};
+    SwitchableSetting<u16, true> dynamic_resolution_target_fps{linkage,
+                                                               60,
+                                                               20,
+                                                               240,
+                                                               "dynamic_resolution_target_fps",
+                                                               Category::Renderer,
+                                                               Specialization::Countable};
     SwitchableSetting<ScalingFilter> scaling_filter{linkage,
                                                     ScalingFilter::Bilinear,
                                                     "scaling_filter",
@@ -384,12 +408,50 @@ struct Values {
                                                                   AstcRecompression::Bc3,
                                                                   "astc_recompression",
                                                                   Category::RendererAdvanced};
+    SwitchableSetting<bool> use_astc_transcode_cache{linkage, false, "use_astc_transcode_cache",
+                                                     Category::RendererAdvanced};
+    SwitchableSetting<u32, true> astc_transcode_cache_size{linkage,
+                                                           1024,
+                                                           16,
+                                                           65536,
+                                                           "astc_transcode_cache_size",
+                                                           Category::RendererAdvanced,
+                                                           Specialization::Countable};
     SwitchableSetting<VramUsageMode, true> vram_usage_mode{linkage,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Conservative,
                                                            VramUsageMode::Aggressive,
                                                            "vram_usage_mode",
                                                            Category::RendererAdvanced};
+    SwitchableSetting<bool> use_texture_deduplication{linkage, false, "use_texture_deduplication",
+                                                      Category::RendererAdvanced};
+    SwitchableSetting<bool> use_host_memory_import{linkage, false, "use_host_memory_import",
+                                                   Category::RendererAdvanced};
+    SwitchableSetting<bool> use_staging_arena{linkage, false, "use_staging_arena",
+                                              Category::RendererAdvanced};
+    SwitchableSetting<bool> parallel_command_recording{linkage, false,
+                                                       "parallel_command_recording",
+                                                       Category::RendererAdvanced};
+    SwitchableSetting<bool> use_descriptor_buffer{linkage, false, "use_descriptor_buffer",
+                                                  Category::RendererAdvanced};
+    SwitchableSetting<bool> low_latency_presentation{linkage, false, "low_latency_presentation",
+                                                     Category::RendererAdvanced};
+    SwitchableSetting<bool> use_dynamic_rendering{linkage, false, "use_dynamic_rendering",
+                                                  Category::RendererAdvanced};
+    SwitchableSetting<bool> use_gpu_conditional_rendering{
+        linkage, false, "use_gpu_conditional_rendering", Category::RendererAdvanced};
+    SwitchableSetting<bool> use_async_compute_queue{linkage, false, "use_async_compute_queue",
+                                                    Category::RendererAdvanced};
+    SwitchableSetting<bool> optimize_spirv_cache{linkage, false, "optimize_spirv_cache",
+                                                 Category::RendererAdvanced};
+    SwitchableSetting<bool> use_cbuf_specialization{linkage, false, "use_cbuf_specialization",
+                                                    Category::RendererAdvanced};
+    SwitchableSetting<bool> skip_unchanged_frames{linkage, false, "skip_unchanged_frames",
+                                                  Category::RendererAdvanced};
+    SwitchableSetting<bool> nvdec_frame_threading{linkage, false, "nvdec_frame_threading",
+                                                  Category::RendererAdvanced};
+    SwitchableSetting<bool> vic_direct_output{linkage, false, "vic_direct_output",
+                                              Category::RendererAdvanced};
     SwitchableSetting<bool> async_presentation{linkage,
 #ifdef ANDROID
                                                true,
@@ -397,6 +459,13 @@ struct Values {
                                                false,
 #endif
                                                "async_presentation", Category::RendererAdvanced};
+    SwitchableSetting<int, true> vulkan_present_device{linkage,
+                                                       -1,
+                                                       -1,
+                                                       15,
+                                                       "vulkan_present_device",
+                                                       Category::RendererAdvanced,
+                                                       Specialization::Countable};
     SwitchableSetting<bool> renderer_force_max_clock{linkage, false, "force_max_clock",
                                                      Category::RendererAdvanced};
     SwitchableSetting<bool> use_reactive_flushing{linkage,
@@ -407,8 +476,13 @@ struct Values {
 #endif
                                                   "use_reactive_flushing",
                                                   Category::RendererAdvanced};
+    SwitchableSetting<bool> use_batched_write_tracking{linkage, false,
+                                                       "use_batched_write_tracking",
+                                                       Category::RendererAdvanced};
     SwitchableSetting<bool> use_asynchronous_shaders{linkage, false, "use_asynchronous_shaders",
                                                      Category::RendererAdvanced};
+    SwitchableSetting<bool> use_asynchronous_shader_fallback{
+        linkage, false, "use_asynchronous_shader_fallback", Category::RendererAdvanced};
     SwitchableSetting<bool> use_fast_gpu_time{
         linkage, true, "use_fast_gpu_time", Category::RendererAdvanced, Specialization::Default,
         true,    true};
@@ -419,10 +493,26 @@ struct Values {
                                                              Specialization::Default,
                                                              true,
                                                              true};
+    SwitchableSetting<u16, true> pipeline_warmup_seconds{linkage,
+                                                         30,
+                                                         0,
+                                                         600,
+                                                         "pipeline_warmup_seconds",
+                                                         Category::RendererAdvanced,
+                                                         Specialization::Countable};
+    SwitchableSetting<u32, true> pipeline_cache_budget{linkage,
+                                                       0,
+                                                       0,
+                                                       65536,
+                                                       "pipeline_cache_budget",
+                                                       Category::RendererAdvanced,
+                                                       Specialization::Countable};
     SwitchableSetting<bool> enable_compute_pipelines{linkage, false, "enable_compute_pipelines",
                                                      Category::RendererAdvanced};
     SwitchableSetting<bool> use_video_framerate{linkage, false, "use_video_framerate",
                                                 Category::RendererAdvanced};
+    SwitchableSetting<FramePacing> frame_pacing{linkage, FramePacing::Emulated, "frame_pacing",
+                                                Category::RendererAdvanced};
     SwitchableSetting<bool> barrier_feedback_loops{linkage, true, "barrier_feedback_loops",
                                                    Category::RendererAdvanced};
 
@@ -503,6 +593,8 @@ struct Values {
 #endif
     };
     Setting<bool> controller_navigation{linkage, true, "controller_navigation", Category::Controls};
+    Setting<bool> hid_event_driven_updates{linkage, false, "hid_event_driven_updates",
+                                           Category::Controls};
     Setting<bool> enable_joycon_driver{linkage, true, "enable_joycon_driver", Category::Controls};
     Setting<bool> enable_procon_driver{linkage, false, "enable_procon_driver", Category::Controls};
 
@@ -570,6 +662,16 @@ struct Values {
                                         Category::DataStorage};
     Setting<std::string> gamecard_path{linkage, std::string(), "gamecard_path",
                                        Category::DataStorage};
+    Setting<bool> use_mapped_file_reads{linkage, true, "use_mapped_file_reads",
+                                        Category::DataStorage};
+    Setting<bool> verify_nca_integrity{linkage, false, "verify_nca_integrity",
+                                       Category::DataStorage};
+    Setting<bool> use_nca_section_cache{linkage, false, "use_nca_section_cache",
+                                        Category::DataStorage};
+    Setting<u32> nca_section_cache_size{linkage, 16, "nca_section_cache_size",
+                                        Category::DataStorage}; // GiB
+    Setting<bool> use_save_data_write_back{linkage, true, "use_save_data_write_back",
+                                           Category::DataStorage};
 
     // Debugging
     bool record_frame_times;
@@ -578,12 +680,31 @@ struct Values {
     Setting<std::string> program_args{linkage, std::string(), "program_args", Category::Debugging};
     Setting<bool> dump_exefs{linkage, false, "dump_exefs", Category::Debugging};
     Setting<bool> dump_nso{linkage, false, "dump_nso", Category::Debugging};
+    Setting<bool> enable_perf_map{linkage, false, "enable_perf_map", Category::Debugging};
+    Setting<bool> enable_svc_trace{linkage, false, "enable_svc_trace", Category::Debugging};
+    Setting<bool> record_scope_trace{linkage, false, "record_scope_trace", Category::Debugging};
     Setting<bool> dump_shaders{
         linkage, false, "dump_shaders", Category::DebuggingGraphics, Specialization::Default,
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> profile_macros{linkage, false, "profile_macros", Category::DebuggingGraphics,
+                                 Specialization::Default, false};
+    Setting<bool> dump_texture_cache_stats{linkage, false, "dump_texture_cache_stats",
+                                           Category::DebuggingGraphics};
+    Setting<bool> profile_gpu_passes{linkage, false, "profile_gpu_passes",
+                                     Category::DebuggingGraphics};
+    Setting<bool> record_shader_stalls{linkage, false, "record_shader_stalls",
+                                       Category::DebuggingGraphics};
+    Setting<bool> null_renderer_caches{linkage, false, "null_renderer_caches",
+                                       Category::DebuggingGraphics};
+    Setting<bool> dump_gpu_commands{linkage, false, "dump_gpu_commands",
+                                    Category::DebuggingGraphics};
+    Setting<u16> dump_gpu_commands_frames{linkage, 60, "dump_gpu_commands_frames",
+                                          Category::DebuggingGraphics};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
+    Setting<bool> enable_ipc_statistics{linkage, false, "enable_ipc_statistics",
+                                        Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
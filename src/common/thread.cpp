@@ -2,15 +2,22 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <fstream>
 #include <string>
 
+#include <fmt/ranges.h>
+
 #include "common/error.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/string_util.h"
 #include "common/thread.h"
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined(_WIN32)
 #include <windows.h>
+#include <avrt.h>
 #include "common/string_util.h"
 #else
 #if defined(__Bitrig__) || defined(__DragonFly__) || defined(__FreeBSD__) || defined(__OpenBSD__)
@@ -23,6 +30,9 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#ifdef ANDROID
+#include <sys/resource.h>
+#endif
 
 #ifdef __FreeBSD__
 #define cpu_set_t cpuset_t
@@ -58,6 +68,11 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
     SetThreadPriority(handle, windows_priority);
 }
 
+bool SetCurrentThreadRealtimeAudioPriority() {
+    DWORD task_index = 0;
+    return AvSetMmThreadCharacteristicsW(L"Pro Audio", &task_index) != nullptr;
+}
+
 #else
 
 void SetCurrentThreadPriority(ThreadPriority new_priority) {
@@ -78,6 +93,22 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
     pthread_setschedparam(this_thread, scheduling_type, &params);
 }
 
+bool SetCurrentThreadRealtimeAudioPriority() {
+#ifdef ANDROID
+    // ANDROID_PRIORITY_AUDIO, the niceness the platform gives its own audio threads.
+    constexpr int AndroidPriorityAudio = -16;
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), AndroidPriorityAudio) == 0;
+#else
+    // A low real-time priority is enough to preempt every normal thread, and stays within the
+    // limits hosts usually grant to unprivileged audio applications.
+    const s32 max_prio = sched_get_priority_max(SCHED_FIFO);
+    const s32 min_prio = sched_get_priority_min(SCHED_FIFO);
+    struct sched_param params {};
+    params.sched_priority = min_prio + (max_prio - min_prio) / 10;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &params) == 0;
+#endif
+}
+
 #endif
 
 #ifdef _MSC_VER
@@ -120,4 +151,149 @@ void SetCurrentThreadName(const char* name) {
 
 #endif
 
+namespace {
+
+/// Parses a list of host core indices such as "4-7,9"
+std::vector<u32> ParseCoreList(const std::string& list) {
+    std::vector<std::string> ranges;
+    SplitString(list, ',', ranges);
+    std::vector<u32> cores;
+    for (const std::string& range : ranges) {
+        const size_t dash = range.find('-');
+        try {
+            const u32 first = static_cast<u32>(std::stoul(range.substr(0, dash)));
+            const u32 last = dash == std::string::npos
+                                 ? first
+                                 : static_cast<u32>(std::stoul(range.substr(dash + 1)));
+            for (u32 core = first; core <= last; ++core) {
+                cores.push_back(core);
+            }
+        } catch (const std::exception&) {
+            LOG_ERROR(Common, "Invalid host core range '{}'", range);
+        }
+    }
+    return cores;
+}
+
+#ifdef __linux__
+/// Returns a value ranking the speed of a host core, zero when it is unknown
+u64 ReadCoreRank(u32 core) {
+    // Scheduler capacities describe asymmetric ARM systems, fall back to the peak frequency
+    for (const char* file : {"cpu_capacity", "cpufreq/cpuinfo_max_freq"}) {
+        std::ifstream stream{fmt::format("/sys/devices/system/cpu/cpu{}/{}", core, file)};
+        u64 rank{};
+        if (stream >> rank) {
+            return rank;
+        }
+    }
+    return 0;
+}
+#endif
+
+std::vector<u32> DetectPerformanceCores() {
+    std::vector<std::pair<u32, u64>> ranks;
+#if defined(_WIN32)
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    std::vector<u8> buffer(length);
+    auto* const info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationProcessorCore, info, &length)) {
+        return {};
+    }
+    for (DWORD offset = 0; offset < length;) {
+        const auto* const entry =
+            reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+        const PROCESSOR_RELATIONSHIP& processor = entry->Processor;
+        // Only the first processor group is considered
+        if (processor.GroupCount > 0 && processor.GroupMask[0].Group == 0) {
+            for (u32 core = 0; core < sizeof(KAFFINITY) * 8; ++core) {
+                if ((processor.GroupMask[0].Mask >> core) & 1) {
+                    ranks.emplace_back(core, processor.EfficiencyClass);
+                }
+            }
+        }
+        offset += entry->Size;
+    }
+#elif defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return {};
+    }
+    for (u32 core = 0; core < CPU_SETSIZE; ++core) {
+        if (CPU_ISSET(core, &allowed)) {
+            ranks.emplace_back(core, ReadCoreRank(core));
+        }
+    }
+#endif
+    if (ranks.empty()) {
+        return {};
+    }
+    const auto [min_it, max_it] =
+        std::ranges::minmax_element(ranks, {}, &std::pair<u32, u64>::second);
+    if (min_it->second == max_it->second) {
+        return {};
+    }
+    const u64 max_rank = max_it->second;
+    std::vector<u32> cores;
+    for (const auto& [core, rank] : ranks) {
+        if (rank == max_rank) {
+            cores.push_back(core);
+        }
+    }
+    return cores;
+}
+
+bool SetCurrentThreadCores(const std::vector<u32>& cores) {
+#if defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (const u32 core : cores) {
+        if (core < sizeof(DWORD_PTR) * 8) {
+            mask |= DWORD_PTR{1} << core;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const u32 core : cores) {
+        if (core < CPU_SETSIZE) {
+            CPU_SET(core, &set);
+        }
+    }
+    return CPU_COUNT(&set) != 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    // macOS has no thread affinity API.
+    return false;
+#endif
+}
+
+} // Anonymous namespace
+
+std::vector<u32> GetPerformanceCores() {
+    static const std::vector<u32> performance_cores = DetectPerformanceCores();
+    return performance_cores;
+}
+
+void SetCurrentThreadAffinity(ThreadRole role) {
+    const char* const role_name = role == ThreadRole::EmulatedCore ? "emulated core" : "GPU";
+    std::vector<u32> cores;
+    const std::string& override_list = Settings::values.host_core_affinity.GetValue();
+    if (!override_list.empty()) {
+        cores = ParseCoreList(override_list);
+    } else if (Settings::values.use_performance_cores.GetValue()) {
+        cores = GetPerformanceCores();
+    }
+    if (cores.empty()) {
+        LOG_INFO(Common, "Leaving placement of the {} thread to the host scheduler", role_name);
+        return;
+    }
+    if (!SetCurrentThreadCores(cores)) {
+        LOG_WARNING(Common, "Failed to place the {} thread on host cores {}", role_name,
+                    fmt::join(cores, ","));
+        return;
+    }
+    LOG_INFO(Common, "Placed the {} thread on host cores {}", role_name, fmt::join(cores, ","));
+}
+
 } // namespace Common
@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 
@@ -104,6 +105,25 @@ enum class ThreadPriority : u32 {
 
 void SetCurrentThreadPriority(ThreadPriority new_priority);
 
+/**
+ * Gives the current thread the host's real-time audio scheduling: SCHED_FIFO on POSIX hosts, the
+ * "Pro Audio" MMCSS task on Windows and the audio thread priority on Android.
+ *
+ * @return False if the host refused, in which case the priority is left unchanged.
+ */
+[[nodiscard]] bool SetCurrentThreadRealtimeAudioPriority();
+
 void SetCurrentThreadName(const char* name);
 
+enum class ThreadRole : u32 {
+    EmulatedCore, ///< Host thread running an emulated CPU core
+    Gpu,          ///< Host thread processing GPU commands
+};
+
+/// Returns the fastest host cores of hybrid CPUs, or an empty list when all cores are alike.
+[[nodiscard]] std::vector<u32> GetPerformanceCores();
+
+/// Restricts the current thread to the host cores the placement settings choose for its role.
+void SetCurrentThreadAffinity(ThreadRole role);
+
 } // namespace Common
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+#include <fmt/format.h>
+
+#include "common/thread.h"
+#include "common/thread_pool.h"
+
+namespace Common {
+
+namespace {
+// Pool and index of the worker running on the current thread, if any
+thread_local const ThreadPool* t_pool{};
+thread_local size_t t_worker_index{};
+
+ThreadPriority HostPriority(TaskPriority priority) {
+    return priority == TaskPriority::Interactive ? ThreadPriority::Normal : ThreadPriority::Low;
+}
+} // Anonymous namespace
+
+ThreadPool::ThreadPool(size_t num_workers) {
+    worker_queues.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        worker_queues.push_back(std::make_unique<TaskQueue>());
+    }
+    threads.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        threads.emplace_back([this, i](std::stop_token stop_token) { WorkerMain(stop_token, i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    for (std::jthread& thread : threads) {
+        thread.request_stop();
+    }
+    threads.clear();
+}
+
+void ThreadPool::Submit(TaskPriority priority, Task task) {
+    {
+        // Count the task before queueing it so the counter never goes below the queued tasks,
+        // taking the lock orders the increment with workers going to sleep.
+        std::scoped_lock lk{sleep_mutex};
+        ++num_pending;
+    }
+    const bool is_worker = t_pool == this;
+    TaskQueue& queue = is_worker ? *worker_queues[t_worker_index] : shared_queue;
+    {
+        std::scoped_lock lk{queue.mutex};
+        queue.tasks[static_cast<size_t>(priority)].push_back(std::move(task));
+    }
+    sleep_condition.notify_one();
+}
+
+bool ThreadPool::RunPendingTask(TaskPriority max_priority) {
+    Task task;
+    TaskPriority priority;
+    const size_t index = t_pool == this ? t_worker_index : 0;
+    if (!TryPop(index, max_priority, task, priority)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::WorkerMain(std::stop_token stop_token, size_t index) {
+    SetCurrentThreadName(fmt::format("ThreadPool{}", index).c_str());
+    t_pool = this;
+    t_worker_index = index;
+
+    std::optional<TaskPriority> current_priority;
+    while (!stop_token.stop_requested()) {
+        Task task;
+        TaskPriority priority;
+        if (!TryPop(index, TaskPriority::Idle, task, priority)) {
+            std::unique_lock lk{sleep_mutex};
+            CondvarWait(sleep_condition, lk, stop_token, [this] { return num_pending > 0; });
+            continue;
+        }
+        if (current_priority != priority) {
+            SetCurrentThreadPriority(HostPriority(priority));
+            current_priority = priority;
+        }
+        task();
+    }
+}
+
+bool ThreadPool::TryPop(size_t index, TaskPriority max_priority, Task& task,
+                        TaskPriority& priority) {
+    if (num_pending.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    const auto pop = [&](TaskQueue& queue, size_t p, bool newest) {
+        std::scoped_lock lk{queue.mutex};
+        auto& tasks = queue.tasks[p];
+        if (tasks.empty()) {
+            return false;
+        }
+        if (newest) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        --num_pending;
+        priority = static_cast<TaskPriority>(p);
+        return true;
+    };
+    const size_t num_workers = worker_queues.size();
+    for (size_t p = 0; p <= static_cast<size_t>(max_priority); ++p) {
+        if (num_workers != 0 && pop(*worker_queues[index], p, true)) {
+            return true;
+        }
+        if (pop(shared_queue, p, false)) {
+            return true;
+        }
+        // Steal the oldest tasks of other workers, they are the most likely to be large
+        for (size_t offset = 1; offset < num_workers; ++offset) {
+            if (pop(*worker_queues[(index + offset) % num_workers], p, false)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+ThreadPool& GetThreadPool() {
+    // Leave a core to the threads that are not part of the pool
+    static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 2U) - 1};
+    return pool;
+}
+
+TaskGroup::TaskGroup(TaskPriority priority_, ThreadPool& pool_)
+    : pool{pool_}, priority{priority_}, state{std::make_shared<State>()} {}
+
+TaskGroup::~TaskGroup() {
+    Cancel();
+    Wait();
+}
+
+void TaskGroup::Run(ThreadPool::Task task) {
+    {
+        std::scoped_lock lk{state->mutex};
+        ++state->num_pending;
+    }
+    pool.Submit(priority, [state = state, task = std::move(task)]() mutable {
+        if (!state->is_cancelled) {
+            task();
+        }
+        std::scoped_lock lk{state->mutex};
+        if (--state->num_pending == 0) {
+            state->finished_condition.notify_all();
+        }
+    });
+}
+
+void TaskGroup::Wait() {
+    std::unique_lock lk{state->mutex};
+    while (state->num_pending != 0) {
+        lk.unlock();
+        const bool ran_task = pool.RunPendingTask(priority);
+        lk.lock();
+        if (!ran_task) {
+            // The remaining tasks are running on other threads or queued at a lower priority
+            state->finished_condition.wait_for(lk, std::chrono::milliseconds{1},
+                                               [this] { return state->num_pending == 0; });
+        }
+    }
+}
+
+void TaskGroup::Cancel() {
+    state->is_cancelled = true;
+}
+
+} // namespace Common
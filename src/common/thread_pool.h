@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "common/unique_function.h"
+
+namespace Common {
+
+enum class TaskPriority : u32 {
+    Interactive, ///< Work something is waiting on right now, such as texture decoding
+    Background,  ///< Work needed soon, such as loading or verifying files
+    Idle,        ///< Work that only uses otherwise idle cores, such as warming caches up
+};
+
+/**
+ * Pool of worker threads shared by the background work of every subsystem, so they do not
+ * oversubscribe the host together. Workers run the most urgent pending task first, taking tasks
+ * from their own queue, then from the shared queue, then from the queues of other workers.
+ * Tasks other than interactive ones run at a low host thread priority to leave the emulated
+ * CPU cores alone.
+ */
+class ThreadPool {
+public:
+    using Task = UniqueFunction<void>;
+
+    explicit ThreadPool(size_t num_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Queues a task. Tasks queued from a worker go to its own queue, which it runs newest first.
+    void Submit(TaskPriority priority, Task task);
+
+    /// Runs a pending task with the given priority or a more urgent one on the calling thread.
+    /// Returns false when there was none.
+    bool RunPendingTask(TaskPriority max_priority);
+
+    [[nodiscard]] size_t NumWorkers() const noexcept {
+        return threads.size();
+    }
+
+private:
+    static constexpr size_t NumPriorities = 3;
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::array<std::deque<Task>, NumPriorities> tasks;
+    };
+
+    void WorkerMain(std::stop_token stop_token, size_t index);
+
+    bool TryPop(size_t index, TaskPriority max_priority, Task& task, TaskPriority& priority);
+
+    TaskQueue shared_queue;
+    std::vector<std::unique_ptr<TaskQueue>> worker_queues;
+    std::atomic<size_t> num_pending{};
+    std::mutex sleep_mutex;
+    std::condition_variable_any sleep_condition;
+    std::vector<std::jthread> threads;
+};
+
+/// Returns the pool shared by the whole process
+ThreadPool& GetThreadPool();
+
+/// Set of tasks that can be waited on or cancelled together
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPriority priority, ThreadPool& pool = GetThreadPool());
+
+    /// Cancels the tasks that have not started and waits for the running ones
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(ThreadPool::Task task);
+
+    /// Blocks until every task of the group has finished, helping with pending tasks of the
+    /// group's priority or more urgent ones meanwhile.
+    void Wait();
+
+    /// Drops the tasks of the group that have not started yet
+    void Cancel();
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable finished_condition;
+        size_t num_pending{};
+        std::atomic_bool is_cancelled{};
+    };
+
+    ThreadPool& pool;
+    TaskPriority priority;
+    std::shared_ptr<State> state;
+};
+
+} // namespace Common
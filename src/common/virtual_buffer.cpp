@@ -4,7 +4,9 @@
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <vector>
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 #include "common/assert.h"
@@ -39,4 +41,29 @@ void FreeMemoryPages(void* base, [[maybe_unused]] std::size_t size) noexcept {
 #endif
 }
 
+std::size_t GetCommittedMemoryPagesSize(const void* base, std::size_t size) noexcept {
+    if (!base) {
+        return 0;
+    }
+#ifdef _WIN32
+    return size;
+#else
+    const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t num_pages = (size + page_size - 1) / page_size;
+#ifdef __linux__
+    std::vector<unsigned char> residency(num_pages);
+#else
+    std::vector<char> residency(num_pages);
+#endif
+    if (mincore(const_cast<void*>(base), size, residency.data()) != 0) {
+        return size;
+    }
+    std::size_t num_resident = 0;
+    for (const auto page : residency) {
+        num_resident += page & 1;
+    }
+    return num_resident * page_size;
+#endif
+}
+
 } // namespace Common
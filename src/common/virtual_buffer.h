@@ -10,6 +10,10 @@ namespace Common {
 void* AllocateMemoryPages(std::size_t size) noexcept;
 void FreeMemoryPages(void* base, std::size_t size) noexcept;
 
+/// Returns how many bytes of pages allocated by AllocateMemoryPages are backed by host memory.
+/// Pages are committed on first touch on Unix systems and upfront on Windows.
+std::size_t GetCommittedMemoryPagesSize(const void* base, std::size_t size) noexcept;
+
 template <typename T>
 class VirtualBuffer final {
 public:
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "core/arm/cas_exclusive_monitor.h"
+#include "core/memory.h"
+
+namespace Core {
+
+CasExclusiveMonitor::CasExclusiveMonitor(Memory::Memory& memory_, std::size_t core_count_)
+    : reservations{core_count_}, memory{memory_} {}
+
+CasExclusiveMonitor::~CasExclusiveMonitor() = default;
+
+u8 CasExclusiveMonitor::ExclusiveRead8(std::size_t core_index, VAddr addr) {
+    return reservations.ReadAndMark<u8>(core_index, addr,
+                                        [&]() -> u8 { return memory.Read8(addr); });
+}
+
+u16 CasExclusiveMonitor::ExclusiveRead16(std::size_t core_index, VAddr addr) {
+    return reservations.ReadAndMark<u16>(core_index, addr,
+                                         [&]() -> u16 { return memory.Read16(addr); });
+}
+
+u32 CasExclusiveMonitor::ExclusiveRead32(std::size_t core_index, VAddr addr) {
+    return reservations.ReadAndMark<u32>(core_index, addr,
+                                         [&]() -> u32 { return memory.Read32(addr); });
+}
+
+u64 CasExclusiveMonitor::ExclusiveRead64(std::size_t core_index, VAddr addr) {
+    return reservations.ReadAndMark<u64>(core_index, addr,
+                                         [&]() -> u64 { return memory.Read64(addr); });
+}
+
+u128 CasExclusiveMonitor::ExclusiveRead128(std::size_t core_index, VAddr addr) {
+    return reservations.ReadAndMark<u128>(core_index, addr, [&]() -> u128 {
+        u128 result;
+        result[0] = memory.Read64(addr);
+        result[1] = memory.Read64(addr + 8);
+        return result;
+    });
+}
+
+void CasExclusiveMonitor::ClearExclusive(std::size_t core_index) {
+    reservations.Clear(core_index);
+}
+
+bool CasExclusiveMonitor::ExclusiveWrite8(std::size_t core_index, VAddr vaddr, u8 value) {
+    return reservations.DoExclusiveOperation<u8>(core_index, vaddr, [&](u8 expected) -> bool {
+        return memory.WriteExclusive8(vaddr, value, expected);
+    });
+}
+
+bool CasExclusiveMonitor::ExclusiveWrite16(std::size_t core_index, VAddr vaddr, u16 value) {
+    return reservations.DoExclusiveOperation<u16>(core_index, vaddr, [&](u16 expected) -> bool {
+        return memory.WriteExclusive16(vaddr, value, expected);
+    });
+}
+
+bool CasExclusiveMonitor::ExclusiveWrite32(std::size_t core_index, VAddr vaddr, u32 value) {
+    return reservations.DoExclusiveOperation<u32>(core_index, vaddr, [&](u32 expected) -> bool {
+        return memory.WriteExclusive32(vaddr, value, expected);
+    });
+}
+
+bool CasExclusiveMonitor::ExclusiveWrite64(std::size_t core_index, VAddr vaddr, u64 value) {
+    return reservations.DoExclusiveOperation<u64>(core_index, vaddr, [&](u64 expected) -> bool {
+        return memory.WriteExclusive64(vaddr, value, expected);
+    });
+}
+
+bool CasExclusiveMonitor::ExclusiveWrite128(std::size_t core_index, VAddr vaddr, u128 value) {
+    return reservations.DoExclusiveOperation<u128>(core_index, vaddr, [&](u128 expected) -> bool {
+        return memory.WriteExclusive128(vaddr, value, expected);
+    });
+}
+
+} // namespace Core
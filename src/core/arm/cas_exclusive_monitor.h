@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/arm/exclusive_monitor.h"
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace Core {
+
+/**
+ * Per core exclusive reservations tracked without a global lock.
+ *
+ * Exclusive stores are performed as a host compare-and-swap against the value observed by the
+ * exclusive load, a successful store then drops the reservations other cores hold on the same
+ * granule. Like the fastmem exclusives of dynarmic, a store succeeds when the value went through
+ * an A-B-A sequence since it was loaded.
+ */
+class ExclusiveReservations {
+public:
+    explicit ExclusiveReservations(std::size_t core_count) : slots(core_count) {}
+
+    template <typename T, typename Function>
+    T ReadAndMark(std::size_t core_index, VAddr addr, Function&& read) {
+        static_assert(sizeof(T) <= sizeof(Slot::value));
+        Slot& slot = slots[core_index];
+        slot.address.store(addr & RESERVATION_GRANULE_MASK, std::memory_order_seq_cst);
+        const T value = read();
+        std::memcpy(slot.value.data(), &value, sizeof(T));
+        return value;
+    }
+
+    template <typename T, typename Function>
+    bool DoExclusiveOperation(std::size_t core_index, VAddr addr, Function&& op) {
+        static_assert(sizeof(T) <= sizeof(Slot::value));
+        const VAddr granule = addr & RESERVATION_GRANULE_MASK;
+        Slot& slot = slots[core_index];
+
+        // Claim our own reservation, this fails when a store from another core dropped it.
+        VAddr reserved = granule;
+        if (!slot.address.compare_exchange_strong(reserved, INVALID_ADDRESS,
+                                                  std::memory_order_seq_cst)) {
+            return false;
+        }
+        T expected;
+        std::memcpy(&expected, slot.value.data(), sizeof(T));
+        if (!op(expected)) {
+            return false;
+        }
+        for (Slot& other : slots) {
+            VAddr other_reserved = granule;
+            other.address.compare_exchange_strong(other_reserved, INVALID_ADDRESS,
+                                                  std::memory_order_seq_cst);
+        }
+        return true;
+    }
+
+    void Clear(std::size_t core_index) {
+        slots[core_index].address.store(INVALID_ADDRESS, std::memory_order_seq_cst);
+    }
+
+private:
+    static constexpr VAddr RESERVATION_GRANULE_MASK = ~VAddr{0xF};
+    static constexpr VAddr INVALID_ADDRESS = ~VAddr{0};
+
+    // Each slot lives in its own cache line so cores do not contend on their reservations.
+    struct alignas(64) Slot {
+        std::atomic<VAddr> address{INVALID_ADDRESS};
+        std::array<u8, 16> value{};
+    };
+
+    std::vector<Slot> slots;
+};
+
+class CasExclusiveMonitor final : public ExclusiveMonitor {
+public:
+    explicit CasExclusiveMonitor(Memory::Memory& memory_, std::size_t core_count_);
+    ~CasExclusiveMonitor() override;
+
+    u8 ExclusiveRead8(std::size_t core_index, VAddr addr) override;
+    u16 ExclusiveRead16(std::size_t core_index, VAddr addr) override;
+    u32 ExclusiveRead32(std::size_t core_index, VAddr addr) override;
+    u64 ExclusiveRead64(std::size_t core_index, VAddr addr) override;
+    u128 ExclusiveRead128(std::size_t core_index, VAddr addr) override;
+    void ClearExclusive(std::size_t core_index) override;
+
+    bool ExclusiveWrite8(std::size_t core_index, VAddr vaddr, u8 value) override;
+    bool ExclusiveWrite16(std::size_t core_index, VAddr vaddr, u16 value) override;
+    bool ExclusiveWrite32(std::size_t core_index, VAddr vaddr, u32 value) override;
+    bool ExclusiveWrite64(std::size_t core_index, VAddr vaddr, u64 value) override;
+    bool ExclusiveWrite128(std::size_t core_index, VAddr vaddr, u128 value) override;
+
+private:
+    ExclusiveReservations reservations;
+    Core::Memory::Memory& memory;
+};
+
+} // namespace Core
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <memory>
+
 #include <dynarmic/interface/halt_reason.h>
 
+#include "common/memory_usage.h"
 #include "core/arm/arm_interface.h"
 
 namespace Core {
@@ -26,6 +29,17 @@ constexpr HaltReason TranslateHaltReason(Dynarmic::HaltReason hr) {
     return static_cast<HaltReason>(hr);
 }
 
+/// Creates a JIT whose code cache is counted in the host memory usage for as long as it lives
+template <typename Jit, typename Config>
+std::shared_ptr<Jit> MakeCountedJit(const Config& config) {
+    const auto size = static_cast<s64>(config.code_cache_size);
+    Common::UpdateMemoryUsage(Common::MemoryUsageCategory::JitCodeCache, size);
+    return std::shared_ptr<Jit>(new Jit(config), [size](Jit* jit) {
+        delete jit;
+        Common::UpdateMemoryUsage(Common::MemoryUsageCategory::JitCodeCache, -size);
+    });
+}
+
 #ifdef __linux__
 
 class ScopedJitExecution {
@@ -300,7 +300,7 @@ std::shared_ptr<Dynarmic::A32::Jit> ArmDynarmic32::MakeJit(Common::PageTable* pa
         }
     }
 
-    return std::make_unique<Dynarmic::A32::Jit>(config);
+    return MakeCountedJit<Dynarmic::A32::Jit>(config);
 }
 
 static std::pair<u32, u32> FpscrToFpsrFpcr(u32 fpscr) {
@@ -266,6 +266,9 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
     config.enable_cycle_counting = !m_uses_wall_clock;
 
     // Code cache size
+    // The cache is not persisted across sessions: dynarmic has no interface to export or import
+    // translated blocks, and the emitted code embeds pointers to this process' callbacks,
+    // page table and fastmem arena.
 #ifdef ARCHITECTURE_arm64
     config.code_cache_size = 128_MiB;
 #else
@@ -358,7 +361,7 @@ std::shared_ptr<Dynarmic::A64::Jit> ArmDynarmic64::MakeJit(Common::PageTable* pa
         }
     }
 
-    return std::make_shared<Dynarmic::A64::Jit>(config);
+    return MakeCountedJit<Dynarmic::A64::Jit>(config);
 }
 
 HaltReason ArmDynarmic64::RunThread(Kernel::KThread* thread) {
@@ -4,6 +4,7 @@
 #if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
 #include "core/arm/dynarmic/dynarmic_exclusive_monitor.h"
 #endif
+#include "core/arm/cas_exclusive_monitor.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/memory.h"
 
@@ -16,8 +17,7 @@ std::unique_ptr<Core::ExclusiveMonitor> MakeExclusiveMonitor(Memory::Memory& mem
 #if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
     return std::make_unique<Core::DynarmicExclusiveMonitor>(memory, num_cores);
 #else
-    // TODO(merry): Passthrough exclusive monitor
-    return nullptr;
+    return std::make_unique<Core::CasExclusiveMonitor>(memory, num_cores);
 #endif
 }
 
@@ -1,13 +1,26 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <optional>
+
 #include "common/arm64/native_clock.h"
 #include "common/bit_cast.h"
+#include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/hex_util.h"
 #include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/perf_map.h"
 #include "core/arm/nce/arm_nce.h"
 #include "core/arm/nce/guest_context.h"
 #include "core/arm/nce/instructions.h"
 #include "core/arm/nce/patcher.h"
+#include "core/arm/symbols.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/svc.h"
@@ -22,6 +35,72 @@ using NativeExecutionParameters = Kernel::KThread::NativeExecutionParameters;
 constexpr size_t MaxRelativeBranch = 128_MiB;
 constexpr u32 ModuleCodeIndex = 0x24 / sizeof(u32);
 
+namespace {
+
+constexpr std::array<char, 8> PATCH_CACHE_MAGIC{'y', 'u', 'z', 'u', 'n', 'c', 'e', 'p'};
+constexpr u32 PATCH_CACHE_VERSION = 1;
+
+std::filesystem::path PatchSitesPath(std::span<const u8> build_id, u64 text_hash) {
+    const auto nce_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "nce";
+    return nce_dir / fmt::format("{}_{:016x}.bin", Common::HexToString(build_id), text_hash);
+}
+
+std::optional<std::vector<u32>> LoadPatchSites(const std::filesystem::path& path,
+                                               u32 num_text_words) {
+    std::ifstream file;
+    Common::FS::OpenFileStream(file, path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::array<char, 8> magic{};
+    u32 version{};
+    u32 num_sites{};
+    file.read(magic.data(), magic.size())
+        .read(reinterpret_cast<char*>(&version), sizeof(version))
+        .read(reinterpret_cast<char*>(&num_sites), sizeof(num_sites));
+    if (!file || magic != PATCH_CACHE_MAGIC || version != PATCH_CACHE_VERSION ||
+        num_sites > num_text_words) {
+        LOG_WARNING(Core_ARM, "Discarding invalid NCE patch cache {}",
+                    Common::FS::PathToUTF8String(path));
+        file.close();
+        Common::FS::RemoveFile(path);
+        return std::nullopt;
+    }
+    std::vector<u32> sites(num_sites);
+    file.read(reinterpret_cast<char*>(sites.data()), sites.size() * sizeof(u32));
+    const bool in_bounds = std::ranges::all_of(sites, [num_text_words](u32 site) {
+        return site >= ModuleCodeIndex && site < num_text_words;
+    });
+    if (!file || !in_bounds) {
+        LOG_WARNING(Core_ARM, "Discarding corrupted NCE patch cache {}",
+                    Common::FS::PathToUTF8String(path));
+        file.close();
+        Common::FS::RemoveFile(path);
+        return std::nullopt;
+    }
+    return sites;
+}
+
+void SavePatchSites(const std::filesystem::path& path, const std::vector<u32>& sites) {
+    if (!Common::FS::CreateDirs(path.parent_path())) {
+        return;
+    }
+    std::ofstream file;
+    Common::FS::OpenFileStream(file, path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_WARNING(Core_ARM, "Failed to create NCE patch cache {}",
+                    Common::FS::PathToUTF8String(path));
+        return;
+    }
+    const u32 num_sites = static_cast<u32>(sites.size());
+    file.write(PATCH_CACHE_MAGIC.data(), PATCH_CACHE_MAGIC.size())
+        .write(reinterpret_cast<const char*>(&PATCH_CACHE_VERSION), sizeof(PATCH_CACHE_VERSION))
+        .write(reinterpret_cast<const char*>(&num_sites), sizeof(num_sites))
+        .write(reinterpret_cast<const char*>(sites.data()), sites.size() * sizeof(u32));
+}
+
+} // Anonymous namespace
+
 Patcher::Patcher() : c(m_patch_instructions) {
     // The first word of the patch section is always a branch to the first instruction of the
     // module.
@@ -39,7 +118,7 @@ Patcher::Patcher() : c(m_patch_instructions) {
 Patcher::~Patcher() = default;
 
 bool Patcher::PatchText(const Kernel::PhysicalMemory& program_image,
-                        const Kernel::CodeSet::Segment& code) {
+                        const Kernel::CodeSet::Segment& code, std::span<const u8> build_id) {
     // If we have patched modules but cannot reach the new module, then it needs its own patcher.
     const size_t image_size = program_image.size();
     if (total_program_size + image_size > MaxRelativeBranch && total_program_size > 0) {
@@ -59,64 +138,94 @@ bool Patcher::PatchText(const Kernel::PhysicalMemory& program_image,
     const auto text_words =
         std::span<const u32>{reinterpret_cast<const u32*>(text.data()), text.size() / sizeof(u32)};
 
-    // Loop through instructions, patching as needed.
-    for (u32 i = ModuleCodeIndex; i < static_cast<u32>(text_words.size()); i++) {
-        const u32 inst = text_words[i];
+    // Modules with a build id remember which instructions needed patching, skipping the scan of
+    // the whole text segment on later boots.
+    std::filesystem::path cache_path;
+    std::optional<std::vector<u32>> patch_sites;
+    if (!build_id.empty()) {
+        const u64 text_hash =
+            Common::CityHash64(reinterpret_cast<const char*>(text.data()), text.size());
+        cache_path = PatchSitesPath(build_id, text_hash);
+        patch_sites = LoadPatchSites(cache_path, static_cast<u32>(text_words.size()));
+    }
 
-        const auto AddRelocations = [&] {
-            const uintptr_t this_offset = i * sizeof(u32);
-            const uintptr_t next_offset = this_offset + sizeof(u32);
+    if (patch_sites) {
+        for (const u32 i : *patch_sites) {
+            PatchInstruction(i, text_words[i]);
+        }
+    } else {
+        // Loop through instructions, patching as needed.
+        std::vector<u32> found_sites;
+        for (u32 i = ModuleCodeIndex; i < static_cast<u32>(text_words.size()); i++) {
+            if (PatchInstruction(i, text_words[i])) {
+                found_sites.push_back(i);
+            }
+        }
+        if (!cache_path.empty()) {
+            SavePatchSites(cache_path, found_sites);
+        }
+    }
 
-            // Relocate from here to patch.
-            this->BranchToPatch(this_offset);
+    curr_patch->m_patch_end = c.offset();
 
-            // Relocate from patch to next instruction.
-            return next_offset;
-        };
+    // Determine patching mode for the final relocation step
+    total_program_size += image_size;
+    this->mode = image_size > MaxRelativeBranch ? PatchMode::PreText : PatchMode::PostData;
+    return true;
+}
 
-        // SVC
-        if (auto svc = SVC{inst}; svc.Verify()) {
-            WriteSvcTrampoline(AddRelocations(), svc.GetValue());
-            continue;
-        }
+bool Patcher::PatchInstruction(u32 i, u32 inst) {
+    const auto AddRelocations = [&] {
+        const uintptr_t this_offset = i * sizeof(u32);
+        const uintptr_t next_offset = this_offset + sizeof(u32);
 
-        // MRS Xn, TPIDR_EL0
-        // MRS Xn, TPIDRRO_EL0
-        if (auto mrs = MRS{inst};
-            mrs.Verify() && (mrs.GetSystemReg() == TpidrroEl0 || mrs.GetSystemReg() == TpidrEl0)) {
-            const auto src_reg = mrs.GetSystemReg() == TpidrroEl0 ? oaknut::SystemReg::TPIDRRO_EL0
-                                                                  : oaknut::SystemReg::TPIDR_EL0;
-            const auto dest_reg = oaknut::XReg{static_cast<int>(mrs.GetRt())};
-            WriteMrsHandler(AddRelocations(), dest_reg, src_reg);
-            continue;
-        }
+        // Relocate from here to patch.
+        this->BranchToPatch(this_offset);
 
-        // MRS Xn, CNTPCT_EL0
-        if (auto mrs = MRS{inst}; mrs.Verify() && mrs.GetSystemReg() == CntpctEl0) {
-            WriteCntpctHandler(AddRelocations(), oaknut::XReg{static_cast<int>(mrs.GetRt())});
-            continue;
-        }
+        // Relocate from patch to next instruction.
+        return next_offset;
+    };
 
-        // MRS Xn, CNTFRQ_EL0
-        if (auto mrs = MRS{inst}; mrs.Verify() && mrs.GetSystemReg() == CntfrqEl0) {
-            UNREACHABLE();
-        }
+    // SVC
+    if (auto svc = SVC{inst}; svc.Verify()) {
+        WriteSvcTrampoline(AddRelocations(), svc.GetValue());
+        return true;
+    }
 
-        // MSR TPIDR_EL0, Xn
-        if (auto msr = MSR{inst}; msr.Verify() && msr.GetSystemReg() == TpidrEl0) {
-            WriteMsrHandler(AddRelocations(), oaknut::XReg{static_cast<int>(msr.GetRt())});
-            continue;
-        }
+    // MRS Xn, TPIDR_EL0
+    // MRS Xn, TPIDRRO_EL0
+    if (auto mrs = MRS{inst};
+        mrs.Verify() && (mrs.GetSystemReg() == TpidrroEl0 || mrs.GetSystemReg() == TpidrEl0)) {
+        const auto src_reg = mrs.GetSystemReg() == TpidrroEl0 ? oaknut::SystemReg::TPIDRRO_EL0
+                                                              : oaknut::SystemReg::TPIDR_EL0;
+        const auto dest_reg = oaknut::XReg{static_cast<int>(mrs.GetRt())};
+        WriteMrsHandler(AddRelocations(), dest_reg, src_reg);
+        return true;
+    }
 
-        if (auto exclusive = Exclusive{inst}; exclusive.Verify()) {
-            curr_patch->m_exclusives.push_back(i);
-        }
+    // MRS Xn, CNTPCT_EL0
+    if (auto mrs = MRS{inst}; mrs.Verify() && mrs.GetSystemReg() == CntpctEl0) {
+        WriteCntpctHandler(AddRelocations(), oaknut::XReg{static_cast<int>(mrs.GetRt())});
+        return true;
     }
 
-    // Determine patching mode for the final relocation step
-    total_program_size += image_size;
-    this->mode = image_size > MaxRelativeBranch ? PatchMode::PreText : PatchMode::PostData;
-    return true;
+    // MRS Xn, CNTFRQ_EL0
+    if (auto mrs = MRS{inst}; mrs.Verify() && mrs.GetSystemReg() == CntfrqEl0) {
+        UNREACHABLE();
+    }
+
+    // MSR TPIDR_EL0, Xn
+    if (auto msr = MSR{inst}; msr.Verify() && msr.GetSystemReg() == TpidrEl0) {
+        WriteMsrHandler(AddRelocations(), oaknut::XReg{static_cast<int>(msr.GetRt())});
+        return true;
+    }
+
+    if (auto exclusive = Exclusive{inst}; exclusive.Verify()) {
+        curr_patch->m_exclusives.push_back(i);
+        return true;
+    }
+
+    return false;
 }
 
 bool Patcher::RelocateAndCopy(Common::ProcessAddress load_base,
@@ -184,6 +293,11 @@ bool Patcher::RelocateAndCopy(Common::ProcessAddress load_base,
         out_trampolines->insert({RebasePc(rel.module_offset), RebasePatch(rel.patch_offset)});
     }
 
+    if (Common::PerfMap::IsEnabled()) {
+        RegisterPerfMap(patch, std::span{program_image}.subspan(code.offset), RebasePc(0),
+                        RebasePatch(0));
+    }
+
     // Cortex-A57 seems to treat all exclusives as ordered, but newer processors do not.
     // Convert to ordered to preserve this assumption.
     for (const ModuleTextAddress i : patch.m_exclusives) {
@@ -212,6 +326,48 @@ bool Patcher::RelocateAndCopy(Common::ProcessAddress load_base,
     return false;
 }
 
+void Patcher::RegisterPerfMap(const ModulePatch& patch, std::span<const u8> module,
+                              u64 module_base, u64 patch_base) const {
+    // Natively executed modules run at their guest addresses, so guest symbols map host code too.
+    struct Symbol {
+        u64 start;
+        u64 size;
+        std::string_view name;
+    };
+    const Core::Symbols::Symbols symbols = Core::Symbols::GetSymbols(module);
+    std::vector<Symbol> sorted_symbols;
+    sorted_symbols.reserve(symbols.size());
+    for (const auto& [name, info] : symbols) {
+        const auto& [start, size] = info;
+        if (size != 0) {
+            sorted_symbols.push_back({start, size, name});
+            Common::PerfMap::Register(reinterpret_cast<const void*>(module_base + start), size,
+                                      name);
+        }
+    }
+    std::ranges::sort(sorted_symbols, {}, &Symbol::start);
+
+    const auto SymbolName = [&](u64 module_offset) -> std::string {
+        auto it = std::ranges::upper_bound(sorted_symbols, module_offset, {}, &Symbol::start);
+        if (it == sorted_symbols.begin() || module_offset >= (it - 1)->start + (it - 1)->size) {
+            return fmt::format("{:#x}", module_base + module_offset);
+        }
+        --it;
+        return fmt::format("{}+{:#x}", it->name, module_offset - it->start);
+    };
+
+    // Handlers are emitted in order, each one ends where the next one starts.
+    const auto& relocations = patch.m_branch_to_patch_relocations;
+    for (size_t i = 0; i < relocations.size(); ++i) {
+        const ptrdiff_t end =
+            i + 1 < relocations.size() ? relocations[i + 1].patch_offset : patch.m_patch_end;
+        const Relocation& rel = relocations[i];
+        Common::PerfMap::Register(reinterpret_cast<const void*>(patch_base + rel.patch_offset),
+                                  static_cast<size_t>(end - rel.patch_offset),
+                                  fmt::format("NCE handler for {}", SymbolName(rel.module_offset)));
+    }
+}
+
 size_t Patcher::GetSectionSize() const noexcept {
     return Common::AlignUp(m_patch_instructions.size() * sizeof(u32), Core::Memory::YUZU_PAGESIZE);
 }
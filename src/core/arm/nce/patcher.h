@@ -32,7 +32,7 @@ public:
     ~Patcher();
 
     bool PatchText(const Kernel::PhysicalMemory& program_image,
-                   const Kernel::CodeSet::Segment& code);
+                   const Kernel::CodeSet::Segment& code, std::span<const u8> build_id = {});
     bool RelocateAndCopy(Common::ProcessAddress load_base, const Kernel::CodeSet::Segment& code,
                          Kernel::PhysicalMemory& program_image, EntryTrampolines* out_trampolines);
     size_t GetSectionSize() const noexcept;
@@ -49,6 +49,7 @@ private:
         uintptr_t module_offset;
     };
 
+    bool PatchInstruction(u32 index, u32 inst);
     void WriteLoadContext();
     void WriteSaveContext();
     void LockContext();
@@ -90,8 +91,12 @@ private:
         std::vector<Relocation> m_branch_to_module_relocations{};
         std::vector<Relocation> m_write_module_pc_relocations{};
         std::vector<ModuleTextAddress> m_exclusives{};
+        ptrdiff_t m_patch_end{}; ///< Offset in bytes of the end of the code of this module.
     };
 
+    void RegisterPerfMap(const ModulePatch& patch, std::span<const u8> module, u64 module_base,
+                         u64 patch_base) const;
+
     oaknut::VectorCodeGenerator c;
     oaknut::Label m_save_context{};
     oaknut::Label m_load_context{};
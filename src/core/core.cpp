@@ -8,9 +8,13 @@
 #include <utility>
 
 #include "audio_core/audio_core.h"
+#include "common/boot_profiler.h"
 #include "common/fs/fs.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/multi_level_page_table.h"
+#include "common/page_table.h"
+#include "common/scope_trace.h"
 #include "common/settings.h"
 #include "common/settings_enums.h"
 #include "common/string_util.h"
@@ -243,6 +247,12 @@ struct System::Impl {
     void Run() {
         std::unique_lock<std::mutex> lk(suspend_guard);
 
+        // The first run follows the frontend's shader cache loading, which ends the boot.
+        if (std::exchange(is_boot_profile_pending, false)) {
+            Common::BootProfiler::Finish(
+                fmt::format("{:016X}", kernel.ApplicationProcess()->GetProgramId()));
+        }
+
         kernel.SuspendEmulation(false);
         core_timing.SyncPause(false);
         is_paused.store(false, std::memory_order_relaxed);
@@ -286,33 +296,45 @@ struct System::Impl {
         debugger = std::make_unique<Debugger>(system, port);
     }
 
-    void InitializeKernel(System& system) {
+    void InitializeKernel(System& system, u64 program_id) {
+        BOOT_PHASE("InitializeKernel");
         LOG_DEBUG(Core, "initialized OK");
 
         // Setting changes may require a full system reinitialization (e.g., disabling multicore).
         ReinitializeIfNecessary(system);
 
-        kernel.Initialize();
+        kernel.Initialize(program_id);
         cpu_manager.Initialize();
     }
 
     SystemResultStatus SetupForApplicationProcess(System& system, Frontend::EmuWindow& emu_window) {
+        BOOT_PHASE("SetupForApplicationProcess");
+
         /// Reset all glue registrations
         arp_manager.ResetAll();
 
         telemetry_session = std::make_unique<Core::TelemetrySession>();
 
-        host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
-        gpu_core = VideoCore::CreateGPU(emu_window, system);
-        if (!gpu_core) {
-            return SystemResultStatus::ErrorVideoCore;
+        {
+            BOOT_PHASE("CreateGPU");
+            host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
+            gpu_core = VideoCore::CreateGPU(emu_window, system);
+            if (!gpu_core) {
+                return SystemResultStatus::ErrorVideoCore;
+            }
         }
 
-        audio_core = std::make_unique<AudioCore::AudioCore>(system);
+        {
+            BOOT_PHASE("CreateAudioCore");
+            audio_core = std::make_unique<AudioCore::AudioCore>(system);
+        }
 
-        service_manager = std::make_shared<Service::SM::ServiceManager>(kernel);
-        services =
-            std::make_unique<Service::Services>(service_manager, system, stop_event.get_token());
+        {
+            BOOT_PHASE("StartServices");
+            service_manager = std::make_shared<Service::SM::ServiceManager>(kernel);
+            services = std::make_unique<Service::Services>(service_manager, system,
+                                                           stop_event.get_token());
+        }
 
         is_powered_on = true;
         exit_locked = false;
@@ -335,8 +357,20 @@ struct System::Impl {
     SystemResultStatus Load(System& system, Frontend::EmuWindow& emu_window,
                             const std::string& filepath,
                             Service::AM::FrontendAppletParameters& params) {
-        app_loader = Loader::GetLoader(system, GetGameFileFromPath(virtual_filesystem, filepath),
-                                       params.program_id, params.program_index);
+        Common::BootProfiler::Start();
+        BOOT_PHASE("System::Load");
+
+        if (Settings::values.record_scope_trace) {
+            scope_trace_title = fmt::format("{:016X}", params.program_id);
+            Common::ScopeTrace::Start();
+        }
+
+        {
+            BOOT_PHASE("GetLoader");
+            app_loader =
+                Loader::GetLoader(system, GetGameFileFromPath(virtual_filesystem, filepath),
+                                  params.program_id, params.program_index);
+        }
 
         if (!app_loader) {
             LOG_CRITICAL(Core, "Failed to obtain loader for {}!", filepath);
@@ -354,14 +388,17 @@ struct System::Impl {
 
         LOG_INFO(Core, "Loading {} ({})", name, params.program_id);
 
-        InitializeKernel(system);
+        InitializeKernel(system, params.program_id);
 
         // Create the application process.
         auto main_process = Kernel::KProcess::Create(system.Kernel());
         Kernel::KProcess::Register(system.Kernel(), main_process);
         kernel.AppendNewProcess(main_process);
         kernel.MakeApplicationProcess(main_process);
-        const auto [load_result, load_parameters] = app_loader->Load(*main_process, system);
+        const auto [load_result, load_parameters] = [&] {
+            BOOT_PHASE("AppLoader::Load");
+            return app_loader->Load(*main_process, system);
+        }();
         if (load_result != Loader::ResultStatus::Success) {
             LOG_CRITICAL(Core, "Failed to load ROM (Error {})!", load_result);
             ShutdownMainProcess();
@@ -425,10 +462,24 @@ struct System::Impl {
             room_member->SendGameInfo(game_info);
         }
 
+        is_boot_profile_pending = true;
         status = SystemResultStatus::Success;
         return status;
     }
 
+    void LogPageTableMemory() {
+        const auto gpu_stats = Common::GetMultiLevelPageTableStatistics();
+        size_t process_bytes = 0;
+        if (const auto* process = kernel.ApplicationProcess()) {
+            const auto& page_table = process->GetPageTable().GetBasePageTable().GetImpl();
+            process_bytes = page_table.GetCommittedBytes();
+        }
+        LOG_INFO(Core,
+                 "Page table memory: process {} KiB, GPU {} KiB in {} sub-tables (peak {} KiB)",
+                 process_bytes / 1024, gpu_stats.committed_bytes / 1024,
+                 gpu_stats.committed_levels, gpu_stats.peak_committed_bytes / 1024);
+    }
+
     void ShutdownMainProcess() {
         SetShuttingDown(true);
 
@@ -447,6 +498,8 @@ struct System::Impl {
                                         perf_stats->GetMeanFrametime());
         }
 
+        LogPageTableMemory();
+
         is_powered_on = false;
         exit_locked = false;
         exit_requested = false;
@@ -477,6 +530,7 @@ struct System::Impl {
         debugger.reset();
         kernel.Shutdown();
         stop_event = {};
+        Common::ScopeTrace::Finish(scope_trace_title);
         Network::RestartSocketOperations();
 
         if (auto room_member = room_network.GetRoomMember().lock()) {
@@ -563,6 +617,8 @@ struct System::Impl {
     bool exit_requested = false;
 
     bool nvdec_active{};
+    bool is_boot_profile_pending{};
+    std::string scope_trace_title;
 
     Reporter reporter;
     std::unique_ptr<Memory::CheatEngine> cheat_engine;
@@ -4,7 +4,6 @@
 #include <algorithm>
 #include <mutex>
 #include <string>
-#include <tuple>
 
 #ifdef _WIN32
 #include "common/windows/timer_resolution.h"
@@ -26,22 +25,11 @@ std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callbac
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
 
-struct CoreTiming::Event {
-    s64 time;
-    u64 fifo_order;
+struct CoreTiming::Event : TimerWheel::Node {
     std::weak_ptr<EventType> type;
+    /// Key of the group this event is linked into, the type may have expired since
+    const EventType* type_key;
     s64 reschedule_time;
-    heap_t::handle_type handle{};
-
-    // Sort by time, unless the times are the same, in which case sort by
-    // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-    }
-
-    friend bool operator<(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-    }
 };
 
 CoreTiming::CoreTiming() : clock{Common::CreateOptimalClock()} {}
@@ -73,7 +61,13 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 
 void CoreTiming::ClearPendingEvents() {
     std::scoped_lock lock{advance_lock, basic_lock};
-    event_queue.clear();
+    event_queue.Clear();
+    scheduled_by_type.clear();
+    free_events.clear();
+    for (const auto& evt : event_storage) {
+        evt->type.reset();
+        free_events.push_back(evt.get());
+    }
     event.Set();
 }
 
@@ -112,7 +106,7 @@ bool CoreTiming::IsRunning() const {
 
 bool CoreTiming::HasPendingEvents() const {
     std::scoped_lock lock{basic_lock};
-    return !(wait_set && event_queue.empty());
+    return !(wait_set && event_queue.Empty());
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
@@ -120,9 +114,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
     {
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
-
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
-        (*h).handle = h;
+        InsertEvent(next_time.count(), event_type, 0);
     }
 
     event.Set();
@@ -135,10 +127,7 @@ void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
     {
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
-
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
-        (*h).handle = h;
+        InsertEvent(next_time.count(), event_type, resched_time.count());
     }
 
     event.Set();
@@ -149,16 +138,13 @@ void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
     {
         std::scoped_lock lk{basic_lock};
 
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
+        if (const auto it = scheduled_by_type.find(event_type.get());
+            it != scheduled_by_type.end()) {
+            TimerWheel::Group& group = it->second;
+            while (!group.empty()) {
+                FreeEvent(static_cast<Event&>(group.front()));
             }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
+            scheduled_by_type.erase(it);
         }
 
         event_type->sequence_number++;
@@ -201,61 +187,87 @@ std::optional<s64> CoreTiming::Advance() {
     std::scoped_lock lock{advance_lock, basic_lock};
     global_timer = GetGlobalTimeNs().count();
 
-    while (!event_queue.empty() && event_queue.top().time <= global_timer) {
-        const Event& evt = event_queue.top();
-
-        if (const auto event_type{evt.type.lock()}) {
-            const auto evt_time = evt.time;
-            const auto evt_sequence_num = event_type->sequence_number;
-
-            if (evt.reschedule_time == 0) {
-                event_queue.pop();
-
-                basic_lock.unlock();
-
-                event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time});
-
-                basic_lock.lock();
-            } else {
-                basic_lock.unlock();
-
-                const auto new_schedule_time{event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
+    for (auto* evt = static_cast<Event*>(event_queue.Earliest());
+         evt != nullptr && evt->time <= global_timer;
+         evt = static_cast<Event*>(event_queue.Earliest())) {
+        const auto event_type{evt->type.lock()};
+        const auto evt_time = evt->time;
+        const auto reschedule_time = evt->reschedule_time;
+
+        // The event leaves the queue while its callback runs, a looping event is queued again
+        // afterwards unless it was changed externally in the meantime.
+        ReleaseEvent(*evt);
+        if (!event_type) {
+            continue;
+        }
+        const auto evt_sequence_num = event_type->sequence_number;
 
-                basic_lock.lock();
+        basic_lock.unlock();
 
-                if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
-                    continue;
-                }
+        const auto new_schedule_time{event_type->callback(
+            evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
 
-                const auto next_schedule_time{new_schedule_time.has_value()
-                                                  ? new_schedule_time.value().count()
-                                                  : evt.reschedule_time};
+        basic_lock.lock();
 
-                // If this event was scheduled into a pause, its time now is going to be way
-                // behind. Re-set this event to continue from the end of the pause.
-                auto next_time{evt.time + next_schedule_time};
-                if (evt.time < pause_end_time) {
-                    next_time = pause_end_time + next_schedule_time;
-                }
+        if (reschedule_time != 0 && evt_sequence_num == event_type->sequence_number) {
+            const auto next_schedule_time{new_schedule_time.has_value()
+                                              ? new_schedule_time.value().count()
+                                              : reschedule_time};
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
+            // If this event was scheduled into a pause, its time now is going to be way
+            // behind. Re-set this event to continue from the end of the pause.
+            auto next_time{evt_time + next_schedule_time};
+            if (evt_time < pause_end_time) {
+                next_time = pause_end_time + next_schedule_time;
             }
+
+            InsertEvent(next_time, event_type, next_schedule_time);
         }
 
         global_timer = GetGlobalTimeNs().count();
     }
 
-    if (!event_queue.empty()) {
-        return event_queue.top().time;
+    if (const auto* const evt = event_queue.Earliest()) {
+        return evt->time;
     } else {
         return std::nullopt;
     }
 }
 
+void CoreTiming::InsertEvent(s64 time, const std::shared_ptr<EventType>& event_type,
+                             s64 reschedule_time) {
+    if (free_events.empty()) {
+        free_events.push_back(event_storage.emplace_back(std::make_unique<Event>()).get());
+    }
+    Event& evt = *free_events.back();
+    free_events.pop_back();
+
+    evt.time = time;
+    evt.fifo_order = event_fifo_id++;
+    evt.type = event_type;
+    evt.type_key = event_type.get();
+    evt.reschedule_time = reschedule_time;
+    event_queue.Insert(evt);
+    scheduled_by_type[evt.type_key].push_back(evt);
+}
+
+void CoreTiming::ReleaseEvent(Event& evt) {
+    const EventType* const type_key = evt.type_key;
+    FreeEvent(evt);
+
+    if (const auto it = scheduled_by_type.find(type_key);
+        it != scheduled_by_type.end() && it->second.empty()) {
+        scheduled_by_type.erase(it);
+    }
+}
+
+void CoreTiming::FreeEvent(Event& evt) {
+    event_queue.Remove(evt);
+    evt.group_hook.unlink();
+    evt.type.reset();
+    free_events.push_back(&evt);
+}
+
 void CoreTiming::ThreadLoop() {
     has_started = true;
     while (!shutting_down) {
@@ -11,12 +11,13 @@
 #include <optional>
 #include <string>
 #include <thread>
-
-#include <boost/heap/fibonacci_heap.hpp>
+#include <unordered_map>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
+#include "core/timer_wheel.h"
 
 namespace Core::Timing {
 
@@ -146,6 +147,15 @@ private:
 
     void Reset();
 
+    /// Queues a new event, basic_lock must be held.
+    void InsertEvent(s64 time, const std::shared_ptr<EventType>& event_type,
+                     s64 reschedule_time);
+
+    /// Removes an event from the queue and returns it to the pool, basic_lock must be held.
+    void ReleaseEvent(Event& evt);
+
+    void FreeEvent(Event& evt);
+
     std::unique_ptr<Common::WallClock> clock;
 
     s64 global_timer = 0;
@@ -154,10 +164,11 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
-
-    heap_t event_queue;
+    TimerWheel event_queue;
+    /// Pending events of each event type, so they can be unscheduled without a search
+    std::unordered_map<const EventType*, TimerWheel::Group> scheduled_by_type;
+    std::vector<std::unique_ptr<Event>> event_storage;
+    std::vector<Event*> free_events;
     u64 event_fifo_id = 0;
 
     Common::Event event{};
@@ -15,6 +15,10 @@
 #include "core/hle/kernel/physical_core.h"
 #include "video_core/gpu.h"
 
+#ifdef ANDROID
+#include "common/android/performance_hint.h"
+#endif
+
 namespace Core {
 
 CpuManager::CpuManager(System& system_) : system{system_} {}
@@ -195,6 +199,11 @@ void CpuManager::RunThread(std::stop_token token, std::size_t core) {
     MicroProfileOnThreadCreate(name.c_str());
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::Critical);
+    Common::SetCurrentThreadAffinity(Common::ThreadRole::EmulatedCore);
+#ifdef ANDROID
+    const Common::Android::ScopedHintThread hint_thread{
+        Common::Android::HintSession::EmulatedCores};
+#endif
     auto& data = core_data[core];
     data.host_context = Common::Fiber::ThreadToFiber();
 
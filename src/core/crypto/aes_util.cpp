@@ -1,13 +1,22 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#include "common/swap.h"
+#include "common/x64/cpu_detect.h"
+#endif
+
 namespace Core::Crypto {
 namespace {
 using NintendoTweak = std::array<u8, 16>;
@@ -20,6 +29,166 @@ NintendoTweak CalculateNintendoTweak(std::size_t sector_id) {
     }
     return out;
 }
+
+#ifdef ARCHITECTURE_x86_64
+#ifdef _MSC_VER
+#define AESNI_FUNCTION
+#else
+#define AESNI_FUNCTION __attribute__((target("aes")))
+#endif
+
+// AES-128 on AES-NI. Blocks are processed in groups of eight, so the rounds of independent blocks
+// overlap in the pipeline instead of waiting on each other's latency.
+namespace AesNi {
+
+constexpr std::size_t Rounds = 10;
+constexpr std::size_t BlockSize = 0x10;
+constexpr std::size_t Lanes = 8;
+
+using RoundKeys = __m128i[Rounds + 1];
+
+AESNI_FUNCTION __m128i ExpandRoundKey(__m128i key, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+AESNI_FUNCTION void ExpandKey(const u8* key, RoundKeys& enc, RoundKeys& dec) {
+    enc[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    enc[1] = ExpandRoundKey(enc[0], _mm_aeskeygenassist_si128(enc[0], 0x01));
+    enc[2] = ExpandRoundKey(enc[1], _mm_aeskeygenassist_si128(enc[1], 0x02));
+    enc[3] = ExpandRoundKey(enc[2], _mm_aeskeygenassist_si128(enc[2], 0x04));
+    enc[4] = ExpandRoundKey(enc[3], _mm_aeskeygenassist_si128(enc[3], 0x08));
+    enc[5] = ExpandRoundKey(enc[4], _mm_aeskeygenassist_si128(enc[4], 0x10));
+    enc[6] = ExpandRoundKey(enc[5], _mm_aeskeygenassist_si128(enc[5], 0x20));
+    enc[7] = ExpandRoundKey(enc[6], _mm_aeskeygenassist_si128(enc[6], 0x40));
+    enc[8] = ExpandRoundKey(enc[7], _mm_aeskeygenassist_si128(enc[7], 0x80));
+    enc[9] = ExpandRoundKey(enc[8], _mm_aeskeygenassist_si128(enc[8], 0x1B));
+    enc[10] = ExpandRoundKey(enc[9], _mm_aeskeygenassist_si128(enc[9], 0x36));
+
+    dec[0] = enc[Rounds];
+    for (std::size_t i = 1; i < Rounds; ++i) {
+        dec[i] = _mm_aesimc_si128(enc[Rounds - i]);
+    }
+    dec[Rounds] = enc[0];
+}
+
+AESNI_FUNCTION void EncryptBlocks(const RoundKeys& keys, __m128i* blocks, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        blocks[i] = _mm_xor_si128(blocks[i], keys[0]);
+    }
+    for (std::size_t round = 1; round < Rounds; ++round) {
+        for (std::size_t i = 0; i < count; ++i) {
+            blocks[i] = _mm_aesenc_si128(blocks[i], keys[round]);
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        blocks[i] = _mm_aesenclast_si128(blocks[i], keys[Rounds]);
+    }
+}
+
+AESNI_FUNCTION void DecryptBlocks(const RoundKeys& keys, __m128i* blocks, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        blocks[i] = _mm_xor_si128(blocks[i], keys[0]);
+    }
+    for (std::size_t round = 1; round < Rounds; ++round) {
+        for (std::size_t i = 0; i < count; ++i) {
+            blocks[i] = _mm_aesdec_si128(blocks[i], keys[round]);
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        blocks[i] = _mm_aesdeclast_si128(blocks[i], keys[Rounds]);
+    }
+}
+
+/// Transcodes in CTR mode and advances the big endian counter in iv past the blocks used, like
+/// mbedtls does.
+AESNI_FUNCTION void CtrTranscode(const RoundKeys& keys, std::array<u8, BlockSize>& iv,
+                                 const u8* src, std::size_t size, u8* dest) {
+    u64 counter_hi;
+    u64 counter_lo;
+    std::memcpy(&counter_hi, iv.data(), sizeof(u64));
+    std::memcpy(&counter_lo, iv.data() + sizeof(u64), sizeof(u64));
+    counter_hi = Common::swap64(counter_hi);
+    counter_lo = Common::swap64(counter_lo);
+
+    __m128i blocks[Lanes];
+    for (std::size_t offset = 0; offset < size; offset += Lanes * BlockSize) {
+        const std::size_t count = std::min(Lanes, (size - offset + BlockSize - 1) / BlockSize);
+        for (std::size_t i = 0; i < count; ++i) {
+            blocks[i] = _mm_set_epi64x(static_cast<s64>(Common::swap64(counter_lo)),
+                                       static_cast<s64>(Common::swap64(counter_hi)));
+            if (++counter_lo == 0) {
+                ++counter_hi;
+            }
+        }
+        EncryptBlocks(keys, blocks, count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t block_offset = offset + i * BlockSize;
+            const std::size_t length = std::min(BlockSize, size - block_offset);
+            if (length == BlockSize) {
+                const __m128i data =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + block_offset));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + block_offset),
+                                 _mm_xor_si128(data, blocks[i]));
+                continue;
+            }
+            std::array<u8, BlockSize> keystream;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keystream.data()), blocks[i]);
+            for (std::size_t j = 0; j < length; ++j) {
+                dest[block_offset + j] = src[block_offset + j] ^ keystream[j];
+            }
+        }
+    }
+
+    counter_hi = Common::swap64(counter_hi);
+    counter_lo = Common::swap64(counter_lo);
+    std::memcpy(iv.data(), &counter_hi, sizeof(u64));
+    std::memcpy(iv.data() + sizeof(u64), &counter_lo, sizeof(u64));
+}
+
+/// Multiplies an XTS tweak by the primitive element of GF(2^128).
+AESNI_FUNCTION __m128i MultiplyTweak(__m128i tweak) {
+    const __m128i carry = _mm_and_si128(_mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), 0x93),
+                                        _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1), carry);
+}
+
+/// Transcodes a single XTS data unit. The size must be a multiple of the block size.
+AESNI_FUNCTION void XtsTranscode(const RoundKeys& data_keys, const RoundKeys& tweak_keys,
+                                 const std::array<u8, BlockSize>& iv, const u8* src,
+                                 std::size_t size, u8* dest, Op op) {
+    __m128i tweak = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv.data()));
+    EncryptBlocks(tweak_keys, &tweak, 1);
+
+    __m128i blocks[Lanes];
+    __m128i tweaks[Lanes];
+    for (std::size_t offset = 0; offset < size; offset += Lanes * BlockSize) {
+        const std::size_t count = std::min(Lanes, (size - offset) / BlockSize);
+        for (std::size_t i = 0; i < count; ++i) {
+            const __m128i data = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + offset + i * BlockSize));
+            tweaks[i] = tweak;
+            blocks[i] = _mm_xor_si128(data, tweak);
+            tweak = MultiplyTweak(tweak);
+        }
+        if (op == Op::Decrypt) {
+            DecryptBlocks(data_keys, blocks, count);
+        } else {
+            EncryptBlocks(data_keys, blocks, count);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset + i * BlockSize),
+                             _mm_xor_si128(blocks[i], tweaks[i]));
+        }
+    }
+}
+
+} // namespace AesNi
+#endif
 } // Anonymous namespace
 
 static_assert(static_cast<std::size_t>(Mode::CTR) ==
@@ -36,6 +205,16 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+#ifdef ARCHITECTURE_x86_64
+    // CTR and XTS bypass mbedtls when the host has AES-NI, which it only uses a block at a time.
+    Mode mode{};
+    bool use_aesni{};
+    std::array<u8, AesNi::BlockSize> iv{};
+    AesNi::RoundKeys encryption_keys{};
+    AesNi::RoundKeys decryption_keys{};
+    AesNi::RoundKeys tweak_keys{};
+#endif
 };
 
 template <typename Key, std::size_t KeySize>
@@ -57,6 +236,20 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+#ifdef ARCHITECTURE_x86_64
+    ctx->mode = mode;
+    const bool is_aes128 = (mode == Mode::CTR && KeySize == 0x10) ||
+                           (mode == Mode::XTS && KeySize == 0x20);
+    ctx->use_aesni = is_aes128 && Common::GetCPUCaps().aes;
+    if (ctx->use_aesni) {
+        AesNi::ExpandKey(key.data(), ctx->encryption_keys, ctx->decryption_keys);
+        if constexpr (KeySize == 0x20) {
+            AesNi::RoundKeys unused_keys;
+            AesNi::ExpandKey(key.data() + 0x10, ctx->tweak_keys, unused_keys);
+        }
+    }
+#endif
 }
 
 template <typename Key, std::size_t KeySize>
@@ -67,12 +260,28 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+#ifdef ARCHITECTURE_x86_64
+    if (ctx->use_aesni) {
+        if (ctx->mode == Mode::CTR) {
+            AesNi::CtrTranscode(ctx->encryption_keys, ctx->iv, src, size, dest);
+            return;
+        }
+        if (size % AesNi::BlockSize == 0) {
+            AesNi::XtsTranscode(op == Op::Encrypt ? ctx->encryption_keys : ctx->decryption_keys,
+                                ctx->tweak_keys, ctx->iv, src, size, dest, op);
+            return;
+        }
+    }
+#endif
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
 
     std::size_t written = 0;
-    if (mbedtls_cipher_get_cipher_mode(context) == MBEDTLS_MODE_XTS) {
+    const auto cipher_mode = mbedtls_cipher_get_cipher_mode(context);
+    if (cipher_mode == MBEDTLS_MODE_XTS || cipher_mode == MBEDTLS_MODE_CTR) {
+        // Stream modes take the whole buffer at once, rather than a call per block.
         mbedtls_cipher_update(context, src, size, dest, &written);
         if (written != size) {
             LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
@@ -122,6 +331,10 @@ void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
+
+#ifdef ARCHITECTURE_x86_64
+    std::memcpy(ctx->iv.data(), data.data(), std::min(data.size(), ctx->iv.size()));
+#endif
 }
 
 template class AESCipher<Key128>;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <mutex>
 
 #include "core/crypto/aes_util.h"
 #include "core/crypto/encryption_layer.h"
@@ -28,6 +29,7 @@ private:
     // Must be mutable as operations modify cipher contexts.
     mutable AESCipher<Key128> cipher;
     mutable IVData iv{};
+    mutable std::mutex cipher_mutex;
 
     void UpdateIV(std::size_t offset) const;
 };
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "core/crypto/aes_util.h"
 #include "core/crypto/encryption_layer.h"
 #include "core/crypto/key_manager.h"
@@ -19,6 +21,7 @@ public:
 private:
     // Must be mutable as operations modify cipher contexts.
     mutable AESCipher<Key256> cipher;
+    mutable std::mutex cipher_mutex;
 };
 
 } // namespace Core::Crypto
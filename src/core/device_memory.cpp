@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/settings.h"
 #include "core/device_memory.h"
 #include "hle/kernel/board/nintendo/nx/k_system_control.h"
 
@@ -12,9 +13,18 @@ constexpr size_t VirtualReserveSize = 1ULL << 38;
 constexpr size_t VirtualReserveSize = 1ULL << 39;
 #endif
 
+namespace {
+bool UseHugePages() {
+    // Native code can not fall back to the page table when the arena is not fully mapped
+    return Settings::values.use_huge_pages.GetValue() &&
+           Settings::values.cpu_backend.GetValue() != Settings::CpuBackend::Nce;
+}
+} // Anonymous namespace
+
 DeviceMemory::DeviceMemory()
     : buffer{Kernel::Board::Nintendo::Nx::KSystemControl::Init::GetIntendedMemorySize(),
-             VirtualReserveSize} {}
+             VirtualReserveSize, UseHugePages()},
+      memory_usage{Common::MemoryUsageCategory::GuestMemory, buffer.BackingSize()} {}
 
 DeviceMemory::~DeviceMemory() = default;
 
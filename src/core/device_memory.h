@@ -4,6 +4,7 @@
 #pragma once
 
 #include "common/host_memory.h"
+#include "common/memory_usage.h"
 #include "common/typed_address.h"
 
 namespace Core {
@@ -60,6 +61,9 @@ public:
     }
 
     Common::HostMemory buffer;
+
+private:
+    Common::MemoryUsageCounter memory_usage;
 };
 
 } // namespace Core
@@ -7,8 +7,11 @@
 #include <atomic>
 #include <bit>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <utility>
 
 #include "common/common_types.h"
 #include "common/range_mutex.h"
@@ -115,6 +118,10 @@ public:
 
     void UpdatePagesCachedCount(DAddr addr, size_t size, s32 delta);
 
+    /// Applies delta once per range to the cached count of the pages of many ranges at once.
+    /// Ranges may overlap or be unsorted, host protections change once per contiguous run.
+    void UpdatePagesCachedBatch(std::span<const std::pair<DAddr, size_t>> ranges, s32 delta);
+
     static constexpr size_t AS_BITS = Traits::device_virtual_bits;
 
 private:
@@ -182,6 +189,23 @@ private:
     }
 
     Common::VirtualBuffer<VAddr> cpu_backing_address;
+
+    /// Contiguous guest pages whose caching state changes, marked on the host as a single region
+    struct CachingRun {
+        u64 begin_vpage{};
+        u64 num_bytes{};
+    };
+    struct CachingRuns {
+        size_t asid = std::numeric_limits<size_t>::max();
+        Memory::Memory* process{};
+        u64 last_vpage{};
+        CachingRun uncache{};
+        CachingRun cache{};
+    };
+
+    void UpdatePagesCachedRange(size_t page, size_t page_end, s32 delta, CachingRuns& runs);
+    void ReleaseCachingRun(CachingRuns& runs, CachingRun& run, bool cached);
+    void ReleaseCachingRuns(CachingRuns& runs);
     using CounterType = u8;
     using CounterAtomicType = std::atomic_uint8_t;
     static constexpr size_t subentries = 8 / sizeof(CounterType);
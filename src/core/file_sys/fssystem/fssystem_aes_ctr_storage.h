@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
 
 #include "core/crypto/aes_util.h"
@@ -38,6 +39,7 @@ private:
     std::array<u8, KeySize> m_key;
     std::array<u8, IvSize> m_iv;
     mutable std::optional<Core::Crypto::AESCipher<Core::Crypto::Key128>> m_cipher;
+    mutable std::mutex m_cipher_mutex;
 };
 
 } // namespace FileSys
@@ -59,6 +59,9 @@ size_t AesXtsStorage::Read(u8* buffer, size_t size, size_t offset) const {
     std::memcpy(ctr.data(), m_iv.data(), IvSize);
     AddCounter(ctr.data(), IvSize, offset / m_block_size);
 
+    // The cipher keeps its IV between calls, so decryption is serialised.
+    std::scoped_lock lk{m_mutex};
+
     // Handle any unaligned data before the start.
     size_t processed_size = 0;
     if ((offset % m_block_size) != 0) {
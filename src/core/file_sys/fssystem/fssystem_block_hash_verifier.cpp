@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <mbedtls/sha256.h>
+
+#include "common/alignment.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/thread_pool.h"
+#include "core/file_sys/fssystem/fssystem_block_hash_verifier.h"
+
+namespace FileSys {
+
+bool BlockHashVerifier::IsEnabled() {
+    return Settings::values.verify_nca_integrity.GetValue();
+}
+
+BlockHashVerifier::BlockHashVerifier(VirtualFile data_storage, VirtualFile hash_storage,
+                                     s64 block_size, bool is_last_block_padded)
+    : m_data_storage(std::move(data_storage)), m_hash_storage(std::move(hash_storage)),
+      m_data_size(static_cast<s64>(m_data_storage->GetSize())), m_block_size(block_size),
+      m_is_last_block_padded(is_last_block_padded),
+      m_states(Common::DivideUp(static_cast<size_t>(m_data_size), static_cast<size_t>(block_size)),
+               BlockState::Unverified) {}
+
+BlockHashVerifier::~BlockHashVerifier() = default;
+
+bool BlockHashVerifier::Request(s64 offset, s64 size) {
+    const s64 num_blocks = static_cast<s64>(m_states.size());
+    const s64 first_block = offset / m_block_size;
+    const s64 end_block = std::min(Common::DivideUp(offset + size, m_block_size), num_blocks);
+
+    s64 queue_first = end_block;
+    s64 queue_end = first_block;
+    {
+        std::scoped_lock lk{m_mutex};
+        for (s64 block = first_block; block < end_block; ++block) {
+            switch (m_states[block]) {
+            case BlockState::Failed:
+                return false;
+            case BlockState::Unverified:
+                m_states[block] = BlockState::Queued;
+                queue_first = std::min(queue_first, block);
+                queue_end = block + 1;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    if (queue_first < queue_end) {
+        Common::GetThreadPool().Submit(
+            Common::TaskPriority::Background, [weak = weak_from_this(), queue_first, queue_end] {
+                if (const auto verifier = weak.lock()) {
+                    verifier->Verify(queue_first, queue_end);
+                }
+            });
+    }
+    return true;
+}
+
+void BlockHashVerifier::Verify(s64 first_block, s64 end_block) {
+    std::vector<u8> buffer(m_block_size);
+    for (s64 block = first_block; block < end_block; ++block) {
+        {
+            std::scoped_lock lk{m_mutex};
+            if (m_states[block] != BlockState::Queued) {
+                continue;
+            }
+        }
+
+        const bool is_valid = this->VerifyBlock(block, buffer);
+        if (!is_valid) {
+            LOG_ERROR(Service_FS, "Block at offset {:#x} failed integrity verification",
+                      block * m_block_size);
+        }
+
+        std::scoped_lock lk{m_mutex};
+        m_states[block] = is_valid ? BlockState::Verified : BlockState::Failed;
+    }
+}
+
+bool BlockHashVerifier::VerifyBlock(s64 block, std::vector<u8>& buffer) const {
+    const s64 offset = block * m_block_size;
+    const size_t data_size = static_cast<size_t>(std::min(m_block_size, m_data_size - offset));
+    if (m_data_storage->Read(buffer.data(), data_size, offset) != data_size) {
+        return false;
+    }
+
+    size_t hashed_size = data_size;
+    if (m_is_last_block_padded && data_size < buffer.size()) {
+        std::memset(buffer.data() + data_size, 0, buffer.size() - data_size);
+        hashed_size = buffer.size();
+    }
+
+    std::array<u8, HashSize> expected_hash;
+    if (m_hash_storage->Read(expected_hash.data(), HashSize, block * HashSize) != HashSize) {
+        return false;
+    }
+
+    std::array<u8, HashSize> hash;
+    mbedtls_sha256_ret(buffer.data(), hashed_size, hash.data(), 0);
+    return hash == expected_hash;
+}
+
+} // namespace FileSys
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+// Verifies the SHA-256 hashes of the blocks of a storage on a worker thread.
+//
+// Reads are served before their blocks are verified. The blocks they cover are queued for
+// verification, and later reads of a block that failed are refused. Verified blocks are not
+// hashed again.
+class BlockHashVerifier : public std::enable_shared_from_this<BlockHashVerifier> {
+    YUZU_NON_COPYABLE(BlockHashVerifier);
+    YUZU_NON_MOVEABLE(BlockHashVerifier);
+
+public:
+    static constexpr size_t HashSize = 256 / 8;
+
+public:
+    static bool IsEnabled();
+
+    // The hash storage holds one hash per block of the data storage. When the last block is
+    // padded, it is hashed as a whole block with zeroes past the end of the data.
+    BlockHashVerifier(VirtualFile data_storage, VirtualFile hash_storage, s64 block_size,
+                      bool is_last_block_padded);
+    ~BlockHashVerifier();
+
+    // Queues the blocks covering a read that are not verified yet. Returns false if any of them
+    // failed verification.
+    bool Request(s64 offset, s64 size);
+
+private:
+    enum class BlockState : u8 {
+        Unverified,
+        Queued,
+        Verified,
+        Failed,
+    };
+
+    void Verify(s64 first_block, s64 end_block);
+    bool VerifyBlock(s64 block, std::vector<u8>& buffer) const;
+
+private:
+    VirtualFile m_data_storage;
+    VirtualFile m_hash_storage;
+    s64 m_data_size;
+    s64 m_block_size;
+    bool m_is_last_block_padded;
+    std::vector<BlockState> m_states;
+    std::mutex m_mutex;
+};
+
+} // namespace FileSys
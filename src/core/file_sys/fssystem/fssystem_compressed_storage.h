@@ -3,7 +3,13 @@
 
 #pragma once
 
+#include <list>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 #include "common/literals.h"
+#include "common/thread_worker.h"
 
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fs_i_storage.h"
@@ -690,6 +696,21 @@ private:
         };
         static_assert(std::is_trivial_v<AccessRange>);
 
+        struct ReadAheadBuffer {
+            s64 offset;
+            std::vector<u8> data;
+
+            s64 GetEndOffset() const {
+                return this->offset + static_cast<s64>(this->data.size());
+            }
+        };
+
+    public:
+        static constexpr size_t ReadAheadSize = 512_KiB;
+        static constexpr size_t ReadAheadBufferCount = 4;
+        static constexpr size_t ReadAheadDistance = 2 * ReadAheadSize;
+        static constexpr s32 SequentialAccessCountForReadAhead = 2;
+
     public:
         CacheManager() = default;
 
@@ -891,13 +912,91 @@ private:
             R_SUCCEED();
         }
 
+        std::optional<s64> RecordAccess(s64 offset, size_t size) {
+            // Detect whether the accesses are streaming through the storage.
+            if (offset == m_next_sequential_offset) {
+                ++m_sequential_access_count;
+            } else {
+                m_sequential_access_count = 0;
+                m_read_ahead_end_offset = 0;
+            }
+            m_next_sequential_offset = offset + static_cast<s64>(size);
+            if (m_sequential_access_count < SequentialAccessCountForReadAhead) {
+                return std::nullopt;
+            }
+
+            // Read ahead of the stream, past what was already requested.
+            const s64 read_ahead_offset =
+                std::max(m_next_sequential_offset, m_read_ahead_end_offset);
+            const s64 read_ahead_limit =
+                m_next_sequential_offset + static_cast<s64>(ReadAheadDistance);
+            if (read_ahead_offset >= m_storage_size || read_ahead_offset >= read_ahead_limit) {
+                return std::nullopt;
+            }
+            m_read_ahead_end_offset = read_ahead_offset + static_cast<s64>(ReadAheadSize);
+            return read_ahead_offset;
+        }
+
+        bool ReadFromReadAhead(s64 offset, void* buffer, size_t size) {
+            // Copy the data from the buffers, which may be split across several of them.
+            char* cur_dst = static_cast<char*>(buffer);
+            while (size > 0) {
+                const auto it = std::ranges::find_if(m_read_ahead_buffers, [&](const auto& ra) {
+                    return ra.offset <= offset && offset < ra.GetEndOffset();
+                });
+                if (it == m_read_ahead_buffers.end()) {
+                    return false;
+                }
+
+                const size_t copy_size = std::min<size_t>(size, it->GetEndOffset() - offset);
+                std::memcpy(cur_dst, it->data.data() + (offset - it->offset), copy_size);
+                cur_dst += copy_size;
+                offset += copy_size;
+                size -= copy_size;
+
+                // Keep the most recently used buffers at the front.
+                m_read_ahead_buffers.splice(m_read_ahead_buffers.begin(), m_read_ahead_buffers,
+                                            it);
+            }
+            return true;
+        }
+
+        Result ReadAhead(CompressedStorageCore& core, s64 offset) {
+            // Skip the read if a previous one already buffered this range.
+            const bool is_buffered = std::ranges::any_of(m_read_ahead_buffers, [&](const auto& ra) {
+                return ra.offset <= offset && offset < ra.GetEndOffset();
+            });
+            R_SUCCEED_IF(is_buffered);
+
+            // Decompress the range into a buffer, replacing the least recently used one.
+            ReadAheadBuffer read_ahead{
+                .offset = offset,
+                .data = {},
+            };
+            if (m_read_ahead_buffers.size() >= ReadAheadBufferCount) {
+                read_ahead.data = std::move(m_read_ahead_buffers.back().data);
+                m_read_ahead_buffers.pop_back();
+            }
+            read_ahead.data.resize(std::min<size_t>(ReadAheadSize, m_storage_size - offset));
+            R_TRY(this->Read(core, offset, read_ahead.data.data(), read_ahead.data.size()));
+
+            m_read_ahead_buffers.push_front(std::move(read_ahead));
+            R_SUCCEED();
+        }
+
     private:
         s64 m_storage_size = 0;
+        s64 m_next_sequential_offset = 0;
+        s64 m_read_ahead_end_offset = 0;
+        s32 m_sequential_access_count = 0;
+        std::list<ReadAheadBuffer> m_read_ahead_buffers;
     };
 
 public:
     CompressedStorage() = default;
     virtual ~CompressedStorage() {
+        // Wait for the read-ahead to stop using the core.
+        m_read_ahead_worker.reset();
         this->Finalize();
     }
 
@@ -948,16 +1047,37 @@ public:
     }
 
     virtual size_t Read(u8* buffer, size_t size, size_t offset) const override {
-        if (R_SUCCEEDED(m_cache_manager.Read(m_core, offset, buffer, size))) {
-            return size;
-        } else {
-            return 0;
+        std::optional<s64> read_ahead_offset;
+        {
+            // The cache entries and the decompression buffers are shared by every reader.
+            std::scoped_lock lk{m_mutex};
+            read_ahead_offset = m_cache_manager.RecordAccess(offset, size);
+            if (read_ahead_offset && !m_read_ahead_worker) {
+                m_read_ahead_worker =
+                    std::make_unique<Common::ThreadWorker>(1, "CompressedReadAhead");
+            }
+
+            if (!m_cache_manager.ReadFromReadAhead(offset, buffer, size) &&
+                R_FAILED(m_cache_manager.Read(m_core, offset, buffer, size))) {
+                return 0;
+            }
+        }
+
+        // Decompress the data following a sequential stream while the guest consumes this read.
+        if (read_ahead_offset) {
+            m_read_ahead_worker->QueueWork([this, ra_offset = *read_ahead_offset] {
+                std::scoped_lock lk{m_mutex};
+                m_cache_manager.ReadAhead(m_core, ra_offset);
+            });
         }
+        return size;
     }
 
 private:
     mutable CompressedStorageCore m_core;
     mutable CacheManager m_cache_manager;
+    mutable std::mutex m_mutex;
+    mutable std::unique_ptr<Common::ThreadWorker> m_read_ahead_worker;
 };
 
 } // namespace FileSys
@@ -1,9 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <mbedtls/sha256.h>
+
 #include "common/alignment.h"
 #include "common/scope_exit.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
+#include "core/file_sys/vfs/vfs_vector.h"
 
 namespace FileSys {
 
@@ -63,6 +66,21 @@ Result HierarchicalSha256Storage::Initialize(VirtualFile* base_storages, s32 lay
     base_storages[1]->Read(reinterpret_cast<u8*>(m_hash_buffer),
                            static_cast<size_t>(hash_storage_size), 0);
 
+    // Verify the data blocks in the background, if enabled.
+    if (BlockHashVerifier::IsEnabled()) {
+        // The hash table is small, so it is checked against the master hash right away.
+        std::array<u8, HashSize> hash_table_hash{};
+        mbedtls_sha256_ret(reinterpret_cast<const u8*>(m_hash_buffer),
+                           static_cast<size_t>(hash_storage_size), hash_table_hash.data(), 0);
+        R_UNLESS(hash_table_hash == master_hash, ResultHierarchicalSha256HashVerificationFailed);
+
+        // The verifier keeps its own copy of the table, as it can outlive this storage.
+        auto hash_storage = std::make_shared<VectorVfsFile>(std::vector<u8>(
+            m_hash_buffer, m_hash_buffer + static_cast<size_t>(hash_storage_size)));
+        m_verifier = std::make_shared<BlockHashVerifier>(m_base_storage, std::move(hash_storage),
+                                                         m_hash_target_block_size, false);
+    }
+
     R_SUCCEED();
 }
 
@@ -75,6 +93,11 @@ size_t HierarchicalSha256Storage::Read(u8* buffer, size_t size, size_t offset) c
     // Validate that we have a buffer to read into.
     ASSERT(buffer != nullptr);
 
+    // Refuse to read blocks that failed verification.
+    if (m_verifier != nullptr && !m_verifier->Request(offset, size)) {
+        return 0;
+    }
+
     // Read the data.
     return m_base_storage->Read(buffer, size, offset);
 }
@@ -7,6 +7,7 @@
 
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fs_i_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_hash_verifier.h"
 #include "core/file_sys/vfs/vfs.h"
 
 namespace FileSys {
@@ -33,6 +34,7 @@ public:
 
 private:
     VirtualFile m_base_storage;
+    std::shared_ptr<BlockHashVerifier> m_verifier;
     s64 m_base_storage_size;
     char* m_hash_buffer;
     size_t m_hash_buffer_size;
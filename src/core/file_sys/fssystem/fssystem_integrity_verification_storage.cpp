@@ -40,9 +40,16 @@ void IntegrityVerificationStorage::Initialize(VirtualFile hs, VirtualFile ds, s6
 
     // Set data.
     m_is_real_data = is_real_data;
+
+    // Verify the hashes in the background, if enabled.
+    if (BlockHashVerifier::IsEnabled()) {
+        m_verifier = std::make_shared<BlockHashVerifier>(m_data_storage, m_hash_storage,
+                                                         m_verification_block_size, true);
+    }
 }
 
 void IntegrityVerificationStorage::Finalize() {
+    m_verifier.reset();
     m_hash_storage = VirtualFile();
     m_data_storage = VirtualFile();
 }
@@ -80,6 +87,11 @@ size_t IntegrityVerificationStorage::Read(u8* buffer, size_t size, size_t offset
         read_size = static_cast<size_t>(data_size - offset);
     }
 
+    // Refuse to read blocks that failed verification.
+    if (m_verifier != nullptr && !m_verifier->Request(offset, read_size)) {
+        return 0;
+    }
+
     // Perform the read.
     return m_data_storage->Read(buffer, read_size, offset);
 }
@@ -7,6 +7,7 @@
 
 #include "core/file_sys/fssystem/fs_i_storage.h"
 #include "core/file_sys/fssystem/fs_types.h"
+#include "core/file_sys/fssystem/fssystem_block_hash_verifier.h"
 
 namespace FileSys {
 
@@ -55,6 +56,7 @@ private:
 private:
     VirtualFile m_hash_storage;
     VirtualFile m_data_storage;
+    std::shared_ptr<BlockHashVerifier> m_verifier;
     s64 m_verification_block_size;
     s64 m_verification_block_order;
     s64 m_upper_layer_verification_block_size;
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <mbedtls/sha256.h>
+
+#include "common/hex_util.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_counter_extended_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
@@ -12,6 +15,7 @@
 #include "core/file_sys/fssystem/fssystem_integrity_romfs_storage.h"
 #include "core/file_sys/fssystem/fssystem_memory_resource_buffer_hold_storage.h"
 #include "core/file_sys/fssystem/fssystem_nca_file_system_driver.h"
+#include "core/file_sys/fssystem/fssystem_section_cache_storage.h"
 #include "core/file_sys/fssystem/fssystem_sparse_storage.h"
 #include "core/file_sys/fssystem/fssystem_switch_storage.h"
 #include "core/file_sys/vfs/vfs_offset.h"
@@ -67,6 +71,23 @@ using Sha256DataRegion = NcaFsHeader::Region;
 using IntegrityLevelInfo = NcaFsHeader::HashData::IntegrityMetaInfo::LevelHashInfo;
 using IntegrityDataInfo = IntegrityLevelInfo::HierarchicalIntegrityVerificationLevelInformation;
 
+void AppendSectionCacheKey(std::vector<u8>& out, const NcaReader& reader, s32 fs_index) {
+    const auto append = [&out](const void* data, size_t size) {
+        const auto* bytes = static_cast<const u8*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    };
+
+    // Hashes are not verified, so the keys are part of the key to avoid caching garbage
+    // decrypted with wrong keys.
+    append(reader.GetFsHeaderHash(fs_index).value.data(), Hash::Size);
+    for (s32 i = 0; i < NcaHeader::DecryptionKey_Count; ++i) {
+        append(reader.GetDecryptionKey(i), NcaCryptoConfiguration::Aes128KeySize);
+    }
+    if (reader.HasExternalDecryptionKey()) {
+        append(reader.GetExternalDecryptionKey(), NcaCryptoConfiguration::Aes128KeySize);
+    }
+}
+
 } // namespace
 
 Result NcaFileSystemDriver::OpenStorageWithContext(VirtualFile* out,
@@ -286,7 +307,25 @@ Result NcaFileSystemDriver::OpenStorageImpl(VirtualFile* out, NcaFsHeaderReader*
     }
 
     // Create the non-raw storage.
-    R_RETURN(this->CreateStorageByRawStorage(out, out_header_reader, std::move(storage), ctx));
+    R_TRY(this->CreateStorageByRawStorage(out, out_header_reader, std::move(storage), ctx));
+
+    // Serve repeated reads of the section from the host cache, if enabled.
+    if (SectionCacheStorage::IsEnabled()) {
+        *out = SectionCacheStorage::Create(std::move(*out), this->GetSectionCacheKey(fs_index));
+    }
+    R_SUCCEED();
+}
+
+std::string NcaFileSystemDriver::GetSectionCacheKey(s32 fs_index) const {
+    std::vector<u8> key_data;
+    AppendSectionCacheKey(key_data, *m_reader, fs_index);
+    if (m_original_reader != nullptr && m_original_reader->HasFsInfo(fs_index)) {
+        AppendSectionCacheKey(key_data, *m_original_reader, fs_index);
+    }
+
+    std::array<u8, Hash::Size> digest;
+    mbedtls_sha256_ret(key_data.data(), key_data.size(), digest.data(), 0);
+    return Common::HexToString(std::span(digest).first<16>());
 }
 
 Result NcaFileSystemDriver::CreateStorageByRawStorage(VirtualFile* out,
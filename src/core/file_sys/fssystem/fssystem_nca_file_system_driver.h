@@ -274,6 +274,8 @@ private:
     Result OpenStorageImpl(VirtualFile* out, NcaFsHeaderReader* out_header_reader, s32 fs_index,
                            StorageContext* ctx);
 
+    std::string GetSectionCacheKey(s32 fs_index) const;
+
     Result OpenIndirectableStorageAsOriginal(VirtualFile* out,
                                              const NcaFsHeaderReader* header_reader,
                                              StorageContext* ctx);
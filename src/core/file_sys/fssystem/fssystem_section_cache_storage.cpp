@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/common_funcs.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/file_sys/fssystem/fssystem_section_cache_storage.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr u32 BitmapMagic = Common::MakeMagic('S', 'C', 'B', 'M');
+constexpr u32 BitmapVersion = 1;
+
+struct BitmapHeader {
+    u32 magic;
+    u32 version;
+    u64 size;
+    u64 block_size;
+};
+static_assert(std::is_trivially_copyable_v<BitmapHeader>);
+
+constexpr size_t BlocksPerWord = sizeof(u64) * 8;
+
+// Sections are shared by every opener, a second instance of the same section could truncate or
+// evict the cache file the first one reads from. Entries stay until the bitmap is saved.
+struct OpenSections {
+    std::mutex mutex;
+    std::condition_variable closed;
+    std::unordered_map<std::string, std::weak_ptr<SectionCacheStorage>> storages;
+};
+
+OpenSections& GetOpenSections() {
+    static OpenSections open_sections;
+    return open_sections;
+}
+
+std::vector<u64> LoadBitmap(const std::filesystem::path& path, size_t size, size_t num_words) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    BitmapHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header) || header.magic != BitmapMagic ||
+        header.version != BitmapVersion || header.size != size ||
+        header.block_size != SectionCacheStorage::BlockSize) {
+        return {};
+    }
+
+    std::vector<u64> bitmap(num_words);
+    if (file.ReadSpan(std::span<u64>(bitmap)) != num_words) {
+        return {};
+    }
+    return bitmap;
+}
+
+// Removes the least recently opened sections until the new one fits under the limit. Open sections
+// are never removed.
+void EnforceSizeLimit(const std::filesystem::path& dir, u64 new_size, u64 size_limit,
+                      const OpenSections& open_sections) {
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        u64 size;
+    };
+    std::vector<Entry> entries;
+    u64 total_size = 0;
+
+    std::error_code ec;
+    for (const auto& dir_entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (!dir_entry.is_regular_file(ec) || dir_entry.path().extension() != ".bin") {
+            continue;
+        }
+        const u64 file_size = dir_entry.file_size(ec);
+        entries.push_back({dir_entry.path(), dir_entry.last_write_time(ec), file_size});
+        total_size += file_size;
+    }
+    std::ranges::sort(entries, {}, &Entry::time);
+
+    for (const auto& entry : entries) {
+        if (total_size + new_size <= size_limit) {
+            break;
+        }
+        if (open_sections.storages.contains(entry.path.stem().string())) {
+            continue;
+        }
+        auto bitmap_path = entry.path;
+        bitmap_path.replace_extension(".map");
+        if (Common::FS::RemoveFile(entry.path)) {
+            Common::FS::RemoveFile(bitmap_path);
+            total_size -= entry.size;
+        }
+    }
+}
+
+} // namespace
+
+bool SectionCacheStorage::IsEnabled() {
+    return Settings::values.use_nca_section_cache.GetValue();
+}
+
+VirtualFile SectionCacheStorage::Create(VirtualFile base_storage, std::string_view key) {
+    const size_t size = base_storage->GetSize();
+    const u64 size_limit = u64{Settings::values.nca_section_cache_size.GetValue()} * 1_GiB;
+    if (size == 0 || size > size_limit) {
+        return base_storage;
+    }
+
+    // Creation is serialized, so only one instance of a section is ever opened.
+    OpenSections& open_sections = GetOpenSections();
+    std::unique_lock lk{open_sections.mutex};
+    const std::string key_string{key};
+    while (true) {
+        const auto it = open_sections.storages.find(key_string);
+        if (it == open_sections.storages.end()) {
+            break;
+        }
+        if (auto storage = it->second.lock()) {
+            return storage;
+        }
+        // The last instance is being destroyed, wait for its bitmap to be saved.
+        open_sections.closed.wait(lk);
+    }
+
+    const auto dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "nca";
+    const auto data_path = dir / fmt::format("{}.bin", key);
+    const auto bitmap_path = dir / fmt::format("{}.map", key);
+    if (!Common::FS::CreateDirs(dir)) {
+        return base_storage;
+    }
+
+    const size_t num_words = Common::DivideUp(Common::DivideUp(size, BlockSize), BlocksPerWord);
+    std::vector<u64> bitmap = LoadBitmap(bitmap_path, size, num_words);
+    if (bitmap.empty() || !Common::FS::Exists(data_path)) {
+        bitmap.assign(num_words, 0);
+        EnforceSizeLimit(dir, size, size_limit, open_sections);
+        if (!Common::FS::NewFile(data_path)) {
+            LOG_ERROR(Service_FS, "Failed to create section cache {}", data_path.string());
+            return base_storage;
+        }
+    } else {
+        // Mark the section as recently used.
+        std::error_code ec;
+        std::filesystem::last_write_time(data_path, std::filesystem::file_time_type::clock::now(),
+                                         ec);
+    }
+
+    Common::FS::IOFile data_file{data_path, Common::FS::FileAccessMode::ReadWrite,
+                                 Common::FS::FileType::BinaryFile};
+    if (!data_file.IsOpen()) {
+        return base_storage;
+    }
+    auto storage = std::make_shared<SectionCacheStorage>(
+        std::move(base_storage), std::move(data_file), key_string, bitmap_path, std::move(bitmap));
+    open_sections.storages.emplace(key_string, storage);
+    return storage;
+}
+
+SectionCacheStorage::SectionCacheStorage(VirtualFile base_storage, Common::FS::IOFile data_file,
+                                         std::string key, std::filesystem::path bitmap_path,
+                                         std::vector<u64> bitmap)
+    : m_base_storage(std::move(base_storage)), m_size(m_base_storage->GetSize()),
+      m_data_file(std::move(data_file)), m_key(std::move(key)),
+      m_bitmap_path(std::move(bitmap_path)), m_bitmap(std::move(bitmap)) {}
+
+SectionCacheStorage::~SectionCacheStorage() {
+    this->SaveBitmap();
+    m_data_file.Close();
+
+    OpenSections& open_sections = GetOpenSections();
+    {
+        std::scoped_lock lk{open_sections.mutex};
+        open_sections.storages.erase(m_key);
+    }
+    open_sections.closed.notify_all();
+}
+
+size_t SectionCacheStorage::GetSize() const {
+    return m_size;
+}
+
+size_t SectionCacheStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    if (offset >= m_size) {
+        return 0;
+    }
+    size = std::min(size, m_size - offset);
+
+    const size_t end_block = Common::DivideUp(offset + size, BlockSize);
+    size_t block = offset / BlockSize;
+    while (block < end_block) {
+        // Find the run of blocks that are all cached or all missing.
+        bool cached;
+        size_t run_end;
+        {
+            std::scoped_lock lk{m_mutex};
+            cached = this->IsCached(block);
+            for (run_end = block + 1; run_end < end_block; ++run_end) {
+                if (this->IsCached(run_end) != cached) {
+                    break;
+                }
+            }
+        }
+
+        const size_t run_offset = block * BlockSize;
+        const size_t run_size = std::min(run_end * BlockSize, m_size) - run_offset;
+        const size_t cur_offset = std::max(offset, run_offset);
+        const size_t cur_size = std::min(offset + size, run_offset + run_size) - cur_offset;
+        u8* const cur_buffer = buffer + (cur_offset - offset);
+
+        if (cached && this->ReadCached(cur_buffer, cur_size, cur_offset)) {
+            block = run_end;
+            continue;
+        }
+        if (!this->ReadBase(cur_buffer, cur_size, cur_offset, run_offset, run_size)) {
+            return cur_offset - offset;
+        }
+        block = run_end;
+    }
+    return size;
+}
+
+bool SectionCacheStorage::IsCached(size_t block) const {
+    return (m_bitmap[block / BlocksPerWord] >> (block % BlocksPerWord)) & 1;
+}
+
+void SectionCacheStorage::SetCached(size_t first_block, size_t end_block, bool cached) const {
+    for (size_t block = first_block; block < end_block; ++block) {
+        const u64 mask = u64{1} << (block % BlocksPerWord);
+        if (cached) {
+            m_bitmap[block / BlocksPerWord] |= mask;
+        } else {
+            m_bitmap[block / BlocksPerWord] &= ~mask;
+        }
+    }
+    m_bitmap_dirty = true;
+}
+
+bool SectionCacheStorage::ReadCached(u8* buffer, size_t size, size_t offset) const {
+    std::scoped_lock lk{m_mutex};
+    if (m_data_file.Seek(static_cast<s64>(offset)) &&
+        m_data_file.ReadSpan(std::span<u8>(buffer, size)) == size) {
+        return true;
+    }
+
+    // The cache file was truncated or removed behind our back, refill these blocks.
+    this->SetCached(offset / BlockSize, Common::DivideUp(offset + size, BlockSize), false);
+    return false;
+}
+
+bool SectionCacheStorage::ReadBase(u8* buffer, size_t size, size_t offset, size_t run_offset,
+                                   size_t run_size) const {
+    // Read whole blocks from the base storage, so that they can be cached.
+    std::vector<u8> run_buffer;
+    u8* run_data = buffer;
+    if (offset != run_offset || size != run_size) {
+        run_buffer.resize(run_size);
+        run_data = run_buffer.data();
+    }
+    if (m_base_storage->Read(run_data, run_size, run_offset) != run_size) {
+        return m_base_storage->Read(buffer, size, offset) == size;
+    }
+    if (run_data != buffer) {
+        std::memcpy(buffer, run_data + (offset - run_offset), size);
+    }
+
+    std::scoped_lock lk{m_mutex};
+    if (m_data_file.Seek(static_cast<s64>(run_offset)) &&
+        m_data_file.WriteSpan(std::span<const u8>(run_data, run_size)) == run_size) {
+        this->SetCached(run_offset / BlockSize, Common::DivideUp(run_offset + run_size, BlockSize),
+                        true);
+    }
+    return true;
+}
+
+void SectionCacheStorage::SaveBitmap() const {
+    std::scoped_lock lk{m_mutex};
+    if (!m_bitmap_dirty) {
+        return;
+    }
+
+    // The data must reach the disk before the bitmap claims it is there.
+    if (!m_data_file.Flush()) {
+        return;
+    }
+
+    Common::FS::IOFile file{m_bitmap_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    const BitmapHeader header{
+        .magic = BitmapMagic,
+        .version = BitmapVersion,
+        .size = m_size,
+        .block_size = BlockSize,
+    };
+    if (!file.IsOpen() || !file.WriteObject(header) ||
+        file.WriteSpan(std::span<const u64>(m_bitmap)) != m_bitmap.size()) {
+        LOG_ERROR(Service_FS, "Failed to write section cache bitmap {}", m_bitmap_path.string());
+        return;
+    }
+    m_bitmap_dirty = false;
+}
+
+} // namespace FileSys
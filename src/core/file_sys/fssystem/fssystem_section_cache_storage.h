@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/fs/file.h"
+#include "common/literals.h"
+#include "core/file_sys/fssystem/fs_i_storage.h"
+
+namespace FileSys {
+
+using namespace Common::Literals;
+
+// Read-through cache of a decrypted NCA section, held on the host in the cache directory.
+//
+// The section is mirrored into a plain file at the same offsets, filled a block at a time as it
+// is read. A bitmap of the blocks present is saved next to it when the storage is destroyed. The
+// cache directory is kept under the configured size by removing the least recently opened
+// sections.
+class SectionCacheStorage : public IReadOnlyStorage {
+    YUZU_NON_COPYABLE(SectionCacheStorage);
+    YUZU_NON_MOVEABLE(SectionCacheStorage);
+
+public:
+    static constexpr size_t BlockSize = 64_KiB;
+
+public:
+    static bool IsEnabled();
+
+    // Returns the base storage wrapped in a cache stored under the given key, or the base storage
+    // itself if the cache cannot be used. Every opener of a key shares the same instance.
+    static VirtualFile Create(VirtualFile base_storage, std::string_view key);
+
+    SectionCacheStorage(VirtualFile base_storage, Common::FS::IOFile data_file, std::string key,
+                        std::filesystem::path bitmap_path, std::vector<u64> bitmap);
+    virtual ~SectionCacheStorage();
+
+    virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
+    virtual size_t GetSize() const override;
+
+private:
+    bool IsCached(size_t block) const;
+    void SetCached(size_t first_block, size_t end_block, bool cached) const;
+    bool ReadCached(u8* buffer, size_t size, size_t offset) const;
+    bool ReadBase(u8* buffer, size_t size, size_t offset, size_t run_offset,
+                  size_t run_size) const;
+    void SaveBitmap() const;
+
+private:
+    VirtualFile m_base_storage;
+    size_t m_size;
+    Common::FS::IOFile m_data_file;
+    std::string m_key;
+    std::filesystem::path m_bitmap_path;
+    mutable std::vector<u64> m_bitmap;
+    mutable bool m_bitmap_dirty{};
+    mutable std::mutex m_mutex;
+};
+
+} // namespace FileSys
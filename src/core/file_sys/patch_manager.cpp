@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstring>
 
+#include "common/boot_profiler.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
@@ -17,11 +18,14 @@
 #include "core/file_sys/common_funcs.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs.h"
+#include "core/file_sys/romfs_layout_cache.h"
 #include "core/file_sys/vfs/vfs_cached.h"
+#include "core/file_sys/vfs/vfs_concat.h"
 #include "core/file_sys/vfs/vfs_layered.h"
 #include "core/file_sys/vfs/vfs_vector.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -128,6 +132,7 @@ u64 PatchManager::GetTitleID() const {
 }
 
 VirtualDir PatchManager::PatchExeFS(VirtualDir exefs) const {
+    BOOT_PHASE("PatchManager::PatchExeFS");
     LOG_INFO(Loader, "Patching ExeFS for title_id={:016X}", title_id);
 
     if (exefs == nullptr)
@@ -228,6 +233,7 @@ std::vector<VirtualFile> PatchManager::CollectPatches(const std::vector<VirtualD
 }
 
 std::vector<u8> PatchManager::PatchNSO(const std::vector<u8>& nso, const std::string& name) const {
+    BOOT_PHASE("PatchManager::PatchNSO");
     if (nso.size() < sizeof(Loader::NSOHeader)) {
         return nso;
     }
@@ -377,16 +383,16 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
         auto romfs_dir = FindSubdirectoryCaseless(subdir, "romfs");
         if (romfs_dir != nullptr)
-            layers.emplace_back(std::make_shared<CachedVfsDirectory>(std::move(romfs_dir)));
+            layers.emplace_back(std::move(romfs_dir));
 
         auto ext_dir = FindSubdirectoryCaseless(subdir, "romfs_ext");
         if (ext_dir != nullptr)
-            layers_ext.emplace_back(std::make_shared<CachedVfsDirectory>(std::move(ext_dir)));
+            layers_ext.emplace_back(std::move(ext_dir));
 
         if (type == ContentRecordType::HtmlDocument) {
             auto manual_dir = FindSubdirectoryCaseless(subdir, "manual_html");
             if (manual_dir != nullptr)
-                layers.emplace_back(std::make_shared<CachedVfsDirectory>(std::move(manual_dir)));
+                layers.emplace_back(std::move(manual_dir));
         }
     }
 
@@ -395,12 +401,28 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         return;
     }
 
+    std::vector<VirtualDir> all_layers{layers};
+    all_layers.insert(all_layers.end(), layers_ext.begin(), layers_ext.end());
+    const RomFSLayoutCache layout_cache{title_id, type, romfs, std::move(all_layers)};
+    if (auto cached = layout_cache.Load()) {
+        LOG_INFO(Loader, "    RomFS: LayeredFS patches applied from cache");
+        romfs = std::move(cached);
+        return;
+    }
+
+    for (auto& layer : layers) {
+        layer = std::make_shared<CachedVfsDirectory>(std::move(layer));
+    }
+    for (auto& layer : layers_ext) {
+        layer = std::make_shared<CachedVfsDirectory>(std::move(layer));
+    }
+
     auto extracted = ExtractRomFS(romfs);
     if (extracted == nullptr) {
         return;
     }
 
-    layers.emplace_back(std::move(extracted));
+    layers.emplace_back(extracted);
 
     auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
     if (layered == nullptr) {
@@ -409,7 +431,12 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
 
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    RomFSBuildContext ctx{layered, std::move(layered_ext)};
+    auto layout = ctx.Build();
+    layout_cache.Save(layout, layered->GetName(), extracted);
+
+    auto packed =
+        ConcatenatedVfsFile::MakeConcatenatedFile(0, layered->GetName(), std::move(layout));
     if (packed == nullptr) {
         return;
     }
@@ -421,6 +448,7 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 VirtualFile PatchManager::PatchRomFS(const NCA* base_nca, VirtualFile base_romfs,
                                      ContentRecordType type, VirtualFile packed_update_raw,
                                      bool apply_layeredfs) const {
+    BOOT_PHASE("PatchManager::PatchRomFS");
     const auto log_string = fmt::format("Patching RomFS for title_id={:016X}, type={:02X}",
                                         title_id, static_cast<u8>(type));
     if (type == ContentRecordType::Program || type == ContentRecordType::Data) {
@@ -623,6 +651,7 @@ std::optional<u32> PatchManager::GetGameVersion() const {
 }
 
 PatchManager::Metadata PatchManager::GetControlMetadata() const {
+    BOOT_PHASE("PatchManager::GetControlMetadata");
     const auto base_control_nca = content_provider.GetEntry(title_id, ContentRecordType::Control);
     if (base_control_nca == nullptr) {
         return {};
@@ -0,0 +1,353 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <mbedtls/sha256.h>
+
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/fs_util.h"
+#include "common/fs/path_util.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "core/file_sys/nca_metadata.h"
+#include "core/file_sys/romfs_layout_cache.h"
+#include "core/file_sys/vfs/vfs_concat.h"
+#include "core/file_sys/vfs/vfs_offset.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+
+using namespace Common::Literals;
+
+constexpr u32 CacheMagic = Common::MakeMagic('Y', 'R', 'L', 'C');
+constexpr u32 CacheVersion = 1;
+
+// Layouts that would store more than this much data in the cache are rebuilt every time instead.
+constexpr size_t MaxStoredDataSize = 64_MiB;
+
+// Tables larger than this are not read to identify the base RomFS.
+constexpr u64 MaxTablesSize = 256_MiB;
+
+enum class SourceKind : u8 {
+    BaseRomFS,
+    LayerFile,
+    Stored,
+};
+
+struct RomFSHeader {
+    u64 header_size;
+    u64 dir_hash_table_ofs;
+    u64 dir_hash_table_size;
+    u64 dir_table_ofs;
+    u64 dir_table_size;
+    u64 file_hash_table_ofs;
+    u64 file_hash_table_size;
+    u64 file_table_ofs;
+    u64 file_table_size;
+    u64 file_partition_ofs;
+};
+static_assert(sizeof(RomFSHeader) == 0x50, "RomFSHeader has incorrect size.");
+
+class Writer {
+public:
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* const bytes = reinterpret_cast<const u8*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteBytes(const void* bytes, size_t size) {
+        Write(static_cast<u64>(size));
+        const auto* const begin = static_cast<const u8*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    }
+
+    std::vector<u8> data;
+};
+
+class Reader {
+public:
+    explicit Reader(const std::vector<u8>& data_) : data{data_} {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename Container>
+    bool ReadBytes(Container& out) {
+        u64 size{};
+        if (!Read(size) || data.size() - offset < size) {
+            return false;
+        }
+        const auto* const begin = data.data() + offset;
+        out.assign(begin, begin + size);
+        offset += size;
+        return true;
+    }
+
+private:
+    const std::vector<u8>& data;
+    size_t offset{};
+};
+
+std::filesystem::path GetCachePath(u64 title_id, ContentRecordType type) {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "romfs" /
+           fmt::format("{:016X}_{:02X}.bin", title_id, static_cast<u8>(type));
+}
+
+void MapBaseFiles(const VirtualDir& dir, std::unordered_map<const VfsFile*, u64>& out) {
+    for (const auto& file : dir->GetFiles()) {
+        if (const auto* const offset_file = dynamic_cast<const OffsetVfsFile*>(file.get())) {
+            out.emplace(file.get(), offset_file->GetOffset());
+        }
+    }
+    for (const auto& subdir : dir->GetSubdirectories()) {
+        MapBaseFiles(subdir, out);
+    }
+}
+
+} // Anonymous namespace
+
+RomFSLayoutCache::RomFSLayoutCache(u64 title_id, ContentRecordType type, VirtualFile base_romfs,
+                                   std::vector<VirtualDir> layers)
+    : m_title_id{title_id}, m_type{type}, m_base_romfs{std::move(base_romfs)},
+      m_layers{std::move(layers)} {
+    ComputeKey();
+}
+
+RomFSLayoutCache::~RomFSLayoutCache() = default;
+
+void RomFSLayoutCache::ComputeKey() {
+    Writer writer;
+    writer.Write(m_title_id);
+    writer.Write(m_type);
+
+    // The base RomFS is identified by its tables, which hold the offset and size of every file.
+    RomFSHeader header{};
+    if (m_base_romfs == nullptr || m_base_romfs->ReadObject(&header) != sizeof(RomFSHeader) ||
+        header.header_size != sizeof(RomFSHeader)) {
+        return;
+    }
+    const u64 tables_begin = header.dir_hash_table_ofs;
+    const u64 tables_end =
+        std::max({header.dir_hash_table_ofs + header.dir_hash_table_size,
+                  header.dir_table_ofs + header.dir_table_size,
+                  header.file_hash_table_ofs + header.file_hash_table_size,
+                  header.file_table_ofs + header.file_table_size});
+    if (tables_end < tables_begin || tables_end - tables_begin > MaxTablesSize) {
+        return;
+    }
+    const auto tables = m_base_romfs->ReadBytes(tables_end - tables_begin, tables_begin);
+    writer.Write(static_cast<u64>(m_base_romfs->GetSize()));
+    writer.Write(header);
+    writer.WriteBytes(tables.data(), tables.size());
+
+    // The layers are identified by the paths, sizes and modification times of their entries.
+    for (const auto& layer : m_layers) {
+        const std::filesystem::path root = Common::FS::ToU8String(layer->GetFullPath());
+        if (!Common::FS::IsDir(root)) {
+            return;
+        }
+
+        std::vector<std::tuple<std::string, u64, s64>> entries;
+        Common::FS::IterateDirEntriesRecursively(
+            root, [&](const std::filesystem::directory_entry& entry) {
+                std::error_code ec;
+                const u64 size = entry.is_directory(ec) ? 0 : entry.file_size(ec);
+                const auto time = entry.last_write_time(ec);
+                entries.emplace_back(
+                    Common::FS::PathToUTF8String(entry.path().lexically_relative(root)), size,
+                    static_cast<s64>(time.time_since_epoch().count()));
+                return true;
+            });
+        std::sort(entries.begin(), entries.end());
+
+        const auto root_path = Common::FS::PathToUTF8String(root);
+        writer.WriteBytes(root_path.data(), root_path.size());
+        writer.Write(static_cast<u64>(entries.size()));
+        for (const auto& [path, size, time] : entries) {
+            writer.WriteBytes(path.data(), path.size());
+            writer.Write(size);
+            writer.Write(time);
+        }
+    }
+
+    mbedtls_sha256_ret(writer.data.data(), writer.data.size(), m_key.data(), 0);
+    m_is_cacheable = true;
+}
+
+VirtualFile RomFSLayoutCache::Load() const {
+    if (!m_is_cacheable) {
+        return nullptr;
+    }
+
+    const auto path = GetCachePath(m_title_id, m_type);
+    if (!Common::FS::Exists(path)) {
+        return nullptr;
+    }
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    std::vector<u8> data(file.IsOpen() ? file.GetSize() : 0);
+    if (file.ReadSpan(std::span<u8>(data)) != data.size()) {
+        return nullptr;
+    }
+
+    Reader reader{data};
+    u32 magic{};
+    u32 version{};
+    std::array<u8, 0x20> key{};
+    std::string name;
+    u64 num_entries{};
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(key) ||
+        !reader.ReadBytes(name) || !reader.Read(num_entries) || magic != CacheMagic ||
+        version != CacheVersion || key != m_key) {
+        return nullptr;
+    }
+
+    std::vector<std::pair<u64, VirtualFile>> layout;
+    for (u64 i = 0; i < num_entries; ++i) {
+        u64 offset{};
+        SourceKind kind{};
+        if (!reader.Read(offset) || !reader.Read(kind)) {
+            return nullptr;
+        }
+
+        switch (kind) {
+        case SourceKind::BaseRomFS: {
+            u64 base_offset{};
+            u64 size{};
+            if (!reader.Read(base_offset) || !reader.Read(size)) {
+                return nullptr;
+            }
+            layout.emplace_back(offset,
+                                std::make_shared<OffsetVfsFile>(m_base_romfs, size, base_offset));
+            break;
+        }
+        case SourceKind::LayerFile: {
+            u32 layer{};
+            std::string relative_path;
+            u64 size{};
+            if (!reader.Read(layer) || !reader.ReadBytes(relative_path) || !reader.Read(size) ||
+                layer >= m_layers.size()) {
+                return nullptr;
+            }
+            auto layer_file = m_layers[layer]->GetFileRelative(relative_path);
+            if (layer_file == nullptr || layer_file->GetSize() != size) {
+                return nullptr;
+            }
+            layout.emplace_back(offset, std::move(layer_file));
+            break;
+        }
+        case SourceKind::Stored: {
+            std::vector<u8> stored;
+            if (!reader.ReadBytes(stored)) {
+                return nullptr;
+            }
+            layout.emplace_back(offset, std::make_shared<VectorVfsFile>(std::move(stored)));
+            break;
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, std::move(name), std::move(layout));
+}
+
+void RomFSLayoutCache::Save(const std::vector<std::pair<u64, VirtualFile>>& layout,
+                            std::string_view name, const VirtualDir& extracted_base) const {
+    if (!m_is_cacheable) {
+        return;
+    }
+
+    std::unordered_map<const VfsFile*, u64> base_offsets;
+    MapBaseFiles(extracted_base, base_offsets);
+
+    std::vector<std::string> layer_paths;
+    layer_paths.reserve(m_layers.size());
+    for (const auto& layer : m_layers) {
+        layer_paths.push_back(layer->GetFullPath());
+    }
+
+    Writer writer;
+    writer.Write(CacheMagic);
+    writer.Write(CacheVersion);
+    writer.Write(m_key);
+    writer.WriteBytes(name.data(), name.size());
+    writer.Write(static_cast<u64>(layout.size()));
+
+    size_t stored_size = 0;
+    for (const auto& [offset, file] : layout) {
+        writer.Write(offset);
+
+        if (const auto it = base_offsets.find(file.get()); it != base_offsets.end()) {
+            writer.Write(SourceKind::BaseRomFS);
+            writer.Write(it->second);
+            writer.Write(static_cast<u64>(file->GetSize()));
+            continue;
+        }
+
+        const auto file_path = file->GetFullPath();
+        const auto layer_it =
+            std::find_if(layer_paths.begin(), layer_paths.end(), [&](const std::string& prefix) {
+                return file_path.size() > prefix.size() && file_path.starts_with(prefix) &&
+                       Common::FS::IsDirSeparator(file_path[prefix.size()]);
+            });
+        if (layer_it != layer_paths.end()) {
+            const auto relative_path = file_path.substr(layer_it->size() + 1);
+            writer.Write(SourceKind::LayerFile);
+            writer.Write(static_cast<u32>(std::distance(layer_paths.begin(), layer_it)));
+            writer.WriteBytes(relative_path.data(), relative_path.size());
+            writer.Write(static_cast<u64>(file->GetSize()));
+            continue;
+        }
+
+        // Anything else, like the tables and patched files, is only held in memory.
+        const auto stored = file->ReadAllBytes();
+        stored_size += stored.size();
+        if (stored_size > MaxStoredDataSize) {
+            LOG_DEBUG(Loader, "Not caching RomFS layout for title_id={:016X}, too much data",
+                      m_title_id);
+            return;
+        }
+        writer.Write(SourceKind::Stored);
+        writer.WriteBytes(stored.data(), stored.size());
+    }
+
+    const auto path = GetCachePath(m_title_id, m_type);
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Loader, "Failed to create the RomFS cache directory");
+        return;
+    }
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen() ||
+        file.WriteSpan(std::span<const u8>(writer.data)) != writer.data.size()) {
+        LOG_ERROR(Loader, "Failed to write the RomFS layout cache for title_id={:016X}",
+                  m_title_id);
+    }
+}
+
+} // namespace FileSys
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+enum class ContentRecordType : u8;
+
+// Caches the layout of a RomFS built from mod layers over a base RomFS, so that it can be
+// reassembled without walking and rebuilding the layers when neither the base RomFS nor any file
+// in the layers changed.
+//
+// The cached layout records where each file of the built RomFS comes from: a range of the base
+// RomFS, a file in one of the layers, or data stored in the cache itself, such as the rebuilt
+// tables and IPS-patched files.
+class RomFSLayoutCache {
+public:
+    // The layers must be host directories, they are identified by the paths, sizes and
+    // modification times of the files they contain.
+    RomFSLayoutCache(u64 title_id, ContentRecordType type, VirtualFile base_romfs,
+                     std::vector<VirtualDir> layers);
+    ~RomFSLayoutCache();
+
+    // Returns the cached RomFS, or nullptr if it is missing or out of date.
+    VirtualFile Load() const;
+
+    // Stores the layout of a RomFS built from the layers. The extracted base directory is the one
+    // the base RomFS files in the layout were taken from.
+    void Save(const std::vector<std::pair<u64, VirtualFile>>& layout, std::string_view name,
+              const VirtualDir& extracted_base) const;
+
+private:
+    void ComputeKey();
+
+    u64 m_title_id;
+    ContentRecordType m_type;
+    VirtualFile m_base_romfs;
+    std::vector<VirtualDir> m_layers;
+    std::array<u8, 0x20> m_key{};
+    bool m_is_cacheable{};
+};
+
+} // namespace FileSys
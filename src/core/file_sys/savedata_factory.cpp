@@ -5,15 +5,20 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "common/uuid.h"
 #include "core/core.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
 
 namespace FileSys {
 
 namespace {
 
+// Buffered save data writes are committed at least this often.
+constexpr std::chrono::seconds SaveDataCommitInterval{5};
+
 bool ShouldSaveDataBeAutomaticallyCreated(SaveDataSpaceId space, const SaveDataAttribute& attr) {
     return attr.type == SaveDataType::Cache || attr.type == SaveDataType::Temporary ||
            (space == SaveDataSpaceId::User && ///< Normal Save Data -- Current Title & User
@@ -78,10 +83,10 @@ VirtualDir SaveDataFactory::Open(SaveDataSpaceId space, const SaveDataAttribute&
     auto out = dir->GetDirectoryRelative(save_directory);
 
     if (out == nullptr && (ShouldSaveDataBeAutomaticallyCreated(space, meta) && auto_create)) {
-        return Create(space, meta);
+        out = Create(space, meta);
     }
 
-    return out;
+    return WrapWriteBack(save_directory, std::move(out));
 }
 
 VirtualDir SaveDataFactory::GetSaveDataSpaceDirectory(SaveDataSpaceId space) const {
@@ -187,6 +192,24 @@ void SaveDataFactory::WriteSaveDataSize(SaveDataType type, u64 title_id, u128 us
     size_file->WriteObject(new_value);
 }
 
+VirtualDir SaveDataFactory::WrapWriteBack(const std::string& save_directory,
+                                          VirtualDir save_data) const {
+    if (save_data == nullptr || !Settings::values.use_save_data_write_back.GetValue()) {
+        return save_data;
+    }
+
+    std::scoped_lock lk{write_back_mutex};
+    std::erase_if(write_back_caches, [](const auto& it) { return it.second.expired(); });
+
+    auto& weak_cache = write_back_caches[save_directory];
+    auto cache = weak_cache.lock();
+    if (cache == nullptr) {
+        cache = std::make_shared<WriteBackCache>(SaveDataCommitInterval);
+        weak_cache = cache;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(save_data), std::move(cache));
+}
+
 void SaveDataFactory::SetAutoCreate(bool state) {
     auto_create = state;
 }
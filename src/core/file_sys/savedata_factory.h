@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -17,6 +19,8 @@ class System;
 
 namespace FileSys {
 
+class WriteBackCache;
+
 constexpr const char* GetSaveDataSizeFileName() {
     return ".yuzu_save_size";
 }
@@ -47,10 +51,17 @@ public:
     void SetAutoCreate(bool state);
 
 private:
+    /// Wraps an opened save data directory so that its writes are buffered until committed.
+    VirtualDir WrapWriteBack(const std::string& save_directory, VirtualDir save_data) const;
+
     Core::System& system;
     ProgramId program_id;
     VirtualDir dir;
     bool auto_create{true};
+
+    // Shared by every open handle to the same save data, so they all see the pending writes.
+    mutable std::mutex write_back_mutex;
+    mutable std::map<std::string, std::weak_ptr<WriteBackCache>> write_back_caches;
 };
 
 } // namespace FileSys
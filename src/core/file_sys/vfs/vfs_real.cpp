@@ -3,13 +3,17 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <utility>
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/file_sys/vfs/vfs.h"
 #include "core/file_sys/vfs/vfs_real.h"
 
@@ -30,8 +34,16 @@ namespace FS = Common::FS;
 
 namespace {
 
+using namespace Common::Literals;
+
 constexpr size_t MaxOpenFiles = 512;
 
+// Read-only files at least this large are memory mapped, if enabled.
+constexpr u64 MinMappedFileSize = 16_MiB;
+
+// Reads at least this large ask the host to read the whole range ahead of the copy.
+constexpr size_t MappedPrefetchSize = 256_KiB;
+
 constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(OpenMode mode) {
     switch (mode) {
     case OpenMode::Read:
@@ -271,12 +283,37 @@ RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::unique_ptr<FileReference
                          const std::string& path_, OpenMode perms_, std::optional<u64> size_)
     : base(base_), reference(std::move(reference_)), path(path_),
       parent_path(FS::GetParentPath(path_)), path_components(FS::SplitPathComponentsCopy(path_)),
-      size(size_), perms(perms_) {}
+      size(size_), perms(perms_) {
+    this->MapIfLarge();
+}
 
 RealVfsFile::~RealVfsFile() {
     base.DropReference(std::move(reference));
 }
 
+void RealVfsFile::MapIfLarge() {
+    if (perms != OpenMode::Read || !Settings::values.use_mapped_file_reads.GetValue()) {
+        return;
+    }
+#ifdef ANDROID
+    // Content URIs can't be mapped by path.
+    if (path[0] != '/') {
+        return;
+    }
+#endif
+    if (size.value_or(FS::GetSize(path)) < MinMappedFileSize) {
+        return;
+    }
+
+    // Reads of mapped files are copies from the mapping, without taking the reference lock.
+    auto mapped_file = std::make_unique<FS::MappedFile>(path);
+    if (!mapped_file->IsOpen()) {
+        return;
+    }
+    size = mapped_file->Data().size();
+    mapping = std::move(mapped_file);
+}
+
 std::string RealVfsFile::GetName() const {
 #ifdef ANDROID
     if (path[0] != '/') {
@@ -295,6 +332,7 @@ std::size_t RealVfsFile::GetSize() const {
 }
 
 bool RealVfsFile::Resize(std::size_t new_size) {
+    mapping.reset();
     size.reset();
     auto lk = base.RefreshReference(path, perms, *reference);
     return reference->file ? reference->file->SetSize(new_size) : false;
@@ -313,6 +351,19 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (mapping) {
+        const auto mapped = mapping->Data();
+        if (offset >= mapped.size()) {
+            return 0;
+        }
+        const std::size_t read_size = std::min(length, mapped.size() - offset);
+        if (read_size >= MappedPrefetchSize) {
+            mapping->Prefetch(offset, read_size);
+        }
+        std::memcpy(data, mapped.data() + offset, read_size);
+        return read_size;
+    }
+
     auto lk = base.RefreshReference(path, perms, *reference);
     if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
         return 0;
@@ -321,6 +372,7 @@ std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset)
 }
 
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    mapping.reset();
     size.reset();
     auto lk = base.RefreshReference(path, perms, *reference);
     if (!reference->file || !reference->file->Seek(static_cast<s64>(offset))) {
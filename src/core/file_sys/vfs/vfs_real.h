@@ -13,6 +13,7 @@
 
 namespace Common::FS {
 class IOFile;
+class MappedFile;
 }
 
 namespace FileSys {
@@ -93,8 +94,11 @@ private:
                 const std::string& path, OpenMode perms = OpenMode::Read,
                 std::optional<u64> size = {});
 
+    void MapIfLarge();
+
     RealVfsFilesystem& base;
     std::unique_ptr<FileReference> reference;
+    std::unique_ptr<Common::FS::MappedFile> mapping;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
@@ -0,0 +1,393 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
+
+namespace FileSys {
+
+namespace {
+
+using namespace Common::Literals;
+
+// Pending writes past this size are committed without waiting for the commit interval.
+constexpr std::size_t MaxPendingSize = 32_MiB;
+
+} // Anonymous namespace
+
+WriteBackCache::WriteBackCache(std::chrono::milliseconds commit_interval)
+    : m_commit_interval{commit_interval}, m_thread{&WriteBackCache::CommitThread, this} {}
+
+WriteBackCache::~WriteBackCache() {
+    {
+        std::scoped_lock lk{m_mutex};
+        m_stop_requested = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+
+    Commit();
+}
+
+std::size_t WriteBackCache::GetSize(const VirtualFile& file) const {
+    std::scoped_lock lk{m_mutex};
+    const auto it = m_pending_files.find(file->GetFullPath());
+    if (it == m_pending_files.end()) {
+        return file->GetSize();
+    }
+    return it->second.size;
+}
+
+bool WriteBackCache::Resize(const VirtualFile& file, std::size_t new_size) {
+    std::scoped_lock lk{m_mutex};
+    PendingFile& pending = GetPendingFileLocked(file);
+
+    if (new_size < pending.size) {
+        pending.base_size = std::min(pending.base_size, new_size);
+
+        auto it = pending.extents.lower_bound(new_size);
+        while (it != pending.extents.end()) {
+            m_pending_size -= it->second.size();
+            it = pending.extents.erase(it);
+        }
+        if (it != pending.extents.begin()) {
+            auto& [extent_offset, extent] = *std::prev(it);
+            if (extent_offset + extent.size() > new_size) {
+                m_pending_size -= extent_offset + extent.size() - new_size;
+                extent.resize(new_size - extent_offset);
+            }
+        }
+    }
+
+    pending.size = new_size;
+    return true;
+}
+
+std::size_t WriteBackCache::Read(const VirtualFile& file, u8* data, std::size_t length,
+                                 std::size_t offset) const {
+    std::scoped_lock lk{m_mutex};
+    const auto pending_it = m_pending_files.find(file->GetFullPath());
+    if (pending_it == m_pending_files.end()) {
+        return file->Read(data, length, offset);
+    }
+
+    const PendingFile& pending = pending_it->second;
+    if (offset >= pending.size) {
+        return 0;
+    }
+    length = std::min(length, pending.size - offset);
+    const std::size_t end = offset + length;
+
+    // Read what is left of the backing file, and zero-fill past its end.
+    std::size_t base_read = 0;
+    if (offset < pending.base_size) {
+        base_read = file->Read(data, std::min(end, pending.base_size) - offset, offset);
+    }
+    std::memset(data + base_read, 0, length - base_read);
+
+    // Overlay the pending writes.
+    auto it = pending.extents.upper_bound(offset);
+    if (it != pending.extents.begin()) {
+        --it;
+    }
+    for (; it != pending.extents.end() && it->first < end; ++it) {
+        const auto& [extent_offset, extent] = *it;
+        const std::size_t copy_begin = std::max(offset, extent_offset);
+        const std::size_t copy_end = std::min(end, extent_offset + extent.size());
+        if (copy_begin < copy_end) {
+            std::memcpy(data + (copy_begin - offset), extent.data() + (copy_begin - extent_offset),
+                        copy_end - copy_begin);
+        }
+    }
+
+    return length;
+}
+
+std::size_t WriteBackCache::Write(const VirtualFile& file, const u8* data, std::size_t length,
+                                  std::size_t offset) {
+    if (length == 0) {
+        return 0;
+    }
+
+    std::unique_lock lk{m_mutex};
+    PendingFile& pending = GetPendingFileLocked(file);
+    const std::size_t end = offset + length;
+
+    // Find the extents that overlap or touch the written range, and merge them into one.
+    auto first = pending.extents.upper_bound(offset);
+    if (first != pending.extents.begin()) {
+        const auto prev = std::prev(first);
+        if (prev->first + prev->second.size() >= offset) {
+            first = prev;
+        }
+    }
+    auto last = first;
+    std::size_t merged_offset = offset;
+    std::size_t merged_end = end;
+    for (; last != pending.extents.end() && last->first <= end; ++last) {
+        merged_offset = std::min(merged_offset, last->first);
+        merged_end = std::max(merged_end, last->first + last->second.size());
+    }
+
+    std::vector<u8> merged(merged_end - merged_offset);
+    for (auto it = first; it != last; ++it) {
+        std::memcpy(merged.data() + (it->first - merged_offset), it->second.data(),
+                    it->second.size());
+        m_pending_size -= it->second.size();
+    }
+    std::memcpy(merged.data() + (offset - merged_offset), data, length);
+    m_pending_size += merged.size();
+
+    pending.extents.erase(first, last);
+    pending.extents.emplace(merged_offset, std::move(merged));
+    pending.size = std::max(pending.size, end);
+
+    if (m_pending_size >= MaxPendingSize) {
+        m_commit_requested = true;
+        lk.unlock();
+        m_cv.notify_one();
+    }
+    return length;
+}
+
+void WriteBackCache::RequestCommit() {
+    {
+        std::scoped_lock lk{m_mutex};
+        m_commit_requested = true;
+    }
+    m_cv.notify_one();
+}
+
+void WriteBackCache::Commit() {
+    std::scoped_lock lk{m_mutex};
+    CommitLocked();
+}
+
+WriteBackCache::PendingFile& WriteBackCache::GetPendingFileLocked(const VirtualFile& file) {
+    auto path = file->GetFullPath();
+    const auto it = m_pending_files.find(path);
+    if (it != m_pending_files.end()) {
+        return it->second;
+    }
+
+    const std::size_t size = file->GetSize();
+    const bool was_empty = m_pending_files.empty();
+    auto& pending = m_pending_files
+                        .emplace(std::move(path), PendingFile{
+                                                      .file = file,
+                                                      .size = size,
+                                                      .base_size = size,
+                                                      .extents = {},
+                                                  })
+                        .first->second;
+
+    // Starts the commit interval on the worker thread.
+    if (was_empty) {
+        m_cv.notify_one();
+    }
+    return pending;
+}
+
+void WriteBackCache::CommitLocked() {
+    for (auto& [path, pending] : m_pending_files) {
+        const VirtualFile& file = pending.file;
+        bool succeeded = true;
+        if (file->GetSize() != pending.base_size) {
+            succeeded &= file->Resize(pending.base_size);
+        }
+        if (pending.size != pending.base_size) {
+            succeeded &= file->Resize(pending.size);
+        }
+        for (const auto& [extent_offset, extent] : pending.extents) {
+            succeeded &= file->Write(extent.data(), extent.size(), extent_offset) == extent.size();
+        }
+        if (!succeeded) {
+            LOG_ERROR(Service_FS, "Failed to commit pending writes to {}", path);
+        }
+    }
+
+    m_pending_files.clear();
+    m_pending_size = 0;
+    m_commit_requested = false;
+}
+
+void WriteBackCache::CommitThread() {
+    Common::SetCurrentThreadName("VfsWriteBack");
+
+    std::unique_lock lk{m_mutex};
+    while (true) {
+        m_cv.wait(lk, [this] { return m_stop_requested || !m_pending_files.empty(); });
+        if (m_stop_requested) {
+            return;
+        }
+
+        m_cv.wait_for(lk, m_commit_interval,
+                      [this] { return m_stop_requested || m_commit_requested; });
+        CommitLocked();
+    }
+}
+
+WriteBackVfsFile::WriteBackVfsFile(VirtualFile base, std::shared_ptr<WriteBackCache> cache)
+    : m_base{std::move(base)}, m_cache{std::move(cache)} {}
+
+WriteBackVfsFile::~WriteBackVfsFile() = default;
+
+std::string WriteBackVfsFile::GetName() const {
+    return m_base->GetName();
+}
+
+std::size_t WriteBackVfsFile::GetSize() const {
+    return m_cache->GetSize(m_base);
+}
+
+bool WriteBackVfsFile::Resize(std::size_t new_size) {
+    return m_cache->Resize(m_base, new_size);
+}
+
+VirtualDir WriteBackVfsFile::GetContainingDirectory() const {
+    auto dir = m_base->GetContainingDirectory();
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(dir), m_cache);
+}
+
+bool WriteBackVfsFile::IsWritable() const {
+    return m_base->IsWritable();
+}
+
+bool WriteBackVfsFile::IsReadable() const {
+    return m_base->IsReadable();
+}
+
+std::size_t WriteBackVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    return m_cache->Read(m_base, data, length, offset);
+}
+
+std::size_t WriteBackVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return m_cache->Write(m_base, data, length, offset);
+}
+
+bool WriteBackVfsFile::Rename(std::string_view name) {
+    m_cache->Commit();
+    return m_base->Rename(name);
+}
+
+std::string WriteBackVfsFile::GetFullPath() const {
+    return m_base->GetFullPath();
+}
+
+WriteBackVfsDirectory::WriteBackVfsDirectory(VirtualDir base,
+                                             std::shared_ptr<WriteBackCache> cache)
+    : m_base{std::move(base)}, m_cache{std::move(cache)} {}
+
+WriteBackVfsDirectory::~WriteBackVfsDirectory() = default;
+
+std::vector<VirtualFile> WriteBackVfsDirectory::GetFiles() const {
+    auto files = m_base->GetFiles();
+    for (auto& file : files) {
+        file = WrapFile(std::move(file));
+    }
+    return files;
+}
+
+VirtualFile WriteBackVfsDirectory::GetFile(std::string_view name) const {
+    return WrapFile(m_base->GetFile(name));
+}
+
+FileTimeStampRaw WriteBackVfsDirectory::GetFileTimeStamp(std::string_view path) const {
+    return m_base->GetFileTimeStamp(path);
+}
+
+std::vector<VirtualDir> WriteBackVfsDirectory::GetSubdirectories() const {
+    auto dirs = m_base->GetSubdirectories();
+    for (auto& dir : dirs) {
+        dir = WrapDirectory(std::move(dir));
+    }
+    return dirs;
+}
+
+VirtualDir WriteBackVfsDirectory::GetSubdirectory(std::string_view name) const {
+    return WrapDirectory(m_base->GetSubdirectory(name));
+}
+
+bool WriteBackVfsDirectory::IsWritable() const {
+    return m_base->IsWritable();
+}
+
+bool WriteBackVfsDirectory::IsReadable() const {
+    return m_base->IsReadable();
+}
+
+std::string WriteBackVfsDirectory::GetName() const {
+    return m_base->GetName();
+}
+
+VirtualDir WriteBackVfsDirectory::GetParentDirectory() const {
+    return WrapDirectory(m_base->GetParentDirectory());
+}
+
+VirtualDir WriteBackVfsDirectory::CreateSubdirectory(std::string_view name) {
+    return WrapDirectory(m_base->CreateSubdirectory(name));
+}
+
+VirtualFile WriteBackVfsDirectory::CreateFile(std::string_view name) {
+    // Creating a file truncates an existing one, so its pending writes must land first.
+    m_cache->Commit();
+    return WrapFile(m_base->CreateFile(name));
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectory(std::string_view name) {
+    m_cache->Commit();
+    return m_base->DeleteSubdirectory(name);
+}
+
+bool WriteBackVfsDirectory::DeleteSubdirectoryRecursive(std::string_view name) {
+    m_cache->Commit();
+    return m_base->DeleteSubdirectoryRecursive(name);
+}
+
+bool WriteBackVfsDirectory::CleanSubdirectoryRecursive(std::string_view name) {
+    m_cache->Commit();
+    return m_base->CleanSubdirectoryRecursive(name);
+}
+
+bool WriteBackVfsDirectory::DeleteFile(std::string_view name) {
+    m_cache->Commit();
+    return m_base->DeleteFile(name);
+}
+
+bool WriteBackVfsDirectory::Rename(std::string_view name) {
+    m_cache->Commit();
+    return m_base->Rename(name);
+}
+
+std::string WriteBackVfsDirectory::GetFullPath() const {
+    return m_base->GetFullPath();
+}
+
+void WriteBackVfsDirectory::Commit() {
+    m_cache->RequestCommit();
+}
+
+VirtualFile WriteBackVfsDirectory::WrapFile(VirtualFile file) const {
+    if (file == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsFile>(std::move(file), m_cache);
+}
+
+VirtualDir WriteBackVfsDirectory::WrapDirectory(VirtualDir dir) const {
+    if (dir == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<WriteBackVfsDirectory>(std::move(dir), m_cache);
+}
+
+} // namespace FileSys
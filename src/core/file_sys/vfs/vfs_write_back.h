@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "core/file_sys/vfs/vfs.h"
+
+namespace FileSys {
+
+// Holds the writes made through a write-back directory until they are committed to the backing
+// files. Commits happen on a worker thread, either when requested or once the oldest uncommitted
+// write is older than the commit interval, and apply all pending writes as one batch.
+class WriteBackCache {
+    YUZU_NON_COPYABLE(WriteBackCache);
+    YUZU_NON_MOVEABLE(WriteBackCache);
+
+public:
+    explicit WriteBackCache(std::chrono::milliseconds commit_interval);
+    ~WriteBackCache();
+
+    std::size_t GetSize(const VirtualFile& file) const;
+    bool Resize(const VirtualFile& file, std::size_t new_size);
+    std::size_t Read(const VirtualFile& file, u8* data, std::size_t length,
+                     std::size_t offset) const;
+    std::size_t Write(const VirtualFile& file, const u8* data, std::size_t length,
+                      std::size_t offset);
+
+    // Wakes the worker thread to commit the pending writes.
+    void RequestCommit();
+
+    // Commits the pending writes on the calling thread.
+    void Commit();
+
+private:
+    struct PendingFile {
+        VirtualFile file;
+        std::size_t size;
+        // Size the backing file is truncated to before the extents are written.
+        std::size_t base_size;
+        // Non-overlapping written ranges, keyed by offset.
+        std::map<std::size_t, std::vector<u8>> extents;
+    };
+
+    PendingFile& GetPendingFileLocked(const VirtualFile& file);
+    void CommitLocked();
+    void CommitThread();
+
+private:
+    std::chrono::milliseconds m_commit_interval;
+    std::map<std::string, PendingFile> m_pending_files;
+    std::size_t m_pending_size{};
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_commit_requested{};
+    bool m_stop_requested{};
+    std::thread m_thread;
+};
+
+// A file whose writes are buffered by a WriteBackCache.
+class WriteBackVfsFile : public VfsFile {
+public:
+    WriteBackVfsFile(VirtualFile base, std::shared_ptr<WriteBackCache> cache);
+    ~WriteBackVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    VirtualFile m_base;
+    std::shared_ptr<WriteBackCache> m_cache;
+};
+
+// A directory whose files buffer their writes in a shared WriteBackCache. Operations that change
+// the directory structure commit the pending writes first and are then applied directly.
+class WriteBackVfsDirectory : public VfsDirectory {
+public:
+    WriteBackVfsDirectory(VirtualDir base, std::shared_ptr<WriteBackCache> cache);
+    ~WriteBackVfsDirectory() override;
+
+    std::vector<VirtualFile> GetFiles() const override;
+    VirtualFile GetFile(std::string_view name) const override;
+    FileTimeStampRaw GetFileTimeStamp(std::string_view path) const override;
+    std::vector<VirtualDir> GetSubdirectories() const override;
+    VirtualDir GetSubdirectory(std::string_view name) const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::string GetName() const override;
+    VirtualDir GetParentDirectory() const override;
+    VirtualDir CreateSubdirectory(std::string_view name) override;
+    VirtualFile CreateFile(std::string_view name) override;
+    bool DeleteSubdirectory(std::string_view name) override;
+    bool DeleteSubdirectoryRecursive(std::string_view name) override;
+    bool CleanSubdirectoryRecursive(std::string_view name) override;
+    bool DeleteFile(std::string_view name) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+    // Requests an asynchronous commit of the pending writes.
+    void Commit();
+
+private:
+    VirtualFile WrapFile(VirtualFile file) const;
+    VirtualDir WrapDirectory(VirtualDir dir) const;
+
+private:
+    VirtualDir m_base;
+    std::shared_ptr<WriteBackCache> m_cache;
+};
+
+} // namespace FileSys
@@ -37,6 +37,8 @@ struct FramebufferLayout {
     u32 height{ScreenUndocked::Height};
     Common::Rectangle<u32> screen;
     bool is_srgb{};
+
+    bool operator==(const FramebufferLayout&) const = default;
 };
 
 /**
@@ -4,6 +4,7 @@
 #include <mutex>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "core/core.h"
 #include "core/hle/kernel/global_scheduler_context.h"
 #include "core/hle/kernel/k_scheduler.h"
@@ -15,7 +16,15 @@ namespace Kernel {
 GlobalSchedulerContext::GlobalSchedulerContext(KernelCore& kernel)
     : m_kernel{kernel}, m_scheduler_lock{kernel} {}
 
-GlobalSchedulerContext::~GlobalSchedulerContext() = default;
+GlobalSchedulerContext::~GlobalSchedulerContext() {
+    const KSchedulerLockStatistics stats = m_scheduler_lock.GetStatistics();
+    if (stats.acquisitions == 0) {
+        return;
+    }
+    LOG_INFO(Kernel, "Scheduler lock: {} acquisitions, {} contended, waited {} ms, held {} ms",
+             stats.acquisitions, stats.contended, stats.wait_time_ns / 1000000,
+             stats.hold_time_ns / 1000000);
+}
 
 void GlobalSchedulerContext::AddThread(KThread* thread) {
     std::scoped_lock lock{m_global_list_guard};
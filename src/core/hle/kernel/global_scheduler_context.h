@@ -68,6 +68,10 @@ public:
         return m_scheduler_lock;
     }
 
+    KSchedulerLockStatistics GetSchedulerLockStatistics() const {
+        return m_scheduler_lock.GetStatistics();
+    }
+
 private:
     friend class KScopedSchedulerLock;
     friend class KScopedSchedulerLockAndSleep;
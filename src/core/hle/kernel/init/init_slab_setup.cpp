@@ -1,9 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <utility>
+
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/common_funcs.h"
+#include "common/logging/log.h"
 #include "core/core.h"
 #include "core/device_memory.h"
 #include "core/hardware_properties.h"
@@ -30,6 +33,7 @@
 #include "core/hle/kernel/k_thread_local_page.h"
 #include "core/hle/kernel/k_transfer_memory.h"
 #include "core/hle/kernel/k_typed_address.h"
+#include "core/hle/kernel/slab_resource_history.h"
 
 namespace Kernel::Init {
 
@@ -91,6 +95,10 @@ constexpr size_t SlabcountKSessionRequestMappings = 40;
 
 constexpr size_t SlabCountExtraKThread = (1024 + 256 + 256) - SlabCountKThread;
 
+// Slab heaps grown from a program's history may take at most this much more memory, which is
+// taken from the page table heap that follows the slab region.
+constexpr size_t SlabHistoryExtraSizeMax = 1_MiB;
+
 namespace test {
 
 static_assert(KernelPageBufferHeapSize ==
@@ -165,11 +173,43 @@ KSlabResourceCounts KSlabResourceCounts::CreateDefault() {
     };
 }
 
-void InitializeSlabResourceCounts(KernelCore& kernel) {
+void InitializeSlabResourceCounts(KernelCore& kernel, const SlabResourceHistory* history) {
     kernel.SlabResourceCounts() = KSlabResourceCounts::CreateDefault();
     if (KSystemControl::Init::ShouldIncreaseThreadResourceLimit()) {
         kernel.SlabResourceCounts().num_KThread += SlabCountExtraKThread;
     }
+    if (history == nullptr) {
+        return;
+    }
+
+    // Grow the heaps the program used up, leaving some headroom over its peak. Heaps that would
+    // exceed the budget keep their current size. KProcess and KThread are not grown, as they
+    // also size the page buffer heap.
+    const size_t size_max = CalculateTotalSlabHeapSize(kernel) + SlabHistoryExtraSizeMax;
+    auto& counts = kernel.SlabResourceCounts();
+    const auto grow = [&](size_t& count, u64 peak, const char* name) {
+        const size_t wanted = static_cast<size_t>(peak + peak / 4);
+        if (wanted <= count) {
+            return;
+        }
+        const size_t previous = std::exchange(count, wanted);
+        if (CalculateTotalSlabHeapSize(kernel) > size_max) {
+            count = previous;
+            LOG_WARNING(Kernel, "Not growing the {} slab heap to {}, out of slab memory", name,
+                        wanted);
+            return;
+        }
+        LOG_INFO(Kernel, "Growing the {} slab heap from {} to {} objects", name, previous, wanted);
+    };
+    grow(counts.num_KSession, history->num_KSession, "KSession");
+    grow(counts.num_KEvent, history->num_KEvent, "KEvent");
+    grow(counts.num_KPort, history->num_KPort, "KPort");
+    grow(counts.num_KSharedMemory, history->num_KSharedMemory, "KSharedMemory");
+    grow(counts.num_KTransferMemory, history->num_KTransferMemory, "KTransferMemory");
+    grow(counts.num_KCodeMemory, history->num_KCodeMemory, "KCodeMemory");
+    grow(counts.num_KDeviceAddressSpace, history->num_KDeviceAddressSpace,
+         "KDeviceAddressSpace");
+    grow(counts.num_KObjectName, history->num_KObjectName, "KObjectName");
 }
 
 size_t CalculateTotalSlabHeapSize(const KernelCore& kernel) {
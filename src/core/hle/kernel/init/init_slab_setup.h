@@ -10,6 +10,7 @@ class System;
 namespace Kernel {
 class KernelCore;
 class KMemoryLayout;
+struct SlabResourceHistory;
 } // namespace Kernel
 
 namespace Kernel::Init {
@@ -36,7 +37,7 @@ struct KSlabResourceCounts {
     size_t num_KSessionRequestMappings;
 };
 
-void InitializeSlabResourceCounts(KernelCore& kernel);
+void InitializeSlabResourceCounts(KernelCore& kernel, const SlabResourceHistory* history);
 size_t CalculateTotalSlabHeapSize(const KernelCore& kernel);
 void InitializeSlabHeaps(Core::System& system, KMemoryLayout& memory_layout);
 
@@ -77,11 +77,12 @@ public:
 class ThreadQueueImplForKConditionVariableWaitConditionVariable final : public KThreadQueue {
 private:
     KConditionVariable::ThreadTree* m_tree;
+    std::atomic<u32>* m_num_waiters;
 
 public:
     explicit ThreadQueueImplForKConditionVariableWaitConditionVariable(
-        KernelCore& kernel, KConditionVariable::ThreadTree* t)
-        : KThreadQueue(kernel), m_tree(t) {}
+        KernelCore& kernel, KConditionVariable::ThreadTree* t, std::atomic<u32>* n)
+        : KThreadQueue(kernel), m_tree(t), m_num_waiters(n) {}
 
     void CancelWait(KThread* waiting_thread, Result wait_result, bool cancel_timer_task) override {
         // Remove the thread as a waiter from its owner.
@@ -93,6 +94,7 @@ public:
         if (waiting_thread->IsWaitingForConditionVariable()) {
             m_tree->erase(m_tree->iterator_to(*waiting_thread));
             waiting_thread->ClearConditionVariable();
+            m_num_waiters->fetch_sub(1);
         }
 
         // Invoke the base cancel wait handler.
@@ -241,6 +243,17 @@ void KConditionVariable::SignalImpl(KThread* thread) {
 }
 
 void KConditionVariable::Signal(u64 cv_key, s32 count) {
+    // If nobody is waiting and the has waiter flag is already clear, there is nothing to do.
+    // Waiters are counted before they release their mutex, so a signal issued after taking it
+    // can't miss them.
+    if (m_num_waiters.load() == 0) {
+        u32 has_waiter_flag{};
+        if (ReadFromUser(m_kernel, std::addressof(has_waiter_flag), cv_key) &&
+            has_waiter_flag == 0) {
+            return;
+        }
+    }
+
     // Perform signaling.
     s32 num_waiters{};
     {
@@ -253,6 +266,7 @@ void KConditionVariable::Signal(u64 cv_key, s32 count) {
 
             it = m_tree.erase(it);
             target_thread->ClearConditionVariable();
+            m_num_waiters.fetch_sub(1);
 
             this->SignalImpl(target_thread);
 
@@ -271,8 +285,8 @@ Result KConditionVariable::Wait(KProcessAddress addr, u64 key, u32 value, s64 ti
     // Prepare to wait.
     KThread* cur_thread = GetCurrentThreadPointer(m_kernel);
     KHardwareTimer* timer{};
-    ThreadQueueImplForKConditionVariableWaitConditionVariable wait_queue(m_kernel,
-                                                                         std::addressof(m_tree));
+    ThreadQueueImplForKConditionVariableWaitConditionVariable wait_queue(
+        m_kernel, std::addressof(m_tree), std::addressof(m_num_waiters));
 
     {
         KScopedSchedulerLockAndSleep slp(m_kernel, std::addressof(timer), cur_thread, timeout);
@@ -283,6 +297,9 @@ Result KConditionVariable::Wait(KProcessAddress addr, u64 key, u32 value, s64 ti
             R_THROW(ResultTerminationRequested);
         }
 
+        // Count ourselves as a waiter before the mutex can be taken by another thread.
+        m_num_waiters.fetch_add(1);
+
         // Update the value and process for the next owner.
         {
             // Remove waiter thread.
@@ -312,13 +329,17 @@ Result KConditionVariable::Wait(KProcessAddress addr, u64 key, u32 value, s64 ti
 
             // Write the value to userspace.
             if (!WriteToUser(m_kernel, addr, std::addressof(next_value))) {
+                m_num_waiters.fetch_sub(1);
                 slp.CancelSleep();
                 R_THROW(ResultInvalidCurrentMemory);
             }
         }
 
         // If timeout is zero, time out.
-        R_UNLESS(timeout != 0, ResultTimedOut);
+        if (timeout == 0) {
+            m_num_waiters.fetch_sub(1);
+            R_THROW(ResultTimedOut);
+        }
 
         // Update condition variable tracking.
         cur_thread->SetConditionVariable(std::addressof(m_tree), addr, key, value);
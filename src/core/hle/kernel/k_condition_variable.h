@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "common/assert.h"
 
 #include "core/hle/kernel/k_scheduler.h"
@@ -40,6 +42,10 @@ private:
     Core::System& m_system;
     KernelCore& m_kernel;
     ThreadTree m_tree{};
+
+    // Number of threads in the tree, raised before a waiter releases its mutex so that signals
+    // which see no waiters can skip the scheduler lock.
+    std::atomic<u32> m_num_waiters{};
 };
 
 inline void BeforeUpdatePriority(KernelCore& kernel, KConditionVariable::ThreadTree* tree,
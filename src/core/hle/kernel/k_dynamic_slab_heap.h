@@ -6,6 +6,7 @@
 #include <atomic>
 
 #include "common/common_funcs.h"
+#include "common/logging/log.h"
 #include "core/hle/kernel/k_dynamic_page_manager.h"
 #include "core/hle/kernel/k_slab_heap.h"
 
@@ -82,8 +83,14 @@ public:
                         KSlabHeapImpl::Free(allocated + i);
                     }
                     m_count += sizeof(PageBuffer) / sizeof(T);
+                    LOG_INFO(Kernel, "Dynamic slab heap of size {:#x} objects expanded to {}",
+                             sizeof(T), m_count.load());
                 }
             }
+            if (allocated == nullptr) {
+                LOG_WARNING(Kernel, "Dynamic slab heap of size {:#x} objects is exhausted at {}",
+                            sizeof(T), m_count.load());
+            }
         }
 
         if (allocated != nullptr) [[likely]] {
@@ -14,8 +14,9 @@ namespace {
 class ThreadQueueImplForKLightConditionVariable final : public KThreadQueue {
 public:
     ThreadQueueImplForKLightConditionVariable(KernelCore& kernel, KThread::WaiterList* wl,
-                                              bool term)
-        : KThreadQueue(kernel), m_wait_list(wl), m_allow_terminating_thread(term) {}
+                                              std::atomic<u32>* n, bool term)
+        : KThreadQueue(kernel), m_wait_list(wl), m_num_waiters(n),
+          m_allow_terminating_thread(term) {}
 
     void CancelWait(KThread* waiting_thread, Result wait_result, bool cancel_timer_task) override {
         // Only process waits if we're allowed to.
@@ -25,6 +26,7 @@ public:
 
         // Remove the thread from the waiting thread from the light condition variable.
         m_wait_list->erase(m_wait_list->iterator_to(*waiting_thread));
+        m_num_waiters->fetch_sub(1);
 
         // Invoke the base cancel wait handler.
         KThreadQueue::CancelWait(waiting_thread, wait_result, cancel_timer_task);
@@ -32,6 +34,7 @@ public:
 
 private:
     KThread::WaiterList* m_wait_list;
+    std::atomic<u32>* m_num_waiters;
     bool m_allow_terminating_thread;
 };
 
@@ -43,6 +46,7 @@ void KLightConditionVariable::Wait(KLightLock* lock, s64 timeout, bool allow_ter
     KHardwareTimer* timer{};
 
     ThreadQueueImplForKLightConditionVariable wait_queue(m_kernel, std::addressof(m_wait_list),
+                                                         std::addressof(m_num_waiters),
                                                          allow_terminating_thread);
 
     // Sleep the thread.
@@ -54,6 +58,8 @@ void KLightConditionVariable::Wait(KLightLock* lock, s64 timeout, bool allow_ter
             return;
         }
 
+        // Count ourselves as a waiter before the lock can be taken by another thread.
+        m_num_waiters.fetch_add(1);
         lock->Unlock();
 
         // Add the thread to the queue.
@@ -69,11 +75,18 @@ void KLightConditionVariable::Wait(KLightLock* lock, s64 timeout, bool allow_ter
 }
 
 void KLightConditionVariable::Broadcast() {
+    // Waiters are counted before they release the lock, so a broadcast that sees none can't
+    // miss a thread that already gave up the lock.
+    if (m_num_waiters.load() == 0) {
+        return;
+    }
+
     KScopedSchedulerLock lk(m_kernel);
 
     // Signal all threads.
     for (auto it = m_wait_list.begin(); it != m_wait_list.end(); it = m_wait_list.erase(it)) {
         it->EndWait(ResultSuccess);
+        m_num_waiters.fetch_sub(1);
     }
 }
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "common/common_types.h"
 #include "core/hle/kernel/k_thread.h"
 
@@ -21,5 +23,9 @@ public:
 private:
     KernelCore& m_kernel;
     KThread::WaiterList m_wait_list{};
+
+    // Number of threads in the wait list, raised before a waiter releases its lock so that
+    // broadcasts which see no waiters can skip the scheduler lock.
+    std::atomic<u32> m_num_waiters{};
 };
 } // namespace Kernel
@@ -30,6 +30,7 @@ Result KMemoryBlockManager::Initialize(KProcessAddress st, KProcessAddress nd,
 void KMemoryBlockManager::Finalize(KMemoryBlockSlabManager* slab_manager,
                                    BlockCallback&& block_callback) {
     // Erase every block until we have none left.
+    m_last_hit.store(nullptr, std::memory_order_relaxed);
     auto it = m_memory_block_tree.begin();
     while (it != m_memory_block_tree.end()) {
         KMemoryBlock* block = std::addressof(*it);
@@ -96,6 +97,7 @@ void KMemoryBlockManager::CoalesceForUpdate(KMemoryBlockManagerUpdateAllocator*
 
         if (prev->CanMergeWith(*it)) {
             KMemoryBlock* block = std::addressof(*it);
+            m_last_hit.store(nullptr, std::memory_order_relaxed);
             m_memory_block_tree.erase(it);
             prev->Add(*block);
             allocator->Free(block);
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 
 #include "common/common_funcs.h"
 #include "core/hle/kernel/k_dynamic_resource_manager.h"
@@ -122,8 +124,26 @@ public:
                          size_t num_pages, KMemoryAttribute mask, KMemoryAttribute attr);
 
     iterator FindIterator(KProcessAddress address) const {
-        return m_memory_block_tree.find(KMemoryBlock(
+        // Lookups tend to hit the same block or walk forward from it, so check those first.
+        if (KMemoryBlock* const block = m_last_hit.load(std::memory_order_relaxed)) {
+            // find() hands out mutable iterators from const lookups as well.
+            iterator it = const_cast<MemoryBlockTree&>(m_memory_block_tree).iterator_to(*block);
+            if (address >= it->GetAddress() && address <= it->GetLastAddress()) {
+                return it;
+            }
+            if (address > it->GetLastAddress() && ++it != m_memory_block_tree.end() &&
+                address <= it->GetLastAddress()) {
+                m_last_hit.store(std::addressof(*it), std::memory_order_relaxed);
+                return it;
+            }
+        }
+
+        iterator it = m_memory_block_tree.find(KMemoryBlock(
             address, 1, KMemoryState::Free, KMemoryPermission::None, KMemoryAttribute::None));
+        if (it != m_memory_block_tree.end()) {
+            m_last_hit.store(std::addressof(*it), std::memory_order_relaxed);
+        }
+        return it;
     }
 
     const KMemoryBlock* FindBlock(KProcessAddress address) const {
@@ -142,6 +162,10 @@ private:
                            size_t num_pages);
 
     MemoryBlockTree m_memory_block_tree;
+
+    /// Block returned by the last lookup, cleared before any block is removed from the tree.
+    mutable std::atomic<KMemoryBlock*> m_last_hit{};
+
     KProcessAddress m_start_address{};
     KProcessAddress m_end_address{};
 };
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -2182,6 +2184,9 @@ Result KPageTableBase::SetHeapSize(KProcessAddress* out, size_t size) {
         }
     }
 
+    // Time the extension, growing the heap while loading is a visible hitch.
+    const auto extension_start = std::chrono::steady_clock::now();
+
     // Reserve memory for the heap extension.
     KScopedResourceReservation memory_reservation(
         m_resource_limit, Svc::LimitableResource::PhysicalMemoryMax, allocation_size);
@@ -2200,9 +2205,12 @@ Result KPageTableBase::SetHeapSize(KProcessAddress* out, size_t size) {
     };
 
     // Clear all the newly allocated pages.
+    size_t num_blocks = 0;
     for (const auto& it : pg) {
         ClearBackingRegion(m_system, it.GetAddress(), it.GetSize(), m_heap_fill_value);
+        ++num_blocks;
     }
+    const auto clear_end = std::chrono::steady_clock::now();
 
     // Map the pages.
     {
@@ -2251,6 +2259,13 @@ Result KPageTableBase::SetHeapSize(KProcessAddress* out, size_t size) {
         // Update the current heap end.
         m_current_heap_end = m_heap_region_start + size;
 
+        const auto ToMicroseconds = [](auto duration) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        };
+        LOG_DEBUG(Kernel, "Heap grown by {:#x} bytes in {} blocks, {} us clearing, {} us total",
+                  allocation_size, num_blocks, ToMicroseconds(clear_end - extension_start),
+                  ToMicroseconds(std::chrono::steady_clock::now() - extension_start));
+
         // Set the output.
         *out = m_heap_region_start;
         R_SUCCEED();
@@ -5764,14 +5779,27 @@ Result KPageTableBase::Operate(PageLinkedList* page_list, KProcessAddress virt_a
         // We want to maintain a new reference to every page in the group.
         KScopedPageGroup spg(page_group, operation == OperationType::MapGroup);
 
-        for (const auto& node : page_group) {
-            const size_t size{node.GetNumPages() * PageSize};
-
-            // Map the pages.
-            m_memory->MapMemoryRegion(*m_impl, virt_addr, size, node.GetAddress(),
+        // Map physically contiguous runs with a single host mapping each.
+        KPhysicalAddress run_addr{};
+        size_t run_size{};
+        const auto MapRun = [&] {
+            m_memory->MapMemoryRegion(*m_impl, virt_addr, run_size, run_addr,
                                       ConvertToMemoryPermission(properties.perm), separate_heap);
-
-            virt_addr += size;
+            virt_addr += run_size;
+        };
+        for (const auto& node : page_group) {
+            if (run_size != 0 && node.GetAddress() == run_addr + run_size) {
+                run_size += node.GetSize();
+                continue;
+            }
+            if (run_size != 0) {
+                MapRun();
+            }
+            run_addr = node.GetAddress();
+            run_size = node.GetSize();
+        }
+        if (run_size != 0) {
+            MapRun();
         }
 
         // We succeeded! We want to persist the reference to the pages.
@@ -2,8 +2,10 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <random>
+#include "common/boot_profiler.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "core/arm/cas_exclusive_monitor.h"
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #include "core/arm/dynarmic/dynarmic_exclusive_monitor.h"
 #include "core/core.h"
@@ -1152,6 +1154,7 @@ KProcess::~KProcess() = default;
 
 Result KProcess::LoadFromMetadata(const FileSys::ProgramMetadata& metadata, std::size_t code_size,
                                   KProcessAddress aslr_space_start, bool is_hbl) {
+    BOOT_PHASE("KProcess::LoadFromMetadata");
     // Create a resource limit for the process.
     const auto pool = static_cast<KMemoryManager::Pool>(metadata.GetPoolPartition());
     const auto physical_memory_size = m_kernel.MemoryManager().GetSize(pool);
@@ -1260,11 +1263,13 @@ void KProcess::LoadModule(CodeSet code_set, KProcessAddress base_addr) {
 }
 
 void KProcess::InitializeInterfaces() {
-    m_exclusive_monitor =
-        Core::MakeExclusiveMonitor(this->GetMemory(), Core::Hardware::NUM_CPU_CORES);
-
 #ifdef HAS_NCE
     if (this->IsApplication() && Settings::IsNceEnabled()) {
+        // Native guest code performs its exclusive accesses on the host, so the monitor is only
+        // used by the kernel and does not need to be shared with dynarmic.
+        m_exclusive_monitor = std::make_unique<Core::CasExclusiveMonitor>(
+            this->GetMemory(), Core::Hardware::NUM_CPU_CORES);
+
         // Register the scoped JIT handler before creating any NCE instances
         // so that its signal handler will appear first in the signal chain.
         Core::ScopedJitExecution::RegisterHandler();
@@ -1272,9 +1277,14 @@ void KProcess::InitializeInterfaces() {
         for (size_t i = 0; i < Core::Hardware::NUM_CPU_CORES; i++) {
             m_arm_interfaces[i] = std::make_unique<Core::ArmNce>(m_kernel.System(), true, i);
         }
-    } else
+        return;
+    }
 #endif
-        if (this->Is64Bit()) {
+
+    m_exclusive_monitor =
+        Core::MakeExclusiveMonitor(this->GetMemory(), Core::Hardware::NUM_CPU_CORES);
+
+    if (this->Is64Bit()) {
         for (size_t i = 0; i < Core::Hardware::NUM_CPU_CORES; i++) {
             m_arm_interfaces[i] = std::make_unique<Core::ArmDynarmic64>(
                 m_kernel.System(), m_kernel.IsMulticore(), this,
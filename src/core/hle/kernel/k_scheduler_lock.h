@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include "common/assert.h"
 #include "core/hle/kernel/k_interrupt_manager.h"
 #include "core/hle/kernel/k_spin_lock.h"
@@ -16,6 +17,13 @@ namespace Kernel {
 class KernelCore;
 class GlobalSchedulerContext;
 
+struct KSchedulerLockStatistics {
+    u64 acquisitions{};
+    u64 contended{};
+    u64 wait_time_ns{};
+    u64 hold_time_ns{};
+};
+
 template <typename SchedulerType>
 class KAbstractSchedulerLock {
 public:
@@ -33,7 +41,13 @@ public:
         } else {
             // Otherwise, we want to disable scheduling and acquire the spinlock.
             SchedulerType::DisableScheduling(m_kernel);
-            m_spin_lock.Lock();
+            if (!m_spin_lock.TryLock()) {
+                const auto wait_start = std::chrono::steady_clock::now();
+                m_spin_lock.Lock();
+                m_contended.fetch_add(1, std::memory_order_relaxed);
+                m_wait_time_ns.fetch_add(NanosecondsSince(wait_start), std::memory_order_relaxed);
+            }
+            m_acquire_time = std::chrono::steady_clock::now();
 
             ASSERT(m_lock_count == 0);
             ASSERT(m_owner_thread == nullptr);
@@ -59,6 +73,10 @@ public:
             const u64 cores_needing_scheduling =
                 SchedulerType::UpdateHighestPriorityThreads(m_kernel);
 
+            // Account for the time the lock was held, including the scheduling update.
+            m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+            m_hold_time_ns.fetch_add(NanosecondsSince(m_acquire_time), std::memory_order_relaxed);
+
             // Note that we no longer hold the lock, and unlock the spinlock.
             m_owner_thread = nullptr;
             m_spin_lock.Unlock();
@@ -68,13 +86,35 @@ public:
         }
     }
 
+    KSchedulerLockStatistics GetStatistics() const {
+        return {
+            .acquisitions = m_acquisitions.load(std::memory_order_relaxed),
+            .contended = m_contended.load(std::memory_order_relaxed),
+            .wait_time_ns = m_wait_time_ns.load(std::memory_order_relaxed),
+            .hold_time_ns = m_hold_time_ns.load(std::memory_order_relaxed),
+        };
+    }
+
 private:
     friend class GlobalSchedulerContext;
 
+    static u64 NanosecondsSince(std::chrono::steady_clock::time_point start) {
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count());
+    }
+
     KernelCore& m_kernel;
     KAlignedSpinLock m_spin_lock{};
     s32 m_lock_count{};
     std::atomic<KThread*> m_owner_thread{};
+
+    // Statistics, only written while the spinlock is held.
+    std::chrono::steady_clock::time_point m_acquire_time{};
+    std::atomic<u64> m_acquisitions{};
+    std::atomic<u64> m_contended{};
+    std::atomic<u64> m_wait_time_ns{};
+    std::atomic<u64> m_hold_time_ns{};
 };
 
 } // namespace Kernel
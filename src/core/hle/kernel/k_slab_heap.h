@@ -9,6 +9,7 @@
 #include "common/atomic_ops.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
+#include "common/logging/log.h"
 #include "common/spin_lock.h"
 
 namespace Kernel {
@@ -136,6 +137,12 @@ public:
     void* Allocate() {
         void* obj = KSlabHeapImpl::Allocate();
 
+        if (obj != nullptr) [[likely]] {
+            this->UpdatePeakImpl(reinterpret_cast<uintptr_t>(obj));
+        } else {
+            LOG_WARNING(Kernel, "Slab heap of {} objects of size {:#x} is exhausted",
+                        this->GetSlabHeapSize(), this->GetObjectSize());
+        }
         return obj;
     }
 
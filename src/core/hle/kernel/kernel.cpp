@@ -1,19 +1,25 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bitset>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <unordered_set>
 #include <utility>
 
+#include <fmt/format.h>
+
 #include "common/assert.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "common/thread_worker.h"
 #include "core/arm/arm_interface.h"
@@ -41,6 +47,8 @@
 #include "core/hle/kernel/k_worker_task_manager.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/physical_core.h"
+#include "core/hle/kernel/slab_resource_history.h"
+#include "core/hle/kernel/svc_trace.h"
 #include "core/hle/result.h"
 #include "core/hle/service/server_manager.h"
 #include "core/hle/service/sm/sm.h"
@@ -62,17 +70,23 @@ struct KernelCore::Impl {
         is_multicore = is_multi;
     }
 
-    void Initialize(KernelCore& kernel) {
+    void Initialize(KernelCore& kernel, u64 program_id_) {
+        program_id = program_id_;
+        slab_history = program_id != 0 ? SlabResourceHistory::Load(program_id) : std::nullopt;
+
         hardware_timer = std::make_unique<Kernel::KHardwareTimer>(kernel);
         hardware_timer->Initialize();
 
+        svc_trace = std::make_unique<Kernel::SvcTrace>();
+        svc_trace->SetEnabled(Settings::values.enable_svc_trace.GetValue());
+
         global_object_list_container = std::make_unique<KAutoObjectWithListContainer>(kernel);
         global_scheduler_context = std::make_unique<Kernel::GlobalSchedulerContext>(kernel);
 
         is_phantom_mode_for_singlecore = false;
 
         // Derive the initial memory layout from the emulated board
-        Init::InitializeSlabResourceCounts(kernel);
+        Init::InitializeSlabResourceCounts(kernel, slab_history ? &*slab_history : nullptr);
         DeriveInitialMemoryLayout();
         Init::InitializeSlabHeaps(system, *memory_layout);
 
@@ -113,6 +127,17 @@ struct KernelCore::Impl {
             is_shutting_down.store(false, std::memory_order_relaxed);
         };
 
+        if (svc_trace && svc_trace->IsEnabled()) {
+            const auto log_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir);
+            svc_trace->ExportChromeTrace(log_dir /
+                                         fmt::format("svc_trace_{:016X}.json", program_id));
+        }
+
+        if (program_id != 0) {
+            RecordSlabHistory();
+            program_id = 0;
+        }
+
         CloseServices();
 
         if (application_process) {
@@ -181,6 +206,26 @@ struct KernelCore::Impl {
 
         hardware_timer->Finalize();
         hardware_timer.reset();
+
+        svc_trace.reset();
+    }
+
+    void RecordSlabHistory() {
+        auto& kernel = system.Kernel();
+        const SlabResourceHistory history{
+            .num_KEvent = kernel.SlabHeap<KEvent>().GetPeakIndex(),
+            .num_KPort = kernel.SlabHeap<KPort>().GetPeakIndex(),
+            .num_KSharedMemory = kernel.SlabHeap<KSharedMemory>().GetPeakIndex(),
+            .num_KTransferMemory = kernel.SlabHeap<KTransferMemory>().GetPeakIndex(),
+            .num_KCodeMemory = kernel.SlabHeap<KCodeMemory>().GetPeakIndex(),
+            .num_KDeviceAddressSpace = kernel.SlabHeap<KDeviceAddressSpace>().GetPeakIndex(),
+            .num_KSession = kernel.SlabHeap<KSession>().GetPeakIndex(),
+            .num_KObjectName = kernel.SlabHeap<KObjectName>().GetPeakIndex(),
+            .num_app_memory_blocks = app_memory_block_heap->GetPeak(),
+            .num_sys_memory_blocks = sys_memory_block_heap->GetPeak(),
+            .num_block_infos = block_info_heap->GetPeak(),
+        };
+        history.Save(program_id);
     }
 
     void CloseServices() {
@@ -257,6 +302,16 @@ struct KernelCore::Impl {
         system.CoreTiming().ScheduleLoopingEvent(time_interval, time_interval, preemption_event);
     }
 
+    /// Sizes a dynamic slab heap from the program's peak, up to twice its default size. The heap
+    /// is taken from the same pages as the page table heap.
+    size_t GetDynamicSlabHeapSize(size_t default_size, u64 SlabResourceHistory::*peak) const {
+        if (!slab_history) {
+            return default_size;
+        }
+        const u64 count = (*slab_history).*peak;
+        return std::clamp(static_cast<size_t>(count + count / 4), default_size, default_size * 2);
+    }
+
     void InitializeResourceManagers(KernelCore& kernel, KVirtualAddress address, size_t size) {
         // Ensure that the buffer is suitable for our use.
         ASSERT(Common::IsAligned(GetInteger(address), PageSize));
@@ -280,11 +335,17 @@ struct KernelCore::Impl {
         app_memory_block_heap = std::make_unique<KMemoryBlockSlabHeap>();
         sys_memory_block_heap = std::make_unique<KMemoryBlockSlabHeap>();
         block_info_heap = std::make_unique<KBlockInfoSlabHeap>();
-        app_memory_block_heap->Initialize(resource_manager_page_manager.get(),
-                                          ApplicationMemoryBlockSlabHeapSize);
-        sys_memory_block_heap->Initialize(resource_manager_page_manager.get(),
-                                          SystemMemoryBlockSlabHeapSize);
-        block_info_heap->Initialize(resource_manager_page_manager.get(), BlockInfoSlabHeapSize);
+        app_memory_block_heap->Initialize(
+            resource_manager_page_manager.get(),
+            GetDynamicSlabHeapSize(ApplicationMemoryBlockSlabHeapSize,
+                                   &SlabResourceHistory::num_app_memory_blocks));
+        sys_memory_block_heap->Initialize(
+            resource_manager_page_manager.get(),
+            GetDynamicSlabHeapSize(SystemMemoryBlockSlabHeapSize,
+                                   &SlabResourceHistory::num_sys_memory_blocks));
+        block_info_heap->Initialize(
+            resource_manager_page_manager.get(),
+            GetDynamicSlabHeapSize(BlockInfoSlabHeapSize, &SlabResourceHistory::num_block_infos));
 
         // Reserve all but a fixed number of remaining pages for the page table heap.
         const size_t num_pt_pages = resource_manager_page_manager->GetCount() -
@@ -782,8 +843,11 @@ struct KernelCore::Impl {
     KProcess* application_process{};
     std::unique_ptr<Kernel::GlobalSchedulerContext> global_scheduler_context;
     std::unique_ptr<Kernel::KHardwareTimer> hardware_timer;
+    std::unique_ptr<Kernel::SvcTrace> svc_trace;
 
     Init::KSlabResourceCounts slab_resource_counts{};
+    u64 program_id{};
+    std::optional<SlabResourceHistory> slab_history;
     KResourceLimit* system_resource_limit{};
 
     KPageBufferSlabHeap page_buffer_slab_heap;
@@ -855,9 +919,9 @@ void KernelCore::SetMulticore(bool is_multicore) {
     impl->SetMulticore(is_multicore);
 }
 
-void KernelCore::Initialize() {
+void KernelCore::Initialize(u64 program_id) {
     slab_heap_container = std::make_unique<SlabHeapContainer>();
-    impl->Initialize(*this);
+    impl->Initialize(*this, program_id);
 }
 
 void KernelCore::Shutdown() {
@@ -966,6 +1030,10 @@ Kernel::KHardwareTimer& KernelCore::HardwareTimer() {
     return *impl->hardware_timer;
 }
 
+Kernel::SvcTrace& KernelCore::SvcTrace() {
+    return *impl->svc_trace;
+}
+
 KAutoObjectWithListContainer& KernelCore::ObjectListContainer() {
     return *impl->global_object_list_container;
 }
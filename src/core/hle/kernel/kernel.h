@@ -72,6 +72,7 @@ class KTransferMemory;
 class KWorkerTaskManager;
 class KCodeMemory;
 class PhysicalCore;
+class SvcTrace;
 
 namespace Init {
 struct KSlabResourceCounts;
@@ -102,8 +103,9 @@ public:
     /// Sets if emulation is multicore or single core, must be set before Initialize
     void SetMulticore(bool is_multicore);
 
-    /// Resets the kernel to a clean slate for use.
-    void Initialize();
+    /// Resets the kernel to a clean slate for use. The slab heaps are sized from the peak usage
+    /// recorded for the given program, if any.
+    void Initialize(u64 program_id);
 
     /// Clears all resources in use by the kernel instance.
     void Shutdown();
@@ -166,6 +168,9 @@ public:
     /// Gets the an instance of the hardware timer.
     Kernel::KHardwareTimer& HardwareTimer();
 
+    /// Gets the host side trace of supervisor calls.
+    Kernel::SvcTrace& SvcTrace();
+
     /// Stops execution of 'id' core, in order to reschedule a new thread.
     void PrepareReschedule(std::size_t id);
 
@@ -1,8 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <chrono>
+
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "common/spin_lock.h"
 #include "core/core.h"
 #include "core/debugger/debugger.h"
 #include "core/hle/kernel/k_process.h"
@@ -13,8 +17,17 @@
 
 namespace Kernel {
 
+namespace {
+// Bounds of the number of pause instructions an idle core spins before parking.
+constexpr u32 MinIdleSpinBudget = 64;
+constexpr u32 MaxIdleSpinBudget = 16384;
+
+// Parked idles shorter than this would likely have been caught by spinning.
+constexpr std::chrono::microseconds ShortIdleInterval{50};
+} // namespace
+
 PhysicalCore::PhysicalCore(KernelCore& kernel, std::size_t core_index)
-    : m_kernel{kernel}, m_core_index{core_index} {
+    : m_kernel{kernel}, m_core_index{core_index}, m_idle_spin_budget{MinIdleSpinBudget} {
     m_is_single_core = !kernel.IsMulticore();
 }
 PhysicalCore::~PhysicalCore() = default;
@@ -204,14 +217,51 @@ void PhysicalCore::LogBacktrace() {
 }
 
 void PhysicalCore::Idle() {
-    std::unique_lock lk{m_guard};
-    m_on_interrupt.wait(lk, [this] { return m_is_interrupted; });
+    const bool adaptive = Settings::values.use_adaptive_idle.GetValue();
+    const u32 spin_budget = m_idle_spin_budget.load(std::memory_order_relaxed);
+
+    // Spin for a short while first, interrupts often arrive soon after a core goes idle and
+    // parking makes every one of them pay for a full wake-up of the host thread.
+    if (adaptive) {
+        for (u32 i = 0; i < spin_budget; ++i) {
+            if (m_is_interrupted.load(std::memory_order_acquire)) {
+                m_idle_spin_wakeups.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Common::ThreadPause();
+        }
+    }
+
+    const auto park_start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock lk{m_guard};
+        m_on_interrupt.wait(lk, [this] { return m_is_interrupted.load(); });
+    }
+    m_idle_parked_wakeups.fetch_add(1, std::memory_order_relaxed);
+    if (!adaptive) {
+        return;
+    }
+
+    // Spin longer when wake-ups keep arriving shortly after parking, less when they do not.
+    const auto parked_time = std::chrono::steady_clock::now() - park_start;
+    const u32 next_budget = parked_time < ShortIdleInterval
+                                ? std::min(spin_budget * 2, MaxIdleSpinBudget)
+                                : std::max(spin_budget / 2, MinIdleSpinBudget);
+    m_idle_spin_budget.store(next_budget, std::memory_order_relaxed);
 }
 
 bool PhysicalCore::IsInterrupted() const {
     return m_is_interrupted;
 }
 
+PhysicalCore::IdleStatistics PhysicalCore::GetIdleStatistics() const {
+    return {
+        .spin_wakeups = m_idle_spin_wakeups.load(std::memory_order_relaxed),
+        .parked_wakeups = m_idle_parked_wakeups.load(std::memory_order_relaxed),
+        .spin_budget = m_idle_spin_budget.load(std::memory_order_relaxed),
+    };
+}
+
 void PhysicalCore::Interrupt() {
     // Lock core context.
     std::scoped_lock lk{m_guard};
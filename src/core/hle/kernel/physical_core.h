@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -23,6 +24,12 @@ namespace Kernel {
 
 class PhysicalCore {
 public:
+    struct IdleStatistics {
+        u64 spin_wakeups;   ///< Interrupts received while spinning before parking.
+        u64 parked_wakeups; ///< Interrupts received after parking on the condition variable.
+        u32 spin_budget;    ///< Current number of spin iterations before parking.
+    };
+
     PhysicalCore(KernelCore& kernel, std::size_t core_index);
     ~PhysicalCore();
 
@@ -58,6 +65,9 @@ public:
     // Check if this core is interrupted.
     bool IsInterrupted() const;
 
+    // Get the statistics of the adaptive idle strategy.
+    IdleStatistics GetIdleStatistics() const;
+
     std::size_t CoreIndex() const {
         return m_core_index;
     }
@@ -70,8 +80,12 @@ private:
     std::condition_variable m_on_interrupt;
     Core::ArmInterface* m_arm_interface{};
     KThread* m_current_thread{};
-    bool m_is_interrupted{};
+    std::atomic<bool> m_is_interrupted{};
     bool m_is_single_core{};
+
+    std::atomic<u32> m_idle_spin_budget;
+    std::atomic<u64> m_idle_spin_wakeups{};
+    std::atomic<u64> m_idle_parked_wakeups{};
 };
 
 } // namespace Kernel
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <filesystem>
+
+#include <fmt/format.h>
+
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/hle/kernel/slab_resource_history.h"
+
+namespace Kernel {
+namespace {
+
+constexpr u32 HistoryMagic = Common::MakeMagic('S', 'L', 'B', 'H');
+constexpr u32 HistoryVersion = 1;
+
+struct HistoryFile {
+    u32 magic;
+    u32 version;
+    SlabResourceHistory history;
+};
+static_assert(std::is_trivially_copyable_v<HistoryFile>);
+
+std::filesystem::path GetHistoryPath(u64 program_id) {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "slab_history" /
+           fmt::format("{:016X}.bin", program_id);
+}
+
+} // Anonymous namespace
+
+std::optional<SlabResourceHistory> SlabResourceHistory::Load(u64 program_id) {
+    const auto path = GetHistoryPath(program_id);
+    if (!Common::FS::Exists(path)) {
+        return std::nullopt;
+    }
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    HistoryFile contents{};
+    if (!file.IsOpen() || !file.ReadObject(contents) || contents.magic != HistoryMagic ||
+        contents.version != HistoryVersion) {
+        LOG_WARNING(Kernel, "Ignoring invalid slab history {}", path.string());
+        return std::nullopt;
+    }
+    return contents.history;
+}
+
+void SlabResourceHistory::Save(u64 program_id) const {
+    const auto path = GetHistoryPath(program_id);
+
+    // Peaks that were not reached in this session are kept from the previous ones.
+    SlabResourceHistory merged = *this;
+    if (const auto previous = Load(program_id)) {
+        const auto keep_max = [](u64& count, u64 previous_count) {
+            count = std::max(count, previous_count);
+        };
+        keep_max(merged.num_KEvent, previous->num_KEvent);
+        keep_max(merged.num_KPort, previous->num_KPort);
+        keep_max(merged.num_KSharedMemory, previous->num_KSharedMemory);
+        keep_max(merged.num_KTransferMemory, previous->num_KTransferMemory);
+        keep_max(merged.num_KCodeMemory, previous->num_KCodeMemory);
+        keep_max(merged.num_KDeviceAddressSpace, previous->num_KDeviceAddressSpace);
+        keep_max(merged.num_KSession, previous->num_KSession);
+        keep_max(merged.num_KObjectName, previous->num_KObjectName);
+        keep_max(merged.num_app_memory_blocks, previous->num_app_memory_blocks);
+        keep_max(merged.num_sys_memory_blocks, previous->num_sys_memory_blocks);
+        keep_max(merged.num_block_infos, previous->num_block_infos);
+    }
+
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Kernel, "Failed to create the directory for {}", path.string());
+        return;
+    }
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    const HistoryFile contents{
+        .magic = HistoryMagic,
+        .version = HistoryVersion,
+        .history = merged,
+    };
+    if (!file.IsOpen() || !file.WriteObject(contents)) {
+        LOG_ERROR(Kernel, "Failed to write slab history {}", path.string());
+    }
+}
+
+} // namespace Kernel
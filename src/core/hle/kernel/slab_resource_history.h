@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+
+#include "common/common_types.h"
+
+namespace Kernel {
+
+/**
+ * Peak object counts of the kernel slab heaps, recorded per program.
+ *
+ * The peaks are saved when the kernel shuts down and loaded before the kernel is initialized for
+ * the same program again. The slab heaps and the dynamic resource heaps are then sized from them,
+ * so a program that needed more objects than the defaults does not expand the heaps during play
+ * or run out of them.
+ */
+struct SlabResourceHistory {
+    u64 num_KEvent;
+    u64 num_KPort;
+    u64 num_KSharedMemory;
+    u64 num_KTransferMemory;
+    u64 num_KCodeMemory;
+    u64 num_KDeviceAddressSpace;
+    u64 num_KSession;
+    u64 num_KObjectName;
+    u64 num_app_memory_blocks;
+    u64 num_sys_memory_blocks;
+    u64 num_block_infos;
+
+    /// Returns the history saved for a program, if there is a valid one.
+    static std::optional<SlabResourceHistory> Load(u64 program_id);
+
+    /// Saves the history for a program, keeping the larger of each count and the saved one.
+    void Save(u64 program_id) const;
+};
+
+} // namespace Kernel
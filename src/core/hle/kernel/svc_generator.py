@@ -539,16 +539,21 @@ void SvcWrap_CallSecureMonitor64(Core::System& system, std::span<uint64_t, 8> ar
 // Perform a supervisor call by index.
 void Call(Core::System& system, u32 imm);
 
+// Returns the name of a supervisor call, or nullptr if the index is unknown.
+const char* GetName(u32 imm);
+
 } // namespace Kernel::Svc
 """
 
 PROLOGUE_CPP = """
+#include <optional>
 #include <type_traits>
 
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/svc.h"
+#include "core/hle/kernel/svc_trace.h"
 
 namespace Kernel::Svc {
 
@@ -598,12 +603,22 @@ void Call(Core::System& system, u32 imm) {
     kernel.CurrentPhysicalCore().SaveSvcArguments(process, args);
     kernel.EnterSVCProfile();
 
+    auto& svc_trace = kernel.SvcTrace();
+    std::optional<SvcTrace::Scope> trace_scope;
+    if (svc_trace.IsEnabled()) {
+        trace_scope = svc_trace.Begin(kernel, imm);
+    }
+
     if (process.Is64Bit()) {
         Call64(system, imm, args);
     } else {
         Call32(system, imm, args);
     }
 
+    if (trace_scope) {
+        svc_trace.End(kernel, *trace_scope);
+    }
+
     kernel.ExitSVCProfile();
     kernel.CurrentPhysicalCore().LoadSvcArguments(process, args);
 }
@@ -634,6 +649,25 @@ def emit_call(bitness, names, suffix):
     return "\n".join(lines)
 
 
+def emit_names(names):
+    indent = "    "
+    lines = [
+        "const char* GetName(u32 imm) {",
+        f"{indent}switch (static_cast<SvcId>(imm)) {{"
+    ]
+
+    for _, name in names:
+        lines.append(f"{indent}case SvcId::{name}:")
+        lines.append(f"{indent*2}return \"{name}\";")
+
+    lines.append(f"{indent}default:")
+    lines.append(f"{indent*2}return nullptr;")
+    lines.append(f"{indent}}}")
+    lines.append("}")
+
+    return "\n".join(lines)
+
+
 def build_fn_declaration(return_type, name, arguments):
     arg_list = ["Core::System& system"]
     for arg in arguments:
@@ -690,6 +724,7 @@ def main():
 
     call_32 = emit_call(BIT_32, names, SUFFIX_NAMES[BIT_32])
     call_64 = emit_call(BIT_64, names, SUFFIX_NAMES[BIT_64])
+    name_fn = emit_names(names)
     enum_decls = build_enum_declarations()
 
     with open("svc.h", "w") as f:
@@ -714,6 +749,8 @@ def main():
         f.write(call_32)
         f.write("\n\n")
         f.write(call_64)
+        f.write("\n\n")
+        f.write(name_fn)
         f.write(EPILOGUE_CPP)
 
     print(f"Done (emitted {len(names)} definitions)")
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/logging/log.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/svc.h"
+#include "core/hle/kernel/svc_trace.h"
+#include "core/memory.h"
+
+namespace Kernel {
+namespace {
+u64 NanosecondsBetween(std::chrono::steady_clock::time_point from,
+                       std::chrono::steady_clock::time_point to) {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+/// Reads the command id of the request a thread is about to send from its message buffer.
+u32 ReadCommandId(Core::Memory::Memory& memory, u64 tls) {
+    IPC::CommandHeader header;
+    memory.ReadBlock(tls, &header, sizeof(header));
+    if (header.IsCloseCommand()) {
+        return SvcTrace::NoCommand;
+    }
+    if (header.IsTipc()) {
+        return static_cast<u32>(header.type.Value()) -
+               static_cast<u32>(IPC::CommandType::TIPC_CommandRegion);
+    }
+
+    // Skip the special header and the buffer descriptors preceding the raw data.
+    u64 offset = sizeof(header);
+    if (header.enable_handle_descriptor) {
+        IPC::HandleDescriptorHeader handles;
+        memory.ReadBlock(tls + offset, &handles, sizeof(handles));
+        offset += sizeof(handles) + (handles.send_current_pid ? sizeof(u64) : 0) +
+                  (handles.num_handles_to_copy + handles.num_handles_to_move) * sizeof(u32);
+    }
+    offset += header.num_buf_x_descriptors * sizeof(IPC::BufferDescriptorX);
+    offset += (header.num_buf_a_descriptors + header.num_buf_b_descriptors +
+               header.num_buf_w_descriptors) *
+              sizeof(IPC::BufferDescriptorABW);
+    offset = (offset + 15) & ~u64{15};
+
+    // Domain requests carry their own header in front of the payload.
+    static constexpr u32 InputMagic = Common::MakeMagic('S', 'F', 'C', 'I');
+    for (const u64 payload : {offset, offset + sizeof(IPC::DomainMessageHeader)}) {
+        IPC::DataPayloadHeader payload_header;
+        memory.ReadBlock(tls + payload, &payload_header, sizeof(payload_header));
+        if (payload_header.magic == InputMagic) {
+            return memory.Read32(tls + payload + sizeof(payload_header));
+        }
+    }
+    return SvcTrace::NoCommand;
+}
+} // Anonymous namespace
+
+SvcTrace::SvcTrace() : m_epoch{std::chrono::steady_clock::now()} {}
+
+SvcTrace::~SvcTrace() = default;
+
+void SvcTrace::SetEnabled(bool enabled) {
+    std::scoped_lock lk{m_mutex};
+
+    // Rings are kept once allocated, so cores still finishing a call never lose them.
+    if (enabled) {
+        for (auto& ring : m_rings) {
+            if (!ring) {
+                ring = std::make_unique<Ring>();
+            }
+        }
+    }
+    m_enabled.store(enabled, std::memory_order_release);
+}
+
+SvcTrace::Scope SvcTrace::Begin(KernelCore& kernel, u32 svc) const {
+    const KThread& thread = GetCurrentThread(kernel);
+    Scope scope{
+        .start = std::chrono::steady_clock::now(),
+        .process_id = GetCurrentProcess(kernel).GetProcessId(),
+        .thread_id = thread.GetThreadId(),
+        .svc = svc,
+        .command = NoCommand,
+    };
+    if (static_cast<Svc::SvcId>(svc) == Svc::SvcId::SendSyncRequest) {
+        scope.command = ReadCommandId(GetCurrentMemory(kernel), GetInteger(thread.GetTlsAddress()));
+    }
+    return scope;
+}
+
+void SvcTrace::End(KernelCore& kernel, const Scope& scope) {
+    // The calling thread may have migrated, record on the core it returns on.
+    Ring& ring = *m_rings[kernel.CurrentPhysicalCoreIndex()];
+    const u64 index = ring.head.load(std::memory_order_relaxed);
+    Slot& slot = ring.slots[index % RingSize];
+
+    // Odd sequence numbers mark a slot that is being written.
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.entry = Entry{
+        .start_ns = NanosecondsBetween(m_epoch, scope.start),
+        .duration_ns = NanosecondsBetween(scope.start, std::chrono::steady_clock::now()),
+        .process_id = scope.process_id,
+        .thread_id = scope.thread_id,
+        .svc = scope.svc,
+        .command = scope.command,
+    };
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+std::vector<SvcTrace::Entry> SvcTrace::Collect() const {
+    std::vector<Entry> entries;
+    {
+        std::scoped_lock lk{m_mutex};
+        for (const auto& ring : m_rings) {
+            if (!ring) {
+                continue;
+            }
+            const u64 head = ring->head.load(std::memory_order_acquire);
+            for (u64 index = head - std::min<u64>(head, RingSize); index < head; ++index) {
+                const Slot& slot = ring->slots[index % RingSize];
+                const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+                const Entry entry = slot.entry;
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                // Skip records overwritten while they were copied.
+                if (sequence == index * 2 + 2 &&
+                    slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                    entries.push_back(entry);
+                }
+            }
+        }
+    }
+    std::ranges::sort(entries, {}, &Entry::start_ns);
+    return entries;
+}
+
+bool SvcTrace::ExportChromeTrace(const std::filesystem::path& path) const {
+    const std::vector<Entry> entries = Collect();
+
+    std::string json = "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Entry& entry = entries[i];
+        const char* const name = Svc::GetName(entry.svc);
+        json += fmt::format(R"({{"name":"{}","cat":"svc","ph":"X","ts":{:.3f},"dur":{:.3f},)"
+                            R"("pid":{},"tid":{},"args":{{"svc":{})",
+                            name != nullptr ? name : "Unknown", entry.start_ns / 1000.0,
+                            entry.duration_ns / 1000.0, entry.process_id, entry.thread_id,
+                            entry.svc);
+        if (entry.command != NoCommand) {
+            json += fmt::format(R"(,"command":{})", entry.command);
+        }
+        json += i + 1 < entries.size() ? "}},\n" : "}}\n";
+    }
+    json += "]}\n";
+
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, json) != json.size()) {
+        LOG_ERROR(Kernel, "Failed to write SVC trace to {}", path.string());
+        return false;
+    }
+    LOG_INFO(Kernel, "Wrote {} SVC trace records to {}", entries.size(), path.string());
+    return true;
+}
+
+} // namespace Kernel
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Kernel {
+
+class KernelCore;
+
+/**
+ * Host side trace of the supervisor calls made by guest threads.
+ *
+ * Every emulated core records into its own fixed size ring, so a record costs a handful of
+ * stores and never takes a lock. Older records are overwritten once a ring is full. Recording
+ * can be toggled at runtime, and the rings can be exported as a Chrome trace at any time.
+ */
+class SvcTrace {
+public:
+    /// Command id recorded for calls that are not IPC requests.
+    static constexpr u32 NoCommand = 0xFFFFFFFF;
+
+    struct Entry {
+        u64 start_ns;
+        u64 duration_ns;
+        u64 process_id;
+        u64 thread_id;
+        u32 svc;
+        u32 command;
+    };
+
+    /// State captured when a call begins, completed by End once it returns.
+    struct Scope {
+        std::chrono::steady_clock::time_point start;
+        u64 process_id;
+        u64 thread_id;
+        u32 svc;
+        u32 command;
+    };
+
+    SvcTrace();
+    ~SvcTrace();
+
+    bool IsEnabled() const {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    void SetEnabled(bool enabled);
+
+    Scope Begin(KernelCore& kernel, u32 svc) const;
+    void End(KernelCore& kernel, const Scope& scope);
+
+    /// Returns the records still held by the rings, ordered by start time.
+    std::vector<Entry> Collect() const;
+
+    /// Writes the records in the Chrome trace event format, one track per guest thread.
+    bool ExportChromeTrace(const std::filesystem::path& path) const;
+
+private:
+    static constexpr size_t RingSize = 64 * 1024;
+
+    struct Slot {
+        std::atomic<u64> sequence;
+        Entry entry;
+    };
+
+    struct Ring {
+        std::array<Slot, RingSize> slots{};
+        std::atomic<u64> head{};
+    };
+
+    // Guards allocating the rings against readers, recording never takes it.
+    mutable std::mutex m_mutex;
+    std::array<std::unique_ptr<Ring>, Core::Hardware::NUM_CPU_CORES> m_rings;
+    std::chrono::steady_clock::time_point m_epoch;
+    std::atomic<bool> m_enabled{};
+};
+
+} // namespace Kernel
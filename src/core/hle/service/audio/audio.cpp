@@ -27,9 +27,16 @@ void LoopProcess(Core::System& system) {
                                          std::make_shared<IFinalOutputRecorderManager>(system));
     server_manager->RegisterNamedService("audren:u",
                                          std::make_shared<IAudioRendererManager>(system));
-    server_manager->RegisterNamedService("hwopus",
-                                         std::make_shared<IHardwareOpusDecoderManager>(system));
     ServerManager::RunServer(std::move(server_manager));
+
+    // Opus decoding is slow enough to delay the other audio services, so hwopus gets its own
+    // server. Each decoder session is processed by one thread at a time, which keeps the order of
+    // its packets while different sessions decode in parallel.
+    auto opus_server_manager = std::make_unique<ServerManager>(system);
+    opus_server_manager->RegisterNamedService(
+        "hwopus", std::make_shared<IHardwareOpusDecoderManager>(system));
+    opus_server_manager->StartAdditionalHostThreads("hwopus", 2);
+    ServerManager::RunServer(std::move(opus_server_manager));
 }
 
 } // namespace Service::Audio
@@ -239,7 +239,19 @@ constexpr RequestLayout GetReplyOutLayout(bool is_domain) {
     return is_domain ? GetDomainReplyOutLayout<MethodArguments>() : GetNonDomainReplyOutLayout<MethodArguments>();
 }
 
-using OutTemporaryBuffers = std::array<Common::ScratchBuffer<u8>, 3>;
+using OutTemporaryBuffers = std::array<Common::PooledScratchBuffer<u8>, 3>;
+
+// Output buffers written through the B descriptor can be filled in place instead of through a temporary buffer.
+template <typename ArgType>
+bool CanWriteBufferInPlace(HLERequestContext& ctx, size_t buffer_index) {
+    if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
+        return ctx.CanWriteBuffer(buffer_index);
+    } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
+        return ctx.BufferDescriptorB().size() > buffer_index && ctx.BufferDescriptorB()[buffer_index].Size() != 0;
+    } else {
+        return false;
+    }
+}
 
 template <typename MethodArguments, typename CallArguments, size_t PrevAlign = 1, size_t DataOffset = 0, size_t HandleIndex = 0, size_t InBufferIndex = 0, size_t OutBufferIndex = 0, bool RawDataFinished = false, size_t ArgIndex = 0>
 void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLERequestContext& ctx, OutTemporaryBuffers& temp) {
@@ -338,12 +350,19 @@ void ReadInArgument(bool is_domain, CallArguments& args, const u8* raw_data, HLE
         } else if constexpr (ArgumentTraits<ArgType>::Type == ArgumentType::OutBuffer) {
             using ElementType = typename ArgType::Type;
 
-            // Set up scratch buffer.
-            auto& buffer = temp[OutBufferIndex];
-            if (ctx.CanWriteBuffer(OutBufferIndex)) {
-                buffer.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
+            std::span<u8> buffer;
+            if (CanWriteBufferInPlace<ArgType>(ctx, OutBufferIndex)) {
+                // Write to guest memory directly when it is contiguous.
+                buffer = ctx.WriteBufferSpan(OutBufferIndex);
             } else {
-                buffer.resize_destructive(0);
+                // Set up scratch buffer.
+                auto& scratch = temp[OutBufferIndex];
+                if (ctx.CanWriteBuffer(OutBufferIndex)) {
+                    scratch.resize_destructive(ctx.GetWriteBufferSize(OutBufferIndex));
+                } else {
+                    scratch.resize_destructive(0);
+                }
+                buffer = scratch;
             }
 
             ElementType* ptr = (ElementType*) buffer.data();
@@ -415,7 +434,10 @@ void WriteOutArgument(bool is_domain, CallArguments& args, u8* raw_data, HLERequ
             auto& buffer = temp[OutBufferIndex];
             const size_t size = buffer.size();
 
-            if (size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
+            if (CanWriteBufferInPlace<ArgType>(ctx, OutBufferIndex)) {
+                const auto& out = std::get<ArgIndex>(args);
+                ctx.CommitWriteBuffer(std::span<const u8>((const u8*) out.data(), out.size_bytes()), OutBufferIndex);
+            } else if (size > 0 && ctx.CanWriteBuffer(OutBufferIndex)) {
                 if constexpr (ArgType::Attr & BufferAttr_HipcAutoSelect) {
                     ctx.WriteBuffer(buffer.data(), size, OutBufferIndex);
                 } else if constexpr (ArgType::Attr & BufferAttr_HipcMapAlias) {
@@ -19,6 +19,7 @@
 #include "core/file_sys/sdmc_factory.h"
 #include "core/file_sys/vfs/vfs.h"
 #include "core/file_sys/vfs/vfs_offset.h"
+#include "core/file_sys/vfs/vfs_write_back.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/filesystem/fsp/fsp_ldr.h"
 #include "core/hle/service/filesystem/fsp/fsp_pr.h"
@@ -291,6 +292,15 @@ Result VfsDirectoryServiceWrapper::GetFileTimeStampRaw(
     return ResultSuccess;
 }
 
+Result VfsDirectoryServiceWrapper::Commit() const {
+    // Only save data buffers its writes, everything else is written through.
+    const auto write_back = std::dynamic_pointer_cast<FileSys::WriteBackVfsDirectory>(backing);
+    if (write_back != nullptr) {
+        write_back->Commit();
+    }
+    return ResultSuccess;
+}
+
 FileSystemController::FileSystemController(Core::System& system_) : system{system_} {}
 
 FileSystemController::~FileSystemController() = default;
@@ -728,6 +738,10 @@ void LoopProcess(Core::System& system) {
     server_manager->RegisterNamedService("fsp-ldr", std::make_shared<FSP_LDR>(system));
     server_manager->RegisterNamedService("fsp:pr", std::make_shared<FSP_PR>(system));
     server_manager->RegisterNamedService("fsp-srv", std::move(FileSystemProxyFactory));
+
+    // Every fsp-srv session owns its own handler, so a slow read on one session should not
+    // stall the others.
+    server_manager->StartAdditionalHostThreads("FS", 3);
     ServerManager::RunServer(std::move(server_manager));
 }
 
@@ -253,6 +253,12 @@ public:
     Result GetFileTimeStampRaw(FileSys::FileTimeStampRaw* out_time_stamp_raw,
                                const std::string& path) const;
 
+    /**
+     * Commit the writes buffered for the archive, if any
+     * @return Result of the operation
+     */
+    Result Commit() const;
+
 private:
     FileSys::VirtualDir backing;
 };
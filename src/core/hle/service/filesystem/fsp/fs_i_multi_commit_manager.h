@@ -3,11 +3,16 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "core/file_sys/vfs/vfs.h"
 #include "core/hle/service/service.h"
 
 namespace Service::FileSystem {
 
+class IFileSystem;
+
 class IMultiCommitManager final : public ServiceFramework<IMultiCommitManager> {
 public:
     explicit IMultiCommitManager(Core::System& system_);
@@ -17,7 +22,7 @@ private:
     Result Add(std::shared_ptr<IFileSystem> filesystem);
     Result Commit();
 
-    FileSys::VirtualFile backend;
+    std::vector<std::shared_ptr<IFileSystem>> filesystems;
 };
 
 } // namespace Service::FileSystem
@@ -450,6 +450,60 @@ std::size_t HLERequestContext::WriteBufferC(const void* buffer, std::size_t size
     return size;
 }
 
+std::span<u8> HLERequestContext::WriteBufferSpan(std::size_t buffer_index) const {
+    const std::size_t size{GetWriteBufferSize(buffer_index)};
+    if (size == 0) {
+        return {};
+    }
+
+    // Handlers may still read their input while writing, so never alias an input buffer
+    const u64 address{GetWriteBufferAddress(buffer_index)};
+    if (!OverlapsReadBuffer(address, size)) {
+        if (u8* const pointer = memory.GetWriteSpan(address, size)) {
+            return {pointer, size};
+        }
+    }
+
+    auto& buffer = write_buffer_data[buffer_index];
+    buffer.resize_destructive(size);
+    return buffer;
+}
+
+std::size_t HLERequestContext::CommitWriteBuffer(std::span<const u8> data,
+                                                 std::size_t buffer_index) const {
+    if (data.empty()) {
+        return 0;
+    }
+
+    if (data.data() == memory.GetPointerSilent(GetWriteBufferAddress(buffer_index))) {
+        // The data was written in place
+        return std::min(data.size(), GetWriteBufferSize(buffer_index));
+    }
+    return WriteBuffer(data.data(), data.size(), buffer_index);
+}
+
+u64 HLERequestContext::GetWriteBufferAddress(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return BufferDescriptorB()[buffer_index].Address();
+    }
+    if (BufferDescriptorC().size() > buffer_index) {
+        return BufferDescriptorC()[buffer_index].Address();
+    }
+    return 0;
+}
+
+bool HLERequestContext::OverlapsReadBuffer(u64 address, std::size_t size) const {
+    const auto overlaps = [address, size](const auto& descriptors) {
+        return std::ranges::any_of(descriptors, [address, size](const auto& descriptor) {
+            return descriptor.Size() != 0 && descriptor.Address() < address + size &&
+                   address < descriptor.Address() + descriptor.Size();
+        });
+    };
+    return overlaps(BufferDescriptorA()) || overlaps(BufferDescriptorX());
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
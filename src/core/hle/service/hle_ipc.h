@@ -281,6 +281,16 @@ public:
     std::size_t WriteBufferC(const void* buffer, std::size_t size,
                              std::size_t buffer_index = 0) const;
 
+    /// Helper function to get a span to fill in place for the appropriate write buffer
+    /// descriptor. The span views guest memory directly when the buffer is host contiguous and
+    /// does not alias a read buffer, otherwise it is backed by a scratch buffer. Either way it
+    /// must be passed to CommitWriteBuffer once filled.
+    [[nodiscard]] std::span<u8> WriteBufferSpan(std::size_t buffer_index = 0) const;
+
+    /// Helper function to complete a write to the appropriate buffer descriptor, copying only
+    /// when the data does not already live in the guest buffer
+    std::size_t CommitWriteBuffer(std::span<const u8> data, std::size_t buffer_index = 0) const;
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam T an arbitrary container that satisfies the
@@ -394,6 +404,12 @@ private:
 
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
+    /// Returns the guest address of the appropriate write buffer descriptor
+    [[nodiscard]] u64 GetWriteBufferAddress(std::size_t buffer_index) const;
+
+    /// Checks if a guest range overlaps any of the read buffer descriptors
+    [[nodiscard]] bool OverlapsReadBuffer(u64 address, std::size_t size) const;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     Kernel::KHandleTable* client_handle_table{};
@@ -429,8 +445,9 @@ private:
     Kernel::KernelCore& kernel;
     Core::Memory::Memory& memory;
 
-    mutable std::array<Common::ScratchBuffer<u8>, 3> read_buffer_data_a{};
-    mutable std::array<Common::ScratchBuffer<u8>, 3> read_buffer_data_x{};
+    mutable std::array<Common::PooledScratchBuffer<u8>, 3> read_buffer_data_a{};
+    mutable std::array<Common::PooledScratchBuffer<u8>, 3> read_buffer_data_x{};
+    mutable std::array<Common::PooledScratchBuffer<u8>, 3> write_buffer_data{};
 };
 
 } // namespace Service
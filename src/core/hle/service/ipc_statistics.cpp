@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/hle/service/ipc_statistics.h"
+
+namespace Service {
+namespace {
+/// Number of commands logged on shutdown, the dump file has all of them.
+constexpr size_t NumLoggedCommands = 10;
+
+/// Returns the upper bound in microseconds of the bucket holding the given fraction of calls.
+u64 Percentile(const IpcStatistics::Command& command, u64 calls, double fraction) {
+    const u64 target = std::max<u64>(1, static_cast<u64>(static_cast<double>(calls) * fraction));
+    u64 seen = 0;
+    for (size_t bucket = 0; bucket < IpcStatistics::NumBuckets; ++bucket) {
+        seen += command.buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return u64{1} << bucket;
+        }
+    }
+    return u64{1} << (IpcStatistics::NumBuckets - 1);
+}
+} // Anonymous namespace
+
+IpcStatistics::IpcStatistics(bool enabled) : m_enabled{enabled} {}
+
+IpcStatistics::~IpcStatistics() {
+    if (m_commands.empty()) {
+        return;
+    }
+    const std::string dump = Dump();
+    const auto path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) / "ipc_statistics.txt";
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, dump) != dump.size()) {
+        LOG_ERROR(Service, "Failed to write IPC statistics to {}", path.string());
+    }
+
+    // Log the head of the table, which holds the most expensive commands.
+    size_t line_end = 0;
+    for (size_t line = 0; line <= NumLoggedCommands && line_end != std::string::npos; ++line) {
+        line_end = dump.find('\n', line_end + 1);
+    }
+    LOG_INFO(Service, "IPC statistics, full table in {}:\n{}", path.string(),
+             dump.substr(0, line_end));
+}
+
+IpcStatistics::Command& IpcStatistics::Get(std::string_view service, std::string_view name,
+                                           u32 id, bool is_tipc) {
+    std::scoped_lock lk{m_mutex};
+    auto& command = m_commands[{std::string(service), std::string(name)}];
+    if (!command) {
+        command = std::make_unique<Command>();
+        command->service = service;
+        command->name = name;
+        command->id = id;
+        command->is_tipc = is_tipc;
+    }
+    return *command;
+}
+
+void IpcStatistics::Record(Command& command, u64 duration_ns) {
+    const size_t bucket =
+        std::min<size_t>(std::bit_width(duration_ns / 1000), NumBuckets - 1);
+    command.calls.fetch_add(1, std::memory_order_relaxed);
+    command.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    command.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    u64 max_ns = command.max_ns.load(std::memory_order_relaxed);
+    while (duration_ns > max_ns &&
+           !command.max_ns.compare_exchange_weak(max_ns, duration_ns, std::memory_order_relaxed)) {
+    }
+}
+
+std::string IpcStatistics::Dump() const {
+    std::vector<const Command*> commands;
+    {
+        std::scoped_lock lk{m_mutex};
+        commands.reserve(m_commands.size());
+        for (const auto& [key, command] : m_commands) {
+            commands.push_back(command.get());
+        }
+    }
+    std::ranges::sort(commands, [](const Command* lhs, const Command* rhs) {
+        return lhs->total_ns.load(std::memory_order_relaxed) >
+               rhs->total_ns.load(std::memory_order_relaxed);
+    });
+
+    std::string result = fmt::format("{:<48} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+                                     "command", "calls", "total ms", "mean us", "p50 us", "p99 us",
+                                     "max us");
+    for (const Command* command : commands) {
+        const u64 calls = command->calls.load(std::memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+        const u64 total_ns = command->total_ns.load(std::memory_order_relaxed);
+        const std::string label = fmt::format("{}{}:{} ({})", command->service,
+                                              command->is_tipc ? " tipc" : "", command->name,
+                                              command->id);
+        result += fmt::format("{:<48} {:>10} {:>10.3f} {:>10.3f} {:>10} {:>10} {:>10.3f}\n", label,
+                              calls, static_cast<double>(total_ns) / 1e6,
+                              static_cast<double>(total_ns) / 1e3 / static_cast<double>(calls),
+                              Percentile(*command, calls, 0.5), Percentile(*command, calls, 0.99),
+                              static_cast<double>(command->max_ns.load(std::memory_order_relaxed)) /
+                                  1e3);
+    }
+    return result;
+}
+
+} // namespace Service
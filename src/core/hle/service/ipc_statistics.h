@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "common/common_types.h"
+
+namespace Service {
+
+/**
+ * Host time spent in HLE command handlers, aggregated per service and command over every
+ * instance of the service. Latencies are kept in a histogram with power of two buckets.
+ */
+class IpcStatistics {
+public:
+    /// Bucket 0 holds calls under a microsecond, bucket N calls under 2^N microseconds.
+    static constexpr size_t NumBuckets = 24;
+
+    struct Command {
+        std::string service;
+        std::string name;
+        u32 id{};
+        bool is_tipc{};
+
+        std::atomic<u64> calls{};
+        std::atomic<u64> total_ns{};
+        std::atomic<u64> max_ns{};
+        std::array<std::atomic<u64>, NumBuckets> buckets{};
+    };
+
+    explicit IpcStatistics(bool enabled);
+    ~IpcStatistics();
+
+    bool IsEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool enabled) {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /// Returns the counters of a command, creating them on first use. The reference stays valid
+    /// for the lifetime of this object.
+    Command& Get(std::string_view service, std::string_view name, u32 id, bool is_tipc);
+
+    static void Record(Command& command, u64 duration_ns);
+
+    /// Formats every command that was called, sorted by total host time.
+    std::string Dump() const;
+
+private:
+    std::atomic<bool> m_enabled;
+    mutable std::mutex m_mutex;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Command>> m_commands;
+};
+
+} // namespace Service
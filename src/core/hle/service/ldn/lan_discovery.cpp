@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <bit>
+#include <cstddef>
+
 #include "core/hle/service/ldn/lan_discovery.h"
 #include "core/internal_network/network.h"
 #include "core/internal_network/network_interface.h"
@@ -297,7 +300,8 @@ Result LANDiscovery::Connect(const NetworkInfo& network_info_, const UserConfig&
     Ipv4Address node_host = network_info_.ldn.nodes[0].ipv4_address;
     std::reverse(std::begin(node_host), std::end(node_host)); // htonl
     host_ip = node_host;
-    SendPacket(Network::LDNPacketType::Connect, node_info, *host_ip);
+    const LanConnectRequest request{.node_info = node_info, .flags = ConnectFlagNetworkDelta};
+    SendPacket(Network::LDNPacketType::Connect, request, *host_ip);
 
     InitNodeStateChange();
 
@@ -364,6 +368,9 @@ void LANDiscovery::ResetStations() {
         station.Reset();
     }
     connected_clients.clear();
+    synced_clients.clear();
+    delta_clients.clear();
+    synced_network_info = {};
 }
 
 void LANDiscovery::UpdateNodes() {
@@ -377,13 +384,63 @@ void LANDiscovery::UpdateNodes() {
     }
     network_info.ldn.node_count = count + 1;
 
+    const bool info_changed =
+        std::memcmp(&network_info, &synced_network_info, sizeof(NetworkInfo)) != 0;
+    const std::vector<u8> delta = info_changed ? EncodeNetworkDelta() : std::vector<u8>{};
+    const auto contains = [](const std::vector<Ipv4Address>& clients, Ipv4Address local_ip) {
+        return std::find(clients.begin(), clients.end(), local_ip) != clients.end();
+    };
+
     for (auto local_ip : connected_clients) {
+        if (contains(synced_clients, local_ip)) {
+            // Clients that already hold the current network info need no update
+            if (!info_changed) {
+                continue;
+            }
+            if (!delta.empty() && contains(delta_clients, local_ip)) {
+                SendRawPacket(Network::LDNPacketType::SyncNetworkDelta, delta, local_ip);
+                continue;
+            }
+        } else {
+            synced_clients.push_back(local_ip);
+        }
         SendPacket(Network::LDNPacketType::SyncNetwork, network_info, local_ip);
     }
+    synced_network_info = network_info;
 
     OnNetworkInfoChanged();
 }
 
+std::vector<u8> LANDiscovery::EncodeNetworkDelta() const {
+    // Only node changes can be sent as a delta, anything else needs a full sync
+    NetworkInfo info = synced_network_info;
+    info.ldn.node_count = network_info.ldn.node_count;
+    info.ldn.nodes = network_info.ldn.nodes;
+    if (std::memcmp(&info, &network_info, sizeof(NetworkInfo)) != 0) {
+        return {};
+    }
+
+    LanNetworkDelta header{.node_count = network_info.ldn.node_count, .changed_nodes = 0};
+    std::vector<u8> delta(sizeof(header));
+    for (std::size_t i = 0; i < NodeCountMax; i++) {
+        const NodeInfo& node = network_info.ldn.nodes[i];
+        if (std::memcmp(&node, &synced_network_info.ldn.nodes[i], sizeof(NodeInfo)) == 0) {
+            continue;
+        }
+        header.changed_nodes |= static_cast<u8>(1U << i);
+        const auto* node_bytes = reinterpret_cast<const u8*>(&node);
+        delta.insert(delta.end(), node_bytes, node_bytes + sizeof(NodeInfo));
+    }
+    std::memcpy(delta.data(), &header, sizeof(header));
+    return delta;
+}
+
+void LANDiscovery::ForgetClient(Ipv4Address local_ip) {
+    for (auto* clients : {&connected_clients, &synced_clients, &delta_clients}) {
+        clients->erase(std::remove(clients->begin(), clients->end(), local_ip), clients->end());
+    }
+}
+
 void LANDiscovery::OnSyncNetwork(const NetworkInfo& info) {
     network_info = info;
     if (state == State::StationOpened) {
@@ -392,6 +449,32 @@ void LANDiscovery::OnSyncNetwork(const NetworkInfo& info) {
     OnNetworkInfoChanged();
 }
 
+void LANDiscovery::OnSyncNetworkDelta(std::span<const u8> data) {
+    LanNetworkDelta header{};
+    if (data.size() < sizeof(header)) {
+        LOG_ERROR(Service_LDN, "SyncNetworkDelta packet is too small");
+        return;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const auto num_nodes = static_cast<std::size_t>(std::popcount(header.changed_nodes));
+    if (data.size() != sizeof(header) + num_nodes * sizeof(NodeInfo)) {
+        LOG_ERROR(Service_LDN, "SyncNetworkDelta packet has an invalid size {}", data.size());
+        return;
+    }
+
+    std::size_t offset = sizeof(header);
+    for (std::size_t i = 0; i < NodeCountMax; i++) {
+        if ((header.changed_nodes & (1U << i)) == 0) {
+            continue;
+        }
+        std::memcpy(&network_info.ldn.nodes[i], data.data() + offset, sizeof(NodeInfo));
+        offset += sizeof(NodeInfo);
+    }
+    network_info.ldn.node_count = header.node_count;
+    OnNetworkInfoChanged();
+}
+
 void LANDiscovery::OnDisconnectFromHost() {
     LOG_INFO(Service_LDN, "OnDisconnectFromHost state: {}", static_cast<int>(state));
     host_ip = std::nullopt;
@@ -433,6 +516,19 @@ void LANDiscovery::SendPacket(Network::LDNPacketType type, const Data& data,
     SendPacket(packet);
 }
 
+void LANDiscovery::SendRawPacket(Network::LDNPacketType type, std::span<const u8> data,
+                                 Ipv4Address remote_ip) {
+    Network::LDNPacket packet;
+    packet.type = type;
+
+    packet.broadcast = false;
+    packet.local_ip = GetLocalIp();
+    packet.remote_ip = remote_ip;
+
+    packet.data.assign(data.begin(), data.end());
+    SendPacket(packet);
+}
+
 void LANDiscovery::SendPacket(Network::LDNPacketType type, Ipv4Address remote_ip) {
     Network::LDNPacket packet;
     packet.type = type;
@@ -501,8 +597,15 @@ void LANDiscovery::ReceivePacket(const Network::LDNPacket& packet) {
         NodeInfo info{};
         std::memcpy(&info, packet.data.data(), sizeof(NodeInfo));
 
+        ForgetClient(packet.local_ip);
         connected_clients.push_back(packet.local_ip);
 
+        // Older clients only send their NodeInfo and need full network syncs
+        if (packet.data.size() > offsetof(LanConnectRequest, flags) &&
+            (packet.data[offsetof(LanConnectRequest, flags)] & ConnectFlagNetworkDelta) != 0) {
+            delta_clients.push_back(packet.local_ip);
+        }
+
         for (LanStation& station : stations) {
             if (station.status != NodeStatus::Connected) {
                 *station.node_info = info;
@@ -518,9 +621,7 @@ void LANDiscovery::ReceivePacket(const Network::LDNPacket& packet) {
     case Network::LDNPacketType::Disconnect: {
         LOG_INFO(Frontend, "Disconnect packet received!");
 
-        connected_clients.erase(
-            std::remove(connected_clients.begin(), connected_clients.end(), packet.local_ip),
-            connected_clients.end());
+        ForgetClient(packet.local_ip);
 
         NodeInfo info{};
         std::memcpy(&info, packet.data.data(), sizeof(NodeInfo));
@@ -553,6 +654,17 @@ void LANDiscovery::ReceivePacket(const Network::LDNPacket& packet) {
 
         break;
     }
+    case Network::LDNPacketType::SyncNetworkDelta: {
+        // Deltas are relative to the full sync that moved the station into the connected state
+        if (state == State::StationConnected) {
+            LOG_DEBUG(Frontend, "SyncNetworkDelta packet received!");
+            OnSyncNetworkDelta(packet.data);
+        } else {
+            LOG_INFO(Frontend, "SyncNetworkDelta packet received but in wrong State!");
+        }
+
+        break;
+    }
     default: {
         LOG_INFO(Frontend, "ReceivePacket unhandled type {}", static_cast<int>(packet.type));
         break;
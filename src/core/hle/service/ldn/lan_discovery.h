@@ -13,6 +13,7 @@
 #include <span>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "common/logging/log.h"
 #include "common/socket_types.h"
@@ -25,6 +26,19 @@ namespace Service::LDN {
 
 class LANDiscovery;
 
+/// Payload of a Connect packet. Older clients only send the NodeInfo.
+struct LanConnectRequest {
+    NodeInfo node_info;
+    u8 flags;
+};
+
+/// Header of a SyncNetworkDelta packet, followed by the NodeInfo of every changed node.
+struct LanNetworkDelta {
+    u8 node_count;
+    u8 changed_nodes; ///< Bitmask of the nodes that follow, in node order
+};
+static_assert(NodeCountMax <= 8, "changed_nodes can not hold every node");
+
 class LanStation {
 public:
     LanStation(s8 node_id_, LANDiscovery* discovery_);
@@ -89,6 +103,7 @@ protected:
     void UpdateNodes();
 
     void OnSyncNetwork(const NetworkInfo& info);
+    void OnSyncNetworkDelta(std::span<const u8> data);
     void OnDisconnectFromHost();
     void OnNetworkInfoChanged();
 
@@ -99,10 +114,15 @@ protected:
     Result GetNodeInfo(NodeInfo& node, const UserConfig& user_config,
                        u16 local_communication_version);
 
+    std::vector<u8> EncodeNetworkDelta() const;
+    void ForgetClient(Ipv4Address local_ip);
+
     Network::IPv4Address GetLocalIp() const;
     template <typename Data>
     void SendPacket(Network::LDNPacketType type, const Data& data, Ipv4Address remote_ip);
     void SendPacket(Network::LDNPacketType type, Ipv4Address remote_ip);
+    void SendRawPacket(Network::LDNPacketType type, std::span<const u8> data,
+                       Ipv4Address remote_ip);
     template <typename Data>
     void SendBroadcast(Network::LDNPacketType type, const Data& data);
     void SendBroadcast(Network::LDNPacketType type);
@@ -110,6 +130,8 @@ protected:
 
     static const LanEventFunc empty_func;
     static constexpr Ssid fake_ssid{"YuzuFakeSsidForLdn"};
+    /// Set in LanConnectRequest::flags by clients that can apply SyncNetworkDelta packets
+    static constexpr u8 ConnectFlagNetworkDelta = 1 << 0;
 
     bool inited{};
     std::mutex packet_mutex;
@@ -124,6 +146,10 @@ protected:
 
     // TODO (flTobi): Should this be an std::set?
     std::vector<Ipv4Address> connected_clients;
+    /// Clients that hold synced_network_info, and those of them that understand delta updates
+    std::vector<Ipv4Address> synced_clients;
+    std::vector<Ipv4Address> delta_clients;
+    NetworkInfo synced_network_info{};
     std::optional<Ipv4Address> host_ip;
 
     LanEventFunc lan_event;
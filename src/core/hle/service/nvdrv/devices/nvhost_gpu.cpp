@@ -257,7 +257,7 @@ NvResult nvhost_gpu::SubmitGPFIFOImpl(IoctlSubmitGpfifo& params, Tegra::CommandL
         }
 
         if (!syncpoint_manager.IsFenceSignalled(params.fence)) {
-            gpu.PushGPUEntries(bind_id, Tegra::CommandList{BuildWaitCommandList(params.fence)});
+            entries.prefetch_command_list = BuildWaitCommandList(params.fence);
         }
     }
 
@@ -266,18 +266,19 @@ NvResult nvhost_gpu::SubmitGPFIFOImpl(IoctlSubmitGpfifo& params, Tegra::CommandL
     u32 increment{(flags.fence_increment.Value() != 0 ? 2 : 0) +
                   (flags.increment_value.Value() != 0 ? params.fence.value : 0)};
     params.fence.value = syncpoint_manager.IncrementSyncpointMaxExt(channel_syncpoint, increment);
-    gpu.PushGPUEntries(bind_id, std::move(entries));
 
     if (flags.fence_increment.Value()) {
         if (flags.suppress_wfi.Value()) {
-            gpu.PushGPUEntries(bind_id,
-                               Tegra::CommandList{BuildIncrementCommandList(params.fence)});
+            entries.epilogue_command_list = BuildIncrementCommandList(params.fence);
         } else {
-            gpu.PushGPUEntries(bind_id,
-                               Tegra::CommandList{BuildIncrementWithWfiCommandList(params.fence)});
+            entries.epilogue_command_list = BuildIncrementWithWfiCommandList(params.fence);
         }
     }
 
+    // The wait, the entries and the increment are handed to the GPU thread as one submission, so
+    // they are dispatched and flushed once instead of once per part.
+    gpu.PushGPUEntries(bind_id, std::move(entries));
+
     flags.raw = 0;
 
     return NvResult::Success;
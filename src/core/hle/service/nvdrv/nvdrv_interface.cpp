@@ -52,6 +52,16 @@ void NVDRV::ServiceError(HLERequestContext& ctx, NvResult result) {
     rb.PushEnum(result);
 }
 
+std::span<u8> NVDRV::GetOutputBuffer(HLERequestContext& ctx, Ioctl command,
+                                     std::size_t buffer_index,
+                                     Common::ScratchBuffer<u8>& discard_buffer) {
+    if (command.is_out != 0) {
+        return ctx.WriteBufferSpan(buffer_index);
+    }
+    discard_buffer.resize_destructive(ctx.GetWriteBufferSize(buffer_index));
+    return discard_buffer;
+}
+
 void NVDRV::Ioctl1(HLERequestContext& ctx) {
     IPC::RequestParser rp{ctx};
     const auto fd = rp.Pop<DeviceFD>();
@@ -65,12 +75,12 @@ void NVDRV::Ioctl1(HLERequestContext& ctx) {
     }
 
     // Check device
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
     const auto input_buffer = ctx.ReadBuffer(0);
+    const auto output = GetOutputBuffer(ctx, command, 0, output_buffer);
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.CommitWriteBuffer(output);
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -92,12 +102,11 @@ void NVDRV::Ioctl2(HLERequestContext& ctx) {
 
     const auto input_buffer = ctx.ReadBuffer(0);
     const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    const auto output = GetOutputBuffer(ctx, command, 0, output_buffer);
 
-    const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
+    const auto nv_result = nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.CommitWriteBuffer(output);
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -118,14 +127,13 @@ void NVDRV::Ioctl3(HLERequestContext& ctx) {
     }
 
     const auto input_buffer = ctx.ReadBuffer(0);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
-    inline_output_buffer.resize_destructive(ctx.GetWriteBufferSize(1));
+    const auto output = GetOutputBuffer(ctx, command, 0, output_buffer);
+    const auto inline_output = GetOutputBuffer(ctx, command, 1, inline_output_buffer);
 
-    const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, inline_output_buffer);
+    const auto nv_result = nvdrv->Ioctl3(fd, command, input_buffer, output, inline_output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(inline_output_buffer, 1);
+        ctx.CommitWriteBuffer(output, 0);
+        ctx.CommitWriteBuffer(inline_output, 1);
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
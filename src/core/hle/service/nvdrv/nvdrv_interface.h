@@ -35,6 +35,11 @@ private:
 
     void ServiceError(HLERequestContext& ctx, NvResult result);
 
+    /// Returns where an ioctl writes its output, in place in the guest buffer when possible.
+    /// Output of ioctls without the out flag is discarded into the given scratch buffer.
+    std::span<u8> GetOutputBuffer(HLERequestContext& ctx, Ioctl command, std::size_t buffer_index,
+                                  Common::ScratchBuffer<u8>& discard_buffer);
+
     std::shared_ptr<Module> nvdrv;
 
     u64 pid{};
@@ -42,8 +42,8 @@ s32 NormalizeSwapInterval(f32* out_speed_scale, s32 swap_interval) {
 HardwareComposer::HardwareComposer() = default;
 HardwareComposer::~HardwareComposer() = default;
 
-u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, Display& display,
-                                    Nvidia::Devices::nvdisp_disp0& nvdisp) {
+u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, bool* out_has_new_frame,
+                                    Display& display, Nvidia::Devices::nvdisp_disp0& nvdisp) {
     boost::container::small_vector<HwcLayer, 2> composition_stack;
 
     // Set default speed limit to 100%.
@@ -106,6 +106,7 @@ u32 HardwareComposer::ComposeLocked(f32* out_speed_scale, Display& display,
     }
 
     // If any new buffers were acquired, we can present.
+    *out_has_new_frame = has_acquired_buffer;
     if (has_acquired_buffer) {
         // Sort by Z-index.
         std::stable_sort(composition_stack.begin(), composition_stack.end(),
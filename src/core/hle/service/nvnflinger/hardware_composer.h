@@ -21,7 +21,7 @@ public:
     explicit HardwareComposer();
     ~HardwareComposer();
 
-    u32 ComposeLocked(f32* out_speed_scale, Display& display,
+    u32 ComposeLocked(f32* out_speed_scale, bool* out_has_new_frame, Display& display,
                       Nvidia::Devices::nvdisp_disp0& nvdisp);
     void RemoveLayerLocked(Display& display, ConsumerId consumer_id);
 
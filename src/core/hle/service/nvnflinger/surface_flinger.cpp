@@ -34,14 +34,14 @@ void SurfaceFlinger::RemoveDisplay(u64 display_id) {
 }
 
 bool SurfaceFlinger::ComposeDisplay(s32* out_swap_interval, f32* out_compose_speed_scale,
-                                    u64 display_id) {
+                                    bool* out_has_new_frame, u64 display_id) {
     auto* const display = this->FindDisplay(display_id);
     if (!display || !display->stack.HasLayers()) {
         return false;
     }
 
     *out_swap_interval =
-        m_composer.ComposeLocked(out_compose_speed_scale, *display,
+        m_composer.ComposeLocked(out_compose_speed_scale, out_has_new_frame, *display,
                                  *nvdrv->GetDevice<Nvidia::Devices::nvdisp_disp0>(disp_fd));
     return true;
 }
@@ -34,7 +34,8 @@ public:
 
     void AddDisplay(u64 display_id);
     void RemoveDisplay(u64 display_id);
-    bool ComposeDisplay(s32* out_swap_interval, f32* out_compose_speed_scale, u64 display_id);
+    bool ComposeDisplay(s32* out_swap_interval, f32* out_compose_speed_scale,
+                        bool* out_has_new_frame, u64 display_id);
 
     void CreateLayer(s32 consumer_binder_id);
     void DestroyLayer(s32 consumer_binder_id);
@@ -48,6 +48,13 @@ public:
     Result ManageDeferral(Kernel::KEvent** out_event);
 
     Result LoopProcess();
+
+    /**
+     * Spawns host threads that process requests alongside the one running LoopProcess.
+     * A session is unlinked from the wait list while its request is handled, so requests of a
+     * single session stay in order, but different sessions may be handled concurrently. Only
+     * use this for servers whose handlers are safe to call from several threads.
+     */
     void StartAdditionalHostThreads(const char* name, size_t num_threads);
 
     static void RunServer(std::unique_ptr<ServerManager>&& server);
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <chrono>
+
 #include <fmt/format.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -42,22 +45,39 @@ ServiceFrameworkBase::~ServiceFrameworkBase() {
     const auto guard = LockService();
 }
 
-void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
+void ServiceFrameworkBase::HandlerTable::Register(const FunctionInfoBase* functions,
+                                                  std::size_t n) {
+    // Ids up to this many times the number of handlers are dispatched through a flat table
+    static constexpr std::size_t DenseFactor = 4;
+    static constexpr std::size_t MinDenseSize = 256;
+
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
         // Usually this array is sorted by id already, so hint to insert at the end
         handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
     }
+
+    // Rebuild the table, as inserting may have moved the handlers
+    dense.clear();
+    const std::size_t max_command = handlers.empty() ? 0 : handlers.rbegin()->first;
+    is_dense = !handlers.empty() &&
+               max_command < std::max(MinDenseSize, handlers.size() * DenseFactor);
+    if (!is_dense) {
+        return;
+    }
+    dense.resize(max_command + 1);
+    for (const auto& [command, info] : handlers) {
+        dense[command] = &info;
+    }
+}
+
+void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
+    handlers.Register(functions, n);
 }
 
 void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* functions,
                                                     std::size_t n) {
-    handlers_tipc.reserve(handlers_tipc.size() + n);
-    for (std::size_t i = 0; i < n; ++i) {
-        // Usually this array is sorted by id already, so hint to insert at the end
-        handlers_tipc.emplace_hint(handlers_tipc.cend(), functions[i].expected_header,
-                                   functions[i]);
-    }
+    handlers_tipc.Register(functions, n);
 }
 
 void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
@@ -84,28 +104,50 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
 }
 
 void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
-    auto itr = handlers.find(ctx.GetCommand());
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
+    const FunctionInfoBase* info = handlers.Find(ctx.GetCommand());
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    Invoke(ctx, info, false);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
-    boost::container::flat_map<u32, FunctionInfoBase>::iterator itr;
-
-    itr = handlers_tipc.find(ctx.GetCommand());
-
-    const FunctionInfoBase* info = itr == handlers_tipc.end() ? nullptr : &itr->second;
+    const FunctionInfoBase* info = handlers_tipc.Find(ctx.GetCommand());
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
+    Invoke(ctx, info, true);
+}
+
+void ServiceFrameworkBase::Invoke(HLERequestContext& ctx, const FunctionInfoBase* info,
+                                  bool is_tipc) {
+    IpcStatistics& ipc_statistics = system.ServiceManager().GetIpcStatistics();
+    if (!ipc_statistics.IsEnabled()) {
+        handler_invoker(this, info->handler_callback, ctx);
+        return;
+    }
+
+    IpcStatistics::Command* command;
+    {
+        // Some services don't lock themselves, so the cache needs its own lock
+        std::scoped_lock lk{statistics_lock};
+        auto& entry = statistics[info];
+        if (entry == nullptr) {
+            entry = &ipc_statistics.Get(service_name, info->name, info->expected_header, is_tipc);
+        }
+        command = entry;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
     handler_invoker(this, info->handler_callback, ctx);
+    const auto duration = std::chrono::steady_clock::now() - start;
+    IpcStatistics::Record(
+        *command,
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
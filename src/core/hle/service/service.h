@@ -6,9 +6,11 @@
 #include <cstddef>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/service/hle_ipc.h"
+#include "core/hle/service/ipc_statistics.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Namespace Service
@@ -97,6 +99,26 @@ private:
     using InvokerFn = void(ServiceFrameworkBase* object, HandlerFnP<ServiceFrameworkBase> member,
                            HLERequestContext& ctx);
 
+    /// Handlers of one protocol. Lookups go through a table indexed by command id when the ids
+    /// are dense enough, and through a binary search otherwise.
+    class HandlerTable {
+    public:
+        void Register(const FunctionInfoBase* functions, std::size_t n);
+
+        [[nodiscard]] const FunctionInfoBase* Find(u32 command) const {
+            if (is_dense) {
+                return command < dense.size() ? dense[command] : nullptr;
+            }
+            const auto itr = handlers.find(command);
+            return itr == handlers.end() ? nullptr : &itr->second;
+        }
+
+    private:
+        boost::container::flat_map<u32, FunctionInfoBase> handlers;
+        std::vector<const FunctionInfoBase*> dense;
+        bool is_dense{};
+    };
+
     explicit ServiceFrameworkBase(Core::System& system_, const char* service_name_,
                                   u32 max_sessions_, InvokerFn* handler_invoker_);
     ~ServiceFrameworkBase() override;
@@ -105,6 +127,9 @@ private:
     void RegisterHandlersBaseTipc(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(HLERequestContext& ctx, const FunctionInfoBase* info);
 
+    /// Runs a handler, timing it when IPC statistics are enabled.
+    void Invoke(HLERequestContext& ctx, const FunctionInfoBase* info, bool is_tipc);
+
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
 
@@ -114,11 +139,15 @@ private:
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers_tipc;
+    HandlerTable handlers;
+    HandlerTable handlers_tipc;
 
     /// Used to gain exclusive access to the service members, e.g. from CoreTiming thread.
     std::mutex lock_service;
+
+    /// Statistics entries of the handlers called so far, looked up once per handler.
+    std::mutex statistics_lock;
+    boost::container::flat_map<const FunctionInfoBase*, IpcStatistics::Command*> statistics;
 };
 
 /**
@@ -4,6 +4,7 @@
 #include <tuple>
 #include "common/assert.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_client_port.h"
 #include "core/hle/kernel/k_client_session.h"
@@ -23,7 +24,8 @@ constexpr Result ResultAlreadyRegistered(ErrorModule::SM, 4);
 constexpr Result ResultInvalidServiceName(ErrorModule::SM, 6);
 constexpr Result ResultNotRegistered(ErrorModule::SM, 7);
 
-ServiceManager::ServiceManager(Kernel::KernelCore& kernel_) : kernel{kernel_} {
+ServiceManager::ServiceManager(Kernel::KernelCore& kernel_)
+    : ipc_statistics{Settings::values.enable_ipc_statistics.GetValue()}, kernel{kernel_} {
     controller_interface = std::make_unique<Controller>(kernel.System());
 }
 
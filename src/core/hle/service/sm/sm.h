@@ -13,6 +13,7 @@
 #include "core/hle/kernel/k_port.h"
 #include "core/hle/kernel/svc.h"
 #include "core/hle/result.h"
+#include "core/hle/service/ipc_statistics.h"
 #include "core/hle/service/service.h"
 
 namespace Core {
@@ -88,7 +89,14 @@ public:
         deferral_event = deferral_event_;
     }
 
+    IpcStatistics& GetIpcStatistics() {
+        return ipc_statistics;
+    }
+
 private:
+    /// Declared first so it outlives the services owned here, it dumps itself on destruction.
+    IpcStatistics ipc_statistics;
+
     std::shared_ptr<SM> sm_interface;
     std::unique_ptr<Controller> controller_interface;
 
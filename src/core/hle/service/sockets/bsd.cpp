@@ -577,7 +577,7 @@ std::pair<s32, Errno> BSD::PollImpl(std::vector<u8>& write_buffer, std::span<con
         return result;
     });
 
-    const auto result = Network::Poll(host_pollfds, timeout);
+    const auto result = poll_set.Poll(host_pollfds, timeout);
 
     const size_t num = host_pollfds.size();
     for (size_t i = 0; i < num; ++i) {
@@ -897,6 +897,7 @@ Errno BSD::CloseImpl(s32 fd) {
         return Errno::BADF;
     }
 
+    poll_set.Remove(*file_descriptors[fd]->socket);
     const Errno bsd_errno = Translate(file_descriptors[fd]->socket->Close());
     if (bsd_errno != Errno::SUCCESS) {
         return bsd_errno;
@@ -12,6 +12,7 @@
 #include "common/socket_types.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sockets/sockets.h"
+#include "core/internal_network/sockets.h"
 #include "network/network.h"
 
 namespace Core {
@@ -179,6 +180,9 @@ private:
 
     std::array<std::optional<FileDescriptor>, MAX_FD> file_descriptors;
 
+    /// Host sockets polled by the guest, kept registered between polls
+    Network::PollSet poll_set;
+
     Network::RoomNetwork& room_network;
 
     /// Callback to parse and handle a received wifi packet.
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -8,9 +11,16 @@
 #include "core/hle/service/vi/container.h"
 #include "core/hle/service/vi/display_list.h"
 #include "core/hle/service/vi/vsync_manager.h"
+#include "video_core/gpu.h"
 
 constexpr auto FrameNs = std::chrono::nanoseconds{1000000000 / 60};
 
+// Host presents older than this mean the display isn't being fed, and can't be paced against.
+constexpr auto MaxPresentAge = std::chrono::milliseconds{100};
+
+// Longest the vsync period is stretched to follow a slow guest in VRR pacing.
+constexpr f32 MaxVrrPeriodScale = 2.0f;
+
 namespace Service::VI {
 
 Conductor::Conductor(Core::System& system, Container& container, DisplayList& displays)
@@ -65,10 +75,15 @@ void Conductor::UnlinkVsyncEvent(u64 display_id, Event* event) {
 }
 
 void Conductor::ProcessVsync() {
+    bool has_new_frame{};
     for (auto& [display_id, manager] : m_vsync_managers) {
-        m_container.ComposeOnDisplay(&m_swap_interval, &m_compose_speed_scale, display_id);
+        bool display_has_new_frame{};
+        m_container.ComposeOnDisplay(&m_swap_interval, &m_compose_speed_scale,
+                                     &display_has_new_frame, display_id);
+        has_new_frame |= display_has_new_frame;
         manager.SignalVsync();
     }
+    this->UpdateVrrPacing(has_new_frame);
 }
 
 void Conductor::VsyncThread(std::stop_token token) {
@@ -108,7 +123,71 @@ s64 Conductor::GetNextTicks() const {
     }
 
     const f32 effective_fps = 60.f / static_cast<f32>(m_swap_interval);
-    return static_cast<s64>(speed_scale * (1000000000.f / effective_fps));
+    const auto period = static_cast<s64>(speed_scale * (1000000000.f / effective_fps));
+
+    // Pacing only applies when running at the intended speed.
+    if (speed_scale != 1.f) {
+        return period;
+    }
+    switch (settings.frame_pacing.GetValue()) {
+    case Settings::FramePacing::Display:
+        return this->PaceToDisplay(period);
+    case Settings::FramePacing::Vrr:
+        return static_cast<s64>(static_cast<f32>(period) *
+                                m_vrr_period_scale.load(std::memory_order_relaxed));
+    default:
+        return period;
+    }
+}
+
+s64 Conductor::PaceToDisplay(s64 period) const {
+    const auto [last_present, present_interval] = m_system.GPU().GetHostPresentTiming();
+    const auto now = std::chrono::steady_clock::now();
+    const s64 interval =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(present_interval).count();
+
+    // Only follow the display while it presents at the guest cadence, a different cadence means
+    // the host refresh rate is not a multiple of the guest one and presents can't line up.
+    if (interval == 0 || now - last_present > MaxPresentAge ||
+        std::abs(interval - period) > period / 50) {
+        return period;
+    }
+
+    // Run vsync at the rate the display takes frames, so they are neither dropped nor repeated
+    // as the host and guest clocks drift apart.
+    s64 next_period = interval;
+
+    // When presents wait for vblank, also nudge the phase so composition lands right after a
+    // present, leaving the whole refresh for the frame to reach the display.
+    const auto vsync_mode = Settings::values.vsync_mode.GetValue();
+    if (vsync_mode == Settings::VSyncMode::Fifo || vsync_mode == Settings::VSyncMode::FifoRelaxed) {
+        const s64 since_present =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_present).count();
+        s64 phase = (since_present + next_period) % interval;
+        if (phase > interval / 2) {
+            phase -= interval;
+        }
+        next_period -= std::clamp(phase / 8, -interval / 100, interval / 100);
+    }
+    return next_period;
+}
+
+void Conductor::UpdateVrrPacing(bool has_new_frame) {
+    // A guest falling behind misses vsyncs, and its frames land unevenly on the vsync grid.
+    // Stretch the period on each miss and shrink it slowly while frames keep coming, so vsync
+    // and with it the host present interval settles at the guest frame time. A variable refresh
+    // display then shows each frame for the same time.
+    f32 scale = m_vrr_period_scale.load(std::memory_order_relaxed);
+    if (has_new_frame) {
+        m_missed_vsyncs = 0;
+        scale = std::max(1.0f, scale * 0.998f);
+    } else if (++m_missed_vsyncs > 3) {
+        // The guest stopped presenting, a static screen is not a slow frame.
+        scale = 1.0f;
+    } else {
+        scale = std::min(MaxVrrPeriodScale, scale * 1.02f);
+    }
+    m_vrr_period_scale.store(scale, std::memory_order_relaxed);
 }
 
 } // namespace Service::VI
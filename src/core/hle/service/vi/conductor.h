@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
@@ -41,6 +42,8 @@ private:
     void ProcessVsync();
     void VsyncThread(std::stop_token token);
     s64 GetNextTicks() const;
+    s64 PaceToDisplay(s64 period) const;
+    void UpdateVrrPacing(bool has_new_frame);
 
 private:
     Core::System& m_system;
@@ -53,6 +56,11 @@ private:
 private:
     s32 m_swap_interval = 1;
     f32 m_compose_speed_scale = 1.0f;
+
+    /// Factor the vsync period is stretched by to follow the guest frame time in VRR pacing
+    std::atomic<f32> m_vrr_period_scale = 1.0f;
+    /// Number of consecutive vsyncs without a new guest frame
+    u32 m_missed_vsyncs = 0;
 };
 
 } // namespace Service::VI
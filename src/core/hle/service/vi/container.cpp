@@ -217,10 +217,10 @@ Result Container::CloseLayerLocked(u64 layer_id) {
 }
 
 bool Container::ComposeOnDisplay(s32* out_swap_interval, f32* out_compose_speed_scale,
-                                 u64 display_id) {
+                                 bool* out_has_new_frame, u64 display_id) {
     std::scoped_lock lk{m_lock};
     return m_surface_flinger->ComposeDisplay(out_swap_interval, out_compose_speed_scale,
-                                             display_id);
+                                             out_has_new_frame, display_id);
 }
 
 } // namespace Service::VI
@@ -73,7 +73,8 @@ private:
     Result CloseLayerLocked(u64 layer_id);
 
 public:
-    bool ComposeOnDisplay(s32* out_swap_interval, f32* out_compose_speed_scale, u64 display_id);
+    bool ComposeOnDisplay(s32* out_swap_interval, f32* out_compose_speed_scale,
+                          bool* out_has_new_frame, u64 display_id);
 
 private:
     std::mutex m_lock{};
@@ -401,7 +401,7 @@ Result SharedBufferManager::GetSharedFrameBufferAcquirableEvent(Kernel::KReadabl
 
 Result SharedBufferManager::WriteAppletCaptureBuffer(bool* out_was_written, s32* out_layer_index) {
     std::vector<u8> capture_buffer(m_system.GPU().GetAppletCaptureBuffer());
-    Common::ScratchBuffer<u32> scratch;
+    Common::PooledScratchBuffer<u32> scratch;
 
     // TODO: this could be optimized
     s64 e = -1280 * 768 * 4;
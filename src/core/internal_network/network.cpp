@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -21,6 +22,9 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #else
 #error "Unimplemented platform"
 #endif
@@ -645,6 +649,163 @@ std::pair<s32, Errno> Poll(std::vector<PollFD>& pollfds, s32 timeout) {
     return {-1, GetAndLogLastError()};
 }
 
+#ifdef __linux__
+
+static_assert(EPOLLIN == POLLIN && EPOLLPRI == POLLPRI && EPOLLOUT == POLLOUT &&
+                  EPOLLERR == POLLERR && EPOLLHUP == POLLHUP && EPOLLRDNORM == POLLRDNORM &&
+                  EPOLLRDBAND == POLLRDBAND && EPOLLWRBAND == POLLWRBAND,
+              "Poll events can not be used as epoll events");
+
+struct PollSet::Impl {
+    struct Registration {
+        const SocketBase* socket;
+        u32 events;
+        u64 last_poll;
+    };
+
+    Impl() : epoll_fd{epoll_create1(EPOLL_CLOEXEC)} {
+        if (epoll_fd < 0) {
+            LOG_ERROR(Network, "Failed to create epoll instance, falling back to poll");
+        }
+    }
+
+    ~Impl() {
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+    }
+
+    /// Keeps the interrupt socket registered, it is recreated when the network is restarted
+    bool RegisterInterrupt() {
+        const SOCKET fd = GetInterruptSocket();
+        if (fd == interrupt_fd) {
+            return true;
+        }
+        if (interrupt_fd >= 0) {
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, interrupt_fd, nullptr);
+            interrupt_fd = -1;
+        }
+        epoll_event event{.events = EPOLLIN, .data = {.fd = fd}};
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            return false;
+        }
+        interrupt_fd = fd;
+        return true;
+    }
+
+    bool Register(SOCKET fd, const SocketBase* socket, u32 events) {
+        auto [it, inserted] = registrations.try_emplace(fd);
+        Registration& registration = it->second;
+        registration.last_poll = poll_count;
+        if (!inserted && registration.socket == socket && registration.events == events) {
+            return true;
+        }
+
+        epoll_event event{.events = events, .data = {.fd = fd}};
+        const int op = inserted ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+        if (epoll_ctl(epoll_fd, op, fd, &event) != 0) {
+            // The descriptor may have been closed and reused without being removed from the set
+            const bool stale = inserted ? errno == EEXIST : errno == ENOENT;
+            const int retry_op = inserted ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+            if (!stale || epoll_ctl(epoll_fd, retry_op, fd, &event) != 0) {
+                registrations.erase(it);
+                return false;
+            }
+        }
+        registration.socket = socket;
+        registration.events = events;
+        return true;
+    }
+
+    void Unregister(SOCKET fd) {
+        if (registrations.erase(fd) != 0) {
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+
+    int epoll_fd;
+    SOCKET interrupt_fd = -1;
+    u64 poll_count = 0;
+    std::unordered_map<SOCKET, Registration> registrations;
+    std::unordered_map<SOCKET, std::size_t> requested;
+    std::vector<epoll_event> ready_events;
+};
+
+PollSet::PollSet() : impl{std::make_unique<Impl>()} {}
+
+PollSet::~PollSet() = default;
+
+std::pair<s32, Errno> PollSet::Poll(std::vector<PollFD>& poll_fds, s32 timeout) {
+    if (impl->epoll_fd < 0 || !impl->RegisterInterrupt()) {
+        return Network::Poll(poll_fds, timeout);
+    }
+
+    ++impl->poll_count;
+    impl->requested.clear();
+    for (std::size_t i = 0; i < poll_fds.size(); ++i) {
+        PollFD& poll_fd = poll_fds[i];
+        poll_fd.revents = PollEvents{};
+
+        // Sockets without a host descriptor, or polled more than once, need a regular poll
+        const SOCKET fd = poll_fd.socket->GetFD();
+        const auto events = static_cast<u32>(TranslatePollEvents(poll_fd.events)) & ~POLLNVAL;
+        if (fd == SocketBase::INVALID_SOCKET || !impl->requested.emplace(fd, i).second ||
+            !impl->Register(fd, poll_fd.socket, events)) {
+            return Network::Poll(poll_fds, timeout);
+        }
+    }
+
+    // Sockets that are not polled anymore would wake up the wait without being reported
+    std::erase_if(impl->registrations, [this](const auto& entry) {
+        if (entry.second.last_poll == impl->poll_count) {
+            return false;
+        }
+        epoll_ctl(impl->epoll_fd, EPOLL_CTL_DEL, entry.first, nullptr);
+        return true;
+    });
+
+    impl->ready_events.resize(poll_fds.size() + 1);
+    const int result = epoll_wait(impl->epoll_fd, impl->ready_events.data(),
+                                  static_cast<int>(impl->ready_events.size()), timeout);
+    if (result < 0) {
+        return {-1, GetAndLogLastError()};
+    }
+
+    s32 num_ready = 0;
+    for (int i = 0; i < result; ++i) {
+        const epoll_event& event = impl->ready_events[i];
+        const auto it = impl->requested.find(event.data.fd);
+        if (it == impl->requested.end()) {
+            continue; // Interrupt socket
+        }
+        poll_fds[it->second].revents = TranslatePollRevents(static_cast<short>(event.events));
+        ++num_ready;
+    }
+    return {num_ready, Errno::SUCCESS};
+}
+
+void PollSet::Remove(const SocketBase& socket) {
+    if (impl->epoll_fd >= 0) {
+        impl->Unregister(socket.GetFD());
+    }
+}
+
+#else
+
+struct PollSet::Impl {};
+
+PollSet::PollSet() = default;
+
+PollSet::~PollSet() = default;
+
+std::pair<s32, Errno> PollSet::Poll(std::vector<PollFD>& poll_fds, s32 timeout) {
+    return Network::Poll(poll_fds, timeout);
+}
+
+void PollSet::Remove(const SocketBase&) {}
+
+#endif
+
 Socket::~Socket() {
     if (fd == INVALID_SOCKET) {
         return;
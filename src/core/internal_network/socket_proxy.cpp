@@ -38,11 +38,16 @@ void ProxySocket::HandleProxyPacket(const ProxyPacket& packet) {
         return;
     }
 
-    auto decompressed = packet;
-    decompressed.data = Common::Compression::DecompressDataZSTD(packet.data);
-
-    std::lock_guard guard(packets_mutex);
-    received_packets.push(decompressed);
+    ProxyPacket decompressed{
+        .local_endpoint = packet.local_endpoint,
+        .remote_endpoint = packet.remote_endpoint,
+        .protocol = packet.protocol,
+        .broadcast = packet.broadcast,
+        .data = Common::Compression::DecompressDataZSTD(packet.data),
+    };
+    if (!received_packets.TryEmplace(std::move(decompressed))) {
+        LOG_WARNING(Network, "Receive queue is full, dropping packet");
+    }
 }
 
 template <typename T>
@@ -86,6 +91,13 @@ Errno ProxySocket::Bind(SockAddrIn addr) {
     local_endpoint = addr;
     is_bound = true;
 
+    // If the ip is all zeroes (INADDR_ANY) or if it matches the hosts ip address, packets are
+    // sent from a "fake" routing address instead
+    const auto& ip = local_endpoint.ip;
+    const auto ipv4 = Network::GetHostIPv4Address();
+    use_fake_ip =
+        std::all_of(ip.begin(), ip.end(), [](u8 i) { return i == 0; }) || (ipv4 && ipv4 == ip);
+
     return Errno::SUCCESS;
 }
 
@@ -119,8 +131,14 @@ std::pair<s32, Errno> ProxySocket::RecvFrom(int flags, std::span<u8> message, So
     const auto timeout = receive_timeout == 0 ? 5000 : receive_timeout;
     while (true) {
         {
-            std::lock_guard guard(packets_mutex);
-            if (received_packets.size() > 0) {
+            std::lock_guard guard(receive_mutex);
+            if (!pending_packet) {
+                ProxyPacket packet;
+                if (received_packets.TryPop(packet)) {
+                    pending_packet = std::move(packet);
+                }
+            }
+            if (pending_packet) {
                 return ReceivePacket(flags, message, addr, message.size());
             }
         }
@@ -143,7 +161,7 @@ std::pair<s32, Errno> ProxySocket::RecvFrom(int flags, std::span<u8> message, So
 
 std::pair<s32, Errno> ProxySocket::ReceivePacket(int flags, std::span<u8> message, SockAddrIn* addr,
                                                  std::size_t max_length) {
-    ProxyPacket& packet = received_packets.front();
+    ProxyPacket& packet = *pending_packet;
     if (addr) {
         addr->family = Domain::INET;
         addr->ip = packet.local_endpoint.ip;         // The senders ip address
@@ -158,7 +176,7 @@ std::pair<s32, Errno> ProxySocket::ReceivePacket(int flags, std::span<u8> messag
 
         if (protocol == Protocol::UDP) {
             if (!peek) {
-                received_packets.pop();
+                pending_packet.reset();
             }
             return {-1, Errno::MSGSIZE};
         } else if (protocol == Protocol::TCP) {
@@ -171,7 +189,7 @@ std::pair<s32, Errno> ProxySocket::ReceivePacket(int flags, std::span<u8> messag
         read_bytes = packet.data.size();
         memcpy(message.data(), packet.data.data(), read_bytes);
         if (!peek) {
-            received_packets.pop();
+            pending_packet.reset();
         }
     }
 
@@ -186,11 +204,11 @@ std::pair<s32, Errno> ProxySocket::Send(std::span<const u8> message, int flags)
     return {static_cast<s32>(0), Errno::SUCCESS};
 }
 
-void ProxySocket::SendPacket(ProxyPacket& packet) {
+void ProxySocket::SendPacket(ProxyPacket& packet, std::span<const u8> message) {
     if (auto room_member = room_network.GetRoomMember().lock()) {
         if (room_member->IsConnected()) {
-            packet.data = Common::Compression::CompressDataZSTDDefault(packet.data.data(),
-                                                                       packet.data.size());
+            // Datagrams are small and sent often, favor latency over compression ratio
+            packet.data = Common::Compression::CompressDataZSTD(message.data(), message.size(), 1);
             room_member->SendProxyPacket(packet);
         }
     }
@@ -217,20 +235,13 @@ std::pair<s32, Errno> ProxySocket::SendTo(u32 flags, std::span<const u8> message
     packet.protocol = protocol;
     packet.broadcast = broadcast && packet.remote_endpoint.ip[3] == 255;
 
-    auto& ip = local_endpoint.ip;
-    auto ipv4 = Network::GetHostIPv4Address();
-    // If the ip is all zeroes (INADDR_ANY) or if it matches the hosts ip address,
-    // replace it with a "fake" routing address
-    if (std::all_of(ip.begin(), ip.end(), [](u8 i) { return i == 0; }) || (ipv4 && ipv4 == ip)) {
+    if (use_fake_ip) {
         if (auto room_member = room_network.GetRoomMember().lock()) {
             packet.local_endpoint.ip = room_member->GetFakeIpAddress();
         }
     }
 
-    packet.data.clear();
-    std::copy(message.begin(), message.end(), std::back_inserter(packet.data));
-
-    SendPacket(packet);
+    SendPacket(packet, message);
 
     return {static_cast<s32>(message.size()), Errno::SUCCESS};
 }
@@ -4,10 +4,11 @@
 #pragma once
 
 #include <mutex>
+#include <optional>
 #include <span>
 #include <vector>
-#include <queue>
 
+#include "common/bounded_threadsafe_queue.h"
 #include "common/common_funcs.h"
 #include "core/internal_network/sockets.h"
 #include "network/room_member.h"
@@ -50,7 +51,7 @@ public:
 
     std::pair<s32, Errno> Send(std::span<const u8> message, int flags) override;
 
-    void SendPacket(ProxyPacket& packet);
+    void SendPacket(ProxyPacket& packet, std::span<const u8> message);
 
     std::pair<s32, Errno> SendTo(u32 flags, std::span<const u8> message,
                                  const SockAddrIn* addr) override;
@@ -81,17 +82,25 @@ public:
     bool IsOpened() const override;
 
 private:
+    /// Maximum number of received packets waiting to be read, further packets are dropped
+    static constexpr std::size_t ReceiveQueueSize = 256;
+
     bool broadcast = false;
     bool closed = false;
     u32 send_timeout = 0;
     u32 receive_timeout = 0;
     bool is_bound = false;
+    bool use_fake_ip = false;
     SockAddrIn local_endpoint{};
     bool blocking = true;
-    std::queue<ProxyPacket> received_packets;
     Protocol protocol;
 
-    std::mutex packets_mutex;
+    /// Filled by the room member thread without taking a lock, drained by the guest
+    Common::SPSCQueue<ProxyPacket, ReceiveQueueSize> received_packets;
+    /// Packet being read by the guest, kept across peeks and partial reads
+    std::optional<ProxyPacket> pending_packet;
+    /// Serializes guest reads, never taken by the room member thread
+    std::mutex receive_mutex;
 
     RoomNetwork& room_network;
 };
@@ -173,4 +173,26 @@ private:
 
 std::pair<s32, Errno> Poll(std::vector<PollFD>& poll_fds, s32 timeout);
 
+/// Set of sockets that stays registered with the host between polls, so that polling the same
+/// sockets again only costs the host the ready ones. Falls back to Poll on hosts without epoll
+/// and for sockets that have no host descriptor.
+class PollSet {
+public:
+    PollSet();
+    ~PollSet();
+
+    PollSet(const PollSet&) = delete;
+    PollSet& operator=(const PollSet&) = delete;
+
+    /// Polls the sockets like Poll, registering new sockets and updating changed events.
+    std::pair<s32, Errno> Poll(std::vector<PollFD>& poll_fds, s32 timeout);
+
+    /// Stops watching a socket. Must be called before the socket is closed.
+    void Remove(const SocketBase& socket);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
 } // namespace Network
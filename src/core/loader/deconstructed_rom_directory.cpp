@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <cstring>
+#include <future>
+#include "common/boot_profiler.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -134,6 +136,7 @@ FileType AppLoader_DeconstructedRomDirectory::IdentifyType(const FileSys::Virtua
 
 AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirectory::Load(
     Kernel::KProcess& process, Core::System& system) {
+    BOOT_PHASE("Loader::DeconstructedRomDirectory");
     if (is_loaded) {
         return {ResultStatus::ErrorAlreadyLoaded, {}};
     }
@@ -185,6 +188,18 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
                                        "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7",
                                        "subsdk8", "subsdk9", "sdk"};
 
+    // Read and decompress every module concurrently, both passes below use the results.
+    std::array<std::future<std::optional<AppLoader_NSO::ModuleImage>>, static_modules.size()>
+        pending_images;
+    for (size_t i = 0; i < static_modules.size(); i++) {
+        if (const FileSys::VirtualFile module_file{dir->GetFile(static_modules[i])}) {
+            pending_images[i] = std::async(std::launch::async, [module_file] {
+                return AppLoader_NSO::ReadModuleImage(*module_file);
+            });
+        }
+    }
+    std::array<std::optional<AppLoader_NSO::ModuleImage>, static_modules.size()> images;
+
     std::size_t code_size{};
 
     // Define an nce patch context for each potential module.
@@ -193,14 +208,17 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     // Use the NSO module loader to figure out the code layout
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
+        if (!pending_images[i].valid()) {
             continue;
         }
+        images[i] = pending_images[i].get();
+        if (!images[i]) {
+            return {ResultStatus::ErrorLoadingNSO, {}};
+        }
 
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, code_size, should_pass_arguments, false, {},
+            process, system, *images[i], code_size, should_pass_arguments, false, {},
             patch_ctx.GetPatchers(), patch_ctx.GetLastIndex());
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
@@ -236,15 +254,14 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
                                    system.GetContentProvider()};
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
-        if (!module_file) {
+        if (!images[i]) {
             continue;
         }
 
         const VAddr load_addr{next_load_addr};
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, load_addr, should_pass_arguments, true, pm,
+            process, system, *images[i], load_addr, should_pass_arguments, true, pm,
             patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
         if (!tentative_next_load_addr) {
             return {ResultStatus::ErrorLoadingNSO, {}};
@@ -3,6 +3,7 @@
 
 #include <utility>
 
+#include "common/boot_profiler.h"
 #include "common/hex_util.h"
 #include "common/scope_exit.h"
 #include "core/core.h"
@@ -35,6 +36,7 @@ FileType AppLoader_NCA::IdentifyType(const FileSys::VirtualFile& nca_file) {
 }
 
 AppLoader_NCA::LoadResult AppLoader_NCA::Load(Kernel::KProcess& process, Core::System& system) {
+    BOOT_PHASE("Loader::NCA");
     if (is_loaded) {
         return {ResultStatus::ErrorAlreadyLoaded, {}};
     }
@@ -4,6 +4,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/boot_profiler.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
@@ -267,6 +268,7 @@ bool AppLoader_NRO::LoadNro(Core::System& system, Kernel::KProcess& process,
 }
 
 AppLoader_NRO::LoadResult AppLoader_NRO::Load(Kernel::KProcess& process, Core::System& system) {
+    BOOT_PHASE("Loader::NRO");
     if (is_loaded) {
         return {ResultStatus::ErrorAlreadyLoaded, {}};
     }
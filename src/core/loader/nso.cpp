@@ -3,10 +3,13 @@
 
 #include <cinttypes>
 #include <cstring>
+#include <future>
 #include <vector>
 
+#include "common/boot_profiler.h"
 #include "common/common_funcs.h"
 #include "common/hex_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
 #include "common/lz4_compression.h"
 #include "common/settings.h"
@@ -26,6 +29,8 @@
 
 namespace Loader {
 namespace {
+using namespace Common::Literals;
+
 struct MODHeader {
     u32_le magic;
     u32_le dynamic_offset;
@@ -37,6 +42,9 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
+// Compressed segments larger than this are decompressed on their own thread.
+constexpr u32 ParallelDecompressionMinSize = 256_KiB;
+
 std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
                                   const NSOSegmentHeader& header) {
     std::vector<u8> uncompressed_data =
@@ -73,24 +81,69 @@ FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& in_file) {
     return FileType::NSO;
 }
 
-std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
-                                               const FileSys::VfsFile& nso_file, VAddr load_base,
-                                               bool should_pass_arguments, bool load_into_process,
-                                               std::optional<FileSys::PatchManager> pm,
-                                               std::vector<Core::NCE::Patcher>* patches,
-                                               s32 patch_index) {
+std::optional<AppLoader_NSO::ModuleImage> AppLoader_NSO::ReadModuleImage(
+    const FileSys::VfsFile& nso_file) {
     if (nso_file.GetSize() < sizeof(NSOHeader)) {
         return std::nullopt;
     }
 
-    NSOHeader nso_header{};
-    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
+    ModuleImage image{};
+    if (sizeof(NSOHeader) != nso_file.ReadObject(&image.header)) {
         return std::nullopt;
     }
 
-    if (nso_header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
+    if (image.header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
         return std::nullopt;
     }
+    image.name = nso_file.GetName();
+
+    // Decompress the larger segments concurrently.
+    std::array<std::future<std::vector<u8>>, 3> pending_segments;
+    for (std::size_t i = 0; i < image.header.segments.size(); ++i) {
+        std::vector<u8> data = nso_file.ReadBytes(image.header.segments_compressed_size[i],
+                                                  image.header.segments[i].offset);
+        if (!image.header.IsSegmentCompressed(i)) {
+            image.segments[i] = std::move(data);
+        } else if (image.header.segments_compressed_size[i] >= ParallelDecompressionMinSize) {
+            pending_segments[i] = std::async(
+                std::launch::async, [data = std::move(data), &header = image.header.segments[i]] {
+                    return DecompressSegment(data, header);
+                });
+        } else {
+            image.segments[i] = DecompressSegment(data, image.header.segments[i]);
+        }
+    }
+    for (std::size_t i = 0; i < pending_segments.size(); ++i) {
+        if (pending_segments[i].valid()) {
+            image.segments[i] = pending_segments[i].get();
+        }
+    }
+
+    return image;
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
+                                               const FileSys::VfsFile& nso_file, VAddr load_base,
+                                               bool should_pass_arguments, bool load_into_process,
+                                               std::optional<FileSys::PatchManager> pm,
+                                               std::vector<Core::NCE::Patcher>* patches,
+                                               s32 patch_index) {
+    const auto image = ReadModuleImage(nso_file);
+    if (!image) {
+        return std::nullopt;
+    }
+    return LoadModule(process, system, *image, load_base, should_pass_arguments,
+                      load_into_process, std::move(pm), patches, patch_index);
+}
+
+std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::System& system,
+                                               const ModuleImage& image, VAddr load_base,
+                                               bool should_pass_arguments, bool load_into_process,
+                                               std::optional<FileSys::PatchManager> pm,
+                                               std::vector<Core::NCE::Patcher>* patches,
+                                               s32 patch_index) {
+    BOOT_PHASE("LoadModule");
+    const NSOHeader& nso_header = image.header;
 
     // Allocate some space at the beginning if we are patching in PreText mode.
     const size_t module_start = [&]() -> size_t {
@@ -109,11 +162,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
-        }
+        const std::vector<u8>& data = image.segments[i];
         program_image.resize(module_start + nso_header.segments[i].location +
                              static_cast<u32>(data.size()));
         std::memcpy(program_image.data() + module_start + nso_header.segments[i].location,
@@ -147,7 +196,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     }
 
     // Apply patches if necessary
-    const auto name = nso_file.GetName();
+    const auto& name = image.name;
     if (pm && (pm->HasNSOPatch(nso_header.build_id, name) || Settings::values.dump_nso)) {
         std::span<u8> patchable_section(program_image.data() + module_start,
                                         program_image.size() - module_start);
@@ -167,7 +216,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     auto* patch = patches ? &patches->operator[](patch_index) : nullptr;
     if (patch && !load_into_process) {
         // Patch SVCs and MRS calls in the guest code
-        while (!patch->PatchText(program_image, code)) {
+        while (!patch->PatchText(program_image, code, nso_header.build_id)) {
             patch = &patches->emplace_back();
         }
     } else if (patch) {
@@ -207,6 +256,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
 }
 
 AppLoader_NSO::LoadResult AppLoader_NSO::Load(Kernel::KProcess& process, Core::System& system) {
+    BOOT_PHASE("Loader::NSO");
     if (is_loaded) {
         return {ResultStatus::ErrorAlreadyLoaded, {}};
     }
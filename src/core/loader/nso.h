@@ -5,7 +5,9 @@
 
 #include <array>
 #include <optional>
+#include <string>
 #include <type_traits>
+#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
@@ -89,6 +91,16 @@ public:
         return IdentifyType(file);
     }
 
+    /// Header and decompressed segments of an NSO file.
+    struct ModuleImage {
+        std::string name;
+        NSOHeader header;
+        std::array<std::vector<u8>, 3> segments;
+    };
+
+    /// Reads an NSO file and decompresses its segments, which can be done ahead of loading it.
+    static std::optional<ModuleImage> ReadModuleImage(const FileSys::VfsFile& nso_file);
+
     static std::optional<VAddr> LoadModule(Kernel::KProcess& process, Core::System& system,
                                            const FileSys::VfsFile& nso_file, VAddr load_base,
                                            bool should_pass_arguments, bool load_into_process,
@@ -96,6 +108,13 @@ public:
                                            std::vector<Core::NCE::Patcher>* patches = nullptr,
                                            s32 patch_index = -1);
 
+    static std::optional<VAddr> LoadModule(Kernel::KProcess& process, Core::System& system,
+                                           const ModuleImage& image, VAddr load_base,
+                                           bool should_pass_arguments, bool load_into_process,
+                                           std::optional<FileSys::PatchManager> pm = {},
+                                           std::vector<Core::NCE::Patcher>* patches = nullptr,
+                                           s32 patch_index = -1);
+
     LoadResult Load(Kernel::KProcess& process, Core::System& system) override;
 
     ResultStatus ReadNSOModules(Modules& out_modules) override;
@@ -3,6 +3,7 @@
 
 #include <vector>
 
+#include "common/boot_profiler.h"
 #include "common/common_types.h"
 #include "core/core.h"
 #include "core/file_sys/content_archive.h"
@@ -76,6 +77,7 @@ FileType AppLoader_NSP::IdentifyType(const FileSys::VirtualFile& nsp_file) {
 }
 
 AppLoader_NSP::LoadResult AppLoader_NSP::Load(Kernel::KProcess& process, Core::System& system) {
+    BOOT_PHASE("Loader::NSP");
     if (is_loaded) {
         return {ResultStatus::ErrorAlreadyLoaded, {}};
     }
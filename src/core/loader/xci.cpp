@@ -3,6 +3,7 @@
 
 #include <vector>
 
+#include "common/boot_profiler.h"
 #include "common/common_types.h"
 #include "core/core.h"
 #include "core/file_sys/card_image.h"
@@ -55,6 +56,7 @@ FileType AppLoader_XCI::IdentifyType(const FileSys::VirtualFile& xci_file) {
 }
 
 AppLoader_XCI::LoadResult AppLoader_XCI::Load(Kernel::KProcess& process, Core::System& system) {
+    BOOT_PHASE("Loader::XCI");
     if (is_loaded) {
         return {ResultStatus::ErrorAlreadyLoaded, {}};
     }
@@ -258,12 +258,22 @@ struct Memory::Impl {
         }
 
         while (remaining_size) {
-            const std::size_t copy_amount =
+            std::size_t copy_amount =
                 std::min(static_cast<std::size_t>(YUZU_PAGESIZE) - page_offset, remaining_size);
             const auto current_vaddr =
                 static_cast<u64>((page_index << YUZU_PAGEBITS) + page_offset);
 
+            // Extend the run over the following pages that continue it in host memory, so large
+            // blocks are handled with one callback per run instead of one per page.
             const auto [pointer, type] = page_table.pointers[page_index].PointerType();
+            std::size_t num_pages = 1;
+            while (copy_amount < remaining_size &&
+                   ContinuesHostRun(page_table, page_index, page_index + num_pages)) {
+                copy_amount += std::min(static_cast<std::size_t>(YUZU_PAGESIZE),
+                                        remaining_size - copy_amount);
+                ++num_pages;
+            }
+
             switch (type) {
             case Common::PageType::Unmapped: {
                 user_accessible = false;
@@ -290,7 +300,7 @@ struct Memory::Impl {
                 UNREACHABLE();
             }
 
-            page_index++;
+            page_index += num_pages;
             page_offset = 0;
             increment(copy_amount);
             remaining_size -= copy_amount;
@@ -299,6 +309,28 @@ struct Memory::Impl {
         return user_accessible;
     }
 
+    /// Returns true when next_page directly follows first_page in host memory and has the same
+    /// type, so both can be accessed with a single host copy.
+    [[nodiscard]] static bool ContinuesHostRun(const Common::PageTable& page_table,
+                                               std::size_t first_page, std::size_t next_page) {
+        const auto [pointer, type] = page_table.pointers[first_page].PointerType();
+        const auto [next_pointer, next_type] = page_table.pointers[next_page].PointerType();
+        if (type != next_type) {
+            return false;
+        }
+        switch (type) {
+        case Common::PageType::Unmapped:
+            return true;
+        case Common::PageType::Memory:
+            // Memory pointers are stored relative to the virtual address of the page
+            return pointer == next_pointer;
+        case Common::PageType::RasterizerCachedMemory:
+            return page_table.backing_addr[first_page] == page_table.backing_addr[next_page];
+        default:
+            return false;
+        }
+    }
+
     template <bool UNSAFE>
     bool ReadBlockImpl(const Common::ProcessAddress src_addr, void* dest_buffer,
                        const std::size_t size) {
@@ -336,20 +368,39 @@ struct Memory::Impl {
         return ReadBlockImpl<true>(src_addr, dest_buffer, size);
     }
 
-    const u8* GetSpan(const VAddr src_addr, const std::size_t size) const {
-        if (current_page_table->blocks[src_addr >> YUZU_PAGEBITS] ==
-            current_page_table->blocks[(src_addr + size) >> YUZU_PAGEBITS]) {
-            return GetPointerSilent(src_addr);
+    /// Returns a pointer to the host memory backing [src_addr, src_addr + size), or nullptr when
+    /// the range is not contiguous in host memory. With memory_only, pages tracked by the
+    /// rasterizer are rejected too, so the pointer can be written to without notifying it.
+    [[nodiscard]] u8* GetContiguousPointer(const VAddr src_addr, const std::size_t size,
+                                           bool memory_only) const {
+        if (size == 0 || !AddressSpaceContains(*current_page_table, src_addr, size)) {
+            return nullptr;
         }
-        return nullptr;
+        const std::size_t first_page = src_addr >> YUZU_PAGEBITS;
+        const std::size_t last_page = (src_addr + size - 1) >> YUZU_PAGEBITS;
+        const Common::PageType type = current_page_table->pointers[first_page].Type();
+        if (type != Common::PageType::Memory &&
+            (memory_only || type != Common::PageType::RasterizerCachedMemory)) {
+            return nullptr;
+        }
+        // Pages of a single block are always contiguous, otherwise check them one by one
+        if (memory_only ||
+            current_page_table->blocks[first_page] != current_page_table->blocks[last_page]) {
+            for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+                if (!ContinuesHostRun(*current_page_table, first_page, page)) {
+                    return nullptr;
+                }
+            }
+        }
+        return GetPointerSilent(src_addr);
+    }
+
+    const u8* GetSpan(const VAddr src_addr, const std::size_t size) const {
+        return GetContiguousPointer(src_addr, size, false);
     }
 
     u8* GetSpan(const VAddr src_addr, const std::size_t size) {
-        if (current_page_table->blocks[src_addr >> YUZU_PAGEBITS] ==
-            current_page_table->blocks[(src_addr + size) >> YUZU_PAGEBITS]) {
-            return GetPointerSilent(src_addr);
-        }
-        return nullptr;
+        return GetContiguousPointer(src_addr, size, false);
     }
 
     template <bool UNSAFE>
@@ -654,22 +705,22 @@ struct Memory::Impl {
                 base += 1;
             }
         } else {
-            auto orig_base = base;
+            // Device memory is linear, so every page of the run is biased by the same amount and
+            // the entries can be filled without translating each page.
+            const auto orig_base = base;
+            const auto host_ptr =
+                reinterpret_cast<uintptr_t>(system.DeviceMemory().GetPointer<u8>(target)) -
+                (base << YUZU_PAGEBITS);
+            const auto backing = GetInteger(target) - (base << YUZU_PAGEBITS);
             while (base != end) {
-                auto host_ptr =
-                    reinterpret_cast<uintptr_t>(system.DeviceMemory().GetPointer<u8>(target)) -
-                    (base << YUZU_PAGEBITS);
-                auto backing = GetInteger(target) - (base << YUZU_PAGEBITS);
                 page_table.pointers[base].Store(host_ptr, type);
                 page_table.backing_addr[base] = backing;
                 page_table.blocks[base] = orig_base << YUZU_PAGEBITS;
-
-                ASSERT_MSG(page_table.pointers[base].Pointer(),
-                           "memory mapping base yield a nullptr within the table");
-
                 base += 1;
-                target += YUZU_PAGESIZE;
             }
+
+            ASSERT_MSG(page_table.pointers[orig_base].Pointer(),
+                       "memory mapping base yield a nullptr within the table");
         }
     }
 
@@ -841,7 +892,9 @@ struct Memory::Impl {
             PAddr subaddress = address >> YUZU_PAGEBITS;
             bool do_collection = current_area.last_address == subaddress;
             if (!do_collection) [[unlikely]] {
-                do_collection = system.GPU().OnCPUWrite(address, size);
+                // Batched tracking defers every write to the next gather, skipping the caches
+                do_collection = Settings::values.use_batched_write_tracking.GetValue() ||
+                                system.GPU().OnCPUWrite(address, size);
                 if (!do_collection) {
                     return;
                 }
@@ -1034,6 +1087,10 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+u8* Memory::GetWriteSpan(const VAddr dest_addr, const std::size_t size) {
+    return impl->GetContiguousPointer(dest_addr, size, true);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
@@ -369,6 +369,18 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Gets a pointer to a range of guest memory that can be written to directly.
+     *
+     * @param dest_addr The virtual address of the range.
+     * @param size      The size of the range, in bytes.
+     *
+     * @returns A pointer to the host memory backing the range, or nullptr when the range is
+     *          not contiguous in host memory or has pages the rasterizer has to be notified
+     *          about on writes.
+     */
+    u8* GetWriteSpan(const VAddr dest_addr, const std::size_t size);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
@@ -3,6 +3,7 @@
 
 #include <locale>
 #include "common/hex_util.h"
+#include "common/logging/backend.h"
 #include "common/microprofile.h"
 #include "common/swap.h"
 #include "core/arm/debug.h"
@@ -111,6 +112,10 @@ void StandardVmCallbacks::CommandLog(std::string_view data) {
               data.back() == '\n' ? data.substr(0, data.size() - 1) : data);
 }
 
+bool StandardVmCallbacks::IsCommandLogEnabled() {
+    return Common::Log::IsLogged(Common::Log::Class::CheatEngine, Common::Log::Level::Debug);
+}
+
 bool StandardVmCallbacks::IsAddressInRange(VAddr in) const {
     if ((in < metadata.main_nso_extents.base ||
          in >= metadata.main_nso_extents.base + metadata.main_nso_extents.size) &&
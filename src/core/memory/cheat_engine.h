@@ -34,6 +34,7 @@ public:
     void ResumeProcess() override;
     void DebugLog(u8 id, u64 value) override;
     void CommandLog(std::string_view data) override;
+    bool IsCommandLogEnabled() override;
 
 private:
     bool IsAddressInRange(VAddr address) const;
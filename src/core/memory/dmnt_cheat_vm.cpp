@@ -639,8 +639,8 @@ void DmntCheatVm::SkipConditionalBlock(bool is_if) {
         // We want to continue until we're out of the current block.
         const std::size_t desired_depth = condition_depth - 1;
 
-        CheatVmOpcode skip_opcode{};
-        while (condition_depth > desired_depth && DecodeNextOpcode(skip_opcode)) {
+        const CheatVmOpcode* skip_opcode;
+        while (condition_depth > desired_depth && (skip_opcode = FetchNextOpcode()) != nullptr) {
             // Decode instructions until we see end of the current conditional block.
             // NOTE: This is broken in gateway's implementation.
             // Gateway currently checks for "0x2" instead of "0x20000000"
@@ -648,9 +648,9 @@ void DmntCheatVm::SkipConditionalBlock(bool is_if) {
             // This causes issues if "0x2" appears as an immediate in the conditional block...
 
             // We also support nesting of conditional blocks, and Gateway does not.
-            if (skip_opcode.begin_conditional_block) {
+            if (skip_opcode->begin_conditional_block) {
                 condition_depth++;
-            } else if (auto end_cond = std::get_if<EndConditionalOpcode>(&skip_opcode.opcode)) {
+            } else if (auto end_cond = std::get_if<EndConditionalOpcode>(&skip_opcode->opcode)) {
                 if (!end_cond->is_else) {
                     condition_depth--;
                 } else if (is_if && condition_depth - 1 == desired_depth) {
@@ -699,6 +699,38 @@ u64 DmntCheatVm::GetCheatProcessAddress(const CheatProcessMetadata& metadata,
     }
 }
 
+void DmntCheatVm::DecodeProgram() {
+    decoded_opcodes.clear();
+    opcode_indices.fill(InvalidOpcodeIndex);
+
+    // Decoding only depends on the program, so every opcode Execute can reach is found by
+    // decoding it linearly once. Loops only jump back to the start of an opcode.
+    instruction_ptr = 0;
+    decode_success = true;
+    while (instruction_ptr < num_opcodes) {
+        const std::size_t start = instruction_ptr;
+        CheatVmOpcode opcode{};
+        if (!DecodeNextOpcode(opcode)) {
+            break;
+        }
+        opcode_indices[start] = static_cast<u16>(decoded_opcodes.size());
+        decoded_opcodes.push_back({opcode, instruction_ptr});
+    }
+    instruction_ptr = 0;
+}
+
+const CheatVmOpcode* DmntCheatVm::FetchNextOpcode() {
+    // Running past the decoded opcodes is a decode failure, which stops execution for good.
+    if (!decode_success || instruction_ptr >= num_opcodes ||
+        opcode_indices[instruction_ptr] == InvalidOpcodeIndex) {
+        decode_success = false;
+        return nullptr;
+    }
+    const DecodedOpcode& decoded = decoded_opcodes[opcode_indices[instruction_ptr]];
+    instruction_ptr = decoded.next_instruction_ptr;
+    return &decoded.opcode;
+}
+
 void DmntCheatVm::ResetState() {
     registers.fill(0);
     saved_values.fill(0);
@@ -717,6 +749,7 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
             // Bounds check.
             if (entries[i].definition.num_opcodes + num_opcodes > MaximumProgramOpcodeCount) {
                 num_opcodes = 0;
+                DecodeProgram();
                 return false;
             }
 
@@ -726,43 +759,49 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
         }
     }
 
+    DecodeProgram();
     return true;
 }
 
 void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
-    CheatVmOpcode cur_opcode{};
-
     // Get Keys down.
     u64 kDown = callbacks->HidKeysDown();
 
-    callbacks->CommandLog("Started VM execution.");
-    callbacks->CommandLog(fmt::format("Main NSO:  {:012X}", metadata.main_nso_extents.base));
-    callbacks->CommandLog(fmt::format("Heap:      {:012X}", metadata.main_nso_extents.base));
-    callbacks->CommandLog(fmt::format("Keys Down: {:08X}", static_cast<u32>(kDown & 0x0FFFFFFF)));
+    const bool log_commands = callbacks->IsCommandLogEnabled();
+    if (log_commands) {
+        callbacks->CommandLog("Started VM execution.");
+        callbacks->CommandLog(fmt::format("Main NSO:  {:012X}", metadata.main_nso_extents.base));
+        callbacks->CommandLog(fmt::format("Heap:      {:012X}", metadata.main_nso_extents.base));
+        callbacks->CommandLog(
+            fmt::format("Keys Down: {:08X}", static_cast<u32>(kDown & 0x0FFFFFFF)));
+    }
 
     // Clear VM state.
     ResetState();
 
     // Loop until program finishes.
-    while (DecodeNextOpcode(cur_opcode)) {
-        callbacks->CommandLog(
-            fmt::format("Instruction Ptr: {:04X}", static_cast<u32>(instruction_ptr)));
+    while (const CheatVmOpcode* const cur_opcode = FetchNextOpcode()) {
+        if (log_commands) {
+            callbacks->CommandLog(
+                fmt::format("Instruction Ptr: {:04X}", static_cast<u32>(instruction_ptr)));
 
-        for (std::size_t i = 0; i < NumRegisters; i++) {
-            callbacks->CommandLog(fmt::format("Registers[{:02X}]: {:016X}", i, registers[i]));
-        }
+            for (std::size_t i = 0; i < NumRegisters; i++) {
+                callbacks->CommandLog(fmt::format("Registers[{:02X}]: {:016X}", i, registers[i]));
+            }
 
-        for (std::size_t i = 0; i < NumRegisters; i++) {
-            callbacks->CommandLog(fmt::format("SavedRegs[{:02X}]: {:016X}", i, saved_values[i]));
+            for (std::size_t i = 0; i < NumRegisters; i++) {
+                callbacks->CommandLog(
+                    fmt::format("SavedRegs[{:02X}]: {:016X}", i, saved_values[i]));
+            }
+            LogOpcode(*cur_opcode);
         }
-        LogOpcode(cur_opcode);
 
         // Increment conditional depth, if relevant.
-        if (cur_opcode.begin_conditional_block) {
+        if (cur_opcode->begin_conditional_block) {
             condition_depth++;
         }
 
-        if (auto store_static = std::get_if<StoreStaticOpcode>(&cur_opcode.opcode)) {
+        if (auto store_static = std::get_if<StoreStaticOpcode>(&cur_opcode->opcode)) {
             // Calculate address, write value to memory.
             u64 dst_address = GetCheatProcessAddress(metadata, store_static->mem_type,
                                                      store_static->rel_address +
@@ -776,7 +815,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 callbacks->MemoryWriteUnsafe(dst_address, &dst_value, store_static->bit_width);
                 break;
             }
-        } else if (auto begin_cond = std::get_if<BeginConditionalOpcode>(&cur_opcode.opcode)) {
+        } else if (auto begin_cond = std::get_if<BeginConditionalOpcode>(&cur_opcode->opcode)) {
             // Read value from memory.
             u64 src_address =
                 GetCheatProcessAddress(metadata, begin_cond->mem_type, begin_cond->rel_address);
@@ -816,7 +855,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
             if (!cond_met) {
                 SkipConditionalBlock(true);
             }
-        } else if (auto end_cond = std::get_if<EndConditionalOpcode>(&cur_opcode.opcode)) {
+        } else if (auto end_cond = std::get_if<EndConditionalOpcode>(&cur_opcode->opcode)) {
             if (end_cond->is_else) {
                 /* Skip to the end of the conditional block. */
                 this->SkipConditionalBlock(false);
@@ -827,7 +866,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                     condition_depth--;
                 }
             }
-        } else if (auto ctrl_loop = std::get_if<ControlLoopOpcode>(&cur_opcode.opcode)) {
+        } else if (auto ctrl_loop = std::get_if<ControlLoopOpcode>(&cur_opcode->opcode)) {
             if (ctrl_loop->start_loop) {
                 // Start a loop.
                 registers[ctrl_loop->reg_index] = ctrl_loop->num_iters;
@@ -839,10 +878,10 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                     instruction_ptr = loop_tops[ctrl_loop->reg_index];
                 }
             }
-        } else if (auto ldr_static = std::get_if<LoadRegisterStaticOpcode>(&cur_opcode.opcode)) {
+        } else if (auto ldr_static = std::get_if<LoadRegisterStaticOpcode>(&cur_opcode->opcode)) {
             // Set a register to a static value.
             registers[ldr_static->reg_index] = ldr_static->value;
-        } else if (auto ldr_memory = std::get_if<LoadRegisterMemoryOpcode>(&cur_opcode.opcode)) {
+        } else if (auto ldr_memory = std::get_if<LoadRegisterMemoryOpcode>(&cur_opcode->opcode)) {
             // Choose source address.
             u64 src_address;
             if (ldr_memory->load_from_reg) {
@@ -861,7 +900,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                                             ldr_memory->bit_width);
                 break;
             }
-        } else if (auto str_static = std::get_if<StoreStaticToAddressOpcode>(&cur_opcode.opcode)) {
+        } else if (auto str_static = std::get_if<StoreStaticToAddressOpcode>(&cur_opcode->opcode)) {
             // Calculate address.
             u64 dst_address = registers[str_static->reg_index];
             u64 dst_value = str_static->value;
@@ -882,7 +921,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 registers[str_static->reg_index] += str_static->bit_width;
             }
         } else if (auto perform_math_static =
-                       std::get_if<PerformArithmeticStaticOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<PerformArithmeticStaticOpcode>(&cur_opcode->opcode)) {
             // Do requested math.
             switch (perform_math_static->math_type) {
             case RegisterArithmeticType::Addition:
@@ -929,14 +968,14 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 break;
             }
         } else if (auto begin_keypress_cond =
-                       std::get_if<BeginKeypressConditionalOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<BeginKeypressConditionalOpcode>(&cur_opcode->opcode)) {
             // Check for keypress.
             if ((begin_keypress_cond->key_mask & kDown) != begin_keypress_cond->key_mask) {
                 // Keys not pressed. Skip conditional block.
                 SkipConditionalBlock(true);
             }
         } else if (auto perform_math_reg =
-                       std::get_if<PerformArithmeticRegisterOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<PerformArithmeticRegisterOpcode>(&cur_opcode->opcode)) {
             const u64 operand_1_value = registers[perform_math_reg->src_reg_1_index];
             const u64 operand_2_value =
                 perform_math_reg->has_immediate
@@ -997,7 +1036,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
             // Save to register.
             registers[perform_math_reg->dst_reg_index] = res_val;
         } else if (auto str_register =
-                       std::get_if<StoreRegisterToAddressOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<StoreRegisterToAddressOpcode>(&cur_opcode->opcode)) {
             // Calculate address.
             u64 dst_value = registers[str_register->str_reg_index];
             u64 dst_address = registers[str_register->addr_reg_index];
@@ -1041,7 +1080,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 registers[str_register->addr_reg_index] += str_register->bit_width;
             }
         } else if (auto begin_reg_cond =
-                       std::get_if<BeginRegisterConditionalOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<BeginRegisterConditionalOpcode>(&cur_opcode->opcode)) {
             // Get value from register.
             u64 src_value = 0;
             switch (begin_reg_cond->bit_width) {
@@ -1145,7 +1184,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 SkipConditionalBlock(true);
             }
         } else if (auto save_restore_reg =
-                       std::get_if<SaveRestoreRegisterOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<SaveRestoreRegisterOpcode>(&cur_opcode->opcode)) {
             // Save or restore a register.
             switch (save_restore_reg->op_type) {
             case SaveRestoreRegisterOpType::ClearRegs:
@@ -1163,7 +1202,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 break;
             }
         } else if (auto save_restore_regmask =
-                       std::get_if<SaveRestoreRegisterMaskOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<SaveRestoreRegisterMaskOpcode>(&cur_opcode->opcode)) {
             // Save or restore register mask.
             u64* src;
             u64* dst;
@@ -1196,7 +1235,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 }
             }
         } else if (auto rw_static_reg =
-                       std::get_if<ReadWriteStaticRegisterOpcode>(&cur_opcode.opcode)) {
+                       std::get_if<ReadWriteStaticRegisterOpcode>(&cur_opcode->opcode)) {
             if (rw_static_reg->static_idx < NumReadableStaticRegisters) {
                 // Load a register with a static register.
                 registers[rw_static_reg->idx] = static_registers[rw_static_reg->static_idx];
@@ -1204,11 +1243,11 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
                 // Store a register to a static register.
                 static_registers[rw_static_reg->static_idx] = registers[rw_static_reg->idx];
             }
-        } else if (std::holds_alternative<PauseProcessOpcode>(cur_opcode.opcode)) {
+        } else if (std::holds_alternative<PauseProcessOpcode>(cur_opcode->opcode)) {
             callbacks->PauseProcess();
-        } else if (std::holds_alternative<ResumeProcessOpcode>(cur_opcode.opcode)) {
+        } else if (std::holds_alternative<ResumeProcessOpcode>(cur_opcode->opcode)) {
             callbacks->ResumeProcess();
-        } else if (auto debug_log = std::get_if<DebugLogOpcode>(&cur_opcode.opcode)) {
+        } else if (auto debug_log = std::get_if<DebugLogOpcode>(&cur_opcode->opcode)) {
             // Read value from memory.
             u64 log_value = 0;
             if (debug_log->val_type == DebugLogValueType::RegisterValue) {
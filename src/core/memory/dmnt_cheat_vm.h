@@ -276,6 +276,8 @@ public:
 
         virtual void DebugLog(u8 id, u64 value) = 0;
         virtual void CommandLog(std::string_view data) = 0;
+        /// Whether CommandLog output is kept, tracing every instruction is skipped otherwise
+        virtual bool IsCommandLogEnabled() = 0;
     };
 
     static constexpr std::size_t MaximumProgramOpcodeCount = 0x400;
@@ -308,7 +310,19 @@ private:
     std::array<u64, NumStaticRegisters> static_registers{};
     std::array<std::size_t, NumRegisters> loop_tops{};
 
+    /// Opcodes decoded once when the program is loaded, with the dword following each of them
+    struct DecodedOpcode {
+        CheatVmOpcode opcode;
+        std::size_t next_instruction_ptr;
+    };
+    static constexpr u16 InvalidOpcodeIndex = 0xFFFF;
+    std::vector<DecodedOpcode> decoded_opcodes;
+    /// Index into decoded_opcodes of the opcode starting at each dword of the program
+    std::array<u16, MaximumProgramOpcodeCount> opcode_indices{};
+
     bool DecodeNextOpcode(CheatVmOpcode& out);
+    void DecodeProgram();
+    const CheatVmOpcode* FetchNextOpcode();
     void SkipConditionalBlock(bool is_if);
     void ResetState();
 
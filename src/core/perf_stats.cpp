@@ -3,13 +3,13 @@
 
 #include <algorithm>
 #include <chrono>
-#include <iterator>
+#include <cmath>
 #include <mutex>
 #include <numeric>
-#include <sstream>
 #include <thread>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
@@ -25,30 +25,101 @@ using std::chrono::microseconds;
 // booting that we shouldn't account for
 constexpr std::size_t IgnoreFrames = 5;
 
+// Bounds the frametimes kept for the percentiles when nothing queries the stats for a while
+constexpr std::size_t MaxIntervalFrames = 3600;
+
 namespace Core {
 
-PerfStats::PerfStats(u64 title_id_) : title_id(title_id_) {}
+namespace {
+float ToMilliseconds(PerfStats::Clock::duration duration) {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+/// Returns the value that the given fraction of the values do not exceed, reordering them
+template <typename T>
+T Percentile(std::vector<T>& values, double fraction) {
+    if (values.empty()) {
+        return T{};
+    }
+    const auto index = static_cast<std::size_t>(
+        std::ceil(fraction * static_cast<double>(values.size())) - 1.0);
+    const auto nth = values.begin() + std::min(index, values.size() - 1);
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+void WriteTextFile(const std::filesystem::path& filepath, std::string_view text) {
+    if (Common::FS::CreateParentDir(filepath)) {
+        Common::FS::IOFile file(filepath, Common::FS::FileAccessMode::Write,
+                                Common::FS::FileType::TextFile);
+        void(file.WriteString(text));
+    }
+}
+} // Anonymous namespace
+
+PerfStats::PerfStats(u64 title_id_) : title_id(title_id_) {
+    interval_frametimes.reserve(MaxIntervalFrames);
+}
 
 PerfStats::~PerfStats() {
-    if (!Settings::values.record_frame_times || title_id == 0) {
+    if (!Settings::values.record_frame_times || title_id == 0 || current_index <= IgnoreFrames) {
         return;
     }
+    WriteFrameTimes();
+}
 
-    const std::time_t t = std::time(nullptr);
-    std::ostringstream stream;
-    std::copy(perf_history.begin() + IgnoreFrames, perf_history.begin() + current_index,
-              std::ostream_iterator<double>(stream, "\n"));
+FrameTimeSummary PerfStats::GetFrameTimeSummary() const {
+    std::scoped_lock lock{object_mutex};
+
+    FrameTimeSummary summary{
+        .histogram_bucket_width =
+            std::chrono::duration<double, std::milli>(HistogramBucketWidth).count(),
+        .histogram{frametime_histogram.begin(), frametime_histogram.end()},
+    };
+    if (current_index <= IgnoreFrames) {
+        return summary;
+    }
+    std::vector<float> frametimes;
+    frametimes.reserve(current_index - IgnoreFrames);
+    for (std::size_t i = IgnoreFrames; i < current_index; ++i) {
+        frametimes.push_back(perf_history[i].frametime);
+    }
+    summary.frames = frametimes.size();
+    summary.mean_frametime = std::accumulate(frametimes.begin(), frametimes.end(), 0.0) /
+                             static_cast<double>(frametimes.size());
+    summary.median_frametime = Percentile(frametimes, 0.5);
+    summary.frametime_1_percent_low = Percentile(frametimes, 0.99);
+    summary.frametime_0_1_percent_low = Percentile(frametimes, 0.999);
+    return summary;
+}
+
+void PerfStats::WriteFrameTimes() const {
+    std::string csv = "frametime_ms,speed_limit_sleep_ms,present_latency_ms\n";
+    for (std::size_t i = IgnoreFrames; i < current_index; ++i) {
+        const FrameTimeRecord& frame = perf_history[i];
+        csv += fmt::format("{:.3f},{:.3f},{:.3f}\n", frame.frametime, frame.speed_limit_sleep,
+                           frame.present_latency);
+    }
 
+    const FrameTimeSummary frames = GetFrameTimeSummary();
+    const nlohmann::json summary{
+        {"title_id", fmt::format("{:016X}", title_id)},
+        {"frames", frames.frames},
+        {"mean_frametime_ms", frames.mean_frametime},
+        {"median_frametime_ms", frames.median_frametime},
+        {"1_percent_low_frametime_ms", frames.frametime_1_percent_low},
+        {"0_1_percent_low_frametime_ms", frames.frametime_0_1_percent_low},
+        {"histogram_bucket_width_ms", frames.histogram_bucket_width},
+        {"histogram", frames.histogram},
+    };
+
+    const std::time_t t = std::time(nullptr);
     const auto path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir);
     // %F Date format expanded is "%Y-%m-%d"
-    const auto filename = fmt::format("{:%F-%H-%M}_{:016X}.csv", *std::localtime(&t), title_id);
-    const auto filepath = path / filename;
+    const auto basename = fmt::format("{:%F-%H-%M}_{:016X}", *std::localtime(&t), title_id);
 
-    if (Common::FS::CreateParentDir(filepath)) {
-        Common::FS::IOFile file(filepath, Common::FS::FileAccessMode::Write,
-                                Common::FS::FileType::TextFile);
-        void(file.WriteString(stream.str()));
-    }
+    WriteTextFile(path / (basename + ".csv"), csv);
+    WriteTextFile(path / (basename + ".json"), summary.dump(4));
 }
 
 void PerfStats::BeginSystemFrame() {
@@ -57,15 +128,26 @@ void PerfStats::BeginSystemFrame() {
     frame_begin = Clock::now();
 }
 
-void PerfStats::EndSystemFrame() {
+void PerfStats::EndSystemFrame(Clock::duration speed_limit_sleep) {
     std::scoped_lock lock{object_mutex};
 
     auto frame_end = Clock::now();
     const auto frame_time = frame_end - frame_begin;
     if (current_index < perf_history.size()) {
-        perf_history[current_index++] =
-            std::chrono::duration<double, std::milli>(frame_time).count();
+        perf_history[current_index++] = {
+            .frametime = ToMilliseconds(frame_time),
+            .speed_limit_sleep = ToMilliseconds(speed_limit_sleep),
+            .present_latency = ToMilliseconds(last_present_latency),
+        };
+    }
+    if (current_index > IgnoreFrames) {
+        const auto bucket = static_cast<std::size_t>(frame_time / HistogramBucketWidth);
+        ++frametime_histogram[std::min(bucket, NumHistogramBuckets - 1)];
     }
+    if (interval_frametimes.size() < MaxIntervalFrames) {
+        interval_frametimes.push_back(duration_cast<DoubleSecs>(frame_time).count());
+    }
+    last_present_latency = Clock::duration::zero();
     accumulated_frametime += frame_time;
     system_frames += 1;
 
@@ -77,6 +159,14 @@ void PerfStats::EndGameFrame() {
     game_frames.fetch_add(1, std::memory_order_relaxed);
 }
 
+void PerfStats::AddPresentLatency(Clock::duration latency) {
+    std::scoped_lock lock{object_mutex};
+
+    accumulated_present_latency += latency;
+    present_latency_frames += 1;
+    last_present_latency = latency;
+}
+
 double PerfStats::GetMeanFrametime() const {
     std::scoped_lock lock{object_mutex};
 
@@ -84,8 +174,9 @@ double PerfStats::GetMeanFrametime() const {
         return 0;
     }
 
-    const double sum = std::accumulate(perf_history.begin() + IgnoreFrames,
-                                       perf_history.begin() + current_index, 0.0);
+    const double sum = std::accumulate(
+        perf_history.begin() + IgnoreFrames, perf_history.begin() + current_index, 0.0,
+        [](double total, const FrameTimeRecord& frame) { return total + frame.frametime; });
     return sum / static_cast<double>(current_index - IgnoreFrames);
 }
 
@@ -105,6 +196,12 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
         .frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                      static_cast<double>(system_frames),
         .emulation_speed = system_us_per_second.count() / 1'000'000.0,
+        .present_latency = present_latency_frames == 0
+                               ? 0.0
+                               : duration_cast<DoubleSecs>(accumulated_present_latency).count() /
+                                     static_cast<double>(present_latency_frames),
+        .frametime_1_percent_low = Percentile(interval_frametimes, 0.99),
+        .frametime_0_1_percent_low = Percentile(interval_frametimes, 0.999),
     };
 
     // Reset counters
@@ -112,7 +209,10 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     reset_point_system_us = current_system_time_us;
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
+    interval_frametimes.clear();
     game_frames.store(0, std::memory_order_relaxed);
+    accumulated_present_latency = Clock::duration::zero();
+    present_latency_frames = 0;
     previous_fps = current_fps;
 
     return results;
@@ -125,10 +225,10 @@ double PerfStats::GetLastFrameTimeScale() const {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
-void SpeedLimiter::DoSpeedLimiting(microseconds current_system_time_us) {
+microseconds SpeedLimiter::DoSpeedLimiting(microseconds current_system_time_us) {
     if (Settings::values.use_multi_core.GetValue() ||
         !Settings::values.use_speed_limit.GetValue()) {
-        return;
+        return microseconds::zero();
     }
 
     auto now = Clock::now();
@@ -148,15 +248,18 @@ void SpeedLimiter::DoSpeedLimiting(microseconds current_system_time_us) {
     speed_limiting_delta_err =
         std::clamp(speed_limiting_delta_err, -max_lag_time_us, max_lag_time_us);
 
+    microseconds slept{0};
     if (speed_limiting_delta_err > microseconds::zero()) {
         std::this_thread::sleep_for(speed_limiting_delta_err);
         auto now_after_sleep = Clock::now();
-        speed_limiting_delta_err -= duration_cast<microseconds>(now_after_sleep - now);
+        slept = duration_cast<microseconds>(now_after_sleep - now);
+        speed_limiting_delta_err -= slept;
         now = now_after_sleep;
     }
 
     previous_system_time_us = current_system_time_us;
     previous_walltime = now;
+    return slept;
 }
 
 } // namespace Core
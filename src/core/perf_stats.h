@@ -8,6 +8,7 @@
 #include <chrono>
 #include <cstddef>
 #include <mutex>
+#include <vector>
 #include "common/common_types.h"
 
 namespace Core {
@@ -21,6 +22,40 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Average walltime between the start of a rendered frame and its display, in seconds.
+    /// Zero when the renderer does not measure presentation latency
+    double present_latency;
+    /// Walltime per system frame, in seconds, that 99% of the frames since the last reset beat.
+    /// This is the frametime of the "1% low" framerate
+    double frametime_1_percent_low;
+    /// Walltime per system frame, in seconds, that 99.9% of the frames since the last reset beat
+    double frametime_0_1_percent_low;
+};
+
+/// Timing of a single system frame, in milliseconds
+struct FrameTimeRecord {
+    /// Walltime between the start of the frame and its end, including the speed limiter
+    float frametime;
+    /// Part of the frametime spent sleeping in the speed limiter
+    float speed_limit_sleep;
+    /// Presentation latency of the last game frame displayed during the frame, zero when none was
+    float present_latency;
+};
+
+/// Frametime statistics of the system frames of a whole session, in milliseconds
+struct FrameTimeSummary {
+    /// Number of recorded system frames
+    std::size_t frames;
+    double mean_frametime;
+    double median_frametime;
+    /// Frametime of the "1% low" framerate, which 99% of the frames beat
+    double frametime_1_percent_low;
+    /// Frametime that 99.9% of the frames beat
+    double frametime_0_1_percent_low;
+    /// Width of the buckets of the histogram
+    double histogram_bucket_width;
+    /// Number of frames per frametime bucket, the last one counts every longer frame
+    std::vector<u32> histogram;
 };
 
 /**
@@ -35,9 +70,13 @@ public:
     using Clock = std::chrono::steady_clock;
 
     void BeginSystemFrame();
-    void EndSystemFrame();
+    /// Ends the current system frame, speed_limit_sleep is the time the speed limiter slept in it
+    void EndSystemFrame(Clock::duration speed_limit_sleep);
     void EndGameFrame();
 
+    /// Records the walltime between the start of a rendered frame and its display
+    void AddPresentLatency(Clock::duration latency);
+
     PerfStatsResults GetAndResetStats(std::chrono::microseconds current_system_time_us);
 
     /**
@@ -51,7 +90,18 @@ public:
      */
     double GetLastFrameTimeScale() const;
 
+    /// Returns the statistics of the frames recorded since the game started
+    FrameTimeSummary GetFrameTimeSummary() const;
+
 private:
+    /// Width of the buckets of the frametime histogram
+    static constexpr std::chrono::milliseconds HistogramBucketWidth{1};
+    /// Number of buckets of the frametime histogram, the last one counts every longer frame
+    static constexpr std::size_t NumHistogramBuckets = 101;
+
+    /// Writes the recorded frames and their summary next to the log files
+    void WriteFrameTimes() const;
+
     mutable std::mutex object_mutex;
 
     /// Title ID for the game that is running. 0 if there is no game running yet
@@ -60,7 +110,11 @@ private:
     std::size_t current_index{0};
     /// Stores an hour of historical frametime data useful for processing and tracking performance
     /// regressions with code changes.
-    std::array<double, 216000> perf_history{};
+    std::array<FrameTimeRecord, 216000> perf_history{};
+    /// Number of system frames per frametime bucket, kept past the hour of perf_history
+    std::array<u32, NumHistogramBuckets> frametime_histogram{};
+    /// Frametimes of the system frames since last reset, in seconds
+    std::vector<double> interval_frametimes;
 
     /// Point when the cumulative counters were reset
     Clock::time_point reset_point = Clock::now();
@@ -73,6 +127,12 @@ private:
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     std::atomic<u32> game_frames = 0;
+    /// Cumulative presentation latency of displayed frames since last reset
+    Clock::duration accumulated_present_latency = Clock::duration::zero();
+    /// Cumulative number of frames with a measured presentation latency since last reset
+    u32 present_latency_frames = 0;
+    /// Presentation latency of the last frame displayed during the current system frame
+    Clock::duration last_present_latency = Clock::duration::zero();
 
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
@@ -88,7 +148,8 @@ class SpeedLimiter {
 public:
     using Clock = std::chrono::steady_clock;
 
-    void DoSpeedLimiting(std::chrono::microseconds current_system_time_us);
+    /// Sleeps to keep the walltime in line with the emulated time, returns the time slept
+    std::chrono::microseconds DoSpeedLimiting(std::chrono::microseconds current_system_time_us);
 
 private:
     /// Emulated system time (in microseconds) at the last limiter invocation
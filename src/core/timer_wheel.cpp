@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <tuple>
+
+#include "core/timer_wheel.h"
+
+namespace Core::Timing {
+namespace {
+constexpr u64 SLOT_MASK = TimerWheel::NUM_SLOTS - 1;
+
+u64 ToTick(s64 time) {
+    return static_cast<u64>(std::max<s64>(time, 0)) >> TimerWheel::TICK_SHIFT;
+}
+} // Anonymous namespace
+
+void TimerWheel::Insert(Node& node) {
+    Link(node);
+    ++size;
+}
+
+void TimerWheel::Remove(Node& node) {
+    const u32 bucket = node.bucket;
+    node.unlink();
+    if (bucket != OVERFLOW_BUCKET && buckets[bucket].empty()) {
+        occupied[bucket / NUM_SLOTS] &= ~(1ULL << (bucket % NUM_SLOTS));
+    }
+    --size;
+}
+
+TimerWheel::Node* TimerWheel::Earliest() {
+    if (size == 0) {
+        return nullptr;
+    }
+    while (occupied[0] == 0) {
+        Cascade();
+    }
+    // Every node of the finest level is due before any node of the coarser ones
+    Node* earliest = nullptr;
+    for (Node& node : buckets[std::countr_zero(occupied[0])]) {
+        if (earliest == nullptr ||
+            std::tie(node.time, node.fifo_order) < std::tie(earliest->time, earliest->fifo_order)) {
+            earliest = &node;
+        }
+    }
+    return earliest;
+}
+
+void TimerWheel::Clear() {
+    for (List& list : buckets) {
+        list.clear();
+    }
+    occupied.fill(0);
+    current_tick = 0;
+    size = 0;
+}
+
+void TimerWheel::Link(Node& node) {
+    // Nodes scheduled in the past are due on the current tick
+    const u64 tick = std::max(ToTick(node.time), current_tick);
+    for (u32 level = 0; level < NUM_LEVELS; ++level) {
+        const u32 shift = level * SLOT_BITS;
+        if ((tick >> (shift + SLOT_BITS)) != (current_tick >> (shift + SLOT_BITS))) {
+            continue;
+        }
+        const u32 slot = static_cast<u32>((tick >> shift) & SLOT_MASK);
+        node.bucket = level * NUM_SLOTS + slot;
+        buckets[node.bucket].push_back(node);
+        occupied[level] |= 1ULL << slot;
+        return;
+    }
+    node.bucket = OVERFLOW_BUCKET;
+    buckets[OVERFLOW_BUCKET].push_back(node);
+}
+
+void TimerWheel::Cascade() {
+    for (u32 level = 1; level < NUM_LEVELS; ++level) {
+        if (occupied[level] == 0) {
+            continue;
+        }
+        // Occupied slots are always ahead of the cursor, so the lowest one is the next due
+        const u32 slot = static_cast<u32>(std::countr_zero(occupied[level]));
+        const u32 shift = level * SLOT_BITS;
+        const u64 upper_mask = ~((1ULL << (shift + SLOT_BITS)) - 1);
+        current_tick = (current_tick & upper_mask) | (u64{slot} << shift);
+        occupied[level] &= ~(1ULL << slot);
+        Relink(buckets[level * NUM_SLOTS + slot]);
+        return;
+    }
+    // Only nodes beyond the range of the wheel are left, jump straight to the first of them
+    u64 next_tick = std::numeric_limits<u64>::max();
+    for (const Node& node : buckets[OVERFLOW_BUCKET]) {
+        next_tick = std::min(next_tick, ToTick(node.time));
+    }
+    current_tick = std::max(current_tick, next_tick);
+    Relink(buckets[OVERFLOW_BUCKET]);
+}
+
+void TimerWheel::Relink(List& list) {
+    List pending;
+    pending.swap(list);
+    while (!pending.empty()) {
+        Node& node = pending.front();
+        pending.pop_front();
+        Link(node);
+    }
+}
+
+} // namespace Core::Timing
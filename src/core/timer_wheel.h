@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <boost/intrusive/list.hpp>
+
+#include "common/common_types.h"
+
+namespace Core::Timing {
+
+/**
+ * Hierarchical timing wheel holding intrusive nodes ordered by (time, fifo_order).
+ *
+ * Insertion and removal are O(1). Finding the earliest node cascades far away nodes into the
+ * finer levels, so every node is moved at most once per level over its lifetime. Nodes can
+ * also be linked into a Group, letting the owner cancel every node sharing a key without
+ * searching the wheel. The wheel is not thread safe and owns none of its nodes.
+ */
+class TimerWheel {
+    using AutoUnlink = boost::intrusive::link_mode<boost::intrusive::auto_unlink>;
+
+public:
+    struct Node : public boost::intrusive::list_base_hook<AutoUnlink> {
+        s64 time{};
+        u64 fifo_order{};
+        boost::intrusive::list_member_hook<AutoUnlink> group_hook;
+
+    private:
+        friend class TimerWheel;
+        u32 bucket{};
+    };
+
+    using Group =
+        boost::intrusive::list<Node,
+                               boost::intrusive::member_hook<
+                                   Node, boost::intrusive::list_member_hook<AutoUnlink>,
+                                   &Node::group_hook>,
+                               boost::intrusive::constant_time_size<false>>;
+
+    /// Nanoseconds covered by a slot of the finest level, rounded to a power of two
+    static constexpr u32 TICK_SHIFT = 10;
+    static constexpr u32 SLOT_BITS = 6;
+    static constexpr u32 NUM_SLOTS = 1U << SLOT_BITS;
+    static constexpr u32 NUM_LEVELS = 4;
+
+    void Insert(Node& node);
+
+    void Remove(Node& node);
+
+    /// Returns the node with the lowest (time, fifo_order), or nullptr when the wheel is empty.
+    [[nodiscard]] Node* Earliest();
+
+    void Clear();
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return size == 0;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size;
+    }
+
+private:
+    using List = boost::intrusive::list<Node, boost::intrusive::constant_time_size<false>>;
+
+    static constexpr u32 OVERFLOW_BUCKET = NUM_LEVELS * NUM_SLOTS;
+
+    /// Places a node in the bucket matching its distance from the current tick.
+    void Link(Node& node);
+
+    /// Moves the cursor to the next occupied coarse slot and spreads its nodes downwards.
+    void Cascade();
+
+    void Relink(List& list);
+
+    std::array<List, OVERFLOW_BUCKET + 1> buckets;
+    std::array<u64, NUM_LEVELS> occupied{};
+    u64 current_tick{};
+    size_t size{};
+};
+
+} // namespace Core::Timing
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/fs/file.h"
+#include "common/hash.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "core/device_memory.h"
+#include "core/tools/memory_snapshot.h"
+
+namespace Tools {
+
+using namespace Common::Literals;
+
+namespace {
+
+constexpr u32 SNAPSHOT_MAGIC = 0x4E534D59; // YMSN
+constexpr u32 SNAPSHOT_VERSION = 1;
+constexpr size_t CHUNK_SIZE = 2_MiB;
+constexpr s32 COMPRESSION_LEVEL = 1;
+
+enum class ChunkKind : u32 {
+    Zero,
+    Zstd,
+};
+
+struct SnapshotHeader {
+    u32 magic;
+    u32 version;
+    u64 memory_size;
+    u64 chunk_size;
+};
+static_assert(sizeof(SnapshotHeader) == 24);
+
+struct ChunkHeader {
+    ChunkKind kind;
+    u32 compressed_size;
+};
+static_assert(sizeof(ChunkHeader) == 8);
+
+} // Anonymous namespace
+
+MemorySnapshot::MemorySnapshot(Core::DeviceMemory& device_memory_)
+    : device_memory{device_memory_} {
+    const std::vector<u8> zeros(CHUNK_SIZE);
+    zero_hash = Common::RuntimeHash64(zeros.data(), zeros.size());
+}
+
+MemorySnapshot::~MemorySnapshot() = default;
+
+bool MemorySnapshot::Save(const std::filesystem::path& path) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open memory snapshot {} for writing", path.string());
+        return false;
+    }
+    const u8* const memory = device_memory.buffer.BackingBasePointer();
+    const size_t memory_size = device_memory.buffer.BackingSize();
+    const SnapshotHeader header{
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .memory_size = memory_size,
+        .chunk_size = CHUNK_SIZE,
+    };
+    if (!file.WriteObject(header)) {
+        return false;
+    }
+    chunks.resize(memory_size / CHUNK_SIZE);
+
+    size_t num_compressed = 0;
+    for (size_t index = 0; index < chunks.size(); ++index) {
+        const u8* const data = memory + index * CHUNK_SIZE;
+        const u64 hash = Common::RuntimeHash64(data, CHUNK_SIZE);
+        Chunk& chunk = chunks[index];
+        if (hash != chunk.hash || (chunk.compressed.empty() && hash != zero_hash)) {
+            chunk.hash = hash;
+            if (hash == zero_hash) {
+                chunk.compressed.clear();
+            } else {
+                chunk.compressed =
+                    Common::Compression::CompressDataZSTD(data, CHUNK_SIZE, COMPRESSION_LEVEL);
+                ++num_compressed;
+            }
+        }
+        const ChunkHeader chunk_header{
+            .kind = chunk.compressed.empty() ? ChunkKind::Zero : ChunkKind::Zstd,
+            .compressed_size = static_cast<u32>(chunk.compressed.size()),
+        };
+        if (!file.WriteObject(chunk_header) ||
+            file.WriteSpan(std::span<const u8>(chunk.compressed)) != chunk.compressed.size()) {
+            LOG_ERROR(Core, "Failed to write memory snapshot {}", path.string());
+            return false;
+        }
+    }
+    LOG_INFO(Core, "Saved memory snapshot {}, {} of {} chunks changed", path.string(),
+             num_compressed, chunks.size());
+    return true;
+}
+
+bool MemorySnapshot::Restore(const std::filesystem::path& path) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open memory snapshot {}", path.string());
+        return false;
+    }
+    u8* const memory = device_memory.buffer.BackingBasePointer();
+    const size_t memory_size = device_memory.buffer.BackingSize();
+    SnapshotHeader header{};
+    if (!file.ReadObject(header) || header.magic != SNAPSHOT_MAGIC ||
+        header.version != SNAPSHOT_VERSION || header.chunk_size != CHUNK_SIZE) {
+        LOG_ERROR(Core, "{} is not a memory snapshot", path.string());
+        return false;
+    }
+    if (header.memory_size != memory_size) {
+        LOG_ERROR(Core, "Memory snapshot {} is for 0x{:X} bytes of memory, not 0x{:X}",
+                  path.string(), header.memory_size, memory_size);
+        return false;
+    }
+    chunks.resize(memory_size / CHUNK_SIZE);
+
+    std::vector<u8> compressed;
+    for (size_t index = 0; index < chunks.size(); ++index) {
+        u8* const data = memory + index * CHUNK_SIZE;
+        ChunkHeader chunk_header{};
+        if (!file.ReadObject(chunk_header)) {
+            LOG_ERROR(Core, "Memory snapshot {} is truncated", path.string());
+            return false;
+        }
+        Chunk& chunk = chunks[index];
+        if (chunk_header.kind == ChunkKind::Zero) {
+            std::memset(data, 0, CHUNK_SIZE);
+            chunk.hash = zero_hash;
+            chunk.compressed.clear();
+            continue;
+        }
+        compressed.resize(chunk_header.compressed_size);
+        if (file.ReadSpan(std::span<u8>(compressed)) != compressed.size()) {
+            LOG_ERROR(Core, "Memory snapshot {} is truncated", path.string());
+            return false;
+        }
+        const std::vector<u8> decompressed = Common::Compression::DecompressDataZSTD(compressed);
+        if (decompressed.size() != CHUNK_SIZE) {
+            LOG_ERROR(Core, "Memory snapshot {} has a corrupted chunk at 0x{:X}", path.string(),
+                      index * CHUNK_SIZE);
+            return false;
+        }
+        std::memcpy(data, decompressed.data(), CHUNK_SIZE);
+        // What was just read is what the next save would write, keep it to skip recompressing
+        chunk.hash = Common::RuntimeHash64(data, CHUNK_SIZE);
+        chunk.compressed = std::move(compressed);
+        compressed = {};
+    }
+    return true;
+}
+
+} // namespace Tools
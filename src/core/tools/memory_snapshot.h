@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Core {
+class DeviceMemory;
+}
+
+namespace Tools {
+
+/**
+ * Saves and restores the contents of guest DRAM as a stream of zstd compressed chunks.
+ *
+ * Chunks are hashed on every save and only the ones that changed since the previous save made by
+ * the same object are compressed again, so periodic snapshots of a running title mostly cost the
+ * hashing. Chunks that are all zeros are stored without data.
+ *
+ * This only covers guest memory. Kernel objects, CPU contexts, services and GPU state are not
+ * serialized, so a restored image is meant for inspection and for comparing runs, it can not be
+ * resumed. Emulation has to be paused while saving or restoring.
+ */
+class MemorySnapshot {
+public:
+    explicit MemorySnapshot(Core::DeviceMemory& device_memory_);
+    ~MemorySnapshot();
+
+    /// Writes the current contents of guest memory to path, returns true on success
+    bool Save(const std::filesystem::path& path);
+
+    /// Reads a snapshot written by Save back into guest memory, returns true on success
+    bool Restore(const std::filesystem::path& path);
+
+private:
+    struct Chunk {
+        u64 hash{};
+        std::vector<u8> compressed;
+    };
+
+    Core::DeviceMemory& device_memory;
+    std::vector<Chunk> chunks;
+    u64 zero_hash{};
+};
+
+} // namespace Tools
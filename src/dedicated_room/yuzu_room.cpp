@@ -1,13 +1,18 @@
 // SPDX-FileCopyrightText: Copyright 2017 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <regex>
+#include <stop_token>
 #include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 // windows.h needs to be included before shellapi.h
@@ -16,6 +21,7 @@
 #include <shellapi.h>
 #endif
 
+#include <fmt/format.h>
 #include <mbedtls/base64.h>
 #include "common/common_types.h"
 #include "common/detached_tasks.h"
@@ -61,6 +67,8 @@ static void PrintHelp(const char* argv0) {
              "--ban-list-file     The file for storing the room ban list\n"
              "--log-file          The file for storing the room log\n"
              "--enable-yuzu-mods Allow yuzu Community Moderators to moderate on your room\n"
+             "--room-count        The number of rooms to host, on consecutive ports\n"
+             "--stats-interval    Seconds between room traffic reports, 0 to disable\n"
              "-h, --help          Display this help and exit\n"
              "-v, --version       Output version information and exit\n",
              argv0);
@@ -175,6 +183,57 @@ static void SaveBanList(const Network::Room::BanList& ban_list, const std::strin
     }
 }
 
+/// Combines the ban lists of several rooms, dropping duplicate entries.
+static Network::Room::BanList MergeBanLists(
+    const std::vector<std::shared_ptr<Network::Room>>& rooms) {
+    Network::Room::BanList merged_ban_list;
+    const auto merge = [](std::vector<std::string>& merged, const std::vector<std::string>& list) {
+        for (const auto& entry : list) {
+            if (std::find(merged.begin(), merged.end(), entry) == merged.end()) {
+                merged.push_back(entry);
+            }
+        }
+    };
+    for (const auto& room : rooms) {
+        const auto ban_list = room->GetBanList();
+        merge(merged_ban_list.first, ban_list.first);
+        merge(merged_ban_list.second, ban_list.second);
+    }
+    return merged_ban_list;
+}
+
+/// Periodically logs the traffic of every hosted room until a stop is requested.
+static void LogRoomStatistics(std::stop_token stop_token,
+                              const std::vector<std::shared_ptr<Network::Room>>& rooms,
+                              std::chrono::seconds interval) {
+    std::mutex mutex;
+    std::condition_variable_any cv;
+    std::vector<Network::RoomStatistics> previous(rooms.size());
+    const auto seconds = static_cast<double>(interval.count());
+
+    std::unique_lock lock{mutex};
+    while (!cv.wait_for(lock, stop_token, interval,
+                        [&stop_token] { return stop_token.stop_requested(); })) {
+        for (std::size_t i = 0; i < rooms.size(); ++i) {
+            const auto stats = rooms[i]->GetStatistics();
+            const auto& last = previous[i];
+            const u64 received = stats.packets_received - last.packets_received;
+            const u64 handling_time_us = stats.handling_time_us - last.handling_time_us;
+            LOG_INFO(Network,
+                     "Room on port {}: {} members, {:.1f}/{:.1f} packets/s in/out, "
+                     "{:.1f}/{:.1f} KiB/s in/out, handling time {} us average, {} us max",
+                     rooms[i]->GetRoomInformation().port, rooms[i]->GetRoomMemberList().size(),
+                     static_cast<double>(received) / seconds,
+                     static_cast<double>(stats.packets_sent - last.packets_sent) / seconds,
+                     static_cast<double>(stats.bytes_received - last.bytes_received) / 1024.0 /
+                         seconds,
+                     static_cast<double>(stats.bytes_sent - last.bytes_sent) / 1024.0 / seconds,
+                     received > 0 ? handling_time_us / received : 0, stats.max_handling_time_us);
+            previous[i] = stats;
+        }
+    }
+}
+
 static void InitializeLogging(const std::string& log_file) {
     Common::Log::Initialize();
     Common::Log::SetColorConsoleBackendEnabled(true);
@@ -200,6 +259,8 @@ int main(int argc, char** argv) {
     u64 preferred_game_id = 0;
     u32 port = Network::DefaultRoomPort;
     u32 max_members = 16;
+    u32 room_count = 1;
+    u32 stats_interval = 0;
     bool enable_yuzu_mods = false;
 
     static struct option long_options[] = {
@@ -217,6 +278,8 @@ int main(int argc, char** argv) {
         {"ban-list-file", required_argument, 0, 'b'},
         {"log-file", required_argument, 0, 'l'},
         {"enable-yuzu-mods", no_argument, 0, 'e'},
+        {"room-count", required_argument, 0, 'c'},
+        {"stats-interval", required_argument, 0, 'S'},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -226,7 +289,7 @@ int main(int argc, char** argv) {
 
     while (optind < argc) {
         int arg =
-            getopt_long(argc, argv, "n:d:s:p:m:w:g:u:t:a:i:l:hv", long_options, &option_index);
+            getopt_long(argc, argv, "n:d:s:p:m:w:g:u:t:a:i:l:c:S:hv", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'n':
@@ -271,6 +334,12 @@ int main(int argc, char** argv) {
             case 'e':
                 enable_yuzu_mods = true;
                 break;
+            case 'c':
+                room_count = strtoul(optarg, &endarg, 0);
+                break;
+            case 'S':
+                stats_interval = strtoul(optarg, &endarg, 0);
+                break;
             case 'h':
                 PrintHelp(argv[0]);
                 return 0;
@@ -310,6 +379,12 @@ int main(int argc, char** argv) {
         PrintHelp(argv[0]);
         return -1;
     }
+    if (room_count < 1 || port + room_count - 1 > UINT16_MAX) {
+        LOG_ERROR(Network, "room-count needs to be at least 1, and the ports of all rooms need to "
+                           "be in the range 0 - 65535!");
+        PrintHelp(argv[0]);
+        return -1;
+    }
     if (ban_list_file.empty()) {
         LOG_ERROR(Network, "Ban list file not set!\nThis should get set to load and save room ban "
                            "list.\nSet with --ban-list-file <file>");
@@ -349,55 +424,92 @@ int main(int argc, char** argv) {
         ban_list = LoadBanList(ban_list_file);
     }
 
-    std::unique_ptr<Network::VerifyUser::Backend> verify_backend;
+#ifndef ENABLE_WEB_SERVICE
     if (announce) {
-#ifdef ENABLE_WEB_SERVICE
-        verify_backend =
-            std::make_unique<WebService::VerifyUserJWT>(Settings::values.web_api_url.GetValue());
-#else
         LOG_INFO(Network,
                  "yuzu Web Services is not available with this build: validation is disabled.");
-        verify_backend = std::make_unique<Network::VerifyUser::NullBackend>();
-#endif
-    } else {
-        verify_backend = std::make_unique<Network::VerifyUser::NullBackend>();
     }
+#endif
+    const auto make_verify_backend = [&]() -> std::unique_ptr<Network::VerifyUser::Backend> {
+#ifdef ENABLE_WEB_SERVICE
+        if (announce) {
+            return std::make_unique<WebService::VerifyUserJWT>(
+                Settings::values.web_api_url.GetValue());
+        }
+#endif
+        return std::make_unique<Network::VerifyUser::NullBackend>();
+    };
 
-    Network::RoomNetwork network{};
-    network.Init();
-    if (auto room = network.GetRoom().lock()) {
+    // Every room has its own ENet host and server thread, so rooms never contend with each other
+    std::vector<std::unique_ptr<Network::RoomNetwork>> networks;
+    std::vector<std::shared_ptr<Network::Room>> rooms;
+    std::vector<std::unique_ptr<Core::AnnounceMultiplayerSession>> announce_sessions;
+    const auto shutdown_rooms = [&] {
+        if (announce) {
+            for (auto& announce_session : announce_sessions) {
+                announce_session->Stop();
+            }
+        }
+        announce_sessions.clear();
+        rooms.clear();
+        for (auto& network : networks) {
+            network->Shutdown();
+        }
+        networks.clear();
+    };
+
+    for (u32 i = 0; i < room_count; ++i) {
+        auto& network = *networks.emplace_back(std::make_unique<Network::RoomNetwork>());
+        network.Init();
+        auto room = network.GetRoom().lock();
+        const std::string name =
+            room_count > 1 ? fmt::format("{} {}", room_name, i + 1) : room_name;
+        const u16 room_port = static_cast<u16>(port + i);
         AnnounceMultiplayerRoom::GameInfo preferred_game_info{.name = preferred_game,
                                                               .id = preferred_game_id};
-        if (!room->Create(room_name, room_description, bind_address, static_cast<u16>(port),
-                          password, max_members, username, preferred_game_info,
-                          std::move(verify_backend), ban_list, enable_yuzu_mods)) {
-            LOG_INFO(Network, "Failed to create room: ");
+        if (!room->Create(name, room_description, bind_address, room_port, password, max_members,
+                          username, preferred_game_info, make_verify_backend(), ban_list,
+                          enable_yuzu_mods)) {
+            LOG_INFO(Network, "Failed to create room on port {}", room_port);
+            shutdown_rooms();
             return -1;
         }
-        LOG_INFO(Network, "Room is open. Close with Q+Enter...");
-        auto announce_session = std::make_unique<Core::AnnounceMultiplayerSession>(network);
+        rooms.push_back(std::move(room));
+        auto& announce_session = announce_sessions.emplace_back(
+            std::make_unique<Core::AnnounceMultiplayerSession>(network));
         if (announce) {
             announce_session->Start();
         }
-        while (room->GetState() == Network::Room::State::Open) {
-            std::string in;
-            std::cin >> in;
-            if (in.size() > 0) {
-                break;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        if (announce) {
-            announce_session->Stop();
-        }
-        announce_session.reset();
-        // Save the ban list
-        if (!ban_list_file.empty()) {
-            SaveBanList(room->GetBanList(), ban_list_file);
+    }
+
+    std::jthread stats_thread;
+    if (stats_interval > 0) {
+        stats_thread = std::jthread([&rooms, stats_interval](std::stop_token stop_token) {
+            LogRoomStatistics(stop_token, rooms, std::chrono::seconds{stats_interval});
+        });
+    }
+
+    LOG_INFO(Network, "{} room(s) open. Close with Q+Enter...", rooms.size());
+    const auto all_rooms_open = [&rooms] {
+        return std::all_of(rooms.begin(), rooms.end(), [](const auto& room) {
+            return room->GetState() == Network::Room::State::Open;
+        });
+    };
+    while (all_rooms_open()) {
+        std::string in;
+        std::cin >> in;
+        if (in.size() > 0) {
+            break;
         }
-        room->Destroy();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    stats_thread = {};
+
+    // Save the ban list
+    if (!ban_list_file.empty()) {
+        SaveBanList(MergeBanLists(rooms), ban_list_file);
     }
-    network.Shutdown();
+    shutdown_rooms();
     detached_tasks.WaitForAllTasks();
     return 0;
 }
@@ -15,6 +15,10 @@ namespace Core::HID {
 constexpr s32 HID_JOYSTICK_MAX = 0x7fff;
 constexpr s32 HID_TRIGGER_MAX = 0x7fff;
 constexpr u32 TURBO_BUTTON_DELAY = 4;
+// Motion samples are fused once this many microseconds of them are buffered, the HID motion rate
+constexpr u64 MOTION_BATCH_TIME = 5000;
+// Fused motion samples between reports of their processing cost
+constexpr u64 MOTION_REPORT_INTERVAL = 60000;
 // Use a common UUID for TAS and Virtual Gamepad
 constexpr Common::UUID TAS_UUID =
     Common::UUID{{0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x7, 0xA5, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}};
@@ -414,6 +418,7 @@ void EmulatedController::ReloadInput() {
         });
 
         // Restore motion state
+        motion_batches[index].Clear();
         auto& emulated_motion = controller.motion_values[index].emulated;
         auto& motion = controller.motion_state[index];
         emulated_motion.ResetRotations();
@@ -425,6 +430,10 @@ void EmulatedController::ReloadInput() {
         motion.orientation = emulated_motion.GetOrientation();
         motion.is_at_rest = !emulated_motion.IsMoving(motion_sensitivity);
     }
+    {
+        std::scoped_lock lock{mutex};
+        PublishServiceState();
+    }
 
     for (std::size_t index = 0; index < camera_devices.size(); ++index) {
         if (!camera_devices[index]) {
@@ -574,14 +583,21 @@ void EmulatedController::UnloadInput() {
 }
 
 void EmulatedController::EnableConfiguration() {
-    std::scoped_lock lock{connect_mutex, npad_mutex};
+    std::scoped_lock lock{connect_mutex, npad_mutex, mutex};
     is_configuring = true;
+    PublishServiceState();
+    state_generation.fetch_add(1, std::memory_order_release);
     tmp_is_connected = is_connected;
     tmp_npad_type = npad_type;
 }
 
 void EmulatedController::DisableConfiguration() {
-    is_configuring = false;
+    {
+        std::scoped_lock lock{mutex};
+        is_configuring = false;
+        PublishServiceState();
+    }
+    state_generation.fetch_add(1, std::memory_order_release);
 
     // Get Joycon colors before turning on the controller
     for (const auto& color_device : color_devices) {
@@ -811,6 +827,7 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
         controller.debug_pad_button_state.raw = 0;
         controller.home_button_state.raw = 0;
         controller.capture_button_state.raw = 0;
+        PublishServiceState();
         lock.unlock();
         TriggerOnChange(ControllerTriggerType::Button, false);
         return;
@@ -915,6 +932,7 @@ void EmulatedController::SetButton(const Common::Input::CallbackStatus& callback
         break;
     }
 
+    PublishServiceState();
     lock.unlock();
 
     if (!is_connected) {
@@ -937,6 +955,9 @@ void EmulatedController::SetStick(const Common::Input::CallbackStatus& callback,
         TriggerOnChange(ControllerTriggerType::Stick, !is_configuring);
     };
     std::scoped_lock lock{mutex};
+    SCOPE_EXIT {
+        PublishServiceState();
+    };
     const auto stick_value = TransformToStick(callback);
 
     // Only read stick values that have the same uuid or are over the threshold to avoid flapping
@@ -994,6 +1015,9 @@ void EmulatedController::SetTrigger(const Common::Input::CallbackStatus& callbac
         TriggerOnChange(ControllerTriggerType::Trigger, !is_configuring);
     };
     std::scoped_lock lock{mutex};
+    SCOPE_EXIT {
+        PublishServiceState();
+    };
     const auto trigger_value = TransformToTrigger(callback);
 
     // Only read trigger values that have the same uuid or are pressed once
@@ -1038,27 +1062,32 @@ void EmulatedController::SetMotion(const Common::Input::CallbackStatus& callback
     if (index >= controller.motion_values.size()) {
         return;
     }
-    SCOPE_EXIT {
+    auto trigger_guard = SCOPE_GUARD {
         TriggerOnChange(ControllerTriggerType::Motion, !is_configuring);
     };
     std::scoped_lock lock{mutex};
     auto& raw_status = controller.motion_values[index].raw_status;
     auto& emulated = controller.motion_values[index].emulated;
+    auto& batch = motion_batches[index];
 
     raw_status = TransformToMotion(callback);
-    emulated.SetAcceleration(Common::Vec3f{
-        raw_status.accel.x.value,
-        raw_status.accel.y.value,
-        raw_status.accel.z.value,
+    batch.Push({
+        .accel = {raw_status.accel.x.value, raw_status.accel.y.value, raw_status.accel.z.value},
+        .gyro = {raw_status.gyro.x.value, raw_status.gyro.y.value, raw_status.gyro.z.value},
+        .user_gyro_threshold = raw_status.gyro.x.properties.threshold,
+        .elapsed_time = raw_status.delta_timestamp,
     });
-    emulated.SetGyroscope(Common::Vec3f{
-        raw_status.gyro.x.value,
-        raw_status.gyro.y.value,
-        raw_status.gyro.z.value,
-    });
-    emulated.SetUserGyroThreshold(raw_status.gyro.x.properties.threshold);
-    emulated.UpdateRotation(raw_status.delta_timestamp);
-    emulated.UpdateOrientation(raw_status.delta_timestamp);
+
+    // High rate devices are fused and reported once per HID motion update instead of per sample
+    if (!raw_status.force_update && !batch.IsFull() && batch.ElapsedTime() < MOTION_BATCH_TIME) {
+        trigger_guard.Cancel();
+        return;
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const u64 num_samples = batch.Samples().size();
+    emulated.UpdateBatch(batch.Samples());
+    batch.Clear();
 
     auto& motion = controller.motion_state[index];
     motion.accel = emulated.GetAcceleration();
@@ -1067,6 +1096,20 @@ void EmulatedController::SetMotion(const Common::Input::CallbackStatus& callback
     motion.euler = emulated.GetEulerAngles();
     motion.orientation = emulated.GetOrientation();
     motion.is_at_rest = !emulated.IsMoving(motion_sensitivity);
+    PublishServiceState();
+
+    const auto processing_time = std::chrono::steady_clock::now() - start_time;
+    const u64 previous_samples = motion_stats.num_samples;
+    motion_stats.num_samples += num_samples;
+    motion_stats.num_batches++;
+    motion_stats.processing_time_ns += static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(processing_time).count());
+    if (previous_samples / MOTION_REPORT_INTERVAL !=
+        motion_stats.num_samples / MOTION_REPORT_INTERVAL) {
+        LOG_DEBUG(Input, "Motion fusion: {} samples in {} batches, {} ns per sample",
+                  motion_stats.num_samples, motion_stats.num_batches,
+                  motion_stats.processing_time_ns / motion_stats.num_samples);
+    }
 }
 
 void EmulatedController::SetColors(const Common::Input::CallbackStatus& callback,
@@ -1873,42 +1916,48 @@ CaptureButtonState EmulatedController::GetCaptureButtons() const {
 }
 
 NpadButtonState EmulatedController::GetNpadButtons() const {
-    std::scoped_lock lock{mutex};
-    if (is_configuring) {
+    const ControllerServiceState state = service_state.Load();
+    if (state.is_configuring) {
         return {};
     }
-    return {controller.npad_button_state.raw & GetTurboButtonMask()};
+    // Turbo buttons read as released for half of every turbo period
+    if (turbo_button_state.load(std::memory_order_relaxed) < TURBO_BUTTON_DELAY) {
+        return state.npad_button_state;
+    }
+    return {state.npad_button_state.raw & static_cast<NpadButton>(~state.turbo_buttons)};
 }
 
 DebugPadButton EmulatedController::GetDebugPadButtons() const {
-    std::scoped_lock lock{mutex};
-    if (is_configuring) {
+    const ControllerServiceState state = service_state.Load();
+    if (state.is_configuring) {
         return {};
     }
-    return controller.debug_pad_button_state;
+    return state.debug_pad_button_state;
 }
 
 AnalogSticks EmulatedController::GetSticks() const {
-    std::scoped_lock lock{mutex};
-
-    if (is_configuring) {
+    const ControllerServiceState state = service_state.Load();
+    if (state.is_configuring) {
         return {};
     }
-
-    return controller.analog_stick_state;
+    return state.analog_stick_state;
 }
 
 NpadGcTriggerState EmulatedController::GetTriggers() const {
-    std::scoped_lock lock{mutex};
-    if (is_configuring) {
+    const ControllerServiceState state = service_state.Load();
+    if (state.is_configuring) {
         return {};
     }
-    return controller.gc_trigger_state;
+    return state.gc_trigger_state;
 }
 
 MotionState EmulatedController::GetMotions() const {
-    std::unique_lock lock{mutex};
-    return controller.motion_state;
+    return service_state.Load().motion_state;
+}
+
+MotionProcessingStats EmulatedController::GetMotionProcessingStats() const {
+    std::scoped_lock lock{mutex};
+    return motion_stats;
 }
 
 ControllerColors EmulatedController::GetColors() const {
@@ -1945,6 +1994,7 @@ NpadColor EmulatedController::GetNpadColor(u32 color) {
 }
 
 void EmulatedController::TriggerOnChange(ControllerTriggerType type, bool is_npad_service_update) {
+    state_generation.fetch_add(1, std::memory_order_release);
     std::scoped_lock lock{callback_mutex};
     for (const auto& poller_pair : callback_list) {
         const ControllerUpdateCallback& poller = poller_pair.second;
@@ -1974,7 +2024,9 @@ void EmulatedController::DeleteCallback(int key) {
 }
 
 void EmulatedController::StatusUpdate() {
-    turbo_button_state = (turbo_button_state + 1) % (TURBO_BUTTON_DELAY * 2);
+    const u32 turbo_state = turbo_button_state.load(std::memory_order_relaxed);
+    turbo_button_state.store((turbo_state + 1) % (TURBO_BUTTON_DELAY * 2),
+                             std::memory_order_relaxed);
 
     // Some drivers like key motion need constant refreshing
     for (std::size_t index = 0; index < motion_devices.size(); ++index) {
@@ -1990,12 +2042,31 @@ void EmulatedController::StatusUpdate() {
     }
 }
 
-NpadButton EmulatedController::GetTurboButtonMask() const {
-    // Apply no mask when disabled
-    if (turbo_button_state < TURBO_BUTTON_DELAY) {
-        return {NpadButton::All};
-    }
+u64 EmulatedController::GetStateGeneration() const {
+    return state_generation.load(std::memory_order_acquire);
+}
+
+bool EmulatedController::NeedsStatusUpdate() const {
+    std::scoped_lock lock{mutex};
+    const auto is_turbo = [](const auto& button) { return button.turbo; };
+    const auto is_forced = [](const auto& motion) { return motion.raw_status.force_update; };
+    return std::ranges::any_of(controller.button_values, is_turbo) ||
+           std::ranges::any_of(controller.motion_values, is_forced);
+}
+
+void EmulatedController::PublishServiceState() {
+    service_state.Store({
+        .npad_button_state = controller.npad_button_state,
+        .debug_pad_button_state = controller.debug_pad_button_state,
+        .analog_stick_state = controller.analog_stick_state,
+        .gc_trigger_state = controller.gc_trigger_state,
+        .motion_state = controller.motion_state,
+        .turbo_buttons = GetTurboButtons(),
+        .is_configuring = is_configuring,
+    });
+}
 
+NpadButton EmulatedController::GetTurboButtons() const {
     NpadButtonState button_mask{};
     for (std::size_t index = 0; index < controller.button_values.size(); ++index) {
         if (!controller.button_values[index].turbo) {
@@ -2056,7 +2127,7 @@ NpadButton EmulatedController::GetTurboButtonMask() const {
         }
     }
 
-    return static_cast<NpadButton>(~button_mask.raw);
+    return button_mask.raw;
 }
 
 } // namespace Core::HID
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -13,6 +14,7 @@
 #include "common/common_types.h"
 #include "common/input.h"
 #include "common/param_package.h"
+#include "common/seqlock.h"
 #include "common/settings.h"
 #include "common/vector_math.h"
 #include "hid_core/frontend/motion_input.h"
@@ -147,6 +149,24 @@ struct ControllerStatus {
     Common::Input::PollingMode right_polling_mode{};
 };
 
+// Cost of fusing motion samples into the controller orientation
+struct MotionProcessingStats {
+    u64 num_samples{};
+    u64 num_batches{};
+    u64 processing_time_ns{};
+};
+
+// Controller state read by the HID services on every update
+struct ControllerServiceState {
+    NpadButtonState npad_button_state{};
+    DebugPadButton debug_pad_button_state{};
+    AnalogSticks analog_stick_state{};
+    NpadGcTriggerState gc_trigger_state{};
+    MotionState motion_state{};
+    NpadButton turbo_buttons{};
+    bool is_configuring{};
+};
+
 enum class ControllerTriggerType {
     Button,
     Stick,
@@ -340,6 +360,9 @@ public:
     /// Returns the latest status of motion input from the mouse
     MotionState GetMotions() const;
 
+    /// Returns the number of motion samples fused so far and the time it took
+    MotionProcessingStats GetMotionProcessingStats() const;
+
     /// Returns the latest color value from the controller
     ControllerColors GetColors() const;
 
@@ -468,6 +491,19 @@ public:
     /// Swaps the state of the turbo buttons and updates motion input
     void StatusUpdate();
 
+    /**
+     * Returns a counter that changes every time the controller state may have changed
+     * @return the current state generation of the controller
+     */
+    u64 GetStateGeneration() const;
+
+    /**
+     * Checks if the state can change without input, because of turbo buttons or motion devices
+     * that need constant refreshing
+     * @return true if StatusUpdate must be called on every update
+     */
+    bool NeedsStatusUpdate() const;
+
 private:
     /// creates input devices from params
     void LoadDevices();
@@ -561,6 +597,9 @@ private:
      */
     NpadColor GetNpadColor(u32 color);
 
+    /// Copies the state read by the HID services to service_state, with mutex held
+    void PublishServiceState();
+
     /**
      * Triggers a callback that something has changed on the controller status
      * @param type Input type of the event to trigger
@@ -568,7 +607,7 @@ private:
      */
     void TriggerOnChange(ControllerTriggerType type, bool is_service_update);
 
-    NpadButton GetTurboButtonMask() const;
+    NpadButton GetTurboButtons() const;
 
     const NpadIdType npad_id_type;
     NpadStyleIndex npad_type{NpadStyleIndex::None};
@@ -579,7 +618,7 @@ private:
     bool is_initialized{false};
     bool system_buttons_enabled{true};
     f32 motion_sensitivity{Core::HID::MotionInput::IsAtRestStandard};
-    u32 turbo_button_state{0};
+    std::atomic<u32> turbo_button_state{0};
     std::size_t nfc_handles{0};
     std::array<VibrationValue, 2> last_vibration_value{DEFAULT_VIBRATION_VALUE,
                                                        DEFAULT_VIBRATION_VALUE};
@@ -632,9 +671,17 @@ private:
     mutable std::mutex connect_mutex;
     std::unordered_map<int, ControllerUpdateCallback> callback_list;
     int last_callback_key = 0;
+    std::atomic<u64> state_generation{};
 
     // Stores the current status of all controller input
     ControllerStatus controller;
+
+    // Motion samples not fused yet, and the cost of fusing them
+    std::array<MotionSampleBatch, Settings::NativeMotion::NumMotions> motion_batches{};
+    MotionProcessingStats motion_stats{};
+
+    // Published through a sequence lock, so HID updates never wait for an input driver thread
+    Common::SeqLock<ControllerServiceState> service_state;
 };
 
 } // namespace Core::HID
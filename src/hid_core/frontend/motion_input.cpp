@@ -113,6 +113,16 @@ void MotionInput::UpdateRotation(u64 elapsed_time) {
     rotations += gyro * sample_period;
 }
 
+void MotionInput::UpdateBatch(std::span<const MotionSample> samples) {
+    for (const MotionSample& sample : samples) {
+        SetAcceleration(sample.accel);
+        SetGyroscope(sample.gyro);
+        SetUserGyroThreshold(sample.user_gyro_threshold);
+        UpdateRotation(sample.elapsed_time);
+        UpdateOrientation(sample.elapsed_time);
+    }
+}
+
 void MotionInput::Calibrate() {
     calibration_mode = true;
     calibration_counter = 0;
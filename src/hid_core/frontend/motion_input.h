@@ -3,12 +3,58 @@
 
 #pragma once
 
+#include <array>
+#include <span>
+
 #include "common/common_types.h"
 #include "common/quaternion.h"
 #include "common/vector_math.h"
 
 namespace Core::HID {
 
+/// Sensor reading waiting to be fused into the device orientation
+struct MotionSample {
+    Common::Vec3f accel{};
+    Common::Vec3f gyro{};
+    f32 user_gyro_threshold{};
+    // Time since the previous sample in microseconds
+    u64 elapsed_time{};
+};
+
+/// Fixed capacity buffer of motion samples, fused together by MotionInput::UpdateBatch
+class MotionSampleBatch {
+public:
+    static constexpr std::size_t Capacity = 16;
+
+    void Push(const MotionSample& sample) {
+        samples[count++] = sample;
+        elapsed_time += sample.elapsed_time;
+    }
+
+    void Clear() {
+        count = 0;
+        elapsed_time = 0;
+    }
+
+    [[nodiscard]] bool IsFull() const {
+        return count == Capacity;
+    }
+
+    /// Returns the time covered by the buffered samples in microseconds
+    [[nodiscard]] u64 ElapsedTime() const {
+        return elapsed_time;
+    }
+
+    [[nodiscard]] std::span<const MotionSample> Samples() const {
+        return {samples.data(), count};
+    }
+
+private:
+    std::array<MotionSample, Capacity> samples{};
+    std::size_t count{};
+    u64 elapsed_time{};
+};
+
 class MotionInput {
 public:
     static constexpr float ThresholdLoose = 0.01f;
@@ -51,6 +97,9 @@ public:
     void UpdateRotation(u64 elapsed_time);
     void UpdateOrientation(u64 elapsed_time);
 
+    /// Fuses the samples in order, as if each was set and updated on its own
+    void UpdateBatch(std::span<const MotionSample> samples);
+
     void Calibrate();
 
     [[nodiscard]] std::array<Common::Vec3f, 3> GetOrientation() const;
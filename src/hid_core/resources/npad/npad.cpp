@@ -500,7 +500,15 @@ void NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing) {
                 continue;
             }
 
-            RequestPadStateUpdate(aruid, controller.device->GetNpadIdType());
+            // Without new input the last pad state is written again with the next sampling number
+            const u64 state_generation = controller.device->GetStateGeneration();
+            if (!Settings::values.hid_event_driven_updates.GetValue() ||
+                !controller.is_state_read || controller.state_generation != state_generation ||
+                !controller.is_connected || controller.device->NeedsStatusUpdate()) {
+                RequestPadStateUpdate(aruid, controller.device->GetNpadIdType());
+                controller.state_generation = state_generation;
+                controller.is_state_read = true;
+            }
             auto& pad_state = controller.npad_pad_state;
             auto& libnx_state = controller.npad_libnx_state;
             auto& trigger_state = controller.npad_trigger_state;
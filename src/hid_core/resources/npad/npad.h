@@ -178,6 +178,10 @@ private:
         NPadGenericState npad_libnx_state{};
         NpadGcTriggerState npad_trigger_state{};
         int callback_key{};
+
+        // Controller state generation the pad state was read at
+        u64 state_generation{};
+        bool is_state_read{};
     };
 
     void ControllerUpdate(Core::HID::ControllerTriggerType type, std::size_t controller_idx);
@@ -419,7 +419,8 @@ void SDLDriver::CloseJoystick(SDL_Joystick* sdl_joystick) {
 }
 
 void SDLDriver::PumpEvents() const {
-    if (initialized) {
+    // The event thread already pumps events as they arrive
+    if (initialized && !start_thread) {
         SDL_PumpEvents();
     }
 }
@@ -541,14 +542,9 @@ SDLDriver::SDLDriver(std::string input_engine_) : InputEngine(std::move(input_en
 
     initialized = true;
     if (start_thread) {
-        vibration_thread = std::thread([this] {
-            Common::SetCurrentThreadName("SDL_Vibration");
-            using namespace std::chrono_literals;
-            while (initialized) {
-                SendVibrations();
-                std::this_thread::sleep_for(10ms);
-            }
-        });
+        wake_event_type = SDL_RegisterEvents(1);
+        event_thread =
+            std::jthread([this](std::stop_token stop_token) { EventThread(stop_token); });
     }
     // Because the events for joystick connection happens before we have our event watcher added, we
     // can just open all the joysticks right here
@@ -563,7 +559,9 @@ SDLDriver::~SDLDriver() {
 
     initialized = false;
     if (start_thread) {
-        vibration_thread.join();
+        event_thread.request_stop();
+        WakeEventThread();
+        event_thread.join();
         SDL_QuitSubSystem(SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER);
     }
 }
@@ -647,6 +645,9 @@ Common::Input::DriverResult SDLDriver::SetVibration(
         .identifier = identifier,
         .vibration = new_vibration,
     });
+    if (start_thread) {
+        WakeEventThread();
+    }
 
     return Common::Input::DriverResult::Success;
 }
@@ -715,6 +716,47 @@ void SDLDriver::SendVibrations() {
     }
 }
 
+void SDLDriver::EventThread(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("SDL_Input");
+
+    // Vibrations are coalesced by controller and sent at most this often
+    constexpr auto vibration_interval = std::chrono::milliseconds{10};
+    // Longest wait for events, in case a wake up event could not be pushed
+    constexpr int max_wait_ms = 100;
+
+    auto next_vibration_time = std::chrono::steady_clock::now();
+    while (!stop_token.stop_requested()) {
+        int wait_ms = max_wait_ms;
+        if (!vibration_queue.Empty()) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= next_vibration_time) {
+                SendVibrations();
+                next_vibration_time = now + vibration_interval;
+            } else {
+                wait_ms = static_cast<int>(
+                    std::chrono::ceil<std::chrono::milliseconds>(next_vibration_time - now)
+                        .count());
+            }
+        }
+
+        // The event watcher handles every event as it is pumped, so the queue is only drained
+        SDL_Event event;
+        if (SDL_WaitEventTimeout(&event, wait_ms) == 1) {
+            while (SDL_PollEvent(&event) == 1) {
+            }
+        }
+    }
+}
+
+void SDLDriver::WakeEventThread() {
+    if (wake_event_type == static_cast<u32>(-1)) {
+        return;
+    }
+    SDL_Event event{};
+    event.type = wake_event_type;
+    SDL_PushEvent(&event);
+}
+
 Common::ParamPackage SDLDriver::BuildAnalogParamPackageForButton(int port, const Common::UUID& guid,
                                                                  s32 axis, float value) const {
     Common::ParamPackage params{};
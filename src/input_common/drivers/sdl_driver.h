@@ -5,12 +5,12 @@
 
 #include <atomic>
 #include <mutex>
-#include <thread>
 #include <unordered_map>
 
 #include <SDL.h>
 
 #include "common/common_types.h"
+#include "common/polyfill_thread.h"
 #include "common/threadsafe_queue.h"
 #include "input_common/input_engine.h"
 
@@ -78,6 +78,12 @@ private:
     /// Takes all vibrations from the queue and sends the command to the controller
     void SendVibrations();
 
+    /// Waits for SDL events and sends queued vibrations, when the driver owns the event loop
+    void EventThread(std::stop_token stop_token);
+
+    /// Wakes the event thread up from its wait for SDL events
+    void WakeEventThread();
+
     Common::ParamPackage BuildAnalogParamPackageForButton(int port, const Common::UUID& guid,
                                                           s32 axis, float value = 0.1f) const;
     Common::ParamPackage BuildButtonParamPackageForButton(int port, const Common::UUID& guid,
@@ -122,6 +128,8 @@ private:
     bool start_thread = false;
     std::atomic<bool> initialized = false;
 
-    std::thread vibration_thread;
+    /// SDL event type pushed to wake the event thread up
+    u32 wake_event_type{};
+    std::jthread event_thread;
 };
 } // namespace InputCommon
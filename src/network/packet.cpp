@@ -25,6 +25,12 @@ static u64 ntohll(u64 x) {
 #endif
 
 void Packet::Append(const void* in_data, std::size_t size_in_bytes) {
+    if (external_data) {
+        // Take a copy of the wrapped buffer before modifying it
+        data.assign(external_data, external_data + external_size);
+        external_data = nullptr;
+        external_size = 0;
+    }
     if (in_data && (size_in_bytes > 0)) {
         std::size_t start = data.size();
         data.resize(start + size_in_bytes);
@@ -32,21 +38,32 @@ void Packet::Append(const void* in_data, std::size_t size_in_bytes) {
     }
 }
 
+void Packet::Wrap(std::span<const u8> buffer) {
+    data.clear();
+    external_data = reinterpret_cast<const char*>(buffer.data());
+    external_size = buffer.size();
+    read_pos = 0;
+    is_valid = true;
+}
+
 void Packet::Read(void* out_data, std::size_t size_in_bytes) {
     if (out_data && CheckSize(size_in_bytes)) {
-        std::memcpy(out_data, &data[read_pos], size_in_bytes);
+        std::memcpy(out_data, &Buffer()[read_pos], size_in_bytes);
         read_pos += size_in_bytes;
     }
 }
 
 void Packet::Clear() {
     data.clear();
+    external_data = nullptr;
+    external_size = 0;
     read_pos = 0;
     is_valid = true;
 }
 
 const void* Packet::GetData() const {
-    return !data.empty() ? &data[0] : nullptr;
+    const auto buffer = Buffer();
+    return !buffer.empty() ? buffer.data() : nullptr;
 }
 
 void Packet::IgnoreBytes(u32 length) {
@@ -54,11 +71,11 @@ void Packet::IgnoreBytes(u32 length) {
 }
 
 std::size_t Packet::GetDataSize() const {
-    return data.size();
+    return Buffer().size();
 }
 
 bool Packet::EndOfPacket() const {
-    return read_pos >= data.size();
+    return read_pos >= Buffer().size();
 }
 
 Packet::operator bool() const {
@@ -142,7 +159,7 @@ Packet& Packet::Read(char* out_data) {
 
     if ((length > 0) && CheckSize(length)) {
         // Then extract characters
-        std::memcpy(out_data, &data[read_pos], length);
+        std::memcpy(out_data, &Buffer()[read_pos], length);
         out_data[length] = '\0';
 
         // Update reading position
@@ -160,7 +177,7 @@ Packet& Packet::Read(std::string& out_data) {
     out_data.clear();
     if ((length > 0) && CheckSize(length)) {
         // Then extract characters
-        out_data.assign(&data[read_pos], length);
+        out_data.assign(&Buffer()[read_pos], length);
 
         // Update reading position
         read_pos += length;
@@ -254,9 +271,16 @@ Packet& Packet::Write(const std::string& in_data) {
 }
 
 bool Packet::CheckSize(std::size_t size) {
-    is_valid = is_valid && (read_pos + size <= data.size());
+    is_valid = is_valid && (read_pos + size <= Buffer().size());
 
     return is_valid;
 }
 
+std::span<const char> Packet::Buffer() const {
+    if (external_data) {
+        return {external_data, external_size};
+    }
+    return data;
+}
+
 } // namespace Network
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <vector>
 #include "common/common_types.h"
 
@@ -22,6 +23,13 @@ public:
      */
     void Append(const void* data, std::size_t size_in_bytes);
 
+    /**
+     * Makes the packet read from an external buffer without copying it. The buffer must outlive
+     * the packet, or the next Append or Clear call.
+     * @param buffer Bytes to read from
+     */
+    void Wrap(std::span<const u8> buffer);
+
     /**
      * Reads data from the current read position of the packet
      * @param out_data        Pointer where the data should get written to
@@ -110,10 +118,15 @@ private:
      */
     bool CheckSize(std::size_t size);
 
+    /// Returns the bytes read from the packet, either its own data or the wrapped buffer
+    std::span<const char> Buffer() const;
+
     // Member data
-    std::vector<char> data;   ///< Data stored in the packet
-    std::size_t read_pos = 0; ///< Current reading position in the packet
-    bool is_valid = true;     ///< Reading state of the packet
+    std::vector<char> data;        ///< Data stored in the packet
+    const char* external_data{};   ///< Wrapped buffer read instead of data, if any
+    std::size_t external_size = 0; ///< Size of the wrapped buffer
+    std::size_t read_pos = 0;      ///< Current reading position in the packet
+    bool is_valid = true;          ///< Reading state of the packet
 };
 
 template <typename T>
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <mutex>
 #include <random>
@@ -39,6 +40,7 @@ public:
         /// Data of the user, often including authenticated forum username.
         VerifyUser::UserData user_data;
         ENetPeer* peer; ///< The remote peer.
+        u8 features;    ///< RoomFeatureFlags supported by the member.
     };
     using MemberList = std::vector<Member>;
     MemberList members;                     ///< Information about the members of this room
@@ -48,6 +50,13 @@ public:
     IPBanList ip_ban_list;             ///< List of banned IP addresses
     mutable std::mutex ban_list_mutex; ///< Mutex for the ban lists
 
+    std::atomic<u64> packets_received{};     ///< Number of packets received from members
+    std::atomic<u64> packets_sent{};         ///< Number of packets sent to members
+    std::atomic<u64> bytes_received{};       ///< Number of bytes received from members
+    std::atomic<u64> bytes_sent{};           ///< Number of bytes sent to members
+    std::atomic<u64> handling_time_us{};     ///< Total time spent handling received packets
+    std::atomic<u64> max_handling_time_us{}; ///< Longest time spent handling a single packet
+
     RoomImpl() : random_gen(std::random_device()()) {}
 
     /// Thread that receives and dispatches network packets
@@ -60,6 +69,12 @@ public:
     void ServerLoop();
     void StartLoop();
 
+    /// Queues an ENet packet to be sent to the peer, and counts it in the room statistics.
+    void SendPacket(ENetPeer* peer, ENetPacket* packet);
+
+    /// Records the time spent handling a received packet of the given size.
+    void RecordReceivedPacket(std::size_t size, std::chrono::microseconds handling_time);
+
     /**
      * Parses and answers a room join request from a client.
      * Validates the uniqueness of the username and assigns the MAC address
@@ -242,7 +257,8 @@ void Room::RoomImpl::ServerLoop() {
         ENetEvent event;
         if (enet_host_service(server, &event, 5) > 0) {
             switch (event.type) {
-            case ENET_EVENT_TYPE_RECEIVE:
+            case ENET_EVENT_TYPE_RECEIVE: {
+                const auto handling_start = std::chrono::steady_clock::now();
                 switch (event.packet->data[0]) {
                 case IdJoinRequest:
                     HandleJoinRequest(&event);
@@ -254,6 +270,7 @@ void Room::RoomImpl::ServerLoop() {
                     HandleProxyPacket(&event);
                     break;
                 case IdLdnPacket:
+                case IdLdnPacketCompressed:
                     HandleLdnPacket(&event);
                     break;
                 case IdChatMessage:
@@ -273,8 +290,15 @@ void Room::RoomImpl::ServerLoop() {
                     HandleModGetBanListPacket(&event);
                     break;
                 }
-                enet_packet_destroy(event.packet);
+                RecordReceivedPacket(event.packet->dataLength,
+                                     std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::steady_clock::now() - handling_start));
+                // Forwarded packets are destroyed by ENet once they were sent
+                if (event.packet->referenceCount == 0) {
+                    enet_packet_destroy(event.packet);
+                }
                 break;
+            }
             case ENET_EVENT_TYPE_DISCONNECT:
                 HandleClientDisconnection(event.peer);
                 break;
@@ -292,16 +316,34 @@ void Room::RoomImpl::StartLoop() {
     room_thread = std::make_unique<std::thread>(&Room::RoomImpl::ServerLoop, this);
 }
 
+void Room::RoomImpl::SendPacket(ENetPeer* peer, ENetPacket* packet) {
+    packets_sent.fetch_add(1, std::memory_order_relaxed);
+    bytes_sent.fetch_add(packet->dataLength, std::memory_order_relaxed);
+    enet_peer_send(peer, 0, packet);
+}
+
+void Room::RoomImpl::RecordReceivedPacket(std::size_t size,
+                                          std::chrono::microseconds handling_time) {
+    const auto time_us = static_cast<u64>(handling_time.count());
+    packets_received.fetch_add(1, std::memory_order_relaxed);
+    bytes_received.fetch_add(size, std::memory_order_relaxed);
+    handling_time_us.fetch_add(time_us, std::memory_order_relaxed);
+    // Only the room thread updates the maximum, so a plain compare is enough
+    if (time_us > max_handling_time_us.load(std::memory_order_relaxed)) {
+        max_handling_time_us.store(time_us, std::memory_order_relaxed);
+    }
+}
+
 void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
     {
-        std::lock_guard lock(member_mutex);
+        std::shared_lock lock(member_mutex);
         if (members.size() >= room_information.member_slots) {
             SendRoomIsFull(event->peer);
             return;
         }
     }
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string nickname;
     packet.Read(nickname);
@@ -318,6 +360,11 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
     std::string token;
     packet.Read(token);
 
+    u8 features = 0;
+    if (!packet.EndOfPacket()) {
+        packet.Read(features);
+    }
+
     if (pass != password) {
         SendWrongPassword(event->peer);
         return;
@@ -349,6 +396,7 @@ void Room::RoomImpl::HandleJoinRequest(const ENetEvent* event) {
     member.fake_ip = preferred_fake_ip;
     member.nickname = nickname;
     member.peer = event->peer;
+    member.features = features;
 
     std::string uid;
     {
@@ -405,7 +453,7 @@ void Room::RoomImpl::HandleModKickPacket(const ENetEvent* event) {
     }
 
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string nickname;
@@ -447,7 +495,7 @@ void Room::RoomImpl::HandleModBanPacket(const ENetEvent* event) {
     }
 
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string nickname;
@@ -508,7 +556,7 @@ void Room::RoomImpl::HandleModUnbanPacket(const ENetEvent* event) {
     }
 
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
 
     std::string address;
@@ -554,20 +602,20 @@ bool Room::RoomImpl::IsValidNickname(const std::string& nickname) const {
     if (!std::regex_match(nickname, nickname_regex))
         return false;
 
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     return std::all_of(members.begin(), members.end(),
                        [&nickname](const auto& member) { return member.nickname != nickname; });
 }
 
 bool Room::RoomImpl::IsValidFakeIPAddress(const IPv4Address& address) const {
     // An IP address is valid if it is not already taken by anybody else in the room.
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     return std::all_of(members.begin(), members.end(),
                        [&address](const auto& member) { return member.fake_ip != address; });
 }
 
 bool Room::RoomImpl::HasModPermission(const ENetPeer* client) const {
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     const auto sending_member =
         std::find_if(members.begin(), members.end(),
                      [client](const auto& member) { return member.peer == client; });
@@ -593,7 +641,7 @@ void Room::RoomImpl::SendNameCollision(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -603,7 +651,7 @@ void Room::RoomImpl::SendIPCollision(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -613,7 +661,7 @@ void Room::RoomImpl::SendWrongPassword(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -623,7 +671,7 @@ void Room::RoomImpl::SendRoomIsFull(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -634,7 +682,7 @@ void Room::RoomImpl::SendVersionMismatch(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -644,7 +692,7 @@ void Room::RoomImpl::SendJoinSuccess(ENetPeer* client, IPv4Address fake_ip) {
     packet.Write(fake_ip);
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -654,7 +702,7 @@ void Room::RoomImpl::SendJoinSuccessAsMod(ENetPeer* client, IPv4Address fake_ip)
     packet.Write(fake_ip);
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -664,7 +712,7 @@ void Room::RoomImpl::SendUserKicked(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -674,7 +722,7 @@ void Room::RoomImpl::SendUserBanned(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -684,7 +732,7 @@ void Room::RoomImpl::SendModPermissionDenied(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -694,7 +742,7 @@ void Room::RoomImpl::SendModNoSuchUser(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
@@ -709,19 +757,19 @@ void Room::RoomImpl::SendModBanListResponse(ENetPeer* client) {
 
     ENetPacket* enet_packet =
         enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
-    enet_peer_send(client, 0, enet_packet);
+    SendPacket(client, enet_packet);
     enet_host_flush(server);
 }
 
 void Room::RoomImpl::SendCloseMessage() {
     Packet packet;
     packet.Write(static_cast<u8>(IdCloseRoom));
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     if (!members.empty()) {
         ENetPacket* enet_packet =
             enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
         for (auto& member : members) {
-            enet_peer_send(member.peer, 0, enet_packet);
+            SendPacket(member.peer, enet_packet);
         }
     }
     enet_host_flush(server);
@@ -737,12 +785,12 @@ void Room::RoomImpl::SendStatusMessage(StatusMessageTypes type, const std::strin
     packet.Write(static_cast<u8>(type));
     packet.Write(nickname);
     packet.Write(username);
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     if (!members.empty()) {
         ENetPacket* enet_packet =
             enet_packet_create(packet.GetData(), packet.GetDataSize(), ENET_PACKET_FLAG_RELIABLE);
         for (auto& member : members) {
-            enet_peer_send(member.peer, 0, enet_packet);
+            SendPacket(member.peer, enet_packet);
         }
     }
     enet_host_flush(server);
@@ -781,7 +829,7 @@ void Room::RoomImpl::BroadcastRoomInformation() {
 
     packet.Write(static_cast<u32>(members.size()));
     {
-        std::lock_guard lock(member_mutex);
+        std::shared_lock lock(member_mutex);
         for (const auto& member : members) {
             packet.Write(member.nickname);
             packet.Write(member.fake_ip);
@@ -792,6 +840,13 @@ void Room::RoomImpl::BroadcastRoomInformation() {
             packet.Write(member.user_data.display_name);
             packet.Write(member.user_data.avatar_url);
         }
+
+        // Features can only be used when every member understands them
+        u8 features = FeatureCompressedLdn;
+        for (const auto& member : members) {
+            features &= member.features;
+        }
+        packet.Write(features);
     }
 
     ENetPacket* enet_packet =
@@ -814,7 +869,7 @@ IPv4Address Room::RoomImpl::GenerateFakeIPAddress() {
 
 void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
     Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    in_packet.Wrap({event->packet->data, event->packet->dataLength});
     in_packet.IgnoreBytes(sizeof(u8)); // Message type
 
     in_packet.IgnoreBytes(sizeof(u8));          // Domain
@@ -831,40 +886,32 @@ void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
     bool broadcast;
     in_packet.Read(broadcast); // Broadcast
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    // Forward the received packet as is. ENet keeps it alive until it was sent to every peer.
+    ENetPacket* enet_packet = event->packet;
+    enet_packet->flags |= ENET_PACKET_FLAG_RELIABLE;
 
     const auto& destination_address = remote_ip;
     if (broadcast) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
+        std::shared_lock lock(member_mutex);
         for (const auto& member : members) {
             if (member.peer != event->peer) {
-                sent_packet = true;
-                enet_peer_send(member.peer, 0, enet_packet);
+                SendPacket(member.peer, enet_packet);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
     } else { // Send the data only to the destination client
-        std::lock_guard lock(member_mutex);
+        std::shared_lock lock(member_mutex);
         auto member = std::find_if(members.begin(), members.end(),
                                    [destination_address](const Member& member_entry) -> bool {
                                        return member_entry.fake_ip == destination_address;
                                    });
         if (member != members.end()) {
-            enet_peer_send(member->peer, 0, enet_packet);
+            SendPacket(member->peer, enet_packet);
         } else {
             LOG_ERROR(Network,
                       "Attempting to send to unknown IP address: "
                       "{}.{}.{}.{}",
                       destination_address[0], destination_address[1], destination_address[2],
                       destination_address[3]);
-            enet_packet_destroy(enet_packet);
         }
     }
     enet_host_flush(server);
@@ -872,7 +919,7 @@ void Room::RoomImpl::HandleProxyPacket(const ENetEvent* event) {
 
 void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
     Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    in_packet.Wrap({event->packet->data, event->packet->dataLength});
 
     in_packet.IgnoreBytes(sizeof(u8)); // Message type
 
@@ -885,40 +932,32 @@ void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
     bool broadcast;
     in_packet.Read(broadcast); // Broadcast
 
-    Packet out_packet;
-    out_packet.Append(event->packet->data, event->packet->dataLength);
-    ENetPacket* enet_packet = enet_packet_create(out_packet.GetData(), out_packet.GetDataSize(),
-                                                 ENET_PACKET_FLAG_RELIABLE);
+    // Forward the received packet as is. ENet keeps it alive until it was sent to every peer.
+    ENetPacket* enet_packet = event->packet;
+    enet_packet->flags |= ENET_PACKET_FLAG_RELIABLE;
 
     const auto& destination_address = remote_ip;
     if (broadcast) { // Send the data to everyone except the sender
-        std::lock_guard lock(member_mutex);
-        bool sent_packet = false;
+        std::shared_lock lock(member_mutex);
         for (const auto& member : members) {
             if (member.peer != event->peer) {
-                sent_packet = true;
-                enet_peer_send(member.peer, 0, enet_packet);
+                SendPacket(member.peer, enet_packet);
             }
         }
-
-        if (!sent_packet) {
-            enet_packet_destroy(enet_packet);
-        }
     } else {
-        std::lock_guard lock(member_mutex);
+        std::shared_lock lock(member_mutex);
         auto member = std::find_if(members.begin(), members.end(),
                                    [destination_address](const Member& member_entry) -> bool {
                                        return member_entry.fake_ip == destination_address;
                                    });
         if (member != members.end()) {
-            enet_peer_send(member->peer, 0, enet_packet);
+            SendPacket(member->peer, enet_packet);
         } else {
             LOG_ERROR(Network,
                       "Attempting to send to unknown IP address: "
                       "{}.{}.{}.{}",
                       destination_address[0], destination_address[1], destination_address[2],
                       destination_address[3]);
-            enet_packet_destroy(enet_packet);
         }
     }
     enet_host_flush(server);
@@ -926,7 +965,7 @@ void Room::RoomImpl::HandleLdnPacket(const ENetEvent* event) {
 
 void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
     Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    in_packet.Wrap({event->packet->data, event->packet->dataLength});
 
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     std::string message;
@@ -935,7 +974,7 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
         return member.peer == event->peer;
     };
 
-    std::lock_guard lock(member_mutex);
+    std::shared_lock lock(member_mutex);
     const auto sending_member = std::find_if(members.begin(), members.end(), CompareNetworkAddress);
     if (sending_member == members.end()) {
         return; // Received a chat message from a unknown sender
@@ -956,7 +995,7 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
     for (const auto& member : members) {
         if (member.peer != event->peer) {
             sent_packet = true;
-            enet_peer_send(member.peer, 0, enet_packet);
+            SendPacket(member.peer, enet_packet);
         }
     }
 
@@ -976,7 +1015,7 @@ void Room::RoomImpl::HandleChatPacket(const ENetEvent* event) {
 
 void Room::RoomImpl::HandleGameInfoPacket(const ENetEvent* event) {
     Packet in_packet;
-    in_packet.Append(event->packet->data, event->packet->dataLength);
+    in_packet.Wrap({event->packet->data, event->packet->dataLength});
 
     in_packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
     GameInfo game_info;
@@ -1074,6 +1113,12 @@ bool Room::Create(const std::string& name, const std::string& description,
     room_impl->verify_backend = std::move(verify_backend);
     room_impl->username_ban_list = ban_list.first;
     room_impl->ip_ban_list = ban_list.second;
+    room_impl->packets_received = 0;
+    room_impl->packets_sent = 0;
+    room_impl->bytes_received = 0;
+    room_impl->bytes_sent = 0;
+    room_impl->handling_time_us = 0;
+    room_impl->max_handling_time_us = 0;
 
     room_impl->StartLoop();
     return true;
@@ -1099,7 +1144,7 @@ Room::BanList Room::GetBanList() const {
 
 std::vector<Member> Room::GetRoomMemberList() const {
     std::vector<Member> member_list;
-    std::lock_guard lock(room_impl->member_mutex);
+    std::shared_lock lock(room_impl->member_mutex);
     for (const auto& member_impl : room_impl->members) {
         Member member;
         member.nickname = member_impl.nickname;
@@ -1113,6 +1158,17 @@ std::vector<Member> Room::GetRoomMemberList() const {
     return member_list;
 }
 
+RoomStatistics Room::GetStatistics() const {
+    return {
+        .packets_received = room_impl->packets_received.load(std::memory_order_relaxed),
+        .packets_sent = room_impl->packets_sent.load(std::memory_order_relaxed),
+        .bytes_received = room_impl->bytes_received.load(std::memory_order_relaxed),
+        .bytes_sent = room_impl->bytes_sent.load(std::memory_order_relaxed),
+        .handling_time_us = room_impl->handling_time_us.load(std::memory_order_relaxed),
+        .max_handling_time_us = room_impl->max_handling_time_us.load(std::memory_order_relaxed),
+    };
+}
+
 bool Room::HasPassword() const {
     return !room_impl->password.empty();
 }
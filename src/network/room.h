@@ -61,6 +61,14 @@ enum RoomMessageTypes : u8 {
     IdModPermissionDenied,
     IdModNoSuchUser,
     IdJoinSuccessAsMod,
+    IdLdnPacketCompressed,
+};
+
+/// Optional protocol features, announced by members in their join request and by the room in its
+/// room information. Older members and rooms send neither.
+enum RoomFeatureFlags : u8 {
+    /// LDN payloads may be sent zstd compressed as IdLdnPacketCompressed
+    FeatureCompressedLdn = 1 << 0,
 };
 
 /// Types of system status messages
@@ -72,6 +80,16 @@ enum StatusMessageTypes : u8 {
     IdAddressUnbanned, ///< A username / ip address is unbanned from the room
 };
 
+/// Traffic counters of a room, accumulated since the room was created.
+struct RoomStatistics {
+    u64 packets_received{};     ///< Number of packets received from members
+    u64 packets_sent{};         ///< Number of packets sent to members
+    u64 bytes_received{};       ///< Number of bytes received from members
+    u64 bytes_sent{};           ///< Number of bytes sent to members
+    u64 handling_time_us{};     ///< Total time spent handling received packets
+    u64 max_handling_time_us{}; ///< Longest time spent handling a single packet
+};
+
 /// This is what a server [person creating a server] would use.
 class Room final {
 public:
@@ -103,6 +121,11 @@ public:
      */
     std::vector<Member> GetRoomMemberList() const;
 
+    /**
+     * Gets the traffic statistics of the room.
+     */
+    RoomStatistics GetStatistics() const;
+
     /**
      * Checks if the room is password protected
      */
@@ -8,6 +8,7 @@
 #include <thread>
 #include "common/assert.h"
 #include "common/socket_types.h"
+#include "common/zstd_compression.h"
 #include "enet/enet.h"
 #include "network/packet.h"
 #include "network/room_member.h"
@@ -29,6 +30,12 @@ public:
     /// The current game name, id and version
     GameInfo current_game_info;
 
+    /// Whether the room and all of its members accept compressed LDN packets
+    std::atomic_bool compress_ldn{false};
+    std::atomic<u64> compressed_packets{};
+    std::atomic<u64> uncompressed_bytes{};
+    std::atomic<u64> compressed_bytes{};
+
     std::atomic<State> state{State::Idle}; ///< Current state of the RoomMember.
     void SetState(const State new_state);
     void SetError(const Error new_error);
@@ -174,6 +181,7 @@ void RoomMember::RoomMemberImpl::MemberLoop() {
                     HandleProxyPackets(&event);
                     break;
                 case IdLdnPacket:
+                case IdLdnPacketCompressed:
                     HandleLdnPackets(&event);
                     break;
                 case IdChatMessage:
@@ -262,9 +270,16 @@ void RoomMember::RoomMemberImpl::MemberLoop() {
             std::lock_guard send_lock(send_list_mutex);
             packets.swap(send_list);
         }
-        for (const auto& packet : packets) {
-            ENetPacket* enetPacket = enet_packet_create(packet.GetData(), packet.GetDataSize(),
-                                                        ENET_PACKET_FLAG_RELIABLE);
+        for (auto& packet : packets) {
+            // Hand the packet buffer to ENet without copying it, it is released once sent
+            auto* owned_packet = new Packet(std::move(packet));
+            ENetPacket* enetPacket =
+                enet_packet_create(owned_packet->GetData(), owned_packet->GetDataSize(),
+                                   ENET_PACKET_FLAG_RELIABLE | ENET_PACKET_FLAG_NO_ALLOCATE);
+            enetPacket->userData = owned_packet;
+            enetPacket->freeCallback = [](ENetPacket* sent_packet) {
+                delete static_cast<Packet*>(sent_packet->userData);
+            };
             enet_peer_send(server, 0, enetPacket);
         }
         enet_host_flush(client);
@@ -292,12 +307,13 @@ void RoomMember::RoomMemberImpl::SendJoinRequest(const std::string& nickname_,
     packet.Write(network_version);
     packet.Write(password);
     packet.Write(token);
+    packet.Write(static_cast<u8>(FeatureCompressedLdn));
     Send(std::move(packet));
 }
 
 void RoomMember::RoomMemberImpl::HandleRoomInformationPacket(const ENetEvent* event) {
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -337,12 +353,18 @@ void RoomMember::RoomMemberImpl::HandleRoomInformationPacket(const ENetEvent* ev
             }
         }
     }
+
+    u8 features = 0;
+    if (!packet.EndOfPacket()) {
+        packet.Read(features);
+    }
+    compress_ldn = (features & FeatureCompressedLdn) != 0;
     Invoke(room_information);
 }
 
 void RoomMember::RoomMemberImpl::HandleJoinPacket(const ENetEvent* event) {
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -354,7 +376,7 @@ void RoomMember::RoomMemberImpl::HandleJoinPacket(const ENetEvent* event) {
 void RoomMember::RoomMemberImpl::HandleProxyPackets(const ENetEvent* event) {
     ProxyPacket proxy_packet{};
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -385,7 +407,7 @@ void RoomMember::RoomMemberImpl::HandleProxyPackets(const ENetEvent* event) {
 void RoomMember::RoomMemberImpl::HandleLdnPackets(const ENetEvent* event) {
     LDNPacket ldn_packet{};
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8)); // Ignore the message type
@@ -399,13 +421,20 @@ void RoomMember::RoomMemberImpl::HandleLdnPackets(const ENetEvent* event) {
     packet.Read(ldn_packet.broadcast);
 
     packet.Read(ldn_packet.data);
+    if (event->packet->data[0] == IdLdnPacketCompressed) {
+        ldn_packet.data = Common::Compression::DecompressDataZSTD(ldn_packet.data);
+        if (ldn_packet.data.empty()) {
+            LOG_ERROR(Network, "Failed to decompress LDN packet");
+            return;
+        }
+    }
 
     Invoke<LDNPacket>(ldn_packet);
 }
 
 void RoomMember::RoomMemberImpl::HandleChatPacket(const ENetEvent* event) {
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -419,7 +448,7 @@ void RoomMember::RoomMemberImpl::HandleChatPacket(const ENetEvent* event) {
 
 void RoomMember::RoomMemberImpl::HandleStatusMessagePacket(const ENetEvent* event) {
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -435,7 +464,7 @@ void RoomMember::RoomMemberImpl::HandleStatusMessagePacket(const ENetEvent* even
 
 void RoomMember::RoomMemberImpl::HandleModBanListResponsePacket(const ENetEvent* event) {
     Packet packet;
-    packet.Append(event->packet->data, event->packet->dataLength);
+    packet.Wrap({event->packet->data, event->packet->dataLength});
 
     // Ignore the first byte, which is the message id.
     packet.IgnoreBytes(sizeof(u8));
@@ -593,6 +622,7 @@ void RoomMember::Join(const std::string& nick, const char* server_addr, u16 serv
     }
 
     room_member_impl->SetState(State::Joining);
+    room_member_impl->compress_ldn = false;
 
     ENetAddress address{};
     enet_address_set_host(&address, server_addr);
@@ -644,8 +674,18 @@ void RoomMember::SendProxyPacket(const ProxyPacket& proxy_packet) {
 }
 
 void RoomMember::SendLdnPacket(const LDNPacket& ldn_packet) {
+    // Small payloads do not shrink enough to be worth the compression
+    constexpr std::size_t CompressionThreshold = 128;
+
+    std::vector<u8> compressed;
+    if (room_member_impl->compress_ldn && ldn_packet.data.size() >= CompressionThreshold) {
+        compressed = Common::Compression::CompressDataZSTD(ldn_packet.data.data(),
+                                                           ldn_packet.data.size(), 1);
+    }
+    const bool is_compressed = !compressed.empty() && compressed.size() < ldn_packet.data.size();
+
     Packet packet;
-    packet.Write(static_cast<u8>(IdLdnPacket));
+    packet.Write(static_cast<u8>(is_compressed ? IdLdnPacketCompressed : IdLdnPacket));
 
     packet.Write(static_cast<u8>(ldn_packet.type));
 
@@ -653,11 +693,28 @@ void RoomMember::SendLdnPacket(const LDNPacket& ldn_packet) {
     packet.Write(ldn_packet.remote_ip);
     packet.Write(ldn_packet.broadcast);
 
-    packet.Write(ldn_packet.data);
+    if (is_compressed) {
+        packet.Write(compressed);
+        room_member_impl->compressed_packets.fetch_add(1, std::memory_order_relaxed);
+        room_member_impl->uncompressed_bytes.fetch_add(ldn_packet.data.size(),
+                                                       std::memory_order_relaxed);
+        room_member_impl->compressed_bytes.fetch_add(compressed.size(),
+                                                     std::memory_order_relaxed);
+    } else {
+        packet.Write(ldn_packet.data);
+    }
 
     room_member_impl->Send(std::move(packet));
 }
 
+CompressionStatistics RoomMember::GetCompressionStatistics() const {
+    return {
+        .compressed_packets = room_member_impl->compressed_packets.load(std::memory_order_relaxed),
+        .uncompressed_bytes = room_member_impl->uncompressed_bytes.load(std::memory_order_relaxed),
+        .compressed_bytes = room_member_impl->compressed_bytes.load(std::memory_order_relaxed),
+    };
+}
+
 void RoomMember::SendChatMessage(const std::string& message) {
     Packet packet;
     packet.Write(static_cast<u8>(IdChatMessage));
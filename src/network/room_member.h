@@ -24,6 +24,7 @@ enum class LDNPacketType : u8 {
     SyncNetwork,
     Disconnect,
     DestroyNetwork,
+    SyncNetworkDelta,
 };
 
 struct LDNPacket {
@@ -43,6 +44,13 @@ struct ProxyPacket {
     std::vector<u8> data;
 };
 
+/// Statistics about the compression of the LDN packets sent by a room member.
+struct CompressionStatistics {
+    u64 compressed_packets{}; ///< Number of packets that were sent compressed
+    u64 uncompressed_bytes{}; ///< Size of their payloads before compression
+    u64 compressed_bytes{};   ///< Size of their payloads after compression
+};
+
 /// Represents a chat message.
 struct ChatEntry {
     std::string nickname; ///< Nickname of the client who sent this message.
@@ -174,6 +182,11 @@ public:
      */
     void SendLdnPacket(const LDNPacket& packet);
 
+    /**
+     * Returns the compression statistics of the LDN packets sent by this member.
+     */
+    CompressionStatistics GetCompressionStatistics() const;
+
     /**
      * Sends a chat message to the room.
      * @param message The contents of the message.
@@ -0,0 +1,360 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Replays the shaders stored in pipeline cache files through the recompiler and reports the cost
+// of each step, so recompiler changes can be measured without booting a game.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <getopt.h>
+
+#include "common/common_types.h"
+#include "common/fs/path_util.h"
+#include "shader_recompiler/backend/bindings.h"
+#include "shader_recompiler/backend/glasm/emit_glasm.h"
+#include "shader_recompiler/backend/glsl/emit_glsl.h"
+#include "shader_recompiler/backend/spirv/emit_spirv.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
+#include "shader_recompiler/frontend/maxwell/translate_program.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/pass_statistics.h"
+#include "shader_recompiler/profile.h"
+#include "shader_recompiler/program_header.h"
+#include "shader_recompiler/runtime_info.h"
+#include "video_core/shader_environment.h"
+
+namespace {
+std::atomic<size_t> num_allocations;
+
+size_t AllocationCount() {
+    return num_allocations.load(std::memory_order_relaxed);
+}
+} // Anonymous namespace
+
+void* operator new(std::size_t size) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* const pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+enum Backends : u32 {
+    SPIRV = 1 << 0,
+    GLSL = 1 << 1,
+    GLASM = 1 << 2,
+};
+
+struct PassTotals {
+    std::chrono::nanoseconds time{};
+    size_t num_runs{};
+    size_t num_insts{};
+    size_t num_allocations{};
+};
+
+struct Benchmark {
+    Shader::Profile profile;
+    Shader::HostTranslateInfo host_info;
+    u32 backends{};
+
+    Shader::ObjectPool<Shader::IR::Inst> inst_pool{8192};
+    Shader::ObjectPool<Shader::IR::Block> block_pool{32};
+    Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block_pool{32};
+
+    std::map<std::string_view, PassTotals> totals;
+    size_t num_pipelines{};
+    size_t num_shaders{};
+    size_t num_failures{};
+};
+
+void PrintHelp(const char* argv0) {
+    fmt::print("Usage: {} [options] <directory>\n"
+               "Replays every pipeline cache (*.bin) in directory through the shader "
+               "recompiler.\n"
+               "-b, --backend=NAME     Backend to emit: spirv, glsl, glasm or all (default)\n"
+               "-i, --iterations=N     Number of times to replay the shaders (default 1)\n"
+               "-h, --help             Display this help and exit\n",
+               argv0);
+}
+
+template <typename Func>
+void Measure(Benchmark& benchmark, std::string_view name, const Shader::IR::Program* program,
+             Func&& func) {
+    const size_t allocations_before{AllocationCount()};
+    const auto start{std::chrono::steady_clock::now()};
+    func();
+    const auto end{std::chrono::steady_clock::now()};
+
+    PassTotals& totals{benchmark.totals[name]};
+    totals.time += end - start;
+    totals.num_allocations += AllocationCount() - allocations_before;
+    ++totals.num_runs;
+    if (program) {
+        for (const Shader::IR::Block* const block : program->blocks) {
+            totals.num_insts += block->size();
+        }
+    }
+}
+
+Shader::IR::Program Translate(Benchmark& benchmark, Shader::Environment& env) {
+    const bool is_compute{env.ShaderStage() == Shader::Stage::Compute};
+    const u32 cfg_offset{static_cast<u32>(
+        env.StartAddress() + (is_compute ? 0 : sizeof(Shader::ProgramHeader)))};
+    std::optional<Shader::Maxwell::Flow::CFG> cfg;
+    Measure(benchmark, "ControlFlowGraph", nullptr, [&] {
+        cfg.emplace(env, benchmark.flow_block_pool, cfg_offset,
+                    env.ShaderStage() == Shader::Stage::VertexA);
+    });
+    Shader::PassStatistics statistics{.allocation_count = AllocationCount};
+    Shader::IR::Program program{Shader::Maxwell::TranslateProgram(
+        benchmark.inst_pool, benchmark.block_pool, env, *cfg, benchmark.host_info, &statistics)};
+    for (const Shader::PassStatistics::Entry& entry : statistics.entries) {
+        PassTotals& totals{benchmark.totals[entry.name]};
+        totals.time += entry.time;
+        totals.num_insts += entry.num_insts;
+        totals.num_allocations += entry.num_allocations;
+        ++totals.num_runs;
+    }
+    ++benchmark.num_shaders;
+    return program;
+}
+
+void Emit(Benchmark& benchmark, Shader::IR::Program& program) {
+    if (benchmark.backends & SPIRV) {
+        Shader::Backend::Bindings bindings;
+        Measure(benchmark, "EmitSPIRV", nullptr, [&] {
+            [[maybe_unused]] const auto code{
+                Shader::Backend::SPIRV::EmitSPIRV(benchmark.profile, {}, program, bindings)};
+        });
+    }
+    if (benchmark.backends & GLSL) {
+        Shader::Backend::Bindings bindings;
+        Measure(benchmark, "EmitGLSL", nullptr, [&] {
+            [[maybe_unused]] const auto code{
+                Shader::Backend::GLSL::EmitGLSL(benchmark.profile, {}, program, bindings)};
+        });
+    }
+    if (benchmark.backends & GLASM) {
+        Shader::Backend::Bindings bindings;
+        Measure(benchmark, "EmitGLASM", nullptr, [&] {
+            [[maybe_unused]] const auto code{
+                Shader::Backend::GLASM::EmitGLASM(benchmark.profile, {}, program, bindings)};
+        });
+    }
+}
+
+void ReplayPipeline(Benchmark& benchmark, std::vector<VideoCommon::FileEnvironment>& envs) {
+    ++benchmark.num_pipelines;
+    try {
+        std::optional<Shader::IR::Program> vertex_a;
+        for (VideoCommon::FileEnvironment& env : envs) {
+            Shader::IR::Program program{Translate(benchmark, env)};
+            if (env.ShaderStage() == Shader::Stage::VertexA) {
+                // Emitted merged with VertexB
+                vertex_a.emplace(std::move(program));
+                continue;
+            }
+            if (env.ShaderStage() == Shader::Stage::VertexB && vertex_a) {
+                Shader::IR::Program merged;
+                Measure(benchmark, "MergeDualVertexPrograms", &merged, [&] {
+                    merged = Shader::Maxwell::MergeDualVertexPrograms(*vertex_a, program, env);
+                });
+                Emit(benchmark, merged);
+                continue;
+            }
+            Emit(benchmark, program);
+        }
+    } catch (const Shader::Exception& exception) {
+        fmt::print(stderr, "Failed to replay pipeline: {}\n", exception.what());
+        ++benchmark.num_failures;
+    }
+    benchmark.inst_pool.ReleaseContents();
+    benchmark.block_pool.ReleaseContents();
+    benchmark.flow_block_pool.ReleaseContents();
+}
+
+void PrintReport(const Benchmark& benchmark, std::chrono::nanoseconds wall_time) {
+    fmt::print("{} pipelines, {} shaders, {} failures in {:.3f} ms\n\n", benchmark.num_pipelines,
+               benchmark.num_shaders, benchmark.num_failures,
+               std::chrono::duration<double, std::milli>(wall_time).count());
+    fmt::print("{:<32} {:>12} {:>12} {:>14} {:>14}\n", "Pass", "Total (ms)", "Mean (us)",
+               "Mean IR insts", "Mean allocs");
+
+    std::vector<std::pair<std::string_view, PassTotals>> passes(benchmark.totals.begin(),
+                                                                benchmark.totals.end());
+    std::ranges::sort(passes, [](const auto& lhs, const auto& rhs) {
+        return lhs.second.time > rhs.second.time;
+    });
+    for (const auto& [name, totals] : passes) {
+        const double runs{static_cast<double>(std::max<size_t>(totals.num_runs, 1))};
+        fmt::print("{:<32} {:>12.3f} {:>12.3f} {:>14.1f} {:>14.1f}\n", name,
+                   std::chrono::duration<double, std::milli>(totals.time).count(),
+                   std::chrono::duration<double, std::micro>(totals.time).count() / runs,
+                   static_cast<double>(totals.num_insts) / runs,
+                   static_cast<double>(totals.num_allocations) / runs);
+    }
+}
+
+Benchmark MakeBenchmark(u32 backends) {
+    Benchmark benchmark;
+    benchmark.backends = backends;
+    // Roughly matches a recent desktop driver, what matters is that results are comparable
+    benchmark.profile = Shader::Profile{
+        .supported_spirv = 0x00010600,
+        .unified_descriptor_binding = true,
+        .support_descriptor_aliasing = true,
+        .support_int8 = true,
+        .support_int16 = true,
+        .support_int64 = true,
+        .support_vertex_instance_id = false,
+        .support_float_controls = true,
+        .support_separate_denorm_behavior = true,
+        .support_separate_rounding_mode = true,
+        .support_fp16_denorm_preserve = true,
+        .support_fp32_denorm_preserve = true,
+        .support_fp16_denorm_flush = true,
+        .support_fp32_denorm_flush = true,
+        .support_fp16_signed_zero_nan_preserve = true,
+        .support_fp32_signed_zero_nan_preserve = true,
+        .support_fp64_signed_zero_nan_preserve = true,
+        .support_explicit_workgroup_layout = true,
+        .support_vote = true,
+        .support_viewport_index_layer_non_geometry = true,
+        .support_viewport_mask = true,
+        .support_typeless_image_loads = true,
+        .support_demote_to_helper_invocation = true,
+        .support_int64_atomics = true,
+        .support_derivative_control = true,
+        .support_geometry_shader_passthrough = true,
+        .support_native_ndc = true,
+        .support_gl_nv_gpu_shader_5 = true,
+        .support_gl_amd_gpu_shader_half_float = false,
+        .support_gl_texture_shadow_lod = true,
+        .support_gl_warp_intrinsics = true,
+        .support_gl_variable_aoffi = true,
+        .support_gl_sparse_textures = true,
+        .support_gl_derivative_control = true,
+        .support_scaled_attributes = true,
+        .support_multi_viewport = true,
+        .support_geometry_streams = true,
+        .warp_size_potentially_larger_than_guest = false,
+    };
+    benchmark.host_info = Shader::HostTranslateInfo{
+        .support_float64 = true,
+        .support_float16 = true,
+        .support_int64 = true,
+        .needs_demote_reorder = false,
+        .support_snorm_render_buffer = true,
+        .support_viewport_index_layer = true,
+        .min_ssbo_alignment = 16,
+        .support_geometry_shader_passthrough = true,
+        .support_conditional_barrier = true,
+    };
+    return benchmark;
+}
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    u32 backends{SPIRV | GLSL | GLASM};
+    int iterations{1};
+
+    static constexpr option long_options[] = {
+        {"backend", required_argument, 0, 'b'},
+        {"iterations", required_argument, 0, 'i'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+    while (optind < argc) {
+        const int arg{getopt_long(argc, argv, "b:i:h", long_options, nullptr)};
+        if (arg == -1) {
+            break;
+        }
+        switch (static_cast<char>(arg)) {
+        case 'b': {
+            const std::string_view backend{optarg};
+            if (backend == "spirv") {
+                backends = SPIRV;
+            } else if (backend == "glsl") {
+                backends = GLSL;
+            } else if (backend == "glasm") {
+                backends = GLASM;
+            } else if (backend == "all") {
+                backends = SPIRV | GLSL | GLASM;
+            } else {
+                fmt::print(stderr, "Unknown backend {}\n", backend);
+                return EXIT_FAILURE;
+            }
+            break;
+        }
+        case 'i':
+            iterations = std::max(std::atoi(optarg), 1);
+            break;
+        case 'h':
+            PrintHelp(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            PrintHelp(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind != argc - 1) {
+        PrintHelp(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::filesystem::path directory{argv[optind]};
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+            files.push_back(entry.path());
+        }
+    }
+    if (ec || files.empty()) {
+        fmt::print(stderr, "No pipeline caches found in {}\n",
+                   Common::FS::PathToUTF8String(directory));
+        return EXIT_FAILURE;
+    }
+    std::ranges::sort(files);
+
+    // Load everything up front so file reads are not part of the measurements
+    std::vector<std::vector<VideoCommon::FileEnvironment>> pipelines;
+    for (const auto& file : files) {
+        const size_t num_read{VideoCommon::ReadPipelineEnvironments(
+            file, [&](std::vector<VideoCommon::FileEnvironment> envs) {
+                pipelines.push_back(std::move(envs));
+            })};
+        fmt::print("{}: {} pipelines\n", Common::FS::PathToUTF8String(file.filename()), num_read);
+    }
+
+    Benchmark benchmark{MakeBenchmark(backends)};
+    const auto start{std::chrono::steady_clock::now()};
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        for (auto& envs : pipelines) {
+            ReplayPipeline(benchmark, envs);
+        }
+    }
+    const auto end{std::chrono::steady_clock::now()};
+    PrintReport(benchmark, end - start);
+    return benchmark.num_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -226,7 +226,8 @@ void EmitCode(EmitContext& ctx, const IR::Program& program) {
             ctx.Add("REP;");
             break;
         case IR::AbstractSyntaxNode::Type::Repeat:
-            if (!Settings::values.disable_shader_loop_safety_checks) {
+            if (!Settings::values.disable_shader_loop_safety_checks &&
+                !node.data.repeat.is_bounded) {
                 const u32 loop_index{ctx.num_safety_loop_vars++};
                 const u32 vector_index{loop_index / 4};
                 const char component{"xyzw"[loop_index % 4]};
@@ -301,6 +301,12 @@ void EmitFPUnordGreaterThanEqual64(EmitContext& ctx, IR::Inst& inst, ScalarF64 l
 void EmitFPIsNan16(EmitContext& ctx, Register value);
 void EmitFPIsNan32(EmitContext& ctx, IR::Inst& inst, ScalarF32 value);
 void EmitFPIsNan64(EmitContext& ctx, IR::Inst& inst, ScalarF64 value);
+void EmitFPAbs16x2(EmitContext& ctx, IR::Inst& inst, Register value);
+void EmitFPAdd16x2(EmitContext& ctx, IR::Inst& inst, Register a, Register b);
+void EmitFPFma16x2(EmitContext& ctx, IR::Inst& inst, Register a, Register b, Register c);
+void EmitFPMul16x2(EmitContext& ctx, IR::Inst& inst, Register a, Register b);
+void EmitFPNeg16x2(EmitContext& ctx, IR::Inst& inst, Register value);
+void EmitFPSaturate16x2(EmitContext& ctx, IR::Inst& inst, Register value);
 void EmitIAdd32(EmitContext& ctx, IR::Inst& inst, ScalarS32 a, ScalarS32 b);
 void EmitIAdd64(EmitContext& ctx, IR::Inst& inst, Register a, Register b);
 void EmitISub32(EmitContext& ctx, IR::Inst& inst, ScalarS32 a, ScalarS32 b);
@@ -161,7 +161,8 @@ void EmitCode(EmitContext& ctx, const IR::Program& program) {
             ctx.Add("for(;;){{");
             break;
         case IR::AbstractSyntaxNode::Type::Repeat:
-            if (Settings::values.disable_shader_loop_safety_checks) {
+            if (Settings::values.disable_shader_loop_safety_checks ||
+                node.data.repeat.is_bounded) {
                 ctx.Add("if(!{}){{break;}}}}", ctx.var_alloc.Consume(node.data.repeat.cond));
             } else {
                 ctx.Add("if(--loop{}<0 || !{}){{break;}}}}", ctx.num_safety_loop_vars++,
@@ -452,4 +452,35 @@ void EmitFPIsNan64(EmitContext& ctx, IR::Inst& inst, std::string_view value) {
     ctx.AddU1("{}=isnan({});", inst, value);
 }
 
+void EmitFPAbs16x2([[maybe_unused]] EmitContext& ctx, [[maybe_unused]] IR::Inst& inst,
+                   [[maybe_unused]] std::string_view value) {
+    NotImplemented();
+}
+
+void EmitFPAdd16x2([[maybe_unused]] EmitContext& ctx, [[maybe_unused]] IR::Inst& inst,
+                   [[maybe_unused]] std::string_view a, [[maybe_unused]] std::string_view b) {
+    NotImplemented();
+}
+
+void EmitFPFma16x2([[maybe_unused]] EmitContext& ctx, [[maybe_unused]] IR::Inst& inst,
+                   [[maybe_unused]] std::string_view a, [[maybe_unused]] std::string_view b,
+                   [[maybe_unused]] std::string_view c) {
+    NotImplemented();
+}
+
+void EmitFPMul16x2([[maybe_unused]] EmitContext& ctx, [[maybe_unused]] IR::Inst& inst,
+                   [[maybe_unused]] std::string_view a, [[maybe_unused]] std::string_view b) {
+    NotImplemented();
+}
+
+void EmitFPNeg16x2([[maybe_unused]] EmitContext& ctx, [[maybe_unused]] IR::Inst& inst,
+                   [[maybe_unused]] std::string_view value) {
+    NotImplemented();
+}
+
+void EmitFPSaturate16x2([[maybe_unused]] EmitContext& ctx, [[maybe_unused]] IR::Inst& inst,
+                        [[maybe_unused]] std::string_view value) {
+    NotImplemented();
+}
+
 } // namespace Shader::Backend::GLSL
@@ -8,10 +8,19 @@
 #include "shader_recompiler/frontend/ir/modifiers.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/profile.h"
+#include "shader_recompiler/runtime_info.h"
 
 namespace Shader::Backend::GLSL {
 namespace {
 std::string Texture(EmitContext& ctx, const IR::TextureInstInfo& info, const IR::Value& index) {
+    if (info.type != TextureType::Buffer && ctx.runtime_info.glsl_bindless_texture_binding) {
+        const auto def{ctx.textures.at(info.descriptor_index)};
+        const auto index_offset{
+            def.count > 1 ? fmt::format("+{}", ctx.var_alloc.Consume(index)) : ""};
+        return fmt::format("{}({}_tex_handles[{}{}].xy)",
+                           ctx.bindless_sampler_types.at(info.descriptor_index), ctx.stage_name,
+                           def.binding, index_offset);
+    }
     const auto def{info.type == TextureType::Buffer ? ctx.texture_buffers.at(info.descriptor_index)
                                                     : ctx.textures.at(info.descriptor_index)};
     const auto index_offset{def.count > 1 ? fmt::format("[{}]", ctx.var_alloc.Consume(index)) : ""};
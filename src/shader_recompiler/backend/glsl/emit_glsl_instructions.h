@@ -361,6 +361,13 @@ void EmitFPUnordGreaterThanEqual64(EmitContext& ctx, IR::Inst& inst, std::string
 void EmitFPIsNan16(EmitContext& ctx, IR::Inst& inst, std::string_view value);
 void EmitFPIsNan32(EmitContext& ctx, IR::Inst& inst, std::string_view value);
 void EmitFPIsNan64(EmitContext& ctx, IR::Inst& inst, std::string_view value);
+void EmitFPAbs16x2(EmitContext& ctx, IR::Inst& inst, std::string_view value);
+void EmitFPAdd16x2(EmitContext& ctx, IR::Inst& inst, std::string_view a, std::string_view b);
+void EmitFPFma16x2(EmitContext& ctx, IR::Inst& inst, std::string_view a, std::string_view b,
+                   std::string_view c);
+void EmitFPMul16x2(EmitContext& ctx, IR::Inst& inst, std::string_view a, std::string_view b);
+void EmitFPNeg16x2(EmitContext& ctx, IR::Inst& inst, std::string_view value);
+void EmitFPSaturate16x2(EmitContext& ctx, IR::Inst& inst, std::string_view value);
 void EmitIAdd32(EmitContext& ctx, IR::Inst& inst, std::string_view a, std::string_view b);
 void EmitIAdd64(EmitContext& ctx, IR::Inst& inst, std::string_view a, std::string_view b);
 void EmitISub32(EmitContext& ctx, IR::Inst& inst, std::string_view a, std::string_view b);
@@ -371,6 +371,9 @@ EmitContext::EmitContext(IR::Program& program, Bindings& bindings, const Profile
 
 void EmitContext::SetupExtensions() {
     header += "#extension GL_ARB_separate_shader_objects : enable\n";
+    if (runtime_info.glsl_bindless_texture_binding) {
+        header += "#extension GL_ARB_bindless_texture : require\n";
+    }
     if (info.uses_shadow_lod && profile.support_gl_texture_shadow_lod) {
         header += "#extension GL_EXT_texture_shadow_lod : enable\n";
     }
@@ -688,6 +691,23 @@ void EmitContext::SetupTextures(Bindings& bindings) {
         bindings.texture += desc.count;
     }
     textures.reserve(info.texture_descriptors.size());
+    if (runtime_info.glsl_bindless_texture_binding) {
+        // Sampled textures do not take texture units, their handles are read from a uniform buffer
+        u32 num_handles{};
+        bindless_sampler_types.reserve(info.texture_descriptors.size());
+        for (const auto& desc : info.texture_descriptors) {
+            const auto sampler_type{desc.is_depth
+                                        ? DepthSamplerType(desc.type)
+                                        : ColorSamplerType(desc.type, desc.is_multisample)};
+            textures.push_back({num_handles, desc.count});
+            bindless_sampler_types.push_back(sampler_type);
+            num_handles += desc.count;
+        }
+        header += fmt::format(
+            "layout(std140,binding={}) uniform {}_bindless{{uvec4 {}_tex_handles[{}];}};",
+            *runtime_info.glsl_bindless_texture_binding, stage_name, stage_name, num_handles);
+        return;
+    }
     for (const auto& desc : info.texture_descriptors) {
         textures.push_back({bindings.texture, desc.count});
         const auto sampler_type{desc.is_depth ? DepthSamplerType(desc.type)
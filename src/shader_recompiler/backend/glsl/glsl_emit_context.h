@@ -149,6 +149,7 @@ public:
     std::vector<TextureImageDefinition> texture_buffers;
     std::vector<TextureImageDefinition> image_buffers;
     std::vector<TextureImageDefinition> textures;
+    std::vector<std::string_view> bindless_sampler_types;
     std::vector<TextureImageDefinition> images;
     std::array<std::array<GenericElementInfo, 4>, 32> output_generics{};
 
@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <bit>
+#include <optional>
 #include <tuple>
 #include <utility>
 
@@ -149,6 +151,21 @@ Id GetCbuf(EmitContext& ctx, Id result_type, Id UniformDefinitions::*member_ptr,
     return ctx.OpSelect(result_type, cond, val, zero);
 }
 
+/// Returns the specialization constant of a constant buffer read, if it has one
+std::optional<Id> SpecializedCbuf(EmitContext& ctx, const IR::Value& binding,
+                                  const IR::Value& offset) {
+    if (!binding.IsImmediate() || !offset.IsImmediate()) {
+        return std::nullopt;
+    }
+    const auto it{std::ranges::find_if(ctx.specialized_cbufs, [&](const auto& cbuf) {
+        return cbuf.index == binding.U32() && cbuf.offset == offset.U32();
+    })};
+    if (it == ctx.specialized_cbufs.end()) {
+        return std::nullopt;
+    }
+    return it->value;
+}
+
 Id GetCbufU32(EmitContext& ctx, const IR::Value& binding, const IR::Value& offset) {
     return GetCbuf(ctx, ctx.U32[1], &UniformDefinitions::U32, sizeof(u32), binding, offset,
                    ctx.load_const_func_u32);
@@ -274,22 +291,33 @@ Id EmitGetCbufS16(EmitContext& ctx, const IR::Value& binding, const IR::Value& o
 }
 
 Id EmitGetCbufU32(EmitContext& ctx, const IR::Value& binding, const IR::Value& offset) {
+    Id value{};
     if (ctx.profile.support_descriptor_aliasing) {
-        return GetCbufU32(ctx, binding, offset);
+        value = GetCbufU32(ctx, binding, offset);
     } else {
         const Id vector{GetCbufU32x4(ctx, binding, offset)};
-        return GetCbufElement(ctx, vector, offset, 0u);
+        value = GetCbufElement(ctx, vector, offset, 0u);
     }
+    if (const std::optional<Id> specialized{SpecializedCbuf(ctx, binding, offset)}) {
+        return ctx.OpSelect(ctx.U32[1], ctx.cbuf_specialization_enabled, *specialized, value);
+    }
+    return value;
 }
 
 Id EmitGetCbufF32(EmitContext& ctx, const IR::Value& binding, const IR::Value& offset) {
+    Id value{};
     if (ctx.profile.support_descriptor_aliasing) {
-        return GetCbuf(ctx, ctx.F32[1], &UniformDefinitions::F32, sizeof(f32), binding, offset,
-                       ctx.load_const_func_f32);
+        value = GetCbuf(ctx, ctx.F32[1], &UniformDefinitions::F32, sizeof(f32), binding, offset,
+                        ctx.load_const_func_f32);
     } else {
         const Id vector{GetCbufU32x4(ctx, binding, offset)};
-        return ctx.OpBitcast(ctx.F32[1], GetCbufElement(ctx, vector, offset, 0u));
+        value = ctx.OpBitcast(ctx.F32[1], GetCbufElement(ctx, vector, offset, 0u));
+    }
+    if (const std::optional<Id> specialized{SpecializedCbuf(ctx, binding, offset)}) {
+        const Id specialized_f32{ctx.OpBitcast(ctx.F32[1], *specialized)};
+        return ctx.OpSelect(ctx.F32[1], ctx.cbuf_specialization_enabled, specialized_f32, value);
     }
+    return value;
 }
 
 Id EmitGetCbufU32x2(EmitContext& ctx, const IR::Value& binding, const IR::Value& offset) {
@@ -392,4 +392,32 @@ Id EmitFPIsNan64(EmitContext& ctx, Id value) {
     return ctx.OpIsNan(ctx.U1, value);
 }
 
+Id EmitFPAbs16x2(EmitContext& ctx, Id value) {
+    return ctx.OpFAbs(ctx.F16[2], value);
+}
+
+Id EmitFPAdd16x2(EmitContext& ctx, IR::Inst* inst, Id a, Id b) {
+    return Decorate(ctx, inst, ctx.OpFAdd(ctx.F16[2], a, b));
+}
+
+Id EmitFPFma16x2(EmitContext& ctx, IR::Inst* inst, Id a, Id b, Id c) {
+    return Decorate(ctx, inst, ctx.OpFma(ctx.F16[2], a, b, c));
+}
+
+Id EmitFPMul16x2(EmitContext& ctx, IR::Inst* inst, Id a, Id b) {
+    return Decorate(ctx, inst, ctx.OpFMul(ctx.F16[2], a, b));
+}
+
+Id EmitFPNeg16x2(EmitContext& ctx, Id value) {
+    return ctx.OpFNegate(ctx.F16[2], value);
+}
+
+Id EmitFPSaturate16x2(EmitContext& ctx, Id value) {
+    const Id zero{ctx.Constant(ctx.F16[1], u16{0})};
+    const Id one{ctx.Constant(ctx.F16[1], u16{0x3c00})};
+    const Id zero_vector{ctx.ConstantComposite(ctx.F16[2], zero, zero)};
+    const Id one_vector{ctx.ConstantComposite(ctx.F16[2], one, one)};
+    return Clamp(ctx, ctx.F16[2], value, zero_vector, one_vector);
+}
+
 } // namespace Shader::Backend::SPIRV
@@ -281,6 +281,12 @@ Id EmitFPUnordGreaterThanEqual64(EmitContext& ctx, Id lhs, Id rhs);
 Id EmitFPIsNan16(EmitContext& ctx, Id value);
 Id EmitFPIsNan32(EmitContext& ctx, Id value);
 Id EmitFPIsNan64(EmitContext& ctx, Id value);
+Id EmitFPAbs16x2(EmitContext& ctx, Id value);
+Id EmitFPAdd16x2(EmitContext& ctx, IR::Inst* inst, Id a, Id b);
+Id EmitFPFma16x2(EmitContext& ctx, IR::Inst* inst, Id a, Id b, Id c);
+Id EmitFPMul16x2(EmitContext& ctx, IR::Inst* inst, Id a, Id b);
+Id EmitFPNeg16x2(EmitContext& ctx, Id value);
+Id EmitFPSaturate16x2(EmitContext& ctx, Id value);
 Id EmitIAdd32(EmitContext& ctx, IR::Inst* inst, Id a, Id b);
 Id EmitIAdd64(EmitContext& ctx, Id a, Id b);
 Id EmitISub32(EmitContext& ctx, Id a, Id b);
@@ -37,7 +37,7 @@ Id WarpExtract(EmitContext& ctx, Id value) {
 
 Id LoadMask(EmitContext& ctx, Id mask) {
     const Id value{ctx.OpLoad(ctx.U32[4], mask)};
-    if (!ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (!ctx.warp_size_larger_than_guest) {
         return ctx.OpCompositeExtract(ctx.U32[1], value, 0U);
     }
     return WarpExtract(ctx, value);
@@ -82,14 +82,14 @@ Id AddPartitionBase(EmitContext& ctx, Id thread_id) {
 
 Id EmitLaneId(EmitContext& ctx) {
     const Id id{GetThreadId(ctx)};
-    if (!ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (!ctx.warp_size_larger_than_guest) {
         return id;
     }
     return ctx.OpBitwiseAnd(ctx.U32[1], id, ctx.Const(31U));
 }
 
 Id EmitVoteAll(EmitContext& ctx, Id pred) {
-    if (!ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (!ctx.warp_size_larger_than_guest) {
         return ctx.OpGroupNonUniformAll(ctx.U1, SubgroupScope(ctx), pred);
     }
     const Id mask_ballot{
@@ -102,7 +102,7 @@ Id EmitVoteAll(EmitContext& ctx, Id pred) {
 }
 
 Id EmitVoteAny(EmitContext& ctx, Id pred) {
-    if (!ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (!ctx.warp_size_larger_than_guest) {
         return ctx.OpGroupNonUniformAny(ctx.U1, SubgroupScope(ctx), pred);
     }
     const Id mask_ballot{
@@ -115,7 +115,7 @@ Id EmitVoteAny(EmitContext& ctx, Id pred) {
 }
 
 Id EmitVoteEqual(EmitContext& ctx, Id pred) {
-    if (!ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (!ctx.warp_size_larger_than_guest) {
         return ctx.OpGroupNonUniformAllEqual(ctx.U1, SubgroupScope(ctx), pred);
     }
     const Id mask_ballot{
@@ -130,7 +130,7 @@ Id EmitVoteEqual(EmitContext& ctx, Id pred) {
 
 Id EmitSubgroupBallot(EmitContext& ctx, Id pred) {
     const Id ballot{ctx.OpGroupNonUniformBallot(ctx.U32[4], SubgroupScope(ctx), pred)};
-    if (!ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (!ctx.warp_size_larger_than_guest) {
         return ctx.OpCompositeExtract(ctx.U32[1], ballot, 0U);
     }
     return WarpExtract(ctx, ballot);
@@ -167,7 +167,7 @@ Id EmitShuffleIndex(EmitContext& ctx, IR::Inst* inst, Id value, Id index, Id cla
     Id src_thread_id{ctx.OpBitwiseOr(ctx.U32[1], lhs, min_thread_id)};
     const Id in_range{ctx.OpSLessThanEqual(ctx.U1, src_thread_id, max_thread_id)};
 
-    if (ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (ctx.warp_size_larger_than_guest) {
         src_thread_id = AddPartitionBase(ctx, src_thread_id);
     }
 
@@ -182,7 +182,7 @@ Id EmitShuffleUp(EmitContext& ctx, IR::Inst* inst, Id value, Id index, Id clamp,
     Id src_thread_id{ctx.OpISub(ctx.U32[1], thread_id, index)};
     const Id in_range{ctx.OpSGreaterThanEqual(ctx.U1, src_thread_id, max_thread_id)};
 
-    if (ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (ctx.warp_size_larger_than_guest) {
         src_thread_id = AddPartitionBase(ctx, src_thread_id);
     }
 
@@ -197,7 +197,7 @@ Id EmitShuffleDown(EmitContext& ctx, IR::Inst* inst, Id value, Id index, Id clam
     Id src_thread_id{ctx.OpIAdd(ctx.U32[1], thread_id, index)};
     const Id in_range{ctx.OpSLessThanEqual(ctx.U1, src_thread_id, max_thread_id)};
 
-    if (ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (ctx.warp_size_larger_than_guest) {
         src_thread_id = AddPartitionBase(ctx, src_thread_id);
     }
 
@@ -212,7 +212,7 @@ Id EmitShuffleButterfly(EmitContext& ctx, IR::Inst* inst, Id value, Id index, Id
     Id src_thread_id{ctx.OpBitwiseXor(ctx.U32[1], thread_id, index)};
     const Id in_range{ctx.OpSLessThanEqual(ctx.U1, src_thread_id, max_thread_id)};
 
-    if (ctx.profile.warp_size_potentially_larger_than_guest) {
+    if (ctx.warp_size_larger_than_guest) {
         src_thread_id = AddPartitionBase(ctx, src_thread_id);
     }
 
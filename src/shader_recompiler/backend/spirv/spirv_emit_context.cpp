@@ -458,7 +458,11 @@ void VectorTypes::Define(Sirit::Module& sirit_ctx, Id base_type, std::string_vie
 EmitContext::EmitContext(const Profile& profile_, const RuntimeInfo& runtime_info_,
                          IR::Program& program, Bindings& bindings)
     : Sirit::Module(profile_.supported_spirv), profile{profile_}, runtime_info{runtime_info_},
-      stage{program.stage}, texture_rescaling_index{bindings.texture_scaling_index},
+      stage{program.stage},
+      warp_size_larger_than_guest{profile.warp_size_potentially_larger_than_guest &&
+                                  ((profile.guest_warp_size_stages >> static_cast<u32>(stage)) &
+                                   1) == 0},
+      texture_rescaling_index{bindings.texture_scaling_index},
       image_rescaling_index{bindings.image_scaling_index} {
     const bool is_unified{profile.unified_descriptor_binding};
     u32& uniform_binding{is_unified ? bindings.unified : bindings.uniform_buffer};
@@ -484,6 +488,7 @@ EmitContext::EmitContext(const Profile& profile_, const RuntimeInfo& runtime_inf
     DefineGlobalMemoryFunctions(program.info);
     DefineRescalingInput(program.info);
     DefineRenderArea(program.info);
+    DefineSpecializedCbufs(program.info);
 }
 
 EmitContext::~EmitContext() = default;
@@ -1106,6 +1111,28 @@ void EmitContext::DefineRenderArea(const Info& info) {
     }
 }
 
+void EmitContext::DefineSpecializedCbufs(const Info& info) {
+    if (info.specialized_cbufs.empty()) {
+        return;
+    }
+    // Specialization is disabled by default, pipelines created without specialization info
+    // read the constant buffers as usual
+    cbuf_specialization_enabled = SpecConstantFalse(U1);
+    Decorate(cbuf_specialization_enabled, spv::Decoration::SpecId, CBUF_SPECIALIZATION_ENABLE_ID);
+    Name(cbuf_specialization_enabled, "cbuf_specialization_enabled");
+    u32 spec_id{CBUF_SPECIALIZATION_FIRST_VALUE_ID};
+    for (const SpecializedCbufDescriptor& desc : info.specialized_cbufs) {
+        const Id value{SpecConstant(U32[1], 0U)};
+        Decorate(value, spv::Decoration::SpecId, spec_id++);
+        Name(value, fmt::format("cbuf{}_{:x}_spec", desc.index, desc.offset));
+        specialized_cbufs.push_back({
+            .index = desc.index,
+            .offset = desc.offset,
+            .value = value,
+        });
+    }
+}
+
 void EmitContext::DefineConstantBuffers(const Info& info, u32& binding) {
     if (info.constant_buffer_descriptors.empty()) {
         return;
@@ -1441,7 +1468,7 @@ void EmitContext::DefineInputs(const IR::Program& program) {
         subgroup_mask_ge = DefineInput(*this, U32[4], false, spv::BuiltIn::SubgroupGeMaskKHR);
     }
     if (info.uses_fswzadd || info.uses_subgroup_invocation_id || info.uses_subgroup_shuffles ||
-        (profile.warp_size_potentially_larger_than_guest &&
+        (warp_size_larger_than_guest &&
          (info.uses_subgroup_vote || info.uses_subgroup_mask))) {
         AddCapability(spv::Capability::GroupNonUniform);
         subgroup_local_invocation_id =
@@ -205,6 +205,8 @@ public:
     const Profile& profile;
     const RuntimeInfo& runtime_info;
     Stage stage{};
+    /// True when the subgroups running this stage may be wider than the guest warp
+    bool warp_size_larger_than_guest{};
 
     Id void_id{};
     Id U1{};
@@ -300,6 +302,15 @@ public:
     Id render_area_push_constant{};
     u32 render_are_member_index{};
 
+    struct SpecializedCbuf {
+        u32 index;
+        u32 offset;
+        Id value;
+    };
+    Id cbuf_specialization_enabled{};
+    boost::container::static_vector<SpecializedCbuf, Info::MAX_SPECIALIZED_CBUFS>
+        specialized_cbufs;
+
     Id local_memory{};
 
     Id shared_memory_u8{};
@@ -380,6 +391,7 @@ private:
     void DefineRescalingInputPushConstant();
     void DefineRescalingInputUniformConstant();
     void DefineRenderArea(const Info& info);
+    void DefineSpecializedCbufs(const Info& info);
 
     void DefineInputs(const IR::Program& program);
     void DefineOutputs(const IR::Program& program);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <optional>
 
 #include "common/common_types.h"
 #include "shader_recompiler/program_header.h"
@@ -43,6 +44,12 @@ public:
 
     virtual void Dump(u64 pipeline_hash, u64 shader_hash) = 0;
 
+    /// Returns a hash of every input observed by the recompiler, if the environment can provide
+    /// a stable one. Environments with identical hashes translate to identical programs.
+    [[nodiscard]] virtual std::optional<u64> TranslationHash() const {
+        return std::nullopt;
+    }
+
     [[nodiscard]] const ProgramHeader& SPH() const noexcept {
         return sph;
     }
@@ -41,6 +41,8 @@ struct AbstractSyntaxNode {
             U1 cond;
             Block* loop_header;
             Block* merge;
+            /// True when the loop is proven to terminate and needs no safety checks
+            bool is_bounded;
         } repeat;
         struct {
             U1 cond;
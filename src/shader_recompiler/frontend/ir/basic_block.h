@@ -20,6 +20,9 @@ namespace Shader::IR {
 
 class Block {
 public:
+    /// Number of condition code flags (zero, sign, carry and overflow) tracked by the SSA pass.
+    static constexpr size_t NUM_SSA_FLAGS = 4;
+
     using InstructionList = boost::intrusive::list<Inst>;
     using size_type = InstructionList::size_type;
     using iterator = InstructionList::iterator;
@@ -86,6 +89,20 @@ public:
         return ssa_reg_values[RegIndex(reg)];
     }
 
+    void SetSsaPredValue(IR::Pred pred, const Value& value) noexcept {
+        ssa_pred_values[PredIndex(pred)] = value;
+    }
+    const Value& SsaPredValue(IR::Pred pred) const noexcept {
+        return ssa_pred_values[PredIndex(pred)];
+    }
+
+    void SetSsaFlagValue(size_t flag_index, const Value& value) noexcept {
+        ssa_flag_values[flag_index] = value;
+    }
+    const Value& SsaFlagValue(size_t flag_index) const noexcept {
+        return ssa_flag_values[flag_index];
+    }
+
     void SsaSeal() noexcept {
         is_ssa_sealed = true;
     }
@@ -179,6 +196,10 @@ private:
 
     /// Intrusively store the value of a register in the block.
     std::array<Value, NUM_REGS> ssa_reg_values;
+    /// Intrusively store the value of a predicate in the block.
+    std::array<Value, NUM_USER_PREDS> ssa_pred_values;
+    /// Intrusively store the value of a condition code flag in the block.
+    std::array<Value, NUM_SSA_FLAGS> ssa_flag_values;
     /// Intrusively store if the block is sealed in the SSA pass.
     bool is_ssa_sealed{false};
 
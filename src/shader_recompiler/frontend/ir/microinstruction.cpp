@@ -10,33 +10,6 @@
 #include "shader_recompiler/frontend/ir/value.h"
 
 namespace Shader::IR {
-namespace {
-void CheckPseudoInstruction(IR::Inst* inst, IR::Opcode opcode) {
-    if (inst && inst->GetOpcode() != opcode) {
-        throw LogicError("Invalid pseudo-instruction");
-    }
-}
-
-void SetPseudoInstruction(IR::Inst*& dest_inst, IR::Inst* pseudo_inst) {
-    if (dest_inst) {
-        throw LogicError("Only one of each type of pseudo-op allowed");
-    }
-    dest_inst = pseudo_inst;
-}
-
-void RemovePseudoInstruction(IR::Inst*& inst, IR::Opcode expected_opcode) {
-    if (inst->GetOpcode() != expected_opcode) {
-        throw LogicError("Undoing use of invalid pseudo-op");
-    }
-    inst = nullptr;
-}
-
-void AllocAssociatedInsts(std::unique_ptr<AssociatedInsts>& associated_insts) {
-    if (!associated_insts) {
-        associated_insts = std::make_unique<AssociatedInsts>();
-    }
-}
-} // Anonymous namespace
 
 Inst::Inst(IR::Opcode op_, u32 flags_) noexcept : op{op_}, flags{flags_} {
     if (op == Opcode::Phi) {
@@ -255,31 +228,23 @@ bool Inst::AreAllArgsImmediates() const {
 }
 
 Inst* Inst::GetAssociatedPseudoOperation(IR::Opcode opcode) {
-    if (!associated_insts) {
-        return nullptr;
-    }
     switch (opcode) {
     case Opcode::GetZeroFromOp:
-        CheckPseudoInstruction(associated_insts->zero_inst, Opcode::GetZeroFromOp);
-        return associated_insts->zero_inst;
     case Opcode::GetSignFromOp:
-        CheckPseudoInstruction(associated_insts->sign_inst, Opcode::GetSignFromOp);
-        return associated_insts->sign_inst;
     case Opcode::GetCarryFromOp:
-        CheckPseudoInstruction(associated_insts->carry_inst, Opcode::GetCarryFromOp);
-        return associated_insts->carry_inst;
     case Opcode::GetOverflowFromOp:
-        CheckPseudoInstruction(associated_insts->overflow_inst, Opcode::GetOverflowFromOp);
-        return associated_insts->overflow_inst;
     case Opcode::GetSparseFromOp:
-        CheckPseudoInstruction(associated_insts->sparse_inst, Opcode::GetSparseFromOp);
-        return associated_insts->sparse_inst;
     case Opcode::GetInBoundsFromOp:
-        CheckPseudoInstruction(associated_insts->in_bounds_inst, Opcode::GetInBoundsFromOp);
-        return associated_insts->in_bounds_inst;
+        break;
     default:
         throw InvalidArgument("{} is not a pseudo-instruction", opcode);
     }
+    for (Inst* pseudo_op = first_pseudo_op; pseudo_op; pseudo_op = pseudo_op->next_pseudo_op) {
+        if (pseudo_op->op == opcode) {
+            return pseudo_op;
+        }
+    }
+    return nullptr;
 }
 
 IR::Type Inst::Type() const {
@@ -386,70 +351,32 @@ void Inst::Use(const Value& value) {
     Inst* const inst{value.Inst()};
     ++inst->use_count;
 
-    std::unique_ptr<AssociatedInsts>& assoc_inst{inst->associated_insts};
-    switch (op) {
-    case Opcode::GetZeroFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        SetPseudoInstruction(assoc_inst->zero_inst, this);
-        break;
-    case Opcode::GetSignFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        SetPseudoInstruction(assoc_inst->sign_inst, this);
-        break;
-    case Opcode::GetCarryFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        SetPseudoInstruction(assoc_inst->carry_inst, this);
-        break;
-    case Opcode::GetOverflowFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        SetPseudoInstruction(assoc_inst->overflow_inst, this);
-        break;
-    case Opcode::GetSparseFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        SetPseudoInstruction(assoc_inst->sparse_inst, this);
-        break;
-    case Opcode::GetInBoundsFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        SetPseudoInstruction(assoc_inst->in_bounds_inst, this);
-        break;
-    default:
-        break;
+    if (!IsPseudoInstruction()) {
+        return;
     }
+    if (inst->GetAssociatedPseudoOperation(op)) {
+        throw LogicError("Only one of each type of pseudo-op allowed");
+    }
+    next_pseudo_op = inst->first_pseudo_op;
+    inst->first_pseudo_op = this;
 }
 
 void Inst::UndoUse(const Value& value) {
     Inst* const inst{value.Inst()};
     --inst->use_count;
 
-    std::unique_ptr<AssociatedInsts>& assoc_inst{inst->associated_insts};
-    switch (op) {
-    case Opcode::GetZeroFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        RemovePseudoInstruction(assoc_inst->zero_inst, Opcode::GetZeroFromOp);
-        break;
-    case Opcode::GetSignFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        RemovePseudoInstruction(assoc_inst->sign_inst, Opcode::GetSignFromOp);
-        break;
-    case Opcode::GetCarryFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        RemovePseudoInstruction(assoc_inst->carry_inst, Opcode::GetCarryFromOp);
-        break;
-    case Opcode::GetOverflowFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        RemovePseudoInstruction(assoc_inst->overflow_inst, Opcode::GetOverflowFromOp);
-        break;
-    case Opcode::GetSparseFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        RemovePseudoInstruction(assoc_inst->sparse_inst, Opcode::GetSparseFromOp);
-        break;
-    case Opcode::GetInBoundsFromOp:
-        AllocAssociatedInsts(assoc_inst);
-        RemovePseudoInstruction(assoc_inst->in_bounds_inst, Opcode::GetInBoundsFromOp);
-        break;
-    default:
-        break;
+    if (!IsPseudoInstruction()) {
+        return;
+    }
+    Inst** link{&inst->first_pseudo_op};
+    while (*link != this) {
+        if (!*link) {
+            throw LogicError("Undoing use of invalid pseudo-op");
+        }
+        link = &(*link)->next_pseudo_op;
     }
+    *link = next_pseudo_op;
+    next_pseudo_op = nullptr;
 }
 
 } // namespace Shader::IR
@@ -29,7 +29,6 @@ namespace Shader::IR {
 class Block;
 class Inst;
 
-struct AssociatedInsts;
 
 class Value {
 public:
@@ -138,7 +137,7 @@ public:
 
     /// Determines if there is a pseudo-operation associated with this instruction.
     [[nodiscard]] bool HasAssociatedPseudoOperation() const noexcept {
-        return associated_insts != nullptr;
+        return first_pseudo_op != nullptr;
     }
 
     /// Determines whether or not this instruction may have side effects.
@@ -244,21 +243,14 @@ private:
         boost::container::small_vector<std::pair<Block*, Value>, 2> phi_args;
         std::array<Value, 5> args;
     };
-    std::unique_ptr<AssociatedInsts> associated_insts;
+    /// First pseudo-operation associated with this instruction.
+    /// Pseudo-operations are chained intrusively to avoid a separate allocation.
+    Inst* first_pseudo_op{};
+    /// Next pseudo-operation associated with the same instruction, only used by pseudo-operations.
+    Inst* next_pseudo_op{};
 };
 static_assert(sizeof(Inst) <= 128, "Inst size unintentionally increased");
 
-struct AssociatedInsts {
-    union {
-        Inst* in_bounds_inst;
-        Inst* sparse_inst;
-        Inst* zero_inst{};
-    };
-    Inst* sign_inst{};
-    Inst* carry_inst{};
-    Inst* overflow_inst{};
-};
-
 using U1 = TypedValue<Type::U1>;
 using U8 = TypedValue<Type::U8>;
 using U16 = TypedValue<Type::U16>;
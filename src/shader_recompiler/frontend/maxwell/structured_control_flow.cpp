@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -12,6 +13,7 @@
 
 #include <boost/intrusive/list.hpp>
 
+#include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
@@ -23,6 +25,9 @@
 
 namespace Shader::Maxwell {
 namespace {
+/// Structurizing shaders slower than this is reported
+constexpr std::chrono::milliseconds SLOW_STRUCTURIZE_THRESHOLD{50};
+
 struct Statement;
 
 // Use normal_link because we are not guaranteed to destroy the tree in order
@@ -313,17 +318,53 @@ class GotoPass {
 public:
     explicit GotoPass(Flow::CFG& cfg, ObjectPool<Statement>& stmt_pool) : pool{stmt_pool} {
         std::vector gotos{BuildTree(cfg)};
+        num_gotos = gotos.size();
         const auto end{gotos.rend()};
         for (auto goto_stmt = gotos.rbegin(); goto_stmt != end; ++goto_stmt) {
             RemoveGoto(*goto_stmt);
         }
+        // Gotos of structured control flow are eliminated in place and never read their variable,
+        // drop the resets of those variables so they don't reach the IR
+        RemoveUnreadVariables(root_stmt.children);
     }
 
     Statement& RootStatement() noexcept {
         return root_stmt;
     }
 
+    /// Number of gotos in the unstructured tree
+    size_t NumGotos() const noexcept {
+        return num_gotos;
+    }
+
+    /// Number of goto variables that have to be tracked by the structured tree
+    size_t NumReadVariables() const noexcept {
+        return static_cast<size_t>(std::ranges::count(read_variables, true));
+    }
+
 private:
+    Statement* MakeVariable(u32 label_id) {
+        if (label_id >= read_variables.size()) {
+            read_variables.resize(label_id + 1);
+        }
+        read_variables[label_id] = true;
+        return pool.Create(Variable{}, label_id, &root_stmt);
+    }
+
+    void RemoveUnreadVariables(Tree& tree) {
+        for (auto it = tree.begin(); it != tree.end();) {
+            if (it->type == StatementType::SetVariable &&
+                (it->id >= read_variables.size() || !read_variables[it->id])) {
+                it = tree.erase(it);
+                continue;
+            }
+            if (HasChildren(it->type)) {
+                RemoveUnreadVariables(it->children);
+            }
+            ++it;
+        }
+    }
+
     void RemoveGoto(Node goto_stmt) {
         // Force goto_stmt and label_stmt to be directly related
         const Node label_stmt{goto_stmt->label};
@@ -518,7 +559,7 @@ private:
 
         Tree if_body;
         if_body.splice(if_body.begin(), body, std::next(goto_stmt), label_nested_stmt);
-        Statement* const variable{pool.Create(Variable{}, label_id, &root_stmt)};
+        Statement* const variable{MakeVariable(label_id)};
         Statement* const neg_var{pool.Create(Not{}, variable, &root_stmt)};
         if (!if_body.empty()) {
             Statement* const if_stmt{pool.Create(If{}, neg_var, std::move(if_body), parent)};
@@ -553,7 +594,7 @@ private:
         Tree loop_body;
         loop_body.splice(loop_body.begin(), body, label_nested_stmt, goto_stmt);
         SanitizeNoBreaks(loop_body);
-        Statement* const variable{pool.Create(Variable{}, label_id, &root_stmt)};
+        Statement* const variable{MakeVariable(label_id)};
         Statement* const loop_stmt{pool.Create(Loop{}, variable, std::move(loop_body), parent)};
         UpdateTreeUp(loop_stmt);
         body.insert(goto_stmt, *loop_stmt);
@@ -580,7 +621,7 @@ private:
         Tree if_body;
         if_body.splice(if_body.begin(), body, std::next(goto_stmt), body.end());
         if_body.pop_front();
-        Statement* const cond{pool.Create(Variable{}, label_id, &root_stmt)};
+        Statement* const cond{MakeVariable(label_id)};
         Statement* const neg_cond{pool.Create(Not{}, cond, &root_stmt)};
         Statement* const if_stmt{pool.Create(If{}, neg_cond, std::move(if_body), &*parent)};
         UpdateTreeUp(if_stmt);
@@ -588,7 +629,7 @@ private:
 
         body.erase(goto_stmt);
 
-        Statement* const new_cond{pool.Create(Variable{}, label_id, &root_stmt)};
+        Statement* const new_cond{MakeVariable(label_id)};
         Statement* const new_goto{pool.Create(Goto{}, new_cond, goto_stmt->label, parent->up)};
         Tree& parent_tree{parent->up->children};
         return parent_tree.insert(std::next(parent), *new_goto);
@@ -600,14 +641,14 @@ private:
         const u32 label_id{goto_stmt->label->id};
         Statement* const goto_cond{goto_stmt->cond};
         Statement* const set_goto_var{pool.Create(SetVariable{}, label_id, goto_cond, parent)};
-        Statement* const cond{pool.Create(Variable{}, label_id, &root_stmt)};
+        Statement* const cond{MakeVariable(label_id)};
         Statement* const break_stmt{pool.Create(Break{}, cond, parent)};
         body.insert(goto_stmt, *set_goto_var);
         body.insert(goto_stmt, *break_stmt);
         body.erase(goto_stmt);
 
         const Node loop{Tree::s_iterator_to(*goto_stmt->up)};
-        Statement* const new_goto_cond{pool.Create(Variable{}, label_id, &root_stmt)};
+        Statement* const new_goto_cond{MakeVariable(label_id)};
         Statement* const new_goto{pool.Create(Goto{}, new_goto_cond, goto_stmt->label, loop->up)};
         Tree& parent_tree{loop->up->children};
         return parent_tree.insert(std::next(loop), *new_goto);
@@ -615,6 +656,8 @@ private:
 
     ObjectPool<Statement>& pool;
     Statement root_stmt{FunctionTag{}};
+    std::vector<bool> read_variables;
+    size_t num_gotos{};
 };
 
 [[nodiscard]] Statement* TryFindForwardBlock(Statement& stmt) {
@@ -782,6 +825,7 @@ private:
                 repeat.data.repeat.cond = cond;
                 repeat.data.repeat.loop_header = loop_header_block;
                 repeat.data.repeat.merge = merge_block;
+                repeat.data.repeat.is_bounded = false;
 
                 auto& merge{syntax_list.emplace_back()};
                 merge.type = IR::AbstractSyntaxNode::Type::Block;
@@ -983,11 +1027,24 @@ private:
 IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
                                 Environment& env, Flow::CFG& cfg,
                                 const HostTranslateInfo& host_info) {
+    const auto start{std::chrono::steady_clock::now()};
     ObjectPool<Statement> stmt_pool{64};
     GotoPass goto_pass{cfg, stmt_pool};
     Statement& root{goto_pass.RootStatement()};
     IR::AbstractSyntaxList syntax_list;
     TranslatePass{inst_pool, block_pool, stmt_pool, env, root, syntax_list, host_info};
+
+    const auto elapsed{std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start)};
+    if (elapsed >= SLOW_STRUCTURIZE_THRESHOLD) {
+        LOG_WARNING(Shader, "Structurizing shader at 0x{:x} took {} ms, {} gotos, {} variables",
+                    env.StartAddress(), elapsed.count(), goto_pass.NumGotos(),
+                    goto_pass.NumReadVariables());
+    } else {
+        LOG_DEBUG(Shader, "Structurized shader at 0x{:x} in {} ms, {} gotos, {} variables",
+                  env.StartAddress(), elapsed.count(), goto_pass.NumGotos(),
+                  goto_pass.NumReadVariables());
+    }
     return syntax_list;
 }
 
@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <string_view>
 #include <vector>
 #include <queue>
 
@@ -235,14 +237,44 @@ void LowerGeometryPassthrough(const IR::Program& program, const HostTranslateInf
     }
 }
 
+template <typename Func>
+void RunPass(PassStatistics* statistics, std::string_view name, const IR::Program& program,
+             Func&& func) {
+    if (!statistics) {
+        func();
+        return;
+    }
+    const auto count_allocations{[statistics]() -> size_t {
+        return statistics->allocation_count ? statistics->allocation_count() : 0;
+    }};
+    const size_t allocations_before{count_allocations()};
+    const auto start{std::chrono::steady_clock::now()};
+    func();
+    const auto end{std::chrono::steady_clock::now()};
+    const size_t allocations_after{count_allocations()};
+
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    statistics->entries.push_back({
+        .name = name,
+        .time = end - start,
+        .num_insts = num_insts,
+        .num_allocations = allocations_after - allocations_before,
+    });
+}
 } // Anonymous namespace
 
 IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                             Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
+                             Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info,
+                             PassStatistics* statistics) {
     IR::Program program;
-    program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
-    program.blocks = GenerateBlocks(program.syntax_list);
-    program.post_order_blocks = PostOrder(program.syntax_list.front());
+    RunPass(statistics, "Structurize", program, [&] {
+        program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
+        program.blocks = GenerateBlocks(program.syntax_list);
+        program.post_order_blocks = PostOrder(program.syntax_list.front());
+    });
     program.stage = env.ShaderStage();
     program.local_memory_size = env.LocalMemorySize();
     switch (program.stage) {
@@ -281,36 +313,60 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
 
     // Replace instructions before the SSA rewrite
     if (!host_info.support_float64) {
-        Optimization::LowerFp64ToFp32(program);
+        RunPass(statistics, "LowerFp64ToFp32", program,
+                [&] { Optimization::LowerFp64ToFp32(program); });
     }
     if (!host_info.support_float16) {
-        Optimization::LowerFp16ToFp32(program);
+        RunPass(statistics, "LowerFp16ToFp32", program,
+                [&] { Optimization::LowerFp16ToFp32(program); });
     }
     if (!host_info.support_int64) {
-        Optimization::LowerInt64ToInt32(program);
+        RunPass(statistics, "LowerInt64ToInt32", program,
+                [&] { Optimization::LowerInt64ToInt32(program); });
     }
     if (!host_info.support_conditional_barrier) {
-        Optimization::ConditionalBarrierPass(program);
+        RunPass(statistics, "ConditionalBarrierPass", program,
+                [&] { Optimization::ConditionalBarrierPass(program); });
     }
-    Optimization::SsaRewritePass(program);
+    RunPass(statistics, "SsaRewritePass", program, [&] { Optimization::SsaRewritePass(program); });
 
-    Optimization::ConstantPropagationPass(env, program);
+    RunPass(statistics, "ConstantPropagationPass", program,
+            [&] { Optimization::ConstantPropagationPass(env, program); });
 
-    Optimization::PositionPass(env, program);
+    RunPass(statistics, "PositionPass", program,
+            [&] { Optimization::PositionPass(env, program); });
 
-    Optimization::GlobalMemoryToStorageBufferPass(program, host_info);
-    Optimization::TexturePass(env, program, host_info);
+    RunPass(statistics, "GlobalMemoryToStorageBufferPass", program,
+            [&] { Optimization::GlobalMemoryToStorageBufferPass(program, host_info); });
+    RunPass(statistics, "TexturePass", program,
+            [&] { Optimization::TexturePass(env, program, host_info); });
 
     if (Settings::values.resolution_info.active) {
-        Optimization::RescalingPass(program);
+        RunPass(statistics, "RescalingPass", program,
+                [&] { Optimization::RescalingPass(program); });
+    }
+    if (host_info.support_float16) {
+        RunPass(statistics, "VectorizeFp16Pass", program,
+                [&] { Optimization::VectorizeFp16Pass(program); });
+    }
+    RunPass(statistics, "DeadCodeEliminationPass", program,
+            [&] { Optimization::DeadCodeEliminationPass(program); });
+    RunPass(statistics, "LoopBoundAnalysisPass", program,
+            [&] { Optimization::LoopBoundAnalysisPass(program); });
+    if (host_info.support_cbuf_specialization) {
+        RunPass(statistics, "ConstantBufferSpecializationPass", program,
+                [&] { Optimization::ConstantBufferSpecializationPass(program); });
     }
-    Optimization::DeadCodeEliminationPass(program);
     if (Settings::values.renderer_debug) {
-        Optimization::VerificationPass(program);
+        RunPass(statistics, "VerificationPass", program,
+                [&] { Optimization::VerificationPass(program); });
     }
-    Optimization::CollectShaderInfoPass(env, program);
-    Optimization::LayerPass(program, host_info);
-    Optimization::VendorWorkaroundPass(program);
+    RunPass(statistics, "CollectShaderInfoPass", program,
+            [&] { Optimization::CollectShaderInfoPass(env, program); });
+    RunPass(statistics, "LayerPass", program,
+            [&] { Optimization::LayerPass(program, host_info); });
+    RunPass(statistics, "VendorWorkaroundPass", program,
+            [&] { Optimization::VendorWorkaroundPass(program); });
 
     CollectInterpolationInfo(env, program);
     AddNVNStorageBuffers(program);
@@ -410,6 +466,36 @@ void ConvertLegacyToGeneric(IR::Program& program, const Shader::RuntimeInfo& run
     }
 }
 
+void EliminateDeadVaryings(IR::Program& producer, const IR::Program& consumer) {
+    if (consumer.stage != Stage::Fragment || producer.is_geometry_passthrough ||
+        producer.info.stores_indexed_attributes || consumer.info.loads_indexed_attributes) {
+        // Indexed accesses and passthrough geometry shaders can't be resolved per component
+        return;
+    }
+    VaryingState dead_stores{};
+    for (size_t index = 0; index < IR::NUM_GENERICS; ++index) {
+        for (size_t component = 0; component < 4; ++component) {
+            if (producer.info.stores.Generic(index, component) &&
+                !consumer.info.loads.Generic(index, component)) {
+                dead_stores.Set(IR::Attribute::Generic0X + index * 4 + component, true);
+            }
+        }
+    }
+    if (dead_stores.mask.none()) {
+        return;
+    }
+    for (IR::Block* const block : producer.post_order_blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            if (inst.GetOpcode() == IR::Opcode::SetAttribute &&
+                dead_stores[inst.Arg(0).Attribute()]) {
+                inst.Invalidate();
+            }
+        }
+    }
+    producer.info.stores.mask &= ~dead_stores.mask;
+    Optimization::DeadCodeEliminationPass(producer);
+}
+
 IR::Program GenerateGeometryPassthrough(ObjectPool<IR::Inst>& inst_pool,
                                         ObjectPool<IR::Block>& block_pool,
                                         const HostTranslateInfo& host_info,
@@ -8,6 +8,7 @@
 #include "shader_recompiler/frontend/ir/program.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/pass_statistics.h"
 #include "shader_recompiler/runtime_info.h"
 
 namespace Shader {
@@ -16,15 +17,23 @@ struct HostTranslateInfo;
 
 namespace Shader::Maxwell {
 
+/// Translates a program, when statistics is not null the cost of each pass is recorded in it
 [[nodiscard]] IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool,
                                            ObjectPool<IR::Block>& block_pool, Environment& env,
-                                           Flow::CFG& cfg, const HostTranslateInfo& host_info);
+                                           Flow::CFG& cfg, const HostTranslateInfo& host_info,
+                                           PassStatistics* statistics = nullptr);
 
 [[nodiscard]] IR::Program MergeDualVertexPrograms(IR::Program& vertex_a, IR::Program& vertex_b,
                                                   Environment& env_vertex_b);
 
 void ConvertLegacyToGeneric(IR::Program& program, const RuntimeInfo& runtime_info);
 
+// Removes the generic outputs of the last pre-rasterization stage that the fragment stage never
+// reads, together with the computations that only fed them.
+// Both programs must have been fully translated. Outputs captured by transform feedback are not
+// known here, so callers must not link programs that have it enabled.
+void EliminateDeadVaryings(IR::Program& producer, const IR::Program& consumer);
+
 // Maxwell v1 and older Nvidia cards don't support setting gl_Layer from non-geometry stages.
 // This creates a workaround by setting the layer as a generic output and creating a
 // passthrough geometry shader that reads the generic and sets the layer.
@@ -21,6 +21,8 @@ struct HostTranslateInfo {
                                                 ///< passthrough shaders
     bool support_conditional_barrier{}; ///< True when the device supports barriers in conditional
                                         ///< control flow
+    bool support_cbuf_specialization{}; ///< True when the host can specialize constant buffer
+                                        ///< reads at pipeline creation
 };
 
 } // namespace Shader
@@ -158,6 +158,12 @@ void VisitUsages(Info& info, IR::Inst& inst) {
     case IR::Opcode::FPSaturate16:
     case IR::Opcode::FPClamp16:
     case IR::Opcode::FPTrunc16:
+    case IR::Opcode::FPAbs16x2:
+    case IR::Opcode::FPAdd16x2:
+    case IR::Opcode::FPFma16x2:
+    case IR::Opcode::FPMul16x2:
+    case IR::Opcode::FPNeg16x2:
+    case IR::Opcode::FPSaturate16x2:
     case IR::Opcode::FPOrdEqual16:
     case IR::Opcode::FPUnordEqual16:
     case IR::Opcode::FPOrdNotEqual16:
@@ -771,6 +777,9 @@ void VisitFpModifiers(Info& info, IR::Inst& inst) {
     case IR::Opcode::FPAdd16:
     case IR::Opcode::FPFma16:
     case IR::Opcode::FPMul16:
+    case IR::Opcode::FPAdd16x2:
+    case IR::Opcode::FPFma16x2:
+    case IR::Opcode::FPMul16x2:
     case IR::Opcode::FPRoundEven16:
     case IR::Opcode::FPFloor16:
     case IR::Opcode::FPCeil16:
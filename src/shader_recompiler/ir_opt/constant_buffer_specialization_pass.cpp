@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include <boost/container/small_vector.hpp>
+
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Maximum number of instructions visited above a branch condition
+constexpr size_t MAX_VISITED_INSTS = 32;
+
+bool IsSpecializableCbufRead(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::GetCbufU32:
+    case IR::Opcode::GetCbufF32:
+        return inst.Arg(0).IsImmediate() && inst.Arg(1).IsImmediate() &&
+               inst.Arg(1).U32() % sizeof(u32) == 0;
+    default:
+        return false;
+    }
+}
+
+void CollectConditionCbufs(const IR::Inst& condition_ref, Info& info) {
+    boost::container::small_vector<const IR::Inst*, MAX_VISITED_INSTS> visited;
+    const IR::Value condition{condition_ref.Arg(0)};
+    if (condition.IsImmediate()) {
+        return;
+    }
+    visited.push_back(condition.InstRecursive());
+    for (size_t index = 0; index < visited.size(); ++index) {
+        const IR::Inst* const inst{visited[index]};
+        if (IsSpecializableCbufRead(*inst)) {
+            const SpecializedCbufDescriptor desc{
+                .index = inst->Arg(0).U32(),
+                .offset = inst->Arg(1).U32(),
+            };
+            auto& cbufs{info.specialized_cbufs};
+            if (std::ranges::find(cbufs, desc) == cbufs.end() &&
+                cbufs.size() < Info::MAX_SPECIALIZED_CBUFS) {
+                cbufs.push_back(desc);
+            }
+            continue;
+        }
+        const size_t num_args{inst->NumArgs()};
+        for (size_t arg = 0; arg < num_args; ++arg) {
+            const IR::Value value{inst->Arg(arg)};
+            if (value.IsImmediate()) {
+                continue;
+            }
+            const IR::Inst* const arg_inst{value.InstRecursive()};
+            if (visited.size() < MAX_VISITED_INSTS &&
+                std::ranges::find(visited, arg_inst) == visited.end()) {
+                visited.push_back(arg_inst);
+            }
+        }
+    }
+}
+} // Anonymous namespace
+
+void ConstantBufferSpecializationPass(IR::Program& program) {
+    // Constant buffer words that decide control flow are usually uber-shader flags. The backend
+    // emits them as specialization constants so pipelines can fold the branches for the values
+    // observed at draw time, without translating the shader again.
+    program.info.specialized_cbufs.clear();
+    for (IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : block->Instructions()) {
+            if (inst.GetOpcode() == IR::Opcode::ConditionRef) {
+                CollectConditionCbufs(inst, program.info);
+            }
+        }
+    }
+}
+
+} // namespace Shader::Optimization
@@ -51,6 +51,9 @@ struct StorageInfo {
     StorageBufferSet set;
     StorageInstVector to_replace;
     StorageWritesSet writes;
+    u32 num_global_insts{};
+    u32 num_pointer_tracked{};
+    u32 num_fallbacks{};
 };
 
 /// Returns true when the instruction is a global memory instruction
@@ -366,6 +369,78 @@ std::optional<StorageBufferAddr> Track(const IR::Value& value, const Bias* bias)
     return BreadthFirstSearch(value, pred);
 }
 
+struct PointerTrackState {
+    small_vector<const IR::Inst*, 8> visited_phis;
+    /// Set when the last tracked pointer was derived from a phi already being tracked
+    bool reached_loop{};
+};
+
+/// Maximum number of pointer arithmetic instructions and phis to look through
+constexpr u32 MAX_POINTER_TRACK_DEPTH = 16;
+
+/// Tries to track the storage buffer of a 64-bit pointer through dynamic offsets and phis.
+/// Phi operands have to track to the same storage buffer, loop back edges are ignored.
+std::optional<StorageBufferAddr> TrackPointer(const IR::Value& pointer, const Bias* bias,
+                                              PointerTrackState& state, u32 depth) {
+    if (pointer.IsImmediate() || depth > MAX_POINTER_TRACK_DEPTH) {
+        return std::nullopt;
+    }
+    const IR::Inst* const inst{pointer.InstRecursive()};
+    switch (inst->GetOpcode()) {
+    case IR::Opcode::IAdd64: {
+        // Either side of the addition can be the base pointer, try the canonical one first
+        if (auto result{TrackPointer(inst->Arg(0), bias, state, depth + 1)}) {
+            return result;
+        }
+        if (state.reached_loop) {
+            // The first operand is the pointer being iterated, the other one is an offset
+            return std::nullopt;
+        }
+        return TrackPointer(inst->Arg(1), bias, state, depth + 1);
+    }
+    case IR::Opcode::ISub64:
+        return TrackPointer(inst->Arg(0), bias, state, depth + 1);
+    case IR::Opcode::PackUint2x32: {
+        const IR::Value vector{inst->Arg(0)};
+        if (vector.IsImmediate()) {
+            return std::nullopt;
+        }
+        const IR::Inst* const vector_inst{vector.InstRecursive()};
+        if (vector_inst->GetOpcode() != IR::Opcode::CompositeConstructU32x2) {
+            return std::nullopt;
+        }
+        return Track(vector_inst->Arg(0), bias);
+    }
+    case IR::Opcode::Phi: {
+        if (std::ranges::find(state.visited_phis, inst) != state.visited_phis.end()) {
+            // Loop back edge, the pointer is constrained by the other operands
+            state.reached_loop = true;
+            return std::nullopt;
+        }
+        state.visited_phis.push_back(inst);
+        std::optional<StorageBufferAddr> result;
+        const size_t num_args{inst->NumArgs()};
+        for (size_t arg = 0; arg < num_args; ++arg) {
+            state.reached_loop = false;
+            const std::optional<StorageBufferAddr> operand{
+                TrackPointer(inst->Arg(arg), bias, state, depth + 1)};
+            if (!operand && state.reached_loop) {
+                continue;
+            }
+            if (!operand || (result && *result != *operand)) {
+                // The phi merges pointers that can't be proven to be in the same buffer
+                return std::nullopt;
+            }
+            result = operand;
+        }
+        state.reached_loop = false;
+        return result;
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
 /// Collects the storage buffer used by a global memory instruction and the instruction itself
 void CollectStorageBuffers(IR::Block& block, IR::Inst& inst, StorageInfo& info) {
     // NVN puts storage buffers in a specific range, we have to bias towards these addresses to
@@ -376,23 +451,36 @@ void CollectStorageBuffers(IR::Block& block, IR::Inst& inst, StorageInfo& info)
         .offset_end = 0x610,
         .alignment = 16,
     };
+    ++info.num_global_insts;
     // Track the low address of the instruction
-    const std::optional<LowAddrInfo> low_addr_info{TrackLowAddress(&inst)};
-    if (!low_addr_info) {
-        // Failed to track the low address, use NVN fallbacks
-        return;
-    }
-    // First try to find storage buffers in the NVN address
-    const IR::U32 low_addr{low_addr_info->value};
-    std::optional<StorageBufferAddr> storage_buffer{Track(low_addr, &nvn_bias)};
-    if (!storage_buffer) {
-        // If it fails, track without a bias
-        storage_buffer = Track(low_addr, nullptr);
+    std::optional<StorageBufferAddr> storage_buffer;
+    if (const std::optional<LowAddrInfo> low_addr_info{TrackLowAddress(&inst)}) {
+        // First try to find storage buffers in the NVN address
+        const IR::U32 low_addr{low_addr_info->value};
+        storage_buffer = Track(low_addr, &nvn_bias);
         if (!storage_buffer) {
-            // If that also fails, use NVN fallbacks
-            LOG_WARNING(Shader, "Storage buffer failed to track, using global memory fallbacks");
-            return;
+            // If it fails, track without a bias
+            storage_buffer = Track(low_addr, nullptr);
         }
+    } else {
+        // The address is not a plain cbuf pointer with an immediate offset, look through the
+        // pointer arithmetic. The storage offset is then computed from the full address.
+        PointerTrackState biased_state;
+        storage_buffer = TrackPointer(inst.Arg(0), &nvn_bias, biased_state, 0);
+        if (!storage_buffer) {
+            PointerTrackState unbiased_state;
+            storage_buffer = TrackPointer(inst.Arg(0), nullptr, unbiased_state, 0);
+        }
+        if (storage_buffer) {
+            ++info.num_pointer_tracked;
+        }
+    }
+    if (!storage_buffer) {
+        // If that also fails, use NVN fallbacks
+        ++info.num_fallbacks;
+        return;
+    }
+    if (!MeetsBias(*storage_buffer, nvn_bias)) {
         LOG_WARNING(Shader, "Storage buffer tracked without bias, index {} offset {}",
                     storage_buffer->index, storage_buffer->offset);
     }
@@ -530,6 +618,16 @@ void GlobalMemoryToStorageBufferPass(IR::Program& program, const HostTranslateIn
             CollectStorageBuffers(*block, inst, info);
         }
     }
+    if (info.num_fallbacks != 0) {
+        LOG_WARNING(Shader,
+                    "{} of {} global memory instructions failed to track a storage buffer, "
+                    "using global memory fallbacks",
+                    info.num_fallbacks, info.num_global_insts);
+    }
+    if (info.num_pointer_tracked != 0) {
+        LOG_DEBUG(Shader, "{} global memory instructions tracked through pointer arithmetic",
+                  info.num_pointer_tracked);
+    }
     for (const StorageBufferAddr& storage_buffer : info.set) {
         program.info.storage_buffers_descriptors.push_back({
             .cbuf_index = storage_buffer.index,
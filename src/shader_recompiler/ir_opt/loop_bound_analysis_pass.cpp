@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <optional>
+
+#include "common/common_types.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Iterations the backends allow before a loop safety check breaks out of the loop
+constexpr u32 MAX_TRIP_COUNT{0x2000};
+
+struct InductionVariable {
+    u32 init;
+    u32 step;
+};
+
+/// Returns the constant offset of value from the induction variable phi, if there is one
+std::optional<u32> OffsetFromPhi(const IR::Value& value, const IR::Inst* phi) {
+    if (value.IsImmediate()) {
+        return std::nullopt;
+    }
+    const IR::Inst* const inst{value.InstRecursive()};
+    if (inst == phi) {
+        return 0U;
+    }
+    const IR::Opcode opcode{inst->GetOpcode()};
+    if (opcode != IR::Opcode::IAdd32 && opcode != IR::Opcode::ISub32) {
+        return std::nullopt;
+    }
+    const IR::Value lhs{inst->Arg(0).Resolve()};
+    const IR::Value rhs{inst->Arg(1).Resolve()};
+    switch (opcode) {
+    case IR::Opcode::IAdd32:
+        if (!lhs.IsImmediate() && lhs.InstRecursive() == phi && rhs.IsImmediate()) {
+            return rhs.U32();
+        }
+        if (!rhs.IsImmediate() && rhs.InstRecursive() == phi && lhs.IsImmediate()) {
+            return lhs.U32();
+        }
+        return std::nullopt;
+    case IR::Opcode::ISub32:
+        if (!lhs.IsImmediate() && lhs.InstRecursive() == phi && rhs.IsImmediate()) {
+            return 0U - rhs.U32();
+        }
+        return std::nullopt;
+    default:
+        return std::nullopt;
+    }
+}
+
+/// Matches a phi in the loop header that starts at a constant and steps by a constant on each
+/// trip through the continue block
+std::optional<InductionVariable> MatchInductionVariable(const IR::Inst* phi,
+                                                        const IR::Block* loop_header,
+                                                        const IR::Block* continue_block) {
+    if (phi->GetOpcode() != IR::Opcode::Phi || phi->NumArgs() != 2) {
+        return std::nullopt;
+    }
+    const auto& header_insts{loop_header->Instructions()};
+    const bool is_header_phi{std::ranges::any_of(
+        header_insts, [phi](const IR::Inst& inst) { return &inst == phi; })};
+    if (!is_header_phi) {
+        return std::nullopt;
+    }
+    std::optional<u32> init;
+    std::optional<u32> step;
+    for (size_t index = 0; index < 2; ++index) {
+        const IR::Value arg{phi->Arg(index).Resolve()};
+        if (phi->PhiBlock(index) == continue_block) {
+            step = OffsetFromPhi(arg, phi);
+        } else if (arg.IsImmediate()) {
+            init = arg.U32();
+        }
+    }
+    if (!init || !step) {
+        return std::nullopt;
+    }
+    return InductionVariable{*init, *step};
+}
+
+std::optional<bool> Compare(IR::Opcode opcode, u32 lhs, u32 rhs) {
+    const s32 slhs{static_cast<s32>(lhs)};
+    const s32 srhs{static_cast<s32>(rhs)};
+    switch (opcode) {
+    case IR::Opcode::SLessThan:
+        return slhs < srhs;
+    case IR::Opcode::ULessThan:
+        return lhs < rhs;
+    case IR::Opcode::IEqual:
+        return lhs == rhs;
+    case IR::Opcode::SLessThanEqual:
+        return slhs <= srhs;
+    case IR::Opcode::ULessThanEqual:
+        return lhs <= rhs;
+    case IR::Opcode::SGreaterThan:
+        return slhs > srhs;
+    case IR::Opcode::UGreaterThan:
+        return lhs > rhs;
+    case IR::Opcode::INotEqual:
+        return lhs != rhs;
+    case IR::Opcode::SGreaterThanEqual:
+        return slhs >= srhs;
+    case IR::Opcode::UGreaterThanEqual:
+        return lhs >= rhs;
+    default:
+        return std::nullopt;
+    }
+}
+
+/// Returns true when the loop repeated by the given condition is proven to leave in at most
+/// MAX_TRIP_COUNT iterations
+bool IsBounded(const IR::U1& repeat_cond, const IR::Block* loop_header,
+               const IR::Block* continue_block) {
+    IR::Value cond{IR::Value{repeat_cond}.Resolve()};
+    bool negate{false};
+    while (!cond.IsImmediate()) {
+        const IR::Inst* const inst{cond.InstRecursive()};
+        if (inst->GetOpcode() == IR::Opcode::ConditionRef) {
+            cond = inst->Arg(0).Resolve();
+        } else if (inst->GetOpcode() == IR::Opcode::LogicalNot) {
+            cond = inst->Arg(0).Resolve();
+            negate = !negate;
+        } else {
+            break;
+        }
+    }
+    if (cond.IsImmediate()) {
+        // A constant false condition never repeats, a constant true one never terminates
+        return cond.U1() == negate;
+    }
+    const IR::Inst* const compare{cond.InstRecursive()};
+    const IR::Opcode opcode{compare->GetOpcode()};
+    if (!Compare(opcode, 0, 0)) {
+        return false;
+    }
+    const IR::Value lhs{compare->Arg(0).Resolve()};
+    const IR::Value rhs{compare->Arg(1).Resolve()};
+    if (lhs.IsImmediate() == rhs.IsImmediate()) {
+        return false;
+    }
+    const bool bound_is_lhs{lhs.IsImmediate()};
+    const u32 bound{bound_is_lhs ? lhs.U32() : rhs.U32()};
+    const IR::Value variable{bound_is_lhs ? rhs : lhs};
+
+    // The compared value must be the induction variable plus a constant
+    const IR::Inst* phi{variable.InstRecursive()};
+    if (phi->GetOpcode() == IR::Opcode::IAdd32 || phi->GetOpcode() == IR::Opcode::ISub32) {
+        const IR::Value base{phi->Arg(0).Resolve()};
+        const IR::Value other{phi->Arg(1).Resolve()};
+        if (base.IsImmediate() == other.IsImmediate()) {
+            return false;
+        }
+        phi = base.IsImmediate() ? other.InstRecursive() : base.InstRecursive();
+    }
+    const std::optional<InductionVariable> induction{
+        MatchInductionVariable(phi, loop_header, continue_block)};
+    if (!induction) {
+        return false;
+    }
+    const std::optional<u32> offset{OffsetFromPhi(variable, phi)};
+    if (!offset) {
+        return false;
+    }
+    // Simulate the loop, the guard counters of the backends allow the same number of iterations
+    u32 value{induction->init};
+    for (u32 trip = 0; trip < MAX_TRIP_COUNT; ++trip) {
+        const u32 compared{value + *offset};
+        const bool repeats{*Compare(opcode, bound_is_lhs ? bound : compared,
+                                    bound_is_lhs ? compared : bound) != negate};
+        if (!repeats) {
+            return true;
+        }
+        value += induction->step;
+    }
+    return false;
+}
+} // Anonymous namespace
+
+void LoopBoundAnalysisPass(IR::Program& program) {
+    IR::Block* continue_block{};
+    for (IR::AbstractSyntaxNode& node : program.syntax_list) {
+        switch (node.type) {
+        case IR::AbstractSyntaxNode::Type::Block:
+            // The continue block is always the block right before its repeat node
+            continue_block = node.data.block;
+            break;
+        case IR::AbstractSyntaxNode::Type::Repeat:
+            node.data.repeat.is_bounded = continue_block != nullptr &&
+                                          IsBounded(node.data.repeat.cond,
+                                                    node.data.repeat.loop_header, continue_block);
+            break;
+        default:
+            continue_block = nullptr;
+            break;
+        }
+    }
+}
+
+} // namespace Shader::Optimization
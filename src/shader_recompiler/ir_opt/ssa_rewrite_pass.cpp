@@ -14,12 +14,14 @@
 //
 
 #include <deque>
-#include <map>
+#include <optional>
 #include <span>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/opcodes.h"
 #include "shader_recompiler/frontend/ir/pred.h"
@@ -32,10 +34,18 @@ namespace {
 struct FlagTag {
     auto operator<=>(const FlagTag&) const noexcept = default;
 };
-struct ZeroFlagTag : FlagTag {};
-struct SignFlagTag : FlagTag {};
-struct CarryFlagTag : FlagTag {};
-struct OverflowFlagTag : FlagTag {};
+struct ZeroFlagTag : FlagTag {
+    static constexpr size_t INDEX = 0;
+};
+struct SignFlagTag : FlagTag {
+    static constexpr size_t INDEX = 1;
+};
+struct CarryFlagTag : FlagTag {
+    static constexpr size_t INDEX = 2;
+};
+struct OverflowFlagTag : FlagTag {
+    static constexpr size_t INDEX = 3;
+};
 
 struct GotoVariable : FlagTag {
     GotoVariable() = default;
@@ -63,10 +73,10 @@ struct DefTable {
     }
 
     const IR::Value& Def(IR::Block* block, IR::Pred variable) {
-        return preds[IR::PredIndex(variable)][block];
+        return block->SsaPredValue(variable);
     }
     void SetDef(IR::Block* block, IR::Pred variable, const IR::Value& value) {
-        preds[IR::PredIndex(variable)].insert_or_assign(block, value);
+        block->SetSsaPredValue(variable, value);
     }
 
     const IR::Value& Def(IR::Block* block, GotoVariable variable) {
@@ -84,40 +94,37 @@ struct DefTable {
     }
 
     const IR::Value& Def(IR::Block* block, ZeroFlagTag) {
-        return zero_flag[block];
+        return block->SsaFlagValue(ZeroFlagTag::INDEX);
     }
     void SetDef(IR::Block* block, ZeroFlagTag, const IR::Value& value) {
-        zero_flag.insert_or_assign(block, value);
+        block->SetSsaFlagValue(ZeroFlagTag::INDEX, value);
     }
 
     const IR::Value& Def(IR::Block* block, SignFlagTag) {
-        return sign_flag[block];
+        return block->SsaFlagValue(SignFlagTag::INDEX);
     }
     void SetDef(IR::Block* block, SignFlagTag, const IR::Value& value) {
-        sign_flag.insert_or_assign(block, value);
+        block->SetSsaFlagValue(SignFlagTag::INDEX, value);
     }
 
     const IR::Value& Def(IR::Block* block, CarryFlagTag) {
-        return carry_flag[block];
+        return block->SsaFlagValue(CarryFlagTag::INDEX);
     }
     void SetDef(IR::Block* block, CarryFlagTag, const IR::Value& value) {
-        carry_flag.insert_or_assign(block, value);
+        block->SetSsaFlagValue(CarryFlagTag::INDEX, value);
     }
 
     const IR::Value& Def(IR::Block* block, OverflowFlagTag) {
-        return overflow_flag[block];
+        return block->SsaFlagValue(OverflowFlagTag::INDEX);
     }
     void SetDef(IR::Block* block, OverflowFlagTag, const IR::Value& value) {
-        overflow_flag.insert_or_assign(block, value);
+        block->SetSsaFlagValue(OverflowFlagTag::INDEX, value);
     }
 
-    std::array<ValueMap, IR::NUM_USER_PREDS> preds;
+    // Registers, predicates and flags are stored intrusively in the blocks,
+    // only the rarely used structurization variables live in maps
     std::unordered_map<u32, ValueMap> goto_vars;
     ValueMap indirect_branch_var;
-    ValueMap zero_flag;
-    ValueMap sign_flag;
-    ValueMap carry_flag;
-    ValueMap overflow_flag;
 };
 
 IR::Opcode UndefOpcode(IR::Reg) noexcept {
@@ -194,7 +201,7 @@ public:
                     IR::Inst* phi{&*block->PrependNewInst(block->begin(), IR::Opcode::Phi)};
                     phi->SetFlags(IR::TypeOf(UndefOpcode(variable)));
 
-                    incomplete_phis[block].insert_or_assign(variable, phi);
+                    incomplete_phis[block].emplace_back(variable, phi);
                     stack.back().result = IR::Value{&*phi};
                 } else if (const std::span imm_preds = block->ImmPredecessors();
                            imm_preds.size() == 1) {
@@ -241,15 +248,42 @@ public:
     void SealBlock(IR::Block* block) {
         const auto it{incomplete_phis.find(block)};
         if (it != incomplete_phis.end()) {
-            for (auto& pair : it->second) {
-                auto& variant{pair.first};
-                auto& phi{pair.second};
-                std::visit([&](auto& variable) { AddPhiOperands(variable, *phi, block); }, variant);
+            // Reading the operands can insert into the map, take the phis out first
+            const auto phis{std::move(it->second)};
+            incomplete_phis.erase(it);
+            for (const auto& [variant, phi] : phis) {
+                std::visit([&](auto variable) { AddPhiOperands(variable, *phi, block); }, variant);
             }
         }
         block->SsaSeal();
     }
 
+    void RemoveTrivialPhis(IR::Program& program) {
+        // Removing a phi can make the phis using it trivial, iterate until nothing changes
+        boost::container::small_vector<IR::Inst*, 16> phis;
+        bool changed{true};
+        while (changed) {
+            changed = false;
+            for (IR::Block* const block : program.post_order_blocks) {
+                phis.clear();
+                for (IR::Inst& inst : *block) {
+                    if (!IR::IsPhi(inst)) {
+                        break;
+                    }
+                    phis.push_back(&inst);
+                }
+                for (IR::Inst* const phi : phis) {
+                    const std::optional<IR::Value> same{UniquePhiValue(*phi)};
+                    if (same && !same->IsEmpty()) {
+                        // The phi has a unique value, no undefined replacement is needed
+                        TryRemoveTrivialPhi(*phi, block, IR::Opcode::Void);
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
 private:
     template <typename Type>
     IR::Value AddPhiOperands(Type variable, IR::Inst& phi, IR::Block* block) {
@@ -259,7 +293,9 @@ private:
         return TryRemoveTrivialPhi(phi, block, UndefOpcode(variable));
     }
 
-    IR::Value TryRemoveTrivialPhi(IR::Inst& phi, IR::Block* block, IR::Opcode undef_opcode) {
+    /// Returns the only value merged by a phi, empty when it only references itself
+    /// and std::nullopt when it merges at least two values
+    static std::optional<IR::Value> UniquePhiValue(IR::Inst& phi) {
         IR::Value same;
         const size_t num_args{phi.NumArgs()};
         for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
@@ -269,11 +305,20 @@ private:
                 continue;
             }
             if (!same.IsEmpty()) {
-                // The phi merges at least two values: not trivial
-                return IR::Value{&phi};
+                return std::nullopt;
             }
             same = op;
         }
+        return same;
+    }
+
+    IR::Value TryRemoveTrivialPhi(IR::Inst& phi, IR::Block* block, IR::Opcode undef_opcode) {
+        std::optional<IR::Value> unique{UniquePhiValue(phi)};
+        if (!unique) {
+            // The phi merges at least two values: not trivial
+            return IR::Value{&phi};
+        }
+        IR::Value same{*unique};
         // Remove the phi node from the block, it will be reinserted
         IR::Block::InstructionList& list{block->Instructions()};
         list.erase(IR::Block::InstructionList::s_iterator_to(phi));
@@ -291,11 +336,13 @@ private:
         // Reinsert the phi node and reroute all its uses to the "same" value
         list.insert(reinsert_point, phi);
         phi.ReplaceUsesWith(same);
-        // TODO: Try to recursively remove all phi users, which might have become trivial
+        // Phi users that became trivial are removed by RemoveTrivialPhis after the rewrite
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    std::unordered_map<IR::Block*,
+                       boost::container::small_vector<std::pair<Variant, IR::Inst*>, 8>>
+        incomplete_phis;
     DefTable current_def;
 };
 
@@ -396,6 +443,7 @@ void SsaRewritePass(IR::Program& program) {
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
         VisitBlock(pass, *block);
     }
+    pass.RemoveTrivialPhis(program);
     for (auto block = program.post_order_blocks.rbegin(); block != end; ++block) {
         for (IR::Inst& inst : (*block)->Instructions()) {
             if (inst.GetOpcode() == IR::Opcode::Phi) {
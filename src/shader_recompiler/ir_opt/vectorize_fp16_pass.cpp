@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Maximum depth of the expression trees vectorized from a single composite
+constexpr int MAX_DEPTH{8};
+
+std::optional<IR::Opcode> PackedOpcode(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::FPAbs16:
+        return IR::Opcode::FPAbs16x2;
+    case IR::Opcode::FPAdd16:
+        return IR::Opcode::FPAdd16x2;
+    case IR::Opcode::FPFma16:
+        return IR::Opcode::FPFma16x2;
+    case IR::Opcode::FPMul16:
+        return IR::Opcode::FPMul16x2;
+    case IR::Opcode::FPNeg16:
+        return IR::Opcode::FPNeg16x2;
+    case IR::Opcode::FPSaturate16:
+        return IR::Opcode::FPSaturate16x2;
+    default:
+        return std::nullopt;
+    }
+}
+
+/// Returns true when two scalar instructions can be merged into one packed instruction
+bool IsPackablePair(const IR::Value& x, const IR::Value& y) {
+    if (x.IsImmediate() || y.IsImmediate()) {
+        return false;
+    }
+    const IR::Inst* const lhs{x.InstRecursive()};
+    const IR::Inst* const rhs{y.InstRecursive()};
+    // Scalars with other users would have to be computed twice
+    return lhs != rhs && lhs->GetOpcode() == rhs->GetOpcode() &&
+           PackedOpcode(lhs->GetOpcode()).has_value() && lhs->UseCount() == 1 &&
+           rhs->UseCount() == 1 && lhs->Flags<u32>() == rhs->Flags<u32>();
+}
+
+/// Returns the vector both lanes were extracted from, if they come from a single vector
+std::optional<IR::Value> SourceVector(const IR::Value& x, const IR::Value& y) {
+    if (x.IsImmediate() || y.IsImmediate()) {
+        return std::nullopt;
+    }
+    const IR::Inst* const lhs{x.InstRecursive()};
+    const IR::Inst* const rhs{y.InstRecursive()};
+    if (lhs->GetOpcode() != IR::Opcode::CompositeExtractF16x2 ||
+        rhs->GetOpcode() != IR::Opcode::CompositeExtractF16x2) {
+        return std::nullopt;
+    }
+    const IR::Value lhs_index{lhs->Arg(1)};
+    const IR::Value rhs_index{rhs->Arg(1)};
+    if (!lhs_index.IsImmediate() || !rhs_index.IsImmediate() || lhs_index.U32() != 0 ||
+        rhs_index.U32() != 1) {
+        return std::nullopt;
+    }
+    const IR::Value vector{lhs->Arg(0).Resolve()};
+    const IR::Value rhs_vector{rhs->Arg(0).Resolve()};
+    if (vector.IsImmediate() || rhs_vector.IsImmediate() ||
+        vector.InstRecursive() != rhs_vector.InstRecursive()) {
+        return std::nullopt;
+    }
+    return vector;
+}
+
+/// Builds a two component vector out of two scalar lanes, merging lanes computed by the same
+/// operation into packed instructions
+IR::Value Vectorize(IR::Block& block, IR::Block::iterator insert_point, const IR::Value& x,
+                    const IR::Value& y, int depth) {
+    const IR::Value lhs{x.Resolve()};
+    const IR::Value rhs{y.Resolve()};
+    if (const std::optional<IR::Value> vector{SourceVector(lhs, rhs)}) {
+        return *vector;
+    }
+    if (depth >= MAX_DEPTH || !IsPackablePair(lhs, rhs)) {
+        return IR::Value{&*block.PrependNewInst(insert_point, IR::Opcode::CompositeConstructF16x2,
+                                                {lhs, rhs})};
+    }
+    const IR::Inst* const lhs_inst{lhs.InstRecursive()};
+    const IR::Inst* const rhs_inst{rhs.InstRecursive()};
+    const IR::Opcode opcode{*PackedOpcode(lhs_inst->GetOpcode())};
+    const u32 flags{lhs_inst->Flags<u32>()};
+    switch (lhs_inst->NumArgs()) {
+    case 1:
+        return IR::Value{&*block.PrependNewInst(
+            insert_point, opcode,
+            {Vectorize(block, insert_point, lhs_inst->Arg(0), rhs_inst->Arg(0), depth + 1)},
+            flags)};
+    case 2: {
+        const IR::Value a{
+            Vectorize(block, insert_point, lhs_inst->Arg(0), rhs_inst->Arg(0), depth + 1)};
+        const IR::Value b{
+            Vectorize(block, insert_point, lhs_inst->Arg(1), rhs_inst->Arg(1), depth + 1)};
+        return IR::Value{&*block.PrependNewInst(insert_point, opcode, {a, b}, flags)};
+    }
+    case 3: {
+        const IR::Value a{
+            Vectorize(block, insert_point, lhs_inst->Arg(0), rhs_inst->Arg(0), depth + 1)};
+        const IR::Value b{
+            Vectorize(block, insert_point, lhs_inst->Arg(1), rhs_inst->Arg(1), depth + 1)};
+        const IR::Value c{
+            Vectorize(block, insert_point, lhs_inst->Arg(2), rhs_inst->Arg(2), depth + 1)};
+        return IR::Value{&*block.PrependNewInst(insert_point, opcode, {a, b, c}, flags)};
+    }
+    default:
+        throw LogicError("Invalid number of arguments {}", lhs_inst->NumArgs());
+    }
+}
+} // Anonymous namespace
+
+void VectorizeFp16Pass(IR::Program& program) {
+    for (IR::Block* const block : program.post_order_blocks) {
+        for (auto it = block->begin(); it != block->end(); ++it) {
+            IR::Inst& inst{*it};
+            if (inst.GetOpcode() != IR::Opcode::CompositeConstructF16x2) {
+                continue;
+            }
+            const IR::Value lhs{inst.Arg(0).Resolve()};
+            const IR::Value rhs{inst.Arg(1).Resolve()};
+            if (!IsPackablePair(lhs, rhs)) {
+                continue;
+            }
+            // Scalar lanes left without uses are removed by dead code elimination
+            inst.ReplaceUsesWith(Vectorize(*block, it, lhs, rhs, 0));
+        }
+    }
+}
+
+} // namespace Shader::Optimization
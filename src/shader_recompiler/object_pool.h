@@ -7,6 +7,8 @@
 #include <type_traits>
 #include <utility>
 
+#include "common/memory_usage.h"
+
 namespace Shader {
 
 template <typename T>
@@ -15,6 +17,7 @@ class ObjectPool {
 public:
     explicit ObjectPool(size_t chunk_size = 8192) : new_chunk_size{chunk_size} {
         node = &chunks.emplace_back(new_chunk_size);
+        memory_usage.Add(new_chunk_size * sizeof(Storage));
     }
 
     template <typename... Args>
@@ -39,6 +42,7 @@ public:
         }
         chunks.shrink_to_fit();
         node = &chunks.front();
+        memory_usage.Set(chunks.front().num_objects * sizeof(Storage));
     }
 
 private:
@@ -95,12 +99,14 @@ private:
             return node;
         }
         node = &chunks.emplace_back(new_chunk_size);
+        memory_usage.Add(new_chunk_size * sizeof(Storage));
         return node;
     }
 
     Chunk* node{};
     std::vector<Chunk> chunks;
     size_t new_chunk_size{};
+    Common::MemoryUsageCounter memory_usage{Common::MemoryUsageCategory::ShaderIR};
 };
 
 } // namespace Shader
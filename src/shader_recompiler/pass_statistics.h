@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Shader {
+
+/// Cost of each step of a translation, collected when requested by the caller
+struct PassStatistics {
+    struct Entry {
+        std::string_view name;
+        std::chrono::nanoseconds time;
+        size_t num_insts;       ///< IR instructions in the program after the pass
+        size_t num_allocations; ///< Heap allocations made by the pass
+    };
+
+    /// Optional counter of heap allocations, sampled before and after each pass
+    size_t (*allocation_count)(){};
+
+    std::vector<Entry> entries;
+};
+
+} // namespace Shader
@@ -47,6 +47,8 @@ struct Profile {
     bool support_geometry_streams{};
 
     bool warp_size_potentially_larger_than_guest{};
+    /// Bit mask of the stages the host runs with subgroups of exactly the guest warp size
+    u32 guest_warp_size_stages{};
 
     bool lower_left_origin_mode{};
     /// Fragment outputs have to be declared even if they are not written to avoid undefined values.
@@ -82,6 +82,8 @@ struct RuntimeInfo {
     bool y_negate{};
     /// Use storage buffers instead of global pointers on GLASM
     bool glasm_use_storage_buffers{};
+    /// Uniform buffer binding with bindless handles of sampled textures on GLSL
+    std::optional<u32> glsl_bindless_texture_binding;
 
     /// Transform feedback state for each varying
     std::array<TransformFeedbackVarying, 256> xfb_varyings{};
@@ -235,10 +235,24 @@ struct ImageDescriptor {
 };
 using ImageDescriptors = boost::container::small_vector<ImageDescriptor, 4>;
 
+/// Specialization constant ID that enables constant buffer specialization when true
+constexpr u32 CBUF_SPECIALIZATION_ENABLE_ID = 0;
+/// Specialization constant ID of the first specialized constant buffer value
+constexpr u32 CBUF_SPECIALIZATION_FIRST_VALUE_ID = 1;
+
+/// Constant buffer word read by control flow that can be specialized at pipeline creation
+struct SpecializedCbufDescriptor {
+    u32 index;
+    u32 offset;
+
+    auto operator<=>(const SpecializedCbufDescriptor&) const = default;
+};
+
 struct Info {
     static constexpr size_t MAX_INDIRECT_CBUFS{14};
     static constexpr size_t MAX_CBUFS{18};
     static constexpr size_t MAX_SSBOS{32};
+    static constexpr size_t MAX_SPECIALIZED_CBUFS{8};
 
     bool uses_workgroup_id{};
     bool uses_local_invocation_id{};
@@ -333,6 +347,8 @@ struct Info {
     ImageBufferDescriptors image_buffer_descriptors;
     TextureDescriptors texture_descriptors;
     ImageDescriptors image_descriptors;
+    boost::container::static_vector<SpecializedCbufDescriptor, MAX_SPECIALIZED_CBUFS>
+        specialized_cbufs;
 };
 
 template <typename Descriptors>
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/fixed_point.h"
+
+namespace AudioCore::Renderer::MixKernels {
+namespace {
+
+constexpr std::array Backends{Backend::Scalar, Backend::Sse41, Backend::Avx2, Backend::Neon};
+
+// Sample counts covering empty buffers, partial vectors and the usual 5ms frames.
+constexpr std::array<u32, 7> SampleCounts{0, 1, 3, 7, 17, 160, 240};
+
+// Volume and ramp pairs covering silence, unity, negative gains, steep ramps and volumes too
+// large for the vector kernels.
+constexpr std::array<std::pair<f32, f32>, 9> Volumes{{
+    {0.0f, 0.0f},
+    {1.0f, 0.0f},
+    {0.5f, 0.0f},
+    {-0.75f, 0.0f},
+    {0.0f, 1.0f / 240.0f},
+    {1.0f, -1.0f / 160.0f},
+    {0.3f, 0.0123f},
+    {200.0f, 0.5f},
+    {70000.0f, -3.0f},
+}};
+
+std::vector<s32> MakeSamples(std::mt19937& rng, u32 count) {
+    std::uniform_int_distribution<s32> distribution{std::numeric_limits<s32>::min(),
+                                                    std::numeric_limits<s32>::max()};
+    std::vector<s32> samples(count);
+    for (auto& sample : samples) {
+        // Mix in small samples too, so that rounding is exercised without overflowing.
+        sample = (rng() & 1) ? distribution(rng) : distribution(rng) >> 12;
+    }
+    return samples;
+}
+
+// The scalar FixedPoint implementations the kernels must match.
+template <size_t Q>
+s32 ReferenceMixRamp(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_,
+                     f32 ramp_, u32 sample_count) {
+    Common::FixedPoint<64 - Q, Q> volume{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    Common::FixedPoint<64 - Q, Q> sample{0};
+    for (u32 i = 0; i < sample_count; i++) {
+        sample = input[i] * volume;
+        output[i] = (output[i] + sample).to_int();
+        volume += ramp;
+    }
+    return sample.to_int();
+}
+
+template <size_t Q>
+void ReferenceVolumeRamp(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_,
+                         f32 ramp_, u32 sample_count) {
+    Common::FixedPoint<64 - Q, Q> volume{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    for (u32 i = 0; i < sample_count; i++) {
+        output[i] = (input[i] * volume).to_int();
+        volume += ramp;
+    }
+}
+
+template <size_t Q>
+void TestKernels() {
+    std::mt19937 rng{Q};
+    for (const auto backend : Backends) {
+        if (!IsSupported(backend)) {
+            continue;
+        }
+        for (const auto sample_count : SampleCounts) {
+            for (const auto& [volume, ramp] : Volumes) {
+                const auto input = MakeSamples(rng, sample_count);
+                const auto initial_output = MakeSamples(rng, sample_count);
+                const s64 raw_volume = Common::FixedPoint<64 - Q, Q>{volume}.to_raw();
+                const s64 raw_ramp = Common::FixedPoint<64 - Q, Q>{ramp}.to_raw();
+
+                auto expected = initial_output;
+                auto output = initial_output;
+                const s32 expected_last =
+                    ReferenceMixRamp<Q>(expected, input, volume, ramp, sample_count);
+                const s32 last =
+                    MixRamp<Q>(output, input, raw_volume, raw_ramp, sample_count, backend);
+                REQUIRE(output == expected);
+                REQUIRE(last == expected_last);
+
+                ReferenceVolumeRamp<Q>(expected, input, volume, ramp, sample_count);
+                VolumeRamp<Q>(output, input, raw_volume, raw_ramp, sample_count, backend);
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MixKernels: Q15 matches FixedPoint", "[audio_core]") {
+    TestKernels<15>();
+}
+
+TEST_CASE("MixKernels: Q23 matches FixedPoint", "[audio_core]") {
+    TestKernels<23>();
+}
+
+TEST_CASE("MixKernels: In-place mixing", "[audio_core]") {
+    constexpr u32 SampleCount = 37;
+    std::mt19937 rng{0};
+    for (const auto backend : Backends) {
+        if (!IsSupported(backend)) {
+            continue;
+        }
+        const auto initial = MakeSamples(rng, SampleCount);
+        auto expected = initial;
+        const auto expected_input = initial;
+        const s32 expected_last =
+            ReferenceMixRamp<15>(expected, expected_input, 0.8f, -0.01f, SampleCount);
+
+        auto buffer = initial;
+        const s32 last = MixRamp<15>(buffer, buffer, Common::FixedPoint<49, 15>{0.8f}.to_raw(),
+                                     Common::FixedPoint<49, 15>{-0.01f}.to_raw(), SampleCount,
+                                     backend);
+        REQUIRE(buffer == expected);
+        REQUIRE(last == expected_last);
+    }
+}
+
+} // namespace AudioCore::Renderer::MixKernels
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer::MixKernels {
+namespace {
+
+constexpr std::array<std::pair<Backend, const char*>, 4> Backends{{
+    {Backend::Scalar, "scalar"},
+    {Backend::Sse41, "SSE4.1"},
+    {Backend::Avx2, "AVX2"},
+    {Backend::Neon, "NEON"},
+}};
+
+// One 5ms frame at 48kHz, what every mix command processes
+constexpr u32 SampleCount = 240;
+
+// Half volume ramping down over the frame, in Q15
+constexpr s64 Volume = 1 << 14;
+constexpr s64 Ramp = -(1 << 14) / SampleCount;
+
+} // Anonymous namespace
+
+TEST_CASE("Audio benchmark: mix kernels", "[audio_core][.benchmark]") {
+    std::mt19937 rng{0x5eed};
+    std::vector<s32> input(SampleCount);
+    for (s32& sample : input) {
+        sample = static_cast<s32>(rng()) >> 8;
+    }
+    std::vector<s32> output(SampleCount);
+
+    for (const auto& [backend, name] : Backends) {
+        if (!IsSupported(backend)) {
+            continue;
+        }
+        BENCHMARK(std::string("MixRamp ") + name) {
+            return MixRamp<15>(output, input, Volume, Ramp, SampleCount, backend);
+        };
+        BENCHMARK(std::string("VolumeRamp ") + name) {
+            VolumeRamp<15>(output, input, Volume, Ramp, SampleCount, backend);
+            return output[0];
+        };
+    }
+}
+
+} // namespace AudioCore::Renderer::MixKernels
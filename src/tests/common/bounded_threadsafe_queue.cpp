@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+
+namespace {
+constexpr size_t NumItems = 1 << 16;
+constexpr size_t BatchSize = 32;
+
+/// The previous MPMC queue, kept to compare against a single queue guarded by locks
+template <typename T>
+class LockedMPMCQueue {
+public:
+    void EmplaceWait(T t) {
+        std::scoped_lock lock{write_mutex};
+        queue.EmplaceWait(t);
+    }
+
+    void PopWait(T& t) {
+        std::scoped_lock lock{read_mutex};
+        queue.PopWait(t);
+    }
+
+private:
+    Common::SPSCQueue<T> queue;
+    std::mutex write_mutex;
+    std::mutex read_mutex;
+};
+
+/// Pushes NumItems values from the producers and pops them from the consumers, returning the
+/// sum of the popped values.
+template <typename Queue, bool Batched = false>
+u64 Transfer(Queue& queue, size_t num_producers, size_t num_consumers) {
+    std::vector<u64> sums(num_consumers);
+    std::vector<std::jthread> threads;
+    for (size_t producer = 0; producer < num_producers; ++producer) {
+        threads.emplace_back([&queue, producer, num_producers] {
+            for (size_t i = producer; i < NumItems; i += num_producers) {
+                queue.EmplaceWait(static_cast<u64>(i));
+            }
+        });
+    }
+    for (size_t consumer = 0; consumer < num_consumers; ++consumer) {
+        threads.emplace_back([&queue, &sums, consumer, num_consumers] {
+            const size_t num_pops = NumItems / num_consumers;
+            u64 sum = 0;
+            if constexpr (Batched) {
+                std::array<u64, BatchSize> values;
+                for (size_t popped = 0; popped < num_pops;) {
+                    const size_t max = std::min(BatchSize, num_pops - popped);
+                    const size_t count = queue.PopBatchWait(std::span(values.data(), max));
+                    sum = std::accumulate(values.begin(), values.begin() + count, sum);
+                    popped += count;
+                }
+            } else {
+                for (size_t popped = 0; popped < num_pops; ++popped) {
+                    u64 value;
+                    queue.PopWait(value);
+                    sum += value;
+                }
+            }
+            sums[consumer] = sum;
+        });
+    }
+    threads.clear();
+    return std::accumulate(sums.begin(), sums.end(), u64{0});
+}
+
+constexpr u64 ExpectedSum = u64{NumItems} * (NumItems - 1) / 2;
+
+std::string Name(const char* queue, size_t num_producers, size_t num_consumers) {
+    return std::string(queue) + " " + std::to_string(num_producers) + "P" +
+           std::to_string(num_consumers) + "C";
+}
+} // Anonymous namespace
+
+TEST_CASE("MPMCQueue: Single thread", "[common]") {
+    Common::MPMCQueue<int, 4> queue;
+    int value{};
+    REQUIRE(!queue.TryPop(value));
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryEmplace(i));
+    }
+    REQUIRE(!queue.TryEmplace(4));
+
+    std::array<int, 3> values{};
+    REQUIRE(queue.TryPopBatch(values) == 3);
+    REQUIRE(values == std::array{0, 1, 2});
+    REQUIRE(queue.TryEmplace(4));
+    REQUIRE(queue.TryPopBatch(values) == 2);
+    REQUIRE(values[0] == 3);
+    REQUIRE(values[1] == 4);
+    REQUIRE(!queue.TryPop(value));
+}
+
+TEST_CASE("MPMCQueue: Every value is popped once", "[common]") {
+    for (const bool batched : {false, true}) {
+        const auto queue = std::make_unique<Common::MPMCQueue<u64, 256>>();
+        const u64 sum = batched ? Transfer<Common::MPMCQueue<u64, 256>, true>(*queue, 4, 4)
+                                : Transfer(*queue, 4, 4);
+        REQUIRE(sum == ExpectedSum);
+    }
+}
+
+TEST_CASE("MPMCQueue: Stop token wakes a waiting consumer", "[common]") {
+    Common::MPMCQueue<int, 4> queue;
+    std::stop_source stop_source;
+    std::jthread consumer([&] {
+        std::array<int, 4> values;
+        REQUIRE(queue.PopBatchWait(values, stop_source.get_token()) == 0);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    stop_source.request_stop();
+}
+
+// Each benchmark moves NumItems values through a queue, so the reported mean is the time to
+// transfer all of them. Run them with `tests "[.benchmark]"`.
+
+TEST_CASE("Queue benchmark: bounded queues", "[common][.benchmark]") {
+    BENCHMARK(Name("SPSCQueue", 1, 1)) {
+        const auto queue = std::make_unique<Common::SPSCQueue<u64>>();
+        return Transfer(*queue, 1, 1);
+    };
+    for (const size_t num_producers : {1, 4}) {
+        BENCHMARK(Name("MPSCQueue", num_producers, 1)) {
+            const auto queue = std::make_unique<Common::MPSCQueue<u64>>();
+            return Transfer(*queue, num_producers, 1);
+        };
+    }
+    for (const auto& [num_producers, num_consumers] :
+         {std::pair<size_t, size_t>{1, 1}, {4, 1}, {1, 4}, {4, 4}}) {
+        BENCHMARK(Name("LockedMPMCQueue", num_producers, num_consumers)) {
+            const auto queue = std::make_unique<LockedMPMCQueue<u64>>();
+            return Transfer(*queue, num_producers, num_consumers);
+        };
+        BENCHMARK(Name("MPMCQueue", num_producers, num_consumers)) {
+            const auto queue = std::make_unique<Common::MPMCQueue<u64>>();
+            return Transfer(*queue, num_producers, num_consumers);
+        };
+        BENCHMARK(Name("MPMCQueue batched", num_producers, num_consumers)) {
+            const auto queue = std::make_unique<Common::MPMCQueue<u64>>();
+            return Transfer<Common::MPMCQueue<u64>, true>(*queue, num_producers, num_consumers);
+        };
+    }
+}
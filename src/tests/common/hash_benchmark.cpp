@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/hash.h"
+
+// Each benchmark hashes a single buffer, so the reported mean is the time per hash.
+// Run them with `tests "[.benchmark]"`.
+
+TEST_CASE("Hash benchmark: CityHash64 against RuntimeHash64", "[common][.benchmark]") {
+    // A pipeline key, a shader page and a decoded video frame plane
+    static constexpr std::size_t SIZES[] = {64, 4096, 1920 * 1080};
+
+    std::mt19937 rng{0};
+    std::vector<char> data(SIZES[std::size(SIZES) - 1]);
+    for (char& value : data) {
+        value = static_cast<char>(rng());
+    }
+    for (const std::size_t size : SIZES) {
+        BENCHMARK("CityHash64 " + std::to_string(size) + " bytes") {
+            return Common::CityHash64(data.data(), size);
+        };
+        BENCHMARK("RuntimeHash64 " + std::to_string(size) + " bytes") {
+            return Common::RuntimeHash64(data.data(), size);
+        };
+    }
+}
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/multi_level_page_table.h"
+#include "common/page_table.h"
+
+namespace {
+// Same layout as the GPU page table with 4 KiB pages
+constexpr size_t AddressSpaceBits = 40;
+constexpr size_t PageBits = 12;
+constexpr size_t FirstLevelBits = AddressSpaceBits + PageBits - 38;
+constexpr u64 LevelSize = 1ULL << (AddressSpaceBits - FirstLevelBits);
+} // Anonymous namespace
+
+TEST_CASE("MultiLevelPageTable: Reserving commits the covered sub-tables", "[common]") {
+    Common::MultiLevelPageTable<u32> table(AddressSpaceBits, FirstLevelBits, PageBits);
+    const auto before = Common::GetMultiLevelPageTableStatistics();
+
+    table.ReserveRange(0, LevelSize);
+    REQUIRE(table.NumCommittedLevels() == 1);
+    table.ReserveRange(LevelSize - 0x1000, 0x2000);
+    REQUIRE(table.NumCommittedLevels() == 2);
+
+    const auto after = Common::GetMultiLevelPageTableStatistics();
+    REQUIRE(after.committed_levels == before.committed_levels + 2);
+    REQUIRE(after.committed_bytes == before.committed_bytes + table.CommittedBytes());
+}
+
+TEST_CASE("MultiLevelPageTable: Compact tables free unused sub-tables", "[common]") {
+    Common::MultiLevelPageTable<u32> table(AddressSpaceBits, FirstLevelBits, PageBits, true);
+    const u64 address = 3 * LevelSize;
+    const size_t first_index = address >> PageBits;
+
+    table.ReserveRange(address, 0x3000);
+    for (size_t i = 0; i < 3; ++i) {
+        table[first_index + i] = static_cast<u32>(i + 1);
+        table.MarkUsed(first_index + i);
+    }
+    REQUIRE(table.NumCommittedLevels() == 1);
+
+    table.MarkUnused(first_index);
+    table.MarkUnused(first_index + 1);
+    REQUIRE(table.NumCommittedLevels() == 1);
+    REQUIRE(table[first_index + 2] == 3);
+
+    table.MarkUnused(first_index + 2);
+    REQUIRE(table.NumCommittedLevels() == 0);
+
+    // Reserving the range again gives back a zeroed sub-table
+    table.ReserveRange(address, 0x1000);
+    REQUIRE(table.NumCommittedLevels() == 1);
+    REQUIRE(table[first_index + 2] == 0);
+}
+
+// Each benchmark translates NumLookups pages, so the reported mean is the time for all of them.
+// Run them with `tests "[.benchmark]"`.
+
+TEST_CASE("Page table benchmark: translation", "[common][.benchmark]") {
+    static constexpr size_t NumPages = 1 << 16;
+    static constexpr size_t NumLookups = 1 << 20;
+
+    Common::MultiLevelPageTable<u32> gpu_table(AddressSpaceBits, FirstLevelBits, PageBits, true);
+    gpu_table.ReserveRange(0, NumPages << PageBits);
+    Common::PageTable process_table;
+    process_table.Resize(39, PageBits);
+    for (size_t page = 0; page < NumPages; ++page) {
+        gpu_table[page] = static_cast<u32>(page);
+        gpu_table.MarkUsed(page);
+        process_table.pointers[page].Store(page << PageBits, Common::PageType::Memory);
+    }
+
+    std::mt19937 rng{0};
+    std::vector<u32> random_pages(NumLookups);
+    for (u32& page : random_pages) {
+        page = static_cast<u32>(rng() % NumPages);
+    }
+
+    BENCHMARK("MultiLevelPageTable sequential") {
+        u64 sum = 0;
+        for (size_t i = 0; i < NumLookups; ++i) {
+            sum += gpu_table[i % NumPages];
+        }
+        return sum;
+    };
+    BENCHMARK("MultiLevelPageTable random") {
+        u64 sum = 0;
+        for (const u32 page : random_pages) {
+            sum += gpu_table[page];
+        }
+        return sum;
+    };
+    BENCHMARK("PageTable random") {
+        u64 sum = 0;
+        for (const u32 page : random_pages) {
+            sum += process_table.pointers[page].Pointer();
+        }
+        return sum;
+    };
+}
@@ -25,4 +25,17 @@ TEST_CASE("ParamPackage", "[common]") {
     REQUIRE(copy.Get("abc", 42) == 42);
 }
 
+TEST_CASE("ParamPackage::Parse", "[common]") {
+    Common::Log::DisableLoggingInTests();
+    const ParamPackage package{"engine:sdl,port:1,button:3,"};
+    REQUIRE(package.Get("engine", "") == "sdl");
+    REQUIRE(package.Get("port", 0) == 1);
+    REQUIRE(package.Get("button", 0) == 3);
+    REQUIRE(ParamPackage{"engine:sdl,button:3"}.Serialize() == "button:3,engine:sdl");
+
+    // Malformed pairs are skipped
+    const ParamPackage malformed{"engine:sdl,button,axis:,,motion:0:1,port:2"};
+    REQUIRE(malformed.Serialize() == "engine:sdl,port:2");
+}
+
 } // namespace Common
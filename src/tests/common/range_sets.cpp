@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/range_sets.h"
+#include "common/range_sets.inc"
+
+namespace {
+using Ranges = std::vector<std::pair<u64, u64>>;
+using Segments = std::vector<std::tuple<u64, u64, s32>>;
+
+Ranges GetRanges(const Common::RangeSet<u64>& set) {
+    Ranges ranges;
+    set.ForEach([&](u64 begin, u64 end) { ranges.emplace_back(begin, end); });
+    return ranges;
+}
+
+Segments GetSegments(const Common::OverlapRangeSet<u64>& set) {
+    Segments segments;
+    set.ForEach([&](u64 begin, u64 end, s32 count) { segments.emplace_back(begin, end, count); });
+    return segments;
+}
+} // Anonymous namespace
+
+TEST_CASE("RangeSet: Add joins overlapping and adjacent ranges", "[common]") {
+    Common::RangeSet<u64> set;
+    set.Add(0x1000, 0x100);
+    set.Add(0x3000, 0x100);
+    set.Add(0x1100, 0x100);
+    REQUIRE(GetRanges(set) == Ranges{{0x1000, 0x1200}, {0x3000, 0x3100}});
+
+    set.Add(0x1180, 0x2000);
+    REQUIRE(GetRanges(set) == Ranges{{0x1000, 0x3180}});
+
+    set.Add(0x500, 0);
+    REQUIRE(GetRanges(set) == Ranges{{0x1000, 0x3180}});
+}
+
+TEST_CASE("RangeSet: Subtract splits ranges", "[common]") {
+    Common::RangeSet<u64> set;
+    set.Add(0x1000, 0x1000);
+    set.Subtract(0x1400, 0x100);
+    REQUIRE(GetRanges(set) == Ranges{{0x1000, 0x1400}, {0x1500, 0x2000}});
+
+    set.Subtract(0x0, 0x1200);
+    set.Subtract(0x1F00, 0x1000);
+    REQUIRE(GetRanges(set) == Ranges{{0x1200, 0x1400}, {0x1500, 0x1F00}});
+
+    Ranges clipped;
+    set.ForEachInRange(0x1300, 0x300,
+                       [&](u64 begin, u64 end) { clipped.emplace_back(begin, end); });
+    REQUIRE(clipped == Ranges{{0x1300, 0x1400}, {0x1500, 0x1600}});
+
+    set.Subtract(0x1000, 0x1000);
+    REQUIRE(set.Empty());
+}
+
+TEST_CASE("RangeSet: Subtract another set", "[common]") {
+    Common::RangeSet<u64> set;
+    set.Add(0x1000, 0x1000);
+    set.Add(0x3000, 0x1000);
+
+    Common::RangeSet<u64> other;
+    other.Add(0x800, 0x900);
+    other.Add(0x1800, 0x100);
+    other.Add(0x1F00, 0x1200);
+    set.Subtract(other);
+    REQUIRE(GetRanges(set) == Ranges{{0x1100, 0x1800}, {0x1900, 0x1F00}, {0x3100, 0x4000}});
+}
+
+TEST_CASE("OverlapRangeSet: Counts overlapping ranges", "[common]") {
+    Common::OverlapRangeSet<u64> set;
+    set.Add(0x1000, 0x200);
+    set.Add(0x1100, 0x200);
+    REQUIRE(GetSegments(set) ==
+            Segments{{0x1000, 0x1100, 1}, {0x1100, 0x1200, 2}, {0x1200, 0x1300, 1}});
+
+    std::vector<std::pair<u64, u64>> deleted;
+    set.Subtract(0x1000, 0x300, [&](u64 begin, u64 end) { deleted.emplace_back(begin, end); });
+    REQUIRE(deleted == Ranges{{0x1000, 0x1100}, {0x1200, 0x1300}});
+    REQUIRE(GetSegments(set) == Segments{{0x1100, 0x1200, 1}});
+
+    set.Add(0x1100, 0x100);
+    set.DeleteAll(0x1000, 0x1000);
+    REQUIRE(set.Empty());
+}
@@ -197,4 +197,32 @@ TEST_CASE("ScratchBuffer: Span Writes", "[common]") {
     }
 }
 
+TEST_CASE("ScratchBuffer: Pooled buffers are reused", "[common]") {
+    const u8* first_data{};
+    {
+        PooledScratchBuffer<u8> buf;
+        buf.resize_destructive(1000);
+        REQUIRE(buf.size() == 1000U);
+        REQUIRE(buf.capacity() == 4096U);
+        first_data = buf.data();
+
+        buf[999] = 66;
+        buf.resize(5000);
+        REQUIRE(buf.capacity() == 8192U);
+        REQUIRE(buf[999] == 66);
+    }
+    const auto before = ScratchPool::GetStatistics();
+    {
+        // Both blocks went back to this thread's pool, the smallest one is borrowed again
+        PooledScratchBuffer<u32> buf;
+        buf.resize_destructive(100);
+        REQUIRE(reinterpret_cast<const u8*>(buf.data()) == first_data);
+        REQUIRE(ScratchPool::GetStatistics().live_bytes == before.live_bytes + 4096);
+    }
+    const auto after = ScratchPool::GetStatistics();
+    REQUIRE(after.heap_allocations == before.heap_allocations);
+    REQUIRE(after.live_bytes == before.live_bytes);
+    REQUIRE(after.peak_live_bytes >= 4096U + 8192U);
+}
+
 } // namespace Common
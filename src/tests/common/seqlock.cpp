@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "common/seqlock.h"
+
+namespace Common {
+
+TEST_CASE("SeqLock: Basic Tests", "[common]") {
+    SeqLock<std::array<u32, 3>> lock;
+    REQUIRE(lock.Load() == std::array<u32, 3>{});
+
+    lock.Store({1, 2, 3});
+    REQUIRE(lock.Load() == std::array<u32, 3>{1, 2, 3});
+}
+
+TEST_CASE("SeqLock: Threaded Test", "[common]") {
+    // Every stored value has all its elements equal, so a torn read would show up as a mismatch
+    SeqLock<std::array<u64, 8>> lock;
+    constexpr u64 count = 100000;
+
+    std::thread producer{[&] {
+        for (u64 i = 1; i <= count; ++i) {
+            std::array<u64, 8> value;
+            value.fill(i);
+            lock.Store(value);
+        }
+    }};
+
+    u64 last = 0;
+    while (last != count) {
+        const auto value = lock.Load();
+        for (const u64 element : value) {
+            REQUIRE(element == value[0]);
+        }
+        REQUIRE(value[0] >= last);
+        last = value[0];
+    }
+    producer.join();
+}
+
+} // namespace Common
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/thread_pool.h"
+
+TEST_CASE("ThreadPool: Wait runs every task", "[common]") {
+    Common::ThreadPool pool(4);
+    std::atomic<int> count{};
+    Common::TaskGroup group(Common::TaskPriority::Background, pool);
+    for (int i = 0; i < 1000; ++i) {
+        group.Run([&count] { ++count; });
+    }
+    group.Wait();
+    REQUIRE(count == 1000);
+}
+
+TEST_CASE("ThreadPool: Nested groups do not deadlock", "[common]") {
+    // A single worker has to help with the inner tasks while it waits for them
+    Common::ThreadPool pool(1);
+    std::atomic<int> count{};
+    Common::TaskGroup outer(Common::TaskPriority::Interactive, pool);
+    for (int i = 0; i < 8; ++i) {
+        outer.Run([&pool, &count] {
+            Common::TaskGroup inner(Common::TaskPriority::Interactive, pool);
+            for (int j = 0; j < 8; ++j) {
+                inner.Run([&count] { ++count; });
+            }
+            inner.Wait();
+        });
+    }
+    outer.Wait();
+    REQUIRE(count == 64);
+}
+
+TEST_CASE("ThreadPool: Cancel drops tasks that have not started", "[common]") {
+    Common::ThreadPool pool(1);
+    std::atomic_bool release{};
+    std::atomic<int> count{};
+    Common::TaskGroup blocker(Common::TaskPriority::Background, pool);
+    blocker.Run([&release] {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    });
+    {
+        Common::TaskGroup group(Common::TaskPriority::Idle, pool);
+        for (int i = 0; i < 16; ++i) {
+            group.Run([&count] { ++count; });
+        }
+        group.Cancel();
+        release = true;
+    }
+    blocker.Wait();
+    REQUIRE(count == 0);
+}
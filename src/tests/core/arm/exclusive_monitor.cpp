@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/arm/cas_exclusive_monitor.h"
+
+namespace {
+constexpr std::size_t NUM_CORES = 4;
+constexpr VAddr BASE = 0x1000;
+
+struct GuestWord {
+    std::atomic<u32> value{};
+};
+
+u32 Load(Core::ExclusiveReservations& reservations, std::size_t core, VAddr addr,
+         GuestWord& word) {
+    return reservations.ReadAndMark<u32>(core, addr, [&] { return word.value.load(); });
+}
+
+bool Store(Core::ExclusiveReservations& reservations, std::size_t core, VAddr addr,
+           GuestWord& word, u32 value) {
+    return reservations.DoExclusiveOperation<u32>(core, addr, [&](u32 expected) {
+        return word.value.compare_exchange_strong(expected, value);
+    });
+}
+} // Anonymous namespace
+
+TEST_CASE("ExclusiveReservations: Store without reservation fails", "[core]") {
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    GuestWord word;
+    REQUIRE(!Store(reservations, 0, BASE, word, 1));
+
+    Load(reservations, 0, BASE, word);
+    reservations.Clear(0);
+    REQUIRE(!Store(reservations, 0, BASE, word, 1));
+    REQUIRE(word.value == 0);
+}
+
+TEST_CASE("ExclusiveReservations: Store consumes the reservation", "[core]") {
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    GuestWord word;
+    Load(reservations, 0, BASE, word);
+    REQUIRE(Store(reservations, 0, BASE, word, 1));
+    REQUIRE(!Store(reservations, 0, BASE, word, 2));
+    REQUIRE(word.value == 1);
+}
+
+TEST_CASE("ExclusiveReservations: Store drops reservations of other cores", "[core]") {
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    std::array<GuestWord, 2> words;
+    static constexpr VAddr OTHER = BASE + 0x40;
+
+    Load(reservations, 0, BASE, words[0]);
+    Load(reservations, 1, BASE + 4, words[0]);
+    Load(reservations, 2, OTHER, words[1]);
+    REQUIRE(Store(reservations, 0, BASE, words[0], 1));
+
+    // Core 1 reserved the same granule, core 2 a different one
+    REQUIRE(!Store(reservations, 1, BASE + 4, words[0], 2));
+    REQUIRE(Store(reservations, 2, OTHER, words[1], 3));
+    REQUIRE(words[0].value == 1);
+    REQUIRE(words[1].value == 3);
+}
+
+TEST_CASE("ExclusiveReservations: Concurrent increments", "[core]") {
+    static constexpr u32 INCREMENTS = 100000;
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    GuestWord counter;
+
+    std::vector<std::jthread> threads;
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        threads.emplace_back([&, core] {
+            for (u32 i = 0; i < INCREMENTS; ++i) {
+                u32 value;
+                do {
+                    value = Load(reservations, core, BASE, counter);
+                } while (!Store(reservations, core, BASE, counter, value + 1));
+            }
+        });
+    }
+    threads.clear();
+    REQUIRE(counter.value == NUM_CORES * INCREMENTS);
+}
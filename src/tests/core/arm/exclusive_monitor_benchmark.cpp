@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+#include <dynarmic/interface/exclusive_monitor.h>
+#endif
+
+#include "common/common_types.h"
+#include "core/arm/cas_exclusive_monitor.h"
+
+namespace {
+constexpr std::size_t NUM_CORES = 4;
+constexpr u32 INCREMENTS = 10000;
+constexpr VAddr BASE = 0x1000;
+
+/// Increments a counter from every core with exclusive load/store loops, on the same granule
+/// when contended and on separate cache lines otherwise
+template <typename Monitor>
+u32 IncrementCounters(Monitor& monitor, bool contended) {
+    std::array<std::atomic<u32>, NUM_CORES * 16> memory{};
+    std::vector<std::jthread> threads;
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        threads.emplace_back([&, core] {
+            const std::size_t index = contended ? 0 : core * 16;
+            const VAddr addr = BASE + index * sizeof(u32);
+            std::atomic<u32>& word = memory[index];
+            for (u32 i = 0; i < INCREMENTS; ++i) {
+                u32 value;
+                do {
+                    value = monitor.template ReadAndMark<u32>(core, addr,
+                                                              [&] { return word.load(); });
+                } while (!monitor.template DoExclusiveOperation<u32>(
+                    core, addr, [&](u32 expected) {
+                        return word.compare_exchange_strong(expected, value + 1);
+                    }));
+            }
+        });
+    }
+    threads.clear();
+    return memory[0].load();
+}
+} // Anonymous namespace
+
+// Each benchmark runs NUM_CORES * INCREMENTS exclusive increments.
+// Run them with `tests "[.benchmark]"`.
+
+TEST_CASE("ExclusiveMonitor benchmark: Exclusive increments", "[core][.benchmark]") {
+    Core::ExclusiveReservations reservations{NUM_CORES};
+    BENCHMARK("CAS reservations, contended") {
+        return IncrementCounters(reservations, true);
+    };
+    BENCHMARK("CAS reservations, uncontended") {
+        return IncrementCounters(reservations, false);
+    };
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_arm64)
+    Dynarmic::ExclusiveMonitor dynarmic_monitor{NUM_CORES};
+    BENCHMARK("Dynarmic monitor, contended") {
+        return IncrementCounters(dynarmic_monitor, true);
+    };
+    BENCHMARK("Dynarmic monitor, uncontended") {
+        return IncrementCounters(dynarmic_monitor, false);
+    };
+#endif
+}
@@ -9,10 +9,14 @@
 #include <cstdlib>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/timer_wheel.h"
 
 namespace {
 // Numbers are chosen randomly to make sure the correct one is given.
@@ -139,3 +143,45 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[TimerWheelOrder]", "[core]") {
+    using Core::Timing::TimerWheel;
+
+    // Spread events from the finest slot up to beyond the range of the wheel
+    std::mt19937_64 rng{0x5eed};
+    std::vector<TimerWheel::Node> nodes(4096);
+    TimerWheel wheel;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        const u32 magnitude = static_cast<u32>(rng() % 40);
+        nodes[i].time = static_cast<s64>(rng() & ((1ULL << magnitude) - 1));
+        nodes[i].fifo_order = i;
+        wheel.Insert(nodes[i]);
+    }
+    for (std::size_t i = 0; i < nodes.size(); i += 3) {
+        wheel.Remove(nodes[i]);
+    }
+    REQUIRE(wheel.Size() == nodes.size() - (nodes.size() + 2) / 3);
+
+    std::size_t popped = 0;
+    s64 last_time = -1;
+    u64 last_fifo = 0;
+    while (TimerWheel::Node* const node = wheel.Earliest()) {
+        REQUIRE(std::tie(node->time, node->fifo_order) > std::tie(last_time, last_fifo));
+        REQUIRE(node->fifo_order % 3 != 0);
+        last_time = node->time;
+        last_fifo = node->fifo_order;
+        wheel.Remove(*node);
+        ++popped;
+    }
+    REQUIRE(popped == nodes.size() - (nodes.size() + 2) / 3);
+    REQUIRE(wheel.Empty());
+
+    // Events scheduled behind the cursor are still returned first
+    nodes[0].time = 0;
+    nodes[0].fifo_order = 1;
+    nodes[1].time = 1LL << 30;
+    nodes[1].fifo_order = 0;
+    wheel.Insert(nodes[0]);
+    wheel.Insert(nodes[1]);
+    REQUIRE(wheel.Earliest() == &nodes[0]);
+}
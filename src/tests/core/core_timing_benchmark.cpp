@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <boost/heap/fibonacci_heap.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/timer_wheel.h"
+
+namespace {
+using Core::Timing::TimerWheel;
+
+// Number of events kept pending, roughly what a running title keeps scheduled
+constexpr std::size_t NUM_EVENTS = 256;
+
+struct HeapEvent {
+    s64 time;
+    u64 fifo_order;
+
+    friend bool operator>(const HeapEvent& left, const HeapEvent& right) {
+        return left.time != right.time ? left.time > right.time
+                                       : left.fifo_order > right.fifo_order;
+    }
+};
+
+using Heap = boost::heap::fibonacci_heap<HeapEvent, boost::heap::compare<std::greater<>>>;
+
+std::vector<s64> MakeDelays() {
+    // Mix of sub microsecond, frame and multi second delays
+    std::mt19937_64 rng{0x5eed};
+    std::vector<s64> delays(NUM_EVENTS);
+    for (s64& delay : delays) {
+        delay = static_cast<s64>(rng() % (1ULL << (10 + rng() % 24)));
+    }
+    return delays;
+}
+} // Anonymous namespace
+
+// Each benchmark runs a single operation, so the reported mean is the time per operation.
+// Run them with `tests "[.benchmark]"`.
+
+TEST_CASE("CoreTiming benchmark: Fire and reschedule", "[core][.benchmark]") {
+    const std::vector<s64> delays = MakeDelays();
+    std::size_t next_delay = 0;
+    u64 fifo = 0;
+
+    std::vector<TimerWheel::Node> nodes(NUM_EVENTS);
+    TimerWheel wheel;
+    for (TimerWheel::Node& node : nodes) {
+        node.time = delays[next_delay++ % NUM_EVENTS];
+        node.fifo_order = fifo++;
+        wheel.Insert(node);
+    }
+    Heap heap;
+    for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+        heap.push(HeapEvent{delays[i], fifo++});
+    }
+
+    BENCHMARK("Timer wheel") {
+        TimerWheel::Node* const node = wheel.Earliest();
+        wheel.Remove(*node);
+        node->time += delays[next_delay++ % NUM_EVENTS];
+        node->fifo_order = fifo++;
+        wheel.Insert(*node);
+        return node->time;
+    };
+    BENCHMARK("Fibonacci heap") {
+        HeapEvent event = heap.top();
+        heap.pop();
+        event.time += delays[next_delay++ % NUM_EVENTS];
+        event.fifo_order = fifo++;
+        heap.push(event);
+        return event.time;
+    };
+}
+
+TEST_CASE("CoreTiming benchmark: Unschedule", "[core][.benchmark]") {
+    const std::vector<s64> delays = MakeDelays();
+    std::size_t next_event = 0;
+    u64 fifo = 0;
+
+    // The wheel unlinks the node directly, the heap has to search for it first
+    std::vector<TimerWheel::Node> nodes(NUM_EVENTS);
+    TimerWheel wheel;
+    for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+        nodes[i].time = delays[i];
+        nodes[i].fifo_order = fifo++;
+        wheel.Insert(nodes[i]);
+    }
+    Heap heap;
+    for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+        heap.push(HeapEvent{delays[i], i});
+    }
+
+    BENCHMARK("Timer wheel") {
+        TimerWheel::Node& node = nodes[next_event++ % NUM_EVENTS];
+        wheel.Remove(node);
+        node.fifo_order = fifo++;
+        wheel.Insert(node);
+        return wheel.Size();
+    };
+    BENCHMARK("Fibonacci heap") {
+        const u64 target = next_event++ % NUM_EVENTS;
+        for (auto it = heap.begin(); it != heap.end(); ++it) {
+            if (it->fifo_order % NUM_EVENTS == target) {
+                HeapEvent event = *it;
+                heap.erase(Heap::s_handle_from_iterator(it));
+                event.fifo_order += NUM_EVENTS;
+                heap.push(event);
+                break;
+            }
+        }
+        return heap.size();
+    };
+}
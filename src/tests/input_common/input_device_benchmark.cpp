@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/input.h"
+#include "common/param_package.h"
+#include "input_common/input_engine.h"
+#include "input_common/input_poller.h"
+
+namespace {
+constexpr char Guid[] = "030000005e0400008e02000014010000";
+
+/// Bindings of a pro controller mapped to a gamepad, like the settings store them
+std::vector<std::string> ControllerBindings() {
+    std::vector<std::string> bindings;
+    for (int button = 0; button < 16; ++button) {
+        bindings.push_back(fmt::format("engine:sdl,port:0,guid:{},button:{}", Guid, button));
+    }
+    for (int stick = 0; stick < 2; ++stick) {
+        bindings.push_back(fmt::format("engine:sdl,port:0,guid:{},axis_x:{},axis_y:{},"
+                                       "deadzone:0.150000,range:0.950000,invert_x:+,invert_y:-,"
+                                       "offset_x:0.000000,offset_y:0.000000",
+                                       Guid, stick * 2, stick * 2 + 1));
+    }
+    for (int motion = 0; motion < 2; ++motion) {
+        bindings.push_back(fmt::format("engine:sdl,port:0,guid:{},motion:{}", Guid, motion));
+    }
+    return bindings;
+}
+} // Anonymous namespace
+
+// Each benchmark handles the bindings of a whole controller, which is what reloading the input
+// settings or hot-plugging a controller does for every player. Run them with
+// `tests "[.benchmark]"`.
+
+TEST_CASE("Input benchmark: device creation", "[input_common][.benchmark]") {
+    const auto engine = std::make_shared<InputCommon::InputEngine>("sdl");
+    InputCommon::InputFactory factory{engine};
+    const std::vector<std::string> bindings = ControllerBindings();
+
+    std::vector<Common::ParamPackage> packages;
+    for (const std::string& binding : bindings) {
+        packages.emplace_back(binding);
+    }
+    for (const Common::ParamPackage& package : packages) {
+        REQUIRE(package.Get("guid", "") == Guid);
+    }
+
+    BENCHMARK("Parse bindings") {
+        size_t num_packages = 0;
+        for (const std::string& binding : bindings) {
+            num_packages += Common::ParamPackage(binding).Has("engine");
+        }
+        return num_packages;
+    };
+    BENCHMARK("Create devices") {
+        std::vector<std::unique_ptr<Common::Input::InputDevice>> devices;
+        for (const Common::ParamPackage& package : packages) {
+            devices.push_back(factory.Create(package));
+        }
+        return devices.size();
+    };
+    BENCHMARK("Parse bindings and create devices") {
+        std::vector<std::unique_ptr<Common::Input::InputDevice>> devices;
+        for (const std::string& binding : bindings) {
+            devices.push_back(factory.Create(Common::ParamPackage(binding)));
+        }
+        return devices.size();
+    };
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "network/packet.h"
+
+namespace {
+
+// Shaped like a relayed LDN packet: a header of small fields followed by the payload
+struct Message {
+    u8 type;
+    std::string nickname;
+    u32 ip;
+    u16 port;
+    u64 program_id;
+    std::vector<u8> payload;
+};
+
+Network::Packet Serialize(const Message& message) {
+    Network::Packet packet;
+    packet.Write(message.type);
+    packet.Write(message.nickname);
+    packet.Write(message.ip);
+    packet.Write(message.port);
+    packet.Write(message.program_id);
+    packet.Write(message.payload);
+    return packet;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Network benchmark: packet serialization", "[network][.benchmark]") {
+    std::mt19937 rng{0x5eed};
+    for (const std::size_t payload_size : {64, 1400}) {
+        Message message{
+            .type = 3,
+            .nickname = "benchmark",
+            .ip = 0x0A000001,
+            .port = 24872,
+            .program_id = 0x0100000000010000,
+            .payload = std::vector<u8>(payload_size),
+        };
+        for (u8& value : message.payload) {
+            value = static_cast<u8>(rng());
+        }
+        const Network::Packet serialized = Serialize(message);
+        const std::string suffix = " " + std::to_string(payload_size) + " byte payload";
+
+        BENCHMARK("Write" + suffix) {
+            return Serialize(message).GetDataSize();
+        };
+        BENCHMARK("Read" + suffix) {
+            Network::Packet packet;
+            packet.Append(serialized.GetData(), serialized.GetDataSize());
+            Message read{};
+            packet.Read(read.type);
+            packet.Read(read.nickname);
+            packet.Read(read.ip);
+            packet.Read(read.port);
+            packet.Read(read.program_id);
+            packet.Read(read.payload);
+            return read.payload.size();
+        };
+    }
+}
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/adaptive_turbo.h"
+
+namespace {
+constexpr u64 MILLISECOND = 1'000'000;
+constexpr u64 BUDGET = 16 * MILLISECOND;
+
+/// Feeds frames with the same times, returns whether turbo is enabled after them
+bool FeedFrames(VideoCommon::AdaptiveTurbo& controller, u64 frame_nanoseconds,
+                u64 gpu_nanoseconds, u32 num_frames) {
+    for (u32 frame = 0; frame < num_frames; ++frame) {
+        controller.AddFrame(frame_nanoseconds, gpu_nanoseconds, BUDGET);
+    }
+    return controller.IsEnabled();
+}
+} // Anonymous namespace
+
+TEST_CASE("AdaptiveTurbo: Enable on an idle GPU missing the budget", "[video_core]") {
+    VideoCommon::AdaptiveTurbo controller;
+    // Meeting the budget, or missing it without GPU work, doesn't need turbo
+    REQUIRE(!FeedFrames(controller, BUDGET, 8 * MILLISECOND, 300));
+    REQUIRE(!FeedFrames(controller, 33 * MILLISECOND, 1 * MILLISECOND, 300));
+    // The GPU being the bottleneck doesn't either
+    REQUIRE(!FeedFrames(controller, 33 * MILLISECOND, 32 * MILLISECOND, 300));
+    // A short stall doesn't enable it
+    REQUIRE(!FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 30));
+    REQUIRE(!FeedFrames(controller, BUDGET, 8 * MILLISECOND, 30));
+
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    // Unmeasured frames keep the state
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 0, 300));
+}
+
+TEST_CASE("AdaptiveTurbo: Disable", "[video_core]") {
+    VideoCommon::AdaptiveTurbo controller;
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    // A saturated GPU doesn't benefit from turbo
+    REQUIRE(!FeedFrames(controller, 33 * MILLISECOND, 32 * MILLISECOND, 60));
+
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    REQUIRE(FeedFrames(controller, BUDGET, 8 * MILLISECOND, 210));
+    REQUIRE(!FeedFrames(controller, BUDGET, 8 * MILLISECOND, 30));
+
+    // Missing again right away doubles the time before the next check
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    REQUIRE(FeedFrames(controller, BUDGET, 8 * MILLISECOND, 450));
+    REQUIRE(!FeedFrames(controller, BUDGET, 8 * MILLISECOND, 30));
+}
+
+TEST_CASE("AdaptiveTurbo: Duty cycle", "[video_core]") {
+    VideoCommon::AdaptiveTurbo controller;
+    REQUIRE(controller.TakeDutyCycle() == 0.0);
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    REQUIRE(controller.TakeDutyCycle() == 0.5);
+    REQUIRE(FeedFrames(controller, 33 * MILLISECOND, 12 * MILLISECOND, 60));
+    REQUIRE(controller.TakeDutyCycle() == 1.0);
+}
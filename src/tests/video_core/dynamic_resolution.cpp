@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/settings_enums.h"
+#include "video_core/dynamic_resolution.h"
+
+namespace {
+using Settings::ResolutionSetup;
+
+constexpr u64 MILLISECOND = 1'000'000;
+
+/// Feeds frames with the same GPU time, returns the first change of scale
+std::optional<ResolutionSetup> FeedFrames(VideoCommon::DynamicResolution& controller,
+                                          u64 gpu_nanoseconds, u32 num_frames) {
+    for (u32 frame = 0; frame < num_frames; ++frame) {
+        if (const auto next = controller.AddFrame(gpu_nanoseconds)) {
+            return next;
+        }
+    }
+    return std::nullopt;
+}
+} // Anonymous namespace
+
+TEST_CASE("DynamicResolution: Step down", "[video_core]") {
+    VideoCommon::DynamicResolution controller(ResolutionSetup::Res1X, ResolutionSetup::Res2X, 60);
+    REQUIRE(controller.Current() == ResolutionSetup::Res2X);
+
+    // A short spike doesn't change the scale
+    REQUIRE(!FeedFrames(controller, 30 * MILLISECOND, 30));
+    REQUIRE(!FeedFrames(controller, 5 * MILLISECOND, 30));
+
+    REQUIRE(FeedFrames(controller, 30 * MILLISECOND, 60) == ResolutionSetup::Res3_2X);
+    // Frames right after a change are ignored
+    REQUIRE(!FeedFrames(controller, 30 * MILLISECOND, 60));
+    REQUIRE(FeedFrames(controller, 30 * MILLISECOND, 60) == ResolutionSetup::Res1X);
+    // The minimum scale is kept however slow frames are
+    REQUIRE(!FeedFrames(controller, 30 * MILLISECOND, 600));
+    REQUIRE(controller.Current() == ResolutionSetup::Res1X);
+}
+
+TEST_CASE("DynamicResolution: Step up", "[video_core]") {
+    VideoCommon::DynamicResolution controller(ResolutionSetup::Res1X, ResolutionSetup::Res2X, 60);
+    REQUIRE(FeedFrames(controller, 30 * MILLISECOND, 60) == ResolutionSetup::Res3_2X);
+    REQUIRE(!FeedFrames(controller, 30 * MILLISECOND, 60));
+
+    // 8 ms at 1.5x predicts 14.2 ms at 2x, over 80% of the 16.7 ms budget
+    REQUIRE(!FeedFrames(controller, 8 * MILLISECOND, 600));
+
+    REQUIRE(FeedFrames(controller, 4 * MILLISECOND, 120) == ResolutionSetup::Res2X);
+    // The configured scale is the upper bound
+    REQUIRE(!FeedFrames(controller, 1 * MILLISECOND, 600));
+    REQUIRE(controller.Current() == ResolutionSetup::Res2X);
+}
+
+TEST_CASE("DynamicResolution: Unmeasured frames", "[video_core]") {
+    VideoCommon::DynamicResolution controller(ResolutionSetup::Res1X, ResolutionSetup::Res2X, 60);
+    REQUIRE(!FeedFrames(controller, 0, 600));
+    REQUIRE(controller.Current() == ResolutionSetup::Res2X);
+}
@@ -2,9 +2,13 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/alignment.h"
@@ -38,6 +42,12 @@ public:
         }
     }
 
+    void UpdatePagesCachedBatch(std::span<const std::pair<VAddr, size_t>> ranges, int delta) {
+        for (const auto& [addr, size] : ranges) {
+            UpdatePagesCachedCount(addr, size, delta);
+        }
+    }
+
     [[nodiscard]] int Count(VAddr addr) const noexcept {
         const auto it = page_table.find(addr >> Core::DEVICE_PAGEBITS);
         return it == page_table.end() ? 0 : it->second;
@@ -546,3 +556,58 @@ TEST_CASE("MemoryTracker: Cached write downloads") {
     memory_track->MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("MemoryTracker: Sparse upload ranges") {
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, HIGH_PAGE_SIZE * 4);
+    REQUIRE(rasterizer.Count() == HIGH_PAGE_SIZE * 4 / PAGE);
+    // Runs crossing words, runs separated by empty words and a run crossing regions
+    memory_track->MarkRegionAsCpuModified(c + WORD * 3 - PAGE * 2, PAGE * 4);
+    memory_track->MarkRegionAsCpuModified(c + WORD * 9, PAGE);
+    memory_track->MarkRegionAsCpuModified(c + WORD * 9 + PAGE * 63, PAGE);
+    memory_track->MarkRegionAsCpuModified(c + HIGH_PAGE_SIZE * 2 - PAGE, PAGE * 2);
+    memory_track->MarkRegionAsCpuModified(c + HIGH_PAGE_SIZE * 4 - PAGE, PAGE);
+    REQUIRE(memory_track->ModifiedCpuRegion(c + WORD * 4, WORD * 8) ==
+            Range{c + WORD * 9, c + WORD * 10});
+    REQUIRE(!memory_track->IsRegionCpuModified(c + WORD * 10, HIGH_PAGE_SIZE * 2 - WORD * 11));
+    std::vector<Range> ranges;
+    memory_track->ForEachUploadRange(c, HIGH_PAGE_SIZE * 4, [&](u64 offset, u64 size) {
+        ranges.emplace_back(offset, offset + size);
+    });
+    const std::vector<Range> expected{
+        {c + WORD * 3 - PAGE * 2, c + WORD * 3 + PAGE * 2},
+        {c + WORD * 9, c + WORD * 9 + PAGE},
+        {c + WORD * 10 - PAGE, c + WORD * 10},
+        {c + HIGH_PAGE_SIZE * 2 - PAGE, c + HIGH_PAGE_SIZE * 2},
+        {c + HIGH_PAGE_SIZE * 2, c + HIGH_PAGE_SIZE * 2 + PAGE},
+        {c + HIGH_PAGE_SIZE * 4 - PAGE, c + HIGH_PAGE_SIZE * 4},
+    };
+    REQUIRE(ranges == expected);
+    REQUIRE(rasterizer.Count() == HIGH_PAGE_SIZE * 4 / PAGE);
+    REQUIRE(!memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 4));
+    memory_track->MarkRegionAsCpuModified(c, HIGH_PAGE_SIZE * 4);
+    REQUIRE(rasterizer.Count() == 0);
+}
+
+TEST_CASE("MemoryTracker: Sparse scan benchmark", "[video_core][.benchmark]") {
+    // 256 MiB buffer with a few scattered CPU writes
+    static constexpr u64 SIZE = 256ULL << 20;
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, SIZE);
+    const auto mark = [&] {
+        for (u64 offset = 0; offset < SIZE; offset += SIZE / 64) {
+            memory_track->MarkRegionAsCpuModified(c + offset + PAGE * 5, PAGE);
+        }
+    };
+    BENCHMARK("Query modified region") {
+        return memory_track->ModifiedCpuRegion(c, SIZE).second;
+    };
+    BENCHMARK("Upload modified ranges") {
+        mark();
+        u64 num_ranges = 0;
+        memory_track->ForEachUploadRange(c, SIZE, [&](u64, u64) { ++num_ranges; });
+        return num_ranges;
+    };
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <random>
+#include <span>
+#include <utility>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/buffer_cache/memory_tracker_base.h"
+
+namespace {
+constexpr u64 PAGE = 4096;
+constexpr u64 BASE = 16ULL << 22;
+
+class NullDeviceTracker {
+public:
+    void UpdatePagesCachedCount(VAddr, u64, int) {}
+    void UpdatePagesCachedBatch(std::span<const std::pair<VAddr, size_t>>, int) {}
+};
+
+using MemoryTracker = VideoCommon::MemoryTrackerBase<NullDeviceTracker>;
+
+struct Fixture {
+    explicit Fixture(u64 size) : memory_track{std::make_unique<MemoryTracker>(device_tracker)} {
+        memory_track->UnmarkRegionAsCpuModified(BASE, size);
+    }
+
+    NullDeviceTracker device_tracker;
+    std::unique_ptr<MemoryTracker> memory_track;
+};
+} // Anonymous namespace
+
+// Each benchmark runs a single operation, so the reported mean is the time per operation.
+// Run them with `tests "[.benchmark]"`.
+
+TEST_CASE("MemoryTracker benchmark: Streaming vertex writes", "[video_core][.benchmark]") {
+    // 64 MiB ring of vertex data written 256 bytes at a time, as a streaming buffer would
+    static constexpr u64 SIZE = 64ULL << 20;
+    static constexpr u64 STRIDE = 256;
+    Fixture fixture{SIZE};
+    u64 offset = 0;
+    BENCHMARK("Mark vertex write") {
+        fixture.memory_track->MarkRegionAsCpuModified(BASE + offset, STRIDE);
+        offset = (offset + STRIDE) % SIZE;
+        return offset;
+    };
+    BENCHMARK("Upload 1 MiB of vertices") {
+        for (u64 write = 0; write < (1ULL << 20); write += STRIDE) {
+            fixture.memory_track->MarkRegionAsCpuModified(BASE + offset + write, STRIDE);
+        }
+        u64 uploaded = 0;
+        fixture.memory_track->ForEachUploadRange(BASE + offset, 1ULL << 20,
+                                                 [&](u64, u64 size) { uploaded += size; });
+        offset = (offset + (1ULL << 20)) % SIZE;
+        return uploaded;
+    };
+    WARN("Tracking memory: " << fixture.memory_track->MemoryUsage() << " bytes");
+}
+
+TEST_CASE("MemoryTracker benchmark: Sparse random CPU writes", "[video_core][.benchmark]") {
+    // Scattered small writes over 1 GiB, like a game updating objects across its heap
+    static constexpr u64 SIZE = 1ULL << 30;
+    Fixture fixture{SIZE};
+    std::mt19937_64 rng{0x5eed};
+    std::uniform_int_distribution<u64> distribution{0, SIZE / 16 - 1};
+    BENCHMARK("Mark random write") {
+        const u64 offset = distribution(rng) * 16;
+        fixture.memory_track->MarkRegionAsCpuModified(BASE + offset, 16);
+        return offset;
+    };
+    BENCHMARK("Query random page") {
+        const u64 offset = distribution(rng) * 16;
+        return fixture.memory_track->IsRegionCpuModified(BASE + offset, PAGE);
+    };
+    BENCHMARK("Upload whole heap") {
+        u64 num_ranges = 0;
+        fixture.memory_track->ForEachUploadRange(BASE, SIZE, [&](u64, u64) { ++num_ranges; });
+        return num_ranges;
+    };
+    WARN("Tracking memory: " << fixture.memory_track->MemoryUsage() << " bytes");
+}
+
+TEST_CASE("MemoryTracker benchmark: Large DMA copies", "[video_core][.benchmark]") {
+    // 32 MiB copies written by the GPU and read back by the CPU
+    static constexpr u64 SIZE = 32ULL << 20;
+    Fixture fixture{SIZE};
+    BENCHMARK("Mark GPU copy") {
+        fixture.memory_track->MarkRegionAsGpuModified(BASE, SIZE);
+        return fixture.memory_track->IsRegionGpuModified(BASE, SIZE);
+    };
+    BENCHMARK("Download and clear copy") {
+        fixture.memory_track->MarkRegionAsGpuModified(BASE, SIZE);
+        u64 downloaded = 0;
+        fixture.memory_track->ForEachDownloadRangeAndClear(
+            BASE, SIZE, [&](u64, u64 size) { downloaded += size; });
+        return downloaded;
+    };
+    WARN("Tracking memory: " << fixture.memory_track->MemoryUsage() << " bytes");
+}
+
+TEST_CASE("MemoryTracker benchmark: Small uniform updates", "[video_core][.benchmark]") {
+    // A handful of constant buffers rewritten and uploaded before every draw
+    static constexpr u64 NUM_BUFFERS = 8;
+    static constexpr u64 BUFFER_SIZE = 0x1000;
+    Fixture fixture{NUM_BUFFERS * BUFFER_SIZE};
+    u64 index = 0;
+    BENCHMARK("Update and upload uniform") {
+        const VAddr address = BASE + (index++ % NUM_BUFFERS) * BUFFER_SIZE;
+        fixture.memory_track->MarkRegionAsCpuModified(address, 256);
+        u64 uploaded = 0;
+        if (fixture.memory_track->IsRegionCpuModified(address, BUFFER_SIZE)) {
+            fixture.memory_track->ForEachUploadRange(address, BUFFER_SIZE,
+                                                     [&](u64, u64 size) { uploaded += size; });
+        }
+        return uploaded;
+    };
+    WARN("Tracking memory: " << fixture.memory_track->MemoryUsage() << " bytes");
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/page_walk.h"
+
+namespace {
+using PageTable = std::unordered_map<u64, std::vector<u32>>;
+
+constexpr u64 PAGE_BITS = 20;
+
+/// Per page lookup, the previous implementation of region walks in the texture cache
+std::vector<u64> LookupEveryPage(const PageTable& table, u64 page_begin, u64 page_end) {
+    std::vector<u64> pages;
+    for (u64 page = page_begin; page <= page_end; ++page) {
+        if (table.contains(page)) {
+            pages.push_back(page);
+        }
+    }
+    return pages;
+}
+
+std::vector<u64> WalkPresentPages(PageTable& table, u64 page_begin, u64 page_end) {
+    std::vector<u64> pages;
+    VideoCommon::ForEachPresentPage(table, page_begin, page_end, [&pages](u64 page, auto&) {
+        pages.push_back(page);
+    });
+    return pages;
+}
+
+PageTable MakePageTable(size_t num_pages, u64 address_space_pages) {
+    std::mt19937_64 rng{1234};
+    PageTable table;
+    while (table.size() < num_pages) {
+        table[rng() % address_space_pages].push_back(0);
+    }
+    return table;
+}
+} // Anonymous namespace
+
+TEST_CASE("ForEachPresentPage: Small ranges", "[video_core]") {
+    PageTable table = MakePageTable(512, 1 << 16);
+    for (u64 begin = 0; begin < (1 << 16); begin += 97) {
+        const u64 end = begin + 31;
+        REQUIRE(WalkPresentPages(table, begin, end) == LookupEveryPage(table, begin, end));
+    }
+}
+
+TEST_CASE("ForEachPresentPage: Large ranges", "[video_core]") {
+    PageTable table = MakePageTable(512, 1 << 16);
+    REQUIRE(WalkPresentPages(table, 0, (1 << 16) - 1) == LookupEveryPage(table, 0, (1 << 16) - 1));
+    REQUIRE(WalkPresentPages(table, 1000, 40000) == LookupEveryPage(table, 1000, 40000));
+}
+
+TEST_CASE("ForEachPresentPage: Early exit", "[video_core]") {
+    PageTable table = MakePageTable(512, 1 << 16);
+    const std::vector<u64> expected = LookupEveryPage(table, 0, (1 << 16) - 1);
+    std::vector<u64> pages;
+    VideoCommon::ForEachPresentPage(table, 0, (1 << 16) - 1, [&](u64 page, auto&) {
+        pages.push_back(page);
+        return pages.size() == 10;
+    });
+    REQUIRE(pages == std::vector<u64>(expected.begin(), expected.begin() + 10));
+}
+
+TEST_CASE("ForEachPresentPage: Unmap benchmark", "[video_core][.benchmark]") {
+    // 16 GiB unmap in a 64 GiB device address space with 2048 cached 1 MiB pages
+    PageTable table = MakePageTable(2048, 1ULL << (36 - PAGE_BITS));
+    const u64 page_begin = (8ULL << 30) >> PAGE_BITS;
+    const u64 page_end = page_begin + ((16ULL << 30) >> PAGE_BITS) - 1;
+    BENCHMARK("Lookup every page") {
+        return LookupEveryPage(table, page_begin, page_end).size();
+    };
+    BENCHMARK("Walk present pages") {
+        return WalkPresentPages(table, page_begin, page_end).size();
+    };
+}
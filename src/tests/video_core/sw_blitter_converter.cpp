@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/engines/sw_blitter/converter.h"
+
+namespace {
+using Tegra::RenderTargetFormat;
+using Tegra::Engines::Blitter::ConverterFactory;
+
+// Vector paths convert groups of four pixels, the rest go through the scalar path
+constexpr size_t NUM_VECTOR_PIXELS = 64;
+constexpr size_t NUM_PIXELS = NUM_VECTOR_PIXELS + 3;
+
+/// Returns pixels covering every byte value, the last pixels repeat the first ones
+std::vector<u8> MakePixels() {
+    std::vector<u8> pixels(NUM_PIXELS * 4);
+    for (size_t i = 0; i < NUM_VECTOR_PIXELS * 4; ++i) {
+        pixels[i] = static_cast<u8>(i * 7 + i / 256);
+    }
+    for (size_t i = NUM_VECTOR_PIXELS * 4; i < pixels.size(); ++i) {
+        pixels[i] = pixels[i - NUM_VECTOR_PIXELS * 4];
+    }
+    return pixels;
+}
+} // Anonymous namespace
+
+TEST_CASE("SoftwareBlitter: 8 bit UNORM conversions", "[video_core]") {
+    ConverterFactory factory;
+    const std::vector<u8> pixels = MakePixels();
+    for (const RenderTargetFormat format :
+         {RenderTargetFormat::A8B8G8R8_UNORM, RenderTargetFormat::A8R8G8B8_UNORM}) {
+        auto* const converter = factory.GetFormatConverter(format);
+        std::vector<f32> ir(NUM_PIXELS * 4);
+        converter->ConvertTo(pixels, ir);
+
+        // Components are stored from the least significant bits in reverse order of the name
+        const size_t red = format == RenderTargetFormat::A8B8G8R8_UNORM ? 3 : 1;
+        const size_t blue = format == RenderTargetFormat::A8B8G8R8_UNORM ? 1 : 3;
+        REQUIRE(ir[0] == static_cast<f32>(pixels[red]) / 255.0f);
+        REQUIRE(ir[1] == static_cast<f32>(pixels[2]) / 255.0f);
+        REQUIRE(ir[2] == static_cast<f32>(pixels[blue]) / 255.0f);
+        REQUIRE(ir[3] == static_cast<f32>(pixels[0]) / 255.0f);
+
+        // The scalar path produces the same results as the vector path
+        for (size_t i = NUM_VECTOR_PIXELS * 4; i < ir.size(); ++i) {
+            REQUIRE(ir[i] == ir[i - NUM_VECTOR_PIXELS * 4]);
+        }
+
+        std::vector<u8> result(pixels.size());
+        converter->ConvertFrom(ir, result);
+        REQUIRE(result == pixels);
+    }
+}
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/decode_bc.h"
+#include "video_core/texture_cache/types.h"
+#include "video_core/textures/astc.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using VideoCore::Surface::PixelFormat;
+
+// A 720p render target, the usual size of what games draw and what gets flushed back
+constexpr u32 WIDTH = 1280;
+constexpr u32 HEIGHT = 720;
+constexpr u32 BLOCK_HEIGHT_LOG2 = 4;
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::mt19937 rng{0x5eed};
+    std::vector<u8> data(size);
+    for (u8& value : data) {
+        value = static_cast<u8>(rng());
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("Texture benchmark: block linear swizzling", "[video_core][.benchmark]") {
+    for (const u32 bytes_per_pixel : {4U, 8U}) {
+        const std::size_t tiled_size = Tegra::Texture::CalculateSize(
+            true, bytes_per_pixel, WIDTH, HEIGHT, 1, BLOCK_HEIGHT_LOG2, 0);
+        const std::vector<u8> tiled = MakeData(tiled_size);
+        const std::vector<u8> linear = MakeData(std::size_t{WIDTH} * HEIGHT * bytes_per_pixel);
+        std::vector<u8> output(std::max(tiled_size, linear.size()));
+
+        BENCHMARK("Unswizzle " + std::to_string(bytes_per_pixel) + " bytes per pixel") {
+            Tegra::Texture::UnswizzleTexture(output, tiled, bytes_per_pixel, WIDTH, HEIGHT, 1,
+                                             BLOCK_HEIGHT_LOG2, 0);
+            return output[0];
+        };
+        BENCHMARK("Swizzle " + std::to_string(bytes_per_pixel) + " bytes per pixel") {
+            Tegra::Texture::SwizzleTexture(output, linear, bytes_per_pixel, WIDTH, HEIGHT, 1,
+                                           BLOCK_HEIGHT_LOG2, 0);
+            return output[0];
+        };
+    }
+}
+
+TEST_CASE("Texture benchmark: ASTC decoding", "[video_core][.benchmark]") {
+    // Random blocks mix valid and reserved block modes, the mix is the same on every run
+    constexpr u32 SIZE = 256;
+    for (const u32 block_size : {4U, 8U}) {
+        const u32 num_blocks = (SIZE / block_size) * (SIZE / block_size);
+        const std::vector<u8> input = MakeData(std::size_t{num_blocks} * 16);
+        std::vector<u8> output(std::size_t{SIZE} * SIZE * 4);
+
+        BENCHMARK("ASTC " + std::to_string(block_size) + "x" + std::to_string(block_size)) {
+            Tegra::Texture::ASTC::Decompress(input, SIZE, SIZE, 1, block_size, block_size,
+                                             output);
+            return output[0];
+        };
+    }
+}
+
+TEST_CASE("Texture benchmark: BCn decoding", "[video_core][.benchmark]") {
+    constexpr u32 SIZE = 256;
+    static constexpr std::pair<PixelFormat, const char*> FORMATS[] = {
+        {PixelFormat::BC1_RGBA_UNORM, "BC1"},
+        {PixelFormat::BC3_UNORM, "BC3"},
+        {PixelFormat::BC5_UNORM, "BC5"},
+        {PixelFormat::BC7_UNORM, "BC7"},
+    };
+    for (const auto& [format, name] : FORMATS) {
+        const u32 bytes_per_block = format == PixelFormat::BC1_RGBA_UNORM ? 8 : 16;
+        const std::vector<u8> input = MakeData(std::size_t{SIZE / 4} * (SIZE / 4) *
+                                               bytes_per_block);
+        std::vector<u8> output(std::size_t{SIZE} * SIZE *
+                               VideoCommon::ConvertedBytesPerBlock(format));
+        VideoCommon::BufferImageCopy copy{
+            .buffer_offset = 0,
+            .buffer_size = input.size(),
+            .buffer_row_length = SIZE,
+            .buffer_image_height = SIZE,
+            .image_subresource = {},
+            .image_offset = {},
+            .image_extent = {SIZE, SIZE, 1},
+        };
+
+        BENCHMARK(name) {
+            VideoCommon::DecompressBCn(input, output, copy, format);
+            return output[0];
+        };
+    }
+}
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/translation_cache.h"
+
+using Tegra::TranslationCache;
+
+TEST_CASE("TranslationCache: Hit after insert", "[video_core]") {
+    TranslationCache cache;
+    REQUIRE(!cache.Find(0, 0, 5));
+    cache.Insert(0, 0, 5, 0x1000);
+    REQUIRE(cache.Find(0, 0, 5) == 0x1000);
+    REQUIRE(cache.Stats().hits == 1);
+    REQUIRE(cache.Stats().misses == 1);
+}
+
+TEST_CASE("TranslationCache: Generation invalidates", "[video_core]") {
+    TranslationCache cache;
+    cache.Insert(0, 0, 5, 0x1000);
+    REQUIRE(!cache.Find(0, 1, 5));
+    cache.Insert(0, 1, 5, 0x2000);
+    REQUIRE(cache.Find(0, 1, 5) == 0x2000);
+}
+
+TEST_CASE("TranslationCache: Owners and aliases do not collide", "[video_core]") {
+    TranslationCache cache;
+    cache.Insert(0, 0, 5, 0x1000);
+    REQUIRE(!cache.Find(1, 0, 5));
+
+    // Pages sharing a slot evict each other
+    cache.Insert(0, 0, 5 + TranslationCache::NUM_ENTRIES, 0x3000);
+    REQUIRE(!cache.Find(0, 0, 5));
+    REQUIRE(cache.Find(0, 0, 5 + TranslationCache::NUM_ENTRIES) == 0x3000);
+}
+
+TEST_CASE("TranslationCache: Page zero is not a hit when empty", "[video_core]") {
+    TranslationCache cache;
+    REQUIRE(!cache.Find(0, 0, 0));
+}
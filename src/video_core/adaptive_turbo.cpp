@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "video_core/adaptive_turbo.h"
+
+namespace VideoCommon {
+namespace {
+// Number of frames averaged before deciding
+constexpr u32 WINDOW_FRAMES = 30;
+// Consecutive windows missing the budget with an idle GPU needed to enable turbo
+constexpr u32 WINDOWS_TO_ENABLE = 2;
+// Consecutive windows with a saturated GPU needed to disable turbo
+constexpr u32 WINDOWS_TO_DISABLE_GPU_BOUND = 2;
+// Consecutive windows meeting the budget before checking whether turbo is still needed, doubled
+// each time frames miss again shortly after disabling it
+constexpr u32 MIN_WINDOWS_TO_DISABLE = 8;
+constexpr u32 MAX_WINDOWS_TO_DISABLE = 128;
+// Fraction of the budget the frame time has to exceed to miss it
+constexpr double MISS_THRESHOLD = 1.05;
+// Fraction of the frame time the GPU has to be idle for to consider it downclocked
+constexpr double IDLE_THRESHOLD = 0.30;
+// Fraction of the frame time under which the GPU is idle enough to be the bottleneck
+constexpr double GPU_BOUND_THRESHOLD = 0.10;
+// Fraction of the budget the GPU has to be busy for, lighter loads don't depend on its clocks
+constexpr double MIN_GPU_LOAD = 0.25;
+} // Anonymous namespace
+
+AdaptiveTurbo::AdaptiveTurbo()
+    : windows_disabled{MAX_WINDOWS_TO_DISABLE}, windows_to_disable{MIN_WINDOWS_TO_DISABLE} {}
+
+bool AdaptiveTurbo::AddFrame(u64 frame_nanoseconds, u64 gpu_nanoseconds,
+                             u64 budget_nanoseconds) {
+    ++duty_frames;
+    if (enabled) {
+        ++duty_enabled_frames;
+    }
+    // Frames without measurements don't tell anything about the load
+    if (frame_nanoseconds == 0 || gpu_nanoseconds == 0 || budget_nanoseconds == 0) {
+        return enabled;
+    }
+    window_frame_nanoseconds += frame_nanoseconds;
+    window_gpu_nanoseconds += gpu_nanoseconds;
+    window_budget_nanoseconds += budget_nanoseconds;
+    if (++window_frames < WINDOW_FRAMES) {
+        return enabled;
+    }
+    EvaluateWindow(static_cast<double>(window_frame_nanoseconds),
+                   static_cast<double>(window_gpu_nanoseconds),
+                   static_cast<double>(window_budget_nanoseconds));
+    window_frame_nanoseconds = 0;
+    window_gpu_nanoseconds = 0;
+    window_budget_nanoseconds = 0;
+    window_frames = 0;
+    return enabled;
+}
+
+double AdaptiveTurbo::TakeDutyCycle() noexcept {
+    const double duty_cycle =
+        duty_frames == 0 ? 0.0
+                         : static_cast<double>(duty_enabled_frames) / static_cast<double>(duty_frames);
+    duty_frames = 0;
+    duty_enabled_frames = 0;
+    return duty_cycle;
+}
+
+void AdaptiveTurbo::EvaluateWindow(double frame, double gpu, double budget) {
+    const bool missing = frame > budget * MISS_THRESHOLD;
+    const double idle = std::max(1.0 - gpu / frame, 0.0);
+    if (!enabled) {
+        ++windows_disabled;
+        if (!missing || idle < IDLE_THRESHOLD || gpu < budget * MIN_GPU_LOAD) {
+            windows_missing = 0;
+            return;
+        }
+        if (++windows_missing < WINDOWS_TO_ENABLE) {
+            return;
+        }
+        // Missing again right after disabling means turbo was still needed, check less often
+        windows_to_disable = windows_disabled <= WINDOWS_TO_ENABLE + 1
+                                 ? std::min(windows_to_disable * 2, MAX_WINDOWS_TO_DISABLE)
+                                 : MIN_WINDOWS_TO_DISABLE;
+        enabled = true;
+        windows_missing = 0;
+        windows_meeting = 0;
+        windows_gpu_bound = 0;
+        return;
+    }
+    windows_gpu_bound = idle < GPU_BOUND_THRESHOLD ? windows_gpu_bound + 1 : 0;
+    windows_meeting = missing ? 0 : windows_meeting + 1;
+    if (windows_gpu_bound >= WINDOWS_TO_DISABLE_GPU_BOUND) {
+        enabled = false;
+        // Only checks whether turbo is still needed back off
+        windows_disabled = MAX_WINDOWS_TO_DISABLE;
+    } else if (windows_meeting >= windows_to_disable) {
+        enabled = false;
+        windows_disabled = 0;
+    }
+}
+
+} // namespace VideoCommon
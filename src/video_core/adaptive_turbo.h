@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * Decides when forcing GPU clocks up is worth it. Drivers that downclock aggressively stretch
+ * the short bursts of work of an emulated frame, so frames miss their budget while the GPU sits
+ * idle between submissions. Turbo is enabled after consecutive windows of frames like that, and
+ * disabled when the GPU is the bottleneck, or after frames meet the budget for a while to check
+ * whether it is still needed. The check backs off when frames start missing again right away.
+ */
+class AdaptiveTurbo {
+public:
+    explicit AdaptiveTurbo();
+
+    /// Adds a frame, returns whether turbo mode should run
+    bool AddFrame(u64 frame_nanoseconds, u64 gpu_nanoseconds, u64 budget_nanoseconds);
+
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return enabled;
+    }
+
+    /// Returns the fraction of frames added since the last call with turbo enabled
+    [[nodiscard]] double TakeDutyCycle() noexcept;
+
+private:
+    void EvaluateWindow(double frame, double gpu, double budget);
+
+    bool enabled = false;
+
+    u64 window_frame_nanoseconds = 0;
+    u64 window_gpu_nanoseconds = 0;
+    u64 window_budget_nanoseconds = 0;
+    u32 window_frames = 0;
+
+    u32 windows_missing = 0;
+    u32 windows_meeting = 0;
+    u32 windows_gpu_bound = 0;
+    u32 windows_disabled;
+    u32 windows_to_disable;
+
+    u64 duty_frames = 0;
+    u64 duty_enabled_frames = 0;
+};
+
+} // namespace VideoCommon
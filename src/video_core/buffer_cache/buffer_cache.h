@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <memory>
 #include <numeric>
 
@@ -11,6 +12,7 @@
 #include "video_core/buffer_cache/buffer_cache_base.h"
 #include "video_core/guest_memory.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/textures/decoders.h"
 
 namespace VideoCommon {
 
@@ -267,6 +269,92 @@ bool BufferCache<P>::DMAClear(GPUVAddr dst_address, u64 amount, u32 value) {
     return true;
 }
 
+template <class P>
+std::optional<DAddr> BufferCache<P>::DMABlockLinearCopy(const Tegra::DMA::BlockLinearCopy& copy,
+                                                        bool to_block_linear) {
+    if constexpr (!HAS_BLOCK_LINEAR_COPY) {
+        return std::nullopt;
+    } else {
+        // Copies are done in 32-bit words, odd sized pixels are left to the CPU
+        if (((copy.pitch_address | copy.block_linear_address | copy.pitch) & 3) != 0 ||
+            copy.bytes_per_pixel < sizeof(u32) || !std::has_single_bit(copy.bytes_per_pixel) ||
+            copy.origin_y >= copy.height) {
+            return std::nullopt;
+        }
+        const std::optional<DAddr> cpu_pitch_address = gpu_memory->GpuToCpuAddress(
+            copy.pitch_address);
+        const std::optional<DAddr> cpu_block_linear_address =
+            gpu_memory->GpuToCpuAddress(copy.block_linear_address);
+        if (!cpu_pitch_address || !cpu_block_linear_address) {
+            return std::nullopt;
+        }
+        const u32 pitch_size = static_cast<u32>(copy.pitch_size);
+        const u32 block_linear_size = static_cast<u32>(copy.block_linear_size);
+        const bool pitch_dirty = IsRegionRegistered(*cpu_pitch_address, pitch_size);
+        const bool block_linear_dirty =
+            IsRegionRegistered(*cpu_block_linear_address, block_linear_size);
+        if (!pitch_dirty && !block_linear_dirty) {
+            return std::nullopt;
+        }
+        const DAddr cpu_src_address = to_block_linear ? *cpu_pitch_address
+                                                      : *cpu_block_linear_address;
+        const u32 src_size = to_block_linear ? pitch_size : block_linear_size;
+        const DAddr cpu_dst_address = to_block_linear ? *cpu_block_linear_address
+                                                      : *cpu_pitch_address;
+        const u32 dst_size = to_block_linear ? block_linear_size : pitch_size;
+        const bool has_gpu_source = IsRegionGpuModified(cpu_src_address, src_size);
+        ClearDownload(cpu_dst_address, dst_size);
+
+        BufferId pitch_buffer_id;
+        BufferId block_linear_buffer_id;
+        do {
+            channel_state->has_deleted_buffers = false;
+            pitch_buffer_id = FindBuffer(*cpu_pitch_address, pitch_size);
+            block_linear_buffer_id = FindBuffer(*cpu_block_linear_address, block_linear_size);
+        } while (channel_state->has_deleted_buffers);
+        Buffer& pitch_buffer = slot_buffers[pitch_buffer_id];
+        Buffer& block_linear_buffer = slot_buffers[block_linear_buffer_id];
+        SynchronizeBuffer(pitch_buffer, *cpu_pitch_address, pitch_size);
+        SynchronizeBuffer(block_linear_buffer, *cpu_block_linear_address, block_linear_size);
+
+        const u32 pitch_offset = pitch_buffer.Offset(*cpu_pitch_address);
+        const u32 block_linear_offset = block_linear_buffer.Offset(*cpu_block_linear_address);
+        pitch_buffer.MarkUsage(pitch_offset, pitch_size);
+        block_linear_buffer.MarkUsage(block_linear_offset, block_linear_size);
+        runtime.CopyBlockLinear(pitch_buffer, pitch_offset, block_linear_buffer,
+                                block_linear_offset, copy, to_block_linear);
+
+        // The texture cache reads guest memory directly, so the copy is repeated on guest memory
+        {
+            Tegra::Memory::DeviceGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead>
+                src_memory(device_memory, cpu_src_address, src_size, &dma_source_buffer);
+            Tegra::Memory::DeviceGuestMemoryScoped<
+                u8, Tegra::Memory::GuestMemoryFlags::UnsafeReadWrite>
+                dst_memory(device_memory, cpu_dst_address, dst_size, &tmp_buffer);
+            if (to_block_linear) {
+                Tegra::Texture::SwizzleSubrect(dst_memory, src_memory, copy.bytes_per_pixel,
+                                               copy.width, copy.height, 1, copy.origin_x,
+                                               copy.origin_y, copy.extent_x, copy.extent_y,
+                                               copy.block_height, copy.block_depth, copy.pitch);
+            } else {
+                Tegra::Texture::UnswizzleSubrect(dst_memory, src_memory, copy.bytes_per_pixel,
+                                                 copy.width, copy.height, 1, copy.origin_x,
+                                                 copy.origin_y, copy.extent_x, copy.extent_y,
+                                                 copy.block_height, copy.block_depth, copy.pitch);
+            }
+        }
+        if (has_gpu_source) {
+            // Guest memory of the source is stale, the exact result only exists on the GPU
+            memory_tracker.MarkRegionAsGpuModified(cpu_dst_address, dst_size);
+            gpu_modified_ranges.Add(cpu_dst_address, dst_size);
+            uncommitted_gpu_modified_ranges.Add(cpu_dst_address, dst_size);
+        } else {
+            gpu_modified_ranges.Subtract(cpu_dst_address, dst_size);
+        }
+        return cpu_dst_address;
+    }
+}
+
 template <class P>
 std::pair<typename P::Buffer*, u32> BufferCache<P>::ObtainBuffer(GPUVAddr gpu_addr, u32 size,
                                                                  ObtainBufferSynchronize sync_info,
@@ -533,9 +621,7 @@ void BufferCache<P>::CommitAsyncFlushesHigh() {
         auto& current_intervals = *it;
         auto next_it = std::next(it);
         while (next_it != committed_gpu_modified_ranges.end()) {
-            next_it->ForEach([&current_intervals](DAddr start, DAddr end) {
-                current_intervals.Subtract(start, end - start);
-            });
+            current_intervals.Subtract(*next_it);
             next_it++;
         }
         it++;
@@ -1289,6 +1375,8 @@ template <class P>
 typename BufferCache<P>::OverlapResult BufferCache<P>::ResolveOverlaps(DAddr device_addr,
                                                                        u32 wanted_size) {
     static constexpr int STREAM_LEAP_THRESHOLD = 16;
+    static constexpr DAddr MIN_STREAM_LEAP = CACHING_PAGESIZE * 128;
+    static constexpr DAddr MAX_STREAM_LEAP = CACHING_PAGESIZE * 2048;
     boost::container::small_vector<BufferId, 16> overlap_ids;
     DAddr begin = device_addr;
     DAddr end = device_addr + wanted_size;
@@ -1346,12 +1434,16 @@ typename BufferCache<P>::OverlapResult BufferCache<P>::ResolveOverlaps(DAddr dev
         if (stream_score > STREAM_LEAP_THRESHOLD && !has_stream_leap) {
             // When this memory region has been joined a bunch of times, we assume it's being used
             // as a stream buffer. Increase the size to skip constantly recreating buffers.
+            // Leaps grow with the buffer, so streams that keep growing are joined a logarithmic
+            // number of times instead of once every few megabytes.
             has_stream_leap = true;
+            const DAddr leap = std::clamp<DAddr>(Common::AlignUp(end - begin, CACHING_PAGESIZE),
+                                                 MIN_STREAM_LEAP, MAX_STREAM_LEAP);
             if (expands_right) {
-                expand_begin(CACHING_PAGESIZE * 128);
+                expand_begin(leap);
             }
             if (expands_left) {
-                expand_end(CACHING_PAGESIZE * 128);
+                expand_end(leap);
             }
         }
     }
@@ -1393,7 +1485,24 @@ BufferId BufferCache<P>::CreateBuffer(DAddr device_addr, u32 wanted_size) {
     const BufferId new_buffer_id = slot_buffers.insert(runtime, overlap.begin, size);
     auto& new_buffer = slot_buffers[new_buffer_id];
     const size_t size_bytes = new_buffer.SizeBytes();
-    runtime.ClearBuffer(new_buffer, 0, size_bytes, 0);
+    // Only clear the ranges that are not overwritten by the joined buffers
+    boost::container::small_vector<BufferId, 16> sorted_ids(overlap.ids.begin(), overlap.ids.end());
+    std::ranges::sort(sorted_ids, {},
+                      [this](BufferId overlap_id) { return slot_buffers[overlap_id].CpuAddr(); });
+    size_t clear_offset = 0;
+    for (const BufferId overlap_id : sorted_ids) {
+        const Buffer& overlap_buffer = slot_buffers[overlap_id];
+        const size_t overlap_offset = overlap_buffer.CpuAddr() - overlap.begin;
+        if (overlap_offset > clear_offset) {
+            runtime.ClearBuffer(new_buffer, static_cast<u32>(clear_offset),
+                                overlap_offset - clear_offset, 0);
+        }
+        clear_offset = std::max(clear_offset, overlap_offset + overlap_buffer.SizeBytes());
+    }
+    if (clear_offset < size_bytes) {
+        runtime.ClearBuffer(new_buffer, static_cast<u32>(clear_offset), size_bytes - clear_offset,
+                            0);
+    }
     new_buffer.MarkUsage(0, size_bytes);
     for (const BufferId overlap_id : overlap.ids) {
         JoinOverlap(new_buffer_id, overlap_id, !overlap.has_stream_leap);
@@ -1418,11 +1527,14 @@ template <bool insert>
 void BufferCache<P>::ChangeRegister(BufferId buffer_id) {
     Buffer& buffer = slot_buffers[buffer_id];
     const auto size = buffer.SizeBytes();
+    const u64 fitted_size = Common::AlignUp(size, 1024);
     if (insert) {
-        total_used_memory += Common::AlignUp(size, 1024);
+        total_used_memory += fitted_size;
+        memory_usage.Add(fitted_size);
         buffer.setLRUID(lru_cache.Insert(buffer_id, frame_tick));
     } else {
-        total_used_memory -= Common::AlignUp(size, 1024);
+        total_used_memory -= fitted_size;
+        memory_usage.Subtract(fitted_size);
         lru_cache.Free(buffer.getLRUID());
     }
     const DAddr device_addr_begin = buffer.CpuAddr();
@@ -1509,6 +1621,14 @@ void BufferCache<P>::MappedUploadMemory([[maybe_unused]] Buffer& buffer,
                                         [[maybe_unused]] u64 total_size_bytes,
                                         [[maybe_unused]] std::span<BufferCopy> copies) {
     if constexpr (USE_MEMORY_MAPS) {
+        if constexpr (CAN_IMPORT_HOST_MEMORY) {
+            if (runtime.CanImportHostMemory()) {
+                copies = ImportedUploadMemory(buffer, copies);
+                if (copies.empty()) {
+                    return;
+                }
+            }
+        }
         auto upload_staging = runtime.UploadStagingBuffer(total_size_bytes);
         const std::span<u8> staging_pointer = upload_staging.mapped_span;
         for (BufferCopy& copy : copies) {
@@ -1524,6 +1644,52 @@ void BufferCache<P>::MappedUploadMemory([[maybe_unused]] Buffer& buffer,
     }
 }
 
+template <class P>
+std::span<BufferCopy> BufferCache<P>::ImportedUploadMemory([[maybe_unused]] Buffer& buffer,
+                                                           std::span<BufferCopy> copies) {
+    if constexpr (!CAN_IMPORT_HOST_MEMORY) {
+        // Backends without host memory import never get here, keep them from instantiating it
+        return copies;
+    } else {
+        // The GPU reads guest memory when the copy executes instead of when it is recorded. Guest
+        // writes in between are tracked as CPU modifications, so they are uploaded again later.
+        boost::container::small_vector<BufferCopy, 4> imported_copies;
+        decltype(runtime.ImportHostMemory(nullptr, 0)) imported_buffer;
+        const auto flush_imported = [&] {
+            if (imported_copies.empty()) {
+                return;
+            }
+            const std::span<const BufferCopy> copies_span(imported_copies.data(),
+                                                          imported_copies.size());
+            const bool can_reorder = runtime.CanReorderUpload(buffer, copies_span);
+            runtime.CopyBuffer(buffer, imported_buffer->buffer, copies_span, true, can_reorder);
+            imported_copies.clear();
+        };
+        size_t num_remaining = 0;
+        for (const BufferCopy& copy : copies) {
+            const DAddr device_addr = buffer.CpuAddr() + copy.dst_offset;
+            const u8* const host_pointer = device_memory.GetSpan(device_addr, copy.size);
+            const auto import = host_pointer ? runtime.ImportHostMemory(host_pointer, copy.size)
+                                             : std::nullopt;
+            if (!import) {
+                copies[num_remaining++] = copy;
+                continue;
+            }
+            if (!imported_buffer || imported_buffer->buffer != import->buffer) {
+                flush_imported();
+                imported_buffer = import;
+            }
+            imported_copies.push_back(BufferCopy{
+                .src_offset = import->offset,
+                .dst_offset = copy.dst_offset,
+                .size = copy.size,
+            });
+        }
+        flush_imported();
+        return copies.first(num_remaining);
+    }
+}
+
 template <class P>
 bool BufferCache<P>::InlineMemory(DAddr dest_address, size_t copy_size,
                                   std::span<const u8> inlined_buffer) {
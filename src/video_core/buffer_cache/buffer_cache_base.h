@@ -9,6 +9,7 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <span>
 #include <unordered_map>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "common/div_ceil.h"
 #include "common/literals.h"
 #include "common/lru_cache.h"
+#include "common/memory_usage.h"
 #include "common/microprofile.h"
 #include "common/range_sets.h"
 #include "common/scope_exit.h"
@@ -29,6 +31,7 @@
 #include "video_core/engines/draw_manager.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/maxwell_dma.h"
 #include "video_core/memory_manager.h"
 #include "video_core/surface.h"
 #include "video_core/texture_cache/types.h"
@@ -169,6 +172,8 @@ class BufferCache : public VideoCommon::ChannelSetupCaches<BufferCacheChannelInf
     static constexpr bool USE_MEMORY_MAPS = P::USE_MEMORY_MAPS;
     static constexpr bool SEPARATE_IMAGE_BUFFERS_BINDINGS = P::SEPARATE_IMAGE_BUFFER_BINDINGS;
     static constexpr bool USE_MEMORY_MAPS_FOR_UPLOADS = P::USE_MEMORY_MAPS_FOR_UPLOADS;
+    static constexpr bool CAN_IMPORT_HOST_MEMORY = P::CAN_IMPORT_HOST_MEMORY;
+    static constexpr bool HAS_BLOCK_LINEAR_COPY = P::HAS_BLOCK_LINEAR_COPY;
 
     static constexpr s64 DEFAULT_EXPECTED_MEMORY = 512_MiB;
     static constexpr s64 DEFAULT_CRITICAL_MEMORY = 1_GiB;
@@ -279,6 +284,11 @@ public:
 
     bool DMAClear(GPUVAddr src_address, u64 amount, u32 value);
 
+    /// Swizzles or unswizzles a DMA copy on the GPU when either side is cached, guest memory is
+    /// written as well. Returns the device address of the destination, or nullopt if not handled.
+    std::optional<DAddr> DMABlockLinearCopy(const Tegra::DMA::BlockLinearCopy& copy,
+                                            bool to_block_linear);
+
     /// Return true when a CPU region is modified from the GPU
     [[nodiscard]] bool IsRegionGpuModified(DAddr addr, size_t size);
 
@@ -422,6 +432,10 @@ private:
 
     void MappedUploadMemory(Buffer& buffer, u64 total_size_bytes, std::span<BufferCopy> copies);
 
+    /// Copies straight from imported guest memory, returns the copies that could not be imported
+    [[nodiscard]] std::span<BufferCopy> ImportedUploadMemory(Buffer& buffer,
+                                                             std::span<BufferCopy> copies);
+
     void DownloadBufferMemory(Buffer& buffer_id);
 
     void DownloadBufferMemory(Buffer& buffer_id, DAddr device_addr, u64 size);
@@ -479,10 +493,12 @@ private:
     u64 total_used_memory = 0;
     u64 minimum_memory = 0;
     u64 critical_memory = 0;
+    Common::MemoryUsageCounter memory_usage{Common::MemoryUsageCategory::BufferCache};
     BufferId inline_buffer_id;
 
     std::array<BufferId, ((1ULL << 34) >> CACHING_PAGEBITS)> page_table;
     Common::ScratchBuffer<u8> tmp_buffer;
+    Common::ScratchBuffer<u8> dma_source_buffer;
 };
 
 } // namespace VideoCommon
@@ -32,6 +32,11 @@ public:
     MemoryTrackerBase(DeviceTracker& device_tracker_) : device_tracker{&device_tracker_} {}
     ~MemoryTrackerBase() = default;
 
+    /// Returns the number of bytes allocated to track memory
+    [[nodiscard]] size_t MemoryUsage() const noexcept {
+        return sizeof(*this) + manager_pool.size() * sizeof(std::array<Manager, MANAGER_POOL_SIZE>);
+    }
+
     /// Returns the inclusive CPU modified range in a begin end pair
     [[nodiscard]] std::pair<u64, u64> ModifiedCpuRegion(VAddr query_cpu_addr,
                                                         u64 query_size) noexcept {
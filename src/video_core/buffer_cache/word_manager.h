@@ -9,6 +9,8 @@
 #include <span>
 #include <utility>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/alignment.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -196,6 +198,41 @@ public:
 
     template <typename Func>
     void IterateWords(size_t offset, size_t size, Func&& func) const {
+        IterateWordsImpl<false>(offset, size, nullptr, nullptr, std::forward<Func>(func));
+    }
+
+    /// Returns the index of the first word in [index, end) with bits set in lhs or rhs, or end
+    static size_t FindNonZeroWord(const u64* lhs, const u64* rhs, size_t index, size_t end) {
+        // Test blocks of words at once, compilers lower this to wide vector compares
+        static constexpr size_t BLOCK_WORDS = 4;
+        for (; index + BLOCK_WORDS <= end; index += BLOCK_WORDS) {
+            u64 any_bits = 0;
+            for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+                any_bits |= lhs[index + i] | rhs[index + i];
+            }
+            if (any_bits != 0) {
+                break;
+            }
+        }
+        while (index < end && (lhs[index] | rhs[index]) == 0) {
+            ++index;
+        }
+        return index;
+    }
+
+    /**
+     * Call func(index, mask) for each word in a range, skipping words without bits set in lhs
+     * or rhs as they are known to have no effect on the caller
+     */
+    template <typename Func>
+    void IterateNonZeroWords(size_t offset, size_t size, const u64* lhs, const u64* rhs,
+                             Func&& func) const {
+        IterateWordsImpl<true>(offset, size, lhs, rhs, std::forward<Func>(func));
+    }
+
+    template <bool skip_zero_words, typename Func>
+    void IterateWordsImpl(size_t offset, size_t size, [[maybe_unused]] const u64* lhs,
+                          [[maybe_unused]] const u64* rhs, Func&& func) const {
         using FuncReturn = std::invoke_result_t<Func, std::size_t, u64>;
         static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
         const size_t start = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset), 0LL));
@@ -214,9 +251,16 @@ public:
         end_page += diff * PAGES_PER_WORD;
         constexpr u64 base_mask{~0ULL};
         for (size_t word_index = start_word; word_index < end_word; word_index++) {
-            const u64 mask = ExtractBits(base_mask, start_page, end_page);
-            start_page = 0;
-            end_page -= PAGES_PER_WORD;
+            if constexpr (skip_zero_words) {
+                word_index = FindNonZeroWord(lhs, rhs, word_index, end_word);
+                if (word_index == end_word) {
+                    return;
+                }
+            }
+            // Only the first word starts in the middle, the end page moves a word per word
+            const size_t first_page = word_index == start_word ? start_page : 0;
+            const size_t last_page = end_page - (word_index - start_word) * PAGES_PER_WORD;
+            const u64 mask = ExtractBits(base_mask, first_page, last_page);
             if constexpr (BOOL_BREAK) {
                 if (func(word_index, mask)) {
                     return;
@@ -253,9 +297,11 @@ public:
         std::span<u64> state_words = words.template Span<type>();
         [[maybe_unused]] std::span<u64> untracked_words = words.template Span<Type::Untracked>();
         [[maybe_unused]] std::span<u64> cached_words = words.template Span<Type::CachedCPU>();
-        IterateWords(dirty_addr - cpu_addr, size, [&](size_t index, u64 mask) {
+        [[maybe_unused]] TrackerRanges tracker_ranges;
+        const auto change = [&](size_t index, u64 mask) {
             if constexpr (type == Type::CPU || type == Type::CachedCPU) {
-                NotifyRasterizer<!enable>(index, untracked_words[index], mask);
+                CollectTrackerRanges<!enable>(index, untracked_words[index], mask,
+                                              tracker_ranges);
             }
             if constexpr (enable) {
                 state_words[index] |= mask;
@@ -275,7 +321,20 @@ public:
                     untracked_words[index] &= ~mask;
                 }
             }
-        });
+        };
+        if constexpr (enable) {
+            IterateWords(dirty_addr - cpu_addr, size, change);
+        } else {
+            // Clearing bits has no effect on words without tracked or modified pages
+            const u64* const other_words = type == Type::CPU || type == Type::CachedCPU
+                                               ? untracked_words.data()
+                                               : state_words.data();
+            IterateNonZeroWords(dirty_addr - cpu_addr, size, state_words.data(), other_words,
+                                change);
+        }
+        if constexpr (type == Type::CPU || type == Type::CachedCPU) {
+            NotifyTracker<!enable>(tracker_ranges);
+        }
     }
 
     /**
@@ -301,7 +360,13 @@ public:
             func(cpu_addr + pending_offset * BYTES_PER_PAGE,
                  (pending_pointer - pending_offset) * BYTES_PER_PAGE);
         };
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        // Words without modified pages break runs on their own, and clearing them only has an
+        // effect when they have tracked pages
+        static constexpr bool clears_untracked =
+            clear && (type == Type::CPU || type == Type::CachedCPU);
+        const u64* const state = state_words.data();
+        const u64* const other = clears_untracked ? untracked_words.data() : state;
+        IterateNonZeroWords(offset, size, state, other, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -356,7 +421,8 @@ public:
         [[maybe_unused]] const std::span<const u64> untracked_words =
             words.template Span<Type::Untracked>();
         bool result = false;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const u64* const state = state_words.data();
+        IterateNonZeroWords(offset, size, state, state, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -384,7 +450,8 @@ public:
             words.template Span<Type::Untracked>();
         u64 begin = std::numeric_limits<u64>::max();
         u64 end = 0;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const u64* const state = state_words.data();
+        IterateNonZeroWords(offset, size, state, state, [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -422,16 +489,25 @@ public:
         u64* const cached_words = Array<Type::CachedCPU>();
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const cpu_words = Array<Type::CPU>();
+        TrackerRanges tracker_ranges;
         for (u64 word_index = 0; word_index < num_words; ++word_index) {
+            word_index = FindNonZeroWord(cached_words, cached_words, word_index, num_words);
+            if (word_index == num_words) {
+                break;
+            }
             const u64 cached_bits = cached_words[word_index];
-            NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits);
+            CollectTrackerRanges<false>(word_index, untracked_words[word_index], cached_bits,
+                                        tracker_ranges);
             untracked_words[word_index] |= cached_bits;
             cpu_words[word_index] |= cached_bits;
             cached_words[word_index] = 0;
         }
+        NotifyTracker<false>(tracker_ranges);
     }
 
 private:
+    using TrackerRanges = boost::container::small_vector<std::pair<VAddr, size_t>, 16>;
+
     template <Type type>
     u64* Array() noexcept {
         if constexpr (type == Type::CPU) {
@@ -469,14 +545,36 @@ private:
      */
     template <bool add_to_tracker>
     void NotifyRasterizer(u64 word_index, u64 current_bits, u64 new_bits) const {
+        TrackerRanges ranges;
+        CollectTrackerRanges<add_to_tracker>(word_index, current_bits, new_bits, ranges);
+        NotifyTracker<add_to_tracker>(ranges);
+    }
+
+    /// Appends the pages of a word whose tracking state changes, merging contiguous pages
+    template <bool add_to_tracker>
+    void CollectTrackerRanges(u64 word_index, u64 current_bits, u64 new_bits,
+                              TrackerRanges& ranges) const {
         u64 changed_bits = (add_to_tracker ? current_bits : ~current_bits) & new_bits;
         VAddr addr = cpu_addr + word_index * BYTES_PER_WORD;
         IteratePages(changed_bits, [&](size_t offset, size_t size) {
-            tracker->UpdatePagesCachedCount(addr + offset * BYTES_PER_PAGE, size * BYTES_PER_PAGE,
-                                            add_to_tracker ? 1 : -1);
+            const VAddr range_addr = addr + offset * BYTES_PER_PAGE;
+            if (!ranges.empty() && ranges.back().first + ranges.back().second == range_addr) {
+                ranges.back().second += size * BYTES_PER_PAGE;
+                return;
+            }
+            ranges.emplace_back(range_addr, size * BYTES_PER_PAGE);
         });
     }
 
+    /// Notifies the tracker about all the collected ranges at once
+    template <bool add_to_tracker>
+    void NotifyTracker(const TrackerRanges& ranges) const {
+        if (ranges.empty()) {
+            return;
+        }
+        tracker->UpdatePagesCachedBatch({ranges.data(), ranges.size()}, add_to_tracker ? 1 : -1);
+    }
+
     VAddr cpu_addr = 0;
     DeviceTracker* tracker = nullptr;
     Words<stack_words> words;
@@ -19,7 +19,10 @@ CDmaPusher::CDmaPusher(Host1x::Host1x& host1x_)
       host1x_processor(std::make_unique<Host1x::Control>(host1x)),
       sync_manager(std::make_unique<Host1x::SyncptIncrManager>(host1x)) {}
 
-CDmaPusher::~CDmaPusher() = default;
+CDmaPusher::~CDmaPusher() {
+    // Pending decodes signal syncpoints through the sync manager when they complete.
+    nvdec_processor->WaitIdle();
+}
 
 void CDmaPusher::ProcessEntries(ChCommandHeaderList&& entries) {
     for (const auto& value : entries) {
@@ -79,8 +82,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // Frames are decoded asynchronously, the syncpoint is reached once they are done.
+                const u32 handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                nvdec_processor->SignalWhenDone(
+                    [this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
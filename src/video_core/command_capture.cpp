@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <ctime>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/command_capture.h"
+
+namespace Tegra {
+
+CommandCapture::CommandCapture(u32 num_frames_) : num_frames{num_frames_} {}
+
+void CommandCapture::RecordSegment(s32 channel, GPUVAddr address, std::span<const u32> words) {
+    if (has_finished) {
+        return;
+    }
+    const RecordHeader header{
+        .type = RecordType::Segment,
+        .channel = channel,
+        .address = address,
+        .num_words = words.size(),
+    };
+    Write(header, std::span(reinterpret_cast<const u8*>(words.data()), words.size_bytes()));
+}
+
+void CommandCapture::EndFrame() {
+    if (has_finished || !file.IsOpen()) {
+        return;
+    }
+    Write(RecordHeader{
+        .type = RecordType::FrameEnd,
+        .channel = -1,
+        .address = 0,
+        .num_words = 0,
+    });
+    if (++frame >= num_frames) {
+        LOG_INFO(HW_GPU, "Captured the command stream of {} frames", frame);
+        Finish();
+    }
+}
+
+void CommandCapture::Open() {
+    const std::time_t t = std::time(nullptr);
+    // %F Date format expanded is "%Y-%m-%d"
+    const auto filename = fmt::format("{:%F-%H-%M}_commands.bin", *std::localtime(&t));
+    const auto filepath =
+        Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "gpu_commands" / filename;
+    if (Common::FS::CreateParentDirs(filepath)) {
+        file.Open(filepath, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    }
+    static constexpr std::array<char, 4> magic{'Y', 'Z', 'G', 'C'};
+    if (!file.IsOpen() || !file.WriteObject(magic) || !file.WriteObject(VERSION)) {
+        LOG_ERROR(HW_GPU, "Failed to create command capture file \"{}\"",
+                  Common::FS::PathToUTF8String(filepath));
+        Finish();
+        return;
+    }
+    LOG_INFO(HW_GPU, "Capturing the command stream of {} frames to \"{}\"", num_frames,
+             Common::FS::PathToUTF8String(filepath));
+}
+
+void CommandCapture::Write(const RecordHeader& header, std::span<const u8> payload) {
+    if (!file.IsOpen()) {
+        Open();
+        if (!file.IsOpen()) {
+            return;
+        }
+    }
+    if (!file.WriteObject(header) || file.WriteSpan(payload) != payload.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write command capture, stopping it");
+        Finish();
+    }
+}
+
+void CommandCapture::Finish() {
+    file.Close();
+    has_finished = true;
+}
+
+} // namespace Tegra
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+
+namespace Tegra {
+
+/**
+ * Records the pushbuffer segments executed by the GPU into a file in the dump directory.
+ *
+ * The file starts with the magic "YZGC" and a version, followed by records made of a
+ * CommandCapture::RecordHeader and, for segments, the raw command words. Capturing starts with
+ * the first command list, so macro uploads and all other state setup done through the command
+ * stream are part of it.
+ */
+class CommandCapture {
+public:
+    enum class RecordType : u32 {
+        Segment = 1, ///< Command words processed by a channel, followed by the words themselves
+        FrameEnd = 2,
+    };
+
+    struct RecordHeader {
+        RecordType type;
+        s32 channel;
+        u64 address; ///< GPU address of the segment, zero for prefetched command lists
+        u64 num_words;
+    };
+    static_assert(sizeof(RecordHeader) == 24, "RecordHeader has an invalid size");
+
+    static constexpr u32 VERSION = 1;
+
+    explicit CommandCapture(u32 num_frames_);
+
+    /// Returns true while frames are still being captured
+    [[nodiscard]] bool IsCapturing() const {
+        return !has_finished;
+    }
+
+    /// Records a segment of commands about to be processed by a channel
+    void RecordSegment(s32 channel, GPUVAddr address, std::span<const u32> words);
+
+    /// Marks the end of a guest frame, closing the file once enough frames have been captured
+    void EndFrame();
+
+private:
+    void Open();
+
+    void Write(const RecordHeader& header, std::span<const u8> payload = {});
+
+    void Finish();
+
+    Common::FS::IOFile file;
+    u32 num_frames;
+    u32 frame{};
+    bool has_finished{};
+};
+
+} // namespace Tegra
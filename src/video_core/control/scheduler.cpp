@@ -14,6 +14,9 @@ Scheduler::Scheduler(GPU& gpu_) : gpu{gpu_} {}
 Scheduler::~Scheduler() = default;
 
 void Scheduler::Push(s32 channel, CommandList&& entries) {
+    // Channels are processed one at a time. Their engines call into the same rasterizer and its
+    // buffer, texture and query caches, which are not thread safe, and memory written by one
+    // channel is only visible to the others in submission order.
     std::unique_lock lk(scheduling_guard);
     auto it = channels.find(channel);
     ASSERT(it != channels.end());
@@ -5,7 +5,10 @@
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "video_core/command_capture.h"
+#include "video_core/control/channel_state.h"
 #include "video_core/dma_pusher.h"
+#include "video_core/engines/draw_manager.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
 #include "video_core/guest_memory.h"
@@ -18,8 +21,8 @@ constexpr u32 ComputeInline = 0x6D;
 
 DmaPusher::DmaPusher(Core::System& system_, GPU& gpu_, MemoryManager& memory_manager_,
                      Control::ChannelState& channel_state_)
-    : gpu{gpu_}, system{system_}, memory_manager{memory_manager_}, puller{gpu_, memory_manager_,
-                                                                          *this, channel_state_} {}
+    : gpu{gpu_}, system{system_}, memory_manager{memory_manager_}, channel_state{channel_state_},
+      puller{gpu_, memory_manager_, *this, channel_state_} {}
 
 DmaPusher::~DmaPusher() = default;
 
@@ -37,6 +40,7 @@ void DmaPusher::DispatchCalls() {
             break;
         }
     }
+    FlushPendingDraws();
     gpu.FlushCommands();
     gpu.OnCommandListEnd();
 }
@@ -49,19 +53,36 @@ bool DmaPusher::Step() {
 
     CommandList& command_list{dma_pushbuffer.front()};
 
-    ASSERT_OR_EXECUTE(
-        command_list.command_lists.size() || command_list.prefetch_command_list.size(), {
-            // Somehow the command_list is empty, in order to avoid a crash
-            // We ignore it and assume its size is 0.
+    ASSERT_OR_EXECUTE(command_list.command_lists.size() ||
+                          command_list.prefetch_command_list.size() ||
+                          command_list.epilogue_command_list.size(),
+                      {
+                          // Somehow the command_list is empty, in order to avoid a crash
+                          // We ignore it and assume its size is 0.
+                          dma_pushbuffer.pop();
+                          dma_pushbuffer_subindex = 0;
+                          return true;
+                      });
+
+    // Runs the epilogue of the current list next if it has one, otherwise moves to the next list
+    const auto finish_command_list = [&] {
+        dma_pushbuffer_subindex = 0;
+        if (command_list.epilogue_command_list.empty()) {
             dma_pushbuffer.pop();
-            dma_pushbuffer_subindex = 0;
-            return true;
-        });
+            return;
+        }
+        command_list.prefetch_command_list = std::move(command_list.epilogue_command_list);
+        command_list.epilogue_command_list.clear();
+        command_list.command_lists.clear();
+    };
 
-    if (command_list.prefetch_command_list.size()) {
+    if (command_list.prefetch_command_list.size() || command_list.command_lists.empty()) {
         // Prefetched command list from nvdrv, used for things like synchronization
         ProcessCommands(command_list.prefetch_command_list);
-        dma_pushbuffer.pop();
+        command_list.prefetch_command_list.clear();
+        if (command_list.command_lists.empty()) {
+            finish_command_list();
+        }
     } else {
         const CommandListHeader command_list_header{
             command_list.command_lists[dma_pushbuffer_subindex++]};
@@ -69,8 +90,7 @@ bool DmaPusher::Step() {
 
         if (dma_pushbuffer_subindex >= command_list.command_lists.size()) {
             // We've gone through the current list, remove it from the queue
-            dma_pushbuffer.pop();
-            dma_pushbuffer_subindex = 0;
+            finish_command_list();
         }
 
         if (command_list_header.size == 0) {
@@ -84,39 +104,75 @@ bool DmaPusher::Step() {
                     dma_state.dma_get, command_list_header.size * sizeof(u32));
             }
         }
-        const auto safe_process = [&] {
-            Tegra::Memory::GpuGuestMemory<Tegra::CommandHeader,
-                                          Tegra::Memory::GuestMemoryFlags::SafeRead>
-                headers(memory_manager, dma_state.dma_get, command_list_header.size,
-                        &command_headers);
-            ProcessCommands(headers);
-        };
-        const auto unsafe_process = [&] {
-            Tegra::Memory::GpuGuestMemory<Tegra::CommandHeader,
-                                          Tegra::Memory::GuestMemoryFlags::UnsafeRead>
-                headers(memory_manager, dma_state.dma_get, command_list_header.size,
-                        &command_headers);
-            ProcessCommands(headers);
+        const auto process = [&](bool safe) {
+            ProcessSegment(dma_state.dma_get, command_list_header.size, safe);
         };
         if (Settings::IsGPULevelHigh()) {
             if (dma_state.method >= MacroRegistersStart) {
-                unsafe_process();
+                process(false);
                 return true;
             }
             if (subchannel_type[dma_state.subchannel] == Engines::EngineTypes::KeplerCompute &&
                 dma_state.method == ComputeInline) {
-                unsafe_process();
+                process(false);
                 return true;
             }
-            safe_process();
+            process(true);
             return true;
         }
-        unsafe_process();
+        process(false);
     }
     return true;
 }
 
+void DmaPusher::ProcessSegment(GPUVAddr address, std::size_t num_words, bool safe) {
+    const auto process_in_place = [&](const u8* pointer, std::size_t words) {
+        if (safe) {
+            memory_manager.FlushRegion(address, words * sizeof(CommandHeader));
+        }
+        dma_state.dma_get = address;
+        ProcessCommands(std::span(reinterpret_cast<const CommandHeader*>(pointer), words));
+    };
+    if (const u8* const pointer = memory_manager.GetSpan(address, num_words * sizeof(u32))) {
+        // Common case, the whole segment is contiguous in host memory
+        process_in_place(pointer, num_words);
+        return;
+    }
+    // Parse each host contiguous run in place, only copying what can't be accessed directly
+    while (num_words > 0) {
+        const std::size_t run_words =
+            memory_manager.MaxContinuousRange(address, num_words * sizeof(u32)) / sizeof(u32);
+        const u8* const pointer =
+            run_words > 0 ? memory_manager.GetSpan(address, run_words * sizeof(u32)) : nullptr;
+        if (!pointer) {
+            break;
+        }
+        process_in_place(pointer, run_words);
+        address += run_words * sizeof(u32);
+        num_words -= run_words;
+    }
+    if (num_words == 0) {
+        return;
+    }
+    dma_state.dma_get = address;
+    if (safe) {
+        Tegra::Memory::GpuGuestMemory<Tegra::CommandHeader,
+                                      Tegra::Memory::GuestMemoryFlags::SafeRead>
+            headers(memory_manager, address, num_words, &command_headers);
+        ProcessCommands(headers);
+    } else {
+        Tegra::Memory::GpuGuestMemory<Tegra::CommandHeader,
+                                      Tegra::Memory::GuestMemoryFlags::UnsafeRead>
+            headers(memory_manager, address, num_words, &command_headers);
+        ProcessCommands(headers);
+    }
+}
+
 void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
+    if (CommandCapture* const capture = gpu.GetCommandCapture()) [[unlikely]] {
+        const std::span words(reinterpret_cast<const u32*>(commands.data()), commands.size());
+        capture->RecordSegment(channel_state.bind_id, dma_state.dma_get, words);
+    }
     for (std::size_t index = 0; index < commands.size();) {
         const CommandHeader& command_header = commands[index];
 
@@ -188,6 +244,7 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
 
 void DmaPusher::CallMethod(u32 argument) const {
     if (dma_state.method < non_puller_methods) {
+        FlushPendingDraws();
         puller.CallPullerMethod(Engines::Puller::MethodCall{
             dma_state.method,
             argument,
@@ -200,6 +257,9 @@ void DmaPusher::CallMethod(u32 argument) const {
             subchannel->method_sink.emplace_back(dma_state.method, argument);
             return;
         }
+        if (subchannel_type[dma_state.subchannel] != Engines::EngineTypes::Maxwell3D) {
+            FlushPendingDraws();
+        }
         subchannel->ConsumeSink();
         subchannel->current_dma_segment = dma_state.dma_get + dma_state.dma_word_offset;
         subchannel->CallMethod(dma_state.method, argument, dma_state.is_last_call);
@@ -208,10 +268,14 @@ void DmaPusher::CallMethod(u32 argument) const {
 
 void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     if (dma_state.method < non_puller_methods) {
+        FlushPendingDraws();
         puller.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                                dma_state.method_count);
     } else {
         auto subchannel = subchannels[dma_state.subchannel];
+        if (subchannel_type[dma_state.subchannel] != Engines::EngineTypes::Maxwell3D) {
+            FlushPendingDraws();
+        }
         subchannel->ConsumeSink();
         subchannel->current_dma_segment = dma_state.dma_get + dma_state.dma_word_offset;
         subchannel->CallMultiMethod(dma_state.method, base_start, num_methods,
@@ -219,6 +283,10 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+void DmaPusher::FlushPendingDraws() const {
+    channel_state.maxwell_3d->draw_manager->FlushDraws();
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
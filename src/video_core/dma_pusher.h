@@ -108,7 +108,10 @@ struct CommandList final {
         : prefetch_command_list{std::move(prefetch_command_list_)} {}
 
     boost::container::small_vector<CommandListHeader, 512> command_lists;
+    /// Commands from nvdrv executed before command_lists, used for things like synchronization
     boost::container::small_vector<CommandHeader, 512> prefetch_command_list;
+    /// Commands from nvdrv executed after command_lists, so a whole submission is pushed at once
+    boost::container::small_vector<CommandHeader, 512> epilogue_command_list;
 };
 
 /**
@@ -142,6 +145,11 @@ private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
     bool Step();
+
+    /// Processes a pushbuffer segment in place where it is contiguous in host memory, copying the
+    /// rest into command_headers
+    void ProcessSegment(GPUVAddr address, std::size_t num_words, bool safe);
+
     void ProcessCommands(std::span<const CommandHeader> commands);
 
     void SetState(const CommandHeader& command_header);
@@ -149,8 +157,11 @@ private:
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
+    /// Submits the 3D draws held back for coalescing before other engines can observe memory
+    void FlushPendingDraws() const;
+
     Common::ScratchBuffer<CommandHeader>
-        command_headers; ///< Buffer for list of commands fetched at once
+        command_headers; ///< Buffer for commands that are not contiguous in host memory
 
     std::queue<CommandList> dma_pushbuffer; ///< Queue of command lists to be processed
     std::size_t dma_pushbuffer_subindex{};  ///< Index within a command list within the pushbuffer
@@ -177,6 +188,7 @@ private:
     GPU& gpu;
     Core::System& system;
     MemoryManager& memory_manager;
+    Control::ChannelState& channel_state;
     mutable Engines::Puller puller;
 };
 
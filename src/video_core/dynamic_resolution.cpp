@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "common/settings.h"
+#include "video_core/dynamic_resolution.h"
+
+namespace VideoCommon {
+namespace {
+// Number of frames averaged before deciding
+constexpr u32 WINDOW_FRAMES = 30;
+// Consecutive windows needed to step down or up, stepping up is slower to avoid oscillating
+constexpr u32 WINDOWS_TO_STEP_DOWN = 2;
+constexpr u32 WINDOWS_TO_STEP_UP = 4;
+// Windows ignored after a change
+constexpr u32 WINDOWS_TO_SETTLE = 2;
+// Fractions of the budget the GPU time has to exceed to step down, and the time predicted for
+// the next scale has to stay under to step up
+constexpr double STEP_DOWN_THRESHOLD = 0.95;
+constexpr double STEP_UP_THRESHOLD = 0.80;
+
+using Settings::ResolutionSetup;
+
+ResolutionSetup Step(ResolutionSetup setup, int step) {
+    return static_cast<ResolutionSetup>(static_cast<int>(setup) + step);
+}
+
+/// Returns the number of pixels of a scale relative to native resolution
+double PixelRatio(ResolutionSetup setup) {
+    Settings::ResolutionScalingInfo info;
+    Settings::TranslateResolutionInfo(setup, info);
+    return static_cast<double>(info.up_factor) * static_cast<double>(info.up_factor);
+}
+} // Anonymous namespace
+
+DynamicResolution::DynamicResolution(ResolutionSetup min_setup_, ResolutionSetup max_setup_,
+                                     u32 target_fps)
+    : min_setup{std::min(min_setup_, max_setup_)}, max_setup{max_setup_}, current{max_setup_},
+      budget_nanoseconds{1'000'000'000ULL / std::max(target_fps, 1U)} {}
+
+std::optional<ResolutionSetup> DynamicResolution::AddFrame(u64 gpu_nanoseconds) {
+    // Frames without measurements don't tell anything about the load
+    if (gpu_nanoseconds == 0) {
+        return std::nullopt;
+    }
+    window_nanoseconds += gpu_nanoseconds;
+    if (++window_frames < WINDOW_FRAMES) {
+        return std::nullopt;
+    }
+    const u64 average_nanoseconds = window_nanoseconds / window_frames;
+    window_nanoseconds = 0;
+    window_frames = 0;
+    if (windows_to_skip > 0) {
+        --windows_to_skip;
+        return std::nullopt;
+    }
+    const std::optional<ResolutionSetup> next = EvaluateWindow(average_nanoseconds);
+    if (next) {
+        current = *next;
+        windows_over = 0;
+        windows_under = 0;
+        windows_to_skip = WINDOWS_TO_SETTLE;
+    }
+    return next;
+}
+
+std::optional<ResolutionSetup> DynamicResolution::EvaluateWindow(u64 average_nanoseconds) {
+    const double budget = static_cast<double>(budget_nanoseconds);
+    const double average = static_cast<double>(average_nanoseconds);
+    if (average > budget * STEP_DOWN_THRESHOLD) {
+        windows_under = 0;
+        if (current > min_setup && ++windows_over >= WINDOWS_TO_STEP_DOWN) {
+            return Step(current, -1);
+        }
+        return std::nullopt;
+    }
+    windows_over = 0;
+    if (current >= max_setup) {
+        return std::nullopt;
+    }
+    // Assume the whole frame scales with the number of pixels, which overestimates the cost
+    const ResolutionSetup next = Step(current, 1);
+    const double predicted = average * PixelRatio(next) / PixelRatio(current);
+    if (predicted >= budget * STEP_UP_THRESHOLD) {
+        windows_under = 0;
+        return std::nullopt;
+    }
+    if (++windows_under >= WINDOWS_TO_STEP_UP) {
+        return next;
+    }
+    return std::nullopt;
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+
+#include "common/common_types.h"
+#include "common/settings_enums.h"
+
+namespace VideoCommon {
+
+/**
+ * Picks the resolution scale of rescaled render targets from the GPU time of recent frames.
+ * Frames are averaged in windows, the scale steps down after consecutive windows over the frame
+ * time budget and steps up after consecutive windows where the next scale is expected to fit
+ * with some headroom. The windows right after a change are ignored, they include the cost of
+ * rescaling images and building pipelines for the new scale.
+ */
+class DynamicResolution {
+public:
+    explicit DynamicResolution(Settings::ResolutionSetup min_setup,
+                               Settings::ResolutionSetup max_setup, u32 target_fps);
+
+    /// Adds the GPU time of a frame, returns the scale to switch to when it has to change
+    [[nodiscard]] std::optional<Settings::ResolutionSetup> AddFrame(u64 gpu_nanoseconds);
+
+    [[nodiscard]] Settings::ResolutionSetup Current() const noexcept {
+        return current;
+    }
+
+private:
+    std::optional<Settings::ResolutionSetup> EvaluateWindow(u64 average_nanoseconds);
+
+    Settings::ResolutionSetup min_setup;
+    Settings::ResolutionSetup max_setup;
+    Settings::ResolutionSetup current;
+    u64 budget_nanoseconds;
+
+    u64 window_nanoseconds = 0;
+    u32 window_frames = 0;
+    u32 windows_over = 0;
+    u32 windows_under = 0;
+    u32 windows_to_skip = 0;
+};
+
+} // namespace VideoCommon
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/settings.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/draw_manager.h"
@@ -68,6 +70,7 @@ void DrawManager::ProcessMethodCall(u32 method, u32 argument) {
 }
 
 void DrawManager::Clear(u32 layer_count) {
+    FlushDraws();
     if (maxwell3d->ShouldExecute()) {
         maxwell3d->rasterizer->Clear(layer_count);
     }
@@ -120,6 +123,12 @@ void DrawManager::DrawIndex(PrimitiveTopology topology, u32 index_first, u32 ind
 
 void DrawManager::DrawArrayIndirect(PrimitiveTopology topology) {
     draw_state.topology = topology;
+    if (indirect_state.is_byte_count) {
+        // The vertex count lives in GPU memory, bound it by the enabled vertex streams so
+        // emulated quad index buffers cover every vertex the draw can reach
+        draw_state.vertex_buffer.first = 0;
+        draw_state.vertex_buffer.count = maxwell3d->GetMaxCurrentVertices();
+    }
 
     ProcessDrawIndirect();
 }
@@ -173,10 +182,11 @@ void DrawManager::DrawEnd(u32 instance_count, bool force_draw) {
         draw_state.base_index = regs.global_base_vertex_index;
         if (draw_state.draw_indexed) {
             draw_state.index_buffer = regs.index_buffer;
-            ProcessDraw(true, instance_count);
         } else {
             draw_state.vertex_buffer = regs.vertex_buffer;
-            ProcessDraw(false, instance_count);
+        }
+        if (!TryCoalesceDraw(draw_state.draw_indexed, instance_count)) {
+            ProcessDraw(draw_state.draw_indexed, instance_count);
         }
         draw_state.draw_indexed = false;
         break;
@@ -231,6 +241,7 @@ void DrawManager::DrawTexture() {
         draw_texture_state.src_y0;
     draw_texture_state.src_sampler = regs.draw_texture.src_sampler;
     draw_texture_state.src_texture = regs.draw_texture.src_texture;
+    FlushDraws();
     maxwell3d->rasterizer->DrawTexture();
 }
 
@@ -265,6 +276,7 @@ void DrawManager::ProcessDraw(bool draw_indexed, u32 instance_count) {
               draw_indexed ? draw_state.index_buffer.count : draw_state.vertex_buffer.count);
 
     UpdateTopology();
+    FlushDraws();
 
     if (maxwell3d->ShouldExecute()) {
         maxwell3d->rasterizer->Draw(draw_indexed, instance_count);
@@ -279,9 +291,76 @@ void DrawManager::ProcessDrawIndirect() {
         indirect_state.buffer_size, indirect_state.max_draw_counts);
 
     UpdateTopology();
+    FlushDraws();
 
     if (maxwell3d->ShouldExecute()) {
         maxwell3d->rasterizer->DrawIndirect();
     }
 }
+
+bool DrawManager::TryCoalesceDraw(bool draw_indexed, u32 instance_count) {
+    if (draw_state.draw_mode != DrawMode::General || !maxwell3d->ShouldExecute() ||
+        !maxwell3d->rasterizer->SupportsDrawCoalescing()) {
+        return false;
+    }
+    UpdateTopology();
+    // Quads, and 8-bit indices on some hosts, are expanded from a single first and count
+    if (draw_state.topology == PrimitiveTopology::Quads ||
+        draw_state.topology == PrimitiveTopology::QuadStrip) {
+        return false;
+    }
+    if (draw_indexed &&
+        draw_state.index_buffer.format == Maxwell3D::Regs::IndexFormat::UnsignedByte) {
+        return false;
+    }
+    const DrawRange range =
+        draw_indexed ? DrawRange{draw_state.index_buffer.first, draw_state.index_buffer.count}
+                     : DrawRange{draw_state.vertex_buffer.first, draw_state.vertex_buffer.count};
+    auto& pending_draws = pending_draw_state.coalesced_draws;
+    if (!pending_draws.empty()) {
+        // Every other register write flushes the pending run, so only what is carried by the
+        // draw methods themselves has to be compared here
+        if (pending_draw_state.draw_indexed == draw_indexed &&
+            pending_draw_state.topology == draw_state.topology &&
+            pending_instance_count == instance_count &&
+            pending_draws.size() < MAX_COALESCED_DRAWS) {
+            pending_draws.push_back(range);
+            return true;
+        }
+        SubmitCoalescedDraws();
+    }
+    pending_draw_state = draw_state;
+    pending_draw_state.draw_indexed = draw_indexed;
+    pending_draw_state.coalesced_draws.push_back(range);
+    pending_instance_count = instance_count;
+    return true;
+}
+
+void DrawManager::SubmitCoalescedDraws() {
+    auto& pending_draws = pending_draw_state.coalesced_draws;
+    const bool draw_indexed = pending_draw_state.draw_indexed;
+    if (pending_draws.size() > 1) {
+        // Buffers are bound for the union of all ranges, each draw picks its own part of it
+        u32 first = pending_draws.front().first;
+        u32 end = first;
+        for (const DrawRange& range : pending_draws) {
+            first = std::min(first, range.first);
+            end = std::max(end, range.first + range.count);
+        }
+        if (draw_indexed) {
+            pending_draw_state.index_buffer.first = first;
+            pending_draw_state.index_buffer.count = end - first;
+            maxwell3d->dirty.flags[VideoCommon::Dirty::IndexBuffer] = true;
+        } else {
+            pending_draw_state.vertex_buffer.first = first;
+            pending_draw_state.vertex_buffer.count = end - first;
+        }
+    } else {
+        pending_draws.clear();
+    }
+    std::swap(draw_state, pending_draw_state);
+    maxwell3d->rasterizer->Draw(draw_indexed, pending_instance_count);
+    std::swap(draw_state, pending_draw_state);
+    pending_draw_state.coalesced_draws.clear();
+}
 } // namespace Tegra::Engines
@@ -20,6 +20,13 @@ using IndexBufferSmall = Maxwell3D::Regs::IndexBufferSmall;
 class DrawManager {
 public:
     enum class DrawMode : u32 { General = 0, Instance, InlineIndex };
+
+    /// First element and element count of one guest draw inside a coalesced run
+    struct DrawRange {
+        u32 first;
+        u32 count;
+    };
+
     struct State {
         PrimitiveTopology topology{};
         DrawMode draw_mode{};
@@ -30,6 +37,8 @@ public:
         u32 base_instance{};
         u32 instance_count{};
         std::vector<u8> inline_index_draw_indexes;
+        /// Guest draws merged into this host draw, empty when it is a single draw
+        std::vector<DrawRange> coalesced_draws;
     };
 
     struct DrawTextureState {
@@ -76,6 +85,14 @@ public:
 
     void DrawIndexedIndirect(PrimitiveTopology topology, u32 index_first, u32 index_count);
 
+    /// Submits the draws held back for coalescing. Must be called before anything that is not a
+    /// draw parameter write can observe or modify the state they were recorded with.
+    void FlushDraws() {
+        if (!pending_draw_state.coalesced_draws.empty()) {
+            SubmitCoalescedDraws();
+        }
+    }
+
     const State& GetDrawState() const {
         return draw_state;
     }
@@ -109,8 +126,16 @@ private:
 
     void ProcessDrawIndirect();
 
+    bool TryCoalesceDraw(bool draw_indexed, u32 instance_count);
+
+    void SubmitCoalescedDraws();
+
+    static constexpr size_t MAX_COALESCED_DRAWS = 256;
+
     Maxwell3D* maxwell3d{};
     State draw_state{};
+    State pending_draw_state{};
+    u32 pending_instance_count{};
     DrawTextureState draw_texture_state{};
     IndirectParams indirect_state{};
 };
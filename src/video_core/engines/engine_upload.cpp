@@ -41,12 +41,28 @@ void State::ProcessData(const u32 data, const bool is_last_call) {
 
 void State::ProcessData(const u32* data, size_t num_data) {
     std::span<const u8> read_buffer(reinterpret_cast<const u8*>(data), num_data * sizeof(u32));
-    ProcessData(read_buffer);
+    if (write_offset == 0 && read_buffer.size() >= copy_size) {
+        // The whole upload is in this span of the pushbuffer, consume it in place
+        ProcessData(read_buffer.first(copy_size));
+        return;
+    }
+    // The upload was split across pushbuffer segments, gather it before processing
+    const u32 sub_copy_size =
+        std::min(static_cast<u32>(read_buffer.size()), copy_size - write_offset);
+    std::memcpy(&inner_buffer[write_offset], read_buffer.data(), sub_copy_size);
+    write_offset += sub_copy_size;
+    if (write_offset < copy_size) {
+        return;
+    }
+    ProcessData(inner_buffer);
 }
 
 void State::ProcessData(std::span<const u8> read_buffer) {
     const GPUVAddr address{regs.dest.Address()};
-    if (is_linear) {
+    if (is_linear && (regs.line_count == 1 || regs.dest.pitch == regs.line_length_in)) {
+        // Tightly packed lines are contiguous in guest memory, upload them at once
+        rasterizer->AccelerateInlineToMemory(address, copy_size, read_buffer);
+    } else if (is_linear) {
         for (size_t line = 0; line < regs.line_count; ++line) {
             const GPUVAddr dest_line = address + line * regs.dest.pitch;
             std::span<const u8> buffer(read_buffer.data() + line * regs.line_length_in,
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
@@ -22,6 +23,99 @@ namespace Tegra::Engines {
 /// First register id that is actually a Macro call.
 constexpr u32 MacroRegistersStart = 0xE00;
 
+namespace {
+constexpr bool IsMethodExecutable(u32 method) {
+    if (method >= MacroRegistersStart) {
+        return true;
+    }
+    switch (method) {
+    case MAXWELL3D_REG_INDEX(draw.end):
+    case MAXWELL3D_REG_INDEX(draw.begin):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.first):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.count):
+    case MAXWELL3D_REG_INDEX(index_buffer.first):
+    case MAXWELL3D_REG_INDEX(index_buffer.count):
+    case MAXWELL3D_REG_INDEX(draw_inline_index):
+    case MAXWELL3D_REG_INDEX(index_buffer32_subsequent):
+    case MAXWELL3D_REG_INDEX(index_buffer16_subsequent):
+    case MAXWELL3D_REG_INDEX(index_buffer8_subsequent):
+    case MAXWELL3D_REG_INDEX(index_buffer32_first):
+    case MAXWELL3D_REG_INDEX(index_buffer16_first):
+    case MAXWELL3D_REG_INDEX(index_buffer8_first):
+    case MAXWELL3D_REG_INDEX(inline_index_2x16.even):
+    case MAXWELL3D_REG_INDEX(inline_index_4x8.index0):
+    case MAXWELL3D_REG_INDEX(vertex_array_instance_first):
+    case MAXWELL3D_REG_INDEX(vertex_array_instance_subsequent):
+    case MAXWELL3D_REG_INDEX(draw_texture.src_y0):
+    case MAXWELL3D_REG_INDEX(wait_for_idle):
+    case MAXWELL3D_REG_INDEX(shadow_ram_control):
+    case MAXWELL3D_REG_INDEX(load_mme.instruction_ptr):
+    case MAXWELL3D_REG_INDEX(load_mme.instruction):
+    case MAXWELL3D_REG_INDEX(load_mme.start_address):
+    case MAXWELL3D_REG_INDEX(falcon[4]):
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer):
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 1:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 2:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 3:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 4:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 5:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 6:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 7:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 8:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 9:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 10:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 11:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 12:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 13:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 14:
+    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 15:
+    case MAXWELL3D_REG_INDEX(bind_groups[0].raw_config):
+    case MAXWELL3D_REG_INDEX(bind_groups[1].raw_config):
+    case MAXWELL3D_REG_INDEX(bind_groups[2].raw_config):
+    case MAXWELL3D_REG_INDEX(bind_groups[3].raw_config):
+    case MAXWELL3D_REG_INDEX(bind_groups[4].raw_config):
+    case MAXWELL3D_REG_INDEX(topology_override):
+    case MAXWELL3D_REG_INDEX(clear_surface):
+    case MAXWELL3D_REG_INDEX(report_semaphore.query):
+    case MAXWELL3D_REG_INDEX(render_enable.mode):
+    case MAXWELL3D_REG_INDEX(clear_report_value):
+    case MAXWELL3D_REG_INDEX(sync_info):
+    case MAXWELL3D_REG_INDEX(launch_dma):
+    case MAXWELL3D_REG_INDEX(inline_data):
+    case MAXWELL3D_REG_INDEX(fragment_barrier):
+    case MAXWELL3D_REG_INDEX(invalidate_texture_data_cache):
+    case MAXWELL3D_REG_INDEX(tiled_cache_barrier):
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns true for the methods that only carry the parameters of the draw they belong to
+constexpr bool IsDrawParameter(u32 method) {
+    switch (method) {
+    case MAXWELL3D_REG_INDEX(draw.end):
+    case MAXWELL3D_REG_INDEX(draw.begin):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.first):
+    case MAXWELL3D_REG_INDEX(vertex_buffer.count):
+    case MAXWELL3D_REG_INDEX(index_buffer.first):
+    case MAXWELL3D_REG_INDEX(index_buffer.count):
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Methods that have side effects besides writing their register, generated at compile time
+constexpr auto EXECUTABLE_METHODS = [] {
+    std::array<bool, Maxwell3D::Regs::NUM_REGS> table{};
+    for (u32 method = 0; method < static_cast<u32>(table.size()); ++method) {
+        table[method] = IsMethodExecutable(method);
+    }
+    return table;
+}();
+} // Anonymous namespace
+
 Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
     : draw_manager{std::make_unique<DrawManager>(this)}, system{system_},
       memory_manager{memory_manager_}, macro_engine{GetMacroEngine(*this)}, upload_state{
@@ -31,7 +125,7 @@ Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
     InitializeRegisterDefaults();
     execution_mask.reset();
     for (size_t i = 0; i < execution_mask.size(); i++) {
-        execution_mask[i] = IsMethodExecutable(static_cast<u32>(i));
+        execution_mask[i] = i >= MacroRegistersStart || EXECUTABLE_METHODS[i];
     }
 }
 
@@ -126,73 +220,6 @@ void Maxwell3D::InitializeRegisterDefaults() {
     shadow_state = regs;
 }
 
-bool Maxwell3D::IsMethodExecutable(u32 method) {
-    if (method >= MacroRegistersStart) {
-        return true;
-    }
-    switch (method) {
-    case MAXWELL3D_REG_INDEX(draw.end):
-    case MAXWELL3D_REG_INDEX(draw.begin):
-    case MAXWELL3D_REG_INDEX(vertex_buffer.first):
-    case MAXWELL3D_REG_INDEX(vertex_buffer.count):
-    case MAXWELL3D_REG_INDEX(index_buffer.first):
-    case MAXWELL3D_REG_INDEX(index_buffer.count):
-    case MAXWELL3D_REG_INDEX(draw_inline_index):
-    case MAXWELL3D_REG_INDEX(index_buffer32_subsequent):
-    case MAXWELL3D_REG_INDEX(index_buffer16_subsequent):
-    case MAXWELL3D_REG_INDEX(index_buffer8_subsequent):
-    case MAXWELL3D_REG_INDEX(index_buffer32_first):
-    case MAXWELL3D_REG_INDEX(index_buffer16_first):
-    case MAXWELL3D_REG_INDEX(index_buffer8_first):
-    case MAXWELL3D_REG_INDEX(inline_index_2x16.even):
-    case MAXWELL3D_REG_INDEX(inline_index_4x8.index0):
-    case MAXWELL3D_REG_INDEX(vertex_array_instance_first):
-    case MAXWELL3D_REG_INDEX(vertex_array_instance_subsequent):
-    case MAXWELL3D_REG_INDEX(draw_texture.src_y0):
-    case MAXWELL3D_REG_INDEX(wait_for_idle):
-    case MAXWELL3D_REG_INDEX(shadow_ram_control):
-    case MAXWELL3D_REG_INDEX(load_mme.instruction_ptr):
-    case MAXWELL3D_REG_INDEX(load_mme.instruction):
-    case MAXWELL3D_REG_INDEX(load_mme.start_address):
-    case MAXWELL3D_REG_INDEX(falcon[4]):
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer):
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 1:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 2:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 3:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 4:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 5:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 6:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 7:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 8:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 9:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 10:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 11:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 12:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 13:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 14:
-    case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 15:
-    case MAXWELL3D_REG_INDEX(bind_groups[0].raw_config):
-    case MAXWELL3D_REG_INDEX(bind_groups[1].raw_config):
-    case MAXWELL3D_REG_INDEX(bind_groups[2].raw_config):
-    case MAXWELL3D_REG_INDEX(bind_groups[3].raw_config):
-    case MAXWELL3D_REG_INDEX(bind_groups[4].raw_config):
-    case MAXWELL3D_REG_INDEX(topology_override):
-    case MAXWELL3D_REG_INDEX(clear_surface):
-    case MAXWELL3D_REG_INDEX(report_semaphore.query):
-    case MAXWELL3D_REG_INDEX(render_enable.mode):
-    case MAXWELL3D_REG_INDEX(clear_report_value):
-    case MAXWELL3D_REG_INDEX(sync_info):
-    case MAXWELL3D_REG_INDEX(launch_dma):
-    case MAXWELL3D_REG_INDEX(inline_data):
-    case MAXWELL3D_REG_INDEX(fragment_barrier):
-    case MAXWELL3D_REG_INDEX(invalidate_texture_data_cache):
-    case MAXWELL3D_REG_INDEX(tiled_cache_barrier):
-        return true;
-    default:
-        return false;
-    }
-}
-
 void Maxwell3D::ProcessMacro(u32 method, const u32* base_start, u32 amount, bool is_last_call) {
     if (executing_macro == 0) {
         // A macro call must begin by writing the macro method's register, not its argument.
@@ -319,6 +346,10 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     if (regs.reg_array[method] == argument) {
         return;
     }
+    if (!IsDrawParameter(method)) {
+        // Draws held back for coalescing were recorded with the previous value
+        draw_manager->FlushDraws();
+    }
     regs.reg_array[method] = argument;
 
     for (const auto& table : dirty.tables) {
@@ -328,6 +359,9 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
 
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
+    if (!IsDrawParameter(method)) {
+        draw_manager->FlushDraws();
+    }
     switch (method) {
     case MAXWELL3D_REG_INDEX(wait_for_idle):
         return rasterizer->WaitForIdle();
@@ -397,6 +431,9 @@ void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argume
 }
 
 void Maxwell3D::CallMacroMethod(u32 method, const std::vector<u32>& parameters) {
+    // HLE macros write registers and call into the rasterizer directly.
+    draw_manager->FlushDraws();
+
     // Reset the current macro.
     executing_macro = 0;
 
@@ -457,14 +494,21 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 13:
     case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 14:
     case MAXWELL3D_REG_INDEX(const_buffer.buffer) + 15:
+        draw_manager->FlushDraws();
         ProcessCBMultiData(base_start, amount);
         break;
     case MAXWELL3D_REG_INDEX(inline_data): {
-        ASSERT(methods_pending == amount);
+        draw_manager->FlushDraws();
         upload_state.ProcessData(base_start, amount);
         return;
     }
     default:
+        if (!EXECUTABLE_METHODS[method]) {
+            // Repeated writes to a plain register only leave the last value behind
+            const u32 last = amount - 1;
+            CallMethod(method, base_start[last], methods_pending - last <= 1);
+            break;
+        }
         for (u32 i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - i <= 1);
         }
@@ -3184,8 +3184,6 @@ private:
 
     void RefreshParametersImpl();
 
-    bool IsMethodExecutable(u32 method);
-
     Core::System& system;
     MemoryManager& memory_manager;
 
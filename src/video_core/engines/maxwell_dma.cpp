@@ -226,6 +226,28 @@ void MaxwellDMA::CopyBlockLinearToPitch() {
 
     const size_t dst_size = dst_operand.pitch * regs.line_count;
 
+    if (depth == 1) {
+        const DMA::BlockLinearCopy block_linear_copy{
+            .pitch_address = dst_operand.address,
+            .block_linear_address = src_operand.address,
+            .pitch_size = dst_size,
+            .block_linear_size = src_size,
+            .pitch = dst_operand.pitch,
+            .bytes_per_pixel = bytes_per_pixel,
+            .width = width,
+            .height = height,
+            .origin_x = x_offset,
+            .origin_y = src_params.origin.y,
+            .extent_x = x_elements,
+            .extent_y = regs.line_count,
+            .block_height = block_height,
+            .block_depth = block_depth,
+        };
+        if (accelerate.BlockLinearToPitch(block_linear_copy)) {
+            return;
+        }
+    }
+
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::SafeRead> tmp_read_buffer(
         memory_manager, src_operand.address, src_size, &read_buffer);
     Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::UnsafeReadCachedWrite>
@@ -288,6 +310,28 @@ void MaxwellDMA::CopyPitchToBlockLinear() {
         CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth);
     const size_t src_size = static_cast<size_t>(regs.pitch_in) * regs.line_count;
 
+    if (depth == 1) {
+        const DMA::BlockLinearCopy block_linear_copy{
+            .pitch_address = src_operand.address,
+            .block_linear_address = dst_operand.address,
+            .pitch_size = src_size,
+            .block_linear_size = dst_size,
+            .pitch = static_cast<u32>(regs.pitch_in),
+            .bytes_per_pixel = bytes_per_pixel,
+            .width = width,
+            .height = height,
+            .origin_x = x_offset,
+            .origin_y = dst_params.origin.y,
+            .extent_x = x_elements,
+            .extent_y = regs.line_count,
+            .block_height = block_height,
+            .block_depth = block_depth,
+        };
+        if (accelerate.PitchToBlockLinear(block_linear_copy)) {
+            return;
+        }
+    }
+
     GPUVAddr src_addr = regs.offset_in;
     GPUVAddr dst_addr = regs.offset_out;
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::SafeRead> tmp_read_buffer(
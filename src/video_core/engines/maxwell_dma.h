@@ -70,6 +70,24 @@ struct BufferOperand {
     GPUVAddr address;
 };
 
+/// Copy between a pitch linear buffer and a single slice of a block linear surface
+struct BlockLinearCopy {
+    GPUVAddr pitch_address;
+    GPUVAddr block_linear_address;
+    u64 pitch_size;
+    u64 block_linear_size;
+    u32 pitch;
+    u32 bytes_per_pixel;
+    u32 width;
+    u32 height;
+    u32 origin_x;
+    u32 origin_y;
+    u32 extent_x;
+    u32 extent_y;
+    u32 block_height;
+    u32 block_depth;
+};
+
 } // namespace DMA
 } // namespace Tegra
 
@@ -87,6 +105,10 @@ public:
 
     virtual bool BufferToImage(const DMA::ImageCopy& copy_info, const DMA::BufferOperand& src,
                                const DMA::ImageOperand& dst) = 0;
+
+    virtual bool BlockLinearToPitch(const DMA::BlockLinearCopy& copy) = 0;
+
+    virtual bool PitchToBlockLinear(const DMA::BlockLinearCopy& copy) = 0;
 };
 
 /**
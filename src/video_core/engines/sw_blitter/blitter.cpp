@@ -3,8 +3,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <span>
 #include <vector>
 
+#include "common/div_ceil.h"
 #include "common/scratch_buffer.h"
 #include "video_core/engines/sw_blitter/blitter.h"
 #include "video_core/engines/sw_blitter/converter.h"
@@ -12,6 +15,7 @@
 #include "video_core/memory_manager.h"
 #include "video_core/surface.h"
 #include "video_core/textures/decoders.h"
+#include "video_core/textures/workers.h"
 
 namespace Tegra {
 class MemoryManager;
@@ -28,85 +32,157 @@ namespace {
 
 constexpr size_t ir_components = 4;
 
-void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_width, u32 src_height,
-                     u32 dst_width, u32 dst_height, size_t bpp) {
-    const size_t dx_du = std::llround((static_cast<f64>(src_width) / dst_width) * (1ULL << 32));
-    const size_t dy_dv = std::llround((static_cast<f64>(src_height) / dst_height) * (1ULL << 32));
-    size_t src_y = 0;
-    for (u32 y = 0; y < dst_height; y++) {
-        size_t src_x = 0;
+// Blits with at least this many pixels are split in bands of rows processed on the thread pool
+constexpr size_t PARALLEL_MIN_PIXELS = 128 * 128;
+constexpr u32 BAND_ROWS = 16;
+
+/// Calls func(first_row, end_row) for bands of rows covering [0, num_rows)
+template <typename Func>
+void ForEachBand(u32 num_rows, u32 row_pixels, Func&& func) {
+    if (static_cast<size_t>(num_rows) * row_pixels < PARALLEL_MIN_PIXELS) {
+        func(0U, num_rows);
+        return;
+    }
+    ParallelFor(Common::DivCeil(num_rows, BAND_ROWS), [&](u32 band) {
+        const u32 first_row = band * BAND_ROWS;
+        func(first_row, std::min(first_row + BAND_ROWS, num_rows));
+    });
+}
+
+/// Returns the 32.32 fixed point step between source texels of consecutive destination texels
+u64 NearestStep(u32 src_size, u32 dst_size) {
+    return std::llround((static_cast<f64>(src_size) / dst_size) * (1ULL << 32));
+}
+
+/// Writes the source column sampled by each destination column
+void NearestColumns(Common::ScratchBuffer<u32>& columns, u32 src_width, u32 dst_width) {
+    const u64 dx_du = NearestStep(src_width, dst_width);
+    columns.resize_destructive(dst_width);
+    for (u32 x = 0; x < dst_width; x++) {
+        columns[x] = static_cast<u32>((x * dx_du) >> 32);
+    }
+}
+
+template <size_t bpp>
+void NearestNeighborRows(const u8* input, u8* output, u32 src_width, u32 dst_width,
+                         std::span<const u32> columns, u64 dy_dv, u32 first_row, u32 end_row) {
+    for (u32 y = first_row; y < end_row; y++) {
+        const u8* const src_row = input + ((y * dy_dv) >> 32) * src_width * bpp;
+        u8* const dst_row = output + static_cast<size_t>(y) * dst_width * bpp;
         for (u32 x = 0; x < dst_width; x++) {
-            const size_t read_from = ((src_y * src_width + src_x) >> 32) * bpp;
-            const size_t write_to = (y * dst_width + x) * bpp;
+            std::memcpy(dst_row + x * bpp, src_row + columns[x] * bpp, bpp);
+        }
+    }
+}
 
+void NearestNeighbor(std::span<const u8> input, std::span<u8> output, u32 src_width,
+                     u32 src_height, u32 dst_width, u32 dst_height, size_t bpp,
+                     std::span<const u32> columns, u32 first_row, u32 end_row) {
+    const u64 dy_dv = NearestStep(src_height, dst_height);
+    // Fixed sizes let the copies of a texel compile to single moves
+    switch (bpp) {
+    case 1:
+        return NearestNeighborRows<1>(input.data(), output.data(), src_width, dst_width, columns,
+                                      dy_dv, first_row, end_row);
+    case 2:
+        return NearestNeighborRows<2>(input.data(), output.data(), src_width, dst_width, columns,
+                                      dy_dv, first_row, end_row);
+    case 4:
+        return NearestNeighborRows<4>(input.data(), output.data(), src_width, dst_width, columns,
+                                      dy_dv, first_row, end_row);
+    case 8:
+        return NearestNeighborRows<8>(input.data(), output.data(), src_width, dst_width, columns,
+                                      dy_dv, first_row, end_row);
+    case 16:
+        return NearestNeighborRows<16>(input.data(), output.data(), src_width, dst_width,
+                                       columns, dy_dv, first_row, end_row);
+    }
+    for (u32 y = first_row; y < end_row; y++) {
+        const size_t src_row = ((y * dy_dv) >> 32) * src_width;
+        for (u32 x = 0; x < dst_width; x++) {
+            const size_t read_from = (src_row + columns[x]) * bpp;
+            const size_t write_to = (static_cast<size_t>(y) * dst_width + x) * bpp;
             std::memcpy(&output[write_to], &input[read_from], bpp);
-            src_x += dx_du;
         }
-        src_y += dy_dv;
     }
 }
 
 void NearestNeighborFast(std::span<const f32> input, std::span<f32> output, u32 src_width,
-                         u32 src_height, u32 dst_width, u32 dst_height) {
-    const size_t dx_du = std::llround((static_cast<f64>(src_width) / dst_width) * (1ULL << 32));
-    const size_t dy_dv = std::llround((static_cast<f64>(src_height) / dst_height) * (1ULL << 32));
-    size_t src_y = 0;
-    for (u32 y = 0; y < dst_height; y++) {
-        size_t src_x = 0;
+                         u32 src_height, u32 dst_width, u32 dst_height,
+                         std::span<const u32> columns, u32 first_row, u32 end_row) {
+    const u64 dy_dv = NearestStep(src_height, dst_height);
+    for (u32 y = first_row; y < end_row; y++) {
+        const f32* const src_row = &input[((y * dy_dv) >> 32) * src_width * ir_components];
+        f32* const dst_row = &output[static_cast<size_t>(y) * dst_width * ir_components];
         for (u32 x = 0; x < dst_width; x++) {
-            const size_t read_from = ((src_y * src_width + src_x) >> 32) * ir_components;
-            const size_t write_to = (y * dst_width + x) * ir_components;
-
-            std::memcpy(&output[write_to], &input[read_from], sizeof(f32) * ir_components);
-            src_x += dx_du;
+            std::memcpy(dst_row + x * ir_components, src_row + columns[x] * ir_components,
+                        sizeof(f32) * ir_components);
         }
-        src_y += dy_dv;
     }
 }
 
-void Bilinear(std::span<const f32> input, std::span<f32> output, size_t src_width,
-              size_t src_height, size_t dst_width, size_t dst_height) {
-    const auto bilinear_sample = [](std::span<const f32> x0_y0, std::span<const f32> x1_y0,
-                                    std::span<const f32> x0_y1, std::span<const f32> x1_y1,
-                                    f32 weight_x, f32 weight_y) {
-        std::array<f32, ir_components> result{};
-        for (size_t i = 0; i < ir_components; i++) {
-            const f32 a = std::lerp(x0_y0[i], x1_y0[i], weight_x);
-            const f32 b = std::lerp(x0_y1[i], x1_y1[i], weight_x);
-            result[i] = std::lerp(a, b, weight_y);
+/// Source texels and weight of the second one for a destination coordinate
+struct BilinearTap {
+    u32 low;
+    u32 high;
+    f32 weight;
+};
+
+/// Writes the taps of each destination coordinate, the corners of both sizes are aligned
+void BilinearTaps(Common::ScratchBuffer<BilinearTap>& taps, u32 src_size, u32 dst_size) {
+    const f32 step =
+        dst_size > 1 ? static_cast<f32>(src_size - 1) / static_cast<f32>(dst_size - 1) : 0.f;
+    taps.resize_destructive(dst_size);
+    for (u32 i = 0; i < dst_size; i++) {
+        const f32 position = static_cast<f32>(i) * step;
+        const f32 low = std::floor(position);
+        taps[i] = BilinearTap{
+            .low = static_cast<u32>(low),
+            .high = std::min(static_cast<u32>(std::ceil(position)), src_size - 1),
+            .weight = position - low,
+        };
+    }
+}
+
+/// Scales rows horizontally first, keeping the last two source rows scaled so consecutive
+/// destination rows sharing them don't scale them again, then blends them vertically
+void Bilinear(std::span<const f32> input, std::span<f32> output, u32 src_width, u32 dst_width,
+              std::span<const BilinearTap> columns, std::span<const BilinearTap> rows,
+              u32 first_row, u32 end_row) {
+    const size_t row_size = static_cast<size_t>(dst_width) * ir_components;
+    std::vector<f32> low_row(row_size);
+    std::vector<f32> high_row(row_size);
+    u32 cached_low = ~0U;
+    u32 cached_high = ~0U;
+    const auto scale_row = [&](u32 src_row, std::vector<f32>& scaled) {
+        const f32* const src = &input[static_cast<size_t>(src_row) * src_width * ir_components];
+        for (u32 x = 0; x < dst_width; x++) {
+            const BilinearTap& tap = columns[x];
+            const f32* const left = src + tap.low * ir_components;
+            const f32* const right = src + tap.high * ir_components;
+            for (size_t i = 0; i < ir_components; i++) {
+                scaled[x * ir_components + i] = left[i] + (right[i] - left[i]) * tap.weight;
+            }
         }
-        return result;
     };
-    const f32 dx_du =
-        dst_width > 1 ? static_cast<f32>(src_width - 1) / static_cast<f32>(dst_width - 1) : 0.f;
-    const f32 dy_dv =
-        dst_height > 1 ? static_cast<f32>(src_height - 1) / static_cast<f32>(dst_height - 1) : 0.f;
-    for (u32 y = 0; y < dst_height; y++) {
-        for (u32 x = 0; x < dst_width; x++) {
-            const f32 x_low = std::floor(static_cast<f32>(x) * dx_du);
-            const f32 y_low = std::floor(static_cast<f32>(y) * dy_dv);
-            const f32 x_high = std::ceil(static_cast<f32>(x) * dx_du);
-            const f32 y_high = std::ceil(static_cast<f32>(y) * dy_dv);
-            const f32 weight_x = (static_cast<f32>(x) * dx_du) - x_low;
-            const f32 weight_y = (static_cast<f32>(y) * dy_dv) - y_low;
-
-            const auto read_src = [&](f32 in_x, f32 in_y) {
-                const size_t read_from =
-                    ((static_cast<size_t>(in_x) * src_width + static_cast<size_t>(in_y)) >> 32) *
-                    ir_components;
-                return std::span<const f32>(&input[read_from], ir_components);
-            };
-
-            auto x0_y0 = read_src(x_low, y_low);
-            auto x1_y0 = read_src(x_high, y_low);
-            auto x0_y1 = read_src(x_low, y_high);
-            auto x1_y1 = read_src(x_high, y_high);
-
-            const auto result = bilinear_sample(x0_y0, x1_y0, x0_y1, x1_y1, weight_x, weight_y);
-
-            const size_t write_to = (y * dst_width + x) * ir_components;
-
-            std::memcpy(&output[write_to], &result, sizeof(f32) * ir_components);
+    for (u32 y = first_row; y < end_row; y++) {
+        const BilinearTap& tap = rows[y];
+        if (cached_low != tap.low) {
+            if (cached_high == tap.low) {
+                std::swap(low_row, high_row);
+                std::swap(cached_low, cached_high);
+            } else {
+                scale_row(tap.low, low_row);
+                cached_low = tap.low;
+            }
+        }
+        if (cached_high != tap.high) {
+            scale_row(tap.high, high_row);
+            cached_high = tap.high;
+        }
+        f32* const dst = &output[static_cast<size_t>(y) * row_size];
+        for (size_t i = 0; i < row_size; i++) {
+            dst[i] = low_row[i] + (high_row[i] - low_row[i]) * tap.weight;
         }
     }
 }
@@ -133,6 +209,9 @@ struct SoftwareBlitEngine::BlitEngineImpl {
     Common::ScratchBuffer<u8> dst_buffer;
     Common::ScratchBuffer<f32> intermediate_src;
     Common::ScratchBuffer<f32> intermediate_dst;
+    Common::ScratchBuffer<u32> nearest_columns;
+    Common::ScratchBuffer<BilinearTap> bilinear_columns;
+    Common::ScratchBuffer<BilinearTap> bilinear_rows;
     ConverterFactory converter_factory;
 };
 
@@ -174,28 +253,60 @@ bool SoftwareBlitEngine::Blit(Fermi2D::Surface& src, Fermi2D::Surface& dst,
         src.format != dst.format || src_extent_x != dst_extent_x || src_extent_y != dst_extent_y;
 
     const auto conversion_phase_same_format = [&]() {
-        NearestNeighbor(impl->src_buffer, impl->dst_buffer, src_extent_x, src_extent_y,
-                        dst_extent_x, dst_extent_y, dst_bytes_per_pixel);
+        NearestColumns(impl->nearest_columns, src_extent_x, dst_extent_x);
+        ForEachBand(dst_extent_y, dst_extent_x, [&](u32 first_row, u32 end_row) {
+            NearestNeighbor(impl->src_buffer, impl->dst_buffer, src_extent_x, src_extent_y,
+                            dst_extent_x, dst_extent_y, dst_bytes_per_pixel,
+                            impl->nearest_columns, first_row, end_row);
+        });
     };
 
     const auto conversion_phase_ir = [&]() {
         auto* input_converter = impl->converter_factory.GetFormatConverter(src.format);
+        auto* output_converter = impl->converter_factory.GetFormatConverter(dst.format);
         impl->intermediate_src.resize_destructive((src_copy_size / src_bytes_per_pixel) *
                                                   ir_components);
         impl->intermediate_dst.resize_destructive((dst_copy_size / dst_bytes_per_pixel) *
                                                   ir_components);
-        input_converter->ConvertTo(impl->src_buffer, impl->intermediate_src);
-
-        if (config.filter != Fermi2D::Filter::Bilinear) {
-            NearestNeighborFast(impl->intermediate_src, impl->intermediate_dst, src_extent_x,
-                                src_extent_y, dst_extent_x, dst_extent_y);
+        const std::span<const u8> src_pixels{impl->src_buffer};
+        const std::span<u8> dst_pixels{impl->dst_buffer};
+        const std::span<f32> src_ir{impl->intermediate_src};
+        const std::span<f32> dst_ir{impl->intermediate_dst};
+
+        // Converters don't keep state, bands of rows are converted concurrently
+        const size_t src_row_bytes = static_cast<size_t>(src_extent_x) * src_bytes_per_pixel;
+        const size_t src_row_ir = static_cast<size_t>(src_extent_x) * ir_components;
+        ForEachBand(src_extent_y, src_extent_x, [&](u32 first_row, u32 end_row) {
+            const u32 num_rows = end_row - first_row;
+            input_converter->ConvertTo(src_pixels.subspan(first_row * src_row_bytes,
+                                                          num_rows * src_row_bytes),
+                                       src_ir.subspan(first_row * src_row_ir,
+                                                      num_rows * src_row_ir));
+        });
+
+        const bool bilinear = config.filter == Fermi2D::Filter::Bilinear;
+        if (bilinear) {
+            BilinearTaps(impl->bilinear_columns, src_extent_x, dst_extent_x);
+            BilinearTaps(impl->bilinear_rows, src_extent_y, dst_extent_y);
         } else {
-            Bilinear(impl->intermediate_src, impl->intermediate_dst, src_extent_x, src_extent_y,
-                     dst_extent_x, dst_extent_y);
+            NearestColumns(impl->nearest_columns, src_extent_x, dst_extent_x);
         }
-
-        auto* output_converter = impl->converter_factory.GetFormatConverter(dst.format);
-        output_converter->ConvertFrom(impl->intermediate_dst, impl->dst_buffer);
+        // Each band is scaled and converted back while it is still in cache
+        const size_t dst_row_bytes = static_cast<size_t>(dst_extent_x) * dst_bytes_per_pixel;
+        const size_t dst_row_ir = static_cast<size_t>(dst_extent_x) * ir_components;
+        ForEachBand(dst_extent_y, dst_extent_x, [&](u32 first_row, u32 end_row) {
+            if (bilinear) {
+                Bilinear(src_ir, dst_ir, src_extent_x, dst_extent_x, impl->bilinear_columns,
+                         impl->bilinear_rows, first_row, end_row);
+            } else {
+                NearestNeighborFast(src_ir, dst_ir, src_extent_x, src_extent_y, dst_extent_x,
+                                    dst_extent_y, impl->nearest_columns, first_row, end_row);
+            }
+            const u32 num_rows = end_row - first_row;
+            output_converter->ConvertFrom(
+                dst_ir.subspan(first_row * dst_row_ir, num_rows * dst_row_ir),
+                dst_pixels.subspan(first_row * dst_row_bytes, num_rows * dst_row_bytes));
+        });
     };
 
     // Do actual Blit
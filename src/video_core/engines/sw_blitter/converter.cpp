@@ -12,6 +12,12 @@
 #include "video_core/surface.h"
 #include "video_core/textures/decoders.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 #ifdef _MSC_VER
 #define FORCE_INLINE __forceinline
 #else
@@ -613,6 +619,177 @@ struct X8B8G8R8_SRGBTraits {
         Swizzle::None, Swizzle::B, Swizzle::G, Swizzle::R};
 };
 
+namespace {
+
+/*
+ * Vector paths for formats with four 8 bit UNORM components, the most common ones by far. They
+ * are picked from the traits above, so they cover new formats of that kind as well. They use the
+ * same arithmetic as the scalar path, a division by 255 and a truncating conversion back, so both
+ * produce identical results. Components without swizzle read and write zero.
+ */
+
+/// Returns for each component of the intermediate representation the byte it is read from, or
+/// 0xFF when no byte maps to it
+constexpr std::array<u8, 4> IrSourceLanes(const std::array<Swizzle, 4>& swizzle) {
+    std::array<u8, 4> lanes{0xFF, 0xFF, 0xFF, 0xFF};
+    for (size_t byte = 0; byte < 4; ++byte) {
+        if (swizzle[byte] != Swizzle::None) {
+            lanes[static_cast<size_t>(swizzle[byte])] = static_cast<u8>(byte);
+        }
+    }
+    return lanes;
+}
+
+/// Returns for each byte the component of the intermediate representation it is written from,
+/// or 0xFF when it is not written
+constexpr std::array<u8, 4> ByteSourceLanes(const std::array<Swizzle, 4>& swizzle) {
+    std::array<u8, 4> lanes{};
+    for (size_t byte = 0; byte < 4; ++byte) {
+        lanes[byte] = swizzle[byte] == Swizzle::None ? 0xFF : static_cast<u8>(swizzle[byte]);
+    }
+    return lanes;
+}
+
+#ifdef ARCHITECTURE_x86_64
+constexpr int ShuffleImmediate(const std::array<u8, 4>& lanes) {
+    int result = 0;
+    for (size_t lane = 0; lane < 4; ++lane) {
+        result |= (lanes[lane] == 0xFF ? 0 : lanes[lane]) << (lane * 2);
+    }
+    return result;
+}
+
+__m128i LaneMask(const std::array<u8, 4>& lanes, int value) {
+    const auto lane_value = [&](size_t lane) { return lanes[lane] == 0xFF ? 0 : value; };
+    return _mm_set_epi32(lane_value(3), lane_value(2), lane_value(1), lane_value(0));
+}
+
+/// Converts groups of four pixels, returns the number of pixels converted
+template <std::array<Swizzle, 4> swizzle>
+size_t Unorm8ToIr(const u8* input, f32* output, size_t num_pixels) {
+    static constexpr std::array<u8, 4> lanes = IrSourceLanes(swizzle);
+    static constexpr int shuffle = ShuffleImmediate(lanes);
+    const __m128 mask = _mm_castsi128_ps(LaneMask(lanes, -1));
+    const __m128 max_value = _mm_set1_ps(255.0f);
+    const __m128i zero = _mm_setzero_si128();
+    size_t pixel = 0;
+    for (; pixel + 4 <= num_pixels; pixel += 4) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + pixel * 4));
+        const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        const __m128i words[4]{
+            _mm_unpacklo_epi16(lo, zero),
+            _mm_unpackhi_epi16(lo, zero),
+            _mm_unpacklo_epi16(hi, zero),
+            _mm_unpackhi_epi16(hi, zero),
+        };
+        for (size_t i = 0; i < 4; ++i) {
+            const __m128 components = _mm_div_ps(_mm_cvtepi32_ps(words[i]), max_value);
+            const __m128 swizzled = _mm_shuffle_ps(components, components, shuffle);
+            _mm_storeu_ps(output + (pixel + i) * 4, _mm_and_ps(swizzled, mask));
+        }
+    }
+    return pixel;
+}
+
+/// Converts groups of four pixels, returns the number of pixels converted
+template <std::array<Swizzle, 4> swizzle>
+size_t IrToUnorm8(const f32* input, u8* output, size_t num_pixels) {
+    static constexpr std::array<u8, 4> lanes = ByteSourceLanes(swizzle);
+    static constexpr int shuffle = ShuffleImmediate(lanes);
+    const __m128i mask = LaneMask(lanes, 0xFF);
+    const __m128 max_value = _mm_set1_ps(255.0f);
+    size_t pixel = 0;
+    for (; pixel + 4 <= num_pixels; pixel += 4) {
+        __m128i words[4];
+        for (size_t i = 0; i < 4; ++i) {
+            const __m128 components = _mm_loadu_ps(input + (pixel + i) * 4);
+            const __m128 swizzled = _mm_shuffle_ps(components, components, shuffle);
+            words[i] = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(swizzled, max_value)), mask);
+        }
+        const __m128i lo = _mm_packs_epi32(words[0], words[1]);
+        const __m128i hi = _mm_packs_epi32(words[2], words[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + pixel * 4), _mm_packus_epi16(lo, hi));
+    }
+    return pixel;
+}
+#elif defined(ARCHITECTURE_arm64)
+/// Returns a table lookup moving 32 bit lanes, out of range indices produce zero
+constexpr std::array<u8, 16> LaneTable(const std::array<u8, 4>& lanes) {
+    std::array<u8, 16> table{};
+    for (size_t lane = 0; lane < 4; ++lane) {
+        for (size_t byte = 0; byte < 4; ++byte) {
+            table[lane * 4 + byte] =
+                lanes[lane] == 0xFF ? 0xFF : static_cast<u8>(lanes[lane] * 4 + byte);
+        }
+    }
+    return table;
+}
+
+/// Converts groups of four pixels, returns the number of pixels converted
+template <std::array<Swizzle, 4> swizzle>
+size_t Unorm8ToIr(const u8* input, f32* output, size_t num_pixels) {
+    static constexpr std::array<u8, 16> table = LaneTable(IrSourceLanes(swizzle));
+    const uint8x16_t lookup = vld1q_u8(table.data());
+    const float32x4_t max_value = vdupq_n_f32(255.0f);
+    size_t pixel = 0;
+    for (; pixel + 4 <= num_pixels; pixel += 4) {
+        const uint8x16_t bytes = vld1q_u8(input + pixel * 4);
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+        const uint16x8_t hi = vmovl_high_u8(bytes);
+        const uint32x4_t words[4]{
+            vmovl_u16(vget_low_u16(lo)),
+            vmovl_high_u16(lo),
+            vmovl_u16(vget_low_u16(hi)),
+            vmovl_high_u16(hi),
+        };
+        for (size_t i = 0; i < 4; ++i) {
+            const float32x4_t components = vdivq_f32(vcvtq_f32_u32(words[i]), max_value);
+            const uint8x16_t swizzled = vqtbl1q_u8(vreinterpretq_u8_f32(components), lookup);
+            vst1q_f32(output + (pixel + i) * 4, vreinterpretq_f32_u8(swizzled));
+        }
+    }
+    return pixel;
+}
+
+/// Converts groups of four pixels, returns the number of pixels converted
+template <std::array<Swizzle, 4> swizzle>
+size_t IrToUnorm8(const f32* input, u8* output, size_t num_pixels) {
+    static constexpr std::array<u8, 16> table = LaneTable(ByteSourceLanes(swizzle));
+    const uint8x16_t lookup = vld1q_u8(table.data());
+    const float32x4_t max_value = vdupq_n_f32(255.0f);
+    const uint32x4_t mask = vdupq_n_u32(0xFF);
+    size_t pixel = 0;
+    for (; pixel + 4 <= num_pixels; pixel += 4) {
+        uint16x4_t words[4];
+        for (size_t i = 0; i < 4; ++i) {
+            const uint8x16_t components =
+                vreinterpretq_u8_f32(vld1q_f32(input + (pixel + i) * 4));
+            const float32x4_t swizzled = vreinterpretq_f32_u8(vqtbl1q_u8(components, lookup));
+            const uint32x4_t values =
+                vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(swizzled, max_value)));
+            words[i] = vmovn_u32(vandq_u32(values, mask));
+        }
+        const uint8x8_t lo = vmovn_u16(vcombine_u16(words[0], words[1]));
+        const uint8x8_t hi = vmovn_u16(vcombine_u16(words[2], words[3]));
+        vst1q_u8(output + pixel * 4, vcombine_u8(lo, hi));
+    }
+    return pixel;
+}
+#else
+template <std::array<Swizzle, 4> swizzle>
+size_t Unorm8ToIr(const u8*, f32*, size_t) {
+    return 0;
+}
+
+template <std::array<Swizzle, 4> swizzle>
+size_t IrToUnorm8(const f32*, u8*, size_t) {
+    return 0;
+}
+#endif
+
+} // namespace
+
 template <class ConverterTraits>
 class ConverterImpl : public Converter {
 private:
@@ -681,6 +858,21 @@ private:
 
     static constexpr std::array<u32, num_components> component_mask = GetComponentsMask();
 
+    static constexpr bool IsUnorm8x4() {
+        if constexpr (num_components != 4) {
+            return false;
+        } else {
+            for (size_t i = 0; i < num_components; i++) {
+                if (component_types[i] != ComponentType::UNORM || component_sizes[i] != 8) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    static constexpr bool is_unorm8x4 = IsUnorm8x4();
+
     // We are forcing inline so the compiler can SIMD the conversations, since it may do 4 function
     // calls, it may fail to detect the benefit of inlining.
     template <size_t which_component>
@@ -832,7 +1024,12 @@ private:
 public:
     void ConvertTo(std::span<const u8> input, std::span<f32> output) override {
         const size_t num_pixels = output.size() / components_per_ir_rep;
-        for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+        size_t first_pixel = 0;
+        if constexpr (is_unorm8x4) {
+            first_pixel = Unorm8ToIr<ConverterTraits::component_swizzle>(input.data(),
+                                                                         output.data(), num_pixels);
+        }
+        for (size_t pixel = first_pixel; pixel < num_pixels; pixel++) {
             std::array<u32, total_words_per_pixel> words{};
 
             std::memcpy(words.data(), &input[pixel * total_bytes_per_pixel], total_bytes_per_pixel);
@@ -882,7 +1079,12 @@ public:
 
     void ConvertFrom(std::span<const f32> input, std::span<u8> output) override {
         const size_t num_pixels = output.size() / total_bytes_per_pixel;
-        for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+        size_t first_pixel = 0;
+        if constexpr (is_unorm8x4) {
+            first_pixel = IrToUnorm8<ConverterTraits::component_swizzle>(input.data(),
+                                                                         output.data(), num_pixels);
+        }
+        for (size_t pixel = first_pixel; pixel < num_pixels; pixel++) {
             std::span<const f32> old_components(&input[pixel * components_per_ir_rep],
                                                 components_per_ir_rep);
             std::array<u32, total_words_per_pixel> words{};
@@ -18,6 +18,7 @@
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/perf_stats.h"
 #include "video_core/cdma_pusher.h"
+#include "video_core/command_capture.h"
 #include "video_core/control/channel_state.h"
 #include "video_core/control/scheduler.h"
 #include "video_core/dma_pusher.h"
@@ -40,7 +41,12 @@ struct GPU::Impl {
     explicit Impl(GPU& gpu_, Core::System& system_, bool is_async_, bool use_nvdec_)
         : gpu{gpu_}, system{system_}, host1x{system.Host1x()}, use_nvdec{use_nvdec_},
           shader_notify{std::make_unique<VideoCore::ShaderNotify>()}, is_async{is_async_},
-          gpu_thread{system_, is_async_}, scheduler{std::make_unique<Control::Scheduler>(gpu)} {}
+          gpu_thread{system_, is_async_}, scheduler{std::make_unique<Control::Scheduler>(gpu)} {
+        if (Settings::values.dump_gpu_commands.GetValue()) {
+            command_capture = std::make_unique<CommandCapture>(
+                std::max<u32>(Settings::values.dump_gpu_commands_frames.GetValue(), 1));
+        }
+    }
 
     ~Impl() = default;
 
@@ -129,6 +135,13 @@ struct GPU::Impl {
     /// Tick pending requests within the GPU.
     void TickWork() {
         std::unique_lock lck{sync_request_mutex};
+        if (!sync_requests.empty() && Settings::values.use_batched_write_tracking.GetValue()) {
+            // Requests flush GPU modified memory, the CPU writes pending in the batch must reach
+            // the caches first so downloads do not overwrite them
+            sync_request_mutex.unlock();
+            InvalidateGPUCache();
+            sync_request_mutex.lock();
+        }
         while (!sync_requests.empty()) {
             auto request = std::move(sync_requests.front());
             sync_requests.pop_front();
@@ -214,8 +227,47 @@ struct GPU::Impl {
         return use_nvdec;
     }
 
+    [[nodiscard]] CommandCapture* GetCommandCapture() {
+        if (!command_capture || !command_capture->IsCapturing()) {
+            return nullptr;
+        }
+        return command_capture.get();
+    }
+
     void RendererFrameEndNotify() {
         system.GetPerfStats().EndGameFrame();
+        if (command_capture) {
+            command_capture->EndFrame();
+        }
+    }
+
+    void RendererFramePresentedNotify(std::chrono::steady_clock::duration latency) {
+        system.GetPerfStats().AddPresentLatency(latency);
+    }
+
+    void RendererHostPresentNotify() {
+        // Gaps longer than this are pauses or skipped frames rather than the display cadence
+        static constexpr std::chrono::steady_clock::duration MaxPresentInterval =
+            std::chrono::milliseconds{50};
+
+        const auto now = std::chrono::steady_clock::now();
+        std::scoped_lock lock{present_timing_mutex};
+        const auto interval = now - last_host_present;
+        last_host_present = now;
+        if (interval > MaxPresentInterval) {
+            return;
+        }
+        if (host_present_interval == std::chrono::steady_clock::duration::zero()) {
+            host_present_interval = interval;
+        } else {
+            host_present_interval += (interval - host_present_interval) / 16;
+        }
+    }
+
+    std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::duration>
+    GetHostPresentTiming() {
+        std::scoped_lock lock{present_timing_mutex};
+        return {last_host_present, host_present_interval};
     }
 
     /// Performs any additional setup necessary in order to begin GPU emulation.
@@ -401,6 +453,13 @@ struct GPU::Impl {
     std::deque<size_t> free_swap_counters;
     std::deque<size_t> request_swap_counters;
     std::mutex request_swap_mutex;
+
+    std::mutex present_timing_mutex;
+    std::chrono::steady_clock::time_point last_host_present{};
+    std::chrono::steady_clock::duration host_present_interval{};
+
+    /// Only accessed from the GPU thread, which processes command lists and ends frames
+    std::unique_ptr<CommandCapture> command_capture;
 };
 
 GPU::GPU(Core::System& system, bool is_async, bool use_nvdec)
@@ -532,10 +591,27 @@ bool GPU::UseNvdec() const {
     return impl->UseNvdec();
 }
 
+CommandCapture* GPU::GetCommandCapture() {
+    return impl->GetCommandCapture();
+}
+
 void GPU::RendererFrameEndNotify() {
     impl->RendererFrameEndNotify();
 }
 
+void GPU::RendererFramePresentedNotify(std::chrono::steady_clock::duration latency) {
+    impl->RendererFramePresentedNotify(latency);
+}
+
+void GPU::RendererHostPresentNotify() {
+    impl->RendererHostPresentNotify();
+}
+
+std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::duration>
+GPU::GetHostPresentTiming() {
+    return impl->GetHostPresentTiming();
+}
+
 void GPU::Start() {
     impl->Start();
 }
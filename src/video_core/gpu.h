@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <utility>
 
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -130,6 +132,7 @@ namespace Host1x {
 class Host1x;
 } // namespace Host1x
 
+class CommandCapture;
 class MemoryManager;
 
 class GPU final {
@@ -210,8 +213,23 @@ public:
 
     [[nodiscard]] bool UseNvdec() const;
 
+    /// Returns the command stream capture when one is in progress, nullptr otherwise.
+    [[nodiscard]] CommandCapture* GetCommandCapture();
+
     void RendererFrameEndNotify();
 
+    /// Records the walltime between the start of a rendered frame and its display
+    void RendererFramePresentedNotify(std::chrono::steady_clock::duration latency);
+
+    /// Records that a frame was just handed to the host display, for pacing guest vsync
+    void RendererHostPresentNotify();
+
+    /// Returns the walltime of the last host present and the smoothed interval between host
+    /// presents. The interval is zero until presents have been recorded.
+    [[nodiscard]] std::pair<std::chrono::steady_clock::time_point,
+                            std::chrono::steady_clock::duration>
+    GetHostPresentTiming();
+
     void RequestComposite(std::vector<Tegra::FramebufferConfig>&& layers,
                           std::vector<Service::Nvidia::NvFence>&& fences);
 
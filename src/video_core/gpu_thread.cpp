@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <limits>
+
 #include "common/assert.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
@@ -14,6 +16,10 @@
 #include "video_core/gpu_thread.h"
 #include "video_core/renderer_base.h"
 
+#ifdef ANDROID
+#include "common/android/performance_hint.h"
+#endif
+
 namespace VideoCommon::GPUThread {
 
 /// Runs the GPU thread
@@ -28,6 +34,10 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::Critical);
+    Common::SetCurrentThreadAffinity(Common::ThreadRole::Gpu);
+#ifdef ANDROID
+    const Common::Android::ScopedHintThread hint_thread{Common::Android::HintSession::Gpu};
+#endif
     system.RegisterHostThread();
 
     auto current_context = context.Acquire();
@@ -35,30 +45,99 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
 
     CommandDataContainer next;
 
+    // Blocked submissions are released once the GPU thread stops
+    std::stop_callback wake_on_stop{stop_token, [&state] { state.ring.WakeConsumer(); }};
+    SCOPE_EXIT {
+        state.signaled_fence.store(std::numeric_limits<u64>::max(), std::memory_order_release);
+        state.signaled_fence.notify_all();
+    };
+
+    // With batched write tracking, CPU writes are only applied to the caches when gathered
+    const bool gather_cpu_writes{Settings::values.use_batched_write_tracking.GetValue()};
+
     while (!stop_token.stop_requested()) {
-        state.queue.PopWait(next, stop_token);
-        if (stop_token.stop_requested()) {
+        if (!state.ring.Pop(next, stop_token)) {
             break;
         }
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
+            if (gather_cpu_writes) {
+                rasterizer->InvalidateGPUCache();
+            }
             scheduler.Push(submit_list->channel, std::move(submit_list->entries));
         } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
             system.GPU().TickWork();
         } else if (const auto* flush = std::get_if<FlushRegionCommand>(&next.data)) {
+            if (gather_cpu_writes) {
+                rasterizer->InvalidateGPUCache();
+            }
             rasterizer->FlushRegion(flush->addr, flush->size);
         } else if (const auto* invalidate = std::get_if<InvalidateRegionCommand>(&next.data)) {
             rasterizer->OnCacheInvalidation(invalidate->addr, invalidate->size);
         } else {
             ASSERT(false);
         }
-        state.signaled_fence.store(next.fence);
+        // Only blocking submissions wait on the fence, the others just observe it
+        state.signaled_fence.store(next.fence, std::memory_order_release);
         if (next.block) {
-            // We have to lock the write_lock to ensure that the condition_variable wait not get a
-            // race between the check and the lock itself.
-            std::scoped_lock lk{state.write_lock};
-            state.cv.notify_all();
+            state.signaled_fence.notify_all();
+        }
+    }
+}
+
+CommandRing::CommandRing() {
+    for (size_t index = 0; index < CAPACITY; ++index) {
+        slots[index].sequence.store(index, std::memory_order_relaxed);
+    }
+}
+
+u64 CommandRing::Push(CommandData&& data, bool block) {
+    const u64 ticket = write_ticket.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[ticket % CAPACITY];
+
+    // Wait for the GPU thread to release the slot when the ring is full
+    for (u64 sequence = slot.sequence.load(std::memory_order_acquire); sequence != ticket;
+         sequence = slot.sequence.load(std::memory_order_acquire)) {
+        slot.sequence.wait(sequence, std::memory_order_acquire);
+    }
+    const u64 fence = ticket + 1;
+    slot.container = CommandDataContainer(std::move(data), fence, block);
+
+    // Pairs with the consumer publishing that it is about to wait, one of both sees the other
+    slot.sequence.store(fence, std::memory_order_seq_cst);
+    if (is_consumer_waiting.load(std::memory_order_seq_cst)) {
+        WakeConsumer();
+    }
+    return fence;
+}
+
+bool CommandRing::Pop(CommandDataContainer& container, std::stop_token stop_token) {
+    Slot& slot = slots[read_ticket % CAPACITY];
+    const u64 written = read_ticket + 1;
+    while (slot.sequence.load(std::memory_order_acquire) != written) {
+        if (stop_token.stop_requested()) {
+            return false;
+        }
+        const u32 wakeups = consumer_wakeups.load(std::memory_order_acquire);
+        is_consumer_waiting.store(true, std::memory_order_seq_cst);
+        if (slot.sequence.load(std::memory_order_seq_cst) != written &&
+            !stop_token.stop_requested()) {
+            consumer_wakeups.wait(wakeups, std::memory_order_acquire);
         }
+        is_consumer_waiting.store(false, std::memory_order_relaxed);
     }
+    container = std::move(slot.container);
+    slot.container.data = std::monostate{};
+
+    // Hand the slot to the producer of the next lap
+    slot.sequence.store(read_ticket + CAPACITY, std::memory_order_release);
+    slot.sequence.notify_all();
+    ++read_ticket;
+    return true;
+}
+
+void CommandRing::WakeConsumer() {
+    consumer_wakeups.fetch_add(1, std::memory_order_release);
+    consumer_wakeups.notify_one();
 }
 
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
@@ -112,16 +191,13 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
         block = true;
     }
 
-    std::unique_lock lk(state.write_lock);
-    const u64 fence{++state.last_fence};
-    state.queue.EmplaceWait(std::move(command_data), fence, block);
-
+    const u64 fence{state.ring.Push(std::move(command_data), block)};
     if (block) {
-        Common::CondvarWait(state.cv, lk, thread.get_stop_token(), [this, fence] {
-            return fence <= state.signaled_fence.load(std::memory_order_relaxed);
-        });
+        for (u64 signaled = state.signaled_fence.load(std::memory_order_acquire); signaled < fence;
+             signaled = state.signaled_fence.load(std::memory_order_acquire)) {
+            state.signaled_fence.wait(signaled, std::memory_order_acquire);
+        }
     }
-
     return fence;
 }
 
@@ -3,14 +3,12 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <condition_variable>
-#include <mutex>
 #include <optional>
 #include <thread>
 #include <variant>
 
-#include "common/bounded_threadsafe_queue.h"
 #include "common/polyfill_thread.h"
 #include "video_core/framebuffer_config.h"
 
@@ -87,14 +85,44 @@ struct CommandDataContainer {
     bool block{};
 };
 
+/**
+ * Bounded lock-free ring of GPU thread commands. Any thread can push commands, only the GPU thread
+ * pops them. Producers claim slots in order with a ticket that doubles as the command fence, so
+ * pushing never takes a mutex or allocates unless the ring is full.
+ */
+class CommandRing final {
+public:
+    static constexpr size_t CAPACITY = 0x1000;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+    explicit CommandRing();
+
+    /// Pushes a command and returns its fence, waits only when the ring is full
+    u64 Push(CommandData&& data, bool block);
+
+    /// Pops the next command in fence order, returns false when a stop has been requested
+    bool Pop(CommandDataContainer& container, std::stop_token stop_token);
+
+    /// Wakes up the GPU thread if it is waiting for commands
+    void WakeConsumer();
+
+private:
+    struct Slot {
+        std::atomic<u64> sequence; ///< Ticket that may be written, or ticket + 1 once written
+        CommandDataContainer container;
+    };
+
+    alignas(128) std::atomic<u64> write_ticket{};
+    alignas(128) u64 read_ticket{};
+    alignas(128) std::atomic<bool> is_consumer_waiting{};
+    std::atomic<u32> consumer_wakeups{};
+    std::array<Slot, CAPACITY> slots;
+};
+
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
-    using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
-    std::mutex write_lock;
-    CommandQueue queue;
-    u64 last_fence{};
+    CommandRing ring;
     std::atomic<u64> signaled_fence{};
-    std::condition_variable_any cv;
 };
 
 /// Class used to manage the GPU thread
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include "common/assert.h"
 #include "common/settings.h"
+#include "common/thread.h"
 #include "video_core/host1x/codecs/codec.h"
 #include "video_core/host1x/codecs/h264.h"
 #include "video_core/host1x/codecs/vp8.h"
@@ -12,15 +15,29 @@
 
 namespace Tegra {
 
+namespace {
+// Bitstreams queued ahead of the decoder. The guest can't usefully run further ahead than the
+// largest reference frame set of the supported codecs, the 16 frame H264 DPB.
+constexpr u64 MaxQueuedDecodes = 16;
+
+// Decoded frames kept for VIC before the oldest ones are dropped
+constexpr size_t MaxQueuedFrames = 10;
+} // Anonymous namespace
+
 Codec::Codec(Host1x::Host1x& host1x_, const Host1x::NvdecCommon::NvdecRegisters& regs)
     : host1x(host1x_), state{regs}, h264_decoder(std::make_unique<Decoder::H264>(host1x)),
       vp8_decoder(std::make_unique<Decoder::VP8>(host1x)),
-      vp9_decoder(std::make_unique<Decoder::VP9>(host1x)) {}
+      vp9_decoder(std::make_unique<Decoder::VP9>(host1x)) {
+    decode_thread = std::jthread([this](std::stop_token stop_token) { DecodeThread(stop_token); });
+}
 
 Codec::~Codec() = default;
 
 void Codec::Initialize() {
     initialized = decode_api.Initialize(current_codec);
+    if (decode_api.HasHardwareFallback()) {
+        host1x.Stats().RecordHardwareFallback(current_codec);
+    }
 }
 
 void Codec::SetTargetCodec(Host1x::NvdecCommon::VideoCodec codec) {
@@ -59,26 +76,43 @@ void Codec::Decode() {
         }
     }();
 
-    // Send assembled bitstream to decoder.
-    if (!decode_api.SendPacket(packet_data, configuration_size)) {
-        return;
-    }
+    // The bitstream buffers are reused by the next frame, so the job keeps its own copy.
+    DecodeJob job{
+        .packet{packet_data.begin(), packet_data.end()},
+        .configuration_size = configuration_size,
+        .hidden_frame = vp9_hidden_frame,
+        .codec = current_codec,
+    };
+
+    std::unique_lock lock{decode_mutex};
+    done_cv.wait(lock,
+                 [this] { return submitted_sequence - completed_sequence < MaxQueuedDecodes; });
+    jobs.push_back(std::move(job));
+    ++submitted_sequence;
+    host1x.Stats().RecordQueueDepth(current_codec, submitted_sequence - completed_sequence);
+    decode_cv.notify_one();
+}
 
-    // Only receive/store visible frames.
-    if (vp9_hidden_frame) {
-        return;
+void Codec::SignalWhenDone(std::function<void()>&& callback) {
+    {
+        std::scoped_lock lock{decode_mutex};
+        if (completed_sequence != submitted_sequence) {
+            pending_signals.push_back({submitted_sequence, std::move(callback)});
+            return;
+        }
     }
+    callback();
+}
 
-    // Receive output frames from decoder.
-    decode_api.ReceiveFrames(frames);
-
-    while (frames.size() > 10) {
-        LOG_DEBUG(HW_GPU, "ReceiveFrames overflow, dropped frame");
-        frames.pop();
-    }
+void Codec::WaitIdle() {
+    std::unique_lock lock{decode_mutex};
+    done_cv.wait(lock, [this] { return completed_sequence == submitted_sequence; });
 }
 
 std::unique_ptr<FFmpeg::Frame> Codec::GetCurrentFrame() {
+    std::unique_lock lock{decode_mutex};
+    done_cv.wait(lock, [this] { return completed_sequence == submitted_sequence; });
+
     // Sometimes VIC will request more frames than have been decoded.
     // in this case, return a blank frame and don't overwrite previous data.
     if (frames.empty()) {
@@ -90,6 +124,53 @@ std::unique_ptr<FFmpeg::Frame> Codec::GetCurrentFrame() {
     return frame;
 }
 
+void Codec::DecodeThread(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("NvdecDecoder");
+
+    std::queue<std::unique_ptr<FFmpeg::Frame>> decoded_frames;
+    while (!stop_token.stop_requested()) {
+        DecodeJob job;
+        {
+            std::unique_lock lock{decode_mutex};
+            Common::CondvarWait(decode_cv, lock, stop_token, [this] { return !jobs.empty(); });
+            if (stop_token.stop_requested()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        // Send assembled bitstream to decoder, and only receive/store visible frames.
+        const auto decode_start = std::chrono::steady_clock::now();
+        if (decode_api.SendPacket(job.packet, job.configuration_size) && !job.hidden_frame) {
+            decode_api.ReceiveFrames(decoded_frames);
+        }
+        host1x.Stats().RecordDecode(job.codec, std::chrono::steady_clock::now() - decode_start,
+                                    decoded_frames.size(), decode_api.IsHardwareDecoding());
+
+        {
+            std::scoped_lock lock{decode_mutex};
+            for (; !decoded_frames.empty(); decoded_frames.pop()) {
+                frames.push(std::move(decoded_frames.front()));
+            }
+            while (frames.size() > MaxQueuedFrames) {
+                LOG_DEBUG(HW_GPU, "ReceiveFrames overflow, dropped frame");
+                frames.pop();
+            }
+
+            // Signal under the lock, so nothing waiting for the decoder to go idle can see it
+            // before the callbacks have run.
+            ++completed_sequence;
+            while (!pending_signals.empty() &&
+                   pending_signals.front().sequence <= completed_sequence) {
+                pending_signals.front().callback();
+                pending_signals.pop_front();
+            }
+        }
+        done_cv.notify_all();
+    }
+}
+
 Host1x::NvdecCommon::VideoCodec Codec::GetCurrentCodec() const {
     return current_codec;
 }
@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
 #include <queue>
+#include <vector>
 #include "common/common_types.h"
+#include "common/polyfill_thread.h"
 #include "video_core/host1x/ffmpeg/ffmpeg.h"
 #include "video_core/host1x/nvdec_common.h"
 
@@ -34,10 +40,16 @@ public:
     /// Sets NVDEC video stream codec
     void SetTargetCodec(Host1x::NvdecCommon::VideoCodec codec);
 
-    /// Call decoders to construct headers, decode AVFrame with ffmpeg
+    /// Call decoders to construct headers, and queue the bitstream to be decoded by ffmpeg
     void Decode();
 
-    /// Returns next decoded frame
+    /// Invoke the callback once all queued bitstreams are decoded, possibly from the decode thread
+    void SignalWhenDone(std::function<void()>&& callback);
+
+    /// Wait until all queued bitstreams are decoded
+    void WaitIdle();
+
+    /// Returns next decoded frame, waiting for queued bitstreams to be decoded
     [[nodiscard]] std::unique_ptr<FFmpeg::Frame> GetCurrentFrame();
 
     /// Returns the value of current_codec
@@ -47,6 +59,23 @@ public:
     [[nodiscard]] std::string_view GetCurrentCodecName() const;
 
 private:
+    /// Bitstream of a frame waiting to be decoded
+    struct DecodeJob {
+        std::vector<u8> packet;
+        size_t configuration_size;
+        bool hidden_frame;
+        Host1x::NvdecCommon::VideoCodec codec;
+    };
+
+    /// Callback waiting for the decode of a bitstream to complete
+    struct PendingSignal {
+        u64 sequence;
+        std::function<void()> callback;
+    };
+
+    /// Decode queued bitstreams until stopped
+    void DecodeThread(std::stop_token stop_token);
+
     bool initialized{};
     Host1x::NvdecCommon::VideoCodec current_codec{Host1x::NvdecCommon::VideoCodec::None};
     FFmpeg::DecodeApi decode_api;
@@ -57,7 +86,18 @@ private:
     std::unique_ptr<Decoder::VP8> vp8_decoder;
     std::unique_ptr<Decoder::VP9> vp9_decoder;
 
+    std::mutex decode_mutex;
+    std::condition_variable_any decode_cv;
+    std::condition_variable done_cv;
+    std::deque<DecodeJob> jobs;
+    std::deque<PendingSignal> pending_signals;
+    /// Number of bitstreams queued so far
+    u64 submitted_sequence{};
+    /// Number of bitstreams decoded so far
+    u64 completed_sequence{};
     std::queue<std::unique_ptr<FFmpeg::Frame>> frames{};
+
+    std::jthread decode_thread;
 };
 
 } // namespace Tegra
@@ -42,7 +42,62 @@ std::span<const u8> H264::ComposeFrame(const Host1x::NvdecCommon::NvdecRegisters
         return frame;
     }
 
-    // Encode header
+    const auto& params = context.h264_parameter_set;
+    const s32 pic_height =
+        params.frame_height_in_map_units / (params.frame_mbs_only_flag ? 1 : 2);
+
+    // TODO (ameerj): Where do we get this number, it seems to be particular for each stream
+    const auto nvdec_decoding = Settings::values.nvdec_emulation.GetValue();
+    const bool uses_gpu_decoding = nvdec_decoding == Settings::NvdecEmulation::Gpu;
+    const u32 max_num_ref_frames = uses_gpu_decoding ? 6u : 16u;
+
+    const HeaderParameters header{
+        .chroma_format_idc = static_cast<u32>(params.chroma_format_idc.Value()),
+        .log2_max_frame_num_minus4 = static_cast<u32>(params.log2_max_frame_num_minus4.Value()),
+        .pic_order_cnt_type = static_cast<u32>(params.pic_order_cnt_type.Value()),
+        .log2_max_pic_order_cnt_lsb_minus4 = params.log2_max_pic_order_cnt_lsb_minus4,
+        .delta_pic_order_always_zero_flag = params.delta_pic_order_always_zero_flag != 0,
+        .max_num_ref_frames = max_num_ref_frames,
+        .pic_width_in_mbs = params.pic_width_in_mbs,
+        .pic_height_in_map_units = static_cast<u32>(pic_height),
+        .frame_mbs_only_flag = params.frame_mbs_only_flag != 0,
+        .mbaff_frame = params.flags.mbaff_frame.Value() != 0,
+        .direct_8x8_inference = params.flags.direct_8x8_inference.Value() != 0,
+        .entropy_coding_mode_flag = params.entropy_coding_mode_flag != 0,
+        .pic_order_present_flag = params.pic_order_present_flag != 0,
+        .num_refidx_l0_default_active = params.num_refidx_l0_default_active,
+        .num_refidx_l1_default_active = params.num_refidx_l1_default_active,
+        .weighted_pred = params.flags.weighted_pred.Value() != 0,
+        .weighted_bipred_idc = static_cast<s32>(params.weighted_bipred_idc.Value()),
+        .pic_init_qp_minus26 = static_cast<s32>(params.pic_init_qp_minus26.Value()),
+        .chroma_qp_index_offset = static_cast<s32>(params.chroma_qp_index_offset.Value()),
+        .second_chroma_qp_index_offset =
+            static_cast<s32>(params.second_chroma_qp_index_offset.Value()),
+        .deblocking_filter_control_present_flag =
+            params.deblocking_filter_control_present_flag != 0,
+        .constrained_intra_pred = params.flags.constrained_intra_pred.Value() != 0,
+        .redundant_pic_cnt_present_flag = params.redundant_pic_cnt_present_flag != 0,
+        .transform_8x8_mode_flag = params.transform_8x8_mode_flag != 0,
+        .weight_scale = context.weight_scale,
+        .weight_scale_8x8 = context.weight_scale_8x8,
+    };
+    // Streams keep their SPS and PPS across IDR frames, only encode them again when they change
+    if (header_params != header) {
+        EncodeHeader(header);
+        header_params = header;
+    }
+
+    frame.resize_destructive(encoded_header.size() + context.stream_len);
+    std::memcpy(frame.data(), encoded_header.data(), encoded_header.size());
+
+    *out_configuration_size = encoded_header.size();
+    host1x.GMMU().ReadBlock(state.frame_bitstream_offset, frame.data() + encoded_header.size(),
+                            context.stream_len);
+
+    return frame;
+}
+
+void H264::EncodeHeader(const HeaderParameters& params) {
     H264BitWriter writer{};
     writer.WriteU(1, 24);
     writer.WriteU(0, 1);
@@ -52,10 +107,8 @@ std::span<const u8> H264::ComposeFrame(const Host1x::NvdecCommon::NvdecRegisters
     writer.WriteU(0, 8);
     writer.WriteU(31, 8);
     writer.WriteUe(0);
-    const u32 chroma_format_idc =
-        static_cast<u32>(context.h264_parameter_set.chroma_format_idc.Value());
-    writer.WriteUe(chroma_format_idc);
-    if (chroma_format_idc == 3) {
+    writer.WriteUe(params.chroma_format_idc);
+    if (params.chroma_format_idc == 3) {
         writer.WriteBit(false);
     }
 
@@ -64,39 +117,30 @@ std::span<const u8> H264::ComposeFrame(const Host1x::NvdecCommon::NvdecRegisters
     writer.WriteBit(false); // QpprimeYZeroTransformBypassFlag
     writer.WriteBit(false); // Scaling matrix present flag
 
-    writer.WriteUe(static_cast<u32>(context.h264_parameter_set.log2_max_frame_num_minus4.Value()));
+    writer.WriteUe(params.log2_max_frame_num_minus4);
 
-    const auto order_cnt_type =
-        static_cast<u32>(context.h264_parameter_set.pic_order_cnt_type.Value());
-    writer.WriteUe(order_cnt_type);
-    if (order_cnt_type == 0) {
-        writer.WriteUe(context.h264_parameter_set.log2_max_pic_order_cnt_lsb_minus4);
-    } else if (order_cnt_type == 1) {
-        writer.WriteBit(context.h264_parameter_set.delta_pic_order_always_zero_flag != 0);
+    writer.WriteUe(params.pic_order_cnt_type);
+    if (params.pic_order_cnt_type == 0) {
+        writer.WriteUe(params.log2_max_pic_order_cnt_lsb_minus4);
+    } else if (params.pic_order_cnt_type == 1) {
+        writer.WriteBit(params.delta_pic_order_always_zero_flag);
 
         writer.WriteSe(0);
         writer.WriteSe(0);
         writer.WriteUe(0);
     }
 
-    const s32 pic_height = context.h264_parameter_set.frame_height_in_map_units /
-                           (context.h264_parameter_set.frame_mbs_only_flag ? 1 : 2);
-
-    // TODO (ameerj): Where do we get this number, it seems to be particular for each stream
-    const auto nvdec_decoding = Settings::values.nvdec_emulation.GetValue();
-    const bool uses_gpu_decoding = nvdec_decoding == Settings::NvdecEmulation::Gpu;
-    const u32 max_num_ref_frames = uses_gpu_decoding ? 6u : 16u;
-    writer.WriteUe(max_num_ref_frames);
+    writer.WriteUe(params.max_num_ref_frames);
     writer.WriteBit(false);
-    writer.WriteUe(context.h264_parameter_set.pic_width_in_mbs - 1);
-    writer.WriteUe(pic_height - 1);
-    writer.WriteBit(context.h264_parameter_set.frame_mbs_only_flag != 0);
+    writer.WriteUe(params.pic_width_in_mbs - 1);
+    writer.WriteUe(params.pic_height_in_map_units - 1);
+    writer.WriteBit(params.frame_mbs_only_flag);
 
-    if (!context.h264_parameter_set.frame_mbs_only_flag) {
-        writer.WriteBit(context.h264_parameter_set.flags.mbaff_frame.Value() != 0);
+    if (!params.frame_mbs_only_flag) {
+        writer.WriteBit(params.mbaff_frame);
     }
 
-    writer.WriteBit(context.h264_parameter_set.flags.direct_8x8_inference.Value() != 0);
+    writer.WriteBit(params.direct_8x8_inference);
     writer.WriteBit(false); // Frame cropping flag
     writer.WriteBit(false); // VUI parameter present flag
 
@@ -111,57 +155,41 @@ std::span<const u8> H264::ComposeFrame(const Host1x::NvdecCommon::NvdecRegisters
     writer.WriteUe(0);
     writer.WriteUe(0);
 
-    writer.WriteBit(context.h264_parameter_set.entropy_coding_mode_flag != 0);
-    writer.WriteBit(context.h264_parameter_set.pic_order_present_flag != 0);
+    writer.WriteBit(params.entropy_coding_mode_flag);
+    writer.WriteBit(params.pic_order_present_flag);
     writer.WriteUe(0);
-    writer.WriteUe(context.h264_parameter_set.num_refidx_l0_default_active);
-    writer.WriteUe(context.h264_parameter_set.num_refidx_l1_default_active);
-    writer.WriteBit(context.h264_parameter_set.flags.weighted_pred.Value() != 0);
-    writer.WriteU(static_cast<s32>(context.h264_parameter_set.weighted_bipred_idc.Value()), 2);
-    s32 pic_init_qp = static_cast<s32>(context.h264_parameter_set.pic_init_qp_minus26.Value());
-    writer.WriteSe(pic_init_qp);
+    writer.WriteUe(params.num_refidx_l0_default_active);
+    writer.WriteUe(params.num_refidx_l1_default_active);
+    writer.WriteBit(params.weighted_pred);
+    writer.WriteU(params.weighted_bipred_idc, 2);
+    writer.WriteSe(params.pic_init_qp_minus26);
     writer.WriteSe(0);
-    s32 chroma_qp_index_offset =
-        static_cast<s32>(context.h264_parameter_set.chroma_qp_index_offset.Value());
 
-    writer.WriteSe(chroma_qp_index_offset);
-    writer.WriteBit(context.h264_parameter_set.deblocking_filter_control_present_flag != 0);
-    writer.WriteBit(context.h264_parameter_set.flags.constrained_intra_pred.Value() != 0);
-    writer.WriteBit(context.h264_parameter_set.redundant_pic_cnt_present_flag != 0);
-    writer.WriteBit(context.h264_parameter_set.transform_8x8_mode_flag != 0);
+    writer.WriteSe(params.chroma_qp_index_offset);
+    writer.WriteBit(params.deblocking_filter_control_present_flag);
+    writer.WriteBit(params.constrained_intra_pred);
+    writer.WriteBit(params.redundant_pic_cnt_present_flag);
+    writer.WriteBit(params.transform_8x8_mode_flag);
 
     writer.WriteBit(true); // pic_scaling_matrix_present_flag
 
     for (s32 index = 0; index < 6; index++) {
         writer.WriteBit(true);
-        std::span<const u8> matrix{context.weight_scale};
-        writer.WriteScalingList(scan, matrix, index * 16, 16);
+        writer.WriteScalingList(scan, params.weight_scale, index * 16, 16);
     }
 
-    if (context.h264_parameter_set.transform_8x8_mode_flag) {
+    if (params.transform_8x8_mode_flag) {
         for (s32 index = 0; index < 2; index++) {
             writer.WriteBit(true);
-            std::span<const u8> matrix{context.weight_scale_8x8};
-            writer.WriteScalingList(scan, matrix, index * 64, 64);
+            writer.WriteScalingList(scan, params.weight_scale_8x8, index * 64, 64);
         }
     }
 
-    s32 chroma_qp_index_offset2 =
-        static_cast<s32>(context.h264_parameter_set.second_chroma_qp_index_offset.Value());
-
-    writer.WriteSe(chroma_qp_index_offset2);
+    writer.WriteSe(params.second_chroma_qp_index_offset);
 
     writer.End();
 
-    const auto& encoded_header = writer.GetByteArray();
-    frame.resize(encoded_header.size() + context.stream_len);
-    std::memcpy(frame.data(), encoded_header.data(), encoded_header.size());
-
-    *out_configuration_size = encoded_header.size();
-    host1x.GMMU().ReadBlock(state.frame_bitstream_offset, frame.data() + encoded_header.size(),
-                            context.stream_len);
-
-    return frame;
+    encoded_header = std::move(writer.GetByteArray());
 }
 
 H264BitWriter::H264BitWriter() = default;
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -71,10 +73,49 @@ public:
                                                    bool is_first_frame = false);
 
 private:
+    /// Stream parameters the SPS and PPS are encoded from
+    struct HeaderParameters {
+        u32 chroma_format_idc;
+        u32 log2_max_frame_num_minus4;
+        u32 pic_order_cnt_type;
+        s32 log2_max_pic_order_cnt_lsb_minus4;
+        bool delta_pic_order_always_zero_flag;
+        u32 max_num_ref_frames;
+        u32 pic_width_in_mbs;
+        u32 pic_height_in_map_units;
+        bool frame_mbs_only_flag;
+        bool mbaff_frame;
+        bool direct_8x8_inference;
+        bool entropy_coding_mode_flag;
+        bool pic_order_present_flag;
+        s32 num_refidx_l0_default_active;
+        s32 num_refidx_l1_default_active;
+        bool weighted_pred;
+        s32 weighted_bipred_idc;
+        s32 pic_init_qp_minus26;
+        s32 chroma_qp_index_offset;
+        s32 second_chroma_qp_index_offset;
+        bool deblocking_filter_control_present_flag;
+        bool constrained_intra_pred;
+        bool redundant_pic_cnt_present_flag;
+        bool transform_8x8_mode_flag;
+        std::array<u8, 0x60> weight_scale;
+        std::array<u8, 0x80> weight_scale_8x8;
+
+        bool operator==(const HeaderParameters&) const = default;
+    };
+
+    /// Encode the SPS and PPS of the stream into encoded_header
+    void EncodeHeader(const HeaderParameters& params);
+
     Common::ScratchBuffer<u8> frame;
     Common::ScratchBuffer<u8> scan;
     Host1x::Host1x& host1x;
 
+    /// Parameters of the last encoded header, it is only re-encoded when they change
+    std::optional<HeaderParameters> header_params;
+    std::vector<u8> encoded_header;
+
     struct H264ParameterSet {
         s32 log2_max_pic_order_cnt_lsb_minus4; ///< 0x00
         s32 delta_pic_order_always_zero_flag;  ///< 0x04
@@ -382,6 +382,7 @@ Vp9FrameContainer VP9::GetCurrentFrame(const Host1x::NvdecCommon::NvdecRegisters
     {
         // gpu.SyncGuestHost(); epic, why?
         current_frame.info = GetVp9PictureInfo(state);
+        current_frame.bit_stream = std::move(spare_bit_stream);
         current_frame.bit_stream.resize(current_frame.info.bitstream_size);
         host1x.GMMU().ReadBlock(state.frame_bitstream_offset, current_frame.bit_stream.data(),
                                 current_frame.info.bitstream_size);
@@ -577,7 +578,7 @@ std::vector<u8> VP9::ComposeCompressedHeader() {
         }
     }
     writer.End();
-    return writer.GetBuffer();
+    return std::move(writer.GetBuffer());
 }
 
 VpxBitStreamWriter VP9::ComposeUncompressedHeader() {
@@ -783,15 +784,19 @@ void VP9::ComposeFrame(const Host1x::NvdecCommon::NvdecRegisters& state) {
 
     uncomp_writer.WriteU(static_cast<s32>(compressed_header.size()), 16);
     uncomp_writer.Flush();
-    std::vector<u8> uncompressed_header = uncomp_writer.GetByteArray();
+    const std::vector<u8>& uncompressed_header = uncomp_writer.GetByteArray();
 
     // Write headers and frame to buffer
-    frame.resize(uncompressed_header.size() + compressed_header.size() + bitstream.size());
+    frame.resize_destructive(uncompressed_header.size() + compressed_header.size() +
+                             bitstream.size());
     std::copy(uncompressed_header.begin(), uncompressed_header.end(), frame.begin());
     std::copy(compressed_header.begin(), compressed_header.end(),
               frame.begin() + uncompressed_header.size());
     std::copy(bitstream.begin(), bitstream.end(),
               frame.begin() + uncompressed_header.size() + compressed_header.size());
+
+    // Keep the allocation around for the next frame's bitstream
+    spare_bit_stream = std::move(bitstream);
 }
 
 VpxRangeEncoder::VpxRangeEncoder() {
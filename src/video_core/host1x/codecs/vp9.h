@@ -189,6 +189,8 @@ private:
     std::array<s8, 2> loop_filter_mode_deltas{};
 
     Vp9FrameContainer next_frame{};
+    /// Bitstream buffer of the last composed frame, reused to read the next one
+    std::vector<u8> spare_bit_stream;
     std::array<Vp9EntropyProbs, 4> frame_ctxs{};
     bool swap_ref_indices{};
 
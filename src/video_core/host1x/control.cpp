@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <chrono>
+
 #include "common/assert.h"
 #include "video_core/host1x/control.h"
 #include "video_core/host1x/host1x.h"
@@ -27,7 +29,9 @@ void Control::ProcessMethod(Method method, u32 argument) {
 }
 
 void Control::Execute(u32 data) {
+    const auto start = std::chrono::steady_clock::now();
     host1x.GetSyncpointManager().WaitHost(data, syncpoint_value);
+    host1x.Stats().RecordSyncpointWait(std::chrono::steady_clock::now() - start);
 }
 
 } // namespace Tegra::Host1x
@@ -187,7 +187,11 @@ DecoderContext::DecoderContext(const Decoder& decoder) {
     m_codec_context = avcodec_alloc_context3(decoder.GetCodec());
     av_opt_set(m_codec_context->priv_data, "tune", "zerolatency", 0);
     m_codec_context->thread_count = 0;
-    m_codec_context->thread_type &= ~FF_THREAD_FRAME;
+    // Frame threading delays the output of each frame by a frame per thread, which only suits
+    // games that queue several frames ahead before presenting one.
+    if (!Settings::values.nvdec_frame_threading.GetValue()) {
+        m_codec_context->thread_type &= ~FF_THREAD_FRAME;
+    }
 }
 
 DecoderContext::~DecoderContext() {
@@ -229,7 +233,10 @@ std::unique_ptr<Frame> DecoderContext::ReceiveFrame(bool* out_is_interlaced) {
 
     const auto ReceiveImpl = [&](AVFrame* frame) {
         if (const int ret = avcodec_receive_frame(m_codec_context, frame); ret < 0) {
-            LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+            // A frame threaded decoder holds back its output until its threads are busy.
+            if (ret != AVERROR(EAGAIN)) {
+                LOG_ERROR(HW_GPU, "avcodec_receive_frame error: {}", AVError(ret));
+            }
             return false;
         }
 
@@ -360,6 +367,7 @@ void DecodeApi::Reset() {
     m_hardware_context.reset();
     m_decoder_context.reset();
     m_decoder.reset();
+    m_hardware_fallback = false;
 }
 
 bool DecodeApi::Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
@@ -370,7 +378,9 @@ bool DecodeApi::Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
     // Enable GPU decoding if requested.
     if (Settings::values.nvdec_emulation.GetValue() == Settings::NvdecEmulation::Gpu) {
         m_hardware_context.emplace();
-        m_hardware_context->InitializeForDecoder(*m_decoder_context, *m_decoder);
+        if (!m_hardware_context->InitializeForDecoder(*m_decoder_context, *m_decoder)) {
+            m_hardware_fallback = true;
+        }
     }
 
     // Open the decoder context.
@@ -382,6 +392,10 @@ bool DecodeApi::Initialize(Tegra::Host1x::NvdecCommon::VideoCodec codec) {
     return true;
 }
 
+bool DecodeApi::IsHardwareDecoding() const {
+    return m_decoder_context && m_decoder_context->GetCodecContext()->hw_device_ctx != nullptr;
+}
+
 bool DecodeApi::SendPacket(std::span<const u8> packet_data, size_t configuration_size) {
     FFmpeg::Packet packet(packet_data);
     return m_decoder_context->SendPacket(packet);
@@ -203,11 +203,20 @@ public:
     bool SendPacket(std::span<const u8> packet_data, size_t configuration_size);
     void ReceiveFrames(std::queue<std::unique_ptr<Frame>>& frame_queue);
 
+    /// Returns true if frames are decoded by a hardware decoder
+    bool IsHardwareDecoding() const;
+
+    /// Returns true if GPU decoding was requested but no hardware decoder could be used
+    bool HasHardwareFallback() const {
+        return m_hardware_fallback;
+    }
+
 private:
     std::optional<FFmpeg::Decoder> m_decoder;
     std::optional<FFmpeg::DecoderContext> m_decoder_context;
     std::optional<FFmpeg::HardwareContext> m_hardware_context;
     std::optional<FFmpeg::DeinterlaceFilter> m_deinterlace_filter;
+    bool m_hardware_fallback{};
 };
 
 } // namespace FFmpeg
@@ -7,6 +7,7 @@
 
 #include "common/address_space.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/host1x/stats.h"
 #include "video_core/host1x/syncpoint_manager.h"
 #include "video_core/memory_manager.h"
 
@@ -31,6 +32,15 @@ public:
         return syncpoint_manager;
     }
 
+    StatsCounters& Stats() {
+        return stats;
+    }
+
+    /// Returns the video decoding counters collected since boot
+    [[nodiscard]] Host1xStats GetStats() const {
+        return stats.GetStats();
+    }
+
     Tegra::MaxwellDeviceMemoryManager& MemoryManager() {
         return memory_manager;
     }
@@ -58,6 +68,7 @@ public:
 private:
     Core::System& system;
     SyncpointManager syncpoint_manager;
+    StatsCounters stats;
     Tegra::MaxwellDeviceMemoryManager memory_manager;
     Tegra::MemoryManager gmmu_manager;
     std::unique_ptr<Common::FlatAllocator<u32, 0, 32>> allocator;
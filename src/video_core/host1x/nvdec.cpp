@@ -28,6 +28,14 @@ void Nvdec::ProcessMethod(u32 method, u32 argument) {
     }
 }
 
+void Nvdec::SignalWhenDone(std::function<void()>&& callback) {
+    codec->SignalWhenDone(std::move(callback));
+}
+
+void Nvdec::WaitIdle() {
+    codec->WaitIdle();
+}
+
 std::unique_ptr<FFmpeg::Frame> Nvdec::GetFrame() {
     return codec->GetCurrentFrame();
 }
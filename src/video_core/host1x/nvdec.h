@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include "common/common_types.h"
@@ -22,6 +23,12 @@ public:
     /// Writes the method into the state, Invoke Execute() if encountered
     void ProcessMethod(u32 method, u32 argument);
 
+    /// Invoke the callback once all submitted frames are decoded
+    void SignalWhenDone(std::function<void()>&& callback);
+
+    /// Wait until all submitted frames are decoded
+    void WaitIdle();
+
     /// Return most recently decoded frame
     [[nodiscard]] std::unique_ptr<FFmpeg::Frame> GetFrame();
 
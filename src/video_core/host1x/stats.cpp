@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/logging/log.h"
+#include "video_core/host1x/stats.h"
+
+namespace Tegra::Host1x {
+
+namespace {
+// Decoded frames of a codec between reports in the log
+constexpr u64 ReportInterval = 1800;
+
+u64 ToMicroseconds(std::chrono::nanoseconds time) {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(time).count());
+}
+
+void RaiseTo(std::atomic<u64>& value, u64 candidate) {
+    u64 current = value.load(std::memory_order_relaxed);
+    while (current < candidate &&
+           !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+    }
+}
+} // Anonymous namespace
+
+void StatsCounters::RecordDecode(NvdecCommon::VideoCodec codec, std::chrono::nanoseconds time,
+                                 u64 num_frames, bool hardware) {
+    CodecCounters* const counters = FindCodec(codec);
+    if (!counters) {
+        return;
+    }
+    const u64 time_us = ToMicroseconds(time);
+    const u64 total_time_us =
+        counters->decode_time_us.fetch_add(time_us, std::memory_order_relaxed) + time_us;
+    if (num_frames == 0) {
+        return;
+    }
+    if (hardware) {
+        counters->num_hardware_frames.fetch_add(num_frames, std::memory_order_relaxed);
+    }
+    const u64 previous = counters->num_frames_decoded.fetch_add(num_frames,
+                                                                std::memory_order_relaxed);
+    const u64 total = previous + num_frames;
+    if (previous / ReportInterval == total / ReportInterval) {
+        return;
+    }
+    const u64 hardware_frames = counters->num_hardware_frames.load(std::memory_order_relaxed);
+    LOG_INFO(HW_GPU,
+             "Video decoding -- {} frames ({} hardware, {} software), {:.2f} ms per frame, "
+             "{} hardware fallbacks, at most {} queued",
+             total, hardware_frames, total - hardware_frames,
+             static_cast<double>(total_time_us) / 1000.0 / static_cast<double>(total),
+             counters->num_hardware_fallbacks.load(std::memory_order_relaxed),
+             counters->max_queue_depth.load(std::memory_order_relaxed));
+}
+
+void StatsCounters::RecordHardwareFallback(NvdecCommon::VideoCodec codec) {
+    if (CodecCounters* const counters = FindCodec(codec)) {
+        counters->num_hardware_fallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void StatsCounters::RecordQueueDepth(NvdecCommon::VideoCodec codec, u64 depth) {
+    if (CodecCounters* const counters = FindCodec(codec)) {
+        RaiseTo(counters->max_queue_depth, depth);
+    }
+}
+
+void StatsCounters::RecordConversion(std::chrono::nanoseconds time) {
+    num_frames_converted.fetch_add(1, std::memory_order_relaxed);
+    conversion_time_us.fetch_add(ToMicroseconds(time), std::memory_order_relaxed);
+}
+
+void StatsCounters::RecordSyncpointWait(std::chrono::nanoseconds time) {
+    syncpoint_wait_time_us.fetch_add(ToMicroseconds(time), std::memory_order_relaxed);
+}
+
+Host1xStats StatsCounters::GetStats() const {
+    const auto to_stats = [](const CodecCounters& counters) {
+        constexpr auto order = std::memory_order_relaxed;
+        const u64 frames = counters.num_frames_decoded.load(order);
+        const u64 hardware_frames = counters.num_hardware_frames.load(order);
+        return CodecStats{
+            .num_frames_decoded = frames,
+            .num_hardware_frames = hardware_frames,
+            .num_software_frames = frames - hardware_frames,
+            .num_hardware_fallbacks = counters.num_hardware_fallbacks.load(order),
+            .decode_time_us = counters.decode_time_us.load(order),
+            .max_queue_depth = counters.max_queue_depth.load(order),
+        };
+    };
+    return Host1xStats{
+        .h264 = to_stats(h264),
+        .vp8 = to_stats(vp8),
+        .vp9 = to_stats(vp9),
+        .num_frames_converted = num_frames_converted.load(std::memory_order_relaxed),
+        .conversion_time_us = conversion_time_us.load(std::memory_order_relaxed),
+        .syncpoint_wait_time_us = syncpoint_wait_time_us.load(std::memory_order_relaxed),
+    };
+}
+
+StatsCounters::CodecCounters* StatsCounters::FindCodec(NvdecCommon::VideoCodec codec) {
+    switch (codec) {
+    case NvdecCommon::VideoCodec::H264:
+        return &h264;
+    case NvdecCommon::VideoCodec::VP8:
+        return &vp8;
+    case NvdecCommon::VideoCodec::VP9:
+        return &vp9;
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace Tegra::Host1x
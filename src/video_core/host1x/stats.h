@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "common/common_types.h"
+#include "video_core/host1x/nvdec_common.h"
+
+namespace Tegra::Host1x {
+
+/// Counters of the video decoding done with a codec
+struct CodecStats {
+    u64 num_frames_decoded{};     ///< Frames received from the decoder
+    u64 num_hardware_frames{};    ///< Frames decoded by a hardware decoder
+    u64 num_software_frames{};    ///< Frames decoded in software
+    u64 num_hardware_fallbacks{}; ///< Hardware decoders that failed to start, using software
+    u64 decode_time_us{};         ///< Time spent sending bitstreams and receiving frames
+    u64 max_queue_depth{};        ///< Most bitstreams queued ahead of the decoder at once
+};
+
+/// Counters of the video work done by host1x since boot
+struct Host1xStats {
+    CodecStats h264{};
+    CodecStats vp8{};
+    CodecStats vp9{};
+    u64 num_frames_converted{};   ///< Frames converted and written out by VIC
+    u64 conversion_time_us{};     ///< Time VIC spent converting frames
+    u64 syncpoint_wait_time_us{}; ///< Time channels spent blocked on syncpoints
+};
+
+/// Collects the host1x counters from the decode, VIC and channel threads
+class StatsCounters {
+public:
+    void RecordDecode(NvdecCommon::VideoCodec codec, std::chrono::nanoseconds time,
+                      u64 num_frames, bool hardware);
+
+    void RecordHardwareFallback(NvdecCommon::VideoCodec codec);
+
+    void RecordQueueDepth(NvdecCommon::VideoCodec codec, u64 depth);
+
+    void RecordConversion(std::chrono::nanoseconds time);
+
+    void RecordSyncpointWait(std::chrono::nanoseconds time);
+
+    [[nodiscard]] Host1xStats GetStats() const;
+
+private:
+    struct CodecCounters {
+        std::atomic<u64> num_frames_decoded{};
+        std::atomic<u64> num_hardware_frames{};
+        std::atomic<u64> num_hardware_fallbacks{};
+        std::atomic<u64> decode_time_us{};
+        std::atomic<u64> max_queue_depth{};
+    };
+
+    CodecCounters* FindCodec(NvdecCommon::VideoCodec codec);
+
+    CodecCounters h264;
+    CodecCounters vp8;
+    CodecCounters vp9;
+    std::atomic<u64> num_frames_converted{};
+    std::atomic<u64> conversion_time_us{};
+    std::atomic<u64> syncpoint_wait_time_us{};
+};
+
+} // namespace Tegra::Host1x
@@ -13,17 +13,20 @@ SyncptIncrManager::SyncptIncrManager(Host1x& host1x_) : host1x(host1x_) {}
 SyncptIncrManager::~SyncptIncrManager() = default;
 
 void SyncptIncrManager::Increment(u32 id) {
+    std::scoped_lock lock{increment_lock};
     increments.emplace_back(0, 0, id, true);
     IncrementAllDone();
 }
 
 u32 SyncptIncrManager::IncrementWhenDone(u32 class_id, u32 id) {
+    std::scoped_lock lock{increment_lock};
     const u32 handle = current_id++;
     increments.emplace_back(handle, class_id, id);
     return handle;
 }
 
 void SyncptIncrManager::SignalDone(u32 handle) {
+    std::scoped_lock lock{increment_lock};
     const auto done_incr =
         std::find_if(increments.begin(), increments.end(),
                      [handle](const SyncptIncr& incr) { return incr.id == handle; });
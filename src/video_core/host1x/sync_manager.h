@@ -34,13 +34,14 @@ public:
     /// Returns a handle to increment later
     u32 IncrementWhenDone(u32 class_id, u32 id);
 
-    /// IncrememntAllDone, including handle
+    /// IncrememntAllDone, including handle. May be called from a decode thread.
     void SignalDone(u32 handle);
 
+private:
     /// Increment all sequential pending increments that are already done.
+    /// increment_lock must be held.
     void IncrementAllDone();
 
-private:
     std::vector<SyncptIncr> increments;
     std::mutex increment_lock;
     u32 current_id{};
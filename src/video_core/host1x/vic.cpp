@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <chrono>
+#include <optional>
 
 extern "C" {
 #if defined(__GNUC__) || defined(__clang__)
@@ -16,13 +18,19 @@ extern "C" {
 
 #include "common/assert.h"
 #include "common/bit_field.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 
+#include "video_core/engines/fermi_2d.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/guest_memory.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/host1x/nvdec.h"
 #include "video_core/host1x/vic.h"
+#include "video_core/host1x/vic_color.h"
 #include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/textures/decoders.h"
 
 namespace Tegra {
@@ -30,12 +38,39 @@ namespace Tegra {
 namespace Host1x {
 
 namespace {
+/// Output surfaces are written in place when the guest memory is contiguous on the host, and
+/// through the scratch buffers otherwise.
+using SurfaceMemory =
+    Tegra::Memory::GpuGuestMemoryScoped<u8, Tegra::Memory::GuestMemoryFlags::SafeWrite>;
+
 enum class VideoPixelFormat : u64_le {
     RGBA8 = 0x1f,
     BGRA8 = 0x20,
     RGBX8 = 0x23,
     YUV420 = 0x44,
 };
+
+/// Height in rows of a GOB, the unit block linear surfaces are swizzled in
+constexpr u32 GobHeight = 8;
+
+/// Number of output surfaces remembered to skip rewriting them with identical frames
+constexpr size_t MaxCachedOutputs = 16;
+
+/// Hash the planes of a decoded 4:2:0 frame, or return nullopt for other formats
+std::optional<u64> HashFrame(const FFmpeg::Frame& frame) {
+    const auto format = frame.GetPixelFormat();
+    const int num_planes = format == AV_PIX_FMT_YUV420P ? 3 : format == AV_PIX_FMT_NV12 ? 2 : 0;
+    if (num_planes == 0) {
+        return std::nullopt;
+    }
+    u64 hash = static_cast<u64>(format);
+    for (int plane = 0; plane < num_planes; ++plane) {
+        const int rows = plane == 0 ? frame.GetHeight() : (frame.GetHeight() + 1) / 2;
+        const auto size = static_cast<size_t>(frame.GetStride(plane)) * static_cast<size_t>(rows);
+        hash = Common::RuntimeHash64WithSeed(frame.GetData(plane), size, hash);
+    }
+    return hash;
+}
 } // Anonymous namespace
 
 union VicConfig {
@@ -94,6 +129,24 @@ void Vic::Execute() {
         LOG_WARNING(Service_NVDRV, "Frame dimensions {}x{} don't match surface dimensions {}x{}",
                     frame->GetWidth(), frame->GetHeight(), surface_width, surface_height);
     }
+
+    // Looping videos and static menus decode identical frames over and over. If the surface
+    // already holds this frame converted with the same config, leave it as is.
+    const std::optional<u64> frame_hash = HashFrame(*frame);
+    const CachedOutput output{
+        .config = config.raw,
+        .frame_hash = frame_hash.value_or(0),
+        .chroma_address = output_surface_chroma_address,
+    };
+    if (frame_hash) {
+        const auto it = cached_outputs.find(output_surface_luma_address);
+        if (it != cached_outputs.end() && it->second == output) {
+            LOG_TRACE(Service_NVDRV, "Frame unchanged, skipping conversion");
+            return;
+        }
+    }
+
+    const auto conversion_start = std::chrono::steady_clock::now();
     switch (config.pixel_format) {
     case VideoPixelFormat::RGBA8:
     case VideoPixelFormat::BGRA8:
@@ -105,8 +158,18 @@ void Vic::Execute() {
         break;
     default:
         UNIMPLEMENTED_MSG("Unknown video pixel format {:X}", config.pixel_format.Value());
-        break;
+        return;
+    }
+    host1x.Stats().RecordConversion(std::chrono::steady_clock::now() - conversion_start);
+
+    if (!frame_hash) {
+        cached_outputs.erase(output_surface_luma_address);
+        return;
     }
+    if (cached_outputs.size() >= MaxCachedOutputs) {
+        cached_outputs.clear();
+    }
+    cached_outputs.insert_or_assign(output_surface_luma_address, output);
 }
 
 void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config) {
@@ -116,6 +179,11 @@ void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
     const auto frame_height = frame->GetHeight();
     const auto frame_format = frame->GetPixelFormat();
 
+    if (frame_format == AV_PIX_FMT_YUV420P || frame_format == AV_PIX_FMT_NV12) {
+        ConvertYUVToRGBFrame(*frame, config);
+        return;
+    }
+
     if (!scaler_ctx || frame_width != scaler_width || frame_height != scaler_height) {
         const AVPixelFormat target_format = [pixel_format = config.pixel_format]() {
             switch (pixel_format) {
@@ -138,31 +206,50 @@ void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
         scaler_height = frame_height;
         converted_frame_buffer.reset();
     }
+
+    // Use the minimum of surface/frame dimensions to avoid buffer overflow.
+    const u32 surface_width = static_cast<u32>(config.surface_width_minus1) + 1;
+    const u32 surface_height = static_cast<u32>(config.surface_height_minus1) + 1;
+    const u32 width = std::min(surface_width, static_cast<u32>(frame_width));
+    const u32 height = std::min(surface_height, static_cast<u32>(frame_height));
+    const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
+    const std::array<int, 4> converted_stride{frame_width * 4, frame_height * 4, 0, 0};
+
+    if (blk_kind == 0 && width == static_cast<u32>(frame_width) &&
+        height == static_cast<u32>(frame_height)) {
+        // A pitch linear surface matching the frame is converted straight into guest memory.
+        const size_t linear_size = width * height * 4;
+        luma_buffer.resize_destructive(linear_size);
+        SurfaceMemory surface(host1x.GMMU(), output_surface_luma_address, linear_size,
+                              &luma_buffer);
+        u8* const surface_addr{surface.data()};
+        sws_scale(scaler_ctx, frame->GetPlanes(), frame->GetStrides(), 0, frame_height,
+                  &surface_addr, converted_stride.data());
+        return;
+    }
+
     if (!converted_frame_buffer) {
         const size_t frame_size = frame_width * frame_height * 4;
         converted_frame_buffer = AVMallocPtr{static_cast<u8*>(av_malloc(frame_size)), av_free};
     }
-    const std::array<int, 4> converted_stride{frame_width * 4, frame_height * 4, 0, 0};
     u8* const converted_frame_buf_addr{converted_frame_buffer.get()};
     sws_scale(scaler_ctx, frame->GetPlanes(), frame->GetStrides(), 0, frame_height,
               &converted_frame_buf_addr, converted_stride.data());
 
-    // Use the minimum of surface/frame dimensions to avoid buffer overflow.
-    const u32 surface_width = static_cast<u32>(config.surface_width_minus1) + 1;
-    const u32 surface_height = static_cast<u32>(config.surface_height_minus1) + 1;
-    const u32 width = std::min(surface_width, static_cast<u32>(frame_width));
-    const u32 height = std::min(surface_height, static_cast<u32>(frame_height));
-    const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
+    if (blk_kind != 0 && width == static_cast<u32>(frame_width) &&
+        WriteDirectOutput(std::span<const u8>(converted_frame_buf_addr, 4 * width * height),
+                          config, width, height)) {
+        return;
+    }
     if (blk_kind != 0) {
         // swizzle pitch linear to block linear
         const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
         const auto size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
         luma_buffer.resize_destructive(size);
+        SurfaceMemory surface(host1x.GMMU(), output_surface_luma_address, size, &luma_buffer);
         std::span<const u8> frame_buff(converted_frame_buf_addr, 4 * width * height);
-        Texture::SwizzleSubrect(luma_buffer, frame_buff, 4, width, height, 1, 0, 0, width, height,
+        Texture::SwizzleSubrect(surface, frame_buff, 4, width, height, 1, 0, 0, width, height,
                                 block_height, 0, width * 4);
-
-        host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(), size);
     } else {
         // send pitch linear frame
         const size_t linear_size = width * height * 4;
@@ -171,6 +258,121 @@ void Vic::WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
     }
 }
 
+void Vic::ConvertYUVToRGBFrame(const FFmpeg::Frame& frame, const VicConfig& config) {
+    const auto layout = frame.GetPixelFormat() == AV_PIX_FMT_NV12
+                            ? VicColor::ChromaLayout::SemiPlanar
+                            : VicColor::ChromaLayout::Planar;
+    const auto order = config.pixel_format == VideoPixelFormat::BGRA8 ? VicColor::RgbOrder::BGRA
+                                                                      : VicColor::RgbOrder::RGBA;
+
+    // Use the minimum of surface/frame dimensions to avoid buffer overflow.
+    const u32 surface_width = static_cast<u32>(config.surface_width_minus1) + 1;
+    const u32 surface_height = static_cast<u32>(config.surface_height_minus1) + 1;
+    const u32 width = std::min(surface_width, static_cast<u32>(frame.GetWidth()));
+    const u32 height = std::min(surface_height, static_cast<u32>(frame.GetHeight()));
+    const u32 pitch = width * 4;
+
+    const u8* const luma_src = frame.GetData(0);
+    const u8* const chroma_u_src = frame.GetData(1);
+    const u8* const chroma_v_src = frame.GetData(2);
+    const auto luma_stride = static_cast<size_t>(frame.GetStride(0));
+    const auto chroma_stride = static_cast<size_t>(frame.GetStride(1));
+    const auto convert_rows = [&](u8* output, u32 first_row, u32 num_rows) {
+        for (u32 row = 0; row < num_rows; ++row) {
+            const u32 y = first_row + row;
+            const size_t chroma_offset = (y / 2) * chroma_stride;
+            VicColor::ConvertRowToRgb(std::span<u8>(output + row * pitch, pitch),
+                                      luma_src + y * luma_stride, chroma_u_src + chroma_offset,
+                                      layout == VicColor::ChromaLayout::Planar
+                                          ? chroma_v_src + chroma_offset
+                                          : nullptr,
+                                      layout, order);
+        }
+    };
+
+    const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
+    if (blk_kind == 0) {
+        // Pitch linear rows are converted straight into guest memory.
+        const size_t linear_size = static_cast<size_t>(pitch) * height;
+        luma_buffer.resize_destructive(linear_size);
+        SurfaceMemory surface(host1x.GMMU(), output_surface_luma_address, linear_size,
+                              &luma_buffer);
+        convert_rows(surface.data(), 0, height);
+        return;
+    }
+
+    // Convert one block row at a time into a small buffer which stays in cache, and swizzle it
+    // into the surface before moving on to the next one.
+    const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+    if (Settings::values.vic_direct_output.GetValue()) {
+        // Convert the whole frame so it can be handed to the texture cache as is
+        strip_buffer.resize_destructive(static_cast<size_t>(pitch) * height);
+        convert_rows(strip_buffer.data(), 0, height);
+        if (WriteDirectOutput(strip_buffer, config, width, height)) {
+            return;
+        }
+        const auto size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+        luma_buffer.resize_destructive(size);
+        SurfaceMemory surface(host1x.GMMU(), output_surface_luma_address, size, &luma_buffer);
+        Texture::SwizzleSubrect(surface, strip_buffer, 4, width, height, 1, 0, 0, width, height,
+                                block_height, 0, pitch);
+        return;
+    }
+
+    const u32 strip_rows = GobHeight << block_height;
+    const auto size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+    luma_buffer.resize_destructive(size);
+    strip_buffer.resize_destructive(static_cast<size_t>(pitch) * strip_rows);
+    SurfaceMemory surface(host1x.GMMU(), output_surface_luma_address, size, &luma_buffer);
+    for (u32 y = 0; y < height; y += strip_rows) {
+        const u32 rows = std::min(strip_rows, height - y);
+        convert_rows(strip_buffer.data(), y, rows);
+        std::span<const u8> strip(strip_buffer.data(), static_cast<size_t>(pitch) * rows);
+        Texture::SwizzleSubrect(surface, strip, 4, width, height, 1, 0, y, width, rows,
+                                block_height, 0, pitch);
+    }
+}
+
+bool Vic::WriteDirectOutput(std::span<const u8> pixels, const VicConfig& config, u32 width,
+                            u32 height) {
+    if (!Settings::values.vic_direct_output.GetValue()) {
+        return false;
+    }
+    // Only whole block linear surfaces in formats the guest samples as is can skip guest memory
+    const u32 surface_width = static_cast<u32>(config.surface_width_minus1) + 1;
+    const u32 surface_height = static_cast<u32>(config.surface_height_minus1) + 1;
+    if (width != surface_width || height != surface_height ||
+        static_cast<u32>(config.block_linear_kind) == 0) {
+        return false;
+    }
+    Engines::Fermi2D::Surface surface{};
+    switch (config.pixel_format) {
+    case VideoPixelFormat::RGBA8:
+        surface.format = RenderTargetFormat::A8B8G8R8_UNORM;
+        break;
+    case VideoPixelFormat::BGRA8:
+        surface.format = RenderTargetFormat::A8R8G8B8_UNORM;
+        break;
+    default:
+        return false;
+    }
+    const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+    surface.linear = Engines::Fermi2D::MemoryLayout::BlockLinear;
+    surface.block_height.Assign(block_height);
+    surface.depth = 1;
+    surface.width = width;
+    surface.height = height;
+
+    auto& gmmu = host1x.GMMU();
+    VideoCore::RasterizerInterface* const rasterizer = gmmu.GetRasterizer();
+    const auto size = Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+    if (!rasterizer || !gmmu.IsContinuousRange(output_surface_luma_address, size)) {
+        return false;
+    }
+    const auto address = gmmu.GpuToCpuAddress(output_surface_luma_address);
+    return address && rasterizer->AccelerateSurfaceWrite(*address, surface, pixels);
+}
+
 void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config) {
     LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
 
@@ -186,34 +388,37 @@ void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
     luma_buffer.resize_destructive(aligned_width * surface_height);
     chroma_buffer.resize_destructive(aligned_width * surface_height / 2);
 
-    // Populate luma buffer
-    const u8* luma_src = frame->GetData(0);
-    for (std::size_t y = 0; y < frame_height; ++y) {
-        const std::size_t src = y * stride;
-        const std::size_t dst = y * aligned_width;
-        std::memcpy(luma_buffer.data() + dst, luma_src + src, frame_width);
+    // Populate luma surface
+    {
+        SurfaceMemory luma(host1x.GMMU(), output_surface_luma_address, luma_buffer.size(),
+                           &luma_buffer);
+        const u8* luma_src = frame->GetData(0);
+        for (std::size_t y = 0; y < frame_height; ++y) {
+            const std::size_t src = y * stride;
+            const std::size_t dst = y * aligned_width;
+            std::memcpy(luma.data() + dst, luma_src + src, frame_width);
+        }
     }
-    host1x.GMMU().WriteBlock(output_surface_luma_address, luma_buffer.data(), luma_buffer.size());
 
     // Chroma
     const std::size_t half_height = frame_height / 2;
     const auto half_stride = static_cast<size_t>(frame->GetStride(1));
 
+    SurfaceMemory chroma(host1x.GMMU(), output_surface_chroma_address, chroma_buffer.size(),
+                         &chroma_buffer);
     switch (frame->GetPixelFormat()) {
     case AV_PIX_FMT_YUV420P: {
         // Frame from FFmpeg software
         // Populate chroma buffer from both channels with interleaving.
         const std::size_t half_width = frame_width / 2;
-        u8* chroma_buffer_data = chroma_buffer.data();
+        u8* chroma_buffer_data = chroma.data();
         const u8* chroma_b_src = frame->GetData(1);
         const u8* chroma_r_src = frame->GetData(2);
         for (std::size_t y = 0; y < half_height; ++y) {
             const std::size_t src = y * half_stride;
             const std::size_t dst = y * aligned_width;
-            for (std::size_t x = 0; x < half_width; ++x) {
-                chroma_buffer_data[dst + x * 2] = chroma_b_src[src + x];
-                chroma_buffer_data[dst + x * 2 + 1] = chroma_r_src[src + x];
-            }
+            VicColor::InterleaveChroma(chroma_buffer_data + dst, chroma_b_src + src,
+                                       chroma_r_src + src, half_width);
         }
         break;
     }
@@ -224,7 +429,7 @@ void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
         for (std::size_t y = 0; y < half_height; ++y) {
             const std::size_t src = y * stride;
             const std::size_t dst = y * aligned_width;
-            std::memcpy(chroma_buffer.data() + dst, chroma_src + src, frame_width);
+            std::memcpy(chroma.data() + dst, chroma_src + src, frame_width);
         }
         break;
     }
@@ -232,8 +437,6 @@ void Vic::WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& c
         ASSERT(false);
         break;
     }
-    host1x.GMMU().WriteBlock(output_surface_chroma_address, chroma_buffer.data(),
-                             chroma_buffer.size());
 }
 
 } // namespace Host1x
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <memory>
+#include <span>
+#include <unordered_map>
 
 #include "common/common_types.h"
 #include "common/scratch_buffer.h"
@@ -41,8 +43,24 @@ private:
 
     void WriteRGBFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config);
 
+    /// Convert a YUV420P or NV12 frame to RGB without going through swscale
+    void ConvertYUVToRGBFrame(const FFmpeg::Frame& frame, const VicConfig& config);
+
+    /// Hand a converted RGB frame to the texture cache instead of writing it to guest memory
+    bool WriteDirectOutput(std::span<const u8> pixels, const VicConfig& config, u32 width,
+                           u32 height);
+
     void WriteYUVFrame(std::unique_ptr<FFmpeg::Frame> frame, const VicConfig& config);
 
+    /// Frame last written to an output surface
+    struct CachedOutput {
+        u64 config;
+        u64 frame_hash;
+        GPUVAddr chroma_address;
+
+        bool operator==(const CachedOutput&) const = default;
+    };
+
     Host1x& host1x;
     std::shared_ptr<Tegra::Host1x::Nvdec> nvdec_processor;
 
@@ -52,11 +70,15 @@ private:
     AVMallocPtr converted_frame_buffer;
     Common::ScratchBuffer<u8> luma_buffer;
     Common::ScratchBuffer<u8> chroma_buffer;
+    Common::ScratchBuffer<u8> strip_buffer;
 
     GPUVAddr config_struct_address{};
     GPUVAddr output_surface_luma_address{};
     GPUVAddr output_surface_chroma_address{};
 
+    /// Frames last written to each output surface, keyed by luma address
+    std::unordered_map<GPUVAddr, CachedOutput> cached_outputs;
+
     SwsContext* scaler_ctx{};
     s32 scaler_width{};
     s32 scaler_height{};
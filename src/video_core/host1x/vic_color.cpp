@@ -0,0 +1,258 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "video_core/host1x/vic_color.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+namespace Tegra::Host1x::VicColor {
+namespace {
+
+// BT.601 limited range to full range RGB, evaluated in 16 bit lanes holding values scaled by 64.
+// Coefficients are applied as (value * 128 * coeff) >> 16, with coeff in 1/32768 units, and the
+// parts of coefficients above one are added separately so everything fits in 16 bits. The scalar
+// and vector paths use exactly the same integer operations, so they produce identical output.
+constexpr s16 LumaFraction = 5387;   // 1.164383 - 1
+constexpr s16 RedFromV = 19531;      // 1.596027 - 1
+constexpr s16 GreenFromU = 12837;    // 0.391762
+constexpr s16 GreenFromV = 26639;    // 0.812968
+constexpr s16 BlueFromU = 565;       // 2.017232 - 2
+constexpr s16 RoundingBias = 32;     // Half of the 1/64 scale
+
+s16 MulHigh(s32 value, s16 coeff) {
+    return static_cast<s16>((value * coeff) >> 16);
+}
+
+s16 AddSat(s32 lhs, s32 rhs) {
+    return static_cast<s16>(std::clamp(lhs + rhs, -32768, 32767));
+}
+
+s16 SubSat(s32 lhs, s32 rhs) {
+    return static_cast<s16>(std::clamp(lhs - rhs, -32768, 32767));
+}
+
+u8 ToChannel(s16 value) {
+    return static_cast<u8>(std::clamp(AddSat(value, RoundingBias) >> 6, 0, 255));
+}
+
+void ConvertPixel(u8* output, u8 y_sample, u8 u_sample, u8 v_sample, RgbOrder order) {
+    const s32 y = y_sample - 16;
+    const s32 u = u_sample - 128;
+    const s32 v = v_sample - 128;
+
+    const s16 luma = AddSat(y * 64, MulHigh(y * 128, LumaFraction));
+    const s16 red = AddSat(v * 64, MulHigh(v * 128, RedFromV));
+    const s16 green = AddSat(MulHigh(u * 128, GreenFromU), MulHigh(v * 128, GreenFromV));
+    const s16 blue = AddSat(u * 128, MulHigh(u * 128, BlueFromU));
+
+    const u8 r = ToChannel(AddSat(luma, red));
+    const u8 g = ToChannel(SubSat(luma, green));
+    const u8 b = ToChannel(AddSat(luma, blue));
+    output[0] = order == RgbOrder::RGBA ? r : b;
+    output[1] = g;
+    output[2] = order == RgbOrder::RGBA ? b : r;
+    output[3] = 0xFF;
+}
+
+#ifdef ARCHITECTURE_x86_64
+/// Converts 16 pixels, with 8 U and V samples widened to 16 bits with the bias removed
+void ConvertPixels(u8* output, __m128i y_samples, __m128i u, __m128i v, RgbOrder order) {
+    const __m128i zero = _mm_setzero_si128();
+    const auto mul_high = [](__m128i value, s16 coeff) {
+        return _mm_mulhi_epi16(value, _mm_set1_epi16(coeff));
+    };
+    const auto luma_of = [&](__m128i y) {
+        y = _mm_sub_epi16(y, _mm_set1_epi16(16));
+        return _mm_adds_epi16(_mm_slli_epi16(y, 6), mul_high(_mm_slli_epi16(y, 7), LumaFraction));
+    };
+    const __m128i luma_lo = luma_of(_mm_unpacklo_epi8(y_samples, zero));
+    const __m128i luma_hi = luma_of(_mm_unpackhi_epi8(y_samples, zero));
+
+    const __m128i u7 = _mm_slli_epi16(u, 7);
+    const __m128i v7 = _mm_slli_epi16(v, 7);
+    const __m128i red = _mm_adds_epi16(_mm_slli_epi16(v, 6), mul_high(v7, RedFromV));
+    const __m128i green = _mm_adds_epi16(mul_high(u7, GreenFromU), mul_high(v7, GreenFromV));
+    const __m128i blue = _mm_adds_epi16(u7, mul_high(u7, BlueFromU));
+
+    const __m128i bias = _mm_set1_epi16(RoundingBias);
+    const auto to_channels = [&](__m128i lo, __m128i hi) {
+        lo = _mm_srai_epi16(_mm_adds_epi16(lo, bias), 6);
+        hi = _mm_srai_epi16(_mm_adds_epi16(hi, bias), 6);
+        return _mm_packus_epi16(lo, hi);
+    };
+    // Each chroma sample covers two pixels
+    const __m128i r = to_channels(_mm_adds_epi16(luma_lo, _mm_unpacklo_epi16(red, red)),
+                                  _mm_adds_epi16(luma_hi, _mm_unpackhi_epi16(red, red)));
+    const __m128i g = to_channels(_mm_subs_epi16(luma_lo, _mm_unpacklo_epi16(green, green)),
+                                  _mm_subs_epi16(luma_hi, _mm_unpackhi_epi16(green, green)));
+    const __m128i b = to_channels(_mm_adds_epi16(luma_lo, _mm_unpacklo_epi16(blue, blue)),
+                                  _mm_adds_epi16(luma_hi, _mm_unpackhi_epi16(blue, blue)));
+    const __m128i a = _mm_set1_epi8(static_cast<char>(0xFF));
+
+    const __m128i first = order == RgbOrder::RGBA ? r : b;
+    const __m128i third = order == RgbOrder::RGBA ? b : r;
+    const __m128i first_second_lo = _mm_unpacklo_epi8(first, g);
+    const __m128i first_second_hi = _mm_unpackhi_epi8(first, g);
+    const __m128i third_alpha_lo = _mm_unpacklo_epi8(third, a);
+    const __m128i third_alpha_hi = _mm_unpackhi_epi8(third, a);
+    auto* const dst = reinterpret_cast<__m128i*>(output);
+    _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(first_second_lo, third_alpha_lo));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(first_second_lo, third_alpha_lo));
+    _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(first_second_hi, third_alpha_hi));
+    _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(first_second_hi, third_alpha_hi));
+}
+
+size_t ConvertRowVector(u8* output, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                        size_t width, ChromaLayout layout, RgbOrder order) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i chroma_bias = _mm_set1_epi16(128);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i y_samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luma + x));
+        __m128i u;
+        __m128i v;
+        if (layout == ChromaLayout::SemiPlanar) {
+            const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma_u + x));
+            u = _mm_and_si128(uv, _mm_set1_epi16(0xFF));
+            v = _mm_srli_epi16(uv, 8);
+        } else {
+            u = _mm_unpacklo_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_u + x / 2)), zero);
+            v = _mm_unpacklo_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_v + x / 2)), zero);
+        }
+        ConvertPixels(output + x * 4, y_samples, _mm_sub_epi16(u, chroma_bias),
+                      _mm_sub_epi16(v, chroma_bias), order);
+    }
+    return x;
+}
+
+size_t InterleaveChromaVector(u8* output, const u8* chroma_u, const u8* chroma_v, size_t count) {
+    size_t x = 0;
+    for (; x + 16 <= count; x += 16) {
+        const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma_u + x));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma_v + x));
+        auto* const dst = reinterpret_cast<__m128i*>(output + x * 2);
+        _mm_storeu_si128(dst + 0, _mm_unpacklo_epi8(u, v));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi8(u, v));
+    }
+    return x;
+}
+#elif defined(ARCHITECTURE_arm64)
+int16x8_t MulHigh(int16x8_t value, s16 coeff) {
+    const int16x4_t coeffs = vdup_n_s16(coeff);
+    return vcombine_s16(vshrn_n_s32(vmull_s16(vget_low_s16(value), coeffs), 16),
+                        vshrn_n_s32(vmull_s16(vget_high_s16(value), coeffs), 16));
+}
+
+/// Converts 16 pixels, with 8 U and V samples widened to 16 bits with the bias removed
+void ConvertPixels(u8* output, uint8x16_t y_samples, int16x8_t u, int16x8_t v, RgbOrder order) {
+    const auto luma_of = [](uint8x8_t samples) {
+        const int16x8_t y =
+            vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(samples)), vdupq_n_s16(16));
+        return vqaddq_s16(vshlq_n_s16(y, 6), MulHigh(vshlq_n_s16(y, 7), LumaFraction));
+    };
+    const int16x8_t luma_lo = luma_of(vget_low_u8(y_samples));
+    const int16x8_t luma_hi = luma_of(vget_high_u8(y_samples));
+
+    const int16x8_t u7 = vshlq_n_s16(u, 7);
+    const int16x8_t v7 = vshlq_n_s16(v, 7);
+    const int16x8_t red = vqaddq_s16(vshlq_n_s16(v, 6), MulHigh(v7, RedFromV));
+    const int16x8_t green = vqaddq_s16(MulHigh(u7, GreenFromU), MulHigh(v7, GreenFromV));
+    const int16x8_t blue = vqaddq_s16(u7, MulHigh(u7, BlueFromU));
+
+    const int16x8_t bias = vdupq_n_s16(RoundingBias);
+    const auto to_channels = [&](int16x8_t lo, int16x8_t hi) {
+        return vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(lo, bias), 6)),
+                           vqmovun_s16(vshrq_n_s16(vqaddq_s16(hi, bias), 6)));
+    };
+    // Each chroma sample covers two pixels
+    const uint8x16_t r = to_channels(vqaddq_s16(luma_lo, vzip1q_s16(red, red)),
+                                     vqaddq_s16(luma_hi, vzip2q_s16(red, red)));
+    const uint8x16_t g = to_channels(vqsubq_s16(luma_lo, vzip1q_s16(green, green)),
+                                     vqsubq_s16(luma_hi, vzip2q_s16(green, green)));
+    const uint8x16_t b = to_channels(vqaddq_s16(luma_lo, vzip1q_s16(blue, blue)),
+                                     vqaddq_s16(luma_hi, vzip2q_s16(blue, blue)));
+
+    uint8x16x4_t pixels;
+    pixels.val[0] = order == RgbOrder::RGBA ? r : b;
+    pixels.val[1] = g;
+    pixels.val[2] = order == RgbOrder::RGBA ? b : r;
+    pixels.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(output, pixels);
+}
+
+size_t ConvertRowVector(u8* output, const u8* luma, const u8* chroma_u, const u8* chroma_v,
+                        size_t width, ChromaLayout layout, RgbOrder order) {
+    const int16x8_t chroma_bias = vdupq_n_s16(128);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16_t y_samples = vld1q_u8(luma + x);
+        uint8x8_t u;
+        uint8x8_t v;
+        if (layout == ChromaLayout::SemiPlanar) {
+            const uint8x8x2_t uv = vld2_u8(chroma_u + x);
+            u = uv.val[0];
+            v = uv.val[1];
+        } else {
+            u = vld1_u8(chroma_u + x / 2);
+            v = vld1_u8(chroma_v + x / 2);
+        }
+        ConvertPixels(output + x * 4, y_samples,
+                      vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), chroma_bias),
+                      vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), chroma_bias), order);
+    }
+    return x;
+}
+
+size_t InterleaveChromaVector(u8* output, const u8* chroma_u, const u8* chroma_v, size_t count) {
+    size_t x = 0;
+    for (; x + 16 <= count; x += 16) {
+        uint8x16x2_t uv;
+        uv.val[0] = vld1q_u8(chroma_u + x);
+        uv.val[1] = vld1q_u8(chroma_v + x);
+        vst2q_u8(output + x * 2, uv);
+    }
+    return x;
+}
+#else
+size_t ConvertRowVector(u8*, const u8*, const u8*, const u8*, size_t, ChromaLayout, RgbOrder) {
+    return 0;
+}
+
+size_t InterleaveChromaVector(u8*, const u8*, const u8*, size_t) {
+    return 0;
+}
+#endif
+
+} // Anonymous namespace
+
+void ConvertRowToRgb(std::span<u8> output, const u8* luma, const u8* chroma_u,
+                     const u8* chroma_v, ChromaLayout layout, RgbOrder order) {
+    const size_t width = output.size() / 4;
+    size_t x = ConvertRowVector(output.data(), luma, chroma_u, chroma_v, width, layout, order);
+    for (; x < width; ++x) {
+        const size_t chroma_x = x / 2;
+        const u8 u = layout == ChromaLayout::SemiPlanar ? chroma_u[chroma_x * 2]
+                                                        : chroma_u[chroma_x];
+        const u8 v = layout == ChromaLayout::SemiPlanar ? chroma_u[chroma_x * 2 + 1]
+                                                        : chroma_v[chroma_x];
+        ConvertPixel(&output[x * 4], luma[x], u, v, order);
+    }
+}
+
+void InterleaveChroma(u8* output, const u8* chroma_u, const u8* chroma_v, size_t count) {
+    size_t x = InterleaveChromaVector(output, chroma_u, chroma_v, count);
+    for (; x < count; ++x) {
+        output[x * 2] = chroma_u[x];
+        output[x * 2 + 1] = chroma_v[x];
+    }
+}
+
+} // namespace Tegra::Host1x::VicColor
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Tegra::Host1x::VicColor {
+
+/// Layout of the chroma planes of a 4:2:0 frame
+enum class ChromaLayout {
+    Planar,     ///< Separate U and V planes (YUV420P)
+    SemiPlanar, ///< A single plane of interleaved U and V samples (NV12)
+};
+
+/// Order of the color channels of a 32 bit pixel, alpha is always last and set to 0xFF
+enum class RgbOrder {
+    RGBA,
+    BGRA,
+};
+
+/**
+ * Convert one row of a limited range BT.601 4:2:0 frame to 32 bit RGB.
+ * Each chroma sample covers two pixels horizontally, chroma is not interpolated.
+ *
+ * @param output   - Output pixels, four bytes each. The width of the row is output.size() / 4.
+ * @param luma     - Luma samples of the row.
+ * @param chroma_u - U samples of the row, or interleaved UV samples for ChromaLayout::SemiPlanar.
+ * @param chroma_v - V samples of the row, unused for ChromaLayout::SemiPlanar.
+ * @param layout   - Layout of the chroma samples.
+ * @param order    - Order of the color channels in the output.
+ */
+void ConvertRowToRgb(std::span<u8> output, const u8* luma, const u8* chroma_u,
+                     const u8* chroma_v, ChromaLayout layout, RgbOrder order);
+
+/**
+ * Interleave separate U and V samples into the UV layout of a semi-planar surface.
+ *
+ * @param output   - Output samples, count * 2 bytes.
+ * @param chroma_u - U samples.
+ * @param chroma_v - V samples.
+ * @param count    - Number of samples in each chroma plane.
+ */
+void InterleaveChroma(u8* output, const u8* chroma_u, const u8* chroma_v, size_t count);
+
+} // namespace Tegra::Host1x::VicColor
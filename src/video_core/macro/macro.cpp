@@ -1,10 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <optional>
 #include <span>
+#include <vector>
 
 #include "common/container_hash.h"
 
@@ -12,6 +14,7 @@
 #include "common/assert.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -21,6 +24,8 @@
 
 #ifdef ARCHITECTURE_x86_64
 #include "video_core/macro/macro_jit_x64.h"
+#elif defined(ARCHITECTURE_arm64)
+#include "video_core/macro/macro_jit_arm64.h"
 #endif
 
 MICROPROFILE_DEFINE(MacroHLE, "GPU", "Execute macro HLE", MP_RGB(128, 192, 192));
@@ -55,9 +60,14 @@ static void Dump(u64 hash, std::span<const u32> code, bool decompiled = false) {
 }
 
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d_)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_} {}
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d_)}, maxwell3d{maxwell3d_},
+      is_profiling{Settings::values.profile_macros.GetValue()} {}
 
-MacroEngine::~MacroEngine() = default;
+MacroEngine::~MacroEngine() {
+    if (is_profiling) {
+        ReportProfile();
+    }
+}
 
 void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
@@ -69,6 +79,61 @@ void MacroEngine::ClearCode(u32 method) {
 }
 
 void MacroEngine::Execute(u32 method, const std::vector<u32>& parameters) {
+    if (!is_profiling) {
+        ExecuteImpl(method, parameters);
+        return;
+    }
+    const auto start_time = std::chrono::steady_clock::now();
+    ExecuteImpl(method, parameters);
+    const auto end_time = std::chrono::steady_clock::now();
+
+    const auto it = macro_cache.find(method);
+    if (it == macro_cache.end()) {
+        return;
+    }
+    const CacheInfo& cache_info = it->second;
+    auto [profile, is_new] = macro_profile.try_emplace(cache_info.hash);
+    ProfileInfo& info = profile->second;
+    if (is_new) {
+        info.method = method;
+        info.has_hle_program = cache_info.has_hle_program;
+    }
+    ++info.num_calls;
+    info.num_parameters += parameters.size();
+    info.time += end_time - start_time;
+}
+
+void MacroEngine::ReportProfile() const {
+    if (macro_profile.empty()) {
+        return;
+    }
+    std::vector<std::pair<u64, ProfileInfo>> ranking(macro_profile.begin(), macro_profile.end());
+    std::ranges::sort(ranking, [](const auto& lhs, const auto& rhs) {
+        return lhs.second.time > rhs.second.time;
+    });
+    std::chrono::nanoseconds total_time{};
+    for (const auto& [hash, info] : ranking) {
+        total_time += info.time;
+    }
+    LOG_INFO(HW_GPU, "Macro profile, {} macros ranked by execution time ({} us in total)",
+             ranking.size(),
+             std::chrono::duration_cast<std::chrono::microseconds>(total_time).count());
+    for (const auto& [hash, info] : ranking) {
+        const auto time = std::chrono::duration_cast<std::chrono::microseconds>(info.time);
+        const double share = total_time.count() > 0
+                                 ? 100.0 * static_cast<double>(info.time.count()) /
+                                       static_cast<double>(total_time.count())
+                                 : 0.0;
+        LOG_INFO(HW_GPU,
+                 "  {:016x} method=0x{:x} calls={} parameters={} avg_parameters={:.1f} "
+                 "time={}us ({:.1f}%){}",
+                 hash, info.method, info.num_calls, info.num_parameters,
+                 static_cast<double>(info.num_parameters) / static_cast<double>(info.num_calls),
+                 time.count(), share, info.has_hle_program ? " hle" : "");
+    }
+}
+
+void MacroEngine::ExecuteImpl(u32 method, const std::vector<u32>& parameters) {
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
         const auto& cache_info = compiled_macro->second;
@@ -134,6 +199,8 @@ std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
     }
 #ifdef ARCHITECTURE_x86_64
     return std::make_unique<MacroJITx64>(maxwell3d);
+#elif defined(ARCHITECTURE_arm64)
+    return std::make_unique<MacroJITArm64>(maxwell3d);
 #else
     return std::make_unique<MacroInterpreter>(maxwell3d);
 #endif
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -127,6 +128,19 @@ protected:
     virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) = 0;
 
 private:
+    struct ProfileInfo {
+        u32 method{};                    ///< First method the macro was called from
+        u64 num_calls{};                 ///< Number of times the macro was executed
+        u64 num_parameters{};            ///< Total number of parameters passed to the macro
+        std::chrono::nanoseconds time{}; ///< Cumulative execution time
+        bool has_hle_program{};          ///< Whether the macro is replaced by an HLE program
+    };
+
+    void ExecuteImpl(u32 method, const std::vector<u32>& parameters);
+
+    // Logs the profiled macros, ranked by their cumulative execution time
+    void ReportProfile() const;
+
     struct CacheInfo {
         std::unique_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
@@ -138,6 +152,9 @@ private:
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
     Engines::Maxwell3D& maxwell3d;
+
+    bool is_profiling{};
+    std::unordered_map<u64, ProfileInfo> macro_profile;
 };
 
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d);
@@ -0,0 +1,524 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <oaknut/code_block.hpp>
+#include <oaknut/oaknut.hpp>
+
+#include "common/assert.h"
+#include "common/bit_field.h"
+#include "common/container_hash.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/perf_map.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_jit_arm64.h"
+
+MICROPROFILE_DEFINE(MacroJitCompile, "GPU", "Compile macro JIT", MP_RGB(173, 255, 47));
+MICROPROFILE_DEFINE(MacroJitExecute, "GPU", "Execute macro JIT", MP_RGB(255, 255, 0));
+
+namespace Tegra {
+namespace {
+using namespace oaknut::util;
+
+// Persistent state lives in callee saved registers, so it survives calls into the engine.
+constexpr oaknut::XReg STATE = X19;
+constexpr oaknut::XReg PARAMETERS = X20;
+constexpr oaknut::XReg MAX_PARAMETER = X21;
+constexpr oaknut::WReg METHOD_ADDRESS = W22;
+constexpr oaknut::WReg RESULT = W23;
+
+// Scratch registers, clobbered by calls
+constexpr oaknut::WReg SCRATCH0 = W0;
+constexpr oaknut::WReg SCRATCH1 = W1;
+constexpr oaknut::WReg SCRATCH2 = W2;
+constexpr oaknut::XReg CALL_TARGET = X16;
+
+/// Stack space used to save the callee saved registers and the link register
+constexpr int STACK_SIZE = 48;
+
+void Send(Engines::Maxwell3D* maxwell3d, u32 raw_method_address, u32 value) {
+    const Macro::MethodAddress method_address{raw_method_address};
+    maxwell3d->CallMethod(method_address.address, value, true);
+}
+
+void WarnInvalidParameter(uintptr_t parameter, uintptr_t max_parameter) {
+    LOG_CRITICAL(HW_GPU,
+                 "Macro JIT: invalid parameter access 0x{:x} (0x{:x} is the last parameter)",
+                 parameter, max_parameter - sizeof(u32));
+}
+
+class MacroJITArm64Impl final : public CachedMacro {
+public:
+    explicit MacroJITArm64Impl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_)
+        : code{code_}, maxwell3d{maxwell3d_}, c{code_buffer} {
+        Compile();
+    }
+
+    void Execute(const std::vector<u32>& parameters, u32 method) override;
+
+private:
+    struct JITState {
+        std::array<u32, Macro::NUM_MACRO_REGISTERS> registers{};
+        u32 carry_flag{};
+    };
+    using ProgramType = void (*)(JITState*, const u32*, const u32*);
+
+    void Optimizer_ScanFlags();
+
+    void Compile();
+    void Compile_Instruction(u32 index, bool is_delay_slot);
+    void Compile_DelaySlot(u32 index);
+
+    void Compile_ALU(Macro::Opcode opcode);
+    void Compile_AddImmediate(Macro::Opcode opcode);
+    void Compile_ExtractInsert(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftRegister(Macro::Opcode opcode);
+    void Compile_Read(Macro::Opcode opcode);
+    void Compile_Branch(u32 index, Macro::Opcode opcode);
+
+    void Compile_ProcessResult(Macro::ResultOperation operation, u32 reg);
+    void Compile_Send(oaknut::WReg value);
+    oaknut::WReg Compile_FetchParameter();
+
+    /// Returns a register holding the macro register, the zero register is never loaded
+    oaknut::WReg Compile_GetRegister(u32 index, oaknut::WReg scratch);
+    /// Loads a macro register into dst
+    void Compile_LoadRegister(u32 index, oaknut::WReg dst);
+    void Compile_SetRegister(u32 index, oaknut::WReg value);
+
+    void Compile_LoadCarry();
+    void Compile_StoreCarry();
+
+    template <typename Function>
+    void Compile_CallFunction(Function* function) {
+        c.MOV(CALL_TARGET, reinterpret_cast<u64>(function));
+        c.BLR(CALL_TARGET);
+    }
+
+    static constexpr int RegisterOffset(u32 index) {
+        return static_cast<int>(offsetof(JITState, registers) + index * sizeof(u32));
+    }
+
+    struct OptimizerState {
+        bool can_skip_carry{};
+        bool skip_dummy_addimmediate{};
+    };
+    OptimizerState optimizer{};
+
+    const std::vector<u32>& code;
+    Engines::Maxwell3D& maxwell3d;
+
+    std::vector<u32> code_buffer;
+    oaknut::VectorCodeGenerator c;
+    std::vector<oaknut::Label> labels;
+    oaknut::Label end_of_code;
+
+    std::unique_ptr<oaknut::CodeBlock> code_block;
+    ProgramType program{nullptr};
+};
+
+void MacroJITArm64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
+    MICROPROFILE_SCOPE(MacroJitExecute);
+    ASSERT_OR_EXECUTE(program != nullptr, { return; });
+    JITState state{};
+    program(&state, parameters.data(), parameters.data() + parameters.size());
+}
+
+void MacroJITArm64Impl::Compile_ALU(Macro::Opcode opcode) {
+    const oaknut::WReg src_a = Compile_GetRegister(opcode.src_a, SCRATCH0);
+    const oaknut::WReg src_b = Compile_GetRegister(opcode.src_b, SCRATCH1);
+
+    switch (opcode.alu_operation) {
+    case Macro::ALUOperation::Add:
+        if (optimizer.can_skip_carry) {
+            c.ADD(RESULT, src_a, src_b);
+        } else {
+            c.ADDS(RESULT, src_a, src_b);
+            Compile_StoreCarry();
+        }
+        break;
+    case Macro::ALUOperation::AddWithCarry:
+        Compile_LoadCarry();
+        c.ADCS(RESULT, src_a, src_b);
+        Compile_StoreCarry();
+        break;
+    case Macro::ALUOperation::Subtract:
+        // The macro carry flag is set when there is no borrow, same as the host carry flag
+        if (optimizer.can_skip_carry) {
+            c.SUB(RESULT, src_a, src_b);
+        } else {
+            c.SUBS(RESULT, src_a, src_b);
+            Compile_StoreCarry();
+        }
+        break;
+    case Macro::ALUOperation::SubtractWithBorrow:
+        Compile_LoadCarry();
+        c.SBCS(RESULT, src_a, src_b);
+        Compile_StoreCarry();
+        break;
+    case Macro::ALUOperation::Xor:
+        c.EOR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Or:
+        c.ORR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::And:
+        c.AND(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::AndNot:
+        c.BIC(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Nand:
+        c.AND(RESULT, src_a, src_b);
+        c.MVN(RESULT, RESULT);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
+        break;
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
+    if (optimizer.skip_dummy_addimmediate) {
+        // Games tend to use this as an exit instruction placeholder. It's to encode an instruction
+        // without doing anything. In our case we can just not emit anything.
+        if (opcode.result_operation == Macro::ResultOperation::Move && opcode.dst == 0) {
+            return;
+        }
+    }
+    const oaknut::WReg src_a = Compile_GetRegister(opcode.src_a, SCRATCH0);
+    if (opcode.immediate == 0) {
+        c.MOV(RESULT, src_a);
+    } else {
+        c.MOV(SCRATCH1, static_cast<u32>(opcode.immediate.Value()));
+        c.ADD(RESULT, src_a, SCRATCH1);
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractInsert(Macro::Opcode opcode) {
+    Compile_LoadRegister(opcode.src_a, RESULT);
+    const oaknut::WReg src = Compile_GetRegister(opcode.src_b, SCRATCH0);
+
+    const u32 mask = opcode.GetBitfieldMask();
+    c.LSR(SCRATCH0, src, opcode.bf_src_bit.Value());
+    c.MOV(SCRATCH1, mask);
+    c.AND(SCRATCH0, SCRATCH0, SCRATCH1);
+    c.LSL(SCRATCH0, SCRATCH0, opcode.bf_dst_bit.Value());
+    c.MOV(SCRATCH1, ~(mask << opcode.bf_dst_bit));
+    c.AND(RESULT, RESULT, SCRATCH1);
+    c.ORR(RESULT, RESULT, SCRATCH0);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode) {
+    const oaknut::WReg dst = Compile_GetRegister(opcode.src_a, SCRATCH0);
+    const oaknut::WReg src = Compile_GetRegister(opcode.src_b, SCRATCH1);
+
+    c.LSRV(RESULT, src, dst);
+    c.MOV(SCRATCH2, opcode.GetBitfieldMask());
+    c.AND(RESULT, RESULT, SCRATCH2);
+    c.LSL(RESULT, RESULT, opcode.bf_dst_bit.Value());
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftRegister(Macro::Opcode opcode) {
+    const oaknut::WReg dst = Compile_GetRegister(opcode.src_a, SCRATCH0);
+    const oaknut::WReg src = Compile_GetRegister(opcode.src_b, SCRATCH1);
+
+    c.LSR(RESULT, src, opcode.bf_src_bit.Value());
+    c.MOV(SCRATCH2, opcode.GetBitfieldMask());
+    c.AND(RESULT, RESULT, SCRATCH2);
+    c.LSLV(RESULT, RESULT, dst);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Read(Macro::Opcode opcode) {
+    const oaknut::WReg src_a = Compile_GetRegister(opcode.src_a, SCRATCH0);
+    c.MOV(SCRATCH1, static_cast<u32>(opcode.immediate.Value()));
+    c.ADD(SCRATCH0, src_a, SCRATCH1);
+
+    // Equivalent to Engines::Maxwell3D::GetRegisterValue, writing W0 clears the upper bits of X0
+    c.MOV(X1, reinterpret_cast<u64>(maxwell3d.regs.reg_array.data()));
+    c.ADD(X1, X1, X0, LSL, 2);
+    c.LDR(RESULT, X1);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Send(oaknut::WReg value) {
+    // The value is moved first, it may live in one of the argument registers
+    c.MOV(W2, value);
+    c.MOV(W1, METHOD_ADDRESS);
+    c.MOV(X0, reinterpret_cast<u64>(&maxwell3d));
+    Compile_CallFunction(&Send);
+
+    // Increment the method address by the method increment, keeping the increment bits
+    c.UBFX(SCRATCH0, METHOD_ADDRESS, 12, 6);
+    c.ADD(SCRATCH0, METHOD_ADDRESS, SCRATCH0);
+    c.BFI(METHOD_ADDRESS, SCRATCH0, 0, 12);
+}
+
+void MacroJITArm64Impl::Compile_Branch(u32 index, Macro::Opcode opcode) {
+    const s64 jump_address =
+        static_cast<s64>(index) + opcode.GetBranchTarget() / static_cast<s32>(sizeof(u32));
+    ASSERT_MSG(jump_address >= 0 && jump_address < static_cast<s64>(code.size()),
+               "Macro branch target {} is out of bounds", jump_address);
+    oaknut::Label& target =
+        jump_address >= 0 && jump_address < static_cast<s64>(code.size())
+            ? labels[static_cast<size_t>(jump_address)]
+            : end_of_code;
+
+    const oaknut::WReg value = Compile_GetRegister(opcode.src_a, SCRATCH0);
+    if (opcode.branch_annul) {
+        if (opcode.branch_condition == Macro::BranchCondition::Zero) {
+            c.CBZ(value, target);
+        } else {
+            c.CBNZ(value, target);
+        }
+        return;
+    }
+    // Taken branches execute the delay slot before jumping, it is emitted inline on that path
+    oaknut::Label not_taken;
+    if (opcode.branch_condition == Macro::BranchCondition::Zero) {
+        c.CBNZ(value, not_taken);
+    } else {
+        c.CBZ(value, not_taken);
+    }
+    Compile_DelaySlot(index + 1);
+    c.B(target);
+    c.l(not_taken);
+}
+
+void MacroJITArm64Impl::Optimizer_ScanFlags() {
+    optimizer.can_skip_carry = true;
+    for (auto raw_op : code) {
+        Macro::Opcode op{};
+        op.raw = raw_op;
+
+        if (op.operation == Macro::Operation::ALU) {
+            // Scan for any ALU operations which actually use the carry flag, if they don't exist in
+            // our current code we can skip emitting the carry flag handling operations
+            if (op.alu_operation == Macro::ALUOperation::AddWithCarry ||
+                op.alu_operation == Macro::ALUOperation::SubtractWithBorrow) {
+                optimizer.can_skip_carry = false;
+            }
+        }
+    }
+}
+
+void MacroJITArm64Impl::Compile() {
+    MICROPROFILE_SCOPE(MacroJitCompile);
+    labels.resize(code.size());
+
+    c.STP(X19, X20, SP, PRE_INDEXED, -STACK_SIZE);
+    c.STP(X21, X22, SP, 16);
+    c.STP(X23, X30, SP, 32);
+
+    // JIT state
+    c.MOV(STATE, X0);
+    c.MOV(PARAMETERS, X1);
+    c.MOV(MAX_PARAMETER, X2);
+    c.MOV(RESULT, WZR);
+    c.MOV(METHOD_ADDRESS, WZR);
+
+    Compile_SetRegister(1, Compile_FetchParameter());
+
+    // AddImmediate tends to be used as a NOP instruction, if we detect this we can
+    // completely skip the entire code path and no emit anything
+    optimizer.skip_dummy_addimmediate = true;
+
+    // Check to see if we can skip emitting certain instructions
+    Optimizer_ScanFlags();
+
+    const u32 op_count = static_cast<u32>(code.size());
+    for (u32 index = 0; index < op_count; ++index) {
+        c.l(labels[index]);
+        Compile_Instruction(index, false);
+    }
+
+    c.l(end_of_code);
+    c.LDP(X23, X30, SP, 32);
+    c.LDP(X21, X22, SP, 16);
+    c.LDP(X19, X20, SP, POST_INDEXED, STACK_SIZE);
+    c.RET();
+
+    // Branches are relative and calls go through absolute addresses, so the code can be moved
+    const size_t code_size = code_buffer.size() * sizeof(u32);
+    code_block = std::make_unique<oaknut::CodeBlock>(code_size);
+    code_block->unprotect();
+    std::memcpy(code_block->ptr(), code_buffer.data(), code_size);
+    code_block->protect();
+    code_block->invalidate_all();
+    program = reinterpret_cast<ProgramType>(code_block->ptr());
+
+    if (Common::PerfMap::IsEnabled()) {
+        Common::PerfMap::Register(code_block->ptr(), code_size,
+                                  fmt::format("Macro {:016x}", Common::HashValue(code)));
+    }
+
+    code_buffer.clear();
+    code_buffer.shrink_to_fit();
+    labels.clear();
+}
+
+void MacroJITArm64Impl::Compile_Instruction(u32 index, bool is_delay_slot) {
+    const Macro::Opcode opcode{code[index]};
+    switch (opcode.operation) {
+    case Macro::Operation::ALU:
+        Compile_ALU(opcode);
+        break;
+    case Macro::Operation::AddImmediate:
+        Compile_AddImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractInsert:
+        Compile_ExtractInsert(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftImmediate:
+        Compile_ExtractShiftLeftImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftRegister:
+        Compile_ExtractShiftLeftRegister(opcode);
+        break;
+    case Macro::Operation::Read:
+        Compile_Read(opcode);
+        break;
+    case Macro::Operation::Branch:
+        ASSERT_MSG(!is_delay_slot, "Executing a branch in a delay slot is not valid");
+        if (!is_delay_slot) {
+            Compile_Branch(index, opcode);
+        }
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented opcode {}", opcode.operation.Value());
+        break;
+    }
+
+    // An instruction with the Exit flag will not actually
+    // cause an exit if it's executed inside a delay slot.
+    if (opcode.is_exit && !is_delay_slot) {
+        // Exit has a delay slot, execute the next instruction
+        Compile_DelaySlot(index + 1);
+        c.B(end_of_code);
+    }
+}
+
+void MacroJITArm64Impl::Compile_DelaySlot(u32 index) {
+    if (index < code.size()) {
+        Compile_Instruction(index, true);
+    }
+}
+
+oaknut::WReg MacroJITArm64Impl::Compile_FetchParameter() {
+    oaknut::Label parameter_ok;
+    c.CMP(PARAMETERS, MAX_PARAMETER);
+    c.B(oaknut::Cond::LO, parameter_ok);
+    c.MOV(X0, PARAMETERS);
+    c.MOV(X1, MAX_PARAMETER);
+    Compile_CallFunction(&WarnInvalidParameter);
+    c.l(parameter_ok);
+    c.LDR(SCRATCH0, PARAMETERS, POST_INDEXED, static_cast<int>(sizeof(u32)));
+    return SCRATCH0;
+}
+
+oaknut::WReg MacroJITArm64Impl::Compile_GetRegister(u32 index, oaknut::WReg scratch) {
+    if (index == 0) {
+        // Register 0 is always zero
+        return WZR;
+    }
+    c.LDR(scratch, STATE, RegisterOffset(index));
+    return scratch;
+}
+
+void MacroJITArm64Impl::Compile_LoadRegister(u32 index, oaknut::WReg dst) {
+    if (index == 0) {
+        c.MOV(dst, WZR);
+    } else {
+        c.LDR(dst, STATE, RegisterOffset(index));
+    }
+}
+
+void MacroJITArm64Impl::Compile_SetRegister(u32 index, oaknut::WReg value) {
+    // Register 0 is supposed to always return 0. NOP is implemented as a store to the zero
+    // register.
+    if (index == 0) {
+        return;
+    }
+    c.STR(value, STATE, RegisterOffset(index));
+}
+
+void MacroJITArm64Impl::Compile_LoadCarry() {
+    // Comparing against one sets the host carry flag when the stored flag is set
+    c.LDR(SCRATCH2, STATE, static_cast<int>(offsetof(JITState, carry_flag)));
+    c.CMP(SCRATCH2, 1);
+}
+
+void MacroJITArm64Impl::Compile_StoreCarry() {
+    c.CSET(SCRATCH2, oaknut::Cond::CS);
+    c.STR(SCRATCH2, STATE, static_cast<int>(offsetof(JITState, carry_flag)));
+}
+
+void MacroJITArm64Impl::Compile_ProcessResult(Macro::ResultOperation operation, u32 reg) {
+    switch (operation) {
+    case Macro::ResultOperation::IgnoreAndFetch:
+        Compile_SetRegister(reg, Compile_FetchParameter());
+        break;
+    case Macro::ResultOperation::Move:
+        Compile_SetRegister(reg, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethod:
+        Compile_SetRegister(reg, RESULT);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSend:
+        // Fetch parameter and send result.
+        Compile_SetRegister(reg, Compile_FetchParameter());
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSend:
+        // Move and send result.
+        Compile_SetRegister(reg, RESULT);
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSetMethod:
+        // Fetch parameter and use result as Method Address.
+        Compile_SetRegister(reg, Compile_FetchParameter());
+        c.MOV(METHOD_ADDRESS, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodFetchAndSend:
+        // Move result and use as Method Address, then fetch and send parameter.
+        Compile_SetRegister(reg, RESULT);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        Compile_Send(Compile_FetchParameter());
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodSend:
+        // Move result and use as Method Address, then send bits 12:17 of result.
+        Compile_SetRegister(reg, RESULT);
+        c.MOV(METHOD_ADDRESS, RESULT);
+        c.UBFX(SCRATCH0, RESULT, 12, 6);
+        Compile_Send(SCRATCH0);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented macro operation {}", operation);
+        break;
+    }
+}
+} // Anonymous namespace
+
+MacroJITArm64::MacroJITArm64(Engines::Maxwell3D& maxwell3d_)
+    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+
+std::unique_ptr<CachedMacro> MacroJITArm64::Compile(const std::vector<u32>& code) {
+    return std::make_unique<MacroJITArm64Impl>(maxwell3d, code);
+}
+} // namespace Tegra
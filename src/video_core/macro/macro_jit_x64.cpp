@@ -9,8 +9,10 @@
 
 #include "common/assert.h"
 #include "common/bit_field.h"
+#include "common/container_hash.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/perf_map.h"
 #include "common/x64/xbyak_abi.h"
 #include "common/x64/xbyak_util.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -498,6 +500,11 @@ void MacroJITx64Impl::Compile() {
     ret();
     ready();
     program = getCode<ProgramType>();
+
+    if (Common::PerfMap::IsEnabled()) {
+        Common::PerfMap::Register(getCode(), getSize(),
+                                  fmt::format("Macro {:016x}", Common::HashValue(code)));
+    }
 }
 
 bool MacroJITx64Impl::Compile_NextInstruction() {
@@ -19,6 +19,12 @@
 namespace Tegra {
 using Tegra::Memory::GuestMemoryFlags;
 
+namespace {
+// Engines translate from their own threads while the guest remaps, one cache per thread keeps
+// lookups free of locks
+thread_local TranslationCache translation_cache;
+} // Anonymous namespace
+
 std::atomic<size_t> MemoryManager::unique_identifier_generator{};
 
 MemoryManager::MemoryManager(Core::System& system_, MaxwellDeviceMemoryManager& memory_,
@@ -27,7 +33,7 @@ MemoryManager::MemoryManager(Core::System& system_, MaxwellDeviceMemoryManager&
     : system{system_}, memory{memory_}, address_space_bits{address_space_bits_},
       split_address{split_address_}, page_bits{page_bits_}, big_page_bits{big_page_bits_},
       entries{}, big_entries{}, page_table{address_space_bits, address_space_bits + page_bits - 38,
-                                           page_bits != big_page_bits ? page_bits : 0},
+                                           page_bits != big_page_bits ? page_bits : 0, true},
       kind_map{PTEKind::INVALID}, unique_identifier{unique_identifier_generator.fetch_add(
                                       1, std::memory_order_acq_rel)},
       accumulator{std::make_unique<VideoCommon::InvalidationAccumulator>()} {
@@ -125,10 +131,17 @@ GPUVAddr MemoryManager::PageTableOp(GPUVAddr gpu_addr, [[maybe_unused]] DAddr de
             const auto index = PageEntryIndex<false>(current_gpu_addr);
             const u32 sub_value = static_cast<u32>(current_dev_addr >> cpu_page_bits);
             page_table[index] = sub_value;
+            if (current_entry_type != EntryType::Mapped) {
+                page_table.MarkUsed(index);
+            }
+        } else if (current_entry_type == EntryType::Mapped) {
+            // Lets the page table free sub-tables without mapped pages left
+            page_table.MarkUnused(PageEntryIndex<false>(current_gpu_addr));
         }
         remaining_size -= page_size;
     }
     kind_map.Map(gpu_addr, gpu_addr + size, kind);
+    mapping_generation.fetch_add(1, std::memory_order_release);
     return gpu_addr;
 }
 
@@ -172,6 +185,7 @@ GPUVAddr MemoryManager::BigPageTableOp(GPUVAddr gpu_addr, [[maybe_unused]] DAddr
         std::unique_lock<std::mutex> lock(guard);
         kind_map.Map(gpu_addr, gpu_addr + size, kind);
     }
+    mapping_generation.fetch_add(1, std::memory_order_release);
     return gpu_addr;
 }
 
@@ -213,6 +227,24 @@ std::optional<DAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
     if (!IsWithinGPUAddressRange(gpu_addr)) [[unlikely]] {
         return std::nullopt;
     }
+    const u64 generation = mapping_generation.load(std::memory_order_acquire);
+    const u64 page = gpu_addr >> page_bits;
+    if (const auto base = translation_cache.Find(unique_identifier, generation, page)) {
+        return *base + (gpu_addr & page_mask);
+    }
+    const auto base = WalkPageTable(gpu_addr & ~page_mask);
+    if (!base) {
+        return std::nullopt;
+    }
+    translation_cache.Insert(unique_identifier, generation, page, *base);
+    return *base + (gpu_addr & page_mask);
+}
+
+TranslationCacheStats MemoryManager::GetTranslationCacheStats() {
+    return translation_cache.Stats();
+}
+
+std::optional<DAddr> MemoryManager::WalkPageTable(GPUVAddr gpu_addr) const {
     if (GetEntry<true>(gpu_addr) != EntryType::Mapped) [[unlikely]] {
         if (GetEntry<false>(gpu_addr) != EntryType::Mapped) {
             return std::nullopt;
@@ -402,6 +434,18 @@ void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std:
         GPUVAddr base = (page_index << big_page_bits) + offset;
         MemoryOperation<false>(base, copy_amount, mapped_normal, set_to_zero, set_to_zero);
     };
+    if ((gpu_src_addr & cpu_page_mask) + size <= cpu_page_size) [[likely]] {
+        // Accesses within a single device page only need one translation
+        if (const auto dev_addr = GpuToCpuAddress(gpu_src_addr)) {
+            if constexpr (is_safe) {
+                rasterizer->FlushRegion(*dev_addr, size, which);
+            }
+            if (const u8* physical = memory.GetPointer<u8>(*dev_addr)) {
+                std::memcpy(dest_buffer, physical, size);
+                return;
+            }
+        }
+    }
     MemoryOperation<true>(gpu_src_addr, size, mapped_big, set_to_zero, read_short_pages);
 }
 
@@ -451,6 +495,18 @@ void MemoryManager::WriteBlockImpl(GPUVAddr gpu_dest_addr, const void* src_buffe
         GPUVAddr base = (page_index << big_page_bits) + offset;
         MemoryOperation<false>(base, copy_amount, mapped_normal, just_advance, just_advance);
     };
+    if ((gpu_dest_addr & cpu_page_mask) + size <= cpu_page_size) [[likely]] {
+        // Accesses within a single device page only need one translation
+        if (const auto dev_addr = GpuToCpuAddress(gpu_dest_addr)) {
+            if constexpr (is_safe) {
+                rasterizer->InvalidateRegion(*dev_addr, size, which);
+            }
+            if (u8* physical = memory.GetPointer<u8>(*dev_addr)) {
+                std::memcpy(physical, src_buffer, size);
+                return;
+            }
+        }
+    }
     MemoryOperation<true>(gpu_dest_addr, size, mapped_big, just_advance, write_short_pages);
 }
 
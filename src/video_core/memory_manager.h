@@ -18,6 +18,7 @@
 #include "video_core/cache_types.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/pte_kind.h"
+#include "video_core/translation_cache.h"
 
 namespace VideoCore {
 class RasterizerInterface;
@@ -50,10 +51,18 @@ public:
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Returns the rasterizer bound to the memory manager, or null if there is none.
+    [[nodiscard]] VideoCore::RasterizerInterface* GetRasterizer() const {
+        return rasterizer;
+    }
+
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr, std::size_t size) const;
 
+    /// Returns the hit and miss counters of the translation cache of the calling thread.
+    [[nodiscard]] static TranslationCacheStats GetTranslationCacheStats();
+
     template <typename T>
     [[nodiscard]] T Read(GPUVAddr addr) const;
 
@@ -170,6 +179,8 @@ private:
     void WriteBlockImpl(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size,
                         VideoCommon::CacheType which);
 
+    [[nodiscard]] std::optional<DAddr> WalkPageTable(GPUVAddr gpu_addr) const;
+
     template <bool is_big_page>
     [[nodiscard]] std::size_t PageEntryIndex(GPUVAddr gpu_addr) const {
         if constexpr (is_big_page) {
@@ -200,6 +211,8 @@ private:
     u64 page_mask;
     u64 page_table_mask;
     static constexpr u64 cpu_page_bits{12};
+    static constexpr u64 cpu_page_size{1ULL << cpu_page_bits};
+    static constexpr u64 cpu_page_mask{cpu_page_size - 1};
 
     const u64 big_page_bits;
     u64 big_page_size;
@@ -244,6 +257,8 @@ private:
     static constexpr size_t continuous_bits = 64;
 
     const size_t unique_identifier;
+    /// Bumped after every page table change, invalidates the cached translations
+    std::atomic<u64> mapping_generation{};
     std::unique_ptr<VideoCommon::InvalidationAccumulator> accumulator;
 
     static std::atomic<size_t> unique_identifier_generator;
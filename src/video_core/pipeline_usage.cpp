@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/pipeline_usage.h"
+
+namespace VideoCommon {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'u', 's', 'a', 'g'};
+
+struct SerializedRecord {
+    u64 pipeline_hash;
+    u32 first_use_ms;
+    u32 hit_count;
+};
+static_assert(std::has_unique_object_representations_v<SerializedRecord>);
+} // Anonymous namespace
+
+void PipelineUsageTracker::Load(const std::filesystem::path& filename_,
+                                u32 expected_cache_version) try {
+    filename = filename_;
+    cache_version = expected_cache_version;
+    records.clear();
+    has_history = false;
+    session_start = std::chrono::steady_clock::now();
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> magic_number;
+    u32 file_cache_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&file_cache_version), sizeof(file_cache_version));
+    if (magic_number != MAGIC_NUMBER || file_cache_version != expected_cache_version) {
+        LOG_INFO(Common_Filesystem, "Discarding old pipeline usage history");
+        return;
+    }
+    while (file.tellg() != end) {
+        SerializedRecord record;
+        file.read(reinterpret_cast<char*>(&record), sizeof(record));
+        records.insert_or_assign(record.pipeline_hash, Record{
+                                                           .usage{
+                                                               .first_use_ms = record.first_use_ms,
+                                                               .hit_count = record.hit_count,
+                                                           },
+                                                           .used_this_session = false,
+                                                       });
+    }
+    has_history = !records.empty();
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    records.clear();
+    has_history = false;
+}
+
+void PipelineUsageTracker::StartSession() {
+    session_start = std::chrono::steady_clock::now();
+}
+
+void PipelineUsageTracker::Save() const try {
+    if (filename.empty()) {
+        return;
+    }
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline usage file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+        .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+    for (const auto& [pipeline_hash, record] : records) {
+        const SerializedRecord serialized{
+            .pipeline_hash = pipeline_hash,
+            .first_use_ms = record.usage.first_use_ms,
+            .hit_count = record.usage.hit_count,
+        };
+        file.write(reinterpret_cast<const char*>(&serialized), sizeof(serialized));
+    }
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline usage file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+void PipelineUsageTracker::RecordUse(u64 pipeline_hash) {
+    if (filename.empty()) {
+        return;
+    }
+    auto& record{records[pipeline_hash]};
+    if (record.used_this_session) {
+        return;
+    }
+    const auto elapsed{std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - session_start)};
+    constexpr auto max_ms{static_cast<s64>(std::numeric_limits<u32>::max())};
+    record.usage.first_use_ms = static_cast<u32>(std::min<s64>(elapsed.count(), max_ms));
+    record.usage.hit_count = std::min(record.usage.hit_count, std::numeric_limits<u32>::max() - 1);
+    ++record.usage.hit_count;
+    record.used_this_session = true;
+}
+
+std::optional<PipelineUsageTracker::Usage> PipelineUsageTracker::Find(u64 pipeline_hash) const {
+    const auto it{records.find(pipeline_hash)};
+    if (it == records.end()) {
+        return std::nullopt;
+    }
+    return it->second.usage;
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * Records when pipelines are first used in a session and how many sessions used them.
+ * The history of previous sessions is used to decide which cached pipelines have to be built
+ * before the game starts and which ones can be built in the background.
+ */
+class PipelineUsageTracker {
+public:
+    struct Usage {
+        /// Milliseconds since the start of the session where the pipeline was first used
+        u32 first_use_ms;
+        /// Number of sessions that used the pipeline
+        u32 hit_count;
+    };
+
+    /// Loads the usage history from the given file
+    void Load(const std::filesystem::path& filename, u32 expected_cache_version);
+
+    /// Starts measuring first use times of the current session
+    void StartSession();
+
+    /// Writes the usage history, including the current session, to the loaded file
+    void Save() const;
+
+    /// Records a pipeline use in the current session, this is cheap for already recorded uses
+    void RecordUse(u64 pipeline_hash);
+
+    /// Returns the usage history of a pipeline, if any
+    [[nodiscard]] std::optional<Usage> Find(u64 pipeline_hash) const;
+
+    /// Returns true when there is history from previous sessions
+    [[nodiscard]] bool HasHistory() const noexcept {
+        return has_history;
+    }
+
+private:
+    struct Record {
+        Usage usage;
+        bool used_this_session;
+    };
+
+    std::unordered_map<u64, Record> records;
+    std::filesystem::path filename;
+    std::chrono::steady_clock::time_point session_start;
+    u32 cache_version{};
+    bool has_history{};
+};
+
+} // namespace VideoCommon
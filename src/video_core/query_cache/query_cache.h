@@ -424,6 +424,12 @@ bool QueryCacheBase<Traits>::AccelerateHostConditionalRendering() {
     }
     const ComparisonMode mode = static_cast<ComparisonMode>(regs.render_enable.mode);
     const GPUVAddr address = regs.render_enable.Address();
+    const auto sync_on_gpu = [this, &qc_dirty] {
+        // Write pending results to guest buffers without waiting for them on the host
+        if (qc_dirty && impl->runtime.IsGpuResidentConditionalRendering()) {
+            NotifyWFI();
+        }
+    };
     switch (mode) {
     case ComparisonMode::True:
         impl->runtime.EndHostConditionalRendering();
@@ -433,17 +439,20 @@ bool QueryCacheBase<Traits>::AccelerateHostConditionalRendering() {
         return false;
     case ComparisonMode::Conditional: {
         VideoCommon::LookupData object_1{gen_lookup(address)};
+        sync_on_gpu();
         return impl->runtime.HostConditionalRenderingCompareValue(object_1, qc_dirty);
     }
     case ComparisonMode::IfEqual: {
         VideoCommon::LookupData object_1{gen_lookup(address)};
         VideoCommon::LookupData object_2{gen_lookup(address + 16)};
+        sync_on_gpu();
         return impl->runtime.HostConditionalRenderingCompareValues(object_1, object_2, qc_dirty,
                                                                    true);
     }
     case ComparisonMode::IfNotEqual: {
         VideoCommon::LookupData object_1{gen_lookup(address)};
         VideoCommon::LookupData object_2{gen_lookup(address + 16)};
+        sync_on_gpu();
         return impl->runtime.HostConditionalRenderingCompareValues(object_1, object_2, qc_dirty,
                                                                    false);
     }
@@ -44,6 +44,11 @@ public:
     /// Dispatches an indirect draw invocation
     virtual void DrawIndirect() {}
 
+    /// Returns true when Draw consumes the coalesced draw ranges of the draw state
+    virtual bool SupportsDrawCoalescing() const {
+        return false;
+    }
+
     /// Dispatches an draw texture invocation
     virtual void DrawTexture() = 0;
 
@@ -150,6 +155,13 @@ public:
         return false;
     }
 
+    /// Attempt to write the linear pixels of a surface produced outside of the 3D engine straight
+    /// to its cached image, leaving guest memory to be written only when it is read
+    [[nodiscard]] virtual bool AccelerateSurfaceWrite(
+        DAddr addr, const Tegra::Engines::Fermi2D::Surface& surface, std::span<const u8> pixels) {
+        return false;
+    }
+
     [[nodiscard]] virtual Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() = 0;
 
     virtual void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
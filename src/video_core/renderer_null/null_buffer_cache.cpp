@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/make_unique_for_overwrite.h"
+#include "video_core/renderer_null/null_buffer_cache.h"
+
+namespace Null {
+
+Buffer::Buffer(BufferCacheRuntime&, VideoCommon::NullBufferParams null_params)
+    : VideoCommon::BufferBase(null_params) {}
+
+Buffer::Buffer(BufferCacheRuntime&, DAddr cpu_addr_, u64 size_bytes_)
+    : VideoCommon::BufferBase(cpu_addr_, size_bytes_),
+      data{Common::make_unique_for_overwrite<u8[]>(size_bytes_)} {}
+
+BufferCacheRuntime::BufferCacheRuntime(StagingBufferPool& staging_pool_)
+    : staging_pool{staging_pool_} {}
+
+StagingBufferRef BufferCacheRuntime::UploadStagingBuffer(size_t size) {
+    return staging_pool.Request(size);
+}
+
+StagingBufferRef BufferCacheRuntime::DownloadStagingBuffer(size_t size, bool deferred) {
+    return staging_pool.Request(size, deferred);
+}
+
+void BufferCacheRuntime::FreeDeferredStagingBuffer(StagingBufferRef& ref) {
+    staging_pool.FreeDeferred(ref);
+}
+
+void BufferCacheRuntime::CopyBuffer(u8* dst_buffer, u8* src_buffer,
+                                    std::span<const VideoCommon::BufferCopy> copies,
+                                    [[maybe_unused]] bool barrier,
+                                    [[maybe_unused]] bool can_reorder_upload) {
+    for (const VideoCommon::BufferCopy& copy : copies) {
+        // Copies within the same buffer may overlap
+        std::memmove(dst_buffer + copy.dst_offset, src_buffer + copy.src_offset, copy.size);
+    }
+}
+
+void BufferCacheRuntime::ClearBuffer(u8* dest_buffer, u32 offset, size_t size, u32 value) {
+    u8* const begin = dest_buffer + offset;
+    for (size_t pos = 0; pos < size; pos += sizeof(u32)) {
+        std::memcpy(begin + pos, &value, std::min(sizeof(u32), size - pos));
+    }
+}
+
+std::span<u8> BufferCacheRuntime::BindMappedUniformBuffer([[maybe_unused]] size_t stage,
+                                                          [[maybe_unused]] u32 binding_index,
+                                                          u32 size) {
+    if (uniform_scratch.size() < size) {
+        uniform_scratch.resize(size);
+    }
+    return std::span<u8>(uniform_scratch.data(), size);
+}
+
+} // namespace Null
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/buffer_cache/buffer_cache_base.h"
+#include "video_core/buffer_cache/memory_tracker_base.h"
+#include "video_core/renderer_null/null_staging_buffer_pool.h"
+#include "video_core/surface.h"
+
+namespace Null {
+
+class BufferCacheRuntime;
+
+/// Buffer backed by host memory, so copies, clears and downloads keep their contents
+class Buffer : public VideoCommon::BufferBase {
+public:
+    explicit Buffer(BufferCacheRuntime&, VideoCommon::NullBufferParams null_params);
+    explicit Buffer(BufferCacheRuntime&, DAddr cpu_addr_, u64 size_bytes_);
+
+    void MarkUsage(u64 offset, u64 size) noexcept {}
+
+    [[nodiscard]] u8* Data() noexcept {
+        return data.get();
+    }
+
+    operator u8*() noexcept {
+        return data.get();
+    }
+
+private:
+    std::unique_ptr<u8[]> data;
+};
+
+/// Runtime that executes transfers on the host and drops every binding
+class BufferCacheRuntime {
+public:
+    explicit BufferCacheRuntime(StagingBufferPool& staging_pool_);
+
+    void TickFrame(Common::SlotVector<Buffer>&) noexcept {}
+
+    void Finish() {}
+
+    u64 GetDeviceLocalMemory() const {
+        return 0;
+    }
+
+    u64 GetDeviceMemoryUsage() const {
+        return 0;
+    }
+
+    bool CanReportMemoryUsage() const {
+        return false;
+    }
+
+    u32 GetStorageBufferAlignment() const {
+        return 16;
+    }
+
+    [[nodiscard]] StagingBufferRef UploadStagingBuffer(size_t size);
+
+    [[nodiscard]] StagingBufferRef DownloadStagingBuffer(size_t size, bool deferred = false);
+
+    bool CanReorderUpload(const Buffer&, std::span<const VideoCommon::BufferCopy>) {
+        return false;
+    }
+
+    void FreeDeferredStagingBuffer(StagingBufferRef& ref);
+
+    void PreCopyBarrier() {}
+
+    void CopyBuffer(u8* dst_buffer, u8* src_buffer, std::span<const VideoCommon::BufferCopy> copies,
+                    bool barrier, bool can_reorder_upload = false);
+
+    void PostCopyBarrier() {}
+
+    void ClearBuffer(u8* dest_buffer, u32 offset, size_t size, u32 value);
+
+    void BindIndexBuffer(Buffer&, u32 offset, u32 size) {}
+
+    void BindVertexBuffers(VideoCommon::HostBindings<Buffer>&) {}
+
+    void BindTransformFeedbackBuffers(VideoCommon::HostBindings<Buffer>&) {}
+
+    std::span<u8> BindMappedUniformBuffer(size_t stage, u32 binding_index, u32 size);
+
+    void BindUniformBuffer(Buffer&, u32 offset, u32 size) {}
+
+    void BindStorageBuffer(Buffer&, u32 offset, u32 size, bool is_written) {}
+
+    void BindTextureBuffer(Buffer&, u32 offset, u32 size, VideoCore::Surface::PixelFormat) {}
+
+private:
+    StagingBufferPool& staging_pool;
+    std::vector<u8> uniform_scratch;
+};
+
+struct BufferCacheParams {
+    using Runtime = Null::BufferCacheRuntime;
+    using Buffer = Null::Buffer;
+    using Async_Buffer = Null::StagingBufferRef;
+    using MemoryTracker = VideoCommon::MemoryTrackerBase<Tegra::MaxwellDeviceMemoryManager>;
+
+    static constexpr bool IS_OPENGL = false;
+    static constexpr bool HAS_PERSISTENT_UNIFORM_BUFFER_BINDINGS = false;
+    static constexpr bool HAS_FULL_INDEX_AND_PRIMITIVE_SUPPORT = true;
+    static constexpr bool NEEDS_BIND_UNIFORM_INDEX = false;
+    static constexpr bool NEEDS_BIND_STORAGE_INDEX = false;
+    static constexpr bool USE_MEMORY_MAPS = true;
+    static constexpr bool SEPARATE_IMAGE_BUFFER_BINDINGS = false;
+    static constexpr bool USE_MEMORY_MAPS_FOR_UPLOADS = true;
+    static constexpr bool CAN_IMPORT_HOST_MEMORY = false;
+    static constexpr bool HAS_BLOCK_LINEAR_COPY = false;
+};
+
+using BufferCache = VideoCommon::BufferCache<BufferCacheParams>;
+
+} // namespace Null
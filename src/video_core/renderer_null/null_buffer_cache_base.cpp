@@ -0,0 +1,9 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "video_core/buffer_cache/buffer_cache.h"
+#include "video_core/renderer_null/null_buffer_cache.h"
+
+namespace VideoCommon {
+template class VideoCommon::BufferCache<Null::BufferCacheParams>;
+}
@@ -1,30 +1,138 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <mutex>
+
 #include "common/alignment.h"
+#include "common/settings.h"
+#include "video_core/buffer_cache/buffer_cache.h"
 #include "video_core/control/channel_state.h"
+#include "video_core/engines/draw_manager.h"
+#include "video_core/engines/kepler_compute.h"
+#include "video_core/engines/maxwell_3d.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_null/null_rasterizer.h"
+#include "video_core/texture_cache/texture_cache.h"
 
 namespace Null {
 
-AccelerateDMA::AccelerateDMA() = default;
+namespace {
+constexpr u32 MAX_UNIFORM_BUFFER_SIZE = 0x10000;
+
+constexpr VideoCommon::UniformBufferSizes UNIFORM_BUFFER_SIZES = [] {
+    VideoCommon::UniformBufferSizes sizes{};
+    for (auto& stage_sizes : sizes) {
+        stage_sizes.fill(MAX_UNIFORM_BUFFER_SIZE);
+    }
+    return sizes;
+}();
+
+constexpr VideoCommon::ComputeUniformBufferSizes COMPUTE_UNIFORM_BUFFER_SIZES = [] {
+    VideoCommon::ComputeUniformBufferSizes sizes{};
+    sizes.fill(MAX_UNIFORM_BUFFER_SIZE);
+    return sizes;
+}();
+} // Anonymous namespace
+
+AccelerateDMA::AccelerateDMA(BufferCache* buffer_cache_) : buffer_cache{buffer_cache_} {}
 
 bool AccelerateDMA::BufferCopy(GPUVAddr start_address, GPUVAddr end_address, u64 amount) {
-    return true;
+    if (!buffer_cache) {
+        return true;
+    }
+    std::scoped_lock lock{buffer_cache->mutex};
+    return buffer_cache->DMACopy(start_address, end_address, amount);
 }
 bool AccelerateDMA::BufferClear(GPUVAddr src_address, u64 amount, u32 value) {
-    return true;
+    if (!buffer_cache) {
+        return true;
+    }
+    std::scoped_lock lock{buffer_cache->mutex};
+    return buffer_cache->DMAClear(src_address, amount, value);
 }
 
-RasterizerNull::RasterizerNull(Tegra::GPU& gpu) : m_gpu{gpu} {}
+RasterizerNull::RasterizerNull(Tegra::GPU& gpu, Tegra::MaxwellDeviceMemoryManager& device_memory)
+    : m_gpu{gpu}, m_use_caches{Settings::values.null_renderer_caches.GetValue()},
+      m_buffer_cache_runtime{m_staging_pool}, m_buffer_cache{device_memory, m_buffer_cache_runtime},
+      m_texture_cache_runtime{m_staging_pool},
+      m_texture_cache{m_texture_cache_runtime, device_memory},
+      m_accelerate_dma{m_use_caches ? &m_buffer_cache : nullptr} {}
 RasterizerNull::~RasterizerNull() = default;
 
-void RasterizerNull::Draw(bool is_indexed, u32 instance_count) {}
-void RasterizerNull::DrawTexture() {}
-void RasterizerNull::Clear(u32 layer_count) {}
-void RasterizerNull::DispatchCompute() {}
+void RasterizerNull::PrepareDraw(bool is_indexed) {
+    gpu_memory->FlushCaching();
+
+    std::array<u32, VideoCommon::NUM_STAGES> enabled_uniform_buffer_masks{};
+    for (size_t stage = 0; stage < VideoCommon::NUM_STAGES; ++stage) {
+        // Stages start at VertexB, VertexA is folded into it
+        if (maxwell3d->regs.IsShaderConfigEnabled(stage + 1)) {
+            enabled_uniform_buffer_masks[stage] =
+                (1U << VideoCommon::NUM_GRAPHICS_UNIFORM_BUFFERS) - 1;
+        }
+    }
+    std::scoped_lock lock{m_buffer_cache.mutex, m_texture_cache.mutex};
+    m_texture_cache.SynchronizeGraphicsDescriptors();
+    m_buffer_cache.SetUniformBuffersState(enabled_uniform_buffer_masks, &UNIFORM_BUFFER_SIZES);
+    m_buffer_cache.UpdateGraphicsBuffers(is_indexed);
+    m_buffer_cache.BindHostGeometryBuffers(is_indexed);
+    for (size_t stage = 0; stage < VideoCommon::NUM_STAGES; ++stage) {
+        m_buffer_cache.BindHostStageBuffers(stage);
+    }
+    m_texture_cache.UpdateRenderTargets(false);
+}
+
+void RasterizerNull::Draw(bool is_indexed, u32 instance_count) {
+    if (m_use_caches) {
+        PrepareDraw(is_indexed);
+    }
+}
+void RasterizerNull::DrawIndirect() {
+    if (!m_use_caches) {
+        return;
+    }
+    const auto& params = maxwell3d->draw_manager->GetIndirectParams();
+    m_buffer_cache.SetDrawIndirect(&params);
+    PrepareDraw(params.is_indexed);
+    m_buffer_cache.SetDrawIndirect(nullptr);
+}
+void RasterizerNull::DrawTexture() {
+    if (!m_use_caches) {
+        return;
+    }
+    std::scoped_lock lock{m_texture_cache.mutex};
+    m_texture_cache.SynchronizeGraphicsDescriptors();
+    m_texture_cache.UpdateRenderTargets(false);
+    const auto& draw_texture_state = maxwell3d->draw_manager->GetDrawTextureState();
+    void(m_texture_cache.GetGraphicsSampler(draw_texture_state.src_sampler));
+    void(m_texture_cache.GetImageView(draw_texture_state.src_texture));
+}
+void RasterizerNull::Clear(u32 layer_count) {
+    if (!m_use_caches) {
+        return;
+    }
+    std::scoped_lock lock{m_texture_cache.mutex};
+    m_texture_cache.UpdateRenderTargets(true);
+}
+void RasterizerNull::DispatchCompute() {
+    if (!m_use_caches) {
+        return;
+    }
+    gpu_memory->FlushCaching();
+
+    const auto& qmd = kepler_compute->launch_description;
+    std::scoped_lock lock{m_texture_cache.mutex, m_buffer_cache.mutex};
+    m_texture_cache.SynchronizeComputeDescriptors();
+    m_buffer_cache.SetComputeUniformBufferState(qmd.const_buffer_enable_mask.Value(),
+                                                &COMPUTE_UNIFORM_BUFFER_SIZES);
+    m_buffer_cache.UpdateComputeBuffers();
+    m_buffer_cache.BindHostComputeBuffers();
+    if (const auto indirect_address = kepler_compute->GetIndirectComputeAddress()) {
+        static constexpr auto sync_info = VideoCommon::ObtainBufferSynchronize::FullSynchronize;
+        const auto post_op = VideoCommon::ObtainBufferOperation::DiscardWrite;
+        void(m_buffer_cache.ObtainBuffer(*indirect_address, 12, sync_info, post_op));
+    }
+}
 void RasterizerNull::ResetCounter(VideoCommon::QueryType type) {}
 void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCommon::QueryType type,
                            VideoCommon::QueryPropertiesFlags flags, u32 payload, u32 subreport) {
@@ -40,19 +148,87 @@ void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCommon::QueryType type,
     }
 }
 void RasterizerNull::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
-                                               u32 size) {}
-void RasterizerNull::DisableGraphicsUniformBuffer(size_t stage, u32 index) {}
+                                               u32 size) {
+    if (m_use_caches) {
+        m_buffer_cache.BindGraphicsUniformBuffer(stage, index, gpu_addr, size);
+    }
+}
+void RasterizerNull::DisableGraphicsUniformBuffer(size_t stage, u32 index) {
+    if (m_use_caches) {
+        m_buffer_cache.DisableGraphicsUniformBuffer(stage, index);
+    }
+}
 void RasterizerNull::FlushAll() {}
-void RasterizerNull::FlushRegion(DAddr addr, u64 size, VideoCommon::CacheType) {}
-bool RasterizerNull::MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheType) {
+void RasterizerNull::FlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) {
+    if (!m_use_caches || addr == 0 || size == 0) {
+        return;
+    }
+    if (True(which & VideoCommon::CacheType::TextureCache)) {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        m_texture_cache.DownloadMemory(addr, size);
+    }
+    if (True(which & VideoCommon::CacheType::BufferCache)) {
+        std::scoped_lock lock{m_buffer_cache.mutex};
+        m_buffer_cache.DownloadMemory(addr, size);
+    }
+}
+bool RasterizerNull::MustFlushRegion(DAddr addr, u64 size, VideoCommon::CacheType which) {
+    if (!m_use_caches) {
+        return false;
+    }
+    if (True(which & VideoCommon::CacheType::BufferCache)) {
+        std::scoped_lock lock{m_buffer_cache.mutex};
+        if (m_buffer_cache.IsRegionGpuModified(addr, size)) {
+            return true;
+        }
+    }
+    if (!Settings::IsGPULevelHigh()) {
+        return false;
+    }
+    if (True(which & VideoCommon::CacheType::TextureCache)) {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        return m_texture_cache.IsRegionGpuModified(addr, size);
+    }
     return false;
 }
-void RasterizerNull::InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType) {}
+void RasterizerNull::InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) {
+    if (!m_use_caches || addr == 0 || size == 0) {
+        return;
+    }
+    if (True(which & VideoCommon::CacheType::TextureCache)) {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        m_texture_cache.WriteMemory(addr, size);
+    }
+    if (True(which & VideoCommon::CacheType::BufferCache)) {
+        std::scoped_lock lock{m_buffer_cache.mutex};
+        m_buffer_cache.WriteMemory(addr, size);
+    }
+}
 bool RasterizerNull::OnCPUWrite(PAddr addr, u64 size) {
+    if (!m_use_caches || addr == 0 || size == 0) {
+        return false;
+    }
+    {
+        std::scoped_lock lock{m_buffer_cache.mutex};
+        if (m_buffer_cache.OnCPUWrite(addr, size)) {
+            return true;
+        }
+    }
+    std::scoped_lock lock{m_texture_cache.mutex};
+    m_texture_cache.WriteMemory(addr, size);
     return false;
 }
-void RasterizerNull::OnCacheInvalidation(PAddr addr, u64 size) {}
+void RasterizerNull::OnCacheInvalidation(PAddr addr, u64 size) {
+    InvalidateRegion(addr, size, VideoCommon::CacheType::TextureCache |
+                                     VideoCommon::CacheType::BufferCache);
+}
 VideoCore::RasterizerDownloadArea RasterizerNull::GetFlushArea(PAddr addr, u64 size) {
+    if (m_use_caches) {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        if (const auto area = m_texture_cache.GetFlushArea(addr, size)) {
+            return *area;
+        }
+    }
     VideoCore::RasterizerDownloadArea new_area{
         .start_address = Common::AlignDown(addr, Core::DEVICE_PAGESIZE),
         .end_address = Common::AlignUp(addr + size, Core::DEVICE_PAGESIZE),
@@ -61,8 +237,23 @@ VideoCore::RasterizerDownloadArea RasterizerNull::GetFlushArea(PAddr addr, u64 s
     return new_area;
 }
 void RasterizerNull::InvalidateGPUCache() {}
-void RasterizerNull::UnmapMemory(DAddr addr, u64 size) {}
-void RasterizerNull::ModifyGPUMemory(size_t as_id, GPUVAddr addr, u64 size) {}
+void RasterizerNull::UnmapMemory(DAddr addr, u64 size) {
+    if (!m_use_caches) {
+        return;
+    }
+    {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        m_texture_cache.UnmapMemory(addr, size);
+    }
+    std::scoped_lock lock{m_buffer_cache.mutex};
+    m_buffer_cache.WriteMemory(addr, size);
+}
+void RasterizerNull::ModifyGPUMemory(size_t as_id, GPUVAddr addr, u64 size) {
+    if (m_use_caches) {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        m_texture_cache.UnmapGPUMemory(as_id, addr, size);
+    }
+}
 void RasterizerNull::SignalFence(std::function<void()>&& func) {
     func();
 }
@@ -76,32 +267,85 @@ void RasterizerNull::SignalSyncPoint(u32 value) {
 }
 void RasterizerNull::SignalReference() {}
 void RasterizerNull::ReleaseFences(bool) {}
-void RasterizerNull::FlushAndInvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType) {}
+void RasterizerNull::FlushAndInvalidateRegion(DAddr addr, u64 size,
+                                              VideoCommon::CacheType which) {
+    if (Settings::IsGPULevelExtreme()) {
+        FlushRegion(addr, size, which);
+    }
+    InvalidateRegion(addr, size, which);
+}
 void RasterizerNull::WaitForIdle() {}
 void RasterizerNull::FragmentBarrier() {}
 void RasterizerNull::TiledCacheBarrier() {}
 void RasterizerNull::FlushCommands() {}
-void RasterizerNull::TickFrame() {}
+void RasterizerNull::TickFrame() {
+    if (!m_use_caches) {
+        return;
+    }
+    {
+        std::scoped_lock lock{m_texture_cache.mutex};
+        m_texture_cache.TickFrame();
+    }
+    std::scoped_lock lock{m_buffer_cache.mutex};
+    m_buffer_cache.TickFrame();
+}
 Tegra::Engines::AccelerateDMAInterface& RasterizerNull::AccessAccelerateDMA() {
     return m_accelerate_dma;
 }
 bool RasterizerNull::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                            const Tegra::Engines::Fermi2D::Surface& dst,
                                            const Tegra::Engines::Fermi2D::Config& copy_config) {
-    return true;
+    if (!m_use_caches) {
+        return true;
+    }
+    std::scoped_lock lock{m_texture_cache.mutex};
+    return m_texture_cache.BlitImage(dst, src, copy_config);
 }
 void RasterizerNull::AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
-                                              std::span<const u8> memory) {}
+                                              std::span<const u8> memory) {
+    if (!m_use_caches) {
+        return;
+    }
+    const auto cpu_addr = gpu_memory->GpuToCpuAddress(address);
+    if (!cpu_addr) [[unlikely]] {
+        gpu_memory->WriteBlock(address, memory.data(), copy_size);
+        return;
+    }
+    gpu_memory->WriteBlockUnsafe(address, memory.data(), copy_size);
+    {
+        std::scoped_lock lock{m_buffer_cache.mutex};
+        if (!m_buffer_cache.InlineMemory(*cpu_addr, copy_size, memory)) {
+            m_buffer_cache.WriteMemory(*cpu_addr, copy_size);
+        }
+    }
+    std::scoped_lock lock{m_texture_cache.mutex};
+    m_texture_cache.WriteMemory(*cpu_addr, copy_size);
+}
 void RasterizerNull::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                        const VideoCore::DiskResourceLoadCallback& callback) {}
 void RasterizerNull::InitializeChannel(Tegra::Control::ChannelState& channel) {
     CreateChannel(channel);
+    if (m_use_caches) {
+        std::scoped_lock lock{m_buffer_cache.mutex, m_texture_cache.mutex};
+        m_texture_cache.CreateChannel(channel);
+        m_buffer_cache.CreateChannel(channel);
+    }
 }
 void RasterizerNull::BindChannel(Tegra::Control::ChannelState& channel) {
     BindToChannel(channel.bind_id);
+    if (m_use_caches) {
+        std::scoped_lock lock{m_buffer_cache.mutex, m_texture_cache.mutex};
+        m_texture_cache.BindToChannel(channel.bind_id);
+        m_buffer_cache.BindToChannel(channel.bind_id);
+    }
 }
 void RasterizerNull::ReleaseChannel(s32 channel_id) {
     EraseChannel(channel_id);
+    if (m_use_caches) {
+        std::scoped_lock lock{m_buffer_cache.mutex, m_texture_cache.mutex};
+        m_texture_cache.EraseChannel(channel_id);
+        m_buffer_cache.EraseChannel(channel_id);
+    }
 }
 
 } // namespace Null
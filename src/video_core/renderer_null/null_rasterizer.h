@@ -7,6 +7,9 @@
 #include "video_core/control/channel_state_cache.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_null/null_buffer_cache.h"
+#include "video_core/renderer_null/null_staging_buffer_pool.h"
+#include "video_core/renderer_null/null_texture_cache.h"
 
 namespace Core {
 class System;
@@ -18,7 +21,8 @@ class RasterizerNull;
 
 class AccelerateDMA : public Tegra::Engines::AccelerateDMAInterface {
 public:
-    explicit AccelerateDMA();
+    /// Copies and clears go through the buffer cache when there is one
+    explicit AccelerateDMA(BufferCache* buffer_cache);
     bool BufferCopy(GPUVAddr start_address, GPUVAddr end_address, u64 amount) override;
     bool BufferClear(GPUVAddr src_address, u64 amount, u32 value) override;
     bool ImageToBuffer(const Tegra::DMA::ImageCopy& copy_info, const Tegra::DMA::ImageOperand& src,
@@ -29,15 +33,30 @@ public:
                        const Tegra::DMA::ImageOperand& dst) override {
         return false;
     }
+    bool BlockLinearToPitch(const Tegra::DMA::BlockLinearCopy& copy) override {
+        return false;
+    }
+    bool PitchToBlockLinear(const Tegra::DMA::BlockLinearCopy& copy) override {
+        return false;
+    }
+
+private:
+    BufferCache* buffer_cache;
 };
 
+/**
+ * Rasterizer that draws nothing. With the null_renderer_caches setting it still runs the buffer
+ * and texture caches against runtimes that only execute transfers on the host, so the CPU side of
+ * the GPU emulation can be profiled without a host GPU in the way.
+ */
 class RasterizerNull final : public VideoCore::RasterizerInterface,
                              protected VideoCommon::ChannelSetupCaches<VideoCommon::ChannelInfo> {
 public:
-    explicit RasterizerNull(Tegra::GPU& gpu);
+    explicit RasterizerNull(Tegra::GPU& gpu, Tegra::MaxwellDeviceMemoryManager& device_memory);
     ~RasterizerNull() override;
 
     void Draw(bool is_indexed, u32 instance_count) override;
+    void DrawIndirect() override;
     void DrawTexture() override;
     void Clear(u32 layer_count) override;
     void DispatchCompute() override;
@@ -84,7 +103,17 @@ public:
     void ReleaseChannel(s32 channel_id) override;
 
 private:
+    /// Binds the buffers of a draw. Shaders are not decoded, so every enabled stage is assumed to
+    /// read all of its bound uniform buffers and no storage or texture buffers.
+    void PrepareDraw(bool is_indexed);
+
     Tegra::GPU& m_gpu;
+    const bool m_use_caches;
+    StagingBufferPool m_staging_pool;
+    BufferCacheRuntime m_buffer_cache_runtime;
+    BufferCache m_buffer_cache;
+    TextureCacheRuntime m_texture_cache_runtime;
+    TextureCache m_texture_cache;
     AccelerateDMA m_accelerate_dma;
 };
 
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+
+#include "common/assert.h"
+#include "common/literals.h"
+#include "common/make_unique_for_overwrite.h"
+#include "video_core/renderer_null/null_staging_buffer_pool.h"
+
+namespace Null {
+
+using namespace Common::Literals;
+
+namespace {
+constexpr size_t MIN_STAGING_SIZE = 64_KiB;
+} // Anonymous namespace
+
+StagingBufferPool::StagingBufferPool() = default;
+
+StagingBufferPool::~StagingBufferPool() = default;
+
+StagingBufferRef StagingBufferPool::Request(size_t size, bool deferred) {
+    std::optional<size_t> found;
+    for (size_t index = 0; index < buffers.size(); ++index) {
+        const StagingBuffer& candidate = buffers[index];
+        if (candidate.deferred || candidate.size < size) {
+            continue;
+        }
+        if (!found || candidate.size < buffers[*found].size) {
+            found = index;
+        }
+    }
+    if (!found) {
+        const size_t alloc_size = std::max(std::bit_ceil(size), MIN_STAGING_SIZE);
+        buffers.push_back(StagingBuffer{
+            .data = Common::make_unique_for_overwrite<u8[]>(alloc_size),
+            .size = alloc_size,
+            .deferred = false,
+        });
+        found = buffers.size() - 1;
+    }
+    StagingBuffer& staging = buffers[*found];
+    staging.deferred = deferred;
+    return StagingBufferRef{
+        .buffer = staging.data.get(),
+        .offset = 0,
+        .mapped_span = std::span<u8>(staging.data.get(), size),
+        .index = *found,
+    };
+}
+
+void StagingBufferPool::FreeDeferred(StagingBufferRef& ref) {
+    ASSERT(ref.index < buffers.size() && buffers[ref.index].deferred);
+    buffers[ref.index].deferred = false;
+}
+
+} // namespace Null
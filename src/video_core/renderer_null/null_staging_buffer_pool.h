@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Null {
+
+struct StagingBufferRef {
+    u8* buffer;
+    size_t offset = 0;
+    std::span<u8> mapped_span;
+    size_t index;
+};
+
+/// Host memory handed out as staging buffers. There is no GPU timeline, so staging buffers that
+/// are not deferred can be reused as soon as the next one is requested.
+class StagingBufferPool {
+public:
+    explicit StagingBufferPool();
+    ~StagingBufferPool();
+
+    StagingBufferRef Request(size_t size, bool deferred = false);
+
+    void FreeDeferred(StagingBufferRef& ref);
+
+private:
+    struct StagingBuffer {
+        std::unique_ptr<u8[]> data;
+        size_t size;
+        bool deferred;
+    };
+
+    std::vector<StagingBuffer> buffers;
+};
+
+} // namespace Null
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "video_core/renderer_null/null_texture_cache.h"
+#include "video_core/texture_cache/util.h"
+
+namespace Null {
+
+TextureCacheRuntime::TextureCacheRuntime(StagingBufferPool& staging_pool_)
+    : staging_pool{staging_pool_} {}
+
+StagingBufferRef TextureCacheRuntime::UploadStagingBuffer(size_t size) {
+    return staging_pool.Request(size);
+}
+
+StagingBufferRef TextureCacheRuntime::DownloadStagingBuffer(size_t size, bool deferred) {
+    return staging_pool.Request(size, deferred);
+}
+
+void TextureCacheRuntime::FreeDeferredStagingBuffer(StagingBufferRef& ref) {
+    staging_pool.FreeDeferred(ref);
+}
+
+Image::Image(TextureCacheRuntime&, const VideoCommon::ImageInfo& info_, GPUVAddr gpu_addr_,
+             VAddr cpu_addr_)
+    : VideoCommon::ImageBase(info_, gpu_addr_, cpu_addr_) {}
+
+Image::Image(const VideoCommon::NullImageParams& params) : VideoCommon::ImageBase{params} {}
+
+void Image::DownloadMemory(u8* buffer, size_t offset,
+                           std::span<const VideoCommon::BufferImageCopy> copies) {
+    // Nothing was rendered, write defined contents instead of stale staging memory
+    for (const VideoCommon::BufferImageCopy& copy : copies) {
+        std::memset(buffer + offset + copy.buffer_offset, 0, copy.buffer_size);
+    }
+}
+
+void Image::DownloadMemory(const StagingBufferRef& map,
+                           std::span<const VideoCommon::BufferImageCopy> copies) {
+    DownloadMemory(map.buffer, map.offset, copies);
+}
+
+ImageView::ImageView(TextureCacheRuntime&, const VideoCommon::ImageViewInfo& info,
+                     ImageId image_id_, Image& image, const SlotVector<Image>&)
+    : VideoCommon::ImageViewBase{info, image.info, image_id_, image.gpu_addr} {}
+
+ImageView::ImageView(TextureCacheRuntime&, const VideoCommon::ImageInfo& info,
+                     const VideoCommon::ImageViewInfo& view_info, GPUVAddr gpu_addr_)
+    : VideoCommon::ImageViewBase{info, view_info, gpu_addr_} {}
+
+ImageView::ImageView(TextureCacheRuntime&, const VideoCommon::NullImageViewParams& params)
+    : VideoCommon::ImageViewBase{params} {}
+
+} // namespace Null
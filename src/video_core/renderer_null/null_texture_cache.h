@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "video_core/renderer_null/null_staging_buffer_pool.h"
+#include "video_core/texture_cache/image_view_base.h"
+#include "video_core/texture_cache/texture_cache_base.h"
+
+namespace Null {
+
+class Framebuffer;
+class Image;
+class ImageView;
+class Sampler;
+
+using Common::SlotVector;
+using VideoCommon::ImageId;
+using VideoCommon::NUM_RT;
+using VideoCommon::Region2D;
+
+/// Runtime without host images. It behaves like a device that natively samples every format, so
+/// the texture cache only does the guest side work: tracking, swizzling and downloads.
+class TextureCacheRuntime {
+public:
+    explicit TextureCacheRuntime(StagingBufferPool& staging_pool_);
+
+    void Finish() {}
+
+    u64 CurrentTick() const noexcept {
+        return 0;
+    }
+
+    void Wait(u64 tick) {}
+
+    StagingBufferRef UploadStagingBuffer(size_t size);
+
+    StagingBufferRef DownloadStagingBuffer(size_t size, bool deferred = false);
+
+    void FreeDeferredStagingBuffer(StagingBufferRef& ref);
+
+    void TickFrame() {}
+
+    u64 GetDeviceLocalMemory() const {
+        return 0;
+    }
+
+    u64 GetDeviceMemoryUsage() const {
+        return 0;
+    }
+
+    u64 GetDeviceMemoryBudget() const {
+        return 0;
+    }
+
+    bool CanReportMemoryUsage() const {
+        return false;
+    }
+
+    void BlitImage(Framebuffer* dst_framebuffer, ImageView& dst, ImageView& src,
+                   const Region2D& dst_region, const Region2D& src_region,
+                   Tegra::Engines::Fermi2D::Filter filter,
+                   Tegra::Engines::Fermi2D::Operation operation) {}
+
+    void BlitFramebuffer(Framebuffer* dst, Framebuffer* src, const Region2D& dst_region,
+                         const Region2D& src_region, Tegra::Engines::Fermi2D::Filter filter,
+                         Tegra::Engines::Fermi2D::Operation operation) {}
+
+    void CopyImage(Image& dst, Image& src, std::span<const VideoCommon::ImageCopy> copies) {}
+
+    void CopyImageMSAA(Image& dst, Image& src, std::span<const VideoCommon::ImageCopy> copies) {}
+
+    bool ShouldReinterpret(Image& dst, Image& src) const noexcept {
+        return true;
+    }
+
+    void ReinterpretImage(Image& dst, Image& src, std::span<const VideoCommon::ImageCopy> copies) {}
+
+    void ConvertImage(Framebuffer* dst, ImageView& dst_view, ImageView& src_view) {}
+
+    bool CanImageBeCopied(const Image& dst, const Image& src) const noexcept {
+        return true;
+    }
+
+    void EmulateCopyImage(Image& dst, Image& src, std::span<const VideoCommon::ImageCopy> copies) {}
+
+    bool CanUploadMSAA() const noexcept {
+        return true;
+    }
+
+    void AccelerateImageUpload(Image&, const StagingBufferRef&,
+                               std::span<const VideoCommon::SwizzleParameters>) {}
+
+    void InsertUploadMemoryBarrier() {}
+
+    void QueueImageUpload(Image& image, const StagingBufferRef& map,
+                          std::span<const VideoCommon::BufferImageCopy> copies) {}
+
+    void FlushImageUploads() {}
+
+    void TransitionImageLayout(Image& image) {}
+
+    bool HasBrokenTextureViewFormats() const noexcept {
+        return false;
+    }
+
+    bool HasNativeBgr() const noexcept {
+        return true;
+    }
+
+    void BarrierFeedbackLoop() const noexcept {}
+
+private:
+    StagingBufferPool& staging_pool;
+};
+
+/// Image without contents, downloads read back zeros
+class Image : public VideoCommon::ImageBase {
+public:
+    explicit Image(TextureCacheRuntime&, const VideoCommon::ImageInfo& info, GPUVAddr gpu_addr,
+                   VAddr cpu_addr);
+    explicit Image(const VideoCommon::NullImageParams&);
+
+    void UploadMemory(const StagingBufferRef& map,
+                      std::span<const VideoCommon::BufferImageCopy> copies) {}
+
+    void DownloadMemory(u8* buffer, size_t offset,
+                        std::span<const VideoCommon::BufferImageCopy> copies);
+
+    void DownloadMemory(const StagingBufferRef& map,
+                        std::span<const VideoCommon::BufferImageCopy> copies);
+
+    bool IsRescaled() const noexcept {
+        return false;
+    }
+
+    bool ScaleUp(bool ignore = false) {
+        return false;
+    }
+
+    bool ScaleDown(bool ignore = false) {
+        return false;
+    }
+
+    void ReleaseScaledImage() {}
+};
+
+class ImageView : public VideoCommon::ImageViewBase {
+public:
+    explicit ImageView(TextureCacheRuntime&, const VideoCommon::ImageViewInfo&, ImageId, Image&,
+                       const SlotVector<Image>&);
+    explicit ImageView(TextureCacheRuntime&, const VideoCommon::ImageInfo&,
+                       const VideoCommon::ImageViewInfo&, GPUVAddr);
+    explicit ImageView(TextureCacheRuntime&, const VideoCommon::NullImageViewParams&);
+};
+
+class ImageAlloc : public VideoCommon::ImageAllocBase {};
+
+class Sampler {
+public:
+    explicit Sampler(TextureCacheRuntime&, const Tegra::Texture::TSCEntry&) {}
+};
+
+class Framebuffer {
+public:
+    explicit Framebuffer(TextureCacheRuntime&, std::span<ImageView*, NUM_RT> color_buffers,
+                         ImageView* depth_buffer, const VideoCommon::RenderTargets& key) {}
+};
+
+struct TextureCacheParams {
+    static constexpr bool ENABLE_VALIDATION = true;
+    static constexpr bool FRAMEBUFFER_BLITS = false;
+    static constexpr bool HAS_EMULATED_COPIES = false;
+    static constexpr bool HAS_DEVICE_MEMORY_INFO = false;
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = false;
+
+    using Runtime = Null::TextureCacheRuntime;
+    using Image = Null::Image;
+    using ImageAlloc = Null::ImageAlloc;
+    using ImageView = Null::ImageView;
+    using Sampler = Null::Sampler;
+    using Framebuffer = Null::Framebuffer;
+    using AsyncBuffer = Null::StagingBufferRef;
+    using BufferType = u8*;
+};
+
+using TextureCache = VideoCommon::TextureCache<TextureCacheParams>;
+
+} // namespace Null
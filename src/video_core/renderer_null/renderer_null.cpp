@@ -8,9 +8,11 @@
 
 namespace Null {
 
-RendererNull::RendererNull(Core::Frontend::EmuWindow& emu_window, Tegra::GPU& gpu,
+RendererNull::RendererNull(Core::Frontend::EmuWindow& emu_window,
+                           Tegra::MaxwellDeviceMemoryManager& device_memory, Tegra::GPU& gpu,
                            std::unique_ptr<Core::Frontend::GraphicsContext> context_)
-    : RendererBase(emu_window, std::move(context_)), m_gpu(gpu), m_rasterizer(gpu) {}
+    : RendererBase(emu_window, std::move(context_)), m_gpu(gpu),
+      m_rasterizer(gpu, device_memory) {}
 
 RendererNull::~RendererNull() = default;
 
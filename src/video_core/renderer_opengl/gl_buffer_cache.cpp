@@ -123,6 +123,13 @@ BufferCacheRuntime::BufferCacheRuntime(const Device& device_,
                               GL_STREAM_DRAW);
         }
     }
+    if (device.HasBindlessTexture()) {
+        for (OGLBuffer& buffer : bindless_texture_tables) {
+            buffer.Create();
+            glNamedBufferData(buffer.handle, MAX_BINDLESS_TEXTURES * BINDLESS_HANDLE_STRIDE,
+                              nullptr, GL_STREAM_DRAW);
+        }
+    }
     if (use_assembly_shaders) {
         for (auto& stage_uniforms : copy_uniforms) {
             for (OGLBuffer& buffer : stage_uniforms) {
@@ -149,6 +149,21 @@ public:
         }
     }
 
+    /// Uploads the bindless texture handles of a stage and binds them as a uniform buffer
+    void PushBindlessTextureHandles(size_t stage, GLuint binding,
+                                    std::span<const GLuint64> handles) {
+        const GLuint handle = bindless_texture_tables[stage].handle;
+        const GLsizeiptr gl_size = static_cast<GLsizeiptr>(handles.size() * BINDLESS_HANDLE_STRIDE);
+        std::array<GLuint, MAX_BINDLESS_TEXTURES * 4> table{};
+        for (size_t index = 0; index < handles.size(); ++index) {
+            // std140 aligns array elements to 16 bytes, each handle takes an uvec4
+            table[index * 4 + 0] = static_cast<GLuint>(handles[index]);
+            table[index * 4 + 1] = static_cast<GLuint>(handles[index] >> 32);
+        }
+        glNamedBufferSubData(handle, 0, gl_size, table.data());
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, handle, 0, gl_size);
+    }
+
     std::span<u8> BindMappedUniformBuffer(size_t stage, u32 binding_index, u32 size) noexcept {
         const auto [mapped_span, offset] = stream_buffer->Request(static_cast<size_t>(size));
         const GLuint base_binding = graphics_base_uniform_bindings[stage];
@@ -224,6 +239,10 @@ private:
 
     std::optional<StreamBuffer> stream_buffer;
 
+    static constexpr size_t MAX_BINDLESS_TEXTURES = 64;
+    static constexpr size_t BINDLESS_HANDLE_STRIDE = 16;
+    std::array<OGLBuffer, VideoCommon::NUM_STAGES> bindless_texture_tables;
+
     std::array<std::array<OGLBuffer, VideoCommon::NUM_GRAPHICS_UNIFORM_BUFFERS>,
                VideoCommon::NUM_STAGES>
         fast_uniforms;
@@ -254,6 +273,8 @@ struct BufferCacheParams {
 
     // TODO: Investigate why OpenGL seems to perform worse with persistently mapped buffer uploads
     static constexpr bool USE_MEMORY_MAPS_FOR_UPLOADS = false;
+    static constexpr bool CAN_IMPORT_HOST_MEMORY = false;
+    static constexpr bool HAS_BLOCK_LINEAR_COPY = false;
 };
 
 using BufferCache = VideoCommon::BufferCache<BufferCacheParams>;
@@ -159,6 +159,7 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
     const std::string_view version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
     const std::string_view renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
     const std::vector extensions = GetExtensions();
+    driver_identity = fmt::format("{}:{}:{}", vendor_name, renderer, version);
 
     const bool is_nvidia = vendor_name == "NVIDIA Corporation";
     const bool is_amd = vendor_name == "ATI Technologies Inc.";
@@ -181,6 +182,7 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
         disable_fast_buffer_sub_data = true;
     }
     max_uniform_buffers = BuildMaxUniformBuffers();
+    max_uniform_buffer_bindings = GetInteger<u32>(GL_MAX_UNIFORM_BUFFER_BINDINGS);
     uniform_buffer_alignment = GetInteger<size_t>(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
     shader_storage_alignment = GetInteger<size_t>(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
     max_vertex_attributes = GetInteger<u32>(GL_MAX_VERTEX_ATTRIBS);
@@ -244,6 +246,11 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
     use_asynchronous_shaders =
         Settings::values.use_asynchronous_shaders.GetValue() && !blacklist_async_shaders;
     use_driver_cache = is_nvidia;
+    has_parallel_shader_compile = GLAD_GL_KHR_parallel_shader_compile;
+    has_program_binary = GetInteger<GLint>(GL_NUM_PROGRAM_BINARY_FORMATS) > 0;
+    // Bindless textures are only used on Nvidia's driver, where per draw texture binding is
+    // the overhead they remove
+    has_bindless_texture = GLAD_GL_ARB_bindless_texture && is_nvidia;
     supports_conditional_barriers = !is_intel;
 
     LOG_INFO(Render_OpenGL, "Renderer_VariableAOFFI: {}", has_variable_aoffi);
@@ -251,6 +258,9 @@ Device::Device(Core::Frontend::EmuWindow& emu_window) {
     LOG_INFO(Render_OpenGL, "Renderer_PreciseBug: {}", has_precise_bug);
     LOG_INFO(Render_OpenGL, "Renderer_BrokenTextureViewFormats: {}",
              has_broken_texture_view_formats);
+    LOG_INFO(Render_OpenGL, "Renderer_ParallelShaderCompile: {}", has_parallel_shader_compile);
+    LOG_INFO(Render_OpenGL, "Renderer_ProgramBinary: {}", has_program_binary);
+    LOG_INFO(Render_OpenGL, "Renderer_BindlessTexture: {}", has_bindless_texture);
     if (Settings::values.use_asynchronous_shaders.GetValue() && !use_asynchronous_shaders) {
         LOG_WARNING(Render_OpenGL, "Asynchronous shader compilation enabled but not supported");
     }
@@ -334,4 +344,10 @@ u64 Device::GetCurrentDedicatedVideoMemory() const {
     return static_cast<u64>(cur_avail_mem_kb) * 1_KiB;
 }
 
+u64 Device::GetCurrentAvailableVideoMemory() const {
+    GLint cur_avail_mem_kb = 0;
+    glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &cur_avail_mem_kb);
+    return static_cast<u64>(cur_avail_mem_kb) * 1_KiB;
+}
+
 } // namespace OpenGL
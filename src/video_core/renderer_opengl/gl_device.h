@@ -22,12 +22,24 @@ public:
 
     [[nodiscard]] std::string GetVendorName() const;
 
+    /// Returns a string identifying the driver, binaries from other drivers are not compatible
+    [[nodiscard]] const std::string& GetDriverIdentity() const {
+        return driver_identity;
+    }
+
     u64 GetCurrentDedicatedVideoMemory() const;
 
+    /// Returns the dedicated video memory currently available to the process.
+    u64 GetCurrentAvailableVideoMemory() const;
+
     u32 GetMaxUniformBuffers(Shader::Stage stage) const noexcept {
         return max_uniform_buffers[static_cast<size_t>(stage)];
     }
 
+    u32 GetMaxUniformBufferBindings() const noexcept {
+        return max_uniform_buffer_bindings;
+    }
+
     size_t GetUniformBufferAlignment() const {
         return uniform_buffer_alignment;
     }
@@ -124,6 +136,18 @@ public:
         return use_driver_cache;
     }
 
+    bool HasParallelShaderCompile() const {
+        return has_parallel_shader_compile;
+    }
+
+    bool HasProgramBinary() const {
+        return has_program_binary;
+    }
+
+    bool HasBindlessTexture() const {
+        return has_bindless_texture;
+    }
+
     bool HasDepthBufferFloat() const {
         return has_depth_buffer_float;
     }
@@ -201,6 +225,7 @@ private:
     static bool TestPreciseBug();
 
     std::array<u32, Shader::MaxStageTypes> max_uniform_buffers{};
+    u32 max_uniform_buffer_bindings{};
     size_t uniform_buffer_alignment{};
     size_t shader_storage_alignment{};
     u32 max_vertex_attributes{};
@@ -228,6 +253,9 @@ private:
     bool use_assembly_shaders{};
     bool use_asynchronous_shaders{};
     bool use_driver_cache{};
+    bool has_parallel_shader_compile{};
+    bool has_program_binary{};
+    bool has_bindless_texture{};
     bool has_depth_buffer_float{};
     bool has_geometry_shader_passthrough{};
     bool has_nv_gpu_shader_5{};
@@ -245,6 +273,7 @@ private:
     bool has_lmem_perf_bug{};
 
     std::string vendor_name;
+    std::string driver_identity;
 };
 
 } // namespace OpenGL
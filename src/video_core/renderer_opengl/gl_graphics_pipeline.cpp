@@ -9,7 +9,9 @@
 #include "common/settings.h" // for enum class Settings::ShaderBackend
 #include "common/thread_worker.h"
 #include "shader_recompiler/shader_info.h"
+#include "video_core/renderer_opengl/gl_device.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 #include "video_core/renderer_opengl/gl_state_tracker.h"
@@ -172,13 +174,17 @@ ConfigureFuncPtr ConfigureFunc(const std::array<Shader::Info, 5>& infos, u32 ena
 GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_cache_,
                                    BufferCache& buffer_cache_, ProgramManager& program_manager_,
                                    StateTracker& state_tracker_, ShaderWorker* thread_worker,
+                                   ProgramBinaryCache* binary_cache_,
                                    VideoCore::ShaderNotify* shader_notify,
                                    std::array<std::string, 5> sources,
                                    std::array<std::vector<u32>, 5> sources_spirv,
                                    const std::array<const Shader::Info*, 5>& infos,
-                                   const GraphicsPipelineKey& key_, bool force_context_flush)
+                                   const GraphicsPipelineKey& key_, u32 bindless_textures_mask_,
+                                   bool force_context_flush)
     : texture_cache{texture_cache_}, buffer_cache{buffer_cache_}, program_manager{program_manager_},
-      state_tracker{state_tracker_}, key{key_} {
+      state_tracker{state_tracker_}, binary_cache{binary_cache_}, key{key_},
+      bindless_textures_mask{bindless_textures_mask_},
+      bindless_base_binding{device.GetMaxUniformBufferBindings() - 5} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -231,6 +237,7 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
         GenerateTransformFeedbackState();
     }
     const bool in_parallel = thread_worker != nullptr;
+    poll_link_completion = device.HasParallelShaderCompile();
     auto func{[this, sources_ = std::move(sources), sources_spirv_ = std::move(sources_spirv),
                shader_notify, backend, in_parallel,
                force_context_flush](ShaderContext::Context*) mutable {
@@ -238,7 +245,8 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
             switch (backend) {
             case Settings::ShaderBackend::Glsl:
                 if (!sources_[stage].empty()) {
-                    source_programs[stage] = CreateProgram(sources_[stage], Stage(stage));
+                    source_programs[stage] = CreateCachedProgram(
+                        binary_cache, sources_[stage], Stage(stage), pending_binary_keys[stage]);
                 }
                 break;
             case Settings::ShaderBackend::Glasm:
@@ -249,7 +257,9 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
                 break;
             case Settings::ShaderBackend::SpirV:
                 if (!sources_spirv_[stage].empty()) {
-                    source_programs[stage] = CreateProgram(sources_spirv_[stage], Stage(stage));
+                    source_programs[stage] =
+                        CreateCachedProgram(binary_cache, sources_spirv_[stage], Stage(stage),
+                                            pending_binary_keys[stage]);
                 }
                 break;
             }
@@ -439,6 +449,9 @@ void GraphicsPipeline::ConfigureImpl(bool is_indexed) {
     if (!IsBuilt()) {
         WaitForBuild();
     }
+    if (binary_cache) {
+        StoreProgramBinaries();
+    }
     const bool use_assembly{assembly_programs[0].handle != 0};
     if (use_assembly) {
         program_manager.BindAssemblyPrograms(assembly_programs, enabled_stages_mask);
@@ -476,21 +489,47 @@ void GraphicsPipeline::ConfigureImpl(bool is_indexed) {
                 }
             }
         }
-        for (const auto& desc : info.texture_descriptors) {
-            for (u32 index = 0; index < desc.count; ++index) {
-                ImageView& image_view{texture_cache.GetImageView((views_it++)->id)};
-                textures[texture_binding] = image_view.Handle(desc.type);
-                if (texture_cache.IsRescaling(image_view)) {
-                    texture_scaling_mask |= 1u << stage_texture_binding;
+        if (((bindless_textures_mask >> stage) & 1) != 0) {
+            std::array<GLuint64, MAX_TEXTURES> handles;
+            size_t num_handles{};
+            for (const auto& desc : info.texture_descriptors) {
+                for (u32 index = 0; index < desc.count; ++index) {
+                    ImageView& image_view{texture_cache.GetImageView((views_it++)->id)};
+                    if (texture_cache.IsRescaling(image_view)) {
+                        texture_scaling_mask |= 1u << stage_texture_binding;
+                    }
+                    ++stage_texture_binding;
+
+                    const Sampler& sampler{texture_cache.GetSampler(*(samplers_it++))};
+                    const bool use_fallback_sampler{sampler.HasAddedAnisotropy() &&
+                                                    !image_view.SupportsAnisotropy()};
+                    const GLuint gl_sampler{use_fallback_sampler
+                                                ? sampler.HandleWithDefaultAnisotropy()
+                                                : sampler.Handle()};
+                    handles[num_handles++] = image_view.BindlessHandle(desc.type, gl_sampler);
+                }
+            }
+            buffer_cache.runtime.PushBindlessTextureHandles(
+                stage, bindless_base_binding + static_cast<GLuint>(stage),
+                std::span(handles.data(), num_handles));
+        } else {
+            for (const auto& desc : info.texture_descriptors) {
+                for (u32 index = 0; index < desc.count; ++index) {
+                    ImageView& image_view{texture_cache.GetImageView((views_it++)->id)};
+                    textures[texture_binding] = image_view.Handle(desc.type);
+                    if (texture_cache.IsRescaling(image_view)) {
+                        texture_scaling_mask |= 1u << stage_texture_binding;
+                    }
+                    ++texture_binding;
+                    ++stage_texture_binding;
+
+                    const Sampler& sampler{texture_cache.GetSampler(*(samplers_it++))};
+                    const bool use_fallback_sampler{sampler.HasAddedAnisotropy() &&
+                                                    !image_view.SupportsAnisotropy()};
+                    gl_samplers[sampler_binding++] = use_fallback_sampler
+                                                         ? sampler.HandleWithDefaultAnisotropy()
+                                                         : sampler.Handle();
                 }
-                ++texture_binding;
-                ++stage_texture_binding;
-
-                const Sampler& sampler{texture_cache.GetSampler(*(samplers_it++))};
-                const bool use_fallback_sampler{sampler.HasAddedAnisotropy() &&
-                                                !image_view.SupportsAnisotropy()};
-                gl_samplers[sampler_binding++] =
-                    use_fallback_sampler ? sampler.HandleWithDefaultAnisotropy() : sampler.Handle();
             }
         }
         for (const auto& desc : info.image_descriptors) {
@@ -630,8 +669,34 @@ bool GraphicsPipeline::IsBuilt() noexcept {
     if (built_fence.handle == 0) {
         return false;
     }
-    is_built = built_fence.IsSignaled();
+    is_built = built_fence.IsSignaled() && IsLinkComplete();
     return is_built;
 }
 
+bool GraphicsPipeline::IsLinkComplete() const {
+    if (!poll_link_completion) {
+        return true;
+    }
+    // Drivers with parallel compilation may still be linking after the fence has signaled, using
+    // the program before that would stall the draw
+    return std::ranges::all_of(source_programs, [](const OGLProgram& program) {
+        if (program.handle == 0) {
+            return true;
+        }
+        GLint completed{};
+        glGetProgramiv(program.handle, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed != GL_FALSE;
+    });
+}
+
+void GraphicsPipeline::StoreProgramBinaries() {
+    for (size_t stage = 0; stage < pending_binary_keys.size(); ++stage) {
+        if (pending_binary_keys[stage] != 0) {
+            binary_cache->Add(pending_binary_keys[stage], source_programs[stage].handle);
+            pending_binary_keys[stage] = 0;
+        }
+    }
+    binary_cache = nullptr;
+}
+
 } // namespace OpenGL
@@ -25,6 +25,7 @@ struct Context;
 }
 
 class Device;
+class ProgramBinaryCache;
 class ProgramManager;
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
@@ -74,11 +75,13 @@ public:
     explicit GraphicsPipeline(const Device& device, TextureCache& texture_cache_,
                               BufferCache& buffer_cache_, ProgramManager& program_manager_,
                               StateTracker& state_tracker_, ShaderWorker* thread_worker,
+                              ProgramBinaryCache* binary_cache_,
                               VideoCore::ShaderNotify* shader_notify,
                               std::array<std::string, 5> sources,
                               std::array<std::vector<u32>, 5> sources_spirv,
                               const std::array<const Shader::Info*, 5>& infos,
-                              const GraphicsPipelineKey& key_, bool force_context_flush = false);
+                              const GraphicsPipelineKey& key_, u32 bindless_textures_mask_,
+                              bool force_context_flush = false);
 
     void Configure(bool is_indexed) {
         configure_func(this, is_indexed);
@@ -126,19 +129,28 @@ private:
 
     void WaitForBuild();
 
+    /// Returns true when the driver has finished linking every program
+    [[nodiscard]] bool IsLinkComplete() const;
+
+    void StoreProgramBinaries();
+
     TextureCache& texture_cache;
     BufferCache& buffer_cache;
     Tegra::MemoryManager* gpu_memory;
     Tegra::Engines::Maxwell3D* maxwell3d;
     ProgramManager& program_manager;
     StateTracker& state_tracker;
+    ProgramBinaryCache* binary_cache;
     const GraphicsPipelineKey key;
 
     void (*configure_func)(GraphicsPipeline*, bool){};
 
     std::array<OGLProgram, 5> source_programs;
     std::array<OGLAssemblyProgram, 5> assembly_programs;
+    std::array<u64, 5> pending_binary_keys{};
     u32 enabled_stages_mask{};
+    u32 bindless_textures_mask{};
+    u32 bindless_base_binding{};
 
     std::array<Shader::Info, 5> stage_infos{};
     std::array<u32, 5> enabled_uniform_buffer_masks{};
@@ -160,6 +172,7 @@ private:
     std::mutex built_mutex;
     std::condition_variable built_condvar;
     OGLSync built_fence{};
+    bool poll_link_completion{};
     bool is_built{false};
 };
 
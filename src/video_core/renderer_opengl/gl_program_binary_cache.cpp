@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <fstream>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
+
+namespace OpenGL {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'g', 'l', 'p', 'b'};
+
+// Stop growing the file past this size, it is loaded in full on every boot
+constexpr size_t MAX_FILE_SIZE = 1024ULL * 1024 * 1024;
+} // Anonymous namespace
+
+u64 ProgramBinaryCache::MakeKey(std::span<const u8> code, GLenum stage) {
+    return Common::CityHash64(reinterpret_cast<const char*>(code.data()), code.size()) ^
+           static_cast<u64>(stage);
+}
+
+void ProgramBinaryCache::Load(const std::filesystem::path& filename_,
+                              u32 expected_cache_version) try {
+    std::scoped_lock lock{mutex};
+    filename = filename_;
+    cache_version = expected_cache_version;
+    file_size = 0;
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> magic_number;
+    u32 file_cache_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&file_cache_version), sizeof(file_cache_version));
+    if (magic_number != MAGIC_NUMBER || file_cache_version != expected_cache_version) {
+        file.close();
+        if (Common::FS::RemoveFile(filename)) {
+            LOG_INFO(Common_Filesystem, "Deleting old program binary cache");
+        } else {
+            LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache in \"{}\"",
+                      Common::FS::PathToUTF8String(filename));
+        }
+        return;
+    }
+    while (file.tellg() != end) {
+        u64 key{};
+        Entry entry{};
+        u64 size{};
+        file.read(reinterpret_cast<char*>(&key), sizeof(key))
+            .read(reinterpret_cast<char*>(&entry.format), sizeof(entry.format))
+            .read(reinterpret_cast<char*>(&size), sizeof(size));
+        entry.binary.resize(size);
+        file.read(reinterpret_cast<char*>(entry.binary.data()), size);
+        entries.insert_or_assign(key, std::move(entry));
+    }
+    file_size = static_cast<size_t>(end);
+    LOG_INFO(Render_OpenGL, "Loaded {} program binaries", entries.size());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    entries.clear();
+    file_size = 0;
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+OGLProgram ProgramBinaryCache::Find(u64 key) {
+    OGLProgram program;
+    {
+        std::scoped_lock lock{mutex};
+        const auto it{entries.find(key)};
+        if (it == entries.end()) {
+            return program;
+        }
+        const Entry& entry{it->second};
+        program.handle = glCreateProgram();
+        glProgramParameteri(program.handle, GL_PROGRAM_SEPARABLE, GL_TRUE);
+        glProgramBinary(program.handle, entry.format, entry.binary.data(),
+                        static_cast<GLsizei>(entry.binary.size()));
+    }
+    GLint link_status{};
+    glGetProgramiv(program.handle, GL_LINK_STATUS, &link_status);
+    if (link_status == GL_FALSE) {
+        // Drivers reject binaries of other versions, the program is compiled and stored again
+        program.Release();
+        std::scoped_lock lock{mutex};
+        entries.erase(key);
+    }
+    return program;
+}
+
+void ProgramBinaryCache::Add(u64 key, GLuint program) {
+    GLint length{};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    Entry entry{
+        .format = GL_NONE,
+        .binary = std::vector<u8>(static_cast<size_t>(length)),
+    };
+    glGetProgramBinary(program, length, nullptr, &entry.format, entry.binary.data());
+
+    std::scoped_lock lock{mutex};
+    const auto [it, is_new]{entries.try_emplace(key, std::move(entry))};
+    if (is_new) {
+        Serialize(key, it->second);
+    }
+}
+
+void ProgramBinaryCache::Serialize(u64 key, const Entry& entry) try {
+    if (filename.empty() || file_size + entry.binary.size() > MAX_FILE_SIZE) {
+        return;
+    }
+    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    if (file.tellp() == 0) {
+        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+    }
+    const u64 size{static_cast<u64>(entry.binary.size())};
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key))
+        .write(reinterpret_cast<const char*>(&entry.format), sizeof(entry.format))
+        .write(reinterpret_cast<const char*>(&size), sizeof(size))
+        .write(reinterpret_cast<const char*>(entry.binary.data()), entry.binary.size());
+    file_size = static_cast<size_t>(file.tellp());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete program binary cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+    file_size = 0;
+}
+
+} // namespace OpenGL
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "common/common_types.h"
+#include "video_core/renderer_opengl/gl_resource_manager.h"
+
+namespace OpenGL {
+
+/**
+ * Driver binaries of linked programs, keyed by the code they were compiled from.
+ * Programs created from a binary skip compilation and linking in the driver. Binaries depend on
+ * the driver, so the file name includes the identity of the driver that produced them.
+ */
+class ProgramBinaryCache {
+public:
+    /// Returns the key of a program compiled from the given code
+    [[nodiscard]] static u64 MakeKey(std::span<const u8> code, GLenum stage);
+
+    /// Loads the binaries stored in the given file, discarding it when invalid
+    void Load(const std::filesystem::path& filename, u32 expected_cache_version);
+
+    /// Creates a program from a cached binary. Returns an empty program when there is none or
+    /// when the driver rejects it.
+    [[nodiscard]] OGLProgram Find(u64 key);
+
+    /// Reads back the binary of a linked program, blocking until the link finishes, and appends
+    /// it to the backing file
+    void Add(u64 key, GLuint program);
+
+    [[nodiscard]] bool IsLoaded() const noexcept {
+        return !filename.empty();
+    }
+
+private:
+    struct Entry {
+        GLenum format;
+        std::vector<u8> binary;
+    };
+
+    void Serialize(u64 key, const Entry& entry);
+
+    std::mutex mutex;
+    std::unordered_map<u64, Entry> entries;
+    std::filesystem::path filename;
+    u32 cache_version{};
+    size_t file_size{};
+};
+
+} // namespace OpenGL
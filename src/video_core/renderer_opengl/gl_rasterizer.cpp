@@ -11,6 +11,7 @@
 #include <glad/glad.h>
 
 #include "common/assert.h"
+#include "common/boot_profiler.h"
 #include "common/logging/log.h"
 #include "common/math_util.h"
 #include "common/microprofile.h"
@@ -152,6 +153,7 @@ void RasterizerOpenGL::SyncVertexInstances() {
 
 void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    BOOT_PHASE("LoadDiskShaderCache");
     shader_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
@@ -722,6 +724,13 @@ bool RasterizerOpenGL::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surf
     return texture_cache.BlitImage(dst, src, copy_config);
 }
 
+bool RasterizerOpenGL::AccelerateSurfaceWrite(DAddr addr,
+                                              const Tegra::Engines::Fermi2D::Surface& surface,
+                                              std::span<const u8> pixels) {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.WriteHostImage(addr, surface, pixels);
+}
+
 Tegra::Engines::AccelerateDMAInterface& RasterizerOpenGL::AccessAccelerateDMA() {
     return accelerate_dma;
 }
@@ -1452,4 +1461,14 @@ bool AccelerateDMA::BufferToImage(const Tegra::DMA::ImageCopy& copy_info,
     return DmaBufferImageCopy<true>(copy_info, buffer_operand, image_operand);
 }
 
+bool AccelerateDMA::BlockLinearToPitch(const Tegra::DMA::BlockLinearCopy& copy) {
+    std::scoped_lock lock{buffer_cache.mutex};
+    return buffer_cache.DMABlockLinearCopy(copy, false).has_value();
+}
+
+bool AccelerateDMA::PitchToBlockLinear(const Tegra::DMA::BlockLinearCopy& copy) {
+    std::scoped_lock lock{buffer_cache.mutex};
+    return buffer_cache.DMABlockLinearCopy(copy, true).has_value();
+}
+
 } // namespace OpenGL
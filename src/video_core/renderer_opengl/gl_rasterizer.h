@@ -62,6 +62,10 @@ public:
     bool BufferToImage(const Tegra::DMA::ImageCopy& copy_info, const Tegra::DMA::BufferOperand& src,
                        const Tegra::DMA::ImageOperand& dst) override;
 
+    bool BlockLinearToPitch(const Tegra::DMA::BlockLinearCopy& copy) override;
+
+    bool PitchToBlockLinear(const Tegra::DMA::BlockLinearCopy& copy) override;
+
 private:
     template <bool IS_IMAGE_UPLOAD>
     bool DmaBufferImageCopy(const Tegra::DMA::ImageCopy& copy_info,
@@ -120,6 +124,8 @@ public:
     bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                const Tegra::Engines::Fermi2D::Surface& dst,
                                const Tegra::Engines::Fermi2D::Config& copy_config) override;
+    bool AccelerateSurfaceWrite(DAddr addr, const Tegra::Engines::Fermi2D::Surface& surface,
+                                std::span<const u8> pixels) override;
     Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override;
     void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
                                   std::span<const u8> memory) override;
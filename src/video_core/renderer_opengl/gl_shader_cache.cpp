@@ -10,6 +10,7 @@
 
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/cityhash.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
@@ -40,6 +41,7 @@ using Shader::Backend::GLASM::EmitGLASM;
 using Shader::Backend::GLSL::EmitGLSL;
 using Shader::Backend::SPIRV::EmitSPIRV;
 using Shader::Maxwell::ConvertLegacyToGeneric;
+using Shader::Maxwell::EliminateDeadVaryings;
 using Shader::Maxwell::GenerateGeometryPassthrough;
 using Shader::Maxwell::MergeDualVertexPrograms;
 using Shader::Maxwell::TranslateProgram;
@@ -51,7 +53,7 @@ using VideoCommon::LoadPipelines;
 using VideoCommon::SerializePipeline;
 using Context = ShaderContext::Context;
 
-constexpr u32 CACHE_VERSION = 10;
+constexpr u32 CACHE_VERSION = 11;
 
 template <typename Container>
 auto MakeSpan(Container& container) {
@@ -248,6 +250,10 @@ ShaderCache::ShaderCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
           .support_geometry_shader_passthrough = device.HasGeometryShaderPassthrough(),
           .support_conditional_barrier = device.SupportsConditionalBarriers(),
       } {
+    if (device.HasParallelShaderCompile()) {
+        // Let the driver pick how many threads it compiles with
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
     if (use_asynchronous_shaders) {
         workers = CreateWorkers();
     }
@@ -267,6 +273,13 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         return;
     }
     shader_cache_filename = base_dir / "opengl.bin";
+    if (device.HasProgramBinary() && device.GetShaderBackend() != Settings::ShaderBackend::Glasm) {
+        // Binaries are only valid for the driver that produced them
+        const std::string& driver{device.GetDriverIdentity()};
+        const u64 driver_hash{Common::CityHash64(driver.data(), driver.size())};
+        const auto filename{fmt::format("opengl_programs_{:016x}.bin", driver_hash)};
+        program_binary_cache.Load(base_dir / filename, CACHE_VERSION);
+    }
 
     if (!workers && !strict_context_required) {
         workers = CreateWorkers();
@@ -290,7 +303,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
             workers->QueueWork(std::move(work));
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env) {
         ComputePipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
@@ -307,7 +320,7 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
         queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
@@ -454,6 +467,7 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     LOG_INFO(Render_OpenGL, "0x{:016x}", hash);
     size_t env_index{};
     u32 total_storage_buffers{};
+    u32 total_uniform_buffers{};
     std::array<Shader::IR::Program, Maxwell::MaxShaderProgram> programs;
     const bool uses_vertex_a{key.unique_hashes[0] != 0};
     const bool uses_vertex_b{key.unique_hashes[1] != 0};
@@ -498,13 +512,37 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
             programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
         }
 
+        total_uniform_buffers +=
+            Shader::NumDescriptors(programs[index].info.constant_buffer_descriptors);
+
         if (programs[index].info.requires_layer_emulation) {
             layer_source_program = &programs[index];
         }
     }
+    const size_t fragment_index{static_cast<size_t>(Maxwell::ShaderType::Pixel)};
+    if (key.unique_hashes[fragment_index] != 0 && key.xfb_enabled == 0) {
+        // Drop the outputs of the last pre-rasterization stage that the fragment stage ignores
+        const size_t geometry_index{static_cast<size_t>(Maxwell::ShaderType::Geometry)};
+        for (size_t index = fragment_index - 1; index > 0; --index) {
+            const bool is_emulated_stage{layer_source_program != nullptr &&
+                                         index == geometry_index};
+            if (key.unique_hashes[index] != 0 || is_emulated_stage) {
+                EliminateDeadVaryings(programs[index], programs[fragment_index]);
+                break;
+            }
+        }
+    }
     const u32 glasm_storage_buffer_limit{device.GetMaxGLASMStorageBufferBlocks()};
     const bool glasm_use_storage_buffers{total_storage_buffers <= glasm_storage_buffer_limit};
 
+    // Bindless texture handles are read from the last uniform buffer bindings, one per stage,
+    // which must not overlap the bindings taken by constant buffers
+    const u32 bindless_base_binding{device.GetMaxUniformBufferBindings() - 5};
+    const bool use_bindless_textures{device.HasBindlessTexture() &&
+                                     device.GetShaderBackend() == Settings::ShaderBackend::Glsl &&
+                                     total_uniform_buffers <= bindless_base_binding};
+    u32 bindless_textures_mask{};
+
     std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
 
     std::array<std::string, 5> sources;
@@ -525,8 +563,16 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
         const size_t stage_index{index - 1};
         infos[stage_index] = &program.info;
 
-        const auto runtime_info{
+        auto runtime_info{
             MakeRuntimeInfo(key, program, previous_program, glasm_use_storage_buffers, use_glasm)};
+        const u32 num_uniform_buffers{
+            Shader::NumDescriptors(program.info.constant_buffer_descriptors)};
+        if (use_bindless_textures && !program.info.texture_descriptors.empty() &&
+            num_uniform_buffers < device.GetMaxUniformBuffers(program.stage)) {
+            runtime_info.glsl_bindless_texture_binding =
+                bindless_base_binding + static_cast<u32>(stage_index);
+            bindless_textures_mask |= 1u << stage_index;
+        }
         switch (device.GetShaderBackend()) {
         case Settings::ShaderBackend::Glsl:
             ConvertLegacyToGeneric(program, runtime_info);
@@ -544,8 +590,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
     }
     auto* const thread_worker{use_shader_workers ? workers.get() : nullptr};
     return std::make_unique<GraphicsPipeline>(device, texture_cache, buffer_cache, program_manager,
-                                              state_tracker, thread_worker, &shader_notify, sources,
-                                              sources_spirv, infos, key, force_context_flush);
+                                              state_tracker, thread_worker, BinaryCache(),
+                                              &shader_notify, sources, sources_spirv, infos, key,
+                                              bindless_textures_mask, force_context_flush);
 
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
@@ -601,7 +648,8 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
     }
 
     return std::make_unique<ComputePipeline>(device, texture_cache, buffer_cache, program_manager,
-                                             program.info, code, code_spirv, force_context_flush);
+                                             BinaryCache(), program.info, code, code_spirv,
+                                             force_context_flush);
 } catch (Shader::Exception& exception) {
     LOG_ERROR(Render_OpenGL, "{}", exception.what());
     return nullptr;
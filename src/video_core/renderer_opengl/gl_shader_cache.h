@@ -12,6 +12,7 @@
 #include "shader_recompiler/profile.h"
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_context.h"
 #include "video_core/shader_cache.h"
 
@@ -64,6 +65,11 @@ private:
 
     std::unique_ptr<ShaderWorker> CreateWorkers() const;
 
+    /// Returns the program binary cache, or null when programs are not cached
+    [[nodiscard]] ProgramBinaryCache* BinaryCache() noexcept {
+        return program_binary_cache.IsLoaded() ? &program_binary_cache : nullptr;
+    }
+
     Core::Frontend::EmuWindow& emu_window;
     const Device& device;
     TextureCache& texture_cache;
@@ -85,6 +91,7 @@ private:
     Shader::HostTranslateInfo host_info;
 
     std::filesystem::path shader_cache_filename;
+    ProgramBinaryCache program_binary_cache;
     std::unique_ptr<ShaderWorker> workers;
 };
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <glad/glad.h>
+
 #include "core/frontend/emu_window.h"
 #include "core/frontend/graphics_context.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
@@ -23,7 +25,11 @@ struct ShaderPools {
 
 struct Context {
     explicit Context(Core::Frontend::EmuWindow& emu_window)
-        : gl_context{emu_window.CreateSharedContext()}, scoped{*gl_context} {}
+        : gl_context{emu_window.CreateSharedContext()}, scoped{*gl_context} {
+        if (GLAD_GL_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        }
+    }
 
     std::unique_ptr<Core::Frontend::GraphicsContext> gl_context;
     Core::Frontend::GraphicsContext::Scoped scoped;
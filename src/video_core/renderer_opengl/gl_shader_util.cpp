@@ -7,14 +7,18 @@
 
 #include "common/logging/log.h"
 #include "common/settings.h"
+#include "video_core/renderer_opengl/gl_program_binary_cache.h"
 #include "video_core/renderer_opengl/gl_shader_util.h"
 
 namespace OpenGL {
 
-static OGLProgram LinkSeparableProgram(GLuint shader) {
+static OGLProgram LinkSeparableProgram(GLuint shader, bool retrievable = false) {
     OGLProgram program;
     program.handle = glCreateProgram();
     glProgramParameteri(program.handle, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    if (retrievable) {
+        glProgramParameteri(program.handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(program.handle, shader);
     glLinkProgram(program.handle);
     glDetachShader(program.handle, shader);
@@ -62,7 +66,7 @@ static void LogShader(GLuint shader, std::string_view code = {}) {
     }
 }
 
-OGLProgram CreateProgram(std::string_view code, GLenum stage) {
+static OGLProgram CreateProgram(std::string_view code, GLenum stage, bool retrievable) {
     OGLShader shader;
     shader.handle = glCreateShader(stage);
 
@@ -73,10 +77,10 @@ OGLProgram CreateProgram(std::string_view code, GLenum stage) {
     if (Settings::values.renderer_debug) {
         LogShader(shader.handle, code);
     }
-    return LinkSeparableProgram(shader.handle);
+    return LinkSeparableProgram(shader.handle, retrievable);
 }
 
-OGLProgram CreateProgram(std::span<const u32> code, GLenum stage) {
+static OGLProgram CreateProgram(std::span<const u32> code, GLenum stage, bool retrievable) {
     OGLShader shader;
     shader.handle = glCreateShader(stage);
 
@@ -86,7 +90,42 @@ OGLProgram CreateProgram(std::span<const u32> code, GLenum stage) {
     if (Settings::values.renderer_debug) {
         LogShader(shader.handle);
     }
-    return LinkSeparableProgram(shader.handle);
+    return LinkSeparableProgram(shader.handle, retrievable);
+}
+
+template <typename Code>
+static OGLProgram CreateCachedProgramImpl(ProgramBinaryCache* binary_cache, Code code,
+                                          GLenum stage, u64& pending_key) {
+    pending_key = 0;
+    if (!binary_cache) {
+        return CreateProgram(code, stage, false);
+    }
+    const std::span<const u8> bytes(reinterpret_cast<const u8*>(code.data()),
+                                    code.size() * sizeof(code[0]));
+    const u64 key{ProgramBinaryCache::MakeKey(bytes, stage)};
+    if (OGLProgram program{binary_cache->Find(key)}; program.handle != 0) {
+        return program;
+    }
+    pending_key = key;
+    return CreateProgram(code, stage, true);
+}
+
+OGLProgram CreateProgram(std::string_view code, GLenum stage) {
+    return CreateProgram(code, stage, false);
+}
+
+OGLProgram CreateProgram(std::span<const u32> code, GLenum stage) {
+    return CreateProgram(code, stage, false);
+}
+
+OGLProgram CreateCachedProgram(ProgramBinaryCache* binary_cache, std::string_view code,
+                               GLenum stage, u64& pending_key) {
+    return CreateCachedProgramImpl(binary_cache, code, stage, pending_key);
+}
+
+OGLProgram CreateCachedProgram(ProgramBinaryCache* binary_cache, std::span<const u32> code,
+                               GLenum stage, u64& pending_key) {
+    return CreateCachedProgramImpl(binary_cache, code, stage, pending_key);
 }
 
 OGLAssemblyProgram CompileProgram(std::string_view code, GLenum target) {
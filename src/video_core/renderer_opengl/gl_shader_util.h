@@ -12,10 +12,20 @@
 
 namespace OpenGL {
 
+class ProgramBinaryCache;
+
 OGLProgram CreateProgram(std::string_view code, GLenum stage);
 
 OGLProgram CreateProgram(std::span<const u32> code, GLenum stage);
 
+/// Creates a program from its cached binary when there is one, otherwise compiles it with its
+/// binary retrievable and stores in pending_key the key to add it under once it is linked.
+OGLProgram CreateCachedProgram(ProgramBinaryCache* binary_cache, std::string_view code,
+                               GLenum stage, u64& pending_key);
+
+OGLProgram CreateCachedProgram(ProgramBinaryCache* binary_cache, std::span<const u32> code,
+                               GLenum stage, u64& pending_key);
+
 OGLAssemblyProgram CompileProgram(std::string_view code, GLenum target);
 
 } // namespace OpenGL
@@ -572,6 +572,14 @@ u64 TextureCacheRuntime::GetDeviceMemoryUsage() const {
     return 2_GiB;
 }
 
+u64 TextureCacheRuntime::GetDeviceMemoryBudget() const {
+    if (device.CanReportMemoryUsage()) {
+        // Whatever other processes are holding is out of reach, so count only what is left free
+        return GetDeviceMemoryUsage() + device.GetCurrentAvailableVideoMemory();
+    }
+    return 0;
+}
+
 void TextureCacheRuntime::CopyImage(Image& dst_image, Image& src_image,
                                     std::span<const ImageCopy> copies) {
     const GLuint dst_name = dst_image.Handle();
@@ -670,6 +678,12 @@ void TextureCacheRuntime::InsertUploadMemoryBarrier() {
     glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 }
 
+void TextureCacheRuntime::QueueImageUpload(Image& image, const StagingBufferMap& map,
+                                           std::span<const VideoCommon::BufferImageCopy> copies) {
+    // Uploads are issued as buffer to texture commands right away, there is nothing to group
+    image.UploadMemory(map, copies);
+}
+
 FormatProperties TextureCacheRuntime::FormatInfo(ImageType type, GLenum internal_format) const {
     switch (type) {
     case ImageType::e1D:
@@ -1098,6 +1112,11 @@ bool Image::ScaleDown(bool ignore) {
     return true;
 }
 
+void Image::ReleaseScaledImage() {
+    ASSERT(False(flags & ImageFlagBits::Rescaled));
+    upscaled_backup.Release();
+}
+
 ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::ImageViewInfo& info,
                      ImageId image_id_, Image& image, const SlotVector<Image>&)
     : VideoCommon::ImageViewBase{info, image.info, image_id_, image.gpu_addr},
@@ -1207,7 +1226,25 @@ ImageView::ImageView(TextureCacheRuntime&, const VideoCommon::ImageInfo& info,
 ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::NullImageViewParams& params)
     : VideoCommon::ImageViewBase{params}, views{runtime.null_image_views} {}
 
-ImageView::~ImageView() = default;
+ImageView::~ImageView() {
+    for (const auto& [key, handle] : bindless_handles) {
+        glMakeTextureHandleNonResidentARB(handle);
+    }
+}
+
+GLuint64 ImageView::BindlessHandle(Shader::TextureType handle_type, GLuint sampler) {
+    const GLuint texture{Handle(handle_type)};
+    const u64 key{(static_cast<u64>(texture) << 32) | sampler};
+    const auto it{std::ranges::find(bindless_handles, key, &std::pair<u64, GLuint64>::first)};
+    if (it != bindless_handles.end()) {
+        return it->second;
+    }
+    // Creating the handle makes the view and sampler state immutable, both are already final
+    const GLuint64 handle{glGetTextureSamplerHandleARB(texture, sampler)};
+    glMakeTextureHandleResidentARB(handle);
+    bindless_handles.emplace_back(key, handle);
+    return handle;
+}
 
 GLuint ImageView::StorageView(Shader::TextureType texture_type, Shader::ImageFormat image_format) {
     if (image_format == Shader::ImageFormat::Typeless) {
@@ -5,6 +5,8 @@
 
 #include <memory>
 #include <span>
+#include <utility>
+#include <vector>
 
 #include <glad/glad.h>
 
@@ -72,6 +74,15 @@ public:
 
     void Finish();
 
+    u64 CurrentTick() const noexcept {
+        return 0;
+    }
+
+    /// OpenGL has no timeline to wait on, waits for all the submitted commands instead
+    void Wait([[maybe_unused]] u64 tick) {
+        Finish();
+    }
+
     StagingBufferMap UploadStagingBuffer(size_t size);
 
     StagingBufferMap DownloadStagingBuffer(size_t size, bool deferred = false);
@@ -84,6 +95,8 @@ public:
 
     u64 GetDeviceMemoryUsage() const;
 
+    u64 GetDeviceMemoryBudget() const;
+
     bool CanReportMemoryUsage() const {
         return device.CanReportMemoryUsage();
     }
@@ -120,6 +133,11 @@ public:
 
     void InsertUploadMemoryBarrier();
 
+    void QueueImageUpload(Image& image, const StagingBufferMap& map,
+                          std::span<const VideoCommon::BufferImageCopy> copies);
+
+    void FlushImageUploads() {}
+
     void TransitionImageLayout(Image& image) {}
 
     FormatProperties FormatInfo(VideoCommon::ImageType type, GLenum internal_format) const;
@@ -223,6 +241,9 @@ public:
 
     bool ScaleDown(bool ignore = false);
 
+    /// Destroys the scaled copy of an image that is not rescaled
+    void ReleaseScaledImage();
+
 private:
     void CopyBufferToImage(const VideoCommon::BufferImageCopy& copy, size_t buffer_offset);
 
@@ -272,6 +293,9 @@ public:
         return default_handle;
     }
 
+    /// Returns a resident bindless handle of the view of the given type paired with a sampler
+    [[nodiscard]] GLuint64 BindlessHandle(Shader::TextureType handle_type, GLuint sampler);
+
     [[nodiscard]] GLenum Format() const noexcept {
         return internal_format;
     }
@@ -297,6 +321,7 @@ private:
     std::array<GLuint, Shader::NUM_TEXTURE_TYPES> views{};
     std::vector<OGLTextureView> stored_views;
     std::unique_ptr<StorageViews> storage_views;
+    std::vector<std::pair<u64, GLuint64>> bindless_handles;
     GLenum internal_format = GL_NONE;
     GLuint default_handle = 0;
     u32 buffer_size = 0;
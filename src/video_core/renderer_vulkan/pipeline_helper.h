@@ -10,6 +10,7 @@
 #include "common/common_types.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/shader_info.h"
+#include "video_core/renderer_vulkan/vk_descriptor_buffer.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/texture_cache/types.h"
@@ -24,7 +25,9 @@ public:
     DescriptorLayoutBuilder(const Device& device_) : device{&device_} {}
 
     bool CanUsePushDescriptor() const noexcept {
+        // Push descriptors can't be mixed with descriptor buffers
         return device->IsKhrPushDescriptorSupported() &&
+               !device->IsExtDescriptorBufferSupported() &&
                num_descriptors <= device->MaxPushDescriptors();
     }
 
@@ -32,8 +35,11 @@ public:
         if (bindings.empty()) {
             return nullptr;
         }
-        const VkDescriptorSetLayoutCreateFlags flags =
+        VkDescriptorSetLayoutCreateFlags flags =
             use_push_descriptor ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
+        if (device->IsExtDescriptorBufferSupported()) {
+            flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        }
         return device->GetLogical().CreateDescriptorSetLayout({
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
             .pNext = nullptr,
@@ -66,6 +72,14 @@ public:
         });
     }
 
+    DescriptorBufferLayout CreateDescriptorBufferLayout(
+        VkDescriptorSetLayout descriptor_set_layout) const {
+        if (entries.empty()) {
+            return DescriptorBufferLayout{};
+        }
+        return DescriptorBufferLayout(*device, descriptor_set_layout, entries);
+    }
+
     vk::PipelineLayout CreatePipelineLayout(VkDescriptorSetLayout descriptor_set_layout) const {
         using Shader::Backend::SPIRV::RenderAreaLayout;
         using Shader::Backend::SPIRV::RescalingLayout;
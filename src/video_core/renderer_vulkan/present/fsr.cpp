@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "common/settings.h"
@@ -9,6 +11,8 @@
 #include "video_core/host_shaders/vulkan_fidelityfx_fsr_easu_fp16_frag_spv.h"
 #include "video_core/host_shaders/vulkan_fidelityfx_fsr_easu_fp32_frag_spv.h"
 #include "video_core/host_shaders/vulkan_fidelityfx_fsr_rcas_fp16_frag_spv.h"
+#include "video_core/host_shaders/vulkan_fidelityfx_fsr_fused_fp16_comp_spv.h"
+#include "video_core/host_shaders/vulkan_fidelityfx_fsr_fused_fp32_comp_spv.h"
 #include "video_core/host_shaders/vulkan_fidelityfx_fsr_rcas_fp32_frag_spv.h"
 #include "video_core/host_shaders/vulkan_fidelityfx_fsr_vert_spv.h"
 #include "video_core/renderer_vulkan/present/fsr.h"
@@ -21,11 +25,18 @@ namespace Vulkan {
 using namespace FSR;
 
 using PushConstants = std::array<u32, 4 * 4>;
+using FusedPushConstants = std::array<u32, 5 * 4>;
+
+// Size of the output tiles processed by a workgroup of the fused pass
+constexpr u32 FUSED_TILE_SIZE = 16;
 
 FSR::FSR(const Device& device, MemoryAllocator& memory_allocator, size_t image_count,
          VkExtent2D extent)
-    : m_device{device}, m_memory_allocator{memory_allocator},
-      m_image_count{image_count}, m_extent{extent} {
+    : m_device{device}, m_memory_allocator{memory_allocator}, m_image_count{image_count},
+      m_extent{extent},
+      m_use_fused{device.IsFormatSupported(VK_FORMAT_R16G16B16A16_SFLOAT,
+                                           VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT,
+                                           FormatType::Optimal)} {
 
     CreateImages();
     CreateRenderPasses();
@@ -41,18 +52,23 @@ FSR::FSR(const Device& device, MemoryAllocator& memory_allocator, size_t image_c
 void FSR::CreateImages() {
     m_dynamic_images.resize(m_image_count);
     for (auto& images : m_dynamic_images) {
-        images.images[Easu] =
-            CreateWrappedImage(m_memory_allocator, m_extent, VK_FORMAT_R16G16B16A16_SFLOAT);
+        if (!m_use_fused) {
+            images.images[Easu] =
+                CreateWrappedImage(m_memory_allocator, m_extent, VK_FORMAT_R16G16B16A16_SFLOAT);
+            images.image_views[Easu] = CreateWrappedImageView(m_device, images.images[Easu],
+                                                              VK_FORMAT_R16G16B16A16_SFLOAT);
+        }
         images.images[Rcas] =
             CreateWrappedImage(m_memory_allocator, m_extent, VK_FORMAT_R16G16B16A16_SFLOAT);
-        images.image_views[Easu] =
-            CreateWrappedImageView(m_device, images.images[Easu], VK_FORMAT_R16G16B16A16_SFLOAT);
         images.image_views[Rcas] =
             CreateWrappedImageView(m_device, images.images[Rcas], VK_FORMAT_R16G16B16A16_SFLOAT);
     }
 }
 
 void FSR::CreateRenderPasses() {
+    if (m_use_fused) {
+        return;
+    }
     m_renderpass = CreateWrappedRenderPass(m_device, VK_FORMAT_R16G16B16A16_SFLOAT);
 
     for (auto& images : m_dynamic_images) {
@@ -68,6 +84,12 @@ void FSR::CreateSampler() {
 }
 
 void FSR::CreateShaders() {
+    if (m_use_fused) {
+        m_fused_shader = BuildShader(m_device, m_device.IsFloat16Supported()
+                                                   ? VULKAN_FIDELITYFX_FSR_FUSED_FP16_COMP_SPV
+                                                   : VULKAN_FIDELITYFX_FSR_FUSED_FP32_COMP_SPV);
+        return;
+    }
     m_vert_shader = BuildShader(m_device, VULKAN_FIDELITYFX_FSR_VERT_SPV);
 
     if (m_device.IsFloat16Supported()) {
@@ -80,6 +102,13 @@ void FSR::CreateShaders() {
 }
 
 void FSR::CreateDescriptorPool() {
+    if (m_use_fused) {
+        // Fused: 1 sampled and 1 storage descriptor, 1 descriptor set per invocation
+        m_descriptor_pool = CreateWrappedDescriptorPool(
+            m_device, m_image_count, m_image_count,
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE});
+        return;
+    }
     // EASU: 1 descriptor
     // RCAS: 1 descriptor
     // 2 descriptors, 2 descriptor sets per invocation
@@ -87,12 +116,19 @@ void FSR::CreateDescriptorPool() {
 }
 
 void FSR::CreateDescriptorSetLayout() {
+    if (m_use_fused) {
+        m_descriptor_set_layout = CreateWrappedDescriptorSetLayout(
+            m_device, {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE},
+            VK_SHADER_STAGE_COMPUTE_BIT);
+        return;
+    }
     m_descriptor_set_layout =
         CreateWrappedDescriptorSetLayout(m_device, {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER});
 }
 
 void FSR::CreateDescriptorSets() {
-    std::vector<VkDescriptorSetLayout> layouts(MaxFsrStage, *m_descriptor_set_layout);
+    std::vector<VkDescriptorSetLayout> layouts(m_use_fused ? 1 : MaxFsrStage,
+                                               *m_descriptor_set_layout);
 
     for (auto& images : m_dynamic_images) {
         images.descriptor_sets = CreateWrappedDescriptorSets(m_descriptor_pool, layouts);
@@ -101,9 +137,9 @@ void FSR::CreateDescriptorSets() {
 
 void FSR::CreatePipelineLayouts() {
     const VkPushConstantRange range{
-        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+        .stageFlags = m_use_fused ? VK_SHADER_STAGE_COMPUTE_BIT : VK_SHADER_STAGE_FRAGMENT_BIT,
         .offset = 0,
-        .size = sizeof(PushConstants),
+        .size = m_use_fused ? sizeof(FusedPushConstants) : sizeof(PushConstants),
     };
     VkPipelineLayoutCreateInfo ci{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
@@ -119,12 +155,36 @@ void FSR::CreatePipelineLayouts() {
 }
 
 void FSR::CreatePipelines() {
+    if (m_use_fused) {
+        CreateFusedPipeline();
+        return;
+    }
     m_easu_pipeline = CreateWrappedPipeline(m_device, m_renderpass, m_pipeline_layout,
                                             std::tie(m_vert_shader, m_easu_shader));
     m_rcas_pipeline = CreateWrappedPipeline(m_device, m_renderpass, m_pipeline_layout,
                                             std::tie(m_vert_shader, m_rcas_shader));
 }
 
+void FSR::CreateFusedPipeline() {
+    m_fused_pipeline = m_device.GetLogical().CreateComputePipeline({
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .stage{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module = *m_fused_shader,
+            .pName = "main",
+            .pSpecializationInfo = nullptr,
+        },
+        .layout = *m_pipeline_layout,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex = 0,
+    });
+}
+
 void FSR::UpdateDescriptorSets(VkImageView image_view, size_t image_index) {
     Images& images = m_dynamic_images[image_index];
     std::vector<VkDescriptorImageInfo> image_infos;
@@ -139,6 +199,22 @@ void FSR::UpdateDescriptorSets(VkImageView image_view, size_t image_index) {
     m_device.GetLogical().UpdateDescriptorSets(updates, {});
 }
 
+void FSR::UpdateFusedDescriptorSet(VkImageView image_view, size_t image_index) {
+    Images& images = m_dynamic_images[image_index];
+    std::vector<VkDescriptorImageInfo> image_infos;
+    image_infos.reserve(2);
+
+    const VkDescriptorSet set = images.descriptor_sets[0];
+    VkWriteDescriptorSet output_write =
+        CreateWriteDescriptorSet(image_infos, VK_NULL_HANDLE, *images.image_views[Rcas], set, 1);
+    output_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    const std::array updates{
+        CreateWriteDescriptorSet(image_infos, *m_sampler, image_view, set, 0),
+        output_write,
+    };
+    m_device.GetLogical().UpdateDescriptorSets(updates, {});
+}
+
 void FSR::UploadImages(Scheduler& scheduler) {
     if (m_images_ready) {
         return;
@@ -146,7 +222,9 @@ void FSR::UploadImages(Scheduler& scheduler) {
 
     scheduler.Record([&](vk::CommandBuffer cmdbuf) {
         for (auto& image : m_dynamic_images) {
-            ClearColorImage(cmdbuf, *image.images[Easu]);
+            if (image.images[Easu]) {
+                ClearColorImage(cmdbuf, *image.images[Easu]);
+            }
             ClearColorImage(cmdbuf, *image.images[Rcas]);
         }
     });
@@ -160,22 +238,10 @@ VkImageView FSR::Draw(Scheduler& scheduler, size_t image_index, VkImage source_i
                       const Common::Rectangle<f32>& crop_rect) {
     Images& images = m_dynamic_images[image_index];
 
-    VkImage easu_image = *images.images[Easu];
-    VkImage rcas_image = *images.images[Rcas];
-    VkDescriptorSet easu_descriptor_set = images.descriptor_sets[Easu];
-    VkDescriptorSet rcas_descriptor_set = images.descriptor_sets[Rcas];
-    VkFramebuffer easu_framebuffer = *images.framebuffers[Easu];
-    VkFramebuffer rcas_framebuffer = *images.framebuffers[Rcas];
-    VkPipeline easu_pipeline = *m_easu_pipeline;
-    VkPipeline rcas_pipeline = *m_rcas_pipeline;
-    VkPipelineLayout pipeline_layout = *m_pipeline_layout;
-    VkRenderPass renderpass = *m_renderpass;
-    VkExtent2D extent = m_extent;
-
     const f32 input_image_width = static_cast<f32>(input_image_extent.width);
     const f32 input_image_height = static_cast<f32>(input_image_extent.height);
-    const f32 output_image_width = static_cast<f32>(extent.width);
-    const f32 output_image_height = static_cast<f32>(extent.height);
+    const f32 output_image_width = static_cast<f32>(m_extent.width);
+    const f32 output_image_height = static_cast<f32>(m_extent.height);
     const f32 viewport_width = (crop_rect.right - crop_rect.left) * input_image_width;
     const f32 viewport_x = crop_rect.left * input_image_width;
     const f32 viewport_height = (crop_rect.bottom - crop_rect.top) * input_image_height;
@@ -193,8 +259,68 @@ VkImageView FSR::Draw(Scheduler& scheduler, size_t image_index, VkImage source_i
     FsrRcasCon(rcas_con.data(), sharpening);
 
     UploadImages(scheduler);
+
+    if (m_use_fused) {
+        FusedPushConstants fused_con{};
+        std::ranges::copy(easu_con, fused_con.begin());
+        std::copy_n(rcas_con.begin(), 4, fused_con.begin() + easu_con.size());
+        UpdateFusedDescriptorSet(source_image_view, image_index);
+
+        const VkImage output_image = *images.images[Rcas];
+        const VkDescriptorSet descriptor_set = images.descriptor_sets[0];
+        const VkPipeline pipeline = *m_fused_pipeline;
+        const VkPipelineLayout pipeline_layout = *m_pipeline_layout;
+        const u32 num_tiles_x = Common::DivCeil(m_extent.width, FUSED_TILE_SIZE);
+        const u32 num_tiles_y = Common::DivCeil(m_extent.height, FUSED_TILE_SIZE);
+
+        scheduler.RequestOutsideRenderPassOperationContext();
+        scheduler.Record([=](vk::CommandBuffer cmdbuf) {
+            TransitionImageLayout(cmdbuf, source_image, VK_IMAGE_LAYOUT_GENERAL);
+            TransitionImageLayout(cmdbuf, output_image, VK_IMAGE_LAYOUT_GENERAL);
+            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_layout, 0,
+                                      descriptor_set, {});
+            cmdbuf.PushConstants(pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, fused_con);
+            cmdbuf.Dispatch(num_tiles_x, num_tiles_y, 1);
+
+            const VkImageMemoryBarrier write_barrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = output_image,
+                .subresourceRange{
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .baseMipLevel = 0,
+                    .levelCount = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+            };
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, write_barrier);
+        });
+        return *images.image_views[Rcas];
+    }
+
     UpdateDescriptorSets(source_image_view, image_index);
 
+    VkImage easu_image = *images.images[Easu];
+    VkImage rcas_image = *images.images[Rcas];
+    VkDescriptorSet easu_descriptor_set = images.descriptor_sets[Easu];
+    VkDescriptorSet rcas_descriptor_set = images.descriptor_sets[Rcas];
+    VkFramebuffer easu_framebuffer = *images.framebuffers[Easu];
+    VkFramebuffer rcas_framebuffer = *images.framebuffers[Rcas];
+    VkPipeline easu_pipeline = *m_easu_pipeline;
+    VkPipeline rcas_pipeline = *m_rcas_pipeline;
+    VkPipelineLayout pipeline_layout = *m_pipeline_layout;
+    VkRenderPass renderpass = *m_renderpass;
+    VkExtent2D extent = m_extent;
+
     scheduler.RequestOutsideRenderPassOperationContext();
     scheduler.Record([=](vk::CommandBuffer cmdbuf) {
         TransitionImageLayout(cmdbuf, source_image, VK_IMAGE_LAYOUT_GENERAL);
@@ -30,15 +30,20 @@ private:
     void CreateDescriptorSets();
     void CreatePipelineLayouts();
     void CreatePipelines();
+    void CreateFusedPipeline();
 
     void UploadImages(Scheduler& scheduler);
     void UpdateDescriptorSets(VkImageView image_view, size_t image_index);
+    void UpdateFusedDescriptorSet(VkImageView image_view, size_t image_index);
 
     const Device& m_device;
     MemoryAllocator& m_memory_allocator;
     const size_t m_image_count;
     const VkExtent2D m_extent;
 
+    /// EASU and RCAS run in a single compute dispatch, without an intermediate image
+    const bool m_use_fused;
+
     enum FsrStage {
         Easu,
         Rcas,
@@ -53,6 +58,8 @@ private:
     vk::ShaderModule m_rcas_shader;
     vk::Pipeline m_easu_pipeline;
     vk::Pipeline m_rcas_pipeline;
+    vk::ShaderModule m_fused_shader;
+    vk::Pipeline m_fused_pipeline;
     vk::RenderPass m_renderpass;
     vk::Sampler m_sampler;
 
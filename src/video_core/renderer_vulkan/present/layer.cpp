@@ -64,11 +64,11 @@ Layer::~Layer() {
 }
 
 void Layer::ConfigureDraw(PresentPushConstants* out_push_constants,
-                          VkDescriptorSet* out_descriptor_set, RasterizerVulkan& rasterizer,
+                          VkDescriptorSet* out_descriptor_set, DisplaySource& source,
                           VkSampler sampler, size_t image_index,
                           const Tegra::FramebufferConfig& framebuffer,
                           const Layout::FramebufferLayout& layout) {
-    const auto texture_info = rasterizer.AccelerateDisplay(
+    const auto texture_info = source.AccelerateDisplay(
         framebuffer, framebuffer.address + framebuffer.offset, framebuffer.stride);
     const u32 texture_width = texture_info ? texture_info->width : framebuffer.width;
     const u32 texture_height = texture_info ? texture_info->height : framebuffer.height;
@@ -174,16 +174,19 @@ void Layer::RefreshResources(const Tegra::FramebufferConfig& framebuffer) {
 }
 
 void Layer::SetAntiAliasPass() {
-    if (anti_alias && anti_alias_setting == filters.get_anti_aliasing()) {
-        return;
-    }
-
-    anti_alias_setting = filters.get_anti_aliasing();
-
+    // The render area follows the resolution scale, which changes with dynamic resolution
     const VkExtent2D render_area{
         .width = Settings::values.resolution_info.ScaleUp(raw_width),
         .height = Settings::values.resolution_info.ScaleUp(raw_height),
     };
+    if (anti_alias && anti_alias_setting == filters.get_anti_aliasing() &&
+        anti_alias_area.width == render_area.width &&
+        anti_alias_area.height == render_area.height) {
+        return;
+    }
+
+    anti_alias_setting = filters.get_anti_aliasing();
+    anti_alias_area = render_area;
 
     switch (anti_alias_setting) {
     case Settings::AntiAliasing::Fxaa:
@@ -29,10 +29,10 @@ namespace Vulkan {
 
 class AntiAliasPass;
 class Device;
+class DisplaySource;
 class FSR;
 class MemoryAllocator;
 struct PresentPushConstants;
-class RasterizerVulkan;
 class Scheduler;
 
 class Layer final {
@@ -44,7 +44,7 @@ public:
     ~Layer();
 
     void ConfigureDraw(PresentPushConstants* out_push_constants,
-                       VkDescriptorSet* out_descriptor_set, RasterizerVulkan& rasterizer,
+                       VkDescriptorSet* out_descriptor_set, DisplaySource& source,
                        VkSampler sampler, size_t image_index,
                        const Tegra::FramebufferConfig& framebuffer,
                        const Layout::FramebufferLayout& layout);
@@ -87,6 +87,7 @@ private:
     Service::android::PixelFormat pixel_format{};
 
     Settings::AntiAliasing anti_alias_setting{};
+    VkExtent2D anti_alias_area{};
     std::unique_ptr<AntiAliasPass> anti_alias{};
 
     std::unique_ptr<FSR> fsr{};
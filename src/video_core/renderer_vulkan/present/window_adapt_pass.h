@@ -19,10 +19,10 @@ struct FramebufferConfig;
 namespace Vulkan {
 
 class Device;
+class DisplaySource;
 struct Frame;
 class Layer;
 class Scheduler;
-class RasterizerVulkan;
 
 class WindowAdaptPass final {
 public:
@@ -30,7 +30,7 @@ public:
                              vk::ShaderModule&& fragment_shader);
     ~WindowAdaptPass();
 
-    void Draw(RasterizerVulkan& rasterizer, Scheduler& scheduler, size_t image_index,
+    void Draw(DisplaySource& source, Scheduler& scheduler, size_t image_index,
               std::list<Layer>& layers, std::span<const Tegra::FramebufferConfig> configs,
               const Layout::FramebufferLayout& layout, Frame* dst);
 
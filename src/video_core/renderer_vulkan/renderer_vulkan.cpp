@@ -25,6 +25,8 @@
 #include "video_core/renderer_vulkan/present/util.h"
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
 #include "video_core/renderer_vulkan/vk_blit_screen.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
+#include "video_core/renderer_vulkan/vk_present_offload.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_state_tracker.h"
@@ -38,6 +40,10 @@
 #include "video_core/vulkan_common/vulkan_surface.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
+#ifdef ANDROID
+#include "common/android/performance_hint.h"
+#endif
+
 namespace Vulkan {
 namespace {
 
@@ -84,6 +90,16 @@ std::string BuildCommaSeparatedExtensions(
     return fmt::format("{}", fmt::join(available_extensions, ","));
 }
 
+/// Returns the time budget of a guest frame at the configured emulation speed
+std::chrono::nanoseconds FrameBudget() {
+    static constexpr std::chrono::nanoseconds BaseBudget{1'000'000'000 / 60};
+    if (!Settings::values.use_speed_limit.GetValue()) {
+        return BaseBudget;
+    }
+    const u16 speed_limit = std::max<u16>(Settings::values.speed_limit.GetValue(), 1);
+    return BaseBudget * 100 / speed_limit;
+}
+
 } // Anonymous namespace
 
 Device CreateDevice(const vk::Instance& instance, const vk::InstanceDispatch& dld,
@@ -109,23 +125,36 @@ RendererVulkan::RendererVulkan(Core::TelemetrySession& telemetry_session_,
       debug_messenger(Settings::values.renderer_debug ? CreateDebugUtilsCallback(instance)
                                                       : vk::DebugUtilsMessenger{}),
       surface(CreateSurface(instance, render_window.GetWindowInfo())),
-      device(CreateDevice(instance, dld, *surface)), memory_allocator(device), state_tracker(),
-      scheduler(device, state_tracker),
-      swapchain(*surface, device, scheduler, render_window.GetFramebufferLayout().width,
-                render_window.GetFramebufferLayout().height),
-      present_manager(instance, render_window, device, memory_allocator, scheduler, swapchain,
-                      surface),
-      blit_swapchain(device_memory, device, memory_allocator, present_manager, scheduler,
+      offload_presentation(CanOffloadPresentation(instance, dld, *surface)),
+      device(CreateDevice(instance, dld, offload_presentation ? VK_NULL_HANDLE : *surface)),
+      memory_allocator(device), state_tracker(), scheduler(device, state_tracker),
+      swapchain(offload_presentation
+                    ? nullptr
+                    : std::make_unique<Swapchain>(*surface, device, scheduler,
+                                                  render_window.GetFramebufferLayout().width,
+                                                  render_window.GetFramebufferLayout().height)),
+      present_manager(offload_presentation
+                          ? nullptr
+                          : std::make_unique<PresentManager>(instance, render_window, device,
+                                                             memory_allocator, scheduler,
+                                                             *swapchain, surface, gpu)),
+      blit_swapchain(device_memory, device, memory_allocator, present_manager.get(), scheduler,
                      PresentFiltersForDisplay),
-      blit_capture(device_memory, device, memory_allocator, present_manager, scheduler,
+      blit_capture(device_memory, device, memory_allocator, present_manager.get(), scheduler,
                    PresentFiltersForDisplay),
-      blit_applet(device_memory, device, memory_allocator, present_manager, scheduler,
+      blit_applet(device_memory, device, memory_allocator, present_manager.get(), scheduler,
                   PresentFiltersForAppletCapture),
       rasterizer(render_window, gpu, device_memory, device, memory_allocator, state_tracker,
                  scheduler),
+      present_offload(offload_presentation
+                          ? std::make_unique<PresentOffload>(instance, dld, render_window,
+                                                             surface, device_memory, gpu, device,
+                                                             scheduler)
+                          : nullptr),
       applet_frame() {
     if (Settings::values.renderer_force_max_clock.GetValue() && device.ShouldBoostClocks()) {
-        turbo_mode.emplace(instance, dld);
+        // Adaptive turbo needs the GPU time of frames, without it turbo always runs
+        turbo_mode.emplace(instance, dld, scheduler.GetGpuProfiler() != nullptr);
         scheduler.RegisterOnSubmit([this] { turbo_mode->QueueSubmitted(); });
     }
     Report();
@@ -135,6 +164,7 @@ RendererVulkan::RendererVulkan(Core::TelemetrySession& telemetry_session_,
 }
 
 RendererVulkan::~RendererVulkan() {
+    screenshot_worker.WaitForRequests();
     scheduler.RegisterOnSubmit([] {});
     void(device.GetLogical().WaitIdle());
 }
@@ -146,6 +176,13 @@ void RendererVulkan::Composite(std::span<const Tegra::FramebufferConfig> framebu
 
     SCOPE_EXIT {
         render_window.OnFrameDisplayed();
+        if (turbo_mode) {
+            const GpuProfiler* const profiler = scheduler.GetGpuProfiler();
+            turbo_mode->FrameEnd(profiler ? profiler->LastFrameNanoseconds() : 0, FrameBudget());
+        }
+#ifdef ANDROID
+        Common::Android::ReportHintFrame(FrameBudget());
+#endif
     };
 
     RenderAppletCaptureLayer(framebuffers);
@@ -155,17 +192,69 @@ void RendererVulkan::Composite(std::span<const Tegra::FramebufferConfig> framebu
     }
 
     RenderScreenshot(framebuffers);
-    Frame* frame = present_manager.GetRenderFrame();
-    blit_swapchain.DrawToFrame(rasterizer, frame, framebuffers,
-                               render_window.GetFramebufferLayout(), swapchain.GetImageCount(),
-                               swapchain.GetImageViewFormat());
-    scheduler.Flush(*frame->render_ready);
-    present_manager.Present(frame);
+    const Layout::FramebufferLayout layout = render_window.GetFramebufferLayout();
+    if (IsFrameUnchanged(framebuffers, layout)) {
+        // The swapchain still shows this frame, skip the blit and present.
+        gpu.RendererFrameEndNotify();
+        rasterizer.TickFrame();
+        return;
+    }
+    if (present_offload) {
+        present_offload->Present(rasterizer, framebuffers, layout);
+    } else {
+        Frame* frame = present_manager->GetRenderFrame();
+        blit_swapchain.DrawToFrame(rasterizer, frame, framebuffers, layout,
+                                   swapchain->GetImageCount(), swapchain->GetImageViewFormat());
+        scheduler.Flush(*frame->render_ready);
+        present_manager->Present(frame);
+    }
 
     gpu.RendererFrameEndNotify();
     rasterizer.TickFrame();
 }
 
+bool RendererVulkan::IsFrameUnchanged(std::span<const Tegra::FramebufferConfig> framebuffers,
+                                      const Layout::FramebufferLayout& layout) {
+    // Present at least this often regardless, so that changes not reflected in the framebuffer
+    // contents, like presentation settings, show up.
+    static constexpr u32 MaxSkippedFrames = 60;
+
+    if (!Settings::values.skip_unchanged_frames.GetValue()) {
+        presented_framebuffers.clear();
+        return false;
+    }
+
+    // Framebuffers written by the CPU can't be tracked, those frames are always presented.
+    bool is_tracked = true;
+    current_contents.clear();
+    for (const auto& framebuffer : framebuffers) {
+        const auto contents = rasterizer.GetFramebufferContents(
+            framebuffer, framebuffer.address + framebuffer.offset);
+        if (!contents) {
+            is_tracked = false;
+            break;
+        }
+        current_contents.push_back(*contents);
+    }
+
+    if (is_tracked && skipped_frames < MaxSkippedFrames && layout == presented_layout &&
+        std::ranges::equal(framebuffers, presented_framebuffers) &&
+        current_contents == presented_contents) {
+        ++skipped_frames;
+        return true;
+    }
+
+    skipped_frames = 0;
+    presented_layout = layout;
+    std::swap(presented_contents, current_contents);
+    if (is_tracked) {
+        presented_framebuffers.assign(framebuffers.begin(), framebuffers.end());
+    } else {
+        presented_framebuffers.clear();
+    }
+    return false;
+}
+
 void RendererVulkan::Report() const {
     using namespace Common::Literals;
     const std::string vendor_name{device.GetVendorName()};
@@ -192,9 +281,9 @@ void RendererVulkan::Report() const {
     telemetry_session.AddField(field, "GPU_Vulkan_Extensions", extensions);
 }
 
-vk::Buffer RendererVulkan::RenderToBuffer(std::span<const Tegra::FramebufferConfig> framebuffers,
-                                          const Layout::FramebufferLayout& layout, VkFormat format,
-                                          VkDeviceSize buffer_size) {
+RendererVulkan::PendingCapture RendererVulkan::RenderToBuffer(
+    std::span<const Tegra::FramebufferConfig> framebuffers, const Layout::FramebufferLayout& layout,
+    VkFormat format, VkDeviceSize buffer_size) {
     auto frame = [&]() {
         Frame f{};
         f.image =
@@ -208,32 +297,41 @@ vk::Buffer RendererVulkan::RenderToBuffer(std::span<const Tegra::FramebufferConf
     blit_capture.DrawToFrame(rasterizer, &frame, framebuffers, layout, 1, format);
 
     scheduler.RequestOutsideRenderPassOperationContext();
-    scheduler.Record([&](vk::CommandBuffer cmdbuf) {
-        DownloadColorImage(cmdbuf, *frame.image, *dst_buffer,
-                           VkExtent3D{layout.width, layout.height, 1});
+    const VkExtent3D extent{layout.width, layout.height, 1};
+    scheduler.Record([image = *frame.image, buffer = *dst_buffer, extent](vk::CommandBuffer cmdbuf) {
+        DownloadColorImage(cmdbuf, image, buffer, extent);
     });
 
-    // Ensure the copy is fully completed before saving the capture
-    scheduler.Finish();
-
-    // Copy backing image data to the capture buffer
-    dst_buffer.Invalidate();
-    return dst_buffer;
+    // Submit without waiting, the download is read back once the GPU reaches this tick
+    const u64 tick = scheduler.Flush();
+    return PendingCapture{
+        .frame = std::move(frame),
+        .buffer = std::move(dst_buffer),
+        .tick = tick,
+    };
 }
 
 void RendererVulkan::RenderScreenshot(std::span<const Tegra::FramebufferConfig> framebuffers) {
-    if (!renderer_settings.screenshot_requested) {
+    if (!renderer_settings.screenshot_requested || screenshot_in_flight) {
         return;
     }
 
     const auto& layout{renderer_settings.screenshot_framebuffer_layout};
-    const auto dst_buffer = RenderToBuffer(framebuffers, layout, VK_FORMAT_B8G8R8A8_UNORM,
-                                           layout.width * layout.height * 4);
-
-    std::memcpy(renderer_settings.screenshot_bits, dst_buffer.Mapped().data(),
-                dst_buffer.Mapped().size());
-    renderer_settings.screenshot_complete_callback(false);
-    renderer_settings.screenshot_requested = false;
+    auto capture = RenderToBuffer(framebuffers, layout, VK_FORMAT_B8G8R8A8_UNORM,
+                                  layout.width * layout.height * 4);
+
+    // Reading the capture back on the render thread would stall it until the GPU is idle
+    screenshot_in_flight = true;
+    screenshot_worker.QueueWork([this, capture = std::move(capture)]() mutable {
+        scheduler.GetMasterSemaphore().Wait(capture.tick);
+
+        capture.buffer.Invalidate();
+        std::memcpy(renderer_settings.screenshot_bits, capture.buffer.Mapped().data(),
+                    capture.buffer.Mapped().size());
+        renderer_settings.screenshot_complete_callback(false);
+        renderer_settings.screenshot_requested = false;
+        screenshot_in_flight = false;
+    });
 }
 
 std::vector<u8> RendererVulkan::GetAppletCaptureBuffer() {
@@ -3,15 +3,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "common/dynamic_library.h"
+#include "common/thread_worker.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_vulkan/vk_blit_screen.h"
 #include "video_core/renderer_vulkan/vk_present_manager.h"
+#include "video_core/renderer_vulkan/vk_present_offload.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_state_tracker.h"
@@ -61,11 +65,20 @@ public:
 private:
     void Report() const;
 
-    vk::Buffer RenderToBuffer(std::span<const Tegra::FramebufferConfig> framebuffers,
-                              const Layout::FramebufferLayout& layout, VkFormat format,
-                              VkDeviceSize buffer_size);
+    /// Capture rendered into a download buffer, valid once the GPU reaches the tick
+    struct PendingCapture {
+        Frame frame;
+        vk::Buffer buffer;
+        u64 tick;
+    };
+
+    PendingCapture RenderToBuffer(std::span<const Tegra::FramebufferConfig> framebuffers,
+                                  const Layout::FramebufferLayout& layout, VkFormat format,
+                                  VkDeviceSize buffer_size);
     void RenderScreenshot(std::span<const Tegra::FramebufferConfig> framebuffers);
     void RenderAppletCaptureLayer(std::span<const Tegra::FramebufferConfig> framebuffers);
+    bool IsFrameUnchanged(std::span<const Tegra::FramebufferConfig> framebuffers,
+                          const Layout::FramebufferLayout& layout);
 
     Core::TelemetrySession& telemetry_session;
     Tegra::MaxwellDeviceMemoryManager& device_memory;
@@ -78,19 +91,34 @@ private:
     vk::DebugUtilsMessenger debug_messenger;
     vk::SurfaceKHR surface;
 
+    /// Frames are presented by a second device, the render device has no swapchain
+    bool offload_presentation;
+
     Device device;
     MemoryAllocator memory_allocator;
     StateTracker state_tracker;
     Scheduler scheduler;
-    Swapchain swapchain;
-    PresentManager present_manager;
+    std::unique_ptr<Swapchain> swapchain;
+    std::unique_ptr<PresentManager> present_manager;
     BlitScreen blit_swapchain;
     BlitScreen blit_capture;
     BlitScreen blit_applet;
     RasterizerVulkan rasterizer;
+    std::unique_ptr<PresentOffload> present_offload;
     std::optional<TurboMode> turbo_mode;
 
     Frame applet_frame;
+
+    /// Last presented frame, to skip presenting frames identical to it
+    std::vector<Tegra::FramebufferConfig> presented_framebuffers;
+    std::vector<FramebufferContents> presented_contents;
+    std::vector<FramebufferContents> current_contents;
+    Layout::FramebufferLayout presented_layout;
+    u32 skipped_frames{};
+
+    /// Waits for screenshot downloads off the render thread, destroyed before the objects it uses
+    std::atomic<bool> screenshot_in_flight{};
+    Common::ThreadWorker screenshot_worker{1, "VkScreenshot"};
 };
 
 } // namespace Vulkan
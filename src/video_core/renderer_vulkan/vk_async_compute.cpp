@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "video_core/renderer_vulkan/vk_async_compute.h"
+#include "video_core/renderer_vulkan/vk_command_pool.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+AsyncComputeQueue::AsyncComputeQueue(const Device& device_, MasterSemaphore& master_semaphore)
+    : device{device_} {
+    // Command buffers are tracked with graphics ticks, the graphics submission following an async
+    // compute submission waits on it
+    command_pool = std::make_unique<CommandPool>(master_semaphore, device,
+                                                 VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                                                 device.GetComputeFamily());
+    static constexpr VkSemaphoreTypeCreateInfo semaphore_type_ci{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .pNext = nullptr,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = 0,
+    };
+    static constexpr VkSemaphoreCreateInfo semaphore_ci{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &semaphore_type_ci,
+        .flags = 0,
+    };
+    semaphore = device.GetLogical().CreateSemaphore(semaphore_ci);
+}
+
+AsyncComputeQueue::~AsyncComputeQueue() = default;
+
+vk::CommandBuffer AsyncComputeQueue::CommandBuffer() {
+    if (!is_recording) {
+        cmdbuf = vk::CommandBuffer(command_pool->Commit(), device.GetDispatchLoader());
+        cmdbuf.Begin({
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pNext = nullptr,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            .pInheritanceInfo = nullptr,
+        });
+        is_recording = true;
+    }
+    return cmdbuf;
+}
+
+u64 AsyncComputeQueue::Submit() {
+    if (!is_recording) {
+        return 0;
+    }
+    cmdbuf.End();
+    is_recording = false;
+
+    const u64 signal_value = ++tick;
+    const VkSemaphore signal_semaphore = *semaphore;
+    const VkCommandBuffer vk_cmdbuf = *cmdbuf;
+    const VkTimelineSemaphoreSubmitInfo timeline_si{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .pNext = nullptr,
+        .waitSemaphoreValueCount = 0,
+        .pWaitSemaphoreValues = nullptr,
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &signal_value,
+    };
+    const VkSubmitInfo submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext = &timeline_si,
+        .waitSemaphoreCount = 0,
+        .pWaitSemaphores = nullptr,
+        .pWaitDstStageMask = nullptr,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &vk_cmdbuf,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &signal_semaphore,
+    };
+    switch (const VkResult result = device.GetComputeQueue().Submit(submit_info)) {
+    case VK_SUCCESS:
+        break;
+    case VK_ERROR_DEVICE_LOST:
+        device.ReportLoss();
+        [[fallthrough]];
+    default:
+        vk::Check(result);
+        break;
+    }
+    return signal_value;
+}
+
+} // namespace Vulkan
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class CommandPool;
+class Device;
+class MasterSemaphore;
+
+/**
+ * Records and submits compute work to a queue family without graphics support, so it can overlap
+ * with rendering on the graphics queue. Submissions signal a timeline semaphore graphics
+ * submissions wait on. Owned by the scheduler and only used from its worker thread.
+ */
+class AsyncComputeQueue {
+public:
+    explicit AsyncComputeQueue(const Device& device, MasterSemaphore& master_semaphore);
+    ~AsyncComputeQueue();
+
+    AsyncComputeQueue& operator=(const AsyncComputeQueue&) = delete;
+    AsyncComputeQueue(const AsyncComputeQueue&) = delete;
+
+    /// Returns the command buffer to record async compute commands to, beginning it when needed
+    vk::CommandBuffer CommandBuffer();
+
+    /// Submits the recorded commands, returns the value signaled on the timeline semaphore or
+    /// zero when nothing was recorded
+    u64 Submit();
+
+    /// Returns the timeline semaphore signaled by submissions
+    [[nodiscard]] VkSemaphore Semaphore() const noexcept {
+        return *semaphore;
+    }
+
+private:
+    const Device& device;
+    std::unique_ptr<CommandPool> command_pool;
+    vk::Semaphore semaphore;
+    vk::CommandBuffer cmdbuf;
+    bool is_recording = false;
+    u64 tick = 0;
+};
+
+} // namespace Vulkan
@@ -6,13 +6,14 @@
 #include "video_core/renderer_vulkan/present/filters.h"
 #include "video_core/renderer_vulkan/present/layer.h"
 #include "video_core/renderer_vulkan/vk_blit_screen.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
 #include "video_core/renderer_vulkan/vk_present_manager.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 
 namespace Vulkan {
 
 BlitScreen::BlitScreen(Tegra::MaxwellDeviceMemoryManager& device_memory_, const Device& device_,
-                       MemoryAllocator& memory_allocator_, PresentManager& present_manager_,
+                       MemoryAllocator& memory_allocator_, PresentManager* present_manager_,
                        Scheduler& scheduler_, const PresentFilters& filters_)
     : device_memory{device_memory_}, device{device_}, memory_allocator{memory_allocator_},
       present_manager{present_manager_}, scheduler{scheduler_}, filters{filters_}, image_count{1},
@@ -21,7 +22,9 @@ BlitScreen::BlitScreen(Tegra::MaxwellDeviceMemoryManager& device_memory_, const
 BlitScreen::~BlitScreen() = default;
 
 void BlitScreen::WaitIdle() {
-    present_manager.WaitPresent();
+    if (present_manager) {
+        present_manager->WaitPresent();
+    }
     scheduler.Finish();
     device.GetLogical().WaitIdle();
 }
@@ -51,7 +54,7 @@ void BlitScreen::SetWindowAdaptPass() {
     }
 }
 
-void BlitScreen::DrawToFrame(RasterizerVulkan& rasterizer, Frame* frame,
+void BlitScreen::DrawToFrame(DisplaySource& source, Frame* frame,
                              std::span<const Tegra::FramebufferConfig> framebuffers,
                              const Layout::FramebufferLayout& layout,
                              size_t current_swapchain_image_count,
@@ -89,9 +92,14 @@ void BlitScreen::DrawToFrame(RasterizerVulkan& rasterizer, Frame* frame,
         SetWindowAdaptPass();
 
         // Update frame format if needed
-        if (presentation_recreate_required) {
-            present_manager.RecreateFrame(frame, layout.width, layout.height, swapchain_view_format,
-                                          window_adapt->GetRenderPass());
+        if (presentation_recreate_required && present_manager) {
+            present_manager->RecreateFrame(frame, layout.width, layout.height,
+                                           swapchain_view_format, window_adapt->GetRenderPass());
+        } else if (presentation_recreate_required) {
+            // Frames that are not presented from this device are only ever read back
+            CreateFrameImage(device, memory_allocator, frame, layout.width, layout.height,
+                             swapchain_view_format, swapchain_view_format,
+                             window_adapt->GetRenderPass());
         }
     }
 
@@ -107,7 +115,8 @@ void BlitScreen::DrawToFrame(RasterizerVulkan& rasterizer, Frame* frame,
     }
 
     // Perform the draw
-    window_adapt->Draw(rasterizer, scheduler, image_index, layers, framebuffers, layout, frame);
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::Present};
+    window_adapt->Draw(source, scheduler, image_index, layers, framebuffers, layout, frame);
 
     // Advance to next image
     if (++image_index >= image_count) {
@@ -5,10 +5,12 @@
 
 #include <list>
 #include <memory>
+#include <optional>
 
 #include "core/frontend/framebuffer_layout.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/renderer_vulkan/present/layer.h"
+#include "video_core/surface.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -29,7 +31,6 @@ enum class ScalingFilter : u32;
 namespace Vulkan {
 
 class Device;
-class RasterizerVulkan;
 class Scheduler;
 class PresentManager;
 class WindowAdaptPass;
@@ -43,16 +44,35 @@ struct FramebufferTextureInfo {
     u32 height{};
     u32 scaled_width{};
     u32 scaled_height{};
+    VideoCore::Surface::PixelFormat pixel_format{};
+};
+
+/// Identifies the contents of a GPU rendered framebuffer, changes whenever it is drawn to
+struct FramebufferContents {
+    VkImageView image_view{};
+    u64 modification_tick{};
+
+    bool operator==(const FramebufferContents&) const = default;
+};
+
+/// Provides the host images holding guest framebuffers to the presentation passes
+class DisplaySource {
+public:
+    virtual ~DisplaySource() = default;
+
+    /// Returns the image holding a framebuffer, or nullopt when it has to be read from memory
+    virtual std::optional<FramebufferTextureInfo> AccelerateDisplay(
+        const Tegra::FramebufferConfig& config, VAddr framebuffer_addr, u32 pixel_stride) = 0;
 };
 
 class BlitScreen {
 public:
     explicit BlitScreen(Tegra::MaxwellDeviceMemoryManager& device_memory, const Device& device,
-                        MemoryAllocator& memory_allocator, PresentManager& present_manager,
+                        MemoryAllocator& memory_allocator, PresentManager* present_manager,
                         Scheduler& scheduler, const PresentFilters& filters);
     ~BlitScreen();
 
-    void DrawToFrame(RasterizerVulkan& rasterizer, Frame* frame,
+    void DrawToFrame(DisplaySource& source, Frame* frame,
                      std::span<const Tegra::FramebufferConfig> framebuffers,
                      const Layout::FramebufferLayout& layout, size_t current_swapchain_image_count,
                      VkFormat current_swapchain_view_format);
@@ -70,7 +90,7 @@ private:
     Tegra::MaxwellDeviceMemoryManager& device_memory;
     const Device& device;
     MemoryAllocator& memory_allocator;
-    PresentManager& present_manager;
+    PresentManager* present_manager;
     Scheduler& scheduler;
     const PresentFilters& filters;
     std::size_t image_count{};
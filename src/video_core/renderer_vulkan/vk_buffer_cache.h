@@ -8,6 +8,7 @@
 #include "video_core/buffer_cache/usage_tracker.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
+#include "video_core/renderer_vulkan/vk_host_memory_importer.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/surface.h"
@@ -30,6 +31,9 @@ public:
 
     [[nodiscard]] VkBufferView View(u32 offset, u32 size, VideoCore::Surface::PixelFormat format);
 
+    [[nodiscard]] DescriptorTexelBuffer TexelBuffer(u32 offset, u32 size,
+                                                    VideoCore::Surface::PixelFormat format) const;
+
     [[nodiscard]] VkBuffer Handle() const noexcept {
         return *buffer;
     }
@@ -99,6 +103,15 @@ public:
 
     bool CanReorderUpload(const Buffer& buffer, std::span<const VideoCommon::BufferCopy> copies);
 
+    [[nodiscard]] bool CanImportHostMemory() const noexcept {
+        return host_memory_importer.IsSupported();
+    }
+
+    [[nodiscard]] std::optional<HostMemoryImport> ImportHostMemory(const u8* pointer,
+                                                                   size_t size) {
+        return host_memory_importer.Import(pointer, size);
+    }
+
     void FreeDeferredStagingBuffer(StagingBufferRef& ref);
 
     void PreCopyBarrier();
@@ -111,6 +124,10 @@ public:
 
     void ClearBuffer(VkBuffer dest_buffer, u32 offset, size_t size, u32 value);
 
+    void CopyBlockLinear(VkBuffer pitch_buffer, u32 pitch_offset, VkBuffer block_linear_buffer,
+                         u32 block_linear_offset, const Tegra::DMA::BlockLinearCopy& copy,
+                         bool to_block_linear);
+
     void BindIndexBuffer(PrimitiveTopology topology, IndexFormat index_format, u32 num_indices,
                          u32 base_vertex, VkBuffer buffer, u32 offset, u32 size);
 
@@ -126,7 +143,8 @@ public:
 
     std::span<u8> BindMappedUniformBuffer([[maybe_unused]] size_t stage,
                                           [[maybe_unused]] u32 binding_index, u32 size) {
-        const StagingBufferRef ref = staging_pool.Request(size, MemoryUsage::Upload);
+        const StagingBufferRef ref =
+            staging_pool.RequestStream(size, device.GetUniformBufferAlignment());
         BindBuffer(ref.buffer, static_cast<u32>(ref.offset), size);
         return ref.mapped_span;
     }
@@ -142,7 +160,11 @@ public:
 
     void BindTextureBuffer(Buffer& buffer, u32 offset, u32 size,
                            VideoCore::Surface::PixelFormat format) {
-        guest_descriptor_queue.AddTexelBuffer(buffer.View(offset, size, format));
+        if (device.IsExtDescriptorBufferSupported()) {
+            guest_descriptor_queue.AddTexelBuffer(buffer.TexelBuffer(offset, size, format));
+        } else {
+            guest_descriptor_queue.AddTexelBuffer(buffer.View(offset, size, format));
+        }
     }
 
 private:
@@ -158,6 +180,7 @@ private:
     Scheduler& scheduler;
     StagingBufferPool& staging_pool;
     GuestDescriptorQueue& guest_descriptor_queue;
+    HostMemoryImporter host_memory_importer;
 
     std::shared_ptr<QuadArrayIndexBuffer> quad_array_index_buffer;
     std::shared_ptr<QuadStripIndexBuffer> quad_strip_index_buffer;
@@ -166,6 +189,7 @@ private:
 
     std::unique_ptr<Uint8Pass> uint8_pass;
     QuadIndexedPass quad_index_pass;
+    BlockLinearCopyPass block_linear_copy_pass;
 };
 
 struct BufferCacheParams {
@@ -182,6 +206,8 @@ struct BufferCacheParams {
     static constexpr bool USE_MEMORY_MAPS = true;
     static constexpr bool SEPARATE_IMAGE_BUFFER_BINDINGS = false;
     static constexpr bool USE_MEMORY_MAPS_FOR_UPLOADS = true;
+    static constexpr bool CAN_IMPORT_HOST_MEMORY = true;
+    static constexpr bool HAS_BLOCK_LINEAR_COPY = true;
 };
 
 using BufferCache = VideoCommon::BufferCache<BufferCacheParams>;
@@ -16,8 +16,10 @@ struct CommandPool::Pool {
     vk::CommandBuffers cmdbufs;
 };
 
-CommandPool::CommandPool(MasterSemaphore& master_semaphore_, const Device& device_)
-    : ResourcePool(master_semaphore_, COMMAND_BUFFER_POOL_SIZE), device{device_} {}
+CommandPool::CommandPool(MasterSemaphore& master_semaphore_, const Device& device_,
+                         VkCommandBufferLevel level_, std::optional<u32> queue_family_)
+    : ResourcePool(master_semaphore_, COMMAND_BUFFER_POOL_SIZE), device{device_}, level{level_},
+      queue_family{queue_family_.value_or(device.GetGraphicsFamily())} {}
 
 CommandPool::~CommandPool() = default;
 
@@ -30,9 +32,9 @@ void CommandPool::Allocate(size_t begin, size_t end) {
         .pNext = nullptr,
         .flags =
             VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
-        .queueFamilyIndex = device.GetGraphicsFamily(),
+        .queueFamilyIndex = queue_family,
     });
-    pool.cmdbufs = pool.handle.Allocate(COMMAND_BUFFER_POOL_SIZE);
+    pool.cmdbufs = pool.handle.Allocate(COMMAND_BUFFER_POOL_SIZE, level);
 }
 
 VkCommandBuffer CommandPool::Commit() {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
 #include <vector>
 
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
@@ -16,7 +17,9 @@ class MasterSemaphore;
 
 class CommandPool final : public ResourcePool {
 public:
-    explicit CommandPool(MasterSemaphore& master_semaphore_, const Device& device_);
+    explicit CommandPool(MasterSemaphore& master_semaphore_, const Device& device_,
+                         VkCommandBufferLevel level_ = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                         std::optional<u32> queue_family_ = std::nullopt);
     ~CommandPool() override;
 
     void Allocate(size_t begin, size_t end) override;
@@ -27,6 +30,8 @@ private:
     struct Pool;
 
     const Device& device;
+    VkCommandBufferLevel level;
+    u32 queue_family;
     std::vector<Pool> pools;
 };
 
@@ -1,32 +1,40 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <utility>
+#include <boost/container/small_vector.hpp>
 
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "common/vector_math.h"
 #include "video_core/host_shaders/astc_decoder_comp_spv.h"
+#include "video_core/host_shaders/bc_decoder_comp_spv.h"
 #include "video_core/host_shaders/convert_msaa_to_non_msaa_comp_spv.h"
 #include "video_core/host_shaders/convert_non_msaa_to_msaa_comp_spv.h"
 #include "video_core/host_shaders/queries_prefix_scan_sum_comp_spv.h"
 #include "video_core/host_shaders/queries_prefix_scan_sum_nosubgroups_comp_spv.h"
 #include "video_core/host_shaders/resolve_conditional_render_comp_spv.h"
+#include "video_core/host_shaders/vulkan_block_linear_copy_comp_spv.h"
 #include "video_core/host_shaders/vulkan_quad_indexed_comp_spv.h"
+#include "video_core/host_shaders/vulkan_transform_feedback_draw_comp_spv.h"
 #include "video_core/host_shaders/vulkan_uint8_comp_spv.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/texture_cache/accelerated_swizzle.h"
+#include "video_core/texture_cache/decode_bc.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/decoders.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -218,6 +226,68 @@ struct AstcPushConstants {
     u32 block_height_mask;
 };
 
+struct BcnPushConstants {
+    u32 format;
+    u32 is_signed;
+    u32 blocks_x;
+    u32 blocks_y;
+    u32 bytes_per_block_log2;
+    u32 layer_stride;
+    u32 block_size;
+    u32 x_shift;
+    u32 block_height;
+    u32 block_height_mask;
+};
+
+/// Returns the format index used by bc_decoder.comp
+u32 BcnDecoderFormat(VideoCore::Surface::PixelFormat format) {
+    using VideoCore::Surface::PixelFormat;
+    switch (format) {
+    case PixelFormat::BC1_RGBA_UNORM:
+    case PixelFormat::BC1_RGBA_SRGB:
+        return 1;
+    case PixelFormat::BC2_UNORM:
+    case PixelFormat::BC2_SRGB:
+        return 2;
+    case PixelFormat::BC3_UNORM:
+    case PixelFormat::BC3_SRGB:
+        return 3;
+    case PixelFormat::BC4_UNORM:
+    case PixelFormat::BC4_SNORM:
+        return 4;
+    case PixelFormat::BC5_UNORM:
+    case PixelFormat::BC5_SNORM:
+        return 5;
+    case PixelFormat::BC6H_UFLOAT:
+    case PixelFormat::BC6H_SFLOAT:
+        return 6;
+    case PixelFormat::BC7_UNORM:
+    case PixelFormat::BC7_SRGB:
+        return 7;
+    default:
+        ASSERT_MSG(false, "Invalid BCn format {}", format);
+        return 0;
+    }
+}
+
+bool IsSignedBcn(VideoCore::Surface::PixelFormat format) {
+    using VideoCore::Surface::PixelFormat;
+    return format == PixelFormat::BC4_SNORM || format == PixelFormat::BC5_SNORM ||
+           format == PixelFormat::BC6H_SFLOAT;
+}
+
+struct BlockLinearCopyPushConstants {
+    std::array<u32, 2> origin;
+    std::array<u32, 2> extent;
+    u32 pitch;
+    u32 pitch_offset;
+    u32 block_linear_offset;
+    u32 block_size;
+    u32 x_shift;
+    u32 block_height;
+    u32 to_block_linear;
+};
+
 struct QueriesPrefixScanPushConstants {
     u32 min_accumulation_base;
     u32 max_accumulation_base;
@@ -324,6 +394,7 @@ std::pair<VkBuffer, VkDeviceSize> Uint8Pass::Assemble(u32 num_vertices, VkBuffer
     const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
 
     scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
     scheduler.Record([this, descriptor_data, num_vertices](vk::CommandBuffer cmdbuf) {
         static constexpr u32 DISPATCH_SIZE = 1024;
         static constexpr VkMemoryBarrier WRITE_BARRIER{
@@ -382,6 +453,7 @@ std::pair<VkBuffer, VkDeviceSize> QuadIndexedPass::Assemble(
     const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
 
     scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
     scheduler.Record([this, descriptor_data, num_tri_vertices, base_vertex, index_shift,
                       is_strip](vk::CommandBuffer cmdbuf) {
         static constexpr u32 DISPATCH_SIZE = 1024;
@@ -405,6 +477,157 @@ std::pair<VkBuffer, VkDeviceSize> QuadIndexedPass::Assemble(
     return {staging.buffer, staging.offset};
 }
 
+TransformFeedbackDrawPass::TransformFeedbackDrawPass(
+    const Device& device_, Scheduler& scheduler_, DescriptorPool& descriptor_pool_,
+    StagingBufferPool& staging_buffer_pool_,
+    ComputePassDescriptorQueue& compute_pass_descriptor_queue_)
+    : ComputePass(device_, descriptor_pool_, INPUT_OUTPUT_DESCRIPTOR_SET_BINDINGS,
+                  INPUT_OUTPUT_DESCRIPTOR_UPDATE_TEMPLATE, INPUT_OUTPUT_BANK_INFO,
+                  COMPUTE_PUSH_CONSTANT_RANGE<sizeof(u32) * 4>,
+                  VULKAN_TRANSFORM_FEEDBACK_DRAW_COMP_SPV),
+      scheduler{scheduler_}, staging_buffer_pool{staging_buffer_pool_},
+      compute_pass_descriptor_queue{compute_pass_descriptor_queue_} {}
+
+TransformFeedbackDrawPass::~TransformFeedbackDrawPass() = default;
+
+std::pair<VkBuffer, VkDeviceSize> TransformFeedbackDrawPass::Assemble(
+    VkBuffer counter_buffer, u32 counter_offset, u32 stride, u32 max_vertices,
+    Tegra::Engines::Maxwell3D::Regs::PrimitiveTopology topology) {
+    using PrimitiveTopology = Tegra::Engines::Maxwell3D::Regs::PrimitiveTopology;
+    const u32 mode = [topology] {
+        switch (topology) {
+        case PrimitiveTopology::Quads:
+            return 1U;
+        case PrimitiveTopology::QuadStrip:
+            return 2U;
+        default:
+            return 0U;
+        }
+    }();
+    // The counter is bound at an aligned offset, the shader indexes from there in words
+    const u32 alignment = static_cast<u32>(device.GetStorageBufferAlignment());
+    const u32 counter_base = Common::AlignDown(counter_offset, alignment);
+    const u32 counter_word = (counter_offset - counter_base) / static_cast<u32>(sizeof(u32));
+
+    const size_t command_size = sizeof(VkDrawIndexedIndirectCommand);
+    const auto staging = staging_buffer_pool.Request(command_size, MemoryUsage::DeviceLocal);
+
+    compute_pass_descriptor_queue.Acquire();
+    compute_pass_descriptor_queue.AddBuffer(counter_buffer, counter_base,
+                                            counter_offset - counter_base + sizeof(u32));
+    compute_pass_descriptor_queue.AddBuffer(staging.buffer, staging.offset, command_size);
+    const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+
+    scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
+    scheduler.Record([this, descriptor_data, counter_word, stride, max_vertices,
+                      mode](vk::CommandBuffer cmdbuf) {
+        static constexpr VkMemoryBarrier READ_BARRIER{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+        };
+        static constexpr VkMemoryBarrier WRITE_BARRIER{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        };
+        const std::array<u32, 4> push_constants{counter_word, stride, max_vertices, mode};
+        const VkDescriptorSet set = descriptor_allocator.Commit();
+        device.GetLogical().UpdateDescriptorSet(set, *descriptor_template, descriptor_data);
+
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, READ_BARRIER);
+        cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline);
+        cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, *layout, 0, set, {});
+        cmdbuf.PushConstants(*layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants),
+                             &push_constants);
+        cmdbuf.Dispatch(1, 1, 1);
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                               VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, WRITE_BARRIER);
+    });
+    return {staging.buffer, staging.offset};
+}
+
+BlockLinearCopyPass::BlockLinearCopyPass(const Device& device_, Scheduler& scheduler_,
+                                         DescriptorPool& descriptor_pool_,
+                                         ComputePassDescriptorQueue& compute_pass_descriptor_queue_)
+    : ComputePass(device_, descriptor_pool_, INPUT_OUTPUT_DESCRIPTOR_SET_BINDINGS,
+                  INPUT_OUTPUT_DESCRIPTOR_UPDATE_TEMPLATE, INPUT_OUTPUT_BANK_INFO,
+                  COMPUTE_PUSH_CONSTANT_RANGE<sizeof(BlockLinearCopyPushConstants)>,
+                  VULKAN_BLOCK_LINEAR_COPY_COMP_SPV),
+      scheduler{scheduler_}, compute_pass_descriptor_queue{compute_pass_descriptor_queue_} {}
+
+BlockLinearCopyPass::~BlockLinearCopyPass() = default;
+
+void BlockLinearCopyPass::Copy(VkBuffer pitch_buffer, u32 pitch_offset,
+                               VkBuffer block_linear_buffer, u32 block_linear_offset,
+                               const Tegra::DMA::BlockLinearCopy& copy, bool to_block_linear) {
+    using namespace Tegra::Texture;
+    static constexpr u32 DISPATCH_SIZE_X = 32;
+    static constexpr u32 DISPATCH_SIZE_Y = 8;
+
+    // Storage buffers are bound at an aligned offset, the shader indexes from there in words
+    const u32 alignment = static_cast<u32>(device.GetStorageBufferAlignment());
+    const u32 pitch_base = Common::AlignDown(pitch_offset, alignment);
+    const u32 block_linear_base = Common::AlignDown(block_linear_offset, alignment);
+    compute_pass_descriptor_queue.Acquire();
+    compute_pass_descriptor_queue.AddBuffer(pitch_buffer, pitch_base,
+                                            pitch_offset - pitch_base + copy.pitch_size);
+    compute_pass_descriptor_queue.AddBuffer(
+        block_linear_buffer, block_linear_base,
+        block_linear_offset - block_linear_base + copy.block_linear_size);
+    const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+
+    const u32 stride = Common::AlignUpLog2(copy.width * copy.bytes_per_pixel, GOB_SIZE_X_SHIFT);
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 x_shift = GOB_SIZE_SHIFT + copy.block_height + copy.block_depth;
+    const u32 num_words = copy.extent_x * copy.bytes_per_pixel / sizeof(u32);
+    const u32 num_lines = std::min(copy.extent_y, copy.height - copy.origin_y);
+    const BlockLinearCopyPushConstants uniforms{
+        .origin{copy.origin_x * copy.bytes_per_pixel, copy.origin_y},
+        .extent{num_words, num_lines},
+        .pitch = copy.pitch,
+        .pitch_offset = (pitch_offset - pitch_base) / static_cast<u32>(sizeof(u32)),
+        .block_linear_offset =
+            (block_linear_offset - block_linear_base) / static_cast<u32>(sizeof(u32)),
+        .block_size = gobs_in_x << x_shift,
+        .x_shift = x_shift,
+        .block_height = copy.block_height,
+        .to_block_linear = to_block_linear ? 1U : 0U,
+    };
+    scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
+    scheduler.Record([this, descriptor_data, uniforms](vk::CommandBuffer cmdbuf) {
+        static constexpr VkMemoryBarrier read_barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        };
+        static constexpr VkMemoryBarrier write_barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+        };
+        const VkDescriptorSet set = descriptor_allocator.Commit();
+        device.GetLogical().UpdateDescriptorSet(set, *descriptor_template, descriptor_data);
+
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, read_barrier);
+        cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline);
+        cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, *layout, 0, set, {});
+        cmdbuf.PushConstants(*layout, VK_SHADER_STAGE_COMPUTE_BIT, uniforms);
+        cmdbuf.Dispatch(Common::DivCeil(uniforms.extent[0], DISPATCH_SIZE_X),
+                        Common::DivCeil(uniforms.extent[1], DISPATCH_SIZE_Y), 1);
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, write_barrier);
+    });
+}
+
 ConditionalRenderingResolvePass::ConditionalRenderingResolvePass(
     const Device& device_, Scheduler& scheduler_, DescriptorPool& descriptor_pool_,
     ComputePassDescriptorQueue& compute_pass_descriptor_queue_)
@@ -423,6 +646,7 @@ void ConditionalRenderingResolvePass::Resolve(VkBuffer dst_buffer, VkBuffer src_
     const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
 
     scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
     scheduler.Record([this, descriptor_data](vk::CommandBuffer cmdbuf) {
         static constexpr VkMemoryBarrier read_barrier{
             .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
@@ -467,6 +691,7 @@ QueriesPrefixScanPass::QueriesPrefixScanPass(
 void QueriesPrefixScanPass::Run(VkBuffer accumulation_buffer, VkBuffer dst_buffer,
                                 VkBuffer src_buffer, size_t number_of_sums,
                                 size_t min_accumulation_limit, size_t max_accumulation_limit) {
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
     size_t current_runs = number_of_sums;
     size_t offset = 0;
     while (current_runs != 0) {
@@ -548,8 +773,21 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
     const VkImageAspectFlags aspect_mask = image.AspectMask();
     const VkImage vk_image = image.Handle();
     const bool is_initialized = image.ExchangeInitialization();
-    scheduler.Record([vk_pipeline, vk_image, aspect_mask,
-                      is_initialized](vk::CommandBuffer cmdbuf) {
+    // Images decoded for the first time have no contents to transfer to the async compute queue
+    const bool is_async = scheduler.HasAsyncCompute() && !is_initialized;
+    // Timestamps are written on the graphics queue, so only passes recorded there are timed
+    std::optional<GpuTimeScope> gpu_time;
+    if (!is_async) {
+        gpu_time.emplace(scheduler, GpuTimeCategory::ComputePass);
+    }
+    const auto record = [this, is_async](auto&& command) {
+        if (is_async) {
+            scheduler.RecordAsyncCompute(std::move(command));
+        } else {
+            scheduler.Record(std::move(command));
+        }
+    };
+    record([vk_pipeline, vk_image, aspect_mask, is_initialized](vk::CommandBuffer cmdbuf) {
         const VkImageMemoryBarrier image_barrier{
             .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
             .pNext = nullptr,
@@ -591,8 +829,8 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
         ASSERT(params.origin == (std::array<u32, 3>{0, 0, 0}));
         ASSERT(params.destination == (std::array<s32, 3>{0, 0, 0}));
         ASSERT(params.bytes_per_block_log2 == 4);
-        scheduler.Record([this, num_dispatches_x, num_dispatches_y, num_dispatches_z, block_dims,
-                          params, descriptor_data](vk::CommandBuffer cmdbuf) {
+        record([this, num_dispatches_x, num_dispatches_y, num_dispatches_z, block_dims, params,
+                descriptor_data](vk::CommandBuffer cmdbuf) {
             const AstcPushConstants uniforms{
                 .blocks_dims = block_dims,
                 .layer_stride = params.layer_stride,
@@ -608,16 +846,18 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
             cmdbuf.Dispatch(num_dispatches_x, num_dispatches_y, num_dispatches_z);
         });
     }
-    scheduler.Record([vk_image, aspect_mask](vk::CommandBuffer cmdbuf) {
-        const VkImageMemoryBarrier image_barrier{
+    const auto make_barrier = [vk_image, aspect_mask](VkAccessFlags src_access,
+                                                      VkAccessFlags dst_access, u32 src_family,
+                                                      u32 dst_family) {
+        return VkImageMemoryBarrier{
             .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
             .pNext = nullptr,
-            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
-            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            .srcAccessMask = src_access,
+            .dstAccessMask = dst_access,
             .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
             .newLayout = VK_IMAGE_LAYOUT_GENERAL,
-            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .srcQueueFamilyIndex = src_family,
+            .dstQueueFamilyIndex = dst_family,
             .image = vk_image,
             .subresourceRange{
                 .aspectMask = aspect_mask,
@@ -627,10 +867,140 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
                 .layerCount = VK_REMAINING_ARRAY_LAYERS,
             },
         };
+    };
+    static constexpr VkAccessFlags READ_WRITE =
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    if (!is_async) {
+        const VkImageMemoryBarrier image_barrier{make_barrier(
+            VK_ACCESS_SHADER_WRITE_BIT, READ_WRITE, VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED)};
+        scheduler.Record([image_barrier](vk::CommandBuffer cmdbuf) {
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, image_barrier);
+        });
+        scheduler.Finish();
+        return;
+    }
+    // Transfer the image to the graphics queue, it is acquired once the decode has been waited on.
+    // Staging buffers are only written by the host, so they are not transferred.
+    const u32 compute_family = device.GetComputeFamily();
+    const u32 graphics_family = device.GetGraphicsFamily();
+    const VkImageMemoryBarrier release_barrier{
+        make_barrier(VK_ACCESS_SHADER_WRITE_BIT, 0, compute_family, graphics_family)};
+    const VkImageMemoryBarrier acquire_barrier{
+        make_barrier(0, READ_WRITE, compute_family, graphics_family)};
+    scheduler.RecordAsyncCompute([release_barrier](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, release_barrier);
+    });
+    scheduler.Record([acquire_barrier](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, acquire_barrier);
+    });
+}
+
+BCnDecoderPass::BCnDecoderPass(const Device& device_, Scheduler& scheduler_,
+                               DescriptorPool& descriptor_pool_,
+                               StagingBufferPool& staging_buffer_pool_,
+                               ComputePassDescriptorQueue& compute_pass_descriptor_queue_)
+    : ComputePass(device_, descriptor_pool_, INPUT_OUTPUT_DESCRIPTOR_SET_BINDINGS,
+                  INPUT_OUTPUT_DESCRIPTOR_UPDATE_TEMPLATE, INPUT_OUTPUT_BANK_INFO,
+                  COMPUTE_PUSH_CONSTANT_RANGE<sizeof(BcnPushConstants)>, BC_DECODER_COMP_SPV),
+      scheduler{scheduler_}, staging_buffer_pool{staging_buffer_pool_},
+      compute_pass_descriptor_queue{compute_pass_descriptor_queue_} {}
+
+BCnDecoderPass::~BCnDecoderPass() = default;
+
+void BCnDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
+                              std::span<const VideoCommon::SwizzleParameters> swizzles) {
+    using namespace VideoCommon::Accelerated;
+    const VideoCore::Surface::PixelFormat format = image.info.format;
+    const u32 bytes_per_texel = VideoCommon::ConvertedBytesPerBlock(format);
+    const s32 num_layers = image.info.resources.layers;
+
+    // The fallback formats of BCn are not always usable as storage images,
+    // so texels are decoded to a buffer and copied to the image afterwards
+    boost::container::small_vector<VideoCommon::BufferImageCopy, 16> copies;
+    size_t output_size = 0;
+    for (const VideoCommon::SwizzleParameters& swizzle : swizzles) {
+        const u32 width = swizzle.num_tiles.width * 4;
+        const u32 height = swizzle.num_tiles.height * 4;
+        const size_t level_size = size_t{width} * height * bytes_per_texel * num_layers;
+        copies.push_back(VideoCommon::BufferImageCopy{
+            .buffer_offset = output_size,
+            .buffer_size = level_size,
+            .buffer_row_length = width,
+            .buffer_image_height = height,
+            .image_subresource{
+                .base_level = swizzle.level,
+                .base_layer = 0,
+                .num_layers = num_layers,
+            },
+            .image_offset{0, 0, 0},
+            .image_extent{
+                .width = std::max(image.info.size.width >> swizzle.level, 1U),
+                .height = std::max(image.info.size.height >> swizzle.level, 1U),
+                .depth = 1,
+            },
+        });
+        output_size = Common::AlignUp(output_size + level_size, 256);
+    }
+    const StagingBufferRef output =
+        staging_buffer_pool.Request(output_size, MemoryUsage::DeviceLocal);
+
+    scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
+    scheduler.Record([vk_pipeline = *pipeline](vk::CommandBuffer cmdbuf) {
+        cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, vk_pipeline);
+    });
+    for (size_t index = 0; index < swizzles.size(); ++index) {
+        const VideoCommon::SwizzleParameters& swizzle = swizzles[index];
+        const size_t input_offset = swizzle.buffer_offset + map.offset;
+        const u32 num_dispatches_x = Common::DivCeil(swizzle.num_tiles.width, 8U);
+        const u32 num_dispatches_y = Common::DivCeil(swizzle.num_tiles.height, 8U);
+        const u32 num_dispatches_z = static_cast<u32>(num_layers);
+
+        compute_pass_descriptor_queue.Acquire();
+        compute_pass_descriptor_queue.AddBuffer(map.buffer, input_offset,
+                                                image.guest_size_bytes - swizzle.buffer_offset);
+        compute_pass_descriptor_queue.AddBuffer(output.buffer,
+                                                output.offset + copies[index].buffer_offset,
+                                                copies[index].buffer_size);
+        const void* const descriptor_data{compute_pass_descriptor_queue.UpdateData()};
+
+        const auto params = MakeBlockLinearSwizzle2DParams(swizzle, image.info);
+        const BcnPushConstants uniforms{
+            .format = BcnDecoderFormat(format),
+            .is_signed = IsSignedBcn(format) ? 1U : 0U,
+            .blocks_x = swizzle.num_tiles.width,
+            .blocks_y = swizzle.num_tiles.height,
+            .bytes_per_block_log2 = params.bytes_per_block_log2,
+            .layer_stride = params.layer_stride,
+            .block_size = params.block_size,
+            .x_shift = params.x_shift,
+            .block_height = params.block_height,
+            .block_height_mask = params.block_height_mask,
+        };
+        scheduler.Record([this, num_dispatches_x, num_dispatches_y, num_dispatches_z, uniforms,
+                          descriptor_data](vk::CommandBuffer cmdbuf) {
+            const VkDescriptorSet set = descriptor_allocator.Commit();
+            device.GetLogical().UpdateDescriptorSet(set, *descriptor_template, descriptor_data);
+            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, *layout, 0, set, {});
+            cmdbuf.PushConstants(*layout, VK_SHADER_STAGE_COMPUTE_BIT, uniforms);
+            cmdbuf.Dispatch(num_dispatches_x, num_dispatches_y, num_dispatches_z);
+        });
+    }
+    scheduler.Record([](vk::CommandBuffer cmdbuf) {
+        static constexpr VkMemoryBarrier WRITE_BARRIER{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+        };
         cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, image_barrier);
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, 0, WRITE_BARRIER);
     });
-    scheduler.Finish();
+    image.UploadMemory(output.buffer, output.offset, copies);
 }
 
 MSAACopyPass::MSAACopyPass(const Device& device_, Scheduler& scheduler_,
@@ -679,6 +1049,7 @@ void MSAACopyPass::CopyImage(Image& dst_image, Image& src_image,
                              bool msaa_to_non_msaa) {
     const VkPipeline msaa_pipeline = *pipelines[msaa_to_non_msaa ? 1 : 0];
     scheduler.RequestOutsideRenderPassOperationContext();
+    const GpuTimeScope gpu_time{scheduler, GpuTimeCategory::ComputePass};
     for (const VideoCommon::ImageCopy& copy : copies) {
         ASSERT(copy.src_subresource.base_layer == 0);
         ASSERT(copy.src_subresource.num_layers == 1);
@@ -9,6 +9,7 @@
 
 #include "common/common_types.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/maxwell_dma.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/texture_cache/types.h"
@@ -85,6 +86,44 @@ private:
     ComputePassDescriptorQueue& compute_pass_descriptor_queue;
 };
 
+class TransformFeedbackDrawPass final : public ComputePass {
+public:
+    explicit TransformFeedbackDrawPass(const Device& device_, Scheduler& scheduler_,
+                                       DescriptorPool& descriptor_pool_,
+                                       StagingBufferPool& staging_buffer_pool_,
+                                       ComputePassDescriptorQueue& compute_pass_descriptor_queue_);
+    ~TransformFeedbackDrawPass();
+
+    /// Converts a transform feedback byte count into an indirect draw command.
+    /// Quads produce a VkDrawIndexedIndirectCommand over the quad index buffer, other topologies
+    /// a VkDrawIndirectCommand. Returns the buffer and offset of the command.
+    std::pair<VkBuffer, VkDeviceSize> Assemble(
+        VkBuffer counter_buffer, u32 counter_offset, u32 stride, u32 max_vertices,
+        Tegra::Engines::Maxwell3D::Regs::PrimitiveTopology topology);
+
+private:
+    Scheduler& scheduler;
+    StagingBufferPool& staging_buffer_pool;
+    ComputePassDescriptorQueue& compute_pass_descriptor_queue;
+};
+
+class BlockLinearCopyPass final : public ComputePass {
+public:
+    explicit BlockLinearCopyPass(const Device& device_, Scheduler& scheduler_,
+                                 DescriptorPool& descriptor_pool_,
+                                 ComputePassDescriptorQueue& compute_pass_descriptor_queue_);
+    ~BlockLinearCopyPass();
+
+    /// Swizzles or unswizzles a DMA copy between two buffers without leaving the GPU
+    void Copy(VkBuffer pitch_buffer, u32 pitch_offset, VkBuffer block_linear_buffer,
+              u32 block_linear_offset, const Tegra::DMA::BlockLinearCopy& copy,
+              bool to_block_linear);
+
+private:
+    Scheduler& scheduler;
+    ComputePassDescriptorQueue& compute_pass_descriptor_queue;
+};
+
 class ConditionalRenderingResolvePass final : public ComputePass {
 public:
     explicit ConditionalRenderingResolvePass(
@@ -131,6 +170,23 @@ private:
     MemoryAllocator& memory_allocator;
 };
 
+class BCnDecoderPass final : public ComputePass {
+public:
+    explicit BCnDecoderPass(const Device& device_, Scheduler& scheduler_,
+                            DescriptorPool& descriptor_pool_,
+                            StagingBufferPool& staging_buffer_pool_,
+                            ComputePassDescriptorQueue& compute_pass_descriptor_queue_);
+    ~BCnDecoderPass();
+
+    void Assemble(Image& image, const StagingBufferRef& map,
+                  std::span<const VideoCommon::SwizzleParameters> swizzles);
+
+private:
+    Scheduler& scheduler;
+    StagingBufferPool& staging_buffer_pool;
+    ComputePassDescriptorQueue& compute_pass_descriptor_queue;
+};
+
 class MSAACopyPass final : public ComputePass {
 public:
     explicit MSAACopyPass(const Device& device_, Scheduler& scheduler_,
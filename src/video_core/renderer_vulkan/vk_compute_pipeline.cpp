@@ -32,7 +32,8 @@ ComputePipeline::ComputePipeline(const Device& device_, vk::PipelineCache& pipel
                                  VideoCore::ShaderNotify* shader_notify, const Shader::Info& info_,
                                  vk::ShaderModule spv_module_)
     : device{device_},
-      pipeline_cache(pipeline_cache_), guest_descriptor_queue{guest_descriptor_queue_}, info{info_},
+      pipeline_cache(pipeline_cache_), guest_descriptor_queue{guest_descriptor_queue_},
+      descriptor_buffer{descriptor_pool.GetDescriptorBuffer()}, info{info_},
       spv_module(std::move(spv_module_)) {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
@@ -40,15 +41,20 @@ ComputePipeline::ComputePipeline(const Device& device_, vk::PipelineCache& pipel
     std::copy_n(info.constant_buffer_used_sizes.begin(), uniform_buffer_sizes.size(),
                 uniform_buffer_sizes.begin());
 
-    auto func{[this, &descriptor_pool, shader_notify, pipeline_statistics] {
+    const auto build_start{std::chrono::steady_clock::now()};
+    auto func{[this, &descriptor_pool, shader_notify, pipeline_statistics, build_start] {
         DescriptorLayoutBuilder builder{device};
         builder.Add(info, VK_SHADER_STAGE_COMPUTE_BIT);
 
         descriptor_set_layout = builder.CreateDescriptorSetLayout(false);
         pipeline_layout = builder.CreatePipelineLayout(*descriptor_set_layout);
-        descriptor_update_template =
-            builder.CreateTemplate(*descriptor_set_layout, *pipeline_layout, false);
-        descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, info);
+        if (descriptor_buffer) {
+            descriptor_buffer_layout = builder.CreateDescriptorBufferLayout(*descriptor_set_layout);
+        } else {
+            descriptor_update_template =
+                builder.CreateTemplate(*descriptor_set_layout, *pipeline_layout, false);
+            descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, info);
+        }
         const VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT subgroup_size_ci{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT,
             .pNext = nullptr,
@@ -58,6 +64,9 @@ ComputePipeline::ComputePipeline(const Device& device_, vk::PipelineCache& pipel
         if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
             flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
         }
+        if (descriptor_buffer) {
+            flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        }
         pipeline = device.GetLogical().CreateComputePipeline(
             {
                 .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -65,8 +74,9 @@ ComputePipeline::ComputePipeline(const Device& device_, vk::PipelineCache& pipel
                 .flags = flags,
                 .stage{
                     .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-                    .pNext =
-                        device.IsExtSubgroupSizeControlSupported() ? &subgroup_size_ci : nullptr,
+                    .pNext = device.IsGuestWarpSizeSupported(VK_SHADER_STAGE_COMPUTE_BIT)
+                                 ? &subgroup_size_ci
+                                 : nullptr,
                     .flags = 0,
                     .stage = VK_SHADER_STAGE_COMPUTE_BIT,
                     .module = *spv_module,
@@ -83,6 +93,7 @@ ComputePipeline::ComputePipeline(const Device& device_, vk::PipelineCache& pipel
             pipeline_statistics->Collect(*pipeline);
         }
         std::scoped_lock lock{build_mutex};
+        build_time = std::chrono::steady_clock::now() - build_start;
         is_built = true;
         build_condvar.notify_one();
         if (shader_notify) {
@@ -217,9 +228,15 @@ void ComputePipeline::Configure(Tegra::Engines::KeplerCompute& kepler_compute,
                                  RESCALING_LAYOUT_WORDS_OFFSET, sizeof(rescaling_data),
                                  rescaling_data.data());
         }
-        const VkDescriptorSet descriptor_set{descriptor_allocator.Commit()};
-        const vk::Device& dev{device.GetLogical()};
-        dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template, descriptor_data);
+        if (descriptor_buffer) {
+            const DescriptorBufferBinding binding{
+                descriptor_buffer->Commit(descriptor_buffer_layout, descriptor_data)};
+            descriptor_buffer->Bind(cmdbuf, VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline_layout,
+                                    binding);
+            return;
+        }
+        const VkDescriptorSet descriptor_set{
+            descriptor_allocator.Commit(*descriptor_update_template, descriptor_data)};
         cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline_layout, 0,
                                   descriptor_set, nullptr);
     });
@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "video_core/renderer_vulkan/vk_descriptor_buffer.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_memory_allocator.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+namespace {
+using namespace Common::Literals;
+
+constexpr VkDeviceSize PAGE_SIZE = 4_MiB;
+constexpr size_t MAX_DESCRIPTOR_SIZE = 256;
+
+constexpr VkBufferUsageFlags DESCRIPTOR_BUFFER_USAGE =
+    VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+    VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+
+size_t DescriptorSize(const VkPhysicalDeviceDescriptorBufferPropertiesEXT& properties,
+                      VkDescriptorType type) {
+    // Robust buffer access is always enabled, so buffers use the robust descriptor sizes
+    switch (type) {
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        return properties.robustUniformBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        return properties.robustStorageBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        return properties.robustUniformTexelBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+        return properties.robustStorageTexelBufferDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        return properties.combinedImageSamplerDescriptorSize;
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        return properties.storageImageDescriptorSize;
+    default:
+        ASSERT_MSG(false, "Unexpected descriptor type {}", static_cast<int>(type));
+        return 0;
+    }
+}
+} // Anonymous namespace
+
+DescriptorBufferLayout::DescriptorBufferLayout(
+    const Device& device, VkDescriptorSetLayout layout,
+    std::span<const VkDescriptorUpdateTemplateEntry> entries)
+    : size{device.GetLogical().GetDescriptorSetLayoutSizeEXT(layout)} {
+    const auto& properties{device.GetDescriptorBufferProperties()};
+    const vk::Device& dev{device.GetLogical()};
+    bindings.reserve(entries.size());
+    for (const VkDescriptorUpdateTemplateEntry& entry : entries) {
+        bindings.push_back({
+            .type = entry.descriptorType,
+            .count = entry.descriptorCount,
+            .descriptor_size = DescriptorSize(properties, entry.descriptorType),
+            .offset = dev.GetDescriptorSetLayoutBindingOffsetEXT(layout, entry.dstBinding),
+            .payload_offset = entry.offset,
+            .payload_stride = entry.stride,
+        });
+    }
+}
+
+DescriptorBuffer::DescriptorBuffer(const Device& device_, MemoryAllocator& memory_allocator_,
+                                   Scheduler& scheduler_)
+    : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_} {
+    const auto& properties{device.GetDescriptorBufferProperties()};
+    page_size = std::min({PAGE_SIZE, properties.maxResourceDescriptorBufferRange,
+                          properties.maxSamplerDescriptorBufferRange});
+    offset_alignment = properties.descriptorBufferOffsetAlignment;
+    split_combined_image_samplers = properties.combinedImageSamplerDescriptorSingleArray == 0;
+    combined_image_sampler_size = properties.combinedImageSamplerDescriptorSize;
+    sampled_image_size = properties.sampledImageDescriptorSize;
+    sampler_size = properties.samplerDescriptorSize;
+    ASSERT(combined_image_sampler_size <= MAX_DESCRIPTOR_SIZE);
+    CreatePage();
+}
+
+DescriptorBuffer::~DescriptorBuffer() = default;
+
+DescriptorBufferBinding DescriptorBuffer::Commit(const DescriptorBufferLayout& layout,
+                                                 const void* data) {
+    VkDeviceAddress address;
+    VkDeviceSize offset;
+    u8* set;
+    {
+        // Only the reservation has to be serialized, the page is not reused before the GPU is
+        // done with the current tick
+        std::scoped_lock lock{mutex};
+        Page& page{Reserve(layout.size)};
+        address = page.address;
+        offset = page.cursor;
+        set = page.buffer.Mapped().data() + offset;
+        page.cursor = Common::AlignUp(offset + layout.size, offset_alignment);
+        page.tick = scheduler.CurrentTick();
+    }
+    const u8* const payload{static_cast<const u8*>(data)};
+    for (const DescriptorBufferLayout::Binding& binding : layout.bindings) {
+        const bool split{binding.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER &&
+                         binding.count > 1 && split_combined_image_samplers};
+        for (u32 element = 0; element < binding.count; ++element) {
+            const auto& entry{*reinterpret_cast<const DescriptorUpdateEntry*>(
+                payload + binding.payload_offset + element * binding.payload_stride)};
+            u8* const descriptor{set + binding.offset};
+            if (split) {
+                // Arrays of images are followed by arrays of their samplers
+                WriteCombinedImageSampler(
+                    entry, descriptor + element * sampled_image_size,
+                    descriptor + binding.count * sampled_image_size + element * sampler_size);
+                continue;
+            }
+            WriteDescriptor(binding.type, entry, binding.descriptor_size,
+                            descriptor + element * binding.descriptor_size);
+        }
+    }
+    return DescriptorBufferBinding{
+        .address = address,
+        .offset = offset,
+    };
+}
+
+void DescriptorBuffer::Bind(vk::CommandBuffer cmdbuf, VkPipelineBindPoint bind_point,
+                            VkPipelineLayout pipeline_layout,
+                            const DescriptorBufferBinding& binding) const {
+    const VkDescriptorBufferBindingInfoEXT binding_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+        .pNext = nullptr,
+        .address = binding.address,
+        .usage = DESCRIPTOR_BUFFER_USAGE,
+    };
+    const u32 buffer_index{0};
+    cmdbuf.BindDescriptorBuffersEXT(binding_info);
+    cmdbuf.SetDescriptorBufferOffsetsEXT(bind_point, pipeline_layout, 0, buffer_index,
+                                         binding.offset);
+}
+
+DescriptorBuffer::Page& DescriptorBuffer::Reserve(VkDeviceSize size) {
+    ASSERT(size <= page_size);
+    if (pages[current_page].cursor + size <= page_size) {
+        return pages[current_page];
+    }
+    for (size_t step = 1; step < pages.size(); ++step) {
+        const size_t index{(current_page + step) % pages.size()};
+        if (scheduler.IsFree(pages[index].tick)) {
+            current_page = index;
+            pages[index].cursor = 0;
+            return pages[index];
+        }
+    }
+    // Every page is in use by the GPU, creating a page avoids waiting on the worker thread
+    CreatePage();
+    current_page = pages.size() - 1;
+    return pages.back();
+}
+
+void DescriptorBuffer::CreatePage() {
+    vk::Buffer buffer{memory_allocator.CreateBuffer(
+        {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .size = page_size,
+            .usage = DESCRIPTOR_BUFFER_USAGE | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+        },
+        MemoryUsage::Stream)};
+    if (device.HasDebuggingToolAttached()) {
+        buffer.SetObjectNameEXT(fmt::format("DescriptorBuffer {}", pages.size()).c_str());
+    }
+    const VkDeviceAddress address{device.GetLogical().GetBufferDeviceAddress(*buffer)};
+    pages.push_back(Page{
+        .buffer = std::move(buffer),
+        .address = address,
+        .cursor = 0,
+        .tick = 0,
+    });
+    LOG_DEBUG(Render_Vulkan, "Created descriptor buffer page {}", pages.size());
+}
+
+void DescriptorBuffer::WriteDescriptor(VkDescriptorType type, const DescriptorUpdateEntry& entry,
+                                       size_t size, u8* descriptor) const {
+    VkDescriptorAddressInfoEXT address_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+        .pNext = nullptr,
+        .address = 0,
+        .range = 0,
+        .format = VK_FORMAT_UNDEFINED,
+    };
+    VkDescriptorGetInfoEXT get_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+        .pNext = nullptr,
+        .type = type,
+        .data{},
+    };
+    const vk::Device& dev{device.GetLogical()};
+    switch (type) {
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        address_info.address =
+            dev.GetBufferDeviceAddress(entry.buffer.buffer) + entry.buffer.offset;
+        address_info.range = entry.buffer.range;
+        if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+            get_info.data.pUniformBuffer = &address_info;
+        } else {
+            get_info.data.pStorageBuffer = &address_info;
+        }
+        break;
+    case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: {
+        const DescriptorTexelBuffer& texel_buffer{entry.texel_buffer_range};
+        // Null buffers are written as null descriptors
+        const VkDescriptorAddressInfoEXT* const info{texel_buffer.buffer ? &address_info
+                                                                         : nullptr};
+        if (texel_buffer.buffer) {
+            address_info.address =
+                dev.GetBufferDeviceAddress(texel_buffer.buffer) + texel_buffer.offset;
+            address_info.range = texel_buffer.size;
+            address_info.format = texel_buffer.format;
+        }
+        if (type == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER) {
+            get_info.data.pUniformTexelBuffer = info;
+        } else {
+            get_info.data.pStorageTexelBuffer = info;
+        }
+        break;
+    }
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        get_info.data.pCombinedImageSampler = &entry.image;
+        break;
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+        get_info.data.pStorageImage = &entry.image;
+        break;
+    default:
+        ASSERT_MSG(false, "Unexpected descriptor type {}", static_cast<int>(type));
+        return;
+    }
+    dev.GetDescriptorEXT(get_info, size, descriptor);
+}
+
+void DescriptorBuffer::WriteCombinedImageSampler(const DescriptorUpdateEntry& entry,
+                                                 u8* image_descriptor,
+                                                 u8* sampler_descriptor) const {
+    std::array<u8, MAX_DESCRIPTOR_SIZE> combined;
+    WriteDescriptor(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, entry, combined_image_sampler_size,
+                    combined.data());
+    std::memcpy(image_descriptor, combined.data(), sampled_image_size);
+    std::memcpy(sampler_descriptor, combined.data() + sampled_image_size, sampler_size);
+}
+
+} // namespace Vulkan
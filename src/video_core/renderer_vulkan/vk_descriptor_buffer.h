@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <span>
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+class MemoryAllocator;
+class Scheduler;
+struct DescriptorUpdateEntry;
+
+/// Location of a descriptor set written to a descriptor buffer
+struct DescriptorBufferBinding {
+    VkDeviceAddress address; ///< Device address of the descriptor buffer
+    VkDeviceSize offset;     ///< Offset of the descriptor set in the descriptor buffer
+};
+
+/// Placement of the entries of a descriptor update template payload in a descriptor buffer
+class DescriptorBufferLayout {
+    friend class DescriptorBuffer;
+
+public:
+    explicit DescriptorBufferLayout() = default;
+    explicit DescriptorBufferLayout(const Device& device, VkDescriptorSetLayout layout,
+                                    std::span<const VkDescriptorUpdateTemplateEntry> entries);
+
+private:
+    struct Binding {
+        VkDescriptorType type;  ///< Type of the descriptors in the binding
+        u32 count;              ///< Number of array elements
+        size_t descriptor_size; ///< Size in bytes of a single descriptor
+        VkDeviceSize offset;    ///< Offset of the binding in the descriptor set
+        size_t payload_offset;  ///< Offset of the first element in the payload
+        size_t payload_stride;  ///< Distance between elements in the payload
+    };
+
+    VkDeviceSize size{};
+    boost::container::small_vector<Binding, 32> bindings;
+};
+
+/**
+ * Host visible descriptor buffers descriptor sets are written to directly, replacing descriptor
+ * pools and template updates. Buffers are filled linearly and reused once the GPU is done with
+ * every descriptor set written to them.
+ */
+class DescriptorBuffer {
+public:
+    explicit DescriptorBuffer(const Device& device, MemoryAllocator& memory_allocator,
+                              Scheduler& scheduler);
+    ~DescriptorBuffer();
+
+    DescriptorBuffer& operator=(const DescriptorBuffer&) = delete;
+    DescriptorBuffer(const DescriptorBuffer&) = delete;
+
+    /// Writes a descriptor set from a descriptor update template payload, thread safe
+    [[nodiscard]] DescriptorBufferBinding Commit(const DescriptorBufferLayout& layout,
+                                                 const void* data);
+
+    /// Binds a committed descriptor set to the first set of a pipeline layout
+    void Bind(vk::CommandBuffer cmdbuf, VkPipelineBindPoint bind_point,
+              VkPipelineLayout pipeline_layout, const DescriptorBufferBinding& binding) const;
+
+private:
+    struct Page {
+        vk::Buffer buffer;
+        VkDeviceAddress address;
+        VkDeviceSize cursor;
+        u64 tick;
+    };
+
+    /// Reserves size bytes in a page, moving to a free or new page when the current one is full
+    Page& Reserve(VkDeviceSize size);
+
+    void CreatePage();
+
+    void WriteDescriptor(VkDescriptorType type, const DescriptorUpdateEntry& entry, size_t size,
+                         u8* descriptor) const;
+
+    void WriteCombinedImageSampler(const DescriptorUpdateEntry& entry, u8* image_descriptor,
+                                   u8* sampler_descriptor) const;
+
+    const Device& device;
+    MemoryAllocator& memory_allocator;
+    Scheduler& scheduler;
+
+    VkDeviceSize page_size{};
+    VkDeviceSize offset_alignment{};
+    bool split_combined_image_samplers{};
+    size_t combined_image_sampler_size{};
+    size_t sampled_image_size{};
+    size_t sampler_size{};
+
+    std::mutex mutex;
+    std::deque<Page> pages;
+    size_t current_page{};
+};
+
+} // namespace Vulkan
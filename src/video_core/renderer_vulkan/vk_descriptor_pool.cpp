@@ -7,10 +7,14 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "video_core/renderer_vulkan/vk_descriptor_buffer.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -19,10 +23,13 @@ namespace Vulkan {
 // Prefer small grow rates to avoid saturating the descriptor pool with barely used pipelines
 constexpr size_t SETS_GROW_RATE = 16;
 constexpr s32 SCORE_THRESHOLD = 3;
+// Descriptor set reuse is reported about every few seconds
+constexpr u64 STATS_REPORT_FRAMES = 300;
 
 struct DescriptorBank {
     DescriptorBankInfo info;
     std::vector<vk::DescriptorPool> pools;
+    std::mutex mutex; ///< Serializes commits from parallel command recording threads
 };
 
 bool DescriptorBankInfo::IsSuperset(const DescriptorBankInfo& subset) const noexcept {
@@ -85,11 +92,52 @@ static void AllocatePool(const Device& device, DescriptorBank& bank) {
 }
 
 DescriptorAllocator::DescriptorAllocator(const Device& device_, MasterSemaphore& master_semaphore_,
-                                         DescriptorBank& bank_, VkDescriptorSetLayout layout_)
+                                         DescriptorBank& bank_, VkDescriptorSetLayout layout_,
+                                         size_t num_descriptors, DescriptorReuseStats& stats_)
     : ResourcePool(master_semaphore_, SETS_GROW_RATE), device{&device_}, bank{&bank_},
-      layout{layout_} {}
+      layout{layout_}, stats{&stats_},
+      payload_size{num_descriptors * sizeof(DescriptorUpdateEntry)} {}
 
 VkDescriptorSet DescriptorAllocator::Commit() {
+    std::scoped_lock lock{bank->mutex};
+    return CommitSet();
+}
+
+VkDescriptorSet DescriptorAllocator::Commit(VkDescriptorUpdateTemplate update_template,
+                                            const void* data) {
+    // Handles referenced by the data can only be destroyed and recreated between ticks, so a set
+    // is only reused within the tick it was updated in
+    std::scoped_lock lock{bank->mutex};
+    const std::span payload{static_cast<const u8*>(data), payload_size};
+    const u64 current_tick = CurrentTick();
+    if (cache_tick != current_tick) {
+        cache_tick = current_tick;
+        cached_sets.clear();
+        cached_payloads.clear();
+    }
+    stats->num_commits.fetch_add(1, std::memory_order_relaxed);
+
+    const u64 hash = Common::RuntimeHash64(payload.data(), payload.size());
+    const auto [it, is_new] = cached_sets.try_emplace(hash);
+    CachedSet& cached = it->second;
+    if (!is_new) {
+        const std::span cached_payload{cached_payloads.data() + cached.payload_offset,
+                                       payload_size};
+        if (std::ranges::equal(payload, cached_payload)) {
+            stats->num_reused.fetch_add(1, std::memory_order_relaxed);
+            stats->num_skipped_bytes.fetch_add(payload_size, std::memory_order_relaxed);
+            return cached.set;
+        }
+    }
+    // Hash collisions replace the cached set, they are too rare to be worth chaining
+    cached.set = CommitSet();
+    cached.payload_offset = cached_payloads.size();
+    cached_payloads.insert(cached_payloads.end(), payload.begin(), payload.end());
+    device->GetLogical().UpdateDescriptorSet(cached.set, update_template, data);
+    return cached.set;
+}
+
+VkDescriptorSet DescriptorAllocator::CommitSet() {
     const size_t index = CommitResource();
     return sets[index / SETS_GROW_RATE][index % SETS_GROW_RATE];
 }
@@ -122,8 +170,13 @@ vk::DescriptorSets DescriptorAllocator::AllocateDescriptors(size_t count) {
     throw vk::Exception(VK_ERROR_OUT_OF_POOL_MEMORY);
 }
 
-DescriptorPool::DescriptorPool(const Device& device_, Scheduler& scheduler)
-    : device{device_}, master_semaphore{scheduler.GetMasterSemaphore()} {}
+DescriptorPool::DescriptorPool(const Device& device_, MemoryAllocator& memory_allocator,
+                               Scheduler& scheduler)
+    : device{device_}, master_semaphore{scheduler.GetMasterSemaphore()} {
+    if (device.IsExtDescriptorBufferSupported()) {
+        descriptor_buffer = std::make_unique<DescriptorBuffer>(device, memory_allocator, scheduler);
+    }
+}
 
 DescriptorPool::~DescriptorPool() = default;
 
@@ -139,7 +192,27 @@ DescriptorAllocator DescriptorPool::Allocator(VkDescriptorSetLayout layout,
 
 DescriptorAllocator DescriptorPool::Allocator(VkDescriptorSetLayout layout,
                                               const DescriptorBankInfo& info) {
-    return DescriptorAllocator(device, master_semaphore, Bank(info), layout);
+    return DescriptorAllocator(device, master_semaphore, Bank(info), layout,
+                               static_cast<size_t>(info.score), reuse_stats);
+}
+
+void DescriptorPool::TickFrame() {
+    if (++frame_count % STATS_REPORT_FRAMES != 0) {
+        return;
+    }
+    const u64 num_commits = reuse_stats.num_commits.exchange(0, std::memory_order_relaxed);
+    const u64 num_reused = reuse_stats.num_reused.exchange(0, std::memory_order_relaxed);
+    const u64 num_skipped_bytes =
+        reuse_stats.num_skipped_bytes.exchange(0, std::memory_order_relaxed);
+    if (num_commits == 0) {
+        return;
+    }
+    LOG_DEBUG(Render_Vulkan,
+              "Descriptor sets in the last {} frames: {} commits, {} reused ({:.1f}%), {} KiB of "
+              "updates skipped",
+              STATS_REPORT_FRAMES, num_commits, num_reused,
+              100.0 * static_cast<double>(num_reused) / static_cast<double>(num_commits),
+              num_skipped_bytes / 1024);
 }
 
 DescriptorBank& DescriptorPool::Bank(const DescriptorBankInfo& reqs) {
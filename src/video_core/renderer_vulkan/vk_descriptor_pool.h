@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <shared_mutex>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
 #include "shader_recompiler/shader_info.h"
@@ -13,7 +15,9 @@
 
 namespace Vulkan {
 
+class DescriptorBuffer;
 class Device;
+class MemoryAllocator;
 class Scheduler;
 
 struct DescriptorBank;
@@ -30,6 +34,13 @@ struct DescriptorBankInfo {
     s32 score{};           ///< Number of descriptors in total
 };
 
+/// Counters of descriptor set commits, used to report how often written sets are reused
+struct DescriptorReuseStats {
+    std::atomic<u64> num_commits{};       ///< Commits with update data
+    std::atomic<u64> num_reused{};        ///< Commits served by a set already written this tick
+    std::atomic<u64> num_skipped_bytes{}; ///< Update data bytes not written thanks to reuse
+};
+
 class DescriptorAllocator final : public ResourcePool {
     friend class DescriptorPool;
 
@@ -45,12 +56,24 @@ public:
 
     VkDescriptorSet Commit();
 
+    /// Commits a descriptor set and updates it with the given data. A set committed in the
+    /// current tick is returned instead when it was updated with the same data.
+    VkDescriptorSet Commit(VkDescriptorUpdateTemplate update_template, const void* data);
+
 private:
+    struct CachedSet {
+        VkDescriptorSet set;
+        size_t payload_offset; ///< Offset of the update data of the set in cached_payloads
+    };
+
     explicit DescriptorAllocator(const Device& device_, MasterSemaphore& master_semaphore_,
-                                 DescriptorBank& bank_, VkDescriptorSetLayout layout_);
+                                 DescriptorBank& bank_, VkDescriptorSetLayout layout_,
+                                 size_t num_descriptors, DescriptorReuseStats& stats_);
 
     void Allocate(size_t begin, size_t end) override;
 
+    VkDescriptorSet CommitSet();
+
     vk::DescriptorSets AllocateDescriptors(size_t count);
 
     const Device* device{};
@@ -58,11 +81,19 @@ private:
     VkDescriptorSetLayout layout{};
 
     std::vector<vk::DescriptorSets> sets;
+
+    DescriptorReuseStats* stats{};
+
+    size_t payload_size{};
+    std::unordered_map<u64, CachedSet> cached_sets;
+    std::vector<u8> cached_payloads;
+    u64 cache_tick{};
 };
 
 class DescriptorPool {
 public:
-    explicit DescriptorPool(const Device& device, Scheduler& scheduler);
+    explicit DescriptorPool(const Device& device, MemoryAllocator& memory_allocator,
+                            Scheduler& scheduler);
     ~DescriptorPool();
 
     DescriptorPool& operator=(const DescriptorPool&) = delete;
@@ -73,6 +104,15 @@ public:
     DescriptorAllocator Allocator(VkDescriptorSetLayout layout, const Shader::Info& info);
     DescriptorAllocator Allocator(VkDescriptorSetLayout layout, const DescriptorBankInfo& info);
 
+    /// Reports descriptor set reuse periodically
+    void TickFrame();
+
+    /// Returns the descriptor buffer guest pipelines write their descriptors to, or null when
+    /// VK_EXT_descriptor_buffer is not in use
+    [[nodiscard]] DescriptorBuffer* GetDescriptorBuffer() const noexcept {
+        return descriptor_buffer.get();
+    }
+
 private:
     DescriptorBank& Bank(const DescriptorBankInfo& reqs);
 
@@ -82,6 +122,11 @@ private:
     std::shared_mutex banks_mutex;
     std::vector<DescriptorBankInfo> bank_infos;
     std::vector<std::unique_ptr<DescriptorBank>> banks;
+
+    DescriptorReuseStats reuse_stats;
+    u64 frame_count{};
+
+    std::unique_ptr<DescriptorBuffer> descriptor_buffer;
 };
 
 } // namespace Vulkan
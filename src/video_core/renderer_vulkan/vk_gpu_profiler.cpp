@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+namespace {
+// Number of ranges measured at once, each range uses two queries
+constexpr u32 NUM_RANGES = 4096;
+// Number of frames between reports
+constexpr u32 REPORT_FRAMES = 300;
+// Number of render targets listed in reports
+constexpr size_t NUM_REPORTED_RENDER_TARGETS = 4;
+
+constexpr std::array<const char*, NUM_GPU_TIME_CATEGORIES> CATEGORY_NAMES{
+    "render passes",
+    "compute passes",
+    "texture copies",
+    "present",
+};
+} // Anonymous namespace
+
+GpuProfiler::GpuProfiler(const Device& device_, Scheduler& scheduler_)
+    : device{device_}, scheduler{scheduler_},
+      nanoseconds_per_tick{static_cast<double>(device.GetTimestampPeriod())},
+      report{Settings::values.profile_gpu_passes.GetValue()}, ranges(NUM_RANGES) {
+    const auto& dev = device.GetLogical();
+    query_pool = dev.CreateQueryPool({
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .queryType = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = NUM_RANGES * 2,
+        .pipelineStatistics = 0,
+    });
+    dev.ResetQueryPool(*query_pool, 0, NUM_RANGES * 2);
+
+    free_ranges.resize(NUM_RANGES);
+    std::iota(free_ranges.rbegin(), free_ranges.rend(), 0U);
+}
+
+GpuProfiler::~GpuProfiler() = default;
+
+u32 GpuProfiler::Begin(GpuTimeCategory category, u64 tag) {
+    if (active_range != INVALID_RANGE || free_ranges.empty()) {
+        return INVALID_RANGE;
+    }
+    const u32 range = free_ranges.back();
+    free_ranges.pop_back();
+    ranges[range] = Range{
+        .category = category,
+        .tag = tag,
+        .end_tick = 0,
+    };
+    active_range = range;
+    scheduler.Record([pool = *query_pool, range](vk::CommandBuffer cmdbuf) {
+        cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pool, range * 2);
+    });
+    return range;
+}
+
+void GpuProfiler::End(u32 range) {
+    if (range == INVALID_RANGE) {
+        return;
+    }
+    scheduler.Record([pool = *query_pool, range](vk::CommandBuffer cmdbuf) {
+        cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pool, range * 2 + 1);
+    });
+    // The timestamp is written by the submission of the current tick
+    ranges[range].end_tick = scheduler.CurrentTick();
+    pending_ranges.push_back(range);
+    active_range = INVALID_RANGE;
+}
+
+void GpuProfiler::TickFrame() {
+    const auto& dev = device.GetLogical();
+    last_frame_nanoseconds = 0;
+    while (!pending_ranges.empty()) {
+        const u32 range = pending_ranges.front();
+        const Range& info = ranges[range];
+        if (!scheduler.IsFree(info.end_tick)) {
+            break;
+        }
+        std::array<u64, 2> timestamps{};
+        const VkResult result =
+            dev.GetQueryResults(*query_pool, range * 2, 2, sizeof(timestamps), timestamps.data(),
+                                sizeof(u64), VK_QUERY_RESULT_64_BIT);
+        if (result == VK_NOT_READY) {
+            break;
+        }
+        pending_ranges.pop_front();
+        dev.ResetQueryPool(*query_pool, range * 2, 2);
+        free_ranges.push_back(range);
+        if (result != VK_SUCCESS || timestamps[1] < timestamps[0]) {
+            continue;
+        }
+        const auto nanoseconds = static_cast<u64>(
+            static_cast<double>(timestamps[1] - timestamps[0]) * nanoseconds_per_tick);
+        last_frame_nanoseconds += nanoseconds;
+        category_nanoseconds[static_cast<size_t>(info.category)] += nanoseconds;
+        if (info.category == GpuTimeCategory::RenderPass) {
+            render_target_nanoseconds[info.tag] += nanoseconds;
+        }
+    }
+    if (++frame_count % REPORT_FRAMES == 0) {
+        if (report) {
+            Report();
+        } else {
+            category_nanoseconds = {};
+            render_target_nanoseconds.clear();
+        }
+    }
+}
+
+void GpuProfiler::Report() {
+    const auto to_frame_ms = [](u64 nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1'000'000.0 / REPORT_FRAMES;
+    };
+    std::string categories;
+    for (size_t i = 0; i < NUM_GPU_TIME_CATEGORIES; ++i) {
+        categories += fmt::format("{}{} {:.3f} ms", i == 0 ? "" : ", ", CATEGORY_NAMES[i],
+                                  to_frame_ms(category_nanoseconds[i]));
+    }
+    std::vector<std::pair<u64, u64>> render_targets(render_target_nanoseconds.begin(),
+                                                    render_target_nanoseconds.end());
+    const size_t num_render_targets =
+        std::min(render_targets.size(), NUM_REPORTED_RENDER_TARGETS);
+    std::partial_sort(render_targets.begin(), render_targets.begin() + num_render_targets,
+                      render_targets.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    std::string busiest;
+    for (size_t i = 0; i < num_render_targets; ++i) {
+        const auto [tag, nanoseconds] = render_targets[i];
+        busiest += fmt::format("{}{}x{} {:.3f} ms", i == 0 ? "" : ", ", tag >> 32,
+                               tag & 0xffffffff, to_frame_ms(nanoseconds));
+    }
+    LOG_INFO(Render_Vulkan, "GPU time per frame over the last {} frames: {}", REPORT_FRAMES,
+             categories);
+    if (!busiest.empty()) {
+        LOG_INFO(Render_Vulkan, "Busiest render targets: {}", busiest);
+    }
+    category_nanoseconds = {};
+    render_target_nanoseconds.clear();
+}
+
+GpuTimeScope::GpuTimeScope(Scheduler& scheduler, GpuTimeCategory category)
+    : profiler{scheduler.GetGpuProfiler()} {
+    if (!profiler) {
+        return;
+    }
+    scheduler.RequestOutsideRenderPassOperationContext();
+    range = profiler->Begin(category);
+}
+
+GpuTimeScope::~GpuTimeScope() {
+    if (profiler) {
+        profiler->End(range);
+    }
+}
+
+} // namespace Vulkan
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+class Scheduler;
+
+enum class GpuTimeCategory : u32 {
+    RenderPass,  ///< Guest draws within render passes
+    ComputePass, ///< Utility compute passes, like index conversion and texture decoding
+    TextureCopy, ///< Texture cache copies, blits and format conversions
+    Present,     ///< Filtering, scaling and composition of presented frames
+};
+constexpr size_t NUM_GPU_TIME_CATEGORIES = 4;
+
+/**
+ * Measures the GPU time of passes with timestamp queries, enabled with the profile_gpu_passes
+ * setting. Timestamps are read once the GPU is done with them, without waiting, and the time
+ * per frame of each category and of the busiest render targets is logged every few hundred
+ * frames. Ranges don't nest, a range begun while another one runs is not measured.
+ * It also runs without logging to feed dynamic resolution with the GPU time of frames.
+ */
+class GpuProfiler {
+public:
+    static constexpr u32 INVALID_RANGE = ~0U;
+
+    explicit GpuProfiler(const Device& device, Scheduler& scheduler);
+    ~GpuProfiler();
+
+    /// Records the timestamp starting a range, tag tells apart render targets of render passes.
+    /// Returns INVALID_RANGE when the range is not measured.
+    [[nodiscard]] u32 Begin(GpuTimeCategory category, u64 tag = 0);
+
+    /// Records the timestamp ending a range returned by Begin
+    void End(u32 range);
+
+    /// Reads the timestamps of finished ranges, called once per frame
+    void TickFrame();
+
+    /// Returns the GPU time of the ranges read on the last tick. Ranges are read once the GPU
+    /// finished them, so this lags behind recorded frames by the frames in flight.
+    [[nodiscard]] u64 LastFrameNanoseconds() const noexcept {
+        return last_frame_nanoseconds;
+    }
+
+private:
+    struct Range {
+        GpuTimeCategory category;
+        u64 tag;
+        u64 end_tick;
+    };
+
+    void Report();
+
+    const Device& device;
+    Scheduler& scheduler;
+    vk::QueryPool query_pool;
+    double nanoseconds_per_tick;
+    bool report;
+
+    std::vector<Range> ranges;       ///< Indexed by range, which uses two consecutive queries
+    std::vector<u32> free_ranges;    ///< Ranges whose queries can be written
+    std::deque<u32> pending_ranges;  ///< Ended ranges, in the order they were ended
+    u32 active_range = INVALID_RANGE;
+
+    u32 frame_count = 0;
+    u64 last_frame_nanoseconds = 0;
+    std::array<u64, NUM_GPU_TIME_CATEGORIES> category_nanoseconds{};
+    std::unordered_map<u64, u64> render_target_nanoseconds;
+};
+
+/// Measures the GPU time of the commands recorded during its lifetime when profiling is enabled.
+/// The current render pass is ended first, so its time is not counted in the scope.
+class GpuTimeScope {
+public:
+    explicit GpuTimeScope(Scheduler& scheduler, GpuTimeCategory category);
+    ~GpuTimeScope();
+
+    GpuTimeScope(const GpuTimeScope&) = delete;
+    GpuTimeScope& operator=(const GpuTimeScope&) = delete;
+
+private:
+    GpuProfiler* profiler;
+    u32 range = GpuProfiler::INVALID_RANGE;
+};
+
+} // namespace Vulkan
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <cstring>
 #include <span>
 
 #include <boost/container/small_vector.hpp>
@@ -232,19 +233,27 @@ ConfigureFuncPtr ConfigureFunc(const std::array<vk::ShaderModule, NUM_STAGES>& m
     return FindSpec<SimpleVertexSpec, SimpleVertexFragmentSpec, SimpleStorageSpec, SimpleImageSpec,
                     DefaultSpec>(modules, infos);
 }
+
+bool UsesWarpIntrinsics(const Shader::Info& info) {
+    return info.uses_subgroup_invocation_id || info.uses_subgroup_shuffles ||
+           info.uses_subgroup_vote || info.uses_subgroup_mask || info.uses_fswzadd;
+}
 } // Anonymous namespace
 
 GraphicsPipeline::GraphicsPipeline(
     Scheduler& scheduler_, BufferCache& buffer_cache_, TextureCache& texture_cache_,
     vk::PipelineCache& pipeline_cache_, VideoCore::ShaderNotify* shader_notify,
     const Device& device_, DescriptorPool& descriptor_pool,
-    GuestDescriptorQueue& guest_descriptor_queue_, Common::ThreadWorker* worker_thread,
+    GuestDescriptorQueue& guest_descriptor_queue_, Common::ThreadWorker* worker_thread_,
     PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
-    const GraphicsPipelineCacheKey& key_, std::array<vk::ShaderModule, NUM_STAGES> stages,
+    PipelineLibraryCache* library_cache_, const GraphicsPipelineCacheKey& key_,
+    std::array<vk::ShaderModule, NUM_STAGES> stages,
     const std::array<const Shader::Info*, NUM_STAGES>& infos)
     : key{key_}, device{device_}, texture_cache{texture_cache_}, buffer_cache{buffer_cache_},
       pipeline_cache(pipeline_cache_), scheduler{scheduler_},
-      guest_descriptor_queue{guest_descriptor_queue_}, spv_modules{std::move(stages)} {
+      guest_descriptor_queue{guest_descriptor_queue_}, library_cache{library_cache_},
+      descriptor_buffer{descriptor_pool.GetDescriptorBuffer()}, worker_thread{worker_thread_},
+      spv_modules{std::move(stages)} {
     if (shader_notify) {
         shader_notify->MarkShaderBuilding();
     }
@@ -257,27 +266,40 @@ GraphicsPipeline::GraphicsPipeline(
         enabled_uniform_buffer_masks[stage] = info->constant_buffer_mask;
         std::ranges::copy(info->constant_buffer_used_sizes, uniform_buffer_sizes[stage].begin());
         num_textures += Shader::NumDescriptors(info->texture_descriptors);
+        num_specialized_cbufs += info->specialized_cbufs.size();
     }
-    auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics] {
+    const auto build_start{std::chrono::steady_clock::now()};
+    auto func{[this, shader_notify, &render_pass_cache, &descriptor_pool, pipeline_statistics,
+                build_start] {
         DescriptorLayoutBuilder builder{MakeBuilder(device, stage_infos)};
         uses_push_descriptor = builder.CanUsePushDescriptor();
         descriptor_set_layout = builder.CreateDescriptorSetLayout(uses_push_descriptor);
-        if (!uses_push_descriptor) {
-            descriptor_allocator = descriptor_pool.Allocator(*descriptor_set_layout, stage_infos);
-        }
         const VkDescriptorSetLayout set_layout{*descriptor_set_layout};
+        if (descriptor_buffer) {
+            descriptor_buffer_layout = builder.CreateDescriptorBufferLayout(set_layout);
+        } else if (!uses_push_descriptor) {
+            descriptor_allocator = descriptor_pool.Allocator(set_layout, stage_infos);
+        }
         pipeline_layout = builder.CreatePipelineLayout(set_layout);
-        descriptor_update_template =
-            builder.CreateTemplate(set_layout, *pipeline_layout, uses_push_descriptor);
+        if (!descriptor_buffer) {
+            descriptor_update_template =
+                builder.CreateTemplate(set_layout, *pipeline_layout, uses_push_descriptor);
+        }
 
-        const VkRenderPass render_pass{render_pass_cache.Get(MakeRenderPassKey(key.state))};
+        const RenderPassKey render_pass_key{MakeRenderPassKey(key.state)};
         Validate();
-        MakePipeline(render_pass);
+        if (device.IsKhrDynamicRenderingSupported()) {
+            built_rendering_formats = &render_pass_cache.GetRenderingFormats(render_pass_key);
+        } else {
+            built_render_pass = render_pass_cache.Get(render_pass_key);
+        }
+        MakePipeline(built_render_pass, built_rendering_formats);
         if (pipeline_statistics) {
             pipeline_statistics->Collect(*pipeline);
         }
 
         std::scoped_lock lock{build_mutex};
+        build_time = std::chrono::steady_clock::now() - build_start;
         is_built = true;
         build_condvar.notify_one();
         if (shader_notify) {
@@ -485,6 +507,10 @@ void GraphicsPipeline::ConfigureImpl(bool is_indexed) {
     }
     texture_cache.UpdateRenderTargets(false);
     texture_cache.CheckFeedbackLoop(views);
+    if (scheduler.PrepareRenderpass(texture_cache.GetFramebuffer())) {
+        // Buffers bound above were recorded into a secondary command buffer that has ended
+        buffer_cache.BindHostGeometryBuffers(is_indexed);
+    }
     ConfigureDraw(rescaling, render_area);
 }
 
@@ -501,14 +527,18 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
     }
     const bool is_rescaling{texture_cache.IsRescaling()};
     const bool update_rescaling{scheduler.UpdateRescaling(is_rescaling)};
-    const bool bind_pipeline{scheduler.UpdateGraphicsPipeline(this)};
+    const SpecializedVariant* const variant{SelectSpecializedVariant()};
+    const bool bind_pipeline{scheduler.UpdateGraphicsPipeline(this) || variant != bound_variant};
+    bound_variant = variant;
     const void* const descriptor_data{guest_descriptor_queue.UpdateData()};
-    scheduler.Record([this, descriptor_data, bind_pipeline, rescaling_data = rescaling.Data(),
-                      is_rescaling, update_rescaling,
+    scheduler.Record([this, descriptor_data, bind_pipeline, variant,
+                      rescaling_data = rescaling.Data(), is_rescaling, update_rescaling,
                       uses_render_area = render_area.uses_render_area,
                       render_area_data = render_area.words](vk::CommandBuffer cmdbuf) {
         if (bind_pipeline) {
-            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline);
+            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                variant ? *variant->pipeline
+                                        : pipeline_handle.load(std::memory_order::acquire));
         }
         cmdbuf.PushConstants(*pipeline_layout, VK_SHADER_STAGE_ALL_GRAPHICS,
                              RESCALING_LAYOUT_WORDS_OFFSET, sizeof(rescaling_data),
@@ -528,20 +558,71 @@ void GraphicsPipeline::ConfigureDraw(const RescalingPushConstant& rescaling,
         if (!descriptor_set_layout) {
             return;
         }
-        if (uses_push_descriptor) {
+        if (descriptor_buffer) {
+            const DescriptorBufferBinding binding{
+                descriptor_buffer->Commit(descriptor_buffer_layout, descriptor_data)};
+            descriptor_buffer->Bind(cmdbuf, VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout,
+                                    binding);
+        } else if (uses_push_descriptor) {
             cmdbuf.PushDescriptorSetWithTemplateKHR(*descriptor_update_template, *pipeline_layout,
                                                     0, descriptor_data);
         } else {
-            const VkDescriptorSet descriptor_set{descriptor_allocator.Commit()};
-            const vk::Device& dev{device.GetLogical()};
-            dev.UpdateDescriptorSet(descriptor_set, *descriptor_update_template, descriptor_data);
+            const VkDescriptorSet descriptor_set{
+                descriptor_allocator.Commit(*descriptor_update_template, descriptor_data)};
             cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, *pipeline_layout, 0,
                                       descriptor_set, nullptr);
         }
     });
 }
 
-void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
+GraphicsPipeline::SpecializedVariant* GraphicsPipeline::SelectSpecializedVariant() {
+    // Acquire the render pass state written by the build of the generic pipeline
+    if (num_specialized_cbufs == 0 || !is_built.load(std::memory_order::acquire)) {
+        return nullptr;
+    }
+    SpecializedValues values{};
+    size_t value_index{};
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+        const auto& cbufs{maxwell3d->state.shader_stages[stage].const_buffers};
+        for (const Shader::SpecializedCbufDescriptor& desc : stage_infos[stage].specialized_cbufs) {
+            const auto& cbuf{cbufs[desc.index]};
+            u32 value{};
+            if (cbuf.enabled && desc.offset < cbuf.size) {
+                value = gpu_memory->Read<u32>(cbuf.address + desc.offset);
+            }
+            values[value_index++] = value;
+        }
+    }
+    for (size_t index = 0; index < num_variants; ++index) {
+        SpecializedVariant* const variant{variants[index].get()};
+        if (variant->values == values) {
+            return variant->is_built.load(std::memory_order::acquire) ? variant : nullptr;
+        }
+    }
+    if (num_variants == MAX_SPECIALIZED_VARIANTS) {
+        // Keep using the generic pipeline for values that don't fit
+        return nullptr;
+    }
+    SpecializedVariant* const variant{
+        (variants[num_variants++] = std::make_unique<SpecializedVariant>()).get()};
+    variant->values = values;
+    num_building_variants.fetch_add(1, std::memory_order::relaxed);
+    auto func{[this, variant] {
+        MakePipeline(built_render_pass, built_rendering_formats, variant);
+        num_building_variants.fetch_sub(1, std::memory_order::release);
+    }};
+    if (worker_thread) {
+        // The generic pipeline is used until the variant is built
+        worker_thread->QueueWork(std::move(func));
+        return nullptr;
+    }
+    func();
+    return variant;
+}
+
+void GraphicsPipeline::MakePipeline(VkRenderPass render_pass,
+                                    const RenderingFormats* rendering_formats,
+                                    SpecializedVariant* variant) {
     FixedPipelineState::DynamicState dynamic{};
     if (!key.state.extended_dynamic_state) {
         dynamic = key.state.dynamic_state;
@@ -791,7 +872,7 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
         .pAttachments = cb_attachments.data(),
         .blendConstants = {},
     };
-    static_vector<VkDynamicState, 28> dynamic_states{
+    static_vector<VkDynamicState, 34> dynamic_states{
         VK_DYNAMIC_STATE_VIEWPORT,           VK_DYNAMIC_STATE_SCISSOR,
         VK_DYNAMIC_STATE_DEPTH_BIAS,         VK_DYNAMIC_STATE_BLEND_CONSTANTS,
         VK_DYNAMIC_STATE_DEPTH_BOUNDS,       VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK,
@@ -840,6 +921,23 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
             };
             dynamic_states.insert(dynamic_states.end(), extended3.begin(), extended3.end());
         }
+        if (key.state.extended_dynamic_state_3_rasterization) {
+            static constexpr std::array extended3{
+                VK_DYNAMIC_STATE_POLYGON_MODE_EXT,
+                VK_DYNAMIC_STATE_ALPHA_TO_COVERAGE_ENABLE_EXT,
+                VK_DYNAMIC_STATE_ALPHA_TO_ONE_ENABLE_EXT,
+            };
+            dynamic_states.insert(dynamic_states.end(), extended3.begin(), extended3.end());
+            if (device.IsExtLineRasterizationSupported()) {
+                dynamic_states.push_back(VK_DYNAMIC_STATE_LINE_RASTERIZATION_MODE_EXT);
+            }
+            if (device.IsExtConservativeRasterizationSupported()) {
+                dynamic_states.push_back(VK_DYNAMIC_STATE_CONSERVATIVE_RASTERIZATION_MODE_EXT);
+            }
+            if (device.IsExtProvokingVertexSupported()) {
+                dynamic_states.push_back(VK_DYNAMIC_STATE_PROVOKING_VERTEX_MODE_EXT);
+            }
+        }
     }
     const VkPipelineDynamicStateCreateInfo dynamic_state_ci{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
@@ -848,59 +946,242 @@ void GraphicsPipeline::MakePipeline(VkRenderPass render_pass) {
         .dynamicStateCount = static_cast<u32>(dynamic_states.size()),
         .pDynamicStates = dynamic_states.data(),
     };
-    [[maybe_unused]] const VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT subgroup_size_ci{
+    const VkPipelineShaderStageRequiredSubgroupSizeCreateInfoEXT subgroup_size_ci{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT,
         .pNext = nullptr,
         .requiredSubgroupSize = GuestWarpSize,
     };
+    // Enable specialization and pass the constant buffer values the variant is built for
+    static constexpr size_t MAX_SPECIALIZATION_ENTRIES = Shader::Info::MAX_SPECIALIZED_CBUFS + 1;
+    std::array<std::array<VkSpecializationMapEntry, MAX_SPECIALIZATION_ENTRIES>, NUM_STAGES>
+        specialization_entries{};
+    std::array<std::array<u32, MAX_SPECIALIZATION_ENTRIES>, NUM_STAGES> specialization_data{};
+    std::array<VkSpecializationInfo, NUM_STAGES> specialization_infos{};
+    size_t specialized_value_index{};
+    for (size_t stage = 0; variant && stage < NUM_STAGES; ++stage) {
+        const auto& cbufs{stage_infos[stage].specialized_cbufs};
+        if (cbufs.empty()) {
+            continue;
+        }
+        auto& entries{specialization_entries[stage]};
+        auto& data{specialization_data[stage]};
+        data[0] = VK_TRUE;
+        entries[0] = {
+            .constantID = Shader::CBUF_SPECIALIZATION_ENABLE_ID,
+            .offset = 0,
+            .size = sizeof(VkBool32),
+        };
+        for (size_t index = 0; index < cbufs.size(); ++index) {
+            data[index + 1] = variant->values[specialized_value_index++];
+            entries[index + 1] = {
+                .constantID = Shader::CBUF_SPECIALIZATION_FIRST_VALUE_ID + static_cast<u32>(index),
+                .offset = static_cast<u32>((index + 1) * sizeof(u32)),
+                .size = sizeof(u32),
+            };
+        }
+        specialization_infos[stage] = {
+            .mapEntryCount = static_cast<u32>(cbufs.size() + 1),
+            .pMapEntries = entries.data(),
+            .dataSize = (cbufs.size() + 1) * sizeof(u32),
+            .pData = data.data(),
+        };
+    }
     static_vector<VkPipelineShaderStageCreateInfo, 5> shader_stages;
     for (size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
         if (!spv_modules[stage]) {
             continue;
         }
-        [[maybe_unused]] auto& stage_ci =
-            shader_stages.emplace_back(VkPipelineShaderStageCreateInfo{
-                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-                .pNext = nullptr,
-                .flags = 0,
-                .stage = MaxwellToVK::ShaderStage(Shader::StageFromIndex(stage)),
-                .module = *spv_modules[stage],
-                .pName = "main",
-                .pSpecializationInfo = nullptr,
-            });
-        /*
-        if (program[stage]->entries.uses_warps && device.IsGuestWarpSizeSupported(stage_ci.stage)) {
+        const bool is_specialized{variant && !stage_infos[stage].specialized_cbufs.empty()};
+        auto& stage_ci = shader_stages.emplace_back(VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .stage = MaxwellToVK::ShaderStage(Shader::StageFromIndex(stage)),
+            .module = *spv_modules[stage],
+            .pName = "main",
+            .pSpecializationInfo = is_specialized ? &specialization_infos[stage] : nullptr,
+        });
+        // Shaders were emitted assuming guest sized warps on stages that can require them
+        if (UsesWarpIntrinsics(stage_infos[stage]) &&
+            device.IsGuestWarpSizeSupported(stage_ci.stage)) {
             stage_ci.pNext = &subgroup_size_ci;
         }
-        */
     }
     VkPipelineCreateFlags flags{};
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
     }
-    pipeline = device.GetLogical().CreateGraphicsPipeline(
-        {
-            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    if (descriptor_buffer) {
+        flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    }
+    VkPipelineRenderingCreateInfo rendering_ci{};
+    if (rendering_formats) {
+        rendering_ci = rendering_formats->PipelineCreateInfo();
+    }
+    const VkGraphicsPipelineCreateInfo pipeline_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = rendering_formats ? &rendering_ci : nullptr,
+        .flags = flags,
+        .stageCount = static_cast<u32>(shader_stages.size()),
+        .pStages = shader_stages.data(),
+        .pVertexInputState = &vertex_input_ci,
+        .pInputAssemblyState = &input_assembly_ci,
+        .pTessellationState = &tessellation_ci,
+        .pViewportState = &viewport_ci,
+        .pRasterizationState = &rasterization_ci,
+        .pMultisampleState = &multisample_ci,
+        .pDepthStencilState = &depth_stencil_ci,
+        .pColorBlendState = &color_blend_ci,
+        .pDynamicState = &dynamic_state_ci,
+        .layout = *pipeline_layout,
+        .renderPass = render_pass,
+        .subpass = 0,
+        .basePipelineHandle = nullptr,
+        .basePipelineIndex = 0,
+    };
+    if (variant) {
+        // Variants are rare enough to be built monolithically
+        variant->pipeline =
+            device.GetLogical().CreateGraphicsPipeline(pipeline_ci, *pipeline_cache);
+        variant->is_built.store(true, std::memory_order::release);
+        return;
+    }
+    // Without fragment stages there is nothing to share between pipelines
+    const bool discards{!key.state.extended_dynamic_state_2 && dynamic.rasterize_enable == 0};
+    if (library_cache && !discards) {
+        LinkPipeline(pipeline_ci);
+        return;
+    }
+    pipeline = device.GetLogical().CreateGraphicsPipeline(pipeline_ci, *pipeline_cache);
+    pipeline_handle.store(*pipeline, std::memory_order::release);
+}
+
+void GraphicsPipeline::LinkPipeline(const VkGraphicsPipelineCreateInfo& pipeline_ci) {
+    const auto make_library{[&](VkGraphicsPipelineLibraryFlagsEXT part,
+                                VkGraphicsPipelineCreateInfo library_ci) {
+        const VkGraphicsPipelineLibraryCreateInfoEXT part_ci{
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+            .pNext = library_ci.pNext,
+            .flags = part,
+        };
+        library_ci.pNext = &part_ci;
+        library_ci.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+                           VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT |
+                           (pipeline_ci.flags & VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT);
+        return device.GetLogical().CreateGraphicsPipeline(library_ci, *pipeline_cache);
+    }};
+    const std::span<const VkPipelineShaderStageCreateInfo> stages(pipeline_ci.pStages,
+                                                                  pipeline_ci.stageCount);
+    const auto fragment_it{std::ranges::find(stages, VK_SHADER_STAGE_FRAGMENT_BIT,
+                                             &VkPipelineShaderStageCreateInfo::stage)};
+    const u32 num_pre_rasterization_stages{
+        static_cast<u32>(std::distance(stages.begin(), fragment_it))};
+
+    const VkGraphicsPipelineCreateInfo vertex_input_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pVertexInputState = pipeline_ci.pVertexInputState,
+        .pInputAssemblyState = pipeline_ci.pInputAssemblyState,
+        .pDynamicState = pipeline_ci.pDynamicState,
+    };
+    // Attachment formats of dynamic rendering are chained after the pipeline create info
+    const VkGraphicsPipelineCreateInfo fragment_output_ci{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = pipeline_ci.pNext,
+        .pMultisampleState = pipeline_ci.pMultisampleState,
+        .pColorBlendState = pipeline_ci.pColorBlendState,
+        .pDynamicState = pipeline_ci.pDynamicState,
+        .renderPass = pipeline_ci.renderPass,
+    };
+    vertex_input_library =
+        make_library(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, vertex_input_ci);
+    fragment_output_library =
+        make_library(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+                     fragment_output_ci);
+
+    // Vertex input and color blend state are not part of the shader libraries, but the attribute
+    // types are, the vertex shader is built for them
+    GraphicsPipelineCacheKey library_key{key};
+    if (!key.state.dynamic_vertex_input) {
+        library_key.state.enabled_divisors = 0;
+    }
+    std::memset(library_key.state.attachments.data(), 0, sizeof(library_key.state.attachments));
+    for (auto& attribute : library_key.state.attributes) {
+        const u32 enabled = attribute.enabled.Value();
+        const u32 type = attribute.type.Value();
+        attribute.raw = 0;
+        attribute.enabled.Assign(enabled);
+        attribute.type.Assign(type);
+    }
+    library_key.state.binding_divisors.fill(0);
+    library_key.state.vertex_strides.fill(0);
+
+    const VkPipeline pre_rasterization_library{library_cache->Get(
+        VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, library_key, [&] {
+            const VkGraphicsPipelineCreateInfo library_ci{
+                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                .pNext = pipeline_ci.pNext,
+                .stageCount = num_pre_rasterization_stages,
+                .pStages = pipeline_ci.pStages,
+                .pTessellationState = pipeline_ci.pTessellationState,
+                .pViewportState = pipeline_ci.pViewportState,
+                .pRasterizationState = pipeline_ci.pRasterizationState,
+                .pDynamicState = pipeline_ci.pDynamicState,
+                .layout = pipeline_ci.layout,
+                .renderPass = pipeline_ci.renderPass,
+            };
+            return make_library(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                                library_ci);
+        })};
+    const VkPipeline fragment_shader_library{library_cache->Get(
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, library_key, [&] {
+            const VkGraphicsPipelineCreateInfo library_ci{
+                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                .pNext = pipeline_ci.pNext,
+                .stageCount = pipeline_ci.stageCount - num_pre_rasterization_stages,
+                .pStages = pipeline_ci.pStages + num_pre_rasterization_stages,
+                .pMultisampleState = pipeline_ci.pMultisampleState,
+                .pDepthStencilState = pipeline_ci.pDepthStencilState,
+                .pDynamicState = pipeline_ci.pDynamicState,
+                .layout = pipeline_ci.layout,
+                .renderPass = pipeline_ci.renderPass,
+            };
+            return make_library(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, library_ci);
+        })};
+
+    const std::array<VkPipeline, 4> libraries{
+        *vertex_input_library,
+        pre_rasterization_library,
+        fragment_shader_library,
+        *fragment_output_library,
+    };
+    const VkPipelineCreateFlags descriptor_flags{pipeline_ci.flags &
+                                                 VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT};
+    const auto link{[this, libraries, descriptor_flags](VkPipelineCreateFlags link_flags) {
+        const VkPipelineLibraryCreateInfoKHR link_ci{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
             .pNext = nullptr,
-            .flags = flags,
-            .stageCount = static_cast<u32>(shader_stages.size()),
-            .pStages = shader_stages.data(),
-            .pVertexInputState = &vertex_input_ci,
-            .pInputAssemblyState = &input_assembly_ci,
-            .pTessellationState = &tessellation_ci,
-            .pViewportState = &viewport_ci,
-            .pRasterizationState = &rasterization_ci,
-            .pMultisampleState = &multisample_ci,
-            .pDepthStencilState = &depth_stencil_ci,
-            .pColorBlendState = &color_blend_ci,
-            .pDynamicState = &dynamic_state_ci,
-            .layout = *pipeline_layout,
-            .renderPass = render_pass,
-            .subpass = 0,
-            .basePipelineHandle = nullptr,
-            .basePipelineIndex = 0,
-        },
-        *pipeline_cache);
+            .libraryCount = static_cast<u32>(libraries.size()),
+            .pLibraries = libraries.data(),
+        };
+        return device.GetLogical().CreateGraphicsPipeline(
+            {
+                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                .pNext = &link_ci,
+                .flags = link_flags | descriptor_flags,
+                .layout = *pipeline_layout,
+            },
+            *pipeline_cache);
+    }};
+    pipeline = link(0);
+    pipeline_handle.store(*pipeline, std::memory_order::release);
+
+    is_linking.store(true, std::memory_order::relaxed);
+    library_cache->QueueLink([this, link] {
+        optimized_pipeline = link(VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT);
+        // The next bind of this pipeline picks up the optimized version
+        pipeline_handle.store(*optimized_pipeline, std::memory_order::release);
+        is_linking.store(false, std::memory_order::release);
+    });
 }
 
 void GraphicsPipeline::Validate() {
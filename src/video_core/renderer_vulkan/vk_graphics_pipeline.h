@@ -6,15 +6,19 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <type_traits>
+#include <unordered_map>
 
 #include "common/thread_worker.h"
 #include "shader_recompiler/shader_info.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
+#include "video_core/renderer_vulkan/vk_descriptor_buffer.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -65,6 +69,46 @@ class RescalingPushConstant;
 class RenderAreaPushConstant;
 class Scheduler;
 
+/**
+ * Shader libraries shared by all graphics pipelines built with VK_EXT_graphics_pipeline_library.
+ * Pipelines that only differ in vertex input or color blend state reuse the compiled shaders and
+ * are fast-linked, the optimized link is done later in a background thread.
+ */
+class PipelineLibraryCache {
+public:
+    /// Returns the library part for the given key, building it with func if it doesn't exist
+    template <typename Func>
+    VkPipeline Get(VkGraphicsPipelineLibraryFlagsEXT part, const GraphicsPipelineCacheKey& key,
+                   Func&& func) {
+        auto& libraries{part == VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT
+                            ? pre_rasterization_libraries
+                            : fragment_shader_libraries};
+        {
+            std::scoped_lock lock{mutex};
+            if (const auto it{libraries.find(key)}; it != libraries.end()) {
+                return *it->second;
+            }
+        }
+        vk::Pipeline library{func()};
+        std::scoped_lock lock{mutex};
+        // Another thread may have built the same library in the meantime, keep the first one
+        return *libraries.try_emplace(key, std::move(library)).first->second;
+    }
+
+    /// Queues a task to the link thread
+    template <typename Func>
+    void QueueLink(Func&& func) {
+        link_worker.QueueWork(std::forward<Func>(func));
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<GraphicsPipelineCacheKey, vk::Pipeline> pre_rasterization_libraries;
+    std::unordered_map<GraphicsPipelineCacheKey, vk::Pipeline> fragment_shader_libraries;
+
+    Common::ThreadWorker link_worker{1, "VkPipelineLinker"};
+};
+
 class GraphicsPipeline {
     static constexpr size_t NUM_STAGES = Tegra::Engines::Maxwell3D::Regs::MaxShaderStage;
 
@@ -73,9 +117,10 @@ public:
         Scheduler& scheduler, BufferCache& buffer_cache, TextureCache& texture_cache,
         vk::PipelineCache& pipeline_cache, VideoCore::ShaderNotify* shader_notify,
         const Device& device, DescriptorPool& descriptor_pool,
-        GuestDescriptorQueue& guest_descriptor_queue, Common::ThreadWorker* worker_thread,
+        GuestDescriptorQueue& guest_descriptor_queue, Common::ThreadWorker* worker_thread_,
         PipelineStatistics* pipeline_statistics, RenderPassCache& render_pass_cache,
-        const GraphicsPipelineCacheKey& key, std::array<vk::ShaderModule, NUM_STAGES> stages,
+        PipelineLibraryCache* library_cache, const GraphicsPipelineCacheKey& key,
+        std::array<vk::ShaderModule, NUM_STAGES> stages,
         const std::array<const Shader::Info*, NUM_STAGES>& infos);
 
     GraphicsPipeline& operator=(GraphicsPipeline&&) noexcept = delete;
@@ -99,10 +144,32 @@ public:
                                            : nullptr;
     }
 
+    [[nodiscard]] const GraphicsPipelineCacheKey& Key() const noexcept {
+        return key;
+    }
+
     [[nodiscard]] bool IsBuilt() const noexcept {
         return is_built.load(std::memory_order::relaxed);
     }
 
+    /// Returns the time from the creation of the pipeline until it was built
+    [[nodiscard]] std::chrono::steady_clock::duration BuildTime() {
+        std::scoped_lock lock{build_mutex};
+        return build_time;
+    }
+
+    /// Returns true when the pipeline is built and no background work references it
+    [[nodiscard]] bool IsIdle() const noexcept {
+        return IsBuilt() && !is_linking.load(std::memory_order::acquire) &&
+               num_building_variants.load(std::memory_order::acquire) == 0;
+    }
+
+    /// Forgets the pipelines this pipeline has transitioned to
+    void ClearTransitions() noexcept {
+        transition_keys.clear();
+        transitions.clear();
+    }
+
     template <typename Spec>
     static auto MakeConfigureSpecFunc() {
         return [](GraphicsPipeline* pl, bool is_indexed) { pl->ConfigureImpl<Spec>(is_indexed); };
@@ -113,14 +180,38 @@ public:
         gpu_memory = gpu_memory_;
     }
 
+    /// Position of the pipeline in the eviction order of the pipeline cache
+    size_t lru_index{};
+    /// Estimated driver memory used by the pipeline in bytes
+    size_t memory_estimate{};
+
 private:
+    static constexpr size_t MAX_SPECIALIZED_VARIANTS = 4;
+
+    using SpecializedValues = std::array<u32, NUM_STAGES * Shader::Info::MAX_SPECIALIZED_CBUFS>;
+
+    /// Pipeline built with the constant buffer words read by control flow specialized
+    struct SpecializedVariant {
+        SpecializedValues values{};
+        vk::Pipeline pipeline;
+        std::atomic_bool is_built{false};
+    };
+
     template <typename Spec>
     void ConfigureImpl(bool is_indexed);
 
+    /// Returns the variant specialized for the current constant buffer values, or null when the
+    /// generic pipeline has to be used. Queues the build of new variants.
+    [[nodiscard]] SpecializedVariant* SelectSpecializedVariant();
+
     void ConfigureDraw(const RescalingPushConstant& rescaling,
                        const RenderAreaPushConstant& render_are);
 
-    void MakePipeline(VkRenderPass render_pass);
+    void MakePipeline(VkRenderPass render_pass, const RenderingFormats* rendering_formats,
+                      SpecializedVariant* variant = nullptr);
+
+    /// Fast-links the pipeline from libraries and queues its optimized link
+    void LinkPipeline(const VkGraphicsPipelineCreateInfo& pipeline_ci);
 
     void Validate();
 
@@ -133,6 +224,9 @@ private:
     vk::PipelineCache& pipeline_cache;
     Scheduler& scheduler;
     GuestDescriptorQueue& guest_descriptor_queue;
+    PipelineLibraryCache* library_cache;
+    DescriptorBuffer* descriptor_buffer;
+    Common::ThreadWorker* worker_thread;
 
     void (*configure_func)(GraphicsPipeline*, bool){};
 
@@ -148,14 +242,34 @@ private:
 
     vk::DescriptorSetLayout descriptor_set_layout;
     DescriptorAllocator descriptor_allocator;
+    DescriptorBufferLayout descriptor_buffer_layout;
     vk::PipelineLayout pipeline_layout;
     vk::DescriptorUpdateTemplate descriptor_update_template;
     vk::Pipeline pipeline;
 
+    // Used when the pipeline is linked from libraries, the fast-linked pipeline is kept alive
+    // after the optimized one replaces it as it may still be in use by the GPU
+    vk::Pipeline vertex_input_library;
+    vk::Pipeline fragment_output_library;
+    vk::Pipeline optimized_pipeline;
+    std::atomic<VkPipeline> pipeline_handle{};
+
     std::condition_variable build_condvar;
     std::mutex build_mutex;
     std::atomic_bool is_built{false};
+    std::atomic_bool is_linking{false};
+    std::chrono::steady_clock::duration build_time{};
     bool uses_push_descriptor{false};
+
+    // Render pass state of the first build, reused when building specialized variants
+    VkRenderPass built_render_pass{};
+    const RenderingFormats* built_rendering_formats{};
+
+    size_t num_specialized_cbufs{};
+    std::array<std::unique_ptr<SpecializedVariant>, MAX_SPECIALIZED_VARIANTS> variants;
+    size_t num_variants{};
+    const SpecializedVariant* bound_variant{};
+    std::atomic<u32> num_building_variants{};
 };
 
 } // namespace Vulkan
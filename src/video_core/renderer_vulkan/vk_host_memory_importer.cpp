@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/renderer_vulkan/vk_host_memory_importer.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+namespace {
+using namespace Common::Literals;
+
+constexpr VkDeviceSize WINDOW_SIZE = 16_MiB;
+constexpr VkExternalMemoryHandleTypeFlagBits HANDLE_TYPE =
+    VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+} // Anonymous namespace
+
+HostMemoryImporter::HostMemoryImporter(const Device& device_) : device{device_} {
+    if (!Settings::values.use_host_memory_import.GetValue() ||
+        !device.IsExtExternalMemoryHostSupported()) {
+        return;
+    }
+    const VkDeviceSize alignment = device.GetMinImportedHostPointerAlignment();
+    if (alignment == 0 || WINDOW_SIZE % alignment != 0) {
+        LOG_WARNING(Render_Vulkan, "Unsupported imported host pointer alignment {}", alignment);
+        return;
+    }
+    is_supported = true;
+}
+
+HostMemoryImporter::~HostMemoryImporter() = default;
+
+std::optional<HostMemoryImport> HostMemoryImporter::Import(const u8* pointer, size_t size) {
+    if (!is_supported) {
+        return std::nullopt;
+    }
+    const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    const uintptr_t base = Common::AlignDown(address, WINDOW_SIZE);
+    if (address + size > base + WINDOW_SIZE) {
+        return std::nullopt;
+    }
+    auto [it, is_new] = windows.try_emplace(base);
+    if (is_new) {
+        it->second = CreateWindow(base);
+    }
+    if (!it->second.buffer) {
+        return std::nullopt;
+    }
+    return HostMemoryImport{
+        .buffer = *it->second.buffer,
+        .offset = static_cast<VkDeviceSize>(address - base),
+    };
+}
+
+HostMemoryImporter::Window HostMemoryImporter::CreateWindow(uintptr_t base) const {
+    const vk::Device& dev = device.GetLogical();
+    const void* const host_pointer = reinterpret_cast<const void*>(base);
+
+    VkMemoryHostPointerPropertiesEXT host_properties;
+    if (dev.GetMemoryHostPointerPropertiesEXT(HANDLE_TYPE, host_pointer, host_properties) !=
+            VK_SUCCESS ||
+        host_properties.memoryTypeBits == 0) {
+        return {};
+    }
+    const VkExternalMemoryBufferCreateInfo external_ci{
+        .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .handleTypes = HANDLE_TYPE,
+    };
+    vk::ExternalBuffer buffer = dev.CreateExternalBuffer({
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = &external_ci,
+        .flags = 0,
+        .size = WINDOW_SIZE,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    });
+    const VkMemoryRequirements requirements = dev.GetBufferMemoryRequirements(*buffer);
+    const u32 type_mask = requirements.memoryTypeBits & host_properties.memoryTypeBits;
+    if (type_mask == 0) {
+        return {};
+    }
+    const VkImportMemoryHostPointerInfoEXT import_info{
+        .sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT,
+        .pNext = nullptr,
+        .handleType = HANDLE_TYPE,
+        .pHostPointer = const_cast<void*>(host_pointer),
+    };
+    vk::DeviceMemory memory = dev.TryAllocateMemory({
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = &import_info,
+        .allocationSize = WINDOW_SIZE,
+        .memoryTypeIndex = static_cast<u32>(std::countr_zero(type_mask)),
+    });
+    if (!memory) {
+        LOG_WARNING(Render_Vulkan, "Failed to import host memory at 0x{:x}", base);
+        return {};
+    }
+    buffer.BindMemory(*memory, 0);
+    if (device.HasDebuggingToolAttached()) {
+        buffer.SetObjectNameEXT(fmt::format("Host memory 0x{:x}", base).c_str());
+    }
+    return Window{
+        .memory = std::move(memory),
+        .buffer = std::move(buffer),
+    };
+}
+
+} // namespace Vulkan
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+
+struct HostMemoryImport {
+    VkBuffer buffer;
+    VkDeviceSize offset;
+};
+
+/**
+ * Imports host memory as transfer source buffers through VK_EXT_external_memory_host.
+ * Memory is imported in fixed size windows the first time a pointer inside of them is requested,
+ * and windows stay imported for the lifetime of the importer.
+ */
+class HostMemoryImporter {
+public:
+    explicit HostMemoryImporter(const Device& device);
+    ~HostMemoryImporter();
+
+    HostMemoryImporter(const HostMemoryImporter&) = delete;
+    HostMemoryImporter& operator=(const HostMemoryImporter&) = delete;
+
+    /// Returns a buffer aliasing the given host range, or nullopt when it can't be imported
+    [[nodiscard]] std::optional<HostMemoryImport> Import(const u8* pointer, size_t size);
+
+    [[nodiscard]] bool IsSupported() const noexcept {
+        return is_supported;
+    }
+
+private:
+    struct Window {
+        vk::DeviceMemory memory;
+        vk::ExternalBuffer buffer;
+    };
+
+    Window CreateWindow(uintptr_t base) const;
+
+    const Device& device;
+    std::unordered_map<uintptr_t, Window> windows;
+    bool is_supported{};
+};
+
+} // namespace Vulkan
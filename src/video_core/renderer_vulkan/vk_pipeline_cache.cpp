@@ -2,9 +2,15 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -12,8 +18,10 @@
 #include "common/cityhash.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/literals.h"
 #include "common/microprofile.h"
 #include "common/thread_worker.h"
+#include "common/zstd_compression.h"
 #include "core/core.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/environment.h"
@@ -36,6 +44,7 @@
 #include "video_core/shader_cache.h"
 #include "video_core/shader_environment.h"
 #include "video_core/shader_notify.h"
+#include "video_core/spirv_optimizer.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -45,6 +54,7 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 namespace {
 using Shader::Backend::SPIRV::EmitSPIRV;
 using Shader::Maxwell::ConvertLegacyToGeneric;
+using Shader::Maxwell::EliminateDeadVaryings;
 using Shader::Maxwell::GenerateGeometryPassthrough;
 using Shader::Maxwell::MergeDualVertexPrograms;
 using Shader::Maxwell::TranslateProgram;
@@ -53,8 +63,19 @@ using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
 
-constexpr u32 CACHE_VERSION = 11;
+constexpr u32 CACHE_VERSION = 13;
+constexpr u32 SPIRV_MODULE_CACHE_VERSION = 4;
+constexpr u32 PIPELINE_USAGE_VERSION = 2;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
+// Driver caches compressed with zstd, files with the magic number above are read as they are
+constexpr std::array<char, 8> VULKAN_CACHE_ZSTD_MAGIC{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'z'};
+
+using namespace Common::Literals;
+
+// Rough estimate of the driver memory used by a pipeline, drivers don't report it. Compiled code
+// is usually a few times larger than its SPIR-V and there's a fixed cost per pipeline.
+constexpr u64 PIPELINE_BASE_MEMORY = 32_KiB;
+constexpr u64 PIPELINE_CODE_MEMORY_FACTOR = 4;
 
 template <typename Container>
 auto MakeSpan(Container& container) {
@@ -278,6 +299,89 @@ size_t GetTotalPipelineWorkers() {
 #endif
 }
 
+/// Runs the given jobs on the workers and waits for them. The calling thread runs the jobs no
+/// worker has picked up yet, so it never waits behind unrelated work queued on the workers and it
+/// can't deadlock when it is a worker itself. Exceptions thrown by jobs are rethrown here.
+void RunInParallel(Common::ThreadWorker& workers, std::vector<std::function<void()>> jobs) {
+    struct State {
+        std::vector<std::function<void()>> jobs;
+        std::unique_ptr<std::atomic_bool[]> claimed;
+        std::vector<std::exception_ptr> exceptions;
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t num_done{};
+    };
+    const size_t num_jobs{jobs.size()};
+    const auto state{std::make_shared<State>()};
+    state->jobs = std::move(jobs);
+    state->claimed = std::make_unique<std::atomic_bool[]>(num_jobs);
+    state->exceptions.resize(num_jobs);
+
+    const auto run{[](State& job_state, size_t index) {
+        if (job_state.claimed[index].exchange(true)) {
+            return;
+        }
+        try {
+            job_state.jobs[index]();
+        } catch (...) {
+            job_state.exceptions[index] = std::current_exception();
+        }
+        {
+            std::scoped_lock lock{job_state.mutex};
+            ++job_state.num_done;
+        }
+        job_state.cv.notify_all();
+    }};
+    // The first job is always run by the calling thread
+    for (size_t index = 1; index < num_jobs; ++index) {
+        workers.QueueWork([state, index, run] { run(*state, index); });
+    }
+    for (size_t index = 0; index < num_jobs; ++index) {
+        run(*state, index);
+    }
+    std::unique_lock lock{state->mutex};
+    state->cv.wait(lock, [&] { return state->num_done == num_jobs; });
+    for (const std::exception_ptr& exception : state->exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+u64 ShaderSetHash(const GraphicsPipelineCacheKey& key) {
+    return Common::CityHash64(reinterpret_cast<const char*>(key.unique_hashes.data()),
+                              sizeof(key.unique_hashes));
+}
+
+/// Returns true when a pipeline built for candidate can draw an approximation of key.
+/// Render target formats and the state the shaders were translated for have to match, the
+/// fixed function state that is still baked in the pipeline may differ.
+bool IsFallbackCompatible(const GraphicsPipelineCacheKey& candidate,
+                          const GraphicsPipelineCacheKey& key) {
+    if (candidate.unique_hashes != key.unique_hashes) {
+        return false;
+    }
+    FixedPipelineState lhs{candidate.state};
+    FixedPipelineState rhs{key.state};
+    lhs.polygon_mode.Assign(0);
+    rhs.polygon_mode.Assign(0);
+    return lhs.raw1 == rhs.raw1 && lhs.color_formats == rhs.color_formats &&
+           lhs.depth_enabled.Value() == rhs.depth_enabled.Value() &&
+           lhs.depth_format.Value() == rhs.depth_format.Value() &&
+           lhs.y_negate.Value() == rhs.y_negate.Value();
+}
+
+/// Returns the stages whose pipelines can require subgroups as wide as the guest warp
+u32 GuestWarpSizeStages(const Device& device) {
+    u32 stages{};
+    for (u32 index = 0; index < Shader::MaxStageTypes; ++index) {
+        const Shader::Stage stage{static_cast<Shader::Stage>(index)};
+        if (device.IsGuestWarpSizeSupported(MaxwellToVK::ShaderStage(stage))) {
+            stages |= 1U << index;
+        }
+    }
+    return stages;
+}
 } // Anonymous namespace
 
 size_t ComputePipelineCacheKey::Hash() const noexcept {
@@ -309,10 +413,14 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
       render_pass_cache{render_pass_cache_}, buffer_cache{buffer_cache_},
       texture_cache{texture_cache_}, shader_notify{shader_notify_},
       use_asynchronous_shaders{Settings::values.use_asynchronous_shaders.GetValue()},
+      use_asynchronous_shader_fallback{
+          Settings::values.use_asynchronous_shader_fallback.GetValue()},
       use_vulkan_pipeline_cache{Settings::values.use_vulkan_driver_pipeline_cache.GetValue()},
+      record_shader_stalls{Settings::values.record_shader_stalls.GetValue()},
       workers(device.HasBrokenParallelShaderCompiling() ? 1ULL : GetTotalPipelineWorkers(),
               "VkPipelineBuilder"),
-      serialization_thread(1, "VkPipelineSerialization") {
+      serialization_thread(1, "VkPipelineSerialization"),
+      background_tasks(Common::TaskPriority::Idle) {
     const auto& float_control{device.FloatControlProperties()};
     const VkDriverId driver_id{device.GetDriverID()};
     profile = Shader::Profile{
@@ -355,6 +463,7 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .support_geometry_streams = device.AreTransformFeedbackGeometryStreamsSupported(),
 
         .warp_size_potentially_larger_than_guest = device.IsWarpSizePotentiallyBiggerThanGuest(),
+        .guest_warp_size_stages = GuestWarpSizeStages(device),
 
         .lower_left_origin_mode = false,
         .need_declared_frag_colors = false,
@@ -390,6 +499,7 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .min_ssbo_alignment = static_cast<u32>(device.GetStorageBufferAlignment()),
         .support_geometry_shader_passthrough = device.IsNvGeometryShaderPassthroughSupported(),
         .support_conditional_barrier = device.SupportsConditionalBarriers(),
+        .support_cbuf_specialization = Settings::values.use_cbuf_specialization.GetValue(),
     };
 
     if (device.GetMaxVertexInputAttributes() < Maxwell::NumVertexAttributes) {
@@ -407,11 +517,21 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
         .has_extended_dynamic_state_2_extra = device.IsExtExtendedDynamicState2ExtrasSupported(),
         .has_extended_dynamic_state_3_blend = device.IsExtExtendedDynamicState3BlendingSupported(),
         .has_extended_dynamic_state_3_enables = device.IsExtExtendedDynamicState3EnablesSupported(),
+        .has_extended_dynamic_state_3_rasterization =
+            device.IsExtExtendedDynamicState3RasterizationSupported(),
         .has_dynamic_vertex_input = device.IsExtVertexInputDynamicStateSupported(),
     };
+    if (device.IsExtGraphicsPipelineLibrarySupported()) {
+        library_cache = std::make_unique<PipelineLibraryCache>();
+    }
 }
 
 PipelineCache::~PipelineCache() {
+    if (record_shader_stalls && title_id != 0) {
+        RecordBuiltMisses();
+        shader_notify.WriteStallReport(title_id);
+    }
+    pipeline_usage.Save();
     if (use_vulkan_pipeline_cache && !vulkan_pipeline_cache_filename.empty()) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
                                      CACHE_VERSION);
@@ -431,6 +551,7 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipeline() {
         GraphicsPipeline* const next{current_pipeline->Next(graphics_key)};
         if (next) {
             current_pipeline = next;
+            lru_cache.Touch(current_pipeline->lru_index, frame_tick);
             return BuiltPipeline(current_pipeline);
         }
     }
@@ -453,14 +574,28 @@ ComputePipeline* PipelineCache::CurrentComputePipeline() {
     const auto [pair, is_new]{compute_cache.try_emplace(key)};
     auto& pipeline{pair->second};
     if (!is_new) {
+        if (pipeline) {
+            lru_cache.Touch(pipeline->lru_index, frame_tick);
+        }
         return pipeline.get();
     }
+    const auto translate_start{std::chrono::steady_clock::now()};
     pipeline = CreateComputePipeline(key, shader);
+    if (pipeline) {
+        TrackPipeline(pair->first, pipeline.get());
+        if (record_shader_stalls) {
+            // Dispatches always wait for their pipeline
+            AddPendingMiss(pipeline.get(), std::span{&key.unique_hash, 1},
+                           VideoCore::ShaderStall::Blocked,
+                           std::chrono::steady_clock::now() - translate_start);
+        }
+    }
     return pipeline.get();
 }
 
-void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+void PipelineCache::LoadDiskResources(u64 title_id_, std::stop_token stop_loading,
                                       const VideoCore::DiskResourceLoadCallback& callback) {
+    title_id = title_id_;
     if (title_id == 0) {
         return;
     }
@@ -471,6 +606,18 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         return;
     }
     pipeline_cache_filename = base_dir / "vulkan.bin";
+    pipeline_usage.Load(base_dir / "vulkan_usage.bin", PIPELINE_USAGE_VERSION);
+
+    // Emitted modules depend on the device profile, share them between titles per device
+    const auto spirv_dir{shader_dir / "spirv"};
+    if (Common::FS::CreateDir(spirv_dir)) {
+        const std::string device_identity{fmt::format(
+            "{}:{}:{:08x}:{:08x}", device.GetModelName(), static_cast<u32>(device.GetDriverID()),
+            device.GetDriverVersion(), device.ApiVersion())};
+        const u64 device_hash{Common::CityHash64(device_identity.data(), device_identity.size())};
+        spirv_module_cache.Load(spirv_dir / fmt::format("{:016x}.bin", device_hash),
+                                SPIRV_MODULE_CACHE_VERSION);
+    }
 
     if (use_vulkan_pipeline_cache) {
         vulkan_pipeline_cache_filename = base_dir / "vulkan_pipelines.bin";
@@ -489,7 +636,7 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
+    const auto load_compute{[&](std::istream& file, FileEnvironment env) {
         ComputePipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
@@ -507,7 +654,13 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
+    struct GraphicsEntry {
+        GraphicsPipelineCacheKey key;
+        std::vector<FileEnvironment> envs;
+        std::optional<VideoCommon::PipelineUsageTracker::Usage> usage;
+    };
+    std::vector<GraphicsEntry> graphics_entries;
+    const auto load_graphics{[&](std::istream& file, std::vector<FileEnvironment> envs) {
         GraphicsPipelineCacheKey key;
         file.read(reinterpret_cast<char*>(&key), sizeof(key));
 
@@ -521,10 +674,44 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
                 dynamic_features.has_extended_dynamic_state_3_blend ||
             (key.state.extended_dynamic_state_3_enables != 0) !=
                 dynamic_features.has_extended_dynamic_state_3_enables ||
+            (key.state.extended_dynamic_state_3_rasterization != 0) !=
+                dynamic_features.has_extended_dynamic_state_3_rasterization ||
             (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
+        graphics_entries.push_back({
+            .key = key,
+            .envs = std::move(envs),
+            .usage = pipeline_usage.Find(key.Hash()),
+        });
+    }};
+    VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
+                               load_graphics);
+
+    // Pipelines used early by the previous session are built before booting, in the order they
+    // were needed. The rest are built in the background, most frequently used first.
+    const u64 warmup_ms{Settings::values.pipeline_warmup_seconds.GetValue() * 1000ULL};
+    const auto is_warm{[&](const GraphicsEntry& entry) {
+        if (warmup_ms == 0 || !pipeline_usage.HasHistory()) {
+            return true;
+        }
+        return entry.usage && entry.usage->first_use_ms <= warmup_ms;
+    }};
+    const auto cold_begin{std::stable_partition(graphics_entries.begin(), graphics_entries.end(),
+                                                is_warm)};
+    std::stable_sort(graphics_entries.begin(), cold_begin, [](const auto& lhs, const auto& rhs) {
+        const u32 lhs_ms{lhs.usage ? lhs.usage->first_use_ms : 0};
+        const u32 rhs_ms{rhs.usage ? rhs.usage->first_use_ms : 0};
+        return lhs_ms < rhs_ms;
+    });
+    std::stable_sort(cold_begin, graphics_entries.end(), [](const auto& lhs, const auto& rhs) {
+        const u32 lhs_hits{lhs.usage ? lhs.usage->hit_count : 0};
+        const u32 rhs_hits{rhs.usage ? rhs.usage->hit_count : 0};
+        return lhs_hits > rhs_hits;
+    });
+    for (auto it = graphics_entries.begin(); it != cold_begin; ++it) {
+        workers.QueueWork([this, key = it->key, envs_ = std::move(it->envs), &state,
+                           &callback]() mutable {
             ShaderPools pools;
             boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
             for (auto& env : envs_) {
@@ -543,11 +730,11 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
             }
         });
         ++state.total;
-    }};
-    VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
-                               load_graphics);
+    }
+    const size_t num_background{static_cast<size_t>(graphics_entries.end() - cold_begin)};
 
-    LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}", state.total);
+    LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}, building {} in the background",
+             state.total + num_background, num_background);
 
     std::unique_lock lock{state.mutex};
     callback(VideoCore::LoadCallbackStage::Build, 0, state.total);
@@ -556,6 +743,38 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
 
     workers.WaitForRequests(stop_loading);
 
+    for (const auto& [key, pipeline] : compute_cache) {
+        if (pipeline) {
+            TrackPipeline(key, pipeline.get());
+        }
+    }
+    for (const auto& [key, pipeline] : graphics_cache) {
+        if (pipeline) {
+            TrackPipeline(key, pipeline.get());
+        }
+    }
+
+    for (auto it = cold_begin; it != graphics_entries.end(); ++it) {
+        if (stop_loading.stop_requested()) {
+            break;
+        }
+        background_tasks.Run([this, key = it->key, envs_ = std::move(it->envs)]() mutable {
+            ShaderPools pools;
+            boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+            for (auto& env : envs_) {
+                env_ptrs.push_back(&env);
+            }
+            auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs), nullptr, false)};
+            if (!pipeline) {
+                return;
+            }
+            std::scoped_lock lock{background_mutex};
+            background_pipelines.emplace_back(key, std::move(pipeline));
+            has_background_pipelines.store(true, std::memory_order_release);
+        });
+    }
+    pipeline_usage.StartSession();
+
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
                                      CACHE_VERSION);
@@ -567,22 +786,225 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
 }
 
 GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
+    if (has_background_pipelines.load(std::memory_order_acquire)) {
+        MergeBackgroundPipelines();
+    }
+    pipeline_usage.RecordUse(graphics_key.Hash());
+
     const auto [pair, is_new]{graphics_cache.try_emplace(graphics_key)};
     auto& pipeline{pair->second};
+    std::chrono::steady_clock::duration translate_time{};
     if (is_new) {
+        const auto translate_start{std::chrono::steady_clock::now()};
         pipeline = CreateGraphicsPipeline();
+        translate_time = std::chrono::steady_clock::now() - translate_start;
+        if (pipeline) {
+            TrackPipeline(pair->first, pipeline.get());
+        }
     }
     if (!pipeline) {
         return nullptr;
     }
+    lru_cache.Touch(pipeline->lru_index, frame_tick);
     if (current_pipeline) {
         current_pipeline->AddTransition(pipeline.get());
     }
     current_pipeline = pipeline.get();
-    return BuiltPipeline(current_pipeline);
+    GraphicsPipeline* const built_pipeline{BuiltPipeline(current_pipeline)};
+    if (is_new && record_shader_stalls) {
+        VideoCore::ShaderStall stall{VideoCore::ShaderStall::Blocked};
+        if (!built_pipeline) {
+            stall = VideoCore::ShaderStall::Skipped;
+        } else if (built_pipeline != current_pipeline) {
+            stall = VideoCore::ShaderStall::Fallback;
+        }
+        AddPendingMiss(current_pipeline, graphics_key.unique_hashes, stall, translate_time);
+    }
+    return built_pipeline;
+}
+
+void PipelineCache::MergeBackgroundPipelines() {
+    std::scoped_lock lock{background_mutex};
+    for (auto& [key, pipeline] : background_pipelines) {
+        // Pipelines needed before their background build finished were built on demand
+        const auto [it, is_new]{graphics_cache.try_emplace(key, std::move(pipeline))};
+        if (is_new) {
+            TrackPipeline(it->first, it->second.get());
+        }
+    }
+    background_pipelines.clear();
+    has_background_pipelines.store(false, std::memory_order_relaxed);
+}
+
+void PipelineCache::TrackPipeline(const GraphicsPipelineCacheKey& key,
+                                  GraphicsPipeline* pipeline) {
+    pipeline->lru_index = lru_cache.Insert(&key, frame_tick);
+    pipeline_memory += pipeline->memory_estimate;
+    shader_set_pipelines[ShaderSetHash(key)].push_back(pipeline);
+}
+
+void PipelineCache::TrackPipeline(const ComputePipelineCacheKey& key, ComputePipeline* pipeline) {
+    pipeline->lru_index = lru_cache.Insert(&key, frame_tick);
+    pipeline_memory += pipeline->memory_estimate;
+}
+
+void PipelineCache::TickFrame() {
+    if (!pending_misses.empty()) {
+        RecordBuiltMisses();
+    }
+    ++frame_tick;
+    sentenced_graphics_pipelines.Tick();
+    sentenced_compute_pipelines.Tick();
+
+    const u64 budget{static_cast<u64>(Settings::values.pipeline_cache_budget.GetValue()) * 1_MiB};
+    if (budget == 0 || pipeline_memory <= budget) {
+        return;
+    }
+    // Leave some headroom so eviction doesn't run on every frame
+    EvictPipelines(budget - budget / 8);
+}
+
+void PipelineCache::ReleasePipelines() {
+    // Pipelines being built read the resolution scale
+    workers.WaitForRequests();
+    background_tasks.Cancel();
+    background_tasks.Wait();
+    {
+        std::scoped_lock lock{background_mutex};
+        background_pipelines.clear();
+        has_background_pipelines.store(false, std::memory_order_relaxed);
+    }
+    if (library_cache) {
+        // Joins the link thread before the pipelines it links are released
+        library_cache = std::make_unique<PipelineLibraryCache>();
+    }
+    RecordBuiltMisses();
+    pending_misses.clear();
+
+    size_t num_released{};
+    for (auto& [key, pipeline] : graphics_cache) {
+        if (!pipeline) {
+            continue;
+        }
+        lru_cache.Free(pipeline->lru_index);
+        // They are still in the disk cache, don't serialize them again when rebuilt
+        evicted_graphics_keys.insert(key);
+        sentenced_graphics_pipelines.Push(std::move(pipeline));
+        ++num_released;
+    }
+    for (auto& [key, pipeline] : compute_cache) {
+        if (!pipeline) {
+            continue;
+        }
+        lru_cache.Free(pipeline->lru_index);
+        evicted_compute_keys.insert(key);
+        sentenced_compute_pipelines.Push(std::move(pipeline));
+        ++num_released;
+    }
+    graphics_cache.clear();
+    compute_cache.clear();
+    shader_set_pipelines.clear();
+    current_pipeline = nullptr;
+    pipeline_memory = 0;
+    LOG_INFO(Render_Vulkan, "Released {} pipelines built for the previous resolution scale",
+             num_released);
+}
+
+void PipelineCache::EvictPipelines(u64 target_memory) {
+    if (frame_tick < TICKS_TO_DESTROY) {
+        return;
+    }
+    size_t num_evicted{};
+    const auto evict{[&](const LRUTicksTraits::ObjectType& object) {
+        if (pipeline_memory <= target_memory) {
+            return;
+        }
+        if (const auto* const graphics_key_ptr{std::get_if<0>(&object)}) {
+            const auto it{graphics_cache.find(**graphics_key_ptr)};
+            GraphicsPipeline* const pipeline{it->second.get()};
+            if (pipeline == current_pipeline || !pipeline->IsIdle() || IsMissPending(pipeline)) {
+                return;
+            }
+            lru_cache.Free(pipeline->lru_index);
+            pipeline_memory -= pipeline->memory_estimate;
+            const auto set_it{shader_set_pipelines.find(ShaderSetHash(it->first))};
+            std::erase(set_it->second, pipeline);
+            if (set_it->second.empty()) {
+                shader_set_pipelines.erase(set_it);
+            }
+            evicted_graphics_keys.insert(it->first);
+            sentenced_graphics_pipelines.Push(std::move(it->second));
+            graphics_cache.erase(it);
+        } else {
+            const auto it{compute_cache.find(*std::get<1>(object))};
+            ComputePipeline* const pipeline{it->second.get()};
+            if (!pipeline->IsBuilt() || IsMissPending(pipeline)) {
+                return;
+            }
+            lru_cache.Free(pipeline->lru_index);
+            pipeline_memory -= pipeline->memory_estimate;
+            evicted_compute_keys.insert(it->first);
+            sentenced_compute_pipelines.Push(std::move(it->second));
+            compute_cache.erase(it);
+        }
+        ++num_evicted;
+    }};
+    // Pipelines used in the last few frames may still be in use by the GPU
+    lru_cache.ForEachItemBelow(frame_tick - TICKS_TO_DESTROY, evict);
+    if (num_evicted == 0) {
+        return;
+    }
+    // Transitions may point to evicted pipelines, they are rebuilt on the slow path
+    for (const auto& [key, pipeline] : graphics_cache) {
+        if (pipeline) {
+            pipeline->ClearTransitions();
+        }
+    }
+    num_evictions += num_evicted;
+    LOG_INFO(Render_Vulkan, "Evicted {} pipelines, {} evictions and {} rebuilds in this session",
+             num_evicted, num_evictions, num_rebuilds);
 }
 
-GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const noexcept {
+void PipelineCache::AddPendingMiss(std::variant<GraphicsPipeline*, ComputePipeline*> pipeline,
+                                   std::span<const u64> stage_hashes,
+                                   VideoCore::ShaderStall stall,
+                                   std::chrono::steady_clock::duration translate_time) {
+    VideoCore::PipelineMiss miss{
+        .frame = frame_tick,
+        .stage_hashes{},
+        .is_compute = std::holds_alternative<ComputePipeline*>(pipeline),
+        .stall = stall,
+        .translate_ms = std::chrono::duration<float, std::milli>(translate_time).count(),
+        .build_ms = 0.0f,
+    };
+    std::ranges::copy(stage_hashes, miss.stage_hashes.begin());
+    pending_misses.push_back({pipeline, miss});
+}
+
+void PipelineCache::RecordBuiltMisses() {
+    std::erase_if(pending_misses, [this](PendingMiss& pending) {
+        return std::visit(
+            [&](auto* pipeline) {
+                if (!pipeline->IsBuilt()) {
+                    return false;
+                }
+                pending.miss.build_ms =
+                    std::chrono::duration<float, std::milli>(pipeline->BuildTime()).count();
+                shader_notify.RecordPipelineMiss(pending.miss);
+                return true;
+            },
+            pending.pipeline);
+    });
+}
+
+bool PipelineCache::IsMissPending(const void* pipeline) const noexcept {
+    return std::ranges::any_of(pending_misses, [pipeline](const PendingMiss& pending) {
+        return std::visit([pipeline](const auto* other) { return other == pipeline; },
+                          pending.pipeline);
+    });
+}
+
+GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) noexcept {
     if (pipeline->IsBuilt()) {
         return pipeline;
     }
@@ -592,7 +1014,7 @@ GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const
     // If something is using depth, we can assume that games are not rendering anything which
     // will be used one time.
     if (maxwell3d->regs.zeta_enable) {
-        return nullptr;
+        return use_asynchronous_shader_fallback ? FallbackPipeline(pipeline) : nullptr;
     }
     // If games are using a small index count, we can assume these are full screen quads.
     // Usually these shaders are only used once for building textures so we can assume they
@@ -601,6 +1023,22 @@ GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const
     if (draw_state.index_buffer.count <= 6 || draw_state.vertex_buffer.count <= 6) {
         return pipeline;
     }
+    return use_asynchronous_shader_fallback ? FallbackPipeline(pipeline) : nullptr;
+}
+
+GraphicsPipeline* PipelineCache::FallbackPipeline(const GraphicsPipeline* pipeline) noexcept {
+    const GraphicsPipelineCacheKey& key{pipeline->Key()};
+    const auto it{shader_set_pipelines.find(ShaderSetHash(key))};
+    if (it == shader_set_pipelines.end()) {
+        return nullptr;
+    }
+    for (GraphicsPipeline* const candidate : it->second) {
+        if (candidate != pipeline && candidate->IsBuilt() &&
+            IsFallbackCompatible(candidate->Key(), key)) {
+            lru_cache.Touch(candidate->lru_index, frame_tick);
+            return candidate;
+        }
+    }
     return nullptr;
 }
 
@@ -615,49 +1053,77 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
     const bool uses_vertex_a{key.unique_hashes[0] != 0};
     const bool uses_vertex_b{key.unique_hashes[1] != 0};
 
-    // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
-    Shader::IR::Program* layer_source_program{};
+    std::array<Shader::Environment*, Maxwell::MaxShaderProgram> stage_envs{};
 
+    // Stages are decoded, structured and optimized independently, only merging VertexA into
+    // VertexB and linking varyings depend on other stages.
+    Shader::IR::Program program_vb;
+    std::vector<std::function<void()>> jobs;
     for (size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
-        const bool is_emulated_stage = layer_source_program != nullptr &&
-                                       index == static_cast<u32>(Maxwell::ShaderType::Geometry);
-        if (key.unique_hashes[index] == 0 && is_emulated_stage) {
-            auto topology = MaxwellToOutputTopology(key.state.topology);
-            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
-                                                          *layer_source_program, topology);
-            continue;
-        }
         if (key.unique_hashes[index] == 0) {
             continue;
         }
         Shader::Environment& env{*envs[env_index]};
         ++env_index;
-
-        const u32 cfg_offset{static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
-        Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
-        if (!uses_vertex_a || index != 1) {
-            // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
-        } else {
-            // VertexB path when VertexA is present.
-            auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-            programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
-        }
-
-        if (Settings::values.dump_shaders) {
-            env.Dump(hash, key.unique_hashes[index]);
+        stage_envs[index] = &env;
+
+        const bool is_merged_vertex_b{uses_vertex_a && index == 1};
+        Shader::IR::Program& program{is_merged_vertex_b ? program_vb : programs[index]};
+        ShaderPools& stage_pools{build_in_parallel ? main_stage_pools[index] : pools};
+        jobs.push_back([this, &env, &program, &stage_pools, hash, index, &key] {
+            const u32 cfg_offset{
+                static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+            Shader::Maxwell::Flow::CFG cfg(env, stage_pools.flow_block, cfg_offset, index == 0);
+            program = TranslateProgram(stage_pools.inst, stage_pools.block, env, cfg, host_info);
+
+            if (Settings::values.dump_shaders) {
+                env.Dump(hash, key.unique_hashes[index]);
+            }
+        });
+    }
+    if (build_in_parallel && jobs.size() > 1) {
+        RunInParallel(workers, std::move(jobs));
+    } else {
+        for (const auto& job : jobs) {
+            job();
         }
+    }
+    if (uses_vertex_a && uses_vertex_b) {
+        // VertexB path when VertexA is present.
+        programs[1] = MergeDualVertexPrograms(programs[0], program_vb, *stage_envs[1]);
+    }
 
-        if (programs[index].info.requires_layer_emulation) {
+    // Layer passthrough generation for devices without VK_EXT_shader_viewport_index_layer
+    Shader::IR::Program* layer_source_program{};
+    const size_t geometry_index{static_cast<size_t>(Maxwell::ShaderType::Geometry)};
+    for (size_t index = 0; index < geometry_index; ++index) {
+        if (key.unique_hashes[index] != 0 && programs[index].info.requires_layer_emulation) {
             layer_source_program = &programs[index];
         }
     }
+    if (key.unique_hashes[geometry_index] == 0 && layer_source_program) {
+        auto topology = MaxwellToOutputTopology(key.state.topology);
+        programs[geometry_index] = GenerateGeometryPassthrough(
+            pools.inst, pools.block, host_info, *layer_source_program, topology);
+    }
+    const size_t fragment_index{static_cast<size_t>(Maxwell::ShaderType::Pixel)};
+    if (key.unique_hashes[fragment_index] != 0 && key.state.xfb_enabled == 0) {
+        // Drop the outputs of the last pre-rasterization stage that the fragment stage ignores
+        for (size_t index = fragment_index - 1; index > 0; --index) {
+            const bool is_emulated_stage{layer_source_program != nullptr &&
+                                         index == geometry_index};
+            if (key.unique_hashes[index] != 0 || is_emulated_stage) {
+                EliminateDeadVaryings(programs[index], programs[fragment_index]);
+                break;
+            }
+        }
+    }
     std::array<const Shader::Info*, Maxwell::MaxShaderStage> infos{};
     std::array<vk::ShaderModule, Maxwell::MaxShaderStage> modules;
 
     const Shader::IR::Program* previous_stage{};
     Shader::Backend::Bindings binding;
+    u64 code_size{};
     for (size_t index = uses_vertex_a && uses_vertex_b ? 1 : 0; index < Maxwell::MaxShaderProgram;
          ++index) {
         const bool is_emulated_stage = layer_source_program != nullptr &&
@@ -673,7 +1139,17 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
 
         const auto runtime_info{MakeRuntimeInfo(programs, key, program, previous_stage)};
         ConvertLegacyToGeneric(program, runtime_info);
-        const std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+
+        boost::container::static_vector<Shader::Environment*, 2> program_envs;
+        if (uses_vertex_a && index == 1) {
+            program_envs.push_back(stage_envs[0]);
+        }
+        if (stage_envs[index]) {
+            program_envs.push_back(stage_envs[index]);
+        }
+        const std::vector<u32> code{
+            EmitCachedSPIRV(MakeSpan(program_envs), runtime_info, program, binding)};
+        code_size += code.size() * sizeof(u32);
         device.SaveShader(code);
         modules[stage_index] = BuildShader(device, code);
         if (device.HasDebuggingToolAttached()) {
@@ -683,10 +1159,14 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         previous_stage = &program;
     }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
-    return std::make_unique<GraphicsPipeline>(
+    // Pipelines loaded from disk are not latency sensitive, build them monolithically
+    PipelineLibraryCache* const libraries{build_in_parallel ? library_cache.get() : nullptr};
+    auto pipeline{std::make_unique<GraphicsPipeline>(
         scheduler, buffer_cache, texture_cache, vulkan_pipeline_cache, &shader_notify, device,
-        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache, key,
-        std::move(modules), infos);
+        descriptor_pool, guest_descriptor_queue, thread_worker, statistics, render_pass_cache,
+        libraries, key, std::move(modules), infos)};
+    pipeline->memory_estimate = PIPELINE_BASE_MEMORY + code_size * PIPELINE_CODE_MEMORY_FACTOR;
+    return pipeline;
 
 } catch (const Shader::Exception& exception) {
     auto hash = key.Hash();
@@ -711,8 +1191,15 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     GetGraphicsEnvironments(environments, graphics_key.unique_hashes);
 
     main_pools.ReleaseContents();
+    for (ShaderPools& stage_pools : main_stage_pools) {
+        stage_pools.ReleaseContents();
+    }
     auto pipeline{
         CreateGraphicsPipeline(main_pools, graphics_key, environments.Span(), nullptr, true)};
+    if (evicted_graphics_keys.erase(graphics_key) != 0) {
+        ++num_rebuilds;
+        return pipeline;
+    }
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
@@ -738,6 +1225,10 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
 
     main_pools.ReleaseContents();
     auto pipeline{CreateComputePipeline(main_pools, key, env, nullptr, true)};
+    if (evicted_compute_keys.erase(key) != 0) {
+        ++num_rebuilds;
+        return pipeline;
+    }
     if (!pipeline || pipeline_cache_filename.empty()) {
         return pipeline;
     }
@@ -767,7 +1258,10 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     }
 
     auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
-    const std::vector<u32> code{EmitSPIRV(profile, program)};
+    Shader::Environment* const env_ptr{&env};
+    Shader::Backend::Bindings binding;
+    const std::vector<u32> code{
+        EmitCachedSPIRV(std::span(&env_ptr, 1), Shader::RuntimeInfo{}, program, binding)};
     device.SaveShader(code);
     vk::ShaderModule spv_module{BuildShader(device, code)};
     if (device.HasDebuggingToolAttached()) {
@@ -775,15 +1269,50 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
         spv_module.SetObjectNameEXT(name.c_str());
     }
     Common::ThreadWorker* const thread_worker{build_in_parallel ? &workers : nullptr};
-    return std::make_unique<ComputePipeline>(device, vulkan_pipeline_cache, descriptor_pool,
-                                             guest_descriptor_queue, thread_worker, statistics,
-                                             &shader_notify, program.info, std::move(spv_module));
+    auto pipeline{std::make_unique<ComputePipeline>(
+        device, vulkan_pipeline_cache, descriptor_pool, guest_descriptor_queue, thread_worker,
+        statistics, &shader_notify, program.info, std::move(spv_module))};
+    pipeline->memory_estimate =
+        PIPELINE_BASE_MEMORY + code.size() * sizeof(u32) * PIPELINE_CODE_MEMORY_FACTOR;
+    return pipeline;
 
 } catch (const Shader::Exception& exception) {
     LOG_ERROR(Render_Vulkan, "{}", exception.what());
     return nullptr;
 }
 
+std::vector<u32> PipelineCache::EmitCachedSPIRV(std::span<Shader::Environment* const> envs,
+                                               const Shader::RuntimeInfo& runtime_info,
+                                               Shader::IR::Program& program,
+                                               Shader::Backend::Bindings& binding) {
+    const std::optional<u64> module_key{
+        spirv_module_cache.IsLoaded()
+            ? VideoCommon::SpirvModuleCache::MakeKey(envs, runtime_info, program.info.stores,
+                                                     binding)
+            : std::nullopt};
+    if (module_key) {
+        if (auto code{spirv_module_cache.Find(*module_key, binding)}) {
+            return std::move(*code);
+        }
+    }
+    std::vector<u32> code{EmitSPIRV(profile, runtime_info, program, binding)};
+    if (module_key && spirv_module_cache.Add(*module_key, binding, code)) {
+        // Optimizing is too slow for the first build, only the copy written to disk is optimized
+        const bool optimize{Settings::values.optimize_spirv_cache.GetValue() &&
+                            VideoCommon::IsSpirvOptimizerAvailable()};
+        serialization_thread.QueueWork(
+            [this, module_key = *module_key, binding, code, optimize]() mutable {
+                if (optimize) {
+                    if (auto optimized{VideoCommon::OptimizeSpirv(code)}) {
+                        code = std::move(*optimized);
+                    }
+                }
+                spirv_module_cache.Serialize(module_key, binding, code);
+            });
+    }
+    return code;
+}
+
 void PipelineCache::SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                                  const vk::PipelineCache& pipeline_cache,
                                                  u32 cache_version) try {
@@ -794,17 +1323,25 @@ void PipelineCache::SerializeVulkanPipelineCache(const std::filesystem::path& fi
                   Common::FS::PathToUTF8String(filename));
         return;
     }
-    file.write(VULKAN_CACHE_MAGIC_NUMBER.data(), VULKAN_CACHE_MAGIC_NUMBER.size())
-        .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
-
     size_t cache_size = 0;
-    std::vector<char> cache_data;
+    std::vector<u8> cache_data;
     if (pipeline_cache) {
         pipeline_cache.Read(&cache_size, nullptr);
         cache_data.resize(cache_size);
         pipeline_cache.Read(&cache_size, cache_data.data());
+        cache_data.resize(cache_size);
+    }
+    std::vector<u8> compressed;
+    if (!cache_data.empty()) {
+        compressed =
+            Common::Compression::CompressDataZSTDDefault(cache_data.data(), cache_data.size());
     }
-    file.write(cache_data.data(), cache_size);
+    const bool is_compressed = !compressed.empty();
+    const auto& magic_number = is_compressed ? VULKAN_CACHE_ZSTD_MAGIC : VULKAN_CACHE_MAGIC_NUMBER;
+    const auto& stored = is_compressed ? compressed : cache_data;
+    file.write(magic_number.data(), magic_number.size())
+        .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version))
+        .write(reinterpret_cast<const char*>(stored.data()), stored.size());
 
     LOG_INFO(Render_Vulkan, "Vulkan driver pipelines cached at: {}",
              Common::FS::PathToUTF8String(filename));
@@ -841,10 +1378,12 @@ vk::PipelineCache PipelineCache::LoadVulkanPipelineCache(const std::filesystem::
         u32 cache_version;
         file.read(magic_number.data(), magic_number.size())
             .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-        if (magic_number != VULKAN_CACHE_MAGIC_NUMBER || cache_version != expected_cache_version) {
+        const bool is_compressed = magic_number == VULKAN_CACHE_ZSTD_MAGIC;
+        const bool is_valid = is_compressed || magic_number == VULKAN_CACHE_MAGIC_NUMBER;
+        if (!is_valid || cache_version != expected_cache_version) {
             file.close();
             if (Common::FS::RemoveFile(filename)) {
-                if (magic_number != VULKAN_CACHE_MAGIC_NUMBER) {
+                if (!is_valid) {
                     LOG_ERROR(Common_Filesystem, "Invalid Vulkan driver pipeline cache file");
                 }
                 if (cache_version != expected_cache_version) {
@@ -860,13 +1399,19 @@ vk::PipelineCache PipelineCache::LoadVulkanPipelineCache(const std::filesystem::
 
         static constexpr size_t header_size = magic_number.size() + sizeof(cache_version);
         const size_t cache_size = static_cast<size_t>(end) - header_size;
-        std::vector<char> cache_data(cache_size);
-        file.read(cache_data.data(), cache_size);
+        std::vector<u8> cache_data(cache_size);
+        file.read(reinterpret_cast<char*>(cache_data.data()), cache_size);
+        if (is_compressed) {
+            cache_data = Common::Compression::DecompressDataZSTD(cache_data);
+            if (cache_data.empty()) {
+                throw std::ios_base::failure("Failed to decompress Vulkan driver pipeline cache");
+            }
+        }
 
         LOG_INFO(Render_Vulkan,
                  "Loaded Vulkan driver pipeline cache: ", Common::FS::PathToUTF8String(filename));
 
-        return create_pipeline_cache(cache_size, cache_data.data());
+        return create_pipeline_cache(cache_data.size(), cache_data.data());
 
     } catch (const std::ios_base::failure& e) {
         LOG_ERROR(Common_Filesystem, "{}", e.what());
@@ -4,14 +4,22 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <variant>
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/lru_cache.h"
+#include "common/thread_pool.h"
 #include "common/thread_worker.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/value.h"
@@ -19,25 +27,33 @@
 #include "shader_recompiler/host_translate_info.h"
 #include "shader_recompiler/object_pool.h"
 #include "shader_recompiler/profile.h"
+#include "video_core/delayed_destruction_ring.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/pipeline_usage.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/shader_cache.h"
+#include "video_core/shader_notify.h"
+#include "video_core/spirv_module_cache.h"
 
 namespace Core {
 class System;
 }
 
-namespace Shader::IR {
-struct Program;
+namespace Shader {
+struct RuntimeInfo;
+}
+
+namespace Shader::Backend {
+struct Bindings;
 }
 
-namespace VideoCore {
-class ShaderNotify;
+namespace Shader::IR {
+struct Program;
 }
 
 namespace Vulkan {
@@ -113,10 +129,48 @@ public:
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback);
 
+    /// Evicts the least recently used pipelines when they exceed the memory budget
+    void TickFrame();
+
+    /// Drops every pipeline, called when the resolution scale changes as shaders embed it.
+    /// Waits for the pipelines being built, the GPU must be done with the current ones.
+    void ReleasePipelines();
+
 private:
+    static constexpr size_t TICKS_TO_DESTROY = 8;
+
+    struct LRUTicksTraits {
+        using ObjectType =
+            std::variant<const GraphicsPipelineCacheKey*, const ComputePipelineCacheKey*>;
+        using TickType = u64;
+    };
+
     [[nodiscard]] GraphicsPipeline* CurrentGraphicsPipelineSlowPath();
 
-    [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline) const noexcept;
+    [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline) noexcept;
+
+    /// Returns a built pipeline with the same shaders and render targets as the given one,
+    /// used to draw an approximation while the exact pipeline builds asynchronously
+    [[nodiscard]] GraphicsPipeline* FallbackPipeline(const GraphicsPipeline* pipeline) noexcept;
+
+    void MergeBackgroundPipelines();
+
+    /// Adds a cached pipeline to the eviction order
+    void TrackPipeline(const GraphicsPipelineCacheKey& key, GraphicsPipeline* pipeline);
+    void TrackPipeline(const ComputePipelineCacheKey& key, ComputePipeline* pipeline);
+
+    /// Evicts pipelines not used for a few frames until memory usage is below the given amount
+    void EvictPipelines(u64 target_memory);
+
+    /// Keeps a pipeline cache miss until its pipeline is built, when stalls are recorded
+    void AddPendingMiss(std::variant<GraphicsPipeline*, ComputePipeline*> pipeline,
+                        std::span<const u64> stage_hashes, VideoCore::ShaderStall stall,
+                        std::chrono::steady_clock::duration translate_time);
+
+    /// Hands the pending misses whose pipeline is built to the shader notifier
+    void RecordBuiltMisses();
+
+    [[nodiscard]] bool IsMissPending(const void* pipeline) const noexcept;
 
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
 
@@ -134,6 +188,11 @@ private:
                                                            PipelineStatistics* statistics,
                                                            bool build_in_parallel);
 
+    [[nodiscard]] std::vector<u32> EmitCachedSPIRV(std::span<Shader::Environment* const> envs,
+                                                   const Shader::RuntimeInfo& runtime_info,
+                                                   Shader::IR::Program& program,
+                                                   Shader::Backend::Bindings& binding);
+
     void SerializeVulkanPipelineCache(const std::filesystem::path& filename,
                                       const vk::PipelineCache& pipeline_cache, u32 cache_version);
 
@@ -149,15 +208,24 @@ private:
     TextureCache& texture_cache;
     VideoCore::ShaderNotify& shader_notify;
     bool use_asynchronous_shaders{};
+    bool use_asynchronous_shader_fallback{};
     bool use_vulkan_pipeline_cache{};
+    bool record_shader_stalls{};
 
     GraphicsPipelineCacheKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
 
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>> compute_cache;
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
+    // Graphics pipelines grouped by the hash of their shaders, used to find fallback pipelines
+    std::unordered_map<u64, std::vector<GraphicsPipeline*>> shader_set_pipelines;
+
+    // Destroyed before the pipelines, its link thread references them
+    std::unique_ptr<PipelineLibraryCache> library_cache;
 
     ShaderPools main_pools;
+    // Used by the stages of pipelines built on demand, which are translated in parallel
+    std::array<ShaderPools, Maxwell::MaxShaderProgram> main_stage_pools;
 
     Shader::Profile profile;
     Shader::HostTranslateInfo host_info;
@@ -167,9 +235,40 @@ private:
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
 
+    VideoCommon::SpirvModuleCache spirv_module_cache;
+    VideoCommon::PipelineUsageTracker pipeline_usage;
+
+    std::mutex background_mutex;
+    std::vector<std::pair<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>>>
+        background_pipelines;
+    std::atomic_bool has_background_pipelines{};
+
+    struct PendingMiss {
+        std::variant<GraphicsPipeline*, ComputePipeline*> pipeline;
+        VideoCore::PipelineMiss miss;
+    };
+    std::vector<PendingMiss> pending_misses;
+    u64 title_id{};
+
+    Common::LeastRecentlyUsedCache<LRUTicksTraits> lru_cache;
+    u64 frame_tick{};
+    u64 pipeline_memory{};
+    size_t num_evictions{};
+    size_t num_rebuilds{};
+    // Evicted pipelines are still in the disk cache, don't serialize them again when rebuilt
+    std::unordered_set<GraphicsPipelineCacheKey> evicted_graphics_keys;
+    std::unordered_set<ComputePipelineCacheKey> evicted_compute_keys;
+    VideoCommon::DelayedDestructionRing<std::unique_ptr<GraphicsPipeline>, TICKS_TO_DESTROY>
+        sentenced_graphics_pipelines;
+    VideoCommon::DelayedDestructionRing<std::unique_ptr<ComputePipeline>, TICKS_TO_DESTROY>
+        sentenced_compute_pipelines;
+
     Common::ThreadWorker workers;
     Common::ThreadWorker serialization_thread;
     DynamicFeatures dynamic_features;
+
+    // Declared last so it is waited on before the resources used by its tasks are destroyed
+    Common::TaskGroup background_tasks;
 };
 
 } // namespace Vulkan
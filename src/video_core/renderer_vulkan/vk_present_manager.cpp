@@ -5,6 +5,7 @@
 #include "common/settings.h"
 #include "common/thread.h"
 #include "core/frontend/emu_window.h"
+#include "video_core/gpu.h"
 #include "video_core/renderer_vulkan/vk_present_manager.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_swapchain.h"
@@ -15,9 +16,16 @@ namespace Vulkan {
 
 MICROPROFILE_DEFINE(Vulkan_WaitPresent, "Vulkan", "Wait For Present", MP_RGB(128, 128, 128));
 MICROPROFILE_DEFINE(Vulkan_CopyToSwapchain, "Vulkan", "Copy to swapchain", MP_RGB(192, 255, 192));
+MICROPROFILE_DEFINE(Vulkan_WaitDisplay, "Vulkan", "Wait For Display", MP_RGB(128, 128, 192));
 
 namespace {
 
+/// Presents that may wait to be displayed before the next frame starts rendering
+constexpr size_t MAX_PENDING_PRESENTS = 1;
+
+/// Nanoseconds to wait for a present to be displayed, presents that fail are never displayed
+constexpr u64 PRESENT_WAIT_TIMEOUT = 100'000'000;
+
 bool CanBlitToSwapchain(const vk::PhysicalDevice& physical_device, VkFormat format) {
     const VkFormatProperties props{physical_device.GetFormatProperties(format)};
     return (props.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT);
@@ -94,15 +102,85 @@ bool CanBlitToSwapchain(const vk::PhysicalDevice& physical_device, VkFormat form
 
 } // Anonymous namespace
 
+void CreateFrameImage(const Device& device, MemoryAllocator& memory_allocator, Frame* frame,
+                      u32 width, u32 height, VkFormat image_format, VkFormat image_view_format,
+                      VkRenderPass rd) {
+    auto& dld = device.GetLogical();
+
+    frame->width = width;
+    frame->height = height;
+
+    frame->image = memory_allocator.CreateImage({
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = image_format,
+        .extent =
+            {
+                .width = width,
+                .height = height,
+                .depth = 1,
+            },
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    });
+
+    frame->image_view = dld.CreateImageView({
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .image = *frame->image,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = image_view_format,
+        .components =
+            {
+                .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                .a = VK_COMPONENT_SWIZZLE_IDENTITY,
+            },
+        .subresourceRange =
+            {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+    });
+
+    const VkImageView image_view{*frame->image_view};
+    frame->framebuffer = dld.CreateFramebuffer({
+        .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .renderPass = rd,
+        .attachmentCount = 1,
+        .pAttachments = &image_view,
+        .width = width,
+        .height = height,
+        .layers = 1,
+    });
+}
+
 PresentManager::PresentManager(const vk::Instance& instance_,
                                Core::Frontend::EmuWindow& render_window_, const Device& device_,
                                MemoryAllocator& memory_allocator_, Scheduler& scheduler_,
-                               Swapchain& swapchain_, vk::SurfaceKHR& surface_)
+                               Swapchain& swapchain_, vk::SurfaceKHR& surface_, Tegra::GPU& gpu_)
     : instance{instance_}, render_window{render_window_}, device{device_},
       memory_allocator{memory_allocator_}, scheduler{scheduler_}, swapchain{swapchain_},
-      surface{surface_}, blit_supported{CanBlitToSwapchain(device.GetPhysical(),
-                                                           swapchain.GetImageViewFormat())},
-      use_present_thread{Settings::values.async_presentation.GetValue()} {
+      surface{surface_}, gpu{gpu_},
+      blit_supported{CanBlitToSwapchain(device.GetPhysical(), swapchain.GetImageViewFormat())},
+      use_present_thread{Settings::values.async_presentation.GetValue()},
+      use_low_latency{device.IsKhrPresentWaitSupported()} {
     SetImageCount();
 
     auto& dld = device.GetLogical();
@@ -140,6 +218,10 @@ PresentManager::PresentManager(const vk::Instance& instance_,
 PresentManager::~PresentManager() = default;
 
 Frame* PresentManager::GetRenderFrame() {
+    if (use_low_latency) {
+        WaitForDisplay();
+    }
+
     MICROPROFILE_SCOPE(Vulkan_WaitPresent);
 
     // Wait for free presentation frames
@@ -154,6 +236,7 @@ Frame* PresentManager::GetRenderFrame() {
     frame->present_done.Wait();
     frame->present_done.Reset();
 
+    frame->render_start = std::chrono::steady_clock::now();
     return frame;
 }
 
@@ -174,70 +257,8 @@ void PresentManager::Present(Frame* frame) {
 
 void PresentManager::RecreateFrame(Frame* frame, u32 width, u32 height, VkFormat image_view_format,
                                    VkRenderPass rd) {
-    auto& dld = device.GetLogical();
-
-    frame->width = width;
-    frame->height = height;
-
-    frame->image = memory_allocator.CreateImage({
-        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT,
-        .imageType = VK_IMAGE_TYPE_2D,
-        .format = swapchain.GetImageFormat(),
-        .extent =
-            {
-                .width = width,
-                .height = height,
-                .depth = 1,
-            },
-        .mipLevels = 1,
-        .arrayLayers = 1,
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .tiling = VK_IMAGE_TILING_OPTIMAL,
-        .usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 0,
-        .pQueueFamilyIndices = nullptr,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-    });
-
-    frame->image_view = dld.CreateImageView({
-        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .image = *frame->image,
-        .viewType = VK_IMAGE_VIEW_TYPE_2D,
-        .format = image_view_format,
-        .components =
-            {
-                .r = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .g = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-                .a = VK_COMPONENT_SWIZZLE_IDENTITY,
-            },
-        .subresourceRange =
-            {
-                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                .baseMipLevel = 0,
-                .levelCount = 1,
-                .baseArrayLayer = 0,
-                .layerCount = 1,
-            },
-    });
-
-    const VkImageView image_view{*frame->image_view};
-    frame->framebuffer = dld.CreateFramebuffer({
-        .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .renderPass = rd,
-        .attachmentCount = 1,
-        .pAttachments = &image_view,
-        .width = width,
-        .height = height,
-        .layers = 1,
-    });
+    CreateFrameImage(device, memory_allocator, frame, width, height, swapchain.GetImageFormat(),
+                     image_view_format, rd);
 }
 
 void PresentManager::WaitPresent() {
@@ -257,6 +278,25 @@ void PresentManager::WaitPresent() {
     std::scoped_lock swapchain_lock{swapchain_mutex};
 }
 
+void PresentManager::WaitForDisplay() {
+    MICROPROFILE_SCOPE(Vulkan_WaitDisplay);
+
+    // Frames still queued for the present thread have not been presented yet
+    WaitPresent();
+
+    std::scoped_lock lock{swapchain_mutex};
+    while (pending_presents.size() > MAX_PENDING_PRESENTS) {
+        const PendingPresent pending = pending_presents.front();
+        pending_presents.pop();
+        // Presents are waited on as soon as the next frame needs them, so the time the wait
+        // returns is the time the frame is displayed, unless it was displayed long before
+        if (swapchain.WaitForPresent(pending.present_id, PRESENT_WAIT_TIMEOUT)) {
+            gpu.RendererFramePresentedNotify(std::chrono::steady_clock::now() -
+                                             pending.render_start);
+        }
+    }
+}
+
 void PresentManager::PresentThread(std::stop_token token) {
     Common::SetCurrentThreadName("VulkanPresent");
     while (!token.stop_requested()) {
@@ -483,6 +523,14 @@ void PresentManager::CopyToSwapchainImpl(Frame* frame) {
 
     // Present
     swapchain.Present(render_semaphore);
+    gpu.RendererHostPresentNotify();
+
+    if (use_low_latency) {
+        pending_presents.push({
+            .present_id = swapchain.GetPresentId(),
+            .render_start = frame->render_start,
+        });
+    }
 }
 
 } // namespace Vulkan
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -16,6 +17,10 @@ namespace Core::Frontend {
 class EmuWindow;
 } // namespace Core::Frontend
 
+namespace Tegra {
+class GPU;
+}
+
 namespace Vulkan {
 
 class Device;
@@ -31,13 +36,19 @@ struct Frame {
     vk::CommandBuffer cmdbuf;
     vk::Semaphore render_ready;
     vk::Fence present_done;
+    std::chrono::steady_clock::time_point render_start;
 };
 
+/// Creates the image, view and framebuffer of a frame, the view may use a different format
+void CreateFrameImage(const Device& device, MemoryAllocator& memory_allocator, Frame* frame,
+                      u32 width, u32 height, VkFormat image_format, VkFormat image_view_format,
+                      VkRenderPass rd);
+
 class PresentManager {
 public:
     PresentManager(const vk::Instance& instance, Core::Frontend::EmuWindow& render_window,
                    const Device& device, MemoryAllocator& memory_allocator, Scheduler& scheduler,
-                   Swapchain& swapchain, vk::SurfaceKHR& surface);
+                   Swapchain& swapchain, vk::SurfaceKHR& surface, Tegra::GPU& gpu);
     ~PresentManager();
 
     /// Returns the last used presentation frame
@@ -54,8 +65,16 @@ public:
     void WaitPresent();
 
 private:
+    struct PendingPresent {
+        u64 present_id;
+        std::chrono::steady_clock::time_point render_start;
+    };
+
     void PresentThread(std::stop_token token);
 
+    /// Waits until at most one present is waiting to be displayed, recording their latency
+    void WaitForDisplay();
+
     void CopyToSwapchain(Frame* frame);
 
     void CopyToSwapchainImpl(Frame* frame);
@@ -72,10 +91,12 @@ private:
     Scheduler& scheduler;
     Swapchain& swapchain;
     vk::SurfaceKHR& surface;
+    Tegra::GPU& gpu;
     vk::CommandPool cmdpool;
     std::vector<Frame> frames;
     std::queue<Frame*> present_queue;
     std::queue<Frame*> free_queue;
+    std::queue<PendingPresent> pending_presents;
     std::condition_variable_any frame_cv;
     std::condition_variable free_cv;
     std::mutex swapchain_mutex;
@@ -84,6 +105,7 @@ private:
     std::jthread present_thread;
     bool blit_supported;
     bool use_present_thread;
+    bool use_low_latency;
     std::size_t image_count{};
 };
 
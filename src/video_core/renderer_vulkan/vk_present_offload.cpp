@@ -0,0 +1,417 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <string_view>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/frontend/emu_window.h"
+#include "video_core/framebuffer_config.h"
+#include "video_core/present.h"
+#include "video_core/renderer_vulkan/maxwell_to_vk.h"
+#include "video_core/renderer_vulkan/present/util.h"
+#include "video_core/renderer_vulkan/vk_present_offload.h"
+
+namespace Vulkan {
+namespace {
+
+constexpr VkExternalMemoryHandleTypeFlagBits MEMORY_HANDLE_TYPE =
+    VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+
+constexpr VkExternalSemaphoreHandleTypeFlagBits SEMAPHORE_HANDLE_TYPE =
+    VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT;
+
+constexpr VkImageSubresourceRange COLOR_SUBRESOURCE_RANGE{
+    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+    .baseMipLevel = 0,
+    .levelCount = 1,
+    .baseArrayLayer = 0,
+    .layerCount = 1,
+};
+
+void CloseFd(int fd) {
+#ifdef __linux__
+    close(fd);
+#endif
+}
+
+std::optional<vk::PhysicalDevice> FindPresentDevice(const vk::Instance& instance,
+                                                    const vk::InstanceDispatch& dld) {
+    const s32 device_index = Settings::values.vulkan_present_device.GetValue();
+    if (device_index < 0 || device_index == Settings::values.vulkan_device.GetValue()) {
+        return std::nullopt;
+    }
+    const std::vector<VkPhysicalDevice> devices = instance.EnumeratePhysicalDevices();
+    if (device_index >= static_cast<s32>(devices.size())) {
+        LOG_ERROR(Render_Vulkan, "Invalid presentation device index {}!", device_index);
+        return std::nullopt;
+    }
+    return vk::PhysicalDevice(devices[device_index], dld);
+}
+
+bool SupportsDmaBufSharing(const vk::PhysicalDevice& physical) {
+    const std::vector extensions = physical.EnumerateDeviceExtensionProperties();
+    const auto is_supported = [&extensions](std::string_view name) {
+        return std::ranges::any_of(extensions, [name](const VkExtensionProperties& extension) {
+            return name == extension.extensionName;
+        });
+    };
+    return is_supported(VK_EXT_EXTERNAL_MEMORY_DMA_BUF_EXTENSION_NAME) &&
+           is_supported(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME) &&
+           is_supported(VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME);
+}
+
+bool SupportsPresent(const vk::PhysicalDevice& physical, VkSurfaceKHR surface) {
+    const u32 num_families = static_cast<u32>(physical.GetQueueFamilyProperties().size());
+    for (u32 index = 0; index < num_families; ++index) {
+        if (physical.GetSurfaceSupportKHR(index, surface)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Device CreatePresentDevice(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                           VkSurfaceKHR surface) {
+    const std::optional<vk::PhysicalDevice> physical = FindPresentDevice(instance, dld);
+    if (!physical) {
+        throw vk::Exception(VK_ERROR_INITIALIZATION_FAILED);
+    }
+    return Device(*instance, *physical, surface, dld);
+}
+
+/// Returns a memory type of the mask in system memory, which any device can import
+u32 FindSharedMemoryType(const Device& device, u32 type_mask) {
+    const VkPhysicalDeviceMemoryProperties properties =
+        device.GetPhysical().GetMemoryProperties().memoryProperties;
+    for (u32 index = 0; index < properties.memoryTypeCount; ++index) {
+        const VkMemoryPropertyFlags flags = properties.memoryTypes[index].propertyFlags;
+        if ((type_mask & (1U << index)) != 0 && (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
+            return index;
+        }
+    }
+    return static_cast<u32>(std::countr_zero(type_mask));
+}
+
+vk::Semaphore CreateExportableSemaphore(const Device& device) {
+    const VkExportSemaphoreCreateInfo export_ci{
+        .sType = VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO,
+        .pNext = nullptr,
+        .handleTypes = SEMAPHORE_HANDLE_TYPE,
+    };
+    return device.GetLogical().CreateSemaphore({
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &export_ci,
+        .flags = 0,
+    });
+}
+
+} // Anonymous namespace
+
+bool CanOffloadPresentation(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                            VkSurfaceKHR surface) {
+#ifdef __linux__
+    const std::optional<vk::PhysicalDevice> present_physical = FindPresentDevice(instance, dld);
+    if (!present_physical) {
+        return false;
+    }
+    const std::vector<VkPhysicalDevice> devices = instance.EnumeratePhysicalDevices();
+    const s32 render_index = Settings::values.vulkan_device.GetValue();
+    if (render_index < 0 || render_index >= static_cast<s32>(devices.size())) {
+        return false;
+    }
+    const vk::PhysicalDevice render_physical(devices[render_index], dld);
+    if (!SupportsDmaBufSharing(render_physical) || !SupportsDmaBufSharing(*present_physical)) {
+        LOG_WARNING(Render_Vulkan, "Devices can't share frames, presenting from the render device");
+        return false;
+    }
+    if (!SupportsPresent(*present_physical, surface)) {
+        LOG_WARNING(Render_Vulkan, "Presentation device can't present to the window");
+        return false;
+    }
+    return true;
+#else
+    // Frames are shared as dma-bufs
+    return false;
+#endif
+}
+
+PresentOffload::PresentOffload(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                               Core::Frontend::EmuWindow& render_window, vk::SurfaceKHR& surface,
+                               Tegra::MaxwellDeviceMemoryManager& device_memory, Tegra::GPU& gpu,
+                               const Device& render_device_, Scheduler& render_scheduler_)
+    : render_device{render_device_}, render_scheduler{render_scheduler_},
+      device(CreatePresentDevice(instance, dld, *surface)), memory_allocator(device),
+      state_tracker(), scheduler(device, state_tracker),
+      swapchain(*surface, device, scheduler, render_window.GetFramebufferLayout().width,
+                render_window.GetFramebufferLayout().height),
+      present_manager(instance, render_window, device, memory_allocator, scheduler, swapchain,
+                      surface, gpu),
+      blit_screen(device_memory, device, memory_allocator, &present_manager, scheduler,
+                  PresentFiltersForDisplay) {
+    for (Slot& slot : slots) {
+        slot.render_semaphore = CreateExportableSemaphore(render_device);
+        slot.present_semaphore = device.GetLogical().CreateSemaphore();
+    }
+    LOG_INFO(Render_Vulkan, "Presenting from: {}", device.GetModelName());
+}
+
+PresentOffload::~PresentOffload() {
+    void(device.GetLogical().WaitIdle());
+}
+
+void PresentOffload::Present(DisplaySource& render_source,
+                             std::span<const Tegra::FramebufferConfig> framebuffers,
+                             const Layout::FramebufferLayout& layout) {
+    Slot& slot = slots[slot_index];
+    slot_index = (slot_index + 1) % NUM_SLOTS;
+
+    // The presentation device has to be done with the buffers of the slot before reusing them
+    scheduler.Wait(slot.present_tick);
+
+    if (slot.layers.size() < framebuffers.size()) {
+        slot.layers.resize(framebuffers.size());
+    }
+    bool has_shared_layers = false;
+    for (size_t index = 0; index < slot.layers.size(); ++index) {
+        SharedLayer& layer = slot.layers[index];
+        layer.is_shared =
+            index < framebuffers.size() && ShareLayer(layer, render_source, framebuffers[index]);
+        has_shared_layers |= layer.is_shared;
+    }
+    if (has_shared_layers) {
+        UploadLayers(slot);
+    }
+
+    presenting_slot = &slot;
+    Frame* const frame = present_manager.GetRenderFrame();
+    blit_screen.DrawToFrame(*this, frame, framebuffers, layout, swapchain.GetImageCount(),
+                            swapchain.GetImageViewFormat());
+    slot.present_tick = scheduler.Flush(*frame->render_ready);
+    present_manager.Present(frame);
+    presenting_slot = nullptr;
+}
+
+std::optional<FramebufferTextureInfo> PresentOffload::AccelerateDisplay(
+    const Tegra::FramebufferConfig& config, VAddr framebuffer_addr, u32 pixel_stride) {
+    if (!presenting_slot) {
+        return std::nullopt;
+    }
+    const auto it =
+        std::ranges::find_if(presenting_slot->layers, [framebuffer_addr](const SharedLayer& layer) {
+            return layer.is_shared && layer.address == framebuffer_addr;
+        });
+    if (it == presenting_slot->layers.end()) {
+        return std::nullopt;
+    }
+    return it->info;
+}
+
+bool PresentOffload::ShareLayer(SharedLayer& layer, DisplaySource& render_source,
+                                const Tegra::FramebufferConfig& framebuffer) {
+    const VAddr framebuffer_addr = framebuffer.address + framebuffer.offset;
+    const auto texture_info =
+        render_source.AccelerateDisplay(framebuffer, framebuffer_addr, framebuffer.stride);
+    if (!texture_info) {
+        // Framebuffers written by the CPU are read from guest memory by the presentation device
+        return false;
+    }
+    const VkExtent2D extent{
+        .width = texture_info->scaled_width,
+        .height = texture_info->scaled_height,
+    };
+    const VkDeviceSize size = VkDeviceSize{extent.width} * extent.height *
+                              VideoCore::Surface::BytesPerBlock(texture_info->pixel_format);
+    if (layer.capacity < size) {
+        CreateSharedBuffer(layer, size);
+    }
+    const VkFormat format = MaxwellToVK::SurfaceFormat(device, FormatType::Optimal, true,
+                                                       texture_info->pixel_format)
+                                .format;
+    if (!layer.image || layer.format != format || layer.extent.width != extent.width ||
+        layer.extent.height != extent.height) {
+        CreateImage(layer, format, extent);
+    }
+    layer.address = framebuffer_addr;
+    layer.info = *texture_info;
+    layer.info.image = *layer.image;
+    layer.info.image_view = *layer.image_view;
+
+    render_scheduler.RequestOutsideRenderPassOperationContext();
+    render_scheduler.Record([image = texture_info->image, buffer = *layer.render_buffer, extent,
+                             family = render_device.GetGraphicsFamily()](vk::CommandBuffer cmdbuf) {
+        DownloadColorImage(cmdbuf, image, buffer, VkExtent3D{extent.width, extent.height, 1});
+
+        // Release the buffer to the presentation device
+        const VkBufferMemoryBarrier release_barrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = 0,
+            .srcQueueFamilyIndex = family,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL,
+            .buffer = buffer,
+            .offset = 0,
+            .size = VK_WHOLE_SIZE,
+        };
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, release_barrier);
+    });
+    return true;
+}
+
+void PresentOffload::CreateSharedBuffer(SharedLayer& layer, VkDeviceSize size) {
+    const VkExternalMemoryBufferCreateInfo external_ci{
+        .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .handleTypes = MEMORY_HANDLE_TYPE,
+    };
+    const VkBufferCreateInfo buffer_ci{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = &external_ci,
+        .flags = 0,
+        .size = size,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    };
+    const vk::Device& render_dev = render_device.GetLogical();
+    layer.render_buffer = render_dev.CreateExternalBuffer(buffer_ci);
+    const VkMemoryRequirements render_requirements =
+        render_dev.GetBufferMemoryRequirements(*layer.render_buffer);
+    const VkExportMemoryAllocateInfo export_info{
+        .sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .handleTypes = MEMORY_HANDLE_TYPE,
+    };
+    layer.render_memory = render_dev.AllocateMemory({
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = &export_info,
+        .allocationSize = render_requirements.size,
+        .memoryTypeIndex =
+            FindSharedMemoryType(render_device, render_requirements.memoryTypeBits),
+    });
+    layer.render_buffer.BindMemory(*layer.render_memory, 0);
+
+    // Vulkan owns the file descriptor once it has been imported successfully
+    const int fd = layer.render_memory.GetMemoryFdKHR(MEMORY_HANDLE_TYPE);
+    const vk::Device& dev = device.GetLogical();
+    layer.present_buffer = dev.CreateExternalBuffer(buffer_ci);
+    const VkMemoryRequirements requirements = dev.GetBufferMemoryRequirements(*layer.present_buffer);
+    VkMemoryFdPropertiesKHR fd_properties;
+    const VkResult result = dev.GetMemoryFdPropertiesKHR(MEMORY_HANDLE_TYPE, fd, fd_properties);
+    const u32 type_mask = requirements.memoryTypeBits & fd_properties.memoryTypeBits;
+    if (result == VK_SUCCESS && type_mask != 0 && requirements.size <= render_requirements.size) {
+        const VkImportMemoryFdInfoKHR import_info{
+            .sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR,
+            .pNext = nullptr,
+            .handleType = MEMORY_HANDLE_TYPE,
+            .fd = fd,
+        };
+        layer.present_memory = dev.TryAllocateMemory({
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .pNext = &import_info,
+            .allocationSize = requirements.size,
+            .memoryTypeIndex = static_cast<u32>(std::countr_zero(type_mask)),
+        });
+    }
+    if (result != VK_SUCCESS || type_mask == 0 || !layer.present_memory) {
+        CloseFd(fd);
+        LOG_ERROR(Render_Vulkan, "Presentation device failed to import a shared frame");
+        throw vk::Exception(VK_ERROR_INVALID_EXTERNAL_HANDLE);
+    }
+    layer.present_buffer.BindMemory(*layer.present_memory, 0);
+    layer.capacity = size;
+}
+
+void PresentOffload::CreateImage(SharedLayer& layer, VkFormat format, VkExtent2D extent) {
+    layer.image = CreateWrappedImage(memory_allocator, extent, format);
+    layer.image_view = CreateWrappedImageView(device, layer.image, format);
+    layer.format = format;
+    layer.extent = extent;
+}
+
+void PresentOffload::UploadLayers(Slot& slot) {
+    // The copies are waited on through a sync file, which only exists once they are submitted
+    render_scheduler.Flush(*slot.render_semaphore);
+    render_scheduler.WaitWorker();
+    const int fd = slot.render_semaphore.GetFdKHR(SEMAPHORE_HANDLE_TYPE);
+    slot.present_semaphore.ImportFdKHR(SEMAPHORE_HANDLE_TYPE, VK_SEMAPHORE_IMPORT_TEMPORARY_BIT,
+                                       fd);
+
+    scheduler.RequestOutsideRenderPassOperationContext();
+    for (const SharedLayer& layer : slot.layers) {
+        if (!layer.is_shared) {
+            continue;
+        }
+        scheduler.Record([buffer = *layer.present_buffer, image = *layer.image,
+                          extent = layer.extent,
+                          family = device.GetGraphicsFamily()](vk::CommandBuffer cmdbuf) {
+            const VkBufferMemoryBarrier acquire_barrier{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = 0,
+                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL,
+                .dstQueueFamilyIndex = family,
+                .buffer = buffer,
+                .offset = 0,
+                .size = VK_WHOLE_SIZE,
+            };
+            const VkImageMemoryBarrier write_barrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image,
+                .subresourceRange = COLOR_SUBRESOURCE_RANGE,
+            };
+            const VkImageMemoryBarrier read_barrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image,
+                .subresourceRange = COLOR_SUBRESOURCE_RANGE,
+            };
+            const VkBufferImageCopy copy{
+                .bufferOffset = 0,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource{
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = 0,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+                .imageOffset{.x = 0, .y = 0, .z = 0},
+                .imageExtent{.width = extent.width, .height = extent.height, .depth = 1},
+            };
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                   VK_PIPELINE_STAGE_TRANSFER_BIT, 0, {}, acquire_barrier,
+                                   write_barrier);
+            cmdbuf.CopyBufferToImage(buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, copy);
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, read_barrier);
+        });
+    }
+    // Submit right away, drawing the frame may flush the scheduler before the semaphore is waited
+    scheduler.Flush(nullptr, *slot.present_semaphore);
+}
+
+} // namespace Vulkan
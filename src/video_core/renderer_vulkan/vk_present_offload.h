@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/frontend/framebuffer_layout.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/renderer_vulkan/vk_blit_screen.h"
+#include "video_core/renderer_vulkan/vk_present_manager.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_state_tracker.h"
+#include "video_core/renderer_vulkan/vk_swapchain.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_memory_allocator.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Core::Frontend {
+class EmuWindow;
+}
+
+namespace Tegra {
+class GPU;
+struct FramebufferConfig;
+} // namespace Tegra
+
+namespace Vulkan {
+
+/// Returns true when the configured presentation device can present frames rendered elsewhere
+bool CanOffloadPresentation(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                            VkSurfaceKHR surface);
+
+/**
+ * Presents frames rendered by one device from a second device, usually the integrated GPU driving
+ * the display of a laptop with a discrete GPU. The rendering device copies the displayed
+ * framebuffers to dma-buf backed buffers, the presentation device runs the output filters on them
+ * and owns the swapchain.
+ */
+class PresentOffload final : public DisplaySource {
+public:
+    explicit PresentOffload(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                            Core::Frontend::EmuWindow& render_window, vk::SurfaceKHR& surface,
+                            Tegra::MaxwellDeviceMemoryManager& device_memory, Tegra::GPU& gpu,
+                            const Device& render_device, Scheduler& render_scheduler);
+    ~PresentOffload() override;
+
+    /// Shares the framebuffers drawn by the rendering device and presents them
+    void Present(DisplaySource& render_source,
+                 std::span<const Tegra::FramebufferConfig> framebuffers,
+                 const Layout::FramebufferLayout& layout);
+
+    std::optional<FramebufferTextureInfo> AccelerateDisplay(const Tegra::FramebufferConfig& config,
+                                                            VAddr framebuffer_addr,
+                                                            u32 pixel_stride) override;
+
+private:
+    static constexpr size_t NUM_SLOTS = 3;
+
+    /// Framebuffer copied from the rendering device, framebuffers written by the CPU are not
+    struct SharedLayer {
+        VAddr address{};
+        bool is_shared{};
+        VkDeviceSize capacity{};
+        vk::DeviceMemory render_memory;
+        vk::ExternalBuffer render_buffer;
+        vk::DeviceMemory present_memory;
+        vk::ExternalBuffer present_buffer;
+        vk::Image image;
+        vk::ImageView image_view;
+        VkFormat format{};
+        VkExtent2D extent{};
+        FramebufferTextureInfo info{};
+    };
+
+    /// Resources of a frame in flight
+    struct Slot {
+        std::vector<SharedLayer> layers;
+        vk::Semaphore render_semaphore;
+        vk::Semaphore present_semaphore;
+        u64 present_tick{};
+    };
+
+    bool ShareLayer(SharedLayer& layer, DisplaySource& render_source,
+                    const Tegra::FramebufferConfig& framebuffer);
+
+    void CreateSharedBuffer(SharedLayer& layer, VkDeviceSize size);
+
+    void CreateImage(SharedLayer& layer, VkFormat format, VkExtent2D extent);
+
+    void UploadLayers(Slot& slot);
+
+    const Device& render_device;
+    Scheduler& render_scheduler;
+
+    Device device;
+    MemoryAllocator memory_allocator;
+    StateTracker state_tracker;
+    Scheduler scheduler;
+    Swapchain swapchain;
+    PresentManager present_manager;
+    BlitScreen blit_screen;
+
+    std::array<Slot, NUM_SLOTS> slots;
+    size_t slot_index{};
+    Slot* presenting_slot{};
+};
+
+} // namespace Vulkan
@@ -1175,12 +1175,20 @@ struct QueryCacheRuntimeImpl {
               device_memory_),
           primitives_needed_minus_succeeded_streamer(
               static_cast<size_t>(QueryType::StreamingPrimitivesNeededMinusSucceeded), runtime, 0u),
-          hcr_setup{}, hcr_is_set{}, is_hcr_running{}, maxwell3d{} {
+          hcr_setup{}, hcr_is_set{}, is_hcr_running{}, gpu_resident_hcr{}, maxwell3d{} {
 
         hcr_setup.sType = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
         hcr_setup.pNext = nullptr;
         hcr_setup.flags = 0;
 
+        // Sample queries are not written to guest memory on these drivers
+        const auto driver_id = device.GetDriverID();
+        gpu_resident_hcr = Settings::values.use_gpu_conditional_rendering.GetValue() &&
+                           device.IsExtConditionalRendering() &&
+                           driver_id != VK_DRIVER_ID_QUALCOMM_PROPRIETARY &&
+                           driver_id != VK_DRIVER_ID_ARM_PROPRIETARY &&
+                           driver_id != VK_DRIVER_ID_MESA_TURNIP;
+
         conditional_resolve_pass = std::make_unique<ConditionalRenderingResolvePass>(
             device, scheduler, descriptor_pool, compute_pass_descriptor_queue);
 
@@ -1227,6 +1235,7 @@ struct QueryCacheRuntimeImpl {
     size_t hcr_offset;
     bool hcr_is_set;
     bool is_hcr_running;
+    bool gpu_resident_hcr;
 
     // maxwell3d
     Maxwell3D* maxwell3d;
@@ -1313,12 +1322,14 @@ void QueryCacheRuntime::HostConditionalRenderingCompareValueImpl(VideoCommon::Lo
     ResumeHostConditionalRendering();
 }
 
-void QueryCacheRuntime::HostConditionalRenderingCompareBCImpl(DAddr address, bool is_equal) {
+void QueryCacheRuntime::HostConditionalRenderingCompareBCImpl(DAddr address, bool is_equal,
+                                                              bool synchronize) {
     VkBuffer to_resolve;
     u32 to_resolve_offset;
     {
         std::scoped_lock lk(impl->buffer_cache.mutex);
-        static constexpr auto sync_info = VideoCommon::ObtainBufferSynchronize::NoSynchronize;
+        const auto sync_info = synchronize ? VideoCommon::ObtainBufferSynchronize::FullSynchronize
+                                           : VideoCommon::ObtainBufferSynchronize::NoSynchronize;
         const auto post_op = VideoCommon::ObtainBufferOperation::DoNothing;
         const auto [buffer, offset] =
             impl->buffer_cache.ObtainCPUBuffer(address, 24, sync_info, post_op);
@@ -1389,6 +1400,13 @@ bool QueryCacheRuntime::HostConditionalRenderingCompareValues(VideoCommon::Looku
         return false;
     }
 
+    if (impl->gpu_resident_hcr) {
+        // Pending query results have been written to guest buffers on the GPU, compare them there.
+        // Either value may still only be in guest memory, so the range is synchronized first.
+        HostConditionalRenderingCompareBCImpl(object_1.address, equal_check, true);
+        return true;
+    }
+
     const bool is_gpu_high = Settings::IsGPULevelHigh();
     if (!is_gpu_high && impl->device.GetDriverID() == VK_DRIVER_ID_INTEL_PROPRIETARY_WINDOWS) {
         return true;
@@ -1420,10 +1438,14 @@ bool QueryCacheRuntime::HostConditionalRenderingCompareValues(VideoCommon::Looku
         // Both queries are in query cache, it's best to just flush.
         return true;
     }
-    HostConditionalRenderingCompareBCImpl(object_1.address, equal_check);
+    HostConditionalRenderingCompareBCImpl(object_1.address, equal_check, false);
     return true;
 }
 
+bool QueryCacheRuntime::IsGpuResidentConditionalRendering() const {
+    return impl->gpu_resident_hcr;
+}
+
 QueryCacheRuntime::~QueryCacheRuntime() = default;
 
 VideoCommon::StreamerInterface* QueryCacheRuntime::GetStreamerInterface(QueryType query_type) {
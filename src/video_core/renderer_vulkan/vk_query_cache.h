@@ -52,6 +52,10 @@ public:
                                                VideoCommon::LookupData object_2, bool qc_dirty,
                                                bool equal_check);
 
+    /// Returns true when pending query results are written to guest buffers on the GPU to
+    /// evaluate render conditions, instead of being waited for on the host
+    bool IsGpuResidentConditionalRendering() const;
+
     VideoCommon::StreamerInterface* GetStreamerInterface(VideoCommon::QueryType query_type);
 
     void Bind3DEngine(Tegra::Engines::Maxwell3D* maxwell3d);
@@ -61,7 +65,7 @@ public:
 
 private:
     void HostConditionalRenderingCompareValueImpl(VideoCommon::LookupData object, bool is_equal);
-    void HostConditionalRenderingCompareBCImpl(DAddr address, bool is_equal);
+    void HostConditionalRenderingCompareBCImpl(DAddr address, bool is_equal, bool synchronize);
     friend struct QueryCacheRuntimeImpl;
     std::unique_ptr<QueryCacheRuntimeImpl> impl;
 };
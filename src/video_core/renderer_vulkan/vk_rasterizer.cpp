@@ -3,12 +3,15 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
 
 #include "common/assert.h"
+#include "common/boot_profiler.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
@@ -52,6 +55,8 @@ MICROPROFILE_DEFINE(Vulkan_Clearing, "Vulkan", "Record clearing", MP_RGB(192, 12
 MICROPROFILE_DEFINE(Vulkan_PipelineCache, "Vulkan", "Pipeline cache", MP_RGB(192, 128, 128));
 
 namespace {
+constexpr u32 STATS_REPORT_FRAMES = 300;
+
 struct DrawParams {
     u32 base_instance;
     u32 num_instances;
@@ -173,6 +178,52 @@ DrawParams MakeDrawParams(const MaxwellDrawState& draw_state, u32 num_instances,
     }
     return params;
 }
+
+void RecordCoalescedDraws(Scheduler& scheduler, const Device& device,
+                          const MaxwellDrawState& draw_state, u32 num_instances, bool is_indexed) {
+    const auto& draws = draw_state.coalesced_draws;
+    const u32 base_instance = draw_state.base_instance;
+    const bool use_multi_draw = device.IsExtMultiDrawSupported();
+    if (is_indexed) {
+        std::vector<VkMultiDrawIndexedInfoEXT> infos(draws.size());
+        std::ranges::transform(draws, infos.begin(), [&draw_state](const auto& draw) {
+            return VkMultiDrawIndexedInfoEXT{
+                .firstIndex = draw.first,
+                .indexCount = draw.count,
+                .vertexOffset = static_cast<s32>(draw_state.base_index),
+            };
+        });
+        scheduler.Record([infos = std::move(infos), num_instances, base_instance,
+                          use_multi_draw](vk::CommandBuffer cmdbuf) {
+            if (use_multi_draw) {
+                cmdbuf.DrawMultiIndexedEXT(infos, num_instances, base_instance);
+                return;
+            }
+            for (const VkMultiDrawIndexedInfoEXT& info : infos) {
+                cmdbuf.DrawIndexed(info.indexCount, num_instances, info.firstIndex,
+                                   static_cast<u32>(info.vertexOffset), base_instance);
+            }
+        });
+        return;
+    }
+    std::vector<VkMultiDrawInfoEXT> infos(draws.size());
+    std::ranges::transform(draws, infos.begin(), [](const auto& draw) {
+        return VkMultiDrawInfoEXT{
+            .firstVertex = draw.first,
+            .vertexCount = draw.count,
+        };
+    });
+    scheduler.Record([infos = std::move(infos), num_instances, base_instance,
+                      use_multi_draw](vk::CommandBuffer cmdbuf) {
+        if (use_multi_draw) {
+            cmdbuf.DrawMultiEXT(infos, num_instances, base_instance);
+            return;
+        }
+        for (const VkMultiDrawInfoEXT& info : infos) {
+            cmdbuf.Draw(info.vertexCount, num_instances, info.firstVertex, base_instance);
+        }
+    });
+}
 } // Anonymous namespace
 
 RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra::GPU& gpu_,
@@ -181,7 +232,8 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
                                    StateTracker& state_tracker_, Scheduler& scheduler_)
     : gpu{gpu_}, device_memory{device_memory_}, device{device_},
       memory_allocator{memory_allocator_}, state_tracker{state_tracker_}, scheduler{scheduler_},
-      staging_pool(device, memory_allocator, scheduler), descriptor_pool(device, scheduler),
+      staging_pool(device, memory_allocator, scheduler),
+      descriptor_pool(device, memory_allocator, scheduler),
       guest_descriptor_queue(device, scheduler), compute_pass_descriptor_queue(device, scheduler),
       blit_image(device, scheduler, state_tracker, descriptor_pool), render_pass_cache(device),
       texture_cache_runtime{
@@ -191,6 +243,8 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
       buffer_cache_runtime(device, memory_allocator, scheduler, staging_pool,
                            guest_descriptor_queue, compute_pass_descriptor_queue, descriptor_pool),
       buffer_cache(device_memory, buffer_cache_runtime),
+      transform_feedback_draw_pass(device, scheduler, descriptor_pool, staging_pool,
+                                   compute_pass_descriptor_queue),
       query_cache_runtime(this, device_memory, buffer_cache, device, memory_allocator, scheduler,
                           staging_pool, compute_pass_descriptor_queue, descriptor_pool),
       query_cache(gpu, *this, device_memory, query_cache_runtime),
@@ -200,6 +254,11 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
       fence_manager(*this, gpu, texture_cache, buffer_cache, query_cache, device, scheduler),
       wfi_event(device.GetLogical().CreateEvent()) {
     scheduler.SetQueryCache(query_cache);
+    if (Settings::values.dynamic_resolution.GetValue() && scheduler.GetGpuProfiler()) {
+        dynamic_resolution.emplace(Settings::values.dynamic_resolution_min.GetValue(),
+                                   Settings::values.resolution_setup.GetValue(),
+                                   Settings::values.dynamic_resolution_target_fps.GetValue());
+    }
 }
 
 RasterizerVulkan::~RasterizerVulkan() = default;
@@ -237,6 +296,11 @@ void RasterizerVulkan::Draw(bool is_indexed, u32 instance_count) {
     PrepareDraw(is_indexed, [this, is_indexed, instance_count] {
         const auto& draw_state = maxwell3d->draw_manager->GetDrawState();
         const u32 num_instances{instance_count};
+        if (!draw_state.coalesced_draws.empty()) {
+            num_collapsed_draws += draw_state.coalesced_draws.size() - 1;
+            RecordCoalescedDraws(scheduler, device, draw_state, num_instances, is_indexed);
+            return;
+        }
         const DrawParams draw_params{MakeDrawParams(draw_state, num_instances, is_indexed)};
         scheduler.Record([draw_params](vk::CommandBuffer cmdbuf) {
             if (draw_params.is_indexed) {
@@ -253,6 +317,16 @@ void RasterizerVulkan::Draw(bool is_indexed, u32 instance_count) {
 
 void RasterizerVulkan::DrawIndirect() {
     const auto& params = maxwell3d->draw_manager->GetIndirectParams();
+    if (params.is_byte_count) {
+        const auto topology = maxwell3d->draw_manager->GetDrawState().topology;
+        const bool is_quad = topology == Maxwell::PrimitiveTopology::Quads ||
+                             topology == Maxwell::PrimitiveTopology::QuadStrip;
+        if (is_quad || !device.IsExtTransformFeedbackSupported()) {
+            DrawIndirectByteCountEmulated(params.indirect_start_address,
+                                          static_cast<u32>(params.stride));
+            return;
+        }
+    }
     buffer_cache.SetDrawIndirect(&params);
     PrepareDraw(params.is_indexed, [this, &params] {
         const auto indirect_buffer = buffer_cache.GetDrawIndirectBuffer();
@@ -299,6 +373,37 @@ void RasterizerVulkan::DrawIndirect() {
     buffer_cache.SetDrawIndirect(nullptr);
 }
 
+void RasterizerVulkan::DrawIndirectByteCountEmulated(GPUVAddr counter_addr, u32 stride) {
+    const auto& draw_state = maxwell3d->draw_manager->GetDrawState();
+    const bool is_quad = draw_state.topology == Maxwell::PrimitiveTopology::Quads ||
+                         draw_state.topology == Maxwell::PrimitiveTopology::QuadStrip;
+    if (stride == 0) {
+        return;
+    }
+    // The conversion has to be recorded before the draw starts its render pass.
+    // Quads are clamped to the vertices covered by the emulated quad index buffer.
+    std::pair<VkBuffer, VkDeviceSize> command;
+    {
+        std::scoped_lock lock{buffer_cache.mutex};
+        const auto [counter, counter_offset] = buffer_cache.ObtainBuffer(
+            counter_addr, sizeof(u32), VideoCommon::ObtainBufferSynchronize::FullSynchronize,
+            VideoCommon::ObtainBufferOperation::DoNothing);
+        const u32 max_vertices =
+            is_quad ? draw_state.vertex_buffer.count : std::numeric_limits<u32>::max();
+        command = transform_feedback_draw_pass.Assemble(counter->Handle(), counter_offset, stride,
+                                                        max_vertices, draw_state.topology);
+    }
+    PrepareDraw(false, [this, command, is_quad] {
+        scheduler.Record([command, is_quad](vk::CommandBuffer cmdbuf) {
+            if (is_quad) {
+                cmdbuf.DrawIndexedIndirect(command.first, command.second, 1, 0);
+            } else {
+                cmdbuf.DrawIndirect(command.first, command.second, 1, 0);
+            }
+        });
+    });
+}
+
 void RasterizerVulkan::DrawTexture() {
     MICROPROFILE_SCOPE(Vulkan_Drawing);
 
@@ -764,8 +869,11 @@ void RasterizerVulkan::TickFrame() {
     draw_counter = 0;
     guest_descriptor_queue.TickFrame();
     compute_pass_descriptor_queue.TickFrame();
+    descriptor_pool.TickFrame();
     fence_manager.TickFrame();
     staging_pool.TickFrame();
+    scheduler.TickFrame();
+    memory_allocator.TickFrame();
     {
         std::scoped_lock lock{texture_cache.mutex};
         texture_cache.TickFrame();
@@ -774,6 +882,36 @@ void RasterizerVulkan::TickFrame() {
         std::scoped_lock lock{buffer_cache.mutex};
         buffer_cache.TickFrame();
     }
+    pipeline_cache.TickFrame();
+    if (dynamic_resolution) {
+        UpdateDynamicResolution();
+    }
+
+    if (++frame_count % STATS_REPORT_FRAMES != 0) {
+        return;
+    }
+    LOG_DEBUG(Render_Vulkan, "Draw coalescing: {} guest draws collapsed in the last {} frames",
+              num_collapsed_draws, STATS_REPORT_FRAMES);
+    num_collapsed_draws = 0;
+}
+
+void RasterizerVulkan::UpdateDynamicResolution() {
+    const u64 gpu_nanoseconds = scheduler.GetGpuProfiler()->LastFrameNanoseconds();
+    const std::optional<Settings::ResolutionSetup> setup =
+        dynamic_resolution->AddFrame(gpu_nanoseconds);
+    if (!setup) {
+        return;
+    }
+    // Images are scaled down at the current scale, then scaled up on demand at the new one.
+    // Shaders embed the scale, pipelines are built again from the SPIR-V module cache.
+    {
+        std::scoped_lock lock{texture_cache.mutex};
+        texture_cache.ReleaseScaledImages();
+    }
+    pipeline_cache.ReleasePipelines();
+    Settings::TranslateResolutionInfo(*setup, Settings::values.resolution_info);
+    LOG_INFO(Render_Vulkan, "Dynamic resolution scale changed to {}",
+             Settings::CanonicalizeEnum(*setup));
 }
 
 bool RasterizerVulkan::AccelerateConditionalRendering() {
@@ -788,6 +926,13 @@ bool RasterizerVulkan::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surf
     return texture_cache.BlitImage(dst, src, copy_config);
 }
 
+bool RasterizerVulkan::AccelerateSurfaceWrite(DAddr addr,
+                                              const Tegra::Engines::Fermi2D::Surface& surface,
+                                              std::span<const u8> pixels) {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.WriteHostImage(addr, surface, pixels);
+}
+
 Tegra::Engines::AccelerateDMAInterface& RasterizerVulkan::AccessAccelerateDMA() {
     return accelerate_dma;
 }
@@ -836,11 +981,30 @@ std::optional<FramebufferTextureInfo> RasterizerVulkan::AccelerateDisplay(
     info.height = image_view->size.height;
     info.scaled_width = scaled ? resolution.ScaleUp(info.width) : info.width;
     info.scaled_height = scaled ? resolution.ScaleUp(info.height) : info.height;
+    info.pixel_format = image_view->format;
     return info;
 }
 
+std::optional<FramebufferContents> RasterizerVulkan::GetFramebufferContents(
+    const Tegra::FramebufferConfig& config, DAddr framebuffer_addr) {
+    if (!framebuffer_addr) {
+        return {};
+    }
+    std::scoped_lock lock{texture_cache.mutex};
+    const auto [image_view, modification_tick] =
+        texture_cache.TryFindFramebufferContents(config, framebuffer_addr);
+    if (!image_view) {
+        return {};
+    }
+    return FramebufferContents{
+        .image_view = image_view->Handle(Shader::TextureType::Color2D),
+        .modification_tick = modification_tick,
+    };
+}
+
 void RasterizerVulkan::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    BOOT_PHASE("LoadDiskShaderCache");
     pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
 }
 
@@ -858,7 +1022,7 @@ void RasterizerVulkan::FlushWork() {
     }
     if (draw_counter < DRAWS_TO_DISPATCH) {
         // Send recorded tasks to the worker thread
-        scheduler.DispatchWork();
+        scheduler.DispatchWorkAtDrawBoundary();
         return;
     }
     // Otherwise (every certain number of draws) flush execution.
@@ -926,6 +1090,26 @@ bool AccelerateDMA::BufferToImage(const Tegra::DMA::ImageCopy& copy_info,
     return DmaBufferImageCopy<true>(copy_info, buffer_operand, image_operand);
 }
 
+bool AccelerateDMA::BlockLinearToPitch(const Tegra::DMA::BlockLinearCopy& copy) {
+    std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
+    const std::optional<DAddr> dst_addr = buffer_cache.DMABlockLinearCopy(copy, false);
+    if (!dst_addr) {
+        return false;
+    }
+    texture_cache.WriteMemory(*dst_addr, copy.pitch_size);
+    return true;
+}
+
+bool AccelerateDMA::PitchToBlockLinear(const Tegra::DMA::BlockLinearCopy& copy) {
+    std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
+    const std::optional<DAddr> dst_addr = buffer_cache.DMABlockLinearCopy(copy, true);
+    if (!dst_addr) {
+        return false;
+    }
+    texture_cache.WriteMemory(*dst_addr, copy.block_linear_size);
+    return true;
+}
+
 void RasterizerVulkan::UpdateDynamicStates() {
     auto& regs = maxwell3d->regs;
     UpdateViewportsState(regs);
@@ -962,6 +1146,19 @@ void RasterizerVulkan::UpdateDynamicStates() {
         if (device.IsExtExtendedDynamicState3Supported()) {
             UpdateBlending(regs);
         }
+        if (device.IsExtExtendedDynamicState3RasterizationSupported()) {
+            UpdatePolygonMode(regs);
+            UpdateAlphaControl(regs);
+            if (device.IsExtConservativeRasterizationSupported()) {
+                UpdateConservativeRasterization(regs);
+            }
+            if (device.IsExtLineRasterizationSupported()) {
+                UpdateLineRasterizationMode(regs);
+            }
+            if (device.IsExtProvokingVertexSupported()) {
+                UpdateProvokingVertexMode(regs);
+            }
+        }
     }
     if (device.IsExtVertexInputDynamicStateSupported()) {
         UpdateVertexInput(regs);
@@ -1333,6 +1530,59 @@ void RasterizerVulkan::UpdateDepthClampEnable(Tegra::Engines::Maxwell3D::Regs& r
         [is_enabled](vk::CommandBuffer cmdbuf) { cmdbuf.SetDepthClampEnableEXT(is_enabled); });
 }
 
+void RasterizerVulkan::UpdatePolygonMode(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchPolygonMode()) {
+        return;
+    }
+    const VkPolygonMode polygon_mode{MaxwellToVK::PolygonMode(regs.polygon_mode_front)};
+    scheduler.Record(
+        [polygon_mode](vk::CommandBuffer cmdbuf) { cmdbuf.SetPolygonModeEXT(polygon_mode); });
+}
+
+void RasterizerVulkan::UpdateAlphaControl(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchAlphaControl()) {
+        return;
+    }
+    const bool alpha_to_coverage = regs.anti_alias_alpha_control.alpha_to_coverage != 0;
+    const bool alpha_to_one = regs.anti_alias_alpha_control.alpha_to_one != 0;
+    scheduler.Record([alpha_to_coverage, alpha_to_one](vk::CommandBuffer cmdbuf) {
+        cmdbuf.SetAlphaToCoverageEnableEXT(alpha_to_coverage);
+        cmdbuf.SetAlphaToOneEnableEXT(alpha_to_one);
+    });
+}
+
+void RasterizerVulkan::UpdateConservativeRasterization(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchConservativeRasterization()) {
+        return;
+    }
+    const VkConservativeRasterizationModeEXT mode{
+        regs.conservative_raster_enable != 0 ? VK_CONSERVATIVE_RASTERIZATION_MODE_OVERESTIMATE_EXT
+                                             : VK_CONSERVATIVE_RASTERIZATION_MODE_DISABLED_EXT};
+    scheduler.Record(
+        [mode](vk::CommandBuffer cmdbuf) { cmdbuf.SetConservativeRasterizationModeEXT(mode); });
+}
+
+void RasterizerVulkan::UpdateLineRasterizationMode(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchLineRasterizationMode()) {
+        return;
+    }
+    const VkLineRasterizationModeEXT mode{regs.line_anti_alias_enable != 0
+                                              ? VK_LINE_RASTERIZATION_MODE_RECTANGULAR_SMOOTH_EXT
+                                              : VK_LINE_RASTERIZATION_MODE_RECTANGULAR_EXT};
+    scheduler.Record(
+        [mode](vk::CommandBuffer cmdbuf) { cmdbuf.SetLineRasterizationModeEXT(mode); });
+}
+
+void RasterizerVulkan::UpdateProvokingVertexMode(Tegra::Engines::Maxwell3D::Regs& regs) {
+    if (!state_tracker.TouchProvokingVertexMode()) {
+        return;
+    }
+    const VkProvokingVertexModeEXT mode{regs.provoking_vertex == Maxwell::ProvokingVertex::Last
+                                            ? VK_PROVOKING_VERTEX_MODE_LAST_VERTEX_EXT
+                                            : VK_PROVOKING_VERTEX_MODE_FIRST_VERTEX_EXT};
+    scheduler.Record([mode](vk::CommandBuffer cmdbuf) { cmdbuf.SetProvokingVertexModeEXT(mode); });
+}
+
 void RasterizerVulkan::UpdateDepthCompareOp(Tegra::Engines::Maxwell3D::Regs& regs) {
     if (!state_tracker.TouchDepthCompareOp()) {
         return;
@@ -4,16 +4,20 @@
 #pragma once
 
 #include <array>
+#include <optional>
 
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
 #include "video_core/control/channel_state_cache.h"
+#include "video_core/dynamic_resolution.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_vulkan/blit_image.h"
+#include "video_core/renderer_vulkan/vk_blit_screen.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
+#include "video_core/renderer_vulkan/vk_compute_pass.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_fence_manager.h"
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
@@ -43,8 +47,6 @@ class Maxwell3D;
 
 namespace Vulkan {
 
-struct FramebufferTextureInfo;
-
 class StateTracker;
 
 class AccelerateDMA : public Tegra::Engines::AccelerateDMAInterface {
@@ -62,6 +64,10 @@ public:
     bool BufferToImage(const Tegra::DMA::ImageCopy& copy_info, const Tegra::DMA::BufferOperand& src,
                        const Tegra::DMA::ImageOperand& dst) override;
 
+    bool BlockLinearToPitch(const Tegra::DMA::BlockLinearCopy& copy) override;
+
+    bool PitchToBlockLinear(const Tegra::DMA::BlockLinearCopy& copy) override;
+
 private:
     template <bool IS_IMAGE_UPLOAD>
     bool DmaBufferImageCopy(const Tegra::DMA::ImageCopy& copy_info,
@@ -74,6 +80,7 @@ private:
 };
 
 class RasterizerVulkan final : public VideoCore::RasterizerInterface,
+                               public DisplaySource,
                                protected VideoCommon::ChannelSetupCaches<VideoCommon::ChannelInfo> {
 public:
     explicit RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra::GPU& gpu_,
@@ -84,6 +91,13 @@ public:
 
     void Draw(bool is_indexed, u32 instance_count) override;
     void DrawIndirect() override;
+    bool SupportsDrawCoalescing() const override {
+        return true;
+    }
+    /// Byte count draws are issued natively or converted to an indirect draw on the GPU
+    bool HasDrawTransformFeedback() override {
+        return true;
+    }
     void DrawTexture() override;
     void Clear(u32 layer_count) override;
     void DispatchCompute() override;
@@ -122,6 +136,8 @@ public:
     bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                const Tegra::Engines::Fermi2D::Surface& dst,
                                const Tegra::Engines::Fermi2D::Config& copy_config) override;
+    bool AccelerateSurfaceWrite(DAddr addr, const Tegra::Engines::Fermi2D::Surface& surface,
+                                std::span<const u8> pixels) override;
     Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override;
     void AccelerateInlineToMemory(GPUVAddr address, size_t copy_size,
                                   std::span<const u8> memory) override;
@@ -136,7 +152,10 @@ public:
 
     std::optional<FramebufferTextureInfo> AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                                             VAddr framebuffer_addr,
-                                                            u32 pixel_stride);
+                                                            u32 pixel_stride) override;
+
+    std::optional<FramebufferContents> GetFramebufferContents(
+        const Tegra::FramebufferConfig& config, DAddr framebuffer_addr);
 
 private:
     static constexpr size_t MAX_TEXTURES = 192;
@@ -148,10 +167,15 @@ private:
     template <typename Func>
     void PrepareDraw(bool is_indexed, Func&&);
 
+    void DrawIndirectByteCountEmulated(GPUVAddr counter_addr, u32 stride);
+
     void FlushWork();
 
     void UpdateDynamicStates();
 
+    /// Changes the resolution scale at the end of a frame when dynamic resolution asks for it
+    void UpdateDynamicResolution();
+
     void HandleTransformFeedback();
 
     void UpdateViewportsState(Tegra::Engines::Maxwell3D::Regs& regs);
@@ -172,6 +196,11 @@ private:
     void UpdateDepthBiasEnable(Tegra::Engines::Maxwell3D::Regs& regs);
     void UpdateLogicOpEnable(Tegra::Engines::Maxwell3D::Regs& regs);
     void UpdateDepthClampEnable(Tegra::Engines::Maxwell3D::Regs& regs);
+    void UpdatePolygonMode(Tegra::Engines::Maxwell3D::Regs& regs);
+    void UpdateAlphaControl(Tegra::Engines::Maxwell3D::Regs& regs);
+    void UpdateConservativeRasterization(Tegra::Engines::Maxwell3D::Regs& regs);
+    void UpdateLineRasterizationMode(Tegra::Engines::Maxwell3D::Regs& regs);
+    void UpdateProvokingVertexMode(Tegra::Engines::Maxwell3D::Regs& regs);
     void UpdateFrontFace(Tegra::Engines::Maxwell3D::Regs& regs);
     void UpdateStencilOp(Tegra::Engines::Maxwell3D::Regs& regs);
     void UpdateStencilTestEnable(Tegra::Engines::Maxwell3D::Regs& regs);
@@ -199,6 +228,7 @@ private:
     TextureCache texture_cache;
     BufferCacheRuntime buffer_cache_runtime;
     BufferCache buffer_cache;
+    TransformFeedbackDrawPass transform_feedback_draw_pass;
     QueryCacheRuntime query_cache_runtime;
     QueryCache query_cache;
     PipelineCache pipeline_cache;
@@ -212,6 +242,10 @@ private:
     boost::container::static_vector<VkSampler, MAX_TEXTURES> sampler_handles;
 
     u32 draw_counter = 0;
+    u32 frame_count = 0;
+    u64 num_collapsed_draws = 0; ///< Guest draws merged into a previous host draw
+
+    std::optional<VideoCommon::DynamicResolution> dynamic_resolution;
 };
 
 } // namespace Vulkan
@@ -14,6 +14,7 @@
 namespace Vulkan {
 namespace {
 using VideoCore::Surface::PixelFormat;
+using VideoCore::Surface::SurfaceType;
 
 VkAttachmentDescription AttachmentDescription(const Device& device, PixelFormat format,
                                               VkSampleCountFlagBits samples) {
@@ -30,8 +31,76 @@ VkAttachmentDescription AttachmentDescription(const Device& device, PixelFormat
         .finalLayout = VK_IMAGE_LAYOUT_GENERAL,
     };
 }
+
+VkRenderingAttachmentInfo RenderingAttachmentInfo(VkImageView image_view) {
+    return {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .pNext = nullptr,
+        .imageView = image_view,
+        .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .resolveMode = VK_RESOLVE_MODE_NONE,
+        .resolveImageView = VK_NULL_HANDLE,
+        .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .clearValue{},
+    };
+}
 } // Anonymous namespace
 
+VkPipelineRenderingCreateInfo RenderingFormats::PipelineCreateInfo() const noexcept {
+    return {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+        .pNext = nullptr,
+        .viewMask = 0,
+        .colorAttachmentCount = num_color_formats,
+        .pColorAttachmentFormats = color_formats.data(),
+        .depthAttachmentFormat = depth_format,
+        .stencilAttachmentFormat = stencil_format,
+    };
+}
+
+VkCommandBufferInheritanceRenderingInfo RenderingFormats::InheritanceInfo() const noexcept {
+    return {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .viewMask = 0,
+        .colorAttachmentCount = num_color_formats,
+        .pColorAttachmentFormats = color_formats.data(),
+        .depthAttachmentFormat = depth_format,
+        .stencilAttachmentFormat = stencil_format,
+        .rasterizationSamples = samples,
+    };
+}
+
+void BeginRendering(vk::CommandBuffer cmdbuf, const RenderingAttachments& attachments,
+                    VkExtent2D render_area, VkRenderingFlags flags) {
+    std::array<VkRenderingAttachmentInfo, 8> color_attachments;
+    for (u32 index = 0; index < attachments.num_color_views; ++index) {
+        // Null views leave gaps in the attachment indices like unused render pass attachments
+        color_attachments[index] = RenderingAttachmentInfo(attachments.color_views[index]);
+    }
+    const VkRenderingAttachmentInfo depth_stencil_attachment{
+        RenderingAttachmentInfo(attachments.depth_stencil_view)};
+    cmdbuf.BeginRendering({
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .pNext = nullptr,
+        .flags = flags,
+        .renderArea =
+            {
+                .offset = {.x = 0, .y = 0},
+                .extent = render_area,
+            },
+        .layerCount = attachments.num_layers,
+        .viewMask = 0,
+        .colorAttachmentCount = attachments.num_color_views,
+        .pColorAttachments = color_attachments.data(),
+        .pDepthAttachment = attachments.has_depth ? &depth_stencil_attachment : nullptr,
+        .pStencilAttachment = attachments.has_stencil ? &depth_stencil_attachment : nullptr,
+    });
+}
+
 RenderPassCache::RenderPassCache(const Device& device_) : device{&device_} {}
 
 VkRenderPass RenderPassCache::Get(const RenderPassKey& key) {
@@ -92,4 +161,37 @@ VkRenderPass RenderPassCache::Get(const RenderPassKey& key) {
     return *pair->second;
 }
 
+const RenderingFormats& RenderPassCache::GetRenderingFormats(const RenderPassKey& key) {
+    using MaxwellToVK::SurfaceFormat;
+    std::scoped_lock lock{mutex};
+    const auto [pair, is_new] = formats_cache.try_emplace(key);
+    RenderingFormats& formats{pair->second};
+    if (!is_new) {
+        return formats;
+    }
+    for (size_t index = 0; index < key.color_formats.size(); ++index) {
+        const PixelFormat format{key.color_formats[index]};
+        if (format == PixelFormat::Invalid) {
+            formats.color_formats[index] = VK_FORMAT_UNDEFINED;
+            continue;
+        }
+        formats.color_formats[index] =
+            SurfaceFormat(*device, FormatType::Optimal, true, format).format;
+        formats.num_color_formats = static_cast<u32>(index + 1);
+    }
+    if (key.depth_format != PixelFormat::Invalid) {
+        const VkFormat format{
+            SurfaceFormat(*device, FormatType::Optimal, true, key.depth_format).format};
+        const SurfaceType type{VideoCore::Surface::GetFormatType(key.depth_format)};
+        if (type == SurfaceType::Depth || type == SurfaceType::DepthStencil) {
+            formats.depth_format = format;
+        }
+        if (type == SurfaceType::Stencil || type == SurfaceType::DepthStencil) {
+            formats.stencil_format = format;
+        }
+    }
+    formats.samples = key.samples;
+    return formats;
+}
+
 } // namespace Vulkan
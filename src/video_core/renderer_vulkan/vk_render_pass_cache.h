@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
 #include <unordered_map>
 
@@ -39,15 +40,50 @@ namespace Vulkan {
 
 class Device;
 
+/// Attachment formats pipelines used with dynamic rendering are created with
+struct RenderingFormats {
+    /// Returns the create info of pipelines drawing to these formats, it references this object
+    [[nodiscard]] VkPipelineRenderingCreateInfo PipelineCreateInfo() const noexcept;
+
+    /// Returns the inheritance info of secondary command buffers, it references this object
+    [[nodiscard]] VkCommandBufferInheritanceRenderingInfo InheritanceInfo() const noexcept;
+
+    std::array<VkFormat, 8> color_formats{};
+    u32 num_color_formats{};
+    VkFormat depth_format = VK_FORMAT_UNDEFINED;
+    VkFormat stencil_format = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+};
+
+/// Image views of a render pass instance begun with dynamic rendering
+struct RenderingAttachments {
+    bool operator==(const RenderingAttachments&) const noexcept = default;
+
+    std::array<VkImageView, 8> color_views{};
+    u32 num_color_views{};
+    VkImageView depth_stencil_view{};
+    bool has_depth{};
+    bool has_stencil{};
+    u32 num_layers = 1;
+};
+
+/// Begins a render pass instance loading and storing the given attachments in general layout
+void BeginRendering(vk::CommandBuffer cmdbuf, const RenderingAttachments& attachments,
+                    VkExtent2D render_area, VkRenderingFlags flags);
+
 class RenderPassCache {
 public:
     explicit RenderPassCache(const Device& device_);
 
     VkRenderPass Get(const RenderPassKey& key);
 
+    /// Returns the attachment formats of a key, references stay valid for the cache lifetime
+    const RenderingFormats& GetRenderingFormats(const RenderPassKey& key);
+
 private:
     const Device* device{};
     std::unordered_map<RenderPassKey, vk::RenderPass> cache;
+    std::unordered_map<RenderPassKey, RenderingFormats> formats_cache;
     std::mutex mutex;
 };
 
@@ -42,6 +42,10 @@ size_t ResourcePool::CommitResource() {
     return *found;
 }
 
+u64 ResourcePool::CurrentTick() const noexcept {
+    return master_semaphore->CurrentTick();
+}
+
 size_t ResourcePool::ManageOverflow() {
     const size_t old_capacity = ticks.size();
     Grow();
@@ -31,6 +31,9 @@ public:
 protected:
     size_t CommitResource();
 
+    /// Returns the tick resources committed now are protected until.
+    [[nodiscard]] u64 CurrentTick() const noexcept;
+
     /// Called when a chunk of resources have to be allocated.
     virtual void Allocate(size_t begin, size_t end) = 0;
 
@@ -1,15 +1,21 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
 
+#include <boost/container/small_vector.hpp>
+
 #include "video_core/renderer_vulkan/vk_query_cache.h"
 
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
+#include "video_core/renderer_vulkan/vk_async_compute.h"
 #include "video_core/renderer_vulkan/vk_command_pool.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -18,7 +24,42 @@
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
+#ifdef ANDROID
+#include "common/android/performance_hint.h"
+#endif
+
 namespace Vulkan {
+namespace {
+// Maximum number of threads recording secondary command buffers
+constexpr size_t MAX_RECORDERS = 4;
+// Number of draw boundary dispatches recorded into a secondary command buffer before splitting it
+constexpr u32 DISPATCHES_PER_SEGMENT = 4;
+// Number of frames between barrier statistics reports
+constexpr u32 STATS_REPORT_FRAMES = 300;
+
+constexpr VkAccessFlags WRITE_ACCESS_FLAGS =
+    VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+    VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT |
+    VK_ACCESS_TRANSFORM_FEEDBACK_WRITE_BIT_EXT | VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT;
+
+/// Returns true when a memory barrier with the covering access mask includes the given accesses
+bool IsAccessCovered(VkAccessFlags covering, VkAccessFlags access) {
+    if ((covering & VK_ACCESS_MEMORY_WRITE_BIT) != 0) {
+        access &= ~WRITE_ACCESS_FLAGS;
+    }
+    if ((covering & VK_ACCESS_MEMORY_READ_BIT) != 0) {
+        access &= WRITE_ACCESS_FLAGS;
+    }
+    return (access & ~covering) == 0;
+}
+
+bool IsSameRange(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs) {
+    return lhs.aspectMask == rhs.aspectMask && lhs.baseMipLevel == rhs.baseMipLevel &&
+           lhs.levelCount == rhs.levelCount && lhs.baseArrayLayer == rhs.baseArrayLayer &&
+           lhs.layerCount == rhs.layerCount;
+}
+} // Anonymous namespace
 
 MICROPROFILE_DECLARE(Vulkan_WaitForWorker);
 
@@ -32,6 +73,11 @@ void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
         command = next;
     }
     submit = false;
+    upload = false;
+    begins_segment = false;
+    renderpass = nullptr;
+    framebuffer = nullptr;
+    rendering_formats = nullptr;
     command_offset = 0;
     first = nullptr;
     last = nullptr;
@@ -40,9 +86,36 @@ void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
 Scheduler::Scheduler(const Device& device_, StateTracker& state_tracker_)
     : device{device_}, state_tracker{state_tracker_},
       master_semaphore{std::make_unique<MasterSemaphore>(device)},
-      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)} {
+      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)},
+      parallel_recording{Settings::values.parallel_command_recording.GetValue()} {
+    if (device.HasAsyncComputeQueue()) {
+        async_compute = std::make_unique<AsyncComputeQueue>(device, *master_semaphore);
+    }
     AcquireNewChunk();
     AllocateWorkerCommandBuffer();
+    const bool adaptive_turbo =
+        Settings::values.renderer_force_max_clock.GetValue() && device.ShouldBoostClocks();
+    if (Settings::values.profile_gpu_passes.GetValue() ||
+        Settings::values.dynamic_resolution.GetValue() || adaptive_turbo) {
+        if (device.GetTimestampPeriod() > 0.0f) {
+            gpu_profiler = std::make_unique<GpuProfiler>(device, *this);
+        } else {
+            LOG_WARNING(Render_Vulkan, "GPU pass profiling, dynamic resolution and adaptive "
+                                       "turbo mode require timestamp queries");
+        }
+    }
+    if (parallel_recording) {
+        const size_t num_recorders =
+            std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_RECORDERS);
+        recorders.reserve(num_recorders);
+        for (size_t index = 0; index < num_recorders; ++index) {
+            recorders.push_back(Recorder{
+                .command_pool = std::make_unique<CommandPool>(*master_semaphore, device,
+                                                              VK_COMMAND_BUFFER_LEVEL_SECONDARY),
+                .thread = std::make_unique<Common::ThreadWorker>(1, "VulkanRecorder"),
+            });
+        }
+    }
     worker_thread = std::jthread([this](std::stop_token token) { WorkerThread(token); });
 }
 
@@ -81,6 +154,10 @@ void Scheduler::DispatchWork() {
     if (chunk->Empty()) {
         return;
     }
+    if (recording_secondary) {
+        chunk->MarkSecondary(state.renderpass, state.framebuffer, state.rendering_formats,
+                             std::exchange(begin_segment, false));
+    }
     {
         std::scoped_lock ql{queue_mutex};
         work_queue.push(std::move(chunk));
@@ -89,45 +166,63 @@ void Scheduler::DispatchWork() {
     AcquireNewChunk();
 }
 
+void Scheduler::DispatchWorkAtDrawBoundary() {
+    if (!parallel_recording || !state.renderpass) {
+        DispatchWork();
+        return;
+    }
+    if (!recording_secondary) {
+        BeginSecondaryRenderPass();
+        return;
+    }
+    if (++segment_dispatches < DISPATCHES_PER_SEGMENT) {
+        DispatchWork();
+        return;
+    }
+    // Queries and conditional rendering can't span secondary command buffers
+    if (query_cache) {
+        query_cache->NotifySegment(false);
+    }
+    DispatchWork();
+    begin_segment = true;
+    segment_dispatches = 0;
+
+    // Secondary command buffers don't inherit bound state
+    InvalidateState();
+}
+
 void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
-    const VkRenderPass renderpass = framebuffer->RenderPass();
-    const VkFramebuffer framebuffer_handle = framebuffer->Handle();
-    const VkExtent2D render_area = framebuffer->RenderArea();
-    if (renderpass == state.renderpass && framebuffer_handle == state.framebuffer &&
-        render_area.width == state.render_area.width &&
-        render_area.height == state.render_area.height) {
+    if (IsCurrentRenderpass(framebuffer)) {
         return;
     }
+    const bool ended_secondary = recording_secondary;
     EndRenderPass();
-    state.renderpass = renderpass;
-    state.framebuffer = framebuffer_handle;
-    state.render_area = render_area;
-
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
-        const VkRenderPassBeginInfo renderpass_bi{
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            .pNext = nullptr,
-            .renderPass = renderpass,
-            .framebuffer = framebuffer_handle,
-            .renderArea =
-                {
-                    .offset = {.x = 0, .y = 0},
-                    .extent = render_area,
-                },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
-        };
-        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
-    });
+    state.renderpass = framebuffer->RenderPass();
+    state.framebuffer = framebuffer->Handle();
+    state.rendering_formats = framebuffer->Formats();
+    state.attachments = framebuffer->Attachments();
+    state.render_area = framebuffer->RenderArea();
+    BeginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
     num_renderpass_images = framebuffer->NumImages();
     renderpass_images = framebuffer->Images();
     renderpass_image_ranges = framebuffer->ImageRanges();
+    if (ended_secondary) {
+        ResumeConditionalRendering();
+    }
 }
 
 void Scheduler::RequestOutsideRenderPassOperationContext() {
     EndRenderPass();
 }
 
+bool Scheduler::PrepareRenderpass(const Framebuffer* framebuffer) {
+    if (recording_secondary && !IsCurrentRenderpass(framebuffer)) {
+        EndRenderPass();
+        ResumeConditionalRendering();
+    }
+    return std::exchange(secondary_state_lost, false);
+}
+
 bool Scheduler::UpdateGraphicsPipeline(GraphicsPipeline* pipeline) {
     if (state.graphics_pipeline == pipeline) {
         return false;
@@ -147,6 +242,10 @@ bool Scheduler::UpdateRescaling(bool is_rescaling) {
 
 void Scheduler::WorkerThread(std::stop_token stop_token) {
     Common::SetCurrentThreadName("VulkanWorker");
+#ifdef ANDROID
+    const Common::Android::ScopedHintThread hint_thread{
+        Common::Android::HintSession::VulkanSubmit};
+#endif
 
     const auto TryPopQueue{[this](auto& work) -> bool {
         if (work_queue.empty()) {
@@ -181,12 +280,31 @@ void Scheduler::WorkerThread(std::stop_token stop_token) {
             // Perform the work, tracking whether the chunk was a submission
             // before executing.
             const bool has_submit = work->HasSubmit();
-            work->ExecuteAll(current_cmdbuf, current_upload_cmdbuf);
+            if (work->IsSecondary()) {
+                RecordSecondary(std::move(work));
+            } else {
+                ExecuteSecondaries();
+                work->ExecuteAll(current_cmdbuf, current_upload_cmdbuf);
+            }
 
             // If the chunk was a submission, reallocate the command buffer.
             if (has_submit) {
                 AllocateWorkerCommandBuffer();
             }
+            if (!work) {
+                // Make sure the commands sent so far have been executed once the queue is drained,
+                // callers waiting for the worker expect it.
+                bool is_drained;
+                {
+                    std::scoped_lock ql{queue_mutex};
+                    is_drained = work_queue.empty();
+                }
+                if (is_drained) {
+                    WaitRecorders();
+                }
+                // Secondary chunks are recycled by the recorder threads
+                continue;
+            }
         }
 
         {
@@ -198,6 +316,119 @@ void Scheduler::WorkerThread(std::stop_token stop_token) {
     }
 }
 
+void Scheduler::RecordSecondary(std::unique_ptr<CommandChunk> work) {
+    if (!open_segment || work->BeginsSegment()) {
+        CloseSegment();
+        open_segment = segments
+                           .emplace_back(std::make_unique<SecondarySegment>(SecondarySegment{
+                               .renderpass = work->RenderPass(),
+                               .framebuffer = work->Framebuffer(),
+                               .rendering_formats = work->Formats(),
+                               .recorder_index = next_recorder,
+                               .cmdbuf{},
+                               .upload_cmdbuf{},
+                           }))
+                           .get();
+        next_recorder = (next_recorder + 1) % recorders.size();
+
+        Recorder& recorder = recorders[open_segment->recorder_index];
+        recorder.thread->QueueWork([this, &recorder, segment = open_segment] {
+            // Secondaries of dynamic rendering instances inherit attachment formats instead
+            const RenderingFormats* const formats{segment->rendering_formats};
+            const VkCommandBufferInheritanceRenderingInfo rendering_info{
+                formats ? formats->InheritanceInfo() : VkCommandBufferInheritanceRenderingInfo{}};
+            const VkCommandBufferInheritanceInfo inheritance_info{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                .pNext = formats ? &rendering_info : nullptr,
+                .renderPass = formats ? VK_NULL_HANDLE : segment->renderpass,
+                .subpass = 0,
+                .framebuffer = segment->framebuffer,
+                .occlusionQueryEnable = VK_FALSE,
+                .queryFlags = 0,
+                .pipelineStatistics = 0,
+            };
+            segment->cmdbuf =
+                vk::CommandBuffer(recorder.command_pool->Commit(), device.GetDispatchLoader());
+            segment->cmdbuf.Begin({
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                .pNext = nullptr,
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                         VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                .pInheritanceInfo = &inheritance_info,
+            });
+        });
+    }
+    Recorder& recorder = recorders[open_segment->recorder_index];
+    recorder.thread->QueueWork([this, &recorder, segment = open_segment,
+                                work = std::move(work)]() mutable {
+        if (work->HasUpload() && !*segment->upload_cmdbuf) {
+            static constexpr VkCommandBufferInheritanceInfo inheritance_info{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                .pNext = nullptr,
+                .renderPass = VK_NULL_HANDLE,
+                .subpass = 0,
+                .framebuffer = VK_NULL_HANDLE,
+                .occlusionQueryEnable = VK_FALSE,
+                .queryFlags = 0,
+                .pipelineStatistics = 0,
+            };
+            segment->upload_cmdbuf =
+                vk::CommandBuffer(recorder.command_pool->Commit(), device.GetDispatchLoader());
+            segment->upload_cmdbuf.Begin({
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                .pNext = nullptr,
+                .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                .pInheritanceInfo = &inheritance_info,
+            });
+        }
+        work->ExecuteAll(segment->cmdbuf, segment->upload_cmdbuf);
+
+        std::scoped_lock rl{reserve_mutex};
+        chunk_reserve.emplace_back(std::move(work));
+    });
+}
+
+void Scheduler::CloseSegment() {
+    if (!open_segment) {
+        return;
+    }
+    recorders[open_segment->recorder_index].thread->QueueWork([segment = open_segment] {
+        segment->cmdbuf.End();
+        if (*segment->upload_cmdbuf) {
+            segment->upload_cmdbuf.End();
+        }
+    });
+    open_segment = nullptr;
+}
+
+void Scheduler::WaitRecorders() {
+    for (Recorder& recorder : recorders) {
+        recorder.thread->WaitForRequests();
+    }
+}
+
+void Scheduler::ExecuteSecondaries() {
+    if (segments.empty()) {
+        return;
+    }
+    CloseSegment();
+    WaitRecorders();
+
+    boost::container::small_vector<VkCommandBuffer, 16> cmdbufs;
+    boost::container::small_vector<VkCommandBuffer, 16> upload_cmdbufs;
+    for (const auto& segment : segments) {
+        cmdbufs.push_back(*segment->cmdbuf);
+        if (*segment->upload_cmdbuf) {
+            upload_cmdbufs.push_back(*segment->upload_cmdbuf);
+        }
+    }
+    if (!upload_cmdbufs.empty()) {
+        current_upload_cmdbuf.ExecuteCommands(upload_cmdbufs);
+    }
+    current_cmdbuf.ExecuteCommands(cmdbufs);
+    segments.clear();
+}
+
 void Scheduler::AllocateWorkerCommandBuffer() {
     current_cmdbuf = vk::CommandBuffer(command_pool->Commit(), device.GetDispatchLoader());
     current_cmdbuf.Begin({
@@ -218,8 +449,12 @@ void Scheduler::AllocateWorkerCommandBuffer() {
 u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore) {
     EndPendingOperations();
     InvalidateState();
+    if (pending_barriers.src_stages != 0) {
+        FlushBarriers();
+    }
 
     const u64 signal_value = master_semaphore->NextTick();
+    async_compute_pending = false;
     RecordWithUploadBuffer([signal_semaphore, wait_semaphore, signal_value,
                             this](vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf) {
         static constexpr VkMemoryBarrier WRITE_BARRIER{
@@ -237,9 +472,15 @@ u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_se
             on_submit();
         }
 
+        // Async compute work recorded for this submission goes first, so it can be waited on
+        const u64 compute_tick = async_compute ? async_compute->Submit() : 0;
+        const VkSemaphore compute_semaphore =
+            compute_tick != 0 ? async_compute->Semaphore() : VK_NULL_HANDLE;
+
         std::scoped_lock lock{submit_mutex};
         switch (const VkResult result = master_semaphore->SubmitQueue(
-                    cmdbuf, upload_cmdbuf, signal_semaphore, wait_semaphore, signal_value)) {
+                    cmdbuf, upload_cmdbuf, signal_semaphore, wait_semaphore, signal_value,
+                    compute_semaphore, compute_tick)) {
         case VK_SUCCESS:
             break;
         case VK_ERROR_DEVICE_LOST:
@@ -255,6 +496,10 @@ u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_se
     return signal_value;
 }
 
+vk::CommandBuffer Scheduler::AsyncComputeCommandBuffer() {
+    return async_compute->CommandBuffer();
+}
+
 void Scheduler::AllocateNewContext() {
     // Enable counters once again. These are disabled when a command buffer is finished.
     if (query_cache) {
@@ -275,6 +520,77 @@ void Scheduler::InvalidateState() {
     state_tracker.InvalidateCommandBufferState();
 }
 
+void Scheduler::RequestBarrier(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage,
+                               VkAccessFlags src_access, VkAccessFlags dst_access) {
+    EndRenderPass();
+    ++num_requested_barriers;
+    pending_barriers.src_stages |= src_stage;
+    pending_barriers.dst_stages |= dst_stage;
+    pending_barriers.src_access |= src_access;
+    pending_barriers.dst_access |= dst_access;
+}
+
+void Scheduler::RequestBarrier(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage,
+                               const VkImageMemoryBarrier& barrier) {
+    EndRenderPass();
+    ++num_requested_barriers;
+    auto& image_barriers = pending_barriers.image_barriers;
+    const auto it = std::ranges::find(image_barriers, barrier.image, &VkImageMemoryBarrier::image);
+    if (it != image_barriers.end()) {
+        if (IsSameRange(it->subresourceRange, barrier.subresourceRange) &&
+            it->newLayout == barrier.oldLayout) {
+            // Nothing accesses the image between both barriers, fold them into one transition
+            it->srcAccessMask |= barrier.srcAccessMask;
+            it->dstAccessMask |= barrier.dstAccessMask;
+            it->newLayout = barrier.newLayout;
+            pending_barriers.src_stages |= src_stage;
+            pending_barriers.dst_stages |= dst_stage;
+            return;
+        }
+        // Barriers of the same image within a pipeline barrier are not ordered
+        FlushBarriers();
+    }
+    pending_barriers.src_stages |= src_stage;
+    pending_barriers.dst_stages |= dst_stage;
+    image_barriers.push_back(barrier);
+}
+
+void Scheduler::RequestBarrier(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage,
+                               const VkBufferMemoryBarrier& barrier) {
+    EndRenderPass();
+    ++num_requested_barriers;
+    pending_barriers.src_stages |= src_stage;
+    pending_barriers.dst_stages |= dst_stage;
+    auto& buffer_barriers = pending_barriers.buffer_barriers;
+    const auto it = std::ranges::find_if(buffer_barriers, [&barrier](const auto& pending) {
+        return pending.buffer == barrier.buffer && pending.offset == barrier.offset &&
+               pending.size == barrier.size;
+    });
+    if (it != buffer_barriers.end()) {
+        it->srcAccessMask |= barrier.srcAccessMask;
+        it->dstAccessMask |= barrier.dstAccessMask;
+        return;
+    }
+    buffer_barriers.push_back(barrier);
+}
+
+void Scheduler::TickFrame() {
+    if (gpu_profiler) {
+        gpu_profiler->TickFrame();
+    }
+    if (++frame_count % STATS_REPORT_FRAMES != 0) {
+        return;
+    }
+    const u64 num_requested = std::exchange(num_requested_barriers, 0);
+    const u64 num_recorded = std::exchange(num_recorded_barriers, 0);
+    if (num_requested == 0) {
+        return;
+    }
+    LOG_DEBUG(Render_Vulkan,
+              "Barriers in the last {} frames: {} requested, {} recorded, {} merged or elided",
+              STATS_REPORT_FRAMES, num_requested, num_recorded, num_requested - num_recorded);
+}
+
 void Scheduler::EndPendingOperations() {
 #if ANDROID
     if (Settings::IsGPULevelHigh()) {
@@ -288,12 +604,97 @@ void Scheduler::EndPendingOperations() {
     EndRenderPass();
 }
 
+bool Scheduler::IsCurrentRenderpass(const Framebuffer* framebuffer) const {
+    const VkExtent2D render_area = framebuffer->RenderArea();
+    if (framebuffer->Formats()) {
+        // Without framebuffer objects, passes drawing to the same attachments within the current
+        // render area are merged into the current render pass instance
+        return framebuffer->RenderPass() == state.renderpass &&
+               framebuffer->Attachments() == state.attachments &&
+               render_area.width <= state.render_area.width &&
+               render_area.height <= state.render_area.height;
+    }
+    return framebuffer->RenderPass() == state.renderpass &&
+           framebuffer->Handle() == state.framebuffer &&
+           render_area.width == state.render_area.width &&
+           render_area.height == state.render_area.height;
+}
+
+void Scheduler::BeginRenderPass(VkSubpassContents contents) {
+    if (gpu_profiler) {
+        // Render passes are told apart by the size of their render targets
+        const u64 tag{(u64{state.render_area.width} << 32) | state.render_area.height};
+        renderpass_time_range = gpu_profiler->Begin(GpuTimeCategory::RenderPass, tag);
+    }
+    if (state.rendering_formats) {
+        Record([attachments = state.attachments, render_area = state.render_area,
+                contents](vk::CommandBuffer cmdbuf) {
+            const VkRenderingFlags flags{contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                             ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+                                             : 0U};
+            BeginRendering(cmdbuf, attachments, render_area, flags);
+        });
+        return;
+    }
+    Record([renderpass = state.renderpass, framebuffer_handle = state.framebuffer,
+            render_area = state.render_area, contents](vk::CommandBuffer cmdbuf) {
+        const VkRenderPassBeginInfo renderpass_bi{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .pNext = nullptr,
+            .renderPass = renderpass,
+            .framebuffer = framebuffer_handle,
+            .renderArea =
+                {
+                    .offset = {.x = 0, .y = 0},
+                    .extent = render_area,
+                },
+            .clearValueCount = 0,
+            .pClearValues = nullptr,
+        };
+        cmdbuf.BeginRenderPass(renderpass_bi, contents);
+    });
+}
+
+void Scheduler::BeginSecondaryRenderPass() {
+    // Queries and conditional rendering can't be active when secondary command buffers execute
+    if (query_cache) {
+        query_cache->NotifySegment(false);
+    }
+    // Render passes load and store their attachments, so the remaining draws of the current one
+    // are recorded in a new instance with its contents in secondary command buffers
+    const State current_state = state;
+    const u32 num_images = num_renderpass_images;
+    EndRenderPass();
+    state = current_state;
+    num_renderpass_images = num_images;
+    BeginRenderPass(VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    DispatchWork();
+
+    recording_secondary = true;
+    begin_segment = true;
+    segment_dispatches = 0;
+
+    // Secondary command buffers don't inherit bound state
+    InvalidateState();
+}
+
 void Scheduler::EndRenderPass() {
     if (!state.renderpass) {
         return;
     }
+    const bool ended_secondary = recording_secondary;
+    if (ended_secondary) {
+        // Queries and conditional rendering begun in a secondary command buffer have to end in it
+        if (query_cache) {
+            query_cache->NotifySegment(false);
+        }
+        DispatchWork();
+        recording_secondary = false;
+        begin_segment = false;
+    }
     Record([num_images = num_renderpass_images, images = renderpass_images,
-            ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
+            ranges = renderpass_image_ranges,
+            is_dynamic = state.rendering_formats != nullptr](vk::CommandBuffer cmdbuf) {
         std::array<VkImageMemoryBarrier, 9> barriers;
         for (size_t i = 0; i < num_images; ++i) {
             barriers[i] = VkImageMemoryBarrier{
@@ -314,15 +715,74 @@ void Scheduler::EndRenderPass() {
                 .subresourceRange = ranges[i],
             };
         }
-        cmdbuf.EndRenderPass();
+        if (is_dynamic) {
+            cmdbuf.EndRendering();
+        } else {
+            cmdbuf.EndRenderPass();
+        }
         cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                                    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
                                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
                                vk::Span(barriers.data(), num_images));
     });
+    if (gpu_profiler) {
+        gpu_profiler->End(std::exchange(renderpass_time_range, GpuProfiler::INVALID_RANGE));
+    }
     state.renderpass = nullptr;
     num_renderpass_images = 0;
+    if (ended_secondary) {
+        // Bound state does not carry over from secondary command buffers
+        InvalidateState();
+        secondary_state_lost = true;
+    }
+}
+
+void Scheduler::ResumeConditionalRendering() {
+    if (query_cache) {
+        query_cache->NotifySegment(true);
+    }
+}
+
+void Scheduler::FlushBarriers() {
+    PendingBarriers barriers{std::exchange(pending_barriers, {})};
+
+    // Barriers without layout transitions are satisfied by a memory barrier covering their access
+    const auto is_covered{[&barriers](VkAccessFlags src_access, VkAccessFlags dst_access) {
+        return IsAccessCovered(barriers.src_access, src_access) &&
+               IsAccessCovered(barriers.dst_access, dst_access);
+    }};
+    auto& image_barriers = barriers.image_barriers;
+    image_barriers.erase(std::remove_if(image_barriers.begin(), image_barriers.end(),
+                                        [&](const VkImageMemoryBarrier& barrier) {
+                                            return barrier.oldLayout == barrier.newLayout &&
+                                                   is_covered(barrier.srcAccessMask,
+                                                              barrier.dstAccessMask);
+                                        }),
+                         image_barriers.end());
+    auto& buffer_barriers = barriers.buffer_barriers;
+    buffer_barriers.erase(std::remove_if(buffer_barriers.begin(), buffer_barriers.end(),
+                                         [&](const VkBufferMemoryBarrier& barrier) {
+                                             return is_covered(barrier.srcAccessMask,
+                                                               barrier.dstAccessMask);
+                                         }),
+                          buffer_barriers.end());
+    ++num_recorded_barriers;
+
+    auto func = [barriers = std::move(barriers)](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
+        const VkMemoryBarrier memory_barrier{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = barriers.src_access,
+            .dstAccessMask = barriers.dst_access,
+        };
+        const bool has_memory_barrier{(barriers.src_access | barriers.dst_access) != 0};
+        cmdbuf.PipelineBarrier(barriers.src_stages, barriers.dst_stages, 0,
+                               has_memory_barrier ? vk::Span<VkMemoryBarrier>(memory_barrier)
+                                                  : vk::Span<VkMemoryBarrier>{},
+                               barriers.buffer_barriers, barriers.image_barriers);
+    };
+    RecordCommand(func);
 }
 
 void Scheduler::AcquireNewChunk() {
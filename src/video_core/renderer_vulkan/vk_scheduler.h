@@ -10,11 +10,16 @@
 #include <thread>
 #include <utility>
 #include <queue>
+#include <vector>
+#include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "common/thread_worker.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
+#include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace VideoCommon {
@@ -24,6 +29,7 @@ class QueryCacheBase;
 
 namespace Vulkan {
 
+class AsyncComputeQueue;
 class CommandPool;
 class Device;
 class Framebuffer;
@@ -52,6 +58,10 @@ public:
     /// Sends currently recorded work to the worker thread.
     void DispatchWork();
 
+    /// Sends currently recorded work to the worker thread from a point between draws. With
+    /// parallel command recording, render passes are split here into secondary command buffers.
+    void DispatchWorkAtDrawBoundary();
+
     /// Requests to begin a renderpass.
     void RequestRenderpass(const Framebuffer* framebuffer);
 
@@ -59,6 +69,11 @@ public:
     /// of a renderpass.
     void RequestOutsideRenderPassOperationContext();
 
+    /// Ends the current secondary command buffer render pass if the given framebuffer can't
+    /// continue it. Returns true when state bound by the current draw was recorded into a secondary
+    /// command buffer that has ended, so it has to be bound again before the draw.
+    bool PrepareRenderpass(const Framebuffer* framebuffer);
+
     /// Update the pipeline to the current execution context.
     bool UpdateGraphicsPipeline(GraphicsPipeline* pipeline);
 
@@ -68,6 +83,24 @@ public:
     /// Invalidates current command buffer state except for render passes
     void InvalidateState();
 
+    /// Requests a memory barrier before the next recorded command, outside of render passes.
+    /// Barriers requested back to back are recorded as a single pipeline barrier, and barriers
+    /// already satisfied by it are dropped.
+    void RequestBarrier(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage,
+                        VkAccessFlags src_access, VkAccessFlags dst_access);
+
+    /// Requests an image memory barrier before the next recorded command, outside of render passes.
+    /// Layout transitions of the same subresources requested back to back are folded together.
+    void RequestBarrier(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage,
+                        const VkImageMemoryBarrier& barrier);
+
+    /// Requests a buffer memory barrier before the next recorded command, outside of render passes.
+    void RequestBarrier(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage,
+                        const VkBufferMemoryBarrier& barrier);
+
+    /// Reports barrier statistics periodically.
+    void TickFrame();
+
     /// Assigns the query cache.
     void SetQueryCache(VideoCommon::QueryCacheBase<QueryCacheParams>& query_cache_) {
         query_cache = &query_cache_;
@@ -82,20 +115,42 @@ public:
     template <typename T>
         requires std::is_invocable_v<T, vk::CommandBuffer, vk::CommandBuffer>
     void RecordWithUploadBuffer(T&& command) {
-        if (chunk->Record(command)) {
-            return;
-        }
-        DispatchWork();
-        (void)chunk->Record(command);
+        RecordCommand(command);
+        chunk->MarkUpload();
     }
 
     template <typename T>
         requires std::is_invocable_v<T, vk::CommandBuffer>
     void Record(T&& c) {
-        this->RecordWithUploadBuffer(
-            [command = std::move(c)](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
-                command(cmdbuf);
-            });
+        if (pending_barriers.src_stages != 0) [[unlikely]] {
+            FlushBarriers();
+        }
+        auto func = [command = std::move(c)](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
+            command(cmdbuf);
+        };
+        RecordCommand(func);
+    }
+
+    /// Returns true when compute work can be recorded to an async compute queue.
+    [[nodiscard]] bool HasAsyncCompute() const noexcept {
+        return async_compute != nullptr;
+    }
+
+    /// Records commands to the async compute queue, outside of render passes. They are submitted
+    /// before the next graphics submission, which waits on them. Graphics work recorded before the
+    /// first async compute command of a submission is flushed, so it does not have to wait.
+    /// Resources used by both queues must have their ownership transferred between them.
+    template <typename T>
+        requires std::is_invocable_v<T, vk::CommandBuffer>
+    void RecordAsyncCompute(T&& c) {
+        if (!async_compute_pending) {
+            Flush();
+            async_compute_pending = true;
+        }
+        RequestOutsideRenderPassOperationContext();
+        Record([this, command = std::move(c)](vk::CommandBuffer) {
+            command(AsyncComputeCommandBuffer());
+        });
     }
 
     /// Returns the current command buffer tick.
@@ -122,6 +177,11 @@ public:
         return *master_semaphore;
     }
 
+    /// Returns the GPU pass profiler, null when profiling is disabled.
+    [[nodiscard]] GpuProfiler* GetGpuProfiler() const noexcept {
+        return gpu_profiler.get();
+    }
+
     std::mutex submit_mutex;
 
 private:
@@ -189,6 +249,18 @@ private:
             submit = true;
         }
 
+        void MarkUpload() {
+            upload = true;
+        }
+
+        void MarkSecondary(VkRenderPass renderpass_, VkFramebuffer framebuffer_,
+                           const RenderingFormats* rendering_formats_, bool begins_segment_) {
+            renderpass = renderpass_;
+            framebuffer = framebuffer_;
+            rendering_formats = rendering_formats_;
+            begins_segment = begins_segment_;
+        }
+
         bool Empty() const {
             return command_offset == 0;
         }
@@ -197,26 +269,108 @@ private:
             return submit;
         }
 
+        bool HasUpload() const {
+            return upload;
+        }
+
+        /// Returns true when the chunk is recorded into a secondary command buffer
+        bool IsSecondary() const {
+            return renderpass != nullptr;
+        }
+
+        /// Returns true when the chunk can't continue the previous secondary command buffer
+        bool BeginsSegment() const {
+            return begins_segment;
+        }
+
+        VkRenderPass RenderPass() const {
+            return renderpass;
+        }
+
+        VkFramebuffer Framebuffer() const {
+            return framebuffer;
+        }
+
+        const RenderingFormats* Formats() const {
+            return rendering_formats;
+        }
+
     private:
         Command* first = nullptr;
         Command* last = nullptr;
 
         size_t command_offset = 0;
         bool submit = false;
+        bool upload = false;
+        bool begins_segment = false;
+        VkRenderPass renderpass = nullptr;
+        VkFramebuffer framebuffer = nullptr;
+        const RenderingFormats* rendering_formats = nullptr;
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
     struct State {
         VkRenderPass renderpass = nullptr;
         VkFramebuffer framebuffer = nullptr;
+        const RenderingFormats* rendering_formats = nullptr; ///< Non-null with dynamic rendering
+        RenderingAttachments attachments{};
         VkExtent2D render_area = {0, 0};
         GraphicsPipeline* graphics_pipeline = nullptr;
         bool is_rescaling = false;
         bool rescaling_defined = false;
     };
 
+    /// Secondary command buffer recording a run of chunks within a render pass.
+    struct SecondarySegment {
+        VkRenderPass renderpass;
+        VkFramebuffer framebuffer;
+        const RenderingFormats* rendering_formats;
+        size_t recorder_index;
+        vk::CommandBuffer cmdbuf;
+        vk::CommandBuffer upload_cmdbuf;
+    };
+
+    /// Barriers requested since the last recorded command, recorded as one pipeline barrier.
+    struct PendingBarriers {
+        VkPipelineStageFlags src_stages = 0;
+        VkPipelineStageFlags dst_stages = 0;
+        VkAccessFlags src_access = 0; ///< Source access of the global memory barrier
+        VkAccessFlags dst_access = 0; ///< Destination access of the global memory barrier
+        boost::container::small_vector<VkImageMemoryBarrier, 4> image_barriers;
+        boost::container::small_vector<VkBufferMemoryBarrier, 2> buffer_barriers;
+    };
+
+    /// Thread recording secondary command buffers from its own command pool.
+    struct Recorder {
+        std::unique_ptr<CommandPool> command_pool;
+        std::unique_ptr<Common::ThreadWorker> thread;
+    };
+
+    template <typename T>
+    void RecordCommand(T& command) {
+        if (chunk->Record(command)) {
+            return;
+        }
+        DispatchWork();
+        (void)chunk->Record(command);
+    }
+
     void WorkerThread(std::stop_token stop_token);
 
+    void RecordSecondary(std::unique_ptr<CommandChunk> work);
+
+    void CloseSegment();
+
+    void WaitRecorders();
+
+    void ExecuteSecondaries();
+
+    bool IsCurrentRenderpass(const Framebuffer* framebuffer) const;
+
+    void BeginRenderPass(VkSubpassContents contents);
+
+    void BeginSecondaryRenderPass();
+
     void AllocateWorkerCommandBuffer();
 
     u64 SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore);
@@ -227,13 +381,21 @@ private:
 
     void EndRenderPass();
 
+    void ResumeConditionalRendering();
+
     void AcquireNewChunk();
 
+    void FlushBarriers();
+
+    vk::CommandBuffer AsyncComputeCommandBuffer();
+
     const Device& device;
     StateTracker& state_tracker;
 
     std::unique_ptr<MasterSemaphore> master_semaphore;
     std::unique_ptr<CommandPool> command_pool;
+    std::unique_ptr<AsyncComputeQueue> async_compute;
+    std::unique_ptr<GpuProfiler> gpu_profiler;
 
     VideoCommon::QueryCacheBase<QueryCacheParams>* query_cache = nullptr;
 
@@ -245,6 +407,19 @@ private:
 
     State state;
 
+    PendingBarriers pending_barriers;
+    u32 frame_count = 0;
+    u64 num_requested_barriers = 0; ///< Barriers requested since the last report
+    u64 num_recorded_barriers = 0;  ///< Pipeline barriers recorded since the last report
+
+    bool parallel_recording = false;  ///< Render passes may be recorded in secondary buffers
+    bool recording_secondary = false; ///< Recorded chunks go to secondary command buffers
+    bool begin_segment = false;       ///< The next dispatched chunk begins a new secondary
+    bool secondary_state_lost = false;
+    u32 segment_dispatches = 0;
+    bool async_compute_pending = false; ///< Async compute work was recorded since the last submit
+
+    u32 renderpass_time_range = GpuProfiler::INVALID_RANGE; ///< GPU time of the render pass
     u32 num_renderpass_images = 0;
     std::array<VkImage, 9> renderpass_images{};
     std::array<VkImageSubresourceRange, 9> renderpass_image_ranges{};
@@ -255,6 +430,12 @@ private:
     std::mutex reserve_mutex;
     std::mutex queue_mutex;
     std::condition_variable_any event_cv;
+
+    std::vector<std::unique_ptr<SecondarySegment>> segments; ///< Owned by the worker thread
+    SecondarySegment* open_segment = nullptr;
+    size_t next_recorder = 0;
+    std::vector<Recorder> recorders;
+
     std::jthread worker_thread;
 };
 
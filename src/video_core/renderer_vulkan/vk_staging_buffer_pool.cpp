@@ -12,6 +12,8 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -26,6 +28,10 @@ using namespace Common::Literals;
 constexpr VkDeviceSize MAX_ALIGNMENT = 256;
 // Stream buffer size in bytes
 constexpr VkDeviceSize MAX_STREAM_BUFFER_SIZE = 128_MiB;
+// Size of each staging arena in bytes
+constexpr VkDeviceSize ARENA_SIZE = 64_MiB;
+// Largest request sub-allocated from an arena, bigger ones get a dedicated buffer
+constexpr VkDeviceSize MAX_ARENA_ALLOCATION = 16_MiB;
 
 size_t GetStreamBufferSize(const Device& device) {
     VkDeviceSize size{0};
@@ -49,8 +55,9 @@ size_t GetStreamBufferSize(const Device& device) {
 StagingBufferPool::StagingBufferPool(const Device& device_, MemoryAllocator& memory_allocator_,
                                      Scheduler& scheduler_)
     : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_},
-      stream_buffer_size{GetStreamBufferSize(device)}, region_size{stream_buffer_size /
-                                                                   StagingBufferPool::NUM_SYNCS} {
+      stream_buffer_size{GetStreamBufferSize(device)},
+      region_size{stream_buffer_size / StagingBufferPool::NUM_SYNCS},
+      use_arenas{Settings::values.use_staging_arena.GetValue()} {
     VkBufferCreateInfo stream_ci = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
@@ -77,11 +84,18 @@ StagingBufferPool::~StagingBufferPool() = default;
 
 StagingBufferRef StagingBufferPool::Request(size_t size, MemoryUsage usage, bool deferred) {
     if (!deferred && usage == MemoryUsage::Upload && size <= region_size) {
-        return GetStreamBuffer(size);
+        return GetStreamBuffer(size, MAX_ALIGNMENT);
     }
     return GetStagingBuffer(size, usage, deferred);
 }
 
+StagingBufferRef StagingBufferPool::RequestStream(size_t size, VkDeviceSize alignment) {
+    if (size > region_size) {
+        return GetStagingBuffer(size, MemoryUsage::Upload);
+    }
+    return GetStreamBuffer(size, alignment);
+}
+
 void StagingBufferPool::FreeDeferred(StagingBufferRef& ref) {
     auto& entries = GetCache(ref.usage)[ref.log2_level].entries;
     const auto is_this_one = [&ref](const StagingBuffer& entry) {
@@ -100,11 +114,19 @@ void StagingBufferPool::TickFrame() {
     ReleaseCache(MemoryUsage::DeviceLocal);
     ReleaseCache(MemoryUsage::Upload);
     ReleaseCache(MemoryUsage::Download);
+
+    if (use_arenas) {
+        ReleaseArenaAllocations();
+        ReleaseArenas(MemoryUsage::DeviceLocal);
+        ReleaseArenas(MemoryUsage::Upload);
+        ReleaseArenas(MemoryUsage::Download);
+    }
 }
 
-StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
+StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size, VkDeviceSize alignment) {
+    size_t offset = Common::AlignUp(iterator, alignment);
     if (AreRegionsActive(Region(free_iterator) + 1,
-                         std::min(Region(iterator + size) + 1, NUM_SYNCS))) {
+                         std::min(Region(offset + size) + 1, NUM_SYNCS))) {
         // Avoid waiting for the previous usages to be free
         return GetStagingBuffer(size, MemoryUsage::Upload);
     }
@@ -112,22 +134,22 @@ StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
     std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + Region(iterator),
               current_tick);
     used_iterator = iterator;
-    free_iterator = std::max(free_iterator, iterator + size);
+    free_iterator = std::max(free_iterator, offset + size);
 
-    if (iterator + size >= stream_buffer_size) {
+    if (offset + size >= stream_buffer_size) {
         std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + NUM_SYNCS,
                   current_tick);
         used_iterator = 0;
-        iterator = 0;
+        offset = 0;
         free_iterator = size;
 
         if (AreRegionsActive(0, Region(size) + 1)) {
             // Avoid waiting for the previous usages to be free
+            iterator = 0;
             return GetStagingBuffer(size, MemoryUsage::Upload);
         }
     }
-    const size_t offset = iterator;
-    iterator = Common::AlignUp(iterator + size, MAX_ALIGNMENT);
+    iterator = offset + size;
     return StagingBufferRef{
         .buffer = *stream_buffer,
         .offset = static_cast<VkDeviceSize>(offset),
@@ -146,6 +168,11 @@ bool StagingBufferPool::AreRegionsActive(size_t region_begin, size_t region_end)
 
 StagingBufferRef StagingBufferPool::GetStagingBuffer(size_t size, MemoryUsage usage,
                                                      bool deferred) {
+    // Deferred buffers are indexed from their first byte and held for an unbounded time, so they
+    // keep using dedicated buffers
+    if (use_arenas && !deferred && size <= MAX_ARENA_ALLOCATION) {
+        return GetArenaBuffer(size, usage);
+    }
     if (const std::optional<StagingBufferRef> ref = TryGetReservedBuffer(size, usage, deferred)) {
         return *ref;
     }
@@ -179,22 +206,7 @@ std::optional<StagingBufferRef> StagingBufferPool::TryGetReservedBuffer(size_t s
 StagingBufferRef StagingBufferPool::CreateStagingBuffer(size_t size, MemoryUsage usage,
                                                         bool deferred) {
     const u32 log2 = Common::Log2Ceil64(size);
-    VkBufferCreateInfo buffer_ci = {
-        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .size = 1ULL << log2,
-        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 0,
-        .pQueueFamilyIndices = nullptr,
-    };
-    if (device.IsExtTransformFeedbackSupported()) {
-        buffer_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
-    }
-    vk::Buffer buffer = memory_allocator.CreateBuffer(buffer_ci, usage);
+    vk::Buffer buffer = CreateBuffer(1ULL << log2, usage);
     if (device.HasDebuggingToolAttached()) {
         ++buffer_index;
         buffer.SetObjectNameEXT(fmt::format("Staging Buffer {}", buffer_index).c_str());
@@ -212,6 +224,141 @@ StagingBufferRef StagingBufferPool::CreateStagingBuffer(size_t size, MemoryUsage
     return entry.Ref();
 }
 
+vk::Buffer StagingBufferPool::CreateBuffer(VkDeviceSize size, MemoryUsage usage) {
+    VkBufferCreateInfo buffer_ci = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .size = size,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    };
+    if (device.IsExtTransformFeedbackSupported()) {
+        buffer_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+    }
+    return memory_allocator.CreateBuffer(buffer_ci, usage);
+}
+
+StagingBufferRef StagingBufferPool::GetArenaBuffer(size_t size, MemoryUsage usage) {
+    ReleaseArenaAllocations();
+
+    const VkDeviceSize alloc_size = Common::AlignUp(static_cast<VkDeviceSize>(size), MAX_ALIGNMENT);
+    auto& arenas = GetArenas(usage);
+    StagingArena* arena = nullptr;
+    std::optional<VkDeviceSize> offset;
+    for (const auto& candidate : arenas) {
+        offset = candidate->Allocate(alloc_size, MAX_ALIGNMENT);
+        if (offset) {
+            arena = candidate.get();
+            break;
+        }
+    }
+    if (!arena) {
+        // Every arena is full or in use by the GPU, grow instead of waiting
+        vk::Buffer buffer = CreateBuffer(ARENA_SIZE, usage);
+        if (device.HasDebuggingToolAttached()) {
+            buffer.SetObjectNameEXT(fmt::format("Staging Arena {}", arenas.size()).c_str());
+        }
+        const std::span<u8> mapped_span = buffer.Mapped();
+        arena = arenas
+                    .emplace_back(std::make_unique<StagingArena>(StagingArena{
+                        .buffer = std::move(buffer),
+                        .mapped_span = mapped_span,
+                        .size = ARENA_SIZE,
+                        .free_bytes = ARENA_SIZE,
+                        .free_ranges{{0, ARENA_SIZE}},
+                    }))
+                    .get();
+        LOG_DEBUG(Render_Vulkan, "Created staging arena, {} MiB in {} arenas for usage={}",
+                  arenas.size() * ARENA_SIZE / 1_MiB, arenas.size(), usage);
+        offset = arena->Allocate(alloc_size, MAX_ALIGNMENT);
+        ASSERT(offset);
+    }
+    arena_releases.push_back(ArenaRelease{
+        .arena = arena,
+        .offset = *offset,
+        .size = alloc_size,
+        .tick = scheduler.CurrentTick(),
+    });
+    return StagingBufferRef{
+        .buffer = *arena->buffer,
+        .offset = *offset,
+        .mapped_span = arena->mapped_span.empty() ? std::span<u8>{}
+                                                  : arena->mapped_span.subspan(*offset, size),
+        .usage = usage,
+        .log2_level{},
+        .index{},
+    };
+}
+
+void StagingBufferPool::ReleaseArenaAllocations() {
+    // Ticks are monotonic, so allocations are released in the order they were made
+    while (!arena_releases.empty() && scheduler.IsFree(arena_releases.front().tick)) {
+        const ArenaRelease& release = arena_releases.front();
+        release.arena->Free(release.offset, release.size);
+        arena_releases.pop_front();
+    }
+}
+
+void StagingBufferPool::ReleaseArenas(MemoryUsage usage) {
+    // Keep the first arena alive, later ones are only needed during bursts of transfers
+    auto& arenas = GetArenas(usage);
+    if (arenas.size() <= 1) {
+        return;
+    }
+    const auto is_unused = [](const std::unique_ptr<StagingArena>& arena) {
+        return arena->free_bytes == arena->size;
+    };
+    arenas.erase(std::remove_if(arenas.begin() + 1, arenas.end(), is_unused), arenas.end());
+}
+
+std::optional<VkDeviceSize> StagingBufferPool::StagingArena::Allocate(VkDeviceSize alloc_size,
+                                                                     VkDeviceSize alignment) {
+    for (auto it = free_ranges.begin(); it != free_ranges.end(); ++it) {
+        const auto [range_begin, range_size] = *it;
+        const VkDeviceSize range_end = range_begin + range_size;
+        const VkDeviceSize offset = Common::AlignUp(range_begin, alignment);
+        if (offset + alloc_size > range_end) {
+            continue;
+        }
+        free_ranges.erase(it);
+        if (offset > range_begin) {
+            free_ranges.emplace(range_begin, offset - range_begin);
+        }
+        if (offset + alloc_size < range_end) {
+            free_ranges.emplace(offset + alloc_size, range_end - offset - alloc_size);
+        }
+        free_bytes -= alloc_size;
+        return offset;
+    }
+    return std::nullopt;
+}
+
+void StagingBufferPool::StagingArena::Free(VkDeviceSize offset, VkDeviceSize alloc_size) {
+    VkDeviceSize range_begin = offset;
+    VkDeviceSize range_end = offset + alloc_size;
+    const auto next = free_ranges.lower_bound(offset);
+    if (next != free_ranges.end() && next->first == range_end) {
+        range_end += next->second;
+        free_ranges.erase(next);
+    }
+    const auto after = free_ranges.lower_bound(offset);
+    if (after != free_ranges.begin()) {
+        const auto prev = std::prev(after);
+        if (prev->first + prev->second == range_begin) {
+            range_begin = prev->first;
+            free_ranges.erase(prev);
+        }
+    }
+    free_ranges.emplace(range_begin, range_end - range_begin);
+    free_bytes += alloc_size;
+}
+
 StagingBufferPool::StagingBuffersCache& StagingBufferPool::GetCache(MemoryUsage usage) {
     switch (usage) {
     case MemoryUsage::DeviceLocal:
@@ -226,6 +373,21 @@ StagingBufferPool::StagingBuffersCache& StagingBufferPool::GetCache(MemoryUsage
     }
 }
 
+std::vector<std::unique_ptr<StagingBufferPool::StagingArena>>& StagingBufferPool::GetArenas(
+    MemoryUsage usage) {
+    switch (usage) {
+    case MemoryUsage::DeviceLocal:
+        return device_local_arenas;
+    case MemoryUsage::Upload:
+        return upload_arenas;
+    case MemoryUsage::Download:
+        return download_arenas;
+    default:
+        ASSERT_MSG(false, "Invalid memory usage={}", usage);
+        return upload_arenas;
+    }
+}
+
 void StagingBufferPool::ReleaseCache(MemoryUsage usage) {
     ReleaseLevel(GetCache(usage), current_delete_level);
 }
@@ -4,6 +4,10 @@
 #pragma once
 
 #include <climits>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "common/common_types.h"
@@ -34,6 +38,10 @@ public:
     ~StagingBufferPool();
 
     StagingBufferRef Request(size_t size, MemoryUsage usage, bool deferred = false);
+
+    /// Sub-allocates a short lived upload from the stream buffer with a custom offset alignment.
+    /// Small uniform and inline uploads use this to avoid padding every allocation to 256 bytes.
+    StagingBufferRef RequestStream(size_t size, VkDeviceSize alignment);
     void FreeDeferred(StagingBufferRef& ref);
 
     [[nodiscard]] VkBuffer StreamBuf() const noexcept {
@@ -69,6 +77,26 @@ private:
         }
     };
 
+    /// Large host visible buffer sub-allocated with a first fit free list of offset ranges.
+    struct StagingArena {
+        vk::Buffer buffer;
+        std::span<u8> mapped_span;
+        VkDeviceSize size;
+        VkDeviceSize free_bytes;
+        std::map<VkDeviceSize, VkDeviceSize> free_ranges;
+
+        std::optional<VkDeviceSize> Allocate(VkDeviceSize alloc_size, VkDeviceSize alignment);
+
+        void Free(VkDeviceSize offset, VkDeviceSize alloc_size);
+    };
+
+    struct ArenaRelease {
+        StagingArena* arena;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        u64 tick;
+    };
+
     struct StagingBuffers {
         std::vector<StagingBuffer> entries;
         size_t delete_index = 0;
@@ -78,7 +106,7 @@ private:
     static constexpr size_t NUM_LEVELS = sizeof(size_t) * CHAR_BIT;
     using StagingBuffersCache = std::array<StagingBuffers, NUM_LEVELS>;
 
-    StagingBufferRef GetStreamBuffer(size_t size);
+    StagingBufferRef GetStreamBuffer(size_t size, VkDeviceSize alignment);
 
     bool AreRegionsActive(size_t region_begin, size_t region_end) const;
 
@@ -89,8 +117,18 @@ private:
 
     StagingBufferRef CreateStagingBuffer(size_t size, MemoryUsage usage, bool deferred);
 
+    vk::Buffer CreateBuffer(VkDeviceSize size, MemoryUsage usage);
+
+    StagingBufferRef GetArenaBuffer(size_t size, MemoryUsage usage);
+
+    void ReleaseArenaAllocations();
+
+    void ReleaseArenas(MemoryUsage usage);
+
     StagingBuffersCache& GetCache(MemoryUsage usage);
 
+    std::vector<std::unique_ptr<StagingArena>>& GetArenas(MemoryUsage usage);
+
     void ReleaseCache(MemoryUsage usage);
 
     void ReleaseLevel(StagingBuffersCache& cache, size_t log2);
@@ -116,6 +154,12 @@ private:
     StagingBuffersCache upload_cache;
     StagingBuffersCache download_cache;
 
+    bool use_arenas;
+    std::vector<std::unique_ptr<StagingArena>> device_local_arenas;
+    std::vector<std::unique_ptr<StagingArena>> upload_arenas;
+    std::vector<std::unique_ptr<StagingArena>> download_arenas;
+    std::deque<ArenaRelease> arena_releases;
+
     size_t current_delete_level = 0;
     u64 buffer_index = 0;
     u64 unique_ids{};
@@ -53,6 +53,11 @@ Flags MakeInvalidationFlags() {
         DepthBiasEnable,
         LogicOpEnable,
         DepthClampEnable,
+        PolygonMode,
+        AlphaControl,
+        ConservativeRasterization,
+        LineRasterizationMode,
+        ProvokingVertexMode,
         LogicOp,
         Blending,
         ColorMask,
@@ -183,6 +188,14 @@ void SetupDirtyBlending(Tables& tables) {
     FillBlock(tables[1], OFF(blend_per_target), NUM(blend_per_target), BlendEquations);
 }
 
+void SetupDirtyRasterizationModes(Tables& tables) {
+    tables[0][OFF(polygon_mode_front)] = PolygonMode;
+    tables[0][OFF(anti_alias_alpha_control)] = AlphaControl;
+    tables[0][OFF(conservative_raster_enable)] = ConservativeRasterization;
+    tables[0][OFF(line_anti_alias_enable)] = LineRasterizationMode;
+    tables[0][OFF(provoking_vertex)] = ProvokingVertexMode;
+}
+
 void SetupDirtySpecialOps(Tables& tables) {
     tables[0][OFF(logic_op.op)] = LogicOp;
 }
@@ -232,6 +245,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyFrontFace(tables);
     SetupDirtyStencilOp(tables);
     SetupDirtyBlending(tables);
+    SetupDirtyRasterizationModes(tables);
     SetupDirtyViewportSwizzles(tables);
     SetupDirtyVertexAttributes(tables);
     SetupDirtyVertexBindings(tables);
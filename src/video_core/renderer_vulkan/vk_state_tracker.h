@@ -55,6 +55,11 @@ enum : u8 {
     LogicOp,
     LogicOpEnable,
     DepthClampEnable,
+    PolygonMode,
+    AlphaControl,
+    ConservativeRasterization,
+    LineRasterizationMode,
+    ProvokingVertexMode,
 
     Blending,
     BlendEnable,
@@ -212,6 +217,26 @@ public:
         return Exchange(Dirty::DepthClampEnable, false);
     }
 
+    bool TouchPolygonMode() {
+        return Exchange(Dirty::PolygonMode, false);
+    }
+
+    bool TouchAlphaControl() {
+        return Exchange(Dirty::AlphaControl, false);
+    }
+
+    bool TouchConservativeRasterization() {
+        return Exchange(Dirty::ConservativeRasterization, false);
+    }
+
+    bool TouchLineRasterizationMode() {
+        return Exchange(Dirty::LineRasterizationMode, false);
+    }
+
+    bool TouchProvokingVertexMode() {
+        return Exchange(Dirty::ProvokingVertexMode, false);
+    }
+
     bool TouchDepthCompareOp() {
         return Exchange(Dirty::DepthCompareOp, false);
     }
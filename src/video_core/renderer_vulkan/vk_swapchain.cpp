@@ -128,6 +128,9 @@ void Swapchain::Create(VkSurfaceKHR surface_, u32 width_, u32 height_) {
 
     Destroy();
 
+    // Present identifiers only have to increase within a swapchain, keep counting to tell
+    // presents to the new swapchain apart from older ones
+    first_present_id = present_id + 1;
     CreateSwapchain(capabilities);
     CreateSemaphores();
 
@@ -164,9 +167,19 @@ bool Swapchain::AcquireNextImage() {
 
 void Swapchain::Present(VkSemaphore render_semaphore) {
     const auto present_queue{device.GetPresentQueue()};
+    const bool identify_present{device.IsKhrPresentWaitSupported()};
+    if (identify_present) {
+        ++present_id;
+    }
+    const VkPresentIdKHR present_id_info{
+        .sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+        .pNext = nullptr,
+        .swapchainCount = 1,
+        .pPresentIds = &present_id,
+    };
     const VkPresentInfoKHR present_info{
         .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-        .pNext = nullptr,
+        .pNext = identify_present ? &present_id_info : nullptr,
         .waitSemaphoreCount = render_semaphore ? 1U : 0U,
         .pWaitSemaphores = &render_semaphore,
         .swapchainCount = 1,
@@ -197,6 +210,26 @@ void Swapchain::Present(VkSemaphore render_semaphore) {
     }
 }
 
+bool Swapchain::WaitForPresent(u64 id, u64 timeout) {
+    if (!swapchain || id < first_present_id || id > present_id) {
+        return false;
+    }
+    const VkResult result = device.GetLogical().WaitForPresentKHR(*swapchain, id, timeout);
+    switch (result) {
+    case VK_SUCCESS:
+        return true;
+    case VK_TIMEOUT:
+        return false;
+    case VK_ERROR_OUT_OF_DATE_KHR:
+    case VK_ERROR_SURFACE_LOST_KHR:
+        // Left to the next acquire to handle
+        return false;
+    default:
+        LOG_ERROR(Render_Vulkan, "vkWaitForPresentKHR returned {}", string_VkResult(result));
+        return false;
+    }
+}
+
 void Swapchain::CreateSwapchain(const VkSurfaceCapabilitiesKHR& capabilities) {
     const auto physical_device{device.GetPhysical()};
     const auto formats{physical_device.GetSurfaceFormatsKHR(surface)};
@@ -32,6 +32,10 @@ public:
     /// Presents the rendered image to the swapchain.
     void Present(VkSemaphore render_semaphore);
 
+    /// Waits until a present is displayed or the timeout expires, returns true when displayed.
+    /// Presents made to previous swapchains are never waited on.
+    bool WaitForPresent(u64 id, u64 timeout);
+
     /// Returns true when the swapchain needs to be recreated.
     bool NeedsRecreation() const {
         return IsSubOptimal() || NeedsPresentModeUpdate();
@@ -99,6 +103,11 @@ public:
         return extent;
     }
 
+    /// Returns the identifier of the last present, zero when presents are not identified.
+    u64 GetPresentId() const {
+        return present_id;
+    }
+
 private:
     void CreateSwapchain(const VkSurfaceCapabilitiesKHR& capabilities);
     void CreateSemaphores();
@@ -126,6 +135,9 @@ private:
     u32 image_index{};
     u32 frame_index{};
 
+    u64 present_id{};
+    u64 first_present_id{};
+
     VkFormat image_view_format{};
     VkExtent2D extent{};
     VkPresentModeKHR present_mode{};
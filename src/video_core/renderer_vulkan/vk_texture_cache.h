@@ -9,6 +9,7 @@
 
 #include "shader_recompiler/shader_info.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
+#include "video_core/renderer_vulkan/vk_render_pass_cache.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
@@ -49,6 +50,12 @@ public:
 
     void Finish();
 
+    /// Returns the tick of the commands being recorded
+    u64 CurrentTick() const noexcept;
+
+    /// Waits for the commands recorded up to the given tick to finish
+    void Wait(u64 tick);
+
     StagingBufferRef UploadStagingBuffer(size_t size);
 
     StagingBufferRef DownloadStagingBuffer(size_t size, bool deferred = false);
@@ -61,6 +68,8 @@ public:
 
     u64 GetDeviceMemoryUsage() const;
 
+    u64 GetDeviceMemoryBudget() const;
+
     bool CanReportMemoryUsage() const;
 
     void BlitImage(Framebuffer* dst_framebuffer, ImageView& dst, ImageView& src,
@@ -92,6 +101,13 @@ public:
 
     void InsertUploadMemoryBarrier() {}
 
+    /// Queues an upload to be recorded with the other queued uploads of the same staging buffer
+    void QueueImageUpload(Image& image, const StagingBufferRef& map,
+                          std::span<const VideoCommon::BufferImageCopy> copies);
+
+    /// Records the queued uploads as grouped copies with one barrier batch
+    void FlushImageUploads();
+
     void TransitionImageLayout(Image& image);
 
     bool HasBrokenTextureViewFormats() const noexcept {
@@ -119,12 +135,22 @@ public:
     BlitImageHelper& blit_image_helper;
     RenderPassCache& render_pass_cache;
     std::optional<ASTCDecoderPass> astc_decoder_pass;
+    std::optional<BCnDecoderPass> bcn_decoder_pass;
     std::unique_ptr<MSAACopyPass> msaa_copy_pass;
     const Settings::ResolutionScalingInfo& resolution;
     std::array<std::vector<VkFormat>, VideoCore::Surface::MaxPixelFormat> view_formats;
 
     static constexpr size_t indexing_slots = 8 * sizeof(size_t);
     std::array<vk::Buffer, indexing_slots> buffers{};
+
+    struct QueuedUpload {
+        VkImage image;
+        VkImageAspectFlags aspect_mask;
+        bool is_initialized;
+        boost::container::small_vector<VkBufferImageCopy, 16> copies;
+    };
+    VkBuffer queued_upload_buffer{};
+    std::vector<QueuedUpload> queued_uploads;
 };
 
 class Image : public VideoCommon::ImageBase {
@@ -177,6 +203,9 @@ public:
 
     bool ScaleDown(bool ignore = false);
 
+    /// Destroys the scaled copy of an image that is not rescaled
+    void ReleaseScaledImage();
+
 private:
     bool BlitScaleHelper(bool scale_up);
 
@@ -325,6 +354,15 @@ public:
         return renderpass;
     }
 
+    /// Returns the attachment formats when dynamic rendering is used, null otherwise
+    [[nodiscard]] const RenderingFormats* Formats() const noexcept {
+        return rendering_formats;
+    }
+
+    [[nodiscard]] const RenderingAttachments& Attachments() const noexcept {
+        return rendering_attachments;
+    }
+
     [[nodiscard]] VkExtent2D RenderArea() const noexcept {
         return render_area;
     }
@@ -368,6 +406,8 @@ public:
 private:
     vk::Framebuffer framebuffer;
     VkRenderPass renderpass{};
+    const RenderingFormats* rendering_formats{};
+    RenderingAttachments rendering_attachments{};
     VkExtent2D render_area{};
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
     u32 num_color_buffers = 0;
@@ -1,11 +1,18 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <utility>
+
 #if defined(ANDROID) && defined(ARCHITECTURE_arm64)
 #include <adrenotools/driver.h>
 #endif
 
+#ifdef ANDROID
+#include "common/android/performance_hint.h"
+#endif
+
 #include "common/literals.h"
+#include "common/logging/log.h"
 #include "video_core/host_shaders/vulkan_turbo_mode_comp_spv.h"
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
@@ -16,7 +23,13 @@ namespace Vulkan {
 
 using namespace Common::Literals;
 
-TurboMode::TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& dld)
+namespace {
+// Number of frames between duty cycle reports
+constexpr u32 REPORT_FRAMES = 1800;
+} // Anonymous namespace
+
+TurboMode::TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                     bool adaptive)
 #ifndef ANDROID
     : m_device{CreateDevice(instance, dld, VK_NULL_HANDLE)}, m_allocator{m_device}
 #endif
@@ -24,6 +37,10 @@ TurboMode::TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& d
     {
         std::scoped_lock lk{m_submission_lock};
         m_submission_time = std::chrono::steady_clock::now();
+        if (adaptive) {
+            m_controller.emplace();
+            m_enabled = false;
+        }
     }
     m_thread = std::jthread([&](auto stop_token) { Run(stop_token); });
 }
@@ -36,6 +53,36 @@ void TurboMode::QueueSubmitted() {
     m_submission_cv.notify_one();
 }
 
+void TurboMode::FrameEnd(u64 gpu_nanoseconds, std::chrono::nanoseconds budget) {
+    if (!m_controller) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const auto frame_time = std::exchange(m_frame_time, now);
+    const bool was_enabled = m_controller->IsEnabled();
+    if (frame_time != std::chrono::time_point<std::chrono::steady_clock>{}) {
+        const auto frame_nanoseconds =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - frame_time).count();
+        m_controller->AddFrame(static_cast<u64>(frame_nanoseconds), gpu_nanoseconds,
+                               static_cast<u64>(budget.count()));
+    }
+    const bool enabled = m_controller->IsEnabled();
+    if (enabled != was_enabled) {
+        LOG_DEBUG(Render_Vulkan, "Turbo mode {}", enabled ? "enabled" : "disabled");
+        SetEnabled(enabled);
+    }
+    if (++m_frame_count % REPORT_FRAMES == 0) {
+        LOG_INFO(Render_Vulkan, "Turbo mode duty cycle over the last {} frames: {:.1f}%",
+                 REPORT_FRAMES, m_controller->TakeDutyCycle() * 100.0);
+    }
+}
+
+void TurboMode::SetEnabled(bool enabled) {
+    std::scoped_lock lk{m_submission_lock};
+    m_enabled = enabled;
+    m_submission_cv.notify_one();
+}
+
 void TurboMode::Run(std::stop_token stop_token) {
 #ifndef ANDROID
     auto& dld = m_device.GetLogical();
@@ -151,9 +198,23 @@ void TurboMode::Run(std::stop_token stop_token) {
 #endif
 
     while (!stop_token.stop_requested()) {
+        {
+            // Idle until the adaptive controller enables turbo
+            std::unique_lock lk{m_submission_lock};
+            if (!m_enabled) {
+#if defined(ANDROID) && defined(ARCHITECTURE_arm64)
+                adrenotools_set_turbo(false);
+#endif
+                Common::CondvarWait(m_submission_cv, lk, stop_token, [this] { return m_enabled; });
+                continue;
+            }
+        }
 #ifdef ANDROID
 #ifdef ARCHITECTURE_arm64
-        adrenotools_set_turbo(true);
+        // With hint sessions the governor raises clocks ahead of demand, so the GPU clock is only
+        // forced up while frames miss their budget
+        adrenotools_set_turbo(!Common::Android::IsPerformanceHintSupported() ||
+                              Common::Android::IsMissingFrameBudget());
 #endif
 #else
         // Reset the fence.
@@ -225,8 +286,8 @@ void TurboMode::Run(std::stop_token stop_token) {
         // Wait for the next graphics queue submission if necessary.
         std::unique_lock lk{m_submission_lock};
         Common::CondvarWait(m_submission_cv, lk, stop_token, [this] {
-            return (std::chrono::steady_clock::now() - m_submission_time) <=
-                   std::chrono::milliseconds{100};
+            return !m_enabled || (std::chrono::steady_clock::now() - m_submission_time) <=
+                                     std::chrono::milliseconds{100};
         });
     }
 #if defined(ANDROID) && defined(ARCHITECTURE_arm64)
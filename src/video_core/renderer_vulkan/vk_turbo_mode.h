@@ -5,24 +5,35 @@
 
 #include <chrono>
 #include <mutex>
+#include <optional>
 
 #include "common/polyfill_thread.h"
+#include "video_core/adaptive_turbo.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace Vulkan {
 
+/// Keeps the GPU clocks up with a dummy workload. When adaptive, it only runs while the GPU is
+/// measured to be downclocking, see VideoCommon::AdaptiveTurbo, otherwise it always runs.
 class TurboMode {
 public:
-    explicit TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& dld);
+    explicit TurboMode(const vk::Instance& instance, const vk::InstanceDispatch& dld,
+                       bool adaptive);
     ~TurboMode();
 
     void QueueSubmitted();
 
+    /// Adds a presented frame to the adaptive controller, gpu_nanoseconds is the measured GPU
+    /// time of the frame and budget is the frame time needed to run at full speed
+    void FrameEnd(u64 gpu_nanoseconds, std::chrono::nanoseconds budget);
+
 private:
     void Run(std::stop_token stop_token);
 
+    void SetEnabled(bool enabled);
+
 #ifndef ANDROID
     Device m_device;
     MemoryAllocator m_allocator;
@@ -30,6 +41,11 @@ private:
     std::mutex m_submission_lock;
     std::condition_variable_any m_submission_cv;
     std::chrono::time_point<std::chrono::steady_clock> m_submission_time{};
+    bool m_enabled = true;
+
+    std::optional<VideoCommon::AdaptiveTurbo> m_controller;
+    std::chrono::time_point<std::chrono::steady_clock> m_frame_time{};
+    u32 m_frame_count = 0;
 
     std::jthread m_thread;
 };
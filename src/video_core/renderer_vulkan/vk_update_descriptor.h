@@ -12,6 +12,14 @@ namespace Vulkan {
 class Device;
 class Scheduler;
 
+/// Texel buffer range written to descriptor buffers, which do not use buffer views
+struct DescriptorTexelBuffer {
+    VkBuffer buffer;
+    u32 offset;
+    u32 size;
+    VkFormat format;
+};
+
 struct DescriptorUpdateEntry {
     struct Empty {};
 
@@ -19,12 +27,15 @@ struct DescriptorUpdateEntry {
     DescriptorUpdateEntry(VkDescriptorImageInfo image_) : image{image_} {}
     DescriptorUpdateEntry(VkDescriptorBufferInfo buffer_) : buffer{buffer_} {}
     DescriptorUpdateEntry(VkBufferView texel_buffer_) : texel_buffer{texel_buffer_} {}
+    DescriptorUpdateEntry(DescriptorTexelBuffer texel_buffer_range_)
+        : texel_buffer_range{texel_buffer_range_} {}
 
     union {
         Empty empty{};
         VkDescriptorImageInfo image;
         VkDescriptorBufferInfo buffer;
         VkBufferView texel_buffer;
+        DescriptorTexelBuffer texel_buffer_range;
     };
 };
 
@@ -75,6 +86,10 @@ public:
         *(payload_cursor++) = texel_buffer;
     }
 
+    void AddTexelBuffer(const DescriptorTexelBuffer& texel_buffer_range) {
+        *(payload_cursor++) = texel_buffer_range;
+    }
+
 private:
     const Device& device;
     Scheduler& scheduler;
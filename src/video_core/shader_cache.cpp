@@ -3,9 +3,12 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <vector>
 
+#include "common/alignment.h"
 #include "common/assert.h"
+#include "common/cityhash.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/object_pool.h"
 #include "video_core/control/channel_state.h"
@@ -18,6 +21,27 @@
 #include "video_core/shader_environment.h"
 
 namespace VideoCommon {
+namespace {
+constexpr size_t INST_SIZE = sizeof(u64);
+constexpr size_t MAXIMUM_PROGRAM_SIZE = 0x100000;
+
+constexpr u64 SELF_BRANCH_A = 0xE2400FFFFF87000FULL;
+constexpr u64 SELF_BRANCH_B = 0xE2400FFFFF07000FULL;
+
+template <size_t N>
+std::optional<size_t> FindEndMarker(const std::array<u64, N>& end_markers, size_t first) {
+    for (size_t word = first / 64; word < N; ++word) {
+        u64 bits{end_markers[word]};
+        if (word == first / 64) {
+            bits &= ~0ULL << (first % 64);
+        }
+        if (bits != 0) {
+            return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+        }
+    }
+    return std::nullopt;
+}
+} // Anonymous namespace
 
 void ShaderCache::InvalidateRegion(VAddr addr, size_t size) {
     std::scoped_lock lock{invalidation_mutex};
@@ -138,9 +162,15 @@ void ShaderCache::Register(std::unique_ptr<ShaderInfo> data, VAddr addr, size_t
 }
 
 void ShaderCache::InvalidatePagesInRegion(VAddr addr, size_t size) {
+    ++invalidation_tick;
+
     const VAddr addr_end = addr + size;
     const u64 page_end = (addr_end + YUZU_PAGESIZE - 1) >> YUZU_PAGEBITS;
     for (u64 page = addr >> YUZU_PAGEBITS; page < page_end; ++page) {
+        if (const auto info_it = page_infos.find(page); info_it != page_infos.end()) {
+            page_infos.erase(info_it);
+            device_memory.UpdatePagesCachedCount(page << YUZU_PAGEBITS, YUZU_PAGESIZE, -1);
+        }
         auto it = invalidation_cache.find(page);
         if (it == invalidation_cache.end()) {
             continue;
@@ -231,7 +261,10 @@ ShaderCache::Entry* ShaderCache::NewEntry(VAddr addr, VAddr addr_end, ShaderInfo
 
 const ShaderInfo* ShaderCache::MakeShaderInfo(GenericEnvironment& env, VAddr cpu_addr) {
     auto info = std::make_unique<ShaderInfo>();
-    if (const std::optional<u64> cached_hash{env.Analyze()}) {
+    if (const std::optional<ProgramHash> program{HashProgram(cpu_addr)}) {
+        info->unique_hash = program->hash;
+        info->size_bytes = program->size_bytes;
+    } else if (const std::optional<u64> cached_hash{env.Analyze()}) {
         info->unique_hash = *cached_hash;
         info->size_bytes = env.CachedSizeBytes();
     } else {
@@ -248,4 +281,95 @@ const ShaderInfo* ShaderCache::MakeShaderInfo(GenericEnvironment& env, VAddr cpu
     return result;
 }
 
+std::optional<ShaderCache::ProgramHash> ShaderCache::HashProgram(VAddr addr) {
+    if (addr % INST_SIZE != 0) {
+        return std::nullopt;
+    }
+    // Find the end of the program, keeping the hashes of the pages it spans
+    const VAddr first_page_addr{Common::AlignDown(addr, YUZU_PAGESIZE)};
+    boost::container::small_vector<u64, 16> page_hashes;
+    std::optional<VAddr> end_addr;
+    for (VAddr page_addr = first_page_addr; page_addr < addr + MAXIMUM_PROGRAM_SIZE;
+         page_addr += YUZU_PAGESIZE) {
+        const std::optional<PageInfo> page_info{GetPageInfo(page_addr >> YUZU_PAGEBITS)};
+        if (!page_info) {
+            return std::nullopt;
+        }
+        page_hashes.push_back(page_info->hash);
+
+        const size_t first{page_addr < addr ? (addr - page_addr) / INST_SIZE : 0};
+        if (const std::optional<size_t> marker{FindEndMarker(page_info->end_markers, first)}) {
+            end_addr = page_addr + *marker * INST_SIZE;
+            break;
+        }
+    }
+    if (!end_addr || *end_addr - addr >= MAXIMUM_PROGRAM_SIZE) {
+        return std::nullopt;
+    }
+    // Combine the cached hashes of whole pages with the hashes of the partially used ones
+    const size_t size{static_cast<size_t>(*end_addr - addr)};
+    u64 hash{size};
+    std::vector<u8> partial_page;
+    for (size_t index = 0; index < page_hashes.size(); ++index) {
+        const VAddr page_addr{first_page_addr + index * YUZU_PAGESIZE};
+        const VAddr begin{std::max(page_addr, addr)};
+        const VAddr end{std::min(page_addr + YUZU_PAGESIZE, *end_addr)};
+        if (begin >= end) {
+            break;
+        }
+        u64 piece_hash{page_hashes[index]};
+        if (end - begin != YUZU_PAGESIZE) {
+            partial_page.resize(end - begin);
+            device_memory.ReadBlock(begin, partial_page.data(), partial_page.size());
+            piece_hash = Common::CityHash64(reinterpret_cast<const char*>(partial_page.data()),
+                                            partial_page.size());
+        }
+        hash = Common::Hash128to64({hash, piece_hash});
+    }
+    return ProgramHash{
+        .hash = hash,
+        .size_bytes = size + INST_SIZE,
+    };
+}
+
+std::optional<ShaderCache::PageInfo> ShaderCache::GetPageInfo(u64 page) {
+    const VAddr page_addr{page << YUZU_PAGEBITS};
+    u64 tick{};
+    {
+        std::scoped_lock lock{invalidation_mutex};
+        if (const auto it = page_infos.find(page); it != page_infos.end()) {
+            return it->second;
+        }
+        // Track writes before reading so the page is never cached with stale contents
+        device_memory.UpdatePagesCachedCount(page_addr, YUZU_PAGESIZE, 1);
+        tick = invalidation_tick;
+    }
+    std::optional<PageInfo> page_info;
+    bool is_mapped{true};
+    for (size_t offset = 0; offset < YUZU_PAGESIZE; offset += Core::DEVICE_PAGESIZE) {
+        is_mapped &= device_memory.GetPointer<u8>(page_addr + offset) != nullptr;
+    }
+    if (is_mapped) {
+        std::array<u64, YUZU_PAGESIZE / INST_SIZE> code;
+        device_memory.ReadBlock(page_addr, code.data(), YUZU_PAGESIZE);
+
+        page_info.emplace();
+        page_info->hash = Common::CityHash64(reinterpret_cast<const char*>(code.data()),
+                                             YUZU_PAGESIZE);
+        page_info->end_markers.fill(0);
+        for (size_t index = 0; index < code.size(); ++index) {
+            if (code[index] == SELF_BRANCH_A || code[index] == SELF_BRANCH_B) {
+                page_info->end_markers[index / 64] |= 1ULL << (index % 64);
+            }
+        }
+    }
+    std::scoped_lock lock{invalidation_mutex};
+    // Don't cache the page when it might have been written while it was read
+    if (page_info && tick == invalidation_tick && page_infos.try_emplace(page, *page_info).second) {
+        return page_info;
+    }
+    device_memory.UpdatePagesCachedCount(page_addr, YUZU_PAGESIZE, -1);
+    return page_info;
+}
+
 } // namespace VideoCommon
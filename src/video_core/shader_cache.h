@@ -6,6 +6,7 @@
 #include <array>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <unordered_map>
 #include <utility>
@@ -53,6 +54,18 @@ class ShaderCache : public VideoCommon::ChannelSetupCaches<VideoCommon::ChannelI
         }
     };
 
+    struct PageInfo {
+        /// Hash of the contents of the whole page
+        u64 hash;
+        /// Bit set for every instruction in the page that can mark the end of a program
+        std::array<u64, YUZU_PAGESIZE / sizeof(u64) / 64> end_markers;
+    };
+
+    struct ProgramHash {
+        u64 hash;
+        size_t size_bytes;
+    };
+
 public:
     /// @brief Removes shaders inside a given region
     /// @note Checks for ranges
@@ -146,6 +159,17 @@ private:
     /// @brief Create a new shader entry and register it
     const ShaderInfo* MakeShaderInfo(GenericEnvironment& env, VAddr cpu_addr);
 
+    /// @brief Finds the size of the program starting in a given address and hashes it
+    /// @note Pages that have not been written since they were last hashed are not read again
+    /// @param addr Start address of the program
+    /// @return Hash and size of the program, std::nullopt when it has to be analyzed instead
+    std::optional<ProgramHash> HashProgram(VAddr addr);
+
+    /// @brief Returns the information of a page, reading and tracking it when it's not cached
+    /// @param page Page to query
+    /// @return Information of the page, std::nullopt when the page is not fully mapped
+    std::optional<PageInfo> GetPageInfo(u64 page);
+
     Tegra::MaxwellDeviceMemoryManager& device_memory;
 
     mutable std::mutex lookup_mutex;
@@ -155,6 +179,9 @@ private:
     std::unordered_map<u64, std::vector<Entry*>> invalidation_cache;
     std::vector<std::unique_ptr<ShaderInfo>> storage;
     std::vector<Entry*> marked_for_removal;
+
+    std::unordered_map<u64, PageInfo> page_infos;
+    u64 invalidation_tick{};
 };
 
 } // namespace VideoCommon
@@ -2,10 +2,16 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 
 #include "common/assert.h"
@@ -13,9 +19,11 @@
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/zstd_compression.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
@@ -25,12 +33,14 @@
 
 namespace VideoCommon {
 
-constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'p', 'c', 'i', 'x'};
 
 constexpr size_t INST_SIZE = sizeof(u64);
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
+static std::mutex texture_info_mutex;
+
 static u64 MakeCbufKey(u32 index, u32 offset) {
     return (static_cast<u64>(index) << 32) | offset;
 }
@@ -67,6 +77,59 @@ static Shader::TexturePixelFormat ConvertTexturePixelFormat(const Tegra::Texture
                                    entry.a_type, entry.srgb_conversion));
 }
 
+template <typename Map>
+static void AppendSortedEntries(std::vector<u64>& data, const Map& map) {
+    std::vector<std::pair<u64, u64>> entries;
+    entries.reserve(map.size());
+    for (const auto& [key, value] : map) {
+        entries.emplace_back(static_cast<u64>(key), static_cast<u64>(value));
+    }
+    std::ranges::sort(entries);
+    data.push_back(static_cast<u64>(entries.size()));
+    for (const auto& [key, value] : entries) {
+        data.push_back(key);
+        data.push_back(value);
+    }
+}
+
+template <typename T>
+static void AppendRaw(std::vector<u64>& data, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const size_t offset{data.size()};
+    data.resize(offset + Common::DivCeil(sizeof(T), sizeof(u64)));
+    std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+/// Hashes the program code together with every query answered by the environment.
+/// Maps are sorted so the result does not depend on the order queries were performed in.
+static u64 HashTranslationInputs(std::span<const u64> code, const auto& texture_types,
+                                 const auto& texture_pixel_formats, const auto& cbuf_values,
+                                 const auto& cbuf_replacements, const Shader::ProgramHeader& sph,
+                                 const std::array<u32, 8>& gp_passthrough_mask,
+                                 const std::array<u32, 3>& workgroup_size, Shader::Stage stage,
+                                 u32 local_memory_size, u32 shared_memory_size, u32 texture_bound,
+                                 u32 viewport_transform_state) {
+    std::vector<u64> data(code.begin(), code.end());
+    data.push_back(static_cast<u64>(code.size()));
+    AppendSortedEntries(data, texture_types);
+    AppendSortedEntries(data, texture_pixel_formats);
+    AppendSortedEntries(data, cbuf_values);
+    AppendSortedEntries(data, cbuf_replacements);
+    if (stage == Shader::Stage::Compute) {
+        AppendRaw(data, workgroup_size);
+    } else {
+        AppendRaw(data, sph);
+        if (stage == Shader::Stage::Geometry) {
+            AppendRaw(data, gp_passthrough_mask);
+        }
+    }
+    data.push_back(static_cast<u64>(stage));
+    data.push_back((static_cast<u64>(local_memory_size) << 32) | shared_memory_size);
+    data.push_back((static_cast<u64>(texture_bound) << 32) | viewport_transform_state);
+    return Common::CityHash64(reinterpret_cast<const char*>(data.data()),
+                              data.size() * sizeof(u64));
+}
+
 static std::string_view StageToPrefix(Shader::Stage stage) {
     switch (stage) {
     case Shader::Stage::VertexB:
@@ -193,7 +256,19 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+std::optional<u64> GenericEnvironment::TranslationHash() const {
+    if (has_unbound_instructions || code.size() < CachedSizeWords()) {
+        return std::nullopt;
+    }
+    // Only the cached range is serialized, hash the same range FileEnvironment sees
+    const std::span<const u64> cached_code(code.data(), CachedSizeWords());
+    return HashTranslationInputs(cached_code, texture_types, texture_pixel_formats, cbuf_values,
+                                 cbuf_replacements, sph, gp_passthrough_mask, workgroup_size,
+                                 stage, local_memory_size, shared_memory_size, texture_bound,
+                                 viewport_transform_state);
+}
+
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -277,7 +352,11 @@ Tegra::Texture::TICEntry GenericEnvironment::ReadTextureInfo(GPUVAddr tic_addr,
     ASSERT(handle.first <= tic_limit);
     const GPUVAddr descriptor_addr{tic_addr + handle.first * sizeof(Tegra::Texture::TICEntry)};
     Tegra::Texture::TICEntry entry;
-    gpu_memory->ReadBlock(descriptor_addr, &entry, sizeof(entry));
+    {
+        // Stages of a pipeline can be translated in parallel, flushing caches is not thread safe
+        std::scoped_lock lock{texture_info_mutex};
+        gpu_memory->ReadBlock(descriptor_addr, &entry, sizeof(entry));
+    }
     return entry;
 }
 
@@ -448,7 +527,7 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+void FileEnvironment::Deserialize(std::istream& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
@@ -516,6 +595,13 @@ void FileEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
+std::optional<u64> FileEnvironment::TranslationHash() const {
+    return HashTranslationInputs(code, texture_types, texture_pixel_formats, cbuf_values,
+                                 cbuf_replacements, sph, gp_passthrough_mask, workgroup_size,
+                                 stage, local_memory_size, shared_memory_size, texture_bound,
+                                 viewport_transform_state);
+}
+
 u64 FileEnvironment::ReadInstruction(u32 address) {
     if (address < read_lowest || address > read_highest) {
         throw Shader::LogicError("Out of bounds address {}", address);
@@ -582,6 +668,214 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
     return it->second;
 }
 
+namespace {
+// Pipeline cache files start with a header followed by the indexed entries and their index.
+// Entries appended after the index are prefixed by their size and are indexed on compaction.
+// Entries compressed with zstd have COMPRESSED_ENTRY set in their size.
+struct CacheHeader {
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    u32 num_indexed;
+    u64 index_offset;
+};
+static_assert(std::has_unique_object_representations_v<CacheHeader>);
+
+struct IndexEntry {
+    u64 hash;
+    u64 offset;
+    u64 size;
+};
+static_assert(std::has_unique_object_representations_v<IndexEntry>);
+
+// Files from before the index only have the magic number and version before their entries
+constexpr std::array<char, 8> LEGACY_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+constexpr size_t LEGACY_HEADER_SIZE = sizeof(LEGACY_MAGIC_NUMBER) + sizeof(u32);
+
+// Rewrite the file when this many pipelines were appended since it was last compacted
+constexpr size_t COMPACTION_THRESHOLD = 64;
+
+constexpr u64 COMPRESSED_ENTRY = 1ULL << 63;
+
+// Smaller entries are stored as they are, zstd frames cost too much on them to be worth it
+constexpr size_t MIN_COMPRESSED_ENTRY_SIZE = 256;
+
+// Number of entries decompressed in parallel before they are loaded
+constexpr size_t LOAD_BATCH_SIZE = 256;
+
+/// Returns the number of bytes an entry with the given size field takes in the file
+constexpr u64 StoredSize(u64 size) {
+    return size & ~COMPRESSED_ENTRY;
+}
+
+/// Compresses an entry into compressed when that makes it smaller, returns its size field.
+/// Entries that were not compressed are stored as they are.
+u64 CompressEntry(std::span<const u8> entry, std::vector<u8>& compressed) {
+    if (entry.size() < MIN_COMPRESSED_ENTRY_SIZE) {
+        return entry.size();
+    }
+    compressed = Common::Compression::CompressDataZSTDDefault(entry.data(), entry.size());
+    if (compressed.empty() || compressed.size() >= entry.size()) {
+        return entry.size();
+    }
+    return compressed.size() | COMPRESSED_ENTRY;
+}
+
+/// Returns the serialized pipeline of an entry, decompressing it into storage if needed
+std::span<const u8> EntryData(std::span<const u8> data, const IndexEntry& entry,
+                              std::vector<u8>& storage) {
+    const std::span<const u8> stored{data.subspan(entry.offset, StoredSize(entry.size))};
+    if ((entry.size & COMPRESSED_ENTRY) == 0) {
+        return stored;
+    }
+    storage = Common::Compression::DecompressDataZSTD(stored);
+    if (storage.empty()) {
+        throw std::ios_base::failure("Failed to decompress pipeline cache entry");
+    }
+    return storage;
+}
+
+/// Read-only stream buffer over a span of memory
+class MemoryStreamBuffer final : public std::streambuf {
+public:
+    explicit MemoryStreamBuffer(std::span<const u8> data) {
+        char* const begin{const_cast<char*>(reinterpret_cast<const char*>(data.data()))};
+        setg(begin, begin, begin + data.size());
+    }
+
+    [[nodiscard]] size_t Position() const noexcept {
+        return static_cast<size_t>(gptr() - eback());
+    }
+};
+
+template <typename T>
+T ReadObject(std::span<const u8> data, size_t offset) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) {
+        throw std::ios_base::failure("Pipeline cache entry out of bounds");
+    }
+    T object;
+    std::memcpy(&object, data.data() + offset, sizeof(T));
+    return object;
+}
+
+/// Deserializes the pipeline at the beginning of data, returns the number of bytes it used
+size_t LoadPipeline(
+    std::span<const u8> data,
+    Common::UniqueFunction<void, std::istream&, FileEnvironment>& load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>>& load_graphics) {
+    MemoryStreamBuffer buffer{data};
+    std::istream stream{&buffer};
+    stream.exceptions(std::ios::failbit);
+
+    u32 num_envs{};
+    stream.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+    std::vector<FileEnvironment> envs(num_envs);
+    for (FileEnvironment& env : envs) {
+        env.Deserialize(stream);
+    }
+    if (envs.front().ShaderStage() == Shader::Stage::Compute) {
+        load_compute(stream, std::move(envs.front()));
+    } else {
+        load_graphics(stream, std::move(envs));
+    }
+    return buffer.Position();
+}
+
+/// Loads the given entries in order, the compressed ones of each batch are decompressed in
+/// parallel. Returns false when loading was stopped.
+bool LoadEntries(
+    std::stop_token stop_loading, std::span<const u8> data, std::span<const IndexEntry> entries,
+    Common::UniqueFunction<void, std::istream&, FileEnvironment>& load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>>& load_graphics) {
+    const size_t num_workers{std::max(std::thread::hardware_concurrency(), 1U)};
+    std::vector<std::vector<u8>> storage(LOAD_BATCH_SIZE);
+    std::vector<std::span<const u8>> batch_data(LOAD_BATCH_SIZE);
+    for (size_t first = 0; first < entries.size(); first += LOAD_BATCH_SIZE) {
+        if (stop_loading.stop_requested()) {
+            return false;
+        }
+        const auto batch{entries.subspan(first, std::min(LOAD_BATCH_SIZE, entries.size() - first))};
+        const auto decompress{[&](size_t worker) {
+            for (size_t i = worker; i < batch.size(); i += num_workers) {
+                batch_data[i] = EntryData(data, batch[i], storage[i]);
+            }
+        }};
+        std::vector<std::future<void>> workers;
+        for (size_t worker = 1; worker < std::min(num_workers, batch.size()); ++worker) {
+            workers.push_back(std::async(std::launch::async, decompress, worker));
+        }
+        decompress(0);
+        for (std::future<void>& worker : workers) {
+            // Rethrows decompression failures
+            worker.get();
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            LoadPipeline(batch_data[i], load_compute, load_graphics);
+        }
+    }
+    return true;
+}
+
+/// Writes the given entries and their index to temp_filename, returns true on success.
+/// Entries that are not compressed yet are compressed when it makes them smaller.
+bool CompactPipelines(const std::filesystem::path& temp_filename, u32 cache_version,
+                      std::span<const u8> data, std::span<const IndexEntry> entries) try {
+    std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+    file.exceptions(std::ofstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open pipeline cache file {}",
+                  Common::FS::PathToUTF8String(temp_filename));
+        return false;
+    }
+    // The header is written again once the index offset is known
+    CacheHeader header{
+        .magic_number = MAGIC_NUMBER,
+        .cache_version = cache_version,
+        .num_indexed = 0,
+        .index_offset = sizeof(CacheHeader),
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<IndexEntry> index;
+    index.reserve(entries.size());
+    u64 offset{sizeof(CacheHeader)};
+    std::vector<u8> compressed;
+    for (const IndexEntry& entry : entries) {
+        std::span<const u8> stored{data.subspan(entry.offset, StoredSize(entry.size))};
+        u64 size{entry.size};
+        u64 hash{entry.hash};
+        if ((entry.size & COMPRESSED_ENTRY) == 0) {
+            size = CompressEntry(stored, compressed);
+            if (size & COMPRESSED_ENTRY) {
+                stored = compressed;
+                hash = Common::CityHash64(reinterpret_cast<const char*>(stored.data()),
+                                          stored.size());
+            }
+        }
+        file.write(reinterpret_cast<const char*>(stored.data()), stored.size());
+        index.push_back({
+            .hash = hash,
+            .offset = offset,
+            .size = size,
+        });
+        offset += stored.size();
+    }
+    header.num_indexed = static_cast<u32>(index.size());
+    header.index_offset = offset;
+    file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexEntry));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    LOG_INFO(Common_Filesystem, "Compacted pipeline cache with {} pipelines", index.size());
+    return true;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "Failed to compact pipeline cache: {}", e.what());
+    Common::FS::RemoveFile(temp_filename);
+    return false;
+}
+} // Anonymous namespace
+
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
                        const std::filesystem::path& filename, u32 cache_version) try {
     std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
@@ -593,18 +887,34 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
     }
     if (file.tellp() == 0) {
         // Write header
-        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
-            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+        const CacheHeader header{
+            .magic_number = MAGIC_NUMBER,
+            .cache_version = cache_version,
+            .num_indexed = 0,
+            .index_offset = sizeof(CacheHeader),
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
     }
     if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
         return;
     }
+    std::ostringstream entry;
+    entry.exceptions(std::ostringstream::failbit);
     const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
+    entry.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
     for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
+        env->Serialize(entry);
     }
-    file.write(key.data(), key.size_bytes());
+    entry.write(key.data(), key.size_bytes());
+
+    const std::string entry_data{std::move(entry).str()};
+    const std::span<const u8> serialized{reinterpret_cast<const u8*>(entry_data.data()),
+                                         entry_data.size()};
+    std::vector<u8> compressed;
+    const u64 entry_size{CompressEntry(serialized, compressed)};
+    const std::span<const u8> stored{(entry_size & COMPRESSED_ENTRY) ? compressed : serialized};
+    file.write(reinterpret_cast<const char*>(&entry_size), sizeof(entry_size))
+        .write(reinterpret_cast<const char*>(stored.data()), stored.size());
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
@@ -616,24 +926,92 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
 
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+    Common::UniqueFunction<void, std::istream&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>> load_graphics) try {
+    Common::FS::MappedFile file{filename};
+    if (!file.IsOpen()) {
         return;
     }
-    file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
-    file.seekg(0, std::ios::beg);
-
-    std::array<char, 8> magic_number;
-    u32 cache_version;
-    file.read(magic_number.data(), magic_number.size())
-        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-    if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
-        file.close();
+    const std::span<const u8> data{file.Data()};
+    std::vector<IndexEntry> entries;
+    std::unordered_set<u64> hashes;
+    const auto add_entry{[&](u64 offset, u64 size) {
+        const u64 hash{Common::CityHash64(reinterpret_cast<const char*>(data.data() + offset),
+                                          StoredSize(size))};
+        const bool is_new{hashes.insert(hash).second};
+        if (is_new) {
+            entries.push_back({
+                .hash = hash,
+                .offset = offset,
+                .size = size,
+            });
+        }
+        return is_new;
+    }};
+
+    bool needs_compaction{};
+    const auto magic_number{ReadObject<std::array<char, 8>>(data, 0)};
+    const auto cache_version{ReadObject<u32>(data, sizeof(magic_number))};
+    if (magic_number == LEGACY_MAGIC_NUMBER && cache_version == expected_cache_version) {
+        // Entries are not delimited, parse them in order and convert the file to the new format
+        size_t offset{LEGACY_HEADER_SIZE};
+        while (offset != data.size()) {
+            if (stop_loading.stop_requested()) {
+                return;
+            }
+            const size_t size{LoadPipeline(data.subspan(offset), load_compute, load_graphics)};
+            add_entry(offset, size);
+            offset += size;
+        }
+        needs_compaction = true;
+    } else if (magic_number == MAGIC_NUMBER && cache_version == expected_cache_version) {
+        const auto header{ReadObject<CacheHeader>(data, 0)};
+        const u64 index_size{static_cast<u64>(header.num_indexed) * sizeof(IndexEntry)};
+        if (header.index_offset > data.size() || data.size() - header.index_offset < index_size) {
+            throw std::ios_base::failure("Pipeline cache index out of bounds");
+        }
+        for (u32 index = 0; index < header.num_indexed; ++index) {
+            if (stop_loading.stop_requested()) {
+                return;
+            }
+            const auto entry{
+                ReadObject<IndexEntry>(data, header.index_offset + index * sizeof(IndexEntry))};
+            if (entry.offset > header.index_offset ||
+                header.index_offset - entry.offset < StoredSize(entry.size)) {
+                throw std::ios_base::failure("Pipeline cache entry out of bounds");
+            }
+            if (!hashes.insert(entry.hash).second) {
+                needs_compaction = true;
+                continue;
+            }
+            entries.push_back(entry);
+        }
+        size_t num_appended{};
+        size_t offset{header.index_offset + index_size};
+        while (offset != data.size()) {
+            if (stop_loading.stop_requested()) {
+                return;
+            }
+            const auto size{ReadObject<u64>(data, offset)};
+            offset += sizeof(size);
+            if (StoredSize(size) > data.size() - offset) {
+                throw std::ios_base::failure("Pipeline cache entry out of bounds");
+            }
+            if (add_entry(offset, size)) {
+                ++num_appended;
+            } else {
+                needs_compaction = true;
+            }
+            offset += StoredSize(size);
+        }
+        if (!LoadEntries(stop_loading, data, entries, load_compute, load_graphics)) {
+            return;
+        }
+        needs_compaction |= num_appended >= COMPACTION_THRESHOLD;
+    } else {
+        file.Close();
         if (Common::FS::RemoveFile(filename)) {
-            if (magic_number != MAGIC_NUMBER) {
+            if (magic_number != MAGIC_NUMBER && magic_number != LEGACY_MAGIC_NUMBER) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
             }
             if (cache_version != expected_cache_version) {
@@ -646,29 +1024,83 @@ void LoadPipelines(
         }
         return;
     }
-    while (file.tellg() != end) {
-        if (stop_loading.stop_requested()) {
-            return;
+    if (!needs_compaction) {
+        return;
+    }
+    auto temp_filename{filename};
+    temp_filename += ".tmp";
+    const bool compacted{CompactPipelines(temp_filename, expected_cache_version, data, entries)};
+    file.Close();
+    if (!compacted) {
+        return;
+    }
+    if (!Common::FS::RemoveFile(filename) || !Common::FS::RenameFile(temp_filename, filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to replace pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        Common::FS::RemoveFile(temp_filename);
+    }
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+size_t ReadPipelineEnvironments(
+    const std::filesystem::path& filename,
+    Common::UniqueFunction<void, std::vector<FileEnvironment>> func) try {
+    Common::FS::MappedFile file{filename};
+    if (!file.IsOpen()) {
+        return 0;
+    }
+    const std::span<const u8> data{file.Data()};
+    const auto header{ReadObject<CacheHeader>(data, 0)};
+    if (header.magic_number != MAGIC_NUMBER) {
+        return 0;
+    }
+    std::vector<u8> storage;
+    const auto read_entry{[&](u64 offset, u64 size) {
+        if (offset > data.size() || data.size() - offset < StoredSize(size)) {
+            throw std::ios_base::failure("Pipeline cache entry out of bounds");
         }
+        const IndexEntry entry{
+            .hash = 0,
+            .offset = offset,
+            .size = size,
+        };
+        MemoryStreamBuffer buffer{EntryData(data, entry, storage)};
+        std::istream stream{&buffer};
+        stream.exceptions(std::ios::failbit);
+
         u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+        stream.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
         std::vector<FileEnvironment> envs(num_envs);
         for (FileEnvironment& env : envs) {
-            env.Deserialize(file);
-        }
-        if (envs.front().ShaderStage() == Shader::Stage::Compute) {
-            load_compute(file, std::move(envs.front()));
-        } else {
-            load_graphics(file, std::move(envs));
+            env.Deserialize(stream);
         }
+        func(std::move(envs));
+    }};
+    for (u32 index = 0; index < header.num_indexed; ++index) {
+        const auto entry{
+            ReadObject<IndexEntry>(data, header.index_offset + index * sizeof(IndexEntry))};
+        read_entry(entry.offset, entry.size);
     }
+    size_t num_entries{header.num_indexed};
+    size_t offset{header.index_offset + header.num_indexed * sizeof(IndexEntry)};
+    while (offset < data.size()) {
+        const auto size{ReadObject<u64>(data, offset)};
+        offset += sizeof(size);
+        read_entry(offset, size);
+        offset += StoredSize(size);
+        ++num_entries;
+    }
+    return num_entries;
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-    }
+    return 0;
 }
 
 } // namespace VideoCommon
@@ -60,7 +60,9 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
-    void Serialize(std::ofstream& file) const;
+    [[nodiscard]] std::optional<u64> TranslationHash() const override;
+
+    void Serialize(std::ostream& file) const;
 
     bool HasHLEMacroState() const override {
         return has_hle_engine_state;
@@ -165,7 +167,7 @@ public:
     FileEnvironment& operator=(const FileEnvironment&) = delete;
     FileEnvironment(const FileEnvironment&) = delete;
 
-    void Deserialize(std::ifstream& file);
+    void Deserialize(std::istream& file);
 
     [[nodiscard]] u64 ReadInstruction(u32 address) override;
 
@@ -196,6 +198,8 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
+    [[nodiscard]] std::optional<u64> TranslationHash() const override;
+
 private:
     std::vector<u64> code;
     std::unordered_map<u32, Shader::TextureType> texture_types;
@@ -224,9 +228,17 @@ void SerializePipeline(const Key& key, const Envs& envs, const std::filesystem::
                       std::span(envs.data(), envs.size()), filename, cache_version);
 }
 
+/// Loads the pipelines in a cache file through a memory mapping.
+/// Pipelines are located through the file index, duplicates are skipped and the file is
+/// compacted when enough pipelines were appended after its index or it uses the old format.
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics);
+    Common::UniqueFunction<void, std::istream&, FileEnvironment> load_compute,
+    Common::UniqueFunction<void, std::istream&, std::vector<FileEnvironment>> load_graphics);
+
+/// Reads the environments of every pipeline in a cache file without loading the pipelines.
+/// Returns the number of pipelines read, caches in the old format are not supported.
+size_t ReadPipelineEnvironments(const std::filesystem::path& filename,
+                                Common::UniqueFunction<void, std::vector<FileEnvironment>> func);
 
 } // namespace VideoCommon
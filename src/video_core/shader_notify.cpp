@@ -1,9 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
 
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
 #include "video_core/shader_notify.h"
 
 using namespace std::chrono_literals;
@@ -12,6 +22,10 @@ namespace VideoCore {
 
 const auto TIME_TO_STOP_REPORTING = 2s;
 
+namespace {
+constexpr std::array<std::string_view, 3> STALL_NAMES{"blocked", "skipped", "fallback"};
+} // Anonymous namespace
+
 int ShaderNotify::ShadersBuilding() noexcept {
     const int now_complete = num_complete.load(std::memory_order::relaxed);
     const int now_building = num_building.load(std::memory_order::relaxed);
@@ -31,4 +45,65 @@ int ShaderNotify::ShadersBuilding() noexcept {
     return now_building - report_base;
 }
 
+void ShaderNotify::RecordPipelineMiss(const PipelineMiss& miss) {
+    std::scoped_lock lock{misses_mutex};
+    misses.push_back(miss);
+}
+
+std::vector<PipelineMiss> ShaderNotify::PipelineMisses() const {
+    std::scoped_lock lock{misses_mutex};
+    return misses;
+}
+
+void ShaderNotify::WriteStallReport(u64 title_id) const {
+    const std::vector<PipelineMiss> session_misses = PipelineMisses();
+    if (session_misses.empty()) {
+        return;
+    }
+    std::string csv = "frame,type,stall,translate_ms,build_ms,stage_hashes\n";
+    std::array<size_t, STALL_NAMES.size()> num_stalls{};
+    std::vector<float> compile_times;
+    compile_times.reserve(session_misses.size());
+    float stalled_ms = 0.0f;
+    for (const PipelineMiss& miss : session_misses) {
+        const float compile_ms = miss.translate_ms + miss.build_ms;
+        const auto stall = static_cast<size_t>(miss.stall);
+        ++num_stalls[stall];
+        compile_times.push_back(compile_ms);
+        // Translation always stalls emulation, the build only when the draw waits for it
+        stalled_ms += miss.stall == ShaderStall::Blocked ? compile_ms : miss.translate_ms;
+
+        const size_t num_stages = miss.is_compute ? 1 : miss.stage_hashes.size();
+        std::string hashes;
+        for (size_t stage = 0; stage < num_stages; ++stage) {
+            hashes += fmt::format("{}{:016x}", stage == 0 ? "" : ";", miss.stage_hashes[stage]);
+        }
+        csv += fmt::format("{},{},{},{:.3f},{:.3f},{}\n", miss.frame,
+                           miss.is_compute ? "compute" : "graphics", STALL_NAMES[stall],
+                           miss.translate_ms, miss.build_ms, hashes);
+    }
+    const auto p99 = compile_times.begin() + (compile_times.size() - 1) * 99 / 100;
+    std::nth_element(compile_times.begin(), p99, compile_times.end());
+    LOG_INFO(HW_GPU,
+             "Pipeline cache misses: {} ({} blocked, {} skipped, {} fallback), {:.1f} ms "
+             "stalled, 99th percentile compile time {:.3f} ms",
+             session_misses.size(), num_stalls[0], num_stalls[1], num_stalls[2], stalled_ms,
+             *p99);
+
+    const std::time_t t = std::time(nullptr);
+    // %F Date format expanded is "%Y-%m-%d"
+    const auto filename =
+        fmt::format("{:%F-%H-%M}_{:016X}_shader_stalls.csv", *std::localtime(&t), title_id);
+    const auto filepath = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) / filename;
+    if (!Common::FS::CreateParentDir(filepath)) {
+        return;
+    }
+    Common::FS::IOFile file(filepath, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::TextFile);
+    if (file.WriteString(csv) != csv.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write shader stall report \"{}\"",
+                  Common::FS::PathToUTF8String(filepath));
+    }
+}
+
 } // namespace VideoCore
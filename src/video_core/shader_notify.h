@@ -3,14 +3,42 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "common/common_types.h"
 
 namespace VideoCore {
+
+/// How the draw or dispatch that missed the pipeline cache went on
+enum class ShaderStall : u32 {
+    Blocked,  ///< It waited for the pipeline to build
+    Skipped,  ///< It was skipped while the pipeline builds asynchronously
+    Fallback, ///< It used a similar built pipeline while the pipeline builds asynchronously
+};
+
+/// Pipeline cache miss of the running session
+struct PipelineMiss {
+    u64 frame;                       ///< Frame of the pipeline cache the miss happened in
+    std::array<u64, 6> stage_hashes; ///< Unique hashes of the stages, only the first for compute
+    bool is_compute;
+    ShaderStall stall;
+    float translate_ms; ///< Time spent translating the shaders on the GPU thread
+    float build_ms;     ///< Time from the end of the translation until the pipeline was built
+};
+
 class ShaderNotify {
 public:
     [[nodiscard]] int ShadersBuilding() noexcept;
 
+    /// Returns the number of shaders built since the game started
+    [[nodiscard]] int ShadersBuilt() const noexcept {
+        return num_complete.load(std::memory_order::relaxed);
+    }
+
     void MarkShaderComplete() noexcept {
         ++num_complete;
     }
@@ -19,6 +47,14 @@ public:
         ++num_building;
     }
 
+    void RecordPipelineMiss(const PipelineMiss& miss);
+
+    /// Returns the pipeline cache misses recorded since the game started
+    [[nodiscard]] std::vector<PipelineMiss> PipelineMisses() const;
+
+    /// Writes the recorded misses to a CSV file in the log directory and logs a summary
+    void WriteStallReport(u64 title_id) const;
+
 private:
     std::atomic_int num_building{};
     std::atomic_int num_complete{};
@@ -27,5 +63,8 @@ private:
     bool completed{};
     int num_when_completed{};
     std::chrono::steady_clock::time_point complete_time;
+
+    mutable std::mutex misses_mutex;
+    std::vector<PipelineMiss> misses;
 };
 } // namespace VideoCore
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bitset>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "shader_recompiler/environment.h"
+#include "shader_recompiler/runtime_info.h"
+#include "video_core/spirv_module_cache.h"
+
+namespace VideoCommon {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 's', 'p', 'v', 'c'};
+
+// Stop growing the shared file past this size, it is loaded in full on every boot
+constexpr size_t MAX_FILE_SIZE = 512ULL * 1024 * 1024;
+
+static_assert(std::is_trivially_copyable_v<Shader::Backend::Bindings>);
+static_assert(std::has_unique_object_representations_v<Shader::Backend::Bindings>);
+
+class KeyBuilder {
+public:
+    template <typename T>
+    void Add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const size_t offset{data.size()};
+        data.resize(offset + sizeof(T));
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    template <size_t N>
+    void Add(const std::bitset<N>& bits) {
+        u64 word{};
+        for (size_t bit = 0; bit < N; ++bit) {
+            word |= static_cast<u64>(bits[bit]) << (bit % 64);
+            if (bit % 64 == 63 || bit == N - 1) {
+                Add(word);
+                word = 0;
+            }
+        }
+    }
+
+    template <typename T>
+    void Add(const std::optional<T>& value) {
+        Add(value.has_value());
+        Add(value.value_or(T{}));
+    }
+
+    [[nodiscard]] u64 Hash() const {
+        return Common::CityHash64(data.data(), data.size());
+    }
+
+private:
+    std::vector<char> data;
+};
+} // Anonymous namespace
+
+std::optional<u64> SpirvModuleCache::MakeKey(std::span<Shader::Environment* const> envs,
+                                             const Shader::RuntimeInfo& runtime_info,
+                                             const Shader::VaryingState& stores,
+                                             const Shader::Backend::Bindings& bindings) {
+    if (envs.empty()) {
+        return std::nullopt;
+    }
+    KeyBuilder builder;
+    for (const Shader::Environment* const env : envs) {
+        const std::optional<u64> env_hash{env->TranslationHash()};
+        if (!env_hash) {
+            return std::nullopt;
+        }
+        builder.Add(*env_hash);
+    }
+    // Global state read by the recompiler that is not part of the environment
+    const auto& resolution{Settings::values.resolution_info};
+    builder.Add(resolution.active);
+    builder.Add(resolution.up_scale);
+    builder.Add(resolution.down_shift);
+    builder.Add(Settings::values.disable_shader_loop_safety_checks.GetValue());
+    builder.Add(Settings::values.renderer_debug.GetValue());
+
+    builder.Add(bindings);
+    builder.Add(stores.mask);
+
+    builder.Add(runtime_info.generic_input_types);
+    builder.Add(runtime_info.previous_stage_stores.mask);
+    builder.Add(runtime_info.previous_stage_legacy_stores_mapping.size());
+    for (const auto& [from, to] : runtime_info.previous_stage_legacy_stores_mapping) {
+        builder.Add(from);
+        builder.Add(to);
+    }
+    builder.Add(runtime_info.convert_depth_mode);
+    builder.Add(runtime_info.force_early_z);
+    builder.Add(runtime_info.tess_primitive);
+    builder.Add(runtime_info.tess_spacing);
+    builder.Add(runtime_info.tess_clockwise);
+    builder.Add(runtime_info.input_topology);
+    builder.Add(runtime_info.fixed_state_point_size);
+    builder.Add(runtime_info.alpha_test_func);
+    builder.Add(runtime_info.alpha_test_reference);
+    builder.Add(runtime_info.y_negate);
+    builder.Add(runtime_info.glasm_use_storage_buffers);
+    builder.Add(runtime_info.xfb_count);
+    for (u32 index = 0; index < runtime_info.xfb_count; ++index) {
+        builder.Add(runtime_info.xfb_varyings[index]);
+    }
+    return builder.Hash();
+}
+
+void SpirvModuleCache::Load(const std::filesystem::path& filename_,
+                            u32 expected_cache_version) try {
+    std::scoped_lock lock{mutex};
+    filename = filename_;
+    cache_version = expected_cache_version;
+    file_size = 0;
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    file.exceptions(std::ifstream::failbit);
+    const auto end{file.tellg()};
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> magic_number;
+    u32 file_cache_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&file_cache_version), sizeof(file_cache_version));
+    if (magic_number != MAGIC_NUMBER || file_cache_version != expected_cache_version) {
+        file.close();
+        if (Common::FS::RemoveFile(filename)) {
+            LOG_INFO(Common_Filesystem, "Deleting old SPIR-V module cache");
+        } else {
+            LOG_ERROR(Common_Filesystem, "Failed to delete SPIR-V module cache in \"{}\"",
+                      Common::FS::PathToUTF8String(filename));
+        }
+        return;
+    }
+    while (file.tellg() != end) {
+        u64 key{};
+        Entry entry{};
+        u64 num_words{};
+        file.read(reinterpret_cast<char*>(&key), sizeof(key))
+            .read(reinterpret_cast<char*>(&entry.bindings), sizeof(entry.bindings))
+            .read(reinterpret_cast<char*>(&num_words), sizeof(num_words));
+        entry.code.resize(num_words);
+        file.read(reinterpret_cast<char*>(entry.code.data()), num_words * sizeof(u32));
+        entries.insert_or_assign(key, std::move(entry));
+    }
+    file_size = static_cast<size_t>(end);
+    LOG_INFO(Render, "Loaded {} shared SPIR-V modules", entries.size());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    entries.clear();
+    file_size = 0;
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete SPIR-V module cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
+std::optional<std::vector<u32>> SpirvModuleCache::Find(u64 key,
+                                                       Shader::Backend::Bindings& bindings) {
+    std::scoped_lock lock{mutex};
+    const auto it{entries.find(key)};
+    if (it == entries.end()) {
+        return std::nullopt;
+    }
+    bindings = it->second.bindings;
+    return it->second.code;
+}
+
+bool SpirvModuleCache::Add(u64 key, const Shader::Backend::Bindings& bindings,
+                           std::span<const u32> code) {
+    std::scoped_lock lock{mutex};
+    const auto [it, is_new]{entries.try_emplace(key)};
+    if (is_new) {
+        it->second.bindings = bindings;
+        it->second.code.assign(code.begin(), code.end());
+    }
+    return is_new;
+}
+
+void SpirvModuleCache::Serialize(u64 key, const Shader::Backend::Bindings& bindings,
+                                 std::span<const u32> code) try {
+    std::scoped_lock lock{mutex};
+    if (filename.empty() || file_size + code.size_bytes() > MAX_FILE_SIZE) {
+        return;
+    }
+    std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
+    file.exceptions(std::ifstream::failbit);
+    if (!file.is_open()) {
+        LOG_ERROR(Common_Filesystem, "Failed to open SPIR-V module cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    if (file.tellp() == 0) {
+        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+    }
+    const u64 num_words{static_cast<u64>(code.size())};
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key))
+        .write(reinterpret_cast<const char*>(&bindings), sizeof(bindings))
+        .write(reinterpret_cast<const char*>(&num_words), sizeof(num_words))
+        .write(reinterpret_cast<const char*>(code.data()), code.size_bytes());
+    file_size = static_cast<size_t>(file.tellp());
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "{}", e.what());
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete SPIR-V module cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+    file_size = 0;
+}
+
+} // namespace VideoCommon
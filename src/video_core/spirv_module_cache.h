@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "shader_recompiler/backend/bindings.h"
+
+namespace Shader {
+class Environment;
+struct RuntimeInfo;
+struct VaryingState;
+} // namespace Shader
+
+namespace VideoCommon {
+
+/**
+ * Content addressed cache of emitted SPIR-V modules shared between all titles.
+ * Modules are keyed by the translation inputs of their stage, so titles sharing engine code or
+ * updates of the same title reuse modules emitted by previous sessions.
+ */
+class SpirvModuleCache {
+public:
+    /// Computes the cache key of a stage translated from the given environments.
+    /// The stores of the stage are part of the key because linking can remove dead outputs.
+    /// Returns std::nullopt when any of the environments can't be hashed reliably.
+    [[nodiscard]] static std::optional<u64> MakeKey(std::span<Shader::Environment* const> envs,
+                                                    const Shader::RuntimeInfo& runtime_info,
+                                                    const Shader::VaryingState& stores,
+                                                    const Shader::Backend::Bindings& bindings);
+
+    /// Loads the modules stored in the given file, discarding it when invalid
+    void Load(const std::filesystem::path& filename, u32 expected_cache_version);
+
+    /// Looks up a module, on success bindings are advanced as if it was emitted
+    [[nodiscard]] std::optional<std::vector<u32>> Find(u64 key,
+                                                       Shader::Backend::Bindings& bindings);
+
+    /// Adds a module to the cache, returns true when it was not present before
+    bool Add(u64 key, const Shader::Backend::Bindings& bindings, std::span<const u32> code);
+
+    /// Appends a module to the backing file
+    void Serialize(u64 key, const Shader::Backend::Bindings& bindings, std::span<const u32> code);
+
+    [[nodiscard]] bool IsLoaded() const noexcept {
+        return !filename.empty();
+    }
+
+private:
+    struct Entry {
+        Shader::Backend::Bindings bindings;
+        std::vector<u32> code;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<u64, Entry> entries;
+    std::filesystem::path filename;
+    u32 cache_version{};
+    size_t file_size{};
+};
+
+} // namespace VideoCommon
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef HAS_SPIRV_TOOLS
+#include <spirv-tools/optimizer.hpp>
+#endif
+
+#include "common/logging/log.h"
+#include "video_core/spirv_optimizer.h"
+
+namespace VideoCommon {
+
+#ifdef HAS_SPIRV_TOOLS
+namespace {
+spv_target_env TargetEnvironment(u32 version) {
+    // Validate against the oldest Vulkan version that accepts the module's SPIR-V version
+    if (version >= 0x00010600) {
+        return SPV_ENV_VULKAN_1_3;
+    }
+    if (version >= 0x00010500) {
+        return SPV_ENV_VULKAN_1_2;
+    }
+    if (version >= 0x00010400) {
+        return SPV_ENV_VULKAN_1_1_SPIRV_1_4;
+    }
+    if (version >= 0x00010100) {
+        return SPV_ENV_VULKAN_1_1;
+    }
+    return SPV_ENV_VULKAN_1_0;
+}
+
+void RegisterPasses(spvtools::Optimizer& optimizer) {
+    optimizer.RegisterPass(spvtools::CreateWrapOpKillPass())
+        .RegisterPass(spvtools::CreateDeadBranchElimPass())
+        .RegisterPass(spvtools::CreateMergeReturnPass())
+        .RegisterPass(spvtools::CreateInlineExhaustivePass())
+        .RegisterPass(spvtools::CreateEliminateDeadFunctionsPass())
+        .RegisterPass(spvtools::CreatePrivateToLocalPass())
+        .RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass())
+        .RegisterPass(spvtools::CreateLocalSingleStoreElimPass())
+        .RegisterPass(spvtools::CreateScalarReplacementPass())
+        .RegisterPass(spvtools::CreateLocalAccessChainConvertPass())
+        .RegisterPass(spvtools::CreateLocalSingleBlockLoadStoreElimPass())
+        .RegisterPass(spvtools::CreateLocalSingleStoreElimPass())
+        .RegisterPass(spvtools::CreateSSARewritePass())
+        .RegisterPass(spvtools::CreateCCPPass())
+        .RegisterPass(spvtools::CreateCopyPropagateArraysPass())
+        .RegisterPass(spvtools::CreateAggressiveDCEPass())
+        .RegisterPass(spvtools::CreateDeadBranchElimPass())
+        .RegisterPass(spvtools::CreateBlockMergePass())
+        .RegisterPass(spvtools::CreateSimplificationPass())
+        .RegisterPass(spvtools::CreateRedundancyEliminationPass())
+        .RegisterPass(spvtools::CreateAggressiveDCEPass())
+        .RegisterPass(spvtools::CreateCFGCleanupPass());
+}
+} // Anonymous namespace
+#endif
+
+bool IsSpirvOptimizerAvailable() noexcept {
+#ifdef HAS_SPIRV_TOOLS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::optional<std::vector<u32>> OptimizeSpirv(std::span<const u32> code) {
+#ifdef HAS_SPIRV_TOOLS
+    if (code.size() < 5) {
+        return std::nullopt;
+    }
+    spvtools::Optimizer optimizer(TargetEnvironment(code[1]));
+    optimizer.SetMessageConsumer(
+        [](spv_message_level_t level, const char*, const spv_position_t& position,
+           const char* message) {
+            if (level <= SPV_MSG_ERROR) {
+                LOG_WARNING(Render_Vulkan, "SPIR-V optimizer at word {}: {}", position.index,
+                            message);
+            }
+        });
+    RegisterPasses(optimizer);
+
+    std::vector<u32> result;
+    if (!optimizer.Run(code.data(), code.size(), &result)) {
+        return std::nullopt;
+    }
+    return result;
+#else
+    return std::nullopt;
+#endif
+}
+
+} // namespace VideoCommon
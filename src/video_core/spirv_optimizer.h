@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// Returns true when yuzu was built with the SPIRV-Tools optimizer
+[[nodiscard]] bool IsSpirvOptimizerAvailable() noexcept;
+
+/**
+ * Runs a fixed SPIRV-Tools recipe over a module: inlining, scalar replacement, local load/store
+ * elimination, copy propagation, dead branch and dead code elimination.
+ * This is too slow to run before a pipeline is first built, callers run it off the critical path.
+ *
+ * @returns The optimized module, or std::nullopt when the optimizer is unavailable or failed
+ */
+[[nodiscard]] std::optional<std::vector<u32>> OptimizeSpirv(std::span<const u32> code);
+
+} // namespace VideoCommon
@@ -102,7 +102,10 @@ struct ImageBase {
     VAddr cpu_addr_end = 0;
 
     u64 modification_tick = 0;
+    u64 content_hash = 0; ///< Hash of the guest contents, zero when unknown or modified
     size_t lru_index = SIZE_MAX;
+    u64 last_use_tick = 0;
+    u32 use_frequency = 0;
 
     std::array<u32, MAX_MIP_LEVELS> mip_level_offsets{};
 
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * Calls func(page, entry) for every page in [page_begin, page_end] present in a hash table of
+ * pages, in ascending page order. Iteration stops early when func returns true.
+ *
+ * Page tables are sparse, so when the range spans more pages than the table holds, the table is
+ * walked instead of looking up every page. This keeps huge ranges, like unmaps of gigabytes,
+ * proportional to the number of cached pages instead of the size of the range.
+ */
+template <typename Table, typename Func>
+void ForEachPresentPage(Table& table, u64 page_begin, u64 page_end, Func&& func) {
+    using Entry = typename Table::mapped_type;
+    static constexpr bool RETURNS_BOOL =
+        std::is_same_v<std::invoke_result_t<Func, u64, Entry&>, bool>;
+    const auto call = [&func](u64 page, Entry& entry) {
+        if constexpr (RETURNS_BOOL) {
+            return func(page, entry);
+        } else {
+            func(page, entry);
+            return false;
+        }
+    };
+    if (page_end - page_begin < table.size()) {
+        for (u64 page = page_begin; page <= page_end; ++page) {
+            const auto it = table.find(page);
+            if (it != table.end() && call(page, it->second)) {
+                return;
+            }
+        }
+        return;
+    }
+    boost::container::small_vector<std::pair<u64, Entry*>, 64> pages;
+    for (auto& [page, entry] : table) {
+        if (page >= page_begin && page <= page_end) {
+            pages.emplace_back(page, &entry);
+        }
+    }
+    std::ranges::sort(pages, {}, &std::pair<u64, Entry*>::first);
+    for (const auto& [page, entry] : pages) {
+        if (call(page, *entry)) {
+            return;
+        }
+    }
+}
+
+} // namespace VideoCommon
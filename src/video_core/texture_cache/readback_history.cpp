@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "video_core/texture_cache/readback_history.h"
+
+namespace VideoCommon {
+namespace {
+constexpr u32 PREDICTION_THRESHOLD = 2;
+constexpr u64 EXPIRATION_FRAMES = 300;
+constexpr u64 SWEEP_INTERVAL_FRAMES = 60;
+} // Anonymous namespace
+
+void ReadbackHistory::RecordRead(DAddr addr, u64 frame) {
+    const auto [it, is_new] = entries.try_emplace(addr, Entry{
+                                                            .num_reads = 1,
+                                                            .last_read_frame = frame,
+                                                        });
+    if (is_new || it->second.last_read_frame == frame) {
+        return;
+    }
+    Entry& entry = it->second;
+    if (entry.num_reads < PREDICTION_THRESHOLD) {
+        ++entry.num_reads;
+    }
+    entry.last_read_frame = frame;
+}
+
+bool ReadbackHistory::IsPredicted(DAddr addr) const {
+    const auto it = entries.find(addr);
+    return it != entries.end() && it->second.num_reads >= PREDICTION_THRESHOLD;
+}
+
+void ReadbackHistory::Tick(u64 frame) {
+    if (frame - last_sweep_frame < SWEEP_INTERVAL_FRAMES) {
+        return;
+    }
+    last_sweep_frame = frame;
+    std::erase_if(entries, [frame](const auto& pair) {
+        return frame - pair.second.last_read_frame > EXPIRATION_FRAMES;
+    });
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <unordered_map>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * History of guest CPU reads of GPU modified images, keyed by guest address.
+ * Unlike the flags of an image, the history survives the image being recreated at the same address,
+ * so images that are read back every frame keep being downloaded ahead of the read.
+ */
+class ReadbackHistory {
+public:
+    /// Records a CPU read of GPU modified data at the given address, counted once per frame
+    void RecordRead(DAddr addr, u64 frame);
+
+    /// Returns true when the address has been read back on enough frames to predict the next read
+    [[nodiscard]] bool IsPredicted(DAddr addr) const;
+
+    /// Forgets addresses that have not been read back recently
+    void Tick(u64 frame);
+
+private:
+    struct Entry {
+        u32 num_reads;
+        u64 last_read_frame;
+    };
+
+    std::unordered_map<DAddr, Entry> entries;
+    u64 last_sweep_frame{};
+};
+
+} // namespace VideoCommon
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ctime>
+#include <string_view>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/texture_cache/stats.h"
+
+namespace VideoCommon {
+
+void TextureCacheStatsDump::Record(const TextureCacheStats& stats) {
+    if (!file.IsOpen()) {
+        if (has_failed) {
+            return;
+        }
+        Open();
+        if (!file.IsOpen()) {
+            return;
+        }
+    }
+    const std::string row = fmt::format(
+        "{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n", frame++, stats.num_lookups,
+        stats.num_hits, stats.num_misses, stats.num_images_created, stats.num_images_destroyed,
+        stats.num_uploaded_bytes, stats.num_downloaded_bytes, stats.num_alias_copies,
+        stats.num_scale_ups, stats.num_scale_downs, stats.num_gc_evictions,
+        stats.num_deduplicated_uploads, stats.num_upload_batches, stats.num_batched_uploads,
+        stats.num_batched_bytes, stats.async_decode_queue_depth);
+    if (file.WriteString(row) != row.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write texture cache statistics, disabling the dump");
+        file.Close();
+        has_failed = true;
+    }
+}
+
+void TextureCacheStatsDump::Open() {
+    const std::time_t t = std::time(nullptr);
+    // %F Date format expanded is "%Y-%m-%d"
+    const auto filename = fmt::format("{:%F-%H-%M}_texture_cache.csv", *std::localtime(&t));
+    const auto filepath = Common::FS::GetYuzuPath(Common::FS::YuzuPath::LogDir) / filename;
+    if (Common::FS::CreateParentDir(filepath)) {
+        file.Open(filepath, Common::FS::FileAccessMode::Write, Common::FS::FileType::TextFile);
+    }
+    static constexpr std::string_view header =
+        "frame,lookups,hits,misses,images_created,images_destroyed,uploaded_bytes,"
+        "downloaded_bytes,alias_copies,scale_ups,scale_downs,gc_evictions,deduplicated_uploads,"
+        "upload_batches,batched_uploads,batched_bytes,async_decode_queue_depth\n";
+    if (!file.IsOpen() || file.WriteString(header) != header.size()) {
+        LOG_ERROR(HW_GPU, "Failed to create texture cache statistics file \"{}\"",
+                  Common::FS::PathToUTF8String(filepath));
+        file.Close();
+        has_failed = true;
+        return;
+    }
+    LOG_INFO(HW_GPU, "Dumping texture cache statistics to \"{}\"",
+             Common::FS::PathToUTF8String(filepath));
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+
+namespace VideoCommon {
+
+/// Counters of the work done by the texture cache during a frame
+struct TextureCacheStats {
+    u64 num_lookups{};              ///< Image lookups by address and layout
+    u64 num_hits{};                 ///< Lookups that found a cached image
+    u64 num_misses{};               ///< Lookups that had to create an image
+    u64 num_images_created{};       ///< Images allocated, including joins of overlaps
+    u64 num_images_destroyed{};     ///< Images deleted, including garbage collected images
+    u64 num_uploaded_bytes{};       ///< Bytes written to staging buffers for image uploads
+    u64 num_downloaded_bytes{};     ///< Bytes read back from images to staging buffers
+    u64 num_alias_copies{};         ///< Image copies made to synchronize aliased images
+    u64 num_scale_ups{};            ///< Images switched to their rescaled copy
+    u64 num_scale_downs{};          ///< Images switched back to their native resolution copy
+    u64 num_gc_evictions{};         ///< Images evicted by the garbage collector
+    u64 num_deduplicated_uploads{}; ///< Uploads replaced by copies of identical images
+    u64 num_upload_batches{};       ///< Staging allocations shared by batched image uploads
+    u64 num_batched_uploads{};      ///< Image uploads recorded in batches
+    u64 num_batched_bytes{};        ///< Staging bytes used by batched image uploads
+    u64 async_decode_queue_depth{}; ///< Asynchronous decodes pending at the end of the frame
+};
+
+/// Appends the texture cache counters of every frame to a CSV file in the log directory
+class TextureCacheStatsDump {
+public:
+    void Record(const TextureCacheStats& stats);
+
+private:
+    void Open();
+
+    Common::FS::IOFile file;
+    u64 frame{};
+    bool has_failed{};
+};
+
+} // namespace VideoCommon
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <unordered_set>
 #include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/fs/path_util.h"
 #include "common/settings.h"
 #include "video_core/control/channel_state.h"
 #include "video_core/dirty_flags.h"
@@ -14,6 +17,7 @@
 #include "video_core/guest_memory.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 #include "video_core/texture_cache/image_view_base.h"
+#include "video_core/texture_cache/page_walk.h"
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/texture_cache_base.h"
 #include "video_core/texture_cache/util.h"
@@ -49,6 +53,14 @@ TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManag
     void(slot_image_views.insert(runtime, NullImageViewParams{}));
     void(slot_samplers.insert(runtime, sampler_descriptor));
 
+    if (Settings::values.use_astc_transcode_cache.GetValue()) {
+        const u64 cache_size_mib = Settings::values.astc_transcode_cache_size.GetValue();
+        const u64 max_size = cache_size_mib * 1_MiB;
+        transcode_cache.Open(Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) /
+                                 "astc_transcode_cache.bin",
+                             max_size);
+    }
+
     if constexpr (HAS_DEVICE_MEMORY_INFO) {
         const s64 device_local_memory = static_cast<s64>(runtime.GetDeviceLocalMemory());
         const s64 min_spacing_expected = device_local_memory - 1_GiB;
@@ -68,6 +80,11 @@ TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManag
         critical_memory = DEFAULT_CRITICAL_MEMORY + 1_GiB;
         minimum_memory = 0;
     }
+    device_minimum_memory = minimum_memory;
+    device_expected_memory = expected_memory;
+    device_critical_memory = critical_memory;
+    // Past the expected memory the garbage collector starts evicting images eagerly
+    Common::SetMemoryBudget(Common::MemoryUsageCategory::TextureCache, expected_memory);
 }
 
 template <class P>
@@ -107,15 +124,18 @@ void TextureCache<P>::RunGarbageCollector() {
             auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
             const auto copies = FullDownloadCopies(image.info);
             image.DownloadMemory(map, copies);
+            stats.num_downloaded_bytes += image.unswizzled_size_bytes;
             runtime.Finish();
             SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
                          swizzle_data_buffer);
         }
+        WriteBackHostImage(image_id);
         if (True(image.flags & ImageFlagBits::Tracked)) {
             UntrackImage(image, image_id);
         }
         UnregisterImage(image_id);
         DeleteImage(image_id, image.scale_tick > frame_tick + 5);
+        ++stats.num_gc_evictions;
         if (total_used_memory < critical_memory) {
             if (aggressive_mode) {
                 // Sink the aggresiveness.
@@ -131,15 +151,61 @@ void TextureCache<P>::RunGarbageCollector() {
         return false;
     };
 
+    const auto Collect = [&] {
+        // Rank the least recently used images so the frequently used ones stay resident
+        gc_candidates.clear();
+        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, [this](ImageId image_id) {
+            gc_candidates.emplace_back(EvictionScore(slot_images[image_id]), image_id);
+            return gc_candidates.size() >= GC_MAX_CANDIDATES;
+        });
+        std::ranges::stable_sort(gc_candidates, std::greater{}, &std::pair<u64, ImageId>::first);
+        for (const auto& [score, image_id] : gc_candidates) {
+            if (Cleanup(image_id)) {
+                break;
+            }
+        }
+    };
+
     // Try to remove anything old enough and not high priority.
     Configure(false);
-    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+    Collect();
 
     // If pressure is still too high, prune aggressively.
     if (total_used_memory >= critical_memory) {
         Configure(true);
-        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+        Collect();
+    }
+}
+
+template <class P>
+void TextureCache<P>::UpdateMemoryBudget(u64 budget) {
+    if (budget == 0) {
+        return;
     }
+    // The budget accounts for the memory other processes are using, leave some headroom for
+    // allocations the cache does not know about before the driver starts paging.
+    critical_memory = std::min(device_critical_memory, budget - budget / 16);
+    expected_memory = std::min(device_expected_memory, budget - budget / 8);
+    minimum_memory = std::min(device_minimum_memory, budget / 2);
+}
+
+template <class P>
+u64 TextureCache<P>::EvictionScore(const ImageBase& image) const noexcept {
+    const u64 idle_ticks = frame_tick - image.last_use_tick;
+    const u64 decay = std::min<u64>(idle_ticks / USE_FREQUENCY_HALF_LIFE, 31);
+    const u64 frequency = image.use_frequency >> decay;
+    return idle_ticks / (frequency + 1);
+}
+
+template <class P>
+void TextureCache<P>::TouchImage(ImageBase& image) {
+    if (image.last_use_tick != frame_tick) {
+        const u64 idle_ticks = frame_tick - image.last_use_tick;
+        const u64 decay = std::min<u64>(idle_ticks / USE_FREQUENCY_HALF_LIFE, 31);
+        image.use_frequency = std::min((image.use_frequency >> decay) + 1, MAX_USE_FREQUENCY);
+        image.last_use_tick = frame_tick;
+    }
+    lru_cache.Touch(image.lru_index, frame_tick);
 }
 
 template <class P>
@@ -147,6 +213,7 @@ void TextureCache<P>::TickFrame() {
     // If we can obtain the memory info, use it instead of the estimate.
     if (runtime.CanReportMemoryUsage()) {
         total_used_memory = runtime.GetDeviceMemoryUsage();
+        UpdateMemoryBudget(runtime.GetDeviceMemoryBudget());
     }
     if (total_used_memory > minimum_memory) {
         RunGarbageCollector();
@@ -155,8 +222,14 @@ void TextureCache<P>::TickFrame() {
     sentenced_framebuffers.Tick();
     sentenced_image_view.Tick();
     TickAsyncDecode();
+    stats.async_decode_queue_depth = async_decodes.size();
+    last_stats = std::exchange(stats, {});
+    if (Settings::values.dump_texture_cache_stats.GetValue()) {
+        stats_dump.Record(last_stats);
+    }
 
     runtime.TickFrame();
+    readback_history.Tick(frame_tick);
     ++frame_tick;
 
     if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
@@ -167,6 +240,27 @@ void TextureCache<P>::TickFrame() {
     }
 }
 
+template <class P>
+void TextureCache<P>::ReleaseScaledImages() {
+    for (auto [id, image] : slot_images) {
+        if (True(image->flags & ImageFlagBits::Rescaled)) {
+            ScaleDown(*image);
+        }
+    }
+    // Wait for the scale downs and for the commands still reading the scaled copies
+    runtime.Finish();
+    for (auto [id, image] : slot_images) {
+        if (!image->HasScaled()) {
+            continue;
+        }
+        const u64 scaled_size = GetScaledImageSizeBytes(*image);
+        total_used_memory -= scaled_size;
+        memory_usage.Subtract(scaled_size);
+        image->ReleaseScaledImage();
+        image->has_scaled = false;
+    }
+}
+
 template <class P>
 const typename P::ImageView& TextureCache<P>::GetImageView(ImageViewId id) const noexcept {
     return slot_image_views[id];
@@ -185,8 +279,13 @@ typename P::ImageView& TextureCache<P>::GetImageView(u32 index) noexcept {
 }
 
 template <class P>
-void TextureCache<P>::MarkModification(ImageId id) noexcept {
-    MarkModification(slot_images[id]);
+void TextureCache<P>::MarkModification(ImageId id) {
+    ImageBase& image = slot_images[id];
+    MarkModification(image);
+    // Render targets are queued when bound, this covers storage images and copies
+    if (image.info.forced_flushed && readback_history.IsPredicted(image.cpu_addr)) {
+        QueuePreemtiveDownload(id);
+    }
 }
 
 template <class P>
@@ -475,6 +574,8 @@ void TextureCache<P>::FillImageViews(DescriptorTable<TICEntry>& table,
                                      std::span<ImageViewId> cached_image_view_ids,
                                      std::span<ImageViewInOut> views) {
     bool has_blacklisted = false;
+    // Uploads of the images in the table are packed together and flushed before returning
+    is_batching_uploads = true;
     do {
         has_deleted_images = false;
         if constexpr (has_blacklists) {
@@ -492,6 +593,8 @@ void TextureCache<P>::FillImageViews(DescriptorTable<TICEntry>& table,
             }
         }
     } while (has_deleted_images || (has_blacklists && has_blacklisted));
+    is_batching_uploads = false;
+    FlushUploadBatch();
 }
 
 template <class P>
@@ -544,6 +647,17 @@ void TextureCache<P>::WriteMemory(DAddr cpu_addr, size_t size) {
 
 template <class P>
 void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
+    if (!host_image_writes.empty()) {
+        boost::container::small_vector<ImageId, 16> host_written;
+        ForEachImageInRegion(cpu_addr, size, [this, &host_written](ImageId image_id, ImageBase&) {
+            if (host_image_writes.contains(image_id)) {
+                host_written.push_back(image_id);
+            }
+        });
+        for (const ImageId image_id : host_written) {
+            WriteBackHostImage(image_id);
+        }
+    }
     boost::container::small_vector<ImageId, 16> images;
     ForEachImageInRegion(cpu_addr, size, [&images](ImageId image_id, ImageBase& image) {
         if (!image.IsSafeDownload()) {
@@ -558,13 +672,55 @@ void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
     std::ranges::sort(images, [this](ImageId lhs, ImageId rhs) {
         return slot_images[lhs].modification_tick < slot_images[rhs].modification_tick;
     });
-    for (const ImageId image_id : images) {
-        Image& image = slot_images[image_id];
-        auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
-        const auto copies = FullDownloadCopies(image.info);
-        image.DownloadMemory(map, copies);
+    // Images with an asynchronous download in flight only have to wait for it to complete
+    boost::container::small_vector<std::span<u8>, 16> sources(images.size());
+    size_t total_size_bytes = 0;
+    u64 wait_tick = 0;
+    for (size_t i = 0; i < images.size(); ++i) {
+        const Image& image = slot_images[images[i]];
+        if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+            const auto it = in_flight_downloads.find(images[i]);
+            if (it != in_flight_downloads.end()) {
+                // Either it is consumed here or the image was modified after it was recorded,
+                // in both cases it must not be written back when the fence is released
+                if (it->second.modification_tick == image.modification_tick) {
+                    sources[i] = it->second.data;
+                    wait_tick = std::max(wait_tick, it->second.tick);
+                }
+                in_flight_downloads.erase(it);
+                if (!sources[i].empty()) {
+                    continue;
+                }
+            }
+        }
+        // Buffer offsets of image copies must be aligned to the texel block size
+        total_size_bytes += Common::AlignUp(image.unswizzled_size_bytes, 64);
+    }
+    if (total_size_bytes > 0) {
+        auto map = runtime.DownloadStagingBuffer(total_size_bytes);
+        stats.num_downloaded_bytes += total_size_bytes;
+        std::span<u8> download_span = map.mapped_span;
+        for (size_t i = 0; i < images.size(); ++i) {
+            if (!sources[i].empty()) {
+                continue;
+            }
+            Image& image = slot_images[images[i]];
+            const auto copies = FullDownloadCopies(image.info);
+            image.DownloadMemory(map, copies);
+            const size_t aligned_size = Common::AlignUp(image.unswizzled_size_bytes, 64);
+            map.offset += aligned_size;
+            sources[i] = download_span.first(image.unswizzled_size_bytes);
+            download_span = download_span.subspan(aligned_size);
+        }
+        // Waiting for the new downloads also waits for the ones in flight
         runtime.Finish();
-        SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
+    } else {
+        runtime.Wait(wait_tick);
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        const ImageBase& image = slot_images[images[i]];
+        const auto copies = FullDownloadCopies(image.info);
+        SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, sources[i],
                      swizzle_data_buffer);
     }
 }
@@ -591,6 +747,7 @@ std::optional<VideoCore::RasterizerDownloadArea> TextureCache<P>::GetFlushArea(D
         }
         area->preemtive &= image.info.forced_flushed;
         image.info.forced_flushed = true;
+        readback_history.RecordRead(image.cpu_addr, frame_tick);
     });
     return area;
 }
@@ -728,6 +885,56 @@ bool TextureCache<P>::BlitImage(const Tegra::Engines::Fermi2D::Surface& dst,
     return true;
 }
 
+template <class P>
+bool TextureCache<P>::WriteHostImage(DAddr cpu_addr, const Tegra::Engines::Fermi2D::Surface& config,
+                                     std::span<const u8> pixels) {
+    static constexpr ImageFlagBits incompatible_flags =
+        ImageFlagBits::AcceleratedUpload | ImageFlagBits::Converted | ImageFlagBits::Sparse |
+        ImageFlagBits::Rescaled | ImageFlagBits::IsDecoding;
+    const ImageInfo info{config};
+    if (info.type != ImageType::e2D) {
+        return false;
+    }
+    // The image must be the only one over the surface, others would keep stale contents
+    ImageId image_id{};
+    bool is_only_image = true;
+    ForEachImageInRegion(cpu_addr, CalculateGuestSizeInBytes(info), [&](ImageId id, Image& image) {
+        const bool matches = image.cpu_addr == cpu_addr && image.info.type == info.type &&
+                             image.info.format == info.format && image.info.size == info.size &&
+                             image.info.block == info.block &&
+                             image.info.resources.levels == 1 &&
+                             image.info.resources.layers == 1 && image.info.num_samples == 1 &&
+                             False(image.flags & incompatible_flags) &&
+                             image.aliased_images.empty();
+        if (!matches || image_id) {
+            is_only_image = false;
+            return true;
+        }
+        image_id = id;
+        return false;
+    });
+    if (!image_id || !is_only_image) {
+        return false;
+    }
+    Image& image = slot_images[image_id];
+    if (pixels.size() != image.unswizzled_size_bytes) {
+        return false;
+    }
+    host_image_writes[image_id].assign(pixels.begin(), pixels.end());
+
+    // The new contents replace both what guest memory and the host image held
+    in_flight_downloads.erase(image_id);
+    image.content_hash = 0;
+    image.flags &= ~ImageFlagBits::GpuModified;
+    if (False(image.flags & ImageFlagBits::CpuModified)) {
+        image.flags |= ImageFlagBits::CpuModified;
+        if (True(image.flags & ImageFlagBits::Tracked)) {
+            UntrackImage(image, image_id);
+        }
+    }
+    return true;
+}
+
 template <class P>
 std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImageView(
     const Tegra::FramebufferConfig& config, DAddr cpu_addr) {
@@ -787,6 +994,20 @@ std::pair<typename P::ImageView*, bool> TextureCache<P>::TryFindFramebufferImage
     return {};
 }
 
+template <class P>
+std::pair<typename P::ImageView*, u64> TextureCache<P>::TryFindFramebufferContents(
+    const Tegra::FramebufferConfig& config, DAddr cpu_addr) {
+    ImageView* const image_view = TryFindFramebufferImageView(config, cpu_addr).first;
+    if (!image_view) {
+        return {};
+    }
+    const ImageBase& image = slot_images[image_view->image_id];
+    if (True(image.flags & ImageFlagBits::CpuModified)) {
+        return {};
+    }
+    return {image_view, image.modification_tick};
+}
+
 template <class P>
 bool TextureCache<P>::HasUncommittedFlushes() const noexcept {
     return !uncommitted_downloads.empty();
@@ -823,11 +1044,20 @@ void TextureCache<P>::CommitAsyncFlushes() {
 
         if (any_none_dma) {
             auto download_map = runtime.DownloadStagingBuffer(total_size_bytes, true);
+            stats.num_downloaded_bytes += total_size_bytes;
             for (const PendingDownload& download_info : download_ids) {
                 if (download_info.is_swizzle) {
                     Image& image = slot_images[download_info.object_id];
                     const auto copies = FullDownloadCopies(image.info);
                     image.DownloadMemory(download_map, copies);
+                    in_flight_downloads.insert_or_assign(
+                        download_info.object_id,
+                        InFlightDownload{
+                            .tick = runtime.CurrentTick(),
+                            .modification_tick = image.modification_tick,
+                            .data = download_map.mapped_span.subspan(download_map.offset,
+                                                                     image.unswizzled_size_bytes),
+                        });
                     download_map.offset += Common::AlignUp(image.unswizzled_size_bytes, 64);
                 }
             }
@@ -863,6 +1093,14 @@ void TextureCache<P>::PopAsyncFlushes() {
                 download_buffer.offset -= Common::AlignUp(image.unswizzled_size_bytes, 64);
                 std::span<u8> download_span =
                     download_buffer.mapped_span.subspan(download_buffer.offset);
+                const auto it = in_flight_downloads.find(download_info.object_id);
+                if (it == in_flight_downloads.end()) {
+                    // Already written back when the guest touched the image, or deleted
+                    continue;
+                }
+                if (it->second.data.data() == download_span.data()) {
+                    in_flight_downloads.erase(it);
+                }
                 SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, download_span,
                              swizzle_data_buffer);
             } else {
@@ -892,6 +1130,7 @@ void TextureCache<P>::PopAsyncFlushes() {
             }
         }
         auto download_map = runtime.DownloadStagingBuffer(total_size_bytes);
+        stats.num_downloaded_bytes += total_size_bytes;
         const size_t original_offset = download_map.offset;
         for (const PendingDownload& download_info : download_ids) {
             if (!download_info.is_swizzle) {
@@ -966,8 +1205,9 @@ bool TextureCache<P>::IsRescaling(const ImageViewBase& image_view) const noexcep
 template <class P>
 bool TextureCache<P>::IsRegionGpuModified(DAddr addr, size_t size) {
     bool is_modified = false;
-    ForEachImageInRegion(addr, size, [&is_modified](ImageId, ImageBase& image) {
-        if (False(image.flags & ImageFlagBits::GpuModified)) {
+    ForEachImageInRegion(addr, size, [this, &is_modified](ImageId image_id, ImageBase& image) {
+        if (False(image.flags & ImageFlagBits::GpuModified) &&
+            !host_image_writes.contains(image_id)) {
             return false;
         }
         is_modified = true;
@@ -1031,6 +1271,7 @@ void TextureCache<P>::DownloadImageIntoBuffer(typename TextureCache<P>::Image* i
         const PendingDownload new_download{false, uncommitted_async_buffers.size(), slot};
         uncommitted_downloads.emplace_back(new_download);
         auto download_map = runtime.DownloadStagingBuffer(size, true);
+        stats.num_downloaded_bytes += size;
         uncommitted_async_buffers.emplace_back(download_map);
         std::array buffers{
             buffer,
@@ -1047,7 +1288,7 @@ void TextureCache<P>::DownloadImageIntoBuffer(typename TextureCache<P>::Image* i
 }
 
 template <class P>
-void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
+void TextureCache<P>::RefreshContents(Image& image, ImageId image_id, bool can_batch) {
     if (False(image.flags & ImageFlagBits::CpuModified)) {
         // Only upload modified images
         return;
@@ -1055,25 +1296,153 @@ void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
     image.flags &= ~ImageFlagBits::CpuModified;
     TrackImage(image, image_id);
 
+    if (const auto it = host_image_writes.find(image_id); it != host_image_writes.end()) {
+        if (True(image.flags & ImageFlagBits::Rescaled)) {
+            WriteBackHostImage(image_id);
+        } else {
+            auto staging = runtime.UploadStagingBuffer(it->second.size());
+            std::memcpy(staging.mapped_span.data(), it->second.data(), it->second.size());
+            auto copies = FullDownloadCopies(image.info);
+            image.UploadMemory(staging, copies);
+            runtime.InsertUploadMemoryBarrier();
+            stats.num_uploaded_bytes += it->second.size();
+            host_image_writes.erase(it);
+            // Guest memory does not hold these contents, download them if it is read
+            MarkModification(image);
+            return;
+        }
+    }
     if (image.info.num_samples > 1 && !runtime.CanUploadMSAA()) {
         LOG_WARNING(HW_GPU, "MSAA image uploads are not implemented");
         runtime.TransitionImageLayout(image);
         return;
     }
+    if (DeduplicateContents(image, image_id)) {
+        return;
+    }
     if (True(image.flags & ImageFlagBits::AsynchronousDecode)) {
         QueueAsyncDecode(image, image_id);
         return;
     }
+    if (can_batch && is_batching_uploads && CanBatchUpload(image)) {
+        const size_t size = Common::AlignUp(MapSizeBytes(image), UPLOAD_BATCH_ALIGNMENT);
+        if (upload_batch_size + size > MAX_UPLOAD_BATCH_SIZE) {
+            FlushUploadBatch();
+        }
+        batched_uploads.push_back(image_id);
+        upload_batch_size += size;
+        return;
+    }
     auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
     UploadImageContents(image, staging);
     runtime.InsertUploadMemoryBarrier();
 }
 
+template <class P>
+void TextureCache<P>::WriteBackHostImage(ImageId image_id) {
+    const auto it = host_image_writes.find(image_id);
+    if (it == host_image_writes.end()) {
+        return;
+    }
+    const ImageBase& image = slot_images[image_id];
+    const auto copies = FullDownloadCopies(image.info);
+    SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, it->second,
+                 swizzle_data_buffer);
+    host_image_writes.erase(it);
+}
+
+template <class P>
+bool TextureCache<P>::CanBatchUpload(const Image& image) const {
+    // Accelerated uploads bind the staging buffer directly. Aliased and rescaled images are
+    // read or written by other commands before the batch is flushed.
+    return False(image.flags & ImageFlagBits::AcceleratedUpload) &&
+           False(image.flags & ImageFlagBits::Rescaled) && image.aliased_images.empty() &&
+           MapSizeBytes(image) <= MAX_UPLOAD_BATCH_SIZE;
+}
+
+template <class P>
+void TextureCache<P>::FlushUploadBatch() {
+    if (batched_uploads.empty()) {
+        return;
+    }
+    boost::container::small_vector<size_t, 64> offsets;
+    size_t total_size = 0;
+    for (const ImageId image_id : batched_uploads) {
+        offsets.push_back(total_size);
+        total_size += Common::AlignUp(MapSizeBytes(slot_images[image_id]), UPLOAD_BATCH_ALIGNMENT);
+    }
+    auto staging = runtime.UploadStagingBuffer(total_size);
+    for (size_t index = 0; index < batched_uploads.size(); ++index) {
+        UploadImageContents(slot_images[batched_uploads[index]], staging, offsets[index], true);
+    }
+    runtime.FlushImageUploads();
+    runtime.InsertUploadMemoryBarrier();
+
+    ++stats.num_upload_batches;
+    stats.num_batched_uploads += batched_uploads.size();
+    stats.num_batched_bytes += total_size;
+    batched_uploads.clear();
+    upload_batch_size = 0;
+}
+
+template <class P>
+bool TextureCache<P>::DeduplicateContents(Image& image, ImageId image_id) {
+    image.content_hash = 0;
+    if (!Settings::values.use_texture_deduplication.GetValue() ||
+        True(image.flags & ImageFlagBits::Rescaled) || !image.aliased_images.empty()) {
+        return false;
+    }
+    Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead> guest_data(
+        *gpu_memory, image.gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
+    // The key folds the image layout in, so matching keys also imply matching image infos
+    const u64 content_hash = TranscodeCache::MakeKey(guest_data, image.info);
+    const auto [it, is_new] = deduplicated_images.try_emplace(content_hash, image_id);
+    const ImageId source_id = it->second;
+    if (is_new || !IsDeduplicationSource(slot_images[source_id], source_id, content_hash)) {
+        // The image becomes the source of its contents once it has been uploaded
+        it->second = image_id;
+        image.content_hash = content_hash;
+        return false;
+    }
+    runtime.TransitionImageLayout(image);
+    const auto copies = MakeReinterpretImageCopies(image.info);
+    CopyImage(image_id, source_id, std::vector<ImageCopy>(copies.begin(), copies.end()));
+    image.content_hash = content_hash;
+    ++stats.num_deduplicated_uploads;
+    return true;
+}
+
+template <class P>
+bool TextureCache<P>::IsDeduplicationSource(const Image& image, ImageId image_id,
+                                            u64 content_hash) const {
+    // Pending uploads and decodes have not written the host image yet
+    static constexpr ImageFlagBits stale_flags = ImageFlagBits::CpuModified |
+                                                 ImageFlagBits::Rescaled |
+                                                 ImageFlagBits::IsDecoding;
+    if (image.content_hash != content_hash || True(image.flags & stale_flags) ||
+        !image.aliased_images.empty()) {
+        return false;
+    }
+    return std::ranges::find(batched_uploads, image_id) == batched_uploads.end();
+}
+
 template <class P>
 template <typename StagingBuffer>
-void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging) {
-    const std::span<u8> mapped_span = staging.mapped_span;
+void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging,
+                                          size_t staging_offset, bool is_batched) {
+    const std::span<u8> mapped_span = staging.mapped_span.subspan(staging_offset);
     const GPUVAddr gpu_addr = image.gpu_addr;
+    stats.num_uploaded_bytes += MapSizeBytes(image);
+    const auto upload = [&](std::span<BufferImageCopy> copies) {
+        if (!is_batched) {
+            image.UploadMemory(staging, copies);
+            return;
+        }
+        for (BufferImageCopy& copy : copies) {
+            copy.buffer_offset += staging_offset;
+        }
+        runtime.QueueImageUpload(image, staging, copies);
+    };
 
     if (True(image.flags & ImageFlagBits::AcceleratedUpload)) {
         gpu_memory->ReadBlock(gpu_addr, mapped_span.data(), mapped_span.size_bytes(),
@@ -1087,15 +1456,29 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         *gpu_memory, gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
 
     if (True(image.flags & ImageFlagBits::Converted)) {
+        const bool uses_transcode_cache = UsesTranscodeCache(image.info);
+        u64 transcode_key{};
+        if (uses_transcode_cache) {
+            transcode_key = TranscodeCache::MakeKey(swizzle_data, image.info);
+            boost::container::small_vector<BufferImageCopy, 16> cached_copies;
+            if (transcode_cache.Find(transcode_key, mapped_span, cached_copies)) {
+                upload(cached_copies);
+                return;
+            }
+        }
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
         ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
-        image.UploadMemory(staging, copies);
+        if (uses_transcode_cache && !copies.empty()) {
+            const size_t converted_size = copies.back().buffer_offset + copies.back().buffer_size;
+            transcode_cache.Add(transcode_key, mapped_span.first(converted_size), copies);
+        }
+        upload(copies);
     } else {
-        const auto copies =
+        auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, mapped_span);
-        image.UploadMemory(staging, copies);
+        upload(copies);
     }
 }
 
@@ -1139,9 +1522,12 @@ ImageViewId TextureCache<P>::CreateImageView(const TICEntry& config) {
 template <class P>
 ImageId TextureCache<P>::FindOrInsertImage(const ImageInfo& info, GPUVAddr gpu_addr,
                                            RelaxedOptions options) {
+    ++stats.num_lookups;
     if (const ImageId image_id = FindImage(info, gpu_addr, options); image_id) {
+        ++stats.num_hits;
         return image_id;
     }
+    ++stats.num_misses;
     return InsertImage(info, gpu_addr, options);
 }
 
@@ -1291,26 +1677,57 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     local_unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
     Tegra::Memory::GpuGuestMemory<u8, Tegra::Memory::GuestMemoryFlags::UnsafeRead> swizzle_data(
         *gpu_memory, image.gpu_addr, image.guest_size_bytes, &swizzle_data_buffer);
+    const size_t out_size = MapSizeBytes(image);
+
+    const bool uses_transcode_cache = UsesTranscodeCache(image.info);
+    u64 transcode_key{};
+    if (uses_transcode_cache) {
+        transcode_key = TranscodeCache::MakeKey(swizzle_data, image.info);
+        decode_ptr->decoded_data.resize_destructive(out_size);
+        if (transcode_cache.Find(transcode_key, decode_ptr->decoded_data, decode_ptr->copies)) {
+            decode_ptr->decoded_size = out_size;
+            decode_ptr->complete = true;
+            return;
+        }
+    }
 
     auto copies = UnswizzleImage(*gpu_memory, image.gpu_addr, image.info, swizzle_data,
                                  local_unswizzle_data_buffer);
-    const size_t out_size = MapSizeBytes(image);
 
-    auto func = [out_size, copies, info = image.info,
-                 input = std::move(local_unswizzle_data_buffer),
-                 async_decode = decode_ptr]() mutable {
+    auto func = [this, out_size, copies, info = image.info,
+                 input = std::move(local_unswizzle_data_buffer), async_decode = decode_ptr,
+                 uses_transcode_cache, transcode_key]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
-        std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
-
-        // TODO: Do we need this lock?
-        std::unique_lock lock{async_decode->mutex};
-        async_decode->copies = std::move(copies);
+        const std::span<u8> output{async_decode->decoded_data.data(), out_size};
+        // Mip levels are decoded from the base level up and published one at a time, so the
+        // levels needed first are uploaded without waiting for the whole chain to be decoded
+        u32 output_offset = 0;
+        for (BufferImageCopy& copy : copies) {
+            const u32 copy_offset = output_offset;
+            output_offset +=
+                ConvertImage(input, info, output.subspan(copy_offset), std::span{&copy, 1});
+            copy.buffer_offset += copy_offset;
+            std::scoped_lock lock{async_decode->mutex};
+            async_decode->copies.push_back(copy);
+            async_decode->decoded_size = output_offset;
+        }
+        if (uses_transcode_cache && !copies.empty()) {
+            const size_t converted_size = copies.back().buffer_offset + copies.back().buffer_size;
+            transcode_cache.Add(transcode_key, output.first(converted_size), copies);
+        }
+        std::scoped_lock lock{async_decode->mutex};
         async_decode->complete = true;
     };
     texture_decode_worker.QueueWork(std::move(func));
 }
 
+template <class P>
+bool TextureCache<P>::UsesTranscodeCache(const ImageInfo& info) const noexcept {
+    return transcode_cache.IsOpen() && IsPixelFormatASTC(info.format) &&
+           Settings::values.astc_recompression.GetValue() !=
+               Settings::AstcRecompression::Uncompressed;
+}
+
 template <class P>
 void TextureCache<P>::TickAsyncDecode() {
     bool has_uploads{};
@@ -1318,17 +1735,31 @@ void TextureCache<P>::TickAsyncDecode() {
     while (i != async_decodes.end()) {
         auto* async_decode = i->get();
         std::unique_lock lock{async_decode->mutex};
+        const size_t first_copy = async_decode->num_uploaded_copies;
+        const size_t num_copies = async_decode->copies.size() - first_copy;
+        if (num_copies != 0) {
+            // Upload the mip levels decoded since the last tick
+            const size_t offset = async_decode->copies[first_copy].buffer_offset;
+            const size_t size = async_decode->decoded_size - offset;
+            auto staging = runtime.UploadStagingBuffer(size);
+            std::memcpy(staging.mapped_span.data(), async_decode->decoded_data.data() + offset,
+                        size);
+            boost::container::small_vector<BufferImageCopy, 16> copies(
+                async_decode->copies.begin() + first_copy, async_decode->copies.end());
+            for (BufferImageCopy& copy : copies) {
+                copy.buffer_offset -= offset;
+            }
+            stats.num_uploaded_bytes += size;
+            slot_images[async_decode->image_id].UploadMemory(staging, copies);
+            async_decode->num_uploaded_copies += num_copies;
+            has_uploads = true;
+        }
         if (!async_decode->complete) {
             ++i;
             continue;
         }
-        Image& image = slot_images[async_decode->image_id];
-        auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
-        std::memcpy(staging.mapped_span.data(), async_decode->decoded_data.data(),
-                    async_decode->decoded_data.size());
-        image.UploadMemory(staging, async_decode->copies);
-        image.flags &= ~ImageFlagBits::IsDecoding;
-        has_uploads = true;
+        slot_images[async_decode->image_id].flags &= ~ImageFlagBits::IsDecoding;
+        lock.unlock();
         i = async_decodes.erase(i);
     }
     if (has_uploads) {
@@ -1343,8 +1774,11 @@ bool TextureCache<P>::ScaleUp(Image& image) {
     if (!rescaled) {
         return false;
     }
+    ++stats.num_scale_ups;
     if (!has_copy) {
-        total_used_memory += GetScaledImageSizeBytes(image);
+        const u64 scaled_size = GetScaledImageSizeBytes(image);
+        total_used_memory += scaled_size;
+        memory_usage.Add(scaled_size);
     }
     InvalidateScale(image);
     return true;
@@ -1356,6 +1790,9 @@ bool TextureCache<P>::ScaleDown(Image& image) {
     if (!rescaled) {
         return false;
     }
+    ++stats.num_scale_downs;
+    // Scaling down resamples the contents, they no longer match the guest texels exactly
+    image.content_hash = 0;
     InvalidateScale(image);
     return true;
 }
@@ -1457,6 +1894,15 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, DA
     ForEachSparseImageInRegion(channel_state->gpu_memory.GetID(), gpu_addr, size_bytes,
                                region_check_gpu);
 
+    // The new image copies from or aliases the images it overlaps, their uploads must land first
+    const auto is_joined = [this](ImageId image_id) {
+        return join_overlaps_found.contains(image_id) ||
+               std::ranges::find(join_left_aliased_ids, image_id) != join_left_aliased_ids.end();
+    };
+    if (std::ranges::any_of(batched_uploads, is_joined)) {
+        FlushUploadBatch();
+    }
+
     bool can_rescale = info.rescaleable;
     bool any_rescaled = false;
     for (const auto& copy : join_copies_to_do) {
@@ -1482,7 +1928,11 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, DA
         }
     }
 
+    if (readback_history.IsPredicted(cpu_addr)) {
+        new_info.forced_flushed = true;
+    }
     const ImageId new_image_id = slot_images.insert(runtime, new_info, gpu_addr, cpu_addr);
+    ++stats.num_images_created;
     Image& new_image = slot_images[new_image_id];
 
     if (!gpu_memory->IsContinuousRange(new_image.gpu_addr, new_image.guest_size_bytes) &&
@@ -1726,8 +2176,8 @@ std::pair<u32, u32> TextureCache<P>::PrepareDmaImage(ImageId dst_id, GPUVAddr ba
     const auto& image = slot_images[dst_id];
     const auto base = image.TryFindBase(base_addr);
     PrepareImage(dst_id, mark_as_modified, false);
-    const auto& new_image = slot_images[dst_id];
-    lru_cache.Touch(new_image.lru_index, frame_tick);
+    auto& new_image = slot_images[dst_id];
+    TouchImage(new_image);
     return std::make_pair(base->level, base->layer);
 }
 
@@ -1811,16 +2261,10 @@ void TextureCache<P>::ForEachImageInRegion(DAddr cpu_addr, size_t size, Func&& f
     static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
     boost::container::small_vector<ImageId, 32> images;
     boost::container::small_vector<ImageMapId, 32> maps;
-    ForEachCPUPage(cpu_addr, size, [this, &images, &maps, cpu_addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
-            if constexpr (BOOL_BREAK) {
-                return false;
-            } else {
-                return;
-            }
-        }
-        for (const ImageMapId map_id : it->second) {
+    const u64 page_begin = cpu_addr >> YUZU_PAGEBITS;
+    const u64 page_end = (cpu_addr + size - 1) >> YUZU_PAGEBITS;
+    ForEachPresentPage(page_table, page_begin, page_end, [&](u64, auto& page_maps) {
+        for (const ImageMapId map_id : page_maps) {
             ImageMapView& map = slot_map_views[map_id];
             if (map.picked) {
                 continue;
@@ -1868,38 +2312,31 @@ void TextureCache<P>::ForEachImageInRegionGPU(size_t as_id, GPUVAddr gpu_addr, s
         return;
     }
     auto& gpu_page_table = gpu_page_table_storage[*storage_id * 2];
-    ForEachGPUPage(gpu_addr, size,
-                   [this, &gpu_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = gpu_page_table.find(page);
-                       if (it == gpu_page_table.end()) {
-                           if constexpr (BOOL_BREAK) {
-                               return false;
-                           } else {
-                               return;
-                           }
-                       }
-                       for (const ImageId image_id : it->second) {
-                           Image& image = slot_images[image_id];
-                           if (True(image.flags & ImageFlagBits::Picked)) {
-                               continue;
-                           }
-                           if (!image.OverlapsGPU(gpu_addr, size)) {
-                               continue;
-                           }
-                           image.flags |= ImageFlagBits::Picked;
-                           images.push_back(image_id);
-                           if constexpr (BOOL_BREAK) {
-                               if (func(image_id, image)) {
-                                   return true;
-                               }
-                           } else {
-                               func(image_id, image);
-                           }
-                       }
-                       if constexpr (BOOL_BREAK) {
-                           return false;
-                       }
-                   });
+    const u64 page_begin = gpu_addr >> YUZU_PAGEBITS;
+    const u64 page_end = (gpu_addr + size - 1) >> YUZU_PAGEBITS;
+    ForEachPresentPage(gpu_page_table, page_begin, page_end, [&](u64, auto& page_images) {
+        for (const ImageId image_id : page_images) {
+            Image& image = slot_images[image_id];
+            if (True(image.flags & ImageFlagBits::Picked)) {
+                continue;
+            }
+            if (!image.OverlapsGPU(gpu_addr, size)) {
+                continue;
+            }
+            image.flags |= ImageFlagBits::Picked;
+            images.push_back(image_id);
+            if constexpr (BOOL_BREAK) {
+                if (func(image_id, image)) {
+                    return true;
+                }
+            } else {
+                func(image_id, image);
+            }
+        }
+        if constexpr (BOOL_BREAK) {
+            return false;
+        }
+    });
     for (const ImageId image_id : images) {
         slot_images[image_id].flags &= ~ImageFlagBits::Picked;
     }
@@ -1917,38 +2354,31 @@ void TextureCache<P>::ForEachSparseImageInRegion(size_t as_id, GPUVAddr gpu_addr
         return;
     }
     auto& sparse_page_table = gpu_page_table_storage[*storage_id * 2 + 1];
-    ForEachGPUPage(gpu_addr, size,
-                   [this, &sparse_page_table, &images, gpu_addr, size, func](u64 page) {
-                       const auto it = sparse_page_table.find(page);
-                       if (it == sparse_page_table.end()) {
-                           if constexpr (BOOL_BREAK) {
-                               return false;
-                           } else {
-                               return;
-                           }
-                       }
-                       for (const ImageId image_id : it->second) {
-                           Image& image = slot_images[image_id];
-                           if (True(image.flags & ImageFlagBits::Picked)) {
-                               continue;
-                           }
-                           if (!image.OverlapsGPU(gpu_addr, size)) {
-                               continue;
-                           }
-                           image.flags |= ImageFlagBits::Picked;
-                           images.push_back(image_id);
-                           if constexpr (BOOL_BREAK) {
-                               if (func(image_id, image)) {
-                                   return true;
-                               }
-                           } else {
-                               func(image_id, image);
-                           }
-                       }
-                       if constexpr (BOOL_BREAK) {
-                           return false;
-                       }
-                   });
+    const u64 page_begin = gpu_addr >> YUZU_PAGEBITS;
+    const u64 page_end = (gpu_addr + size - 1) >> YUZU_PAGEBITS;
+    ForEachPresentPage(sparse_page_table, page_begin, page_end, [&](u64, auto& page_images) {
+        for (const ImageId image_id : page_images) {
+            Image& image = slot_images[image_id];
+            if (True(image.flags & ImageFlagBits::Picked)) {
+                continue;
+            }
+            if (!image.OverlapsGPU(gpu_addr, size)) {
+                continue;
+            }
+            image.flags |= ImageFlagBits::Picked;
+            images.push_back(image_id);
+            if constexpr (BOOL_BREAK) {
+                if (func(image_id, image)) {
+                    return true;
+                }
+            } else {
+                func(image_id, image);
+            }
+        }
+        if constexpr (BOOL_BREAK) {
+            return false;
+        }
+    });
     for (const ImageId image_id : images) {
         slot_images[image_id].flags &= ~ImageFlagBits::Picked;
     }
@@ -1997,8 +2427,12 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
         True(image.flags & ImageFlagBits::Converted)) {
         tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
     }
-    total_used_memory += Common::AlignUp(tentative_size, 1024);
+    const u64 fitted_size = Common::AlignUp(tentative_size, 1024);
+    total_used_memory += fitted_size;
+    memory_usage.Add(fitted_size);
     image.lru_index = lru_cache.Insert(image_id, frame_tick);
+    image.last_use_tick = frame_tick;
+    image.use_frequency = 1;
 
     ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
         (*channel_state->gpu_page_table)[page].push_back(image_id);
@@ -2119,22 +2553,22 @@ void TextureCache<P>::TrackImage(ImageBase& image, ImageId image_id) {
         }
         return;
     }
+    boost::container::small_vector<std::pair<DAddr, size_t>, 16> ranges;
     if (True(image.flags & ImageFlagBits::Registered)) {
         auto it = sparse_views.find(image_id);
         ASSERT(it != sparse_views.end());
         auto& sparse_maps = it->second;
         for (auto& map_view_id : sparse_maps) {
             const auto& map = slot_map_views[map_view_id];
-            const DAddr cpu_addr = map.cpu_addr;
-            const std::size_t size = map.size;
-            device_memory.UpdatePagesCachedCount(cpu_addr, size, 1);
+            ranges.emplace_back(map.cpu_addr, map.size);
         }
-        return;
+    } else {
+        ForEachSparseSegment(
+            image, [&ranges]([[maybe_unused]] GPUVAddr gpu_addr, DAddr cpu_addr, size_t size) {
+                ranges.emplace_back(cpu_addr, size);
+            });
     }
-    ForEachSparseSegment(image,
-                         [this]([[maybe_unused]] GPUVAddr gpu_addr, DAddr cpu_addr, size_t size) {
-                             device_memory.UpdatePagesCachedCount(cpu_addr, size, 1);
-                         });
+    device_memory.UpdatePagesCachedBatch({ranges.data(), ranges.size()}, 1);
 }
 
 template <class P>
@@ -2151,19 +2585,21 @@ void TextureCache<P>::UntrackImage(ImageBase& image, ImageId image_id) {
     auto it = sparse_views.find(image_id);
     ASSERT(it != sparse_views.end());
     auto& sparse_maps = it->second;
+    boost::container::small_vector<std::pair<DAddr, size_t>, 16> ranges;
     for (auto& map_view_id : sparse_maps) {
         const auto& map = slot_map_views[map_view_id];
-        const DAddr cpu_addr = map.cpu_addr;
-        const std::size_t size = map.size;
-        device_memory.UpdatePagesCachedCount(cpu_addr, size, -1);
+        ranges.emplace_back(map.cpu_addr, map.size);
     }
+    device_memory.UpdatePagesCachedBatch({ranges.data(), ranges.size()}, -1);
 }
 
 template <class P>
 void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
     ImageBase& image = slot_images[image_id];
     if (image.HasScaled()) {
-        total_used_memory -= GetScaledImageSizeBytes(image);
+        const u64 scaled_size = GetScaledImageSizeBytes(image);
+        total_used_memory -= scaled_size;
+        memory_usage.Subtract(scaled_size);
     }
     u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
     if ((IsPixelFormatASTC(image.info.format) &&
@@ -2171,7 +2607,9 @@ void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
         True(image.flags & ImageFlagBits::Converted)) {
         tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
     }
-    total_used_memory -= Common::AlignUp(tentative_size, 1024);
+    const u64 fitted_size = Common::AlignUp(tentative_size, 1024);
+    total_used_memory -= fitted_size;
+    memory_usage.Subtract(fitted_size);
     const GPUVAddr gpu_addr = image.gpu_addr;
     const auto alloc_it = image_allocs_table.find(gpu_addr);
     if (alloc_it == image_allocs_table.end()) {
@@ -2188,6 +2626,14 @@ void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
     }
     ASSERT_MSG(False(image.flags & ImageFlagBits::Tracked), "Image was not untracked");
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered), "Image was not unregistered");
+    in_flight_downloads.erase(image_id);
+    host_image_writes.erase(image_id);
+    std::erase(batched_uploads, image_id);
+    ++stats.num_images_destroyed;
+    if (const auto it = deduplicated_images.find(image.content_hash);
+        it != deduplicated_images.end() && it->second == image_id) {
+        deduplicated_images.erase(it);
+    }
 
     // Mark render targets as dirty
     auto& dirty = maxwell3d->dirty.flags;
@@ -2287,6 +2733,7 @@ template <class P>
 void TextureCache<P>::MarkModification(ImageBase& image) noexcept {
     image.flags |= ImageFlagBits::GpuModified;
     image.modification_tick = ++modification_tick;
+    image.content_hash = 0;
 }
 
 template <class P>
@@ -2308,6 +2755,7 @@ void TextureCache<P>::SynchronizeAliases(ImageId image_id) {
     if (aliased_images.empty()) {
         return;
     }
+    stats.num_alias_copies += aliased_images.size();
     const bool can_rescale = ImageCanRescale(image);
     if (any_rescaled) {
         if (can_rescale) {
@@ -2351,13 +2799,13 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
             TrackImage(image, image_id);
         }
     } else {
-        RefreshContents(image, image_id);
+        RefreshContents(image, image_id, true);
         SynchronizeAliases(image_id);
     }
     if (is_modification) {
-        MarkModification(image);
+        MarkModification(image_id);
     }
-    lru_cache.Touch(image.lru_index, frame_tick);
+    TouchImage(image);
 }
 
 template <class P>
@@ -2377,6 +2825,7 @@ template <class P>
 void TextureCache<P>::CopyImage(ImageId dst_id, ImageId src_id, std::vector<ImageCopy> copies) {
     Image& dst = slot_images[dst_id];
     Image& src = slot_images[src_id];
+    dst.content_hash = 0;
     const bool is_rescaled = True(src.flags & ImageFlagBits::Rescaled);
     if (is_rescaled) {
         ASSERT(True(dst.flags & ImageFlagBits::Rescaled));
@@ -2469,13 +2918,22 @@ void TextureCache<P>::BindRenderTarget(ImageViewId* old_id, ImageViewId new_id)
     if (new_id) {
         const ImageViewBase& old_view = slot_image_views[new_id];
         if (True(old_view.flags & ImageViewFlagBits::PreemtiveDownload)) {
-            const PendingDownload new_download{true, 0, old_view.image_id};
-            uncommitted_downloads.emplace_back(new_download);
+            QueuePreemtiveDownload(old_view.image_id);
         }
     }
     *old_id = new_id;
 }
 
+template <class P>
+void TextureCache<P>::QueuePreemtiveDownload(ImageId image_id) {
+    const bool is_queued = std::ranges::any_of(uncommitted_downloads, [image_id](const auto& info) {
+        return info.is_swizzle && info.object_id == image_id;
+    });
+    if (!is_queued) {
+        uncommitted_downloads.push_back(PendingDownload{true, 0, image_id});
+    }
+}
+
 template <class P>
 std::pair<FramebufferId, ImageViewId> TextureCache<P>::RenderTargetFromImage(
     ImageId image_id, const ImageViewInfo& view_info) {
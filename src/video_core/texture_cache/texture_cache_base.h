@@ -11,6 +11,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 #include <boost/container/small_vector.hpp>
 #include <queue>
@@ -19,6 +20,7 @@
 #include "common/hash.h"
 #include "common/literals.h"
 #include "common/lru_cache.h"
+#include "common/memory_usage.h"
 #include "common/polyfill_ranges.h"
 #include "common/scratch_buffer.h"
 #include "common/slot_vector.h"
@@ -32,7 +34,10 @@
 #include "video_core/texture_cache/image_base.h"
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
+#include "video_core/texture_cache/readback_history.h"
 #include "video_core/texture_cache/render_targets.h"
+#include "video_core/texture_cache/stats.h"
+#include "video_core/texture_cache/transcode_cache.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
 
@@ -58,7 +63,9 @@ struct ImageViewInOut {
 struct AsyncDecodeContext {
     ImageId image_id;
     Common::ScratchBuffer<u8> decoded_data;
-    boost::container::small_vector<BufferImageCopy, 16> copies;
+    boost::container::small_vector<BufferImageCopy, 16> copies; ///< Copies decoded so far
+    size_t decoded_size{};        ///< Bytes of decoded_data written by the decoded copies
+    size_t num_uploaded_copies{}; ///< Decoded copies already uploaded to the image
     std::mutex mutex;
     std::atomic_bool complete;
 };
@@ -111,6 +118,14 @@ class TextureCache : public VideoCommon::ChannelSetupCaches<TextureCacheChannelI
     static constexpr s64 DEFAULT_EXPECTED_MEMORY = 1_GiB + 125_MiB;
     static constexpr s64 DEFAULT_CRITICAL_MEMORY = 1_GiB + 625_MiB;
     static constexpr size_t GC_EMERGENCY_COUNTS = 2;
+    /// Number of the least recently used images ranked on each garbage collection
+    static constexpr size_t GC_MAX_CANDIDATES = 256;
+    /// Frames of inactivity it takes to halve the use frequency of an image
+    static constexpr u64 USE_FREQUENCY_HALF_LIFE = 64;
+    static constexpr u32 MAX_USE_FREQUENCY = 255;
+    /// Largest staging allocation shared by a batch of image uploads
+    static constexpr size_t MAX_UPLOAD_BATCH_SIZE = 64_MiB;
+    static constexpr size_t UPLOAD_BATCH_ALIGNMENT = 256;
 
     using Runtime = typename P::Runtime;
     using Image = typename P::Image;
@@ -134,6 +149,10 @@ public:
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
+    /// Scales down rescaled images and frees their scaled copies, called before the resolution
+    /// scale changes so they are scaled up again at the new scale
+    void ReleaseScaledImages();
+
     /// Return a constant reference to the given image view id
     [[nodiscard]] const ImageView& GetImageView(ImageViewId id) const noexcept;
 
@@ -143,8 +162,13 @@ public:
     /// Get the imageview from the graphics descriptor table in the specified index
     [[nodiscard]] ImageView& GetImageView(u32 index) noexcept;
 
-    /// Mark an image as modified from the GPU
-    void MarkModification(ImageId id) noexcept;
+    /// Mark an image as modified from the GPU, downloading it preemtively if a read is predicted
+    void MarkModification(ImageId id);
+
+    /// Return the counters of the last frame
+    [[nodiscard]] const TextureCacheStats& GetStats() const noexcept {
+        return last_stats;
+    }
 
     /// Fill image_view_ids with the graphics images in indices
     template <bool has_blacklists>
@@ -211,7 +235,17 @@ public:
                    const Tegra::Engines::Fermi2D::Surface& src,
                    const Tegra::Engines::Fermi2D::Config& copy);
 
+    /// Replace the contents of the cached image at a CPU address with linear pixels produced
+    /// by another engine, without writing guest memory. Return false when no image matches.
+    bool WriteHostImage(DAddr cpu_addr, const Tegra::Engines::Fermi2D::Surface& config,
+                        std::span<const u8> pixels);
+
     /// Try to find a cached image view in the given CPU address
+    /// Return the view a framebuffer is displayed from and the modification tick of its image.
+    /// The view is null if the framebuffer is not in the cache or has pending CPU writes.
+    [[nodiscard]] std::pair<ImageView*, u64> TryFindFramebufferContents(
+        const Tegra::FramebufferConfig& config, DAddr cpu_addr);
+
     [[nodiscard]] std::pair<ImageView*, bool> TryFindFramebufferImageView(
         const Tegra::FramebufferConfig& config, DAddr cpu_addr);
 
@@ -289,6 +323,15 @@ private:
     /// Runs the Garbage Collector.
     void RunGarbageCollector();
 
+    /// Clamps the memory thresholds to the live memory budget reported by the driver
+    void UpdateMemoryBudget(u64 budget);
+
+    /// Returns the eviction score of an image, higher scores are evicted first
+    [[nodiscard]] u64 EvictionScore(const ImageBase& image) const noexcept;
+
+    /// Marks an image as used in the current frame
+    void TouchImage(ImageBase& image);
+
     /// Fills image_view_ids in the image views in indices
     template <bool has_blacklists>
     void FillImageViews(DescriptorTable<TICEntry>& table,
@@ -302,12 +345,29 @@ private:
     /// Find or create a framebuffer with the given render target parameters
     FramebufferId GetFramebufferId(const RenderTargets& key);
 
-    /// Refresh the contents (pixel data) of an image
-    void RefreshContents(Image& image, ImageId image_id);
+    /// Refresh the contents (pixel data) of an image, deferring it to the upload batch if allowed
+    void RefreshContents(Image& image, ImageId image_id, bool can_batch = false);
+
+    /// Write the pending host contents of an image to guest memory
+    void WriteBackHostImage(ImageId image_id);
 
     /// Upload data from guest to an image
     template <typename StagingBuffer>
-    void UploadImageContents(Image& image, StagingBuffer& staging_buffer);
+    void UploadImageContents(Image& image, StagingBuffer& staging_buffer,
+                             size_t staging_offset = 0, bool is_batched = false);
+
+    /// Return true when the upload of an image can be deferred to the current upload batch
+    [[nodiscard]] bool CanBatchUpload(const Image& image) const;
+
+    /// Upload the images deferred in the current batch through one staging allocation
+    void FlushUploadBatch();
+
+    /// Fill an image with a copy of a cached image with the same guest contents, when possible
+    [[nodiscard]] bool DeduplicateContents(Image& image, ImageId image_id);
+
+    /// Return true when the host contents of an image match the given content hash
+    [[nodiscard]] bool IsDeduplicationSource(const Image& image, ImageId image_id,
+                                             u64 content_hash) const;
 
     /// Find or create an image view from a guest descriptor
     [[nodiscard]] ImageViewId FindImageView(const TICEntry& config);
@@ -403,6 +463,9 @@ private:
     /// Bind an image view as render target, downloading resources preemtively if needed
     void BindRenderTarget(ImageViewId* old_id, ImageViewId new_id);
 
+    /// Queue a download of the image for the next fence, ignored when it is already queued
+    void QueuePreemtiveDownload(ImageId image_id);
+
     /// Create a render target from a given image and image view parameters
     [[nodiscard]] std::pair<FramebufferId, ImageViewId> RenderTargetFromImage(
         ImageId, const ImageViewInfo& view_info);
@@ -419,6 +482,9 @@ private:
     bool ScaleDown(Image& image);
     u64 GetScaledImageSizeBytes(const ImageBase& image);
 
+    /// Returns true when converted uploads of the image go through the transcode cache
+    [[nodiscard]] bool UsesTranscodeCache(const ImageInfo& info) const noexcept;
+
     void QueueAsyncDecode(Image& image, ImageId image_id);
     void TickAsyncDecode();
 
@@ -438,10 +504,16 @@ private:
 
     bool has_deleted_images = false;
     bool is_rescaling = false;
+    bool is_batching_uploads = false;
     u64 total_used_memory = 0;
+    /// Estimated image memory, kept apart as total_used_memory may come from the driver
+    Common::MemoryUsageCounter memory_usage{Common::MemoryUsageCategory::TextureCache};
     u64 minimum_memory;
     u64 expected_memory;
     u64 critical_memory;
+    u64 device_minimum_memory;
+    u64 device_expected_memory;
+    u64 device_critical_memory;
 
     struct BufferDownload {
         GPUVAddr address;
@@ -454,6 +526,12 @@ private:
         Common::SlotId object_id;
     };
 
+    struct InFlightDownload {
+        u64 tick;
+        u64 modification_tick;
+        std::span<u8> data;
+    };
+
     Common::SlotVector<Image> slot_images;
     Common::SlotVector<ImageMapView> slot_map_views;
     Common::SlotVector<ImageView> slot_image_views;
@@ -469,12 +547,20 @@ private:
     std::vector<AsyncBuffer> uncommitted_async_buffers;
     std::deque<std::vector<AsyncBuffer>> async_buffers;
     std::deque<AsyncBuffer> async_buffers_death_ring;
+    std::unordered_map<ImageId, InFlightDownload> in_flight_downloads;
+    ReadbackHistory readback_history;
 
     struct LRUItemParams {
         using ObjectType = ImageId;
         using TickType = u64;
     };
     Common::LeastRecentlyUsedCache<LRUItemParams> lru_cache;
+    std::vector<std::pair<u64, ImageId>> gc_candidates;
+
+    std::vector<ImageId> batched_uploads;
+    size_t upload_batch_size = 0;
+
+    std::unordered_map<u64, ImageId, Common::IdentityHash<u64>> deduplicated_images;
 
     static constexpr size_t TICKS_TO_DESTROY = 8;
     DelayedDestructionRing<Image, TICKS_TO_DESTROY> sentenced_images;
@@ -485,6 +571,11 @@ private:
 
     Common::ScratchBuffer<u8> swizzle_data_buffer;
     Common::ScratchBuffer<u8> unswizzle_data_buffer;
+    TranscodeCache transcode_cache;
+
+    TextureCacheStats stats{};
+    TextureCacheStats last_stats{};
+    TextureCacheStatsDump stats_dump;
 
     u64 modification_tick = 0;
     u64 frame_tick = 0;
@@ -505,6 +596,9 @@ private:
     };
     boost::container::small_vector<JoinCopy, 4> join_copies_to_do;
     std::unordered_map<ImageId, size_t> join_alias_indices;
+
+    /// Contents written with WriteHostImage, uploaded in place of guest memory on next use
+    std::unordered_map<ImageId, std::vector<u8>> host_image_writes;
 };
 
 } // namespace VideoCommon
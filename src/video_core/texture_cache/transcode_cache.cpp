@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <type_traits>
+
+#include "common/cityhash.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/transcode_cache.h"
+
+namespace VideoCommon {
+namespace {
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'a', 's', 't', 'c'};
+constexpr u32 CACHE_VERSION = 1;
+
+struct RecordHeader {
+    u64 key;
+    u64 data_size;
+    u32 num_copies;
+    u32 padding;
+};
+static_assert(std::has_unique_object_representations_v<RecordHeader>);
+} // Anonymous namespace
+
+u64 TranscodeCache::MakeKey(std::span<const u8> guest_data, const ImageInfo& info) {
+    const std::array<u32, 13> layout{
+        static_cast<u32>(info.format),
+        static_cast<u32>(info.type),
+        static_cast<u32>(info.resources.levels),
+        static_cast<u32>(info.resources.layers),
+        info.size.width,
+        info.size.height,
+        info.size.depth,
+        info.type == ImageType::Linear ? info.pitch : info.block.width,
+        info.type == ImageType::Linear ? 0 : info.block.height,
+        info.type == ImageType::Linear ? 0 : info.block.depth,
+        info.layer_stride,
+        info.tile_width_spacing,
+        static_cast<u32>(Settings::values.astc_recompression.GetValue()),
+    };
+    const u64 seed{Common::CityHash64(reinterpret_cast<const char*>(layout.data()),
+                                      sizeof(layout))};
+    return Common::CityHash64WithSeed(reinterpret_cast<const char*>(guest_data.data()),
+                                      guest_data.size(), seed);
+}
+
+void TranscodeCache::Open(const std::filesystem::path& filename, u64 max_size) {
+    std::scoped_lock lock{mutex};
+    entries.clear();
+    max_file_size = max_size;
+
+    if (!Common::FS::CreateParentDirs(filename)) {
+        LOG_ERROR(HW_GPU, "Failed to create directory for ASTC transcode cache \"{}\"",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    file.Open(filename, Common::FS::FileAccessMode::ReadAppend);
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open ASTC transcode cache \"{}\"",
+                  Common::FS::PathToUTF8String(filename));
+        return;
+    }
+    file_size = file.GetSize();
+
+    const auto discard{[&] {
+        LOG_INFO(HW_GPU, "Discarding invalid ASTC transcode cache");
+        file.Close();
+        file.Open(filename, Common::FS::FileAccessMode::Write);
+        file.Close();
+        entries.clear();
+        file.Open(filename, Common::FS::FileAccessMode::ReadAppend);
+        file_size = 0;
+    }};
+    if (file_size == 0) {
+        return;
+    }
+    std::array<char, 8> magic_number;
+    u32 file_cache_version{};
+    if (file.ReadSpan(std::span<char>{magic_number}) != magic_number.size() ||
+        !file.ReadObject(file_cache_version) || magic_number != MAGIC_NUMBER ||
+        file_cache_version != CACHE_VERSION) {
+        discard();
+        return;
+    }
+    u64 offset{sizeof(MAGIC_NUMBER) + sizeof(CACHE_VERSION)};
+    while (offset < file_size) {
+        RecordHeader header;
+        if (!file.ReadObject(header)) {
+            discard();
+            return;
+        }
+        const u64 copies_size{header.num_copies * sizeof(BufferImageCopy)};
+        const u64 record_size{sizeof(header) + copies_size + header.data_size};
+        if (offset + record_size > file_size ||
+            !file.Seek(static_cast<s64>(copies_size + header.data_size),
+                       Common::FS::SeekOrigin::CurrentPosition)) {
+            discard();
+            return;
+        }
+        entries.insert_or_assign(header.key, Entry{
+                                                 .offset = offset + sizeof(header),
+                                                 .data_size = header.data_size,
+                                                 .num_copies = header.num_copies,
+                                             });
+        offset += record_size;
+    }
+    LOG_INFO(HW_GPU, "Loaded {} ASTC transcodes", entries.size());
+}
+
+bool TranscodeCache::Find(u64 key, std::span<u8> output,
+                          boost::container::small_vector<BufferImageCopy, 16>& copies) {
+    std::scoped_lock lock{mutex};
+    const auto it{entries.find(key)};
+    if (it == entries.end()) {
+        return false;
+    }
+    const Entry& entry{it->second};
+    if (entry.data_size > output.size()) {
+        return false;
+    }
+    copies.resize(entry.num_copies);
+    if (!file.Seek(static_cast<s64>(entry.offset)) ||
+        file.ReadSpan(std::span{copies.data(), copies.size()}) != copies.size() ||
+        file.ReadSpan(output.first(entry.data_size)) != entry.data_size) {
+        LOG_ERROR(HW_GPU, "Failed to read ASTC transcode 0x{:016x}", key);
+        entries.erase(it);
+        return false;
+    }
+    return true;
+}
+
+void TranscodeCache::Add(u64 key, std::span<const u8> data,
+                         std::span<const BufferImageCopy> copies) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen() || entries.contains(key)) {
+        return;
+    }
+    const bool has_header{file_size != 0};
+    const u64 header_size{has_header ? 0 : sizeof(MAGIC_NUMBER) + sizeof(CACHE_VERSION)};
+    const u64 record_size{sizeof(RecordHeader) + copies.size_bytes() + data.size()};
+    if (file_size + header_size + record_size > max_file_size) {
+        return;
+    }
+    const RecordHeader header{
+        .key = key,
+        .data_size = data.size(),
+        .num_copies = static_cast<u32>(copies.size()),
+        .padding = 0,
+    };
+    // Reads may have moved the position, appends always write at the end
+    if (!file.Seek(0, Common::FS::SeekOrigin::End)) {
+        return;
+    }
+    bool succeeded{true};
+    if (!has_header) {
+        succeeded = file.WriteSpan(std::span<const char>{MAGIC_NUMBER}) == MAGIC_NUMBER.size() &&
+                    file.WriteObject(CACHE_VERSION);
+    }
+    succeeded = succeeded && file.WriteObject(header) &&
+                file.WriteSpan(copies) == copies.size() && file.WriteSpan(data) == data.size();
+    if (!succeeded) {
+        LOG_ERROR(HW_GPU, "Failed to write ASTC transcode, disabling the cache");
+        file.Close();
+        entries.clear();
+        return;
+    }
+    entries.insert_or_assign(key, Entry{
+                                      .offset = file_size + header_size + sizeof(header),
+                                      .data_size = data.size(),
+                                      .num_copies = header.num_copies,
+                                  });
+    file_size += header_size + record_size;
+}
+
+} // namespace VideoCommon
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+struct ImageInfo;
+
+/**
+ * Size capped on-disk cache of ASTC textures recompressed to BCn.
+ * Transcodes are keyed by the guest texels and the image layout, so they are shared between
+ * titles and sessions. Only the index lives in memory, transcodes are read back on demand.
+ */
+class TranscodeCache {
+public:
+    /// Returns the key of a transcode of the given guest texels
+    [[nodiscard]] static u64 MakeKey(std::span<const u8> guest_data, const ImageInfo& info);
+
+    /// Opens the cache file, discarding it when invalid
+    void Open(const std::filesystem::path& filename, u64 max_size);
+
+    /// Reads a transcode into output, returns false when it is not cached
+    [[nodiscard]] bool Find(u64 key, std::span<u8> output,
+                            boost::container::small_vector<BufferImageCopy, 16>& copies);
+
+    /// Appends a transcode to the cache, ignored when the cache is full
+    void Add(u64 key, std::span<const u8> data, std::span<const BufferImageCopy> copies);
+
+    [[nodiscard]] bool IsOpen() const noexcept {
+        return file.IsOpen();
+    }
+
+private:
+    struct Entry {
+        u64 offset;
+        u64 data_size;
+        u32 num_copies;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<u64, Entry> entries;
+    Common::FS::IOFile file;
+    u64 file_size{};
+    u64 max_file_size{};
+};
+
+} // namespace VideoCommon
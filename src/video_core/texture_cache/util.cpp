@@ -910,10 +910,10 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
     return copies;
 }
 
-void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+u32 ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
+                 std::span<BufferImageCopy> copies) {
     u32 output_offset = 0;
-    Common::ScratchBuffer<u8> decode_scratch;
+    Common::PooledScratchBuffer<u8> decode_scratch;
 
     const Extent2D tile_size = DefaultBlockSize(info.format);
     for (BufferImageCopy& copy : copies) {
@@ -980,6 +980,7 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
         copy.buffer_row_length = mip_size.width;
         copy.buffer_image_height = mip_size.height;
     }
+    return output_offset;
 }
 
 boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(const ImageInfo& info) {
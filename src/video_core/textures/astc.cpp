@@ -1655,39 +1655,44 @@ void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
     const u32 rows = Common::DivideUp(height, block_height);
     const u32 cols = Common::DivideUp(width, block_width);
+    if (rows == 0 || cols == 0) {
+        return;
+    }
 
-    Common::ThreadWorker& workers{GetThreadWorkers()};
+    // Rows of every slice are split in tasks of a similar number of blocks, so small mip levels
+    // are not dispatched one row at a time and slices do not wait for each other
+    static constexpr u32 MIN_BLOCKS_PER_TASK = 256;
+    const u32 rows_per_task = std::clamp(MIN_BLOCKS_PER_TASK / cols, 1U, rows);
+    const u32 tasks_per_slice = Common::DivideUp(rows, rows_per_task);
 
-    for (u32 z = 0; z < depth; ++z) {
+    ParallelFor(tasks_per_slice * depth, [&](u32 task) {
+        const u32 z = task / tasks_per_slice;
         const u32 depth_offset = z * height * width * 4;
-        for (u32 y_index = 0; y_index < rows; ++y_index) {
-            auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
-                                      cols, z, depth_offset, y_index] {
-                const u32 y = y_index * block_height;
-                for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
-                    const u32 x = x_index * block_width;
-
-                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
-                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                    u32 decompWidth = std::min(block_width, width - x);
-                    u32 decompHeight = std::min(block_height, height - y);
-
-                    const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                    for (u32 h = 0; h < decompHeight; ++h) {
-                        std::memcpy(outRow.data() + h * width * 4,
-                                    uncompData.data() + h * block_width, decompWidth * 4);
-                    }
+        const u32 first_row = (task % tasks_per_slice) * rows_per_task;
+        const u32 last_row = std::min(first_row + rows_per_task, rows);
+        for (u32 y_index = first_row; y_index < last_row; ++y_index) {
+            const u32 y = y_index * block_height;
+            for (u32 x_index = 0; x_index < cols; ++x_index) {
+                const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
+                const u32 x = x_index * block_width;
+
+                const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+                // Blocks can be at most 12x12
+                std::array<u32, 12 * 12> uncompData;
+                DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+                u32 decompWidth = std::min(block_width, width - x);
+                u32 decompHeight = std::min(block_height, height - y);
+
+                const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
+                for (u32 h = 0; h < decompHeight; ++h) {
+                    std::memcpy(outRow.data() + h * width * 4,
+                                uncompData.data() + h * block_width, decompWidth * 4);
                 }
-            };
-            workers.QueueWork(std::move(decompress_stride));
+            }
         }
-        workers.WaitForRequests();
-    }
+    });
 }
 
 } // namespace Tegra::Texture::ASTC
@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <span>
@@ -33,6 +35,76 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
+/// Returns the offset of a byte inside a GOB row
+constexpr u32 SwizzleGobX(u32 x) {
+    return (x & 0xf) | ((x & 0x10) << 1) | ((x & 0x20) << 3);
+}
+static_assert(SwizzleGobX(GOB_SIZE_X - 1) == pdep<SWIZZLE_X_BITS>(GOB_SIZE_X - 1));
+
+/**
+ * Copies the bytes [x_begin, x_end) of num_lines lines starting at y, all in the same row of GOBs.
+ * Aligned 16 byte chunks of a GOB line are contiguous in both layouts, so data is moved in whole
+ * chunks that compile to vector loads and stores. GOBs are walked in memory order.
+ */
+template <bool TO_LINEAR>
+void SwizzleGobRow(std::span<u8> output, std::span<const u8> input, u32 swizzled_base,
+                   u32 unswizzled_base, u32 pitch, u32 y, u32 num_lines, u32 x_begin, u32 x_end,
+                   u32 x_shift) {
+    static constexpr u32 CHUNK_SIZE = 16;
+    const auto copy = [&](u32 swizzled_offset, u32 unswizzled_offset, size_t size) {
+        u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
+        const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
+        std::memcpy(dst, src, size);
+    };
+    u32 x = x_begin;
+    while (x < x_end) {
+        const u32 gob_offset = swizzled_base + ((x >> GOB_SIZE_X_SHIFT) << x_shift);
+        const u32 gob_x = x & (GOB_SIZE_X - 1);
+        if (gob_x == 0 && x_end - x >= GOB_SIZE_X) {
+            for (u32 line = 0; line < num_lines; ++line) {
+                const u32 swizzled = gob_offset + pdep<SWIZZLE_Y_BITS>(y + line);
+                const u32 unswizzled = unswizzled_base + line * pitch + (x - x_begin);
+                copy(swizzled + SwizzleGobX(0x00), unswizzled + 0x00, CHUNK_SIZE);
+                copy(swizzled + SwizzleGobX(0x10), unswizzled + 0x10, CHUNK_SIZE);
+                copy(swizzled + SwizzleGobX(0x20), unswizzled + 0x20, CHUNK_SIZE);
+                copy(swizzled + SwizzleGobX(0x30), unswizzled + 0x30, CHUNK_SIZE);
+            }
+            x += GOB_SIZE_X;
+            continue;
+        }
+        const u32 chunk_end = std::min((x | (CHUNK_SIZE - 1)) + 1, x_end);
+        for (u32 line = 0; line < num_lines; ++line) {
+            const u32 swizzled = gob_offset + pdep<SWIZZLE_Y_BITS>(y + line) + SwizzleGobX(gob_x);
+            const u32 unswizzled = unswizzled_base + line * pitch + (x - x_begin);
+            copy(swizzled, unswizzled, chunk_end - x);
+        }
+        x = chunk_end;
+    }
+}
+
+/// Swizzles num_lines lines of a slice one row of GOBs at a time, pixels are a power of two bytes
+template <bool TO_LINEAR>
+void SwizzleGobRows(std::span<u8> output, std::span<const u8> input, u32 offset_z,
+                    u32 unswizzled_base, u32 pitch, u32 origin_y, u32 num_lines, u32 x_begin,
+                    u32 x_end, u32 block_height, u32 block_size, u32 x_shift) {
+    const u32 block_height_mask = (1U << block_height) - 1;
+    u32 line = 0;
+    while (line < num_lines) {
+        const u32 y = line + origin_y;
+        const u32 lines_in_gob =
+            std::min(num_lines - line, GOB_SIZE_Y - (y & (GOB_SIZE_Y - 1)));
+
+        const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+        const u32 offset_y = (block_y >> block_height) * block_size +
+                             ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+
+        SwizzleGobRow<TO_LINEAR>(output, input, offset_z + offset_y,
+                                 unswizzled_base + line * pitch, pitch, y, lines_in_gob, x_begin,
+                                 x_end, x_shift);
+        line += lines_in_gob;
+    }
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
                  u32 block_height, u32 block_depth, u32 stride) {
@@ -59,6 +131,13 @@ void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32
         const u32 z = slice + origin_z;
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
+        if constexpr (std::has_single_bit(BYTES_PER_PIXEL)) {
+            SwizzleGobRows<TO_LINEAR>(output, input, offset_z, slice * pitch * height, pitch,
+                                      origin_y, height, origin_x * BYTES_PER_PIXEL,
+                                      (origin_x + width) * BYTES_PER_PIXEL, block_height,
+                                      block_size, x_shift);
+            continue;
+        }
         for (u32 line = 0; line < height; ++line) {
             const u32 y = line + origin_y;
             const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
@@ -118,6 +197,17 @@ void SwizzleSubrectImpl(std::span<u8> output, std::span<const u8> input, u32 wid
         const u32 offset_z = (z >> block_depth) * slice_size +
                              ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
         const u32 lines_in_y = std::min(unprocessed_lines, extent_y);
+        if constexpr (std::has_single_bit(BYTES_PER_PIXEL)) {
+            SwizzleGobRows<TO_LINEAR>(output, input, offset_z, slice * pitch * height, pitch,
+                                      origin_y, lines_in_y, origin_x * BYTES_PER_PIXEL,
+                                      (origin_x + extent_x) * BYTES_PER_PIXEL, block_height,
+                                      block_size, x_shift);
+            unprocessed_lines -= lines_in_y;
+            if (unprocessed_lines == 0) {
+                return;
+            }
+            continue;
+        }
         for (u32 line = 0; line < lines_in_y; ++line) {
             const u32 y = line + origin_y;
             const u32 swizzled_y = pdep<SWIZZLE_Y_BITS>(y);
@@ -1,15 +1,35 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <atomic>
+
+#include "common/thread_pool.h"
 #include "video_core/textures/workers.h"
 
 namespace Tegra::Texture {
 
-Common::ThreadWorker& GetThreadWorkers() {
-    static Common::ThreadWorker workers{std::max(std::thread::hardware_concurrency(), 2U) / 2,
-                                        "ImageTranscode"};
+void ParallelFor(u32 count, const std::function<void(u32)>& func) {
+    if (count == 0) {
+        return;
+    }
+    std::atomic<u32> next_index{};
+    const auto run = [&] {
+        for (u32 index = next_index++; index < count; index = next_index++) {
+            func(index);
+        }
+    };
+    Common::ThreadPool& pool{Common::GetThreadPool()};
+    Common::TaskGroup helpers{Common::TaskPriority::Interactive, pool};
+    const size_t num_helpers = std::min<size_t>(count - 1, pool.NumWorkers());
+    for (size_t helper = 0; helper < num_helpers; ++helper) {
+        helpers.Run([&run] { run(); });
+    }
+    run();
 
-    return workers;
+    // Every index has been claimed, helpers that did not start have nothing left to do
+    helpers.Cancel();
+    helpers.Wait();
 }
 
 } // namespace Tegra::Texture
@@ -3,10 +3,17 @@
 
 #pragma once
 
-#include "common/thread_worker.h"
+#include <functional>
+
+#include "common/common_types.h"
 
 namespace Tegra::Texture {
 
-Common::ThreadWorker& GetThreadWorkers();
+/**
+ * Calls func(index) for every index in [0, count) on the shared thread pool, returning when all
+ * calls have finished. The calling thread takes part in the work, so concurrent and nested calls
+ * never wait on each other's work.
+ */
+void ParallelFor(u32 count, const std::function<void(u32)>& func);
 
-}
+} // namespace Tegra::Texture
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include "common/common_types.h"
+
+namespace Tegra {
+
+struct TranslationCacheStats {
+    u64 hits{};   ///< Lookups answered by the cache
+    u64 misses{}; ///< Lookups that had to walk the page table
+};
+
+/**
+ * Small direct-mapped cache of page translations. Entries are tagged with the owner of the page
+ * table and the generation of its mappings, bumping the generation on every map or unmap drops
+ * all the translations of that owner at once without touching the cache.
+ */
+class TranslationCache {
+public:
+    static constexpr size_t NUM_ENTRIES = 256;
+
+    [[nodiscard]] std::optional<u64> Find(size_t owner, u64 generation, u64 page) {
+        const Entry& entry = entries[page % NUM_ENTRIES];
+        if (entry.page == page && entry.owner == owner && entry.generation == generation) {
+            ++stats.hits;
+            return entry.value;
+        }
+        ++stats.misses;
+        return std::nullopt;
+    }
+
+    void Insert(size_t owner, u64 generation, u64 page, u64 value) {
+        entries[page % NUM_ENTRIES] = Entry{
+            .page = page,
+            .owner = owner,
+            .generation = generation,
+            .value = value,
+        };
+    }
+
+    [[nodiscard]] const TranslationCacheStats& Stats() const noexcept {
+        return stats;
+    }
+
+private:
+    struct Entry {
+        u64 page = ~0ULL;
+        size_t owner{};
+        u64 generation{};
+        u64 value{};
+    };
+
+    std::array<Entry, NUM_ENTRIES> entries{};
+    TranslationCacheStats stats{};
+};
+
+} // namespace Tegra
@@ -714,6 +714,7 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
                                VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
         dynamic_state3_blending = false;
         dynamic_state3_enables = false;
+        dynamic_state3_rasterization = false;
     }
 
     logical = vk::Device::Create(physical, queue_cis, ExtensionListForVulkan(loaded_extensions),
@@ -721,13 +722,20 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
 
     graphics_queue = logical.GetQueue(graphics_family);
     present_queue = logical.GetQueue(present_family);
+    if (has_async_compute_queue) {
+        compute_queue = logical.GetQueue(compute_family);
+    }
 
     VmaVulkanFunctions functions{};
     functions.vkGetInstanceProcAddr = dld.vkGetInstanceProcAddr;
     functions.vkGetDeviceProcAddr = dld.vkGetDeviceProcAddr;
 
+    VmaAllocatorCreateFlags allocator_flags = VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT;
+    if (extensions.descriptor_buffer) {
+        allocator_flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    }
     const VmaAllocatorCreateInfo allocator_info = {
-        .flags = VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT,
+        .flags = allocator_flags,
         .physicalDevice = physical,
         .device = *logical,
         .preferredLargeHeapBlockSize = 0,
@@ -1096,6 +1104,21 @@ bool Device::GetSuitability(bool requires_swapchain) {
             VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TRANSFORM_FEEDBACK_PROPERTIES_EXT;
         SetNext(next, properties.transform_feedback);
     }
+    if (extensions.external_memory_host) {
+        properties.external_memory_host.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT;
+        SetNext(next, properties.external_memory_host);
+    }
+    if (extensions.graphics_pipeline_library) {
+        properties.graphics_pipeline_library.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        SetNext(next, properties.graphics_pipeline_library);
+    }
+    if (extensions.descriptor_buffer) {
+        properties.descriptor_buffer.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+        SetNext(next, properties.descriptor_buffer);
+    }
 
     // Perform the property fetch.
     physical.GetProperties2(properties2);
@@ -1149,6 +1172,25 @@ void Device::RemoveUnsuitableExtensions() {
     RemoveExtensionFeatureIfUnsuitable(extensions.depth_clip_control, features.depth_clip_control,
                                        VK_EXT_DEPTH_CLIP_CONTROL_EXTENSION_NAME);
 
+    // VK_EXT_descriptor_buffer
+    // Descriptors of buffers are written from their device addresses
+    if (Settings::values.use_descriptor_buffer.GetValue()) {
+        extensions.descriptor_buffer = features.descriptor_buffer.descriptorBuffer &&
+                                       features.buffer_device_address.bufferDeviceAddress;
+        RemoveExtensionFeatureIfUnsuitable(extensions.descriptor_buffer, features.descriptor_buffer,
+                                           VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+    } else {
+        RemoveExtensionFeature(extensions.descriptor_buffer, features.descriptor_buffer,
+                               VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+    }
+    // Capture and replay is only useful to debugging tools and may slow down allocations
+    features.descriptor_buffer.descriptorBufferCaptureReplay = false;
+    features.buffer_device_address.bufferDeviceAddressCaptureReplay = false;
+    features.buffer_device_address.bufferDeviceAddressMultiDevice = false;
+    if (!extensions.descriptor_buffer) {
+        features.buffer_device_address.bufferDeviceAddress = false;
+    }
+
     // VK_EXT_extended_dynamic_state
     extensions.extended_dynamic_state = features.extended_dynamic_state.extendedDynamicState;
     RemoveExtensionFeatureIfUnsuitable(extensions.extended_dynamic_state,
@@ -1169,14 +1211,39 @@ void Device::RemoveUnsuitableExtensions() {
     dynamic_state3_enables =
         features.extended_dynamic_state3.extendedDynamicState3DepthClampEnable &&
         features.extended_dynamic_state3.extendedDynamicState3LogicOpEnable;
-
-    extensions.extended_dynamic_state3 = dynamic_state3_blending || dynamic_state3_enables;
+    dynamic_state3_rasterization =
+        features.extended_dynamic_state3.extendedDynamicState3PolygonMode &&
+        features.extended_dynamic_state3.extendedDynamicState3AlphaToCoverageEnable &&
+        features.extended_dynamic_state3.extendedDynamicState3AlphaToOneEnable &&
+        features.extended_dynamic_state3.extendedDynamicState3ConservativeRasterizationMode &&
+        features.extended_dynamic_state3.extendedDynamicState3LineRasterizationMode &&
+        features.extended_dynamic_state3.extendedDynamicState3ProvokingVertexMode;
+
+    extensions.extended_dynamic_state3 =
+        dynamic_state3_blending || dynamic_state3_enables || dynamic_state3_rasterization;
     dynamic_state3_blending = dynamic_state3_blending && extensions.extended_dynamic_state3;
     dynamic_state3_enables = dynamic_state3_enables && extensions.extended_dynamic_state3;
+    dynamic_state3_rasterization =
+        dynamic_state3_rasterization && extensions.extended_dynamic_state3;
     RemoveExtensionFeatureIfUnsuitable(extensions.extended_dynamic_state3,
                                        features.extended_dynamic_state3,
                                        VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
 
+    // VK_EXT_graphics_pipeline_library
+    // Only fast linking is useful to us, without it linking costs about as much as a full compile
+    extensions.graphics_pipeline_library =
+        extensions.pipeline_library &&
+        features.graphics_pipeline_library.graphicsPipelineLibrary &&
+        properties.graphics_pipeline_library.graphicsPipelineLibraryFastLinking;
+    RemoveExtensionFeatureIfUnsuitable(extensions.graphics_pipeline_library,
+                                       features.graphics_pipeline_library,
+                                       VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+    // VK_EXT_multi_draw
+    extensions.multi_draw = features.multi_draw.multiDraw;
+    RemoveExtensionFeatureIfUnsuitable(extensions.multi_draw, features.multi_draw,
+                                       VK_EXT_MULTI_DRAW_EXTENSION_NAME);
+
     // VK_EXT_provoking_vertex
     extensions.provoking_vertex =
         features.provoking_vertex.provokingVertexLast &&
@@ -1224,6 +1291,17 @@ void Device::RemoveUnsuitableExtensions() {
                                        features.vertex_input_dynamic_state,
                                        VK_EXT_VERTEX_INPUT_DYNAMIC_STATE_EXTENSION_NAME);
 
+    // VK_KHR_dynamic_rendering
+    if (Settings::values.use_dynamic_rendering.GetValue()) {
+        extensions.dynamic_rendering = features.dynamic_rendering.dynamicRendering;
+        RemoveExtensionFeatureIfUnsuitable(extensions.dynamic_rendering,
+                                           features.dynamic_rendering,
+                                           VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+    } else {
+        RemoveExtensionFeature(extensions.dynamic_rendering, features.dynamic_rendering,
+                               VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+    }
+
     // VK_KHR_pipeline_executable_properties
     if (Settings::values.renderer_shader_feedback.GetValue()) {
         extensions.pipeline_executable_properties =
@@ -1237,6 +1315,22 @@ void Device::RemoveUnsuitableExtensions() {
                                VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME);
     }
 
+    // VK_KHR_present_id and VK_KHR_present_wait
+    // Presents are only waited on by the low latency presentation mode
+    if (Settings::values.low_latency_presentation.GetValue() && extensions.swapchain) {
+        extensions.present_id = features.present_id.presentId;
+        RemoveExtensionFeatureIfUnsuitable(extensions.present_id, features.present_id,
+                                           VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        extensions.present_wait = extensions.present_id && features.present_wait.presentWait;
+        RemoveExtensionFeatureIfUnsuitable(extensions.present_wait, features.present_wait,
+                                           VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    } else {
+        RemoveExtensionFeature(extensions.present_id, features.present_id,
+                               VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        RemoveExtensionFeature(extensions.present_wait, features.present_wait,
+                               VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    }
+
     // VK_KHR_workgroup_memory_explicit_layout
     extensions.workgroup_memory_explicit_layout =
         features.features.shaderInt16 &&
@@ -1282,6 +1376,21 @@ void Device::SetupFamilies(VkSurfaceKHR surface) {
     if (present) {
         present_family = *present;
     }
+
+    // Work on the async compute queue is synchronized with graphics through timeline semaphores
+    if (!Settings::values.use_async_compute_queue.GetValue() || !HasTimelineSemaphore()) {
+        return;
+    }
+    for (u32 index = 0; index < static_cast<u32>(queue_family_properties.size()); ++index) {
+        const VkQueueFamilyProperties& queue_family = queue_family_properties[index];
+        if (queue_family.queueCount != 0 && (queue_family.queueFlags & VK_QUEUE_COMPUTE_BIT) &&
+            !(queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+            compute_family = index;
+            has_async_compute_queue = true;
+            LOG_INFO(Render_Vulkan, "Using async compute queue family {}", index);
+            break;
+        }
+    }
 }
 
 u64 Device::GetDeviceMemoryUsage() const {
@@ -1296,6 +1405,18 @@ u64 Device::GetDeviceMemoryUsage() const {
     return result;
 }
 
+u64 Device::GetDeviceMemoryBudget() const {
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget;
+    budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    budget.pNext = nullptr;
+    physical.GetMemoryProperties(&budget);
+    u64 result{};
+    for (const size_t heap : valid_heap_memory) {
+        result += budget.heapBudget[heap];
+    }
+    return result;
+}
+
 void Device::CollectPhysicalMemoryInfo() {
     // Calculate limits using memory budget
     VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
@@ -1360,6 +1481,9 @@ std::vector<VkDeviceQueueCreateInfo> Device::GetDeviceQueueCreateInfos() const {
     static constexpr float QUEUE_PRIORITY = 1.0f;
 
     std::unordered_set<u32> unique_queue_families{graphics_family, present_family};
+    if (has_async_compute_queue) {
+        unique_queue_families.insert(compute_family);
+    }
     std::vector<VkDeviceQueueCreateInfo> queue_cis;
     queue_cis.reserve(unique_queue_families.size());
 
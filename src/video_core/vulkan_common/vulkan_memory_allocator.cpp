@@ -19,6 +19,9 @@
 
 namespace Vulkan {
 namespace {
+// Number of frames between memory statistics reports
+constexpr u32 STATS_REPORT_FRAMES = 300;
+
 struct Range {
     u64 begin;
     u64 end;
@@ -88,6 +91,14 @@ struct Range {
     return VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 }
 
+[[nodiscard]] MemoryCategory BufferCategory(MemoryUsage usage) {
+    return usage == MemoryUsage::DeviceLocal ? MemoryCategory::Buffers : MemoryCategory::Staging;
+}
+
+[[nodiscard]] constexpr u64 ToMiB(u64 bytes) {
+    return bytes >> 20;
+}
+
 } // Anonymous namespace
 
 class MemoryAllocation {
@@ -231,6 +242,7 @@ MemoryAllocator::MemoryAllocator(const Device& device_)
 MemoryAllocator::~MemoryAllocator() = default;
 
 vk::Image MemoryAllocator::CreateImage(const VkImageCreateInfo& ci) const {
+    std::atomic<u64>& bytes = category_bytes[static_cast<size_t>(MemoryCategory::Images)];
     const VmaAllocationCreateInfo alloc_ci = {
         .flags = VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT,
         .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
@@ -238,20 +250,31 @@ vk::Image MemoryAllocator::CreateImage(const VkImageCreateInfo& ci) const {
         .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
         .memoryTypeBits = 0,
         .pool = VK_NULL_HANDLE,
-        .pUserData = nullptr,
+        .pUserData = &bytes,
         .priority = 0.f,
     };
 
     VkImage handle{};
+    VmaAllocationInfo alloc_info{};
     VmaAllocation allocation{};
 
-    vk::Check(vmaCreateImage(allocator, &ci, &alloc_ci, &handle, &allocation, nullptr));
+    vk::Check(vmaCreateImage(allocator, &ci, &alloc_ci, &handle, &allocation, &alloc_info));
+    bytes.fetch_add(alloc_info.size, std::memory_order_relaxed);
 
     return vk::Image(handle, *device.GetLogical(), allocator, allocation,
                      device.GetDispatchLoader());
 }
 
 vk::Buffer MemoryAllocator::CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsage usage) const {
+    static constexpr VkBufferUsageFlags descriptor_usage =
+        VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT |
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    VkBufferCreateInfo buffer_ci{ci};
+    if (device.IsExtDescriptorBufferSupported() && (ci.usage & descriptor_usage) != 0) {
+        // Descriptor buffers reference buffers through their device address
+        buffer_ci.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+    std::atomic<u64>& bytes = category_bytes[static_cast<size_t>(BufferCategory(usage))];
     const VmaAllocationCreateInfo alloc_ci = {
         .flags = VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT | MemoryUsageVmaFlags(usage),
         .usage = MemoryUsageVma(usage),
@@ -259,7 +282,7 @@ vk::Buffer MemoryAllocator::CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsa
         .preferredFlags = MemoryUsagePreferredVmaFlags(usage),
         .memoryTypeBits = usage == MemoryUsage::Stream ? 0u : valid_memory_types,
         .pool = VK_NULL_HANDLE,
-        .pUserData = nullptr,
+        .pUserData = &bytes,
         .priority = 0.f,
     };
 
@@ -268,8 +291,10 @@ vk::Buffer MemoryAllocator::CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsa
     VmaAllocation allocation{};
     VkMemoryPropertyFlags property_flags{};
 
-    vk::Check(vmaCreateBuffer(allocator, &ci, &alloc_ci, &handle, &allocation, &alloc_info));
+    vk::Check(
+        vmaCreateBuffer(allocator, &buffer_ci, &alloc_ci, &handle, &allocation, &alloc_info));
     vmaGetAllocationMemoryProperties(allocator, allocation, &property_flags);
+    bytes.fetch_add(alloc_info.size, std::memory_order_relaxed);
 
     u8* data = reinterpret_cast<u8*>(alloc_info.pMappedData);
     const std::span<u8> mapped_data = data ? std::span<u8>{data, ci.size} : std::span<u8>{};
@@ -279,6 +304,43 @@ vk::Buffer MemoryAllocator::CreateBuffer(const VkBufferCreateInfo& ci, MemoryUsa
                       device.GetDispatchLoader());
 }
 
+MemoryStatistics MemoryAllocator::GetStatistics() const {
+    MemoryStatistics stats{};
+    for (size_t index = 0; index < stats.category_bytes.size(); ++index) {
+        stats.category_bytes[index] = category_bytes[index].load(std::memory_order_relaxed);
+    }
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(allocator, budgets.data());
+    for (u32 heap = 0; heap < properties.memoryHeapCount; ++heap) {
+        const VmaBudget& budget = budgets[heap];
+        stats.block_bytes += budget.statistics.blockBytes;
+        stats.allocation_bytes += budget.statistics.allocationBytes;
+        if ((properties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+            stats.device_local_usage += budget.usage;
+            stats.device_local_budget += budget.budget;
+        }
+    }
+    return stats;
+}
+
+void MemoryAllocator::TickFrame() {
+    if (++frame_count < STATS_REPORT_FRAMES) {
+        return;
+    }
+    frame_count = 0;
+    const MemoryStatistics stats = GetStatistics();
+    const auto category = [&stats](MemoryCategory type) {
+        return ToMiB(stats.category_bytes[static_cast<size_t>(type)]);
+    };
+    LOG_DEBUG(Render_Vulkan,
+              "Memory: images {} MiB, buffers {} MiB, staging {} MiB, device local {}/{} MiB, "
+              "{} MiB of {} MiB in VMA blocks unused",
+              category(MemoryCategory::Images), category(MemoryCategory::Buffers),
+              category(MemoryCategory::Staging), ToMiB(stats.device_local_usage),
+              ToMiB(stats.device_local_budget), ToMiB(stats.block_bytes - stats.allocation_bytes),
+              ToMiB(stats.block_bytes));
+}
+
 MemoryCommit MemoryAllocator::Commit(const VkMemoryRequirements& requirements, MemoryUsage usage) {
     // Find the fastest memory flags we can afford with the current requirements
     const u32 type_mask = requirements.memoryTypeBits;
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <span>
 #include <vector>
@@ -27,6 +29,24 @@ enum class MemoryUsage {
     Stream,      ///< Requests device local host visible buffer, falling back host memory.
 };
 
+/// Categories of the memory tracked by allocator statistics
+enum class MemoryCategory : u32 {
+    Images,  ///< Images
+    Buffers, ///< Device local buffers
+    Staging, ///< Upload, download and stream buffers
+    Count,
+};
+
+/// Snapshot of the memory used by an allocator
+struct MemoryStatistics {
+    /// Bytes in use by each category of allocations
+    std::array<u64, static_cast<size_t>(MemoryCategory::Count)> category_bytes{};
+    u64 block_bytes{};         ///< Bytes of device memory blocks allocated by VMA
+    u64 allocation_bytes{};    ///< Bytes of the VMA blocks used by allocations
+    u64 device_local_usage{};  ///< Device local memory used by the process
+    u64 device_local_budget{}; ///< Device local memory available to the process
+};
+
 template <typename F>
 void ForEachDeviceLocalHostVisibleHeap(const Device& device, F&& f) {
     auto memory_props = device.GetPhysical().GetMemoryProperties().memoryProperties;
@@ -114,6 +134,13 @@ public:
     /// Commits memory required by the buffer and binds it.
     MemoryCommit Commit(const vk::Buffer& buffer, MemoryUsage usage);
 
+    /// Returns the memory in use by images and buffers created by the allocator, and the usage of
+    /// the device memory blocks backing them.
+    [[nodiscard]] MemoryStatistics GetStatistics() const;
+
+    /// Reports memory statistics periodically.
+    void TickFrame();
+
 private:
     /// Tries to allocate a chunk of memory.
     bool TryAllocMemory(VkMemoryPropertyFlags flags, u32 type_mask, u64 size);
@@ -138,6 +165,11 @@ private:
     VkDeviceSize buffer_image_granularity; // The granularity for adjacent offsets between buffers
                                            // and optimal images
     u32 valid_memory_types{~0u};
+
+    /// Live bytes of each category, referenced by the user data of VMA allocations
+    mutable std::array<std::atomic<u64>, static_cast<size_t>(MemoryCategory::Count)>
+        category_bytes{};
+    u32 frame_count{};
 };
 
 } // namespace Vulkan
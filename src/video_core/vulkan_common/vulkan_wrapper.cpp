@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -89,8 +90,10 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdBeginConditionalRenderingEXT);
     X(vkCmdBeginQuery);
     X(vkCmdBeginRenderPass);
+    X(vkCmdBeginRendering);
     X(vkCmdBeginTransformFeedbackEXT);
     X(vkCmdBeginDebugUtilsLabelEXT);
+    X(vkCmdBindDescriptorBuffersEXT);
     X(vkCmdBindDescriptorSets);
     X(vkCmdBindIndexBuffer);
     X(vkCmdBindPipeline);
@@ -113,11 +116,15 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdDrawIndirectCount);
     X(vkCmdDrawIndexedIndirectCount);
     X(vkCmdDrawIndirectByteCountEXT);
+    X(vkCmdDrawMultiEXT);
+    X(vkCmdDrawMultiIndexedEXT);
     X(vkCmdEndConditionalRenderingEXT);
     X(vkCmdEndQuery);
     X(vkCmdEndRenderPass);
+    X(vkCmdEndRendering);
     X(vkCmdEndTransformFeedbackEXT);
     X(vkCmdEndDebugUtilsLabelEXT);
+    X(vkCmdExecuteCommands);
     X(vkCmdFillBuffer);
     X(vkCmdPipelineBarrier);
     X(vkCmdPushConstants);
@@ -126,6 +133,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdSetDepthBias);
     X(vkCmdSetDepthBias2EXT);
     X(vkCmdSetDepthBounds);
+    X(vkCmdSetDescriptorBufferOffsetsEXT);
     X(vkCmdSetEvent);
     X(vkCmdSetScissor);
     X(vkCmdSetStencilCompareMask);
@@ -133,6 +141,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdSetStencilWriteMask);
     X(vkCmdSetViewport);
     X(vkCmdWaitEvents);
+    X(vkCmdWriteTimestamp);
     X(vkCmdBindVertexBuffers2EXT);
     X(vkCmdSetCullModeEXT);
     X(vkCmdSetDepthBoundsTestEnableEXT);
@@ -144,6 +153,12 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdSetDepthBiasEnableEXT);
     X(vkCmdSetLogicOpEnableEXT);
     X(vkCmdSetDepthClampEnableEXT);
+    X(vkCmdSetPolygonModeEXT);
+    X(vkCmdSetAlphaToCoverageEnableEXT);
+    X(vkCmdSetAlphaToOneEnableEXT);
+    X(vkCmdSetConservativeRasterizationModeEXT);
+    X(vkCmdSetLineRasterizationModeEXT);
+    X(vkCmdSetProvokingVertexModeEXT);
     X(vkCmdSetFrontFaceEXT);
     X(vkCmdSetLogicOpEXT);
     X(vkCmdSetPatchControlPointsEXT);
@@ -202,13 +217,19 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkFreeCommandBuffers);
     X(vkFreeDescriptorSets);
     X(vkFreeMemory);
+    X(vkGetBufferDeviceAddress);
     X(vkGetBufferMemoryRequirements2);
+    X(vkGetDescriptorEXT);
+    X(vkGetDescriptorSetLayoutBindingOffsetEXT);
+    X(vkGetDescriptorSetLayoutSizeEXT);
     X(vkGetDeviceQueue);
     X(vkGetEventStatus);
     X(vkGetFenceStatus);
     X(vkGetImageMemoryRequirements);
     X(vkGetPipelineCacheData);
     X(vkGetMemoryFdKHR);
+    X(vkGetMemoryFdPropertiesKHR);
+    X(vkGetMemoryHostPointerPropertiesEXT);
 #ifdef _WIN32
     X(vkGetMemoryWin32HandleKHR);
 #endif
@@ -216,6 +237,8 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkGetPipelineExecutablePropertiesKHR);
     X(vkGetPipelineExecutableStatisticsKHR);
     X(vkGetSemaphoreCounterValue);
+    X(vkGetSemaphoreFdKHR);
+    X(vkImportSemaphoreFdKHR);
     X(vkMapMemory);
     X(vkQueueSubmit);
     X(vkResetFences);
@@ -226,6 +249,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkUpdateDescriptorSetWithTemplate);
     X(vkUpdateDescriptorSets);
     X(vkWaitForFences);
+    X(vkWaitForPresentKHR);
     X(vkWaitSemaphores);
 
     // Support for timeline semaphores is mandatory in Vulkan 1.2
@@ -239,6 +263,17 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
         Proc(dld.vkResetQueryPool, dld, "vkResetQueryPoolEXT", device);
     }
 
+    // Support for dynamic rendering is mandatory in Vulkan 1.3
+    if (!dld.vkCmdBeginRendering) {
+        Proc(dld.vkCmdBeginRendering, dld, "vkCmdBeginRenderingKHR", device);
+        Proc(dld.vkCmdEndRendering, dld, "vkCmdEndRenderingKHR", device);
+    }
+
+    // Support for buffer device address is optional in Vulkan 1.2
+    if (!dld.vkGetBufferDeviceAddress) {
+        Proc(dld.vkGetBufferDeviceAddress, dld, "vkGetBufferDeviceAddressKHR", device);
+    }
+
     // Support for draw indirect with count is optional in Vulkan 1.2
     if (!dld.vkCmdDrawIndirectCount) {
         Proc(dld.vkCmdDrawIndirectCount, dld, "vkCmdDrawIndirectCountKHR", device);
@@ -262,6 +297,16 @@ void SetObjectName(const DeviceDispatch* dld, VkDevice device, T handle, VkObjec
     }
 }
 
+/// Subtracts the size of an allocation from the byte counter in its user data, when it has one
+void ReleaseAllocationBytes(VmaAllocator allocator, VmaAllocation allocation) {
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(allocator, allocation, &info);
+    if (info.pUserData != nullptr) {
+        static_cast<std::atomic<u64>*>(info.pUserData)
+            ->fetch_sub(info.size, std::memory_order_relaxed);
+    }
+}
+
 } // Anonymous namespace
 
 bool Load(InstanceDispatch& dld) noexcept {
@@ -486,6 +531,7 @@ void Image::SetObjectNameEXT(const char* name) const {
 
 void Image::Release() const noexcept {
     if (handle) {
+        ReleaseAllocationBytes(allocator, allocation);
         vmaDestroyImage(allocator, handle, allocation);
     }
 }
@@ -508,10 +554,19 @@ void Buffer::SetObjectNameEXT(const char* name) const {
 
 void Buffer::Release() const noexcept {
     if (handle) {
+        ReleaseAllocationBytes(allocator, allocation);
         vmaDestroyBuffer(allocator, handle, allocation);
     }
 }
 
+void ExternalBuffer::BindMemory(VkDeviceMemory memory, VkDeviceSize offset) const {
+    Check(dld->vkBindBufferMemory(owner, handle, memory, offset));
+}
+
+void ExternalBuffer::SetObjectNameEXT(const char* name) const {
+    SetObjectName(dld, owner, handle, VK_OBJECT_TYPE_BUFFER, name);
+}
+
 void BufferView::SetObjectNameEXT(const char* name) const {
     SetObjectName(dld, owner, handle, VK_OBJECT_TYPE_BUFFER_VIEW, name);
 }
@@ -520,12 +575,12 @@ void ImageView::SetObjectNameEXT(const char* name) const {
     SetObjectName(dld, owner, handle, VK_OBJECT_TYPE_IMAGE_VIEW, name);
 }
 
-int DeviceMemory::GetMemoryFdKHR() const {
+int DeviceMemory::GetMemoryFdKHR(VkExternalMemoryHandleTypeFlagBits handle_type) const {
     const VkMemoryGetFdInfoKHR get_fd_info{
         .sType = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR,
         .pNext = nullptr,
         .memory = handle,
-        .handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR,
+        .handleType = handle_type,
     };
     int fd;
     Check(dld->vkGetMemoryFdKHR(owner, &get_fd_info, &fd));
@@ -623,6 +678,31 @@ void Semaphore::SetObjectNameEXT(const char* name) const {
     SetObjectName(dld, owner, handle, VK_OBJECT_TYPE_SEMAPHORE, name);
 }
 
+int Semaphore::GetFdKHR(VkExternalSemaphoreHandleTypeFlagBits handle_type) const {
+    const VkSemaphoreGetFdInfoKHR get_fd_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR,
+        .pNext = nullptr,
+        .semaphore = handle,
+        .handleType = handle_type,
+    };
+    int fd;
+    Check(dld->vkGetSemaphoreFdKHR(owner, &get_fd_info, &fd));
+    return fd;
+}
+
+void Semaphore::ImportFdKHR(VkExternalSemaphoreHandleTypeFlagBits handle_type,
+                            VkSemaphoreImportFlags flags, int fd) const {
+    const VkImportSemaphoreFdInfoKHR import_info{
+        .sType = VK_STRUCTURE_TYPE_IMPORT_SEMAPHORE_FD_INFO_KHR,
+        .pNext = nullptr,
+        .semaphore = handle,
+        .flags = flags,
+        .handleType = handle_type,
+        .fd = fd,
+    };
+    Check(dld->vkImportSemaphoreFdKHR(owner, &import_info));
+}
+
 Device Device::Create(VkPhysicalDevice physical_device, Span<VkDeviceQueueCreateInfo> queues_ci,
                       Span<const char*> enabled_extensions, const void* next,
                       DeviceDispatch& dispatch) {
@@ -650,6 +730,12 @@ Queue Device::GetQueue(u32 family_index) const noexcept {
     return Queue(queue, *dld);
 }
 
+ExternalBuffer Device::CreateExternalBuffer(const VkBufferCreateInfo& ci) const {
+    VkBuffer object;
+    Check(dld->vkCreateBuffer(handle, &ci, nullptr, &object));
+    return ExternalBuffer(object, handle, *dld);
+}
+
 BufferView Device::CreateBufferView(const VkBufferViewCreateInfo& ci) const {
     VkBufferView object;
     Check(dld->vkCreateBufferView(handle, &ci, nullptr, &object));
@@ -819,6 +905,22 @@ VkMemoryRequirements Device::GetImageMemoryRequirements(VkImage image) const noe
     return requirements;
 }
 
+VkResult Device::GetMemoryHostPointerPropertiesEXT(
+    VkExternalMemoryHandleTypeFlagBits handle_type, const void* host_pointer,
+    VkMemoryHostPointerPropertiesEXT& properties) const noexcept {
+    properties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    properties.pNext = nullptr;
+    return dld->vkGetMemoryHostPointerPropertiesEXT(handle, handle_type, host_pointer,
+                                                    &properties);
+}
+
+VkResult Device::GetMemoryFdPropertiesKHR(VkExternalMemoryHandleTypeFlagBits handle_type, int fd,
+                                          VkMemoryFdPropertiesKHR& properties) const noexcept {
+    properties.sType = VK_STRUCTURE_TYPE_MEMORY_FD_PROPERTIES_KHR;
+    properties.pNext = nullptr;
+    return dld->vkGetMemoryFdPropertiesKHR(handle, handle_type, fd, &properties);
+}
+
 std::vector<VkPipelineExecutablePropertiesKHR> Device::GetPipelineExecutablePropertiesKHR(
     VkPipeline pipeline) const {
     const VkPipelineInfoKHR info{
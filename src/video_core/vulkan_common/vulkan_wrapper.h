@@ -189,7 +189,9 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkCmdBeginDebugUtilsLabelEXT vkCmdBeginDebugUtilsLabelEXT{};
     PFN_vkCmdBeginQuery vkCmdBeginQuery{};
     PFN_vkCmdBeginRenderPass vkCmdBeginRenderPass{};
+    PFN_vkCmdBeginRendering vkCmdBeginRendering{};
     PFN_vkCmdBeginTransformFeedbackEXT vkCmdBeginTransformFeedbackEXT{};
+    PFN_vkCmdBindDescriptorBuffersEXT vkCmdBindDescriptorBuffersEXT{};
     PFN_vkCmdBindDescriptorSets vkCmdBindDescriptorSets{};
     PFN_vkCmdBindIndexBuffer vkCmdBindIndexBuffer{};
     PFN_vkCmdBindPipeline vkCmdBindPipeline{};
@@ -213,11 +215,15 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkCmdDrawIndirectCount vkCmdDrawIndirectCount{};
     PFN_vkCmdDrawIndexedIndirectCount vkCmdDrawIndexedIndirectCount{};
     PFN_vkCmdDrawIndirectByteCountEXT vkCmdDrawIndirectByteCountEXT{};
+    PFN_vkCmdDrawMultiEXT vkCmdDrawMultiEXT{};
+    PFN_vkCmdDrawMultiIndexedEXT vkCmdDrawMultiIndexedEXT{};
     PFN_vkCmdEndConditionalRenderingEXT vkCmdEndConditionalRenderingEXT{};
     PFN_vkCmdEndDebugUtilsLabelEXT vkCmdEndDebugUtilsLabelEXT{};
     PFN_vkCmdEndQuery vkCmdEndQuery{};
     PFN_vkCmdEndRenderPass vkCmdEndRenderPass{};
+    PFN_vkCmdEndRendering vkCmdEndRendering{};
     PFN_vkCmdEndTransformFeedbackEXT vkCmdEndTransformFeedbackEXT{};
+    PFN_vkCmdExecuteCommands vkCmdExecuteCommands{};
     PFN_vkCmdFillBuffer vkCmdFillBuffer{};
     PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier{};
     PFN_vkCmdPushConstants vkCmdPushConstants{};
@@ -237,6 +243,13 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkCmdSetDepthBiasEnableEXT vkCmdSetDepthBiasEnableEXT{};
     PFN_vkCmdSetLogicOpEnableEXT vkCmdSetLogicOpEnableEXT{};
     PFN_vkCmdSetDepthClampEnableEXT vkCmdSetDepthClampEnableEXT{};
+    PFN_vkCmdSetPolygonModeEXT vkCmdSetPolygonModeEXT{};
+    PFN_vkCmdSetAlphaToCoverageEnableEXT vkCmdSetAlphaToCoverageEnableEXT{};
+    PFN_vkCmdSetAlphaToOneEnableEXT vkCmdSetAlphaToOneEnableEXT{};
+    PFN_vkCmdSetConservativeRasterizationModeEXT vkCmdSetConservativeRasterizationModeEXT{};
+    PFN_vkCmdSetLineRasterizationModeEXT vkCmdSetLineRasterizationModeEXT{};
+    PFN_vkCmdSetProvokingVertexModeEXT vkCmdSetProvokingVertexModeEXT{};
+    PFN_vkCmdSetDescriptorBufferOffsetsEXT vkCmdSetDescriptorBufferOffsetsEXT{};
     PFN_vkCmdSetEvent vkCmdSetEvent{};
     PFN_vkCmdSetFrontFaceEXT vkCmdSetFrontFaceEXT{};
     PFN_vkCmdSetPatchControlPointsEXT vkCmdSetPatchControlPointsEXT{};
@@ -255,6 +268,7 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkCmdSetColorBlendEnableEXT vkCmdSetColorBlendEnableEXT{};
     PFN_vkCmdSetColorBlendEquationEXT vkCmdSetColorBlendEquationEXT{};
     PFN_vkCmdWaitEvents vkCmdWaitEvents{};
+    PFN_vkCmdWriteTimestamp vkCmdWriteTimestamp{};
     PFN_vkCreateBuffer vkCreateBuffer{};
     PFN_vkCreateBufferView vkCreateBufferView{};
     PFN_vkCreateCommandPool vkCreateCommandPool{};
@@ -301,13 +315,19 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkFreeCommandBuffers vkFreeCommandBuffers{};
     PFN_vkFreeDescriptorSets vkFreeDescriptorSets{};
     PFN_vkFreeMemory vkFreeMemory{};
+    PFN_vkGetBufferDeviceAddress vkGetBufferDeviceAddress{};
     PFN_vkGetBufferMemoryRequirements2 vkGetBufferMemoryRequirements2{};
+    PFN_vkGetDescriptorEXT vkGetDescriptorEXT{};
+    PFN_vkGetDescriptorSetLayoutBindingOffsetEXT vkGetDescriptorSetLayoutBindingOffsetEXT{};
+    PFN_vkGetDescriptorSetLayoutSizeEXT vkGetDescriptorSetLayoutSizeEXT{};
     PFN_vkGetDeviceQueue vkGetDeviceQueue{};
     PFN_vkGetEventStatus vkGetEventStatus{};
     PFN_vkGetFenceStatus vkGetFenceStatus{};
     PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements{};
     PFN_vkGetPipelineCacheData vkGetPipelineCacheData{};
     PFN_vkGetMemoryFdKHR vkGetMemoryFdKHR{};
+    PFN_vkGetMemoryFdPropertiesKHR vkGetMemoryFdPropertiesKHR{};
+    PFN_vkGetMemoryHostPointerPropertiesEXT vkGetMemoryHostPointerPropertiesEXT{};
 #ifdef _WIN32
     PFN_vkGetMemoryWin32HandleKHR vkGetMemoryWin32HandleKHR{};
 #endif
@@ -315,6 +335,8 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkGetPipelineExecutableStatisticsKHR vkGetPipelineExecutableStatisticsKHR{};
     PFN_vkGetQueryPoolResults vkGetQueryPoolResults{};
     PFN_vkGetSemaphoreCounterValue vkGetSemaphoreCounterValue{};
+    PFN_vkGetSemaphoreFdKHR vkGetSemaphoreFdKHR{};
+    PFN_vkImportSemaphoreFdKHR vkImportSemaphoreFdKHR{};
     PFN_vkMapMemory vkMapMemory{};
     PFN_vkQueueSubmit vkQueueSubmit{};
     PFN_vkResetFences vkResetFences{};
@@ -325,6 +347,7 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkUpdateDescriptorSetWithTemplate vkUpdateDescriptorSetWithTemplate{};
     PFN_vkUpdateDescriptorSets vkUpdateDescriptorSets{};
     PFN_vkWaitForFences vkWaitForFences{};
+    PFN_vkWaitForPresentKHR vkWaitForPresentKHR{};
     PFN_vkWaitSemaphores vkWaitSemaphores{};
 };
 
@@ -776,6 +799,18 @@ private:
     const DeviceDispatch* dld = nullptr;
 };
 
+/// Buffer bound to memory owned by the caller instead of the memory allocator.
+class ExternalBuffer : public Handle<VkBuffer, VkDevice, DeviceDispatch> {
+    using Handle<VkBuffer, VkDevice, DeviceDispatch>::Handle;
+
+public:
+    /// Attaches memory to the buffer.
+    void BindMemory(VkDeviceMemory memory, VkDeviceSize offset) const;
+
+    /// Set object name.
+    void SetObjectNameEXT(const char* name) const;
+};
+
 class BufferView : public Handle<VkBufferView, VkDevice, DeviceDispatch> {
     using Handle<VkBufferView, VkDevice, DeviceDispatch>::Handle;
 
@@ -796,7 +831,8 @@ class DeviceMemory : public Handle<VkDeviceMemory, VkDevice, DeviceDispatch> {
     using Handle<VkDeviceMemory, VkDevice, DeviceDispatch>::Handle;
 
 public:
-    int GetMemoryFdKHR() const;
+    int GetMemoryFdKHR(VkExternalMemoryHandleTypeFlagBits handle_type =
+                           VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR) const;
 
 #ifdef _WIN32
     HANDLE GetMemoryWin32HandleKHR() const;
@@ -911,6 +947,13 @@ public:
     /// Set object name.
     void SetObjectNameEXT(const char* name) const;
 
+    /// Exports the semaphore payload, ownership of the file descriptor goes to the caller.
+    int GetFdKHR(VkExternalSemaphoreHandleTypeFlagBits handle_type) const;
+
+    /// Imports a payload into the semaphore, ownership of the file descriptor goes to Vulkan.
+    void ImportFdKHR(VkExternalSemaphoreHandleTypeFlagBits handle_type,
+                     VkSemaphoreImportFlags flags, int fd) const;
+
     [[nodiscard]] u64 GetCounter() const {
         u64 value;
         Check(dld->vkGetSemaphoreCounterValue(owner, handle, &value));
@@ -955,6 +998,8 @@ public:
 
     Queue GetQueue(u32 family_index) const noexcept;
 
+    ExternalBuffer CreateExternalBuffer(const VkBufferCreateInfo& ci) const;
+
     BufferView CreateBufferView(const VkBufferViewCreateInfo& ci) const;
 
     ImageView CreateImageView(const VkImageViewCreateInfo& ci) const;
@@ -1007,6 +1052,13 @@ public:
 
     VkMemoryRequirements GetImageMemoryRequirements(VkImage image) const noexcept;
 
+    VkResult GetMemoryHostPointerPropertiesEXT(
+        VkExternalMemoryHandleTypeFlagBits handle_type, const void* host_pointer,
+        VkMemoryHostPointerPropertiesEXT& properties) const noexcept;
+
+    VkResult GetMemoryFdPropertiesKHR(VkExternalMemoryHandleTypeFlagBits handle_type, int fd,
+                                      VkMemoryFdPropertiesKHR& properties) const noexcept;
+
     std::vector<VkPipelineExecutablePropertiesKHR> GetPipelineExecutablePropertiesKHR(
         VkPipeline pipeline) const;
 
@@ -1021,12 +1073,44 @@ public:
         dld->vkUpdateDescriptorSetWithTemplate(handle, set, update_template, data);
     }
 
+    VkDeviceAddress GetBufferDeviceAddress(VkBuffer buffer) const noexcept {
+        const VkBufferDeviceAddressInfo info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .pNext = nullptr,
+            .buffer = buffer,
+        };
+        return dld->vkGetBufferDeviceAddress(handle, &info);
+    }
+
+    VkDeviceSize GetDescriptorSetLayoutSizeEXT(VkDescriptorSetLayout layout) const noexcept {
+        VkDeviceSize size;
+        dld->vkGetDescriptorSetLayoutSizeEXT(handle, layout, &size);
+        return size;
+    }
+
+    VkDeviceSize GetDescriptorSetLayoutBindingOffsetEXT(VkDescriptorSetLayout layout,
+                                                       u32 binding) const noexcept {
+        VkDeviceSize offset;
+        dld->vkGetDescriptorSetLayoutBindingOffsetEXT(handle, layout, binding, &offset);
+        return offset;
+    }
+
+    void GetDescriptorEXT(const VkDescriptorGetInfoEXT& info, size_t size,
+                          void* descriptor) const noexcept {
+        dld->vkGetDescriptorEXT(handle, &info, size, descriptor);
+    }
+
     VkResult AcquireNextImageKHR(VkSwapchainKHR swapchain, u64 timeout, VkSemaphore semaphore,
                                  VkFence fence, u32* image_index) const noexcept {
         return dld->vkAcquireNextImageKHR(handle, swapchain, timeout, semaphore, fence,
                                           image_index);
     }
 
+    VkResult WaitForPresentKHR(VkSwapchainKHR swapchain, u64 present_id,
+                               u64 timeout) const noexcept {
+        return dld->vkWaitForPresentKHR(handle, swapchain, present_id, timeout);
+    }
+
     VkResult WaitIdle() const noexcept {
         return dld->vkDeviceWaitIdle(handle);
     }
@@ -1119,6 +1203,18 @@ public:
         dld->vkCmdEndRenderPass(handle);
     }
 
+    void BeginRendering(const VkRenderingInfo& rendering_info) const noexcept {
+        dld->vkCmdBeginRendering(handle, &rendering_info);
+    }
+
+    void EndRendering() const noexcept {
+        dld->vkCmdEndRendering(handle);
+    }
+
+    void ExecuteCommands(Span<VkCommandBuffer> command_buffers) const noexcept {
+        dld->vkCmdExecuteCommands(handle, command_buffers.size(), command_buffers.data());
+    }
+
     void BeginQuery(VkQueryPool query_pool, u32 query, VkQueryControlFlags flags) const noexcept {
         dld->vkCmdBeginQuery(handle, query_pool, query, flags);
     }
@@ -1133,6 +1229,19 @@ public:
                                      dynamic_offsets.size(), dynamic_offsets.data());
     }
 
+    void BindDescriptorBuffersEXT(
+        Span<VkDescriptorBufferBindingInfoEXT> binding_infos) const noexcept {
+        dld->vkCmdBindDescriptorBuffersEXT(handle, binding_infos.size(), binding_infos.data());
+    }
+
+    void SetDescriptorBufferOffsetsEXT(VkPipelineBindPoint bind_point, VkPipelineLayout layout,
+                                       u32 first_set, Span<u32> buffer_indices,
+                                       Span<VkDeviceSize> offsets) const noexcept {
+        dld->vkCmdSetDescriptorBufferOffsetsEXT(handle, bind_point, layout, first_set,
+                                                buffer_indices.size(), buffer_indices.data(),
+                                                offsets.data());
+    }
+
     void PushDescriptorSetWithTemplateKHR(VkDescriptorUpdateTemplate update_template,
                                           VkPipelineLayout layout, u32 set,
                                           const void* data) const noexcept {
@@ -1168,6 +1277,19 @@ public:
                               first_instance);
     }
 
+    void DrawMultiEXT(std::span<const VkMultiDrawInfoEXT> draws, u32 instance_count,
+                      u32 first_instance) const noexcept {
+        dld->vkCmdDrawMultiEXT(handle, static_cast<u32>(draws.size()), draws.data(), instance_count,
+                               first_instance, sizeof(VkMultiDrawInfoEXT));
+    }
+
+    void DrawMultiIndexedEXT(std::span<const VkMultiDrawIndexedInfoEXT> draws, u32 instance_count,
+                             u32 first_instance) const noexcept {
+        dld->vkCmdDrawMultiIndexedEXT(handle, static_cast<u32>(draws.size()), draws.data(),
+                                      instance_count, first_instance,
+                                      sizeof(VkMultiDrawIndexedInfoEXT), nullptr);
+    }
+
     void DrawIndirect(VkBuffer src_buffer, VkDeviceSize src_offset, u32 draw_count,
                       u32 stride) const noexcept {
         dld->vkCmdDrawIndirect(handle, src_buffer, src_offset, draw_count, stride);
@@ -1358,6 +1480,11 @@ public:
         dld->vkCmdSetEvent(handle, event, stage_flags);
     }
 
+    void WriteTimestamp(VkPipelineStageFlagBits stage, VkQueryPool query_pool,
+                        u32 query) const noexcept {
+        dld->vkCmdWriteTimestamp(handle, stage, query_pool, query);
+    }
+
     void WaitEvents(Span<VkEvent> events, VkPipelineStageFlags src_stage_mask,
                     VkPipelineStageFlags dst_stage_mask, Span<VkMemoryBarrier> memory_barriers,
                     Span<VkBufferMemoryBarrier> buffer_barriers,
@@ -1414,6 +1541,31 @@ public:
         dld->vkCmdSetDepthClampEnableEXT(handle, enable ? VK_TRUE : VK_FALSE);
     }
 
+    void SetPolygonModeEXT(VkPolygonMode polygon_mode) const noexcept {
+        dld->vkCmdSetPolygonModeEXT(handle, polygon_mode);
+    }
+
+    void SetAlphaToCoverageEnableEXT(bool enable) const noexcept {
+        dld->vkCmdSetAlphaToCoverageEnableEXT(handle, enable ? VK_TRUE : VK_FALSE);
+    }
+
+    void SetAlphaToOneEnableEXT(bool enable) const noexcept {
+        dld->vkCmdSetAlphaToOneEnableEXT(handle, enable ? VK_TRUE : VK_FALSE);
+    }
+
+    void SetConservativeRasterizationModeEXT(
+        VkConservativeRasterizationModeEXT mode) const noexcept {
+        dld->vkCmdSetConservativeRasterizationModeEXT(handle, mode);
+    }
+
+    void SetLineRasterizationModeEXT(VkLineRasterizationModeEXT mode) const noexcept {
+        dld->vkCmdSetLineRasterizationModeEXT(handle, mode);
+    }
+
+    void SetProvokingVertexModeEXT(VkProvokingVertexModeEXT mode) const noexcept {
+        dld->vkCmdSetProvokingVertexModeEXT(handle, mode);
+    }
+
     void SetFrontFaceEXT(VkFrontFace front_face) const noexcept {
         dld->vkCmdSetFrontFaceEXT(handle, front_face);
     }
@@ -65,6 +65,8 @@ void ConfigureDebug::SetConfiguration() {
     ui->dump_shaders->setChecked(Settings::values.dump_shaders.GetValue());
     ui->dump_macros->setEnabled(runtime_lock);
     ui->dump_macros->setChecked(Settings::values.dump_macros.GetValue());
+    ui->profile_macros->setEnabled(runtime_lock);
+    ui->profile_macros->setChecked(Settings::values.profile_macros.GetValue());
     ui->disable_macro_jit->setEnabled(runtime_lock);
     ui->disable_macro_jit->setChecked(Settings::values.disable_macro_jit.GetValue());
     ui->disable_macro_hle->setEnabled(runtime_lock);
@@ -104,6 +106,7 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.enable_nsight_aftermath = ui->enable_nsight_aftermath->isChecked();
     Settings::values.dump_shaders = ui->dump_shaders->isChecked();
     Settings::values.dump_macros = ui->dump_macros->isChecked();
+    Settings::values.profile_macros = ui->profile_macros->isChecked();
     Settings::values.disable_shader_loop_safety_checks =
         ui->disable_loop_safety_checks->isChecked();
     Settings::values.disable_macro_jit = ui->disable_macro_jit->isChecked();
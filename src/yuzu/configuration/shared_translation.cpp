@@ -58,6 +58,16 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
         Settings, use_multi_core, tr("Multicore CPU Emulation"),
         tr("This option increases CPU emulation thread use from 1 to the Switch’s maximum of 4.\n"
            "This is mainly a debug option and shouldn’t be disabled."));
+    INSERT(Settings, use_adaptive_idle, tr("Adaptive CPU Idle"),
+           tr("Idle emulated cores briefly busy-wait for interrupts before sleeping.\n"
+              "This reduces scheduling latency in multicore games at the cost of some "
+              "extra host CPU use."));
+    INSERT(Settings, use_performance_cores, tr("Use Performance Cores"),
+           tr("Runs the emulated CPU cores and the GPU thread on the performance cores of hybrid "
+              "host CPUs."));
+    INSERT(Settings, host_core_affinity, tr("Host Core Affinity"),
+           tr("Host cores to run the emulated CPU cores and the GPU thread on, such as "
+              "\"4-7\".\nLeave empty to choose them automatically."));
     INSERT(
         Settings, memory_layout_mode, tr("Memory Layout"),
         tr("Increases the amount of emulated RAM from the stock 4GB of the retail Switch to the "
@@ -65,6 +75,10 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            "to let big texture mods fit in emulated RAM.\nEnabling it will increase memory "
            "use. It is not recommended to enable unless a specific game with a texture mod needs "
            "it."));
+    INSERT(Settings, use_huge_pages, tr("Use Huge Pages"),
+           tr("Backs emulated RAM with 2MB huge pages reserved by the host (Linux only).\n"
+              "This reduces TLB misses when the host has enough huge pages configured, "
+              "and falls back to regular pages otherwise. Requires a restart."));
     INSERT(Settings, use_speed_limit, QStringLiteral(), QStringLiteral());
     INSERT(Settings, speed_limit, tr("Limit Speed Percent"),
            tr("Controls the game's maximum rendering speed, but it’s up to each game if it runs "
@@ -164,11 +178,59 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            "the emulator to decompress to an intermediate format any card supports, RGBA8.\n"
            "This option recompresses RGBA8 to either the BC1 or BC3 format, saving VRAM but "
            "negatively affecting image quality."));
+    INSERT(Settings, use_astc_transcode_cache, tr("Cache recompressed ASTC textures"),
+           tr("Stores ASTC textures recompressed to BC1 or BC3 on disk, so they are not decoded "
+              "and recompressed again in later sessions.\nHas no effect when ASTC recompression "
+              "is disabled."));
+    INSERT(Settings, astc_transcode_cache_size, tr("ASTC transcode cache size (MiB):"),
+           tr("Maximum size of the recompressed ASTC texture cache on disk."));
     INSERT(Settings, vram_usage_mode, tr("VRAM Usage Mode:"),
            tr("Selects whether the emulator should prefer to conserve memory or make maximum usage "
               "of available video memory for performance. Has no effect on integrated graphics. "
               "Aggressive mode may severely impact the performance of other applications such as "
               "recording software."));
+    INSERT(Settings, use_texture_deduplication, tr("Deduplicate identical textures"),
+           tr("Fills textures with the same contents as a texture already in video memory with a "
+              "copy of it, skipping their decoding and upload.\nHashes every uploaded texture, "
+              "which costs some CPU time."));
+    INSERT(Settings, use_host_memory_import, tr("Import guest memory (Vulkan only)"),
+           tr("Copies buffer data straight from guest memory on the GPU instead of staging it "
+              "first, using VK_EXT_external_memory_host.\nReduces CPU time spent on buffer "
+              "uploads, mostly on integrated GPUs. Unsupported drivers ignore this setting."));
+    INSERT(Settings, use_staging_arena, tr("Sub-allocate staging buffers (Vulkan only)"),
+           tr("Carves transfer staging memory out of a few large buffers instead of creating a "
+              "buffer per transfer size.\nReduces allocations and memory wasted on padding "
+              "during heavy streaming."));
+    INSERT(Settings, parallel_command_recording, tr("Parallel command recording (Vulkan only)"),
+           tr("Splits render passes into secondary command buffers recorded on several "
+              "threads.\nReduces CPU time in draw heavy scenes on systems with spare cores."));
+    INSERT(Settings, use_descriptor_buffer, tr("Use descriptor buffers (Vulkan only)"),
+           tr("Writes shader resource descriptors directly to GPU memory on drivers supporting "
+              "VK_EXT_descriptor_buffer.\nReduces the CPU cost of binding resources on every "
+              "draw."));
+    INSERT(Settings, low_latency_presentation, tr("Low latency presentation (Vulkan only)"),
+           tr("Waits for frames to be displayed before rendering further ahead on drivers "
+              "supporting VK_KHR_present_wait.\nReduces input latency at the cost of a lower "
+              "framerate when the GPU is the bottleneck."));
+    INSERT(Settings, use_dynamic_rendering, tr("Use dynamic rendering (Vulkan only)"),
+           tr("Begins render passes without framebuffer objects on drivers supporting "
+              "VK_KHR_dynamic_rendering.\nMerges consecutive passes drawing to the same images, "
+              "which is cheaper on tiled mobile GPUs."));
+    INSERT(Settings, use_gpu_conditional_rendering,
+           tr("Resolve conditional rendering on the GPU (Vulkan only)"),
+           tr("Writes query results and evaluates render conditions on the GPU instead of "
+              "waiting for them on the CPU.\nResults are only read back when the game reads "
+              "them. Reduces stutters in games relying on occlusion culling."));
+    INSERT(Settings, use_async_compute_queue, tr("Use async compute queue (Vulkan only)"),
+           tr("Decodes ASTC textures on a dedicated compute queue when the GPU has one, so "
+              "texture streaming overlaps with rendering."));
+    INSERT(Settings, optimize_spirv_cache, tr("Optimize cached shaders (Vulkan only)"),
+           tr("Runs the SPIR-V optimizer on shaders before they are written to the disk cache.\n"
+              "Shaders load optimized on the next boot. Requires a build with SPIRV-Tools."));
+    INSERT(Settings, use_cbuf_specialization,
+           tr("Specialize shaders on constant buffer flags (Vulkan only)"),
+           tr("Builds pipeline variants with the branches of uber-shaders resolved for the values "
+              "games use the most.\nMay increase pipeline build work."));
     INSERT(
         Settings, vsync_mode, tr("VSync Mode:"),
         tr("FIFO (VSync) does not drop frames or exhibit tearing but is limited by the screen "
@@ -183,6 +245,11 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     // Renderer (Advanced Graphics)
     INSERT(Settings, async_presentation, tr("Enable asynchronous presentation (Vulkan only)"),
            tr("Slightly improves performance by moving presentation to a separate CPU thread."));
+    INSERT(Settings, vulkan_present_device, tr("Presentation device (Vulkan only):"),
+           tr("Index of a second GPU that runs the output filters and presents the frames, "
+              "usually the integrated GPU driving the display.\nFrames are shared through "
+              "dma-bufs, so this is only available on Linux. -1 presents from the rendering "
+              "GPU."));
     INSERT(
         Settings, renderer_force_max_clock, tr("Force maximum clocks (Vulkan only)"),
         tr("Runs work in the background while waiting for graphics commands to keep the GPU from "
@@ -200,6 +267,11 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Enables asynchronous shader compilation, which may reduce shader stutter.\nThis "
               "feature "
               "is experimental."));
+    INSERT(Settings, use_asynchronous_shader_fallback,
+           tr("Draw with similar pipelines while shaders build"),
+           tr("While asynchronous shaders build, draws are rendered with an already built "
+              "pipeline using the same shaders instead of being skipped.\nThis reduces missing "
+              "geometry at the cost of temporary rendering inaccuracies."));
     INSERT(Settings, use_fast_gpu_time, tr("Use Fast GPU Time (Hack)"),
            tr("Enables Fast GPU Time. This option will force most games to run at their highest "
               "native resolution."));
@@ -207,6 +279,14 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Enables GPU vendor-specific pipeline cache.\nThis option can improve shader loading "
               "time significantly in cases where the Vulkan driver does not store pipeline cache "
               "files internally."));
+    INSERT(Settings, pipeline_warmup_seconds, tr("Pipeline warm-up window (seconds):"),
+           tr("Cached pipelines first used within this many seconds of the previous session are "
+              "built before the game starts.\nThe rest are built in the background while "
+              "playing.\nSet to 0 to build every cached pipeline before booting."));
+    INSERT(Settings, pipeline_cache_budget, tr("Pipeline memory budget (MiB):"),
+           tr("Least recently used pipelines are destroyed when their estimated driver memory "
+              "exceeds this budget.\nEvicted pipelines are rebuilt from the disk cache when "
+              "needed again.\nSet to 0 for no limit."));
     INSERT(
         Settings, enable_compute_pipelines, tr("Enable Compute Pipelines (Intel Vulkan Only)"),
         tr("Enable compute pipelines, required by some games.\nThis setting only exists for Intel "
@@ -216,6 +296,10 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
         Settings, use_reactive_flushing, tr("Enable Reactive Flushing"),
         tr("Uses reactive flushing instead of predictive flushing, allowing more accurate memory "
            "syncing."));
+    INSERT(Settings, use_batched_write_tracking, tr("Batch GPU memory write tracking"),
+           tr("Records CPU writes to GPU cached memory and applies them in bulk when the GPU "
+              "starts executing commands, instead of checking the GPU caches on every write.\n"
+              "Reduces CPU overhead in games that stream data to the GPU."));
     INSERT(Settings, use_video_framerate, tr("Sync to framerate of video playback"),
            tr("Run the game at normal speed during video playback, even when the framerate is "
               "unlocked."));
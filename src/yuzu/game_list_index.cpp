@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "yuzu/game_list_index.h"
+
+namespace {
+
+constexpr u32 IndexMagic = Common::MakeMagic('Y', 'G', 'L', 'I');
+constexpr u32 IndexVersion = 1;
+
+std::filesystem::path GetIndexPath() {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "game_list" / "index.bin";
+}
+
+class Writer {
+public:
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* const bytes = reinterpret_cast<const u8*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteBytes(const void* bytes, size_t size) {
+        Write(static_cast<u32>(size));
+        const auto* const begin = static_cast<const u8*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    }
+
+    std::vector<u8> data;
+};
+
+class Reader {
+public:
+    explicit Reader(const std::vector<u8>& data_) : data{data_} {}
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename Container>
+    bool ReadBytes(Container& out) {
+        u32 size{};
+        if (!Read(size) || data.size() - offset < size) {
+            return false;
+        }
+        const auto* const begin = data.data() + offset;
+        out.assign(begin, begin + size);
+        offset += size;
+        return true;
+    }
+
+private:
+    const std::vector<u8>& data;
+    size_t offset{};
+};
+
+} // Anonymous namespace
+
+GameListIndex::GameListIndex() {
+    const auto path = GetIndexPath();
+    if (!Common::FS::Exists(path)) {
+        return;
+    }
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    std::vector<u8> data(file.IsOpen() ? file.GetSize() : 0);
+    if (file.ReadSpan(std::span<u8>(data)) != data.size()) {
+        LOG_ERROR(Frontend, "Failed to read the game list index");
+        return;
+    }
+
+    Reader reader{data};
+    u32 magic{};
+    u32 version{};
+    u32 num_records{};
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(num_records) ||
+        magic != IndexMagic || version != IndexVersion) {
+        LOG_WARNING(Frontend, "Ignoring invalid game list index");
+        return;
+    }
+
+    for (u32 i = 0; i < num_records; ++i) {
+        std::string file_path;
+        Entry entry{};
+        u32 file_type{};
+        u32 num_programs{};
+        if (!reader.ReadBytes(file_path) || !reader.Read(entry.file_size) ||
+            !reader.Read(entry.modification_time) || !reader.Read(file_type) ||
+            !reader.Read(num_programs)) {
+            LOG_WARNING(Frontend, "Game list index is truncated");
+            records.clear();
+            return;
+        }
+        entry.file_type = static_cast<Loader::FileType>(file_type);
+        entry.programs.resize(num_programs);
+        for (auto& program : entry.programs) {
+            if (!reader.Read(program.program_id) || !reader.ReadBytes(program.name) ||
+                !reader.ReadBytes(program.icon)) {
+                LOG_WARNING(Frontend, "Game list index is truncated");
+                records.clear();
+                return;
+            }
+        }
+        records.insert_or_assign(std::move(file_path), Record{std::move(entry), false});
+    }
+}
+
+GameListIndex::~GameListIndex() = default;
+
+std::optional<std::pair<u64, s64>> GameListIndex::GetFileStamp(const std::string& path) {
+    std::error_code ec;
+    const auto fs_path = Common::FS::ToU8String(path);
+    const u64 file_size = std::filesystem::file_size(fs_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto modification_time = std::filesystem::last_write_time(fs_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return std::make_pair(file_size,
+                          static_cast<s64>(modification_time.time_since_epoch().count()));
+}
+
+std::optional<GameListIndex::Entry> GameListIndex::Find(const std::string& path, u64 file_size,
+                                                        s64 modification_time) {
+    std::scoped_lock lk{mutex};
+    const auto it = records.find(path);
+    if (it == records.end()) {
+        return std::nullopt;
+    }
+
+    Record& record = it->second;
+    if (record.entry.file_size != file_size ||
+        record.entry.modification_time != modification_time) {
+        return std::nullopt;
+    }
+    record.used = true;
+    return record.entry;
+}
+
+void GameListIndex::Insert(const std::string& path, Entry entry) {
+    std::scoped_lock lk{mutex};
+    records.insert_or_assign(path, Record{std::move(entry), true});
+    dirty = true;
+}
+
+void GameListIndex::Save(bool prune) {
+    std::scoped_lock lk{mutex};
+    if (prune) {
+        dirty |= std::erase_if(records, [](const auto& it) { return !it.second.used; }) != 0;
+    }
+    if (!dirty) {
+        return;
+    }
+
+    Writer writer;
+    writer.Write(IndexMagic);
+    writer.Write(IndexVersion);
+    writer.Write(static_cast<u32>(records.size()));
+    for (const auto& [file_path, record] : records) {
+        const Entry& entry = record.entry;
+        writer.WriteBytes(file_path.data(), file_path.size());
+        writer.Write(entry.file_size);
+        writer.Write(entry.modification_time);
+        writer.Write(static_cast<u32>(entry.file_type));
+        writer.Write(static_cast<u32>(entry.programs.size()));
+        for (const auto& program : entry.programs) {
+            writer.Write(program.program_id);
+            writer.WriteBytes(program.name.data(), program.name.size());
+            writer.WriteBytes(program.icon.data(), program.icon.size());
+        }
+    }
+
+    const auto path = GetIndexPath();
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Frontend, "Failed to create the game list cache directory");
+        return;
+    }
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen() ||
+        file.WriteSpan(std::span<const u8>(writer.data)) != writer.data.size()) {
+        LOG_ERROR(Frontend, "Failed to write the game list index");
+        return;
+    }
+    dirty = false;
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/loader/loader.h"
+
+/**
+ * On-disk index of the metadata the game list reads from game files.
+ *
+ * Entries are keyed by the path of the file and are only valid while its size and modification
+ * time match, so unchanged files are listed without opening and parsing them again.
+ * Thread-safe, files are looked up and added from the game list scanning threads.
+ */
+class GameListIndex {
+public:
+    struct Program {
+        u64 program_id;
+        std::string name;
+        std::vector<u8> icon;
+    };
+
+    struct Entry {
+        u64 file_size;
+        s64 modification_time;
+        Loader::FileType file_type;
+        std::vector<Program> programs;
+    };
+
+    /// Loads the index from the game list cache directory.
+    GameListIndex();
+    ~GameListIndex();
+
+    YUZU_NON_COPYABLE(GameListIndex);
+    YUZU_NON_MOVEABLE(GameListIndex);
+
+    /// Returns the size and modification time of a file, used to validate its entry.
+    static std::optional<std::pair<u64, s64>> GetFileStamp(const std::string& path);
+
+    /// Returns the entry of a file if it is present and up to date.
+    std::optional<Entry> Find(const std::string& path, u64 file_size, s64 modification_time);
+
+    /// Adds or replaces the entry of a file.
+    void Insert(const std::string& path, Entry entry);
+
+    /**
+     * Writes the index back to disk if it changed.
+     * @param prune Drop the entries of files that were not looked up, for when every game
+     *              directory was scanned.
+     */
+    void Save(bool prune);
+
+private:
+    struct Record {
+        Entry entry;
+        bool used;
+    };
+
+    std::map<std::string, Record, std::less<>> records;
+    bool dirty{};
+    std::mutex mutex;
+};
@@ -13,6 +13,7 @@
 
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/thread_pool.h"
 #include "core/core.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/content_archive.h"
@@ -25,6 +26,7 @@
 #include "core/loader/loader.h"
 #include "yuzu/compatibility_list.h"
 #include "yuzu/game_list.h"
+#include "yuzu/game_list_index.h"
 #include "yuzu/game_list_p.h"
 #include "yuzu/game_list_worker.h"
 #include "yuzu/uisettings.h"
@@ -191,12 +193,31 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
     return out;
 }
 
+QString GetPatchVersions(const FileSys::PatchManager& patch,
+                         const std::function<std::unique_ptr<Loader::AppLoader>()>& open_loader) {
+    return GetGameListCachedObject(
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &open_loader] {
+            const auto loader = open_loader();
+            if (!loader) {
+                return QString{};
+            }
+            return FormatPatchNameVersions(patch, *loader, loader->IsRomFSUpdatable());
+        });
+}
+
+QString GetPatchVersions(const FileSys::PatchManager& patch, Loader::AppLoader& loader) {
+    return GetGameListCachedObject(
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
+            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
+        });
+}
+
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
                                         const std::size_t size, const std::vector<u8>& icon,
-                                        Loader::AppLoader& loader, u64 program_id,
+                                        Loader::FileType file_type, u64 program_id,
                                         const CompatibilityList& compatibility_list,
                                         const PlayTime::PlayTimeManager& play_time_manager,
-                                        const FileSys::PatchManager& patch) {
+                                        const QString& patch_versions) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -205,7 +226,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -217,10 +237,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         new GameListItemPlayTime(play_time_manager.GetPlayTime(program_id)),
     };
 
-    const auto patch_versions = GetGameListCachedObject(
-        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
-        });
     list.insert(2, new GameListItem(patch_versions));
 
     return list;
@@ -328,15 +344,105 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        auto entry = MakeGameListEntry(file->GetFullPath(), name, file->GetSize(), icon, *loader,
-                                       program_id, compatibility_list, play_time_manager, patch);
+        const auto patch_versions = GetPatchVersions(patch, *loader);
+        auto entry = MakeGameListEntry(file->GetFullPath(), name, file->GetSize(), icon,
+                                       loader->GetFileType(), program_id, compatibility_list,
+                                       play_time_manager, patch_versions);
         RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
     }
 }
 
+GameListWorker::ScannedFile GameListWorker::ScanGameFile(const std::string& physical_name) {
+    ScannedFile scanned{};
+    const auto stamp = index ? GameListIndex::GetFileStamp(physical_name) : std::nullopt;
+    if (stamp) {
+        if (auto entry = index->Find(physical_name, stamp->first, stamp->second)) {
+            scanned.entry = std::move(*entry);
+            const bool is_multi_program = scanned.entry.programs.size() > 1;
+            for (const auto& program : scanned.entry.programs) {
+                const FileSys::PatchManager patch{program.program_id,
+                                                  system.GetFileSystemController(),
+                                                  system.GetContentProvider()};
+
+                // Only reopened when the patch versions aren't cached either.
+                scanned.patch_versions.push_back(GetPatchVersions(patch, [&] {
+                    const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
+                    return Loader::GetLoader(system, file,
+                                             is_multi_program ? program.program_id : 0);
+                }));
+            }
+            return scanned;
+        }
+        scanned.entry.file_size = stamp->first;
+        scanned.entry.modification_time = stamp->second;
+    } else {
+        scanned.entry.file_size = Common::FS::GetSize(physical_name);
+    }
+
+    // Files that are not games are indexed too, with no programs, so they aren't parsed again.
+    scanned.entry.file_type = Loader::FileType::Unknown;
+    this->ReadGameFile(physical_name, scanned);
+    if (stamp) {
+        index->Insert(physical_name, scanned.entry);
+    }
+    return scanned;
+}
+
+void GameListWorker::ReadGameFile(const std::string& physical_name, ScannedFile& scanned) {
+    const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
+    if (!file) {
+        return;
+    }
+
+    auto loader = Loader::GetLoader(system, file);
+    if (!loader) {
+        return;
+    }
+
+    const auto file_type = loader->GetFileType();
+    if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
+        return;
+    }
+    scanned.entry.file_type = file_type;
+
+    const auto add_program = [this, &scanned](Loader::AppLoader& program_loader, u64 id) {
+        GameListIndex::Program program{.program_id = id};
+        [[maybe_unused]] const auto res1 = program_loader.ReadIcon(program.icon);
+
+        program.name = " ";
+        [[maybe_unused]] const auto res3 = program_loader.ReadTitle(program.name);
+
+        const FileSys::PatchManager patch{id, system.GetFileSystemController(),
+                                          system.GetContentProvider()};
+        scanned.patch_versions.push_back(GetPatchVersions(patch, program_loader));
+        scanned.entry.programs.push_back(std::move(program));
+    };
+
+    u64 program_id = 0;
+    const auto res2 = loader->ReadProgramId(program_id);
+
+    std::vector<u64> program_ids;
+    loader->ReadProgramIds(program_ids);
+
+    if (res2 == Loader::ResultStatus::Success && program_ids.size() > 1 &&
+        (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP)) {
+        for (const auto id : program_ids) {
+            loader = Loader::GetLoader(system, file, id);
+            if (!loader) {
+                continue;
+            }
+            add_program(*loader, id);
+        }
+    } else {
+        add_program(*loader, program_id);
+    }
+}
+
 void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
                                     GameListDir* parent_dir) {
-    const auto callback = [this, target, parent_dir](const std::filesystem::path& path) -> bool {
+    std::vector<std::string> game_files;
+
+    const auto callback = [this, target, &game_files](const std::filesystem::path& path) -> bool {
         if (stop_requested) {
             // Breaks the callback loop.
             return false;
@@ -347,6 +453,12 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
 
         if (!is_dir &&
             (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
+            if (target == ScanTarget::PopulateGameList) {
+                // Parsed in parallel once the directory has been walked.
+                game_files.push_back(physical_name);
+                return true;
+            }
+
             const auto file = vfs->OpenFile(physical_name, FileSys::OpenMode::Read);
             if (!file) {
                 return true;
@@ -365,71 +477,24 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
             u64 program_id = 0;
             const auto res2 = loader->ReadProgramId(program_id);
 
-            if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
+            if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
+                provider->AddEntry(FileSys::TitleType::Application,
+                                   FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
+                                   program_id, file);
+            } else if (res2 == Loader::ResultStatus::Success &&
+                       (file_type == Loader::FileType::XCI ||
+                        file_type == Loader::FileType::NSP)) {
+                const auto nsp = file_type == Loader::FileType::NSP
+                                     ? std::make_shared<FileSys::NSP>(file)
+                                     : FileSys::XCI{file}.GetSecurePartitionNSP();
+                for (const auto& title : nsp->GetNCAs()) {
+                    for (const auto& entry : title.second) {
+                        provider->AddEntry(entry.first.first, entry.first.second, title.first,
+                                           entry.second->GetBaseFile());
                     }
                 }
-            } else {
-                std::vector<u64> program_ids;
-                loader->ReadProgramIds(program_ids);
-
-                if (res2 == Loader::ResultStatus::Success && program_ids.size() > 1 &&
-                    (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP)) {
-                    for (const auto id : program_ids) {
-                        loader = Loader::GetLoader(system, file, id);
-                        if (!loader) {
-                            continue;
-                        }
-
-                        std::vector<u8> icon;
-                        [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                        std::string name = " ";
-                        [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                        const FileSys::PatchManager patch{id, system.GetFileSystemController(),
-                                                          system.GetContentProvider()};
-
-                        auto entry = MakeGameListEntry(
-                            physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                            id, compatibility_list, play_time_manager, patch);
-
-                        RecordEvent(
-                            [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
-                    }
-                } else {
-                    std::vector<u8> icon;
-                    [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                    std::string name = " ";
-                    [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                    const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
-                                                      system.GetContentProvider()};
-
-                    auto entry = MakeGameListEntry(
-                        physical_name, name, Common::FS::GetSize(physical_name), icon, *loader,
-                        program_id, compatibility_list, play_time_manager, patch);
-
-                    RecordEvent(
-                        [=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
-                }
             }
-        } else if (is_dir) {
+        } else if (is_dir && target == ScanTarget::PopulateGameList) {
             watch_list.append(QString::fromStdString(physical_name));
         }
 
@@ -442,12 +507,48 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
     } else {
         Common::FS::IterateDirEntries(dir_path, callback, Common::FS::DirEntryFilter::File);
     }
+
+    if (game_files.empty()) {
+        return;
+    }
+
+    // The content provider has been filled and the tickets of every file were added to the key
+    // manager by the first pass, so the files can be read concurrently from here.
+    std::vector<ScannedFile> scanned_files(game_files.size());
+    {
+        Common::TaskGroup scan_tasks(Common::TaskPriority::Background);
+        for (size_t i = 0; i < game_files.size(); ++i) {
+            scan_tasks.Run([this, &game_files, &scanned_files, i] {
+                if (!stop_requested) {
+                    scanned_files[i] = this->ScanGameFile(game_files[i]);
+                }
+            });
+        }
+        scan_tasks.Wait();
+    }
+
+    // Entries are created here to keep them in the order the files were found.
+    for (size_t i = 0; i < game_files.size() && !stop_requested; ++i) {
+        const auto& scanned = scanned_files[i];
+        for (size_t j = 0; j < scanned.entry.programs.size(); ++j) {
+            const auto& program = scanned.entry.programs[j];
+            auto entry = MakeGameListEntry(game_files[i], program.name, scanned.entry.file_size,
+                                           program.icon, scanned.entry.file_type,
+                                           program.program_id, compatibility_list,
+                                           play_time_manager, scanned.patch_versions[j]);
+            RecordEvent([=](GameList* game_list) { game_list->AddEntry(entry, parent_dir); });
+        }
+    }
 }
 
 void GameListWorker::run() {
     watch_list.clear();
     provider->ClearAllEntries();
 
+    if (UISettings::values.cache_game_list) {
+        index = std::make_unique<GameListIndex>();
+    }
+
     const auto DirEntryReady = [&](GameListDir* game_list_dir) {
         RecordEvent([=](GameList* game_list) { game_list->AddDirEntry(game_list_dir); });
     };
@@ -480,6 +581,12 @@ void GameListWorker::run() {
         }
     }
 
+    if (index) {
+        // Files that were not seen are only dropped after a complete scan.
+        index->Save(!stop_requested);
+        index.reset();
+    }
+
     RecordEvent([this](GameList* game_list) { game_list->DonePopulating(watch_list); });
     processing_completed.Set();
 }
@@ -15,6 +15,7 @@
 
 #include "common/thread.h"
 #include "yuzu/compatibility_list.h"
+#include "yuzu/game_list_index.h"
 #include "yuzu/play_time_manager.h"
 
 namespace Core {
@@ -76,11 +77,23 @@ private:
     void ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
                         GameListDir* parent_dir);
 
+    struct ScannedFile {
+        GameListIndex::Entry entry;
+        std::vector<QString> patch_versions;
+    };
+
+    /// Returns the programs of a game file, from the index if the file did not change.
+    ScannedFile ScanGameFile(const std::string& physical_name);
+
+    /// Parses the programs of a game file.
+    void ReadGameFile(const std::string& physical_name, ScannedFile& scanned);
+
     std::shared_ptr<FileSys::VfsFilesystem> vfs;
     FileSys::ManualContentProvider* provider;
     QVector<UISettings::GameDir>& game_dirs;
     const CompatibilityList& compatibility_list;
     const PlayTime::PlayTimeManager& play_time_manager;
+    std::unique_ptr<GameListIndex> index;
 
     QStringList watch_list;
 
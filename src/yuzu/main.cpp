@@ -4665,7 +4665,18 @@ void GMainWindow::UpdateStatusBar() {
         game_fps_label->setText(
             tr("Game: %1 FPS").arg(std::round(results.average_game_fps), 0, 'f', 0));
     }
-    emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    if (results.present_latency > 0.0) {
+        emu_frametime_label->setText(tr("Frame: %1 ms / Latency: %2 ms")
+                                         .arg(results.frametime * 1000.0, 0, 'f', 2)
+                                         .arg(results.present_latency * 1000.0, 0, 'f', 1));
+    } else {
+        emu_frametime_label->setText(
+            tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
+    }
+    emu_frametime_label->setToolTip(
+        tr("Slowest 1% of frames: %1 ms\nSlowest 0.1% of frames: %2 ms")
+            .arg(results.frametime_1_percent_low * 1000.0, 0, 'f', 2)
+            .arg(results.frametime_0_1_percent_low * 1000.0, 0, 'f', 2));
 
     res_scale_label->setVisible(true);
     emu_speed_label->setVisible(!Settings::values.use_multi_core.GetValue());
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/memory_detect.h"
+#include "common/memory_usage.h"
+#include "common/multi_level_page_table.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/perf_stats.h"
+#include "input_common/drivers/tas_input.h"
+#include "input_common/main.h"
+#include "video_core/gpu.h"
+#include "video_core/shader_notify.h"
+#include "yuzu_cmd/benchmark.h"
+#include "yuzu_cmd/sdl_config.h"
+
+Benchmark::Benchmark(BenchmarkOptions options_) : options{std::move(options_)} {
+    if (options.frames == 0 && options.duration == std::chrono::seconds::zero()) {
+        options.frames = DefaultFrames;
+    }
+}
+
+void Benchmark::ApplySettings() const {
+    Settings::values.use_speed_limit.SetValue(false);
+    Settings::values.rng_seed_enabled.SetValue(true);
+
+    const bool use_tas = !options.tas_path.empty();
+    Settings::values.tas_enable.SetValue(use_tas);
+    Settings::values.tas_loop.SetValue(false);
+    if (use_tas) {
+        Common::FS::SetYuzuPath(Common::FS::YuzuPath::TASDir, options.tas_path);
+    }
+    if (options.recommend_settings) {
+        Settings::values.record_shader_stalls.SetValue(true);
+    }
+}
+
+void Benchmark::Start(InputCommon::InputSubsystem& input_subsystem, u64 frames_displayed) {
+    LOG_INFO(Frontend, "Starting benchmark");
+    start_time = Clock::now();
+    start_frames = frames_displayed;
+    if (!options.tas_path.empty()) {
+        input_subsystem.GetTas()->Reset();
+        input_subsystem.GetTas()->StartStop();
+    }
+}
+
+bool Benchmark::IsFinished(u64 frames_displayed) const {
+    if (options.frames != 0 && frames_displayed - start_frames >= options.frames) {
+        return true;
+    }
+    return options.duration != std::chrono::seconds::zero() &&
+           Clock::now() - start_time >= options.duration;
+}
+
+bool Benchmark::WriteReport(Core::System& system, u64 frames_displayed) const {
+    const double seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+    const u64 frames = frames_displayed - start_frames;
+    const Core::FrameTimeSummary frametimes = system.GetPerfStats().GetFrameTimeSummary();
+    const Common::MultiLevelPageTableStatistics page_tables =
+        Common::GetMultiLevelPageTableStatistics();
+    nlohmann::json peak_memory;
+    for (size_t i = 0; i < Common::NumMemoryUsageCategories; ++i) {
+        const auto category = static_cast<Common::MemoryUsageCategory>(i);
+        peak_memory[std::string(Common::GetMemoryUsageCategoryName(category))] =
+            Common::GetMemoryUsage(category).peak_bytes;
+    }
+
+    nlohmann::json report{
+        {"version", fmt::format("{} {}", Common::g_scm_branch, Common::g_scm_desc)},
+        {"title_id", fmt::format("{:016X}", system.GetApplicationProcessProgramID())},
+        {"frames", frames},
+        {"duration_s", seconds},
+        {"average_fps", seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0},
+        {"system_frametimes",
+         {
+             {"frames", frametimes.frames},
+             {"mean_ms", frametimes.mean_frametime},
+             {"median_ms", frametimes.median_frametime},
+             {"1_percent_low_ms", frametimes.frametime_1_percent_low},
+             {"0_1_percent_low_ms", frametimes.frametime_0_1_percent_low},
+             {"histogram_bucket_width_ms", frametimes.histogram_bucket_width},
+             {"histogram", frametimes.histogram},
+         }},
+        {"shaders_built", system.GPU().ShaderNotify().ShadersBuilt()},
+        {"peak_resident_memory_bytes", Common::GetPeakResidentMemory()},
+        {"peak_page_table_bytes", page_tables.peak_committed_bytes},
+        {"peak_memory_bytes", peak_memory},
+    };
+
+    std::vector<SettingRecommendation> recommendations;
+    if (options.recommend_settings) {
+        recommendations = RecommendSettings(MeasureSession(system, frametimes, seconds));
+        nlohmann::json& entries = report["recommendations"] = nlohmann::json::array();
+        for (const SettingRecommendation& recommendation : recommendations) {
+            entries.push_back({
+                {"setting", recommendation.setting},
+                {"current", recommendation.current_value},
+                {"recommended", recommendation.recommended_value},
+                {"reason", recommendation.reason},
+            });
+            LOG_INFO(Frontend, "Recommending {} = {}: {}", recommendation.setting,
+                     recommendation.recommended_value, recommendation.reason);
+        }
+    }
+
+    if (!Common::FS::CreateParentDir(options.report_path)) {
+        LOG_ERROR(Frontend, "Failed to create the directory of the benchmark report {}",
+                  options.report_path.string());
+        return false;
+    }
+    Common::FS::IOFile file(options.report_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::TextFile);
+    const std::string text = report.dump(4);
+    if (file.WriteString(text) != text.size()) {
+        LOG_ERROR(Frontend, "Failed to write the benchmark report {}",
+                  options.report_path.string());
+        return false;
+    }
+    LOG_INFO(Frontend, "Benchmark ran {} frames in {:.2f} s, report written to {}", frames,
+             seconds, options.report_path.string());
+    if (options.recommend_settings) {
+        SaveRecommendedSettings(system, recommendations);
+    }
+    return true;
+}
+
+SessionMetrics Benchmark::MeasureSession(Core::System& system,
+                                         const Core::FrameTimeSummary& frametimes,
+                                         double seconds) const {
+    SessionMetrics metrics{
+        .target_frametime_ms = 1000.0 / static_cast<double>(std::max(options.target_fps, 1U)),
+        .mean_frametime_ms = frametimes.mean_frametime,
+        .session_ms = seconds * 1000.0,
+        .blocked_pipeline_misses = 0,
+        .pipeline_stall_ms = 0.0,
+        .texture_cache_peak_bytes = 0,
+        .texture_cache_budget_bytes = 0,
+    };
+    for (const VideoCore::PipelineMiss& miss : system.GPU().ShaderNotify().PipelineMisses()) {
+        // Translation always stalls emulation, the build only when the draw waits for it
+        const bool is_blocked = miss.stall == VideoCore::ShaderStall::Blocked;
+        metrics.pipeline_stall_ms += miss.translate_ms + (is_blocked ? miss.build_ms : 0.0f);
+        metrics.blocked_pipeline_misses += is_blocked ? 1 : 0;
+    }
+    const Common::MemoryUsage texture_cache =
+        Common::GetMemoryUsage(Common::MemoryUsageCategory::TextureCache);
+    metrics.texture_cache_peak_bytes = texture_cache.peak_bytes;
+    metrics.texture_cache_budget_bytes = texture_cache.budget_bytes;
+    return metrics;
+}
+
+void Benchmark::SaveRecommendedSettings(
+    Core::System& system, const std::vector<SettingRecommendation>& recommendations) const {
+    const u64 title_id = system.GetApplicationProcessProgramID();
+    if (title_id == 0) {
+        LOG_WARNING(Frontend, "The title has no program ID, not saving recommended settings");
+        return;
+    }
+    if (recommendations.empty()) {
+        LOG_INFO(Frontend, "No settings to recommend for {:016X}", title_id);
+        return;
+    }
+    {
+        SdlConfig per_game_config(fmt::format("{:016X}", title_id),
+                                  Config::ConfigType::PerGameConfig);
+        for (const SettingRecommendation& recommendation : recommendations) {
+            recommendation.apply();
+        }
+        per_game_config.SaveAllValues();
+        LOG_INFO(Frontend, "Saved recommended settings to {}",
+                 per_game_config.GetConfigFilePath());
+    }
+    // Go back to the global values so that the global configuration is saved unchanged
+    Settings::RestoreGlobalState(false);
+}
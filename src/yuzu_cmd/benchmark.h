@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+
+#include "common/common_types.h"
+#include "yuzu_cmd/settings_advisor.h"
+
+namespace Core {
+class System;
+struct FrameTimeSummary;
+}
+
+namespace InputCommon {
+class InputSubsystem;
+}
+
+struct BenchmarkOptions {
+    /// File the JSON report is written to
+    std::filesystem::path report_path;
+    /// Frames to run for once the game started, zero for no limit
+    u64 frames = 0;
+    /// Walltime to run for once the game started, zero for no limit
+    std::chrono::seconds duration{};
+    /// Directory of the TAS scripts to replay, empty to run without input
+    std::filesystem::path tas_path;
+    /// Recommend settings from the measured bottlenecks and save them as per-game settings
+    bool recommend_settings = false;
+    /// Frame rate the recommendations aim for
+    u32 target_fps = 60;
+};
+
+/**
+ * Runs a game unattended for a number of frames or a duration with settings that make runs
+ * comparable, then reports frametimes, shader builds and memory usage for regression tracking.
+ */
+class Benchmark {
+public:
+    explicit Benchmark(BenchmarkOptions options_);
+
+    /// Overrides the settings that limit or randomize the run, call before creating the window
+    void ApplySettings() const;
+
+    /// Starts measuring and the TAS playback, call once the game is running
+    void Start(InputCommon::InputSubsystem& input_subsystem, u64 frames_displayed);
+
+    /// Returns true once the benchmark ran for its frames or duration
+    [[nodiscard]] bool IsFinished(u64 frames_displayed) const;
+
+    /// Writes the report of the run so far, returns false when the file could not be written
+    [[nodiscard]] bool WriteReport(Core::System& system, u64 frames_displayed) const;
+
+private:
+    /// Collects the bottleneck measurements the setting recommendations are based on
+    [[nodiscard]] SessionMetrics MeasureSession(Core::System& system,
+                                                const Core::FrameTimeSummary& frametimes,
+                                                double seconds) const;
+
+    /// Writes the recommended values to the per-game configuration of the running title
+    void SaveRecommendedSettings(Core::System& system,
+                                 const std::vector<SettingRecommendation>& recommendations) const;
+
+    using Clock = std::chrono::steady_clock;
+
+    /// Frames run when neither a frame count nor a duration was given
+    static constexpr u64 DefaultFrames = 3600;
+
+    BenchmarkOptions options;
+    Clock::time_point start_time;
+    u64 start_frames = 0;
+};
@@ -11,6 +11,7 @@
 #include "hid_core/hid_core.h"
 #include "input_common/drivers/keyboard.h"
 #include "input_common/drivers/mouse.h"
+#include "input_common/drivers/tas_input.h"
 #include "input_common/drivers/touch_screen.h"
 #include "input_common/main.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
@@ -167,6 +168,32 @@ void EmuWindow_SDL2::WaitEvent() {
         exit(1);
     }
 
+    HandleEvent(event);
+    UpdateTitle();
+}
+
+void EmuWindow_SDL2::WaitEvent(std::chrono::milliseconds timeout) {
+    // Called on main thread
+    SDL_Event event;
+
+    // Errors are not told apart from timeouts here, the next call will run into them again
+    if (SDL_WaitEventTimeout(&event, static_cast<int>(timeout.count()))) {
+        HandleEvent(event);
+    }
+    UpdateTitle();
+}
+
+void EmuWindow_SDL2::OnFrameDisplayed() {
+    // Called on the thread presenting frames
+    input_subsystem->GetTas()->UpdateThread();
+    frames_displayed.fetch_add(1, std::memory_order_relaxed);
+}
+
+u64 EmuWindow_SDL2::FramesDisplayed() const {
+    return frames_displayed.load(std::memory_order_relaxed);
+}
+
+void EmuWindow_SDL2::HandleEvent(const SDL_Event& event) {
     switch (event.type) {
     case SDL_WINDOWEVENT:
         switch (event.window.event) {
@@ -219,14 +246,19 @@ void EmuWindow_SDL2::WaitEvent() {
     default:
         break;
     }
+}
 
+void EmuWindow_SDL2::UpdateTitle() {
     const u32 current_time = SDL_GetTicks();
     if (current_time > last_time + 2000) {
         const auto results = system.GetAndResetPerfStats();
-        const auto title =
-            fmt::format("yuzu {} | {}-{} | FPS: {:.0f} ({:.0f}%)", Common::g_build_fullname,
-                        Common::g_scm_branch, Common::g_scm_desc, results.average_game_fps,
-                        results.emulation_speed * 100.0);
+        const double low_fps = results.frametime_1_percent_low > 0.0
+                                   ? 1.0 / results.frametime_1_percent_low
+                                   : 0.0;
+        const auto title = fmt::format(
+            "yuzu {} | {}-{} | FPS: {:.0f} ({:.0f}%) | 1% low: {:.0f}", Common::g_build_fullname,
+            Common::g_scm_branch, Common::g_scm_desc, results.average_game_fps,
+            results.emulation_speed * 100.0, low_fps);
         SDL_SetWindowTitle(render_window, title.c_str());
         last_time = current_time;
     }
@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <utility>
 
 #include "core/frontend/emu_window.h"
 #include "core/frontend/graphics_context.h"
 
 struct SDL_Window;
+union SDL_Event;
 
 namespace Core {
 class System;
@@ -33,10 +36,25 @@ public:
     /// Wait for the next event on the main thread.
     void WaitEvent();
 
+    /// Wait for the next event on the main thread, giving up after the timeout.
+    void WaitEvent(std::chrono::milliseconds timeout);
+
+    /// Advances TAS playback and counts the frame, called after a frame is presented.
+    void OnFrameDisplayed() override;
+
+    /// Returns the number of frames presented since the window was created
+    u64 FramesDisplayed() const;
+
     // Sets the window icon from yuzu.bmp
     void SetWindowIcon();
 
 protected:
+    /// Dispatches an event received by WaitEvent
+    void HandleEvent(const SDL_Event& event);
+
+    /// Refreshes the performance stats in the title bar every few seconds
+    void UpdateTitle();
+
     /// Called by WaitEvent when a key is pressed or released.
     void OnKeyEvent(int key, u8 state);
 
@@ -85,6 +103,9 @@ protected:
     /// Keeps track of how often to update the title bar during gameplay
     u32 last_time = 0;
 
+    /// Number of frames presented since the window was created
+    std::atomic<u64> frames_displayed = 0;
+
     /// Input subsystem to use with this window.
     InputCommon::InputSubsystem* input_subsystem;
 
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <type_traits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "common/settings.h"
+#include "yuzu_cmd/settings_advisor.h"
+
+namespace {
+
+/// Share of the session stalled on pipeline builds from which asynchronous shaders pay off
+constexpr double STALL_SHARE_THRESHOLD = 0.005;
+/// Share of the texture cache budget from which the cache runs short of memory
+constexpr double VRAM_PRESSURE_THRESHOLD = 0.9;
+/// Frames this much slower than the target count as missing it
+constexpr double SLOW_FRAME_FACTOR = 1.05;
+/// Frames this much faster than the target leave room for a higher resolution
+constexpr double HEADROOM_FRAME_FACTOR = 0.5;
+
+template <typename Type>
+std::string ValueName(Type value) {
+    if constexpr (std::is_enum_v<Type>) {
+        return Settings::CanonicalizeEnum(value);
+    } else {
+        return value ? "true" : "false";
+    }
+}
+
+template <typename Type, bool ranged>
+void Recommend(std::vector<SettingRecommendation>& recommendations,
+               Settings::SwitchableSetting<Type, ranged>& setting, Type value,
+               std::string reason) {
+    if (setting.GetValue() == value) {
+        return;
+    }
+    recommendations.push_back({
+        .setting = setting.GetLabel(),
+        .current_value = ValueName(setting.GetValue()),
+        .recommended_value = ValueName(value),
+        .reason = std::move(reason),
+        .apply =
+            [&setting, value] {
+                setting.SetGlobal(false);
+                setting.SetValue(value);
+            },
+    });
+}
+
+} // Anonymous namespace
+
+std::vector<SettingRecommendation> RecommendSettings(const SessionMetrics& metrics) {
+    std::vector<SettingRecommendation> recommendations;
+    auto& values = Settings::values;
+
+    const double stall_share =
+        metrics.session_ms > 0.0 ? metrics.pipeline_stall_ms / metrics.session_ms : 0.0;
+    if (metrics.blocked_pipeline_misses > 0 && stall_share >= STALL_SHARE_THRESHOLD) {
+        Recommend(recommendations, values.use_asynchronous_shaders, true,
+                  fmt::format("{} draws waited for pipeline builds, emulation stalled for "
+                              "{:.0f} ms ({:.1f}% of the session)",
+                              metrics.blocked_pipeline_misses, metrics.pipeline_stall_ms,
+                              stall_share * 100.0));
+    }
+
+    const double vram_share =
+        metrics.texture_cache_budget_bytes != 0
+            ? static_cast<double>(metrics.texture_cache_peak_bytes) /
+                  static_cast<double>(metrics.texture_cache_budget_bytes)
+            : 0.0;
+    const bool vram_pressure = vram_share >= VRAM_PRESSURE_THRESHOLD;
+    if (vram_pressure) {
+        const std::string usage =
+            fmt::format("the texture cache peaked at {} MiB, {:.0f}% of its {} MiB budget",
+                        metrics.texture_cache_peak_bytes >> 20, vram_share * 100.0,
+                        metrics.texture_cache_budget_bytes >> 20);
+        Recommend(recommendations, values.astc_recompression, Settings::AstcRecompression::Bc3,
+                  fmt::format("{}, recompressed ASTC textures take a quarter of the memory",
+                              usage));
+        Recommend(recommendations, values.vram_usage_mode, Settings::VramUsageMode::Aggressive,
+                  fmt::format("{}, aggressive mode lifts the cap on the budget", usage));
+    }
+
+    // Only frame pacing is measured, CPU and GPU bound sessions are not told apart
+    const double slow_frametime = metrics.target_frametime_ms * SLOW_FRAME_FACTOR;
+    const double fast_frametime = metrics.target_frametime_ms * HEADROOM_FRAME_FACTOR;
+    const auto resolution = values.resolution_setup.GetValue();
+    if (metrics.mean_frametime_ms > slow_frametime) {
+        const std::string pacing =
+            fmt::format("frames took {:.2f} ms on average against a target of {:.2f} ms",
+                        metrics.mean_frametime_ms, metrics.target_frametime_ms);
+        switch (values.gpu_accuracy.GetValue()) {
+        case Settings::GpuAccuracy::Extreme:
+            Recommend(recommendations, values.gpu_accuracy, Settings::GpuAccuracy::High,
+                      fmt::format("{}, high accuracy skips the extreme synchronization", pacing));
+            break;
+        case Settings::GpuAccuracy::High:
+            Recommend(recommendations, values.gpu_accuracy, Settings::GpuAccuracy::Normal,
+                      fmt::format("{}, normal accuracy flushes less GPU memory", pacing));
+            break;
+        case Settings::GpuAccuracy::Normal:
+            break;
+        }
+        if (resolution > Settings::ResolutionSetup::Res1X) {
+            Recommend(recommendations, values.resolution_setup,
+                      static_cast<Settings::ResolutionSetup>(static_cast<u32>(resolution) - 1),
+                      fmt::format("{}, a lower resolution helps when the GPU is the bottleneck",
+                                  pacing));
+        }
+    } else if (metrics.mean_frametime_ms < fast_frametime && !vram_pressure &&
+               resolution < Settings::ResolutionSetup::Res2X) {
+        Recommend(recommendations, values.resolution_setup,
+                  static_cast<Settings::ResolutionSetup>(static_cast<u32>(resolution) + 1),
+                  fmt::format("frames took {:.2f} ms on average against a target of {:.2f} ms, "
+                              "leaving room for a higher resolution",
+                              metrics.mean_frametime_ms, metrics.target_frametime_ms));
+    }
+    return recommendations;
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+
+/// Measurements of a benchmark session the recommendations are based on
+struct SessionMetrics {
+    double target_frametime_ms;
+    double mean_frametime_ms;
+    double session_ms;
+    u64 blocked_pipeline_misses; ///< Draws and dispatches that waited for a pipeline build
+    double pipeline_stall_ms;    ///< Time emulation stalled on pipeline cache misses
+    u64 texture_cache_peak_bytes;
+    u64 texture_cache_budget_bytes; ///< Zero when the texture cache did not report a budget
+};
+
+struct SettingRecommendation {
+    std::string setting;
+    std::string current_value;
+    std::string recommended_value;
+    std::string reason;
+    /// Sets the recommended value as a per-game value of the setting
+    std::function<void()> apply;
+};
+
+/**
+ * Picks per-game values of the settings that trade accuracy or quality for speed from the
+ * bottlenecks seen in a session. Settings already at the recommended value are left out.
+ */
+[[nodiscard]] std::vector<SettingRecommendation> RecommendSettings(const SessionMetrics& metrics);
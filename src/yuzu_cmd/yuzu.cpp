@@ -35,6 +35,7 @@
 #include "network/network.h"
 #include "sdl_config.h"
 #include "video_core/renderer_base.h"
+#include "yuzu_cmd/benchmark.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
@@ -71,6 +72,14 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 static void PrintHelp(const char* argv0) {
     std::cout << "Usage: " << argv0
               << " [options] <filename>\n"
+                 "-b, --benchmark=file  Run unattended without speed limit and write a JSON\n"
+                 "                      performance report to the file\n"
+                 "--benchmark-frames=n  Stop the benchmark after n frames (default 3600)\n"
+                 "--benchmark-seconds=n Stop the benchmark after n seconds\n"
+                 "--benchmark-tas=dir   Replay the TAS scripts of dir during the benchmark\n"
+                 "--benchmark-recommend Recommend settings from the bottlenecks of the benchmark\n"
+                 "                      and save them to the per-game configuration\n"
+                 "--benchmark-target-fps=n Frame rate the recommendations aim for (default 60)\n"
                  "-c, --config          Load the specified configuration file\n"
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-g, --game            File path of the game to load\n"
@@ -211,6 +220,13 @@ int main(int argc, char** argv) {
     std::optional<std::string> config_path;
     std::string program_args;
     std::optional<int> selected_user;
+    std::optional<BenchmarkOptions> benchmark_options;
+    const auto get_benchmark_options = [&benchmark_options]() -> BenchmarkOptions& {
+        if (!benchmark_options) {
+            benchmark_options.emplace();
+        }
+        return *benchmark_options;
+    };
 
     bool use_multiplayer = false;
     bool fullscreen = false;
@@ -221,6 +237,12 @@ int main(int argc, char** argv) {
 
     static struct option long_options[] = {
         // clang-format off
+        {"benchmark", required_argument, 0, 'b'},
+        {"benchmark-frames", required_argument, 0, 'N'},
+        {"benchmark-seconds", required_argument, 0, 'S'},
+        {"benchmark-tas", required_argument, 0, 'T'},
+        {"benchmark-recommend", no_argument, 0, 'R'},
+        {"benchmark-target-fps", required_argument, 0, 'F'},
         {"config", required_argument, 0, 'c'},
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
@@ -234,9 +256,28 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "b:g:fhvp::c:u:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
+            case 'b':
+                get_benchmark_options().report_path = optarg;
+                break;
+            case 'N':
+                get_benchmark_options().frames = std::strtoull(optarg, nullptr, 0);
+                break;
+            case 'S':
+                get_benchmark_options().duration =
+                    std::chrono::seconds{std::strtoull(optarg, nullptr, 0)};
+                break;
+            case 'T':
+                get_benchmark_options().tas_path = optarg;
+                break;
+            case 'R':
+                get_benchmark_options().recommend_settings = true;
+                break;
+            case 'F':
+                get_benchmark_options().target_fps = std::strtoul(optarg, nullptr, 0);
+                break;
             case 'c':
                 config_path = optarg;
                 break;
@@ -322,6 +363,17 @@ int main(int argc, char** argv) {
         Settings::values.current_user = std::clamp(*selected_user, 0, 7);
     }
 
+    std::optional<Benchmark> benchmark;
+    if (benchmark_options) {
+        if (benchmark_options->report_path.empty()) {
+            std::cout << "The benchmark options require --benchmark\n";
+            PrintHelp(argv[0]);
+            return -1;
+        }
+        benchmark.emplace(std::move(*benchmark_options));
+        benchmark->ApplySettings();
+    }
+
 #ifdef _WIN32
     LocalFree(argv_w);
 #endif
@@ -443,17 +495,33 @@ int main(int argc, char** argv) {
     if (system.DebuggerEnabled()) {
         system.InitializeDebugger();
     }
-    while (emu_window->IsOpen()) {
-        emu_window->WaitEvent();
+    int exit_code = 0;
+    if (benchmark) {
+        benchmark->Start(input_subsystem, emu_window->FramesDisplayed());
+        while (emu_window->IsOpen() && !benchmark->IsFinished(emu_window->FramesDisplayed())) {
+            // Wake up regularly as the benchmark ends without any window event
+            emu_window->WaitEvent(std::chrono::milliseconds{100});
+        }
+        if (!benchmark->WriteReport(system, emu_window->FramesDisplayed())) {
+            exit_code = -1;
+        }
+    } else {
+        while (emu_window->IsOpen()) {
+            emu_window->WaitEvent();
+        }
     }
     system.DetachDebugger();
     void(system.Pause());
     system.ShutdownMainProcess();
+    if (benchmark) {
+        // Read the configuration again so the benchmark overrides are not saved on exit
+        config.ReloadAllValues();
+    }
 
 #ifdef __unix__
     Common::Linux::StopGamemode();
 #endif
 
     detached_tasks.WaitForAllTasks();
-    return 0;
+    return exit_code;
 }